@@ -426,4 +426,26 @@ TEST(FrtTest, require_that_empty_v3_reponse_is_correctly_initialized)
     f1.assertResponse(*response, "defaultBar");
 }
 
+TEST(FrtTest, require_that_v3_reponse_payload_is_not_decoded_when_xxhash64_is_known)
+{
+    V3RequestFixture f1;
+    const char *payload = "{\"barValue\":\"foobiar\"}";
+    f1.encodePayload(payload, strlen(payload), strlen(payload), CompressionType::UNCOMPRESSED);
+    std::unique_ptr<FRTConfigResponseV3> response(f1.createResponse());
+    ASSERT_TRUE(response->validateResponse());
+    response->fill_unless_known(f1.xxhash64);
+    f1.assertResponse(*response, "defaultBar");
+}
+
+TEST(FrtTest, require_that_v3_reponse_payload_is_decoded_when_xxhash64_is_not_known)
+{
+    V3RequestFixture f1;
+    const char *payload = "{\"barValue\":\"foobiar\"}";
+    f1.encodePayload(payload, strlen(payload), strlen(payload), CompressionType::UNCOMPRESSED);
+    std::unique_ptr<FRTConfigResponseV3> response(f1.createResponse());
+    ASSERT_TRUE(response->validateResponse());
+    response->fill_unless_known("otherxxhash64");
+    f1.assertResponse(*response, "foobiar");
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -42,6 +42,13 @@ public:
      */
     virtual void fill() = 0;
 
+    /**
+     * As fill(), but the payload of a config with the given xxhash64 is not
+     * decoded, as the caller already has that config. The value then has an
+     * empty payload and the given xxhash64.
+     */
+    virtual void fill_unless_known(const std::string & known_xxhash64) { (void) known_xxhash64; fill(); }
+
     /** @return Error message if a request has failed, null otherwise. */
     virtual std::string errorMessage() const = 0;
 
@@ -43,7 +43,7 @@ void
 FRTConfigAgent::handleOKResponse(const ConfigRequest & request, std::unique_ptr<ConfigResponse> response)
 {
     _failedRequests = 0;
-    response->fill();
+    response->fill_unless_known(_latest.getXxhash64());
     if (LOG_WOULD_LOG(spam)) {
         LOG(spam, "trace(%s)", response->getTrace().toString().c_str());
     }
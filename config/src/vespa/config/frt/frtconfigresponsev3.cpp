@@ -51,12 +51,24 @@ FRTConfigResponseV3::getResponseTypes() const
 }
 
 ConfigValue
-FRTConfigResponseV3::readConfigValue() const
+FRTConfigResponseV3::readConfigValue(const std::string & known_xxhash64) const
 {
     std::string xxhash64(_data->get()[RESPONSE_CONFIG_XXHASH64].asString().make_string());
     CompressionInfo info;
     info.deserialize(_data->get()[RESPONSE_COMPRESSION_INFO]);
     auto slime = std::make_unique<Slime>();
+    if (LOG_WOULD_LOG(debug)) {
+        LOG(debug, "config %s.%s,%s xxhash64(%s): received %u payload bytes (%s), %u bytes uncompressed",
+            _data->get()[RESPONSE_DEF_NAMESPACE].asString().make_string().c_str(),
+            _data->get()[RESPONSE_DEF_NAME].asString().make_string().c_str(),
+            _data->get()[RESPONSE_CONFIGID].asString().make_string().c_str(),
+            xxhash64.c_str(), ((*_returnValues)[1]._data._len),
+            compressionTypeToString(info.compressionType).c_str(), info.uncompressedSize);
+    }
+    if (!known_xxhash64.empty() && (xxhash64 == known_xxhash64)) {
+        // Only the generation changed, the caller already has this payload
+        return ConfigValue(std::make_shared<V3Payload>(std::move(slime)), xxhash64);
+    }
     DecompressedData data(decompress(((*_returnValues)[1]._data._buf), ((*_returnValues)[1]._data._len), info.compressionType, info.uncompressedSize));
     if (data.memRef.size > 0) {
         size_t consumedSize = JsonFormat::decode(data.memRef, *slime);
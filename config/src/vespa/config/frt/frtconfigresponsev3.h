@@ -22,7 +22,7 @@ public:
 private:
     static const std::string RESPONSE_TYPES;
     const std::string & getResponseTypes() const override;
-    ConfigValue readConfigValue() const override;
+    ConfigValue readConfigValue(const std::string & known_xxhash64) const override;
 };
 
 } // namespace config
@@ -27,6 +27,18 @@ SlimeConfigResponse::~SlimeConfigResponse() = default;
 
 void
 SlimeConfigResponse::fill()
+{
+    fill_internal("");
+}
+
+void
+SlimeConfigResponse::fill_unless_known(const std::string & known_xxhash64)
+{
+    fill_internal(known_xxhash64);
+}
+
+void
+SlimeConfigResponse::fill_internal(const std::string & known_xxhash64)
 {
     if (_filled) {
         LOG(info, "SlimeConfigResponse::fill() called twice, probably a bug");
@@ -38,7 +50,7 @@ SlimeConfigResponse::fill()
     _data = std::move(data);
     _key = readKey();
     _state = readState();
-    _value = readConfigValue();
+    _value = readConfigValue(known_xxhash64);
     readTrace();
     _filled = true;
     if (LOG_WOULD_LOG(debug)) {
@@ -32,9 +32,11 @@ public:
     std::string getHostName() const;
 
     void fill() override;
+    void fill_unless_known(const std::string & known_xxhash64) override;
 
 protected:
-    virtual ConfigValue readConfigValue() const = 0;
+    // Empty known_xxhash64 means that the payload is always decoded
+    virtual ConfigValue readConfigValue(const std::string & known_xxhash64) const = 0;
 
 private:
     ConfigKey   _key;
@@ -43,6 +45,7 @@ private:
     Trace       _trace;
     bool        _filled;
 
+    void fill_internal(const std::string & known_xxhash64);
     ConfigKey readKey() const;
     ConfigState readState() const;
     void readTrace();
@@ -22,6 +22,11 @@ public abstract class AggregatorNode extends GroupingExpression {
         this.exp = exp;
     }
 
+    protected AggregatorNode(String image, String label, Integer level, ConstantValue<?> param, GroupingExpression exp) {
+        super(image + "(" + param.toString() + ", " + exp.toString() + ")", label, level);
+        this.exp = exp;
+    }
+
     /**
      * Returns the expression that this node aggregates on.
      *
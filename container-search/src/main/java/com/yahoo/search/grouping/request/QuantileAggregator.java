@@ -0,0 +1,41 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.search.grouping.request;
+
+/**
+ * This class represents a quantile-aggregator in a {@link GroupingExpression}. It evaluates to an estimate of the
+ * given quantile of the values that the contained expression evaluated to over all the inputs. The estimate is based
+ * on a bounded size sketch, so it is approximate, but most accurate near the tails (e.g. 0.01 and 0.99).
+ */
+public class QuantileAggregator extends AggregatorNode {
+
+    private final DoubleValue quantile;
+
+    /**
+     * Constructs a new instance of this class.
+     *
+     * @param quantile   the quantile to estimate, in the range [0, 1].
+     * @param expression the expression to aggregate on.
+     */
+    public QuantileAggregator(DoubleValue quantile, GroupingExpression expression) {
+        this(null, null, quantile, expression);
+    }
+
+    private QuantileAggregator(String label, Integer level, DoubleValue quantile, GroupingExpression expression) {
+        super("quantile", label, level, quantile, expression);
+        if (!(quantile.getValue() >= 0.0 && quantile.getValue() <= 1.0)) {
+            throw new IllegalArgumentException("Quantile must be in the range [0, 1], got " + quantile.getValue() + ".");
+        }
+        this.quantile = quantile;
+    }
+
+    /** Returns the quantile that this aggregator estimates. */
+    public double getQuantile() {
+        return quantile.getValue();
+    }
+
+    @Override
+    public QuantileAggregator copy() {
+        return new QuantileAggregator(getLabel(), getLevelOrNull(), quantile.copy(), getExpression().copy());
+    }
+
+}
@@ -68,6 +68,7 @@ import com.yahoo.search.grouping.request.NowFunction;
 import com.yahoo.search.grouping.request.OrFunction;
 import com.yahoo.search.grouping.request.OrPredicate;
 import com.yahoo.search.grouping.request.PredefinedFunction;
+import com.yahoo.search.grouping.request.QuantileAggregator;
 import com.yahoo.search.grouping.request.RawValue;
 import com.yahoo.search.grouping.request.RegexPredicate;
 import com.yahoo.search.grouping.request.RelevanceValue;
@@ -100,6 +101,7 @@ import com.yahoo.searchlib.aggregation.ExpressionCountAggregationResult;
 import com.yahoo.searchlib.aggregation.HitsAggregationResult;
 import com.yahoo.searchlib.aggregation.MaxAggregationResult;
 import com.yahoo.searchlib.aggregation.MinAggregationResult;
+import com.yahoo.searchlib.aggregation.QuantileAggregationResult;
 import com.yahoo.searchlib.aggregation.StandardDeviationAggregationResult;
 import com.yahoo.searchlib.aggregation.SumAggregationResult;
 import com.yahoo.searchlib.aggregation.XorAggregationResult;
@@ -246,6 +248,10 @@ class ExpressionConverter {
                     .setSummaryClass(summaryName != null ? summaryName : defaultSummaryName)
                     .setExpression(new ConstantNode(new IntegerResultNode(0)));
         }
+        if (exp instanceof QuantileAggregator aggregator) {
+            return new QuantileAggregationResult(aggregator.getQuantile())
+                    .setExpression(toExpressionNode(aggregator.getExpression()));
+        }
         if (exp instanceof StandardDeviationAggregator aggregator) {
             return new StandardDeviationAggregationResult()
                     .setExpression(toExpressionNode(aggregator.getExpression()));
@@ -31,6 +31,7 @@ import com.yahoo.searchlib.aggregation.HitsAggregationResult;
 import com.yahoo.searchlib.aggregation.MaxAggregationResult;
 import com.yahoo.searchlib.aggregation.MinAggregationResult;
 import com.yahoo.searchlib.aggregation.RawData;
+import com.yahoo.searchlib.aggregation.QuantileAggregationResult;
 import com.yahoo.searchlib.aggregation.StandardDeviationAggregationResult;
 import com.yahoo.searchlib.aggregation.SumAggregationResult;
 import com.yahoo.searchlib.aggregation.XorAggregationResult;
@@ -265,6 +266,8 @@ class ResultBuilder {
                 return ((MinAggregationResult)execResult).getMin().getValue();
             } else if (execResult instanceof SumAggregationResult) {
                 return ((SumAggregationResult) execResult).getSum().getValue();
+            } else if (execResult instanceof QuantileAggregationResult) {
+                return ((QuantileAggregationResult) execResult).getQuantileValue();
             } else if (execResult instanceof StandardDeviationAggregationResult) {
                 return ((StandardDeviationAggregationResult) execResult).getStandardDeviation();
             } else if (execResult instanceof XorAggregationResult) {
@@ -117,6 +117,7 @@ public class GroupingParserTestCase {
                 "precision",
                 "predefined",
                 "regex",
+                "quantile",
                 "relevance",
                 "reverse",
                 "sin",
@@ -584,6 +585,11 @@ public class GroupingParserTestCase {
         assertIllegalArgument("all(group(debugwait(artist, 3.3, lol)))",
                 "Encountered \" <IDENTIFIER> \"lol\"\" at line 1, column 34");
         assertParse("all(group(artist) each(output(stddev(simple))))");
+        assertParse("all(group(artist) each(output(quantile(0.99, simple))))");
+        assertParse("all(group(artist) each(output(quantile(1, simple))))",
+                    "all(group(artist) each(output(quantile(1.0, simple))))");
+        assertIllegalArgument("all(group(artist) each(output(quantile(1.5, simple))))",
+                              "Quantile must be in the range [0, 1], got 1.5.");
 
         // Test max()
         assertTrue(assertParse("all(group(artist) max(inf))").get(0).hasUnlimitedMax());
@@ -3,6 +3,7 @@
 #include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/repo/configbuilder.h>
 #include <vespa/document/repo/document_type_repo_factory.h>
+#include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <string>
 
@@ -46,6 +47,22 @@ TEST(DocumentTypeRepoFactoryTest, require_that_equal_configs_gives_same_repo)
     EXPECT_NE(repo3, repo4);
 }
 
+TEST(DocumentTypeRepoFactoryTest, require_that_repo_is_forgotten_when_last_reference_is_gone)
+{
+    auto config1 = makeDocumentTypesConfig("a");
+    auto config2 = std::make_shared<const DocumenttypesConfig>(*config1);
+    auto repo1 = DocumentTypeRepoFactory::make(*config1);
+    EXPECT_FALSE(DocumentTypeRepoFactory::empty());
+    auto repo2 = DocumentTypeRepoFactory::make(*config2);
+    EXPECT_EQ(repo1, repo2);
+    repo1.reset();
+    EXPECT_FALSE(DocumentTypeRepoFactory::empty());
+    repo2.reset();
+    EXPECT_TRUE(DocumentTypeRepoFactory::empty());
+    auto repo3 = DocumentTypeRepoFactory::make(*config2);
+    EXPECT_TRUE(repo3->getDocumentType(type_name) != nullptr);
+}
+
 }
 
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -27,6 +27,7 @@
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/test/test_path.h>
+#include <vespa/vespalib/util/buffer.h>
 #include <vespa/vespalib/util/growablebytebuffer.h>
 #include <fcntl.h>
 #include <gmock/gmock.h>
@@ -985,6 +986,36 @@ TEST(DocumentTest, testUnknownEntries)
     EXPECT_EQ(size_t(2), doc2.getSetFieldCount());
 }
 
+TEST(DocumentTest, document_references_shared_backing_buffer_until_modified)
+{
+    DocumentType type("test", 0);
+    Field field("str", *DataType::STRING);
+    type.addField(field);
+    DocumentTypeRepo repo(type);
+
+    std::string text(100, 'x');
+    Document doc1(repo, type, DocumentId("id:ns:test::1"));
+    doc1.setValue(field, StringFieldValue(text));
+    vespalib::nbostream os;
+    doc1.serialize(os);
+    auto owner = std::make_shared<std::string>(os.data(), os.size());
+    const char *begin = owner->data();
+    const char *end = begin + owner->size();
+
+    Document doc2(repo, vespalib::ConstBufferRef(owner->data(), owner->size()), owner);
+    EXPECT_EQ(2, owner.use_count());
+    EXPECT_EQ(doc1, doc2);
+    auto value = doc2.getValue(field);
+    auto ref = static_cast<const StringFieldValue &>(*value).getValueRef();
+    EXPECT_EQ(text, ref);
+    EXPECT_TRUE(ref.data() >= begin && ref.data() < end);
+
+    owner.reset();
+    static_cast<StringFieldValue &>(*value).setValue("y");
+    EXPECT_EQ("y", static_cast<const StringFieldValue &>(*value).getValueRef());
+    EXPECT_EQ(text, doc2.getValue(field)->getAsString());
+}
+
 TEST(DocumentTest, testAnnotationDeserialization)
 {
     DocumenttypesConfigBuilderHelper builder;
@@ -507,6 +507,62 @@ TEST(VespaDocumentSerializerTest, requireThatUncompressedStructFieldValueCanBeSe
     checkStructSerialization(value, CompressionConfig::NONE, "uncompressed");
 }
 
+TEST(VespaDocumentSerializerTest, require_that_selected_array_elements_can_be_deserialized)
+{
+    StructDataType structType(getStructDataType());
+    ArrayDataType array_type(structType);
+    ArrayFieldValue value(array_type);
+    for (int32_t i = 0; i < 10; ++i) {
+        StructFieldValue element(structType);
+        element.setValue(field1, IntFieldValue(i));
+        element.setValue(field2, StringFieldValue("element " + std::to_string(i)));
+        value.add(element);
+    }
+    nbostream stream;
+    VespaDocumentSerializer serializer(stream);
+    serializer.write(value);
+    const std::vector<uint32_t> element_ids{1, 4, 9};
+    ArrayFieldValue selected(array_type);
+    VespaDocumentDeserializer deserializer(repo, stream, serialization_version);
+    deserializer.readSelected(selected, element_ids);
+    EXPECT_EQ(0u, stream.size());
+    ASSERT_EQ(3u, selected.size());
+    for (size_t i = 0; i < element_ids.size(); ++i) {
+        EXPECT_EQ(value[element_ids[i]], selected[i]);
+    }
+
+    nbostream stream2;
+    VespaDocumentSerializer serializer2(stream2);
+    serializer2.write(value);
+    VespaDocumentDeserializer deserializer2(repo, stream2, serialization_version);
+    deserializer2.readSelected(selected, std::vector<uint32_t>{2, 10});
+    EXPECT_TRUE(selected.isEmpty());
+}
+
+TEST(VespaDocumentSerializerTest, require_that_selected_map_elements_can_be_deserialized)
+{
+    StructDataType structType(getStructDataType());
+    MapDataType map_type(*DataType::STRING, structType);
+    MapFieldValue value(map_type);
+    for (int32_t i = 0; i < 10; ++i) {
+        StructFieldValue element(structType);
+        element.setValue(field1, IntFieldValue(i));
+        value.push_back(StringFieldValue("key " + std::to_string(i)), element);
+    }
+    nbostream stream;
+    VespaDocumentSerializer serializer(stream);
+    serializer.write(value);
+    const std::vector<uint32_t> element_ids{0, 5};
+    MapFieldValue selected(map_type);
+    VespaDocumentDeserializer deserializer(repo, stream, serialization_version);
+    deserializer.readSelected(selected, element_ids);
+    ASSERT_EQ(2u, selected.size());
+    for (size_t i = 0; i < element_ids.size(); ++i) {
+        EXPECT_EQ(*value[element_ids[i]].first, *selected[i].first);
+        EXPECT_EQ(*value[element_ids[i]].second, *selected[i].second);
+    }
+}
+
 TEST(VespaDocumentSerializerTest, requireThatReserializationIsUnompressedIfUnmodified)
 {
     StructDataType structType(getStructDataType());
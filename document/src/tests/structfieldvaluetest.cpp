@@ -189,5 +189,31 @@ TEST_F(StructFieldValueTest, testStruct)
     }
 }
 
+TEST_F(StructFieldValueTest, field_value_can_reference_serialized_buffer)
+{
+    FixedTypeRepo repo(doc_repo, *doc_repo.getDocumentType(42));
+    const DataType &type = *repo.getDataType("test.header");
+    StructFieldValue value(type);
+    const Field &intF = value.getField("int");
+    const Field &strF = value.getField("content");
+    value.setValue(intF, IntFieldValue(7));
+    value.setValue(strF, StringFieldValue("some content"));
+    nbostream buffer(value.serialize());
+    StructFieldValue value2(type);
+    deserialize(buffer, value2, repo);
+
+    auto copied = value2.getValue(strF);
+    auto referenced1 = value2.getFieldValueReferencingBuffer(strF);
+    auto referenced2 = value2.getFieldValueReferencingBuffer(strF);
+    ASSERT_TRUE(referenced1 && referenced2);
+    EXPECT_EQ(*copied, *referenced1);
+    auto &str1 = dynamic_cast<const StringFieldValue &>(*referenced1);
+    auto &str2 = dynamic_cast<const StringFieldValue &>(*referenced2);
+    EXPECT_EQ(str1.getValueRef().data(), str2.getValueRef().data());
+    EXPECT_NE(dynamic_cast<const StringFieldValue &>(*copied).getValueRef().data(), str1.getValueRef().data());
+    EXPECT_EQ(7, value2.getFieldValueReferencingBuffer(intF)->getAsInt());
+    EXPECT_FALSE(value2.getFieldValueReferencingBuffer(value2.getField("long")));
+}
+
 } // document
 
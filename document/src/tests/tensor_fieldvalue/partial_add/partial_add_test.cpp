@@ -64,6 +64,45 @@ TEST(PartialAddTest, partial_add_works_for_simple_values) {
     }
 }
 
+std::vector<std::pair<std::string,std::string>> in_place_add_layouts = {
+    {       "x3",       "x3" },
+    {     "x4_1",     "x2_1" },
+    { "x4_2y4_1", "x2_2y4_1" },
+    {   "x3y4_1",   "x3y2_1" }
+};
+
+TEST(PartialAddTest, partial_add_in_place_works_for_simple_values) {
+    const auto &factory = SimpleValueBuilderFactory::get();
+    for (const auto &layouts: in_place_add_layouts) {
+        for (auto lhs_ct: CellTypeUtils::list_types()) {
+            for (auto rhs_ct: CellTypeUtils::list_types()) {
+                TensorSpec lhs = GenSpec::from_desc(layouts.first).cells(lhs_ct).seq(N());
+                TensorSpec rhs = GenSpec::from_desc(layouts.second).cells(rhs_ct).seq(Div16(N()));
+                SCOPED_TRACE(fmt("\n===\nLHS: %s\nRHS: %s\n===\n", lhs.to_string().c_str(), rhs.to_string().c_str()));
+                auto output = value_from_spec(lhs, factory);
+                auto add_cells = value_from_spec(rhs, factory);
+                EXPECT_TRUE(TensorPartialUpdate::can_add_in_place(*output, *add_cells));
+                EXPECT_TRUE(TensorPartialUpdate::add_in_place(*output, *add_cells));
+                EXPECT_EQ(reference_add(lhs, rhs), spec_from_value(*output));
+            }
+        }
+    }
+}
+
+TEST(PartialAddTest, partial_add_in_place_is_rejected_when_subspaces_are_added) {
+    for (const auto &layouts: add_layouts) {
+        TensorSpec lhs = GenSpec::from_desc(layouts.first).seq(N());
+        TensorSpec rhs = GenSpec::from_desc(layouts.second).seq(Div16(N()));
+        SCOPED_TRACE(fmt("\n===\nLHS: %s\nRHS: %s\n===\n", lhs.to_string().c_str(), rhs.to_string().c_str()));
+        const auto &factory = SimpleValueBuilderFactory::get();
+        auto output = value_from_spec(lhs, factory);
+        auto add_cells = value_from_spec(rhs, factory);
+        EXPECT_FALSE(TensorPartialUpdate::can_add_in_place(*output, *add_cells));
+        EXPECT_FALSE(TensorPartialUpdate::add_in_place(*output, *add_cells));
+        EXPECT_EQ(lhs, spec_from_value(*output));
+    }
+}
+
 std::vector<std::pair<std::string,std::string>> bad_layouts = {
     {       "x3",     "x3y1" },
     {     "x3y1",       "x3" },
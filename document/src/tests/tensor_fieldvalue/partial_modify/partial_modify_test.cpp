@@ -137,6 +137,37 @@ TEST(PartialModifyTest, partial_modify_with_defauls) {
                                 "tensor(x[3]):{{x:0}:2,{x:1}:3,{x:2}:0}");
 }
 
+TEST(PartialModifyTest, partial_modify_in_place_works_for_simple_values) {
+    const auto &factory = SimpleValueBuilderFactory::get();
+    for (const auto &layouts: modify_layouts) {
+        for (auto lhs_ct: CellTypeUtils::list_types()) {
+            for (auto rhs_ct: CellTypeUtils::list_types()) {
+                TensorSpec lhs = GenSpec::from_desc(layouts.first).cells(lhs_ct).seq(N());
+                TensorSpec rhs = GenSpec::from_desc(layouts.second).cells(rhs_ct).seq(Div16(N()));
+                SCOPED_TRACE(fmt("\n===\nLHS: %s\nRHS: %s\n===\n", lhs.to_string().c_str(), rhs.to_string().c_str()));
+                auto output = value_from_spec(lhs, factory);
+                auto modifier = value_from_spec(rhs, factory);
+                EXPECT_TRUE(TensorPartialUpdate::can_modify_in_place(*output, *modifier, false));
+                EXPECT_TRUE(TensorPartialUpdate::modify_in_place(*output, operation::Add::f, *modifier));
+                EXPECT_EQ(reference_modify(lhs, rhs, operation::Add::f), spec_from_value(*output));
+            }
+        }
+    }
+}
+
+TEST(PartialModifyTest, partial_modify_with_defaults_in_place_requires_existing_subspaces) {
+    const auto &factory = SimpleValueBuilderFactory::get();
+    auto lhs = value_from_spec(TensorSpec::from_expr("tensor(x{}):{{x:\"a\"}:1,{x:\"b\"}:2}"), factory);
+    auto existing = value_from_spec(TensorSpec::from_expr("tensor(x{}):{{x:\"b\"}:3}"), factory);
+    auto added = value_from_spec(TensorSpec::from_expr("tensor(x{}):{{x:\"b\"}:3,{x:\"c\"}:4}"), factory);
+    EXPECT_TRUE(TensorPartialUpdate::can_modify_in_place(*lhs, *existing, true));
+    EXPECT_FALSE(TensorPartialUpdate::can_modify_in_place(*lhs, *added, true));
+    EXPECT_TRUE(TensorPartialUpdate::can_modify_in_place(*lhs, *added, false));
+    auto dense = value_from_spec(TensorSpec::from_expr("tensor(x[3]):{{x:0}:2}"), factory);
+    auto dense_modifier = value_from_spec(TensorSpec::from_expr("tensor(x{}):{{x:\"1\"}:3}"), factory);
+    EXPECT_TRUE(TensorPartialUpdate::can_modify_in_place(*dense, *dense_modifier, true));
+}
+
 std::vector<std::pair<std::string,std::string>> bad_layouts = {
     {       "x3",       "x3" },
     {   "x3y4_1",   "x3y4_1" },
@@ -10,6 +10,7 @@
 #include <vespa/document/util/serializableexceptions.h>
 #include <vespa/document/fieldset/fieldsets.h>
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/buffer.h>
 #include <vespa/vespalib/util/xmlstream.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <cassert>
@@ -69,6 +70,7 @@ Document::Document()
       _id(),
       _fields(getType().getFieldsType()),
       _backingBuffer(),
+      _sharedBacking(),
       _lastModified(0)
 {
     _fields.setDocumentType(getType());
@@ -79,6 +81,7 @@ Document::Document(const Document& rhs)
       _id(rhs._id),
       _fields(rhs._fields),
       _backingBuffer(),
+      _sharedBacking(),
       _lastModified(rhs._lastModified)
 {}
 
@@ -87,6 +90,7 @@ Document::Document(const DataType &type, DocumentId documentId)
       _id(std::move(documentId)),
       _fields(getType().getFieldsType()),
       _backingBuffer(),
+      _sharedBacking(),
       _lastModified(0)
 {
     _fields.setDocumentType(getType());
@@ -107,6 +111,7 @@ Document::Document(const DocumentTypeRepo& repo, const DataType &type, DocumentI
       _id(std::move(documentId)),
       _fields(repo, getType().getFieldsType()),
       _backingBuffer(),
+      _sharedBacking(),
       _lastModified(0)
 {
     _fields.setDocumentType(getType());
@@ -125,6 +130,7 @@ Document::Document(const DocumentTypeRepo& repo, vespalib::nbostream & is)
       _id(),
       _fields(static_cast<const DocumentType &>(getType()).getFieldsType()),
       _backingBuffer(),
+      _sharedBacking(),
       _lastModified(0)
 {
     deserialize(repo, is);
@@ -135,6 +141,7 @@ Document::Document(const DocumentTypeRepo& repo, vespalib::DataBuffer && backing
       _id(),
       _fields(static_cast<const DocumentType &>(getType()).getFieldsType()),
       _backingBuffer(),
+      _sharedBacking(),
       _lastModified(0)
 {
     if (backingBuffer.referencesExternalData()) {
@@ -147,6 +154,18 @@ Document::Document(const DocumentTypeRepo& repo, vespalib::DataBuffer && backing
     }
 }
 
+Document::Document(const DocumentTypeRepo& repo, vespalib::ConstBufferRef buffer, std::shared_ptr<const void> owner)
+    : StructuredFieldValue(Type::DOCUMENT, *DataType::DOCUMENT),
+      _id(),
+      _fields(static_cast<const DocumentType &>(getType()).getFieldsType()),
+      _backingBuffer(),
+      _sharedBacking(std::move(owner)),
+      _lastModified(0)
+{
+    vespalib::nbostream_longlivedbuf is(buffer.c_str(), buffer.size());
+    deserialize(repo, is);
+}
+
 Document::Document(Document &&) noexcept = default;
 Document::~Document() noexcept = default;
 
@@ -156,6 +175,7 @@ Document::operator =(Document &&rhs) noexcept {
     _id = std::move(rhs._id);
     _fields = std::move(rhs._fields);
     _backingBuffer = std::move(rhs._backingBuffer);
+    _sharedBacking = std::move(rhs._sharedBacking);
     _lastModified = rhs._lastModified;
     StructuredFieldValue::operator=(std::move(rhs));
     return *this;
@@ -170,6 +190,7 @@ Document::operator =(const Document &rhs) {
     _lastModified = rhs._lastModified;
     StructuredFieldValue::operator=(rhs);
     _backingBuffer.reset();
+    _sharedBacking.reset();
     return *this;
 }
 
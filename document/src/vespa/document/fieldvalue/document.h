@@ -19,7 +19,10 @@
 #include <vespa/document/base/documentid.h>
 #include <vespa/document/base/field.h>
 
-namespace vespalib { class DataBuffer; }
+namespace vespalib {
+    class ConstBufferRef;
+    class DataBuffer;
+}
 namespace document {
 
 class TransactionGuard;
@@ -31,6 +34,8 @@ private:
     StructFieldValue _fields;
     std::unique_ptr<StructuredCache> _cache;
     std::unique_ptr<vespalib::DataBuffer> _backingBuffer;
+    // Keeps a buffer shared with others alive while field values reference it
+    std::shared_ptr<const void> _sharedBacking;
 
     // To avoid having to return another container object out of docblocks
     // the meta data has been added to document. This will not be serialized
@@ -59,6 +64,12 @@ public:
     Document(const DocumentTypeRepo& repo, const DataType&, DocumentId id);
     Document(const DocumentTypeRepo& repo, vespalib::nbostream& stream);
     Document(const DocumentTypeRepo& repo, vespalib::DataBuffer && buffer);
+    /**
+     * Deserializes from an immutable buffer kept alive by owner, which may be
+     * shared with others. String, raw and struct field values reference the
+     * buffer instead of copying from it, until they are modified.
+     */
+    Document(const DocumentTypeRepo& repo, vespalib::ConstBufferRef buffer, std::shared_ptr<const void> owner);
     ~Document() noexcept override;
 
     void setRepo(const DocumentTypeRepo & repo);
@@ -1,8 +1,10 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "structfieldvalue.h"
+#include "arrayfieldvalue.h"
 #include "fieldvaluewriter.h"
 #include "document.h"
+#include "mapfieldvalue.h"
 #include <vespa/document/repo/fixedtyperepo.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/document/serialization/vespadocumentdeserializer.h>
@@ -142,18 +144,38 @@ createFV(FieldValue & value, const DocumentTypeRepo * repo, nbostream & stream,
 
 FieldValue::UP
 StructFieldValue::getFieldValue(const Field& field) const
+{
+    return getFieldValue(field, false);
+}
+
+FieldValue::UP
+StructFieldValue::getFieldValueReferencingBuffer(const Field& field) const
+{
+    return getFieldValue(field, true);
+}
+
+FieldValue::UP
+StructFieldValue::getFieldValue(const Field& field, bool reference_buffer) const
 {
     int fieldId = field.getId();
 
     vespalib::ConstBufferRef buf = _fields.get(fieldId);
     if (buf.size() != 0) {
-        nbostream stream(buf.c_str(), buf.size());
         FieldValue::UP value(field.getDataType().createFieldValue());
-        if ((_repo == nullptr) && (_doc_type != nullptr)) {
-            DocumentTypeRepo tmpRepo(*_doc_type);
-            createFV(*value, &tmpRepo, stream, _doc_type, _version);
+        auto decode = [&](nbostream & stream) {
+            if ((_repo == nullptr) && (_doc_type != nullptr)) {
+                DocumentTypeRepo tmpRepo(*_doc_type);
+                createFV(*value, &tmpRepo, stream, _doc_type, _version);
+            } else {
+                createFV(*value, _repo, stream, _doc_type, _version);
+            }
+        };
+        if (reference_buffer) {
+            nbostream_longlivedbuf stream(buf.c_str(), buf.size());
+            decode(stream);
         } else {
-            createFV(*value, _repo, stream, _doc_type, _version);
+            nbostream stream(buf.c_str(), buf.size());
+            decode(stream);
         }
         return value;
     }
@@ -190,6 +212,32 @@ StructFieldValue::getFieldValue(const Field& field, FieldValue& value) const
     return false;
 }
 
+bool
+StructFieldValue::getSelectedElements(const Field& field, std::span<const uint32_t> element_ids, FieldValue& value) const
+{
+    vespalib::ConstBufferRef buf = getRawField(field.getId());
+    if (buf.size() == 0) {
+        return false;
+    }
+    nbostream_longlivedbuf stream(buf.c_str(), buf.size());
+    std::unique_ptr<DocumentTypeRepo> tmpRepo;
+    const DocumentTypeRepo * repo = _repo;
+    if ((repo == nullptr) && (_doc_type != nullptr)) {
+        tmpRepo = std::make_unique<DocumentTypeRepo>(*_doc_type);
+        repo = tmpRepo.get();
+    }
+    FixedTypeRepo frepo(repo, _doc_type);
+    VespaDocumentDeserializer deserializer(frepo, stream, _version);
+    if (value.isA(FieldValue::Type::ARRAY)) {
+        deserializer.readSelected(static_cast<ArrayFieldValue&>(value), element_ids);
+    } else if (value.isA(FieldValue::Type::MAP)) {
+        deserializer.readSelected(static_cast<MapFieldValue&>(value), element_ids);
+    } else {
+        createFV(value, repo, stream, _doc_type, _version);
+    }
+    return true;
+}
+
 bool
 StructFieldValue::hasFieldValue(const Field& field) const
 {
@@ -11,6 +11,7 @@
 
 #include "structuredfieldvalue.h"
 #include "serializablearray.h"
+#include <span>
 
 namespace document {
 
@@ -54,6 +55,13 @@ public:
     bool serializeField(int raw_field_id, uint16_t version, FieldValueWriter &writer) const;
     uint16_t getVersion() const { return _version; }
 
+    /**
+     * Deserializes the given field like getValue(), but without copying
+     * strings, raw values and annotations out of the serialized buffer of
+     * this struct. The returned value must not outlive this struct.
+     */
+    FieldValue::UP getFieldValueReferencingBuffer(const Field& field) const;
+
     // raw_ids may contain ids for elements not in the struct's datatype.
     std::vector<int> getRawFieldIds() const;
     void getRawFieldIds(std::vector<int> &raw_ids, const FieldSet& fieldSet) const;
@@ -84,6 +92,13 @@ public:
      */
     bool hasChanged() const { return _hasChanged; }
 
+    /**
+     * Deserializes only the selected elements of an array or map field into value, which must
+     * be created from the field data type. Element ids must be strictly increasing. Other field
+     * types are deserialized as usual. Returns false if the field is not set.
+     */
+    bool getSelectedElements(const Field& field, std::span<const uint32_t> element_ids, FieldValue& value) const;
+
     /**
      * Called by document to reset struct when deserializing where this struct
      * has no content. This clears content and sets changed to false.
@@ -96,6 +111,7 @@ private:
     bool hasFieldValue(const Field&) const override;
     void removeFieldValue(const Field&) override;
     VESPA_DLL_LOCAL vespalib::ConstBufferRef getRawField(uint32_t id) const;
+    VESPA_DLL_LOCAL FieldValue::UP getFieldValue(const Field& field, bool reference_buffer) const;
     VESPA_DLL_LOCAL const StructDataType & getStructType() const;
 
     struct FieldIterator;
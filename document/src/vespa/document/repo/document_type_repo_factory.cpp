@@ -3,7 +3,11 @@
 #include "document_type_repo_factory.h"
 #include "documenttyperepo.h"
 #include <vespa/document/config/config-documenttypes.h>
-#include <iostream>
+#include <vespa/config/print/configdatabuffer.h>
+#include <vespa/vespalib/data/simple_buffer.h>
+#include <vespa/vespalib/data/slime/binary_format.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/stllike/hash_fun.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".document.repo.document_type_repo_factory");
@@ -30,12 +34,25 @@ EmptyFactoryCheck::~EmptyFactoryCheck()
 
 EmptyFactoryCheck emptyFactoryCheck;
 
+std::string
+encode_config(const DocumenttypesConfig &config)
+{
+    ::config::ConfigDataBuffer buffer;
+    config.serialize(buffer);
+    vespalib::SimpleBuffer output;
+    vespalib::slime::BinaryFormat::encode(buffer.slimeObject(), output);
+    auto encoded = output.get();
+    return {encoded.data, encoded.size};
+}
+
 }
 
-DocumentTypeRepoFactory::DocumentTypeRepoEntry::DocumentTypeRepoEntry(std::weak_ptr<const DocumentTypeRepo> repo_in,
-                                                                      std::unique_ptr<const DocumenttypesConfig> config_in)
-    : repo(std::move(repo_in)),
-      config(std::move(config_in))
+DocumentTypeRepoFactory::DocumentTypeRepoEntry::DocumentTypeRepoEntry(const void *repo_raw_ptr_in,
+                                                                      std::weak_ptr<const DocumentTypeRepo> repo_in,
+                                                                      std::string encoded_config_in)
+    : repo_raw_ptr(repo_raw_ptr_in),
+      repo(std::move(repo_in)),
+      encoded_config(std::move(encoded_config_in))
 {
 }
 
@@ -46,36 +63,45 @@ DocumentTypeRepoFactory::DocumentTypeRepoEntry::~DocumentTypeRepoEntry() = defau
  */
 class DocumentTypeRepoFactory::Deleter
 {
+    uint64_t _config_hash;
 public:
+    explicit Deleter(uint64_t config_hash) noexcept : _config_hash(config_hash) {}
     void operator()(DocumentTypeRepo *repoRawPtr) const noexcept {
-        deleteRepo(repoRawPtr);
+        deleteRepo(_config_hash, repoRawPtr);
     }
 };
 
 void
-DocumentTypeRepoFactory::deleteRepo(DocumentTypeRepo *repoRawPtr) noexcept
+DocumentTypeRepoFactory::deleteRepo(uint64_t config_hash, DocumentTypeRepo *repoRawPtr) noexcept
 {
     std::unique_ptr<const DocumentTypeRepo> repo(repoRawPtr);
     std::lock_guard guard(_mutex);
-    _repos.erase(repo.get());
+    auto range = _repos.equal_range(config_hash);
+    for (auto itr = range.first; itr != range.second; ++itr) {
+        if (itr->second.repo_raw_ptr == repo.get()) {
+            _repos.erase(itr);
+            break;
+        }
+    }
 }
 
 std::shared_ptr<const DocumentTypeRepo>
 DocumentTypeRepoFactory::make(const DocumenttypesConfig &config)
 {
+    auto encoded_config = encode_config(config);
+    uint64_t config_hash = vespalib::xxhash::xxh3_64(encoded_config.data(), encoded_config.size());
     std::lock_guard guard(_mutex);
     // Return existing instance if config matches
-    for (const auto &entry : _repos) {
-        const auto repo = entry.second.repo.lock();
-        const auto &repoConfig = *entry.second.config;
-        if (repo && repoConfig == config) {
+    auto range = _repos.equal_range(config_hash);
+    for (auto itr = range.first; itr != range.second; ++itr) {
+        auto repo = itr->second.repo.lock();
+        if (repo && itr->second.encoded_config == encoded_config) {
             return repo;
         }
     }
-    auto repoConfig = std::make_unique<const DocumenttypesConfig>(config);
-    auto repoup = std::make_unique<DocumentTypeRepo>(*repoConfig);
-    auto repo = std::shared_ptr<const DocumentTypeRepo>(repoup.release(), Deleter());
-    _repos.emplace(repo.get(), DocumentTypeRepoEntry(repo, std::move(repoConfig)));
+    auto repoup = std::make_unique<DocumentTypeRepo>(config);
+    auto repo = std::shared_ptr<const DocumentTypeRepo>(repoup.release(), Deleter(config_hash));
+    _repos.emplace(config_hash, DocumentTypeRepoEntry(repo.get(), repo, std::move(encoded_config)));
     return repo;
 }
 
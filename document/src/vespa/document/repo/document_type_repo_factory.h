@@ -2,9 +2,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <map>
+#include <string>
 #include <vespa/document/config/documenttypes_config_fwd.h>
 
 namespace document {
@@ -13,25 +15,29 @@ class DocumentTypeRepo;
 
 /*
  * Factory class for document type repos. Same instance is returned
- * for equal config.
+ * for equal config. Live repos are found by a hash of the binary slime
+ * encoding of their config, which is also kept instead of a copy of the
+ * config itself to check for equality.
  */
 class DocumentTypeRepoFactory {
     struct DocumentTypeRepoEntry {
+        const void *repo_raw_ptr;
         std::weak_ptr<const DocumentTypeRepo> repo;
-        std::unique_ptr<const DocumenttypesConfig> config;
+        std::string encoded_config;
 
-        DocumentTypeRepoEntry(std::weak_ptr<const DocumentTypeRepo> repo_in,
-                              std::unique_ptr<const DocumenttypesConfig> config_in);
+        DocumentTypeRepoEntry(const void *repo_raw_ptr_in,
+                              std::weak_ptr<const DocumentTypeRepo> repo_in,
+                              std::string encoded_config_in);
         DocumentTypeRepoEntry(DocumentTypeRepoEntry &&) = default;
         ~DocumentTypeRepoEntry();
     };
-    using DocumentTypeRepoMap = std::map<const void *, DocumentTypeRepoEntry>;
+    using DocumentTypeRepoMap = std::multimap<uint64_t, DocumentTypeRepoEntry>;
     class Deleter;
 
     static std::mutex _mutex;
     static DocumentTypeRepoMap _repos;
 
-    static void deleteRepo(DocumentTypeRepo *repoRawPtr) noexcept;
+    static void deleteRepo(uint64_t config_hash, DocumentTypeRepo *repoRawPtr) noexcept;
 public:
     /*
      * Since same instance is returned for equal config, we return a shared
@@ -2,6 +2,7 @@
 
 #include "vespadocumentdeserializer.h"
 #include "annotationdeserializer.h"
+#include <vespa/document/datatype/mapdatatype.h>
 #include <vespa/document/fieldvalue/annotationreferencefieldvalue.h>
 #include <vespa/document/fieldvalue/arrayfieldvalue.h>
 #include <vespa/document/fieldvalue/boolfieldvalue.h>
@@ -185,6 +186,60 @@ VespaDocumentDeserializer::read(MapFieldValue &value) {
     }
 }
 
+void
+VespaDocumentDeserializer::readSelected(ArrayFieldValue &value, std::span<const uint32_t> element_ids) {
+    uint32_t size = readSize(_stream);
+    value.clear();
+    if (element_ids.empty() || element_ids.back() >= size) {
+        return;
+    }
+    value.resize(element_ids.size());
+    FieldValue::UP scratch = value.createNested();
+    uint32_t next = 0;
+    for (size_t i = 0; i < element_ids.size(); ++i) {
+        for (; next < element_ids[i]; ++next) {
+            skip(*scratch);
+        }
+        value[i].accept(*this);
+        ++next;
+    }
+}
+
+void
+VespaDocumentDeserializer::readSelected(MapFieldValue &value, std::span<const uint32_t> element_ids) {
+    value.clear();
+    uint32_t size = readSize(_stream);
+    if (element_ids.empty() || element_ids.back() >= size) {
+        return;
+    }
+    value.resize(element_ids.size());
+    const auto & map_type = static_cast<const MapDataType &>(*value.getDataType());
+    FieldValue::UP key_scratch = map_type.getKeyType().createFieldValue();
+    FieldValue::UP value_scratch = map_type.getValueType().createFieldValue();
+    uint32_t next = 0;
+    auto itr = value.begin();
+    for (uint32_t element_id : element_ids) {
+        for (; next < element_id; ++next) {
+            skip(*key_scratch);
+            skip(*value_scratch);
+        }
+        auto pair = *itr;
+        pair.first->accept(*this);
+        pair.second->accept(*this);
+        ++itr;
+        ++next;
+    }
+}
+
+void
+VespaDocumentDeserializer::skip(FieldValue &scratch) {
+    if (scratch.isA(FieldValue::Type::STRUCT)) {
+        skipStruct();
+    } else {
+        scratch.accept(*this);
+    }
+}
+
 namespace {
 template <typename T> struct ValueType { using Type = typename T::Number; };
 template <> struct ValueType<BoolFieldValue> { using Type = bool; };
@@ -395,6 +450,25 @@ VespaDocumentDeserializer::readStructNoReset(StructFieldValue &value) {
     }
 }
 
+void
+VespaDocumentDeserializer::skipStruct() {
+    size_t data_size = readValue<uint32_t>(_stream);
+    const auto compression_type = CompressionConfig::Type(readValue<uint8_t>(_stream));
+    if (CompressionConfig::isCompressed(compression_type)) {
+        getInt2_4_8Bytes(_stream);
+    }
+    size_t field_count = getInt1_4Bytes(_stream);
+    for (size_t i = 0; i < field_count; ++i) {
+        getInt1_4Bytes(_stream);
+        getInt2_4_8Bytes(_stream);
+    }
+    if (data_size > _stream.size()) [[unlikely]] {
+        throw DeserializeException(fmt("Struct size (%zu) is greater than remaining buffer size (%zu)",
+                                       data_size, _stream.size()), VESPA_STRLOC);
+    }
+    _stream.adjustReadPos(data_size);
+}
+
 void
 VespaDocumentDeserializer::read(StructFieldValue& value)
 {
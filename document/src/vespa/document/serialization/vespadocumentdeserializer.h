@@ -5,6 +5,7 @@
 #include <vespa/document/fieldvalue/fieldvaluevisitor.h>
 #include <vespa/document/repo/fixedtyperepo.h>
 #include <memory>
+#include <span>
 
 namespace vespalib { class nbostream; }
 namespace vespalib::eval { struct Value; }
@@ -40,6 +41,8 @@ class VespaDocumentDeserializer : private FieldValueVisitor {
     void visit(ReferenceFieldValue &value) override { read(value); }
 
     void readDocument(Document &value);
+    void skip(FieldValue &scratch);
+    void skipStruct();
 
 public:
     VespaDocumentDeserializer(const DocumentTypeRepo &repo, vespalib::nbostream &stream, uint16_t version) :
@@ -65,6 +68,14 @@ public:
     void read(AnnotationReferenceFieldValue &value);
     void read(ArrayFieldValue &value);
     void read(MapFieldValue &value);
+    /**
+     * Reads an array or map, only deserializing the elements with the given
+     * strictly increasing element ids. The other elements are skipped without
+     * creating field values for them, and reading stops after the last
+     * selected element. The value is left empty if any element id is out of range.
+     */
+    void readSelected(ArrayFieldValue &value, std::span<const uint32_t> element_ids);
+    void readSelected(MapFieldValue &value, std::span<const uint32_t> element_ids);
     void read(BoolFieldValue &value);
     void read(ByteFieldValue &value);
     void read(DoubleFieldValue &value);
@@ -13,6 +13,7 @@
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/xmlstream.h>
+#include <cassert>
 #include <ostream>
 
 using vespalib::IllegalArgumentException;
@@ -77,6 +78,22 @@ TensorAddUpdate::apply_to(const Value &old_tensor,
     return {};
 }
 
+bool
+TensorAddUpdate::can_apply_in_place(const Value &tensor) const
+{
+    const auto* addTensor = _tensor->getAsTensorPtr();
+    return (addTensor != nullptr) && TensorPartialUpdate::can_add_in_place(tensor, *addTensor);
+}
+
+void
+TensorAddUpdate::apply_in_place(Value &tensor) const
+{
+    const auto* addTensor = _tensor->getAsTensorPtr();
+    assert(addTensor != nullptr);
+    bool added = TensorPartialUpdate::add_in_place(tensor, *addTensor);
+    assert(added);
+}
+
 bool
 TensorAddUpdate::applyTo(FieldValue& value) const
 {
@@ -31,6 +31,8 @@ public:
     std::unique_ptr<vespalib::eval::Value> applyTo(const vespalib::eval::Value &tensor) const;
     std::unique_ptr<Value> apply_to(const Value &tensor,
                                     const ValueBuilderFactory &factory) const override;
+    bool can_apply_in_place(const Value &tensor) const override;
+    void apply_in_place(Value &tensor) const override;
     bool applyTo(FieldValue &value) const override;
     void printXml(XmlOutputStream &xos) const override;
     void print(std::ostream &out, bool verbose, const std::string &indent) const override;
@@ -16,6 +16,7 @@
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/xmlstream.h>
+#include <cassert>
 #include <ostream>
 
 using vespalib::IllegalArgumentException;
@@ -168,6 +169,23 @@ TensorModifyUpdate::apply_to(const Value &old_tensor,
     return {};
 }
 
+bool
+TensorModifyUpdate::can_apply_in_place(const Value &tensor) const
+{
+    const auto* cellsTensor = _tensor->getAsTensorPtr();
+    return (cellsTensor != nullptr) &&
+           TensorPartialUpdate::can_modify_in_place(tensor, *cellsTensor, _default_cell_value.has_value());
+}
+
+void
+TensorModifyUpdate::apply_in_place(Value &tensor) const
+{
+    const auto* cellsTensor = _tensor->getAsTensorPtr();
+    assert(cellsTensor != nullptr);
+    bool modified = TensorPartialUpdate::modify_in_place(tensor, getJoinFunction(_operation), *cellsTensor);
+    assert(modified);
+}
+
 namespace {
 
 std::unique_ptr<Value>
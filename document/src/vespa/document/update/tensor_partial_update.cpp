@@ -211,21 +211,14 @@ struct PerformModify {
 };
 
 template <typename ICT, typename MCT>
-Value::UP
-PerformModify::invoke(const Value &input, join_fun_t function, const Value &modifier, const ValueBuilderFactory &factory,
-                      AddressHandler& handler, Value::UP output)
+void
+modify_cells(Value &output, join_fun_t function, const Value &modifier, AddressHandler& handler)
 {
-    const ValueType &input_type = input.type();
-    const size_t dsss = input_type.dense_subspace_size();
-    if (!output) {
-        // copy input to output
-        output = copy_tensor<ICT>(input, input_type, handler.for_output, factory);
-    }
-    // need to overwrite some cells
-    auto output_cells = unconstify(output->cells().template typify<ICT>());
+    const size_t dsss = output.type().dense_subspace_size();
+    auto output_cells = unconstify(output.cells().template typify<ICT>());
     const auto modifier_cells = modifier.cells().typify<MCT>();
     auto modifier_view = modifier.index().create_view({});
-    auto lookup_view = output->index().create_view(handler.for_output.lookup_view_dims);
+    auto lookup_view = output.index().create_view(handler.for_output.lookup_view_dims);
     modifier_view->lookup({});
     size_t modifier_subspace_index;
     while (modifier_view->next_result(handler.from_modifier.next_result_refs, modifier_subspace_index)) {
@@ -244,9 +237,50 @@ PerformModify::invoke(const Value &input, join_fun_t function, const Value &modi
             dst[dense_idx] = function(lhs, rhs);
         }
     }
+}
+
+template <typename ICT, typename MCT>
+Value::UP
+PerformModify::invoke(const Value &input, join_fun_t function, const Value &modifier, const ValueBuilderFactory &factory,
+                      AddressHandler& handler, Value::UP output)
+{
+    if (!output) {
+        // copy input to output
+        output = copy_tensor<ICT>(input, input.type(), handler.for_output, factory);
+    }
+    // need to overwrite some cells
+    modify_cells<ICT, MCT>(*output, function, modifier, handler);
     return output;
 }
 
+struct PerformModifyInPlace {
+    template<typename ICT, typename MCT>
+    static void invoke(Value &output, join_fun_t function, const Value &modifier, AddressHandler& handler) {
+        modify_cells<ICT, MCT>(output, function, modifier, handler);
+    }
+};
+
+bool
+all_modified_sub_spaces_in_input(const Value& input, const Value& modifier, AddressHandler& handler)
+{
+    auto lookup_view = input.index().create_view(handler.for_output.lookup_view_dims);
+    auto modifier_view = modifier.index().create_view({});
+    modifier_view->lookup({});
+    size_t modifier_subspace_index;
+    while (modifier_view->next_result(handler.from_modifier.next_result_refs, modifier_subspace_index)) {
+        handler.handle_address();
+        if (handler.dense_converter.get_dense_index() == npos()) {
+            continue;
+        }
+        lookup_view->lookup(handler.for_output.lookup_refs);
+        size_t output_subspace_index;
+        if (!lookup_view->next_result({}, output_subspace_index)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void
 find_sub_spaces_not_in_input(const Value& input, const Value& modifier, double default_cell_value,
                              AddressHandler& handler, ArrayArrayMap<string_id, double>& sub_spaces_result)
@@ -354,6 +388,36 @@ PerformAdd::invoke(const Value &input, const Value &modifier, const ValueBuilder
     return builder->build(std::move(builder));
 }
 
+struct PerformAddInPlace {
+    template<typename ICT, typename MCT>
+    static void invoke(Value &output, const Value &modifier);
+};
+
+template <typename ICT, typename MCT>
+void
+PerformAddInPlace::invoke(Value &output, const Value &modifier)
+{
+    const size_t dsss = output.type().dense_subspace_size();
+    auto output_cells = unconstify(output.cells().template typify<ICT>());
+    const auto modifier_cells = modifier.cells().typify<MCT>();
+    SparseCoords addrs(output.type().count_mapped_dimensions());
+    auto lookup_view = output.index().create_view(addrs.lookup_view_dims);
+    auto modifier_view = modifier.index().create_view({});
+    modifier_view->lookup({});
+    size_t modifier_subspace_index;
+    while (modifier_view->next_result(addrs.next_result_refs, modifier_subspace_index)) {
+        lookup_view->lookup(addrs.lookup_refs);
+        size_t output_subspace_index;
+        bool found = lookup_view->next_result({}, output_subspace_index);
+        assert(found);
+        auto src = modifier_cells.begin() + dsss * modifier_subspace_index;
+        auto dst = output_cells.begin() + dsss * output_subspace_index;
+        for (size_t i = 0; i < dsss; ++i) {
+            dst[i] = src[i];
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 struct PerformRemove {
@@ -504,6 +568,63 @@ TensorPartialUpdate::add(const Value &input, const Value &add_cells, const Value
             input, add_cells, factory);
 }
 
+bool
+TensorPartialUpdate::can_modify_in_place(const Value& input, const Value& modifier, bool with_defaults)
+{
+    AddressHandler handler(input.type(), modifier.type());
+    if (!handler.valid) {
+        return false;
+    }
+    // Default cell values are only used for sub-spaces that must be added
+    return !with_defaults || input.type().is_dense() || all_modified_sub_spaces_in_input(input, modifier, handler);
+}
+
+bool
+TensorPartialUpdate::modify_in_place(Value& output, join_fun_t function, const Value& modifier)
+{
+    AddressHandler handler(output.type(), modifier.type());
+    if (!handler.valid) {
+        return false;
+    }
+    typify_invoke<2, TypifyCellType, PerformModifyInPlace>(
+            output.cells().type, modifier.cells().type,
+            output, function, modifier, handler);
+    return true;
+}
+
+bool
+TensorPartialUpdate::can_add_in_place(const Value& input, const Value& add_cells)
+{
+    if (input.type().dimensions() != add_cells.type().dimensions()) {
+        return false;
+    }
+    SparseCoords addrs(input.type().count_mapped_dimensions());
+    auto lookup_view = input.index().create_view(addrs.lookup_view_dims);
+    auto add_view = add_cells.index().create_view({});
+    add_view->lookup({});
+    size_t add_subspace_index;
+    while (add_view->next_result(addrs.next_result_refs, add_subspace_index)) {
+        lookup_view->lookup(addrs.lookup_refs);
+        size_t input_subspace_index;
+        if (!lookup_view->next_result({}, input_subspace_index)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+TensorPartialUpdate::add_in_place(Value& output, const Value& add_cells)
+{
+    if (!can_add_in_place(output, add_cells)) {
+        return false;
+    }
+    typify_invoke<2, TypifyCellType, PerformAddInPlace>(
+            output.cells().type, add_cells.cells().type,
+            output, add_cells);
+    return true;
+}
+
 Value::UP
 TensorPartialUpdate::remove(const Value &input, const Value &remove_spec, const ValueBuilderFactory &factory)
 {
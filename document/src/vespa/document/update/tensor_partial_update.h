@@ -39,6 +39,34 @@ struct TensorPartialUpdate {
      **/
     static Value::UP add(const Value &input, const Value &add_cells, const ValueBuilderFactory &factory);
 
+    /**
+     *  Returns true if modify (or modify_with_defaults when with_defaults is set)
+     *  of input with modifier only changes values of existing cells,
+     *  i.e. if the result can be made by modify_in_place on a copy of input.
+     **/
+    static bool can_modify_in_place(const Value &input, const Value &modifier, bool with_defaults);
+
+    /**
+     *  Apply function(oldvalue, modifier.cellvalue) directly to the cells
+     *  of output which also exist in the "modifier". The cells of output
+     *  must be writable. Returns false if the type constraints of modify
+     *  are violated.
+     **/
+    static bool modify_in_place(Value &output, join_fun_t function, const Value &modifier);
+
+    /**
+     *  Returns true if add of add_cells to input only overwrites existing
+     *  cells, i.e. if all dense sub-spaces in add_cells exist in input.
+     **/
+    static bool can_add_in_place(const Value &input, const Value &add_cells);
+
+    /**
+     *  Overwrite cells of output directly with the cells from add_cells.
+     *  The cells of output must be writable. Returns false, leaving output
+     *  unchanged, if can_add_in_place is false.
+     **/
+    static bool add_in_place(Value &output, const Value &add_cells);
+
     /**
      *  Make a copy of the input, but remove cells present in remove_spec.
      *  The remove_spec must be a sparse tensor, with exactly the mapped dimensions
@@ -16,6 +16,16 @@ public:
     using Value = vespalib::eval::Value;
     using ValueBuilderFactory = vespalib::eval::ValueBuilderFactory;
     virtual std::unique_ptr<Value> apply_to(const Value &tensor, const ValueBuilderFactory &factory) const = 0;
+    /**
+     * Returns true if applying this update to tensor only changes values
+     * of existing cells, i.e. if apply_in_place can be used on a copy of tensor.
+     */
+    virtual bool can_apply_in_place(const Value &tensor) const { (void) tensor; return false; }
+    /**
+     * Applies this update directly to the cells of tensor, which must be
+     * writable. Only valid if can_apply_in_place returned true for tensor.
+     */
+    virtual void apply_in_place(Value &tensor) const { (void) tensor; }
 };
 
 }
@@ -107,15 +107,17 @@ private:
     std::string              _error;
     CTFMetaData              _meta;
     CostProfile              _cost;
+    std::vector<size_t>      _cells;
 
     void clear_state() {
         _error.clear();
         _meta = CTFMetaData();
         _cost.clear();
+        _cells.clear();
     }
 
 public:
-    Context() : _param_names(), _param_types(), _param_values(), _param_refs(), _verbose(), _meta(), _cost() {}
+    Context() : _param_names(), _param_types(), _param_values(), _param_refs(), _verbose(), _meta(), _cost(), _cells() {}
     ~Context();
 
     void verbose(bool value) { _verbose = value; }
@@ -159,6 +161,7 @@ public:
             InterpretedFunction::ProfiledContext ctx(ifun);
             result = factory.copy(ifun.eval(ctx, params));
             _cost = ctx.cost;
+            _cells = ctx.cells;
         } else {
             InterpretedFunction ifun(factory, optimized, nullptr);
             InterpretedFunction::Context ctx(ifun);
@@ -171,6 +174,7 @@ public:
     const std::string &error() const { return _error; }
     const CTFMetaData &meta() const { return _meta; }
     const CostProfile &cost() const { return _cost; }
+    const std::vector<size_t> &cells() const { return _cells; }
 
     bool save(const std::string &name, Value::UP value) {
         REQUIRE(value);
@@ -208,7 +212,9 @@ void print_error(const std::string &error) {
     fprintf(stderr, "error: %s\n", error.c_str());
 }
 
-void print_value(const Value &value, const std::string &name, const CTFMetaData &meta, const CostProfile &cost) {
+void print_value(const Value &value, const std::string &name, const CTFMetaData &meta, const CostProfile &cost,
+                 const std::vector<size_t> &cells)
+{
     bool with_name = !name.empty();
     bool with_meta = !meta.steps.empty();
     auto spec = spec_from_value(value);
@@ -224,6 +230,7 @@ void print_value(const Value &value, const std::string &name, const CTFMetaData
             fprintf(stderr, "    symbol: %s\n", steps[i].symbol_name.c_str());
             fprintf(stderr, "    count: %zu\n", cost[i].first);
             fprintf(stderr, "    time_us: %g\n", vespalib::count_ns(cost[i].second)/1000.0);
+            fprintf(stderr, "    cells: %zu\n", cells[i]);
         }
     }
     if (with_name) {
@@ -255,10 +262,14 @@ void handle_message(Context &ctx, const Inspector &req, Cursor &reply) {
     }
     if (!ctx.meta().steps.empty()) {
         auto &steps_out = reply.setArray("steps");
-        for (const auto &step: ctx.meta().steps) {
+        const auto &steps = ctx.meta().steps;
+        for (size_t i = 0; i < steps.size(); ++i) {
             auto &step_out = steps_out.addObject();
-            step_out.setString("class", step.class_name);
-            step_out.setString("symbol", step.symbol_name);            
+            step_out.setString("class", steps[i].class_name);
+            step_out.setString("symbol", steps[i].symbol_name);
+            step_out.setLong("count", ctx.cost()[i].first);
+            step_out.setDouble("time_us", vespalib::count_ns(ctx.cost()[i].second)/1000.0);
+            step_out.setLong("cells", ctx.cells()[i]);
         }
     }
 }
@@ -486,7 +497,7 @@ int interactive_mode(Context &ctx, Script &script, Collector &collector) {
         }
         collector.expr(name, expr);
         if (auto value = ctx.eval(expr)) {
-            print_value(*value, name, ctx.meta(), ctx.cost());
+            print_value(*value, name, ctx.meta(), ctx.cost(), ctx.cells());
             if (!name.empty()) {
                 if (ctx.save(name, std::move(value))) {
                     collector.fail("value redefinition not supported");
@@ -1059,12 +1070,12 @@ int main(int argc, char **argv) {
     for (int i = expr_idx; i < argc; ++i) {
         if (auto value = ctx.eval(argv[i])) {
             if (expr_cnt > 1) {
-                print_value(*value, name, ctx.meta(), ctx.cost());
+                print_value(*value, name, ctx.meta(), ctx.cost(), ctx.cells());
                 ctx.save(name, std::move(value));
                 ++name[0];
             } else {
                 std::string no_name;
-                print_value(*value, no_name, ctx.meta(), ctx.cost());
+                print_value(*value, no_name, ctx.meta(), ctx.cost(), ctx.cells());
             }
         } else {
             print_error(ctx.error());
@@ -11,6 +11,7 @@
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/test/nexus.h>
+#include <filesystem>
 #include <set>
 
 using namespace vespalib;
@@ -422,6 +423,27 @@ TEST(CompileCacheTest, require_that_deadlock_is_avoided_with_blocking_executor)
     Nexus::run(num_threads, task);
 }
 
+TEST(CompileCacheTest, require_that_compiled_code_can_be_reused_from_persistent_cache)
+{
+    std::string dir("persistent_compile_cache");
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directory(dir);
+    CompileCache::set_persistent_dir(dir);
+    auto before = CompileCache::persistent_stats();
+    auto function = Function::parse("x*3+y/2-x*y");
+    for (size_t i = 0; i < 2; ++i) {
+        auto token = CompileCache::compile(*function, PassParams::SEPARATE);
+        auto fun = token->get().get_function<2>();
+        EXPECT_EQ(fun(1.0, 2.0), 2.0);
+        EXPECT_EQ(fun(4.0, 2.0), 5.0);
+    }
+    auto after = CompileCache::persistent_stats();
+    EXPECT_EQ(after.misses, before.misses + 1);
+    EXPECT_EQ(after.hits, before.hits + 1);
+    CompileCache::set_persistent_dir("");
+    std::filesystem::remove_all(dir);
+}
+
 //-----------------------------------------------------------------------------
 
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -115,6 +115,32 @@ TEST(FastValueTest, insert_subspace) {
     EXPECT_EQ(actual, expected);
 }
 
+void verify_lookup_many(const GenSpec &a_spec, const GenSpec &b_spec) {
+    auto a = value_from_spec(a_spec, FastValueBuilderFactory::get());
+    auto b = value_from_spec(b_spec, FastValueBuilderFactory::get());
+    const auto &a_map = as_fast(a->index()).map;
+    const auto &b_map = as_fast(b->index()).map;
+    size_t calls = 0;
+    size_t found = 0;
+    a_map.lookup_many(b_map, [&](size_t b_subspace, size_t a_subspace) {
+                EXPECT_EQ(b_subspace, calls++);
+                EXPECT_EQ(a_subspace, a_map.lookup(b_map.get_addr(b_subspace)));
+                if (a_subspace != FastAddrMap::npos()) {
+                    ++found;
+                    EXPECT_TRUE(std::ranges::equal(a_map.get_addr(a_subspace), b_map.get_addr(b_subspace)));
+                }
+            });
+    EXPECT_EQ(calls, b_map.size());
+    EXPECT_GT(found, 0u);
+    EXPECT_LT(found, b_map.size());
+}
+
+TEST(FastAddrMapTest, lookup_many_gives_same_results_as_lookup) {
+    verify_lookup_many(GenSpec().map("x", 40, 2), GenSpec().map("x", 30, 3));
+    verify_lookup_many(GenSpec().map("x", 5, 2).map("y", 8), GenSpec().map("x", 4, 3).map("y", 5, 2));
+    verify_lookup_many(GenSpec().map("x", 40, 2), GenSpec().map("x", 3, 3));
+}
+
 TEST(FastValueTest, insert_empty_subspace) {
     auto addr = []() { return std::span<const string_id>(); };
     auto type = ValueType::from_spec("double");
@@ -428,6 +428,40 @@ TEST(GbdtTest, require_that_fast_forest_evaluation_is_correct_for_all_tree_size_
     }
 }
 
+TEST(GbdtTest, require_that_fast_forest_batch_evaluation_gives_same_results_as_single_evaluation)
+{
+    for (size_t tree_size: std::vector<size_t>({7,15,30,61,127})) {
+        std::string expression = Model().max_features(20).less_percent(100).invert_percent(50).make_forest(67, tree_size);
+        auto function = Function::parse(expression);
+        auto forest = FastForest::try_convert(*function);
+        if ((tree_size <= 64) || is_little_endian()) {
+            ASSERT_TRUE(forest);
+            SCOPED_TRACE(forest->impl_name());
+            size_t num_params = function->num_params();
+            EXPECT_EQ(num_params, forest->num_params());
+            size_t num_docs = FastForest::batch_size * 2 + 5;
+            std::vector<float> params(num_params * num_docs);
+            for (size_t i = 0; i < num_params; ++i) {
+                for (size_t j = 0; j < num_docs; ++j) {
+                    params[(i * num_docs) + j] = ((i + j) % 11 == 0)
+                        ? std::numeric_limits<float>::quiet_NaN()
+                        : float(((i * 7) + (j * 13)) % 10) / 10.0f;
+                }
+            }
+            std::vector<double> results(num_docs, 0.0);
+            auto ctx = forest->create_context();
+            forest->eval_batch(*ctx, params.data(), num_docs, results.data());
+            std::vector<float> doc_params(num_params);
+            for (size_t j = 0; j < num_docs; ++j) {
+                for (size_t i = 0; i < num_params; ++i) {
+                    doc_params[i] = params[(i * num_docs) + j];
+                }
+                EXPECT_EQ(results[j], forest->eval(*ctx, doc_params.data()));
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 TEST(GbdtTest, require_that_GDBT_expressions_can_be_detected)
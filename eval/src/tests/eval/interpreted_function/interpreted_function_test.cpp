@@ -9,7 +9,10 @@
 #include <vespa/eval/eval/test/eval_spec.h>
 #include <vespa/eval/eval/basic_nodes.h>
 #include <vespa/eval/eval/simple_value.h>
+#include <vespa/eval/eval/value_codec.h>
+#include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/execution_profiler.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/stash.h>
 #include <iostream>
@@ -157,6 +160,101 @@ TEST(InterpretedFunctionTest, require_that_basic_addition_works)
 
 //-----------------------------------------------------------------------------
 
+TEST(InterpretedFunctionTest, require_that_batch_evaluation_gives_same_results_as_single_evaluation)
+{
+    auto function = Function::parse({"a", "b"}, "if(a<b,max(a,b)*exp(-a),pow(a,2)-b/3)+tanh(b)+(a in [1,5,7])");
+    auto node_types = NodeTypes(*function, {ValueType::double_type(), ValueType::double_type()});
+    InterpretedFunction interpreted(SimpleValueBuilderFactory::get(), *function, node_types);
+    ASSERT_TRUE(interpreted.supports_batch());
+    size_t num_docs = InterpretedFunction::max_batch_size + 10;
+    std::vector<double> a;
+    std::vector<double> b;
+    for (size_t i = 0; i < num_docs; ++i) {
+        a.push_back(double(i % 10));
+        b.push_back(double(i % 7) * 0.5);
+    }
+    std::vector<const double *> columns({a.data(), b.data()});
+    std::vector<double> result(num_docs, 0.0);
+    InterpretedFunction::BatchContext batch_ctx(interpreted);
+    interpreted.eval_batch(batch_ctx, columns, result);
+    InterpretedFunction::Context ctx(interpreted);
+    for (size_t i = 0; i < num_docs; ++i) {
+        SimpleParams params({a[i], b[i]});
+        EXPECT_DOUBLE_EQ(interpreted.eval(ctx, params).as_double(), result[i]);
+    }
+}
+
+TEST(InterpretedFunctionTest, require_that_batch_evaluation_is_not_supported_for_tensor_functions)
+{
+    auto function = Function::parse({"a"}, "reduce(a*tensor(x[3]):[1,2,3],sum)");
+    auto node_types = NodeTypes(*function, {ValueType::double_type()});
+    InterpretedFunction interpreted(SimpleValueBuilderFactory::get(), *function, node_types);
+    EXPECT_FALSE(interpreted.supports_batch());
+}
+
+//-----------------------------------------------------------------------------
+
+size_t count_heap_values(const std::string &expr, const std::vector<TensorSpec> &param_specs, double expect) {
+    auto function = Function::parse({"a", "b"}, expr);
+    const auto &factory = FastValueBuilderFactory::get();
+    std::vector<Value::UP> values;
+    std::vector<Value::CREF> refs;
+    std::vector<ValueType> types;
+    for (const auto &spec: param_specs) {
+        values.push_back(value_from_spec(spec, factory));
+        refs.emplace_back(*values.back());
+        types.push_back(values.back()->type());
+    }
+    auto node_types = NodeTypes(*function, types);
+    InterpretedFunction ifun(factory, *function, node_types);
+    InterpretedFunction::Context ctx(ifun);
+    SimpleObjectParams params(refs);
+    EXPECT_EQ(ifun.eval(ctx, params).as_double(), expect);
+    size_t first = ctx.heap_values();
+    EXPECT_EQ(ifun.eval(ctx, params).as_double(), expect);
+    EXPECT_EQ(ctx.heap_values(), first);
+    return first;
+}
+
+TEST(InterpretedFunctionTest, require_that_heap_allocated_intermediate_values_are_counted)
+{
+    auto mixed = TensorSpec("tensor(x{},y[2])")
+                 .add({{"x", "foo"}, {"y", 0}}, 1.0).add({{"x", "foo"}, {"y", 1}}, 2.0)
+                 .add({{"x", "bar"}, {"y", 0}}, 3.0).add({{"x", "bar"}, {"y", 1}}, 4.0);
+    auto sparse = TensorSpec("tensor(x{})").add({{"x", "foo"}}, 5.0).add({{"x", "bar"}}, 6.0);
+    EXPECT_EQ(count_heap_values("a{x:bar,y:1}+b", {mixed, TensorSpec("double").add({}, 1.0)}, 5.0), 0u);
+    EXPECT_EQ(count_heap_values("a{x:baz,y:0}+b", {mixed, TensorSpec("double").add({}, 1.0)}, 1.0), 0u);
+    EXPECT_GT(count_heap_values("reduce(a*b,sum)", {sparse, sparse}, 61.0), 0u);
+}
+
+TEST(InterpretedFunctionTest, require_that_profiled_evaluation_tracks_instructions)
+{
+    auto function = Function::parse("reduce(a*b,sum)");
+    auto a = SimpleValue::from_spec(TensorSpec("tensor(x[3])").add({{"x",0}}, 1).add({{"x",1}}, 2).add({{"x",2}}, 3));
+    auto b = SimpleValue::from_spec(TensorSpec("tensor(x[3])").add({{"x",0}}, 4).add({{"x",1}}, 5).add({{"x",2}}, 6));
+    auto node_types = NodeTypes(*function, {a->type(), b->type()});
+    CTFMetaData meta;
+    InterpretedFunction ifun(FastValueBuilderFactory::get(), function->root(), node_types, &meta);
+    SimpleObjectParams params({*a, *b});
+    InterpretedFunction::ProfiledContext ctx(ifun);
+    EXPECT_EQ(ifun.eval(ctx, params).as_double(), 32.0);
+    ASSERT_EQ(ctx.cells.size(), ifun.program_size());
+    ASSERT_EQ(meta.steps.size(), ifun.program_size());
+    for (const auto &cost: ctx.cost) {
+        EXPECT_EQ(cost.first, 1u);
+    }
+    vespalib::ExecutionProfiler profiler(-64);
+    std::vector<vespalib::ExecutionProfiler::TaskId> tasks;
+    for (const auto &step: meta.steps) {
+        tasks.push_back(profiler.resolve(step.class_name));
+    }
+    InterpretedFunction::Context plain_ctx(ifun);
+    EXPECT_EQ(ifun.eval(plain_ctx, params, profiler, tasks).as_double(), 32.0);
+    vespalib::Slime slime;
+    profiler.report(slime.setObject());
+    EXPECT_GE(slime["roots"].entries(), 1u);
+}
+
 TEST(InterpretedFunctionTest, require_that_functions_with_non_compilable_simple_lambdas_cannot_be_interpreted)
 {
     auto good_map = Function::parse("map(a,f(x)(x+1))");
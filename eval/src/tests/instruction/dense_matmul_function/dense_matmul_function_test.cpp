@@ -58,6 +58,17 @@ TEST(DenseMatMulFunctionTest, require_that_matmul_with_lambda_can_be_optimized)
     verify_optimized("reduce(join(a2d3,b5d3,f(x,y)(x*y)),sum,d)", details);
 }
 
+TEST(DenseMatMulFunctionTest, require_that_matmul_with_long_common_dimension_can_be_optimized)
+{
+    // wide enough to exercise the vectorized int8 dot product
+    verify_optimized("reduce(a3d70*b2d70,sum,d)", { .lhs_size = 3, .common_size = 70, .rhs_size = 2,
+                                                    .lhs_inner = true, .rhs_inner = true });
+    verify_optimized("reduce(a3b70*b70d2,sum,b)", { .lhs_size = 3, .common_size = 70, .rhs_size = 2,
+                                                    .lhs_inner = true, .rhs_inner = false });
+    verify_optimized("reduce(b70c3*b70d2,sum,b)", { .lhs_size = 3, .common_size = 70, .rhs_size = 2,
+                                                    .lhs_inner = false, .rhs_inner = false });
+}
+
 TEST(DenseMatMulFunctionTest, require_that_expressions_similar_to_matmul_are_not_optimized)
 {
     verify_not_optimized("reduce(a2d3*b5d3,sum,a)");
@@ -71,6 +71,9 @@ TEST(DenseXWProductFunctionTest, require_that_xw_product_gives_same_results_as_r
     // 16 -> 5 happy/unhappy
     verify_optimized_multi("y16", "x5y16", "y", 16, 5, true);
     verify_optimized_multi("y16", "y16z5", "y", 16, 5, false);
+    // 70 -> 3 happy/unhappy (wide enough to exercise the vectorized int8 dot product)
+    verify_optimized_multi("y70", "x3y70", "y", 70, 3, true);
+    verify_optimized_multi("y70", "y70z3", "y", 70, 3, false);
 }
 
 TEST(DenseXWProductFunctionTest, require_that_various_variants_of_xw_product_can_be_optimized)
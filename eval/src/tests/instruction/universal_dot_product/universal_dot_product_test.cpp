@@ -116,6 +116,14 @@ Optimize universal_only() {
     return Optimize::specific("universal_only", my_optimizer);
 }
 
+Optimize universal_generic() {
+    auto my_optimizer = [](const TensorFunction &expr, Stash &stash)->const TensorFunction &
+                        {
+                            return UniversalDotProduct::optimize(expr, stash, true, false);
+                        };
+    return Optimize::specific("universal_generic", my_optimizer);
+}
+
 Trinary tri(bool value) {
     return value ? Trinary::True : Trinary::False;
 }
@@ -125,7 +133,8 @@ bool satisfies(bool actual, Trinary expect) {
 }
 
 void verify(const std::string &expr, select_cell_type_t select_cell_type,
-            Trinary expect_forward, Trinary expect_distinct, Trinary expect_single)
+            Trinary expect_forward, Trinary expect_distinct, Trinary expect_single,
+            Trinary expect_specialized)
 {
     ++verify_cnt;
     auto fun = Function::parse(expr);
@@ -157,6 +166,7 @@ void verify(const std::string &expr, select_cell_type_t select_cell_type,
     EXPECT_TRUE(satisfies(node->forward(), expect_forward));
     EXPECT_TRUE(satisfies(node->distinct(), expect_distinct));
     EXPECT_TRUE(satisfies(node->single(), expect_single));
+    EXPECT_TRUE(satisfies(node->specialized(), expect_specialized));
     InterpretedFunction ifun(prod_factory, optimized);
     InterpretedFunction::Context ctx(ifun);
     const Value &actual = ifun.eval(ctx, params);
@@ -172,10 +182,13 @@ void verify(const std::string &expr, select_cell_type_t select_cell_type,
     EXPECT_EQ(spec_from_value(actual), expected);
 }
 void verify(const std::string &expr) {
-    verify(expr, always_double, Trinary::Undefined, Trinary::Undefined, Trinary::Undefined);
+    verify(expr, always_double, Trinary::Undefined, Trinary::Undefined, Trinary::Undefined, Trinary::Undefined);
 }
 void verify(const std::string &expr, select_cell_type_t select_cell_type, bool forward, bool distinct, bool single) {
-    verify(expr, select_cell_type, tri(forward), tri(distinct), tri(single));
+    verify(expr, select_cell_type, tri(forward), tri(distinct), tri(single), Trinary::Undefined);
+}
+void verify_specialized(const std::string &expr, select_cell_type_t select_cell_type, bool specialized) {
+    verify(expr, select_cell_type, Trinary::Undefined, Trinary::Undefined, Trinary::Undefined, tri(specialized));
 }
 
 using cost_list_t = std::vector<std::pair<std::string,double>>;
@@ -302,6 +315,27 @@ TEST(UniversalDotProductTest, universal_dot_product_works_for_various_cases) {
     // reduce nothing is the scalar case, which satisfies 'forward'
 }
 
+TEST(UniversalDotProductTest, specialized_kernels_are_used_for_simple_forwarding_shapes) {
+    for (CellType lct: CellTypeUtils::list_types()) {
+        for (CellType rct: CellTypeUtils::list_types()) {
+            bool same_float = (lct == rct) && ((lct == CellType::FLOAT) || (lct == CellType::DOUBLE));
+            auto sel2 = select(lct, rct);
+            verify_specialized("reduce(a4_1x8*x8,sum,x)",          sel2, same_float);
+            verify_specialized("reduce(a4_1*x1,sum,x)",            sel2, same_float);
+            verify_specialized("reduce(a4_1x8y16*x8y16,sum,y)",    sel2, same_float);
+            verify_specialized("reduce(a4_1b2_1x8y16*y16,sum,y)",  sel2, same_float);
+            verify_specialized("reduce(a4_1x8y4z2*x8y4z2,sum,z)",  sel2, same_float);
+            verify_specialized("reduce(a4_1x8*x8y4,sum,x)",        sel2, false);
+            verify_specialized("reduce(a4_1x8y4z2*x8z2,sum,z)",    sel2, false);
+            verify_specialized("reduce(a4_1b2_1x8*b2_1x8,sum,b)",  sel2, false);
+            verify_specialized("reduce(a4_1x8*a2_1x8,sum,x)",      sel2, false);
+        }
+    }
+    verify_specialized("reduce(2.0*3.0,sum)", always_double, true);
+    verify_specialized("reduce(x0_0y8*y8,sum,y)", always_double, true);
+    verify_specialized("reduce(x0_0y8z4*y8z4,sum,z)", always_double, true);
+}
+
 TEST(UniversalDotProductTest, universal_dot_product_works_with_complex_dimension_nesting) {
     verify("reduce(a4_1b4_1c4_1x4y3z2w1*a2_1c1_1x4z2,sum,b,c,x)");
 }
@@ -346,7 +380,7 @@ TEST(UniversalDotProductTest, bench_vector_dot_product) {
         fprintf(stderr, "benchmarking disabled, run with 'bench' parameter to enable\n");
         return;
     }
-    auto optimize_list = std::vector<Optimize>({baseline(), with_universal(), universal_only()});
+    auto optimize_list = std::vector<Optimize>({baseline(), with_universal(), universal_only(), universal_generic()});
 
     benchmark("reduce(2.0*3.0,sum)",                    optimize_list);
     benchmark("reduce(5.0*x128,sum,x)",                 optimize_list);
@@ -371,6 +405,10 @@ TEST(UniversalDotProductTest, bench_vector_dot_product) {
     benchmark("reduce(b64_1x8y128*x8y128,sum,y)",       optimize_list);
     benchmark("reduce(b64_1x128*x128,sum,b,x)",         optimize_list);
     benchmark("reduce(a1_1x128*a2_1b64_1x128,sum,a,x)", optimize_list);
+    benchmark("reduce(b8_1x16*x16,sum,x)",              optimize_list);
+    benchmark("reduce(b256_1x32*x32,sum,x)",            optimize_list);
+    benchmark("reduce(b8_1x8y16*x8y16,sum,y)",          optimize_list);
+    benchmark("reduce(b64_1x32y32*y32,sum,y)",          optimize_list);
 
     size_t max_expr_size = 0;
     for (const auto &[expr, cost_list]: benchmark_results) {
@@ -385,6 +423,7 @@ TEST(UniversalDotProductTest, bench_vector_dot_product) {
         double baseline_cost = 0.0;
         double with_universal_cost = 0.0;
         double universal_only_cost = 0.0;
+        double universal_generic_cost = 0.0;
         for (const auto &[name, cost]: cost_list) {
             if (++cnt > 1) {
                 fprintf(stderr, ", ");
@@ -395,6 +434,8 @@ TEST(UniversalDotProductTest, bench_vector_dot_product) {
                 with_universal_cost = cost;
             } else if (name == "universal_only") {
                 universal_only_cost = cost;
+            } else if (name == "universal_generic") {
+                universal_generic_cost = cost;
             }
             fprintf(stderr, "%s: %8.3f us", name.c_str(), cost);
         }
@@ -407,6 +448,9 @@ TEST(UniversalDotProductTest, bench_vector_dot_product) {
         if (with_universal_cost > 1.1 * universal_only_cost) {
             fprintf(stderr, ", MISSED: %8.3f", with_universal_cost / universal_only_cost);
         }
+        if (universal_generic_cost > 1.1 * universal_only_cost) {
+            fprintf(stderr, ", SPECIALIZED: %8.3f", universal_generic_cost / universal_only_cost);
+        }
         fprintf(stderr, "\n");
     }
     fprintf(stderr, "\n");
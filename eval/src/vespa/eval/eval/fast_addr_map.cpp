@@ -1,7 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "fast_addr_map.h"
-#include <vespa/vespalib/stllike/hashtable.hpp>
+#include <vespa/vespalib/stllike/swiss_hashtable.hpp>
 
 namespace vespalib::eval {
 
@@ -5,13 +5,14 @@
 #include "memory_usage_stuff.h"
 #include <vespa/vespalib/util/string_id.h>
 #include <vespa/vespalib/stllike/identity.h>
-#include <vespa/vespalib/stllike/hashtable.h>
+#include <vespa/vespalib/stllike/swiss_hashtable.h>
+#include <algorithm>
 #include <span>
 
 namespace vespalib::eval {
 
 /**
- * A wrapper around vespalib::hashtable, using it to map a list of
+ * A wrapper around vespalib::swiss_hashtable, using it to map a list of
  * labels (a sparse address) to an integer value (dense subspace
  * index). Labels are represented by string enum values stored and
  * handled outside this class.
@@ -97,7 +98,7 @@ public:
         bool operator()(const Entry &a, string_id b) const { return (a.hash == b.value()); }
     };
 
-    using HashType = hashtable<Entry, Entry, Hash, Equal, Identity, hashtable_base::and_modulator>;
+    using HashType = swiss_hashtable<Entry, Entry, Hash, Equal, Identity>;
 
 private:
     LabelView _labels;
@@ -113,6 +114,8 @@ public:
     static constexpr size_t npos() noexcept { return -1; }
     std::span<const string_id> get_addr(size_t idx) const noexcept { return _labels.get_addr(idx); }
     size_t size() const noexcept { return _map.size(); }
+    // Removes all mappings, keeping allocated memory. The labels must be cleared by the owner.
+    void clear() { _map.clear(); }
     constexpr size_t addr_size() const noexcept { return _labels.addr_size; }
     const StringIdVector &labels() const noexcept { return _labels.labels; }
     template <typename T>
@@ -133,6 +136,44 @@ public:
             ? lookup_singledim(self(addr[0]))
             : lookup(addr, hash_labels(addr));
     }
+    // prefetch the part of the map probed when looking up an address with the given hash
+    void prefetch(uint32_t hash) const noexcept {
+        _map.prefetch(AltKey<string_id>{{}, hash});
+    }
+    // how many lookups ahead lookup_many prefetches
+    static constexpr size_t prefetch_distance = 8;
+    // look up all addresses of another map with the same dimensions,
+    // calling f(other_subspace, subspace) for each of them, where
+    // subspace is npos() if the address is not found. Lookups are
+    // prefetched ahead of probing to overlap cache misses.
+    template <typename F>
+    void lookup_many(const FastAddrMap &other, F &&f) const {
+        size_t n = other.size();
+        size_t ahead = std::min(n, prefetch_distance);
+        if (addr_size() == 1) {
+            const auto &labels = other.labels();
+            for (size_t i = 0; i < ahead; ++i) {
+                prefetch(hash_label(labels[i]));
+            }
+            for (size_t i = 0; i < n; ++i) {
+                if (i + prefetch_distance < n) {
+                    prefetch(hash_label(labels[i + prefetch_distance]));
+                }
+                f(i, lookup_singledim(labels[i]));
+            }
+        } else {
+            for (size_t i = 0; i < ahead; ++i) {
+                prefetch(hash_labels(other.get_addr(i)));
+            }
+            for (size_t i = 0; i < n; ++i) {
+                if (i + prefetch_distance < n) {
+                    prefetch(hash_labels(other.get_addr(i + prefetch_distance)));
+                }
+                auto addr = other.get_addr(i);
+                f(i, lookup(addr, hash_labels(addr)));
+            }
+        }
+    }
     void add_mapping(uint32_t hash) {
         uint32_t idx = _map.size();
         _map.force_insert(Entry{{idx}, hash});
@@ -8,6 +8,7 @@
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <arpa/inet.h>
 
 namespace vespalib::eval::gbdt {
@@ -146,7 +147,8 @@ constexpr size_t max_leafs() { return (sizeof(T) * bits_per_byte); }
 template <typename T>
 struct FixedContext : FastForest::Context {
     std::vector<T> masks;
-    FixedContext(size_t num_trees) : masks(num_trees) {}
+    std::vector<T> batch_masks; // [tree][doc]
+    FixedContext(size_t num_trees) : masks(num_trees), batch_masks(num_trees * FastForest::batch_size) {}
 };
 
 template <typename T>
@@ -196,10 +198,13 @@ struct FixedForest : FastForest {
     static void apply_masks(T *ctx_masks, const Mask *pos, const Mask *end, float limit);
     static void apply_masks(T *ctx_masks, const DMask *pos, const DMask *end);
     double get_result(const T *ctx_masks) const;
+    void eval_chunk(T *ctx_masks, const float *params, size_t stride, size_t num_docs, double *results) const;
 
     std::string impl_name() const override { return fixed_impl_name<T>(); }
+    size_t num_params() const override { return _mask_sizes.size(); }
     Context::UP create_context() const override;
     double eval(Context &context, const float *params) const override;
+    void eval_batch(Context &context, const float *params, size_t num_docs, double *results) const override;
 };
 
 template <typename T>
@@ -335,6 +340,79 @@ FixedForest<T>::eval(Context &context, const float *params) const
     return get_result(ctx_masks);
 }
 
+// Masks are kept for batch_size documents per tree, and each mask is
+// applied to all documents with a branch-free inner loop that can be
+// vectorized. Padding documents (beyond num_docs) and documents with a
+// missing feature value get a limit no mask value is below. The leaf
+// values are summed in the same order as in get_result.
+template <typename T>
+void
+FixedForest<T>::eval_chunk(T *ctx_masks, const float *params, size_t stride, size_t num_docs, double *results) const
+{
+    constexpr size_t B = FastForest::batch_size;
+    constexpr float no_limit = -std::numeric_limits<float>::infinity();
+    memset(ctx_masks, 0xff, _num_trees * B * sizeof(T));
+    const Mask *mask_pos = &_masks[0];
+    for (size_t feature = 0; feature < _mask_sizes.size(); ++feature) {
+        const float *column = params + (feature * stride);
+        float limits[B];
+        T missing[B];
+        float max_limit = no_limit;
+        bool any_missing = false;
+        for (size_t d = 0; d < B; ++d) {
+            float value = (d < num_docs) ? column[d] : no_limit;
+            bool is_missing = std::isnan(value);
+            limits[d] = is_missing ? no_limit : value;
+            missing[d] = is_missing ? T(0) : T(~T(0));
+            max_limit = std::max(max_limit, limits[d]);
+            any_missing |= is_missing;
+        }
+        const Mask *end = mask_pos + _mask_sizes[feature];
+        for (const Mask *pos = mask_pos; (pos < end) && !(max_limit < pos->value); ++pos) {
+            T *dst = ctx_masks + (pos->tree * B);
+            for (size_t d = 0; d < B; ++d) {
+                dst[d] &= (limits[d] < pos->value) ? T(~T(0)) : pos->bits;
+            }
+        }
+        if (any_missing) {
+            const DMask *pos = &_default_masks[_default_offsets[feature]];
+            const DMask *dend = &_default_masks[_default_offsets[feature + 1]];
+            for (; pos < dend; ++pos) {
+                T *dst = ctx_masks + (pos->tree * B);
+                for (size_t d = 0; d < B; ++d) {
+                    dst[d] &= (pos->bits | missing[d]);
+                }
+            }
+        }
+        mask_pos = end;
+    }
+    double result1[B] = {};
+    double result2[B] = {};
+    size_t paired_trees = (_num_trees & ~size_t(3));
+    for (size_t tree = 0; tree < _num_trees; ++tree) {
+        const float *leafs = &_padded_leafs[tree * _max_leafs];
+        const T *src = ctx_masks + (tree * B);
+        double *dst = ((tree < paired_trees) && ((tree & 1) != 0)) ? result2 : result1;
+        for (size_t d = 0; d < B; ++d) {
+            dst[d] += leafs[get_lsb(src[d])];
+        }
+    }
+    for (size_t d = 0; d < num_docs; ++d) {
+        results[d] = (result1[d] + result2[d]);
+    }
+}
+
+template <typename T>
+void
+FixedForest<T>::eval_batch(Context &context, const float *params, size_t num_docs, double *results) const
+{
+    T *ctx_masks = &static_cast<FixedContext<T>&>(context).batch_masks[0];
+    for (size_t offset = 0; offset < num_docs; offset += FastForest::batch_size) {
+        size_t n = std::min(FastForest::batch_size, num_docs - offset);
+        eval_chunk(ctx_masks, params + offset, num_docs, n, results + offset);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // implementation using multiple words for each tree
 //-----------------------------------------------------------------------------
@@ -438,6 +516,7 @@ struct MultiWordForest : FastForest {
     double get_result(const uint32_t *ctx_words) const;
 
     std::string impl_name() const override { return "ff-multiword"; }
+    size_t num_params() const override { return _mask_sizes.size(); }
     Context::UP create_context() const override;
     double eval(Context &context, const float *params) const override;
 };
@@ -661,6 +740,19 @@ FastForest::try_convert(const Function &fun, size_t min_fixed, size_t max_fixed)
     return FastForest::UP();
 }
 
+void
+FastForest::eval_batch(Context &context, const float *params, size_t num_docs, double *results) const
+{
+    size_t n = num_params();
+    context.doc_params.resize(n);
+    for (size_t doc = 0; doc < num_docs; ++doc) {
+        for (size_t i = 0; i < n; ++i) {
+            context.doc_params[i] = params[(i * num_docs) + doc];
+        }
+        results[doc] = eval(context, context.doc_params.data());
+    }
+}
+
 double
 FastForest::estimate_cost_us(const std::vector<double> &params, double budget) const
 {
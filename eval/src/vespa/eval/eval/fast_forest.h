@@ -5,6 +5,7 @@
 #include "function.h"
 #include <vespa/vespalib/util/optimized.h>
 #include <memory>
+#include <vector>
 #include <cassert>
 #include <cmath>
 
@@ -31,11 +32,23 @@ public:
     public:
         virtual ~Context();
         using UP = std::unique_ptr<Context>;
+        std::vector<float> doc_params; // used by the default eval_batch
     };
+    // number of documents evaluated together by eval_batch
+    static constexpr size_t batch_size = 16;
     static UP try_convert(const Function &fun, size_t min_fixed = 8, size_t max_fixed = 64);
     virtual std::string impl_name() const = 0;
+    virtual size_t num_params() const = 0;
     virtual Context::UP create_context() const = 0;
     virtual double eval(Context &context, const float *params) const = 0;
+
+    /**
+     * Evaluate the forest for multiple documents. The parameters are
+     * given in feature-major order; the value of feature i for
+     * document j is params[(i * num_docs) + j]. The default
+     * implementation evaluates one document at a time.
+     **/
+    virtual void eval_batch(Context &context, const float *params, size_t num_docs, double *results) const;
     double estimate_cost_us(const std::vector<double> &params, double budget = 5.0) const;
 };
 
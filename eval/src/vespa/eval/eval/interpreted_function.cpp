@@ -7,17 +7,25 @@
 #include "make_tensor_function.h"
 #include "optimize_tensor_function.h"
 #include "compile_tensor_function.h"
+#include "inline_operation.h"
+#include "tensor_function.h"
 #include <vespa/vespalib/util/classname.h>
 #include <vespa/eval/eval/llvm/compile_cache.h>
 #include <vespa/eval/eval/llvm/addr_to_symbol.h>
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
 #include <set>
 
 namespace vespalib::eval {
 
 namespace {
 
+// value at the given depth from the top of the stack (0 is top), or nullptr
+const Value *top_value(const std::vector<Value::CREF> &stack, size_t depth) {
+    return (depth < stack.size()) ? &stack[stack.size() - 1 - depth].get() : nullptr;
+}
+
 const Function *get_simple_lambda(const nodes::Node &node) {
     if (auto ptr = nodes::as<nodes::TensorMap>(node)) {
         return &ptr->lambda();
@@ -46,6 +54,84 @@ const Function *get_complex_lambda(const nodes::Node &node) {
 
 void my_nop(InterpretedFunction::State &, uint64_t) {}
 
+using BatchStep = InterpretedFunction::BatchStep;
+
+void my_batch_const(const BatchStep &step, const double * const *, double *dst, size_t n) {
+    std::fill(dst, dst + n, step.number);
+}
+
+template <typename Func>
+void my_batch_map(const BatchStep &step, const double * const *columns, double *dst, size_t n) {
+    Func fun(step.op1);
+    operation::apply_op1_vec(dst, columns[step.a], n, fun);
+}
+
+template <typename Func>
+void my_batch_join(const BatchStep &step, const double * const *columns, double *dst, size_t n) {
+    Func fun(step.op2);
+    operation::apply_op2_vec_vec(dst, columns[step.a], columns[step.b], n, fun);
+}
+
+void my_batch_if(const BatchStep &step, const double * const *columns, double *dst, size_t n) {
+    const double *cond = columns[step.a];
+    const double *true_value = columns[step.b];
+    const double *false_value = columns[step.c];
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = (cond[i] != 0.0) ? true_value[i] : false_value[i];
+    }
+}
+
+struct SelectBatchMap {
+    template <typename Func> static auto invoke() { return my_batch_map<Func>; }
+};
+
+struct SelectBatchJoin {
+    template <typename Func> static auto invoke() { return my_batch_join<Func>; }
+};
+
+// Both branches of an if are calculated for all documents,
+// which gives the same result since the steps have no side effects.
+struct BatchProgramBuilder {
+    std::vector<BatchStep> steps;
+    bool ok = true;
+    uint32_t add(BatchStep step) {
+        steps.push_back(step);
+        return steps.size() - 1;
+    }
+    uint32_t make(const TensorFunction &node) {
+        using namespace tensor_function;
+        if (!ok || !node.result_type().is_double()) {
+            ok = false;
+            return 0;
+        }
+        if (auto inject = as<Inject>(node)) {
+            return add(BatchStep{nullptr, uint32_t(inject->param_idx()), 0, 0, 0.0, nullptr, nullptr});
+        }
+        if (auto constant = as<ConstValue>(node)) {
+            return add(BatchStep{my_batch_const, 0, 0, 0, constant->value().as_double(), nullptr, nullptr});
+        }
+        if (auto map = as<Map>(node)) {
+            uint32_t a = make(map->child());
+            auto fun = typify_invoke<1,operation::TypifyOp1,SelectBatchMap>(map->function());
+            return add(BatchStep{fun, a, 0, 0, 0.0, map->function(), nullptr});
+        }
+        if (auto join = as<Join>(node)) {
+            uint32_t a = make(join->lhs());
+            uint32_t b = make(join->rhs());
+            auto fun = typify_invoke<1,operation::TypifyOp2,SelectBatchJoin>(join->function());
+            return add(BatchStep{fun, a, b, 0, 0.0, nullptr, join->function()});
+        }
+        if (auto if_node = as<If>(node)) {
+            uint32_t a = make(if_node->cond());
+            uint32_t b = make(if_node->true_child());
+            uint32_t c = make(if_node->false_child());
+            return add(BatchStep{my_batch_if, a, b, c, 0.0, nullptr, nullptr});
+        }
+        ok = false;
+        return 0;
+    }
+};
+
 } // namespace vespalib::<unnamed>
 
 
@@ -55,7 +141,8 @@ InterpretedFunction::State::State(const ValueBuilderFactory &factory_in)
       stash(),
       stack(),
       program_offset(0),
-      if_cnt(0)
+      if_cnt(0),
+      heap_values(0)
 {
 }
 
@@ -68,6 +155,7 @@ InterpretedFunction::State::init(const LazyParams &params_in) {
     stack.clear();
     program_offset = 0;
     if_cnt = 0;
+    heap_values = 0;
 }
 
 InterpretedFunction::Context::Context(const InterpretedFunction &ifun)
@@ -77,12 +165,21 @@ InterpretedFunction::Context::Context(const InterpretedFunction &ifun)
 
 InterpretedFunction::ProfiledContext::ProfiledContext(const InterpretedFunction &ifun)
   : context(ifun),
-    cost(ifun.program_size(), std::make_pair(size_t(0), duration::zero()))
+    cost(ifun.program_size(), std::make_pair(size_t(0), duration::zero())),
+    cells(ifun.program_size(), 0)
 {
 }
 
 InterpretedFunction::ProfiledContext::~ProfiledContext() = default;
 
+InterpretedFunction::BatchContext::BatchContext(const InterpretedFunction &ifun)
+  : _space(ifun._batch_program.size() * max_batch_size, 0.0),
+    _columns(ifun._batch_program.size(), nullptr)
+{
+}
+
+InterpretedFunction::BatchContext::~BatchContext() = default;
+
 std::string
 InterpretedFunction::Instruction::resolve_symbol() const
 {
@@ -100,24 +197,39 @@ InterpretedFunction::Instruction::nop()
 
 InterpretedFunction::InterpretedFunction(const ValueBuilderFactory &factory, const TensorFunction &function, CTFMetaData *meta)
     : _program(),
+      _batch_program(),
       _stash(),
       _factory(factory)
 {
     _program = compile_tensor_function(factory, function, _stash, meta);
+    setup_batch(function);
 }
 
-InterpretedFunction::InterpretedFunction(const ValueBuilderFactory &factory, const nodes::Node &root, const NodeTypes &types)
+InterpretedFunction::InterpretedFunction(const ValueBuilderFactory &factory, const nodes::Node &root, const NodeTypes &types,
+                                         CTFMetaData *meta)
     : _program(),
+      _batch_program(),
       _stash(),
       _factory(factory)
 {
     const TensorFunction &plain_fun = make_tensor_function(factory, root, types, _stash);
     const TensorFunction &optimized = optimize_tensor_function(factory, plain_fun, _stash);
-    _program = compile_tensor_function(factory, optimized, _stash, nullptr);
+    _program = compile_tensor_function(factory, optimized, _stash, meta);
+    setup_batch(plain_fun);
 }
 
 InterpretedFunction::~InterpretedFunction() = default;
 
+void
+InterpretedFunction::setup_batch(const TensorFunction &function)
+{
+    BatchProgramBuilder builder;
+    builder.make(function);
+    if (builder.ok) {
+        _batch_program = std::move(builder.steps);
+    }
+}
+
 const Value &
 InterpretedFunction::eval(Context &ctx, const LazyParams &params) const
 {
@@ -138,16 +250,61 @@ InterpretedFunction::eval(ProfiledContext &pctx, const LazyParams &params) const
     state.init(params);
     while (state.program_offset < _program.size()) {
         auto pos = state.program_offset;                 // Profiling
+        auto prev_top = top_value(state.stack, 0);       // Profiling
+        auto prev_below = top_value(state.stack, 1);     // Profiling
         auto before = steady_clock::now();               // Profiling
         _program[state.program_offset++].perform(state);
         auto after = steady_clock::now();                // Profiling
         ++pctx.cost[pos].first;                          // Profiling
         pctx.cost[pos].second += (after - before);       // Profiling
+        auto top = top_value(state.stack, 0);            // Profiling
+        if (top && (top != prev_top) && (top != prev_below)) { // Profiling
+            pctx.cells[pos] += top->cells().size;        // Profiling
+        }                                                // Profiling
     }
     assert(state.stack.size() == 1);
     return state.stack.back();
 }
 
+const Value &
+InterpretedFunction::eval(Context &ctx, const LazyParams &params,
+                          ExecutionProfiler &profiler, std::span<const ExecutionProfiler::TaskId> tasks) const
+{
+    assert(tasks.size() == _program.size());
+    State &state = ctx._state;
+    state.init(params);
+    while (state.program_offset < _program.size()) {
+        profiler.start(tasks[state.program_offset]);     // Profiling
+        _program[state.program_offset++].perform(state);
+        profiler.complete();                             // Profiling
+    }
+    assert(state.stack.size() == 1);
+    return state.stack.back();
+}
+
+void
+InterpretedFunction::eval_batch(BatchContext &ctx, std::span<const double * const> params, std::span<double> result) const
+{
+    assert(supports_batch());
+    auto &columns = ctx._columns;
+    for (size_t offset = 0; offset < result.size(); offset += max_batch_size) {
+        size_t n = std::min(max_batch_size, result.size() - offset);
+        for (size_t i = 0; i < _batch_program.size(); ++i) {
+            const BatchStep &step = _batch_program[i];
+            if (step.function == nullptr) {
+                assert(step.a < params.size());
+                columns[i] = params[step.a] + offset;
+            } else {
+                double *dst = ctx._space.data() + (i * max_batch_size);
+                step.function(step, columns.data(), dst, n);
+                columns[i] = dst;
+            }
+        }
+        const double *res = columns.back();
+        std::copy(res, res + n, result.begin() + offset);
+    }
+}
+
 double
 InterpretedFunction::estimate_cost_us(const std::vector<double> &params, double budget) const
 {
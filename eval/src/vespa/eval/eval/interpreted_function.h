@@ -6,8 +6,10 @@
 #include "function.h"
 #include "node_types.h"
 #include "lazy_params.h"
+#include <vespa/vespalib/util/execution_profiler.h>
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/util/time.h>
+#include <span>
 
 namespace vespalib::eval {
 
@@ -37,11 +39,18 @@ public:
         std::vector<Value::CREF>   stack;
         uint32_t                   program_offset;
         uint32_t                   if_cnt;
+        uint32_t                   heap_values;
 
         State(const ValueBuilderFactory &factory_in);
         ~State();
 
         void init(const LazyParams &params_in);
+        // keep a value that could not be allocated in the stash alive
+        // until the next evaluation (counted to track heap usage)
+        const Value &keep(std::unique_ptr<Value> value) {
+            ++heap_values;
+            return *stash.create<std::unique_ptr<Value>>(std::move(value));
+        }
         const Value &peek(size_t ridx) const {
             return stack[stack.size() - 1 - ridx];
         }
@@ -69,13 +78,50 @@ public:
     public:
         explicit Context(const InterpretedFunction &ifun);
         uint32_t if_cnt() const { return _state.if_cnt; }
+        // number of intermediate values allocated on the heap by the last evaluation
+        uint32_t heap_values() const { return _state.heap_values; }
     };
     struct ProfiledContext {
         Context context;
+        // (count, time) per instruction
         std::vector<std::pair<size_t,duration>> cost;
+        // total number of result cells produced per instruction
+        std::vector<size_t> cells;
         ProfiledContext(const InterpretedFunction &ifun);
         ~ProfiledContext();
     };
+    /**
+     * Used to evaluate a function for a batch of documents at a
+     * time. Only functions where the parameters, the result and all
+     * intermediate values are numbers can be evaluated this way; see
+     * supports_batch.
+     **/
+    class BatchContext {
+        friend class InterpretedFunction;
+    private:
+        std::vector<double>         _space;
+        std::vector<const double *> _columns;
+    public:
+        explicit BatchContext(const InterpretedFunction &ifun);
+        ~BatchContext();
+    };
+    /**
+     * A single step in the program used for batch evaluation. Each
+     * step calculates one column of values, with one value per
+     * document in the batch, from the columns of earlier steps
+     * (a, b, c) or from a parameter column (a).
+     **/
+    struct BatchStep {
+        using batch_function = void (*)(const BatchStep &step, const double * const *columns, double *dst, size_t n);
+        batch_function function; // nullptr means fetch parameter a
+        uint32_t       a;
+        uint32_t       b;
+        uint32_t       c;
+        double         number;
+        double (*op1)(double);
+        double (*op2)(double, double);
+    };
+    static constexpr size_t max_batch_size = 64;
     using op_function = void (*)(State &, uint64_t);
     class Instruction {
     private:
@@ -102,16 +148,21 @@ public:
 
 private:
     std::vector<Instruction>   _program;
+    std::vector<BatchStep>     _batch_program;
     Stash                      _stash;
     const ValueBuilderFactory &_factory;
 
+    void setup_batch(const TensorFunction &function);
+
 public:
     using UP = std::unique_ptr<InterpretedFunction>;
     // for testing; use with care; the tensor function must be kept alive
     InterpretedFunction(const ValueBuilderFactory &factory, const TensorFunction &function, CTFMetaData *meta);
     InterpretedFunction(const ValueBuilderFactory &factory, const TensorFunction &function)
       : InterpretedFunction(factory, function, nullptr) {}
-    InterpretedFunction(const ValueBuilderFactory &factory, const nodes::Node &root, const NodeTypes &types);
+    InterpretedFunction(const ValueBuilderFactory &factory, const nodes::Node &root, const NodeTypes &types, CTFMetaData *meta);
+    InterpretedFunction(const ValueBuilderFactory &factory, const nodes::Node &root, const NodeTypes &types)
+        : InterpretedFunction(factory, root, types, nullptr) {}
     InterpretedFunction(const ValueBuilderFactory &factory, const Function &function, const NodeTypes &types)
         : InterpretedFunction(factory, function.root(), types) {}
     InterpretedFunction(InterpretedFunction &&rhs) = default;
@@ -119,6 +170,26 @@ public:
     size_t program_size() const { return _program.size(); }
     const Value &eval(Context &ctx, const LazyParams &params) const;
     const Value &eval(ProfiledContext &ctx, const LazyParams &params) const;
+    // track each instruction as a separate task in the profiler (tasks has one entry per instruction)
+    const Value &eval(Context &ctx, const LazyParams &params,
+                      ExecutionProfiler &profiler, std::span<const ExecutionProfiler::TaskId> tasks) const;
+
+    /**
+     * Check if this function can be evaluated for multiple documents
+     * at a time using eval_batch.
+     **/
+    bool supports_batch() const { return !_batch_program.empty(); }
+
+    /**
+     * Evaluate this function for a batch of documents. Each step of
+     * the batch program is performed for all documents before moving
+     * on to the next one, using tight loops over columns of numbers.
+     *
+     * @param ctx context holding the intermediate columns
+     * @param params one column of values per parameter, with one value per document
+     * @param result where to store the result for each document
+     **/
+    void eval_batch(BatchContext &ctx, std::span<const double * const> params, std::span<double> result) const;
     double estimate_cost_us(const std::vector<double> &params, double budget = 5.0) const;
     static Function::Issues detect_issues(const Function &function);
 
@@ -93,6 +93,10 @@ public:
     static ExecutorBinding::UP bind(std::shared_ptr<Executor> executor) {
         return std::make_unique<ExecutorBinding>(std::move(executor), ExecutorBinding::ctor_tag());
     }
+    // Store generated machine code in the given directory, and reuse it
+    // when the same function is compiled again, also after a restart.
+    static void set_persistent_dir(const std::string &dir) { LLVMObjectCache::set_dir(dir); }
+    static LLVMObjectCache::Stats persistent_stats() { return LLVMObjectCache::get_stats(); }
     static size_t num_cached();
     static size_t num_bound();
     static size_t count_refs();
@@ -18,12 +18,27 @@
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
 #endif
 #include <llvm/Support/ManagedStatic.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Config/llvm-config.h>
+#if LLVM_VERSION_MAJOR < 17
+#include <llvm/Support/Host.h>
+#else
+#include <llvm/TargetParser/Host.h>
+#endif
 #include <vespa/eval/eval/check_type.h>
 #include <vespa/vespalib/stllike/hash_set.h>
 #include <vespa/vespalib/util/approx.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/malloc_mmap_guard.h>
+#include <vespa/vespalib/stllike/hash_fun.h>
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
 #include <limits>
+#include <unistd.h>
 
 #if LLVM_VERSION_MAJOR < 18
 using CodeGenOptLevel = llvm::CodeGenOpt::Level;
@@ -687,9 +702,98 @@ struct InitializeNativeTarget {
     }
 } initialize_native_target;
 
+namespace {
+
+std::mutex object_cache_lock;
+std::string object_cache_dir;
+std::atomic<size_t> object_cache_hits(0);
+std::atomic<size_t> object_cache_misses(0);
+std::atomic<size_t> object_cache_tmp_seq(0);
+
+std::string make_host_cpu_spec() {
+    std::string spec = llvm::sys::getHostCPUName().str();
+#if LLVM_VERSION_MAJOR < 19
+    llvm::StringMap<bool> features;
+    llvm::sys::getHostCPUFeatures(features);
+#else
+    llvm::StringMap<bool> features = llvm::sys::getHostCPUFeatures();
+#endif
+    std::vector<std::string> enabled;
+    for (const auto &entry: features) {
+        if (entry.getValue()) {
+            enabled.push_back(entry.getKey().str());
+        }
+    }
+    std::sort(enabled.begin(), enabled.end());
+    for (const auto &feature: enabled) {
+        spec.append(",").append(feature);
+    }
+    return spec;
+}
+
+const std::string &host_cpu_spec() {
+    static const std::string spec = make_host_cpu_spec();
+    return spec;
+}
+
+class DiskObjectCache : public llvm::ObjectCache {
+private:
+    std::string _file_name;
+public:
+    explicit DiskObjectCache(std::string file_name) : _file_name(std::move(file_name)) {}
+    void notifyObjectCompiled(const llvm::Module *, llvm::MemoryBufferRef obj) override {
+        // write to a unique temporary file first, since the same function may be compiled concurrently
+        auto tmp_name = make_string("%s.%d.%zu.tmp", _file_name.c_str(), getpid(), object_cache_tmp_seq++);
+        {
+            std::ofstream out(tmp_name, std::ios::binary | std::ios::trunc);
+            out.write(obj.getBufferStart(), obj.getBufferSize());
+            out.close();
+            if (!out.good()) {
+                std::remove(tmp_name.c_str());
+                return;
+            }
+        }
+        if (std::rename(tmp_name.c_str(), _file_name.c_str()) != 0) {
+            std::remove(tmp_name.c_str());
+        }
+    }
+    std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *) override {
+        auto buffer = llvm::MemoryBuffer::getFile(_file_name);
+        if (!buffer) {
+            ++object_cache_misses;
+            return {};
+        }
+        ++object_cache_hits;
+        return std::move(buffer.get());
+    }
+};
+
+}
+
+void
+LLVMObjectCache::set_dir(const std::string &dir)
+{
+    std::lock_guard guard(object_cache_lock);
+    object_cache_dir = dir;
+}
+
+std::string
+LLVMObjectCache::get_dir()
+{
+    std::lock_guard guard(object_cache_lock);
+    return object_cache_dir;
+}
+
+LLVMObjectCache::Stats
+LLVMObjectCache::get_stats()
+{
+    return {object_cache_hits.load(std::memory_order_relaxed), object_cache_misses.load(std::memory_order_relaxed)};
+}
+
 LLVMWrapper::LLVMWrapper()
     : _context(),
       _module(),
+      _object_cache(),
       _engine(),
       _functions(),
       _forests(),
@@ -726,15 +830,36 @@ LLVMWrapper::make_forest_fragment(size_t num_params, const std::vector<const Nod
     return function_id;
 }
 
+std::string
+LLVMWrapper::make_object_cache_file() const
+{
+    std::string dir = LLVMObjectCache::get_dir();
+    if (dir.empty() || !_forests.empty() || !_plugin_state.empty()) {
+        return {};
+    }
+    std::string key;
+    llvm::raw_string_ostream key_stream(key);
+    _module->print(key_stream, nullptr);
+    key_stream << LLVM_VERSION_STRING << "\n" << host_cpu_spec() << "\n";
+    key_stream.flush();
+    uint64_t hash = vespalib::hashValue(key.data(), key.size());
+    return make_string("%s/%016" PRIx64 ".o", dir.c_str(), hash);
+}
+
 void
 LLVMWrapper::compile(llvm::raw_ostream * dumpStream)
 {
     if (dumpStream) {
         _module->print(*dumpStream, nullptr);
     }
+    std::string object_cache_file = make_object_cache_file();
     // Set relocation model to silence valgrind on CentOS 8 / aarch64
     _engine.reset(llvm::EngineBuilder(std::move(_module)).setOptLevel(CodeGenOptLevel::Aggressive).setRelocationModel(llvm::Reloc::Static).create());
     assert(_engine && "llvm jit not available for your platform");
+    if (!object_cache_file.empty()) {
+        _object_cache = std::make_unique<DiskObjectCache>(std::move(object_cache_file));
+        _engine->setObjectCache(_object_cache.get());
+    }
 
     MallocMmapGuard largeAllocsAsMMap(1_Mi);
     _engine->finalizeObject();
@@ -751,6 +876,7 @@ LLVMWrapper::~LLVMWrapper() {
     _forests.clear();
     _functions.clear();
     _engine.reset();
+    _object_cache.reset();
     _module.reset();
     _context.reset();
 }
@@ -8,6 +8,7 @@
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
 #include <mutex>
 
 extern "C" {
@@ -37,6 +38,25 @@ struct PluginState {
     virtual ~PluginState() = default;
 };
 
+/**
+ * Persistent cache of the machine code generated by llvm, used to
+ * avoid compiling the same functions again after a restart. Each
+ * module is stored as an object file in the cache directory, named
+ * by a hash of the module IR, the llvm version and the host cpu
+ * (name and enabled features). Modules referring to process local
+ * state (forests and plugin state) are never cached.
+ **/
+struct LLVMObjectCache {
+    struct Stats {
+        size_t hits;
+        size_t misses;
+    };
+    // an empty directory disables the cache (default)
+    static void set_dir(const std::string &dir);
+    static std::string get_dir();
+    static Stats get_stats();
+};
+
 /**
  * Stuff related to LLVM code generation is wrapped in this
  * class. This is mostly used by the CompiledFunction class.
@@ -46,11 +66,13 @@ class LLVMWrapper
 private:
     std::unique_ptr<llvm::LLVMContext>     _context;
     std::unique_ptr<llvm::Module>          _module;
+    std::unique_ptr<llvm::ObjectCache>     _object_cache;
     std::unique_ptr<llvm::ExecutionEngine> _engine;
     std::vector<llvm::Function*>           _functions;
     std::vector<gbdt::Forest::UP>          _forests;
     std::vector<PluginState::UP>           _plugin_state;
 
+    std::string make_object_cache_file() const;
     void compile(llvm::raw_ostream * dumpStream);
 public:
     LLVMWrapper();
@@ -4,6 +4,7 @@
 #include <vespa/vespalib/objects/objectvisitor.h>
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/operation.h>
+#include <vespa/vespalib/hwaccelerated/iaccelerated.h>
 #include <cassert>
 #include <cblas.h>
 
@@ -14,6 +15,8 @@ using namespace operation;
 
 namespace {
 
+static const auto &hw = hwaccelerated::IAccelerated::getAccelerator();
+
 template <typename LCT, typename RCT, typename OCT, bool lhs_common_inner, bool rhs_common_inner>
 OCT my_dot_product(const LCT *lhs, const RCT *rhs, size_t lhs_size, size_t common_size, size_t rhs_size) {
     OCT result = 0.0;
@@ -73,6 +76,38 @@ void my_cblas_float_matmul_op(InterpretedFunction::State &state, uint64_t param)
     state.pop_pop_push(state.stash.create<DenseValueView>(self.result_type, TypedCells(dst_cells)));
 }
 
+// int8 cells with the common dimension innermost, transposing into the stash if needed
+const int8_t *int8_common_inner(TypedCells cells, size_t size, size_t common_size, bool common_inner, Stash &stash) {
+    const Int8Float *src = cells.unsafe_typify<Int8Float>().data();
+    if (common_inner) {
+        return reinterpret_cast<const int8_t *>(src);
+    }
+    auto dst = stash.create_uninitialized_array<int8_t>(size * common_size);
+    for (size_t i = 0; i < size; ++i) {
+        for (size_t c = 0; c < common_size; ++c) {
+            dst[(i * common_size) + c] = src[(c * size) + i].get_bits();
+        }
+    }
+    return dst.data();
+}
+
+// int8 x int8 products are summed exactly as integers using the
+// accelerated integer dot product (VNNI on x86, dotprod on ARM)
+template <bool lhs_common_inner, bool rhs_common_inner>
+void my_int8_matmul_op(InterpretedFunction::State &state, uint64_t param) {
+    const DenseMatMulFunction::Self &self = unwrap_param<DenseMatMulFunction::Self>(param);
+    const int8_t *lhs = int8_common_inner(state.peek(1).cells(), self.lhs_size, self.common_size, lhs_common_inner, state.stash);
+    const int8_t *rhs = int8_common_inner(state.peek(0).cells(), self.rhs_size, self.common_size, rhs_common_inner, state.stash);
+    auto dst_cells = state.stash.create_uninitialized_array<float>(self.lhs_size * self.rhs_size);
+    float *dst = dst_cells.data();
+    for (size_t i = 0; i < self.lhs_size; ++i) {
+        for (size_t j = 0; j < self.rhs_size; ++j) {
+            *dst++ = hw.dotProduct(lhs + (i * self.common_size), rhs + (j * self.common_size), self.common_size);
+        }
+    }
+    state.pop_pop_push(state.stash.create<DenseValueView>(self.result_type, TypedCells(dst_cells)));
+}
+
 bool is_matrix(const ValueType &type) {
     return (type.is_dense() && (type.dimensions().size() == 2));
 }
@@ -122,6 +157,9 @@ struct SelectDenseMatmul {
             return my_cblas_double_matmul_op<LhsCommonInner::value, RhsCommonInner::value>;
         } else if (std::is_same_v<LCT,float> && std::is_same_v<RCT,float>) {
             return my_cblas_float_matmul_op<LhsCommonInner::value, RhsCommonInner::value>;
+        } else if (std::is_same_v<LCT,Int8Float> && std::is_same_v<RCT,Int8Float>) {
+            assert((std::is_same_v<OCT,float>));
+            return my_int8_matmul_op<LhsCommonInner::value, RhsCommonInner::value>;
         } else {
             return my_matmul_op<LCT, RCT, OCT, LhsCommonInner::value, RhsCommonInner::value>;
         }
@@ -4,6 +4,7 @@
 #include <vespa/vespalib/objects/objectvisitor.h>
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/operation.h>
+#include <vespa/vespalib/hwaccelerated/iaccelerated.h>
 #include <cassert>
 
 #include <cblas.h>
@@ -15,6 +16,8 @@ using namespace operation;
 
 namespace {
 
+static const auto &hw = hwaccelerated::IAccelerated::getAccelerator();
+
 template <typename LCT, typename RCT, typename OCT, bool common_inner>
 OCT my_dot_product(const LCT *lhs, const RCT *rhs, size_t vector_size, size_t result_size) {
     OCT result = 0.0;
@@ -69,6 +72,31 @@ void my_cblas_float_xw_product_op(InterpretedFunction::State &state, uint64_t pa
     state.pop_pop_push(state.stash.create<DenseValueView>(self.result_type, TypedCells(dst_cells)));
 }
 
+// int8 x int8 products are summed exactly as integers using the
+// accelerated integer dot product (VNNI on x86, dotprod on ARM);
+// a matrix without the common dimension innermost is transposed into the stash
+template <bool common_inner>
+void my_int8_xw_product_op(InterpretedFunction::State &state, uint64_t param) {
+    const DenseXWProductFunction::Self &self = unwrap_param<DenseXWProductFunction::Self>(param);
+    const int8_t *vector = reinterpret_cast<const int8_t *>(state.peek(1).cells().typify<Int8Float>().data());
+    const Int8Float *matrix_cells = state.peek(0).cells().typify<Int8Float>().data();
+    const int8_t *matrix = reinterpret_cast<const int8_t *>(matrix_cells);
+    if (!common_inner) {
+        auto transposed = state.stash.create_uninitialized_array<int8_t>(self.result_size * self.vector_size);
+        for (size_t i = 0; i < self.result_size; ++i) {
+            for (size_t c = 0; c < self.vector_size; ++c) {
+                transposed[(i * self.vector_size) + c] = matrix_cells[(c * self.result_size) + i].get_bits();
+            }
+        }
+        matrix = transposed.data();
+    }
+    auto dst_cells = state.stash.create_uninitialized_array<float>(self.result_size);
+    for (size_t i = 0; i < self.result_size; ++i) {
+        dst_cells[i] = hw.dotProduct(vector, matrix + (i * self.vector_size), self.vector_size);
+    }
+    state.pop_pop_push(state.stash.create<DenseValueView>(self.result_type, TypedCells(dst_cells)));
+}
+
 bool isDenseTensor(const ValueType &type, size_t d) {
     return (type.is_dense() && (type.dimensions().size() == d));
 }
@@ -110,6 +138,9 @@ struct MyXWProductOp {
         } else if (std::is_same_v<LCT,float> && std::is_same_v<RCT,float>) {
             assert((std::is_same_v<OCT,float>));
             return my_cblas_float_xw_product_op<CommonInner::value>;
+        } else if (std::is_same_v<LCT,Int8Float> && std::is_same_v<RCT,Int8Float>) {
+            assert((std::is_same_v<OCT,float>));
+            return my_int8_xw_product_op<CommonInner::value>;
         } else {
             return my_xw_product_op<LCT, RCT, OCT, CommonInner::value>;
         }
@@ -83,9 +83,7 @@ void my_generic_concat_op(State &state, uint64_t param_in) {
             lhs, rhs,
             param.sparse_plan, param.dense_plan,
             param.res_type, param.factory);
-    auto &result = state.stash.create<std::unique_ptr<Value>>(std::move(res_value));
-    const Value &result_ref = *(result.get());
-    state.pop_pop_push(result_ref);
+    state.pop_pop_push(state.keep(std::move(res_value)));
 }
 
 template <typename LCT, typename RCT, typename OCT, bool forward_lhs>
@@ -96,9 +96,7 @@ void my_generic_filter_subspaces_op(InterpretedFunction::State &state, uint64_t
         }
     }
     auto up = builder->build(std::move(builder));
-    auto &result = state.stash.create<std::unique_ptr<Value>>(std::move(up));
-    const Value &result_ref = *(result.get());
-    state.pop_push(result_ref);
+    state.pop_push(state.keep(std::move(up)));
 }
 
 struct SelectGenericFilterSubspacesOp {
@@ -61,9 +61,7 @@ void my_mixed_join_op(State &state, uint64_t param_in) {
     const Value &lhs = state.peek(1);
     const Value &rhs = state.peek(0);
     auto up = generic_mixed_join<LCT, RCT, OCT, Fun>(lhs, rhs, param);
-    auto &result = state.stash.create<std::unique_ptr<Value>>(std::move(up));
-    const Value &result_ref = *(result.get());
-    state.pop_pop_push(result_ref);
+    state.pop_pop_push(state.keep(std::move(up)));
 }
 
 //-----------------------------------------------------------------------------
@@ -328,6 +328,38 @@ generic_mixed_peek(const ValueType &res_type,
     return builder->build(std::move(builder));
 }
 
+// all mapped dimensions are peeked; at most one subspace matches,
+// and the result is built in the stash instead of on the heap
+template <typename ICT, typename OCT, typename Getter>
+const Value &
+generic_dense_peek(const ValueType &res_type,
+                   const Value &input_value,
+                   const SparsePlan &sparse_plan,
+                   const DensePlan &dense_plan,
+                   Stash &stash,
+                   const Getter &get_child_value)
+{
+    auto input_cells = input_value.cells().typify<ICT>();
+    auto dst_cells = stash.create_array<OCT>(dense_plan.out_dense_size);
+    size_t dense_offset = dense_plan.get_offset(get_child_value);
+    if (dense_offset != npos) {
+        SparseState state = sparse_plan.make_state(get_child_value);
+        auto view = input_value.index().create_view(sparse_plan.view_dims);
+        view->lookup(state.lookup_refs);
+        size_t input_subspace;
+        if (view->next_result(state.fetch_addr, input_subspace)) {
+            auto dst = dst_cells.begin();
+            auto input_offset = input_subspace * dense_plan.in_dense_size;
+            dense_plan.execute(dense_offset + input_offset,
+                               [&](size_t idx) { *dst++ = input_cells[idx]; });
+        }
+    }
+    if (res_type.is_double()) {
+        return stash.create<DoubleValue>(dst_cells[0]);
+    }
+    return stash.create<DenseValueView>(res_type, TypedCells(dst_cells));
+}
+
 template <typename ICT, typename OCT>
 void my_generic_peek_op(State &state, uint64_t param_in) {
     const auto &param = unwrap_param<PeekParam>(param_in);
@@ -338,10 +370,17 @@ void my_generic_peek_op(State &state, uint64_t param_in) {
         size_t stack_idx = last_valid_stack_idx - child_idx;
         return int64_t(state.peek(stack_idx).as_double());
     };
+    if (param.sparse_plan.out_mapped_dims == 0) {
+        const Value &result = generic_dense_peek<ICT,OCT>(param.res_type, input_value,
+                                                         param.sparse_plan, param.dense_plan,
+                                                         state.stash, get_child_value);
+        state.pop_n_push(param.num_children, result);
+        return;
+    }
     auto up = generic_mixed_peek<ICT,OCT>(param.res_type, input_value,
                                           param.sparse_plan, param.dense_plan,
                                           param.factory, get_child_value);
-    const Value &result = *state.stash.create<Value::UP>(std::move(up));
+    const Value &result = state.keep(std::move(up));
     // num_children includes the "input" param
     state.pop_n_push(param.num_children, result);
 }
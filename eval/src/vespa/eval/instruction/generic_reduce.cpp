@@ -105,9 +105,7 @@ void my_generic_reduce_op(State &state, uint64_t param_in) {
     const auto &param = unwrap_param<ReduceParam>(param_in);
     const Value &value = state.peek(0);
     auto up = generic_reduce<ICT, OCT, AGGR>(value, param);
-    auto &result = state.stash.create<std::unique_ptr<Value>>(std::move(up));
-    const Value &result_ref = *(result.get());
-    state.pop_push(result_ref);
+    state.pop_push(state.keep(std::move(up)));
 }
 
 template <typename ICT, typename OCT, typename AGGR, bool forward_index>
@@ -96,9 +96,7 @@ void my_generic_rename_op(State &state, uint64_t param_in) {
     const Value &a = state.peek(0);
     auto res_value = generic_rename<CT>(a, param.sparse_plan, param.dense_plan,
                                         param.res_type, param.factory);
-    auto &result = state.stash.create<std::unique_ptr<Value>>(std::move(res_value));
-    const Value &result_ref = *(result.get());
-    state.pop_push(result_ref);
+    state.pop_push(state.keep(std::move(res_value)));
 }
 
 template <typename CT>
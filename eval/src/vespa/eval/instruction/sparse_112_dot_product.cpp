@@ -74,11 +74,21 @@ double my_fast_sparse_112_dot_product(const FastAddrMap *a_map, const FastAddrMa
     for (size_t a_space = 0; a_space < a_labels.size(); ++a_space) {
         if (a_cells[a_space] != 0.0) { // handle pseudo-sparse input
             c_addr[0] = a_labels[a_space];
+            uint32_t a_hash = FastAddrMap::hash_label(c_addr[0]);
             const auto &b_labels = b_map->labels();
+            auto c_hash = [&](size_t b_space) noexcept {
+                return FastAddrMap::combine_label_hash(a_hash, FastAddrMap::hash_label(b_labels[b_space]));
+            };
+            for (size_t b_space = 0; b_space < std::min(b_labels.size(), FastAddrMap::prefetch_distance); ++b_space) {
+                c_map->prefetch(c_hash(b_space));
+            }
             for (size_t b_space = 0; b_space < b_labels.size(); ++b_space) {
+                if (b_space + FastAddrMap::prefetch_distance < b_labels.size()) {
+                    c_map->prefetch(c_hash(b_space + FastAddrMap::prefetch_distance));
+                }
                 if (b_cells[b_space] != 0.0) { // handle pseudo-sparse input
                     c_addr[1] = b_labels[b_space];
-                    auto c_space = c_map->lookup(as_car(c_addr));
+                    auto c_space = c_map->lookup(as_car(c_addr), c_hash(b_space));
                     if (c_space != FastAddrMap::npos()) {
                         result += (a_cells[a_space] * b_cells[b_space] * c_cells[c_space]);
                     }
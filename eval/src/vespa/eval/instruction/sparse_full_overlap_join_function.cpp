@@ -20,27 +20,17 @@ const Value &my_fast_sparse_full_overlap_join(const FastAddrMap &lhs_map, const
 {
     Fun fun(param.function);
     auto &result = stash.create<FastValue<CT,true>>(param.res_type, lhs_map.addr_size(), 1, lhs_map.size());
-    if constexpr (single_dim) {
-        const auto &labels = lhs_map.labels();
-        for (size_t i = 0; i < labels.size(); ++i) {
-            auto rhs_subspace = rhs_map.lookup_singledim(labels[i]);
-            if (rhs_subspace != FastAddrMap::npos()) {
-                result.add_singledim_mapping(labels[i]);
-                auto cell_value = fun(lhs_cells[i], rhs_cells[rhs_subspace]);
-                result.my_cells.push_back_fast(cell_value);
-            }
-        }
-    } else {
-        lhs_map.each_map_entry([&](auto lhs_subspace, auto hash) {
-                    auto lhs_addr = lhs_map.get_addr(lhs_subspace);
-                    auto rhs_subspace = rhs_map.lookup(lhs_addr, hash);
-                    if (rhs_subspace != FastAddrMap::npos()) {
-                        result.add_mapping(lhs_addr, hash);
-                        auto cell_value = fun(lhs_cells[lhs_subspace], rhs_cells[rhs_subspace]);
-                        result.my_cells.push_back_fast(cell_value);
+    rhs_map.lookup_many(lhs_map, [&](auto lhs_subspace, auto rhs_subspace) {
+                if (rhs_subspace != FastAddrMap::npos()) {
+                    if constexpr (single_dim) {
+                        result.add_singledim_mapping(lhs_map.labels()[lhs_subspace]);
+                    } else {
+                        result.add_mapping(lhs_map.get_addr(lhs_subspace));
                     }
-                });
-    }
+                    auto cell_value = fun(lhs_cells[lhs_subspace], rhs_cells[rhs_subspace]);
+                    result.my_cells.push_back_fast(cell_value);
+                }
+            });
     return result;
 }
 
@@ -64,10 +54,11 @@ void my_sparse_full_overlap_join_op(InterpretedFunction::State &state, uint64_t
     if (__builtin_expect(are_fast(lhs_idx, rhs_idx), true)) {
         const Value &res = my_fast_sparse_full_overlap_join_dispatch<CT,Fun,single_dim>(as_fast(lhs_idx).map, as_fast(rhs_idx).map,
                 lhs.cells().typify<CT>().data(), rhs.cells().typify<CT>().data(), param, state.stash);
+        ++state.heap_values;
         state.pop_pop_push(res);
     } else {
         auto res = generic_mixed_join<CT,CT,CT,Fun>(lhs, rhs, param);
-        state.pop_pop_push(*state.stash.create<std::unique_ptr<Value>>(std::move(res)));
+        state.pop_pop_push(state.keep(std::move(res)));
     }
 }
 
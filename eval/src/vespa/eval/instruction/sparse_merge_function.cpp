@@ -79,10 +79,11 @@ void my_sparse_merge_op(InterpretedFunction::State &state, uint64_t param_in) {
         const Value &v = my_fast_sparse_merge<CT,single_dim,Fun>(as_fast(a_idx).map, as_fast(b_idx).map,
                                                                  a_cells.data(), b_cells.data(),
                                                                  param, state.stash);
+        ++state.heap_values;
         state.pop_pop_push(v);
     } else {
         auto up = generic_mixed_merge<CT,CT,CT,Fun>(a, b, param);
-        state.pop_pop_push(*state.stash.create<std::unique_ptr<Value>>(std::move(up)));
+        state.pop_pop_push(state.keep(std::move(up)));
     }
 }
 
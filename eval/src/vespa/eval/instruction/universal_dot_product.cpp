@@ -43,6 +43,9 @@ struct UniversalDotProductParam {
     bool forward() const { return sparse_plan.maybe_forward_lhs_index(); }
     bool distinct() const { return sparse_plan.is_distinct() && dense_plan.is_distinct(); }
     bool single() const { return vector_size == 1; }
+    // forwarded distinct results with at most one dense loop per subspace
+    bool simple_shape() const { return forward() && distinct() && (dense_plan.loop_cnt.size() <= 1); }
+    bool nested() const { return !dense_plan.loop_cnt.empty(); }
 };
 
 template <typename OCT>
@@ -161,9 +164,66 @@ struct SparseFun {
 template <typename LCT, typename RCT, typename OCT, bool forward, bool distinct, bool single>
 void my_universal_dot_product_op(InterpretedFunction::State &state, uint64_t param_in) {
     SparseFun<LCT,RCT,OCT,forward,distinct,single> sparse_fun(param_in, state.peek(1), state.peek(0));
+    if constexpr (!forward) {
+        ++state.heap_values;
+    }
     state.pop_pop_push(sparse_fun.calculate_result(state.peek(1).index(), state.peek(0).index(), state.stash));
 }
 
+// Specialized version of the forward distinct case, where rhs is
+// dense and each lhs subspace produces either a single dot product
+// (1-to-many sparse-dense) or a dense result from a single loop of
+// dot products (dense-dense with mapped outer dimensions). Avoids the
+// generic sparse and dense plan dispatch for these common shapes.
+template <typename LCT, typename RCT, typename OCT, bool single, bool nested>
+void my_simple_forward_dot_product_op(InterpretedFunction::State &state, uint64_t param_in) {
+    const auto &param = unwrap_param<UniversalDotProductParam>(param_in);
+    const Value &lhs = state.peek(1);
+    const Value &rhs = state.peek(0);
+    size_t num_subspaces = lhs.index().size();
+    if (num_subspaces == 0 || rhs.index().size() == 0) {
+        state.pop_pop_push(create_empty_result<OCT>(param, state.stash));
+        return;
+    }
+    MyDotProduct<LCT,RCT,single> dot_product(param.vector_size);
+    const LCT *lhs_cells = lhs.cells().typify<LCT>().data();
+    const RCT *rhs_cells = rhs.cells().typify<RCT>().data();
+    auto dst_cells = state.stash.create_uninitialized_array<OCT>(num_subspaces * param.dense_plan.res_size);
+    OCT *dst = dst_cells.data();
+    const size_t lhs_size = param.dense_plan.lhs_size;
+    if constexpr (nested) {
+        const size_t loop_cnt = param.dense_plan.loop_cnt[0];
+        const size_t lhs_stride = param.dense_plan.lhs_stride[0];
+        const size_t rhs_stride = param.dense_plan.rhs_stride[0];
+        for (size_t i = 0; i < num_subspaces; ++i, lhs_cells += lhs_size) {
+            for (size_t j = 0; j < loop_cnt; ++j) {
+                *dst++ = dot_product(lhs_cells + j * lhs_stride, rhs_cells + j * rhs_stride);
+            }
+        }
+    } else {
+        for (size_t i = 0; i < num_subspaces; ++i, lhs_cells += lhs_size) {
+            *dst++ = dot_product(lhs_cells, rhs_cells);
+        }
+    }
+    state.pop_pop_push(state.stash.create<ValueView>(param.res_type, lhs.index(), TypedCells(dst_cells)));
+}
+
+struct SelectSimpleForwardDotProduct {
+    template <typename LCM, typename RCM, typename SCALAR, typename SINGLE, typename NESTED>
+    static auto invoke() {
+        constexpr CellMeta ocm = CellMeta::join(LCM::value, RCM::value).reduce(SCALAR::value);
+        using LCT = CellValueType<LCM::value.cell_type>;
+        using RCT = CellValueType<RCM::value.cell_type>;
+        using OCT = CellValueType<ocm.cell_type>;
+        if constexpr ((std::same_as<LCT,float> && std::same_as<RCT,float>) ||
+                      (std::same_as<LCT,double> && std::same_as<RCT,double>))
+        {
+            return my_simple_forward_dot_product_op<LCT,RCT,OCT,SINGLE::value,NESTED::value>;
+        }
+        return my_universal_dot_product_op<LCT,RCT,OCT,true,false,false>;
+    }
+};
+
 struct SelectUniversalDotProduct {
     template <typename LCM, typename RCM, typename SCALAR, typename FORWARD, typename DISTINCT, typename SINGLE>
     static auto invoke() {
@@ -180,6 +240,11 @@ struct SelectUniversalDotProduct {
     }
 };
 
+bool same_float_cells(const ValueType &lhs, const ValueType &rhs) {
+    return (lhs.cell_type() == rhs.cell_type()) &&
+        ((lhs.cell_type() == CellType::FLOAT) || (lhs.cell_type() == CellType::DOUBLE));
+}
+
 bool check_types(const ValueType &lhs, const ValueType &rhs) {
     if (lhs.is_double() || rhs.is_double()) {
         return false;
@@ -194,8 +259,10 @@ bool check_types(const ValueType &lhs, const ValueType &rhs) {
 
 UniversalDotProduct::UniversalDotProduct(const ValueType &res_type_in,
                                          const TensorFunction &lhs_in,
-                                         const TensorFunction &rhs_in)
-  : tensor_function::Op2(res_type_in, lhs_in, rhs_in)
+                                         const TensorFunction &rhs_in,
+                                         bool allow_specialized)
+  : tensor_function::Op2(res_type_in, lhs_in, rhs_in),
+    _allow_specialized(allow_specialized)
 {
 }
 
@@ -204,6 +271,14 @@ UniversalDotProduct::compile_self(const ValueBuilderFactory &, Stash &stash) con
 {
     auto &param = stash.create<UniversalDotProductParam>(result_type(), lhs().result_type(), rhs().result_type());
     using MyTypify = TypifyValue<TypifyCellMeta,TypifyBool>;
+    if (specialized()) {
+        auto op = typify_invoke<5,MyTypify,SelectSimpleForwardDotProduct>(lhs().result_type().cell_meta(),
+                                                                          rhs().result_type().cell_meta(),
+                                                                          result_type().cell_meta().is_scalar,
+                                                                          param.single(),
+                                                                          param.nested());
+        return InterpretedFunction::Instruction(op, wrap_param<UniversalDotProductParam>(param));
+    }
     auto op = typify_invoke<6,MyTypify,SelectUniversalDotProduct>(lhs().result_type().cell_meta(),
                                                                   rhs().result_type().cell_meta(),
                                                                   result_type().cell_meta().is_scalar,
@@ -234,8 +309,24 @@ UniversalDotProduct::single() const
     return param.single();
 }
 
+bool
+UniversalDotProduct::specialized() const
+{
+    if (!_allow_specialized || !same_float_cells(lhs().result_type(), rhs().result_type())) {
+        return false;
+    }
+    UniversalDotProductParam param(result_type(), lhs().result_type(), rhs().result_type());
+    return param.simple_shape();
+}
+
 const TensorFunction &
 UniversalDotProduct::optimize(const TensorFunction &expr, Stash &stash, bool force)
+{
+    return optimize(expr, stash, force, true);
+}
+
+const TensorFunction &
+UniversalDotProduct::optimize(const TensorFunction &expr, Stash &stash, bool force, bool allow_specialized)
 {
     if (auto reduce = as<Reduce>(expr); reduce && (reduce->aggr() == Aggr::SUM)) {
         if (auto join = as<Join>(reduce->child()); join && (join->function() == Mul::f)) {
@@ -245,9 +336,9 @@ UniversalDotProduct::optimize(const TensorFunction &expr, Stash &stash, bool for
             if (force || check_types(lhs_type, rhs_type)) {
                 SparseJoinReducePlan sparse_plan(lhs_type, rhs_type, res_type);
                 if (sparse_plan.maybe_forward_rhs_index() && !sparse_plan.maybe_forward_lhs_index()) {
-                    return stash.create<UniversalDotProduct>(res_type, join->rhs(), join->lhs());
+                    return stash.create<UniversalDotProduct>(res_type, join->rhs(), join->lhs(), allow_specialized);
                 }
-                return stash.create<UniversalDotProduct>(res_type, join->lhs(), join->rhs());
+                return stash.create<UniversalDotProduct>(res_type, join->lhs(), join->rhs(), allow_specialized);
             }
         }
     }
@@ -12,17 +12,27 @@ namespace vespalib::eval {
  * 
  * Note: can evaluate 'anything', but unless 'force' is given; will
  * try to be a bit conservative about when to optimize.
+ *
+ * Common shapes where the lhs index is forwarded to the result and
+ * rhs is dense (one dot product or one loop of dot products per lhs
+ * subspace) are evaluated by specialized kernels, unless disabled
+ * with 'allow_specialized' (used for benchmarking).
  **/
 class UniversalDotProduct : public tensor_function::Op2
 {
+private:
+    bool _allow_specialized;
 public:
-    UniversalDotProduct(const ValueType &res_type, const TensorFunction &lhs, const TensorFunction &rhs);
+    UniversalDotProduct(const ValueType &res_type, const TensorFunction &lhs, const TensorFunction &rhs,
+                        bool allow_specialized);
     InterpretedFunction::Instruction compile_self(const ValueBuilderFactory &factory, Stash &stash) const override;
     bool result_is_mutable() const override { return true; }
     bool forward() const;
     bool distinct() const;
     bool single() const;
+    bool specialized() const;
     static const TensorFunction &optimize(const TensorFunction &expr, Stash &stash, bool force);
+    static const TensorFunction &optimize(const TensorFunction &expr, Stash &stash, bool force, bool allow_specialized);
 };
 
 } // namespace
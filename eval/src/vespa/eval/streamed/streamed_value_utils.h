@@ -13,9 +13,9 @@ namespace vespalib::eval {
  *  Reading more labels than available will trigger an assert.
  **/
 struct LabelStream {
-    const StringIdVector &source;
+    std::span<const string_id> source;
     size_t pos;
-    LabelStream(const StringIdVector &data) : source(data), pos(0) {}
+    LabelStream(std::span<const string_id> data) : source(data), pos(0) {}
     string_id next_label() {
         assert(pos < source.size());
         return source[pos++];
@@ -61,7 +61,7 @@ public:
     }
 
     LabelBlockStream(uint32_t num_subspaces,
-                     const StringIdVector &labels,
+                     std::span<const string_id> labels,
                      uint32_t num_mapped_dims)
       : _num_subspaces(num_subspaces),
         _labels(labels),
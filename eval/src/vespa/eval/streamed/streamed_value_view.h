@@ -12,7 +12,8 @@ namespace vespalib::eval {
  /**
   *  Same characteristics as StreamedValue, but does not
   *  own its data - refers to type, cells and serialized
-  *  labels that must be kept outside the Value.
+  *  labels that must be kept outside the Value (e.g. directly in
+  *  the buffer of a tensor attribute).
   **/
 class StreamedValueView : public Value
 {
@@ -24,7 +25,7 @@ private:
 public:
     StreamedValueView(const ValueType &type, size_t num_mapped_dimensions,
                       TypedCells cells, size_t num_subspaces,
-                      const StringIdVector &labels)
+                      std::span<const string_id> labels)
       : _type(type),
         _cells_ref(cells),
         _my_index(num_mapped_dimensions, num_subspaces, labels)
@@ -4,29 +4,43 @@
 #include <util/timer.h>
 #include <util/clientstatus.h>
 #include <httpclient/httpclient.h>
+#include <httpclient/async_httpclient.h>
 #include <util/filereader.h>
 #include <cstring>
 #include <iostream>
+#include <vespa/vespalib/coro/async_io.h>
+#include <vespa/vespalib/coro/completion.h>
 #include <vespa/vespalib/encoding/base64.h>
 
 using namespace vespalib;
 
-Client::Client(vespalib::CryptoEngine::SP engine, std::unique_ptr<ClientArguments> args)
+Client::Client(vespalib::CryptoEngine::SP engine, std::unique_ptr<ClientArguments> args,
+               vespalib::coro::AsyncIo *async)
     : _args(std::move(args)),
       _status(std::make_unique<ClientStatus>()),
       _reqTimer(std::make_unique<Timer>()),
       _cycleTimer(std::make_unique<Timer>()),
       _masterTimer(std::make_unique<Timer>()),
-      _http(std::make_unique<HTTPClient>(std::move(engine), _args->_hostname, _args->_port, _args->_keepAlive,
-                                         _args->_headerBenchmarkdataCoverage, _args->_extraHeaders, _args->_authority)),
+      _http(),
+      _asyncHttp(),
+      _async(async),
       _reader(std::make_unique<FileReader>()),
       _output(),
       _linebufsize(_args->_maxLineSize),
       _linebuf(std::make_unique<char[]>(_linebufsize)),
       _stop(false),
       _done(false),
-      _thread()
+      _thread(),
+      _asyncDone()
 {
+    if (_async != nullptr) {
+        _asyncHttp = std::make_unique<AsyncHTTPClient>(*_async, std::move(engine), _args->_hostname, _args->_port,
+                                                       _args->_keepAlive, _args->_headerBenchmarkdataCoverage,
+                                                       _args->_extraHeaders, _args->_authority);
+    } else {
+        _http = std::make_unique<HTTPClient>(std::move(engine), _args->_hostname, _args->_port, _args->_keepAlive,
+                                             _args->_headerBenchmarkdataCoverage, _args->_extraHeaders, _args->_authority);
+    }
     _cycleTimer->SetMax(_args->_cycle);
 }
 
@@ -155,24 +169,38 @@ int UrlReader::nextContent()
 }
 
 
+namespace {
+
 void
-Client::run()
+recordFetch(ClientStatus &status, const ClientArguments &args, const HTTPClient::FetchStatus &fetch_status,
+            double timespan)
 {
-    char inputFilename[1024];
-    char outputFilename[1024];
-    char timestr[64];
-    int  linelen;
-    ///   int  reslen;
+    status.AddRequestStatus(fetch_status.RequestStatus());
+    if (fetch_status.Ok() && fetch_status.TotalHitCount() == 0)
+        ++status._zeroHitQueries;
+    if (fetch_status.ResultSize() >= args._byteLimit) {
+        if (args._ignoreCount == 0)
+            status.ResponseTime(timespan);
+    } else {
+        if (args._ignoreCount == 0)
+            status.RequestFailed();
+    }
+}
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(_args->_delay));
+}
+
+bool
+Client::openFiles(char *inputFilename, size_t len)
+{
+    char outputFilename[1024];
 
     // open query file
-    snprintf(inputFilename, 1024, _args->_filenamePattern.c_str(), _args->_myNum);
+    snprintf(inputFilename, len, _args->_filenamePattern.c_str(), _args->_myNum);
     if (!_reader->Open(inputFilename)) {
         printf("Client %d: ERROR: could not open file '%s' [read mode]\n",
                _args->_myNum, inputFilename);
         _status->SetError("Could not open query file.");
-        return;
+        return false;
     }
     if ( ! _args->_outputPattern.empty()) {
         snprintf(outputFilename, 1024, _args->_outputPattern.c_str(), _args->_myNum);
@@ -181,11 +209,27 @@ Client::run()
             printf("Client %d: ERROR: could not open file '%s' [write mode]\n",
                    _args->_myNum, outputFilename);
             _status->SetError("Could not open output file.");
-            return;
+            return false;
         }
     }
     if (_output)
         _output->write(&FBENCH_DELIMITER[1], strlen(FBENCH_DELIMITER) - 1);
+    return true;
+}
+
+void
+Client::run()
+{
+    char inputFilename[1024];
+    char timestr[64];
+    int  linelen;
+    ///   int  reslen;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(_args->_delay));
+
+    if (!openFiles(inputFilename, sizeof(inputFilename))) {
+        return;
+    }
 
     if (_args->_ignoreCount == 0)
         _masterTimer->Start();
@@ -242,9 +286,6 @@ Client::run()
             _reqTimer->Start();
             auto fetch_status = _http->Fetch(_linebuf.get(), _output.get(), _args->_usePostMode, content, cLen);
             _reqTimer->Stop();
-            _status->AddRequestStatus(fetch_status.RequestStatus());
-            if (fetch_status.Ok() && fetch_status.TotalHitCount() == 0)
-                ++_status->_zeroHitQueries;
             if (_output) {
                 if (!fetch_status.Ok()) {
                     _output->write("\nFBENCH: URL FETCH FAILED!\n",
@@ -258,13 +299,7 @@ Client::run()
                     _output->write(&FBENCH_DELIMITER[1], strlen(FBENCH_DELIMITER) - 1);
                 }
             }
-            if (fetch_status.ResultSize() >= _args->_byteLimit) {
-                if (_args->_ignoreCount == 0)
-                    _status->ResponseTime(_reqTimer->GetTimespan());
-            } else {
-                if (_args->_ignoreCount == 0)
-                    _status->RequestFailed();
-            }
+            recordFetch(*_status, *_args, fetch_status, _reqTimer->GetTimespan());
         } else {
             if (_args->_ignoreCount == 0)
                 _status->SkippedRequest();
@@ -296,6 +331,89 @@ Client::run()
     _done = true;
 }
 
+vespalib::coro::Work
+Client::runAsync()
+{
+    char inputFilename[1024];
+    int  linelen;
+
+    // continue in the async io runtime; no cycle time or start delay
+    // is applied, each client keeps a single request outstanding.
+    co_await _async->schedule();
+
+    if (!openFiles(inputFilename, sizeof(inputFilename))) {
+        co_return vespalib::coro::Done{};
+    }
+
+    if (_args->_ignoreCount == 0)
+        _masterTimer->Start();
+
+    // Start reading from offset
+    if ( _args->_singleQueryFile )
+        _reader->SetFilePos(_args->_queryfileOffset);
+
+    UrlReader urlSource(*_reader, *_args);
+    size_t urlNumber = 0;
+
+    // run queries
+    while (!_stop) {
+        linelen = urlSource.nextUrl(_linebuf.get(), _linebufsize);
+        if (linelen > 0) {
+            ++urlNumber;
+        } else {
+            if (urlNumber == 0) {
+                fprintf(stderr, "Client %d: ERROR: could not read any lines from '%s'\n",
+                        _args->_myNum, inputFilename);
+                _status->SetError("Could not read any lines from query file.");
+            }
+            break;
+        }
+        if (linelen < _linebufsize) {
+            if (linelen + (int)_args->_queryStringToAppend.length() < _linebufsize) {
+                strcat(_linebuf.get(), _args->_queryStringToAppend.c_str());
+            }
+            int cLen = _args->_usePostMode ? urlSource.nextContent() : 0;
+
+            const char* content = urlSource.content();
+            std::string base64_decoded;
+            if (_args->_usePostMode && _args->_base64Decode) {
+                try {
+                    base64_decoded = Base64::decode(content, cLen);
+                } catch (std::exception &e) {
+                    std::string msg = "POST request contains invalid base64 encoded data: ";
+                    msg.append(e.what());
+                    _status->SetError(msg.c_str());
+                    break;
+                }
+                content = base64_decoded.c_str();
+                cLen = base64_decoded.size();
+            }
+
+            _reqTimer->Start();
+            auto fetch_status = co_await _asyncHttp->Fetch(_linebuf.get(), _args->_usePostMode, content, cLen);
+            _reqTimer->Stop();
+            recordFetch(*_status, *_args, fetch_status, _reqTimer->GetTimespan());
+        } else {
+            if (_args->_ignoreCount == 0)
+                _status->SkippedRequest();
+        }
+        if (_args->_ignoreCount > 0) {
+            _args->_ignoreCount--;
+            if (_args->_ignoreCount == 0)
+                _masterTimer->Start();
+        }
+        // Update current time span to calculate Q/s
+        _status->SetRealTime(_masterTimer->GetCurrent());
+    }
+    _masterTimer->Stop();
+    _status->SetRealTime(_masterTimer->GetTimespan());
+    _status->SetReuseCount(_asyncHttp->GetReuseCount());
+    printf(".");
+    fflush(stdout);
+    _done = true;
+    co_return vespalib::coro::Done{};
+}
+
 void Client::stop() {
     _stop = true;
 }
@@ -305,9 +423,17 @@ bool Client::done() {
 }
 
 void Client::start() {
-    _thread = std::thread(Client::runMe, this);
+    if (_async != nullptr) {
+        _asyncDone = vespalib::coro::make_future(runAsync());
+    } else {
+        _thread = std::thread(Client::runMe, this);
+    }
 }
 
 void Client::join() {
-    _thread.join();
+    if (_asyncDone.valid()) {
+        _asyncDone.wait();
+    } else {
+        _thread.join();
+    }
 }
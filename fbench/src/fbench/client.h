@@ -3,9 +3,13 @@
 
 #include <fstream>
 #include <atomic>
+#include <future>
 #include <thread>
+#include <vespa/vespalib/coro/lazy.h>
 #include <vespa/vespalib/net/crypto_engine.h>
 
+namespace vespalib::coro { struct AsyncIo; }
+
 #define FBENCH_DELIMITER "\n[--xxyyzz--FBENCH_MAGIC_DELIMITER--zzyyxx--]\n"
 
 /**
@@ -154,11 +158,13 @@ private:
 
 class Timer;
 class HTTPClient;
+class AsyncHTTPClient;
 class FileReader;
 struct ClientStatus;
 /**
  * This class implements a single test client. The clients are run in
- * separate threads to simulate several simultanious users. The
+ * separate threads to simulate several simultanious users, or as
+ * coroutines sharing the threads of an async io runtime. The
  * operation of a client is controlled through an instance of the
  * @ref ClientArguments class.
  **/
@@ -171,6 +177,8 @@ private:
     std::unique_ptr<Timer>           _cycleTimer;
     std::unique_ptr<Timer>           _masterTimer;
     std::unique_ptr<HTTPClient>      _http;
+    std::unique_ptr<AsyncHTTPClient> _asyncHttp;
+    vespalib::coro::AsyncIo         *_async;
     std::unique_ptr<FileReader>      _reader;
     std::unique_ptr<std::ofstream>   _output;
     int                              _linebufsize;
@@ -178,17 +186,23 @@ private:
     std::atomic<bool>                _stop;
     std::atomic<bool>                _done;
     std::thread                      _thread;
+    std::future<vespalib::coro::Done> _asyncDone;
 
     static void runMe(Client * client);
+    bool openFiles(char *inputFilename, size_t len);
     void run();
+    vespalib::coro::Work runAsync();
 
 public:
     using UP = std::unique_ptr<Client>;
     /**
      * The client arguments given to this method becomes the
-     * responsibility of the client.
+     * responsibility of the client. If an async io runtime is given,
+     * the client will run as a coroutine in that runtime instead of
+     * in its own thread.
      **/
-    Client(vespalib::CryptoEngine::SP engine, std::unique_ptr<ClientArguments> args);
+    Client(vespalib::CryptoEngine::SP engine, std::unique_ptr<ClientArguments> args,
+           vespalib::coro::AsyncIo *async = nullptr);
     Client(const Client &) = delete;
     Client &operator=(const Client &) = delete;
 
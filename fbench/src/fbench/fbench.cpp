@@ -43,6 +43,7 @@ sig_atomic_t exitSignal = 0;
 
 FBench::FBench()
     : _crypto_engine(),
+      _asyncIo(),
       _clients(),
       _ignoreCount(0),
       _cycle(0),
@@ -55,7 +56,8 @@ FBench::FBench()
       _usePostMode(false),
       _headerBenchmarkdataCoverage(false),
       _seconds(60),
-      _singleQueryFile(false)
+      _singleQueryFile(false),
+      _asyncThreads(0)
 {
 }
 
@@ -117,7 +119,7 @@ FBench::InitBenchmark(int numClients, int ignoreCount, int cycle,
                       bool keepAlive, bool base64Decode,
                       bool headerBenchmarkdataCoverage, int seconds,
                       bool singleQueryFile, const std::string & queryStringToAppend, const std::string & extraHeaders,
-                      const std::string &authority, bool postMode)
+                      const std::string &authority, bool postMode, int asyncThreads)
 {
     _clients.resize(numClients);
     _ignoreCount     = ignoreCount;
@@ -142,6 +144,7 @@ FBench::InitBenchmark(int numClients, int ignoreCount, int cycle,
     _headerBenchmarkdataCoverage = headerBenchmarkdataCoverage;
     _seconds = seconds;
     _singleQueryFile = singleQueryFile;
+    _asyncThreads = asyncThreads;
 }
 
 void
@@ -149,6 +152,9 @@ FBench::CreateClients()
 {
     int spread = (_cycle > 1) ? _cycle : 1;
 
+    for (int i = 0; i < _asyncThreads; ++i) {
+        _asyncIo.push_back(vespalib::coro::AsyncIo::create());
+    }
     int i(0);
     for(auto & client : _clients) {
         uint64_t off_beg = 0;
@@ -163,7 +169,8 @@ FBench::CreateClients()
                                               _ports[i % _ports.size()], _cycle,random() % spread,
                                               _ignoreCount, _byteLimit, _restartLimit, _maxLineSize, _keepAlive,
                                               _base64Decode, _headerBenchmarkdataCoverage, off_beg, off_end,
-                                              _singleQueryFile, _queryStringToAppend, _extraHeaders, _authority, _usePostMode));
+                                              _singleQueryFile, _queryStringToAppend, _extraHeaders, _authority, _usePostMode),
+            _asyncIo.empty() ? nullptr : &static_cast<vespalib::coro::AsyncIo &>(_asyncIo[i % _asyncIo.size()]));
         ++i;
     }
 }
@@ -258,6 +265,9 @@ FBench::PrintSummary()
     }
     printf("***************** Benchmark Summary *****************\n");
     printf("clients:                %8ld\n", _clients.size());
+    if (_asyncThreads > 0) {
+        printf("async io threads:       %8d\n", _asyncThreads);
+    }
     printf("ran for:                %8d seconds\n", _seconds);
     printf("cycle time:             %8d ms\n", _cycle);
     printf("lower response limit:   %8d bytes\n", _byteLimit);
@@ -293,7 +303,7 @@ FBench::Usage()
 {
     printf("usage: vespa-fbench [-H extraHeader] [-a queryStringToAppend ] [-n numClients] [-c cycleTime] [-l limit] [-i ignoreCount]\n");
     printf("              [-s seconds] [-q queryFilePattern] [-o outputFilePattern]\n");
-    printf("              [-r restartLimit] [-m maxLineSize] [-k] <hostname> <port>\n\n");
+    printf("              [-r restartLimit] [-m maxLineSize] [-k] [-w asyncThreads] <hostname> <port>\n\n");
     printf(" -H <str> : append extra header to each get request.\n");
     printf(" -A <str> : assign authority.  <str> should be hostname:port format. Overrides Host: header sent.\n");
     printf(" -P       : use POST for requests instead of GET.\n");
@@ -319,7 +329,9 @@ FBench::Usage()
     printf(" -T <str> : CA certificate file to verify peer against.\n");
     printf(" -C <str> : client certificate file name.\n");
     printf(" -K <str> : client private key file name.\n");
-    printf(" -D       : use TLS configuration from environment if T/C/K is not used\n\n");
+    printf(" -D       : use TLS configuration from environment if T/C/K is not used\n");
+    printf(" -w <num> : run all clients as coroutines on <num> async io threads instead\n");
+    printf("            of one thread per client. Requires cycle time 0 and no output files.\n\n");
     printf(" <hostname> : the host you want to benchmark.\n");
     printf(" <port>     : the port to use when contacting the host.\n\n");
     printf("Several hostnames and ports can be listed\n");
@@ -366,6 +378,7 @@ FBench::Main(int argc, char *argv[])
     std::string authority;
 
     int  printInterval = 0;
+    int  asyncThreads = 0;
 
     // parse options and override defaults.
     int         opt;
@@ -373,7 +386,7 @@ FBench::Main(int argc, char *argv[])
 
     optError = false;
     std::string content_type = "Content-type:application/json";
-    while((opt = getopt(argc, argv, "H:A:T:C:K:Da:n:c:l:i:s:q:o:r:m:p:kdxyzP")) != -1) {
+    while((opt = getopt(argc, argv, "H:A:T:C:K:Da:n:c:l:i:s:q:o:r:m:p:w:kdxyzP")) != -1) {
         switch(opt) {
         case 'A':
             authority = optarg;
@@ -442,6 +455,11 @@ FBench::Main(int argc, char *argv[])
             if (printInterval < 0)
                 optError = true;
             break;
+        case 'w':
+            asyncThreads = atoi(optarg);
+            if (asyncThreads < 0)
+                optError = true;
+            break;
         case 'k':
             keepAlive = false;
             break;
@@ -471,6 +489,10 @@ FBench::Main(int argc, char *argv[])
         Usage();
         return -1;
     }
+    if (asyncThreads > 0 && (cycleTime != 0 || outputFilePattern != nullptr)) {
+        fprintf(stderr, "Async io clients (-w) can not be combined with cycle time (-c) or output files (-o)\n");
+        return -1;
+    }
     // Hostname/port must be in pair
     int args = (argc - optind);
     if (args % 2 != 0) {
@@ -540,7 +562,7 @@ FBench::Main(int argc, char *argv[])
                   keepAlive, base64Decode,
                   headerBenchmarkdataCoverage, seconds,
                   singleQueryFile, queryStringToAppend, extraHeaders,
-                  authority, usePostMode);
+                  authority, usePostMode, asyncThreads);
 
     CreateClients();
     StartClients();
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <vespa/vespalib/coro/async_io.h>
 #include <memory>
 #include <string>
 #include <vector>
@@ -19,6 +20,7 @@ class FBench
 {
 private:
     std::shared_ptr<vespalib::CryptoEngine> _crypto_engine;
+    std::vector<vespalib::coro::AsyncIo::Owner> _asyncIo;
     std::vector<std::unique_ptr<Client>> _clients;
     int                      _ignoreCount;
     int                      _cycle;
@@ -39,6 +41,7 @@ private:
     std::string              _queryStringToAppend;
     std::string              _extraHeaders;
     std::string              _authority;
+    int                      _asyncThreads;
 
     bool init_crypto_engine(const std::string &ca_certs_file_name,
                             const std::string &cert_chain_file_name,
@@ -51,7 +54,7 @@ private:
                        bool keepAlive, bool base64Decode,
                        bool headerBenchmarkdataCoverage, int seconds,
                        bool singleQueryFile, const std::string & queryStringToAppend, const std::string & extraHeaders,
-                       const std::string &authority, bool postMode);
+                       const std::string &authority, bool postMode, int asyncThreads);
 
     void CreateClients();
     void StartClients();
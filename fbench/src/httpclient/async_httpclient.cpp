@@ -0,0 +1,273 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "async_httpclient.h"
+#include <vespa/vespalib/util/size_literals.h>
+#include <util/authority.h>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+using vespalib::coro::Lazy;
+
+namespace {
+
+std::string
+trim(const std::string &str)
+{
+    size_t begin = str.find_first_not_of(" \t");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = str.find_last_not_of(" \t");
+    return str.substr(begin, end - begin + 1);
+}
+
+bool
+has_token(const std::string &value, const char *token)
+{
+    size_t len = strlen(token);
+    for (size_t pos = 0; pos + len <= value.size(); ++pos) {
+        if (strncasecmp(value.data() + pos, token, len) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+AsyncHTTPClient::Response::Response()
+    : httpVersion(0),
+      requestStatus(0),
+      totalHitCount(-1),
+      connectionCloseGiven(false),
+      keepAliveGiven(false),
+      contentLengthGiven(false),
+      chunkedEncodingGiven(false),
+      contentLength(0),
+      dataRead(0)
+{
+}
+
+AsyncHTTPClient::AsyncHTTPClient(AsyncIo &async, vespalib::CryptoEngine::SP engine, const char *hostname, int port,
+                                 bool keepAlive, bool headerBenchmarkdataCoverage,
+                                 const std::string &extraHeaders, const std::string &authority)
+    : _async(async),
+      _engine(std::move(engine)),
+      _address(vespalib::SocketAddress::select_remote(port, hostname)),
+      _keepAlive(keepAlive),
+      _headerBenchmarkdataCoverage(headerBenchmarkdataCoverage),
+      _extraHeaders(extraHeaders),
+      _sni_spec(make_sni_spec(authority, hostname, port, _engine->use_tls_when_client())),
+      _host_header_value(make_host_header_value(_sni_spec, _engine->use_tls_when_client())),
+      _reuseCount(0),
+      _socket(),
+      _buf(10_Ki),
+      _bufpos(0),
+      _bufused(0)
+{
+}
+
+AsyncHTTPClient::~AsyncHTTPClient() = default;
+
+std::string
+AsyncHTTPClient::make_request(const std::string &url, bool usePost, int contentLen) const
+{
+    std::string req = usePost ? "POST " : "GET ";
+    req += url;
+    req += " HTTP/1.1\r\nHost: ";
+    req += _host_header_value;
+    req += "\r\n";
+    if (usePost) {
+        req += "Content-Length: " + std::to_string(contentLen) + "\r\n";
+    }
+    req += _extraHeaders;
+    req += "X-Yahoo-Vespa-Benchmarkdata: true\r\n";
+    if (_headerBenchmarkdataCoverage) {
+        req += "X-Yahoo-Vespa-Benchmarkdata-Coverage: true\r\n";
+    }
+    if (!_keepAlive) {
+        req += "Connection: close\r\n";
+    }
+    req += "User-Agent: fbench/4.2.10\r\n\r\n";
+    return req;
+}
+
+Lazy<bool>
+AsyncHTTPClient::connect_socket()
+{
+    _socket.reset();
+    _bufpos = 0;
+    _bufused = 0;
+    auto handle = co_await _async.connect(_address);
+    if (!handle.valid() || !handle.set_nodelay(true) || !handle.set_linger(false, 0)) {
+        co_return false;
+    }
+    _socket = co_await AsyncCryptoSocket::connect(_async, *_engine, std::move(handle), _sni_spec);
+    co_return bool(_socket);
+}
+
+Lazy<bool>
+AsyncHTTPClient::write_all(const char *buf, size_t len)
+{
+    size_t written = 0;
+    while (written < len) {
+        ssize_t res = co_await _socket->write(buf + written, len - written);
+        if (res <= 0) {
+            co_return false;
+        }
+        written += res;
+    }
+    co_return true;
+}
+
+Lazy<bool>
+AsyncHTTPClient::fill_buffer()
+{
+    ssize_t res = co_await _socket->read(_buf.data(), _buf.size());
+    _bufpos = 0;
+    _bufused = (res > 0) ? res : 0;
+    co_return (res > 0);
+}
+
+Lazy<bool>
+AsyncHTTPClient::read_line(std::string &line)
+{
+    line.clear();
+    for (;;) {
+        while (_bufpos < _bufused) {
+            char c = _buf[_bufpos++];
+            if (c == '\n') {
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                co_return true;
+            }
+            line.push_back(c);
+        }
+        if (!co_await fill_buffer()) {
+            co_return false;
+        }
+    }
+}
+
+Lazy<bool>
+AsyncHTTPClient::skip(size_t len, size_t &dataRead)
+{
+    while (len > 0) {
+        if (_bufpos == _bufused && !co_await fill_buffer()) {
+            co_return false;
+        }
+        size_t chunk = std::min(len, _bufused - _bufpos);
+        _bufpos += chunk;
+        dataRead += chunk;
+        len -= chunk;
+    }
+    co_return true;
+}
+
+Lazy<bool>
+AsyncHTTPClient::read_http_header(Response &response)
+{
+    std::string line;
+    if (!co_await read_line(line) || strncmp(line.c_str(), "HTTP/", 5) != 0) {
+        co_return false;
+    }
+    size_t space = line.find(' ');
+    if (space == std::string::npos) {
+        co_return false;
+    }
+    response.httpVersion = (strncmp(line.c_str(), "HTTP/1.0", 8) == 0) ? 0 : 1;
+    response.requestStatus = atoi(line.c_str() + space + 1);
+    while (co_await read_line(line)) {
+        if (line.empty()) {
+            co_return true;
+        }
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string name = line.substr(0, colon);
+        std::string value = trim(line.substr(colon + 1));
+        if (name == "X-Yahoo-Vespa-TotalHitCount") {
+            response.totalHitCount = atoi(value.c_str());
+        } else if (strcasecmp(name.c_str(), "connection") == 0) {
+            response.keepAliveGiven = has_token(value, "keep-alive");
+            response.connectionCloseGiven = has_token(value, "close");
+        } else if (strcasecmp(name.c_str(), "content-length") == 0) {
+            response.contentLengthGiven = true;
+            response.contentLength = strtoul(value.c_str(), nullptr, 10);
+        } else if (strcasecmp(name.c_str(), "transfer-encoding") == 0) {
+            response.chunkedEncodingGiven = has_token(value, "chunked");
+        }
+    }
+    co_return false;
+}
+
+Lazy<bool>
+AsyncHTTPClient::read_content(Response &response)
+{
+    if (response.chunkedEncodingGiven) {
+        std::string line;
+        for (;;) {
+            if (!co_await read_line(line)) {
+                co_return false;
+            }
+            size_t chunkLen = strtoul(line.c_str(), nullptr, 16);
+            if (chunkLen == 0) {
+                while (co_await read_line(line)) {
+                    if (line.empty()) {
+                        co_return true; // end of trailer
+                    }
+                }
+                co_return false;
+            }
+            if (!co_await skip(chunkLen, response.dataRead) || !co_await read_line(line)) {
+                co_return false;
+            }
+        }
+    }
+    if (response.contentLengthGiven) {
+        co_return co_await skip(response.contentLength, response.dataRead);
+    }
+    // content ends when the server closes the connection
+    response.connectionCloseGiven = true;
+    response.dataRead += (_bufused - _bufpos);
+    _bufpos = _bufused;
+    while (co_await fill_buffer()) {
+        response.dataRead += _bufused;
+        _bufpos = _bufused;
+    }
+    co_return true;
+}
+
+Lazy<HTTPClient::FetchStatus>
+AsyncHTTPClient::Fetch(std::string url, bool usePost, const char *content, int contentLen)
+{
+    std::string req = make_request(url, usePost, contentLen);
+    bool sent = false;
+    // try to reuse connection if keep-alive is enabled
+    if (_keepAlive && _socket && _bufpos == _bufused) {
+        sent = (co_await write_all(req.data(), req.size()) &&
+                (!usePost || co_await write_all(content, contentLen)) &&
+                co_await fill_buffer());
+        if (sent) {
+            _reuseCount++;
+        }
+    }
+    if (!sent) {
+        sent = (co_await connect_socket() &&
+                co_await write_all(req.data(), req.size()) &&
+                (!usePost || co_await write_all(content, contentLen)));
+    }
+    Response response;
+    bool ok = (sent && co_await read_http_header(response) && co_await read_content(response));
+    if (!ok || !_keepAlive || response.connectionCloseGiven ||
+        (response.httpVersion == 0 && !response.keepAliveGiven))
+    {
+        _socket.reset();
+    }
+    co_return HTTPClient::FetchStatus(ok && response.requestStatus == 200 && response.totalHitCount >= 0,
+                                      response.requestStatus,
+                                      response.totalHitCount,
+                                      response.dataRead);
+}
@@ -0,0 +1,93 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "httpclient.h"
+#include <vespa/vespalib/coro/async_crypto_socket.h>
+#include <vespa/vespalib/coro/async_io.h>
+#include <vespa/vespalib/coro/lazy.h>
+#include <vespa/vespalib/net/crypto_engine.h>
+#include <vespa/vespalib/net/socket_address.h>
+#include <vespa/vespalib/net/socket_spec.h>
+#include <string>
+#include <vector>
+
+/**
+ * This class implements a HTTP 1.1 client like @ref HTTPClient, but
+ * performs all network io asynchronously through a coroutine based
+ * async io runtime. This way a single io thread may drive a large
+ * number of clients, each with its own keep-alive connection and a
+ * single outstanding request. Response content is read and
+ * discarded.
+ **/
+class AsyncHTTPClient
+{
+private:
+  using AsyncIo = vespalib::coro::AsyncIo;
+  using AsyncCryptoSocket = vespalib::coro::AsyncCryptoSocket;
+  template <typename T> using Lazy = vespalib::coro::Lazy<T>;
+
+  AsyncIo                    &_async;
+  vespalib::CryptoEngine::SP  _engine;
+  vespalib::SocketAddress     _address;
+  bool                        _keepAlive;
+  bool                        _headerBenchmarkdataCoverage;
+  const std::string           _extraHeaders;
+  vespalib::SocketSpec        _sni_spec;
+  std::string                 _host_header_value;
+  uint64_t                    _reuseCount;
+  AsyncCryptoSocket::UP       _socket;
+  std::vector<char>           _buf;
+  size_t                      _bufpos;
+  size_t                      _bufused;
+
+  struct Response {
+    unsigned int httpVersion;
+    unsigned int requestStatus;
+    int          totalHitCount;
+    bool         connectionCloseGiven;
+    bool         keepAliveGiven;
+    bool         contentLengthGiven;
+    bool         chunkedEncodingGiven;
+    size_t       contentLength;
+    size_t       dataRead;
+    Response();
+  };
+
+  std::string make_request(const std::string &url, bool usePost, int contentLen) const;
+  Lazy<bool> connect_socket();
+  Lazy<bool> write_all(const char *buf, size_t len);
+  Lazy<bool> fill_buffer();
+  Lazy<bool> read_line(std::string &line);
+  Lazy<bool> skip(size_t len, size_t &dataRead);
+  Lazy<bool> read_http_header(Response &response);
+  Lazy<bool> read_content(Response &response);
+
+public:
+  /**
+   * Create a HTTP client fetching documents from the given host
+   * using the given async io runtime.
+   **/
+  AsyncHTTPClient(AsyncIo &async, vespalib::CryptoEngine::SP engine, const char *hostname, int port, bool keepAlive,
+                  bool headerBenchmarkdataCoverage, const std::string &extraHeaders = "", const std::string &authority = "");
+  AsyncHTTPClient(const AsyncHTTPClient &) = delete;
+  AsyncHTTPClient &operator=(const AsyncHTTPClient &) = delete;
+  ~AsyncHTTPClient();
+
+  /**
+   * @return connection reuse count, see @ref HTTPClient::GetReuseCount.
+   **/
+  uint64_t GetReuseCount() const { return _reuseCount; }
+
+  /**
+   * Fetch a document, reading and discarding its content. Must be
+   * awaited to completion before the next fetch is started.
+   *
+   * @return status of the fetch.
+   * @param url the url to fetch.
+   * @param usePost whether to use POST in the request
+   * @param content if usePost is true, the content to post
+   * @param contentLen length of content in bytes
+   **/
+  Lazy<HTTPClient::FetchStatus> Fetch(std::string url, bool usePost = false,
+                                      const char *content = nullptr, int contentLen = 0);
+};
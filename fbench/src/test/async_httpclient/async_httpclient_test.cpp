@@ -0,0 +1,121 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <httpclient/async_httpclient.h>
+#include <vespa/vespalib/coro/completion.h>
+#include <vespa/vespalib/net/crypto_engine.h>
+#include <vespa/vespalib/net/server_socket.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace vespalib;
+using namespace vespalib::coro;
+
+std::string ok_response(const std::string &body) {
+    return "HTTP/1.1 200 OK\r\n"
+           "X-Yahoo-Vespa-TotalHitCount: 42\r\n"
+           "Content-Length: " + std::to_string(body.size()) + "\r\n"
+           "\r\n" + body;
+}
+
+std::string chunked_response() {
+    return "HTTP/1.1 200 OK\r\n"
+           "X-Yahoo-Vespa-TotalHitCount: 7\r\n"
+           "Transfer-Encoding: chunked\r\n"
+           "\r\n"
+           "5\r\nhello\r\n"
+           "6\r\n world\r\n"
+           "0\r\n\r\n";
+}
+
+Lazy<bool> read_request(AsyncCryptoSocket &socket) {
+    std::string request;
+    char tmp[256];
+    while (request.find("\r\n\r\n") == std::string::npos) {
+        ssize_t res = co_await socket.read(tmp, sizeof(tmp));
+        if (res <= 0) {
+            co_return false;
+        }
+        request.append(tmp, res);
+    }
+    co_return true;
+}
+
+Work serve(AsyncIo &async, CryptoEngine &engine, ServerSocket &server_socket, std::vector<std::string> responses) {
+    auto raw_socket = co_await async.accept(server_socket);
+    auto socket = co_await AsyncCryptoSocket::accept(async, engine, std::move(raw_socket));
+    for (const auto &response: responses) {
+        if (!socket || !co_await read_request(*socket)) {
+            break;
+        }
+        size_t written = 0;
+        while (written < response.size()) {
+            ssize_t res = co_await socket->write(response.data() + written, response.size() - written);
+            if (res <= 0) {
+                co_return Done{};
+            }
+            written += res;
+        }
+    }
+    co_return Done{};
+}
+
+Work fetch(AsyncHTTPClient &client, size_t n, std::vector<HTTPClient::FetchStatus> &result) {
+    for (size_t i = 0; i < n; ++i) {
+        result.push_back(co_await client.Fetch("/search/?query=test"));
+    }
+    co_return Done{};
+}
+
+struct AsyncHTTPClientTest : ::testing::Test {
+    ServerSocket server_socket;
+    AsyncIo::Owner async;
+    std::shared_ptr<CryptoEngine> engine;
+    AsyncHTTPClient client;
+    AsyncHTTPClientTest()
+      : server_socket("tcp/0"),
+        async(AsyncIo::create()),
+        engine(std::make_shared<NullCryptoEngine>()),
+        client(async, engine, "localhost", server_socket.address().port(), true, false)
+    {
+        server_socket.set_blocking(false);
+    }
+    std::vector<HTTPClient::FetchStatus> run(std::vector<std::string> responses, size_t n) {
+        std::vector<HTTPClient::FetchStatus> result;
+        auto server = make_future(serve(async, *engine, server_socket, std::move(responses)));
+        auto client_done = make_future(fetch(client, n, result));
+        client_done.wait();
+        server.wait();
+        return result;
+    }
+};
+
+TEST_F(AsyncHTTPClientTest, keep_alive_connection_is_reused) {
+    auto result = run({ok_response("first"), ok_response("second result")}, 2);
+    ASSERT_EQ(2u, result.size());
+    EXPECT_TRUE(result[0].Ok());
+    EXPECT_EQ(200u, result[0].RequestStatus());
+    EXPECT_EQ(42, result[0].TotalHitCount());
+    EXPECT_EQ(5, result[0].ResultSize());
+    EXPECT_TRUE(result[1].Ok());
+    EXPECT_EQ(13, result[1].ResultSize());
+    EXPECT_EQ(1u, client.GetReuseCount());
+}
+
+TEST_F(AsyncHTTPClientTest, chunked_content_is_read) {
+    auto result = run({chunked_response(), ok_response("done")}, 2);
+    ASSERT_EQ(2u, result.size());
+    EXPECT_TRUE(result[0].Ok());
+    EXPECT_EQ(7, result[0].TotalHitCount());
+    EXPECT_EQ(11, result[0].ResultSize());
+    EXPECT_TRUE(result[1].Ok());
+    EXPECT_EQ(1u, client.GetReuseCount());
+}
+
+TEST_F(AsyncHTTPClientTest, error_status_is_not_ok) {
+    auto result = run({"HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n"}, 1);
+    ASSERT_EQ(1u, result.size());
+    EXPECT_FALSE(result[0].Ok());
+    EXPECT_EQ(503u, result[0].RequestStatus());
+    EXPECT_EQ(-1, result[0].TotalHitCount());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/fnet/databuffer.h>
+#include <vespa/fnet/buffer_pool.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <chrono>
 
@@ -53,6 +54,65 @@ TEST(DataBufferTest, testResize) {
     EXPECT_TRUE(buf.GetDataLen() == 0);
 }
 
+TEST(DataBufferTest, pooled_buffer_memory_is_reused) {
+    fnet::BufferPool pool(4096);
+    FNET_DataBuffer buf(0);
+    buf.SetPool(&pool);
+    buf.WriteInt32(42);
+    EXPECT_EQ(256u, buf.GetBufSize());
+    EXPECT_EQ(1u, pool.stats().allocs);
+    EXPECT_EQ(0u, pool.stats().reused);
+    char *mem = buf.GetDead();
+    EXPECT_EQ(42u, buf.ReadInt32());
+    EXPECT_TRUE(buf.Shrink(0));
+    EXPECT_EQ(256u, pool.stats().cached_bytes);
+    EXPECT_EQ(1u, pool.stats().cached_buffers);
+    buf.WriteInt32(43);
+    EXPECT_EQ(mem, buf.GetDead());
+    EXPECT_EQ(2u, pool.stats().allocs);
+    EXPECT_EQ(1u, pool.stats().reused);
+    EXPECT_EQ(0u, pool.stats().cached_bytes);
+    buf.EnsureFree(1000); // grows to 1024, releasing the old buffer
+    EXPECT_EQ(1024u, buf.GetBufSize());
+    EXPECT_EQ(43u, buf.ReadInt32());
+    EXPECT_EQ(256u, pool.stats().cached_bytes);
+    buf.Release();
+    EXPECT_EQ(0u, buf.GetBufSize());
+    EXPECT_EQ(1280u, pool.stats().cached_bytes);
+    EXPECT_EQ(2u, pool.stats().cached_buffers);
+    pool.clear();
+    EXPECT_EQ(0u, pool.stats().cached_bytes);
+    EXPECT_EQ(0u, pool.stats().cached_buffers);
+}
+
+TEST(DataBufferTest, buffer_pool_is_bounded_and_only_caches_pooled_sizes) {
+    fnet::BufferPool pool(1024);
+    pool.release(pool.alloc(512));
+    pool.release(pool.alloc(1000)); // not a size class
+    pool.release(pool.alloc(1024)); // would exceed the bound
+    pool.release(pool.alloc(2 * fnet::BufferPool::max_size));
+    EXPECT_EQ(512u, pool.stats().cached_bytes);
+    EXPECT_EQ(1u, pool.stats().cached_buffers);
+    auto buf = pool.alloc(512);
+    EXPECT_EQ(512u, buf.size());
+    EXPECT_EQ(1u, pool.stats().reused);
+    EXPECT_EQ(0u, pool.stats().cached_bytes);
+}
+
+TEST(DataBufferTest, swap_does_not_swap_pools) {
+    fnet::BufferPool pool(4096);
+    FNET_DataBuffer pooled(0);
+    FNET_DataBuffer plain(0);
+    pooled.SetPool(&pool);
+    pooled.WriteInt32(42);
+    plain.Swap(pooled);
+    plain.Release();
+    EXPECT_EQ(0u, pool.stats().cached_bytes);
+    pooled.WriteInt32(43);
+    pooled.Release();
+    EXPECT_EQ(256u, pool.stats().cached_bytes);
+}
+
 TEST(DataBufferTest, testSpeed) {
   using clock = std::chrono::steady_clock;
   using ms_double = std::chrono::duration<double, std::milli>;
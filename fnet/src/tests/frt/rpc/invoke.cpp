@@ -11,6 +11,7 @@
 #include <vespa/fnet/frt/invoker.h>
 #include <vespa/fnet/frt/request_access_filter.h>
 #include <vespa/fnet/frt/require_capabilities.h>
+#include <vespa/fnet/transport.h>
 #include <mutex>
 #include <condition_variable>
 #include <string_view>
@@ -512,6 +513,27 @@ TEST_F(InvokeTest, require_that_parameters_can_be_echoed_as_return_values) {
     EXPECT_TRUE(req.get().GetParams()->Equals(req.get().GetReturn()));
 }
 
+TEST_F(InvokeTest, large_values_can_be_echoed_using_zero_copy_writes) {
+    fnet::frt::StandaloneFRT client(fnet::TransportConfig().crypto(crypto).zero_copy_threshold(4096));
+    fnet::frt::StandaloneFRT server(fnet::TransportConfig().crypto(crypto).zero_copy_threshold(4096));
+    ASSERT_TRUE(server.supervisor().Listen("tcp/0"));
+    auto spec = SocketSpec::from_host_port("localhost", server.supervisor().GetListenPort()).spec();
+    auto target = vespalib::ref_counted<FRT_Target>::internal_attach(client.supervisor().GetTarget(spec.c_str()));
+    std::string data(1024 * 1024, '\0');
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = char(i * 7);
+    }
+    for (size_t i = 0; i < 8; ++i) {
+        MyReq req("frt.rpc.echo");
+        req.get().GetParams()->AddData(data.data(), data.size() - i);
+        target->InvokeSync(req.borrow(), timeout);
+        ASSERT_TRUE(!req.get().IsError());
+        ASSERT_EQ(std::string(req.get().GetReturnSpec()), "x");
+        const auto &ret = req.get().GetReturn()->GetValue(0)._data;
+        EXPECT_TRUE(std::string_view(ret._buf, ret._len) == std::string_view(data.data(), data.size() - i));
+    }
+}
+
 TEST_F(InvokeTest, request_denied_by_access_filter_returns_PERMISSION_DENIED_and_does_not_invoke_server_method) {
     MyReq req("accessRestricted");
     auto key = MyAccessFilter::WRONG_KEY;
@@ -0,0 +1,81 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/fnet/latency_histogram.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <memory>
+
+using fnet::LatencyHistogram;
+using fnet::LatencyStats;
+using namespace std::chrono_literals;
+
+TEST(LatencyHistogramTest, small_values_have_exact_buckets) {
+    for (uint64_t us = 0; us < 16; ++us) {
+        uint32_t idx = LatencyHistogram::bucket(us);
+        EXPECT_EQ(us, idx);
+        EXPECT_EQ(us, LatencyHistogram::bucket_max(idx));
+    }
+}
+
+TEST(LatencyHistogramTest, buckets_are_contiguous_with_bounded_error) {
+    uint64_t prev_max = 0;
+    for (uint32_t idx = 1; idx < LatencyHistogram::num_buckets; ++idx) {
+        uint64_t max = LatencyHistogram::bucket_max(idx);
+        uint64_t min = prev_max + 1;
+        EXPECT_EQ(idx, LatencyHistogram::bucket(min));
+        EXPECT_EQ(idx, LatencyHistogram::bucket(max));
+        EXPECT_LE(double(max - min), double(min) * 0.125);
+        prev_max = max;
+    }
+    EXPECT_EQ(LatencyHistogram::num_buckets - 1, LatencyHistogram::bucket(prev_max + 1));
+    EXPECT_EQ(LatencyHistogram::num_buckets - 1, LatencyHistogram::bucket(uint64_t(-1)));
+}
+
+TEST(LatencyHistogramTest, percentiles_are_calculated_from_buckets) {
+    LatencyHistogram hist;
+    EXPECT_EQ(0u, hist.snapshot().count());
+    EXPECT_EQ(0us, hist.snapshot().percentile(0.5));
+    for (int i = 1; i <= 100; ++i) {
+        hist.record(std::chrono::microseconds(i));
+    }
+    hist.record(-5us); // clock skew is recorded as zero
+    auto snap = hist.snapshot();
+    EXPECT_EQ(101u, snap.count());
+    EXPECT_EQ(5050us, snap.total());
+    EXPECT_EQ(50us, snap.average());
+    EXPECT_EQ(0us, snap.percentile(0.0));
+    EXPECT_EQ(51us, snap.percentile(0.5));
+    EXPECT_EQ(103us, snap.percentile(0.99));
+    EXPECT_EQ(103us, snap.max());
+}
+
+TEST(LatencyHistogramTest, snapshots_can_be_added_and_subtracted) {
+    LatencyHistogram hist;
+    hist.record(10us);
+    auto first = hist.snapshot();
+    hist.record(1ms);
+    hist.record(1ms);
+    auto delta = hist.snapshot().subtract(first);
+    EXPECT_EQ(2u, delta.count());
+    EXPECT_EQ(2ms, delta.total());
+    EXPECT_EQ(1023us, delta.percentile(0.0)); // bucket 960-1023us
+    delta.add(first);
+    EXPECT_EQ(3u, delta.count());
+    EXPECT_EQ(10us, delta.percentile(0.0));
+}
+
+TEST(LatencyHistogramTest, collected_stats_survive_destruction_of_their_owner) {
+    auto before = LatencyStats::collect();
+    auto stats = std::make_unique<LatencyStats>();
+    stats->read_to_decode.record(5us);
+    stats->output_drain.record(7us);
+    auto live = LatencyStats::collect().subtract(before);
+    EXPECT_EQ(1u, live.read_to_decode.count());
+    EXPECT_EQ(1u, live.output_drain.count());
+    EXPECT_EQ(0u, live.event_queue.count());
+    stats.reset();
+    auto retired = LatencyStats::collect().subtract(before);
+    EXPECT_EQ(1u, retired.read_to_decode.count());
+    EXPECT_EQ(7us, retired.output_drain.total());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,187 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/fnet/iexecutable.h>
+#include <vespa/fnet/priority_scheduler.h>
+#include <vespa/fnet/transport.h>
+#include <vespa/fnet/frt/invoker.h>
+#include <vespa/fnet/frt/rpcrequest.h>
+#include <vespa/fnet/frt/supervisor.h>
+#include <vespa/fnet/frt/target.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/gate.h>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using fnet::Priority;
+using fnet::PriorityScheduler;
+using namespace std::chrono_literals;
+
+struct Task : FNET_IExecutable {
+    std::string          &log;
+    char                  name;
+    PriorityScheduler    *more;
+    std::unique_ptr<Task> spawned;
+    Task(std::string &log_in, char name_in, PriorityScheduler *more_in = nullptr)
+      : log(log_in), name(name_in), more(more_in), spawned() {}
+    void execute() override {
+        log.push_back(name);
+        if (more != nullptr) {
+            spawned = std::make_unique<Task>(log, 'x');
+            more->schedule(Priority::HIGH, spawned.get());
+        }
+    }
+};
+
+struct SchedulerTest : ::testing::Test {
+    PriorityScheduler                  scheduler;
+    PriorityScheduler::QueueLatency    latency;
+    std::string                        log;
+    std::vector<std::unique_ptr<Task>> tasks;
+    SchedulerTest() : scheduler(2), latency(), log(), tasks() {}
+    ~SchedulerTest() override;
+    void schedule(Priority priority, char name, bool spawn = false) {
+        tasks.push_back(std::make_unique<Task>(log, name, spawn ? &scheduler : nullptr));
+        scheduler.schedule(priority, tasks.back().get());
+    }
+};
+
+SchedulerTest::~SchedulerTest() = default;
+
+TEST_F(SchedulerTest, tasks_are_run_in_priority_order) {
+    schedule(Priority::LOW, 'l');
+    schedule(Priority::NORMAL, 'n');
+    schedule(Priority::HIGH, 'h');
+    EXPECT_EQ(3u, scheduler.size());
+    scheduler.run_all(latency);
+    EXPECT_TRUE(scheduler.empty());
+    EXPECT_EQ("hnl", log);
+    for (const auto &hist: latency) {
+        EXPECT_EQ(1u, hist.snapshot().count());
+    }
+}
+
+TEST_F(SchedulerTest, tasks_of_same_priority_are_run_in_order) {
+    schedule(Priority::NORMAL, 'a');
+    schedule(Priority::NORMAL, 'b');
+    schedule(Priority::NORMAL, 'c');
+    scheduler.run_all(latency);
+    EXPECT_EQ("abc", log);
+    EXPECT_EQ(3u, latency[uint32_t(Priority::NORMAL)].snapshot().count());
+}
+
+TEST_F(SchedulerTest, waiting_priority_class_is_passed_over_at_most_streak_limit_times) {
+    schedule(Priority::LOW, 'l');
+    schedule(Priority::NORMAL, 'n');
+    for (char c: std::string("abcdef")) {
+        schedule(Priority::HIGH, c);
+    }
+    scheduler.run_all(latency);
+    EXPECT_EQ("abnlcdef", log);
+}
+
+TEST_F(SchedulerTest, tasks_scheduled_while_running_are_also_run) {
+    schedule(Priority::LOW, 'l', true);
+    schedule(Priority::LOW, 'm');
+    scheduler.run_all(latency);
+    // the spawned task is run before the remaining low priority task
+    EXPECT_EQ("lxm", log);
+}
+
+//-----------------------------------------------------------------------------
+
+struct BlockTransport : FNET_IExecutable {
+    vespalib::Gate started;
+    vespalib::Gate release;
+    void execute() override {
+        started.countDown();
+        release.await();
+    }
+};
+
+struct Server : FRT_Invokable {
+    fnet::frt::StandaloneFRT frt;
+    std::mutex               lock;
+    std::string              log;
+    Server()
+      : frt(fnet::TransportConfig(1).priority_streak_limit(100)),
+        lock(),
+        log()
+    {
+        FRT_ReflectionBuilder rb(&frt.supervisor());
+        rb.DefineMethod("feed", "", "", FRT_METHOD(Server::rpc_feed), this);
+        rb.MethodPriority(Priority::LOW);
+        rb.DefineMethod("query", "", "", FRT_METHOD(Server::rpc_query), this);
+        rb.MethodPriority(Priority::HIGH);
+        rb.DefineMethod("detached_query", "", "", FRT_METHOD(Server::rpc_detached_query), this);
+        rb.MethodPriority(Priority::HIGH);
+        bool ok = frt.supervisor().Listen(0);
+        EXPECT_TRUE(ok);
+    }
+    void append(char c) {
+        std::lock_guard guard(lock);
+        log.push_back(c);
+    }
+    void rpc_feed(FRT_RPCRequest *) { append('f'); }
+    void rpc_query(FRT_RPCRequest *) { append('q'); }
+    void rpc_detached_query(FRT_RPCRequest *req) {
+        req->Detach();
+        append('d');
+        req->Return();
+    }
+};
+
+struct MyWait : FRT_IRequestWait {
+    std::mutex              lock;
+    std::condition_variable cond;
+    size_t                  done = 0;
+    void RequestDone(FRT_RPCRequest *) override {
+        std::lock_guard guard(lock);
+        ++done;
+        cond.notify_all();
+    }
+    void wait_for(size_t n) {
+        std::unique_lock guard(lock);
+        cond.wait(guard, [&]{ return done >= n; });
+    }
+};
+
+TEST(PrioritizedInvocationTest, requests_decoded_together_are_invoked_in_priority_order) {
+    Server server;
+    fnet::frt::StandaloneFRT client;
+    FRT_Target *target = client.supervisor().GetTarget(server.frt.supervisor().GetListenPort());
+    FRT_RPCRequest *ping = client.supervisor().AllocRPCRequest();
+    ping->SetMethodName("frt.rpc.ping");
+    target->InvokeSync(ping, 60.0); // connect before blocking the server
+    ASSERT_FALSE(ping->IsError());
+    ping->internal_subref();
+    BlockTransport block;
+    ASSERT_TRUE(server.frt.supervisor().GetTransport()->execute(&block));
+    block.started.await();
+    MyWait wait;
+    std::vector<FRT_RPCRequest *> reqs;
+    for (const char *method: {"feed", "feed", "feed", "query", "detached_query"}) {
+        FRT_RPCRequest *req = client.supervisor().AllocRPCRequest();
+        req->SetMethodName(method);
+        target->InvokeAsync(req, 60.0, &wait);
+        reqs.push_back(req);
+    }
+    // let all requests reach the socket of the blocked server
+    std::this_thread::sleep_for(200ms);
+    block.release.countDown();
+    wait.wait_for(reqs.size());
+    for (FRT_RPCRequest *req: reqs) {
+        EXPECT_FALSE(req->IsError()) << req->GetErrorMessage();
+        req->internal_subref();
+    }
+    target->internal_subref();
+    EXPECT_EQ("qdfff", server.log);
+    auto latency = server.frt.supervisor().GetTransport()->get_latency_stats();
+    EXPECT_EQ(2u, latency.invoke_queue[uint32_t(Priority::HIGH)].count());
+    EXPECT_EQ(1u, latency.invoke_queue[uint32_t(Priority::NORMAL)].count());
+    EXPECT_EQ(3u, latency.invoke_queue[uint32_t(Priority::LOW)].count());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
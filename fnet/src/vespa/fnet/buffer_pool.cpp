@@ -0,0 +1,85 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "buffer_pool.h"
+#include <bit>
+
+namespace fnet {
+
+static_assert((BufferPool::min_size << 12) == BufferPool::max_size);
+
+int
+BufferPool::size_class(size_t size) noexcept
+{
+    if ((size < min_size) || (size > max_size) || !std::has_single_bit(size)) {
+        return -1;
+    }
+    return std::countr_zero(size) - std::countr_zero(min_size);
+}
+
+BufferPool::BufferPool(size_t max_cached_bytes)
+    : _free(),
+      _max_cached_bytes(max_cached_bytes),
+      _allocs(0),
+      _reused(0),
+      _cached_bytes(0),
+      _cached_buffers(0)
+{
+}
+
+BufferPool::~BufferPool() = default;
+
+BufferPool::Alloc
+BufferPool::alloc(uint32_t size)
+{
+    if (size == 0) {
+        return Alloc::alloc(0);
+    }
+    _allocs.store(_allocs.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    int idx = size_class(size);
+    if ((idx >= 0) && !_free[idx].empty()) {
+        Alloc buf = std::move(_free[idx].back());
+        _free[idx].pop_back();
+        _reused.store(_reused.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        _cached_bytes.store(_cached_bytes.load(std::memory_order_relaxed) - size, std::memory_order_relaxed);
+        _cached_buffers.store(_cached_buffers.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        return buf;
+    }
+    return Alloc::alloc(size);
+}
+
+void
+BufferPool::release(Alloc buf) noexcept
+{
+    size_t size = buf.size();
+    int idx = size_class(size);
+    size_t cached = _cached_bytes.load(std::memory_order_relaxed);
+    if ((idx < 0) || (buf.get() == nullptr) || ((cached + size) > _max_cached_bytes)) {
+        return; // freed when going out of scope
+    }
+    _free[idx].push_back(std::move(buf));
+    _cached_bytes.store(cached + size, std::memory_order_relaxed);
+    _cached_buffers.store(_cached_buffers.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void
+BufferPool::clear() noexcept
+{
+    for (auto &list: _free) {
+        std::vector<Alloc>().swap(list);
+    }
+    _cached_bytes.store(0, std::memory_order_relaxed);
+    _cached_buffers.store(0, std::memory_order_relaxed);
+}
+
+BufferPool::Stats
+BufferPool::stats() const noexcept
+{
+    Stats stats;
+    stats.allocs = _allocs.load(std::memory_order_relaxed);
+    stats.reused = _reused.load(std::memory_order_relaxed);
+    stats.cached_bytes = _cached_bytes.load(std::memory_order_relaxed);
+    stats.cached_buffers = _cached_buffers.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}
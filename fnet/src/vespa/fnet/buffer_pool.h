@@ -0,0 +1,78 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/alloc.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace fnet {
+
+/**
+ * A cache of released data buffer memory, used to avoid allocating
+ * and freeing memory each time a connection grows or shrinks its
+ * input or output buffer. Memory is cached in power of two size
+ * classes from 256 bytes up to 1 MiB, and the total amount of cached
+ * memory is bounded. Requests for other sizes, or released memory
+ * that does not fit, are passed on to the underlying allocator.
+ *
+ * Each transport thread owns a pool that is used by the connections
+ * it services. The pool itself is not thread safe, but its
+ * statistics may be sampled by any thread.
+ **/
+class BufferPool
+{
+public:
+    static constexpr uint32_t min_size = 256;
+    static constexpr uint32_t max_size = 1024 * 1024;
+
+    struct Stats {
+        uint64_t allocs;         // total allocations served
+        uint64_t reused;         // allocations served from the cache
+        size_t   cached_bytes;   // memory currently held by the pool
+        size_t   cached_buffers; // buffers currently held by the pool
+        Stats() noexcept : allocs(0), reused(0), cached_bytes(0), cached_buffers(0) {}
+    };
+
+private:
+    using Alloc = vespalib::alloc::Alloc;
+    static constexpr size_t num_classes = 13; // 256 B .. 1 MiB
+
+    std::array<std::vector<Alloc>, num_classes> _free;
+    size_t                                      _max_cached_bytes;
+    std::atomic<uint64_t>                       _allocs;
+    std::atomic<uint64_t>                       _reused;
+    std::atomic<size_t>                         _cached_bytes;
+    std::atomic<size_t>                         _cached_buffers;
+
+    static int size_class(size_t size) noexcept;
+
+public:
+    explicit BufferPool(size_t max_cached_bytes);
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+    ~BufferPool();
+
+    /**
+     * Allocate memory of the given size, reusing cached memory if
+     * possible.
+     **/
+    Alloc alloc(uint32_t size);
+
+    /**
+     * Give memory back to the pool. It is cached if it has a pooled
+     * size and there is room for it, otherwise it is freed.
+     **/
+    void release(Alloc buf) noexcept;
+
+    /**
+     * Free all cached memory.
+     **/
+    void clear() noexcept;
+
+    Stats stats() const noexcept;
+};
+
+}
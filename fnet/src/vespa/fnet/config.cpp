@@ -7,7 +7,11 @@ FNET_Config::FNET_Config()
       _events_before_wakeup(1),
       _maxInputBufferSize(0x10000),
       _maxOutputBufferSize(0x10000),
+      _zero_copy_threshold(0),
+      _buffer_pool_size(4 * 1024 * 1024),
+      _priority_streak_limit(0),
       _tcpNoDelay(true),
-      _drop_empty_buffers(false)
+      _drop_empty_buffers(false),
+      _use_io_uring(false)
 {
 }
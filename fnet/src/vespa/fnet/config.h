@@ -15,8 +15,12 @@ public:
     uint32_t  _events_before_wakeup;
     uint32_t  _maxInputBufferSize;
     uint32_t  _maxOutputBufferSize;
+    uint32_t  _zero_copy_threshold;
+    uint32_t  _buffer_pool_size;
+    uint32_t  _priority_streak_limit;
     bool      _tcpNoDelay;
     bool      _drop_empty_buffers;
+    bool      _use_io_uring;
 
     FNET_Config();
 };
@@ -16,6 +16,7 @@
 LOG_SETUP(".fnet");
 
 std::atomic<uint64_t> FNET_Connection::_num_connections = 0;
+std::atomic<uint64_t> FNET_Connection::_zero_copy_bytes_sent = 0;
 
 namespace {
 class SyncPacket : public FNET_DummyPacket {
@@ -280,6 +281,8 @@ bool
 FNET_Connection::handle_packets()
 {
     bool broken = false;
+    vespalib::steady_time decode_time = vespalib::steady_clock::now();
+    auto &read_to_decode = Owner()->latency_stats().read_to_decode;
     for (bool done = false; !done;) { // handle each complete packet in the buffer.
         if (!_flags._gotheader) {
             _flags._gotheader = _streamer->GetPacketInfo(&_input, &_packetLength,
@@ -287,6 +290,7 @@ FNET_Connection::handle_packets()
                     &broken);
         }
         if (_flags._gotheader && (_input.GetDataLen() >= _packetLength)) {
+            read_to_decode.record(decode_time - Owner()->poll_time());
             HandlePacket(_packetLength, _packetCode, _packetCHID);
             _flags._gotheader = false; // reset header flag.
         } else {
@@ -380,11 +384,16 @@ FNET_Connection::Write()
     FNET_Packet     *packet;
     FNET_Context     context;
 
+    if ((_outputZeroCopyWrites > 0) || !_zeroCopyBuffers.empty()) {
+        reap_zero_copy_completions();
+    }
+
     do {
 
-        // fill output buffer
+        // fill output buffer (not allowed to touch it while the
+        // kernel might still be reading from it)
 
-        while (_output.GetDataLen() < chunk_size) {
+        while ((_outputZeroCopyWrites == 0) && (_output.GetDataLen() < chunk_size)) {
             if (_myQueue.IsEmpty_NoLock())
                 break;
 
@@ -402,12 +411,25 @@ FNET_Connection::Write()
 
         // write data
 
-        res = _socket->write(_output.GetData(), _output.GetDataLen());
+        bool zero_copy = use_zero_copy(_output.GetDataLen());
+        if (zero_copy) {
+            res = _socket->write_zero_copy(_output.GetData(), _output.GetDataLen());
+        } else {
+            res = _socket->write(_output.GetData(), _output.GetDataLen());
+        }
         my_errno = errno;
         writeCnt++;
         if (res > 0) {
+            if (zero_copy) {
+                ++_outputZeroCopyWrites;
+                _zero_copy_bytes_sent.fetch_add(res, std::memory_order_relaxed);
+            }
             _output.DataToDead((uint32_t)res);
-            _output.resetIfEmpty();
+            if (_outputZeroCopyWrites == 0) {
+                _output.resetIfEmpty();
+            } else if (_output.GetDataLen() == 0) {
+                retire_output_buffer();
+            }
         }
     } while (res > 0 &&
              _output.GetDataLen() == 0 &&
@@ -429,10 +451,12 @@ FNET_Connection::Write()
 
     if (_flags._drop_empty_buffers) {
         _socket->drop_empty_buffers();
-        _output.Shrink(0);
+        if (_outputZeroCopyWrites == 0) {
+            _output.Shrink(0);
+        }
     }
     uint32_t maxSize = getConfig()._maxOutputBufferSize;
-    if (maxSize > 0 && _output.GetBufSize() > maxSize) {
+    if (maxSize > 0 && _output.GetBufSize() > maxSize && _outputZeroCopyWrites == 0) {
         _output.Shrink(maxSize);
     }
 
@@ -452,14 +476,59 @@ FNET_Connection::Write()
                  + _myQueue.GetPacketCnt_NoLock()
                  + my_write_work;
     bool writePending = (_writeWork > 0);
+    vespalib::steady_time writeWorkTime = _writeWorkTime;
 
     guard.unlock();
-    if (!writePending)
+    if (!writePending) {
         EnableWriteEvent(false);
+        Owner()->latency_stats().output_drain.record(vespalib::steady_clock::now() - writeWorkTime);
+    }
 
     return !broken;
 }
 
+bool
+FNET_Connection::use_zero_copy(uint32_t len)
+{
+    uint32_t threshold = getConfig()._zero_copy_threshold;
+    if ((threshold == 0) || (len < threshold)) {
+        return false;
+    }
+    if (!_flags._zero_copy_probed) {
+        _flags._zero_copy_probed = true;
+        _flags._zero_copy = _socket->enable_zero_copy();
+        LOG(debug, "Connection(%s): zero-copy writes %s", GetSpec(),
+            _flags._zero_copy ? "enabled" : "not supported");
+    }
+    return _flags._zero_copy;
+}
+
+void
+FNET_Connection::reap_zero_copy_completions()
+{
+    // zero-copy writes complete in order; oldest buffers first
+    size_t completed = _socket->reap_zero_copy_completions();
+    while ((completed > 0) && !_zeroCopyBuffers.empty()) {
+        ZeroCopyBuffer &oldest = _zeroCopyBuffers.front();
+        size_t n = std::min(completed, size_t(oldest.writes));
+        oldest.writes -= n;
+        completed -= n;
+        if (oldest.writes == 0) {
+            _zeroCopyBuffers.pop_front();
+        }
+    }
+    _outputZeroCopyWrites -= std::min(completed, size_t(_outputZeroCopyWrites));
+}
+
+void
+FNET_Connection::retire_output_buffer()
+{
+    auto buffer = std::make_unique<FNET_DataBuffer>(0);
+    buffer->Swap(_output);
+    _zeroCopyBuffers.push_back(ZeroCopyBuffer{_outputZeroCopyWrites, std::move(buffer)});
+    _outputZeroCopyWrites = 0;
+}
+
 ////////////////////
 // PUBLIC METHODS //
 ////////////////////
@@ -482,15 +551,20 @@ FNET_Connection::FNET_Connection(FNET_TransportThread *owner,
       _packetCode(0),
       _packetCHID(0),
       _writeWork(0),
+      _writeWorkTime(),
       _currentID(1), // <-- NB
       _input(0),
       _queue(256),
       _myQueue(256),
       _output(0),
+      _outputZeroCopyWrites(0),
+      _zeroCopyBuffers(),
       _channels(),
       _callbackTarget(nullptr)
 {
     assert(_socket && (_socket->get_fd() >= 0));
+    _input.SetPool(&owner->buffer_pool());
+    _output.SetPool(&owner->buffer_pool());
     _num_connections.fetch_add(1, std::memory_order_relaxed);
 }
 
@@ -512,14 +586,19 @@ FNET_Connection::FNET_Connection(FNET_TransportThread *owner,
       _packetCode(0),
       _packetCHID(0),
       _writeWork(0),
+      _writeWorkTime(),
       _currentID(0),
       _input(0),
       _queue(256),
       _myQueue(256),
       _output(0),
+      _outputZeroCopyWrites(0),
+      _zeroCopyBuffers(),
       _channels(),
       _callbackTarget(nullptr)
 {
+    _input.SetPool(&owner->buffer_pool());
+    _output.SetPool(&owner->buffer_pool());
     _num_connections.fetch_add(1, std::memory_order_relaxed);
 }
 
@@ -658,6 +737,9 @@ FNET_Connection::PostPacket(FNET_Packet *packet, uint32_t chid)
     }
     writeWork = _writeWork;
     _writeWork++;
+    if (writeWork == 0) {
+        _writeWorkTime = vespalib::steady_clock::now();
+    }
     _queue.QueuePacket_NoLock(packet, FNET_Context(chid));
     if ((writeWork == 0) && (GetState() == FNET_CONNECTED)) {
         internal_addref();
@@ -687,6 +769,15 @@ FNET_Connection::Close()
     if (!_flags._handshake_work_pending) {
         _socket.reset();
     }
+    // give buffer memory back to the transport thread while we are
+    // still running in it; the kernel may still be reading output
+    // handed to zero-copy writes
+    _input.Release();
+    if (_outputZeroCopyWrites == 0) {
+        _output.Release();
+    }
+    _input.SetPool(nullptr);
+    _output.SetPool(nullptr);
 }
 
 
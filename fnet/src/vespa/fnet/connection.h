@@ -13,6 +13,7 @@
 #include <vespa/vespalib/net/crypto_socket.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <atomic>
+#include <deque>
 
 class FNET_IPacketStreamer;
 class FNET_IServerAdapter;
@@ -54,7 +55,9 @@ private:
             _discarding(false),
             _framed(false),
             _handshake_work_pending(false),
-            _drop_empty_buffers(cfg._drop_empty_buffers)
+            _drop_empty_buffers(cfg._drop_empty_buffers),
+            _zero_copy_probed(false),
+            _zero_copy(false)
         { }
         bool _gotheader;
         bool _inCallback;
@@ -63,6 +66,13 @@ private:
         bool _framed;
         bool _handshake_work_pending;
         bool _drop_empty_buffers;
+        bool _zero_copy_probed;
+        bool _zero_copy;
+    };
+    // output buffer kept alive until the kernel is done with it
+    struct ZeroCopyBuffer {
+        uint32_t                         writes; // zero-copy writes in flight
+        std::unique_ptr<FNET_DataBuffer> buffer;
     };
     struct ResolveHandler : public vespalib::AsyncResolver::ResultHandler {
         FNET_Connection *connection;
@@ -83,17 +93,21 @@ private:
     uint32_t                 _packetCode;      // packet code
     uint32_t                 _packetCHID;      // packet chid
     uint32_t                 _writeWork;       // pending write work
+    vespalib::steady_time    _writeWorkTime;   // when write work became pending
     uint32_t                 _currentID;       // current channel ID
     FNET_DataBuffer          _input;           // input buffer
     FNET_PacketQueue_NoLock  _queue;           // outer output queue
     FNET_PacketQueue_NoLock  _myQueue;         // inner output queue
     FNET_DataBuffer          _output;          // output buffer
+    uint32_t                 _outputZeroCopyWrites; // zero-copy writes in flight from output buffer
+    std::deque<ZeroCopyBuffer> _zeroCopyBuffers; // retired output buffers
     FNET_ChannelLookup       _channels;        // channel 'DB'
     FNET_Channel            *_callbackTarget;  // target of current callback
 
     std::unique_ptr<vespalib::net::ConnectionAuthContext> _auth_context;
 
     static std::atomic<uint64_t> _num_connections; // total number of connections
+    static std::atomic<uint64_t> _zero_copy_bytes_sent; // total bytes written zero-copy
 
 
     /**
@@ -214,6 +228,24 @@ private:
 
     bool writePendingAfterConnect();
 
+    /**
+     * Check whether a chunk of the given size should be written
+     * using a zero-copy write. Zero-copy writes are enabled on the
+     * socket the first time a large enough chunk is written.
+     **/
+    bool use_zero_copy(uint32_t len);
+
+    /**
+     * Release output buffers no longer referenced by the kernel.
+     **/
+    void reap_zero_copy_completions();
+
+    /**
+     * Hand over the (fully written) output buffer to be kept alive
+     * until all zero-copy writes from it have completed.
+     **/
+    void retire_output_buffer();
+
 public:
     FNET_Connection(const FNET_Connection &) = delete;
     FNET_Connection &operator=(const FNET_Connection &) = delete;
@@ -477,4 +509,11 @@ public:
     static uint64_t get_num_connections() {
         return _num_connections.load(std::memory_order_relaxed);
     }
+
+    /**
+     * @return the total number of bytes written using zero-copy writes
+     **/
+    static uint64_t get_zero_copy_bytes_sent() {
+        return _zero_copy_bytes_sent.load(std::memory_order_relaxed);
+    }
 };
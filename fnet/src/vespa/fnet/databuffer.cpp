@@ -1,13 +1,16 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "databuffer.h"
+#include "buffer_pool.h"
 #include <cstdio>
 
 FNET_DataBuffer::FNET_DataBuffer(uint32_t len)
     : _bufstart(nullptr),
       _bufend(nullptr),
       _datapt(nullptr),
-      _freept(nullptr)
+      _freept(nullptr),
+      _ownedBuf(),
+      _pool(nullptr)
 {
     if (len > 0 && len < 256)
         len = 256;
@@ -28,7 +31,9 @@ FNET_DataBuffer::FNET_DataBuffer(char *buf, uint32_t len)
     : _bufstart(buf),
       _bufend(buf + len),
       _datapt(_bufstart),
-      _freept(_bufstart)
+      _freept(_bufstart),
+      _ownedBuf(),
+      _pool(nullptr)
 {
 }
 
@@ -38,6 +43,32 @@ FNET_DataBuffer::~FNET_DataBuffer()
 }
 
 
+FNET_DataBuffer::Alloc
+FNET_DataBuffer::allocate(uint32_t len)
+{
+    return (_pool != nullptr) ? _pool->alloc(len) : Alloc::alloc(len);
+}
+
+
+void
+FNET_DataBuffer::recycle(Alloc buf) noexcept
+{
+    if (_pool != nullptr) {
+        _pool->release(std::move(buf));
+    }
+}
+
+
+void
+FNET_DataBuffer::Release()
+{
+    Alloc old;
+    old.swap(_ownedBuf);
+    recycle(std::move(old));
+    _bufstart = _bufend = _datapt = _freept = nullptr;
+}
+
+
 void
 FNET_DataBuffer::FreeToData(uint32_t len)
 {
@@ -70,11 +101,12 @@ FNET_DataBuffer::Shrink(uint32_t newsize)
         return false;
     }
     
-    Alloc newBuf(Alloc::alloc(newsize));
+    Alloc newBuf(allocate(newsize));
     if (data_len > 0) [[likely]] {
         memcpy(newBuf.get(), _datapt, data_len);
     }
     _ownedBuf.swap(newBuf);
+    recycle(std::move(newBuf));
     _bufstart = static_cast<char *>(_ownedBuf.get());
     _freept   = _bufstart + data_len;
     _datapt   = _bufstart;
@@ -96,11 +128,12 @@ FNET_DataBuffer::Pack(uint32_t needbytes)
         while (bufsize - GetDataLen() < needbytes)
             bufsize *= 2;
 
-        Alloc newBuf(Alloc::alloc(bufsize));
+        Alloc newBuf(allocate(bufsize));
         if (_datapt != nullptr) [[likely]] {
             memcpy(newBuf.get(), _datapt, GetDataLen());
         }
         _ownedBuf.swap(newBuf);
+        recycle(std::move(newBuf));
         _bufstart = static_cast<char *>(_ownedBuf.get());
         _freept   = _bufstart + GetDataLen();
         _datapt   = _bufstart;
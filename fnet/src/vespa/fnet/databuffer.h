@@ -6,6 +6,9 @@
 #include <vespa/vespalib/util/alloc.h>
 #include <cassert>
 #include <cstring>
+#include <utility>
+
+namespace fnet { class BufferPool; }
 
 /**
  * This is a buffer that may hold the stream representation of
@@ -37,10 +40,14 @@ private:
     char  *_datapt;
     char  *_freept;
     Alloc  _ownedBuf;
+    fnet::BufferPool *_pool;
 
     FNET_DataBuffer(const FNET_DataBuffer &);
     FNET_DataBuffer &operator=(const FNET_DataBuffer &);
 
+    Alloc allocate(uint32_t len);
+    void recycle(Alloc buf) noexcept;
+
 public:
 
     /**
@@ -142,6 +149,39 @@ public:
     void Clear() { _datapt = _freept = _bufstart; }
 
 
+    /**
+     * Use the given pool when allocating and releasing memory for
+     * this buffer. The pool is not owned by the buffer, and is only
+     * used by methods that reallocate memory. Set it to nullptr to
+     * stop using it before the pool goes away.
+     *
+     * @param pool the pool to use, or nullptr to use plain allocation.
+     **/
+    void SetPool(fnet::BufferPool *pool) { _pool = pool; }
+
+    /**
+     * Discard all data in this buffer and release the underlying
+     * memory (to the pool, if this buffer has one).
+     **/
+    void Release();
+
+
+    /**
+     * Swap the contents (including the underlying memory) of this
+     * buffer with another buffer. The memory pools used by the
+     * buffers are not swapped.
+     *
+     * @param other the buffer to swap with.
+     **/
+    void Swap(FNET_DataBuffer &other) noexcept {
+        std::swap(_bufstart, other._bufstart);
+        std::swap(_bufend, other._bufend);
+        std::swap(_datapt, other._datapt);
+        std::swap(_freept, other._freept);
+        _ownedBuf.swap(other._ownedBuf);
+    }
+
+
     /**
      * Shrink this buffer. The given value is the new wanted size of
      * this buffer. If the buffer is already smaller or equal in size
@@ -3,6 +3,8 @@
 #include "invoker.h"
 #include "supervisor.h"
 #include <vespa/fnet/channel.h>
+#include <vespa/fnet/connection.h>
+#include <vespa/fnet/transport_thread.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".fnet.frt.invoker");
@@ -79,6 +81,25 @@ bool FRT_RPCInvoker::Invoke()
     return true;
 }
 
+fnet::Priority
+FRT_RPCInvoker::GetPriority() const
+{
+    return _method->GetPriority();
+}
+
+void
+FRT_RPCInvoker::execute()
+{
+    FNET_TransportThread &thread = *GetConnection()->Owner();
+    thread.latency_stats().read_to_invoke.record(vespalib::steady_clock::now() - thread.poll_time());
+    bool detached = false;
+    _req->SetDetachedPT(&detached);
+    (_method->GetHandler()->*_method->GetMethod())(_req);
+    if (!detached) {
+        HandleDone(true);
+    }
+}
+
 void
 FRT_RPCInvoker::HandleDone(bool freeChannel)
 {
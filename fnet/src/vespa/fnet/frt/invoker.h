@@ -3,6 +3,8 @@
 #pragma once
 
 #include "rpcrequest.h"
+#include <vespa/fnet/iexecutable.h>
+#include <vespa/fnet/priority.h>
 #include <vespa/fnet/task.h>
 #include <vespa/fnet/ipackethandler.h>
 #include <mutex>
@@ -58,7 +60,8 @@ public:
 
 //-----------------------------------------------------------------------------
 
-class FRT_RPCInvoker : public FRT_IReturnHandler
+class FRT_RPCInvoker : public FRT_IReturnHandler,
+                       public FNET_IExecutable
 {
 private:
     FRT_RPCRequest *_req;
@@ -77,10 +80,16 @@ public:
 
     FRT_RPCRequest *GetRequest() { return _req; }
 
+    fnet::Priority GetPriority() const;
+
     void HandleDone(bool freeChannel);
     bool Invoke();
     void HandleReturn() override;
     FNET_Connection *GetConnection() override;
+
+    // Invoke a request that was deferred outside the packet delivery
+    // callback, after the channel was closed
+    void execute() override;
 };
 
 //-----------------------------------------------------------------------------
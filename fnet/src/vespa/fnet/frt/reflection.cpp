@@ -15,7 +15,8 @@ FRT_Method::FRT_Method(const char * name, const char * paramSpec, const char * r
       _method(method),
       _handler(handler),
       _doc(),
-      _access_filter()
+      _access_filter(),
+      _priority(fnet::Priority::NORMAL)
 {
 }
 
@@ -126,6 +127,7 @@ FRT_ReflectionBuilder::Flush()
 
     _method->SetDocumentation(_values);
     _method->SetRequestAccessFilter(std::move(_access_filter)); // May be nullptr
+    _method->SetPriority(_priority);
     _method = nullptr;
     _req->Reset();
 }
@@ -145,7 +147,8 @@ FRT_ReflectionBuilder::FRT_ReflectionBuilder(FRT_Supervisor *supervisor)
       _arg_desc(nullptr),
       _ret_name(nullptr),
       _ret_desc(nullptr),
-      _access_filter()
+      _access_filter(),
+      _priority(fnet::Priority::NORMAL)
 {
 }
 
@@ -187,6 +190,7 @@ FRT_ReflectionBuilder::DefineMethod(const char    *name,
     _ret_name = _values->AddStringArray(_retCnt);
     _ret_desc = _values->AddStringArray(_retCnt);
     _access_filter.reset();
+    _priority = fnet::Priority::NORMAL;
 }
 
 
@@ -237,3 +241,12 @@ FRT_ReflectionBuilder::RequestAccessFilter(std::unique_ptr<FRT_RequestAccessFilt
     }
     _access_filter = std::move(access_filter);
 }
+
+void
+FRT_ReflectionBuilder::MethodPriority(fnet::Priority priority)
+{
+    if (_method == nullptr) {
+        return;
+    }
+    _priority = priority;
+}
@@ -4,6 +4,7 @@
 
 #include "invokable.h"
 #include "request_access_filter.h"
+#include <vespa/fnet/priority.h>
 #include <memory>
 #include <string>
 #include <vector>
@@ -26,6 +27,7 @@ private:
     FRT_Invokable     *_handler;       // method handler
     std::vector<char>  _doc;           // method documentation
     std::unique_ptr<FRT_RequestAccessFilter> _access_filter; // (optional) access filter
+    fnet::Priority     _priority;      // scheduling priority class
 
 public:
     FRT_Method(const FRT_Method &) = delete;
@@ -48,6 +50,8 @@ public:
     void SetRequestAccessFilter(std::unique_ptr<FRT_RequestAccessFilter> access_filter) noexcept {
         _access_filter = std::move(access_filter);
     }
+    fnet::Priority GetPriority() const noexcept { return _priority; }
+    void SetPriority(fnet::Priority priority) noexcept { _priority = priority; }
     void SetDocumentation(FRT_Values *values);
     void GetDocumentation(FRT_Values *values);
 };
@@ -112,6 +116,7 @@ private:
     FRT_StringValue *_ret_name;
     FRT_StringValue *_ret_desc;
     std::unique_ptr<FRT_RequestAccessFilter> _access_filter;
+    fnet::Priority   _priority;
 
     FRT_ReflectionBuilder(const FRT_ReflectionBuilder &);
     FRT_ReflectionBuilder &operator=(const FRT_ReflectionBuilder &);
@@ -131,5 +136,9 @@ public:
     void ParamDesc(const char *name, const char *desc);
     void ReturnDesc(const char *name, const char *desc);
     void RequestAccessFilter(std::unique_ptr<FRT_RequestAccessFilter> access_filter);
+    // Requests for methods of higher priority may be invoked before
+    // requests of lower priority decoded before them, if the transport
+    // is configured to prioritize invocations. Default is NORMAL.
+    void MethodPriority(fnet::Priority priority);
 };
 
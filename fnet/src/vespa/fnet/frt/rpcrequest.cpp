@@ -4,9 +4,78 @@
 #include "packets.h"
 #include <vespa/fnet/info.h>
 #include <cassert>
+#include <vector>
+
+namespace {
+
+// Per-thread cache of memory for destructed requests and of their
+// (cleared) stashes. Requests are often created and destructed by
+// different threads, so each cache is bounded.
+struct RequestCache {
+    static constexpr size_t max_cached = 128;
+    std::vector<void*>           memory;
+    std::vector<vespalib::Stash> stashes;
+    RequestCache() : memory(), stashes() {}
+    ~RequestCache();
+};
+
+// trivially destructible; tells us if the cache may still be used
+// while the thread is exiting
+thread_local bool request_cache_destroyed = false;
+thread_local RequestCache request_cache;
+
+RequestCache::~RequestCache() {
+    request_cache_destroyed = true;
+    for (void *mem: memory) {
+        ::operator delete(mem);
+    }
+}
+
+vespalib::Stash
+take_cached_stash() {
+    if (!request_cache_destroyed && !request_cache.stashes.empty()) {
+        vespalib::Stash stash(std::move(request_cache.stashes.back()));
+        request_cache.stashes.pop_back();
+        return stash;
+    }
+    return {};
+}
+
+void
+cache_stash(vespalib::Stash &stash) {
+    stash.clear();
+    if (!request_cache_destroyed && (request_cache.stashes.size() < RequestCache::max_cached) &&
+        (stash.get_memory_usage().allocatedBytes() <= stash.get_chunk_size()))
+    {
+        request_cache.stashes.push_back(std::move(stash));
+    }
+}
+
+}
+
+void *
+FRT_RPCRequest::operator new(size_t size)
+{
+    if ((size == sizeof(FRT_RPCRequest)) && !request_cache_destroyed && !request_cache.memory.empty()) {
+        void *mem = request_cache.memory.back();
+        request_cache.memory.pop_back();
+        return mem;
+    }
+    return ::operator new(size);
+}
+
+void
+FRT_RPCRequest::operator delete(void *ptr) noexcept
+{
+    if ((ptr != nullptr) && !request_cache_destroyed && (request_cache.memory.size() < RequestCache::max_cached)) {
+        request_cache.memory.push_back(ptr);
+        return;
+    }
+    ::operator delete(ptr);
+}
 
 FRT_RPCRequest::FRT_RPCRequest()
-    : _stash(),
+    : _stash(take_cached_stash()),
       _context(),
       _params(_stash),
       _return(_stash),
@@ -21,7 +90,12 @@ FRT_RPCRequest::FRT_RPCRequest()
       _returnHandler(nullptr)
 { }
 
-FRT_RPCRequest::~FRT_RPCRequest() = default;
+FRT_RPCRequest::~FRT_RPCRequest()
+{
+    _params.Reset();
+    _return.Reset();
+    cache_stash(_stash);
+}
 
 void
 FRT_RPCRequest::SetError(uint32_t errorCode, const char *errorMessage, uint32_t errorMessageLen)
@@ -63,6 +63,11 @@ public:
     FRT_RPCRequest();
     ~FRT_RPCRequest();
 
+    // request objects and their stash memory are recycled through a
+    // small per-thread cache to avoid malloc churn at high call rates
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr) noexcept;
+
     void Reset();
     bool Recycle();
 
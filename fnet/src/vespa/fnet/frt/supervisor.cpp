@@ -192,6 +192,15 @@ FRT_Supervisor::HandlePacket(FNET_Packet *packet, FNET_Context context)
 
     } else {
 
+        if (FNET_Connection *conn = invoker->GetConnection()) {
+            FNET_TransportThread &thread = *conn->Owner();
+            if (thread.prioritize()) {
+                // invoked by the transport thread after this poll, as if detached
+                thread.schedule(invoker->GetPriority(), invoker);
+                return FNET_CLOSE_CHANNEL;
+            }
+            thread.latency_stats().read_to_invoke.record(vespalib::steady_clock::now() - thread.poll_time());
+        }
         return (invoker->Invoke()) ?
             FNET_FREE_CHANNEL : FNET_CLOSE_CHANNEL;
 
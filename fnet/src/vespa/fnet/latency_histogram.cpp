@@ -0,0 +1,201 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "latency_histogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+namespace fnet {
+
+namespace {
+
+struct Registry {
+    std::mutex                       lock;
+    std::vector<const LatencyStats*> live;
+    LatencyStats::Snapshot           retired;
+};
+
+Registry &registry() {
+    static Registry instance;
+    return instance;
+}
+
+}
+
+LatencyHistogram::Snapshot::Snapshot() noexcept
+    : _counts(),
+      _total_us(0)
+{
+}
+
+uint64_t
+LatencyHistogram::Snapshot::count() const noexcept
+{
+    uint64_t sum = 0;
+    for (uint64_t cnt: _counts) {
+        sum += cnt;
+    }
+    return sum;
+}
+
+vespalib::duration
+LatencyHistogram::Snapshot::average() const noexcept
+{
+    uint64_t cnt = count();
+    return std::chrono::microseconds((cnt > 0) ? (_total_us / cnt) : 0);
+}
+
+vespalib::duration
+LatencyHistogram::Snapshot::percentile(double quantile) const noexcept
+{
+    uint64_t cnt = count();
+    if (cnt == 0) {
+        return vespalib::duration::zero();
+    }
+    uint64_t rank = std::clamp(uint64_t(std::ceil(quantile * cnt)), uint64_t(1), cnt);
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < num_buckets; ++i) {
+        seen += _counts[i];
+        if (seen >= rank) {
+            return std::chrono::microseconds(bucket_max(i));
+        }
+    }
+    return std::chrono::microseconds(bucket_max(num_buckets - 1));
+}
+
+void
+LatencyHistogram::Snapshot::add(const Snapshot &rhs) noexcept
+{
+    for (uint32_t i = 0; i < num_buckets; ++i) {
+        _counts[i] += rhs._counts[i];
+    }
+    _total_us += rhs._total_us;
+}
+
+LatencyHistogram::Snapshot
+LatencyHistogram::Snapshot::subtract(const Snapshot &rhs) const noexcept
+{
+    Snapshot result;
+    for (uint32_t i = 0; i < num_buckets; ++i) {
+        result._counts[i] = _counts[i] - rhs._counts[i];
+    }
+    result._total_us = _total_us - rhs._total_us;
+    return result;
+}
+
+LatencyHistogram::LatencyHistogram() noexcept
+    : _counts(),
+      _total_us(0)
+{
+}
+
+uint32_t
+LatencyHistogram::bucket(uint64_t us) noexcept
+{
+    if (us < sub_buckets) {
+        return us;
+    }
+    uint32_t exponent = std::bit_width(us) - 1;
+    if (exponent > max_exponent) {
+        return num_buckets - 1;
+    }
+    return (exponent - sub_bucket_bits + 1) * sub_buckets + ((us >> (exponent - sub_bucket_bits)) - sub_buckets);
+}
+
+uint64_t
+LatencyHistogram::bucket_max(uint32_t idx) noexcept
+{
+    if (idx < sub_buckets) {
+        return idx;
+    }
+    uint32_t shift = (idx / sub_buckets) - 1;
+    uint64_t lower = uint64_t(sub_buckets + (idx % sub_buckets)) << shift;
+    return lower + (uint64_t(1) << shift) - 1;
+}
+
+LatencyHistogram::Snapshot
+LatencyHistogram::snapshot() const noexcept
+{
+    Snapshot result;
+    for (uint32_t i = 0; i < num_buckets; ++i) {
+        result._counts[i] = _counts[i].load(std::memory_order_relaxed);
+    }
+    result._total_us = _total_us.load(std::memory_order_relaxed);
+    return result;
+}
+
+void
+LatencyStats::Snapshot::add(const Snapshot &rhs) noexcept
+{
+    read_to_decode.add(rhs.read_to_decode);
+    event_queue.add(rhs.event_queue);
+    read_to_invoke.add(rhs.read_to_invoke);
+    output_drain.add(rhs.output_drain);
+    for (size_t i = 0; i < invoke_queue.size(); ++i) {
+        invoke_queue[i].add(rhs.invoke_queue[i]);
+    }
+}
+
+LatencyStats::Snapshot
+LatencyStats::Snapshot::subtract(const Snapshot &rhs) const noexcept
+{
+    Snapshot result;
+    result.read_to_decode = read_to_decode.subtract(rhs.read_to_decode);
+    result.event_queue = event_queue.subtract(rhs.event_queue);
+    result.read_to_invoke = read_to_invoke.subtract(rhs.read_to_invoke);
+    result.output_drain = output_drain.subtract(rhs.output_drain);
+    for (size_t i = 0; i < invoke_queue.size(); ++i) {
+        result.invoke_queue[i] = invoke_queue[i].subtract(rhs.invoke_queue[i]);
+    }
+    return result;
+}
+
+LatencyStats::LatencyStats()
+    : read_to_decode(),
+      event_queue(),
+      read_to_invoke(),
+      output_drain(),
+      invoke_queue()
+{
+    auto &reg = registry();
+    std::lock_guard guard(reg.lock);
+    reg.live.push_back(this);
+}
+
+LatencyStats::~LatencyStats()
+{
+    auto &reg = registry();
+    std::lock_guard guard(reg.lock);
+    reg.retired.add(snapshot());
+    reg.live.erase(std::find(reg.live.begin(), reg.live.end(), this));
+}
+
+LatencyStats::Snapshot
+LatencyStats::snapshot() const noexcept
+{
+    Snapshot result;
+    result.read_to_decode = read_to_decode.snapshot();
+    result.event_queue = event_queue.snapshot();
+    result.read_to_invoke = read_to_invoke.snapshot();
+    result.output_drain = output_drain.snapshot();
+    for (size_t i = 0; i < invoke_queue.size(); ++i) {
+        result.invoke_queue[i] = invoke_queue[i].snapshot();
+    }
+    return result;
+}
+
+LatencyStats::Snapshot
+LatencyStats::collect()
+{
+    auto &reg = registry();
+    std::lock_guard guard(reg.lock);
+    Snapshot result = reg.retired;
+    for (const LatencyStats *stats: reg.live) {
+        result.add(stats->snapshot());
+    }
+    return result;
+}
+
+}
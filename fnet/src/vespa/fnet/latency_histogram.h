@@ -0,0 +1,117 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "priority.h"
+#include <vespa/vespalib/util/time.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace fnet {
+
+/**
+ * A histogram of latencies that is cheap enough to be updated for
+ * each packet. Latencies are counted in log-linear buckets of
+ * microseconds in the style of HDR histograms; each power of two is
+ * split into 8 sub-buckets, giving a relative error of at most
+ * 12.5%. Latencies above ~2 minutes are counted in the last bucket.
+ *
+ * A histogram has a single writer (the transport thread owning it),
+ * while snapshots may be taken by any thread.
+ **/
+class LatencyHistogram
+{
+public:
+    static constexpr uint32_t sub_bucket_bits = 3;
+    static constexpr uint32_t sub_buckets = 1u << sub_bucket_bits;
+    static constexpr uint32_t max_exponent = 26;
+    static constexpr uint32_t num_buckets = (max_exponent - sub_bucket_bits + 2) * sub_buckets;
+
+    class Snapshot {
+    private:
+        std::array<uint64_t, num_buckets> _counts;
+        uint64_t                          _total_us;
+        friend class LatencyHistogram;
+    public:
+        Snapshot() noexcept;
+        uint64_t count() const noexcept;
+        vespalib::duration total() const noexcept { return std::chrono::microseconds(_total_us); }
+        vespalib::duration average() const noexcept;
+        // the highest latency counted in the bucket holding the given quantile (0.0 - 1.0)
+        vespalib::duration percentile(double quantile) const noexcept;
+        vespalib::duration max() const noexcept { return percentile(1.0); }
+        void add(const Snapshot &rhs) noexcept;
+        Snapshot subtract(const Snapshot &rhs) const noexcept;
+    };
+
+private:
+    std::array<std::atomic<uint64_t>, num_buckets> _counts;
+    std::atomic<uint64_t>                          _total_us;
+
+public:
+    LatencyHistogram() noexcept;
+    LatencyHistogram(const LatencyHistogram &) = delete;
+    LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+    static uint32_t bucket(uint64_t us) noexcept;
+    static uint64_t bucket_max(uint32_t idx) noexcept;
+
+    void record(vespalib::duration latency) noexcept {
+        int64_t us = vespalib::count_us(latency);
+        uint64_t value = (us > 0) ? uint64_t(us) : 0;
+        auto &cnt = _counts[bucket(value)];
+        cnt.store(cnt.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        _total_us.store(_total_us.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+    Snapshot snapshot() const noexcept;
+};
+
+/**
+ * Latencies tracked by each transport thread, telling apart time
+ * spent waiting for the transport thread from time spent in the
+ * network and in request handlers:
+ *
+ * read_to_decode: socket seen readable -> packet decoded
+ * event_queue:    event posted to transport thread -> event handled
+ * read_to_invoke: socket seen readable -> RPC method invoked
+ * output_drain:   packet queued on idle connection -> output written
+ * invoke_queue:   RPC request decoded -> RPC method invoked, for each
+ *                 method priority class, when invocations are prioritized
+ *
+ * All live instances are registered process wide so that they may be
+ * collected without access to the transports owning them.
+ **/
+struct LatencyStats
+{
+    struct Snapshot {
+        LatencyHistogram::Snapshot read_to_decode;
+        LatencyHistogram::Snapshot event_queue;
+        LatencyHistogram::Snapshot read_to_invoke;
+        LatencyHistogram::Snapshot output_drain;
+        std::array<LatencyHistogram::Snapshot, num_priorities> invoke_queue;
+        void add(const Snapshot &rhs) noexcept;
+        Snapshot subtract(const Snapshot &rhs) const noexcept;
+    };
+
+    LatencyHistogram read_to_decode;
+    LatencyHistogram event_queue;
+    LatencyHistogram read_to_invoke;
+    LatencyHistogram output_drain;
+    std::array<LatencyHistogram, num_priorities> invoke_queue;
+
+    LatencyStats();
+    LatencyStats(const LatencyStats &) = delete;
+    LatencyStats &operator=(const LatencyStats &) = delete;
+    ~LatencyStats();
+
+    Snapshot snapshot() const noexcept;
+
+    /**
+     * Sum of all latencies recorded in this process, including those
+     * recorded by transport threads that have since been destroyed.
+     **/
+    static Snapshot collect();
+};
+
+}
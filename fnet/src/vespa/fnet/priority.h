@@ -0,0 +1,17 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace fnet {
+
+/**
+ * Priority classes for work performed by a transport thread, set for
+ * each RPC method when it is registered. Lower values are served
+ * first.
+ **/
+enum class Priority : uint8_t { HIGH = 0, NORMAL = 1, LOW = 2 };
+constexpr uint32_t num_priorities = 3;
+
+}
@@ -0,0 +1,64 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "priority_scheduler.h"
+#include "iexecutable.h"
+#include <algorithm>
+
+namespace fnet {
+
+PriorityScheduler::PriorityScheduler(uint32_t streak_limit) noexcept
+    : _queues(),
+      _passed_over(),
+      _streak_limit(std::max(streak_limit, 1u)),
+      _size(0)
+{
+}
+
+PriorityScheduler::~PriorityScheduler() = default;
+
+void
+PriorityScheduler::schedule(Priority priority, FNET_IExecutable *task)
+{
+    _queues[uint32_t(priority)].push_back(Entry{task, vespalib::steady_clock::now()});
+    ++_size;
+}
+
+uint32_t
+PriorityScheduler::select() noexcept
+{
+    uint32_t first = num_priorities;
+    for (uint32_t i = 0; i < num_priorities; ++i) {
+        if (!_queues[i].empty()) {
+            if (_passed_over[i] >= _streak_limit) {
+                return i;
+            }
+            if (first == num_priorities) {
+                first = i;
+            }
+        }
+    }
+    return first;
+}
+
+void
+PriorityScheduler::run_all(QueueLatency &queue_latency)
+{
+    while (_size > 0) {
+        uint32_t prio = select();
+        auto &queue = _queues[prio];
+        Entry entry = queue.front();
+        queue.pop_front();
+        --_size;
+        _passed_over[prio] = 0;
+        for (uint32_t i = 0; i < num_priorities; ++i) {
+            if ((i != prio) && !_queues[i].empty()) {
+                ++_passed_over[i];
+            }
+        }
+        queue_latency[prio].record(vespalib::steady_clock::now() - entry.queued);
+        entry.task->execute();
+    }
+    _passed_over.fill(0);
+}
+
+}
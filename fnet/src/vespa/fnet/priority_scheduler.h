@@ -0,0 +1,60 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "latency_histogram.h"
+#include "priority.h"
+#include <array>
+#include <cstdint>
+#include <deque>
+
+class FNET_IExecutable;
+
+namespace fnet {
+
+/**
+ * Work queued by a transport thread while handling I/O events, run in
+ * priority order once all events seen by a poll have been handled.
+ * This lets RPC requests of a high priority class overtake requests
+ * of lower classes that were decoded before them, on the same or on
+ * other connections owned by the thread.
+ *
+ * To bound starvation, a priority class with queued work is never
+ * passed over more than 'streak_limit' times in a row.
+ **/
+class PriorityScheduler
+{
+public:
+    using QueueLatency = std::array<LatencyHistogram, num_priorities>;
+
+private:
+    struct Entry {
+        FNET_IExecutable      *task;
+        vespalib::steady_time  queued;
+    };
+    std::array<std::deque<Entry>, num_priorities> _queues;
+    std::array<uint32_t, num_priorities>          _passed_over;
+    uint32_t                                      _streak_limit;
+    size_t                                        _size;
+
+    uint32_t select() noexcept;
+
+public:
+    explicit PriorityScheduler(uint32_t streak_limit) noexcept;
+    PriorityScheduler(const PriorityScheduler &) = delete;
+    PriorityScheduler &operator=(const PriorityScheduler &) = delete;
+    ~PriorityScheduler();
+
+    bool empty() const noexcept { return (_size == 0); }
+    size_t size() const noexcept { return _size; }
+    void schedule(Priority priority, FNET_IExecutable *task);
+
+    /**
+     * Run all scheduled tasks, including tasks scheduled by the tasks
+     * being run. The time each task spent queued is recorded in the
+     * histogram of its priority class.
+     **/
+    void run_all(QueueLatency &queue_latency);
+};
+
+}
@@ -218,6 +218,27 @@ FNET_Transport::GetNumIOComponents()
     return result;
 }
 
+std::vector<fnet::BufferPool::Stats>
+FNET_Transport::get_buffer_pool_stats() const
+{
+    std::vector<fnet::BufferPool::Stats> result;
+    result.reserve(_threads.size());
+    for (const auto &thread: _threads) {
+        result.push_back(thread->buffer_pool().stats());
+    }
+    return result;
+}
+
+fnet::LatencyStats::Snapshot
+FNET_Transport::get_latency_stats() const
+{
+    fnet::LatencyStats::Snapshot result;
+    for (const auto &thread: _threads) {
+        result.add(thread->latency_stats().snapshot());
+    }
+    return result;
+}
+
 void
 FNET_Transport::sync()
 {
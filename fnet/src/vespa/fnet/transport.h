@@ -4,6 +4,8 @@
 
 #include "context.h"
 #include "config.h"
+#include "buffer_pool.h"
+#include "latency_histogram.h"
 #include <vespa/vespalib/net/async_resolver.h>
 #include <vespa/vespalib/net/crypto_engine.h>
 #include <vespa/vespalib/util/time.h>
@@ -76,6 +78,25 @@ public:
         _config._maxOutputBufferSize = v;
         return *this;
     }
+    // write output chunks of at least this size using MSG_ZEROCOPY
+    // on plain sockets; 0 disables zero-copy writes
+    TransportConfig & zero_copy_threshold(uint32_t v) {
+        _config._zero_copy_threshold = v;
+        return *this;
+    }
+    // max bytes of released connection buffer memory cached by each
+    // transport thread for reuse; 0 disables caching
+    TransportConfig & buffer_pool_size(uint32_t v) {
+        _config._buffer_pool_size = v;
+        return *this;
+    }
+    // invoke RPC requests decoded by the same poll in order of method
+    // priority, never passing over a waiting priority class more than
+    // this many times in a row; 0 invokes requests as they are decoded
+    TransportConfig & priority_streak_limit(uint32_t v) {
+        _config._priority_streak_limit = v;
+        return *this;
+    }
     TransportConfig & tcpNoDelay(bool v) {
         _config._tcpNoDelay = v;
         return *this;
@@ -84,6 +105,11 @@ public:
         _config._drop_empty_buffers = v;
         return *this;
     }
+    // wait for socket events using io_uring instead of epoll, if supported
+    TransportConfig &use_io_uring(bool v) {
+        _config._use_io_uring = v;
+        return *this;
+    }
 
 private:
     FNET_Config                 _config;
@@ -244,6 +270,19 @@ public:
      **/
     uint32_t GetNumIOComponents();
 
+    /**
+     * Sample the connection buffer pool statistics of each transport
+     * thread.
+     *
+     * @return buffer pool statistics, one entry per transport thread.
+     **/
+    std::vector<fnet::BufferPool::Stats> get_buffer_pool_stats() const;
+
+    /**
+     * Sum of the latencies recorded by all transport threads.
+     **/
+    fnet::LatencyStats::Snapshot get_latency_stats() const;
+
     /**
      * Synchronize with all transport threads. This method will block
      * until all events posted before this method was invoked has been
@@ -124,6 +124,9 @@ FNET_TransportThread::PostEvent(FNET_ControlPacket *cpacket,
             DiscardEvent(cpacket, context);
             return false;
         }
+        if (_queue.IsEmpty_NoLock()) {
+            _event_time = vespalib::steady_clock::now();
+        }
         _queue.QueuePacket_NoLock(cpacket, context);
         qLen = _queue.GetPacketCnt_NoLock();
     }
@@ -234,7 +237,7 @@ FNET_TransportThread::FNET_TransportThread(FNET_Transport &owner_in)
       _componentsTail(nullptr),
       _componentCnt(0),
       _deleteList(nullptr),
-      _selector(),
+      _selector(owner_in.getConfig()._use_io_uring ? vespalib::SelectorBackend::IO_URING : vespalib::SelectorBackend::EPOLL),
       _queue(),
       _myQueue(),
       _lock(),
@@ -244,6 +247,12 @@ FNET_TransportThread::FNET_TransportThread(FNET_Transport &owner_in)
       _shutdown(false),
       _finished(false),
       _detaching(),
+      _buffer_pool(owner_in.getConfig()._buffer_pool_size),
+      _latency(),
+      _invocations(owner_in.getConfig()._priority_streak_limit),
+      _poll_time(vespalib::steady_clock::now()),
+      _event_time(),
+      _prioritize(owner_in.getConfig()._priority_streak_limit > 0),
       _reject_events(false)
 {
     trapsigpipe();
@@ -425,10 +434,17 @@ FNET_TransportThread::InitEventLoop()
 void
 FNET_TransportThread::handle_wakeup()
 {
+    bool got_events = false;
+    vespalib::steady_time event_time;
     {
         std::lock_guard<std::mutex> guard(_lock);
+        got_events = !_queue.IsEmpty_NoLock();
+        event_time = _event_time;
         _queue.FlushPackets_NoLock(&_myQueue);
     }
+    if (got_events) {
+        _latency.event_queue.record(vespalib::steady_clock::now() - event_time);
+    }
 
     FNET_Context context;
     FNET_Packet *packet = nullptr;
@@ -508,6 +524,7 @@ FNET_TransportThread::EventLoopIteration() {
         int msTimeout = vespalib::count_ms(time_tools().event_timeout());
         // obtain I/O events
         _selector.poll(msTimeout);
+        _poll_time = vespalib::steady_clock::now();
 
         // sample current time (performed once per event loop iteration)
         _now = time_tools().current_time();
@@ -519,6 +536,11 @@ FNET_TransportThread::EventLoopIteration() {
             handle_wakeup();
         }
 
+        // perform work deferred while handling io-events
+        if (!_invocations.empty()) {
+            _invocations.run_all(_latency.invoke_queue);
+        }
+
         // handle IOC time-outs
         if (getConfig()._iocTimeOut > vespalib::duration::zero()) {
             checkTimedoutComponents(getConfig()._iocTimeOut);
@@ -6,6 +6,9 @@
 #include "config.h"
 #include "task.h"
 #include "packetqueue.h"
+#include "buffer_pool.h"
+#include "latency_histogram.h"
+#include "priority_scheduler.h"
 #include <vespa/vespalib/net/socket_handle.h>
 #include <vespa/vespalib/net/selector.h>
 #include <vespa/vespalib/util/thread.h>
@@ -52,6 +55,12 @@ private:
     std::atomic<bool>        _shutdown;       // should stop event loop ?
     std::atomic<bool>        _finished;       // event loop stopped ?
     std::set<FNET_IServerAdapter*> _detaching; // server adapters being detached
+    fnet::BufferPool         _buffer_pool;    // recycled connection buffer memory
+    fnet::LatencyStats       _latency;        // latencies seen by this thread
+    fnet::PriorityScheduler  _invocations;    // prioritized work for this poll
+    vespalib::steady_time    _poll_time;      // when the last poll returned
+    vespalib::steady_time    _event_time;     // when the outer event queue became non-empty
+    bool _prioritize;    // defer and prioritize work decoded from sockets
     bool _reject_events; // the transport thread does not want any more events
 
     /**
@@ -265,6 +274,49 @@ public:
         return _componentCnt.load(std::memory_order_relaxed);
     }
 
+    /**
+     * The pool of connection buffer memory owned by this transport
+     * thread. The pool may only be used by the transport thread, but
+     * its statistics may be sampled by any thread.
+     **/
+    fnet::BufferPool &buffer_pool() noexcept { return _buffer_pool; }
+    const fnet::BufferPool &buffer_pool() const noexcept { return _buffer_pool; }
+
+    /**
+     * Latencies recorded by this transport thread and the connections
+     * it services. Only the transport thread may record latencies,
+     * but they may be sampled by any thread.
+     **/
+    fnet::LatencyStats &latency_stats() noexcept { return _latency; }
+    const fnet::LatencyStats &latency_stats() const noexcept { return _latency; }
+
+    /**
+     * Whether work decoded from sockets should be deferred with @ref
+     * schedule rather than performed right away. This is the case when
+     * a priority streak limit has been configured.
+     **/
+    bool prioritize() const noexcept { return _prioritize; }
+
+    /**
+     * Defer a task until all I/O events seen by the current poll have
+     * been handled, and then run it in order of priority. This method
+     * may only be called by the transport thread itself while
+     * handling I/O events, and only if @ref prioritize returns true.
+     *
+     * @param priority the priority class of the task
+     * @param task the task to run
+     **/
+    void schedule(fnet::Priority priority, FNET_IExecutable *task) {
+        _invocations.schedule(priority, task);
+    }
+
+    /**
+     * The (real) time at which the event loop last returned from
+     * waiting for I/O events; that is, the time at which sockets
+     * currently being handled were seen to be readable.
+     **/
+    vespalib::steady_time poll_time() const noexcept { return _poll_time; }
+
     /**
      * Add an I/O component to the working set of this transport
      * object. Note that the actual work is performed by the transport
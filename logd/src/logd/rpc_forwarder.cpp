@@ -5,19 +5,23 @@
 #include "proto_converter.h"
 #include "rpc_forwarder.h"
 #include <vespa/log/exceptions.h>
+#include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/buffer.h>
+#include <vespa/vespalib/util/compressor.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/fnet/frt/invoker.h>
 #include <vespa/fnet/frt/rpcrequest.h>
 #include <vespa/fnet/frt/supervisor.h>
 
-
-
 #include <vespa/log/log.h>
 LOG_SETUP(".logd.rpc_forwarder");
 
 using ns_log::BadLogLineException;
 using ns_log::LogMessage;
 using vespalib::make_string;
+using vespalib::ConstBufferRef;
+using vespalib::DataBuffer;
+using vespalib::compression::CompressionConfig;
 
 namespace logdemon {
 
@@ -40,6 +44,19 @@ public:
 
 }
 
+class RpcForwarder::PendingRequest {
+private:
+    GuardedRequest    _request;
+    FRT_SingleReqWait _waiter;
+public:
+    PendingRequest()
+        : _request(),
+          _waiter()
+    {}
+    FRT_RPCRequest& request() { return *_request; }
+    FRT_SingleReqWait& waiter() { return _waiter; }
+};
+
 void
 RpcForwarder::ping_logserver()
 {
@@ -64,12 +81,19 @@ RpcForwarder::RpcForwarder(Metrics& metrics, const ForwardMap& forward_filter, F
       _target(supervisor.GetTarget(_connection_spec.c_str())),
       _messages(),
       _bad_lines(0),
-      _forward_filter(forward_filter)
+      _forward_filter(forward_filter),
+      _pending()
 {
     ping_logserver();
 }
 
-RpcForwarder::~RpcForwarder() = default;
+RpcForwarder::~RpcForwarder()
+{
+    if (_pending) {
+        // The reply must not arrive after the waiter is gone
+        _pending->waiter().WaitReq();
+    }
+}
 
 namespace {
 
@@ -78,10 +102,14 @@ encode_log_request(const ProtoConverter::ProtoLogRequest& src, FRT_RPCRequest& d
 {
     dst.SetMethodName("vespa.logserver.archiveLogMessages");
     auto buf = src.SerializeAsString();
+    DataBuffer compressed;
+    // Falls back to no compression (type 0) when lz4 does not shrink the request enough
+    auto type = vespalib::compression::compress(CompressionConfig(CompressionConfig::LZ4),
+                                                ConstBufferRef(buf.data(), buf.size()), compressed, false);
     auto& params = *dst.GetParams();
-    params.AddInt8(0); // '0' indicates no compression
+    params.AddInt8(type);
     params.AddInt32(buf.size());
-    params.AddData(buf.data(), buf.size());
+    params.AddData(compressed.getData(), compressed.getDataLen());
 }
 
 bool
@@ -89,10 +117,14 @@ decode_log_response(FRT_RPCRequest& src, ProtoConverter::ProtoLogResponse& dst)
 {
     auto& values = *src.GetReturn();
     uint8_t encoding = values[0]._intval8;
-    assert(encoding == 0); // Not using compression
     uint32_t uncompressed_size = values[1]._intval32;
-    (void) uncompressed_size;
-    return dst.ParseFromArray(values[2]._data._buf, values[2]._data._len);
+    if (encoding == CompressionConfig::NONE) {
+        return dst.ParseFromArray(values[2]._data._buf, values[2]._data._len);
+    }
+    DataBuffer uncompressed;
+    vespalib::compression::decompress(CompressionConfig::toType(encoding), uncompressed_size,
+                                      ConstBufferRef(values[2]._data._buf, values[2]._data._len), uncompressed, false);
+    return dst.ParseFromArray(uncompressed.getData(), uncompressed.getDataLen());
 }
 
 bool
@@ -122,35 +154,55 @@ RpcForwarder::forwardLine(std::string_view line)
     if (should_forward_log_message(message, _forward_filter)) {
         _messages.push_back(std::move(message));
         if (_messages.size() == _max_messages_per_request) {
-            flush();
+            send_messages();
         }
     }
 }
 
 void
-RpcForwarder::flush()
+RpcForwarder::send_messages()
 {
-    if (_messages.empty()) {
-        return;
-    }
     ProtoConverter::ProtoLogRequest proto_request;
     ProtoConverter::log_messages_to_proto(_messages, proto_request);
-    GuardedRequest request;
-    encode_log_request(proto_request, *request);
-    _target->InvokeSync(request.get(), _rpc_timeout_secs);
-    if (!request->CheckReturnTypes("bix")) {
+    auto pending = std::make_unique<PendingRequest>();
+    encode_log_request(proto_request, pending->request());
+    // Keep messages until the previous request is known to have succeeded, and keep them in order
+    wait_for_pending_request();
+    _messages.clear();
+    _pending = std::move(pending);
+    _target->InvokeAsync(&_pending->request(), _rpc_timeout_secs, &_pending->waiter());
+}
+
+void
+RpcForwarder::wait_for_pending_request()
+{
+    if (!_pending) {
+        return;
+    }
+    auto pending = std::move(_pending);
+    pending->waiter().WaitReq();
+    auto& request = pending->request();
+    if (!request.CheckReturnTypes("bix")) {
         auto error_msg = make_string("Error in rpc reply from logserver ('%s'): '%s'",
-                                     _connection_spec.c_str(), request->GetErrorMessage());
+                                     _connection_spec.c_str(), request.GetErrorMessage());
         LOG(debug, "%s", error_msg.c_str());
         throw ConnectionException(error_msg);
     }
     ProtoConverter::ProtoLogResponse proto_response;
-    if (!decode_log_response(*request, proto_response)) {
+    if (!decode_log_response(request, proto_response)) {
         auto error_msg = make_string("Error during decoding of protobuf response from logserver ('%s')", _connection_spec.c_str());
         LOG(warning, "%s", error_msg.c_str());
         throw DecodeException(error_msg);
     }
-    _messages.clear();
+}
+
+void
+RpcForwarder::flush()
+{
+    if (!_messages.empty()) {
+        send_messages();
+    }
+    wait_for_pending_request();
 }
 
 int
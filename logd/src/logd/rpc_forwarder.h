@@ -24,9 +24,14 @@ using RpcTargetGuard = std::unique_ptr<FRT_Target, RpcTargetSubRef>;
 
 /**
  * Implementation of the Forwarder interface that uses RPC to send protobuf encoded log messages to the logserver.
+ *
+ * Requests are lz4 compressed when that pays off. A full batch is sent asynchronously, so the next batch is
+ * parsed while the previous one is in flight. At most one request is in flight, and flush() waits for it.
  */
 class RpcForwarder : public Forwarder {
 private:
+    class PendingRequest;
+
     Metrics& _metrics;
     std::string _connection_spec;
     double _rpc_timeout_secs;
@@ -35,8 +40,11 @@ private:
     std::vector<ns_log::LogMessage> _messages;
     int _bad_lines;
     ForwardMap _forward_filter;
+    std::unique_ptr<PendingRequest> _pending;
 
     void ping_logserver();
+    void send_messages();
+    void wait_for_pending_request();
 
 public:
     RpcForwarder(Metrics& metrics, const ForwardMap& forward_filter, FRT_Supervisor& supervisor,
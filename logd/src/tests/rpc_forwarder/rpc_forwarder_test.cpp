@@ -3,14 +3,17 @@
 #include <logd/exceptions.h>
 #include <logd/metrics.h>
 #include <logd/rpc_forwarder.h>
+#include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/metrics/dummy_metrics_manager.h>
+#include <vespa/vespalib/util/compressor.h>
 #include <vespa/fnet/frt/supervisor.h>
 #include <vespa/fnet/frt/rpcrequest.h>
 
 
 
 using namespace logdemon;
+using vespalib::compression::CompressionConfig;
 using vespalib::metrics::DummyMetricsManager;
 
 void
@@ -26,10 +29,17 @@ bool
 decode_log_request(FRT_Values& src, ProtoConverter::ProtoLogRequest& dst)
 {
     uint8_t encoding = src[0]._intval8;
-    assert(encoding == 0);
     uint32_t uncompressed_size = src[1]._intval32;
-    assert(uncompressed_size == src[2]._data._len);
-    return dst.ParseFromArray(src[2]._data._buf, src[2]._data._len);
+    if (encoding == CompressionConfig::NONE) {
+        assert(uncompressed_size == src[2]._data._len);
+        return dst.ParseFromArray(src[2]._data._buf, src[2]._data._len);
+    }
+    assert(encoding == CompressionConfig::LZ4);
+    vespalib::DataBuffer uncompressed;
+    vespalib::compression::decompress(CompressionConfig::LZ4, uncompressed_size,
+                                      vespalib::ConstBufferRef(src[2]._data._buf, src[2]._data._len), uncompressed, false);
+    assert(uncompressed_size == uncompressed.getDataLen());
+    return dst.ParseFromArray(uncompressed.getData(), uncompressed.getDataLen());
 }
 
 std::string garbage("garbage");
@@ -37,6 +47,7 @@ std::string garbage("garbage");
 struct RpcServer : public FRT_Invokable {
     fnet::frt::StandaloneFRT server;
     int request_count;
+    int compressed_request_count;
     std::vector<std::string> messages;
     bool reply_with_error;
     bool reply_with_proto_response;
@@ -51,6 +62,9 @@ public:
         ProtoConverter::ProtoLogRequest proto_request;
         ASSERT_TRUE(decode_log_request(*request->GetParams(), proto_request));
         ++request_count;
+        if (request->GetParams()->GetValue(0)._intval8 != CompressionConfig::NONE) {
+            ++compressed_request_count;
+        }
         for (const auto& message : proto_request.log_messages()) {
             messages.push_back(message.payload());
         }
@@ -73,6 +87,7 @@ public:
 RpcServer::RpcServer()
     : server(),
       request_count(0),
+      compressed_request_count(0),
       messages(),
       reply_with_error(false),
       reply_with_proto_response(true)
@@ -186,15 +201,44 @@ TEST_F(RpcForwarderTest, automatically_sends_rpc_when_max_messages_limit_is_reac
     forward_line("b");
     expect_messages();
     forward_line("c");
-    expect_messages(1, {"a", "b", "c"});
     forward_line("d");
-    expect_messages(1, {"a", "b", "c"});
     forward_line("e");
-    expect_messages(1, {"a", "b", "c"});
     forward_line("f");
+    // The second request is sent after the reply to the first one is received
+    EXPECT_LE(1, server.request_count);
+    flush();
     expect_messages(2, {"a", "b", "c", "d", "e", "f"});
 }
 
+TEST_F(RpcForwarderTest, flush_waits_for_request_sent_when_max_messages_limit_is_reached)
+{
+    forward_line("a");
+    forward_line("b");
+    forward_line("c");
+    flush();
+    expect_messages(1, {"a", "b", "c"});
+    flush();
+    expect_messages(1, {"a", "b", "c"});
+}
+
+TEST_F(RpcForwarderTest, compressible_requests_are_sent_compressed)
+{
+    std::string payload(1000, 'x');
+    forward_line(payload);
+    forward_line(payload);
+    flush();
+    expect_messages(1, {payload, payload});
+    EXPECT_EQ(1, server.compressed_request_count);
+}
+
+TEST_F(RpcForwarderTest, small_requests_are_sent_uncompressed)
+{
+    forward_line("a");
+    flush();
+    expect_messages(1, {"a"});
+    EXPECT_EQ(0, server.compressed_request_count);
+}
+
 TEST_F(RpcForwarderTest, bad_log_lines_are_counted_but_not_sent)
 {
     forward_line("a");
@@ -243,6 +287,15 @@ TEST_F(RpcForwarderTest, throws_when_rpc_reply_contains_errors)
     EXPECT_THROW(flush(), logdemon::ConnectionException);
 }
 
+TEST_F(RpcForwarderTest, error_in_reply_to_request_sent_when_max_messages_limit_is_reached_is_thrown_by_flush)
+{
+    server.reply_with_error = true;
+    forward_line("a");
+    forward_line("b");
+    forward_line("c");
+    EXPECT_THROW(flush(), logdemon::ConnectionException);
+}
+
 TEST_F(RpcForwarderTest, throws_when_rpc_reply_does_not_contain_proto_response)
 {
     server.reply_with_proto_response = false;
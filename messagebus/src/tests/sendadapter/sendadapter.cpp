@@ -1,12 +1,16 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
+#include <vespa/messagebus/routablequeue.h>
 #include <vespa/messagebus/testlib/receptor.h>
+#include <vespa/messagebus/testlib/simplemessage.h>
 #include <vespa/messagebus/testlib/simpleprotocol.h>
 #include <vespa/messagebus/testlib/simplereply.h>
 #include <vespa/messagebus/testlib/slobrok.h>
 #include <vespa/messagebus/testlib/testserver.h>
 #include <vespa/messagebus/network/rpcsendv2.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <set>
 
 #include <vespa/log/log.h>
 LOG_SETUP("sendadapter_test");
@@ -198,4 +202,45 @@ TEST(SendAdapterTest, test_that_we_can_send_between_multiple_versions) {
     testSendAdapters(data, {vespalib::Version(6, 149), vespalib::Version(9, 999)});
 }
 
+TEST(SendAdapterTest, test_that_batched_messages_get_their_own_replies) {
+    Slobrok slobrok;
+    TestServer srcServer(MessageBusParams().setRetryPolicy(IRetryPolicy::SP()).addProtocol(std::make_shared<SimpleProtocol>()),
+                         RPCNetworkParams(slobrok.config()).setMaxBatchMessages(16));
+    TestServer dstServer(MessageBusParams().addProtocol(std::make_shared<SimpleProtocol>()),
+                         RPCNetworkParams(slobrok.config()).setIdentity(Identity("dst")));
+    RoutableQueue srcQueue;
+    RoutableQueue dstQueue;
+    SourceSession::UP srcSession = srcServer.mb.createSourceSession(
+            SourceSessionParams().setReplyHandler(srcQueue).setThrottlePolicy(IThrottlePolicy::SP()));
+    DestinationSession::UP dstSession = dstServer.mb.createDestinationSession(
+            DestinationSessionParams().setName("session").setMessageHandler(dstQueue));
+    ASSERT_TRUE(srcServer.waitSlobrok("dst/session", 1u));
+
+    constexpr uint32_t num_messages = 64;
+    for (uint32_t i = 0; i < num_messages; ++i) {
+        auto msg = std::make_unique<SimpleMessage>(vespalib::make_string("msg%u", i));
+        ASSERT_TRUE(srcSession->send(std::move(msg), Route::parse("dst/session")).isAccepted());
+    }
+    for (uint32_t i = 0; i < num_messages; ++i) {
+        Routable::UP msg = dstQueue.dequeue(TIMEOUT_SECS);
+        ASSERT_TRUE(msg);
+        auto reply = std::make_unique<SimpleReply>("re:" + static_cast<SimpleMessage&>(*msg).getValue());
+        reply->swapState(*msg);
+        dstSession->reply(std::move(reply));
+    }
+    std::set<string> replies;
+    for (uint32_t i = 0; i < num_messages; ++i) {
+        Routable::UP routable = srcQueue.dequeue(TIMEOUT_SECS);
+        ASSERT_TRUE(routable);
+        ASSERT_TRUE(routable->isReply());
+        auto &reply = static_cast<Reply&>(*routable);
+        EXPECT_FALSE(reply.hasErrors());
+        ASSERT_TRUE(reply.getMessage());
+        const string &value = static_cast<SimpleReply&>(reply).getValue();
+        EXPECT_EQ("re:" + static_cast<SimpleMessage&>(*reply.getMessage()).getValue(), value);
+        replies.insert(value);
+    }
+    EXPECT_EQ(num_messages, replies.size());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
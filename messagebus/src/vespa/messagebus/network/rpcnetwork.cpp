@@ -109,7 +109,9 @@ RPCNetwork::RPCNetwork(const RPCNetworkParams &params) :
     _servicePool(std::make_unique<RPCServicePool>(*_mirror, 4_Ki)),
     _sendV2(std::make_unique<RPCSendV2>()),
     _sendAdapters(),
-    _compressionConfig(params.getCompressionConfig()),
+    _compression(params.getCompressionConfig(), params.getAdaptiveCompressionConfig()),
+    _maxBatchMessages(params.getMaxBatchMessages()),
+    _maxBatchPayloadSize(params.getMaxBatchPayloadSize()),
     _required_capabilities(params.required_capabilities())
 {
 }
@@ -12,6 +12,7 @@
 #include <vespa/slobrok/imirrorapi.h>
 #include <vespa/vespalib/component/versionspecification.h>
 #include <vespa/vespalib/net/tls/capability_set.h>
+#include <vespa/vespalib/util/adaptive_compression.h>
 #include <vespa/vespalib/util/compressionconfig.h>
 #include <vespa/fnet/frt/invokable.h>
 
@@ -67,7 +68,9 @@ private:
     std::unique_ptr<RPCServicePool>                    _servicePool;
     std::unique_ptr<RPCSendAdapter>                    _sendV2;
     SendAdapterMap                                     _sendAdapters;
-    CompressionConfig                                  _compressionConfig;
+    vespalib::compression::AdaptiveCompression        _compression;
+    uint32_t                                           _maxBatchMessages;
+    uint32_t                                           _maxBatchPayloadSize;
     CapabilitySet                                      _required_capabilities;
 
     /**
@@ -190,6 +193,14 @@ public:
      */
     FRT_Supervisor &getSupervisor() { return *_orb; }
 
+    /**
+     * Obtain a reference to the internal transport. This is used by the
+     * request adapters to hand batched messages to the network thread.
+     *
+     * @return The transport.
+     */
+    FNET_Transport &getTransport() { return *_transport; }
+
     /**
      * Deliver an error reply to the recipients of a {@link SendContext} in a
      * way that avoids entanglement.
@@ -222,7 +233,10 @@ public:
     void shutdown() override;
     void postShutdownHook() override;
     const slobrok::api::IMirrorAPI &getMirror() const override;
-    CompressionConfig getCompressionConfig() { return _compressionConfig; }
+    CompressionConfig getCompressionConfig() { return _compression.base(); }
+    vespalib::compression::AdaptiveCompression &getCompression() { return _compression; }
+    uint32_t getMaxBatchMessages() const { return _maxBatchMessages; }
+    uint32_t getMaxBatchPayloadSize() const { return _maxBatchPayloadSize; }
     void invoke(FRT_RPCRequest *req);
 };
 
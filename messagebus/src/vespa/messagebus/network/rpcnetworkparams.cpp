@@ -18,9 +18,12 @@ RPCNetworkParams::RPCNetworkParams(config::ConfigUri configUri) :
     _numNetworkThreads(1),
     _numRpcTargets(1),
     _events_before_wakeup(1),
+    _maxBatchMessages(0),
+    _maxBatchPayloadSize(4_Ki),
     _tcpNoDelay(true),
     _connectionExpireSecs(600),
     _compressionConfig(CompressionConfig::LZ4, 6, 90, 1024),
+    _adaptiveCompressionConfig(),
     _required_capabilities(CapabilitySet::make_empty()) // No special peer requirements by default
 { }
 
@@ -4,6 +4,7 @@
 #include "identity.h"
 #include <vespa/slobrok/cfg.h>
 #include <vespa/vespalib/net/tls/capability_set.h>
+#include <vespa/vespalib/util/adaptive_compression.h>
 #include <vespa/vespalib/util/compressionconfig.h>
 
 namespace mbus {
@@ -15,6 +16,7 @@ namespace mbus {
 class RPCNetworkParams {
 private:
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using AdaptiveCompressionConfig = vespalib::compression::AdaptiveCompression::Config;
     using CapabilitySet     = vespalib::net::tls::CapabilitySet;
     Identity          _identity;
     config::ConfigUri _slobrokConfig;
@@ -24,9 +26,12 @@ private:
     uint32_t          _numNetworkThreads;
     uint32_t          _numRpcTargets;
     uint32_t          _events_before_wakeup;
+    uint32_t          _maxBatchMessages;
+    uint32_t          _maxBatchPayloadSize;
     bool              _tcpNoDelay;
     double            _connectionExpireSecs;
     CompressionConfig _compressionConfig;
+    AdaptiveCompressionConfig _adaptiveCompressionConfig;
     CapabilitySet     _required_capabilities;
 
 public:
@@ -164,6 +169,44 @@ public:
     }
     CompressionConfig getCompressionConfig() const { return _compressionConfig; }
 
+    /**
+     * Sets when to use dense (zstd) compression instead of the regular
+     * compression config, based on payload size and link throughput.
+     */
+    RPCNetworkParams &setAdaptiveCompressionConfig(AdaptiveCompressionConfig config) {
+        _adaptiveCompressionConfig = config;
+        return *this;
+    }
+    const AdaptiveCompressionConfig &getAdaptiveCompressionConfig() const { return _adaptiveCompressionConfig; }
+
+    /**
+     * Sets the maximum number of messages to the same target that may be sent
+     * together in a single batch request. Messages are only coalesced while
+     * they wait for the network thread, so no delay is added to any message.
+     * A value of 0 or 1 disables batching.
+     *
+     * @param maxMessages The maximum number of messages in a batch.
+     * @return This, to allow chaining.
+     */
+    RPCNetworkParams &setMaxBatchMessages(uint32_t maxMessages) {
+        _maxBatchMessages = maxMessages;
+        return *this;
+    }
+    uint32_t getMaxBatchMessages() const { return _maxBatchMessages; }
+
+    /**
+     * Sets the largest message payload that may be sent as part of a batch;
+     * larger messages are always sent on their own.
+     *
+     * @param maxSize The maximum payload size in bytes.
+     * @return This, to allow chaining.
+     */
+    RPCNetworkParams &setMaxBatchPayloadSize(uint32_t maxSize) {
+        _maxBatchPayloadSize = maxSize;
+        return *this;
+    }
+    uint32_t getMaxBatchPayloadSize() const { return _maxBatchPayloadSize; }
+
     RPCNetworkParams &events_before_wakeup(uint32_t value) {
         _events_before_wakeup = value;
         return *this;
@@ -3,12 +3,15 @@
 #include "rpcsend.h"
 #include "rpcsend_private.h"
 #include "rpcserviceaddress.h"
+#include "rpctarget.h"
 #include <vespa/messagebus/network/rpcnetwork.h>
 #include <vespa/messagebus/tracelevel.h>
 #include <vespa/messagebus/emptyreply.h>
 #include <vespa/messagebus/errorcode.h>
 #include <vespa/fnet/channel.h>
 #include <vespa/fnet/frt/reflection.h>
+#include <vespa/fnet/transport.h>
+#include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/lambdatask.h>
 
@@ -19,11 +22,49 @@ using vespalib::makeLambdaTask;
 
 namespace mbus {
 
+using network::internal::BatchEntry;
+using network::internal::BatchReplyContext;
+using network::internal::BatchSendContext;
 using network::internal::ReplyContext;
 using network::internal::SendContext;
 
 namespace {
 
+// Messages whose timeouts differ by more than this fraction are not sent in the same batch
+constexpr double BATCH_TIMEOUT_SLACK = 0.1;
+
+bool
+isCompatibleTimeout(duration batchTimeout, duration timeout)
+{
+    auto slack = std::chrono::duration_cast<duration>(batchTimeout * BATCH_TIMEOUT_SLACK);
+    return (timeout >= batchTimeout - slack) && (timeout <= batchTimeout + slack);
+}
+
+Error
+toError(FRT_RPCRequest &req, const string &serviceName, duration timeout)
+{
+    switch (req.GetErrorCode()) {
+        case FRTE_RPC_TIMEOUT:
+            return Error(ErrorCode::TIMEOUT,
+                         make_string("A timeout occured while waiting for '%s' (%g seconds expired); %s",
+                                     serviceName.c_str(), vespalib::to_s(timeout), req.GetErrorMessage()));
+        case FRTE_RPC_CONNECTION:
+            return Error(ErrorCode::CONNECTION_ERROR,
+                         make_string("A connection error occured for '%s'; %s",
+                                     serviceName.c_str(), req.GetErrorMessage()));
+        default:
+            return Error(ErrorCode::NETWORK_ERROR,
+                         make_string("A network error occured for '%s'; %s",
+                                     serviceName.c_str(), req.GetErrorMessage()));
+    }
+}
+
+const string &
+getServiceName(SendContext &ctx)
+{
+    return static_cast<RPCServiceAddress&>(ctx.getRecipient().getServiceAddress()).getServiceName();
+}
+
 class FillByCopy final : public PayLoadFiller
 {
 public:
@@ -34,6 +75,7 @@ public:
     void fill(const vespalib::Memory & name, vespalib::slime::Cursor & v) const override {
         v.setData(name, vespalib::Memory(_payload.data(), _payload.size()));
     }
+    size_t size() const override { return _payload.size(); }
 private:
     BlobRef _payload;
 };
@@ -49,6 +91,7 @@ public:
     void fill(const vespalib::Memory & name, vespalib::slime::Cursor & v) const override {
         v.setData(name, vespalib::Memory(_payload.data(), _payload.size()));
     }
+    size_t size() const override { return _payload.size(); }
 private:
     mutable Blob _payload;
 };
@@ -78,10 +121,11 @@ RPCSend::attach(RPCNetwork &net, CapabilitySet required_capabilities)
 }
 
 void
-RPCSend::replyError(FRT_RPCRequest *req, const vespalib::Version &version, uint32_t traceLevel, const Error &err)
+RPCSend::replyError(FRT_RPCRequest *req, const vespalib::Version &version, uint32_t traceLevel, const Error &err,
+                    std::shared_ptr<BatchReplyContext> batch, uint32_t index)
 {
     Reply::UP reply(new EmptyReply());
-    reply->setContext(Context(new ReplyContext(*req, version)));
+    reply->setContext(Context(new ReplyContext(*req, version, std::move(batch), index)));
     reply->getTrace().setLevel(traceLevel);
     reply->addError(err);
     handleReply(std::move(reply));
@@ -91,6 +135,12 @@ void
 RPCSend::handleDiscard(Context ctx)
 {
     ReplyContext::UP tmp(static_cast<ReplyContext*>(ctx.value.PTR));
+    if (BatchReplyContext *batch = tmp->getBatch()) {
+        if (batch->discard()) {
+            completeBatch(*batch);
+        }
+        return;
+    }
     FRT_RPCRequest &req = tmp->getRequest();
     FNET_Channel *chn = req.GetContext()._value.CHANNEL;
     req.internal_subref();
@@ -119,8 +169,8 @@ RPCSend::send(RoutingNode &recipient, const vespalib::Version &version,
     Route route = recipient.getRoute();
     Hop hop = route.removeHop(0);
 
-    FRT_RPCRequest *req = _net->allocRequest();
-    encodeRequest(*req, version, route, address, msg, recipient.getTrace().getLevel(),  payload, timeRemaining);
+    vespalib::DataBuffer message = encodeMessage(version, route, address, msg, recipient.getTrace().getLevel(),
+                                                 payload, timeRemaining);
 
     if (ctx->getTrace().shouldTrace(TraceLevel::SEND_RECEIVE)) {
         ctx->getTrace().trace(TraceLevel::SEND_RECEIVE,
@@ -129,6 +179,14 @@ RPCSend::send(RoutingNode &recipient, const vespalib::Version &version,
                                           address.getServiceName().c_str(), vespalib::to_s(ctx->getTimeout())));
     }
 
+    if (shouldBatch(hop, payload)) {
+        RPCTarget &target = address.getTarget();
+        target.getSendQueue().enqueue(std::make_unique<BatchEntry>(std::move(ctx), std::move(message)),
+                                      target.shared_from_this(), *this, _net->getTransport());
+        return;
+    }
+    FRT_RPCRequest *req = _net->allocRequest();
+    encodeRequest(*req, std::move(message), address.getTarget());
     if (hop.getIgnoreResult()) {
         address.getTarget().getFRTTarget().InvokeVoid(req);
         if (ctx->getTrace().shouldTrace(TraceLevel::SEND_RECEIVE)) {
@@ -145,41 +203,148 @@ RPCSend::send(RoutingNode &recipient, const vespalib::Version &version,
     }
 }
 
+bool
+RPCSend::shouldBatch(const Hop &hop, const PayLoadFiller &payload) const
+{
+    return (_net->getMaxBatchMessages() > 1) &&
+           (payload.size() <= _net->getMaxBatchPayloadSize()) &&
+           !hop.getIgnoreResult();
+}
+
+void
+RPCSend::flush(RPCTarget &target, RPCSendQueue::Entries entries)
+{
+    if ( ! target.getSendQueue().isBatchSupported()) {
+        for (auto &entry : entries) {
+            sendSingle(target, std::move(entry));
+        }
+        return;
+    }
+    const size_t maxMessages = _net->getMaxBatchMessages();
+    BatchEntries batch;
+    duration batchTimeout = duration::zero();
+    duration maxTimeout = duration::zero();
+    for (auto &entry : entries) {
+        duration timeout = entry->getContext().getTimeout();
+        if ( ! batch.empty() && ((batch.size() >= maxMessages) || !isCompatibleTimeout(batchTimeout, timeout))) {
+            sendBatch(target, std::move(batch), maxTimeout);
+            batch.clear();
+        }
+        if (batch.empty()) {
+            batchTimeout = timeout;
+            maxTimeout = timeout;
+        }
+        maxTimeout = std::max(maxTimeout, timeout);
+        batch.push_back(std::move(entry));
+    }
+    if ( ! batch.empty()) {
+        sendBatch(target, std::move(batch), maxTimeout);
+    }
+}
+
+void
+RPCSend::sendSingle(RPCTarget &target, BatchEntry::UP entry)
+{
+    FRT_RPCRequest *req = _net->allocRequest();
+    encodeRequest(*req, std::move(entry->getRequest()), target);
+    SendContext *ctx = entry->stealContext().release();
+    req->SetContext(FNET_Context(ctx));
+    target.getFRTTarget().InvokeAsync(req, vespalib::to_s(ctx->getTimeout()), this);
+}
+
+void
+RPCSend::sendBatch(RPCTarget &target, BatchEntries entries, duration timeout)
+{
+    if (entries.size() == 1) {
+        sendSingle(target, std::move(entries.front()));
+        return;
+    }
+    FRT_RPCRequest *req = _net->allocRequest();
+    encodeBatchRequest(*req, entries, target);
+    auto *ctx = new BatchSendContext(std::move(entries), target.shared_from_this(), timeout);
+    req->SetContext(FNET_Context(ctx));
+    target.getFRTTarget().InvokeAsync(req, vespalib::to_s(timeout), this);
+}
+
 void
 RPCSend::RequestDone(FRT_RPCRequest *req)
 {
-    doRequestDone(req);
+    if (isBatchRequest(*req)) {
+        doBatchRequestDone(req);
+    } else {
+        doRequestDone(req);
+    }
 }
 
 void
 RPCSend::doRequestDone(FRT_RPCRequest *req) {
     SendContext::UP ctx(static_cast<SendContext*>(req->GetContext()._value.VOIDP));
-    const string &serviceName = static_cast<RPCServiceAddress&>(ctx->getRecipient().getServiceAddress()).getServiceName();
+    const string &serviceName = getServiceName(*ctx);
     Reply::UP reply;
     Error error;
     Trace & trace = ctx->getTrace();
     if (!req->CheckReturnTypes(getReturnSpec())) {
         reply = std::make_unique<EmptyReply>();
-        switch (req->GetErrorCode()) {
-            case FRTE_RPC_TIMEOUT:
-                error = Error(ErrorCode::TIMEOUT,
-                              make_string("A timeout occured while waiting for '%s' (%g seconds expired); %s",
-                                          serviceName.c_str(), vespalib::to_s(ctx->getTimeout()), req->GetErrorMessage()));
-                break;
-            case FRTE_RPC_CONNECTION:
-                error = Error(ErrorCode::CONNECTION_ERROR,
-                              make_string("A connection error occured for '%s'; %s",
-                                          serviceName.c_str(), req->GetErrorMessage()));
-                break;
-            default:
-                error = Error(ErrorCode::NETWORK_ERROR,
-                              make_string("A network error occured for '%s'; %s",
-                                          serviceName.c_str(), req->GetErrorMessage()));
-        }
+        error = toError(*req, serviceName, ctx->getTimeout());
     } else {
         FRT_Values &ret = *req->GetReturn();
+        auto &address = static_cast<RPCServiceAddress&>(ctx->getRecipient().getServiceAddress());
+        if (address.hasTarget()) {
+            address.getTarget().getLinkEstimate().observe_transfer(req->GetParams()->GetLength() + ret.GetLength(),
+                                                                   vespalib::steady_clock::now() - ctx->getSendTime());
+        }
         reply = createReply(ret, serviceName, error, trace);
     }
+    deliverReply(*ctx, std::move(reply), error);
+    req->internal_subref();
+}
+
+void
+RPCSend::doBatchRequestDone(FRT_RPCRequest *req) {
+    BatchSendContext::UP ctx(static_cast<BatchSendContext*>(req->GetContext()._value.VOIDP));
+    BatchEntries &entries = ctx->getEntries();
+    BatchReplies replies;
+    Error error;
+    if (!req->CheckReturnTypes(getReturnSpec())) {
+        if (req->GetErrorCode() == FRTE_RPC_NO_SUCH_METHOD) {
+            // The target runs a version that does not know batch requests; resend the messages one by one
+            ctx->getTarget().getSendQueue().setBatchUnsupported();
+            for (auto &entry : entries) {
+                sendSingle(ctx->getTarget(), std::move(entry));
+            }
+            req->internal_subref();
+            return;
+        }
+    } else {
+        FRT_Values &ret = *req->GetReturn();
+        ctx->getTarget().getLinkEstimate().observe_transfer(req->GetParams()->GetLength() + ret.GetLength(),
+                                                            vespalib::steady_clock::now() - ctx->getSendTime());
+        replies = createBatchReplies(ret, entries);
+        if (replies.size() != entries.size()) {
+            replies.clear();
+            error = Error(ErrorCode::DECODE_ERROR,
+                          make_string("Batch reply does not hold one reply for each of the %zu messages sent.",
+                                      entries.size()));
+        }
+    }
+    for (size_t i = 0; i < entries.size(); ++i) {
+        SendContext &entryCtx = entries[i]->getContext();
+        if (replies.empty()) {
+            Error entryError = (error.getCode() != ErrorCode::NONE)
+                               ? error
+                               : toError(*req, getServiceName(entryCtx), ctx->getTimeout());
+            deliverReply(entryCtx, std::make_unique<EmptyReply>(), entryError);
+        } else {
+            deliverReply(entryCtx, std::move(replies[i]), Error());
+        }
+    }
+    req->internal_subref();
+}
+
+void
+RPCSend::deliverReply(SendContext &ctx, Reply::UP reply, const Error &error)
+{
+    Trace & trace = ctx.getTrace();
     if (trace.shouldTrace(TraceLevel::SEND_RECEIVE)) {
         trace.trace(TraceLevel::SEND_RECEIVE,
                     make_string("Reply (type %d) received at %s.", reply->getType(), _clientIdent.c_str()));
@@ -188,8 +353,7 @@ RPCSend::doRequestDone(FRT_RPCRequest *req) {
     if (error.getCode() != ErrorCode::NONE) {
         reply->addError(error);
     }
-    _net->getOwner().deliverReply(std::move(reply), ctx->getRecipient());
-    req->internal_subref();
+    _net->getOwner().deliverReply(std::move(reply), ctx.getRecipient());
 }
 
 std::unique_ptr<Reply>
@@ -227,7 +391,6 @@ void
 RPCSend::doHandleReply(Reply::UP reply) {
     const IProtocol * protocol = _net->getOwner().getProtocol(reply->getProtocol());
     ReplyContext::UP ctx(static_cast<ReplyContext*>(reply->getContext().value.PTR));
-    FRT_RPCRequest &req = ctx->getRequest();
     string version = ctx->getVersion().toAbbreviatedString();
     if (reply->getTrace().shouldTrace(TraceLevel::SEND_RECEIVE)) {
         reply->getTrace().trace(TraceLevel::SEND_RECEIVE, make_string("Sending reply (version %s) from %s.",
@@ -240,11 +403,32 @@ RPCSend::doHandleReply(Reply::UP reply) {
             reply->addError(Error(ErrorCode::ENCODE_ERROR, "An error occured while encoding the reply, see log."));
         }
     }
+    if (BatchReplyContext *batch = ctx->getBatch()) {
+        if (batch->setReply(ctx->getIndex(), std::move(version), std::move(reply), std::move(payload))) {
+            completeBatch(*batch);
+        }
+        return;
+    }
+    FRT_RPCRequest &req = ctx->getRequest();
     FRT_Values &ret = *req.GetReturn();
     createResponse(ret, version, *reply, std::move(payload));
     req.Return();
 }
 
+void
+RPCSend::completeBatch(BatchReplyContext &batch)
+{
+    FRT_RPCRequest &req = batch.getRequest();
+    if (batch.isDiscarded()) {
+        FNET_Channel *chn = req.GetContext()._value.CHANNEL;
+        req.internal_subref();
+        chn->Free();
+        return;
+    }
+    createBatchResponse(*req.GetReturn(), batch.getEntries());
+    req.Return();
+}
+
 void
 RPCSend::invoke(FRT_RPCRequest *req)
 {
@@ -252,49 +436,77 @@ RPCSend::invoke(FRT_RPCRequest *req)
     doRequest(req);
 }
 
+void
+RPCSend::invokeBatch(FRT_RPCRequest *req)
+{
+    req->Detach();
+    std::vector<std::unique_ptr<Params>> params = toBatchParams(*req->GetParams());
+    req->DiscardBlobs();
+    if (params.empty()) {
+        req->SetError(FRTE_RPC_METHOD_FAILED, "Batch request holds no messages.");
+        req->Return();
+        return;
+    }
+    auto batch = std::make_shared<BatchReplyContext>(*req, params.size());
+    for (uint32_t i = 0; i < params.size(); ++i) {
+        doRequest(*req, *params[i], batch, i);
+    }
+}
+
 void
 RPCSend::doRequest(FRT_RPCRequest *req)
 {
     FRT_Values &args = *req->GetParams();
     std::unique_ptr<Params> params = toParams(args);
-    IProtocol * protocol = _net->getOwner().getProtocol(params->getProtocol());
+    doRequest(*req, *params, {}, 0);
+}
+
+void
+RPCSend::doRequest(FRT_RPCRequest &req, const Params &params, std::shared_ptr<BatchReplyContext> batch, uint32_t index)
+{
+    IProtocol * protocol = _net->getOwner().getProtocol(params.getProtocol());
     if (protocol == nullptr) {
-        replyError(req, params->getVersion(), params->getTraceLevel(),
+        replyError(&req, params.getVersion(), params.getTraceLevel(),
                    Error(ErrorCode::UNKNOWN_PROTOCOL, make_string("Protocol '%s' is not known by %s.",
-                                                                  std::string(params->getProtocol()).c_str(), _serverIdent.c_str())));
+                                                                  std::string(params.getProtocol()).c_str(), _serverIdent.c_str())),
+                   std::move(batch), index);
         return;
     }
-    Routable::UP routable = protocol->decode(params->getVersion(), params->getPayload());
-    req->DiscardBlobs();
+    Routable::UP routable = protocol->decode(params.getVersion(), params.getPayload());
+    if ( ! batch) {
+        req.DiscardBlobs();
+    }
     if ( ! routable ) {
-        replyError(req, params->getVersion(), params->getTraceLevel(),
+        replyError(&req, params.getVersion(), params.getTraceLevel(),
                    Error(ErrorCode::DECODE_ERROR,
-                         make_string("Protocol '%s' failed to decode routable.", std::string(params->getProtocol()).c_str())));
+                         make_string("Protocol '%s' failed to decode routable.", std::string(params.getProtocol()).c_str())),
+                   std::move(batch), index);
         return;
     }
     if (routable->isReply()) {
-        replyError(req, params->getVersion(), params->getTraceLevel(),
-                   Error(ErrorCode::DECODE_ERROR, "Payload decoded to a reply when expecting a mesage."));
+        replyError(&req, params.getVersion(), params.getTraceLevel(),
+                   Error(ErrorCode::DECODE_ERROR, "Payload decoded to a reply when expecting a mesage."),
+                   std::move(batch), index);
         return;
     }
     Message::UP msg(static_cast<Message*>(routable.release()));
-    std::string_view route = params->getRoute();
+    std::string_view route = params.getRoute();
     if (!route.empty()) {
         msg->setRoute(Route::parse(route));
     }
-    msg->setContext(Context(new ReplyContext(*req, params->getVersion())));
+    msg->setContext(Context(new ReplyContext(req, params.getVersion(), std::move(batch), index)));
     msg->pushHandler(*this, *this);
-    msg->setRetryEnabled(params->useRetry());
-    msg->setRetry(params->getRetries());
+    msg->setRetryEnabled(params.useRetry());
+    msg->setRetry(params.getRetries());
     msg->setTimeReceivedNow();
-    msg->setTimeRemaining(params->getRemainingTime());
-    msg->getTrace().setLevel(params->getTraceLevel());
+    msg->setTimeRemaining(params.getRemainingTime());
+    msg->getTrace().setLevel(params.getTraceLevel());
     if (msg->getTrace().shouldTrace(TraceLevel::SEND_RECEIVE)) {
         msg->getTrace().trace(TraceLevel::SEND_RECEIVE,
                               make_string("Message (type %d) received at %s for session '%s'.",
-                                          msg->getType(), _serverIdent.c_str(), string(params->getSession()).c_str()));
+                                          msg->getType(), _serverIdent.c_str(), string(params.getSession()).c_str()));
     }
-    _net->getOwner().deliverMessage(std::move(msg), params->getSession());
+    _net->getOwner().deliverMessage(std::move(msg), params.getSession());
 }
 
 } // namespace mbus
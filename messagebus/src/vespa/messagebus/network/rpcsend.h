@@ -2,6 +2,7 @@
 #pragma once
 
 #include "rpcsendadapter.h"
+#include "rpcsendqueue.h"
 #include <vespa/messagebus/idiscardhandler.h>
 #include <vespa/messagebus/ireplyhandler.h>
 #include <vespa/messagebus/common.h>
@@ -13,27 +14,39 @@ class FRT_ReflectionBuilder;
 namespace vespalib::slime { struct Cursor; }
 namespace vespalib { struct Memory; }
 namespace vespalib { class Trace; }
+namespace vespalib { class DataBuffer; }
 namespace mbus {
 
 class Error;
+class Hop;
 class Route;
 class Message;
 class RPCServiceAddress;
+class RPCTarget;
 class IProtocol;
 
+namespace network::internal {
+class BatchEntry;
+class BatchReplyContext;
+struct BatchReplyEntry;
+class SendContext;
+}
+
 class PayLoadFiller
 {
 public:
     virtual ~PayLoadFiller() = default;
     virtual void fill(FRT_Values & v) const = 0;
     virtual void fill(const vespalib::Memory & name, vespalib::slime::Cursor & v) const = 0;
+    virtual size_t size() const = 0;
 };
 
 class RPCSend : public FRT_Invokable,
                 public RPCSendAdapter,
                 public FRT_IRequestWait,
                 public IDiscardHandler,
-                public IReplyHandler
+                public IReplyHandler,
+                public RPCSendQueue::IFlusher
 {
 public:
     class Params {
@@ -50,6 +63,9 @@ public:
         virtual BlobRef getPayload() const = 0;
     };
 protected:
+    using BatchEntries = std::vector<std::unique_ptr<network::internal::BatchEntry>>;
+    using BatchReplies = std::vector<std::unique_ptr<Reply>>;
+
     RPCNetwork *_net;
     string _clientIdent;
     string _serverIdent;
@@ -57,12 +73,29 @@ protected:
     virtual void build(FRT_ReflectionBuilder & builder, CapabilitySet required_capabilities) = 0;
     virtual std::unique_ptr<Reply> createReply(const FRT_Values & response, const string & serviceName,
                                                Error & error, vespalib::Trace & trace) const = 0;
-    virtual void encodeRequest(FRT_RPCRequest &req, const vespalib::Version &version, const Route & route,
-                               const RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
-                               const PayLoadFiller &filler, duration timeRemaining) const = 0;
+    /**
+     * Encodes a single message, without compression, into the form that is sent
+     * by either {@link #encodeRequest} or {@link #encodeBatchRequest}.
+     */
+    virtual vespalib::DataBuffer encodeMessage(const vespalib::Version &version, const Route & route,
+                                               const RPCServiceAddress & address, const Message & msg,
+                                               uint32_t traceLevel, const PayLoadFiller &filler,
+                                               duration timeRemaining) const = 0;
+    virtual void encodeRequest(FRT_RPCRequest &req, vespalib::DataBuffer message, RPCTarget &target) const = 0;
+    virtual void encodeBatchRequest(FRT_RPCRequest &req, BatchEntries &entries, RPCTarget &target) const = 0;
+    virtual bool isBatchRequest(FRT_RPCRequest &req) const = 0;
+    /**
+     * Decodes the replies to the messages of a batch request, in message order.
+     * Returns an empty list if the response does not hold one reply for each
+     * message.
+     */
+    virtual BatchReplies createBatchReplies(const FRT_Values & response, BatchEntries &entries) const = 0;
     virtual const char * getReturnSpec() const = 0;
     virtual void createResponse(FRT_Values & ret, const string & version, Reply & reply, Blob payload) const = 0;
+    virtual void createBatchResponse(FRT_Values & ret,
+                                     std::vector<network::internal::BatchReplyEntry> &replies) const = 0;
     virtual std::unique_ptr<Params> toParams(const FRT_Values &param) const = 0;
+    virtual std::vector<std::unique_ptr<Params>> toBatchParams(const FRT_Values &param) const = 0;
 
     void send(RoutingNode &recipient, const vespalib::Version &version,
               const PayLoadFiller & filler, duration timeRemaining);
@@ -76,16 +109,26 @@ protected:
      * @param traceLevel The trace level to set in the reply.
      * @param err        The error to reply with.
      */
-    void replyError(FRT_RPCRequest *req, const vespalib::Version &version, uint32_t traceLevel, const Error &err);
+    void replyError(FRT_RPCRequest *req, const vespalib::Version &version, uint32_t traceLevel, const Error &err,
+                    std::shared_ptr<network::internal::BatchReplyContext> batch = {}, uint32_t index = 0);
 public:
     RPCSend();
     ~RPCSend();
 
     void invoke(FRT_RPCRequest *req);
+    void invokeBatch(FRT_RPCRequest *req);
 private:
+    bool shouldBatch(const Hop &hop, const PayLoadFiller &payload) const;
     void doRequest(FRT_RPCRequest *req);
+    void doRequest(FRT_RPCRequest &req, const Params &params,
+                   std::shared_ptr<network::internal::BatchReplyContext> batch, uint32_t index);
     void doRequestDone(FRT_RPCRequest *req);
+    void doBatchRequestDone(FRT_RPCRequest *req);
+    void deliverReply(network::internal::SendContext &ctx, std::unique_ptr<Reply> reply, const Error &error);
+    void sendSingle(RPCTarget &target, std::unique_ptr<network::internal::BatchEntry> entry);
+    void sendBatch(RPCTarget &target, BatchEntries entries, duration timeout);
     void doHandleReply(std::unique_ptr<Reply> reply);
+    void completeBatch(network::internal::BatchReplyContext &batch);
     void attach(RPCNetwork &net, CapabilitySet required_capabilities) final override;
     void handleDiscard(Context ctx) final override;
     void sendByHandover(RoutingNode &recipient, const vespalib::Version &version,
@@ -94,6 +137,7 @@ private:
               BlobRef payload, duration timeRemaining) final override;
     void RequestDone(FRT_RPCRequest *req) final override;
     void handleReply(std::unique_ptr<Reply> reply) final override;
+    void flush(RPCTarget &target, RPCSendQueue::Entries entries) final override;
 };
 
 } // namespace mbus
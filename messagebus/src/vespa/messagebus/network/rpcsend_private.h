@@ -1,8 +1,17 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <vespa/messagebus/blob.h>
+#include <vespa/messagebus/reply.h>
 #include <vespa/messagebus/trace.h>
 #include <vespa/messagebus/routing/routingnode.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/time.h>
+#include <mutex>
+
+class FRT_RPCRequest;
+
+namespace mbus { class RPCTarget; }
 
 namespace mbus::network::internal {
 /**
@@ -17,15 +26,129 @@ public:
     SendContext(mbus::RoutingNode &recipient, duration timeRemaining)
         : _recipient(recipient),
           _trace(recipient.getTrace().getLevel()),
-          _timeout(timeRemaining)
+          _timeout(timeRemaining),
+          _sendTime(vespalib::steady_clock::now())
    { }
     mbus::RoutingNode &getRecipient() { return _recipient; }
     mbus::Trace &getTrace() { return _trace; }
     duration getTimeout() { return _timeout; }
+    vespalib::steady_time getSendTime() const { return _sendTime; }
+private:
+    mbus::RoutingNode    &_recipient;
+    mbus::Trace           _trace;
+    duration              _timeout;
+    vespalib::steady_time _sendTime;
+};
+
+/**
+ * Implements a helper class to hold a message that waits in a {@link
+ * RPCSendQueue} to be sent as part of a batch, together with its encoded (but
+ * not compressed) request.
+ */
+class BatchEntry {
+public:
+    using UP = std::unique_ptr<BatchEntry>;
+    BatchEntry(const BatchEntry &) = delete;
+    BatchEntry & operator = (const BatchEntry &) = delete;
+    BatchEntry(SendContext::UP ctx, vespalib::DataBuffer request)
+        : _ctx(std::move(ctx)),
+          _request(std::move(request))
+    { }
+    SendContext &getContext() { return *_ctx; }
+    SendContext::UP stealContext() { return std::move(_ctx); }
+    vespalib::DataBuffer &getRequest() { return _request; }
+private:
+    SendContext::UP      _ctx;
+    vespalib::DataBuffer _request;
+};
+
+/**
+ * Implements a helper class to hold the messages sent in a single batch
+ * request. This object is held as the context of an FRT_RPCRequest.
+ */
+class BatchSendContext {
+public:
+    using UP = std::unique_ptr<BatchSendContext>;
+    BatchSendContext(const BatchSendContext &) = delete;
+    BatchSendContext & operator = (const BatchSendContext &) = delete;
+    BatchSendContext(std::vector<BatchEntry::UP> entries, std::shared_ptr<RPCTarget> target, duration timeout)
+        : _entries(std::move(entries)),
+          _target(std::move(target)),
+          _timeout(timeout),
+          _sendTime(vespalib::steady_clock::now())
+    { }
+    std::vector<BatchEntry::UP> &getEntries() { return _entries; }
+    RPCTarget &getTarget() { return *_target; }
+    duration getTimeout() const { return _timeout; }
+    vespalib::steady_time getSendTime() const { return _sendTime; }
+private:
+    std::vector<BatchEntry::UP> _entries;
+    std::shared_ptr<RPCTarget>  _target;
+    duration                    _timeout;
+    vespalib::steady_time       _sendTime;
+};
+
+/**
+ * The encoded reply to one of the messages of a received batch request.
+ */
+struct BatchReplyEntry {
+    string     version;
+    Reply::UP  reply;
+    Blob       payload;
+    BatchReplyEntry() : version(), reply(), payload(0) { }
+};
+
+/**
+ * Implements a helper class to collect the replies to the messages of a
+ * single received batch request. The request is answered once all messages
+ * have been replied to, or discarded if any of them are discarded.
+ */
+class BatchReplyContext {
+public:
+    using Entry = BatchReplyEntry;
+    BatchReplyContext(const BatchReplyContext &) = delete;
+    BatchReplyContext & operator = (const BatchReplyContext &) = delete;
+    BatchReplyContext(FRT_RPCRequest &request, uint32_t numMessages)
+        : _lock(),
+          _request(request),
+          _entries(numMessages),
+          _pending(numMessages),
+          _discarded(false)
+    { }
+    FRT_RPCRequest &getRequest() { return _request; }
+    std::vector<Entry> &getEntries() { return _entries; }
+    bool isDiscarded() const { return _discarded; }
+
+    /**
+     * Stores the reply to the message with the given index.
+     *
+     * @return True if this was the last message of the batch.
+     */
+    bool setReply(uint32_t index, string version, Reply::UP reply, Blob payload) {
+        std::lock_guard guard(_lock);
+        Entry &entry = _entries[index];
+        entry.version = std::move(version);
+        entry.reply = std::move(reply);
+        entry.payload = std::move(payload);
+        return (--_pending == 0);
+    }
+
+    /**
+     * Records that one of the messages was discarded.
+     *
+     * @return True if this was the last message of the batch.
+     */
+    bool discard() {
+        std::lock_guard guard(_lock);
+        _discarded = true;
+        return (--_pending == 0);
+    }
 private:
-    mbus::RoutingNode &_recipient;
-    mbus::Trace        _trace;
-    duration           _timeout;
+    std::mutex         _lock;
+    FRT_RPCRequest    &_request;
+    std::vector<Entry> _entries;
+    uint32_t           _pending;
+    bool               _discarded;
 };
 
 /**
@@ -34,18 +157,23 @@ private:
  */
 class ReplyContext {
 private:
-    FRT_RPCRequest   &_request;
-    vespalib::Version _version;
+    FRT_RPCRequest                    &_request;
+    vespalib::Version                  _version;
+    std::shared_ptr<BatchReplyContext> _batch;
+    uint32_t                           _index;
 
 public:
     using UP = std::unique_ptr<ReplyContext>;
     ReplyContext(const ReplyContext &) = delete;
     ReplyContext & operator = (const ReplyContext &) = delete;
 
-    ReplyContext(FRT_RPCRequest &request, const vespalib::Version &version)
-            : _request(request), _version(version) { }
+    ReplyContext(FRT_RPCRequest &request, const vespalib::Version &version,
+                 std::shared_ptr<BatchReplyContext> batch = {}, uint32_t index = 0)
+            : _request(request), _version(version), _batch(std::move(batch)), _index(index) { }
     FRT_RPCRequest &getRequest() { return _request; }
     const vespalib::Version &getVersion() { return _version; }
+    BatchReplyContext *getBatch() { return _batch.get(); }
+    uint32_t getIndex() const { return _index; }
 };
 
 
@@ -0,0 +1,52 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "rpcsendqueue.h"
+#include "rpcsend_private.h"
+#include "rpctarget.h"
+#include <vespa/fnet/transport.h>
+
+namespace mbus {
+
+RPCSendQueue::RPCSendQueue()
+    : _lock(),
+      _pending(),
+      _flusher(nullptr),
+      _target(),
+      _batchSupported(true)
+{ }
+
+RPCSendQueue::~RPCSendQueue() = default;
+
+void
+RPCSendQueue::enqueue(Entry entry, std::shared_ptr<RPCTarget> target, IFlusher &flusher, FNET_Transport &transport)
+{
+    bool shouldPost = false;
+    {
+        std::lock_guard guard(_lock);
+        _pending.push_back(std::move(entry));
+        if ( ! _target) {
+            _target = std::move(target);
+            _flusher = &flusher;
+            shouldPost = true;
+        }
+    }
+    if (shouldPost && ! transport.execute(this)) {
+        execute(); // network is shut down; the sends will fail as usual
+    }
+}
+
+void
+RPCSendQueue::execute()
+{
+    Entries entries;
+    std::shared_ptr<RPCTarget> target;
+    IFlusher *flusher;
+    {
+        std::lock_guard guard(_lock);
+        entries.swap(_pending);
+        target.swap(_target);
+        flusher = _flusher;
+    }
+    flusher->flush(*target, std::move(entries));
+}
+
+} // namespace mbus
@@ -0,0 +1,74 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/fnet/iexecutable.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class FNET_Transport;
+
+namespace mbus {
+
+class RPCTarget;
+namespace network::internal { class BatchEntry; }
+
+/**
+ * Collects small messages bound for the same target until the network thread
+ * gets around to sending them, so that messages submitted by many threads at
+ * about the same time are coalesced into a single batch request. The window in
+ * which messages are coalesced is the time it takes to wake up the network
+ * thread, so no explicit delay is added to any message.
+ */
+class RPCSendQueue : public FNET_IExecutable {
+public:
+    using Entry   = std::unique_ptr<network::internal::BatchEntry>;
+    using Entries = std::vector<Entry>;
+
+    /**
+     * Sends the messages collected by a queue. This is invoked by the network
+     * thread, or by the enqueuing thread if the network has been shut down.
+     */
+    class IFlusher {
+    public:
+        virtual ~IFlusher() = default;
+        virtual void flush(RPCTarget &target, Entries entries) = 0;
+    };
+
+private:
+    std::mutex                 _lock;
+    Entries                    _pending;
+    IFlusher                  *_flusher;
+    std::shared_ptr<RPCTarget> _target; // set while a flush is posted
+    std::atomic<bool>          _batchSupported;
+
+public:
+    RPCSendQueue();
+    RPCSendQueue(const RPCSendQueue &) = delete;
+    RPCSendQueue & operator = (const RPCSendQueue &) = delete;
+    ~RPCSendQueue() override;
+
+    /**
+     * Adds a message to this queue, and posts a flush of the queue to the
+     * network thread unless one is already pending.
+     *
+     * @param entry     The message to send.
+     * @param target    The target that owns this queue, kept alive until flushed.
+     * @param flusher   The object that sends the collected messages.
+     * @param transport The transport whose network thread performs the flush.
+     */
+    void enqueue(Entry entry, std::shared_ptr<RPCTarget> target, IFlusher &flusher, FNET_Transport &transport);
+
+    /**
+     * Returns whether the target is believed to accept batch requests. This is
+     * cleared once the target rejects a batch request as an unknown method.
+     */
+    bool isBatchSupported() const { return _batchSupported.load(std::memory_order_relaxed); }
+    void setBatchUnsupported() { _batchSupported.store(false, std::memory_order_relaxed); }
+
+    // Implements FNET_IExecutable.
+    void execute() override;
+};
+
+} // namespace mbus
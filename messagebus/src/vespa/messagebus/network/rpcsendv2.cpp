@@ -2,11 +2,14 @@
 
 #include "rpcsendv2.h"
 #include "rpcnetwork.h"
+#include "rpcsend_private.h"
 #include "rpcserviceaddress.h"
+#include "rpctarget.h"
 #include <vespa/fnet/frt/reflection.h>
 #include <vespa/fnet/frt/require_capabilities.h>
 #include <vespa/messagebus/emptyreply.h>
 #include <vespa/messagebus/error.h>
+#include <vespa/messagebus/errorcode.h>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/util/compressor.h>
@@ -14,6 +17,7 @@
 #include <vespa/vespalib/util/stringfmt.h>
 
 using vespalib::make_string;
+using vespalib::compression::AdaptiveCompression;
 using vespalib::compression::CompressionConfig;
 using vespalib::compression::decompress;
 using vespalib::compression::compress;
@@ -32,6 +36,7 @@ namespace {
 const char *METHOD_NAME   = "mbus.slime";
 const char *METHOD_PARAMS = "bixbix";
 const char *METHOD_RETURN = "bixbix";
+const char *BATCH_METHOD_NAME = "mbus.slime.batch";
 
 Memory VERSION_F("version");
 Memory ROUTE_F("route");
@@ -48,6 +53,8 @@ Memory ERRORS_F("errors");
 Memory CODE_F("code");
 Memory MSG_F("msg");
 Memory SERVICE_F("service");
+Memory MESSAGES_F("messages");
+Memory REPLIES_F("replies");
 
 }
 
@@ -77,6 +84,22 @@ RPCSendV2::build(FRT_ReflectionBuilder & builder, CapabilitySet required_capabil
     builder.ReturnDesc("body_decoded_size", "Uncompressed body blob size");
     builder.ReturnDesc("body_payload", "The reply body blob in slime.");
     builder.RequestAccessFilter(FRT_RequireCapabilities::of(required_capabilities));
+
+    builder.DefineMethod(BATCH_METHOD_NAME, METHOD_PARAMS, METHOD_RETURN, FRT_METHOD(RPCSendV2::invokeBatch), this);
+    builder.MethodDesc("Send a batch of message bus slime requests and get their replies back.");
+    builder.ParamDesc("header_encoding", "0=raw, 6=lz4");
+    builder.ParamDesc("header_decoded_size", "Uncompressed header blob size");
+    builder.ParamDesc("header_payload", "The batch header blob in slime");
+    builder.ParamDesc("body_encoding", "0=raw, 6=lz4");
+    builder.ParamDesc("body_decoded_size", "Uncompressed body blob size");
+    builder.ParamDesc("body_payload", "The batch body blob in slime, an array of encoded message slimes");
+    builder.ReturnDesc("header_encoding",  "0=raw, 6=lz4");
+    builder.ReturnDesc("header_decoded_size", "Uncompressed header blob size");
+    builder.ReturnDesc("header_payload", "The batch reply header blob in slime.");
+    builder.ReturnDesc("body_encoding",  "0=raw, 6=lz4");
+    builder.ReturnDesc("body_decoded_size", "Uncompressed body blob size");
+    builder.ReturnDesc("body_payload", "The batch reply body blob in slime, an array of replies in message order.");
+    builder.RequestAccessFilter(FRT_RequireCapabilities::of(required_capabilities));
 }
 
 const char *
@@ -103,20 +126,44 @@ private:
 };
 OutputBuf::~OutputBuf() = default;
 
+DataBuffer
+decodePayload(const FRT_Values &values)
+{
+    uint8_t encoding = values[3]._intval8;
+    uint32_t uncompressedSize = values[4]._intval32;
+    DataBuffer uncompressed(values[5]._data._buf, values[5]._data._len);
+    ConstBufferRef blob(values[5]._data._buf, values[5]._data._len);
+    decompress(CompressionConfig::toType(encoding), uncompressedSize, blob, uncompressed, true);
+    assert(uncompressedSize == uncompressed.getDataLen());
+    return uncompressed;
+}
+
 }
 
 void
-RPCSendV2::encodeRequest(FRT_RPCRequest &req, const Version &version, const Route & route,
-                         const RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
-                         const PayLoadFiller &filler, duration timeRemaining) const
+RPCSendV2::addPayload(FRT_Values &values, const DataBuffer &slime, const AdaptiveCompression::LinkEstimate *link) const
 {
-    FRT_Values &args = *req.GetParams();
-    req.SetMethodName(METHOD_NAME);
     // Place holder for auxillary data to be transfered later.
-    args.AddInt8(CompressionConfig::NONE);
-    args.AddInt32(0);
-    args.AddData("", 0);
+    values.AddInt8(CompressionConfig::NONE);
+    values.AddInt32(0);
+    values.AddData("", 0);
+
+    ConstBufferRef toCompress(slime.getData(), slime.getDataLen());
+    DataBuffer buf(vespalib::roundUp2inN(slime.getDataLen()));
+    CompressionConfig::Type type = _net->getCompression().compress(toCompress, buf, link);
 
+    values.AddInt8(type);
+    values.AddInt32(toCompress.size());
+    const auto bufferLength = buf.getDataLen();
+    assert(bufferLength <= INT32_MAX);
+    values.AddData(std::move(buf).stealBuffer(), bufferLength);
+}
+
+DataBuffer
+RPCSendV2::encodeMessage(const Version &version, const Route & route, const RPCServiceAddress & address,
+                         const Message & msg, uint32_t traceLevel, const PayLoadFiller &filler,
+                         duration timeRemaining) const
+{
     Slime slime;
     Cursor & root = slime.setObject();
 
@@ -132,15 +179,37 @@ RPCSendV2::encodeRequest(FRT_RPCRequest &req, const Version &version, const Rout
 
     OutputBuf rBuf(8_Ki);
     BinaryFormat::encode(slime, rBuf);
-    ConstBufferRef toCompress(rBuf.getBuf().getData(), rBuf.getBuf().getDataLen());
-    DataBuffer buf(vespalib::roundUp2inN(rBuf.getBuf().getDataLen()));
-    CompressionConfig::Type type = compress(_net->getCompressionConfig(), toCompress, buf, false);
+    return std::move(rBuf.getBuf());
+}
 
-    args.AddInt8(type);
-    args.AddInt32(toCompress.size());
-    const auto bufferLength = buf.getDataLen();
-    assert(bufferLength <= INT32_MAX);
-    args.AddData(std::move(buf).stealBuffer(), bufferLength);
+void
+RPCSendV2::encodeRequest(FRT_RPCRequest &req, DataBuffer message, RPCTarget &target) const
+{
+    req.SetMethodName(METHOD_NAME);
+    addPayload(*req.GetParams(), message, &target.getLinkEstimate());
+}
+
+void
+RPCSendV2::encodeBatchRequest(FRT_RPCRequest &req, BatchEntries &entries, RPCTarget &target) const
+{
+    req.SetMethodName(BATCH_METHOD_NAME);
+    Slime slime;
+    Cursor & messages = slime.setObject().setArray(MESSAGES_F);
+    size_t size = 0;
+    for (const auto & entry : entries) {
+        const DataBuffer &message = entry->getRequest();
+        messages.addData(Memory(message.getData(), message.getDataLen()));
+        size += message.getDataLen();
+    }
+    OutputBuf rBuf(size + 1_Ki);
+    BinaryFormat::encode(slime, rBuf);
+    addPayload(*req.GetParams(), rBuf.getBuf(), &target.getLinkEstimate());
+}
+
+bool
+RPCSendV2::isBatchRequest(FRT_RPCRequest &req) const
+{
+    return (strcmp(req.GetMethodName(), BATCH_METHOD_NAME) == 0);
 }
 
 namespace {
@@ -151,14 +220,14 @@ public:
     explicit ParamsV2(const FRT_Values &arg)
         : _slime()
     {
-        uint8_t encoding = arg[3]._intval8;
-        uint32_t uncompressedSize = arg[4]._intval32;
-        DataBuffer uncompressed(arg[5]._data._buf, arg[5]._data._len);
-        ConstBufferRef blob(arg[5]._data._buf, arg[5]._data._len);
-        decompress(CompressionConfig::toType(encoding), uncompressedSize, blob, uncompressed, true);
-        assert(uncompressedSize == uncompressed.getDataLen());
+        DataBuffer uncompressed = decodePayload(arg);
         BinaryFormat::decode(Memory(uncompressed.getData(), uncompressed.getDataLen()), _slime);
     }
+    explicit ParamsV2(Memory message)
+        : _slime()
+    {
+        BinaryFormat::decode(message, _slime);
+    }
 
     uint32_t getTraceLevel() const override { return _slime.get()[TRACELEVEL_F].asLong(); }
     bool useRetry() const override { return _slime.get()[USERETRY_F].asBool(); }
@@ -193,19 +262,60 @@ RPCSendV2::toParams(const FRT_Values &args) const
     return std::make_unique<ParamsV2>(args);
 }
 
+std::vector<std::unique_ptr<RPCSend::Params>>
+RPCSendV2::toBatchParams(const FRT_Values &args) const
+{
+    DataBuffer uncompressed = decodePayload(args);
+    Slime slime;
+    BinaryFormat::decode(Memory(uncompressed.getData(), uncompressed.getDataLen()), slime);
+    Inspector & messages = slime.get()[MESSAGES_F];
+    std::vector<std::unique_ptr<Params>> params;
+    params.reserve(messages.entries());
+    for (size_t i = 0; i < messages.entries(); ++i) {
+        params.push_back(std::make_unique<ParamsV2>(messages[i].asData()));
+    }
+    return params;
+}
+
 std::unique_ptr<Reply>
 RPCSendV2::createReply(const FRT_Values & ret, const string & serviceName,
                        Error & error, vespalib::Trace & rootTrace) const
 {
-    uint8_t encoding = ret[3]._intval8;
-    uint32_t uncompressedSize = ret[4]._intval32;
-    DataBuffer uncompressed(ret[5]._data._buf, ret[5]._data._len);
-    ConstBufferRef blob(ret[5]._data._buf, ret[5]._data._len);
-    decompress(CompressionConfig::toType(encoding), uncompressedSize, blob, uncompressed, true);
-    assert(uncompressedSize == uncompressed.getDataLen());
+    DataBuffer uncompressed = decodePayload(ret);
+    Slime slime;
+    BinaryFormat::decode(Memory(uncompressed.getData(), uncompressed.getDataLen()), slime);
+    return createReply(slime.get(), serviceName, error, rootTrace);
+}
+
+RPCSend::BatchReplies
+RPCSendV2::createBatchReplies(const FRT_Values & ret, BatchEntries &entries) const
+{
+    DataBuffer uncompressed = decodePayload(ret);
     Slime slime;
     BinaryFormat::decode(Memory(uncompressed.getData(), uncompressed.getDataLen()), slime);
-    Inspector & root = slime.get();
+    Inspector & replies = slime.get()[REPLIES_F];
+    BatchReplies result;
+    if (replies.entries() != entries.size()) {
+        return result;
+    }
+    result.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        network::internal::SendContext &ctx = entries[i]->getContext();
+        const auto &address = static_cast<const RPCServiceAddress&>(ctx.getRecipient().getServiceAddress());
+        Error error;
+        Reply::UP reply = createReply(replies[i], address.getServiceName(), error, ctx.getTrace());
+        if (error.getCode() != ErrorCode::NONE) {
+            reply->addError(error);
+        }
+        result.push_back(std::move(reply));
+    }
+    return result;
+}
+
+std::unique_ptr<Reply>
+RPCSendV2::createReply(const Inspector & root, const string & serviceName,
+                       Error & error, vespalib::Trace & rootTrace) const
+{
     Version version(root[VERSION_F].asString().make_string());
     Memory payload = root[BLOB_F].asData();
 
@@ -217,31 +327,25 @@ RPCSendV2::createReply(const FRT_Values & ret, const string & serviceName,
         reply = std::make_unique<EmptyReply>();
     }
     reply->setRetryDelay(root[RETRYDELAY_F].asDouble());
-    Inspector & errors = root[ERRORS_F];
+    const Inspector & errors = root[ERRORS_F];
     for (uint32_t i = 0; i < errors.entries(); ++i) {
-        Inspector & e = errors[i];
+        const Inspector & e = errors[i];
         Memory service = e[SERVICE_F].asString();
         reply->addError(Error(e[CODE_F].asLong(), e[MSG_F].asString().make_string(),
                               (service.size > 0) ? service.make_string() : serviceName));
     }
-    Inspector & trace = root[TRACE_F];
+    const Inspector & trace = root[TRACE_F];
     if (trace.valid() && (trace.asString().size > 0)) {
         rootTrace.addChild(TraceNode::decode(trace.asString().make_string()));
     }
     return reply;
 }
 
+namespace {
+
 void
-RPCSendV2::createResponse(FRT_Values & ret, const string & version, Reply & reply, Blob payload) const
+encodeReply(Cursor & root, const string & version, const Reply & reply, const Blob & payload)
 {
-    // Place holder for auxillary data to be transfered later.
-    ret.AddInt8(CompressionConfig::NONE);
-    ret.AddInt32(0);
-    ret.AddData("", 0);
-
-    Slime slime;
-    Cursor & root = slime.setObject();
-
     root.setString(VERSION_F, version);
     root.setDouble(RETRYDELAY_F, reply.getRetryDelay());
     root.setString(PROTOCOL_F, reply.getProtocol());
@@ -259,17 +363,35 @@ RPCSendV2::createResponse(FRT_Values & ret, const string & version, Reply & repl
             error.setString(SERVICE_F, reply.getError(i).getService());
         }
     }
+}
+
+}
+
+void
+RPCSendV2::createResponse(FRT_Values & ret, const string & version, Reply & reply, Blob payload) const
+{
+    Slime slime;
+    encodeReply(slime.setObject(), version, reply, payload);
+
+    OutputBuf rBuf(8_Ki);
+    BinaryFormat::encode(slime, rBuf);
+    // the link to the client is not known here; large replies use
+    // dense compression whenever it is enabled
+    addPayload(ret, rBuf.getBuf(), nullptr);
+}
+
+void
+RPCSendV2::createBatchResponse(FRT_Values & ret, std::vector<network::internal::BatchReplyEntry> &replies) const
+{
+    Slime slime;
+    Cursor & array = slime.setObject().setArray(REPLIES_F);
+    for (const auto & entry : replies) {
+        encodeReply(array.addObject(), entry.version, *entry.reply, entry.payload);
+    }
 
     OutputBuf rBuf(8_Ki);
     BinaryFormat::encode(slime, rBuf);
-    ConstBufferRef toCompress(rBuf.getBuf().getData(), rBuf.getBuf().getDataLen());
-    DataBuffer buf(vespalib::roundUp2inN(rBuf.getBuf().getDataLen()));
-    CompressionConfig::Type type = compress(_net->getCompressionConfig(), toCompress, buf, false);
-
-    ret.AddInt8(type);
-    ret.AddInt32(toCompress.size());
-    assert(buf.getDataLen() <= INT32_MAX);
-    ret.AddData(std::move(buf));
+    addPayload(ret, rBuf.getBuf(), nullptr);
 }
 
 } // namespace mbus
@@ -2,6 +2,9 @@
 #pragma once
 
 #include "rpcsend.h"
+#include <vespa/vespalib/util/adaptive_compression.h>
+
+namespace vespalib::slime { struct Inspector; }
 
 namespace mbus {
 
@@ -12,13 +15,25 @@ private:
     void build(FRT_ReflectionBuilder & builder, CapabilitySet required_capabilities) override;
     const char * getReturnSpec() const override;
     std::unique_ptr<Params> toParams(const FRT_Values &param) const override;
-    void encodeRequest(FRT_RPCRequest &req, const vespalib::Version &version, const Route & route,
-                       const RPCServiceAddress & address, const Message & msg, uint32_t traceLevel,
-                       const PayLoadFiller &filler, duration timeRemaining) const override;
+    std::vector<std::unique_ptr<Params>> toBatchParams(const FRT_Values &param) const override;
+    vespalib::DataBuffer encodeMessage(const vespalib::Version &version, const Route & route,
+                                       const RPCServiceAddress & address, const Message & msg,
+                                       uint32_t traceLevel, const PayLoadFiller &filler,
+                                       duration timeRemaining) const override;
+    void encodeRequest(FRT_RPCRequest &req, vespalib::DataBuffer message, RPCTarget &target) const override;
+    void encodeBatchRequest(FRT_RPCRequest &req, BatchEntries &entries, RPCTarget &target) const override;
+    bool isBatchRequest(FRT_RPCRequest &req) const override;
 
     std::unique_ptr<Reply> createReply(const FRT_Values & response, const string & serviceName,
                                        Error & error, vespalib::Trace & trace) const override;
+    BatchReplies createBatchReplies(const FRT_Values & response, BatchEntries &entries) const override;
     void createResponse(FRT_Values & ret, const string & version, Reply & reply, Blob payload) const override;
+    void createBatchResponse(FRT_Values & ret, std::vector<network::internal::BatchReplyEntry> &replies) const override;
+
+    std::unique_ptr<Reply> createReply(const vespalib::slime::Inspector & root, const string & serviceName,
+                                       Error & error, vespalib::Trace & trace) const;
+    void addPayload(FRT_Values & values, const vespalib::DataBuffer & slime,
+                    const vespalib::compression::AdaptiveCompression::LinkEstimate * link) const;
 };
 
 } // namespace mbus
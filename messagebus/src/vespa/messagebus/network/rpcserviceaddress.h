@@ -77,6 +77,7 @@ public:
      * @return The target to use.
      */
     RPCTarget &getTarget() { return *_target; }
+    const RPCTarget &getTarget() const { return *_target; }
 
     /**
      * Returns whether or not this has an RPC target set.
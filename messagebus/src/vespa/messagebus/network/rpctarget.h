@@ -1,10 +1,12 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "rpcsendqueue.h"
 #include <vespa/messagebus/common.h>
 #include <vespa/fnet/frt/invoker.h>
 #include <vespa/fnet/frt/target.h>
 #include <vespa/vespalib/component/version.h>
+#include <vespa/vespalib/util/adaptive_compression.h>
 
 namespace mbus {
 
@@ -57,6 +59,8 @@ private:
     std::atomic<ResolveState>  _state;
     Version_UP                 _version;
     HandlerList                _versionHandlers;
+    vespalib::compression::AdaptiveCompression::LinkEstimate _link;
+    RPCSendQueue               _sendQueue;
 
     struct ctor_tag {};
 public:
@@ -107,6 +111,19 @@ public:
      */
     FRT_Target &getFRTTarget() { return _target; }
 
+    /**
+     * Returns the estimated throughput of the link to this target, used
+     * to select payload compression.
+     */
+    vespalib::compression::AdaptiveCompression::LinkEstimate &getLinkEstimate() { return _link; }
+    const vespalib::compression::AdaptiveCompression::LinkEstimate &getLinkEstimate() const { return _link; }
+
+    /**
+     * Returns the queue of small messages waiting to be sent to this target
+     * in a batch.
+     */
+    RPCSendQueue &getSendQueue() { return _sendQueue; }
+
     /**
      * Returns the version to use when communicating with this target.
      * Version must have been successfully resolved before calling this
@@ -239,6 +239,7 @@ public enum SearchNodeMetrics implements VespaMetrics {
     CONTENT_PROTON_DOCUMENTDB_INDEX_INDEXES("content.proton.documentdb.index.indexes", Unit.ITEM, "Number of disk or memory indexes"),
     CONTENT_PROTON_DOCUMENTDB_INDEX_IO_SEARCH_READ_BYTES("content.proton.documentdb.index.io.search.read_bytes", Unit.BYTE, "Bytes read from disk index posting list and bitvector files as part of search for this document type"),
     CONTENT_PROTON_DOCUMENTDB_INDEX_IO_SEARCH_CACHED_READ_BYTES("content.proton.documentdb.index.io.search.cached_read_bytes", Unit.BYTE, "Bytes read from cached disk index posting list and bitvector files as part of search for this document type"),
+    CONTENT_PROTON_DOCUMENTDB_INDEX_IO_SEARCH_DIRECT_IO_READ_BYTES("content.proton.documentdb.index.io.search.direct_io_read_bytes", Unit.BYTE, "Bytes read from disk index bitvector files bypassing the OS page cache as part of search for this document type"),
     CONTENT_PROTON_DOCUMENTDB_READY_INDEX_MEMORY_USAGE_ALLOCATED_BYTES("content.proton.documentdb.ready.index.memory_usage.allocated_bytes", Unit.BYTE, "The number of allocated bytes for this index field in the memory index for this document type"),
     CONTENT_PROTON_DOCUMENTDB_READY_INDEX_DISK_USAGE("content.proton.documentdb.ready.index.disk_usage", Unit.BYTE, "Disk space usage (in bytes) of this index field in all disk indexes for this document type"),
 
@@ -247,6 +248,10 @@ public enum SearchNodeMetrics implements VespaMetrics {
     CONTENT_PROTON_DOCUMENTDB_MATCHING_SOFT_DOOMED_QUERIES("content.proton.documentdb.matching.soft_doomed_queries", Unit.QUERY, "Number of queries hitting the soft timeout"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_QUERY_LATENCY("content.proton.documentdb.matching.query_latency", Unit.SECOND, "Total average latency (sec) when matching and ranking a query"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_QUERY_SETUP_TIME("content.proton.documentdb.matching.query_setup_time", Unit.SECOND, "Average time (sec) spent setting up and tearing down queries"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_QUEUED_QUERIES("content.proton.documentdb.matching.queued_queries", Unit.QUERY, "Number of queries that waited for admission to matching"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_SHED_QUERIES("content.proton.documentdb.matching.shed_queries", Unit.QUERY, "Number of queries rejected by admission control without matching"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_QUEUE_TIME("content.proton.documentdb.matching.queue_time", Unit.SECOND, "Average time (sec) queries waited for admission to matching"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_WAKEUP_TIME("content.proton.documentdb.matching.wakeup_time", Unit.SECOND, "Average time (sec) from handing out a query to the match threads until the last one started"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_DOCS_MATCHED("content.proton.documentdb.matching.docs_matched", Unit.DOCUMENT, "Number of documents matched"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_DOCS_RANKED("content.proton.documentdb.matching.docs_ranked", Unit.DOCUMENT, "Number of documents ranked (first phase)"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_DOCS_RERANKED("content.proton.documentdb.matching.docs_reranked", Unit.DOCUMENT, "Number of documents re-ranked (second phase)"),
@@ -261,6 +266,9 @@ public enum SearchNodeMetrics implements VespaMetrics {
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_DOCS_RANKED("content.proton.documentdb.matching.rank_profile.docs_ranked", Unit.DOCUMENT, "Number of documents ranked (first phase)"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_DOCS_RERANKED("content.proton.documentdb.matching.rank_profile.docs_reranked", Unit.DOCUMENT, "Number of documents re-ranked (second phase)"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_LIMITED_QUERIES("content.proton.documentdb.matching.rank_profile.limited_queries", Unit.QUERY, "Number of queries limited in match phase"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_ADAPTIVE_LIMITED_QUERIES("content.proton.documentdb.matching.rank_profile.adaptive_limited_queries", Unit.QUERY, "Number of queries limited in match phase with max hits lowered to fit the time left"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_ADAPTIVE_MAX_HITS("content.proton.documentdb.matching.rank_profile.adaptive_max_hits", Unit.HIT, "Average max hits chosen by adaptive match phase limiting"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_MATCH_COST_PER_HIT("content.proton.documentdb.matching.rank_profile.match_cost_per_hit", Unit.SECOND, "Smoothed match time (sec) per matched document"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_DOCID_PARTITION_ACTIVE_TIME("content.proton.documentdb.matching.rank_profile.docid_partition.active_time", Unit.SECOND, "Time (sec) spent doing actual work"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_DOCID_PARTITION_DOCS_MATCHED("content.proton.documentdb.matching.rank_profile.docid_partition.docs_matched", Unit.DOCUMENT, "Number of documents matched"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_DOCID_PARTITION_DOCS_RANKED("content.proton.documentdb.matching.rank_profile.docid_partition.docs_ranked", Unit.DOCUMENT, "Number of documents ranked (first phase)"),
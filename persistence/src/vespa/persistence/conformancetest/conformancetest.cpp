@@ -3,6 +3,7 @@
 #include <vespa/document/base/testdocman.h>
 #include <vespa/persistence/conformancetest/conformancetest.h>
 #include <vespa/persistence/spi/test.h>
+#include <vespa/persistence/spi/batched_feed_operation.h>
 #include <vespa/persistence/spi/catchresult.h>
 #include <vespa/persistence/spi/doctype_gid_and_timestamp.h>
 #include <vespa/persistence/spi/resource_usage_listener.h>
@@ -833,6 +834,56 @@ TEST_F(ConformanceTest, multi_remove_does_not_remove_docs_if_specified_timestamp
     }
 }
 
+TEST_F(ConformanceTest, feed_batch_applies_puts_and_removes_in_order)
+{
+    document::TestDocMan testDocMan;
+    _factory->clear();
+    PersistenceProviderUP spi(getSpi(*_factory, testDocMan));
+
+    Bucket bucket(makeSpiBucket(BucketId(8, 0x01)));
+    spi->createBucket(bucket);
+    Document::SP doc1 = testDocMan.createRandomDocumentAtLocation(0x01, 1);
+    Document::SP doc2 = testDocMan.createRandomDocumentAtLocation(0x01, 2);
+    Document::SP doc3 = testDocMan.createRandomDocumentAtLocation(0x01, 3);
+
+    std::vector<std::future<std::unique_ptr<Result>>> futures;
+    std::vector<BatchedFeedOperation> ops;
+    auto add_op = [&futures, &ops](auto make_op) {
+        auto onDone = std::make_unique<CatchResult>();
+        futures.emplace_back(onDone->future_result());
+        ops.emplace_back(make_op(std::move(onDone)));
+    };
+    add_op([&](auto onDone) { return BatchedFeedOperation::make_put(Timestamp(1), doc1, std::move(onDone)); });
+    add_op([&](auto onDone) { return BatchedFeedOperation::make_put(Timestamp(2), doc2, std::move(onDone)); });
+    add_op([&](auto onDone) { return BatchedFeedOperation::make_remove(Timestamp(3), doc1->getId(), std::move(onDone)); });
+    add_op([&](auto onDone) { return BatchedFeedOperation::make_remove(Timestamp(4), doc3->getId(), std::move(onDone)); });
+    spi->feedBatchAsync(bucket, std::move(ops));
+
+    std::vector<std::unique_ptr<Result>> results;
+    for (auto& future : futures) {
+        results.emplace_back(future.get());
+        ASSERT_TRUE(results.back());
+        EXPECT_FALSE(results.back()->hasError());
+    }
+    auto remove_found = dynamic_cast<RemoveResult *>(results[2].get());
+    auto remove_not_found = dynamic_cast<RemoveResult *>(results[3].get());
+    ASSERT_TRUE(remove_found != nullptr);
+    ASSERT_TRUE(remove_not_found != nullptr);
+    EXPECT_TRUE(remove_found->wasFound());
+    EXPECT_FALSE(remove_not_found->wasFound());
+
+    const BucketInfo info = spi->getBucketInfo(bucket).getBucketInfo();
+    EXPECT_EQ(1, (int)info.getDocumentCount());
+
+    Context context(Priority(0), Trace::TraceLevel(0));
+    GetResult gr1 = spi->get(bucket, document::AllFields(), doc1->getId(), context);
+    EXPECT_FALSE(gr1.hasDocument());
+    GetResult gr2 = spi->get(bucket, document::AllFields(), doc2->getId(), context);
+    EXPECT_EQ(Timestamp(2), gr2.getTimestamp());
+    ASSERT_TRUE(gr2.hasDocument());
+    EXPECT_EQ(*doc2, gr2.getDocument());
+}
+
 TEST_F(ConformanceTest, testRemoveMerge)
 {
     document::TestDocMan testDocMan;
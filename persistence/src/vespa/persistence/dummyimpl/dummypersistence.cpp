@@ -6,6 +6,7 @@
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/document/bucket/fixed_bucket_spaces.h>
+#include <vespa/persistence/spi/batched_feed_operation.h>
 #include <vespa/persistence/spi/doctype_gid_and_timestamp.h>
 #include <vespa/persistence/spi/i_resource_usage_listener.h>
 #include <vespa/persistence/spi/resource_usage.h>
@@ -458,26 +459,67 @@ DummyPersistence::putAsync(const Bucket& b, Timestamp t, Document::SP doc, Opera
     LOG(debug, "put(%s, %" PRIu64 ", %s)",
         b.toString().c_str(), uint64_t(t), doc->getId().toString().c_str());
     assert(b.getBucketSpace() == FixedBucketSpaces::default_space());
-    BucketContentGuard::UP bc(acquireBucketWithLock(b));
-    while (!bc) {
-        internal_create_bucket(b);
-        bc = acquireBucketWithLock(b);
-    }
-    DocEntry::SP existing = (*bc)->getEntry(t);
+    BucketContentGuard::UP bc(acquire_or_create_bucket_with_lock(b));
+    auto result = put_locked(**bc, t, *doc);
+    bc.reset();
+    onComplete->onComplete(std::move(result));
+}
+
+std::unique_ptr<Result>
+DummyPersistence::put_locked(BucketContent& bc, Timestamp t, const Document& doc)
+{
+    DocEntry::SP existing = bc.getEntry(t);
     if (existing) {
-        bc.reset();
-        if (doc->getId() == *existing->getDocumentId()) {
-            onComplete->onComplete(std::make_unique<Result>());
-        } else {
-            onComplete->onComplete(std::make_unique<Result>(Result::ErrorType::TIMESTAMP_EXISTS,
-                                                            "Timestamp already existed"));
+        if (doc.getId() == *existing->getDocumentId()) {
+            return std::make_unique<Result>();
         }
-    } else {
-        LOG(spam, "Inserting document %s", doc->toString(true).c_str());
-        auto entry = DocEntry::create(t, Document::UP(doc->clone()));
-        (*bc)->insert(std::move(entry));
-        bc.reset();
-        onComplete->onComplete(std::make_unique<Result>());
+        return std::make_unique<Result>(Result::ErrorType::TIMESTAMP_EXISTS, "Timestamp already existed");
+    }
+    LOG(spam, "Inserting document %s", doc.toString(true).c_str());
+    bc.insert(DocEntry::create(t, Document::UP(doc.clone())));
+    return std::make_unique<Result>();
+}
+
+uint32_t
+DummyPersistence::remove_locked(BucketContent& bc, Timestamp t, const DocumentId& id)
+{
+    DocEntry::SP entry(bc.getEntry(id));
+    if (!entry || entry->getTimestamp() <= t) {
+        uint32_t num_removes = (entry && !entry->isRemove()) ? 1 : 0;
+        auto remEntry = DocEntry::create(t, DocumentMetaEnum::REMOVE_ENTRY, id);
+
+        if (bc.hasTimestamp(t)) {
+            bc.eraseEntry(t);
+        }
+        bc.insert(std::move(remEntry));
+        return num_removes;
+    }
+    LOG(debug, "Not adding tombstone for %s at %" PRIu64 " since it has already "
+               "been succeeded by a newer write at timestamp %" PRIu64,
+        id.toString().c_str(), t.getValue(), entry->getTimestamp().getValue());
+    return 0;
+}
+
+void
+DummyPersistence::feedBatchAsync(const Bucket& b, std::vector<spi::BatchedFeedOperation> ops)
+{
+    verifyInitialized();
+    LOG(debug, "feedBatch(%s, %zu operations)", b.toString().c_str(), ops.size());
+    assert(b.getBucketSpace() == FixedBucketSpaces::default_space());
+    std::vector<std::unique_ptr<Result>> results;
+    results.reserve(ops.size());
+    {
+        BucketContentGuard::UP bc(acquire_or_create_bucket_with_lock(b));
+        for (const auto& op : ops) {
+            if (op.is_put()) {
+                results.emplace_back(put_locked(**bc, op.timestamp(), *op.document()));
+            } else {
+                results.emplace_back(std::make_unique<RemoveResult>(remove_locked(**bc, op.timestamp(), op.document_id())));
+            }
+        }
+    }
+    for (size_t i = 0; i < ops.size(); ++i) {
+        ops[i].steal_on_complete()->onComplete(std::move(results[i]));
     }
 }
 
@@ -527,24 +569,10 @@ DummyPersistence::removeAsync(const Bucket& b, std::vector<spi::IdAndTimestamp>
         Timestamp t = stampedId.timestamp;
         LOG(debug, "remove(%s, %" PRIu64 ", %s)", b.toString().c_str(), uint64_t(t), id.toString().c_str());
 
-        while (!bc) {
-            internal_create_bucket(b);
-            bc = acquireBucketWithLock(b);
-        }
-        DocEntry::SP entry((*bc)->getEntry(id));
-        if (!entry || entry->getTimestamp() <= t) {
-            numRemoves += (entry && !entry->isRemove()) ? 1 : 0;
-            auto remEntry = DocEntry::create(t, DocumentMetaEnum::REMOVE_ENTRY, id);
-
-            if ((*bc)->hasTimestamp(t)) {
-                (*bc)->eraseEntry(t);
-            }
-            (*bc)->insert(std::move(remEntry));
-        } else {
-            LOG(debug, "Not adding tombstone for %s at %" PRIu64 " since it has already "
-                       "been succeeded by a newer write at timestamp %" PRIu64,
-                id.toString().c_str(), t.getValue(), entry->getTimestamp().getValue());
+        if (!bc) {
+            bc = acquire_or_create_bucket_with_lock(b);
         }
+        numRemoves += remove_locked(**bc, t, id);
     }
     bc.reset();
     onComplete->onComplete(std::make_unique<RemoveResult>(numRemoves));
@@ -994,6 +1022,17 @@ DummyPersistence::internal_create_bucket(const Bucket& b)
     }
 }
 
+BucketContentGuard::UP
+DummyPersistence::acquire_or_create_bucket_with_lock(const Bucket& b)
+{
+    BucketContentGuard::UP bc(acquireBucketWithLock(b));
+    while (!bc) {
+        internal_create_bucket(b);
+        bc = acquireBucketWithLock(b);
+    }
+    return bc;
+}
+
 DummyPersistence::Content::const_iterator
 DummyPersistence::find(const Bucket & bucket) const {
     return _content.find(bucket);
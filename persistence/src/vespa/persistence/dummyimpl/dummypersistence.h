@@ -165,6 +165,7 @@ public:
     void putAsync(const Bucket&, Timestamp, DocumentSP, OperationComplete::UP) override;
     void removeAsync(const Bucket& b, std::vector<spi::IdAndTimestamp> ids, OperationComplete::UP) override;
     void removeByGidAsync(const Bucket& b, std::vector<spi::DocTypeGidAndTimestamp> ids, std::unique_ptr<OperationComplete>) override;
+    void feedBatchAsync(const Bucket& b, std::vector<spi::BatchedFeedOperation> ops) override;
     void updateAsync(const Bucket&, Timestamp, DocumentUpdateSP, OperationComplete::UP) override;
 
     CreateIteratorResult
@@ -210,6 +211,10 @@ private:
     BucketContentGuard::UP acquireBucketWithLock(const Bucket& b, LockMode lock_mode = LockMode::Exclusive) const;
     void releaseBucketNoLock(const BucketContent& bc, LockMode lock_mode = LockMode::Exclusive) const noexcept;
     void internal_create_bucket(const Bucket &b);
+    BucketContentGuard::UP acquire_or_create_bucket_with_lock(const Bucket& b);
+    // Both require the bucket lock to be held by the caller
+    static std::unique_ptr<Result> put_locked(BucketContent& bc, Timestamp t, const Document& doc);
+    static uint32_t remove_locked(BucketContent& bc, Timestamp t, const DocumentId& id);
 
     mutable bool _initialized;
     std::shared_ptr<const document::DocumentTypeRepo> _repo;
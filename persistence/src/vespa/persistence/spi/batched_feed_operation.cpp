@@ -0,0 +1,33 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "batched_feed_operation.h"
+#include <vespa/document/fieldvalue/document.h>
+
+namespace storage::spi {
+
+BatchedFeedOperation::BatchedFeedOperation(Timestamp timestamp, DocumentSP doc, DocumentId id,
+                                           OperationComplete::UP on_complete) noexcept
+    : _timestamp(timestamp),
+      _doc(std::move(doc)),
+      _id(std::move(id)),
+      _on_complete(std::move(on_complete))
+{
+}
+
+BatchedFeedOperation::BatchedFeedOperation(BatchedFeedOperation&&) noexcept = default;
+BatchedFeedOperation& BatchedFeedOperation::operator=(BatchedFeedOperation&&) noexcept = default;
+BatchedFeedOperation::~BatchedFeedOperation() = default;
+
+BatchedFeedOperation
+BatchedFeedOperation::make_put(Timestamp timestamp, DocumentSP doc, OperationComplete::UP on_complete)
+{
+    return {timestamp, std::move(doc), DocumentId(), std::move(on_complete)};
+}
+
+BatchedFeedOperation
+BatchedFeedOperation::make_remove(Timestamp timestamp, const DocumentId& id, OperationComplete::UP on_complete)
+{
+    return {timestamp, DocumentSP(), id, std::move(on_complete)};
+}
+
+}
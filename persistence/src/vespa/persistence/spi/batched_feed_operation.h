@@ -0,0 +1,38 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "operationcomplete.h"
+#include "types.h"
+#include <vespa/document/base/documentid.h>
+
+namespace storage::spi {
+
+/**
+ * A single put or remove in a batch of feed operations towards one bucket,
+ * cf. PersistenceProvider::feedBatchAsync(). Each operation carries its own
+ * completion callback, so callers get the same per-operation results as with
+ * putAsync() and removeIfFoundAsync().
+ */
+class BatchedFeedOperation {
+    Timestamp             _timestamp;
+    DocumentSP            _doc;
+    DocumentId            _id;
+    OperationComplete::UP _on_complete;
+    BatchedFeedOperation(Timestamp timestamp, DocumentSP doc, DocumentId id, OperationComplete::UP on_complete) noexcept;
+public:
+    BatchedFeedOperation(BatchedFeedOperation&&) noexcept;
+    BatchedFeedOperation& operator=(BatchedFeedOperation&&) noexcept;
+    ~BatchedFeedOperation();
+
+    static BatchedFeedOperation make_put(Timestamp timestamp, DocumentSP doc, OperationComplete::UP on_complete);
+    static BatchedFeedOperation make_remove(Timestamp timestamp, const DocumentId& id, OperationComplete::UP on_complete);
+
+    bool is_put() const noexcept { return static_cast<bool>(_doc); }
+    Timestamp timestamp() const noexcept { return _timestamp; }
+    const DocumentSP& document() const noexcept { return _doc; }
+    // Document id of the removed document; only valid for removes.
+    const DocumentId& document_id() const noexcept { return _id; }
+    OperationComplete::UP steal_on_complete() noexcept { return std::move(_on_complete); }
+};
+
+}
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "persistenceprovider.h"
+#include "batched_feed_operation.h"
 #include "catchresult.h"
 #include <future>
 
@@ -58,6 +59,17 @@ PersistenceProvider::removeIfFound(const Bucket& bucket, Timestamp timestamp, co
     return dynamic_cast<const RemoveResult &>(*future.get());
 }
 
+void
+PersistenceProvider::feedBatchAsync(const Bucket& bucket, std::vector<BatchedFeedOperation> ops) {
+    for (auto& op : ops) {
+        if (op.is_put()) {
+            putAsync(bucket, op.timestamp(), op.document(), op.steal_on_complete());
+        } else {
+            removeIfFoundAsync(bucket, op.timestamp(), op.document_id(), op.steal_on_complete());
+        }
+    }
+}
+
 UpdateResult
 PersistenceProvider::update(const Bucket& bucket, Timestamp timestamp, DocumentUpdateSP upd) {
     auto catcher = std::make_unique<CatchResult>();
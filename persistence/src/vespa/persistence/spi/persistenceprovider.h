@@ -16,6 +16,7 @@ namespace vespalib { class IDestructorCallback; }
 
 namespace storage::spi {
 
+class BatchedFeedOperation;
 class IResourceUsageListener;
 struct BucketExecutor;
 struct DocTypeGidAndTimestamp;
@@ -199,6 +200,18 @@ struct PersistenceProvider
      */
     virtual void removeIfFoundAsync(const Bucket&, Timestamp timestamp, const DocumentId& id, OperationComplete::UP) = 0;
 
+    /**
+     * Apply a batch of puts and removes towards a single bucket, in order.
+     * Puts have putAsync() semantics and removes have removeIfFoundAsync()
+     * semantics. The completion callback of each operation is invoked with
+     * the result of that operation, in batch order.
+     * <p/>
+     * The default implementation forwards each operation separately. A
+     * provider can override this to apply the whole batch while holding the
+     * bucket (or write) lock only once.
+     */
+    virtual void feedBatchAsync(const Bucket&, std::vector<BatchedFeedOperation> ops);
+
     /**
      * Remove any trace of the entry with the given timestamp. (Be it a document
      * or a remove entry) This is usually used to revert previously performed
@@ -0,0 +1,381 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "rank_profile_benchmark.h"
+#include <vespa/eval/eval/fast_value.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/eval/value_codec.h>
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchcore/proton/bucketdb/bucket_db_owner.h>
+#include <vespa/searchcore/proton/documentmetastore/documentmetastore.h>
+#include <vespa/searchcore/proton/matching/fakesearchcontext.h>
+#include <vespa/searchcore/proton/matching/match_tools.h>
+#include <vespa/searchcore/proton/matching/matcher.h>
+#include <vespa/searchcore/proton/matching/querynodes.h>
+#include <vespa/searchlib/attribute/attribute_blueprint_factory.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributemanager.h>
+#include <vespa/searchlib/attribute/configconverter.h>
+#include <vespa/searchlib/attribute/floatbase.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/stringbase.h>
+#include <vespa/searchlib/common/mapnames.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/searchlib/fef/blueprintresolver.h>
+#include <vespa/searchlib/fef/indexproperties.h>
+#include <vespa/searchlib/fef/properties.h>
+#include <vespa/searchlib/fef/rank_program.h>
+#include <vespa/searchlib/query/tree/querybuilder.h>
+#include <vespa/searchlib/query/tree/stackdumpcreator.h>
+#include <vespa/searchlib/tensor/tensor_attribute.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/execution_profiler.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/testclock.h>
+#include <vespa/vespalib/util/thread_bundle.h>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+using proton::matching::FakeSearchContext;
+using proton::matching::ISearchContext;
+using proton::matching::Matcher;
+using proton::matching::ProtonNodeTypes;
+using proton::matching::QueryLimiter;
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::FloatingPointAttribute;
+using search::IntegerAttribute;
+using search::StringAttribute;
+using search::attribute::ConfigConverter;
+using search::fef::BlueprintResolver;
+using search::fef::Level;
+using search::fef::Message;
+using search::fef::Properties;
+using search::query::QueryBuilder;
+using search::query::StackDumpCreator;
+using search::query::Weight;
+using search::tensor::TensorAttribute;
+using vespa::config::search::AttributesConfig;
+using vespalib::ExecutionProfiler;
+using vespalib::Memory;
+using vespalib::Slime;
+using vespalib::eval::FastValueBuilderFactory;
+using vespalib::eval::TensorSpec;
+using vespalib::make_string_short::fmt;
+using vespalib::slime::Cursor;
+using vespalib::slime::Inspector;
+
+namespace rank = search::fef::indexproperties::rank;
+
+namespace {
+
+// Number of features to report in the per feature profile
+constexpr int32_t profile_top_n = 1000;
+
+/**
+ * Search context with the benchmark attributes and an empty index,
+ * i.e. query terms will only match attribute fields.
+ **/
+class BenchmarkSearchContext : public ISearchContext {
+    FakeSearchContext                 _fake;
+    search::AttributeBlueprintFactory _attributes;
+    uint32_t                          _docid_limit;
+public:
+    explicit BenchmarkSearchContext(uint32_t docid_limit)
+        : _fake(docid_limit),
+          _attributes(),
+          _docid_limit(docid_limit)
+    {
+        _fake.addIdx(0);
+    }
+    ~BenchmarkSearchContext() override;
+    IndexSearchable &getIndexes() override { return _fake.getIndexes(); }
+    Searchable &getAttributes() override { return _attributes; }
+    uint32_t getDocIdLimit() override { return _docid_limit; }
+};
+
+BenchmarkSearchContext::~BenchmarkSearchContext() = default;
+
+std::unique_ptr<vespalib::eval::Value>
+make_tensor(const Inspector &value)
+{
+    auto spec = TensorSpec::from_expr(value.asString().make_string());
+    if (spec.type() == "error") {
+        throw std::invalid_argument(fmt("invalid tensor expression '%s'", value.asString().make_string().c_str()));
+    }
+    return vespalib::eval::value_from_spec(spec, FastValueBuilderFactory::get());
+}
+
+void
+append_value(AttributeVector &attr, uint32_t docid, const Inspector &value, int32_t weight)
+{
+    if (attr.isIntegerType()) {
+        static_cast<IntegerAttribute &>(attr).append(docid, value.asLong(), weight);
+    } else if (attr.isFloatingPointType()) {
+        static_cast<FloatingPointAttribute &>(attr).append(docid, value.asDouble(), weight);
+    } else {
+        static_cast<StringAttribute &>(attr).append(docid, value.asString().make_string(), weight);
+    }
+}
+
+void
+set_value(AttributeVector &attr, uint32_t docid, const Inspector &value)
+{
+    if (attr.isTensorType()) {
+        auto *tensor_attr = dynamic_cast<TensorAttribute *>(&attr);
+        if (tensor_attr == nullptr) {
+            throw std::invalid_argument("unsupported tensor attribute");
+        }
+        tensor_attr->setTensor(docid, *make_tensor(value));
+    } else if (!attr.isIntegerType() && !attr.isFloatingPointType() && !attr.isStringType()) {
+        throw std::invalid_argument("unsupported attribute type");
+    } else if (attr.hasWeightedSetType()) {
+        attr.clearDoc(docid);
+        for (size_t i = 0; i < value.entries(); ++i) {
+            append_value(attr, docid, value[i][0], value[i][1].asLong());
+        }
+    } else if (attr.hasMultiValue()) {
+        attr.clearDoc(docid);
+        for (size_t i = 0; i < value.entries(); ++i) {
+            append_value(attr, docid, value[i], 1);
+        }
+    } else if (attr.isIntegerType()) {
+        static_cast<IntegerAttribute &>(attr).update(docid, value.asLong());
+    } else if (attr.isFloatingPointType()) {
+        static_cast<FloatingPointAttribute &>(attr).update(docid, value.asDouble());
+    } else {
+        static_cast<StringAttribute &>(attr).update(docid, value.asString().make_string());
+    }
+}
+
+/**
+ * Creates all attributes in the attributes config and populates them
+ * with the values of the documents. Document i in the input gets
+ * local document id i + 1.
+ **/
+void
+load_attributes(const AttributesConfig &attributesCfg, const Inspector &docs, search::AttributeManager &mgr,
+                std::vector<Message> &messages)
+{
+    uint32_t num_docs = docs.entries();
+    for (const auto &attr_cfg : attributesCfg.attribute) {
+        auto attr = AttributeFactory::createAttribute(attr_cfg.name, ConfigConverter::convert(attr_cfg));
+        attr->addDocs(num_docs + 1);
+        for (uint32_t i = 0; i < num_docs; ++i) {
+            const auto &value = docs[i][attr_cfg.name];
+            if (!value.valid()) {
+                continue;
+            }
+            try {
+                set_value(*attr, i + 1, value);
+            } catch (std::exception &e) {
+                messages.emplace_back(Level::WARNING, fmt("attribute '%s', document %u: %s",
+                                                          attr_cfg.name.c_str(), i, e.what()));
+            }
+        }
+        attr->commit(true);
+        mgr.add(attr);
+    }
+}
+
+void
+add_query_features(const Inspector &query, Properties &rank_props)
+{
+    struct Adder : vespalib::slime::ObjectTraverser {
+        Properties &props;
+        explicit Adder(Properties &props_in) noexcept : props(props_in) {}
+        void field(const Memory &name, const Inspector &value) override {
+            if (value.type().getId() == vespalib::slime::STRING::ID) {
+                vespalib::nbostream stream;
+                vespalib::eval::encode_value(*make_tensor(value), stream);
+                props.add(name.make_string(), std::string_view(stream.peek(), stream.size()));
+            } else {
+                props.add(name.make_string(), fmt("%g", value.asDouble()));
+            }
+        }
+    };
+    Adder adder(rank_props);
+    query.traverse(adder);
+}
+
+std::string
+make_stack_dump(const Inspector &terms)
+{
+    QueryBuilder<ProtonNodeTypes> builder;
+    if (terms.entries() == 0) {
+        builder.add_true_node();
+    } else {
+        if (terms.entries() > 1) {
+            builder.addAnd(terms.entries());
+        }
+        for (size_t i = 0; i < terms.entries(); ++i) {
+            builder.addStringTerm(terms[i]["term"].asString().make_string(),
+                                  terms[i]["field"].asString().make_string(), i + 1, Weight(100));
+        }
+    }
+    return StackDumpCreator::create(*builder.build());
+}
+
+struct PhaseResult {
+    double   time_ns;
+    uint64_t allocs;
+    uint32_t matched_docs;
+    double   score_sum;
+    PhaseResult() noexcept : time_ns(0.0), allocs(0), matched_docs(0), score_sum(0.0) {}
+};
+
+/**
+ * Evaluates the rank program of a ranking phase for all documents,
+ * 'repeat' times. Documents not matching the query are also ranked,
+ * as if they were passed on from first phase ranking.
+ **/
+PhaseResult
+run_phase(const proton::matching::MatchToolsFactory &mtf, bool second_phase, uint32_t num_docs, uint32_t repeat,
+          ExecutionProfiler *profiler, const std::function<uint64_t()> &alloc_count)
+{
+    PhaseResult result;
+    auto tools = mtf.createMatchTools();
+    if (second_phase) {
+        tools->setup_second_phase(profiler);
+    } else {
+        tools->setup_first_phase(profiler);
+    }
+    auto &search = tools->search();
+    auto seed = tools->rank_program().get_seeds().resolve(0);
+    uint64_t allocs_before = alloc_count ? alloc_count() : 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < repeat; ++r) {
+        search.initRange(1, num_docs + 1);
+        for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+            if (search.seek(docid)) {
+                search.unpack(docid);
+                ++result.matched_docs;
+            }
+            result.score_sum += seed.as_number(docid);
+        }
+    }
+    result.time_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    if (alloc_count) {
+        result.allocs = alloc_count() - allocs_before;
+    }
+    return result;
+}
+
+void
+benchmark_phase(const proton::matching::MatchToolsFactory &mtf, bool second_phase, const std::string &expression,
+                uint32_t num_docs, const RankProfileBenchmarkParams &params, Cursor &obj)
+{
+    double evals = double(num_docs) * params.repeat;
+    // The first run warms up the rank program and the attributes
+    run_phase(mtf, second_phase, num_docs, 1, nullptr, {});
+    auto timed = run_phase(mtf, second_phase, num_docs, params.repeat, nullptr, params.alloc_count);
+    obj.setString("expression", expression);
+    obj.setLong("matched_docs", timed.matched_docs / params.repeat);
+    obj.setDouble("score_sum", timed.score_sum / params.repeat);
+    obj.setDouble("ns_per_doc", timed.time_ns / evals);
+    if (params.alloc_count) {
+        obj.setDouble("allocs_per_doc", timed.allocs / evals);
+    }
+    ExecutionProfiler profiler(-profile_top_n);
+    run_phase(mtf, second_phase, num_docs, params.repeat, &profiler, {});
+    profiler.report(obj.setObject("profile"),
+                    [](const std::string &name){ return BlueprintResolver::describe_feature(name); });
+}
+
+std::string
+read_file(const std::string &file_name)
+{
+    std::ifstream file(file_name);
+    if (!file) {
+        throw std::runtime_error(fmt("could not open input file '%s'", file_name.c_str()));
+    }
+    std::stringstream buf;
+    buf << file.rdbuf();
+    return buf.str();
+}
+
+}
+
+RankProfileBenchmarkParams::RankProfileBenchmarkParams()
+    : rank_profile(),
+      input_file(),
+      repeat(10),
+      alloc_count()
+{}
+
+RankProfileBenchmarkParams::~RankProfileBenchmarkParams() = default;
+
+bool
+benchmarkRankProfile(const RankProfileBenchmarkParams &params,
+                     const search::index::Schema &schema,
+                     const AttributesConfig &attributesCfg,
+                     const Properties &rankProperties,
+                     const search::fef::IRankingAssetsRepo &repo,
+                     std::vector<Message> &messages,
+                     Cursor &result)
+{
+    try {
+        Slime input;
+        std::string json = read_file(params.input_file);
+        if (vespalib::slime::JsonFormat::decode(Memory(json), input) == 0) {
+            messages.emplace_back(Level::ERROR, fmt("could not parse input file '%s' as json", params.input_file.c_str()));
+            return false;
+        }
+        const auto &docs = input.get()["documents"];
+        uint32_t num_docs = docs.entries();
+        if (num_docs == 0) {
+            messages.emplace_back(Level::ERROR, fmt("no documents in input file '%s'", params.input_file.c_str()));
+            return false;
+        }
+        uint32_t repeat = std::max(params.repeat, 1u);
+        if (num_docs == 1 && repeat > 1) {
+            // The rank program caches the outputs for the last document evaluated
+            messages.emplace_back(Level::WARNING, "repeat ignored since there is a single document");
+            repeat = 1;
+        }
+        RankProfileBenchmarkParams run_params(params);
+        run_params.repeat = repeat;
+
+        search::AttributeManager attributes;
+        load_attributes(attributesCfg, docs, attributes, messages);
+        auto attr_ctx = attributes.createContext();
+        BenchmarkSearchContext search_ctx(num_docs + 1);
+        proton::DocumentMetaStore meta_store(std::make_shared<proton::bucketdb::BucketDBOwner>());
+
+        search::engine::SearchRequest request;
+        request.setTimeout(std::chrono::hours(1));
+        std::string stack_dump = make_stack_dump(input.get()["terms"]);
+        request.stackDump.assign(stack_dump.data(), stack_dump.data() + stack_dump.size());
+        add_query_features(input.get()["query"], request.propertiesMap.lookupCreate(search::MapNames::RANK));
+        request.maxhits = num_docs;
+
+        vespalib::TestClock clock;
+        QueryLimiter query_limiter;
+        Matcher matcher(schema, rankProperties, clock.nowRef(), query_limiter, repo, 0);
+        Properties feature_overrides;
+        auto mtf = matcher.create_match_tools_factory(request, search_ctx, *attr_ctx, meta_store, feature_overrides,
+                                                      vespalib::ThreadBundle::trivial(), nullptr, num_docs, true);
+        if (!mtf->valid()) {
+            messages.emplace_back(Level::ERROR, fmt("rank profile '%s': could not set up matching for the benchmark query",
+                                                    params.rank_profile.c_str()));
+            return false;
+        }
+        result.setString("rank_profile", params.rank_profile);
+        result.setLong("documents", num_docs);
+        result.setLong("repeat", repeat);
+        if (auto first_phase = rank::FirstPhase::lookup(rankProperties); !first_phase.empty()) {
+            benchmark_phase(*mtf, false, first_phase, num_docs, run_params, result.setObject("first_phase"));
+        }
+        if (auto second_phase = rank::SecondPhase::lookup(rankProperties); !second_phase.empty()) {
+            benchmark_phase(*mtf, true, second_phase, num_docs, run_params, result.setObject("second_phase"));
+        }
+        messages.emplace_back(Level::INFO, fmt("rank profile '%s': benchmarked %u documents",
+                                               params.rank_profile.c_str(), num_docs));
+        return true;
+    } catch (std::exception &e) {
+        messages.emplace_back(Level::ERROR, fmt("rank profile '%s': benchmark failed: %s",
+                                                params.rank_profile.c_str(), e.what()));
+        return false;
+    }
+}
@@ -0,0 +1,57 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/config-attributes.h>
+#include <vespa/searchlib/fef/verify_feature.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace search::fef {
+class IRankingAssetsRepo;
+class Properties;
+}
+namespace search::index { class Schema; }
+namespace vespalib::slime { struct Cursor; }
+
+/**
+ * Parameters for benchmarking the evaluation cost of a rank profile.
+ *
+ * The input file is a json object with the query features to use,
+ * an optional list of query terms and the documents to rank:
+ *
+ * {
+ *   "query": { "query(q)": "tensor(x[2]):[1,2]", "query(w)": 0.5 },
+ *   "terms": [ { "field": "title", "term": "foo" } ],
+ *   "documents": [ { "year": 2020, "tags": [["a", 10], ["b", 5]], "embedding": "tensor(x[2]):[3,4]" } ]
+ * }
+ *
+ * Array attribute values are given as json arrays, weighted set
+ * values as arrays of [value, weight] pairs and tensor values as
+ * tensor expressions.
+ **/
+struct RankProfileBenchmarkParams {
+    std::string              rank_profile;
+    std::string              input_file;
+    uint32_t                 repeat;
+    // Returns the number of allocations done so far, if available
+    std::function<uint64_t()> alloc_count;
+    RankProfileBenchmarkParams();
+    ~RankProfileBenchmarkParams();
+};
+
+/**
+ * Evaluates the first and second phase ranking of the given rank
+ * profile for all documents in the input file through the regular
+ * matching stack (Matcher, MatchTools and RankProgram), and reports
+ * the time and allocations per document as well as the time spent
+ * in each feature executor into the given slime object.
+ **/
+bool benchmarkRankProfile(const RankProfileBenchmarkParams &params,
+                          const search::index::Schema &schema,
+                          const vespa::config::search::AttributesConfig &attributesCfg,
+                          const search::fef::Properties &rankProperties,
+                          const search::fef::IRankingAssetsRepo &repo,
+                          std::vector<search::fef::Message> &messages,
+                          vespalib::slime::Cursor &result);
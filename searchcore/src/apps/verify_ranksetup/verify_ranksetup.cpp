@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "verify_ranksetup.h"
+#include "rank_profile_benchmark.h"
 #include "config-verify-ranksetup.h"
 #include <vespa/config-attributes.h>
 #include <vespa/config-indexschema.h>
@@ -26,6 +27,7 @@
 #include <vespa/searchvisitor/rankmanager.h>
 #include <vespa/vsm/config/config-vsmfields.h>
 #include <vespa/config/subscription/configsubscriber.hpp>
+#include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <optional>
@@ -105,6 +107,8 @@ class VerifyRankSetup
 private:
     std::vector<search::fef::Message> _messages;
     SearchMode _searchMode;
+    const RankProfileBenchmarkParams *_benchParams;
+    vespalib::Slime *_benchResult;
 
     bool verifyIndexEnv(const search::fef::IIndexEnvironment &indexEnv);
 
@@ -119,6 +123,7 @@ private:
 
 public:
     explicit VerifyRankSetup(SearchMode mode);
+    VerifyRankSetup(const RankProfileBenchmarkParams &benchParams, vespalib::Slime &benchResult);
     ~VerifyRankSetup();
     [[nodiscard]] const std::vector<search::fef::Message> & getMessages() const { return _messages; }
     bool verify(const std::string & configId);
@@ -166,7 +171,16 @@ DummyRankingAssetsRepo::getConstant(const std::string &name) const {
 
 VerifyRankSetup::VerifyRankSetup(SearchMode mode)
     : _messages(),
-      _searchMode(mode)
+      _searchMode(mode),
+      _benchParams(nullptr),
+      _benchResult(nullptr)
+{ }
+
+VerifyRankSetup::VerifyRankSetup(const RankProfileBenchmarkParams &benchParams, vespalib::Slime &benchResult)
+    : _messages(),
+      _searchMode(SearchMode::INDEXED),
+      _benchParams(&benchParams),
+      _benchResult(&benchResult)
 { }
 
 VerifyRankSetup::~VerifyRankSetup() = default;
@@ -236,7 +250,12 @@ VerifyRankSetup::verifyConfig(const VerifyRanksetupConfig &myCfg,
                       return std::make_unique<proton::matching::IndexEnvironment>(0, schema, properties, *repo);
                   };
     }
+    bool found = false;
     for(const auto & profile : rankCfg.rankprofile) {
+        if (_benchParams != nullptr && profile.name != _benchParams->rank_profile) {
+            continue;
+        }
+        found = true;
         search::fef::Properties properties;
         for(const auto & j : profile.fef.property) {
             properties.add(j.name, j.value);
@@ -245,12 +264,21 @@ VerifyRankSetup::verifyConfig(const VerifyRanksetupConfig &myCfg,
         if (verifyIndexEnv(*indexEnvP)) {
             _messages.emplace_back(search::fef::Level::INFO,
                                    fmt("rank profile '%s': pass", profile.name.c_str()));
+            if (_benchParams != nullptr) {
+                ok = benchmarkRankProfile(*_benchParams, schema, attributeCfg, properties, *repo,
+                                          _messages, _benchResult->setObject()) && ok;
+            }
         } else {
             _messages.emplace_back(search::fef::Level::ERROR,
                                    fmt("rank profile '%s': FAIL", profile.name.c_str()));
             ok = false;
         }
     }
+    if (_benchParams != nullptr && !found) {
+        _messages.emplace_back(search::fef::Level::ERROR,
+                               fmt("rank profile '%s' not found", _benchParams->rank_profile.c_str()));
+        ok = false;
+    }
     return ok;
 }
 
@@ -304,3 +332,11 @@ verifyRankSetup(const char * configId, SearchMode mode) {
 
     return {ok, verifier.getMessages()};
 }
+
+std::pair<bool, std::vector<search::fef::Message>>
+benchmarkRankSetup(const char * configId, const RankProfileBenchmarkParams & params, vespalib::Slime & result) {
+    VerifyRankSetup verifier{params, result};
+    bool ok = verifier.verify(configId);
+
+    return {ok, verifier.getMessages()};
+}
@@ -4,6 +4,17 @@
 
 #include <vespa/searchlib/fef/verify_feature.h>
 
+namespace vespalib { class Slime; }
+struct RankProfileBenchmarkParams;
+
 enum class SearchMode { INDEXED, STREAMING };
 
 std::pair<bool, std::vector<search::fef::Message>> verifyRankSetup(const char * configId, SearchMode mode);
+
+/**
+ * Verifies the given rank profile and benchmarks its evaluation on the
+ * documents in the input file, storing the result in the given slime.
+ **/
+std::pair<bool, std::vector<search::fef::Message>> benchmarkRankSetup(const char * configId,
+                                                                      const RankProfileBenchmarkParams & params,
+                                                                      vespalib::Slime & result);
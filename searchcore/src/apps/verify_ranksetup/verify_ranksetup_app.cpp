@@ -1,8 +1,14 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "verify_ranksetup.h"
+#include "rank_profile_benchmark.h"
+#include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/util/signalhandler.h>
+#include <atomic>
+#include <cstdlib>
 #include <cstring>
+#include <iostream>
+#include <new>
 
 #include <vespa/log/log.h>
 LOG_SETUP("vespa-verify-ranksetup");
@@ -17,11 +23,18 @@ public:
 int
 App::usage()
 {
-    fprintf(stderr, "Usage: vespa-verify-ranksetup <config-id>\n");
+    fprintf(stderr, "Usage: vespa-verify-ranksetup <config-id> [-S]\n");
+    fprintf(stderr, "       vespa-verify-ranksetup <config-id> -B <rank-profile> <input-file> [repeat]\n");
+    fprintf(stderr, "  -S: verify for streaming search\n");
+    fprintf(stderr, "  -B: benchmark the given rank profile on the documents in the input file,\n");
+    fprintf(stderr, "      printing timings and allocation counts per document as json on stdout\n");
     return 1;
 }
 
 namespace {
+
+std::atomic<uint64_t> num_allocs(0);
+
 ns_log::Logger::LogLevel
 toLogLevel(search::fef::Level level) {
     switch (level) {
@@ -36,9 +49,47 @@ toLogLevel(search::fef::Level level) {
 }
 }
 
+// Counts all allocations done by this program, reported per document when benchmarking
+void *
+operator new(size_t size)
+{
+    num_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
 int
 App::main(int argc, char **argv)
 {
+    if (argc >= 4 && (strcmp("-B", argv[2]) == 0)) {
+        if (argc > 6) {
+            return usage();
+        }
+        RankProfileBenchmarkParams params;
+        params.rank_profile = argv[3];
+        params.input_file = (argc > 4) ? argv[4] : "";
+        if (argc > 5) {
+            params.repeat = strtoul(argv[5], nullptr, 10);
+        }
+        if (params.input_file.empty() || params.repeat == 0) {
+            return usage();
+        }
+        params.alloc_count = []() noexcept { return num_allocs.load(std::memory_order_relaxed); };
+        vespalib::Slime result;
+        auto [ok, messages] = benchmarkRankSetup(argv[1], params, result);
+        for (const auto & msg : messages) {
+            VLOG(toLogLevel(msg.first), "%s", msg.second.c_str());
+        }
+        if (ok) {
+            std::cout << result.toString() << std::endl;
+        }
+        return ok ? 0 : 1;
+    }
     SearchMode mode = SearchMode::INDEXED;
     if (argc == 3 && (strcmp("-S", argv[2]) == 0)) {
         mode = SearchMode::STREAMING;
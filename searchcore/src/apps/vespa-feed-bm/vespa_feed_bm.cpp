@@ -1,5 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
+#include <vespa/config/helper/configgetter.hpp>
+#include <vespa/document/config/config-documenttypes.h>
 #include <vespa/document/config/documenttypes_config_fwd.h>
 #include <vespa/document/repo/configbuilder.h>
 #include <vespa/document/repo/document_type_repo_factory.h>
@@ -16,7 +18,10 @@
 #include <vespa/searchcore/bmcluster/bm_node.h>
 #include <vespa/searchcore/bmcluster/bm_node_stats.h>
 #include <vespa/searchcore/bmcluster/bm_node_stats_reporter.h>
+#include <vespa/searchcore/bmcluster/bm_query_driver.h>
+#include <vespa/searchcore/bmcluster/bm_query_params.h>
 #include <vespa/searchcore/bmcluster/bm_range.h>
+#include <vespa/searchcore/bmcluster/bm_tls_replayer.h>
 #include <vespa/searchcore/bmcluster/bucket_selector.h>
 #include <vespa/searchcore/bmcluster/spi_bm_feed_handler.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
@@ -24,6 +29,7 @@
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <getopt.h>
+#include <cinttypes>
 #include <filesystem>
 #include <iostream>
 
@@ -45,7 +51,10 @@ using search::bmcluster::BmFeedParams;
 using search::bmcluster::BmFeeder;
 using search::bmcluster::BmNode;
 using search::bmcluster::BmNodeStatsReporter;
+using search::bmcluster::BmQueryDriver;
+using search::bmcluster::BmQueryParams;
 using search::bmcluster::BmRange;
+using search::bmcluster::BmTlsReplayer;
 using search::bmcluster::BucketSelector;
 using search::index::DummyFileHeaderContext;
 
@@ -53,6 +62,7 @@ namespace {
 
 std::string base_dir = "testdb";
 constexpr int base_port = 9017;
+constexpr int replay_tls_port = 9016;
 
 std::shared_ptr<DocumenttypesConfig> make_document_types() {
     using Struct = document::config_builder::Struct;
@@ -62,31 +72,50 @@ std::shared_ptr<DocumenttypesConfig> make_document_types() {
     return std::make_shared<DocumenttypesConfig>(builder.config());
 }
 
+std::shared_ptr<DocumenttypesConfig> load_document_types(const std::string& config_dir) {
+    return config::ConfigGetter<DocumenttypesConfig>::getConfig("", config::DirSpec(config_dir));
+}
+
 class BMParams : public BmClusterParams,
-                 public BmFeedParams
+                 public BmFeedParams,
+                 public BmQueryParams
 {
     uint32_t _get_passes;
     uint32_t _put_passes;
     uint32_t _update_passes;
     uint32_t _remove_passes;
+    std::string _replay_domain;
+    double   _replay_rate_scale;
+    std::string _replay_tls_dir;
 public:
     BMParams()
         : BmClusterParams(),
           BmFeedParams(),
+          BmQueryParams(),
           _get_passes(0),
           _put_passes(2),
           _update_passes(1),
-          _remove_passes(2)
+          _remove_passes(2),
+          _replay_domain(),
+          _replay_rate_scale(1.0),
+          _replay_tls_dir()
     {
     }
     uint32_t get_get_passes() const { return _get_passes; }
     uint32_t get_put_passes() const { return _put_passes; }
     uint32_t get_update_passes() const { return _update_passes; }
     uint32_t get_remove_passes() const { return _remove_passes; }
+    const std::string& get_replay_domain() const { return _replay_domain; }
+    double get_replay_rate_scale() const { return _replay_rate_scale; }
+    const std::string& get_replay_tls_dir() const { return _replay_tls_dir; }
+    bool needs_replay() const { return !_replay_tls_dir.empty(); }
     void set_get_passes(uint32_t get_passes_in) { _get_passes = get_passes_in; }
     void set_put_passes(uint32_t put_passes_in) { _put_passes = put_passes_in; }
     void set_update_passes(uint32_t update_passes_in) { _update_passes = update_passes_in; }
     void set_remove_passes(uint32_t remove_passes_in) { _remove_passes = remove_passes_in; }
+    void set_replay_domain(const std::string& domain_in) { _replay_domain = domain_in; }
+    void set_replay_rate_scale(double rate_scale_in) { _replay_rate_scale = rate_scale_in; }
+    void set_replay_tls_dir(const std::string& tls_dir_in) { _replay_tls_dir = tls_dir_in; }
     bool check() const;
 };
 
@@ -99,6 +128,9 @@ BMParams::check() const
     if (!BmFeedParams::check()) {
         return false;
     }
+    if (!BmQueryParams::check()) {
+        return false;
+    }
     if (_put_passes < 1) {
         std::cerr << "Put passes too low: " << _put_passes << std::endl;
         return false;
@@ -107,6 +139,23 @@ BMParams::check() const
         std::cerr << "grouped distribution only allowed when using distributor" << std::endl;
         return false;
     }
+    if (needs_replay()) {
+        if (_replay_domain.empty()) {
+            std::cerr << "Replay domain must be specified when replaying a transaction log" << std::endl;
+            return false;
+        }
+        if (_replay_rate_scale < 0.0) {
+            std::cerr << "Replay rate scale too low: " << _replay_rate_scale << std::endl;
+            return false;
+        }
+        if (needs_queries()) {
+            std::cerr << "queries not supported when replaying a transaction log" << std::endl;
+            return false;
+        }
+    } else if (get_document_type() != "test" || !get_document_db_config_dir().empty()) {
+        std::cerr << "synthetic feed requires the built-in 'test' document type" << std::endl;
+        return false;
+    }
 
     return true;
 }
@@ -119,8 +168,11 @@ class Benchmark {
     std::shared_ptr<const DocumentTypeRepo>    _repo;
     std::unique_ptr<BmCluster>                 _cluster;
     BmFeed                                     _feed;
+    std::unique_ptr<BmQueryDriver>             _query_driver;
 
     void benchmark_feed(BmFeeder& feeder, int64_t& time_bias, const std::vector<vespalib::nbostream>& serialized_feed, uint32_t passes, const std::string &op_name);
+    void run_synthetic_feed(BmFeeder& feeder, vespalib::ThreadStackExecutor& executor, BmNodeStatsReporter& reporter, int64_t& time_bias);
+    void run_replay(BmFeeder& feeder, vespalib::ThreadStackExecutor& executor, BmNodeStatsReporter& reporter, int64_t& time_bias);
 public:
     explicit Benchmark(const BMParams& params);
     ~Benchmark();
@@ -129,10 +181,11 @@ public:
 
 Benchmark::Benchmark(const BMParams& params)
     : _params(params),
-      _document_types(make_document_types()),
+      _document_types(_params.get_document_db_config_dir().empty() ? make_document_types() : load_document_types(_params.get_document_db_config_dir())),
       _repo(document::DocumentTypeRepoFactory::make(*_document_types)),
       _cluster(std::make_unique<BmCluster>(base_dir, base_port, _params, _document_types, _repo)),
-      _feed(_repo)
+      _feed(_repo),
+      _query_driver()
 {
     _cluster->make_nodes();
 }
@@ -148,26 +201,32 @@ Benchmark::benchmark_feed(BmFeeder& feeder, int64_t& time_bias, const std::vecto
     AvgSampler sampler;
     LOG(info, "--------------------------------");
     LOG(info, "%sAsync: %u small documents, passes=%u", op_name.c_str(), _params.get_documents(), passes);
+    if (_query_driver) {
+        _query_driver->sample();
+    }
     for (uint32_t pass = 0; pass < passes; ++pass) {
         feeder.run_feed_tasks(pass, time_bias, serialized_feed, _params, sampler, op_name);
     }
     LOG(info, "%sAsync: AVG %s/s: %8.2f", op_name.c_str(), op_name.c_str(), sampler.avg());
+    if (_query_driver) {
+        auto queries = _query_driver->sample();
+        LOG(info, "%sAsync: queries/s: %8.2f, errors: %" PRIu64 ", latency ms p50=%.3f p90=%.3f p99=%.3f max=%.3f",
+            op_name.c_str(), queries.qps(), queries.errors, queries.p50_ms, queries.p90_ms, queries.p99_ms, queries.max_ms);
+    }
 }
 
 void
-Benchmark::run()
+Benchmark::run_synthetic_feed(BmFeeder& feeder, vespalib::ThreadStackExecutor& executor, BmNodeStatsReporter& reporter, int64_t& time_bias)
 {
-    _cluster->start(_feed);
-    vespalib::ThreadStackExecutor executor(_params.get_client_threads());
-    BmFeeder feeder(_repo, *_cluster->get_feed_handler(), executor);
     auto put_feed = _feed.make_feed(executor, _params, [this](BmRange range, BucketSelector bucket_selector) { return _feed.make_put_feed(range, bucket_selector); }, _feed.num_buckets(), "put");
     auto update_feed = _feed.make_feed(executor, _params, [this](BmRange range, BucketSelector bucket_selector) { return _feed.make_update_feed(range, bucket_selector); }, _feed.num_buckets(), "update");
     auto get_feed = _feed.make_feed(executor, _params, [this](BmRange range, BucketSelector bucket_selector) { return _feed.make_get_feed(range, bucket_selector); }, _feed.num_buckets(), "get");
     auto remove_feed = _feed.make_feed(executor, _params, [this](BmRange range, BucketSelector bucket_selector) { return _feed.make_remove_feed(range, bucket_selector); }, _feed.num_buckets(), "remove");
-    BmNodeStatsReporter reporter(*_cluster, false);
-    reporter.start(500ms);
-    int64_t time_bias = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch() - 24h).count();
-    LOG(info, "Feed handler is '%s'", feeder.get_feed_handler().get_name().c_str());
+    if (_params.needs_queries()) {
+        _query_driver = std::make_unique<BmQueryDriver>(*_cluster, _params, _params.get_documents());
+        _query_driver->start();
+        LOG(info, "Query driver started with %u threads", _params.get_query_threads());
+    }
     benchmark_feed(feeder, time_bias, put_feed, _params.get_put_passes(), "put");
     reporter.report_now();
     benchmark_feed(feeder, time_bias, update_feed, _params.get_update_passes(), "update");
@@ -176,6 +235,36 @@ Benchmark::run()
     reporter.report_now();
     benchmark_feed(feeder, time_bias, remove_feed, _params.get_remove_passes(), "remove");
     reporter.report_now();
+    _query_driver.reset();
+}
+
+void
+Benchmark::run_replay(BmFeeder& feeder, vespalib::ThreadStackExecutor& executor, BmNodeStatsReporter& reporter, int64_t& time_bias)
+{
+    BmTlsReplayer replayer(_repo, *_cluster, _feed, _params.get_client_threads());
+    if (!replayer.load(_params.get_replay_tls_dir(), _params.get_replay_domain(), replay_tls_port)) {
+        LOG(error, "Failed to load transaction log domain '%s'", _params.get_replay_domain().c_str());
+        return;
+    }
+    replayer.replay(feeder, executor, _params.get_replay_rate_scale(), time_bias);
+    reporter.report_now();
+}
+
+void
+Benchmark::run()
+{
+    _cluster->start(_feed);
+    vespalib::ThreadStackExecutor executor(_params.get_client_threads());
+    BmFeeder feeder(_repo, *_cluster->get_feed_handler(), executor);
+    BmNodeStatsReporter reporter(*_cluster, false);
+    reporter.start(500ms);
+    int64_t time_bias = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch() - 24h).count();
+    LOG(info, "Feed handler is '%s'", feeder.get_feed_handler().get_name().c_str());
+    if (_params.needs_replay()) {
+        run_replay(feeder, executor, reporter, time_bias);
+    } else {
+        run_synthetic_feed(feeder, executor, reporter, time_bias);
+    }
     reporter.stop();
     LOG(info, "--------------------------------");
 
@@ -212,6 +301,8 @@ App::usage()
         "[--bucket-db-stripe-bits bits]\n"
         "[--client-threads threads]\n"
         "[--distributor-stripes stripes]\n"
+        "[--document-db-config-dir dir]\n"
+        "[--document-type type]\n"
         "[--documents documents]\n"
         "[--enable-distributor]\n"
         "[--enable-service-layer]\n"
@@ -221,12 +312,20 @@ App::usage()
         "[--max-pending max-pending]\n"
         "[--nodes-per-group nodes-per-group]\n"
         "[--put-passes put-passes]\n"
+        "[--query-hits hits]\n"
+        "[--query-threads threads]\n"
+        "[--range-query-weight weight]\n"
+        "[--range-query-width width]\n"
         "[--remove-passes remove-passes]\n"
+        "[--replay-domain domain]\n"
+        "[--replay-rate-scale scale]\n"
+        "[--replay-tls-dir dir]\n"
         "[--response-threads threads]\n"
         "[--rpc-events-before-wakeup events]\n"
         "[--rpc-network-threads threads]\n"
         "[--rpc-targets-per-node targets]\n"
         "[--skip-get-spi-bucket-info]\n"
+        "[--term-query-weight weight]\n"
         "[--update-passes update-passes]\n"
         "[--use-async-message-handling]\n"
         "[--use-document-api]\n"
@@ -243,6 +342,8 @@ App::get_options(int argc, char **argv)
         { "bucket-db-stripe-bits", 1, nullptr, 0 },
         { "client-threads", 1, nullptr, 0 },
         { "distributor-stripes", 1, nullptr, 0 },
+        { "document-db-config-dir", 1, nullptr, 0 },
+        { "document-type", 1, nullptr, 0 },
         { "documents", 1, nullptr, 0 },
         { "enable-distributor", 0, nullptr, 0 },
         { "enable-service-layer", 0, nullptr, 0 },
@@ -252,12 +353,20 @@ App::get_options(int argc, char **argv)
         { "max-pending", 1, nullptr, 0 },
         { "nodes-per-group", 1, nullptr, 0 },
         { "put-passes", 1, nullptr, 0 },
+        { "query-hits", 1, nullptr, 0 },
+        { "query-threads", 1, nullptr, 0 },
+        { "range-query-weight", 1, nullptr, 0 },
+        { "range-query-width", 1, nullptr, 0 },
         { "remove-passes", 1, nullptr, 0 },
+        { "replay-domain", 1, nullptr, 0 },
+        { "replay-rate-scale", 1, nullptr, 0 },
+        { "replay-tls-dir", 1, nullptr, 0 },
         { "response-threads", 1, nullptr, 0 },
         { "rpc-events-before-wakeup", 1, nullptr, 0 },
         { "rpc-network-threads", 1, nullptr, 0 },
         { "rpc-targets-per-node", 1, nullptr, 0 },
         { "skip-get-spi-bucket-info", 0, nullptr, 0 },
+        { "term-query-weight", 1, nullptr, 0 },
         { "update-passes", 1, nullptr, 0 },
         { "use-async-message-handling", 0, nullptr, 0 },
         { "use-document-api", 0, nullptr, 0 },
@@ -269,6 +378,8 @@ App::get_options(int argc, char **argv)
         LONGOPT_BUCKET_DB_STRIPE_BITS,
         LONGOPT_CLIENT_THREADS,
         LONGOPT_DISTRIBUTOR_STRIPES,
+        LONGOPT_DOCUMENT_DB_CONFIG_DIR,
+        LONGOPT_DOCUMENT_TYPE,
         LONGOPT_DOCUMENTS,
         LONGOPT_ENABLE_DISTRIBUTOR,
         LONGOPT_ENABLE_SERVICE_LAYER,
@@ -278,12 +389,20 @@ App::get_options(int argc, char **argv)
         LONGOPT_MAX_PENDING,
         LONGOPT_NODES_PER_GROUP,
         LONGOPT_PUT_PASSES,
+        LONGOPT_QUERY_HITS,
+        LONGOPT_QUERY_THREADS,
+        LONGOPT_RANGE_QUERY_WEIGHT,
+        LONGOPT_RANGE_QUERY_WIDTH,
         LONGOPT_REMOVE_PASSES,
+        LONGOPT_REPLAY_DOMAIN,
+        LONGOPT_REPLAY_RATE_SCALE,
+        LONGOPT_REPLAY_TLS_DIR,
         LONGOPT_RESPONSE_THREADS,
         LONGOPT_RPC_EVENTS_BEFORE_WAKEUP,
         LONGOPT_RPC_NETWORK_THREADS,
         LONGOPT_RPC_TARGETS_PER_NODE,
         LONGOPT_SKIP_GET_SPI_BUCKET_INFO,
+        LONGOPT_TERM_QUERY_WEIGHT,
         LONGOPT_UPDATE_PASSES,
         LONGOPT_USE_ASYNC_MESSAGE_HANDLING,
         LONGOPT_USE_DOCUMENT_API,
@@ -304,6 +423,12 @@ App::get_options(int argc, char **argv)
             case LONGOPT_DISTRIBUTOR_STRIPES:
                 _bm_params.set_distributor_stripes(atoi(optarg));
                 break;
+            case LONGOPT_DOCUMENT_DB_CONFIG_DIR:
+                _bm_params.set_document_db_config_dir(optarg);
+                break;
+            case LONGOPT_DOCUMENT_TYPE:
+                _bm_params.set_document_type(optarg);
+                break;
             case LONGOPT_DOCUMENTS:
                 _bm_params.set_documents(atoi(optarg));
                 break;
@@ -331,12 +456,33 @@ App::get_options(int argc, char **argv)
             case LONGOPT_PUT_PASSES:
                 _bm_params.set_put_passes(atoi(optarg));
                 break;
+            case LONGOPT_QUERY_HITS:
+                _bm_params.set_query_hits(atoi(optarg));
+                break;
+            case LONGOPT_QUERY_THREADS:
+                _bm_params.set_query_threads(atoi(optarg));
+                break;
+            case LONGOPT_RANGE_QUERY_WEIGHT:
+                _bm_params.set_range_query_weight(atoi(optarg));
+                break;
+            case LONGOPT_RANGE_QUERY_WIDTH:
+                _bm_params.set_range_query_width(atoi(optarg));
+                break;
             case LONGOPT_UPDATE_PASSES:
                 _bm_params.set_update_passes(atoi(optarg));
                 break;
             case LONGOPT_REMOVE_PASSES:
                 _bm_params.set_remove_passes(atoi(optarg));
                 break;
+            case LONGOPT_REPLAY_DOMAIN:
+                _bm_params.set_replay_domain(optarg);
+                break;
+            case LONGOPT_REPLAY_RATE_SCALE:
+                _bm_params.set_replay_rate_scale(atof(optarg));
+                break;
+            case LONGOPT_REPLAY_TLS_DIR:
+                _bm_params.set_replay_tls_dir(optarg);
+                break;
             case LONGOPT_RESPONSE_THREADS:
                 _bm_params.set_response_threads(atoi(optarg));
                 break;
@@ -352,6 +498,9 @@ App::get_options(int argc, char **argv)
             case LONGOPT_SKIP_GET_SPI_BUCKET_INFO:
                 _bm_params.set_skip_get_spi_bucket_info(true);
                 break;
+            case LONGOPT_TERM_QUERY_WEIGHT:
+                _bm_params.set_term_query_weight(atoi(optarg));
+                break;
             case LONGOPT_USE_ASYNC_MESSAGE_HANDLING:
                 _bm_params.set_use_async_message_handling_on_schedule(true);
                 break;
@@ -203,4 +203,35 @@ TEST_F(AttributesStateExplorerTest, require_that_bool_attibute_shows_bitvector)
     EXPECT_EQ(1, slime[bitvector]["size"].asLong());
 }
 
+TEST_F(AttributesStateExplorerTest, require_that_attribute_shows_memory_advice)
+{
+    auto slime = explore_attribute("hybrid");
+    auto& advice = slime.get()["memory_advice"];
+    EXPECT_LT(0, advice["allocated_bytes"].asLong());
+    EXPECT_FALSE(advice["access"]["sampled"].asBool());
+    EXPECT_FALSE(advice["address_space"]["component"].asString().make_string().empty());
+    StringVector options;
+    for (size_t i = 0; i < advice["options"].entries(); ++i) {
+        auto& option = advice["options"][i];
+        auto name = option["name"].asString().make_string();
+        EXPECT_LT(0, option["estimated_savings"].asLong());
+        if (name != "compaction") {
+            options.emplace_back(name);
+        }
+    }
+    EXPECT_EQ(StringVector({"paged", "btree_dictionary", "hash_dictionary"}), options);
+}
+
+TEST_F(AttributesStateExplorerTest, require_that_attribute_manager_shows_memory_advice_summary)
+{
+    Slime result;
+    vespalib::slime::SlimeInserter inserter(result);
+    _explorer.get_state(inserter, true);
+    auto& advice = result.get()["memory_advice"];
+    EXPECT_EQ(5u, advice.fields());
+    EXPECT_LT(0, advice["regular"]["allocated_bytes"].asLong());
+    EXPECT_EQ("paged", advice["regular"]["best_option"].asString().make_string());
+    EXPECT_LT(0, result.get()["total_estimated_savings"].asLong());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
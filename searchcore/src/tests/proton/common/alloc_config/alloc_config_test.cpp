@@ -18,8 +18,8 @@ GrowStrategy make_grow_strategy(uint32_t initial_docs) {
     return GrowStrategy(initial_docs, 0.1, 1, initial_docs, 0.15);
 }
 
-AllocStrategy make_alloc_strategy(uint32_t initial_docs) {
-    return AllocStrategy(make_grow_strategy(initial_docs), baseline_compaction_strategy, 10000);
+AllocStrategy make_alloc_strategy(uint32_t initial_docs, bool gid_hash_index = false) {
+    return AllocStrategy(make_grow_strategy(initial_docs), baseline_compaction_strategy, 10000, gid_hash_index);
 }
 
 };
@@ -32,4 +32,13 @@ TEST(AllocConfigTest, can_make_allocation_strategy_for_sub_dbs)
     EXPECT_EQ(make_alloc_strategy(30000000), config.make_alloc_strategy(SubDbType::NOTREADY));
 }
 
+TEST(AllocConfigTest, gid_hash_index_is_propagated_to_sub_dbs)
+{
+    AllocConfig config(make_alloc_strategy(10000000, true), 5, 2);
+    EXPECT_TRUE(config.make_alloc_strategy(SubDbType::READY).get_gid_hash_index());
+    EXPECT_TRUE(config.make_alloc_strategy(SubDbType::NOTREADY).get_gid_hash_index());
+    EXPECT_NE(make_alloc_strategy(20000000), config.make_alloc_strategy(SubDbType::READY));
+    EXPECT_EQ(make_alloc_strategy(20000000, true), config.make_alloc_strategy(SubDbType::READY));
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -475,6 +475,22 @@ TensorFixture<SerializedFastValueAttribute> f("tensor(x{})", "sparse_tensor");
     f.assertTensor(TensorSpec(f.type).add({{"x", "a"}}, 3));
 }
 
+TEST(AttributeUpdaterTest, require_that_tensor_modify_update_of_mixed_tensor_leaves_old_value_intact_for_readers)
+{
+    TensorFixture<SerializedFastValueAttribute> f("tensor(x{},y[2])", "sparse_tensor");
+    auto old_spec = TensorSpec(f.type).add({{"x", "a"}, {"y", 0}}, 1).add({{"x", "a"}, {"y", 1}}, 2)
+                                      .add({{"x", "b"}, {"y", 0}}, 3).add({{"x", "b"}, {"y", 1}}, 4);
+    f.setTensor(old_spec);
+    auto guard = f.attribute->getGenerationHandler().takeGuard();
+    auto old_tensor = f.attribute->getTensor(1);
+    f.applyValueUpdate(*f.attribute, 1,
+                       std::make_unique<TensorModifyUpdate>(TensorModifyUpdate::Operation::ADD,
+                                          makeTensorFieldValue(TensorSpec("tensor(x{},y{})").add({{"x", "b"}, {"y", "1"}}, 10))));
+    f.assertTensor(TensorSpec(f.type).add({{"x", "a"}, {"y", 0}}, 1).add({{"x", "a"}, {"y", 1}}, 2)
+                                     .add({{"x", "b"}, {"y", 0}}, 3).add({{"x", "b"}, {"y", 1}}, 14));
+    EXPECT_EQ(old_spec, spec_from_value(*old_tensor));
+}
+
 TEST(AttributeUpdaterTest, require_that_tensor_add_update_to_non_existing_tensor_creates_empty_tensor_first)
 {
 TensorFixture<SerializedFastValueAttribute> f("tensor(x{})", "sparse_tensor");
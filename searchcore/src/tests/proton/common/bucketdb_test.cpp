@@ -186,7 +186,44 @@ TEST(BucketDBTest, require_that_bucket_checksum_is_a_combination_of_sub_db_types
 
 TEST(BucketDBTest, require_that_BucketState_follows_checksum_type)
 {
-    EXPECT_EQ(48u, sizeof(BucketState));
+    EXPECT_EQ(64u, sizeof(BucketState));
+}
+
+TEST(BucketDBTest, require_that_sub_db_part_of_bucket_state_can_be_extracted)
+{
+    GlobalId gid1("aaaaaaaaaaaa");
+    GlobalId gid2("bbbbbbbbbbbb");
+    GlobalId gid3("cccccccccccc");
+    BucketState state;
+    state.add(gid1, TIME_1, DOCSIZE_1, SDT::READY);
+    state.add(gid2, TIME_2, DOCSIZE_2, SDT::NOTREADY);
+    state.add(gid3, TIME_3, DOCSIZE_1, SDT::REMOVED);
+    state.setActive(true);
+    BucketState ready;
+    ready.add(gid1, TIME_1, DOCSIZE_1, SDT::READY);
+    BucketState notReady;
+    notReady.add(gid2, TIME_2, DOCSIZE_2, SDT::NOTREADY);
+
+    BucketState readyPart = state.subDbState(SDT::READY);
+    assertDocCount("ready part", 1, 0, 0, readyPart);
+    assertDocSizes("ready part", DOCSIZE_1, 0, 0, readyPart);
+    EXPECT_EQ(ready.getChecksum(), readyPart.getChecksum());
+    EXPECT_FALSE(readyPart.isActive());
+
+    BucketState notReadyPart = state.subDbState(SDT::NOTREADY);
+    assertDocCount("not ready part", 0, 1, 0, notReadyPart);
+    assertDocSizes("not ready part", 0, DOCSIZE_2, 0, notReadyPart);
+    EXPECT_EQ(notReady.getChecksum(), notReadyPart.getChecksum());
+
+    BucketState removedPart = state.subDbState(SDT::REMOVED);
+    assertDocCount("removed part", 0, 0, 1, removedPart);
+    EXPECT_EQ(BucketChecksum(0), removedPart.getChecksum());
+
+    state -= readyPart;
+    EXPECT_EQ(notReady.getChecksum(), state.getChecksum());
+    state -= notReadyPart;
+    state -= removedPart;
+    EXPECT_TRUE(state.empty());
 }
 
 TEST(BucketDBTest, require_that_bucket_is_ready_when_not_having_docs_in_notready_sub_db)
@@ -15,6 +15,7 @@
 #include <vespa/eval/eval/simple_value.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/searchcore/proton/common/cachedselect.h>
+#include <vespa/searchcore/proton/common/compiled_select.h>
 #include <vespa/searchcore/proton/common/selectcontext.h>
 #include <vespa/searchlib/attribute/attributecontext.h>
 #include <vespa/searchlib/attribute/attributefactory.h>
@@ -51,6 +52,7 @@ using document::select::Node;
 using document::select::Result;
 using document::select::ResultSet;
 using proton::CachedSelect;
+using proton::CompiledSelect;
 using proton::SelectContext;
 using search::AttributeContext;
 using search::AttributeFactory;
@@ -215,11 +217,12 @@ public:
     }
     ~MyIntAv() override;
 
-    virtual uint32_t
-    get(AttributeVector::DocId doc, largeint_t *v, uint32_t sz) const override
+    // Both the selection tree and compiled selections read values through getInt()
+    largeint_t
+    getInt(AttributeVector::DocId doc) const override
     {
         ++_gets;
-        return SvIntAttr::get(doc, v, sz);
+        return SvIntAttr::getInt(doc);
     }
 
     uint32_t
@@ -791,6 +794,53 @@ TEST(CachedSelectTest, Test_performance_when_using_attributes)
     
 }
 
+TEST(CachedSelectTest, Compiled_pre_doc_selection_gives_same_result_as_selection_tree)
+{
+    TestFixture f;
+    MyDB &db(*f._db);
+
+    db.addDoc(1u, "id:ns:test::1", "hello", "null", 45, 37);
+    db.addDoc(2u, "id:ns:test::2", "gotcha", "foo", 3, 25);
+    db.addDoc(3u, "id:ns:test::3", "gotcha", "foo", noIntVal, noIntVal);
+    db.addDoc(4u, "id:ns:test::4", "null", "foo", noIntVal, noIntVal);
+
+    for (const std::string selection : {"test.aa < 45", "test.aa == 3", "test.aa != 3", "45 > test.aa",
+                                        "test.aa >= 3 and not test.aa == 45", "test.aa <= 3 or test.aa > 44",
+                                        "test.aa == null", "test.aa != null", "null == test.aa", "test.aa < null",
+                                        "test.aa < 3.5", "test.aa > 40 + 4", "test.aa < now()", "true and test.aa == 45"})
+    {
+        SCOPED_TRACE(selection);
+        CachedSelect::SP cs = f.testParse(selection, "test");
+        ASSERT_TRUE(cs->preDocOnlySelect());
+        auto compiled = CompiledSelect::compile(*cs->preDocOnlySelect(), cs->attributes());
+        ASSERT_TRUE(compiled);
+        EXPECT_TRUE(cs->createSession()->has_compiled_pre_doc_select());
+        SelectContext ctx(*cs);
+        ctx.getAttributeGuards();
+        for (uint32_t docId = 1; docId <= 4; ++docId) {
+            SCOPED_TRACE("docId=" + std::to_string(docId));
+            ctx._docId = docId;
+            EXPECT_TRUE(cs->preDocOnlySelect()->contains(ctx) == compiled->contains(ctx));
+        }
+    }
+}
+
+TEST(CachedSelectTest, Selection_with_arithmetic_on_attribute_is_not_compiled)
+{
+    TestFixture f;
+    MyDB &db(*f._db);
+
+    db.addDoc(1u, "id:ns:test::1", "hello", "null", 45, 37);
+    db.addDoc(2u, "id:ns:test::2", "gotcha", "foo", 3, 25);
+
+    CachedSelect::SP cs = f.testParse("test.aa + 1 == 4", "test");
+    assertEquals(Stats().preDocOnlySelect().fieldNodes(1).attrFieldNodes(1).svAttrFieldNodes(1), *cs);
+    EXPECT_FALSE(CompiledSelect::compile(*cs->preDocOnlySelect(), cs->attributes()));
+    EXPECT_FALSE(cs->createSession()->has_compiled_pre_doc_select());
+    checkSelect(cs, 1u, Result::False);
+    checkSelect(cs, 2u, Result::True);
+}
+
 TEST(CachedSelectTest, can_check_for_pre_doc_only_attribute_tensor_presence_in_selections)
 {
     TestFixture f;
@@ -286,14 +286,22 @@ TEST(FeedOperationTest, require_that_we_can_serialize_and_deserialize_put_operat
         op.setDbDocumentId({1, 2});
         op.setPrevDbDocumentId({3, 4});
         EXPECT_EQ(0u, op.getSerializedDocSize());
+        EXPECT_FALSE(op.getSerializedDocument());
         op.serialize(stream);
         EXPECT_EQ(expSerializedDocSize, op.getSerializedDocSize());
+        ASSERT_TRUE(op.getSerializedDocument());
+        EXPECT_EQ(expSerializedDocSize, op.getSerializedDocument()->size());
     }
     {
         PutOperation op;
         op.deserialize(stream, *f._repo);
         EXPECT_EQ(*doc, *op.getDocument());
         assertDocumentOperation(op, bucket, expSerializedDocSize);
+        ASSERT_TRUE(op.getSerializedDocument());
+        vespalib::nbostream docStream(op.getSerializedDocument()->peek(), op.getSerializedDocument()->size());
+        EXPECT_EQ(*doc, Document(*f._repo, docStream));
+        op.deserializeDocument(*f._repo);
+        EXPECT_FALSE(op.getSerializedDocument());
     }
 }
 
@@ -0,0 +1,56 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/common/pendinglidtracker.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/test/nexus.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+
+using namespace proton;
+using vespalib::BenchmarkTimer;
+using vespalib::test::Nexus;
+
+namespace {
+
+constexpr size_t num_ops_per_thread = 100000;
+
+/*
+ * Each feed thread produces a token for its own lid, checks the state of the
+ * lid (as done by get after put) and consumes the token again.
+ */
+void
+feed_and_check(PendingLidTracker & tracker, uint32_t base_lid, size_t num_ops)
+{
+    for (size_t i = 0; i < num_ops; ++i) {
+        uint32_t lid = base_lid + (i % 64) * 101;
+        auto token = tracker.produce(lid);
+        (void) tracker.getState(lid);
+    }
+}
+
+double
+measure_ops_per_second(size_t num_threads)
+{
+    PendingLidTracker tracker;
+    BenchmarkTimer timer(1.0);
+    while (timer.has_budget()) {
+        timer.before();
+        auto task = [&](Nexus & ctx) {
+            feed_and_check(tracker, 1 + ctx.thread_id(), num_ops_per_thread);
+        };
+        Nexus::run(num_threads, task);
+        timer.after();
+    }
+    return (num_threads * num_ops_per_thread) / timer.min_time();
+}
+
+}
+
+TEST(PendingLidTrackerBench, produce_check_and_consume_with_concurrent_feed_threads)
+{
+    for (size_t num_threads : {1, 2, 4, 8, 16}) {
+        double ops_per_second = measure_ops_per_second(num_threads);
+        fprintf(stderr, "threads=%zu: %g ops/s\n", num_threads, ops_per_second);
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
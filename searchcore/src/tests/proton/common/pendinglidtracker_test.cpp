@@ -2,6 +2,7 @@
 
 #include <vespa/searchcore/proton/common/pendinglidtracker.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <thread>
 
 using namespace proton;
 
@@ -74,3 +75,23 @@ TEST(PendingLidTrackerTest, test_pendinglidtracker_for_needcommit)
     EXPECT_EQ(ILidCommitState::State::COMPLETED, tracker.getState(LID_1));
     EXPECT_EQ(ILidCommitState::State::COMPLETED, tracker.getState(LIDV_2_1_3));
 }
+
+TEST(PendingLidTrackerTest, wait_complete_for_lids_in_multiple_shards)
+{
+    PendingLidTracker tracker;
+    std::vector<uint32_t> lids({1u, 2u, 17u, 33u, 1000u});
+    auto token1 = std::make_unique<IPendingLidTracker::Token>(tracker.produce(1u));
+    auto token17 = std::make_unique<IPendingLidTracker::Token>(tracker.produce(17u));
+    auto token1000 = std::make_unique<IPendingLidTracker::Token>(tracker.produce(1000u));
+    EXPECT_EQ(ILidCommitState::State::WAITING, tracker.getState(lids));
+    EXPECT_EQ(ILidCommitState::State::WAITING, tracker.getState(17u));
+    EXPECT_EQ(ILidCommitState::State::COMPLETED, tracker.getState(33u));
+    std::thread consumer([&]() {
+        token1.reset();
+        token17.reset();
+        token1000.reset();
+    });
+    tracker.waitComplete(lids);
+    EXPECT_EQ(ILidCommitState::State::COMPLETED, tracker.getState(lids));
+    consumer.join();
+}
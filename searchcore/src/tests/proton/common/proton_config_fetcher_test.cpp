@@ -493,6 +493,24 @@ TEST(ProtonConfigFetcherTest, require_that_docstore_config_computes_cachesize_au
     EXPECT_EQ(500000ul, config->getStoreConfig().getMaxCacheBytes());
 }
 
+TEST(ProtonConfigFetcherTest, require_that_rendered_docsum_cache_size_is_derived)
+{
+    ConfigTestFixture f1("test");
+    DocumentDBConfigManager f2(f1.configId + "/test", "test");
+    HwInfo hwInfo = createHwInfoWithMemory(1000000);
+    f1.addDocType("test");
+    auto config = getDocumentDBConfig(f1, f2, hwInfo);
+    EXPECT_EQ(0ul, config->getStoreConfig().getMaxRenderedCacheBytes());
+
+    f1.protonBuilder.summary.cache.rendered.maxbytes = 3000;
+    config = getDocumentDBConfig(f1, f2, hwInfo);
+    EXPECT_EQ(3000ul, config->getStoreConfig().getMaxRenderedCacheBytes());
+
+    f1.protonBuilder.summary.cache.rendered.maxbytes = -2;
+    config = getDocumentDBConfig(f1, f2, hwInfo);
+    EXPECT_EQ(20000ul, config->getStoreConfig().getMaxRenderedCacheBytes());
+}
+
 namespace {
 
 GrowStrategy
@@ -70,7 +70,9 @@
 #include <vespa/vespalib/geo/zcurve.h>
 #include <vespa/vespalib/test/test_path.h>
 #include <vespa/vespalib/util/destructor_callbacks.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/config-summary.h>
 #include <filesystem>
 #include <regex>
@@ -561,10 +563,33 @@ TEST(DocSummaryTest, requireThatDocsumRequestIsProcessed)
     req.hits.emplace_back(gid2);
     req.hits.emplace_back(gid4);
     req.hits.emplace_back(gid9);
-    DocsumReply::UP rep = dc._ddb->getDocsums(req);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, vespalib::ThreadBundle::trivial());
     EXPECT_TRUE(assertSlime("{docsums:[ {docsum:{a:20}}, {docsum:{a:40}}, {} ]}", *rep));
 }
 
+TEST(DocSummaryTest, requireThatDocsumsCanBeGeneratedInParallel)
+{
+    BuildContext bc([](auto& header) { header.addField("a", DataType::T_INT); });
+    DBContext dc(bc.get_repo_sp(), getDocTypeName());
+    DocsumRequest req;
+    req.resultClassName = "class1";
+    std::string expected("{docsums:[");
+    for (uint32_t lid = 1; lid <= 40; ++lid) {
+        auto id = vespalib::make_string("id:ns:searchdocument::%u", lid);
+        auto doc = bc.make_document(id);
+        doc->setValue("a", IntFieldValue(lid * 10));
+        dc.put(*doc, lid);
+        req.hits.emplace_back(DocumentId(id).getGlobalId());
+        expected += vespalib::make_string("{docsum:{a:%u}},", lid * 10);
+    }
+    req.hits.emplace_back(DocumentId("id:ns:searchdocument::100").getGlobalId());
+    expected += "{}]}";
+    vespalib::SimpleThreadBundle threadBundle(4);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, threadBundle);
+    EXPECT_TRUE(assertSlime(expected, *rep));
+    EXPECT_EQ(41u, rep->root()["docsums"].entries());
+}
+
 TEST(DocSummaryTest, requireThatRewritersAreUsed)
 {
     BuildContext bc([](auto& header)
@@ -579,7 +604,7 @@ TEST(DocSummaryTest, requireThatRewritersAreUsed)
     DocsumRequest req;
     req.resultClassName = "class2";
     req.hits.emplace_back(gid1);
-    DocsumReply::UP rep = dc._ddb->getDocsums(req);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, vespalib::ThreadBundle::trivial());
     EXPECT_TRUE(assertSlime("{docsums:[ {docsum:{aa:20}} ]}", *rep));
 }
 
@@ -599,7 +624,7 @@ TEST(DocSummaryTest, requireThatSummariesTimeout)
     EXPECT_TRUE(req.expired());
     req.resultClassName = "class2";
     req.hits.emplace_back(gid1);
-    DocsumReply::UP rep = dc._ddb->getDocsums(req);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, vespalib::ThreadBundle::trivial());
     const auto & root = rep->root();
     const auto & field = root["errors"];
     EXPECT_TRUE(field.valid());
@@ -621,7 +646,7 @@ void verifyFieldListHonoured(DocsumRequest::FieldList fields, const std::string
     req.resultClassName = "class6";
     req.hits.emplace_back(gid1);
     req.setFields(fields);
-    DocsumReply::UP rep = dc._ddb->getDocsums(req);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, vespalib::ThreadBundle::trivial());
     EXPECT_TRUE(assertSlime(json, *rep));
 }
 
@@ -693,7 +718,7 @@ TEST(DocSummaryTest, requireThatAttributesAreUsed)
     req.resultClassName = "class3";
     req.hits.emplace_back(gid2);
     req.hits.emplace_back(gid3);
-    DocsumReply::UP rep = dc._ddb->getDocsums(req);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, vespalib::ThreadBundle::trivial());
 
     EXPECT_TRUE(assertSlime("{docsums:[ {docsum:{"
                             "ba:10,bb:10.1250,"
@@ -729,7 +754,7 @@ TEST(DocSummaryTest, requireThatAttributesAreUsed)
     }
     gate.await();
 
-    DocsumReply::UP rep2 = dc._ddb->getDocsums(req);
+    DocsumReply::UP rep2 = dc._ddb->getDocsums(req, vespalib::ThreadBundle::trivial());
     assertTensor("second", make_tensor(TensorSpec("tensor(x{},y{})")
                                            .add({{"x", "a"}, {"y", "b"}}, 4)),
                  "bj", *rep2, 1);
@@ -737,7 +762,7 @@ TEST(DocSummaryTest, requireThatAttributesAreUsed)
     DocsumRequest req3;
     req3.resultClassName = "class3";
     req3.hits.emplace_back(gid3);
-    DocsumReply::UP rep3 = dc._ddb->getDocsums(req3);
+    DocsumReply::UP rep3 = dc._ddb->getDocsums(req3, vespalib::ThreadBundle::trivial());
     EXPECT_TRUE(assertSlime("{docsums:[{docsum:{bj:x01020178017901016101624010000000000000}}]}", *rep3));
 }
 
@@ -876,7 +901,7 @@ TEST(DocSummaryTest, requireThatPositionsAreUsed)
     DocsumRequest req;
     req.resultClassName = "class5";
     req.hits.emplace_back(gid1);
-    DocsumReply::UP rep = dc._ddb->getDocsums(req);
+    DocsumReply::UP rep = dc._ddb->getDocsums(req, vespalib::ThreadBundle::trivial());
     EXPECT_TRUE(assertSlime("{docsums:["
                             "{docsum:{sp2:1047758"
                             ",sp2x:{x:1002, y:1003, latlong:'N0.001003;E0.001002'}"
@@ -19,6 +19,8 @@
 #include <vespa/persistence/spi/test.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
 #include <unordered_set>
 
 #include <vespa/log/log.h>
@@ -282,6 +284,13 @@ struct PairDR : DocumentRetrieverBaseForTest {
     }
 };
 
+struct ReversedReadOrderPairDR : PairDR {
+    using PairDR::PairDR;
+    void sortInReadOrder(LidVector &lids) const override {
+        std::reverse(lids.begin(), lids.end());
+    }
+};
+
 size_t getSize(const document::Document &doc) {
     vespalib::nbostream tmp;
     doc.serialize(tmp);
@@ -726,6 +735,83 @@ TEST(DocumentIteratorTest, require_that_at_least_one_document_is_returned_by_vis
     checkEntry(res1, 0, *make_doc(DocumentId("id:ns:document::1")), Timestamp(2));
 }
 
+TEST(DocumentIteratorTest, require_that_read_ahead_fetches_documents_incrementally)
+{
+    VisitRecordingUnitDR::VisitedLIDs visited_lids;
+    DocumentIterator itr(bucket(5), std::make_shared<document::AllFields>(), selectAll(), newestV(), -1, false);
+    for (uint32_t i = 1; i <= 3; ++i) {
+        itr.add(doc_rec(visited_lids, "id:ns:foo::" + std::to_string(i), Timestamp(i), bucket(5)));
+    }
+    itr.setReadAhead(1, nullptr);
+    IterateResult res1 = itr.iterate(1);
+    EXPECT_FALSE(res1.isCompleted());
+    EXPECT_EQ(1u, res1.getEntries().size());
+    EXPECT_EQ(1u, visited_lids.size());
+
+    IterateResult res2 = itr.iterate(1);
+    EXPECT_FALSE(res2.isCompleted());
+    EXPECT_EQ(1u, res2.getEntries().size());
+    EXPECT_EQ(2u, visited_lids.size());
+
+    IterateResult res3 = itr.iterate(1);
+    EXPECT_TRUE(res3.isCompleted());
+    EXPECT_EQ(1u, res3.getEntries().size());
+    EXPECT_EQ(3u, visited_lids.size());
+    checkEntry(res3, 0, *Document::make_without_repo(getAttrDocType(), DocumentId("id:ns:foo::3")), Timestamp(3));
+}
+
+TEST(DocumentIteratorTest, require_that_read_ahead_in_executor_returns_all_documents)
+{
+    vespalib::ThreadStackExecutor executor(1);
+    DocumentIterator itr(bucket(5), std::make_shared<document::AllFields>(), selectAll(), newestV(), -1, false);
+    itr.add(doc("id:ns:document::1", Timestamp(2), bucket(5)));
+    itr.add(cat(rem("id:ns:document::2", Timestamp(3), bucket(5)),
+                doc("id:ns:document::3", Timestamp(4), bucket(5))));
+    itr.add(doc("id:ns:document::4", Timestamp(5), bucket(5)));
+    itr.setReadAhead(largeNum, &executor);
+    IterateResult res1 = itr.iterate(getSize(*make_doc(DocumentId("id:ns:document::1"))));
+    EXPECT_FALSE(res1.isCompleted());
+    EXPECT_EQ(1u, res1.getEntries().size());
+    checkEntry(res1, 0, *make_doc(DocumentId("id:ns:document::1")), Timestamp(2));
+
+    IterateResult res2 = itr.iterate(largeNum);
+    EXPECT_TRUE(res2.isCompleted());
+    EXPECT_EQ(3u, res2.getEntries().size());
+    checkEntry(res2, 0, DocumentId("id:ns:document::2"), Timestamp(3));
+    checkEntry(res2, 1, *make_doc(DocumentId("id:ns:document::3")), Timestamp(4));
+    checkEntry(res2, 2, *make_doc(DocumentId("id:ns:document::4")), Timestamp(5));
+
+    IterateResult res3 = itr.iterate(largeNum);
+    EXPECT_TRUE(res3.isCompleted());
+    EXPECT_EQ(0u, res3.getEntries().size());
+}
+
+TEST(DocumentIteratorTest, require_that_read_ahead_fetches_documents_in_read_order)
+{
+    DocumentIterator itr(bucket(5), std::make_shared<document::AllFields>(), selectAll(), newestV(), -1, false);
+    itr.add(std::make_shared<ReversedReadOrderPairDR>(doc("id:ns:document::1", Timestamp(2), bucket(5)),
+                                                      doc("id:ns:document::2", Timestamp(3), bucket(5))));
+    itr.setReadAhead(largeNum, nullptr);
+    IterateResult res = itr.iterate(largeNum);
+    EXPECT_TRUE(res.isCompleted());
+    EXPECT_EQ(2u, res.getEntries().size());
+    checkEntry(res, 0, *make_doc(DocumentId("id:ns:document::2")), Timestamp(3));
+    checkEntry(res, 1, *make_doc(DocumentId("id:ns:document::1")), Timestamp(2));
+}
+
+TEST(DocumentIteratorTest, require_that_read_ahead_is_not_used_for_meta_data_only_iteration)
+{
+    DocumentIterator itr(bucket(5), std::make_shared<document::NoFields>(), selectAll(), newestV(), -1, false);
+    itr.add(std::make_shared<ReversedReadOrderPairDR>(doc("id:ns:document::1", Timestamp(2), bucket(5)),
+                                                      doc("id:ns:document::2", Timestamp(3), bucket(5))));
+    itr.setReadAhead(largeNum, nullptr);
+    IterateResult res = itr.iterate(largeNum);
+    EXPECT_TRUE(res.isCompleted());
+    EXPECT_EQ(2u, res.getEntries().size());
+    checkEntry(res, 0, Timestamp(2), DocumentMetaEnum::NONE, gid_of("id:ns:document::1"), "");
+    checkEntry(res, 1, Timestamp(3), DocumentMetaEnum::NONE, gid_of("id:ns:document::2"), "");
+}
+
 TEST(DocumentIteratorTest, require_that_documents_outside_the_timestamp_limits_are_ignored)
 {
     DocumentIterator itr(bucket(5), std::make_shared<document::AllFields>(), selectTimestampRange(100, 200), newestV(), -1, false);
@@ -1,5 +1,6 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
+#include <vespa/config-rank-profiles.h>
 #include <vespa/config-summary.h>
 #include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/repo/documenttyperepo.h>
@@ -22,6 +23,7 @@
 #include <vespa/searchcore/proton/reprocessing/attribute_reprocessing_initializer.h>
 #include <vespa/searchcore/proton/server/document_subdb_reconfig.h>
 #include <vespa/searchcore/proton/server/fast_access_doc_subdb_configurer.h>
+#include <vespa/searchcore/proton/server/matchers.h>
 #include <vespa/searchcore/proton/server/reconfig_params.h>
 #include <vespa/searchcore/proton/server/searchable_doc_subdb_configurer.h>
 #include <vespa/searchcore/proton/server/searchview.h>
@@ -201,7 +203,7 @@ Fixture::Fixture()
     std::filesystem::create_directory(std::filesystem::path(BASE_DIR));
     initViewSet(_views);
     _configurer = std::make_unique<Configurer>(_views._summaryMgr, _views.searchView, _views.feedView, _queryLimiter,
-                                               _constantValueFactory, _clock.nowRef(), "test", 0);
+                                               _constantValueFactory, _clock.nowRef(), "test", 0, 0);
 }
 Fixture::~Fixture() {
     std::filesystem::remove_all(std::filesystem::path(BASE_DIR));
@@ -389,6 +391,20 @@ createConfig(std::shared_ptr<const Schema> schema)
             repo(createRepo()).build();
 }
 
+DocumentDBConfig::SP
+createConfigWithRankProfiles(const std::string &changed_value)
+{
+    RankProfilesConfigBuilder builder;
+    builder.rankprofile.resize(2);
+    builder.rankprofile[0].name = "unchanged";
+    builder.rankprofile[1].name = "changed";
+    builder.rankprofile[1].fef.property.resize(1);
+    builder.rankprofile[1].fef.property[0].name = "my_property";
+    builder.rankprofile[1].fef.property[0].value = changed_value;
+    return proton::test::DocumentDBConfigBuilder(0, make_shared<Schema>(), "client", DOC_TYPE).
+            repo(createRepo()).rankProfiles(make_shared<RankProfilesConfig>(builder)).build();
+}
+
 struct SearchViewComparer
 {
     SearchView::SP _old;
@@ -693,6 +709,25 @@ TEST(DocSubDBConfigurerTest, require_that_we_can_reconfigure_matchers)
     }
 }
 
+TEST(DocSubDBConfigurerTest, require_that_matchers_for_unchanged_rank_profiles_are_reused)
+{
+    Fixture f;
+    auto old_matchers = f._configurer->createMatchers(*createConfigWithRankProfiles("1"));
+    auto new_matchers = f._configurer->createMatchers(*createConfigWithRankProfiles("2"), *old_matchers);
+    EXPECT_EQ(old_matchers->find("unchanged").get(), new_matchers->find("unchanged").get());
+    EXPECT_NE(old_matchers->find("changed").get(), new_matchers->find("changed").get());
+    EXPECT_EQ(&old_matchers->get_ranking_assets_repo(), &new_matchers->get_ranking_assets_repo());
+}
+
+TEST(DocSubDBConfigurerTest, require_that_matchers_are_only_reused_when_schema_and_ranking_assets_are_unchanged)
+{
+    EXPECT_TRUE(ReconfigParams(CCR().setRankProfilesChanged(true)).canReuseUnchangedMatchers());
+    EXPECT_FALSE(ReconfigParams(CCR().setRankingConstantsChanged(true)).canReuseUnchangedMatchers());
+    EXPECT_FALSE(ReconfigParams(CCR().setRankingExpressionsChanged(true)).canReuseUnchangedMatchers());
+    EXPECT_FALSE(ReconfigParams(CCR().setOnnxModelsChanged(true)).canReuseUnchangedMatchers());
+    EXPECT_FALSE(ReconfigParams(CCR().setSchemaChanged(true)).canReuseUnchangedMatchers());
+}
+
 TEST(DocSubDBConfigurerTest, require_that_attribute_manager_should_change_when_imported_fields_have_changed)
 {
     ReconfigParams params(CCR().setImportedFieldsChanged(true));
@@ -45,7 +45,8 @@ struct ControllerFixtureBase : public ::testing::Test
     DocumentDBTaggedMetrics         _metrics;
     std::shared_ptr<BucketMoveJob>  _bmj;
     MyCountJobRunner                _runner;
-    ControllerFixtureBase(const BlockableMaintenanceJobConfig &blockableConfig, bool storeMoveDoneContexts);
+    ControllerFixtureBase(const BlockableMaintenanceJobConfig &blockableConfig, bool storeMoveDoneContexts,
+                          const BucketMoveConfig &bucketMoveConfig = BucketMoveConfig());
     ~ControllerFixtureBase() override;
     ControllerFixtureBase &addReady(const BucketId &bucket) {
         _calc->addReady(bucket);
@@ -112,7 +113,8 @@ struct ControllerFixtureBase : public ::testing::Test
     }
 };
 
-ControllerFixtureBase::ControllerFixtureBase(const BlockableMaintenanceJobConfig &blockableConfig, bool storeMoveDoneContexts)
+ControllerFixtureBase::ControllerFixtureBase(const BlockableMaintenanceJobConfig &blockableConfig, bool storeMoveDoneContexts,
+                                             const BucketMoveConfig &bucketMoveConfig)
     : _builder(),
       _calc(std::make_shared<test::BucketStateCalculator>()),
       _bucketHandler(),
@@ -130,7 +132,7 @@ ControllerFixtureBase::ControllerFixtureBase(const BlockableMaintenanceJobConfig
       _metrics("test", 1),
       _bmj(BucketMoveJob::create(_calc, RetainGuard(_refCount), _moveHandler, _modifiedHandler, _master, _bucketExecutor, _ready._subDb,
                                  _notReady._subDb, _bucketCreateNotifier, _clusterStateHandler, _bucketHandler,
-                                 _resource_usage_notifier, blockableConfig, "test", makeBucketSpace())),
+                                 _resource_usage_notifier, blockableConfig, bucketMoveConfig, "test", makeBucketSpace())),
       _runner(*_bmj)
 {
 }
@@ -142,8 +144,10 @@ const BlockableMaintenanceJobConfig BLOCKABLE_CONFIG(RESOURCE_LIMIT_FACTOR, MAX_
 
 struct ControllerFixture : public ControllerFixtureBase
 {
-    explicit ControllerFixture(const BlockableMaintenanceJobConfig &blockableConfig = BLOCKABLE_CONFIG)
-        : ControllerFixtureBase(blockableConfig, blockableConfig.getMaxOutstandingMoveOps() != MAX_OUTSTANDING_OPS)
+    explicit ControllerFixture(const BlockableMaintenanceJobConfig &blockableConfig = BLOCKABLE_CONFIG,
+                               const BucketMoveConfig &bucketMoveConfig = BucketMoveConfig())
+        : ControllerFixtureBase(blockableConfig, blockableConfig.getMaxOutstandingMoveOps() != MAX_OUTSTANDING_OPS,
+                                bucketMoveConfig)
     {
         _builder.createDocs(1, 1, 4); // 3 docs
         _builder.createDocs(2, 4, 6); // 2 docs
@@ -591,6 +595,26 @@ TEST_F(ControllerFixture, require_that_notifyCreateBucket_causes_bucket_to_be_re
 }
 
 
+struct BatchedControllerFixture : public ControllerFixture
+{
+    BatchedControllerFixture() : ControllerFixture(BLOCKABLE_CONFIG, BucketMoveConfig(3)) {}
+};
+
+TEST_F(BatchedControllerFixture, require_that_run_moves_a_batch_of_documents_from_bucket)
+{
+    // bucket 1 should be moved
+    addReady(_ready.bucket(2));
+    _bmj->recompute();
+    EXPECT_FALSE(_bmj->done());
+    _bmj->run();
+    sync();
+    EXPECT_EQ(3u, docsMoved().size());
+    assertEqual(_ready.bucket(1), _ready.docs(1)[0], 1, 2, docsMoved()[0]);
+    assertEqual(_ready.bucket(1), _ready.docs(1)[1], 1, 2, docsMoved()[1]);
+    assertEqual(_ready.bucket(1), _ready.docs(1)[2], 1, 2, docsMoved()[2]);
+}
+
+
 struct ResourceLimitControllerFixture : public ControllerFixture
 {
     explicit ResourceLimitControllerFixture(double resourceLimitFactor = RESOURCE_LIMIT_FACTOR) :
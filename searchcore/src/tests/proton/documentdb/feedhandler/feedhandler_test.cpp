@@ -42,6 +42,7 @@
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <filesystem>
+#include <thread>
 
 #include <vespa/log/log.h>
 LOG_SETUP("feedhandler_test");
@@ -760,6 +761,96 @@ TEST_F(FeedHandlerTest, require_that_feed_stats_are_updated)
     EXPECT_LT(0.0, stats.get_total_latency());
 }
 
+namespace {
+
+// The returned context must outlive the commit of the put
+std::unique_ptr<FeedTokenContext>
+perform_put(FeedHandlerFixture& f, const std::string& doc_id, uint64_t timestamp)
+{
+    DocumentContext doc_context(doc_id, f.schema.builder);
+    auto op = std::make_unique<PutOperation>(doc_context.bucketId, Timestamp(timestamp), std::move(doc_context.doc));
+    auto token_context = std::make_unique<FeedTokenContext>();
+    f.handler.performOperation(std::move(token_context->token), std::move(op));
+    return token_context;
+}
+
+}
+
+TEST_F(FeedHandlerTest, require_that_commit_is_delayed_until_batch_is_full)
+{
+    FeedHandlerFixture f;
+    std::vector<std::unique_ptr<FeedTokenContext>> token_contexts;
+    f.runAsMaster([&]() { f.handler.set_commit_batching(3600s, 3); });
+    token_contexts.push_back(perform_put(f, "id:ns:searchdocument::foo1", 10));
+    token_contexts.push_back(perform_put(f, "id:ns:searchdocument::foo2", 11));
+    f.syncMaster();
+    EXPECT_EQ(0u, f.handler.get_stats(false).get_commits());
+    token_contexts.push_back(perform_put(f, "id:ns:searchdocument::foo3", 12));
+    f.syncMaster(); // wait for initateCommit
+    f.syncMaster(); // wait for onCommitDone
+    auto stats = f.handler.get_stats(false);
+    EXPECT_EQ(1u, stats.get_commits());
+    EXPECT_EQ(3u, stats.get_operations());
+    EXPECT_EQ(1u, stats.get_batch_sizes()[FeedHandlerStats::batch_size_bucket(3)]);
+}
+
+TEST_F(FeedHandlerTest, require_that_delayed_commit_is_started_after_max_delay)
+{
+    FeedHandlerFixture f;
+    std::vector<std::unique_ptr<FeedTokenContext>> token_contexts;
+    f.runAsMaster([&]() { f.handler.set_commit_batching(10ms, 0); });
+    token_contexts.push_back(perform_put(f, "id:ns:searchdocument::foo1", 10));
+    token_contexts.push_back(perform_put(f, "id:ns:searchdocument::foo2", 11));
+    auto stats = f.handler.get_stats(false);
+    for (int i = 0; i < 6000 && stats.get_commits() == 0u; ++i) {
+        std::this_thread::sleep_for(10ms);
+        f.syncMaster();
+        stats = f.handler.get_stats(false);
+    }
+    EXPECT_EQ(1u, stats.get_commits());
+    EXPECT_EQ(2u, stats.get_operations());
+}
+
+TEST_F(FeedHandlerTest, require_that_disabling_commit_delay_starts_delayed_commit)
+{
+    FeedHandlerFixture f;
+    std::vector<std::unique_ptr<FeedTokenContext>> token_contexts;
+    f.runAsMaster([&]() { f.handler.set_commit_batching(3600s, 0); });
+    token_contexts.push_back(perform_put(f, "id:ns:searchdocument::foo1", 10));
+    f.syncMaster();
+    EXPECT_EQ(0u, f.handler.get_stats(false).get_commits());
+    f.runAsMaster([&]() { f.handler.set_commit_batching(0s, 0); });
+    f.syncMaster(); // wait for initateCommit
+    f.syncMaster(); // wait for onCommitDone
+    EXPECT_EQ(1u, f.handler.get_stats(false).get_commits());
+}
+
+TEST_F(FeedHandlerTest, require_that_commits_are_counted_per_batch_size)
+{
+    FeedHandlerStats stats;
+    stats.add_commit(0, 0.1);
+    stats.add_commit(1, 0.1);
+    stats.add_commit(2, 0.1);
+    stats.add_commit(3, 0.1);
+    stats.add_commit(4, 0.1);
+    stats.add_commit(1023, 0.1);
+    stats.add_commit(1024, 0.1);
+    stats.add_commit(100000, 0.1);
+    const auto& batch_sizes = stats.get_batch_sizes();
+    EXPECT_EQ(2u, batch_sizes[0]);
+    EXPECT_EQ(2u, batch_sizes[1]);
+    EXPECT_EQ(1u, batch_sizes[2]);
+    EXPECT_EQ(1u, batch_sizes[9]);
+    EXPECT_EQ(2u, batch_sizes[10]);
+    FeedHandlerStats last = stats;
+    stats.add_commit(3, 0.1);
+    stats -= last;
+    EXPECT_EQ(1u, stats.get_commits());
+    EXPECT_EQ(0u, stats.get_batch_sizes()[0]);
+    EXPECT_EQ(1u, stats.get_batch_sizes()[1]);
+    EXPECT_EQ(4u, FeedHandlerStats::batch_size_bucket_lower_bound(2));
+}
+
 using namespace document;
 
 TEST_F(FeedHandlerTest, require_that_update_with_a_fieldpath_update_will_be_rejected)
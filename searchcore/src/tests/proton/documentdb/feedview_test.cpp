@@ -1159,6 +1159,22 @@ TEST(FeedViewTest, require_that_update_to_tensor_attribute_only_updates_attribut
     requireThatUpdateOnlyUpdatesAttributeAndNotDocumentStore(f, "a3");
 }
 
+TEST(FeedViewTest, require_that_update_to_attribute_and_non_attribute_field_updates_document_store)
+{
+    SearchableFeedViewFixture f;
+    f.maw._attrs.insert("a1"); // mark a1 as attribute field
+    DocumentContext dc1 = f.doc1();
+    f.putAndWait(dc1);
+    f.forceCommitAndWait();
+    DocumentContext dc2("id:ns:searchdocument::1", 20, f.getBuilder());
+    dc2.addFieldUpdate(f.getBuilder(), "a1");
+    dc2.addFieldUpdate(f.getBuilder(), "s1");
+    f.updateAndWait(dc2);
+    f.forceCommitAndWait();
+    EXPECT_EQ(2u, f.msa._store._lastSyncToken); // document store updated
+    assertAttributeUpdate(2u, DocumentId("id:ns:searchdocument::1"), 1, f.maw);
+}
+
 TEST(FeedViewTest, require_that_compactLidSpace_propagates_to_document_meta_store_and_document_store_and_blocks_lid_space_shrinkage_until_generation_is_no_longer_used)
 {
     SearchableFeedViewFixture f;
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "lid_space_jobtest.h"
+#include <vespa/vespalib/data/slime/slime.h>
 
 using BlockedReason = IBlockableMaintenanceJob::BlockedReason;
 
@@ -161,6 +162,35 @@ TEST_F(JobTest, delay_is_set_based_on_interval_and_can_be_less_than_300_secs)
     EXPECT_EQ(299s, _job->getInterval());
 }
 
+TEST_F(JobTest, document_moves_are_limited_by_max_moves_per_second)
+{
+    init_with_max_moves_per_second(1.0); // 1 move per 1s interval
+    setupThreeDocumentsToCompact();
+    EXPECT_TRUE(run()); // move budget is spent
+    assertJobContext(2, 9, 1, 0, 0);
+    EXPECT_TRUE(run()); // no more moves until next interval
+    assertJobContext(2, 9, 1, 0, 0);
+}
+
+TEST_F(JobTest, progress_is_reported_while_scanning)
+{
+    vespalib::Slime before;
+    _job->report_progress(before.setObject());
+    EXPECT_FALSE(before.get()["progress"]["scanning"].asBool());
+    EXPECT_EQ(0, before.get()["progress"]["moved_documents"].asLong());
+
+    setupThreeDocumentsToCompact();
+    EXPECT_FALSE(run());
+    sync();
+    vespalib::Slime during;
+    _job->report_progress(during.setObject());
+    const auto &progress = during.get()["progress"];
+    EXPECT_TRUE(progress["scanning"].asBool());
+    EXPECT_EQ(1, progress["moved_documents"].asLong());
+    EXPECT_EQ(2, progress["remaining_moves_estimate"].asLong());
+    EXPECT_LE(0.0, progress["moves_per_second"].asDouble());
+}
+
 TEST_F(JobTest, job_is_disabled_when_node_is_retired)
 {
     init_with_node_retired(true);
@@ -36,7 +36,8 @@ JobTestBase::JobTestBase()
       _handler(),
       _storer(),
       _maintenance_job_token_source(std::make_shared<MaintenanceJobTokenSource>()),
-      _job()
+      _job(),
+      _max_moves_per_second(0.0)
 {
     init(ALLOWED_LID_BLOAT, ALLOWED_LID_BLOAT_FACTOR, RESOURCE_LIMIT_FACTOR, JOB_DELAY, false, MAX_OUTSTANDING_MOVE_OPS);
 }
@@ -51,7 +52,7 @@ JobTestBase::init(uint32_t allowedLidBloat,
 {
     _handler = std::make_shared<MyHandler>(maxOutstandingMoveOps != MAX_OUTSTANDING_MOVE_OPS, true);
     DocumentDBLidSpaceCompactionConfig compactCfg(interval, allowedLidBloat, allowedLidBloatFactor,
-                                                  REMOVE_BATCH_BLOCK_RATE, REMOVE_BLOCK_RATE, false);
+                                                  REMOVE_BATCH_BLOCK_RATE, REMOVE_BLOCK_RATE, false, _max_moves_per_second);
     BlockableMaintenanceJobConfig blockableCfg(resourceLimitFactor, maxOutstandingMoveOps);
 
     _job.reset();
@@ -199,6 +200,12 @@ JobTest::init_with_node_retired(bool retired) {
     init(ALLOWED_LID_BLOAT, ALLOWED_LID_BLOAT_FACTOR, RESOURCE_LIMIT_FACTOR, JOB_DELAY, retired);
 }
 
+void
+JobTest::init_with_max_moves_per_second(double max_moves_per_second) {
+    _max_moves_per_second = max_moves_per_second;
+    init(ALLOWED_LID_BLOAT, ALLOWED_LID_BLOAT_FACTOR);
+}
+
 
 JobDisabledByRemoveOpsTest::JobDisabledByRemoveOpsTest() : JobTest() {}
 JobDisabledByRemoveOpsTest::~JobDisabledByRemoveOpsTest() = default;
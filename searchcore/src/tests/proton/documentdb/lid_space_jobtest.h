@@ -19,6 +19,7 @@ struct JobTestBase : public ::testing::Test {
     MyStorer _storer;
     std::shared_ptr<MaintenanceJobTokenSource> _maintenance_job_token_source;
     std::shared_ptr<BlockableMaintenanceJob> _job;
+    double _max_moves_per_second;
     JobTestBase();
     ~JobTestBase() override;
     void init(uint32_t allowedLidBloat,
@@ -66,6 +67,7 @@ struct JobTest : public JobTestBase {
               uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS);
     void init_with_interval(vespalib::duration interval);
     void init_with_node_retired(bool retired);
+    void init_with_max_moves_per_second(double max_moves_per_second);
 };
 
 class JobDisabledByRemoveOpsTest : public JobTest {
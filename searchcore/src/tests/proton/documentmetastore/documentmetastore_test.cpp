@@ -1716,6 +1716,61 @@ TEST(DocumentMetaStoreTest, move_works)
     EXPECT_EQ(1u, lid);
 }
 
+TEST(DocumentMetaStoreTest, gid_hash_index_follows_put_remove_and_move)
+{
+    DocumentMetaStore dms(createBucketDB(), DocumentMetaStore::getFixedName(), GrowStrategy(), SubDbType::READY, true);
+    EXPECT_TRUE(dms.has_gid_hash_index());
+    dms.constructFreeList();
+    assertPut(bucketId1, time1, 1u, gid1, dms);
+    assertPut(bucketId2, time2, 2u, gid2, dms);
+    assertPut(bucketId3, time3, 3u, gid3, dms);
+    Result inspect = dms.inspectExisting(gid2, 0u);
+    EXPECT_TRUE(inspect.ok());
+    EXPECT_EQ(2u, inspect.getLid());
+    EXPECT_EQ(time2, inspect._timestamp);
+    EXPECT_FALSE(dms.inspectExisting(gid4, 0u).ok());
+    EXPECT_EQ(4u, dms.inspect(gid4, 0u).getLid());
+    // Put of existing document only updates meta data
+    assertPut(bucketId2, time3, 2u, gid2, dms);
+    assertGid(gid2, 2u, dms, bucketId2, time3);
+    EXPECT_TRUE(dms.remove(1u, 0u));
+    dms.commit();
+    dms.removes_complete({ 1u });
+    EXPECT_FALSE(dms.inspectExisting(gid1, 0u).ok());
+    dms.move(3u, 1u, 0u);
+    dms.commit();
+    dms.removes_complete({ 3u });
+    EXPECT_EQ(1u, dms.inspectExisting(gid3, 0u).getLid());
+    assertLid(1u, gid3, dms);
+    dms.removeBatch({ 1u, 2u }, dms.getCommittedDocIdLimit());
+    dms.commit();
+    EXPECT_FALSE(dms.inspectExisting(gid2, 0u).ok());
+    EXPECT_FALSE(dms.inspectExisting(gid3, 0u).ok());
+    EXPECT_EQ(0u, dms.getNumUsedLids());
+}
+
+TEST(DocumentMetaStoreTest, gid_hash_index_is_populated_on_load)
+{
+    DocumentMetaStore dms1(createBucketDB());
+    dms1.constructFreeList();
+    assertPut(bucketId1, time1, 1u, gid1, dms1);
+    assertPut(bucketId2, time2, 2u, gid2, dms1);
+    TuneFileAttributes tuneFileAttributes;
+    DummyFileHeaderContext fileHeaderContext;
+    AttributeFileSaveTarget saveTarget(tuneFileAttributes, fileHeaderContext);
+    EXPECT_TRUE(dms1.save(saveTarget, "documentmetastore3"));
+
+    DocumentMetaStore dms2(createBucketDB(), "documentmetastore3", GrowStrategy(), SubDbType::READY, true);
+    EXPECT_TRUE(dms2.load());
+    dms2.constructFreeList();
+    EXPECT_EQ(1u, dms2.inspectExisting(gid1, 0u).getLid());
+    EXPECT_EQ(2u, dms2.inspectExisting(gid2, 0u).getLid());
+    EXPECT_EQ(3u, dms2.inspect(gid3, 0u).getLid());
+    assertPut(bucketId3, time3, 3u, gid3, dms2);
+    EXPECT_EQ(3u, dms2.inspectExisting(gid3, 0u).getLid());
+    std::filesystem::remove(std::filesystem::path("documentmetastore3.dat"));
+}
+
 void
 assertLidSpace(uint32_t numDocs,
                uint32_t committedDocIdLimit,
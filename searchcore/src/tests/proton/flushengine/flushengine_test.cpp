@@ -292,6 +292,16 @@ public:
     {}
 };
 
+class WritingTarget : public SimpleTarget {
+    uint64_t _bytes_to_write;
+public:
+    WritingTarget(const std::string &name, search::SerialNum flushedSerial, uint64_t bytes_to_write)
+        : SimpleTarget(name, Type::OTHER, flushedSerial, false),
+          _bytes_to_write(bytes_to_write)
+    {}
+    uint64_t getApproxBytesToWriteToDisk() const override { return _bytes_to_write; }
+};
+
 class HighPriorityTarget : public SimpleTarget {
 public:
     HighPriorityTarget(const std::string &name, search::SerialNum flushedSerial, bool proceed)
@@ -752,6 +762,32 @@ TEST(FlushEngineTest, require_that_concurrency_works)
     target2->_proceed.countDown();
 }
 
+TEST(FlushEngineTest, require_that_pending_write_bytes_limits_concurrency)
+{
+    Fixture f(2, 1ms);
+    f.engine.set_max_pending_write_bytes(100);
+    auto target1 = std::make_shared<WritingTarget>("target1", 1, 150);
+    auto target2 = std::make_shared<WritingTarget>("target2", 2, 50);
+    auto target3 = std::make_shared<WritingTarget>("target3", 3, 10);
+    auto handler = std::make_shared<SimpleHandler>(Targets({target1, target2, target3}), "handler", 9);
+    f.putFlushHandler("handler", handler);
+    f.engine.start();
+
+    EXPECT_TRUE(target1->_initDone.await(LONG_TIMEOUT));
+    EXPECT_TRUE(!target2->_initDone.await(SHORT_TIMEOUT));
+    assertThatHandlersInCurrentSet(f.engine, {"handler.target1"});
+    EXPECT_EQ(150u, f.engine.get_pending_write_bytes());
+    target1->_proceed.countDown();
+    EXPECT_TRUE(target1->_taskDone.await(LONG_TIMEOUT));
+    EXPECT_TRUE(target2->_initDone.await(LONG_TIMEOUT));
+    EXPECT_TRUE(target3->_initDone.await(LONG_TIMEOUT));
+    assertThatHandlersInCurrentSet(f.engine, {"handler.target2", "handler.target3"});
+    EXPECT_EQ(60u, f.engine.get_pending_write_bytes());
+    EXPECT_LT(0.0, f.engine.get_write_bandwidth());
+    target2->_proceed.countDown();
+    target3->_proceed.countDown();
+}
+
 TEST(FlushEngineTest, require_that_there_is_room_for_one_and_only_one_high_pri_target)
 {
     Fixture f(2, 1ms, std::make_unique<SimpleStrategy>(SimpleStrategy::OrderBy::SERIAL));
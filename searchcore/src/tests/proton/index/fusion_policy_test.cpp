@@ -0,0 +1,47 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcorespi/index/fusion_policy.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using searchcorespi::index::FusionPolicy;
+
+using Sizes = std::vector<uint64_t>;
+
+TEST(FusionPolicyTest, count_based_policy_uses_max_flushed)
+{
+    FusionPolicy policy;
+    EXPECT_FALSE(policy.is_tiered());
+    EXPECT_FALSE(policy.fusion_due(Sizes{}, 2));
+    EXPECT_FALSE(policy.fusion_due(Sizes{1000, 1}, 2));
+    EXPECT_TRUE(policy.fusion_due(Sizes{1000, 1, 1}, 2));
+    EXPECT_TRUE(policy.fusion_due(Sizes{1}, 0));
+}
+
+TEST(FusionPolicyTest, tiered_policy_waits_for_size_ratio)
+{
+    FusionPolicy policy(0.5, 8);
+    EXPECT_TRUE(policy.is_tiered());
+    EXPECT_FALSE(policy.fusion_due(Sizes{1000}, 2));
+    EXPECT_FALSE(policy.fusion_due(Sizes{1000, 100, 100, 100}, 2));
+    EXPECT_FALSE(policy.fusion_due(Sizes{1000, 100, 100, 100, 100}, 2));
+    EXPECT_TRUE(policy.fusion_due(Sizes{1000, 100, 100, 100, 100, 100}, 2));
+    EXPECT_TRUE(policy.fusion_due(Sizes{1000, 600}, 2));
+}
+
+TEST(FusionPolicyTest, tiered_policy_bounds_number_of_disk_indexes)
+{
+    FusionPolicy policy(0.5, 4);
+    EXPECT_FALSE(policy.fusion_due(Sizes{1000, 1, 1, 1}, 2));
+    EXPECT_TRUE(policy.fusion_due(Sizes{1000, 1, 1, 1, 1}, 2));
+    // max flushed is used when larger, e.g. for retired nodes
+    EXPECT_FALSE(policy.fusion_due(Sizes{1000, 1, 1, 1, 1}, 20));
+}
+
+TEST(FusionPolicyTest, tiered_policy_uses_oldest_flushed_index_as_base_when_no_fusion_index)
+{
+    FusionPolicy policy(1.0, 8);
+    EXPECT_FALSE(policy.fusion_due(Sizes{100, 50}, 2));
+    EXPECT_TRUE(policy.fusion_due(Sizes{100, 50, 50}, 2));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -3,10 +3,12 @@
 #include <vespa/searchcore/proton/matching/fakesearchcontext.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
 #include <vespa/searchlib/query/tree/simplequery.h>
+#include <vespa/searchcorespi/index/warmup_term_sample.h>
 #include <vespa/searchcorespi/index/warmupindexcollection.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/testclock.h>
+#include <filesystem>
 #include <vespa/log/log.h>
 LOG_SETUP("indexcollection_test");
 
@@ -20,6 +22,8 @@ using search::queryeval::FakeRequestContext;
 using search::queryeval::FieldSpecList;
 using search::queryeval::FieldSpec;
 using searchcorespi::index::WarmupConfig;
+using searchcorespi::index::WarmupTermSample;
+using Term = WarmupTermSample::Term;
 
 class MockIndexSearchable : public FakeIndexSearchable {
 private:
@@ -184,4 +188,67 @@ TEST_F(IndexCollectionTest, warmup_can_create_blueprint)
     EXPECT_TRUE(blueprint);
 }
 
+TEST_F(IndexCollectionTest, index_collection_samples_string_terms_for_warmup)
+{
+    auto sample = std::make_shared<WarmupTermSample>(10);
+    auto collection = make_unique_collection();
+    collection->set_term_sample(sample);
+    collection->append(0, _source1);
+
+    FakeRequestContext requestContext;
+    FieldSpecList fields;
+    fields.add(FieldSpec("f1", 1, search::fef::IllegalHandle));
+    fields.add(FieldSpec("f2", 2, search::fef::IllegalHandle));
+    search::query::SimpleStringTerm term("what", "view", 1, search::query::Weight(100));
+    search::query::SimplePrefixTerm prefix_term("wh", "view", 2, search::query::Weight(100));
+    collection->createBlueprint(requestContext, fields, term);
+    collection->createBlueprint(requestContext, fields, prefix_term);
+    EXPECT_EQ((std::vector<Term>{{"f1", "what"}, {"f2", "what"}}), sample->get_terms());
+
+    IndexCollection copy(_selector, *collection);
+    EXPECT_EQ(sample, copy.get_term_sample());
+    auto renumbered = IndexCollection::replaceAndRenumber(_selector, *collection, 0, _fusion_source);
+    EXPECT_EQ(sample, dynamic_cast<const IndexCollection &>(*renumbered).get_term_sample());
+}
+
+TEST(WarmupTermSampleTest, keeps_most_recent_distinct_terms)
+{
+    WarmupTermSample sample(3);
+    sample.add("f", "a");
+    sample.add("f", "b");
+    sample.add("f", "a");
+    sample.add("g", "a");
+    EXPECT_EQ((std::vector<Term>{{"f", "a"}, {"f", "b"}, {"g", "a"}}), sample.get_terms());
+    sample.add("f", "c");
+    sample.add("f", "d");
+    EXPECT_EQ((std::vector<Term>{{"g", "a"}, {"f", "c"}, {"f", "d"}}), sample.get_terms());
+    sample.add("f", "a");
+    EXPECT_EQ((std::vector<Term>{{"f", "c"}, {"f", "d"}, {"f", "a"}}), sample.get_terms());
+}
+
+TEST(WarmupTermSampleTest, disabled_sample_ignores_terms)
+{
+    WarmupTermSample sample(0);
+    sample.add("f", "a");
+    EXPECT_TRUE(sample.get_terms().empty());
+}
+
+TEST(WarmupTermSampleTest, terms_can_be_saved_and_loaded)
+{
+    std::string dir("warmup_term_sample_dir");
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directory(dir);
+    EXPECT_TRUE(WarmupTermSample::load(dir).empty());
+    WarmupTermSample sample(10);
+    sample.add("f", "a");
+    sample.add("g", std::string("b\0\nc", 4));
+    sample.save(dir);
+    auto terms = WarmupTermSample::load(dir);
+    EXPECT_EQ(sample.get_terms(), terms);
+    WarmupTermSample seeded(10);
+    seeded.add(terms);
+    EXPECT_EQ(terms, seeded.get_terms());
+    std::filesystem::remove_all(dir);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
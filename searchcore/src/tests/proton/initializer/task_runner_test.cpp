@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/log/log.h>
 LOG_SETUP("task_runner_test");
+#include <vespa/searchcore/proton/initializer/critical_path.h>
 #include <vespa/searchcore/proton/initializer/initializer_task.h>
 #include <vespa/searchcore/proton/initializer/task_runner.h>
 #include <vespa/vespalib/gtest/gtest.h>
@@ -10,6 +11,7 @@ LOG_SETUP("task_runner_test");
 #include <string>
 
 using proton::initializer::InitializerTask;
+using proton::initializer::get_critical_path;
 using proton::initializer::TaskRunner;
 
 struct TestLog
@@ -38,16 +40,20 @@ protected:
     std::string  _name;
     TestLog          &_log;
     size_t            _transient_memory_usage;
+    uint64_t          _estimated_load_size;
 public:
-    NamedTask(const std::string &name, TestLog &log, size_t transient_memory_usage = 0)
+    NamedTask(const std::string &name, TestLog &log, size_t transient_memory_usage = 0, uint64_t estimated_load_size = 0)
         : _name(name),
           _log(log),
-          _transient_memory_usage(transient_memory_usage)
+          _transient_memory_usage(transient_memory_usage),
+          _estimated_load_size(estimated_load_size)
     {
     }
 
     void run() override { _log.append(_name); }
     size_t get_transient_memory_usage() const override { return _transient_memory_usage; }
+    uint64_t get_estimated_load_size() const override { return _estimated_load_size; }
+    std::string get_name() const override { return _name; }
 };
 
 
@@ -99,6 +105,21 @@ struct TestJob {
         return TestJob(std::move(log), std::move(task_e));
     }
 
+    static TestJob setupLoadingTasks()
+    {
+        auto log = std::make_unique<TestLog>();
+        auto task_a = std::make_shared<NamedTask>("A", *log, 0, 100);
+        auto task_b = std::make_shared<NamedTask>("B", *log, 0, 1000);
+        auto task_c = std::make_shared<NamedTask>("C", *log, 5, 1);
+        auto task_d = std::make_shared<NamedTask>("D", *log, 0, 10);
+        auto task_e = std::make_shared<NamedTask>("E", *log, 0, 0);
+        task_e->addDependency(task_a);
+        task_e->addDependency(task_b);
+        task_e->addDependency(task_c);
+        task_e->addDependency(task_d);
+        return TestJob(std::move(log), std::move(task_e));
+    }
+
 };
 
 TestJob::TestJob(TestLog::UP log, InitializerTask::SP root)
@@ -170,4 +191,30 @@ TEST(TaskRunnerTest, single_thread_with_resource_using_tasks)
     EXPECT_EQ("BDCAE", job._log->result());
 }
 
+TEST(TaskRunnerTest, single_thread_starts_largest_loading_tasks_first)
+{
+    Fixture f(1);
+    auto job = TestJob::setupLoadingTasks();
+    f.run(job._root);
+    EXPECT_EQ("CBADE", job._log->result());
+}
+
+TEST(TaskRunnerTest, critical_path_follows_last_done_dependency)
+{
+    Fixture f(1);
+    TestJob job = TestJob::setupDiamond();
+    f.run(job._root);
+    EXPECT_EQ("DABC", job._log->result());
+    std::string path_names;
+    for (const auto *task : get_critical_path(*job._root)) {
+        path_names += task->get_name();
+    }
+    EXPECT_EQ("DBC", path_names);
+    auto path_string = proton::initializer::critical_path_to_string(*job._root);
+    EXPECT_EQ(0u, path_string.find("D(run="));
+    EXPECT_NE(std::string::npos, path_string.find(" -> B(run="));
+    EXPECT_NE(std::string::npos, path_string.find(" -> C(run="));
+    EXPECT_NE(std::string::npos, path_string.find(", wait="));
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
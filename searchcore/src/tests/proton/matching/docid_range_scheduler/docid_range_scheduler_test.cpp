@@ -354,4 +354,82 @@ TEST(DocidRangeSchedulerTest, require_that_the_adaptive_scheduler_handles_fewer_
 
 //-----------------------------------------------------------------------------
 
+TEST(DocidRangeSchedulerTest, require_that_the_work_stealing_scheduler_hands_out_chunks_and_steals_half_the_remaining_work)
+{
+    WorkStealingDocidRangeScheduler scheduler(2, 2, 11);
+    EXPECT_EQ(scheduler.unassigned_size(), 10u);
+    verify_range("first0", scheduler.first_range(0), DocidRange(1, 3));
+    verify_range("next0a", scheduler.next_range(0), DocidRange(3, 5));
+    verify_range("next0b", scheduler.next_range(0), DocidRange(5, 6));
+    EXPECT_EQ(scheduler.unassigned_size(), 5u);
+    verify_range("stolen0", scheduler.next_range(0), DocidRange(8, 10));
+    EXPECT_EQ(scheduler.steal_count(0), 1u);
+    EXPECT_EQ(scheduler.unassigned_size(), 3u);
+    verify_range("first1", scheduler.first_range(1), DocidRange(6, 8));
+    verify_range("next0c", scheduler.next_range(0), DocidRange(10, 11));
+    verify_range("empty0", scheduler.next_range(0), DocidRange());
+    verify_range("empty1", scheduler.next_range(1), DocidRange());
+    EXPECT_EQ(scheduler.total_size(0), 8u);
+    EXPECT_EQ(scheduler.total_size(1), 2u);
+    EXPECT_EQ(scheduler.unassigned_size(), 0u);
+    EXPECT_EQ(scheduler.steal_count(0), 1u);
+    EXPECT_EQ(scheduler.failed_steal_count(0), 1u);
+    EXPECT_EQ(scheduler.steal_count(1), 0u);
+    EXPECT_EQ(scheduler.failed_steal_count(1), 1u);
+}
+
+TEST(DocidRangeSchedulerTest, require_that_the_work_stealing_scheduler_assigns_each_docid_exactly_once)
+{
+    constexpr size_t num_threads = 8;
+    constexpr uint32_t docid_limit = 10007;
+    WorkStealingDocidRangeScheduler f1(num_threads, 7, docid_limit);
+    TimeBomb f2(60);
+    std::vector<std::vector<DocidRange>> ranges(num_threads);
+    auto task = [&f1,&ranges](Nexus& ctx) {
+        auto thread_id = ctx.thread_id();
+        size_t total = 0;
+        for (DocidRange docid_range = f1.first_range(thread_id);
+             !docid_range.empty();
+             docid_range = f1.next_range(thread_id))
+        {
+            EXPECT_GE(7u, docid_range.size());
+            ranges[thread_id].push_back(docid_range);
+            total += docid_range.size();
+            if (thread_id == 0) {
+                // make thread 0 slow to trigger stealing from it
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+        EXPECT_EQ(f1.total_size(thread_id), total);
+    };
+    Nexus::run(num_threads, task);
+    std::vector<uint32_t> seen(docid_limit, 0);
+    size_t steals = 0;
+    for (size_t i = 0; i < num_threads; ++i) {
+        for (DocidRange range: ranges[i]) {
+            for (uint32_t docid = range.begin; docid < range.end; ++docid) {
+                ++seen[docid];
+            }
+        }
+        steals += f1.steal_count(i);
+    }
+    for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+        EXPECT_EQ(seen[docid], 1u);
+    }
+    EXPECT_GT(steals, 0u);
+    EXPECT_EQ(f1.unassigned_size(), 0u);
+}
+
+TEST(DocidRangeSchedulerTest, require_that_the_work_stealing_scheduler_handles_no_documents)
+{
+    WorkStealingDocidRangeScheduler scheduler(4, 1, 1);
+    for (size_t thread_id = 0; thread_id < 4; ++thread_id) {
+        verify_range(std::to_string(thread_id), scheduler.first_range(thread_id), DocidRange());
+        EXPECT_EQ(scheduler.total_size(thread_id), 0u);
+    }
+    EXPECT_EQ(scheduler.unassigned_size(), 0u);
+}
+
+//-----------------------------------------------------------------------------
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,121 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/matching/grouping_result_cache.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/size_literals.h>
+
+using proton::matching::GroupingResultCache;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using vespalib::steady_time;
+
+namespace {
+
+const int owner_a = 1;
+const int owner_b = 2;
+
+std::unique_ptr<SearchRequest> make_request(const std::string &stack, const std::string &grouping) {
+    auto req = std::make_unique<SearchRequest>();
+    req->ranking = "default";
+    req->stackDump.assign(stack.begin(), stack.end());
+    req->groupSpec.assign(grouping.begin(), grouping.end());
+    return req;
+}
+
+SearchReply make_reply(const std::string &grouping_result, size_t size = 0) {
+    SearchReply reply;
+    reply.totalHitCount = 42;
+    reply.coverage.setActive(1000).setCovered(900);
+    reply.groupResult.assign(grouping_result.data(), grouping_result.data() + grouping_result.size());
+    reply.sortData.resize(size);
+    return reply;
+}
+
+std::string group_result(const SearchReply &reply) {
+    return {reply.groupResult.data(), reply.groupResult.size()};
+}
+
+}
+
+TEST(GroupingResultCacheTest, requireThatOnlyPlainGroupingRequestsAreCacheable)
+{
+    auto req = make_request("stack", "");
+    EXPECT_FALSE(GroupingResultCache::is_cacheable(*req));
+    req = make_request("stack", "grouping");
+    EXPECT_TRUE(GroupingResultCache::is_cacheable(*req));
+    req->sessionId.push_back('x');
+    EXPECT_TRUE(GroupingResultCache::is_cacheable(*req));
+    req->propertiesMap.lookupCreate(search::MapNames::CACHES).add("grouping", "true");
+    EXPECT_FALSE(GroupingResultCache::is_cacheable(*req));
+    req = make_request("stack", "grouping");
+    req->dumpFeatures = true;
+    EXPECT_FALSE(GroupingResultCache::is_cacheable(*req));
+}
+
+TEST(GroupingResultCacheTest, requireThatKeyDependsOnOwnerQueryAndGrouping)
+{
+    auto req = make_request("stack", "grouping");
+    auto key = GroupingResultCache::make_key(&owner_a, *req);
+    EXPECT_EQ(key, GroupingResultCache::make_key(&owner_a, *make_request("stack", "grouping")));
+    EXPECT_NE(key, GroupingResultCache::make_key(&owner_b, *req));
+    EXPECT_NE(key, GroupingResultCache::make_key(&owner_a, *make_request("other", "grouping")));
+    EXPECT_NE(key, GroupingResultCache::make_key(&owner_a, *make_request("stack", "next page")));
+}
+
+TEST(GroupingResultCacheTest, requireThatRepliesAreServedForSameGenerationWithinTtl)
+{
+    GroupingResultCache cache(1_Mi, 10s);
+    steady_time now(1000s);
+    EXPECT_FALSE(cache.lookup("a", 1, now));
+    cache.insert("a", 1, now, make_reply("groups"));
+    auto reply = cache.lookup("a", 1, now + 5s);
+    ASSERT_TRUE(reply);
+    EXPECT_EQ("groups", group_result(*reply));
+    EXPECT_EQ(42u, reply->totalHitCount);
+    EXPECT_EQ(900u, reply->coverage.getCovered());
+    EXPECT_FALSE(cache.lookup("a", 2, now + 5s));
+    EXPECT_FALSE(cache.lookup("a", 1, now + 5s)); // stale entry was dropped
+    cache.insert("a", 2, now, make_reply("groups"));
+    EXPECT_FALSE(cache.lookup("a", 2, now + 11s));
+    auto stats = cache.get_stats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(4u, stats.misses);
+    EXPECT_EQ(2u, stats.inserts);
+    EXPECT_EQ(1u, stats.expired);
+    EXPECT_EQ(0u, stats.entries);
+}
+
+TEST(GroupingResultCacheTest, requireThatExpiredEntriesArePruned)
+{
+    GroupingResultCache cache(1_Mi, 10s);
+    steady_time now(1000s);
+    cache.insert("a", 1, now, make_reply("a"));
+    cache.insert("b", 1, now + 5s, make_reply("b"));
+    cache.prune(now + 12s);
+    EXPECT_EQ(1u, cache.get_stats().entries);
+    EXPECT_FALSE(cache.lookup("a", 1, now + 12s));
+    EXPECT_TRUE(cache.lookup("b", 1, now + 12s));
+    cache.prune(now + 20s);
+    EXPECT_EQ(0u, cache.get_stats().entries);
+    EXPECT_EQ(0u, cache.get_stats().memory_used);
+}
+
+TEST(GroupingResultCacheTest, requireThatMemoryBudgetIsRespected)
+{
+    GroupingResultCache cache(3500, 10s);
+    steady_time now(1000s);
+    cache.insert("a", 1, now, make_reply("a", 1000));
+    cache.insert("b", 1, now, make_reply("b", 1000));
+    EXPECT_TRUE(cache.lookup("a", 1, now)); // a is now most recently used
+    cache.insert("c", 1, now, make_reply("c", 1000));
+    EXPECT_TRUE(cache.lookup("a", 1, now));
+    EXPECT_FALSE(cache.lookup("b", 1, now));
+    EXPECT_TRUE(cache.lookup("c", 1, now));
+    EXPECT_LE(cache.get_stats().memory_used, 3500u);
+    EXPECT_EQ(1u, cache.get_stats().evictions);
+    cache.insert("d", 1, now, make_reply("d", 5000));
+    EXPECT_FALSE(cache.lookup("d", 1, now));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/searchcore/proton/matching/match_loop_communicator.h>
 #include <vespa/searchlib/features/first_phase_rank_lookup.h>
+#include <vespa/searchlib/queryeval/rank_score_threshold.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/test/nexus.h>
 #include <algorithm>
@@ -16,6 +17,7 @@ using Hits = MatchLoopCommunicator::Hits;
 using TaggedHit = MatchLoopCommunicator::TaggedHit;
 using TaggedHits = MatchLoopCommunicator::TaggedHits;
 using search::features::FirstPhaseRankLookup;
+using search::queryeval::RankScoreThreshold;
 using search::queryeval::SortedHitSequence;
 using vespalib::test::Nexus;
 
@@ -330,4 +332,24 @@ TEST(MatchLoopCommunicatorTest, require_that_before_second_phase_is_called_once)
     EXPECT_EQ(1, cnt.load(std::memory_order_acquire));
 }
 
+TEST(MatchLoopCommunicatorTest, require_that_published_score_thresholds_only_raise_the_shared_threshold)
+{
+    constexpr size_t num_threads = 5;
+    MatchLoopCommunicator f1(num_threads, 3);
+    EXPECT_FALSE(f1.accepts_score_threshold());
+    f1.publish_score_threshold(10.0); // ignored
+    RankScoreThreshold threshold;
+    f1.set_score_threshold(&threshold);
+    EXPECT_TRUE(f1.accepts_score_threshold());
+    auto task = [&f1](Nexus& ctx) {
+                    auto thread_id = ctx.thread_id();
+                    for (size_t i = 0; i < 100; ++i) {
+                        f1.publish_score_threshold(double(i * num_threads + thread_id));
+                    }
+                    f1.publish_score_threshold(1.0);
+                };
+    Nexus::run(num_threads, task);
+    EXPECT_EQ(double(100 * num_threads - 1), threshold.get());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -405,6 +405,79 @@ TEST(MatchPhaseLimiterTest, require_that_the_match_phase_limiter_is_able_to_post
     EXPECT_TRUE(limiter.was_limited());
 }
 
+DegradationParams
+adaptive_params(size_t max_hits, double cost_per_hit_s)
+{
+    DegradationParams params("limiter_attribute", max_hits, true, 1.0, 0.2, 1.0);
+    params.adaptive = true;
+    params.cost_per_hit_s = cost_per_hit_s;
+    return params;
+}
+
+std::string
+limiter_term(const SearchIterator &search)
+{
+    auto *limited = dynamic_cast<const LimitedSearch*>(&search);
+    EXPECT_TRUE(limited != nullptr);
+    const auto *ms = (limited != nullptr) ? dynamic_cast<const MockSearch*>(&limited->getFirst()) : nullptr;
+    EXPECT_TRUE(ms != nullptr);
+    return (ms != nullptr) ? ms->term : "";
+}
+
+TEST(MatchPhaseLimiterTest, require_that_adaptive_limiter_lowers_max_hits_to_fit_time_left) {
+    MockSearchable searchable;
+    FakeRequestContext requestContext(nullptr, vespalib::steady_clock::now() + 10s);
+    MockRangeLocator rangeLocator;
+    // 8s of the 10s left at 10ms per hit gives at most 800 hits
+    MatchPhaseLimiter yes_limiter(10000, rangeLocator, searchable, requestContext,
+                                  adaptive_params(5000, 0.01),
+                                  DiversityParams("", 1, 10.0, AttributeLimiter::LOOSE));
+    MaybeMatchPhaseLimiter &limiter = yes_limiter;
+    EXPECT_EQ(0u, limiter.adaptive_max_hits());
+    SearchIterator::UP search = limiter.maybe_limit(prepare(new MockSearch("search")), 0.1, 100000, nullptr);
+    EXPECT_TRUE(limiter.was_limited());
+    size_t max_hits = limiter.adaptive_max_hits();
+    EXPECT_LE(700u, max_hits);
+    EXPECT_GE(800u, max_hits);
+    EXPECT_EQ(fmt("[;;-%zu]", size_t(max_hits / 0.1)), limiter_term(*search));
+}
+
+TEST(MatchPhaseLimiterTest, require_that_adaptive_limiter_keeps_max_hits_when_there_is_enough_time) {
+    MockSearchable searchable;
+    FakeRequestContext requestContext(nullptr, vespalib::steady_clock::now() + 100s);
+    MockRangeLocator rangeLocator;
+    MatchPhaseLimiter yes_limiter(10000, rangeLocator, searchable, requestContext,
+                                  adaptive_params(500, 0.01),
+                                  DiversityParams("", 1, 10.0, AttributeLimiter::LOOSE));
+    MaybeMatchPhaseLimiter &limiter = yes_limiter;
+    RelativeTime clock(std::make_unique<CountingClock>(vespalib::count_ns(10000000s), 1700000L));
+    Trace trace(clock, 7);
+    trace.start(4, false);
+    SearchIterator::UP search = limiter.maybe_limit(prepare(new MockSearch("search")), 0.1, 100000, trace.maybeCreateCursor(7, "limit"));
+    EXPECT_TRUE(limiter.was_limited());
+    EXPECT_EQ(0u, limiter.adaptive_max_hits());
+    EXPECT_EQ("[;;-5000]", limiter_term(*search));
+    trace.done();
+    const auto &limit = trace.getSlime().get()["traces"][0];
+    EXPECT_TRUE(limit["adaptive"].asBool());
+    EXPECT_DOUBLE_EQ(10.0, limit["cost_per_hit_ms"].asDouble());
+    EXPECT_EQ(500, limit["adaptive_max_hits"].asLong());
+    EXPECT_EQ(5000, limit["wanted_docs"].asLong());
+}
+
+TEST(MatchPhaseLimiterTest, require_that_adaptive_limiter_uses_max_hits_without_observed_cost) {
+    MockSearchable searchable;
+    FakeRequestContext requestContext(nullptr, vespalib::steady_clock::now() + 10ms);
+    MockRangeLocator rangeLocator;
+    MatchPhaseLimiter yes_limiter(10000, rangeLocator, searchable, requestContext,
+                                  adaptive_params(500, 0.0),
+                                  DiversityParams("", 1, 10.0, AttributeLimiter::LOOSE));
+    MaybeMatchPhaseLimiter &limiter = yes_limiter;
+    SearchIterator::UP search = limiter.maybe_limit(prepare(new MockSearch("search")), 0.1, 100000, nullptr);
+    EXPECT_EQ(0u, limiter.adaptive_max_hits());
+    EXPECT_EQ("[;;-5000]", limiter_term(*search));
+}
+
 void verifyDiversity(AttributeLimiter::DiversityCutoffStrategy strategy)
 {
     MockSearchable searchable;
@@ -277,6 +277,24 @@ TEST(MatchingStatsTest, requireThatSoftDoomIsSetAndAdded)
     EXPECT_EQ(0.5, stats2.softDoomFactor());  // Not affected by add
 }
 
+TEST(MatchingStatsTest, requireThatStealCountsAreMergedAndAdded)
+{
+    MatchingStats stats;
+    stats.merge_partition(MatchingStats::Partition().steals(3).failed_steals(5), 0);
+    stats.merge_partition(MatchingStats::Partition().steals(1).failed_steals(2), 1);
+    EXPECT_EQ(4u, stats.steals());
+    EXPECT_EQ(7u, stats.failed_steals());
+    EXPECT_EQ(3u, stats.getPartition(0).steals());
+    EXPECT_EQ(2u, stats.getPartition(1).failed_steals());
+    MatchingStats stats2;
+    stats2.add(stats);
+    stats2.add(stats);
+    EXPECT_EQ(8u, stats2.steals());
+    EXPECT_EQ(14u, stats2.failed_steals());
+    EXPECT_EQ(6u, stats2.getPartition(0).steals());
+    EXPECT_EQ(10u, stats2.getPartition(0).failed_steals());
+}
+
 TEST(MatchingStatsTest, requireThatSoftDoomFacorIsComputedCorrectlyForDownAdjustment)
 {
     MatchingStats stats;
@@ -335,4 +353,46 @@ TEST(MatchingStatsTest, requireThatFactor_is_capped_at_minimum_1_percent)
     EXPECT_DOUBLE_EQ(0.0105, stats.softDoomFactor());
 }
 
+TEST(MatchingStatsTest, requireThatMatchCostPerHitIsSmoothed)
+{
+    MatchingStats stats;
+    EXPECT_EQ(0.0, stats.matchCostPerHit());
+    stats.updateMatchCostPerHit(0.5, 0);     // no hits, ignored
+    EXPECT_EQ(0.0, stats.matchCostPerHit());
+    stats.updateMatchCostPerHit(0.2, 1000);  // first sample is used as is
+    EXPECT_DOUBLE_EQ(0.0002, stats.matchCostPerHit());
+    stats.updateMatchCostPerHit(1.2, 1000);
+    EXPECT_DOUBLE_EQ(0.00025, stats.matchCostPerHit());
+    MatchingStats stats2;
+    stats2.add(stats);
+    EXPECT_EQ(0.0, stats2.matchCostPerHit());  // Not affected by add
+}
+
+TEST(MatchingStatsTest, requireThatAdaptiveLimitingIsAdded)
+{
+    MatchingStats stats;
+    stats.adaptive_limited_queries(1).adaptiveMaxHits(300);
+    MatchingStats stats2;
+    stats2.adaptive_limited_queries(1).adaptiveMaxHits(500);
+    stats2.add(stats);
+    EXPECT_EQ(2u, stats2.adaptive_limited_queries());
+    EXPECT_EQ(2u, stats2.adaptiveMaxHitsCount());
+    EXPECT_DOUBLE_EQ(400.0, stats2.adaptiveMaxHitsAvg());
+    EXPECT_DOUBLE_EQ(300.0, stats2.adaptiveMaxHitsMin());
+    EXPECT_DOUBLE_EQ(500.0, stats2.adaptiveMaxHitsMax());
+}
+
+TEST(MatchingStatsTest, requireThatWakeupTimeIsAdded)
+{
+    MatchingStats stats;
+    stats.wakeupTime(0.001);
+    MatchingStats stats2;
+    stats2.wakeupTime(0.003);
+    stats2.add(stats);
+    EXPECT_EQ(2u, stats2.wakeupTimeCount());
+    EXPECT_NEAR(0.002, stats2.wakeupTimeAvg(), 0.00001);
+    EXPECT_NEAR(0.001, stats2.wakeupTimeMin(), 0.00001);
+    EXPECT_NEAR(0.003, stats2.wakeupTimeMax(), 0.00001);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -31,6 +31,7 @@
 #include <vespa/eval/eval/simple_value.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/value_codec.h>
+#include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/featureset.h>
@@ -414,7 +415,7 @@ struct MyWorld {
 
         explicit MySearchHandler(Matcher::SP matcher) noexcept : _matcher(std::move(matcher)) {}
 
-        DocsumReply::UP getDocsums(const DocsumRequest &) override {
+        DocsumReply::UP getDocsums(const DocsumRequest &, vespalib::ThreadBundle &) override {
             return {};
         }
         SearchReply::UP match(const SearchRequest &, vespalib::ThreadBundle &) const override {
@@ -443,7 +444,10 @@ struct MyWorld {
     }
 
     SearchReply::UP performSearch(const SearchRequest & req, size_t threads) {
-        Matcher::SP matcher = createMatcher();
+        return performSearch(createMatcher(), req, threads);
+    }
+
+    SearchReply::UP performSearch(Matcher::SP matcher, const SearchRequest & req, size_t threads) {
         SearchSession::OwnershipBundle owned_objects({std::make_unique<MockAttributeContext>(),
                                                       std::make_unique<FakeSearchContext>()},
                                                      std::make_shared<MySearchHandler>(matcher));
@@ -684,6 +688,47 @@ TEST_F(MatchingTest, require_that_ranking_is_performed_with_multi_threaded_match
     }
 }
 
+TEST_F(MatchingTest, require_that_profiles_of_sampled_queries_are_aggregated)
+{
+    constexpr size_t threads = 4;
+    MyWorld world(shared_state());
+    world.basicSetup();
+    world.basicResults();
+    world.config.add(ProfileSampleInterval::NAME, "2");
+    Matcher::SP matcher = world.createMatcher();
+    auto &profiles = matcher->get_aggregated_profiles();
+    EXPECT_EQ(2u, profiles.sample_interval());
+    EXPECT_EQ(ProfileSampleDepth::DEFAULT_VALUE, uint32_t(profiles.depth()));
+    SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "spread");
+    for (size_t i = 0; i < 4; ++i) {
+        SearchReply::UP reply = world.performSearch(matcher, *request, threads);
+        EXPECT_EQ(9u, reply->hits.size());
+    }
+    EXPECT_EQ(2u, profiles.sampled_queries());
+    EXPECT_EQ(2 * threads, profiles.match().num_profiles());
+    EXPECT_EQ(2 * threads, profiles.first_phase().num_profiles());
+    vespalib::Slime slime;
+    profiles.report(slime.setObject(), true);
+    EXPECT_EQ(2, slime["sampled_queries"].asLong());
+    EXPECT_LT(0u, slime["match_profiling"]["roots"].entries());
+    EXPECT_LT(0u, slime["first_phase_profiling"]["roots"].entries());
+    profiles.reset();
+    EXPECT_EQ(0u, profiles.sampled_queries());
+    EXPECT_EQ(0u, profiles.match().num_profiles());
+}
+
+TEST_F(MatchingTest, require_that_queries_are_not_sampled_for_profiling_by_default)
+{
+    MyWorld world(shared_state());
+    world.basicSetup();
+    world.basicResults();
+    Matcher::SP matcher = world.createMatcher();
+    SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "spread");
+    world.performSearch(matcher, *request, 1);
+    EXPECT_EQ(0u, matcher->get_aggregated_profiles().sampled_queries());
+    EXPECT_EQ(0u, matcher->get_aggregated_profiles().match().num_profiles());
+}
+
 TEST_F(MatchingTest, require_that_reranking_is_performed_with_multi_threaded_matcher)
  {
     for (size_t threads = 1; threads <= 16; ++threads) {
@@ -1001,6 +1046,55 @@ TEST_F(MatchingTest, require_that_getSummaryFeatures_can_use_cached_query_setup)
     EXPECT_EQ(100, f[4].as_double());
 }
 
+TEST_F(MatchingTest, require_that_summary_features_can_be_precomputed_in_match_phase)
+{
+    MyWorld world(shared_state());
+    world.basicSetup();
+    world.basicResults();
+    SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "foo");
+    request->propertiesMap.lookupCreate(search::MapNames::CACHES).add("query", "true");
+    request->propertiesMap.lookupCreate(search::MapNames::RANK).add(indexproperties::summary::PrecomputeFeatures::NAME, "true");
+    request->sessionId.push_back('a');
+    auto reply = world.performSearch(*request, 1);
+    ASSERT_LT(0u, reply->hits.size());
+
+    auto session = world.sessionManager->pickSearch("a");
+    ASSERT_TRUE(session);
+    auto precomputed = session->get_summary_features();
+    ASSERT_TRUE(precomputed);
+    EXPECT_EQ(5u, precomputed->numFeatures());
+    EXPECT_EQ(reply->hits.size(), precomputed->numDocs());
+    uint32_t docid = precomputed->get_docids().front();
+
+    DocsumRequest::SP docsum_request(new DocsumRequest);  // no stack dump
+    docsum_request->sessionId = request->sessionId;
+    docsum_request->propertiesMap.lookupCreate(search::MapNames::CACHES).add("query", "true");
+    docsum_request->hits.emplace_back();
+    docsum_request->hits.back().docid = docid;
+    FeatureSet::SP fs = world.getSummaryFeatures(*docsum_request);
+    EXPECT_EQ(precomputed->getNames(), fs->getNames());
+    ASSERT_EQ(1u, fs->numDocs());
+    const auto *f = fs->getFeaturesByDocId(docid);
+    ASSERT_TRUE(f);
+    EXPECT_EQ(docid, f[0].as_double());
+    EXPECT_EQ(1.0, f[1].as_double());
+    EXPECT_EQ(100, f[4].as_double());
+}
+
+TEST_F(MatchingTest, require_that_summary_features_are_not_precomputed_by_default)
+{
+    MyWorld world(shared_state());
+    world.basicSetup();
+    world.basicResults();
+    SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "foo");
+    request->propertiesMap.lookupCreate(search::MapNames::CACHES).add("query", "true");
+    request->sessionId.push_back('a');
+    world.performSearch(*request, 1);
+    auto session = world.sessionManager->pickSearch("a");
+    ASSERT_TRUE(session);
+    EXPECT_FALSE(session->get_summary_features());
+}
+
 void count_f1_matches(FeatureSet &fs, double& sum) {
     ASSERT_TRUE(fs.getNames().size() > 1);
     ASSERT_EQ(fs.getNames()[1], "matches(f1)");
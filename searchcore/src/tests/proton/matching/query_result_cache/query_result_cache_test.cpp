@@ -0,0 +1,125 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using proton::matching::QueryResultCache;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+
+namespace {
+
+std::unique_ptr<SearchRequest> make_request(const std::string &stack, const std::string &ranking = "default") {
+    auto req = std::make_unique<SearchRequest>();
+    req->ranking = ranking;
+    req->stackDump.assign(stack.begin(), stack.end());
+    req->maxhits = 10;
+    return req;
+}
+
+SearchReply make_reply(size_t num_hits) {
+    SearchReply reply;
+    reply.totalHitCount = num_hits * 10;
+    reply.coverage.setActive(1000).setCovered(900);
+    for (size_t i = 0; i < num_hits; ++i) {
+        SearchReply::Hit hit;
+        hit.metric = 100.0 - i;
+        reply.hits.push_back(hit);
+    }
+    return reply;
+}
+
+}
+
+TEST(QueryResultCacheTest, requireThatKeyDependsOnStackRankProfileAndRankProperties)
+{
+    auto a = make_request("stack");
+    auto b = make_request("stack");
+    EXPECT_EQ(QueryResultCache::make_key(*a), QueryResultCache::make_key(*b));
+    EXPECT_NE(QueryResultCache::make_key(*a), QueryResultCache::make_key(*make_request("other")));
+    EXPECT_NE(QueryResultCache::make_key(*a), QueryResultCache::make_key(*make_request("stack", "fancy")));
+    b->propertiesMap.lookupCreate(search::MapNames::RANK).add("foo", "bar");
+    EXPECT_NE(QueryResultCache::make_key(*a), QueryResultCache::make_key(*b));
+    b->propertiesMap.lookupCreate(search::MapNames::RANK).add("baz", "qux");
+    a->propertiesMap.lookupCreate(search::MapNames::RANK).add("baz", "qux").add("foo", "bar");
+    EXPECT_EQ(QueryResultCache::make_key(*a), QueryResultCache::make_key(*b));
+    b->offset = 10;
+    EXPECT_NE(QueryResultCache::make_key(*a), QueryResultCache::make_key(*b));
+}
+
+TEST(QueryResultCacheTest, requireThatGroupingAndSessionRequestsAreNotCacheable)
+{
+    auto req = make_request("stack");
+    EXPECT_TRUE(QueryResultCache::is_cacheable(*req));
+    req->groupSpec.push_back('x');
+    EXPECT_FALSE(QueryResultCache::is_cacheable(*req));
+    req = make_request("stack");
+    req->sessionId.push_back('x');
+    EXPECT_FALSE(QueryResultCache::is_cacheable(*req));
+}
+
+TEST(QueryResultCacheTest, requireThatCachedReplyIsReturnedForSameGeneration)
+{
+    QueryResultCache cache(100000);
+    EXPECT_FALSE(cache.lookup("key", 1));
+    cache.insert("key", 1, make_reply(3));
+    auto reply = cache.lookup("key", 1);
+    ASSERT_TRUE(reply);
+    EXPECT_EQ(30u, reply->totalHitCount);
+    EXPECT_EQ(900u, reply->coverage.getCovered());
+    ASSERT_EQ(3u, reply->hits.size());
+    EXPECT_EQ(98.0, reply->hits[2].metric);
+    auto stats = cache.get_stats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(1u, stats.entries);
+    EXPECT_LT(0u, stats.memory_used);
+}
+
+TEST(QueryResultCacheTest, requireThatNewerGenerationDropsAllEntries)
+{
+    QueryResultCache cache(100000);
+    cache.insert("a", 1, make_reply(3));
+    cache.insert("b", 1, make_reply(3));
+    EXPECT_FALSE(cache.lookup("a", 2));
+    EXPECT_FALSE(cache.lookup("b", 2));
+    auto stats = cache.get_stats();
+    EXPECT_EQ(1u, stats.invalidations);
+    EXPECT_EQ(0u, stats.entries);
+    EXPECT_EQ(0u, stats.memory_used);
+    // replies produced against an older generation are not cached
+    cache.insert("a", 1, make_reply(3));
+    EXPECT_FALSE(cache.lookup("a", 2));
+}
+
+TEST(QueryResultCacheTest, requireThatLeastRecentlyUsedEntriesAreEvictedToStayWithinBudget)
+{
+    QueryResultCache probe(1000000);
+    probe.insert("a", 0, make_reply(10));
+    size_t entry_size = probe.get_stats().memory_used;
+
+    QueryResultCache cache(entry_size * 2 + entry_size / 2);
+    cache.insert("a", 0, make_reply(10));
+    cache.insert("b", 0, make_reply(10));
+    EXPECT_TRUE(cache.lookup("a", 0));
+    cache.insert("c", 0, make_reply(10));
+    EXPECT_TRUE(cache.lookup("a", 0));
+    EXPECT_FALSE(cache.lookup("b", 0));
+    EXPECT_TRUE(cache.lookup("c", 0));
+    auto stats = cache.get_stats();
+    EXPECT_EQ(1u, stats.evictions);
+    EXPECT_EQ(2u, stats.entries);
+    EXPECT_LE(stats.memory_used, cache.max_bytes());
+}
+
+TEST(QueryResultCacheTest, requireThatRepliesLargerThanBudgetAreNotCached)
+{
+    QueryResultCache cache(100);
+    cache.insert("a", 0, make_reply(100));
+    EXPECT_FALSE(cache.lookup("a", 0));
+    EXPECT_EQ(0u, cache.get_stats().entries);
+    EXPECT_EQ(0u, cache.get_stats().memory_used);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,97 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/matching/querylimiter.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <thread>
+
+using namespace proton::matching;
+using vespalib::Doom;
+using vespalib::steady_clock;
+using vespalib::steady_time;
+using Priority = QueryLimiter::Priority;
+
+struct QueryLimiterTest : ::testing::Test {
+    std::atomic<steady_time> now;
+    QueryLimiter limiter;
+    QueryLimiterTest() : now(steady_clock::now()), limiter() {}
+    Doom doom(vespalib::duration left) const { return Doom(now, now.load() + left); }
+    void advance(vespalib::duration delta) { now.store(now.load() + delta); }
+};
+
+TEST_F(QueryLimiterTest, priority_names_are_mapped)
+{
+    EXPECT_EQ(Priority::HIGH, QueryLimiter::to_priority("high"));
+    EXPECT_EQ(Priority::NORMAL, QueryLimiter::to_priority("normal"));
+    EXPECT_EQ(Priority::LOW, QueryLimiter::to_priority("low"));
+    EXPECT_EQ(Priority::NORMAL, QueryLimiter::to_priority("urgent"));
+}
+
+TEST_F(QueryLimiterTest, all_queries_are_admitted_without_limit)
+{
+    auto a = limiter.admit(doom(1s), Priority::LOW);
+    auto b = limiter.admit(doom(1s), Priority::LOW);
+    EXPECT_TRUE(a->admitted());
+    EXPECT_TRUE(b->admitted());
+    EXPECT_FALSE(b->queued());
+}
+
+TEST_F(QueryLimiterTest, query_waits_for_admission_until_a_query_is_done)
+{
+    limiter.configure_admission(1, 1s, 1s);
+    auto first = limiter.admit(doom(10s), Priority::NORMAL);
+    EXPECT_TRUE(first->admitted());
+    EXPECT_FALSE(first->queued());
+    QueryLimiter::Admission::UP second;
+    std::thread thread([&]() { second = limiter.admit(doom(10s), Priority::NORMAL); });
+    std::this_thread::sleep_for(10ms);
+    first.reset();
+    thread.join();
+    EXPECT_TRUE(second->admitted());
+    EXPECT_TRUE(second->queued());
+}
+
+TEST_F(QueryLimiterTest, query_is_rejected_when_estimated_queue_delay_exceeds_time_left)
+{
+    limiter.configure_admission(1, 1s, 1s);
+    {
+        auto first = limiter.admit(doom(10s), Priority::HIGH);
+        std::this_thread::sleep_for(20ms);
+    }
+    auto busy = limiter.admit(doom(10s), Priority::HIGH);
+    EXPECT_LE(vespalib::duration(20ms), limiter.estimated_queue_delay(Priority::HIGH));
+    auto rejected = limiter.admit(doom(1ms), Priority::HIGH);
+    EXPECT_FALSE(rejected->admitted());
+    EXPECT_FALSE(rejected->queued());
+}
+
+TEST_F(QueryLimiterTest, query_is_rejected_when_soft_doomed_while_waiting)
+{
+    limiter.configure_admission(1, 1s, 1s);
+    auto busy = limiter.admit(doom(10s), Priority::NORMAL);
+    QueryLimiter::Admission::UP waiting;
+    Doom short_doom = doom(5ms);
+    std::thread thread([&]() { waiting = limiter.admit(short_doom, Priority::NORMAL); });
+    std::this_thread::sleep_for(10ms);
+    advance(10ms);
+    thread.join();
+    EXPECT_FALSE(waiting->admitted());
+}
+
+TEST_F(QueryLimiterTest, low_priority_queries_are_shed_when_queue_delay_stays_above_target)
+{
+    limiter.configure_admission(1, vespalib::duration::zero(), vespalib::duration::zero());
+    limiter.admit(doom(10s), Priority::NORMAL);
+    EXPECT_FALSE(limiter.is_shedding());
+    auto busy = limiter.admit(doom(10s), Priority::NORMAL);
+    EXPECT_TRUE(limiter.is_shedding());
+    auto low = limiter.admit(doom(10s), Priority::LOW);
+    EXPECT_FALSE(low->admitted());
+    QueryLimiter::Admission::UP normal;
+    std::thread thread([&]() { normal = limiter.admit(doom(10s), Priority::NORMAL); });
+    std::this_thread::sleep_for(10ms);
+    busy.reset();
+    thread.join();
+    EXPECT_TRUE(normal->admitted());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
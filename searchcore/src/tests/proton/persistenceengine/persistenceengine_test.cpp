@@ -9,6 +9,7 @@
 #include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/document/update/assignvalueupdate.h>
+#include <vespa/persistence/spi/catchresult.h>
 #include <vespa/persistence/spi/documentselection.h>
 #include <vespa/persistence/spi/test.h>
 #include <vespa/searchcore/proton/persistenceengine/ipersistenceengineowner.h>
@@ -30,6 +31,7 @@ using document::DocumentUpdate;
 using document::GlobalId;
 using document::test::makeBucketSpace;
 using search::DocumentMetaData;
+using storage::spi::BatchedFeedOperation;
 using storage::spi::Bucket;
 using storage::spi::BucketChecksum;
 using storage::spi::BucketIdListResult;
@@ -162,6 +164,7 @@ struct MyHandler : public IPersistenceHandler, IBucketFreezer {
     std::multiset<uint64_t>      frozen;
     std::multiset<uint64_t>      was_frozen;
     DocTypeName                  _doc_type_name;
+    uint32_t                     feed_batches;
 
     MyHandler(const DocTypeName &type_name)
         : initialized(false),
@@ -182,7 +185,8 @@ struct MyHandler : public IPersistenceHandler, IBucketFreezer {
           document(nullptr),
           frozen(),
           was_frozen(),
-          _doc_type_name(type_name)
+          _doc_type_name(type_name),
+          feed_batches(0)
     {
     }
 
@@ -208,6 +212,11 @@ struct MyHandler : public IPersistenceHandler, IBucketFreezer {
         handle(token, bucket, timestamp, doc->getId());
     }
 
+    void handleFeedBatch(const Bucket& bucket, FeedBatch batch) override {
+        ++feed_batches;
+        IPersistenceHandler::handleFeedBatch(bucket, std::move(batch));
+    }
+
     void handleUpdate(FeedToken token, const Bucket& bucket,
                       Timestamp timestamp, DocumentUpdateSP upd) override {
         token->setResult(std::make_unique<UpdateResult>(existingTimestamp), existingTimestamp > 0);
@@ -591,6 +600,57 @@ TEST(PersistenceEngineTest, require_that_remove_is_NOT_rejected_if_resource_limi
 }
 
 
+TEST(PersistenceEngineTest, require_that_feed_batch_is_routed_to_handlers_as_one_batch_per_handler)
+{
+    SimpleFixture f;
+    f.hset.handler2.setExistingTimestamp(tstamp2);
+    std::vector<std::future<std::unique_ptr<Result>>> futures;
+    std::vector<BatchedFeedOperation> ops;
+    auto make_on_done = [&futures]() {
+        auto on_done = std::make_unique<storage::spi::CatchResult>();
+        futures.emplace_back(on_done->future_result());
+        return on_done;
+    };
+    ops.emplace_back(BatchedFeedOperation::make_put(tstamp1, doc1, make_on_done()));
+    ops.emplace_back(BatchedFeedOperation::make_remove(tstamp2, docId2, make_on_done()));
+    ops.emplace_back(BatchedFeedOperation::make_put(tstamp3, doc3, make_on_done()));
+    ops.emplace_back(BatchedFeedOperation::make_put(tstamp3, doc1, make_on_done()));
+    f.engine.feedBatchAsync(bucket1, std::move(ops));
+
+    EXPECT_EQ(1u, f.hset.handler1.feed_batches);
+    EXPECT_EQ(1u, f.hset.handler2.feed_batches);
+    assertHandler(bucket1, tstamp3, docId1, f.hset.handler1, "handler1 after feed batch");
+    assertHandler(bucket1, tstamp2, docId2, f.hset.handler2, "handler2 after feed batch");
+    ASSERT_EQ(4u, futures.size());
+    EXPECT_EQ(Result(), *futures[0].get());
+    auto remove_result = futures[1].get();
+    ASSERT_TRUE(dynamic_cast<const RemoveResult *>(remove_result.get()) != nullptr);
+    EXPECT_TRUE(dynamic_cast<const RemoveResult &>(*remove_result).wasFound());
+    EXPECT_EQ(Result(Result::ErrorType::PERMANENT_ERROR, "No handler for document type 'type3'"), *futures[2].get());
+    EXPECT_EQ(Result(), *futures[3].get());
+}
+
+TEST(PersistenceEngineTest, require_that_puts_in_feed_batch_are_rejected_if_resource_limit_is_reached)
+{
+    SimpleFixture f;
+    f._writeFilter._acceptWriteOperation = false;
+    f._writeFilter._message = "Disk is full";
+    auto put_done = std::make_unique<storage::spi::CatchResult>();
+    auto put_future = put_done->future_result();
+    auto remove_done = std::make_unique<storage::spi::CatchResult>();
+    auto remove_future = remove_done->future_result();
+    std::vector<BatchedFeedOperation> ops;
+    ops.emplace_back(BatchedFeedOperation::make_put(tstamp1, doc1, std::move(put_done)));
+    ops.emplace_back(BatchedFeedOperation::make_remove(tstamp2, docId1, std::move(remove_done)));
+    f.engine.feedBatchAsync(bucket1, std::move(ops));
+
+    EXPECT_EQ(Result(Result::ErrorType::RESOURCE_EXHAUSTED,
+                     "Put operation rejected for document 'id:type1:type1::1': 'Disk is full'"),
+              *put_future.get());
+    EXPECT_EQ(RemoveResult(false), dynamic_cast<const RemoveResult &>(*remove_future.get()));
+    assertHandler(bucket1, tstamp2, docId1, f.hset.handler1, "handler1 after feed batch");
+}
+
 TEST(PersistenceEngineTest, require_that_listBuckets_is_routed_to_handlers_and_merged)
 {
     SimpleFixture f;
@@ -112,4 +112,42 @@ TEST_F(ReprocessingRunnerTest, require_that_runner_can_be_reset)
     EXPECT_EQ(1.0, _runner.getProgress());
 }
 
+struct EtaTask : public IReprocessingTask
+{
+    ReprocessingRunner &_runner;
+    double _myProgress;
+
+    explicit EtaTask(ReprocessingRunner &runner) noexcept
+        : _runner(runner),
+          _myProgress(0.0)
+    {
+    }
+
+    void run() override {
+        auto now = vespalib::steady_clock::now() + 10s;
+        EXPECT_TRUE(_runner.is_running());
+        EXPECT_EQ(vespalib::duration::zero(), _runner.estimated_time_left(now));
+        _myProgress = 0.5;
+        EXPECT_EQ(_runner.elapsed(now), _runner.estimated_time_left(now));
+        _myProgress = 0.8;
+        EXPECT_EQ(_runner.elapsed(now) / 4, _runner.estimated_time_left(now));
+        EXPECT_LT(10s, _runner.elapsed(now));
+    }
+
+    Progress getProgress() const override {
+        return Progress(_myProgress, 1.0);
+    }
+};
+
+TEST_F(ReprocessingRunnerTest, require_that_time_left_is_estimated_from_progress)
+{
+    auto now = vespalib::steady_clock::now();
+    EXPECT_FALSE(_runner.is_running());
+    EXPECT_EQ(vespalib::duration::zero(), _runner.elapsed(now));
+    _runner.addTasks({std::make_shared<EtaTask>(_runner)});
+    _runner.run();
+    EXPECT_FALSE(_runner.is_running());
+    EXPECT_EQ(vespalib::duration::zero(), _runner.estimated_time_left(now));
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
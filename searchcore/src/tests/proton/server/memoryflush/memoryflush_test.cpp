@@ -37,16 +37,18 @@ private:
     SerialNum     _flushedSerial;
     system_time  _lastFlushTime;
     bool          _urgentFlush;
+    uint64_t      _bytesToWrite;
 public:
     MyFlushTarget(const std::string &name, MemoryGain memoryGain,
                   DiskGain diskGain, SerialNum flushedSerial,
-                  system_time lastFlushTime, bool urgentFlush) noexcept :
+                  system_time lastFlushTime, bool urgentFlush, uint64_t bytesToWrite = 0) noexcept :
         test::DummyFlushTarget(name),
         _memoryGain(memoryGain),
         _diskGain(diskGain),
         _flushedSerial(flushedSerial),
         _lastFlushTime(lastFlushTime),
-        _urgentFlush(urgentFlush)
+        _urgentFlush(urgentFlush),
+        _bytesToWrite(bytesToWrite)
     {
     }
     MemoryGain getApproxMemoryGain() const override { return _memoryGain; }
@@ -54,6 +56,7 @@ public:
     SerialNum getFlushedSerialNum() const override { return _flushedSerial; }
     system_time getLastFlushTime() const override { return _lastFlushTime; }
     bool needUrgentFlush() const override { return _urgentFlush; }
+    uint64_t getApproxBytesToWriteToDisk() const override { return _bytesToWrite; }
 };
 
 using StringList = std::vector<std::string>;
@@ -120,6 +123,12 @@ createTargetM(const std::string &name, MemoryGain memoryGain)
     return std::make_shared<MyFlushTarget>(name, memoryGain, DiskGain(), SerialNum(), system_time(), false);
 }
 
+MyFlushTarget::SP
+createTargetW(const std::string &name, MemoryGain memoryGain, uint64_t bytesToWrite)
+{
+    return std::make_shared<MyFlushTarget>(name, memoryGain, DiskGain(), SerialNum(), system_time(), false, bytesToWrite);
+}
+
 MyFlushTarget::SP
 createTargetD(const std::string &name, DiskGain diskGain, SerialNum serial = 0)
 {
@@ -170,6 +179,23 @@ TEST(MemoryFlushTest, can_order_by_memory_gain)
     }
 }
 
+TEST(MemoryFlushTest, can_order_by_memory_gain_per_written_byte)
+{
+    ContextBuilder cb;
+    cb.add(createTargetW("t1", MemoryGain(40_Mi, 0), 400_Mi))
+      .add(createTargetW("t2", MemoryGain(20_Mi, 0), 20_Mi))
+      .add(createTargetW("t3", MemoryGain(30_Mi, 0), 0))
+      .add(createTargetW("t4", MemoryGain(10_Mi, 0), 50_Mi));
+    { // target t1 has memoryGain >= maxMemoryGain, ordered by memory gain
+        MemoryFlush flush({1_Gi, 20_Gi, 1.0, 40_Mi, 1.0, minutes(1), false});
+        assertOrder({"t1", "t3", "t2", "t4"}, cb.flush_targets(flush));
+    }
+    { // ordered by memory gain per written byte, small writes are counted as 1 MiB
+        MemoryFlush flush({1_Gi, 20_Gi, 1.0, 40_Mi, 1.0, minutes(1), true});
+        assertOrder({"t3", "t2", "t4", "t1"}, cb.flush_targets(flush));
+    }
+}
+
 int64_t milli = 1000000;
 
 TEST(MemoryFlushTest, can_order_by_disk_gain_with_large_values)
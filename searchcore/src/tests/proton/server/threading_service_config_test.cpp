@@ -55,6 +55,32 @@ void assertConfig(uint32_t exp_master_task_limit, uint32_t exp_default_task_limi
 
 }
 
+TEST(ThreadingServiceConfigTest, require_that_commit_batching_is_set)
+{
+    ProtonConfigBuilder builder;
+    builder.feeding.commit.maxdelay = 0.5;
+    builder.feeding.commit.maxoperations = 64;
+    auto tcfg = ThreadingServiceConfig::make(builder);
+    EXPECT_EQ(500ms, tcfg.commit_max_delay());
+    EXPECT_EQ(64u, tcfg.commit_max_operations());
+    auto disabled = Fixture().make();
+    EXPECT_EQ(vespalib::duration::zero(), disabled.commit_max_delay());
+    EXPECT_EQ(0u, disabled.commit_max_operations());
+    EXPECT_FALSE(tcfg == disabled);
+    disabled.update(tcfg);
+    EXPECT_TRUE(tcfg == disabled);
+}
+
+TEST(ThreadingServiceConfigTest, require_that_replay_decode_tasks_is_set)
+{
+    EXPECT_EQ(1u, Fixture().make().replay_decode_tasks());
+    ProtonConfigBuilder builder;
+    builder.feeding.replay.decodetasks = 4;
+    EXPECT_EQ(4u, ThreadingServiceConfig::make(builder).replay_decode_tasks());
+    builder.feeding.replay.decodetasks = 0;
+    EXPECT_EQ(1u, ThreadingServiceConfig::make(builder).replay_decode_tasks());
+}
+
 TEST(ThreadingServiceConfigTest, require_that_config_can_be_somewhat_updated)
 {
     Fixture f1;
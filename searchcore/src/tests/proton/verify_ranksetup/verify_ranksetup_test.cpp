@@ -281,6 +281,19 @@ struct CommonSetup {
         }
         return (process.join() == 0);
     }
+    bool benchmark(const std::string &profile, const std::string &input_json, std::string &output) {
+        generate();
+        std::string input_file = gen_dir + "/benchmark-input.json";
+        Writer(input_file).fmt("%s", input_json.c_str());
+        vespalib::Process process(fmt("%s dir:%s -B %s %s 3", prog, gen_dir.c_str(),
+                                      profile.c_str(), input_file.c_str()),
+                                  true);
+        for (auto line = process.read_line(); !line.empty(); line = process.read_line()) {
+            fprintf(stderr, "> %s\n", line.c_str());
+            output.append(line);
+        }
+        return (process.join() == 0);
+    }
     void verify_valid(std::initializer_list<std::string> features, SearchMode mode = SearchMode::BOTH) {
         for (const std::string &f : features) {
             first_phase(f);
@@ -606,4 +619,35 @@ TEST_F(VerifyRankSetupTest, require_that_zcurve_distance_must_be_backed_by_an_at
 
 //-----------------------------------------------------------------------------
 
+TEST_F(VerifyRankSetupTest, require_that_rank_profile_can_be_benchmarked) {
+    SimpleSetup f;
+    f.query_feature_type("w", "tensor(x[2])");
+    f.first_phase("attribute(date)");
+    f.rank_expr("score", "reduce(query(w)*tensor(x[2]):[1,2],sum)+attribute(date)");
+    f.second_phase("rankingExpression(score)");
+    std::string output;
+    EXPECT_TRUE(f.benchmark("default",
+                            R"json({"query":{"query(w)":"tensor(x[2]):[3,4]"},"documents":[{"date":5},{"date":7}]})json",
+                            output));
+    EXPECT_NE(output.find("\"first_phase\""), std::string::npos);
+    EXPECT_NE(output.find("\"second_phase\""), std::string::npos);
+    EXPECT_NE(output.find("\"allocs_per_doc\""), std::string::npos);
+}
+
+TEST_F(VerifyRankSetupTest, require_that_benchmark_fails_for_unknown_rank_profile) {
+    SimpleSetup f;
+    f.first_phase("attribute(date)");
+    std::string output;
+    EXPECT_FALSE(f.benchmark("unknown", R"({"documents":[{"date":5}]})", output));
+}
+
+TEST_F(VerifyRankSetupTest, require_that_benchmark_fails_without_documents) {
+    SimpleSetup f;
+    f.first_phase("attribute(date)");
+    std::string output;
+    EXPECT_FALSE(f.benchmark("default", R"({"documents":[]})", output));
+}
+
+//-----------------------------------------------------------------------------
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -11,6 +11,8 @@ BmClusterParams::BmClusterParams()
       _distributor_stripes(0),
       _doc_store_chunk_compression_level(9), // Same default as in proton.def
       _doc_store_chunk_maxbytes(65536),      // Same default as in proton.def
+      _document_db_config_dir(),
+      _document_type("test"),
       _enable_distributor(false),
       _enable_service_layer(false),
       _groups(0),
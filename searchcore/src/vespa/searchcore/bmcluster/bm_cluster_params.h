@@ -18,6 +18,8 @@ class BmClusterParams
     uint32_t _distributor_stripes;
     uint32_t _doc_store_chunk_compression_level;
     uint32_t _doc_store_chunk_maxbytes;
+    std::string _document_db_config_dir;
+    std::string _document_type;
     bool     _enable_distributor;
     bool     _enable_service_layer;
     uint32_t _groups;
@@ -46,6 +48,8 @@ public:
     uint32_t get_distributor_stripes() const { return _distributor_stripes; }
     uint32_t get_doc_store_chunk_compression_level() const noexcept { return _doc_store_chunk_compression_level; }
     uint32_t get_doc_store_chunk_maxbytes() const noexcept { return _doc_store_chunk_maxbytes; }
+    const std::string & get_document_db_config_dir() const noexcept { return _document_db_config_dir; }
+    const std::string & get_document_type() const noexcept { return _document_type; }
     bool get_enable_distributor() const { return _enable_distributor; }
     uint32_t get_groups() const noexcept { return _groups; }
     const std::string & get_indexing_sequencer() const { return _indexing_sequencer; }
@@ -72,6 +76,8 @@ public:
     void set_distributor_stripes(uint32_t value) { _distributor_stripes = value; }
     void set_doc_store_chunk_compression_level(uint32_t value) { _doc_store_chunk_compression_level = value; }
     void set_doc_store_chunk_maxbytes(uint32_t value) { _doc_store_chunk_maxbytes = value; }
+    void set_document_db_config_dir(std::string_view dir) { _document_db_config_dir = dir; }
+    void set_document_type(std::string_view document_type) { _document_type = document_type; }
     void set_enable_distributor(bool value) { _enable_distributor = value; }
     void set_enable_service_layer(bool value) { _enable_service_layer = value; }
     void set_groups(uint32_t value);
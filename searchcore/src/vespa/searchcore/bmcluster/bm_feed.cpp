@@ -39,7 +39,7 @@ namespace search::bmcluster {
 BmFeed::BmFeed(std::shared_ptr<const DocumentTypeRepo> repo)
     : _repo(std::move(repo)),
       _document_type(_repo->getDocumentType("test")),
-      _field(_document_type->getField("int")),
+      _field((_document_type != nullptr && _document_type->hasField("int")) ? &_document_type->getField("int") : nullptr),
       _bucket_bits(16),
       _bucket_space(document::test::makeBucketSpace("test"))
 {
@@ -59,18 +59,20 @@ BmFeed::make_document_id(uint32_t n, uint32_t i) const
 std::unique_ptr<Document>
 BmFeed::make_document(uint32_t n, uint32_t i) const
 {
+    assert(_field != nullptr);
     auto id = make_document_id(n, i);
     auto document = std::make_unique<Document>(*_repo, *_document_type, id);
-    document->setFieldValue(_field, IntFieldValue::make(i));
+    document->setFieldValue(*_field, IntFieldValue::make(i));
     return document;
 }
 
 std::unique_ptr<DocumentUpdate>
 BmFeed::make_document_update(uint32_t n, uint32_t i) const
 {
+    assert(_field != nullptr);
     auto id = make_document_id(n, i);
     auto document_update = std::make_unique<DocumentUpdate>(*_repo, *_document_type, id);
-    document_update->addUpdate(FieldUpdate(_field).addUpdate(std::make_unique<AssignValueUpdate>(std::make_unique<IntFieldValue>(15))));
+    document_update->addUpdate(FieldUpdate(*_field).addUpdate(std::make_unique<AssignValueUpdate>(std::make_unique<IntFieldValue>(15))));
     return document_update;
 }
 
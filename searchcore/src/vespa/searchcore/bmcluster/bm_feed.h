@@ -30,12 +30,14 @@ class BmRange;
 class BucketSelector;
 
 /*
- * Class to generate synthetic feed of documents.
+ * Class to generate synthetic feed of documents. The synthetic feed
+ * requires the "test" document type with an "int" field, while the
+ * bucket layout is also used when replaying other document types.
  */
 class BmFeed {
     std::shared_ptr<const document::DocumentTypeRepo> _repo;
     const document::DocumentType*                     _document_type;
-    const document::Field&                            _field;
+    const document::Field*                            _field;
     uint32_t                                          _bucket_bits;
     document::BucketSpace                             _bucket_space;
     vespalib::nbostream make_get_or_remove_feed(BmRange range, BucketSelector bucket_selector, bool make_removes);
@@ -24,6 +24,7 @@
 #include <vespa/searchcore/proton/server/fileconfigmanager.h>
 #include <vespa/searchcore/proton/server/memoryconfigstore.h>
 #include <vespa/searchcore/proton/server/persistencehandlerproxy.h>
+#include <vespa/searchcore/proton/server/searchhandlerproxy.h>
 #include <vespa/searchcore/proton/test/resource_usage_notifier.h>
 #include <vespa/searchcore/proton/test/mock_shared_threading_service.h>
 #include <vespa/searchlib/attribute/interlock.h>
@@ -106,6 +107,7 @@ using vespa::config::search::AttributesConfigBuilder;
 using vespa::config::search::ImportedFieldsConfig;
 using vespa::config::search::IndexschemaConfig;
 using vespa::config::search::RankProfilesConfig;
+using vespa::config::search::RankProfilesConfigBuilder;
 using vespa::config::search::SummaryConfig;
 using vespa::config::search::core::ProtonConfig;
 using vespa::config::search::core::ProtonConfigBuilder;
@@ -161,6 +163,17 @@ std::shared_ptr<AttributesConfig> make_attributes_config() {
     return std::make_shared<AttributesConfig>(builder);
 }
 
+std::shared_ptr<RankProfilesConfig> make_rank_profiles_config() {
+    RankProfilesConfigBuilder builder;
+    builder.rankprofile.resize(1);
+    auto& profile = builder.rankprofile.back();
+    profile.name = "default";
+    profile.fef.property.resize(1);
+    profile.fef.property.back().name = "vespa.rank.firstphase";
+    profile.fef.property.back().value = "attribute(int)";
+    return std::make_shared<RankProfilesConfig>(builder);
+}
+
 std::shared_ptr<DocumentDBConfig> make_document_db_config(std::shared_ptr<DocumenttypesConfig> document_types, std::shared_ptr<const DocumentTypeRepo> repo, const DocTypeName& doc_type_name)
 {
     auto indexschema = std::make_shared<IndexschemaConfig>();
@@ -169,7 +182,7 @@ std::shared_ptr<DocumentDBConfig> make_document_db_config(std::shared_ptr<Docume
     auto schema = DocumentDBConfig::build_schema(*attributes, *indexschema);
     return std::make_shared<DocumentDBConfig>(
             1,
-            std::make_shared<RankProfilesConfig>(),
+            make_rank_profiles_config(),
             std::make_shared<search::fef::RankingConstants>(),
             std::make_shared<search::fef::RankingExpressions>(),
             std::make_shared<search::fef::OnnxModels>(),
@@ -199,10 +212,10 @@ make_slobroks_config(SlobroksConfigBuilder& slobroks, int slobrok_port)
 }
 
 void
-make_bucketspaces_config(BucketspacesConfigBuilder& bucketspaces)
+make_bucketspaces_config(BucketspacesConfigBuilder& bucketspaces, const std::string& document_type)
 {
     BucketspacesConfigBuilder::Documenttype bucket_space_map;
-    bucket_space_map.name = "test";
+    bucket_space_map.name = document_type;
     bucket_space_map.bucketspace = "default";
     bucketspaces.documenttype.emplace_back(std::move(bucket_space_map));
 }
@@ -314,7 +327,7 @@ struct StorageConfigSet
         stor_communicationmanager.rpcport = rpc_port;
 
         stor_status.httpport = status_port;
-        make_bucketspaces_config(bucketspaces);
+        make_bucketspaces_config(bucketspaces, params.get_document_type());
     }
 
     ~StorageConfigSet();
@@ -458,6 +471,8 @@ public:
     std::shared_ptr<BmStorageLinkContext> get_storage_link_context(bool distributor) override;
     bool has_storage_layer(bool distributor) const override;
     PersistenceProvider* get_persistence_provider() override;
+    std::shared_ptr<proton::ISearchHandler> get_search_handler() override;
+    std::shared_ptr<proton::DocumentDB> get_document_db() override;
     void merge_node_stats(std::vector<BmNodeStats>& node_stats, storage::lib::ClusterState &baseline_state) override;
 };
 
@@ -466,8 +481,8 @@ MyBmNode::MyBmNode(const std::string& base_dir, int base_port, uint32_t node_idx
       _cluster(cluster),
       _document_types(std::move(document_types)),
       _repo(document::DocumentTypeRepoFactory::make(*_document_types)),
-      _doc_type_name("test"),
-      _document_db_config(make_document_db_config(_document_types, _repo, _doc_type_name)),
+      _doc_type_name(params.get_document_type()),
+      _document_db_config(params.get_document_db_config_dir().empty() ? make_document_db_config(_document_types, _repo, _doc_type_name) : std::shared_ptr<DocumentDBConfig>()),
       _base_dir(base_dir),
       _file_header_context(),
       _node_idx(node_idx),
@@ -531,11 +546,12 @@ MyBmNode::create_document_db(const BmClusterParams& params)
     std::filesystem::create_directory(std::filesystem::path(_base_dir));
     std::filesystem::create_directory(std::filesystem::path(_base_dir + "/" + _doc_type_name.getName()));
     std::string input_cfg = _base_dir + "/" + _doc_type_name.getName() + "/baseconfig";
-    {
+    if (_document_db_config) {
         proton::FileConfigManager fileCfg(_shared_service.transport(), input_cfg, "", _doc_type_name.getName());
         fileCfg.saveConfig(*_document_db_config, 1);
     }
-    config::DirSpec spec(input_cfg + "/config-1");
+    // A document db config dir (e.g. a config snapshot saved by proton) replaces the generated config
+    config::DirSpec spec(_document_db_config ? (input_cfg + "/config-1") : params.get_document_db_config_dir());
     auto tuneFileDocDB = std::make_shared<TuneFileDocumentDB>();
     proton::DocumentDBConfigHelper mgr(spec, _doc_type_name.getName());
     auto protonCfg = std::make_shared<ProtonConfigBuilder>();
@@ -670,6 +686,18 @@ MyBmNode::get_persistence_provider()
     return _persistence_engine.get();
 }
 
+std::shared_ptr<proton::ISearchHandler>
+MyBmNode::get_search_handler()
+{
+    return std::make_shared<proton::SearchHandlerProxy>(_document_db);
+}
+
+std::shared_ptr<proton::DocumentDB>
+MyBmNode::get_document_db()
+{
+    return _document_db;
+}
+
 void
 MyBmNode::wait_service_layer_slobrok()
 {
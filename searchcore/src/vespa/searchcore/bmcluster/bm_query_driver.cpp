@@ -0,0 +1,167 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bm_query_driver.h"
+#include "bm_cluster.h"
+#include "bm_node.h"
+#include <vespa/searchcore/proton/summaryengine/isearchhandler.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/searchlib/query/tree/querybuilder.h>
+#include <vespa/searchlib/query/tree/simplequery.h>
+#include <vespa/searchlib/query/tree/stackdumpcreator.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/thread_bundle.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
+#include <cassert>
+
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using search::query::QueryBuilder;
+using search::query::Range;
+using search::query::SimpleQueryNodeTypes;
+using search::query::StackDumpCreator;
+using search::query::Weight;
+using vespalib::makeLambdaTask;
+
+namespace search::bmcluster {
+
+namespace {
+
+const std::string field_name("int");
+
+double
+percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()));
+    return sorted[idx];
+}
+
+}
+
+BmQueryDriver::Sample::Sample() noexcept
+    : queries(0),
+      errors(0),
+      elapsed(0.0),
+      p50_ms(0.0),
+      p90_ms(0.0),
+      p99_ms(0.0),
+      max_ms(0.0)
+{
+}
+
+BmQueryDriver::BmQueryDriver(BmCluster& cluster, const BmQueryParams& params, uint32_t documents)
+    : _params(params),
+      _documents(std::max(documents, 1u)),
+      _search_handlers(),
+      _executor(),
+      _stop(false),
+      _lock(),
+      _latencies(),
+      _errors(0),
+      _sample_start(steady_clock::now())
+{
+    for (uint32_t node_idx = 0; node_idx < cluster.get_num_nodes(); ++node_idx) {
+        auto node = cluster.get_node(node_idx);
+        assert(node != nullptr);
+        _search_handlers.emplace_back(node->get_search_handler());
+    }
+}
+
+BmQueryDriver::~BmQueryDriver()
+{
+    stop();
+}
+
+std::string
+BmQueryDriver::make_query(std::mt19937& rng) const
+{
+    uint32_t total_weight = _params.get_term_query_weight() + _params.get_range_query_weight();
+    std::uniform_int_distribution<uint32_t> type_dist(0, total_weight - 1);
+    std::uniform_int_distribution<int64_t> value_dist(0, _documents - 1);
+    int64_t value = value_dist(rng);
+    QueryBuilder<SimpleQueryNodeTypes> builder;
+    if (type_dist(rng) < _params.get_term_query_weight()) {
+        builder.addNumberTerm(std::to_string(value), field_name, 1, Weight(100));
+    } else {
+        builder.addRangeTerm(Range(value, value + _params.get_range_query_width()), field_name, 1, Weight(100));
+    }
+    return StackDumpCreator::create(*builder.build());
+}
+
+void
+BmQueryDriver::query_task(uint32_t thread_idx)
+{
+    auto& search_handler = *_search_handlers[thread_idx % _search_handlers.size()];
+    std::mt19937 rng(thread_idx);
+    while (!_stop.load(std::memory_order_relaxed)) {
+        std::string stack_dump = make_query(rng);
+        SearchRequest request;
+        request.setTimeout(10s);
+        request.ranking = "default";
+        request.maxhits = _params.get_query_hits();
+        request.stackDump.assign(stack_dump.begin(), stack_dump.end());
+        auto start = steady_clock::now();
+        auto reply = search_handler.match(request, vespalib::ThreadBundle::trivial());
+        std::chrono::duration<double, std::milli> latency = steady_clock::now() - start;
+        bool failed = !reply || reply->coverage.wasDegradedByTimeout();
+        std::lock_guard guard(_lock);
+        _latencies.emplace_back(latency.count());
+        if (failed) {
+            ++_errors;
+        }
+    }
+}
+
+void
+BmQueryDriver::start()
+{
+    if (_executor || _search_handlers.empty() || !_params.needs_queries()) {
+        return;
+    }
+    _stop = false;
+    sample();
+    _executor = std::make_unique<vespalib::ThreadStackExecutor>(_params.get_query_threads());
+    for (uint32_t i = 0; i < _params.get_query_threads(); ++i) {
+        _executor->execute(makeLambdaTask([this, i]() { query_task(i); }));
+    }
+}
+
+void
+BmQueryDriver::stop()
+{
+    if (!_executor) {
+        return;
+    }
+    _stop = true;
+    _executor->sync();
+    _executor.reset();
+}
+
+BmQueryDriver::Sample
+BmQueryDriver::sample()
+{
+    std::vector<double> latencies;
+    Sample result;
+    auto now = steady_clock::now();
+    {
+        std::lock_guard guard(_lock);
+        latencies.swap(_latencies);
+        result.errors = _errors;
+        _errors = 0;
+        result.elapsed = std::chrono::duration<double>(now - _sample_start).count();
+        _sample_start = now;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    result.queries = latencies.size();
+    result.p50_ms = percentile(latencies, 0.50);
+    result.p90_ms = percentile(latencies, 0.90);
+    result.p99_ms = percentile(latencies, 0.99);
+    result.max_ms = latencies.empty() ? 0.0 : latencies.back();
+    return result;
+}
+
+}
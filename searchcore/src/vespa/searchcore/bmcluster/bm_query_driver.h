@@ -0,0 +1,63 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "bm_query_params.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace proton { class ISearchHandler; }
+namespace vespalib { class ThreadStackExecutor; }
+
+namespace search::bmcluster {
+
+class BmCluster;
+
+/*
+ * Class driving a query load against the document dbs of the
+ * benchmark nodes while feeding. Each query thread sends queries to a
+ * single node in a closed loop, picking term or range queries on the
+ * "int" attribute according to the query mix in the query params.
+ */
+class BmQueryDriver {
+public:
+    struct Sample {
+        uint64_t queries;
+        uint64_t errors;
+        double   elapsed;
+        double   p50_ms;
+        double   p90_ms;
+        double   p99_ms;
+        double   max_ms;
+        Sample() noexcept;
+        double qps() const { return (elapsed != 0.0) ? (queries / elapsed) : 0.0; }
+    };
+private:
+    using steady_clock = std::chrono::steady_clock;
+
+    BmQueryParams                                        _params;
+    uint32_t                                             _documents;
+    std::vector<std::shared_ptr<proton::ISearchHandler>> _search_handlers;
+    std::unique_ptr<vespalib::ThreadStackExecutor>       _executor;
+    std::atomic<bool>                                    _stop;
+    std::mutex                                           _lock;
+    std::vector<double>                                  _latencies;
+    uint64_t                                             _errors;
+    steady_clock::time_point                             _sample_start;
+
+    std::string make_query(std::mt19937& rng) const;
+    void query_task(uint32_t thread_idx);
+public:
+    BmQueryDriver(BmCluster& cluster, const BmQueryParams& params, uint32_t documents);
+    ~BmQueryDriver();
+    void start();
+    void stop();
+    Sample sample();
+};
+
+}
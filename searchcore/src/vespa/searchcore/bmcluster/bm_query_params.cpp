@@ -0,0 +1,33 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bm_query_params.h"
+#include <iostream>
+
+namespace search::bmcluster {
+
+BmQueryParams::BmQueryParams()
+    : _query_threads(0),
+      _query_hits(10),
+      _term_query_weight(1),
+      _range_query_weight(1),
+      _range_query_width(100)
+{
+}
+
+BmQueryParams::~BmQueryParams() = default;
+
+bool
+BmQueryParams::check() const
+{
+    if (_query_threads > 1024) {
+        std::cerr << "Too many query threads: " << _query_threads << std::endl;
+        return false;
+    }
+    if (needs_queries() && _term_query_weight == 0 && _range_query_weight == 0) {
+        std::cerr << "Query mix is empty, both term and range query weights are 0" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+}
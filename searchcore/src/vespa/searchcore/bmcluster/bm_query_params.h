@@ -0,0 +1,38 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::bmcluster {
+
+/*
+ * Parameters for the query load issued against the benchmark nodes
+ * while feeding. The query mix is given by relative weights of the
+ * supported query types.
+ */
+class BmQueryParams
+{
+    uint32_t _query_threads;
+    uint32_t _query_hits;
+    uint32_t _term_query_weight;
+    uint32_t _range_query_weight;
+    uint32_t _range_query_width;
+public:
+    BmQueryParams();
+    ~BmQueryParams();
+    uint32_t get_query_threads() const { return _query_threads; }
+    uint32_t get_query_hits() const { return _query_hits; }
+    uint32_t get_term_query_weight() const { return _term_query_weight; }
+    uint32_t get_range_query_weight() const { return _range_query_weight; }
+    uint32_t get_range_query_width() const { return _range_query_width; }
+    bool needs_queries() const { return _query_threads > 0; }
+    void set_query_threads(uint32_t threads_in) { _query_threads = threads_in; }
+    void set_query_hits(uint32_t hits_in) { _query_hits = hits_in; }
+    void set_term_query_weight(uint32_t weight_in) { _term_query_weight = weight_in; }
+    void set_range_query_weight(uint32_t weight_in) { _range_query_weight = weight_in; }
+    void set_range_query_width(uint32_t width_in) { _range_query_width = width_in; }
+    bool check() const;
+};
+
+}
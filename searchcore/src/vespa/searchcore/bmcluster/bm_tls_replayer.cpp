@@ -0,0 +1,370 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bm_tls_replayer.h"
+#include "bm_cluster.h"
+#include "bm_feed.h"
+#include "bm_feeder.h"
+#include "bm_node.h"
+#include "i_bm_feed_handler.h"
+#include "pending_tracker.h"
+#include <vespa/document/bucket/bucketidfactory.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/update/documentupdate.h>
+#include <vespa/fnet/transport.h>
+#include <vespa/searchcore/proton/feedoperation/operations.h>
+#include <vespa/searchcore/proton/server/documentdb.h>
+#include <vespa/searchcore/proton/server/executorthreadingservice.h>
+#include <vespa/searchcore/proton/metrics/executor_threading_service_stats.h>
+#include <vespa/searchcore/proton/server/replaypacketdispatcher.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/searchlib/transactionlog/client_session.h>
+#include <vespa/searchlib/transactionlog/translogclient.h>
+#include <vespa/searchlib/transactionlog/translogserver.h>
+#include <vespa/vespalib/util/isequencedtaskexecutor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cinttypes>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".bmcluster.bm_tls_replayer");
+
+using document::BucketIdFactory;
+using document::DocumentTypeRepo;
+using search::SerialNum;
+using search::transactionlog::Packet;
+using search::transactionlog::TransLogServer;
+using search::transactionlog::client::RPC;
+using search::transactionlog::client::TransLogClient;
+using vespalib::makeLambdaTask;
+using namespace std::chrono_literals;
+
+namespace search::bmcluster {
+
+namespace {
+
+constexpr uint32_t num_op_types = static_cast<uint32_t>(BmFeedOperation::REMOVE_OPERATION) + 1;
+
+const char*
+op_type_name(uint32_t op_type)
+{
+    switch (static_cast<BmFeedOperation>(op_type)) {
+    case BmFeedOperation::PUT_OPERATION:
+        return "put";
+    case BmFeedOperation::UPDATE_OPERATION:
+        return "update";
+    case BmFeedOperation::GET_OPERATION:
+        return "get";
+    case BmFeedOperation::REMOVE_OPERATION:
+        return "remove";
+    }
+    return "unknown";
+}
+
+double
+percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()));
+    return sorted[idx];
+}
+
+class NoopStreamHandler : public proton::NewConfigOperation::IStreamHandler {
+public:
+    void serializeConfig(SerialNum, vespalib::nbostream&) override { }
+    void deserializeConfig(SerialNum, vespalib::nbostream& is) override { is.adjustReadPos(is.size()); }
+};
+
+class VisitorCallback : public search::transactionlog::client::Callback
+{
+    proton::ReplayPacketDispatcher _dispatcher;
+    std::atomic<bool>              _eof;
+    std::atomic<bool>              _failed;
+public:
+    VisitorCallback(proton::IReplayPacketHandler& handler)
+        : _dispatcher(handler),
+          _eof(false),
+          _failed(false)
+    {
+    }
+    RPC::Result receive(const Packet& packet) override {
+        vespalib::nbostream_longlivedbuf handle(packet.getHandle().data(), packet.getHandle().size());
+        try {
+            while (handle.size() > 0) {
+                Packet::Entry entry;
+                entry.deserialize(handle);
+                _dispatcher.replayEntry(entry);
+            }
+        } catch (const std::exception& e) {
+            LOG(error, "Error while handling transaction log packet: '%s'", e.what());
+            _failed = true;
+            return RPC::ERROR;
+        }
+        return RPC::OK;
+    }
+    void eof() override { _eof = true; }
+    bool is_eof() const noexcept { return _eof.load(); }
+    bool failed() const noexcept { return _failed.load(); }
+};
+
+/*
+ * Stats for the document db writer executors, summed over all nodes.
+ * Sampling the executor stats resets them.
+ */
+struct WriterStats {
+    vespalib::ExecutorStats index;
+    vespalib::ExecutorStats summary;
+    vespalib::ExecutorStats field_writer;
+    WriterStats();
+    ~WriterStats();
+};
+
+WriterStats::WriterStats()
+    : index(),
+      summary(),
+      field_writer()
+{
+}
+
+WriterStats::~WriterStats() = default;
+
+void
+add_stats(vespalib::ExecutorStats& sum, const vespalib::ExecutorStats& stats, bool first)
+{
+    if (first) {
+        sum = stats;
+    } else {
+        sum.aggregate(stats);
+    }
+}
+
+WriterStats
+sample_writer_stats(BmCluster& cluster)
+{
+    WriterStats result;
+    bool first = true;
+    for (uint32_t node_idx = 0; node_idx < cluster.get_num_nodes(); ++node_idx) {
+        auto node = cluster.get_node(node_idx);
+        auto document_db = (node != nullptr) ? node->get_document_db() : std::shared_ptr<proton::DocumentDB>();
+        if (document_db) {
+            auto& write_service = document_db->getWriteService();
+            auto stats = write_service.getStats();
+            add_stats(result.index, stats.getIndexExecutorStats(), first);
+            add_stats(result.summary, stats.getSummaryExecutorStats(), first);
+            add_stats(result.field_writer, write_service.field_writer().getStats(), first);
+            first = false;
+        }
+    }
+    return result;
+}
+
+}
+
+/*
+ * Receives the operations decoded by proton::ReplayPacketDispatcher
+ * and adds the document operations to the replay feed.
+ */
+class BmTlsReplayer::Loader : public proton::IReplayPacketHandler
+{
+    BmTlsReplayer&    _replayer;
+    BucketIdFactory   _bucket_id_factory;
+    NoopStreamHandler _stream_handler;
+
+    void skip() { ++_replayer._skipped_ops; }
+public:
+    explicit Loader(BmTlsReplayer& replayer)
+        : _replayer(replayer),
+          _bucket_id_factory(),
+          _stream_handler()
+    {
+    }
+    ~Loader() override;
+    void replay(const proton::PutOperation& op) override {
+        const auto& document = *op.getDocument();
+        _replayer.add_op(_bucket_id_factory.getBucketId(document.getId()), op.getTimestamp(), BmFeedOperation::PUT_OPERATION,
+                         [&document](vespalib::nbostream& os) { document.serialize(os); });
+    }
+    void replay(const proton::RemoveOperation& op) override {
+        auto remove_op = dynamic_cast<const proton::RemoveOperationWithDocId*>(&op);
+        if (remove_op == nullptr) {
+            // Removes by gid lack the document id needed by the feed handler
+            skip();
+            return;
+        }
+        const auto& document_id = remove_op->getDocumentId();
+        _replayer.add_op(_bucket_id_factory.getBucketId(document_id), op.getTimestamp(), BmFeedOperation::REMOVE_OPERATION,
+                         [&document_id](vespalib::nbostream& os) {
+                             std::string raw_id = document_id.toString();
+                             os.write(raw_id.c_str(), raw_id.size() + 1);
+                         });
+    }
+    void replay(const proton::UpdateOperation& op) override {
+        const auto& document_update = *op.getUpdate();
+        _replayer.add_op(_bucket_id_factory.getBucketId(document_update.getId()), op.getTimestamp(), BmFeedOperation::UPDATE_OPERATION,
+                         [&document_update](vespalib::nbostream& os) { document_update.serializeHEAD(os); });
+    }
+    void replay(const proton::NoopOperation&) override { skip(); }
+    void replay(const proton::NewConfigOperation&) override { skip(); }
+    void replay(const proton::DeleteBucketOperation&) override { skip(); }
+    void replay(const proton::SplitBucketOperation&) override { skip(); }
+    void replay(const proton::JoinBucketsOperation&) override { skip(); }
+    void replay(const proton::PruneRemovedDocumentsOperation&) override { skip(); }
+    void replay(const proton::MoveOperation&) override { skip(); }
+    void replay(const proton::CreateBucketOperation&) override { skip(); }
+    void replay(const proton::CompactLidSpaceOperation&) override { skip(); }
+    void check_serial_num(search::SerialNum) override { }
+    void optionalCommit(search::SerialNum) override { }
+    proton::feedoperation::IStreamHandler& getNewConfigStreamHandler() override { return _stream_handler; }
+    const DocumentTypeRepo& getDeserializeRepo() override { return *_replayer._repo; }
+};
+
+BmTlsReplayer::Loader::~Loader() = default;
+
+BmTlsReplayer::BmTlsReplayer(std::shared_ptr<const DocumentTypeRepo> repo, BmCluster& cluster, BmFeed& feed, uint32_t client_threads)
+    : _repo(std::move(repo)),
+      _cluster(cluster),
+      _feed(feed),
+      _client_threads(std::max(client_threads, 1u)),
+      _serialized_feed(_client_threads),
+      _ops(_client_threads),
+      _num_ops(0),
+      _skipped_ops(0),
+      _first_timestamp(0)
+{
+}
+
+BmTlsReplayer::~BmTlsReplayer() = default;
+
+void
+BmTlsReplayer::add_op(const document::BucketId& bucket_id, uint64_t timestamp, BmFeedOperation op_type, const std::function<void(vespalib::nbostream&)>& serialize)
+{
+    // Map to the bucket layout used by the benchmark cluster, keeping all operations for a document in the same thread
+    uint32_t n = static_cast<uint32_t>(bucket_id.getRawId());
+    auto feed_bucket_id = _feed.make_bucket_id(n);
+    uint32_t thread_idx = (n & (_feed.num_buckets() - 1)) % _client_threads;
+    auto& os = _serialized_feed[thread_idx];
+    os << static_cast<uint8_t>(op_type);
+    os << feed_bucket_id;
+    serialize(os);
+    if (_num_ops == 0) {
+        _first_timestamp = timestamp;
+    }
+    _ops[thread_idx].emplace_back(timestamp, _num_ops, op_type);
+    ++_num_ops;
+}
+
+bool
+BmTlsReplayer::load(const std::string& tls_dir, const std::string& domain, int listen_port)
+{
+    LOG(info, "Loading transaction log domain '%s' from '%s'", domain.c_str(), tls_dir.c_str());
+    search::index::DummyFileHeaderContext file_header_context;
+    FNET_Transport transport;
+    TransLogServer server(transport, "tls", listen_port, tls_dir, file_header_context);
+    TransLogClient client(transport, vespalib::make_string("tcp/localhost:%d", listen_port));
+    transport.Start();
+    bool ok = true;
+    {
+        Loader loader(*this);
+        VisitorCallback callback(loader);
+        auto visitor = client.createVisitor(domain, callback);
+        if (!visitor || !visitor->visit(0, std::numeric_limits<SerialNum>::max())) {
+            LOG(error, "Visiting transaction log domain '%s' failed", domain.c_str());
+            ok = false;
+        } else {
+            while (!callback.is_eof() && !callback.failed()) {
+                std::this_thread::sleep_for(10ms);
+            }
+            ok = !callback.failed();
+        }
+    }
+    transport.ShutDown(true);
+    LOG(info, "Loaded %u operations from transaction log domain '%s', skipped %u non-document operations",
+        _num_ops, domain.c_str(), _skipped_ops);
+    return ok;
+}
+
+void
+BmTlsReplayer::replay_task(BmFeeder& feeder, uint32_t thread_idx, double rate_scale, steady_clock::time_point start_time, int64_t time_bias, std::vector<std::vector<double>>& latencies, double& max_lag_ms)
+{
+    PendingTracker tracker(1);
+    feeder.get_feed_handler().attach_bucket_info_queue(tracker);
+    vespalib::nbostream is(_serialized_feed[thread_idx].data(), _serialized_feed[thread_idx].size());
+    for (const auto& op : _ops[thread_idx]) {
+        auto now = steady_clock::now();
+        if (rate_scale > 0.0) {
+            uint64_t delta_us = (op.timestamp > _first_timestamp) ? (op.timestamp - _first_timestamp) : 0;
+            auto scheduled = start_time + std::chrono::duration_cast<steady_clock::duration>(std::chrono::duration<double, std::micro>(delta_us / rate_scale));
+            if (scheduled > now) {
+                std::this_thread::sleep_until(scheduled);
+                now = steady_clock::now();
+            } else {
+                max_lag_ms = std::max(max_lag_ms, std::chrono::duration<double, std::milli>(now - scheduled).count());
+            }
+        }
+        feeder.feed_operation(op.op_idx, is, time_bias, tracker);
+        while (tracker.get_pending() > 0) {
+            std::this_thread::yield();
+        }
+        std::chrono::duration<double, std::milli> latency = steady_clock::now() - now;
+        latencies[static_cast<uint32_t>(op.op_type)].emplace_back(latency.count());
+    }
+    assert(is.empty());
+    tracker.drain();
+}
+
+void
+BmTlsReplayer::replay(BmFeeder& feeder, vespalib::ThreadStackExecutor& executor, double rate_scale, int64_t& time_bias)
+{
+    LOG(info, "--------------------------------");
+    if (rate_scale > 0.0) {
+        LOG(info, "replayAsync: %u operations, rate scale=%.3f, client threads=%u", _num_ops, rate_scale, _client_threads);
+    } else {
+        LOG(info, "replayAsync: %u operations, max speed, client threads=%u", _num_ops, _client_threads);
+    }
+    uint32_t old_errors = feeder.get_feed_handler().get_error_count();
+    std::vector<std::vector<std::vector<double>>> latencies(_client_threads, std::vector<std::vector<double>>(num_op_types));
+    std::vector<double> max_lag_ms(_client_threads, 0.0);
+    sample_writer_stats(_cluster);
+    auto start_time = steady_clock::now();
+    for (uint32_t i = 0; i < _client_threads; ++i) {
+        executor.execute(makeLambdaTask([this, &feeder, i, rate_scale, start_time, time_bias, &latencies, &max_lag_ms]()
+                                        { replay_task(feeder, i, rate_scale, start_time, time_bias, latencies[i], max_lag_ms[i]); }));
+    }
+    executor.sync();
+    std::chrono::duration<double> elapsed = steady_clock::now() - start_time;
+    auto writer_stats = sample_writer_stats(_cluster);
+    time_bias += _num_ops;
+    uint32_t new_errors = feeder.get_feed_handler().get_error_count() - old_errors;
+    LOG(info, "replayAsync: %u operations in %5.3f s, ops/s: %8.2f, errors: %u, max schedule lag ms=%.3f",
+        _num_ops, elapsed.count(), _num_ops / elapsed.count(), new_errors, *std::max_element(max_lag_ms.begin(), max_lag_ms.end()));
+    for (uint32_t op_type = 0; op_type < num_op_types; ++op_type) {
+        std::vector<double> merged;
+        for (auto& thread_latencies : latencies) {
+            merged.insert(merged.end(), thread_latencies[op_type].begin(), thread_latencies[op_type].end());
+        }
+        if (merged.empty()) {
+            continue;
+        }
+        std::sort(merged.begin(), merged.end());
+        LOG(info, "replayAsync: %s: %zu ops, ops/s: %8.2f, latency ms p50=%.3f p90=%.3f p99=%.3f max=%.3f",
+            op_type_name(op_type), merged.size(), merged.size() / elapsed.count(),
+            percentile(merged, 0.50), percentile(merged, 0.90), percentile(merged, 0.99), merged.back());
+    }
+    // Attribute and index field writers share the field writer executor
+    LOG(info, "replayAsync: writer tasks/s: field writer (attribute, index fields)=%8.2f, index=%8.2f, docstore (summary)=%8.2f",
+        writer_stats.field_writer.acceptedTasks / elapsed.count(),
+        writer_stats.index.acceptedTasks / elapsed.count(),
+        writer_stats.summary.acceptedTasks / elapsed.count());
+    LOG(info, "replayAsync: writer utilization: field writer=%5.3f, index=%5.3f, docstore (summary)=%5.3f",
+        writer_stats.field_writer.getUtil(), writer_stats.index.getUtil(), writer_stats.summary.getUtil());
+}
+
+}
@@ -0,0 +1,71 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "bm_feed_operation.h"
+#include <vespa/vespalib/objects/nbostream.h>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace document {
+class BucketId;
+class DocumentTypeRepo;
+}
+namespace vespalib { class ThreadStackExecutor; }
+
+namespace search::bmcluster {
+
+class BmCluster;
+class BmFeed;
+class BmFeeder;
+
+/*
+ * Class replaying the document operations in a captured transaction log
+ * domain into a benchmark cluster, either at the original rate, at a
+ * scaled rate or at maximum speed. The transaction log entries are
+ * decoded by proton::ReplayPacketDispatcher and converted to the
+ * serialized feed format used by BmFeeder. Operations are partitioned
+ * on bucket between the client threads, preserving the order of the
+ * operations for each document. Each client thread has a single
+ * operation in flight, to measure the latency per operation type.
+ */
+class BmTlsReplayer {
+    using steady_clock = std::chrono::steady_clock;
+    class Loader;
+
+    struct ReplayOp {
+        uint64_t        timestamp;
+        uint32_t        op_idx;
+        BmFeedOperation op_type;
+        ReplayOp(uint64_t timestamp_in, uint32_t op_idx_in, BmFeedOperation op_type_in) noexcept
+            : timestamp(timestamp_in),
+              op_idx(op_idx_in),
+              op_type(op_type_in)
+        {
+        }
+    };
+
+    std::shared_ptr<const document::DocumentTypeRepo> _repo;
+    BmCluster&                                        _cluster;
+    BmFeed&                                           _feed;
+    uint32_t                                          _client_threads;
+    std::vector<vespalib::nbostream>                  _serialized_feed;
+    std::vector<std::vector<ReplayOp>>                _ops;
+    uint32_t                                          _num_ops;
+    uint32_t                                          _skipped_ops;
+    uint64_t                                          _first_timestamp;
+
+    void add_op(const document::BucketId& bucket_id, uint64_t timestamp, BmFeedOperation op_type, const std::function<void(vespalib::nbostream&)>& serialize);
+    void replay_task(BmFeeder& feeder, uint32_t thread_idx, double rate_scale, steady_clock::time_point start_time, int64_t time_bias, std::vector<std::vector<double>>& latencies, double& max_lag_ms);
+public:
+    BmTlsReplayer(std::shared_ptr<const document::DocumentTypeRepo> repo, BmCluster& cluster, BmFeed& feed, uint32_t client_threads);
+    ~BmTlsReplayer();
+    bool load(const std::string& tls_dir, const std::string& domain, int listen_port);
+    void replay(BmFeeder& feeder, vespalib::ThreadStackExecutor& executor, double rate_scale, int64_t& time_bias);
+    uint32_t get_num_ops() const noexcept { return _num_ops; }
+};
+
+}
@@ -27,6 +27,7 @@ public:
     }
     void retain();
     void drain();
+    uint32_t get_pending() const noexcept { return _pending.load(std::memory_order_acquire); }
 
     void attach_bucket_info_queue(std::atomic<uint32_t>& errors);
     BucketInfoQueue *get_bucket_info_queue() { return _bucket_info_queue.get(); }
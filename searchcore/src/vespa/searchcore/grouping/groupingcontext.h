@@ -7,6 +7,8 @@
 #include <vector>
 #include <atomic>
 
+namespace search::aggregation { class ColumnarGrouping; }
+
 namespace search::grouping {
 
 /**
@@ -112,12 +114,13 @@ public:
     void groupUnordered(const RankedHit *searchResults, uint32_t binSize, const search::BitVector * overflow);
     void groupInRelevanceOrder(const RankedHit *searchResults, uint32_t binSize);
 private:
+    using ColumnarGrouping = search::aggregation::ColumnarGrouping;
     void aggregate(Grouping & grouping, const RankedHit * rankedHit, unsigned int len, const BitVector * bv) const;
     void aggregate(Grouping & grouping, const RankedHit * rankedHit, unsigned int len) const;
-    void aggregate(Grouping & grouping, uint32_t docId, HitRank rank) const;
-    unsigned int aggregateRanked(Grouping & grouping, const RankedHit * rankedHit, unsigned int len) const;
-    void aggregate(Grouping & grouping, const BitVector * bv, unsigned int lidLimit) const;
-    void aggregate(Grouping & grouping, const BitVector * bv, unsigned int , unsigned int topN) const;
+    void aggregate(Grouping & grouping, ColumnarGrouping * columnar, uint32_t docId, HitRank rank) const;
+    unsigned int aggregateRanked(Grouping & grouping, ColumnarGrouping * columnar, const RankedHit * rankedHit, unsigned int len) const;
+    void aggregate(Grouping & grouping, ColumnarGrouping * columnar, const BitVector * bv, unsigned int lidLimit) const;
+    void aggregate(Grouping & grouping, ColumnarGrouping * columnar, const BitVector * bv, unsigned int , unsigned int topN) const;
     const BitVector                & _validLids;
     const std::atomic<steady_time> & _now_ref;
     steady_time                      _timeOfDoom;
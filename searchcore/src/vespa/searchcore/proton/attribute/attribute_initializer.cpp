@@ -15,6 +15,7 @@
 #include <vespa/searchlib/attribute/attribute_header.h>
 #include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/fastos/file.h>
+#include <algorithm>
 #include <cinttypes>
 
 #include <vespa/log/log.h>
@@ -280,4 +281,19 @@ AttributeInitializer::get_transient_memory_usage() const
     return 0u;
 }
 
+uint64_t
+AttributeInitializer::get_estimated_load_size() const
+{
+    if (_header_ok) {
+        return std::max(uint64_t(_header->getNumDocs()), _header->get_total_value_count());
+    }
+    return 0u;
+}
+
+std::string
+AttributeInitializer::get_name() const
+{
+    return "attribute " + _documentSubDbName + "." + _spec.getName();
+}
+
 } // namespace proton
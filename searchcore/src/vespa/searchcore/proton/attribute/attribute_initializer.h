@@ -55,6 +55,9 @@ public:
     AttributeInitializerResult init() const;
     const std::optional<uint64_t>& getCurrentSerialNum() const noexcept { return _currentSerialNum; }
     size_t get_transient_memory_usage() const;
+    // Number of values (or documents if larger) in the saved attribute, 0 if unknown
+    uint64_t get_estimated_load_size() const;
+    std::string get_name() const;
 };
 
 } // namespace proton
@@ -2,16 +2,19 @@
 
 #include "attribute_manager_explorer.h"
 #include "attribute_executor.h"
+#include "attribute_memory_advisor.h"
 #include "attribute_vector_explorer.h"
 #include "i_attribute_manager.h"
 #include "imported_attribute_vector_explorer.h"
 #include "imported_attributes_repo.h"
 #include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/searchlib/attribute/imported_attribute_vector.h>
+#include <vespa/vespalib/data/slime/cursor.h>
 
 using search::AttributeVector;
 using search::attribute::ImportedAttributeVector;
 using vespalib::StateExplorer;
+using vespalib::slime::Cursor;
 using vespalib::slime::Inserter;
 
 namespace proton {
@@ -81,8 +84,29 @@ AttributeManagerExplorer::~AttributeManagerExplorer() = default;
 void
 AttributeManagerExplorer::get_state(const Inserter &inserter, bool full) const
 {
-    (void) full;
-    inserter.insertObject();
+    Cursor& object = inserter.insertObject();
+    if (full) {
+        // Memory advice for all attribute vectors, calculated in the attribute writer threads
+        auto& advice = object.setObject("memory_advice");
+        size_t total_estimated_savings = 0;
+        for (const auto* writable : _mgr->getWritableAttributes()) {
+            auto guard = _mgr->getAttribute(writable->getName());
+            if (!guard || !guard->getSP()) {
+                continue;
+            }
+            AttributeExecutor executor(_mgr, guard->getSP());
+            auto& summary = advice.setObject(writable->getName());
+            executor.run_sync([&executor, &summary, &total_estimated_savings]() {
+                AttributeMemoryAdvisor advisor(executor.get_attr());
+                advisor.to_slime_summary(summary);
+                auto* best = advisor.best_option();
+                if (best != nullptr) {
+                    total_estimated_savings += best->estimated_savings;
+                }
+            });
+        }
+        object.setLong("total_estimated_savings", total_estimated_savings);
+    }
 }
 
 std::vector<std::string>
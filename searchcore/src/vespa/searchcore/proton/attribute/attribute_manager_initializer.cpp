@@ -47,6 +47,12 @@ public:
     size_t get_transient_memory_usage() const override {
         return _initializer->get_transient_memory_usage();
     }
+    uint64_t get_estimated_load_size() const override {
+        return _initializer->get_estimated_load_size();
+    }
+    std::string get_name() const override {
+        return _initializer->get_name();
+    }
 };
 
 class AttributeManagerInitializerTask : public vespalib::Executor::Task
@@ -0,0 +1,204 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "attribute_memory_advisor.h"
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/searchlib/attribute/i_enum_store.h>
+#include <vespa/searchlib/attribute/i_enum_store_dictionary.h>
+#include <vespa/searchlib/util/state_explorer_utils.h>
+#include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/tiered_memory_allocator.h>
+#include <algorithm>
+
+using search::AttributeVector;
+using search::DictionaryConfig;
+using search::StateExplorerUtils;
+using search::attribute::BasicType;
+using search::attribute::Config;
+using vespalib::alloc::TieredMemoryAllocator;
+using vespalib::slime::Cursor;
+
+namespace proton {
+
+namespace {
+
+// Same rules as used when selecting memory allocator for a paged attribute vector
+bool
+can_be_paged(const Config& cfg)
+{
+    if (cfg.basicType() == BasicType::PREDICATE) {
+        return false;
+    }
+    if (cfg.basicType() == BasicType::TENSOR) {
+        return (!cfg.tensorType().is_error() && (cfg.tensorType().is_dense() || !cfg.fastSearch()));
+    }
+    return true;
+}
+
+}
+
+AttributeMemoryAdvisor::Option::Option(std::string name_in, size_t estimated_savings_in, std::string description_in)
+    : name(std::move(name_in)),
+      estimated_savings(estimated_savings_in),
+      description(std::move(description_in))
+{
+}
+
+AttributeMemoryAdvisor::Option::Option(const Option&) = default;
+AttributeMemoryAdvisor::Option::Option(Option&&) noexcept = default;
+AttributeMemoryAdvisor::Option::~Option() = default;
+AttributeMemoryAdvisor::Option& AttributeMemoryAdvisor::Option::operator=(const Option&) = default;
+AttributeMemoryAdvisor::Option& AttributeMemoryAdvisor::Option::operator=(Option&&) noexcept = default;
+
+AttributeMemoryAdvisor::AttributeMemoryAdvisor(const AttributeVector& attr)
+    : _allocated_bytes(attr.getStatus().getAllocated()),
+      _used_bytes(attr.getStatus().getUsed()),
+      _dead_bytes(attr.getStatus().getDead()),
+      _on_hold_bytes(attr.getStatus().getOnHold()),
+      _address_space_component(),
+      _address_space(),
+      _sampled(false),
+      _hot_bytes(0),
+      _cold_bytes(0),
+      _demotions(0),
+      _promotions(0),
+      _options()
+{
+    for (const auto& entry : attr.getAddressSpaceUsage().get_all()) {
+        if (_address_space_component.empty() || _address_space.usage() < entry.second.usage()) {
+            _address_space_component = entry.first;
+            _address_space = entry.second;
+        }
+    }
+    auto* tiered_memory = dynamic_cast<const TieredMemoryAllocator*>(attr.get_memory_allocator().get());
+    if (tiered_memory != nullptr) {
+        auto stats = tiered_memory->get_stats();
+        _sampled = true;
+        _hot_bytes = stats.hot_bytes;
+        _cold_bytes = stats.cold_bytes;
+        _demotions = stats.demotions;
+        _promotions = stats.promotions;
+    }
+    advise_compaction(attr);
+    advise_paging(attr);
+    advise_dictionary(attr);
+}
+
+AttributeMemoryAdvisor::~AttributeMemoryAdvisor() = default;
+
+void
+AttributeMemoryAdvisor::advise_compaction(const AttributeVector& attr)
+{
+    /*
+     * Dead bytes below the max dead bytes ratio in the compaction strategy
+     * are not reclaimed. Compacting more aggressively would reclaim them at
+     * the cost of more frequent compaction.
+     */
+    if (_dead_bytes == 0) {
+        return;
+    }
+    auto& strategy = attr.getConfig().getCompactionStrategy();
+    _options.emplace_back("compaction", _dead_bytes,
+                          "Lower max dead bytes ratio (currently " +
+                          std::to_string(strategy.getMaxDeadBytesRatio()) + ") to reclaim dead bytes");
+}
+
+void
+AttributeMemoryAdvisor::advise_paging(const AttributeVector& attr)
+{
+    /*
+     * With paged memory the resident memory is managed by the page cache.
+     * When access sampling is available, the hot bytes are assumed to stay
+     * resident. Otherwise the estimate is an upper bound.
+     */
+    auto& cfg = attr.getConfig();
+    if (cfg.paged() || !can_be_paged(cfg)) {
+        return;
+    }
+    size_t resident = _allocated_bytes - std::min(_allocated_bytes, _cold_bytes);
+    size_t savings = resident - std::min(resident, _hot_bytes);
+    if (savings == 0) {
+        return;
+    }
+    _options.emplace_back("paged", savings,
+                          _sampled
+                          ? "Use paged memory, estimate assumes that only sampled hot memory stays resident"
+                          : "Use paged memory, estimate is an upper bound since access is not sampled");
+}
+
+void
+AttributeMemoryAdvisor::advise_dictionary(const AttributeVector& attr)
+{
+    /*
+     * An attribute vector with both btree and hash dictionary can drop one
+     * of them. The btree dictionary is needed for range and prefix search,
+     * the hash dictionary gives faster exact lookups.
+     */
+    auto* enum_store = attr.getEnumStoreBase();
+    if (enum_store == nullptr) {
+        return;
+    }
+    auto& dictionary = enum_store->get_dictionary();
+    if (!dictionary.get_has_btree_dictionary() || !dictionary.get_has_hash_dictionary()) {
+        return;
+    }
+    _options.emplace_back("btree_dictionary", dictionary.get_hash_memory_usage().allocatedBytes(),
+                          "Use btree dictionary, exact lookups use the btree");
+    _options.emplace_back("hash_dictionary", dictionary.get_btree_memory_usage().allocatedBytes(),
+                          "Use hash dictionary, only if attribute is not used for range or prefix search");
+}
+
+const AttributeMemoryAdvisor::Option*
+AttributeMemoryAdvisor::best_option() const noexcept
+{
+    auto itr = std::max_element(_options.begin(), _options.end(), [](const Option& lhs, const Option& rhs) noexcept
+                                { return lhs.estimated_savings < rhs.estimated_savings; });
+    return (itr != _options.end()) ? &*itr : nullptr;
+}
+
+void
+AttributeMemoryAdvisor::to_slime(Cursor& object) const
+{
+    object.setLong("allocated_bytes", _allocated_bytes);
+    object.setLong("used_bytes", _used_bytes);
+    object.setLong("dead_bytes", _dead_bytes);
+    object.setLong("on_hold_bytes", _on_hold_bytes);
+    if (!_address_space_component.empty()) {
+        auto& address_space = object.setObject("address_space");
+        address_space.setString("component", _address_space_component);
+        StateExplorerUtils::address_space_to_slime(_address_space, address_space);
+    }
+    auto& access = object.setObject("access");
+    access.setBool("sampled", _sampled);
+    if (_sampled) {
+        access.setLong("hot_bytes", _hot_bytes);
+        access.setLong("cold_bytes", _cold_bytes);
+        access.setLong("demotions", _demotions);
+        access.setLong("promotions", _promotions);
+    }
+    auto& options = object.setArray("options");
+    for (const auto& option : _options) {
+        auto& slime_option = options.addObject();
+        slime_option.setString("name", option.name);
+        slime_option.setLong("estimated_savings", option.estimated_savings);
+        slime_option.setString("description", option.description);
+    }
+}
+
+void
+AttributeMemoryAdvisor::to_slime_summary(Cursor& object) const
+{
+    object.setLong("allocated_bytes", _allocated_bytes);
+    object.setLong("dead_bytes", _dead_bytes);
+    if (!_address_space_component.empty()) {
+        object.setDouble("address_space_usage", _address_space.usage());
+    }
+    auto* best = best_option();
+    if (best != nullptr) {
+        object.setString("best_option", best->name);
+        object.setLong("estimated_savings", best->estimated_savings);
+    }
+}
+
+} // namespace proton
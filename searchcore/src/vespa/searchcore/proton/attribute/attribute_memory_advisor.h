@@ -0,0 +1,75 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/address_space.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace search { class AttributeVector; }
+namespace vespalib::slime { struct Cursor; }
+
+namespace proton {
+
+/**
+ * Class estimating how much memory an attribute vector could save by
+ * changing its memory layout, e.g. compacting more aggressively, using
+ * paged memory or switching dictionary type.
+ *
+ * The estimates are based on the memory usage and address space usage
+ * of the attribute vector, and on the hot/cold access sampling done by
+ * the tiered memory allocator when tiered memory is enabled.
+ *
+ * Must be constructed in the attribute writer thread.
+ */
+class AttributeMemoryAdvisor
+{
+public:
+    struct Option {
+        std::string name;
+        size_t      estimated_savings;
+        std::string description;
+        Option(std::string name_in, size_t estimated_savings_in, std::string description_in);
+        Option(const Option&);
+        Option(Option&&) noexcept;
+        ~Option();
+        Option& operator=(const Option&);
+        Option& operator=(Option&&) noexcept;
+    };
+private:
+    size_t                 _allocated_bytes;
+    size_t                 _used_bytes;
+    size_t                 _dead_bytes;
+    size_t                 _on_hold_bytes;
+    std::string            _address_space_component;
+    vespalib::AddressSpace _address_space;
+    bool                   _sampled;
+    size_t                 _hot_bytes;
+    size_t                 _cold_bytes;
+    uint64_t               _demotions;
+    uint64_t               _promotions;
+    std::vector<Option>    _options;
+
+    void advise_compaction(const search::AttributeVector& attr);
+    void advise_paging(const search::AttributeVector& attr);
+    void advise_dictionary(const search::AttributeVector& attr);
+public:
+    explicit AttributeMemoryAdvisor(const search::AttributeVector& attr);
+    ~AttributeMemoryAdvisor();
+
+    size_t allocated_bytes() const noexcept { return _allocated_bytes; }
+    size_t dead_bytes() const noexcept { return _dead_bytes; }
+    const std::string& address_space_component() const noexcept { return _address_space_component; }
+    const vespalib::AddressSpace& address_space() const noexcept { return _address_space; }
+    bool sampled() const noexcept { return _sampled; }
+    const std::vector<Option>& options() const noexcept { return _options; }
+    // Returns the option with the largest estimated savings, or nullptr if there are no options
+    const Option* best_option() const noexcept;
+    void to_slime(vespalib::slime::Cursor& object) const;
+    // Short form used when reporting advice for all attributes in an attribute manager
+    void to_slime_summary(vespalib::slime::Cursor& object) const;
+};
+
+} // namespace proton
@@ -1,33 +1,42 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "attribute_vector_explorer.h"
+#include "attribute_memory_advisor.h"
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/searchlib/attribute/bitvector_search_cache.h>
 #include <vespa/searchlib/attribute/distance_metric_utils.h>
 #include <vespa/searchlib/attribute/i_enum_store.h>
 #include <vespa/searchlib/attribute/i_enum_store_dictionary.h>
 #include <vespa/searchlib/attribute/ipostinglistattributebase.h>
 #include <vespa/searchlib/attribute/multi_value_mapping.h>
 #include <vespa/searchlib/attribute/singleboolattribute.h>
+#include <vespa/searchlib/attribute/stringbase.h>
 #include <vespa/searchlib/tensor/i_tensor_attribute.h>
 #include <vespa/searchlib/util/state_explorer_utils.h>
 #include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/stllike/cache_stats.h>
+#include <vespa/vespalib/util/tiered_memory_allocator.h>
 
 using search::AddressSpaceUsage;
 using search::AttributeVector;
 using search::IEnumStore;
 using search::SingleBoolAttribute;
 using search::StateExplorerUtils;
+using search::StringAttribute;
 using search::attribute::BasicType;
+using search::attribute::BitVectorSearchCache;
 using search::attribute::CollectionType;
 using search::attribute::Config;
 using search::attribute::DistanceMetricUtils;
 using search::attribute::IAttributeVector;
 using search::attribute::IPostingListAttributeBase;
 using search::attribute::MultiValueMappingBase;
+using search::attribute::SortKeyCache;
 using search::attribute::Status;
 using vespalib::AddressSpace;
 using vespalib::MemoryUsage;
+using vespalib::alloc::TieredMemoryAllocator;
 using namespace vespalib::slime;
 
 namespace proton {
@@ -98,6 +107,46 @@ convertPostingBaseToSlime(const IPostingListAttributeBase &postingBase, Cursor &
     convertMemoryUsageToSlime(memory_usage.btrees, cursor.setObject("btrees"));
     convertMemoryUsageToSlime(memory_usage.short_arrays, cursor.setObject("short_arrays"));
     convertMemoryUsageToSlime(memory_usage.bitvectors, cursor.setObject("bitvectors"));
+    convertMemoryUsageToSlime(memory_usage.compressed, cursor.setObject("compressed"));
+}
+
+void
+convert_tiered_memory_to_slime(const TieredMemoryAllocator& allocator, Cursor& object)
+{
+    auto& policy = allocator.policy();
+    auto& slime_policy = object.setObject("policy");
+    slime_policy.setLong("cold_samples", policy.cold_samples);
+    slime_policy.setLong("min_cold_size", policy.min_cold_size);
+    auto stats = allocator.get_stats();
+    object.setLong("hot_allocations", stats.hot_allocations);
+    object.setLong("hot_bytes", stats.hot_bytes);
+    object.setLong("cold_allocations", stats.cold_allocations);
+    object.setLong("cold_bytes", stats.cold_bytes);
+    object.setLong("demotions", stats.demotions);
+    object.setLong("promotions", stats.promotions);
+}
+
+void
+convert_bitvector_search_cache_to_slime(const BitVectorSearchCache& cache, Cursor& object)
+{
+    auto stats = cache.get_stats();
+    object.setLong("max_memory", cache.max_memory());
+    object.setLong("memory_used", stats.memory_used);
+    object.setLong("elements", stats.elements);
+    object.setLong("hits", stats.hits);
+    object.setLong("misses", stats.misses);
+    object.setLong("invalidations", stats.invalidations);
+}
+
+void
+convert_sort_key_cache_to_slime(const SortKeyCache& cache, Cursor& object)
+{
+    for (const auto& stats : cache.get_stats()) {
+        auto& keys = object.setObject(stats.id);
+        keys.setLong("values", stats.num_values);
+        keys.setLong("memory_used", stats.memory_usage);
+        keys.setLong("misses", stats.misses);
+    }
 }
 
 void
@@ -107,6 +156,7 @@ convert_config_to_slime(const Config& cfg, bool full, Cursor& object)
     object.setBool("fast_search", cfg.fastSearch());
     object.setBool("filter", cfg.getIsFilter());
     object.setBool("paged", cfg.paged());
+    object.setBool("tiered_memory", cfg.tiered_memory());
     if (full) {
         if (cfg.basicType().type() == BasicType::TENSOR) {
             object.setString("distance_metric", DistanceMetricUtils::to_string(cfg.distance_metric()));
@@ -164,6 +214,18 @@ AttributeVectorExplorer::get_state(const vespalib::slime::Inserter &inserter, bo
             convertPostingBaseToSlime(*postingBase, object.setObject("posting_store"));
         }
         convertChangeVectorToSlime(attr, object.setObject("changeVector"));
+        auto* tiered_memory = dynamic_cast<const TieredMemoryAllocator*>(attr.get_memory_allocator().get());
+        if (tiered_memory != nullptr) {
+            convert_tiered_memory_to_slime(*tiered_memory, object.setObject("tiered_memory"));
+        }
+        auto& bitvector_search_cache = attr.get_bitvector_search_cache();
+        if (bitvector_search_cache.max_memory() > 0) {
+            convert_bitvector_search_cache_to_slime(bitvector_search_cache, object.setObject("bitvector_search_cache"));
+        }
+        auto* string_attr = dynamic_cast<const StringAttribute*>(_attr.get());
+        if (string_attr != nullptr && !string_attr->get_sort_key_cache().get_stats().empty()) {
+            convert_sort_key_cache_to_slime(string_attr->get_sort_key_cache(), object.setObject("sort_keys"));
+        }
         auto* single_bool_attr = dynamic_cast<const SingleBoolAttribute*>(_attr.get());
         if (single_bool_attr != nullptr) {
             auto& bvobj = object.setObject("bitvector");
@@ -171,6 +233,7 @@ AttributeVectorExplorer::get_state(const vespalib::slime::Inserter &inserter, bo
             bvobj.setLong("true_bits", bitvector.countTrueBits());
             bvobj.setLong("size", bitvector.size());
         }
+        AttributeMemoryAdvisor(attr).to_slime(object.setObject("memory_advice"));
         object.setLong("committedDocIdLimit", attr.getCommittedDocIdLimit());
         object.setLong("createSerialNum", attr.getCreateSerialNum());
     } else {
@@ -753,13 +753,8 @@ AttributeWriter::update(SerialNum serialNum, const DocumentUpdate &upd, Document
                         const OnWriteDoneType& onWriteDone, IFieldUpdateCallback & onUpdate)
 {
     LOG(debug, "Inspecting update for document %d.", lid);
-    std::vector<std::unique_ptr<BatchUpdateTask>> args;
-    uint32_t numExecutors = _attributeFieldWriter.getNumExecutors();
-    args.reserve(numExecutors);
-    for (uint32_t i(0); i < numExecutors; i++) {
-        args.emplace_back(std::make_unique<BatchUpdateTask>(serialNum, lid));
-        args.back()->_updates.reserve((2*upd.getUpdates().size())/numExecutors);
-    }
+    // Tasks are created on demand, as most updates only touch a few attributes (e.g. counters)
+    std::vector<std::unique_ptr<BatchUpdateTask>> args(_attributeFieldWriter.getNumExecutors());
 
     for (const auto &fupd : upd.getUpdates()) {
         LOG(debug, "Retrieving guard for attribute vector '%s'.", fupd.getField().getName().c_str());
@@ -783,14 +778,18 @@ AttributeWriter::update(SerialNum serialNum, const DocumentUpdate &upd, Document
             _shared_executor.execute(CpuUsage::wrap(std::move(prepare_task), CpuUsage::Category::WRITE));
             _attributeFieldWriter.executeTask(found->second.executor_id, std::move(complete_task));
         } else {
-            args[found->second.executor_id.getId()]->_updates.emplace_back(attrp, &fupd);
+            auto & task = args[found->second.executor_id.getId()];
+            if ( ! task) {
+                task = std::make_unique<BatchUpdateTask>(serialNum, lid);
+            }
+            task->_updates.emplace_back(attrp, &fupd);
             LOG(debug, "About to apply update for docId %u in attribute vector '%s'.", lid, attrp->getName().c_str());
         }
     }
     // NOTE: The lifetime of the field update will be ensured by keeping the document update alive
     // in a operation done context object.
     for (uint32_t id(0); id < args.size(); id++) {
-        if ( ! args[id]->_updates.empty()) {
+        if (args[id]) {
             args[id]->_onWriteDone = onWriteDone;
             _attributeFieldWriter.executeTask(ExecutorId(id), std::move(args[id]));
         }
@@ -24,6 +24,12 @@ BucketSessionBase::extractInfo(const BucketId &bucket, BucketState *&state)
 }
 
 
+BucketState
+BucketSessionBase::subDbState(const BucketId &bucket, SubDbType subDbType) const
+{
+    return _bucketDB->get(bucket).subDbState(subDbType);
+}
+
 bool
 BucketSessionBase::calcFixupNeed(BucketState *state, bool wantActive, bool fixup)
 {
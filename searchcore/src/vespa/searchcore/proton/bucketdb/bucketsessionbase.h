@@ -29,6 +29,11 @@ public:
     BucketSessionBase & operator =(const BucketSessionBase &) = delete;
     ~BucketSessionBase();
     bool extractInfo(const BucketId &bucket, BucketState *&info);
+    /*
+     * Return the part of the current state of the given bucket that belongs
+     * to the given sub database. Deltas are not applied before finish().
+     */
+    BucketState subDbState(const BucketId &bucket, SubDbType subDbType) const;
 
     static bool calcFixupNeed(BucketState *state, bool wantActive, bool fixup);
 };
@@ -45,9 +45,9 @@ BucketState::BucketChecksum
 BucketState::getChecksum() const {
     switch (_checksumType) {
         case ChecksumAggregator::ChecksumType::LEGACY:
-            return LegacyChecksumAggregator::get(_ch._legacy);
+            return LegacyChecksumAggregator::get(LegacyChecksumAggregator::add(_ch[NOTREADY]._legacy, _ch[READY]._legacy));
         case ChecksumAggregator::ChecksumType::XXHASH64:
-            return XXH64ChecksumAggregator::get(_ch._xxh64);
+            return XXH64ChecksumAggregator::get(XXH64ChecksumAggregator::update(_ch[NOTREADY]._xxh64, _ch[READY]._xxh64));
     }
     abort();
 }
@@ -67,17 +67,18 @@ void
 BucketState::add(const GlobalId &gid, const Timestamp &timestamp, uint32_t docSize, SubDbType subDbType)
 {
     assert(subDbType < SubDbType::COUNT);
+    uint32_t subDbTypeIdx = toIdx(subDbType);
     if (subDbType != SubDbType::REMOVED) {
+        Checksum &ch = _ch[subDbTypeIdx];
         switch (_checksumType) {
             case ChecksumAggregator::ChecksumType::LEGACY:
-                _ch._legacy = LegacyChecksumAggregator::addDoc(gid, timestamp, _ch._legacy);
+                ch._legacy = LegacyChecksumAggregator::addDoc(gid, timestamp, ch._legacy);
                 break;
             case ChecksumAggregator::ChecksumType::XXHASH64:
-                _ch._xxh64 = XXH64ChecksumAggregator::update(gid, timestamp, _ch._xxh64);
+                ch._xxh64 = XXH64ChecksumAggregator::update(gid, timestamp, ch._xxh64);
                 break;
         }
     }
-    uint32_t subDbTypeIdx = toIdx(subDbType);
     ++_docCount[subDbTypeIdx];
     _docSizes[subDbTypeIdx] += docSize;
 }
@@ -90,12 +91,13 @@ BucketState::remove(const GlobalId &gid, const Timestamp &timestamp, uint32_t do
     assert(_docCount[subDbTypeIdx] > 0);
     assert(_docSizes[subDbTypeIdx] >= docSize);
     if (subDbType != SubDbType::REMOVED) {
+        Checksum &ch = _ch[subDbTypeIdx];
         switch (_checksumType) {
             case ChecksumAggregator::ChecksumType::LEGACY:
-                _ch._legacy = LegacyChecksumAggregator::removeDoc(gid, timestamp, _ch._legacy);
+                ch._legacy = LegacyChecksumAggregator::removeDoc(gid, timestamp, ch._legacy);
                 break;
             case ChecksumAggregator::ChecksumType::XXHASH64:
-                _ch._xxh64 = XXH64ChecksumAggregator::update(gid, timestamp, _ch._xxh64);
+                ch._xxh64 = XXH64ChecksumAggregator::update(gid, timestamp, ch._xxh64);
                 break;
         }
     }
@@ -114,14 +116,15 @@ BucketState::modify(const GlobalId &gid,
     assert(_docCount[subDbTypeIdx] > 0);
     assert(_docSizes[subDbTypeIdx] >= oldDocSize);
     if (subDbType != SubDbType::REMOVED) {
+        Checksum &ch = _ch[subDbTypeIdx];
         switch (_checksumType) {
             case ChecksumAggregator::ChecksumType::LEGACY:
-                _ch._legacy = LegacyChecksumAggregator::removeDoc(gid, oldTimestamp, _ch._legacy);
-                _ch._legacy = LegacyChecksumAggregator::addDoc(gid, newTimestamp, _ch._legacy);
+                ch._legacy = LegacyChecksumAggregator::removeDoc(gid, oldTimestamp, ch._legacy);
+                ch._legacy = LegacyChecksumAggregator::addDoc(gid, newTimestamp, ch._legacy);
                 break;
             case ChecksumAggregator::ChecksumType::XXHASH64:
-                _ch._xxh64 = XXH64ChecksumAggregator::update(gid, oldTimestamp, _ch._xxh64);
-                _ch._xxh64 = XXH64ChecksumAggregator::update(gid, newTimestamp, _ch._xxh64);
+                ch._xxh64 = XXH64ChecksumAggregator::update(gid, oldTimestamp, ch._xxh64);
+                ch._xxh64 = XXH64ChecksumAggregator::update(gid, newTimestamp, ch._xxh64);
                 break;
         }
     }
@@ -134,8 +137,8 @@ BucketState::empty() const
     if (getReadyCount() != 0 || getRemovedCount() != 0 ||
         getNotReadyCount() != 0)
         return false;
-    assert((_checksumType == ChecksumAggregator::ChecksumType::LEGACY) ? (_ch._legacy == 0) : (_ch._xxh64 == 0));
     for (uint32_t i = 0; i < COUNTS; ++i) {
+        assert((_checksumType == ChecksumAggregator::ChecksumType::LEGACY) ? (_ch[i]._legacy == 0) : (_ch[i]._xxh64 == 0));
         assert(_docSizes[i] == 0);
     }
     return true;
@@ -147,15 +150,14 @@ BucketState::operator+=(const BucketState &rhs)
     for (uint32_t i = 0; i < COUNTS; ++i) {
         _docCount[i] += rhs._docCount[i];
         _docSizes[i] += rhs._docSizes[i];
-    }
-
-    switch (_checksumType) {
-        case ChecksumAggregator::ChecksumType::LEGACY:
-            _ch._legacy = LegacyChecksumAggregator::add(rhs._ch._legacy, _ch._legacy);
-            break;
-        case ChecksumAggregator::ChecksumType::XXHASH64:
-            _ch._xxh64 = XXH64ChecksumAggregator::update(rhs._ch._xxh64, _ch._xxh64);
-            break;
+        switch (_checksumType) {
+            case ChecksumAggregator::ChecksumType::LEGACY:
+                _ch[i]._legacy = LegacyChecksumAggregator::add(rhs._ch[i]._legacy, _ch[i]._legacy);
+                break;
+            case ChecksumAggregator::ChecksumType::XXHASH64:
+                _ch[i]._xxh64 = XXH64ChecksumAggregator::update(rhs._ch[i]._xxh64, _ch[i]._xxh64);
+                break;
+        }
     }
     return *this;
 }
@@ -170,18 +172,30 @@ BucketState::operator-=(const BucketState &rhs)
     for (uint32_t i = 0; i < COUNTS; ++i) {
         _docCount[i] -= rhs._docCount[i];
         _docSizes[i] -= rhs._docSizes[i];
-    }
-    switch (_checksumType) {
-        case ChecksumAggregator::ChecksumType::LEGACY:
-            _ch._legacy = LegacyChecksumAggregator::remove(rhs._ch._legacy, _ch._legacy);
-            break;
-        case ChecksumAggregator::ChecksumType::XXHASH64:
-            _ch._xxh64 = XXH64ChecksumAggregator::update(rhs._ch._xxh64, _ch._xxh64);
-            break;
+        switch (_checksumType) {
+            case ChecksumAggregator::ChecksumType::LEGACY:
+                _ch[i]._legacy = LegacyChecksumAggregator::remove(rhs._ch[i]._legacy, _ch[i]._legacy);
+                break;
+            case ChecksumAggregator::ChecksumType::XXHASH64:
+                _ch[i]._xxh64 = XXH64ChecksumAggregator::update(rhs._ch[i]._xxh64, _ch[i]._xxh64);
+                break;
+        }
     }
     return *this;
 }
 
+BucketState
+BucketState::subDbState(SubDbType subDbType) const
+{
+    assert(subDbType < SubDbType::COUNT);
+    uint32_t subDbTypeIdx = toIdx(subDbType);
+    BucketState state;
+    state._ch[subDbTypeIdx] = _ch[subDbTypeIdx];
+    state._docCount[subDbTypeIdx] = _docCount[subDbTypeIdx];
+    state._docSizes[subDbTypeIdx] = _docSizes[subDbTypeIdx];
+    return state;
+}
+
 
 void
 BucketState::applyDelta(BucketState *src, BucketState *dst) const
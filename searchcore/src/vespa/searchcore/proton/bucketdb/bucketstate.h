@@ -12,6 +12,10 @@ class ChecksumAggregator;
 
 /**
  * Class BucketState represent the known state of a bucket in raw form.
+ *
+ * The checksum is kept separately for each sub database, allowing the part of
+ * a bucket state belonging to a single sub database to be extracted when all its
+ * documents are moved to another bucket, without rehashing every document.
  */
 class BucketState
 {
@@ -26,7 +30,8 @@ private:
     static constexpr uint32_t REMOVED = static_cast<uint32_t>(SubDbType::REMOVED);
     static constexpr uint32_t NOTREADY = static_cast<uint32_t>(SubDbType::NOTREADY);
     static constexpr uint32_t COUNTS = static_cast<uint32_t>(SubDbType::COUNT);
-    union { uint32_t _legacy; uint64_t _xxh64;} _ch;
+    union Checksum { uint32_t _legacy; uint64_t _xxh64;};
+    Checksum _ch[COUNTS];
     size_t   _docSizes[COUNTS];
     uint32_t _docCount[COUNTS];
     bool     _active;
@@ -72,6 +77,8 @@ public:
     bool empty() const;
     BucketState &operator+=(const BucketState &rhs);
     BucketState &operator-=(const BucketState &rhs);
+    // Returns the (inactive) part of this state belonging to the given sub database.
+    BucketState subDbState(SubDbType subDbType) const;
     void applyDelta(BucketState *src, BucketState *dst) const;
     operator storage::spi::BucketInfo() const;
 };
@@ -53,7 +53,8 @@ AllocConfig::make_alloc_strategy(SubDbType sub_db_type) const
         break;
     }
     GrowStrategy grow_strategy(initial_capacity, baseline.getGrowFactor(), baseline.getGrowDelta(), initial_capacity, baseline.getMultiValueAllocGrowFactor());
-    return {grow_strategy, _alloc_strategy.get_compaction_strategy(), _alloc_strategy.get_amortize_count()};
+    return {grow_strategy, _alloc_strategy.get_compaction_strategy(), _alloc_strategy.get_amortize_count(),
+            _alloc_strategy.get_gid_hash_index()};
 }
 
 }
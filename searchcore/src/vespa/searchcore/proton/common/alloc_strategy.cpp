@@ -9,10 +9,19 @@ namespace proton {
 
 AllocStrategy::AllocStrategy(const GrowStrategy& grow_strategy,
                              const CompactionStrategy& compaction_strategy,
-                             uint32_t amortize_count)
+                             uint32_t amortize_count,
+                             bool gid_hash_index)
     : _grow_strategy(grow_strategy),
       _compaction_strategy(compaction_strategy),
-      _amortize_count(amortize_count)
+      _amortize_count(amortize_count),
+      _gid_hash_index(gid_hash_index)
+{
+}
+
+AllocStrategy::AllocStrategy(const GrowStrategy& grow_strategy,
+                             const CompactionStrategy& compaction_strategy,
+                             uint32_t amortize_count)
+    : AllocStrategy(grow_strategy, compaction_strategy, amortize_count, false)
 {
 }
 
@@ -28,12 +37,13 @@ AllocStrategy::operator==(const AllocStrategy &rhs) const noexcept
 {
     return ((_grow_strategy == rhs._grow_strategy) &&
             (_compaction_strategy == rhs._compaction_strategy) &&
-            (_amortize_count == rhs._amortize_count));
+            (_amortize_count == rhs._amortize_count) &&
+            (_gid_hash_index == rhs._gid_hash_index));
 }
 
 std::ostream& operator<<(std::ostream& os, const AllocStrategy&alloc_strategy)
 {
-    os << "{ grow_strategy=" << alloc_strategy.get_grow_strategy() << ", compaction_strategy=" << alloc_strategy.get_compaction_strategy() << ", amortize_count=" << alloc_strategy.get_amortize_count() << "}";
+    os << "{ grow_strategy=" << alloc_strategy.get_grow_strategy() << ", compaction_strategy=" << alloc_strategy.get_compaction_strategy() << ", amortize_count=" << alloc_strategy.get_amortize_count() << ", gid_hash_index=" << (alloc_strategy.get_gid_hash_index() ? "true" : "false") << "}";
     return os;
 }
 
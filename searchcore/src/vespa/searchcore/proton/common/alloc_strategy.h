@@ -20,8 +20,13 @@ protected:
     const search::GrowStrategy       _grow_strategy;
     const CompactionStrategy         _compaction_strategy;
     const uint32_t                   _amortize_count;
+    const bool                       _gid_hash_index; // Use hash index for gid to lid lookups in document meta store
 
 public:
+    AllocStrategy(const search::GrowStrategy& grow_strategy,
+                  const CompactionStrategy& compaction_strategy,
+                  uint32_t amortize_count,
+                  bool gid_hash_index);
     AllocStrategy(const search::GrowStrategy& grow_strategy,
                   const CompactionStrategy& compaction_strategy,
                   uint32_t amortize_count);
@@ -36,6 +41,7 @@ public:
     const search::GrowStrategy& get_grow_strategy() const noexcept { return _grow_strategy; }
     const CompactionStrategy& get_compaction_strategy() const noexcept { return _compaction_strategy; }
     uint32_t get_amortize_count() const noexcept { return _amortize_count; }
+    bool get_gid_hash_index() const noexcept { return _gid_hash_index; }
 };
 
 std::ostream& operator<<(std::ostream& os, const AllocStrategy&alloc_strategy);
@@ -17,6 +17,8 @@ public:
                             const std::string& field,
                             uint32_t attr_guard_index);
 
+    uint32_t attr_guard_index() const noexcept { return _attr_guard_index; }
+
     std::unique_ptr<document::select::Value> getValue(const Context &context) const override;
     std::unique_ptr<document::select::Value> traceValue(const Context &context, std::ostream& out) const override;
     document::select::ValueNode::UP clone() const override;
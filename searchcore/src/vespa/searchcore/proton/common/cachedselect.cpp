@@ -2,6 +2,7 @@
 
 #include "cachedselect.h"
 #include "attributefieldvaluenode.h"
+#include "compiled_select.h"
 #include "select_utils.h"
 #include "selectcontext.h"
 #include "selectpruner.h"
@@ -137,21 +138,41 @@ AttrVisitor::visitFieldValueNode(const FieldValueNode &expr)
 
 CachedSelect::Session::Session(std::unique_ptr<document::select::Node> docSelect,
                                std::unique_ptr<document::select::Node> preDocOnlySelect,
-                               std::unique_ptr<document::select::Node> preDocSelect)
+                               std::unique_ptr<document::select::Node> preDocSelect,
+                               std::unique_ptr<CompiledSelect> compiledPreDocOnlySelect,
+                               std::unique_ptr<CompiledSelect> compiledPreDocSelect)
     : _docSelect(std::move(docSelect)),
       _preDocOnlySelect(std::move(preDocOnlySelect)),
-      _preDocSelect(std::move(preDocSelect))
+      _preDocSelect(std::move(preDocSelect)),
+      _compiledPreDocOnlySelect(std::move(compiledPreDocOnlySelect)),
+      _compiledPreDocSelect(std::move(compiledPreDocSelect))
 {
 }
 
+CachedSelect::Session::~Session() = default;
+
+namespace {
+
+bool
+evaluates_to(const std::unique_ptr<CompiledSelect> &compiled, const document::select::Node &node,
+             const SelectContext &context, const document::select::Result &expected)
+{
+    if (compiled) {
+        return (compiled->contains(context) == expected);
+    }
+    return (node.contains(context) == expected);
+}
+
+}
+
 bool
 CachedSelect::Session::contains_pre_doc(const SelectContext &context) const
 {
-    if (_preDocSelect && (_preDocSelect->contains(context) == document::select::Result::False)) {
+    if (_preDocSelect && evaluates_to(_compiledPreDocSelect, *_preDocSelect, context, document::select::Result::False)) {
         return false;
     }
     return (!_preDocOnlySelect) ||
-            (_preDocOnlySelect && (_preDocOnlySelect->contains(context) == document::select::Result::True));
+            evaluates_to(_compiledPreDocOnlySelect, *_preDocOnlySelect, context, document::select::Result::True);
 }
 
 bool
@@ -264,7 +285,9 @@ CachedSelect::createSession() const
 {
     return std::make_unique<Session>((_docSelect ? _docSelect->clone() : NodeUP()),
                                      (_preDocOnlySelect ? _preDocOnlySelect->clone() : NodeUP()),
-                                     (_preDocSelect ? _preDocSelect->clone() : NodeUP()));
+                                     (_preDocSelect ? _preDocSelect->clone() : NodeUP()),
+                                     (_preDocOnlySelect ? CompiledSelect::compile(*_preDocOnlySelect, _attributes) : nullptr),
+                                     (_preDocSelect ? CompiledSelect::compile(*_preDocSelect, _attributes) : nullptr));
 }
 
 }
@@ -20,6 +20,7 @@ namespace search::attribute { class ReadableAttributeVector; }
 
 namespace proton {
 
+class CompiledSelect;
 class SelectContext;
 class SelectPruner;
 
@@ -37,15 +38,25 @@ public:
         std::unique_ptr<document::select::Node> _docSelect;
         std::unique_ptr<document::select::Node> _preDocOnlySelect;
         std::unique_ptr<document::select::Node> _preDocSelect;
+        // Compiled variants of the pre document selections, if all of the expression can be compiled
+        std::unique_ptr<CompiledSelect> _compiledPreDocOnlySelect;
+        std::unique_ptr<CompiledSelect> _compiledPreDocSelect;
 
     public:
         Session(std::unique_ptr<document::select::Node> docSelect,
                 std::unique_ptr<document::select::Node> preDocOnlySelect,
-                std::unique_ptr<document::select::Node> preDocSelect);
+                std::unique_ptr<document::select::Node> preDocSelect,
+                std::unique_ptr<CompiledSelect> compiledPreDocOnlySelect,
+                std::unique_ptr<CompiledSelect> compiledPreDocSelect);
+        ~Session();
         [[nodiscard]] bool contains_pre_doc(const SelectContext &context) const;
         // Precondition: context must have non-nullptr _doc
         [[nodiscard]] bool contains_doc(const SelectContext &context) const;
         [[nodiscard]] const document::select::Node &selectNode() const;
+        // Should only be used for unit testing
+        [[nodiscard]] bool has_compiled_pre_doc_select() const noexcept {
+            return _compiledPreDocOnlySelect || _compiledPreDocSelect;
+        }
     };
 
     using AttributeVectors = std::vector<std::shared_ptr<search::attribute::ReadableAttributeVector>>;
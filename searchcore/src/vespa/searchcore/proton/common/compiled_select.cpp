@@ -0,0 +1,324 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compiled_select.h"
+#include "attributefieldvaluenode.h"
+#include "selectcontext.h"
+#include <vespa/document/select/branch.h>
+#include <vespa/document/select/compare.h>
+#include <vespa/document/select/constant.h>
+#include <vespa/document/select/context.h>
+#include <vespa/document/select/operator.h>
+#include <vespa/document/select/value.h>
+#include <vespa/document/select/valuenodes.h>
+#include <vespa/searchlib/attribute/attribute_read_guard.h>
+#include <vespa/searchlib/attribute/readable_attribute_vector.h>
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <optional>
+#include <string_view>
+
+namespace proton {
+
+using document::select::And;
+using document::select::ArithmeticValueNode;
+using document::select::Compare;
+using document::select::Constant;
+using document::select::CurrentTimeValueNode;
+using document::select::FloatValue;
+using document::select::FloatValueNode;
+using document::select::FunctionOperator;
+using document::select::IntegerValue;
+using document::select::IntegerValueNode;
+using document::select::Node;
+using document::select::Not;
+using document::select::NullValueNode;
+using document::select::Operator;
+using document::select::Or;
+using document::select::Result;
+using document::select::StringValue;
+using document::select::StringValueNode;
+using document::select::Value;
+using document::select::ValueNode;
+using search::attribute::BasicType;
+using search::attribute::IAttributeVector;
+
+using Program = CompiledSelect::Program;
+
+namespace {
+
+enum class CmpOp { EQ, NE, LT, LE, GT, GE };
+
+/*
+ * The derived operators are combined from < and == exactly as in
+ * document::select::Value, to get the same result for NaN.
+ */
+template <CmpOp op, typename L, typename R>
+const Result &
+compare(const L &lhs, const R &rhs)
+{
+    if constexpr (op == CmpOp::EQ) {
+        return Result::get(lhs == rhs);
+    } else if constexpr (op == CmpOp::NE) {
+        return Result::get(!(lhs == rhs));
+    } else if constexpr (op == CmpOp::LT) {
+        return Result::get(lhs < rhs);
+    } else if constexpr (op == CmpOp::GE) {
+        return Result::get(!(lhs < rhs));
+    } else if constexpr (op == CmpOp::GT) {
+        return Result::get(!(lhs < rhs) && !(lhs == rhs));
+    } else {
+        return Result::get((lhs < rhs) || (lhs == rhs));
+    }
+}
+
+// Result when at least one of the operands is null
+const Result &
+compare_null(CmpOp op, bool both_null)
+{
+    switch (op) {
+    case CmpOp::EQ: return Result::get(both_null);
+    case CmpOp::NE: return Result::get(!both_null);
+    default:        return Result::Invalid;
+    }
+}
+
+struct LoadInt {
+    IAttributeVector::largeint_t operator()(const IAttributeVector &attr, uint32_t docid) const {
+        return attr.getInt(docid);
+    }
+};
+
+struct LoadFloat {
+    double operator()(const IAttributeVector &attr, uint32_t docid) const {
+        return attr.getFloat(docid);
+    }
+};
+
+struct LoadString {
+    std::string_view operator()(const IAttributeVector &attr, uint32_t docid) const {
+        auto raw = attr.get_raw(docid);
+        return {raw.data(), raw.size()};
+    }
+};
+
+template <CmpOp op, bool constant_on_left, typename Load, typename T>
+Program
+make_compare(uint32_t attr_idx, T constant)
+{
+    return [attr_idx, constant = std::move(constant)](const SelectContext &context) -> const Result & {
+        const auto &attr = context.guarded_attribute_at_index(attr_idx);
+        uint32_t docid = context._docId;
+        if (attr.isUndefined(docid)) {
+            return compare_null(op, false);
+        }
+        auto value = Load()(attr, docid);
+        if constexpr (constant_on_left) {
+            return compare<op>(constant, value);
+        } else {
+            return compare<op>(value, constant);
+        }
+    };
+}
+
+template <bool constant_on_left, typename Load, typename T>
+Program
+make_compare(CmpOp op, uint32_t attr_idx, T constant)
+{
+    switch (op) {
+    case CmpOp::EQ: return make_compare<CmpOp::EQ, constant_on_left, Load>(attr_idx, std::move(constant));
+    case CmpOp::NE: return make_compare<CmpOp::NE, constant_on_left, Load>(attr_idx, std::move(constant));
+    case CmpOp::LT: return make_compare<CmpOp::LT, constant_on_left, Load>(attr_idx, std::move(constant));
+    case CmpOp::LE: return make_compare<CmpOp::LE, constant_on_left, Load>(attr_idx, std::move(constant));
+    case CmpOp::GT: return make_compare<CmpOp::GT, constant_on_left, Load>(attr_idx, std::move(constant));
+    case CmpOp::GE: return make_compare<CmpOp::GE, constant_on_left, Load>(attr_idx, std::move(constant));
+    }
+    return {};
+}
+
+template <typename Load, typename T>
+Program
+make_compare(CmpOp op, bool constant_on_left, uint32_t attr_idx, T constant)
+{
+    return constant_on_left
+        ? make_compare<true, Load>(op, attr_idx, std::move(constant))
+        : make_compare<false, Load>(op, attr_idx, std::move(constant));
+}
+
+std::optional<CmpOp>
+map_operator(const Operator &op)
+{
+    if (op == FunctionOperator::EQ) {
+        return CmpOp::EQ;
+    } else if (op == FunctionOperator::NE) {
+        return CmpOp::NE;
+    } else if (op == FunctionOperator::LT) {
+        return CmpOp::LT;
+    } else if (op == FunctionOperator::LEQ) {
+        return CmpOp::LE;
+    } else if (op == FunctionOperator::GT) {
+        return CmpOp::GT;
+    } else if (op == FunctionOperator::GEQ) {
+        return CmpOp::GE;
+    }
+    return std::nullopt;
+}
+
+bool
+is_constant(const ValueNode &node)
+{
+    if (dynamic_cast<const IntegerValueNode *>(&node) != nullptr ||
+        dynamic_cast<const FloatValueNode *>(&node) != nullptr ||
+        dynamic_cast<const StringValueNode *>(&node) != nullptr ||
+        dynamic_cast<const NullValueNode *>(&node) != nullptr ||
+        dynamic_cast<const CurrentTimeValueNode *>(&node) != nullptr)
+    {
+        return true;
+    }
+    const auto *arithmetic = dynamic_cast<const ArithmeticValueNode *>(&node);
+    return (arithmetic != nullptr) && is_constant(arithmetic->getLeft()) && is_constant(arithmetic->getRight());
+}
+
+bool
+is_integer_type(BasicType::Type type)
+{
+    switch (type) {
+    case BasicType::BOOL:
+    case BasicType::UINT2:
+    case BasicType::UINT4:
+    case BasicType::INT8:
+    case BasicType::INT16:
+    case BasicType::INT32:
+    case BasicType::INT64:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Program
+compile_compare(const Compare &node, const CachedSelect::AttributeVectors &attributes)
+{
+    auto op = map_operator(node.getOperator());
+    if (!op.has_value()) {
+        return {};
+    }
+    const auto *attr_node = dynamic_cast<const AttributeFieldValueNode *>(&node.getLeft());
+    const ValueNode *constant_node = &node.getRight();
+    bool constant_on_left = false;
+    if (attr_node == nullptr) {
+        attr_node = dynamic_cast<const AttributeFieldValueNode *>(&node.getRight());
+        constant_node = &node.getLeft();
+        constant_on_left = true;
+    }
+    if (attr_node == nullptr || !is_constant(*constant_node)) {
+        return {};
+    }
+    uint32_t attr_idx = attr_node->attr_guard_index();
+    BasicType::Type type = attributes[attr_idx]->makeReadGuard(false)->attribute()->getBasicType();
+    bool integer_attr = is_integer_type(type);
+    bool float_attr = (type == BasicType::FLOAT) || (type == BasicType::DOUBLE);
+    bool string_attr = (type == BasicType::STRING);
+    if (!integer_attr && !float_attr && !string_attr) {
+        return {};
+    }
+    // Folded once, which also freezes now() for the lifetime of the program
+    auto value = constant_node->getValue(document::select::Context());
+    switch (value->getType()) {
+    case Value::Type::Null:
+        return [attr_idx, cmp = op.value()](const SelectContext &context) -> const Result & {
+            return compare_null(cmp, context.guarded_attribute_at_index(attr_idx).isUndefined(context._docId));
+        };
+    case Value::Type::Integer:
+    {
+        int64_t constant = static_cast<const IntegerValue &>(*value).getValue();
+        if (integer_attr) {
+            return make_compare<LoadInt>(op.value(), constant_on_left, attr_idx, constant);
+        } else if (float_attr) {
+            return make_compare<LoadFloat>(op.value(), constant_on_left, attr_idx, constant);
+        }
+        return {};
+    }
+    case Value::Type::Float:
+    {
+        double constant = static_cast<const FloatValue &>(*value).getValue();
+        if (integer_attr) {
+            return make_compare<LoadInt>(op.value(), constant_on_left, attr_idx, constant);
+        } else if (float_attr) {
+            return make_compare<LoadFloat>(op.value(), constant_on_left, attr_idx, constant);
+        }
+        return {};
+    }
+    case Value::Type::String:
+        if (string_attr) {
+            return make_compare<LoadString>(op.value(), constant_on_left, attr_idx,
+                                            std::string(static_cast<const StringValue &>(*value).getValue()));
+        }
+        return {};
+    default:
+        return {};
+    }
+}
+
+Program
+compile_node(const Node &node, const CachedSelect::AttributeVectors &attributes)
+{
+    if (const auto *and_node = dynamic_cast<const And *>(&node)) {
+        auto left = compile_node(and_node->getLeft(), attributes);
+        auto right = compile_node(and_node->getRight(), attributes);
+        if (!left || !right) {
+            return {};
+        }
+        return [left = std::move(left), right = std::move(right)](const SelectContext &context) -> const Result & {
+            const Result &lhs = left(context);
+            return (lhs == Result::False) ? Result::False : (lhs && right(context));
+        };
+    }
+    if (const auto *or_node = dynamic_cast<const Or *>(&node)) {
+        auto left = compile_node(or_node->getLeft(), attributes);
+        auto right = compile_node(or_node->getRight(), attributes);
+        if (!left || !right) {
+            return {};
+        }
+        return [left = std::move(left), right = std::move(right)](const SelectContext &context) -> const Result & {
+            const Result &lhs = left(context);
+            return (lhs == Result::True) ? Result::True : (lhs || right(context));
+        };
+    }
+    if (const auto *not_node = dynamic_cast<const Not *>(&node)) {
+        auto child = compile_node(not_node->getChild(), attributes);
+        if (!child) {
+            return {};
+        }
+        return [child = std::move(child)](const SelectContext &context) -> const Result & {
+            return !child(context);
+        };
+    }
+    if (const auto *constant_node = dynamic_cast<const Constant *>(&node)) {
+        const Result &result = Result::get(constant_node->getConstantValue());
+        return [&result](const SelectContext &) -> const Result & { return result; };
+    }
+    if (const auto *compare_node = dynamic_cast<const Compare *>(&node)) {
+        return compile_compare(*compare_node, attributes);
+    }
+    return {};
+}
+
+}
+
+CompiledSelect::CompiledSelect(Program program) noexcept
+    : _program(std::move(program))
+{
+}
+
+CompiledSelect::~CompiledSelect() = default;
+
+std::unique_ptr<CompiledSelect>
+CompiledSelect::compile(const Node &node, const CachedSelect::AttributeVectors &attributes)
+{
+    auto program = compile_node(node, attributes);
+    if (!program) {
+        return {};
+    }
+    return std::make_unique<CompiledSelect>(std::move(program));
+}
+
+}
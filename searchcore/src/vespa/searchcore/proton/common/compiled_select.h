@@ -0,0 +1,54 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "cachedselect.h"
+#include <functional>
+#include <memory>
+
+namespace document::select {
+    class Node;
+    class Result;
+}
+
+namespace proton {
+
+class SelectContext;
+
+/**
+ * Selection expression compiled into a tree of closures evaluated
+ * directly on single value attributes, avoiding the allocation of a
+ * document::select::Value per operand and the virtual dispatch on value
+ * type for each document.
+ *
+ * Only expressions consisting of and/or/not, constants and comparisons
+ * (==, !=, <, <=, >, >=) between a single value numeric or string
+ * attribute and a constant expression are compiled. The result for a
+ * document is identical to evaluating the selection tree. Constant
+ * expressions are folded when compiling, i.e. now() is evaluated once
+ * per compiled program.
+ */
+class CompiledSelect
+{
+public:
+    using Result = document::select::Result;
+    using Program = std::function<const Result &(const SelectContext &)>;
+
+private:
+    Program _program;
+
+public:
+    explicit CompiledSelect(Program program) noexcept;
+    ~CompiledSelect();
+
+    // Precondition: context must have valid attribute guards and non-zero _docId
+    const Result &contains(const SelectContext &context) const { return _program(context); }
+
+    /**
+     * Returns nullptr if the selection contains anything that can not be
+     * compiled, in which case the selection tree must be evaluated instead.
+     */
+    static std::unique_ptr<CompiledSelect> compile(const document::select::Node &node,
+                                                   const CachedSelect::AttributeVectors &attributes);
+};
+
+}
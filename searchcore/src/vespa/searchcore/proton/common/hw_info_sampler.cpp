@@ -117,6 +117,7 @@ double measureDiskWriteSpeed(const std::string &path,
 HwInfoSampler::HwInfoSampler(const std::string &path,
                              const Config &config)
     : _hwInfo(),
+      _numa(vespalib::NumaTopology::discover()),
       _sampleTime(),
       _diskWriteSpeed(0.0)
 {
@@ -126,7 +127,7 @@ HwInfoSampler::HwInfoSampler(const std::string &path,
                        (_diskWriteSpeed < config.slowWriteSpeedLimit),
                        config.diskShared),
           HwInfo::Memory(sampleMemorySizeBytes(config, resource_limits)),
-          HwInfo::Cpu(sampleCpuCores(config, resource_limits)));
+          HwInfo::Cpu(sampleCpuCores(config, resource_limits), _numa.num_nodes()));
 }
 
 HwInfoSampler::~HwInfoSampler() = default;
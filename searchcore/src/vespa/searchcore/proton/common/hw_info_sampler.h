@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/vespalib/util/hw_info.h>
+#include <vespa/vespalib/util/numa_topology.h>
 #include <chrono>
 #include <string>
 
@@ -10,7 +11,7 @@ namespace proton {
 
 /*
  * Class detecting some hardware characteristics on the machine, e.g.
- * speed of sequential write to file.
+ * speed of sequential write to file and NUMA topology.
  */
 class HwInfoSampler
 {
@@ -44,6 +45,7 @@ public:
 
 private:
     vespalib::HwInfo _hwInfo;
+    vespalib::NumaTopology _numa;
     using Clock = std::chrono::system_clock;
     Clock::time_point _sampleTime;
     double _diskWriteSpeed;
@@ -56,6 +58,7 @@ public:
     ~HwInfoSampler();
 
     const vespalib::HwInfo &hwInfo() const { return _hwInfo; }
+    const vespalib::NumaTopology &numa() const { return _numa; }
     std::chrono::time_point<Clock> sampleTime() const { return _sampleTime; }
     double diskWriteSpeed() const { return _diskWriteSpeed; }
 };
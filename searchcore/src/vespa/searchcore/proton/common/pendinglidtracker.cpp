@@ -8,61 +8,96 @@ namespace proton {
 PendingLidTrackerBase::PendingLidTrackerBase() = default;
 PendingLidTrackerBase::~PendingLidTrackerBase() = default;
 
-ILidCommitState::State
-PendingLidTrackerBase::waitState(State state, uint32_t lid) const {
-    MonitorGuard guard(_mutex);
-    return waitFor(guard, state, lid);
+PendingLidTracker::Shard::Shard()
+    : _mutex(),
+      _cond(),
+      _pending(),
+      _num_pending(0u)
+{
+}
+
+PendingLidTracker::Shard::~Shard() {
+    assert(_pending.empty());
 }
 
 ILidCommitState::State
-PendingLidTrackerBase::waitState(State state, const LidList & lids) const {
-    MonitorGuard guard(_mutex);
-    State lowest = State::COMPLETED;
-    for (uint32_t lid : lids) {
-        State next = waitFor(guard, state, lid);
-        if ((state == State::NEED_COMMIT) && next == state) {
-            return next;
+PendingLidTracker::Shard::waitFor(MonitorGuard & guard, State state, uint32_t lid) const {
+    for (auto found = _pending.find(lid); found != _pending.end(); found = _pending.find(lid)) {
+        if (state == State::NEED_COMMIT) {
+            return State::WAITING;
         }
-        lowest = std::min(next, lowest);
+        _cond.wait(guard);
     }
-    return lowest;
+    return State::COMPLETED;
 }
 
 PendingLidTracker::PendingLidTracker() = default;
 
-PendingLidTracker::~PendingLidTracker() {
-    assert(_pending.empty());
-}
+PendingLidTracker::~PendingLidTracker() = default;
 
 IPendingLidTracker::Token
 PendingLidTracker::produce(uint32_t lid) {
-    std::lock_guard guard(_mutex);
-    _pending[lid]++;
+    Shard & s = shard(lid);
+    std::lock_guard guard(s._mutex);
+    auto & count = s._pending[lid];
+    if (count++ == 0) {
+        s._num_pending.store(s._pending.size(), std::memory_order_release);
+    }
     return Token(lid, *this);
 }
+
 void
 PendingLidTracker::consume(uint32_t lid) {
-    std::lock_guard guard(_mutex);
-    auto found = _pending.find(lid);
-    assert (found != _pending.end());
+    Shard & s = shard(lid);
+    std::lock_guard guard(s._mutex);
+    auto found = s._pending.find(lid);
+    assert (found != s._pending.end());
     assert (found->second > 0);
     if (found->second == 1) {
-        _pending.erase(found);
-        _cond.notify_all();
+        s._pending.erase(found);
+        s._num_pending.store(s._pending.size(), std::memory_order_release);
+        s._cond.notify_all();
     } else {
         found->second--;
     }
 }
 
 ILidCommitState::State
-PendingLidTracker::waitFor(MonitorGuard & guard, State state, uint32_t lid) const {
-    for (auto found = _pending.find(lid); found != _pending.end(); found = _pending.find(lid)) {
-        if (state == State::NEED_COMMIT) {
-            return State::WAITING;
+PendingLidTracker::waitState(State state, uint32_t lid) const {
+    const Shard & s = shard(lid);
+    if (s._num_pending.load(std::memory_order_acquire) == 0u) {
+        return State::COMPLETED;
+    }
+    Shard::MonitorGuard guard(s._mutex);
+    return s.waitFor(guard, state, lid);
+}
+
+ILidCommitState::State
+PendingLidTracker::waitState(State state, const LidList & lids) const {
+    // Batch the lids per shard to take each shard mutex at most once
+    std::array<LidList, NUM_SHARDS> lids_per_shard;
+    for (uint32_t lid : lids) {
+        uint32_t shard_id = lid % NUM_SHARDS;
+        if (_shards[shard_id]._num_pending.load(std::memory_order_acquire) != 0u) {
+            lids_per_shard[shard_id].push_back(lid);
         }
-        _cond.wait(guard);
     }
-    return State::COMPLETED;
+    State lowest = State::COMPLETED;
+    for (uint32_t shard_id = 0; shard_id < NUM_SHARDS; ++shard_id) {
+        if (lids_per_shard[shard_id].empty()) {
+            continue;
+        }
+        const Shard & s = _shards[shard_id];
+        Shard::MonitorGuard guard(s._mutex);
+        for (uint32_t lid : lids_per_shard[shard_id]) {
+            State next = s.waitFor(guard, state, lid);
+            if ((state == State::NEED_COMMIT) && next == state) {
+                return next;
+            }
+            lowest = std::min(next, lowest);
+        }
+    }
+    return lowest;
 }
 
 PendingLidTrackerBase::Snapshot
@@ -4,6 +4,8 @@
 
 #include "ipendinglidtracker.h"
 #include <vespa/vespalib/stllike/hash_map.h>
+#include <array>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 
@@ -27,21 +29,17 @@ public:
     };
     using Snapshot = std::unique_ptr<Payload>;
     virtual Snapshot produceSnapshot() = 0;
-
-    State waitState(State state, uint32_t lid) const override;
-    State waitState(State state, const LidList & lids) const override;
 protected:
-    using MonitorGuard = std::unique_lock<std::mutex>;
     PendingLidTrackerBase();
-    virtual State waitFor(MonitorGuard & guard, State state, uint32_t lid) const = 0;
-    MonitorGuard getGuard() { return MonitorGuard(_mutex); }
-    mutable std::mutex                     _mutex;
-    mutable std::condition_variable        _cond;
 };
 
 /**
  * Use for tracking lids when visibility-delay is zero and commit is implicit.
  * In this case lids go directly to WAITING and the second phase is a noop.
+ *
+ * The lids are spread over a set of shards, each with its own mutex and condition
+ * variable, to avoid serializing feed threads producing and consuming different lids.
+ * Checking a shard without pending lids does not take its mutex.
  */
 class PendingLidTracker : public PendingLidTrackerBase
 {
@@ -51,10 +49,24 @@ public:
     Token produce(uint32_t lid) override;
     Snapshot produceSnapshot() override;
 private:
+    static constexpr uint32_t NUM_SHARDS = 16;
+    struct alignas(64) Shard {
+        using MonitorGuard = std::unique_lock<std::mutex>;
+        mutable std::mutex                     _mutex;
+        mutable std::condition_variable        _cond;
+        vespalib::hash_map<uint32_t, uint32_t> _pending;
+        std::atomic<uint32_t>                  _num_pending; // Number of lids in _pending
+        Shard();
+        ~Shard();
+        State waitFor(MonitorGuard & guard, State state, uint32_t lid) const;
+    };
     void consume(uint32_t lid) override;
-    State waitFor(MonitorGuard & guard, State state, uint32_t lid) const override;
+    State waitState(State state, uint32_t lid) const override;
+    State waitState(State state, const LidList & lids) const override;
+    Shard & shard(uint32_t lid) noexcept { return _shards[lid % NUM_SHARDS]; }
+    const Shard & shard(uint32_t lid) const noexcept { return _shards[lid % NUM_SHARDS]; }
 
-    vespalib::hash_map<uint32_t, uint32_t> _pending;
+    std::array<Shard, NUM_SHARDS> _shards;
 };
 
 }
@@ -6,8 +6,10 @@
 #include <vespa/searchlib/attribute/iattributemanager.h>
 #include <vespa/searchlib/common/location.h>
 #include <vespa/searchlib/common/matching_elements.h>
+#include <vespa/vespalib/data/slime/inject.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/thread_bundle.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.docsummary.docsumcontext");
@@ -18,7 +20,9 @@ using std::string;
 using vespalib::slime::SymbolTable;
 using vespalib::slime::NIX;
 using vespalib::Memory;
+using vespalib::slime::ArrayInserter;
 using vespalib::slime::Cursor;
+using vespalib::slime::Inspector;
 using vespalib::slime::Symbol;
 using vespalib::slime::Inserter;
 using vespalib::slime::ObjectSymbolInserter;
@@ -42,6 +46,71 @@ Memory TYPE("type");
 Memory MESSAGE("message");
 Memory TIMEOUT("timeout");
 
+// Minimum number of hits for each partition when generating docsums in parallel
+constexpr size_t MIN_HITS_PER_PARTITION = 8;
+
+}
+
+/**
+ * A range of hits with its own state and slime, used when generating
+ * docsums in parallel. Features and matching elements are shared with the
+ * state of the docsum context.
+ **/
+class DocsumContext::Partition : public GetDocsumsStateCallback,
+                                 public vespalib::Runnable
+{
+private:
+    DocsumContext          & _ctx;
+    const ResolveClassInfo & _rci;
+    size_t                   _begin;
+    size_t                   _end;
+    GetDocsumsState          _state;
+    Slime                    _slime;
+    uint32_t                 _num_ok;
+public:
+    Partition(DocsumContext & ctx, const ResolveClassInfo & rci, size_t begin, size_t end);
+    ~Partition() override;
+    void run() override;
+    // Returns an array with the docsums generated for this partition
+    const Inspector & docsums() const { return _slime.get(); }
+    bool complete() const noexcept { return _num_ok == (_end - _begin); }
+
+    void fillSummaryFeatures(GetDocsumsState& state) override { _ctx.shareSummaryFeatures(state); }
+    void fillRankFeatures(GetDocsumsState& state) override { _ctx.shareRankFeatures(state); }
+    std::unique_ptr<MatchingElements> fill_matching_elements(const MatchingElementsFields &) override {
+        return _ctx.shareMatchingElements();
+    }
+};
+
+DocsumContext::Partition::Partition(DocsumContext & ctx, const ResolveClassInfo & rci, size_t begin, size_t end)
+    : _ctx(ctx),
+      _rci(rci),
+      _begin(begin),
+      _end(end),
+      _state(*this),
+      _slime(Slime::Params(std::min(0x200000ul, (end - begin)*0x400ul))),
+      _num_ok(0)
+{
+    _ctx.initPartitionState(_state, _rci);
+}
+
+DocsumContext::Partition::~Partition() = default;
+
+void
+DocsumContext::Partition::run()
+{
+    Cursor & array = _slime.setArray();
+    const Symbol docsumSym = _slime.insert(DOCSUM);
+    for (size_t i = _begin; i < _end; ++i) {
+        if (_ctx._request.expired()) { break; }
+        uint32_t docId = _ctx._docsumState._docsumbuf[i];
+        Cursor &docSumC = array.addObject();
+        ObjectSymbolInserter inserter(docSumC, docsumSym);
+        if (docId != search::endDocId) {
+            _ctx._docsumWriter.insertDocsum(_rci, docId, _state, _ctx._docsumStore, inserter);
+        }
+        _num_ok++;
+    }
 }
 
 void
@@ -62,6 +131,87 @@ DocsumContext::initState()
     }
 }
 
+void
+DocsumContext::initPartitionState(GetDocsumsState & state, const ResolveClassInfo & rci)
+{
+    state.query_normalization(this);
+    const GetDocsumArgs & args = _docsumState._args;
+    state._args.initFromDocsumRequest(_request);
+    state._args.setStackDump(args.getStackDump().size(), args.getStackDump().data());
+    state._args.setTimeout(args.getTimeout());
+    state._args.locations_possible(args.locations_possible());
+    _docsumWriter.initState(_attrMgr, state, rci);
+    state._omit_summary_features = _docsumState._omit_summary_features;
+}
+
+size_t
+DocsumContext::getNumPartitions(const ResolveClassInfo & rci) const
+{
+    if (rci.res_class == nullptr) {
+        return 1;
+    }
+    size_t numPartitions = std::min(_threadBundle.size(), _docsumState._docsumbuf.size() / MIN_HITS_PER_PARTITION);
+    return std::max(size_t(1), numPartitions);
+}
+
+uint32_t
+DocsumContext::insertDocsumsInParallel(const ResolveClassInfo & rci, size_t numPartitions, Cursor & array)
+{
+    const size_t numHits = _docsumState._docsumbuf.size();
+    std::vector<std::unique_ptr<Partition>> partitions;
+    std::vector<vespalib::Runnable *> targets;
+    partitions.reserve(numPartitions);
+    targets.reserve(numPartitions);
+    for (size_t i = 0; i < numPartitions; ++i) {
+        partitions.push_back(std::make_unique<Partition>(*this, rci, (numHits * i) / numPartitions,
+                                                         (numHits * (i + 1)) / numPartitions));
+        targets.push_back(partitions.back().get());
+    }
+    _threadBundle.run(targets);
+    // Docsums are matched with hits by position, stop after the first partition that timed out
+    uint32_t num_ok(0);
+    for (const auto & partition : partitions) {
+        const Inspector & docsums = partition->docsums();
+        for (size_t i = 0; i < docsums.entries(); ++i) {
+            vespalib::slime::inject(docsums[i], ArrayInserter(array));
+        }
+        num_ok += docsums.entries();
+        if ( ! partition->complete()) {
+            break;
+        }
+    }
+    return num_ok;
+}
+
+void
+DocsumContext::shareSummaryFeatures(GetDocsumsState & state)
+{
+    std::lock_guard guard(_lock);
+    state._summaryFeatures = _docsumState._summaryFeatures;
+    if ( ! state._summaryFeatures) {
+        _docsumState.get_summary_features();
+        state._summaryFeatures = _docsumState._summaryFeatures;
+    }
+}
+
+void
+DocsumContext::shareRankFeatures(GetDocsumsState & state)
+{
+    std::lock_guard guard(_lock);
+    if ( ! _rankFeaturesFilled) {
+        fillRankFeatures(_docsumState);
+        _rankFeaturesFilled = true;
+    }
+    state._rankFeatures = _docsumState._rankFeatures;
+}
+
+std::unique_ptr<MatchingElements>
+DocsumContext::shareMatchingElements()
+{
+    std::lock_guard guard(_lock);
+    return std::make_unique<MatchingElements>(_docsumState.get_matching_elements());
+}
+
 vespalib::Slime::UP
 DocsumContext::createSlimeReply()
 {
@@ -74,15 +224,31 @@ DocsumContext::createSlimeReply()
     Cursor & array = root.setArray(DOCSUMS);
     const Symbol docsumSym = response->insert(DOCSUM);
     _docsumState._omit_summary_features = (rci.res_class == nullptr) || rci.res_class->omit_summary_features();
+    if ((rci.res_class != nullptr) && ! rci.all_fields_generated && (_docsumState._docsumbuf.size() > 1)) {
+        // Read all documents in one batch instead of one by one when generating each docsum
+        std::vector<uint32_t> docIds;
+        docIds.reserve(_docsumState._docsumbuf.size());
+        for (uint32_t docId : _docsumState._docsumbuf) {
+            if (docId != search::endDocId) {
+                docIds.push_back(docId);
+            }
+        }
+        _docsumStore.prefetch(docIds);
+    }
     uint32_t num_ok(0);
-    for (uint32_t docId : _docsumState._docsumbuf) {
-        if (_request.expired() ) { break; }
-        Cursor &docSumC = array.addObject();
-        ObjectSymbolInserter inserter(docSumC, docsumSym);
-        if ((docId != search::endDocId) && rci.res_class != nullptr) {
-            _docsumWriter.insertDocsum(rci, docId, _docsumState, _docsumStore, inserter);
+    const size_t numPartitions = getNumPartitions(rci);
+    if (numPartitions > 1) {
+        num_ok = insertDocsumsInParallel(rci, numPartitions, array);
+    } else {
+        for (uint32_t docId : _docsumState._docsumbuf) {
+            if (_request.expired() ) { break; }
+            Cursor &docSumC = array.addObject();
+            ObjectSymbolInserter inserter(docSumC, docsumSym);
+            if ((docId != search::endDocId) && rci.res_class != nullptr) {
+                _docsumWriter.insertDocsum(rci, docId, _docsumState, _docsumStore, inserter);
+            }
+            num_ok++;
         }
-        num_ok++;
     }
     if (num_ok != _docsumState._docsumbuf.size()) {
         const uint32_t numTimedOut = _docsumState._docsumbuf.size() - num_ok;
@@ -98,7 +264,8 @@ DocsumContext::createSlimeReply()
 DocsumContext::DocsumContext(const DocsumRequest & request, IDocsumWriter & docsumWriter,
                              IDocsumStore & docsumStore, std::shared_ptr<Matcher> matcher,
                              ISearchContext & searchCtx, IAttributeContext & attrCtx,
-                             const IAttributeManager & attrMgr, SessionManager & sessionMgr) :
+                             const IAttributeManager & attrMgr, SessionManager & sessionMgr,
+                             vespalib::ThreadBundle & threadBundle) :
     _request(request),
     _docsumWriter(docsumWriter),
     _docsumStore(docsumStore),
@@ -107,11 +274,16 @@ DocsumContext::DocsumContext(const DocsumRequest & request, IDocsumWriter & docs
     _attrCtx(attrCtx),
     _attrMgr(attrMgr),
     _docsumState(*this),
-    _sessionMgr(sessionMgr)
+    _sessionMgr(sessionMgr),
+    _threadBundle(threadBundle),
+    _lock(),
+    _rankFeaturesFilled(false)
 {
     initState();
 }
 
+DocsumContext::~DocsumContext() = default;
+
 DocsumReply::UP
 DocsumContext::getDocsums()
 {
@@ -6,6 +6,9 @@
 #include <vespa/searchsummary/docsummary/docsumwriter.h>
 #include <vespa/searchlib/engine/docsumrequest.h>
 #include <vespa/searchlib/engine/docsumreply.h>
+#include <mutex>
+
+namespace vespalib { struct ThreadBundle; }
 
 namespace proton {
 
@@ -18,11 +21,20 @@ namespace matching {
 /**
  * The DocsumContext class is responsible for performing a docsum request and
  * creating a docsum reply.
+ *
+ * When the thread bundle has more than one thread and there are enough hits,
+ * the hits are partitioned across the threads. Each partition generates its
+ * docsums using a separate state and slime, and the results are copied into
+ * the reply in hit order. Summary features, rank features and matching
+ * elements are calculated once and shared between the partitions.
  **/
 class DocsumContext : public search::docsummary::GetDocsumsStateCallback,
                       public search::QueryNormalization
 {
 private:
+    class Partition;
+    using ResolveClassInfo = search::docsummary::IDocsumWriter::ResolveClassInfo;
+
     const search::engine::DocsumRequest  & _request;
     search::docsummary::IDocsumWriter    & _docsumWriter;
     search::docsummary::IDocsumStore     & _docsumStore;
@@ -32,8 +44,17 @@ private:
     const search::IAttributeManager      & _attrMgr;
     search::docsummary::GetDocsumsState    _docsumState;
     matching::SessionManager             & _sessionMgr;
+    vespalib::ThreadBundle               & _threadBundle;
+    std::mutex                             _lock;
+    bool                                   _rankFeaturesFilled;
 
     void initState();
+    void initPartitionState(search::docsummary::GetDocsumsState & state, const ResolveClassInfo & rci);
+    size_t getNumPartitions(const ResolveClassInfo & rci) const;
+    uint32_t insertDocsumsInParallel(const ResolveClassInfo & rci, size_t numPartitions, vespalib::slime::Cursor & array);
+    void shareSummaryFeatures(search::docsummary::GetDocsumsState & state);
+    void shareRankFeatures(search::docsummary::GetDocsumsState & state);
+    std::unique_ptr<search::MatchingElements> shareMatchingElements();
     std::unique_ptr<vespalib::Slime> createSlimeReply();
 
 public:
@@ -46,7 +67,9 @@ public:
                   matching::ISearchContext & searchCtx,
                   search::attribute::IAttributeContext & attrCtx,
                   const search::IAttributeManager & attrMgr,
-                  matching::SessionManager & sessionMgr);
+                  matching::SessionManager & sessionMgr,
+                  vespalib::ThreadBundle & threadBundle);
+    ~DocsumContext() override;
 
     search::engine::DocsumReply::UP getDocsums();
 
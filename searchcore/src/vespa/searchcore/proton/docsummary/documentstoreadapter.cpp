@@ -6,6 +6,7 @@
 #include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/eval/eval/value_codec.h>
 #include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/document/fieldvalue/tensorfieldvalue.h>
 
 #include <vespa/log/log.h>
@@ -16,11 +17,28 @@ using namespace search::docsummary;
 
 namespace proton {
 
+namespace {
+
+class PrefetchVisitor : public search::IDocumentVisitor {
+public:
+    explicit PrefetchVisitor(vespalib::hash_map<uint32_t, search::IDocumentStore::DocumentUP> & documents) noexcept
+        : _documents(documents)
+    { }
+    void visit(uint32_t lid, DocumentUP doc) override { _documents[lid] = std::move(doc); }
+    bool allowVisitCaching() const override { return false; }
+private:
+    vespalib::hash_map<uint32_t, search::IDocumentStore::DocumentUP> & _documents;
+};
+
+}
+
 DocumentStoreAdapter::
 DocumentStoreAdapter(const search::IDocumentStore & docStore,
                      const DocumentTypeRepo &repo)
     : _docStore(docStore),
-      _repo(repo)
+      _repo(repo),
+      _lock(),
+      _prefetched()
 {
 }
 
@@ -29,7 +47,20 @@ DocumentStoreAdapter::~DocumentStoreAdapter() = default;
 std::unique_ptr<const IDocsumStoreDocument>
 DocumentStoreAdapter::get_document(uint32_t docId)
 {
-    auto document = _docStore.read(docId, _repo);
+    search::IDocumentStore::DocumentUP document;
+    bool prefetched = false;
+    {
+        std::lock_guard guard(_lock);
+        auto found = _prefetched.find(docId);
+        if (found != _prefetched.end()) {
+            document = std::move(found->second);
+            _prefetched.erase(found);
+            prefetched = true;
+        }
+    }
+    if ( ! prefetched) {
+        document = _docStore.read(docId, _repo);
+    }
     if ( ! document) {
         LOG(debug, "Did not find summary document for docId %u. Returning empty docsum", docId);
         return {};
@@ -38,4 +69,12 @@ DocumentStoreAdapter::get_document(uint32_t docId)
     return std::make_unique<DocsumStoreDocument>(std::move(document));
 }
 
+void
+DocumentStoreAdapter::prefetch(const std::vector<uint32_t>& docIds)
+{
+    std::lock_guard guard(_lock);
+    PrefetchVisitor visitor(_prefetched);
+    _docStore.readMany(docIds, _repo, visitor);
+}
+
 } // namespace proton
@@ -4,6 +4,8 @@
 
 #include <vespa/searchsummary/docsummary/docsumstore.h>
 #include <vespa/searchlib/docstore/idocumentstore.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <mutex>
 
 namespace proton {
 
@@ -12,6 +14,8 @@ class DocumentStoreAdapter : public search::docsummary::IDocsumStore
 private:
     const search::IDocumentStore           & _docStore;
     const document::DocumentTypeRepo       & _repo;
+    std::mutex                               _lock;
+    vespalib::hash_map<uint32_t, search::IDocumentStore::DocumentUP> _prefetched;
 
 public:
     DocumentStoreAdapter(const search::IDocumentStore &docStore,
@@ -19,6 +23,7 @@ public:
     ~DocumentStoreAdapter() override;
 
     std::unique_ptr<const search::docsummary::IDocsumStoreDocument> get_document(uint32_t docId) override;
+    void prefetch(const std::vector<uint32_t>& docIds) override;
 };
 
 } // namespace proton
@@ -7,6 +7,7 @@
 #include <vespa/searchsummary/docsummary/docsumwriter.h>
 #include <vespa/searchsummary/docsummary/idocsumenvironment.h>
 #include <vespa/searchsummary/docsummary/resultconfig.h>
+#include <vespa/vespalib/stllike/cache_stats.h>
 
 namespace document { class DocumentTypeRepo; }
 namespace search::index { class Schema; }
@@ -51,6 +52,7 @@ public:
                        const search::index::Schema& schema) = 0;
 
     virtual search::IDocumentStore &getBackingStore() = 0;
+    virtual vespalib::CacheStats get_rendered_docsum_cache_stats() const { return {}; }
 protected:
     ISummaryManager() = default;
 };
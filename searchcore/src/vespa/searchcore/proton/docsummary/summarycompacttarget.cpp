@@ -87,6 +87,18 @@ SummaryGCTarget::getApproxDiskGain() const
     return DiskGain(total, total - std::min(total, getBloat(_docStore)));
 }
 
+uint64_t
+SummaryGCTarget::getApproxBytesToWriteToDisk() const
+{
+    return getCompactionCost(_docStore).bytesToWrite;
+}
+
+uint64_t
+SummaryGCTarget::get_approx_bytes_to_read_from_disk() const noexcept
+{
+    return getCompactionCost(_docStore).bytesToRead;
+}
+
 IFlushTarget::Time
 SummaryGCTarget::getLastFlushTime() const
 {
@@ -120,6 +132,11 @@ SummaryCompactBloatTarget::getBloat(const search::IDocumentStore & docStore) con
     return docStore.getDiskBloat();
 }
 
+search::DataStoreCompactionCost
+SummaryCompactBloatTarget::getCompactionCost(const IDocumentStore & docStore) const {
+    return docStore.getApproxCompactionCost(true);
+}
+
 FlushTask::UP
 SummaryCompactBloatTarget::create(IDocumentStore & docStore, FlushStats & stats, SerialNum currSerial) {
     return std::make_unique<CompactBloat>(docStore, stats, currSerial);
@@ -135,6 +152,11 @@ SummaryCompactSpreadTarget::getBloat(const search::IDocumentStore & docStore) co
     return docStore.getMaxSpreadAsBloat();
 }
 
+search::DataStoreCompactionCost
+SummaryCompactSpreadTarget::getCompactionCost(const IDocumentStore & docStore) const {
+    return docStore.getApproxCompactionCost(false);
+}
+
 FlushTask::UP
 SummaryCompactSpreadTarget::create(IDocumentStore & docStore, FlushStats & stats, SerialNum currSerial) {
     return std::make_unique<CompactSpread>(docStore, stats, currSerial);
@@ -24,12 +24,14 @@ public:
     Task::UP initFlush(SerialNum currentSerial, std::shared_ptr<search::IFlushToken> flush_token) override;
 
     FlushStats getLastFlushStats() const override { return _lastStats; }
-    uint64_t getApproxBytesToWriteToDisk() const override { return 0; }
+    uint64_t getApproxBytesToWriteToDisk() const override;
+    uint64_t get_approx_bytes_to_read_from_disk() const noexcept override;
 protected:
     SummaryGCTarget(const std::string &, vespalib::Executor & summaryService, IDocumentStore & docStore);
 private:
 
     virtual size_t getBloat(const IDocumentStore & docStore) const = 0;
+    virtual search::DataStoreCompactionCost getCompactionCost(const IDocumentStore & docStore) const = 0;
     virtual Task::UP create(IDocumentStore & docStore, FlushStats & stats, SerialNum currSerial) = 0;
 
     vespalib::Executor  &_summaryService;
@@ -43,6 +45,7 @@ private:
 class SummaryCompactBloatTarget : public SummaryGCTarget {
 private:
     size_t getBloat(const search::IDocumentStore & docStore) const override;
+    search::DataStoreCompactionCost getCompactionCost(const IDocumentStore & docStore) const override;
     Task::UP create(IDocumentStore & docStore, FlushStats & stats, SerialNum currSerial) override;
 public:
     SummaryCompactBloatTarget(vespalib::Executor & summaryService, IDocumentStore & docStore);
@@ -55,6 +58,7 @@ public:
 class SummaryCompactSpreadTarget : public SummaryGCTarget {
 private:
     size_t getBloat(const search::IDocumentStore & docStore) const override;
+    search::DataStoreCompactionCost getCompactionCost(const IDocumentStore & docStore) const override;
     Task::UP create(IDocumentStore & docStore, FlushStats & stats, SerialNum currSerial) override;
 public:
     SummaryCompactSpreadTarget(vespalib::Executor & summaryService, IDocumentStore & docStore);
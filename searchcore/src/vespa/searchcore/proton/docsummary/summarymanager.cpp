@@ -12,6 +12,7 @@
 #include <vespa/searchsummary/docsummary/docsum_field_writer_factory.h>
 #include <vespa/searchsummary/docsummary/i_query_term_filter.h>
 #include <vespa/searchsummary/docsummary/query_term_filter_factory.h>
+#include <vespa/searchsummary/docsummary/rendered_docsum_cache.h>
 #include <vespa/searchsummary/docsummary/struct_fields_mapper.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/fastlib/text/normwordfolder.h>
@@ -92,7 +93,8 @@ SummarySetup(const std::string & baseDir, const SummaryConfig & summaryCfg,
              const JuniperrcConfig & juniperCfg,
              search::IAttributeManager::SP attributeMgr, search::IDocumentStore::SP docStore,
              std::shared_ptr<const DocumentTypeRepo> repo,
-             const search::index::Schema& schema)
+             const search::index::Schema& schema,
+             std::shared_ptr<RenderedDocsumCache> renderedDocsumCache)
     : _docsumWriter(),
       _wordFolder(std::make_unique<Fast_NormalizeWordFolder>()),
       _juniperProps(juniperCfg),
@@ -118,6 +120,7 @@ SummarySetup(const std::string & baseDir, const SummaryConfig & summaryCfg,
     docsum_field_writer_factory.reset();
 
     _docsumWriter = std::make_unique<DynamicDocsumWriter>(std::move(resultConfig));
+    _docsumWriter->set_rendered_docsum_cache(std::move(renderedDocsumCache));
 }
 
 IDocsumStore::UP
@@ -134,7 +137,7 @@ SummaryManager::createSummarySetup(const SummaryConfig & summaryCfg,
                                    const search::index::Schema& schema)
 {
     return std::make_shared<SummarySetup>(_baseDir, summaryCfg,
-                                          juniperCfg, attributeMgr, _docStore, repo, schema);
+                                          juniperCfg, attributeMgr, _docStore, repo, schema, _renderedDocsumCache);
 }
 
 SummaryManager::SummaryManager(vespalib::Executor &shared_executor, const LogDocumentStore::Config & storeConfig,
@@ -143,8 +146,12 @@ SummaryManager::SummaryManager(vespalib::Executor &shared_executor, const LogDoc
                                const FileHeaderContext &fileHeaderContext, search::transactionlog::SyncProxy &tlSyncer,
                                search::IBucketizer::SP bucketizer)
     : _baseDir(baseDir),
-      _docStore()
+      _docStore(),
+      _renderedDocsumCache()
 {
+    if (storeConfig.getMaxRenderedCacheBytes() > 0) {
+        _renderedDocsumCache = std::make_shared<RenderedDocsumCache>(storeConfig.getMaxRenderedCacheBytes());
+    }
     _docStore = std::make_shared<LogDocumentStore>(shared_executor, baseDir, storeConfig, growStrategy, tuneFileSummary,
                                                    fileHeaderContext, tlSyncer, std::move(bucketizer));
 }
@@ -202,6 +209,15 @@ void
 SummaryManager::reconfigure(const LogDocumentStore::Config & config) {
     auto & docStore = dynamic_cast<LogDocumentStore &> (*_docStore);
     docStore.reconfigure(config);
+    if (_renderedDocsumCache) {
+        _renderedDocsumCache->set_max_bytes(config.getMaxRenderedCacheBytes());
+    }
+}
+
+vespalib::CacheStats
+SummaryManager::get_rendered_docsum_cache_stats() const
+{
+    return _renderedDocsumCache ? _renderedDocsumCache->get_stats() : vespalib::CacheStats();
 }
 
 } // namespace proton
@@ -11,6 +11,7 @@
 #include <vespa/document/fieldvalue/document.h>
 
 namespace search { class IBucketizer; }
+namespace search::docsummary { class RenderedDocsumCache; }
 namespace search::common { class FileHeaderContext; }
 
 class Fast_NormalizeWordFolder;
@@ -36,7 +37,8 @@ public:
                      search::IAttributeManager::SP attributeMgr,
                      search::IDocumentStore::SP docStore,
                      std::shared_ptr<const document::DocumentTypeRepo> repo,
-                     const search::index::Schema& schema);
+                     const search::index::Schema& schema,
+                     std::shared_ptr<search::docsummary::RenderedDocsumCache> renderedDocsumCache);
 
         search::docsummary::IDocsumWriter & getDocsumWriter() const override { return *_docsumWriter; }
         const search::docsummary::ResultConfig & getResultConfig() override { return *_docsumWriter->GetResultConfig(); }
@@ -50,6 +52,7 @@ public:
 private:
     std::string               _baseDir;
     std::shared_ptr<search::IDocumentStore> _docStore;
+    std::shared_ptr<search::docsummary::RenderedDocsumCache> _renderedDocsumCache;
 
 public:
     using SP = std::shared_ptr<SummaryManager>;
@@ -76,6 +79,14 @@ public:
                        const search::index::Schema& schema) override;
 
     search::IDocumentStore & getBackingStore() override { return *_docStore; }
+    vespalib::CacheStats get_rendered_docsum_cache_stats() const override;
+    /**
+     * The cache of rendered docsums shared by all summary setups, if enabled. The feed view
+     * must invalidate a lid when an operation changing the document has completed.
+     */
+    const std::shared_ptr<search::docsummary::RenderedDocsumCache> & get_rendered_docsum_cache() const noexcept {
+        return _renderedDocsumCache;
+    }
     void reconfigure(const search::LogDocumentStore::Config & config);
 };
 
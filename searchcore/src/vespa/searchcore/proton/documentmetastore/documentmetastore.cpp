@@ -5,6 +5,7 @@
 #include "operation_listener.h"
 #include "search_context.h"
 #include "document_meta_store_versions.h"
+#include "gid_to_lid_hash_index.h"
 #include <vespa/fastos/file.h>
 #include <vespa/persistence/spi/bucket_limits.h>
 #include <vespa/searchcommon/attribute/config.h>
@@ -35,6 +36,7 @@ using document::BucketId;
 using document::GlobalId;
 using proton::bucketdb::BucketState;
 using proton::bucketdb::RemoveBatchEntry;
+using proton::documentmetastore::GidToLidHashIndex;
 using proton::documentmetastore::GidToLidMapKey;
 using search::AttributeVector;
 using search::FileReader;
@@ -189,6 +191,9 @@ DocumentMetaStore::insert(GidToLidMapKey key, const RawDocumentMetaData &metaDat
     // flush writes to meta store rcu vector before new entry is visible
     // from frozen root or lid based scan
     std::atomic_thread_fence(std::memory_order_release);
+    if (_gidHashIndex) {
+        _gidHashIndex->insert(lid);
+    }
     _lidAlloc.registerLid(lid);
     updateUncommittedDocIdLimit(lid);
     _changesSinceCommit++;
@@ -238,6 +243,9 @@ DocumentMetaStore::onUpdateStat()
     auto gid_to_lid_map_memory_usage = _gidToLidMap.getMemoryUsage();
     _should_compact_gid_to_lid_map = compaction_strategy.should_compact_memory(gid_to_lid_map_memory_usage);
     usage.merge(gid_to_lid_map_memory_usage);
+    if (_gidHashIndex) {
+        usage.merge(_gidHashIndex->get_memory_usage());
+    }
     // the free lists are not taken into account here
     updateStatistics(_metaDataStore.size(),
                      _metaDataStore.size(),
@@ -252,6 +260,9 @@ DocumentMetaStore::before_inc_generation(generation_t current_gen)
 {
     _gidToLidMap.getAllocator().freeze();
     _gidToLidMap.getAllocator().assign_generation(current_gen);
+    if (_gidHashIndex) {
+        _gidHashIndex->assign_generation(current_gen);
+    }
     getGenerationHolder().assign_generation(current_gen);
     updateStat(false);
 }
@@ -260,6 +271,9 @@ void
 DocumentMetaStore::reclaim_memory(generation_t oldest_used_gen)
 {
     _gidToLidMap.getAllocator().reclaim_memory(oldest_used_gen);
+    if (_gidHashIndex) {
+        _gidHashIndex->reclaim_memory(oldest_used_gen);
+    }
     _lidAlloc.reclaim_memory(oldest_used_gen);
     getGenerationHolder().reclaim(oldest_used_gen);
 }
@@ -326,6 +340,11 @@ DocumentMetaStore::onLoad(vespalib::Executor *)
     _gidToLidMap.getAllocator().freeze(); // create initial frozen tree
     generation_t generation = getGenerationHandler().getCurrentGeneration();
     _gidToLidMap.getAllocator().assign_generation(generation);
+    if (_gidHashIndex) {
+        for (auto itr = _gidToLidMap.begin(); itr.valid(); ++itr) {
+            _gidHashIndex->insert(itr.getKey().get_lid());
+        }
+    }
 
     setNumDocs(_metaDataStore.size());
     setCommittedDocIdLimit(_metaDataStore.size());
@@ -423,10 +442,12 @@ DocumentMetaStore::DocumentMetaStore(BucketDBOwnerSP bucketDB, const std::string
 DocumentMetaStore::DocumentMetaStore(BucketDBOwnerSP bucketDB,
                                      const std::string &name,
                                      const GrowStrategy &grow,
-                                     SubDbType subDbType)
+                                     SubDbType subDbType,
+                                     bool gidHashIndex)
     : DocumentMetaStoreAttribute(name),
       _metaDataStore(grow, getGenerationHolder()),
       _gidToLidMap(),
+      _gidHashIndex(gidHashIndex ? std::make_unique<GidToLidHashIndex>(_metaDataStore) : nullptr),
       _gid_to_lid_map_write_itr(vespalib::datastore::EntryRef(), _gidToLidMap.getAllocator()),
       _gid_to_lid_map_write_itr_prepare_serial_num(0u),
       _lidAlloc(_metaDataStore.size(), _metaDataStore.capacity(), getGenerationHolder()),
@@ -459,6 +480,16 @@ DocumentMetaStore::Result
 DocumentMetaStore::inspectExisting(const GlobalId &gid, uint64_t prepare_serial_num)
 {
     Result res;
+    if (_gidHashIndex) {
+        DocId lid = _gidHashIndex->find(gid);
+        _gid_to_lid_map_write_itr_prepare_serial_num = 0u; // write iterator is not positioned
+        if (lid != 0u) {
+            res.setLid(lid);
+            res.fillPrev(_metaDataStore[lid].getTimestamp());
+            res.markSuccess();
+        }
+        return res;
+    }
     KeyComp comp(gid, get_unbound_meta_data_view());
     auto find_key = GidToLidMapKey::make_find_key(gid);
     auto& itr = _gid_to_lid_map_write_itr;
@@ -478,6 +509,18 @@ DocumentMetaStore::inspect(const GlobalId &gid, uint64_t prepare_serial_num)
 {
     assert(_lidAlloc.isFreeListConstructed());
     Result res;
+    if (_gidHashIndex) {
+        DocId lid = _gidHashIndex->find(gid);
+        _gid_to_lid_map_write_itr_prepare_serial_num = 0u; // write iterator is not positioned
+        if (lid == 0u) {
+            res.setLid(peekFreeLid());
+        } else {
+            res.setLid(lid);
+            res.fillPrev(_metaDataStore[lid].getTimestamp());
+        }
+        res.markSuccess();
+        return res;
+    }
     KeyComp comp(gid, get_unbound_meta_data_view());
     auto find_key = GidToLidMapKey::make_find_key(gid);
     auto& itr = _gid_to_lid_map_write_itr;
@@ -502,6 +545,14 @@ DocumentMetaStore::put(const GlobalId &gid, const BucketId &bucketId, Timestamp
 {
     Result res;
     RawDocumentMetaData metaData(gid, bucketId, storage::spi::Timestamp(timestamp), docSize);
+    if (_gidHashIndex && (_gidHashIndex->find(gid) == lid)) {
+        // Existing document, the gid to lid btree is not changed
+        res.setLid(lid);
+        res.fillPrev(_metaDataStore[lid].getTimestamp());
+        updateMetaDataAndBucketDB(gid, lid, metaData);
+        res.markSuccess();
+        return res;
+    }
     KeyComp comp(metaData, get_unbound_meta_data_view());
     auto find_key = GidToLidMapKey::make_find_key(gid);
     auto& itr = _gid_to_lid_map_write_itr;
@@ -590,6 +641,9 @@ DocumentMetaStore::removeInternal(DocId lid, uint64_t prepare_serial_num)
                         lid, gid.toString().c_str()));
     }
     _gidToLidMap.remove(itr);
+    if (_gidHashIndex) {
+        _gidHashIndex->remove(lid);
+    }
     _lidAlloc.unregisterLid(lid);
     return _metaDataStore[lid];
 }
@@ -639,6 +693,9 @@ DocumentMetaStore::move(DocId fromLid, DocId toLid, uint64_t prepare_serial_num)
     assert(itr.getKey().get_lid() == fromLid);
     _gidToLidMap.thaw(itr);
     itr.writeKey(GidToLidMapKey(toLid, find_key.get_gid_key()));
+    if (_gidHashIndex) {
+        _gidHashIndex->move(fromLid, toLid);
+    }
     _lidAlloc.moveLidEnd(fromLid, toLid);
     _changesSinceCommit++;
 }
@@ -670,6 +727,9 @@ DocumentMetaStore::remove_batch_internal_btree(std::vector<LidAndRawDocumentMeta
                             lid, gid.toString().c_str()));
         }
         _gidToLidMap.remove(itr);
+        if (_gidHashIndex) {
+            _gidHashIndex->remove(lid);
+        }
     }
 }
 
@@ -886,6 +946,13 @@ DocumentMetaStore::handleSplit(const bucketdb::SplitBucketSession &session)
         }
     }
 
+    // When splitting into both children, every document ends up in one of the targets.
+    // The delta for target2 is then what remains of the source, saving the checksum
+    // computation for the documents moved there.
+    bool deriveDelta2 = target1.valid() && target2.valid() &&
+                        (target1.getUsedBits() == source.getUsedBits() + 1) &&
+                        (target2.getUsedBits() == source.getUsedBits() + 1);
+    uint32_t movedToTarget2 = 0;
     TreeType::Iterator itr = lowerBound(source);
     TreeType::Iterator end = upperBound(source);
     bucketdb::BucketDeltaPair deltas;
@@ -912,13 +979,22 @@ DocumentMetaStore::handleSplit(const bucketdb::SplitBucketSession &session)
                                    _subDbType);
             } else if (target2.valid() && t2 == target2) {
                 metaData.setBucketUsedBits(target2.getUsedBits());
-                deltas._delta2.add(metaData.getGid(),
-                                   metaData.getTimestamp(),
-                                   metaData.getDocSize(),
-                                   _subDbType);
+                if (deriveDelta2) {
+                    ++movedToTarget2;
+                } else {
+                    deltas._delta2.add(metaData.getGid(),
+                                       metaData.getTimestamp(),
+                                       metaData.getDocSize(),
+                                       _subDbType);
+                }
             }
         }
     }
+    if (deriveDelta2 && (movedToTarget2 != 0)) {
+        deltas._delta2 = session.subDbState(source, _subDbType);
+        deltas._delta2 -= deltas._delta1;
+        assert(deltas._delta2.getEntryCount() == movedToTarget2);
+    }
     return deltas;
     // Caller can remove source bucket if empty
 }
@@ -933,7 +1009,8 @@ DocumentMetaStore::handleJoin(const bucketdb::JoinBucketsSession &session)
 
     TreeType::Iterator itr = lowerBound(target);
     TreeType::Iterator end = upperBound(target);
-    bucketdb::BucketDeltaPair deltas;
+    uint32_t movedFromSource1 = 0;
+    uint32_t movedFromSource2 = 0;
     for (; itr != end; ++itr) {
         DocId lid = itr.getKey().get_lid();
         assert(validLid(lid));
@@ -942,12 +1019,23 @@ DocumentMetaStore::handleJoin(const bucketdb::JoinBucketsSession &session)
         BucketId s(metaData.getBucketId());
         if (source1.valid() && s == source1) {
             metaData.setBucketUsedBits(target.getUsedBits());
-            deltas._delta1.add(metaData.getGid(), metaData.getTimestamp(), metaData.getDocSize(), _subDbType);
+            ++movedFromSource1;
         } else if (source2.valid() && s == source2) {
             metaData.setBucketUsedBits(target.getUsedBits());
-            deltas._delta2.add(metaData.getGid(), metaData.getTimestamp(), metaData.getDocSize(), _subDbType);
+            ++movedFromSource2;
         }
     }
+    // All documents of the source buckets in this sub database have been moved,
+    // thus the deltas are the complete sub database parts of the source states.
+    bucketdb::BucketDeltaPair deltas;
+    if (movedFromSource1 != 0) {
+        deltas._delta1 = session.subDbState(source1, _subDbType);
+        assert(deltas._delta1.getEntryCount() == movedFromSource1);
+    }
+    if (movedFromSource2 != 0) {
+        deltas._delta2 = session.subDbState(source2, _subDbType);
+        assert(deltas._delta2.getEntryCount() == movedFromSource2);
+    }
     if (_subDbType == SubDbType::READY) {
         bool movedSource1Docs = deltas._delta1.getReadyCount() != 0;
         bool movedSource2Docs = deltas._delta2.getReadyCount() != 0;
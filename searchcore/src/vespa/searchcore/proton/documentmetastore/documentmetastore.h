@@ -19,6 +19,7 @@ namespace proton::bucketdb {
 }
 
 namespace proton::documentmetastore {
+    class GidToLidHashIndex;
     class OperationListener;
     class Reader;
 }
@@ -68,6 +69,9 @@ private:
 
     MetaDataStore       _metaDataStore;
     TreeType            _gidToLidMap;
+    // Optional hash index for point lookups by the writer. Readers use the frozen view of
+    // _gidToLidMap, where changes become visible on commit, and it is used for ordered iteration.
+    std::unique_ptr<documentmetastore::GidToLidHashIndex> _gidHashIndex;
     Iterator            _gid_to_lid_map_write_itr; // Iterator used for all updates of _gidToLidMap
     SerialNum           _gid_to_lid_map_write_itr_prepare_serial_num;
     documentmetastore::LidAllocator _lidAlloc;
@@ -151,7 +155,8 @@ public:
     DocumentMetaStore(BucketDBOwnerSP bucketDB,
                       const std::string & name,
                       const search::GrowStrategy & grow,
-                      SubDbType subDbType = SubDbType::READY);
+                      SubDbType subDbType = SubDbType::READY,
+                      bool gidHashIndex = false);
     ~DocumentMetaStore() override;
 
     /**
@@ -196,6 +201,7 @@ public:
     bool getGid(DocId lid, GlobalId &gid) const override;
     bool getGidEvenIfMoved(DocId lid, GlobalId &gid) const override;
     bool getLid(const GlobalId & gid, DocId &lid) const override;
+    bool has_gid_hash_index() const noexcept { return static_cast<bool>(_gidHashIndex); }
     search::DocumentMetaData getMetaData(const GlobalId &gid) const override;
     void getMetaData(const BucketId &bucketId, search::DocumentMetaData::Vector &result) const override;
     DocId   getNumUsedLids() const override { return _lidAlloc.getNumUsedLids(); }
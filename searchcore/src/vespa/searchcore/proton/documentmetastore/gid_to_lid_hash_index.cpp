@@ -0,0 +1,95 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "gid_to_lid_hash_index.h"
+#include <vespa/vespalib/datastore/entry_comparator.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <cassert>
+
+using document::GlobalId;
+using vespalib::datastore::EntryComparator;
+using vespalib::datastore::EntryRef;
+
+namespace proton::documentmetastore {
+
+/**
+ * Comparator mapping from lid -> gid by using the meta data store. The
+ * invalid entry ref represents the gid given to the constructor.
+ **/
+class GidToLidHashIndex::Comparator : public EntryComparator
+{
+    const MetaDataStore& _metaDataStore;
+    const GlobalId*      _gid;
+
+    const GlobalId& get_gid(EntryRef ref) const noexcept {
+        if (ref.valid()) {
+            return _metaDataStore.acquire_elem_ref(ref.ref()).getGid();
+        }
+        return *_gid;
+    }
+public:
+    Comparator(const MetaDataStore& metaDataStore, const GlobalId* gid) noexcept
+        : _metaDataStore(metaDataStore),
+          _gid(gid)
+    {
+    }
+    bool less(const EntryRef lhs, const EntryRef rhs) const noexcept override {
+        return GlobalId::BucketOrderCmp()(get_gid(lhs), get_gid(rhs));
+    }
+    bool equal(const EntryRef lhs, const EntryRef rhs) const noexcept override {
+        return get_gid(lhs) == get_gid(rhs);
+    }
+    size_t hash(const EntryRef rhs) const noexcept override {
+        return GlobalId::hash()(get_gid(rhs));
+    }
+};
+
+GidToLidHashIndex::GidToLidHashIndex(const MetaDataStore& metaDataStore)
+    : _metaDataStore(metaDataStore),
+      _map(std::make_unique<Comparator>(metaDataStore, nullptr))
+{
+}
+
+GidToLidHashIndex::~GidToLidHashIndex() = default;
+
+void
+GidToLidHashIndex::insert(DocId lid)
+{
+    EntryRef ref(lid);
+    std::function<EntryRef()> insert_entry([ref]() noexcept { return ref; });
+    auto& kv = _map.add(_map.get_default_comparator(), ref, insert_entry);
+    assert(kv.first.load_relaxed() == ref);
+    (void) kv;
+}
+
+void
+GidToLidHashIndex::remove(DocId lid)
+{
+    auto* kv = _map.remove(_map.get_default_comparator(), EntryRef(lid));
+    assert(kv != nullptr && kv->first.load_relaxed() == EntryRef(lid));
+    (void) kv;
+}
+
+void
+GidToLidHashIndex::move(DocId from_lid, DocId to_lid)
+{
+    auto* kv = _map.find(_map.get_default_comparator(), EntryRef(from_lid));
+    assert(kv != nullptr && kv->first.load_relaxed() == EntryRef(from_lid));
+    // Same gid, thus the entry stays in the same hash chain
+    kv->first.store_release(EntryRef(to_lid));
+}
+
+GidToLidHashIndex::DocId
+GidToLidHashIndex::find(const GlobalId& gid) const
+{
+    Comparator comp(_metaDataStore, &gid);
+    auto* kv = _map.find(comp, EntryRef());
+    return (kv != nullptr) ? kv->first.load_acquire().ref() : 0u;
+}
+
+vespalib::MemoryUsage
+GidToLidHashIndex::get_memory_usage() const
+{
+    return _map.get_memory_usage();
+}
+
+}
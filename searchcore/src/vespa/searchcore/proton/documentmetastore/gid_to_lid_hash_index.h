@@ -0,0 +1,53 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "raw_document_meta_data.h"
+#include <vespa/vespalib/datastore/sharded_hash_map.h>
+#include <vespa/vespalib/util/rcuvector.h>
+
+namespace vespalib { class MemoryUsage; }
+
+namespace proton::documentmetastore {
+
+/**
+ * Hash index mapping from gid to lid, used by the document meta store
+ * for point lookups in the write thread. The keys in the hash map are
+ * lids, and the gid for a lid is found in the meta data store. Ordered
+ * iteration (e.g. all documents in a bucket) and lookups from readers
+ * still use the gid to lid btree.
+ *
+ * Memory is held using generations, cf. vespalib::datastore::ShardedHashMap.
+ **/
+class GidToLidHashIndex
+{
+public:
+    using DocId = uint32_t;
+    using MetaDataStore = vespalib::RcuVectorBase<RawDocumentMetaData>;
+    using generation_t = vespalib::GenerationHandler::generation_t;
+private:
+    class Comparator;
+
+    const MetaDataStore&                 _metaDataStore;
+    vespalib::datastore::ShardedHashMap  _map;
+
+public:
+    explicit GidToLidHashIndex(const MetaDataStore& metaDataStore);
+    ~GidToLidHashIndex();
+
+    // Called by writer after the meta data for lid has been set
+    void insert(DocId lid);
+    // Called by writer before the meta data for lid is changed
+    void remove(DocId lid);
+    // Called by writer after the meta data for from_lid has been copied to to_lid
+    void move(DocId from_lid, DocId to_lid);
+    // Returns 0 if gid is not found
+    DocId find(const document::GlobalId& gid) const;
+
+    void assign_generation(generation_t current_gen) { _map.assign_generation(current_gen); }
+    void reclaim_memory(generation_t oldest_used_gen) { _map.reclaim_memory(oldest_used_gen); }
+    size_t size() const noexcept { return _map.size(); }
+    vespalib::MemoryUsage get_memory_usage() const;
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include "putoperation.h"
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/vespalib/objects/nbostream.h>
 
 using document::BucketId;
 using document::Document;
@@ -12,13 +13,15 @@ namespace proton {
 
 PutOperation::PutOperation()
     : DocumentOperation(FeedOperation::PUT),
-      _doc()
+      _doc(),
+      _serializedDoc()
 { }
 
 
 PutOperation::PutOperation(BucketId bucketId, Timestamp timestamp, Document::SP doc)
     : DocumentOperation(FeedOperation::PUT, bucketId, timestamp),
-      _doc(std::move(doc))
+      _doc(std::move(doc)),
+      _serializedDoc()
 { }
 
 PutOperation::~PutOperation() = default;
@@ -28,9 +31,11 @@ PutOperation::serialize(vespalib::nbostream &os) const
 {
     assertValidBucketId(_doc->getId());
     DocumentOperation::serialize(os);
-    size_t oldSize = os.size();
-    _doc->serialize(os);
-    _serializedDocSize = os.size() - oldSize;
+    auto serializedDoc = std::make_shared<vespalib::nbostream>();
+    _doc->serialize(*serializedDoc);
+    os.write(serializedDoc->peek(), serializedDoc->size());
+    _serializedDocSize = serializedDoc->size();
+    _serializedDoc = std::move(serializedDoc);
 }
 
 
@@ -38,9 +43,18 @@ void
 PutOperation::deserialize(vespalib::nbostream &is, const DocumentTypeRepo &repo)
 {
     DocumentOperation::deserialize(is, repo);
+    const char *start = is.peek();
     size_t oldSize = is.size();
     _doc.reset(new Document(repo, is));
     _serializedDocSize = oldSize - is.size();
+    /*
+     * The document store keeps documents serialized with older document
+     * types anyway, thus the bytes from the transaction log can be stored
+     * as is even if the document type has changed since the put.
+     */
+    auto serializedDoc = std::make_shared<vespalib::nbostream>(_serializedDocSize);
+    serializedDoc->write(start, _serializedDocSize);
+    _serializedDoc = std::move(serializedDoc);
 }
 
 void
@@ -50,6 +64,7 @@ PutOperation::deserializeDocument(const DocumentTypeRepo &repo)
     _doc->serialize(stream);
     auto fixedDoc = std::make_shared<Document>(repo, stream);
     _doc = std::move(fixedDoc);
+    _serializedDoc.reset();
 }
 
 std::string
@@ -8,13 +8,17 @@ namespace proton {
 class PutOperation : public DocumentOperation
 {
     using DocumentSP = std::shared_ptr<document::Document>;
-    DocumentSP _doc;
+    using SerializedDocumentSP = std::shared_ptr<const vespalib::nbostream>;
+    DocumentSP                   _doc;
+    // Serialized form of _doc, set by serialize()/deserialize() and reused when writing to the document store
+    mutable SerializedDocumentSP _serializedDoc;
 
 public:
     PutOperation();
     PutOperation(document::BucketId bucketId, Timestamp timestamp, DocumentSP doc);
     ~PutOperation() override;
     const DocumentSP &getDocument() const { return _doc; }
+    const SerializedDocumentSP &getSerializedDocument() const noexcept { return _serializedDoc; }
     void assertValid() const;
     void serialize(vespalib::nbostream &os) const override;
     void deserialize(vespalib::nbostream &is, const document::DocumentTypeRepo &repo) override;
@@ -71,6 +71,8 @@ void
 FlushEngineExplorer::get_state(const Inserter &inserter, bool full) const
 {
     Cursor &object = inserter.insertObject();
+    object.setLong("pending_write_bytes", _engine.get_pending_write_bytes());
+    object.setDouble("write_bandwidth", _engine.get_write_bandwidth());
     if (full) {
         vespalib::system_time now = vespalib::system_clock::now();
         convertToSlime(_engine.getCurrentlyFlushingSet(), object.setArray("flushingTargets"));
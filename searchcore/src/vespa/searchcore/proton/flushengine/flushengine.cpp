@@ -86,7 +86,8 @@ FlushEngine::FlushMeta::~FlushMeta() = default;
 FlushEngine::FlushInfo::FlushInfo()
     : FlushMeta("", "", 0),
       _target(),
-      _strategy_id(0)
+      _strategy_id(0),
+      _approx_bytes_to_write(0)
 {
 }
 
@@ -97,7 +98,8 @@ FlushEngine::FlushInfo::FlushInfo(uint32_t taskId, const std::string& handler_na
                                   uint32_t strategy_id)
     : FlushMeta(handler_name, target->getName(), taskId),
       _target(target),
-      _strategy_id(strategy_id)
+      _strategy_id(strategy_id),
+      _approx_bytes_to_write(target->getApproxBytesToWriteToDisk())
 {
 }
 
@@ -127,7 +129,10 @@ FlushEngine::FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory> tlsStats
       _pendingPrune(),
       _normal_flush_token(std::make_shared<search::FlushToken>()),
       _gc_flush_token(std::make_shared<search::FlushToken>()),
-      _flush_history(std::make_shared<FlushHistory>(_strategy->name(), _strategy_id, _maxConcurrentNormal))
+      _flush_history(std::make_shared<FlushHistory>(_strategy->name(), _strategy_id, _maxConcurrentNormal)),
+      _max_pending_write_bytes(0),
+      _pending_write_bytes(0),
+      _write_bandwidth(0.0)
 {
     _flushing_strategies[_strategy_id] = 1u; // Account for initial flush strategy
 }
@@ -192,10 +197,35 @@ FlushEngine::canFlushMore(const std::unique_lock<std::mutex> &, IFlushTarget::Pr
     if (priority > IFlushTarget::Priority::NORMAL) {
         return maxConcurrentTotal() > _flushing.size();
     } else {
+        if (_max_pending_write_bytes != 0 && !_flushing.empty() && _pending_write_bytes >= _max_pending_write_bytes) {
+            return false;
+        }
         return maxConcurrentNormal() > _flushing.size();
     }
 }
 
+void
+FlushEngine::set_max_pending_write_bytes(uint64_t max_pending_write_bytes)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _max_pending_write_bytes = max_pending_write_bytes;
+    _cond.notify_all();
+}
+
+uint64_t
+FlushEngine::get_pending_write_bytes() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _pending_write_bytes;
+}
+
+double
+FlushEngine::get_write_bandwidth() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _write_bandwidth;
+}
+
 void
 FlushEngine::idle_wait(vespalib::duration minimumWaitTimeIfReady) {
     std::unique_lock<std::mutex> guard(_lock);
@@ -577,6 +607,13 @@ FlushEngine::flushDone(const FlushContext &ctx, uint32_t taskId)
         auto itr = _flushing.find(taskId);
         assert(itr != _flushing.end());
         strategy_id = itr->second._strategy_id;
+        uint64_t bytes_written = itr->second._approx_bytes_to_write;
+        _pending_write_bytes -= bytes_written;
+        double seconds = vespalib::to_s(duration);
+        if (bytes_written != 0 && seconds > 0.0) {
+            double bandwidth = bytes_written / seconds;
+            _write_bandwidth = (_write_bandwidth == 0.0) ? bandwidth : 0.8 * _write_bandwidth + 0.2 * bandwidth;
+        }
         _flush_history->flush_done(taskId);
         _flushing.erase(itr);
     }
@@ -652,6 +689,7 @@ FlushEngine::initFlush(const IFlushHandler::SP &handler, const IFlushTarget::SP
         std::lock_guard<std::mutex> guard(_lock);
         taskId = _taskId++;
         FlushInfo flush(taskId, handler->getName(), target, strategy_id);
+        _pending_write_bytes += flush._approx_bytes_to_write;
         _flushing[taskId] = flush;
         _flush_history->start_flush(handler->getName(), target->getName(), target->last_flush_duration(),  taskId);
         mark_active_strategy(strategy_id, guard);
@@ -58,6 +58,7 @@ private:
 
         IFlushTarget::SP  _target;
         uint32_t _strategy_id;
+        uint64_t _approx_bytes_to_write;
     };
     struct PruneMeta {
         uint32_t                            _flush_id;
@@ -115,6 +116,9 @@ private:
     std::shared_ptr<search::FlushToken> _normal_flush_token;
     std::shared_ptr<search::FlushToken> _gc_flush_token;
     std::shared_ptr<flushengine::FlushHistory> _flush_history;
+    uint64_t                       _max_pending_write_bytes; // 0 means no limit
+    uint64_t                       _pending_write_bytes;     // estimated bytes to write by active flushes
+    double                         _write_bandwidth;         // bytes per second, moving average over completed flushes
 
     FlushContext::List getTargetList(bool includeFlushingTargets) const;
     BoundFlushContextList getSortedTargetList();
@@ -235,6 +239,19 @@ public:
     flushengine::SetStrategyResult poll_strategy(uint32_t wait_strategy_id);
     uint32_t maxConcurrentTotal() const { return _maxConcurrentNormal + 1; }
     uint32_t maxConcurrentNormal() const { return _maxConcurrentNormal; }
+
+    /**
+     * Limits the sum of estimated bytes to write to disk by outstanding flushes. No more
+     * normal priority flushes are started while the limit is reached, pacing the flushes
+     * against the disk. A single flush is always allowed. 0 means no limit.
+     */
+    void set_max_pending_write_bytes(uint64_t max_pending_write_bytes);
+    uint64_t get_pending_write_bytes() const;
+    /**
+     * Returns the disk write bandwidth (bytes per second) observed for completed flushes,
+     * based on the bytes to write estimated by the flush targets. 0 if no estimate yet.
+     */
+    double get_write_bandwidth() const;
     const std::shared_ptr<flushengine::FlushHistory>& get_flush_history() const noexcept { return _flush_history; }
 };
 
@@ -42,6 +42,7 @@ public:
                             std::shared_ptr<searchcorespi::IIndexManager::SP> indexManager);
     ~IndexManagerInitializer() override;
     void run() override;
+    std::string get_name() const override { return "index"; }
 };
 
 } // namespace proton
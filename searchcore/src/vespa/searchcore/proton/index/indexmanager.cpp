@@ -31,12 +31,14 @@ namespace proton::index {
 IndexManager::MaintainerOperations::MaintainerOperations(const FileHeaderContext &fileHeaderContext,
                                                          const TuneFileIndexManager &tuneFileIndexManager,
                                                          std::shared_ptr<IPostingListCache> posting_list_cache,
-                                                         IThreadingService &threadingService)
+                                                         IThreadingService &threadingService,
+                                                         uint32_t invert_field_shards)
     : _posting_list_cache(std::move(posting_list_cache)),
       _fileHeaderContext(fileHeaderContext),
       _tuneFileIndexing(tuneFileIndexManager._indexing),
       _tuneFileSearch(tuneFileIndexManager._search),
-      _threadingService(threadingService)
+      _threadingService(threadingService),
+      _invert_field_shards(invert_field_shards)
 {
 }
 
@@ -46,7 +48,7 @@ IndexManager::MaintainerOperations::createMemoryIndex(const Schema& schema,
                                                       SerialNum serialNum)
 {
     return std::make_shared<MemoryIndexWrapper>(schema, inspector, _fileHeaderContext, _tuneFileIndexing,
-                                                _threadingService, serialNum);
+                                                _threadingService, serialNum, _invert_field_shards);
 }
 
 IDiskIndex::SP
@@ -88,8 +90,8 @@ IndexManager::IndexManager(const std::string &baseDir,
                            const search::TuneFileIndexManager &tuneFileIndexManager,
                            const search::TuneFileAttributes &tuneFileAttributes,
                            const FileHeaderContext &fileHeaderContext) :
-    _operations(fileHeaderContext, tuneFileIndexManager, std::move(posting_list_cache),threadingService),
-    _maintainer(IndexMaintainerConfig(baseDir, indexConfig.warmup, indexConfig.maxFlushed, schema, serialNum, tuneFileAttributes),
+    _operations(fileHeaderContext, tuneFileIndexManager, std::move(posting_list_cache), threadingService, indexConfig.invert_field_shards),
+    _maintainer(IndexMaintainerConfig(baseDir, indexConfig.warmup, indexConfig.maxFlushed, indexConfig.fusion_policy, schema, serialNum, tuneFileAttributes),
                 IndexMaintainerContext(threadingService, reconfigurer, fileHeaderContext, warmupExecutor),
                 _operations)
 {
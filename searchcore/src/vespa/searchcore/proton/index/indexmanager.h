@@ -5,6 +5,7 @@
 #include <vespa/searchcorespi/index/iindexmanager.h>
 #include <vespa/searchcorespi/index/indexmaintainer.h>
 #include <vespa/searchcorespi/index/ithreadingservice.h>
+#include <vespa/searchcorespi/index/fusion_policy.h>
 #include <vespa/searchcorespi/index/warmupconfig.h>
 
 namespace search::diskindex { class IPostingListCache; }
@@ -13,14 +14,23 @@ namespace proton::index {
 
 struct IndexConfig {
     using WarmupConfig = searchcorespi::index::WarmupConfig;
+    using FusionPolicy = searchcorespi::index::FusionPolicy;
     IndexConfig() : IndexConfig(WarmupConfig(), 2) { }
     IndexConfig(WarmupConfig warmup_, size_t maxFlushed_)
+        : IndexConfig(warmup_, maxFlushed_, FusionPolicy(), 1)
+    { }
+    IndexConfig(WarmupConfig warmup_, size_t maxFlushed_, FusionPolicy fusion_policy_, uint32_t invert_field_shards_)
         : warmup(warmup_),
-          maxFlushed(maxFlushed_)
+          maxFlushed(maxFlushed_),
+          fusion_policy(fusion_policy_),
+          invert_field_shards(invert_field_shards_)
     { }
 
     const WarmupConfig warmup;
     const size_t       maxFlushed;
+    const FusionPolicy fusion_policy;
+    // Number of shards (by document) used when inverting each text field in memory indexes
+    const uint32_t     invert_field_shards;
 };
 
 /**
@@ -41,12 +51,14 @@ public:
         const search::TuneFileIndexing _tuneFileIndexing;
         const search::TuneFileSearch _tuneFileSearch;
         searchcorespi::index::IThreadingService &_threadingService;
+        const uint32_t _invert_field_shards;
 
     public:
         MaintainerOperations(const search::common::FileHeaderContext &fileHeaderContext,
                              const search::TuneFileIndexManager &tuneFileIndexManager,
                              std::shared_ptr<search::diskindex::IPostingListCache> posting_list_cache,
-                             searchcorespi::index::IThreadingService &threadingService);
+                             searchcorespi::index::IThreadingService &threadingService,
+                             uint32_t invert_field_shards);
 
         IMemoryIndex::SP createMemoryIndex(const Schema& schema,
                                            const IFieldLengthInspector& inspector,
@@ -22,12 +22,14 @@ MemoryIndexWrapper::MemoryIndexWrapper(const search::index::Schema& schema,
                                        const search::common::FileHeaderContext& fileHeaderContext,
                                        const TuneFileIndexing& tuneFileIndexing,
                                        searchcorespi::index::IThreadingService& threadingService,
-                                       search::SerialNum serialNum)
+                                       search::SerialNum serialNum,
+                                       uint32_t invert_field_shards)
     : _index(schema, inspector, threadingService.field_writer(),
-             threadingService.field_writer()),
+             threadingService.field_writer(), invert_field_shards),
       _serialNum(serialNum),
       _fileHeaderContext(fileHeaderContext),
-      _tuneFileIndexing(tuneFileIndexing)
+      _tuneFileIndexing(tuneFileIndexing),
+      _flushExecutor(threadingService.shared())
 {
 }
 
@@ -39,7 +41,7 @@ MemoryIndexWrapper::flushToDisk(const std::string &flushDir, uint32_t docIdLimit
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext, serialNum);
     IndexBuilder indexBuilder(_index.getSchema(), flushDir, docIdLimit,
                               numWords, *this, _tuneFileIndexing, fileHeaderContext);
-    _index.dump(indexBuilder);
+    _index.dump(indexBuilder, _flushExecutor, max_flush_threads);
 }
 
 search::SerialNum
@@ -23,14 +23,19 @@ private:
     std::atomic<SerialNum> _serialNum;
     const search::common::FileHeaderContext &_fileHeaderContext;
     const search::TuneFileIndexing _tuneFileIndexing;
+    vespalib::Executor &_flushExecutor;
 
 public:
+    // Max number of fields written in parallel when flushing, shared by all fields of the index
+    static constexpr uint32_t max_flush_threads = 4;
+
     MemoryIndexWrapper(const search::index::Schema& schema,
                        const search::index::IFieldLengthInspector& inspector,
                        const search::common::FileHeaderContext& fileHeaderContext,
                        const search::TuneFileIndexing& tuneFileIndexing,
                        searchcorespi::index::IThreadingService& threadingService,
-                       SerialNum serialNum);
+                       SerialNum serialNum,
+                       uint32_t invert_field_shards);
 
     /**
      * Implements searchcorespi::IndexSearchable
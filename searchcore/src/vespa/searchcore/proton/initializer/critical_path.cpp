@@ -0,0 +1,60 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "critical_path.h"
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <cassert>
+
+namespace proton::initializer {
+
+namespace {
+
+double
+to_seconds(vespalib::duration d)
+{
+    return vespalib::to_s(std::max(d, vespalib::duration::zero()));
+}
+
+}
+
+std::vector<const InitializerTask *>
+get_critical_path(const InitializerTask &task)
+{
+    std::vector<const InitializerTask *> path;
+    const InitializerTask *current = &task;
+    while (current != nullptr) {
+        assert(current->getState() == InitializerTask::State::DONE);
+        path.push_back(current);
+        const InitializerTask *last_done = nullptr;
+        for (const auto &dep : current->getDependencies()) {
+            if (last_done == nullptr || dep->get_end_time() > last_done->get_end_time()) {
+                last_done = dep.get();
+            }
+        }
+        current = last_done;
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::string
+critical_path_to_string(const InitializerTask &task)
+{
+    std::string result;
+    const InitializerTask *prev = nullptr;
+    for (const auto *elem : get_critical_path(task)) {
+        if (prev != nullptr) {
+            result += " -> ";
+        }
+        result += vespalib::make_string("%s(run=%.3fs", elem->get_name().c_str(),
+                                        to_seconds(elem->get_end_time() - elem->get_start_time()));
+        if (prev != nullptr) {
+            result += vespalib::make_string(", wait=%.3fs", to_seconds(elem->get_start_time() - prev->get_end_time()));
+        }
+        result += ")";
+        prev = elem;
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,22 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "initializer_task.h"
+
+namespace proton::initializer {
+
+/*
+ * Returns the chain of tasks that decided when the given task was done,
+ * starting with the first task that was run. For each task, the
+ * dependency that was done last is followed. All tasks must be done.
+ */
+std::vector<const InitializerTask *> get_critical_path(const InitializerTask &task);
+
+/*
+ * Describes the critical path of the given task, with the time spent
+ * running each task and the time each task spent waiting after its
+ * dependencies were done, e.g. "attribute ready.a(run=2.000s) -> ready(run=0.010s, wait=0.001s)".
+ */
+std::string critical_path_to_string(const InitializerTask &task);
+
+}
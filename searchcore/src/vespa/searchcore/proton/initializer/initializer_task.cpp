@@ -6,7 +6,9 @@ namespace proton::initializer {
 
 InitializerTask::InitializerTask()
     : _state(State::BLOCKED),
-      _dependencies()
+      _dependencies(),
+      _start_time(),
+      _end_time()
 {
 }
 
@@ -24,4 +26,16 @@ InitializerTask::get_transient_memory_usage() const
     return 0u;
 }
 
+uint64_t
+InitializerTask::get_estimated_load_size() const
+{
+    return 0u;
+}
+
+std::string
+InitializerTask::get_name() const
+{
+    return "task";
+}
+
 }
@@ -1,7 +1,9 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <vespa/vespalib/util/time.h>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace proton::initializer {
@@ -20,18 +22,26 @@ public:
         DONE
     };
 private:
-    State           _state;
-    List            _dependencies;
+    State                 _state;
+    List                  _dependencies;
+    vespalib::steady_time _start_time;
+    vespalib::steady_time _end_time;
 public:
     InitializerTask();
     virtual ~InitializerTask();
     State getState() const { return _state; }
     const List &getDependencies() const { return _dependencies; }
-    void setRunning() { _state = State::RUNNING; }
-    void setDone() { _state = State::DONE; }
+    void setRunning() { _state = State::RUNNING; _start_time = vespalib::steady_clock::now(); }
+    void setDone() { _state = State::DONE; _end_time = vespalib::steady_clock::now(); }
+    vespalib::steady_time get_start_time() const noexcept { return _start_time; }
+    vespalib::steady_time get_end_time() const noexcept { return _end_time; }
     void addDependency(SP dependency);
     virtual void run() = 0;
     virtual size_t get_transient_memory_usage() const;
+    // Estimate of the amount of data loaded by the task, used to start the largest tasks first
+    virtual uint64_t get_estimated_load_size() const;
+    // Name used when reporting the critical path of the initialization
+    virtual std::string get_name() const;
 };
 
 }
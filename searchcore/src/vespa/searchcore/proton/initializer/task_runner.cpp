@@ -114,7 +114,14 @@ TaskRunner::pollTask(Context::SP context)
     TaskList readyTasks;
     TaskSet checked;
     getReadyTasks(context->rootTask(), readyTasks, checked);
-    std::sort(readyTasks.begin(), readyTasks.end(), [](const auto &a, const auto &b) -> bool { return a->get_transient_memory_usage() > b->get_transient_memory_usage(); });
+    std::sort(readyTasks.begin(), readyTasks.end(), [](const auto &a, const auto &b) -> bool {
+        size_t a_transient = a->get_transient_memory_usage();
+        size_t b_transient = b->get_transient_memory_usage();
+        if (a_transient != b_transient) {
+            return a_transient > b_transient;
+        }
+        return a->get_estimated_load_size() > b->get_estimated_load_size();
+    });
     internalRunTasks(readyTasks, context);
 }
 
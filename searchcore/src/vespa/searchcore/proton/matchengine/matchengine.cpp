@@ -49,7 +49,8 @@ namespace proton {
 using namespace vespalib::slime;
 using vespalib::CpuUsage;
 
-MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async)
+MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async,
+                         const vespalib::NumaTopology &numa, vespalib::duration bundleSpin)
     : _lock(),
       _distributionKey(distributionKey),
       _async(async),
@@ -57,9 +58,9 @@ MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t di
       _forward_issues(true),
       _handlers(),
       _executor(std::max(size_t(1), numThreads / threadsPerSearch),
-                CpuUsage::wrap(match_engine_executor, CpuUsage::Category::READ)),
+                numa.spread_over_nodes(CpuUsage::wrap(match_engine_executor, CpuUsage::Category::READ))),
       _threadBundlePool(std::max(size_t(1), threadsPerSearch),
-                        CpuUsage::wrap(match_engine_thread_bundle, CpuUsage::Category::READ)),
+                        CpuUsage::wrap(match_engine_thread_bundle, CpuUsage::Category::READ), numa, bundleSpin),
       _nodeUp(false),
       _nodeMaintenance(false)
 {
@@ -8,7 +8,7 @@
 #include <vespa/searchlib/engine/searchapi.h>
 #include <vespa/vespalib/net/http/state_explorer.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
-#include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <vespa/vespalib/util/numa_thread_bundle_pool.h>
 #include <mutex>
 
 namespace proton {
@@ -24,7 +24,7 @@ private:
     std::atomic<bool>                  _forward_issues;
     HandlerMap<ISearchHandler>         _handlers;
     vespalib::ThreadStackExecutor      _executor;
-    vespalib::SimpleThreadBundle::Pool _threadBundlePool;
+    vespalib::NumaThreadBundlePool     _threadBundlePool;
     std::atomic<bool>                  _nodeUp;
     std::atomic<bool>                  _nodeMaintenance;
 
@@ -48,8 +48,20 @@ public:
      * @param threadsPerSearch number of threads used for each search
      * @param distributionKey distributionkey of this node.
      * @param async if query is dispatched to threadpool
+     * @param numa NUMA nodes to spread the search threads over; each query
+     *             is matched by threads on the node of the thread handling it
+     * @param bundleSpin time the threads used for each search spin waiting
+     *                   for more work before parking
      */
-    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async);
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async,
+                const vespalib::NumaTopology &numa, vespalib::duration bundleSpin);
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async,
+                const vespalib::NumaTopology &numa)
+        : MatchEngine(numThreads, threadsPerSearch, distributionKey, async, numa, vespalib::duration::zero())
+    {}
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey, bool async)
+        : MatchEngine(numThreads, threadsPerSearch, distributionKey, async, vespalib::NumaTopology())
+    {}
     MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey)
         : MatchEngine(numThreads, threadsPerSearch, distributionKey, true)
     {}
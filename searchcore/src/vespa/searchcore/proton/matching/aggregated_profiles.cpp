@@ -0,0 +1,43 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "aggregated_profiles.h"
+#include <vespa/vespalib/data/slime/cursor.h>
+
+namespace proton::matching {
+
+AggregatedProfiles::AggregatedProfiles(uint32_t sample_interval, uint32_t depth)
+  : _sample_interval(sample_interval),
+    _depth(depth),
+    _queries(0),
+    _sampled_queries(0),
+    _match(),
+    _first_phase(),
+    _second_phase()
+{
+}
+
+AggregatedProfiles::~AggregatedProfiles() = default;
+
+void
+AggregatedProfiles::report(vespalib::slime::Cursor &obj, bool full) const
+{
+    obj.setLong("sample_interval", _sample_interval);
+    obj.setLong("depth", _depth);
+    obj.setLong("sampled_queries", sampled_queries());
+    if (full) {
+        _match.report(obj.setObject("match_profiling"));
+        _first_phase.report(obj.setObject("first_phase_profiling"));
+        _second_phase.report(obj.setObject("second_phase_profiling"));
+    }
+}
+
+void
+AggregatedProfiles::reset()
+{
+    _sampled_queries.store(0, std::memory_order_relaxed);
+    _match.reset();
+    _first_phase.reset();
+    _second_phase.reset();
+}
+
+}
@@ -0,0 +1,57 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/execution_profile_aggregator.h>
+#include <atomic>
+#include <cstdint>
+
+namespace vespalib::slime { struct Cursor; }
+
+namespace proton::matching {
+
+/**
+ * Match and ranking profiles aggregated across a sample of the
+ * queries run against a rank profile. One out of every
+ * sample_interval queries is profiled with a tree profiler of the
+ * given depth, and the profiles of all match threads are merged by
+ * task (blueprint/feature) structure. Queries that are profiled for
+ * tracing are not sampled.
+ **/
+class AggregatedProfiles
+{
+private:
+    using Aggregator = vespalib::ExecutionProfileAggregator;
+    uint32_t              _sample_interval;
+    uint32_t              _depth;
+    std::atomic<uint64_t> _queries;
+    std::atomic<uint64_t> _sampled_queries;
+    Aggregator            _match;
+    Aggregator            _first_phase;
+    Aggregator            _second_phase;
+
+public:
+    AggregatedProfiles(uint32_t sample_interval, uint32_t depth);
+    ~AggregatedProfiles();
+    uint32_t sample_interval() const noexcept { return _sample_interval; }
+    int32_t depth() const noexcept { return _depth; }
+    // called once per query; true if the query should be profiled
+    bool sample() noexcept {
+        if (_sample_interval == 0) {
+            return false;
+        }
+        if ((_queries.fetch_add(1, std::memory_order_relaxed) % _sample_interval) != 0) {
+            return false;
+        }
+        _sampled_queries.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    uint64_t sampled_queries() const noexcept { return _sampled_queries.load(std::memory_order_relaxed); }
+    Aggregator &match() noexcept { return _match; }
+    Aggregator &first_phase() noexcept { return _first_phase; }
+    Aggregator &second_phase() noexcept { return _second_phase; }
+    void report(vespalib::slime::Cursor &obj, bool full) const;
+    void reset();
+};
+
+}
@@ -164,4 +164,109 @@ AdaptiveDocidRangeScheduler::share_range(size_t thread_id, DocidRange todo)
 
 //-----------------------------------------------------------------------------
 
+DocidRange
+WorkStealingDocidRangeScheduler::take_chunk(size_t thread_id)
+{
+    Worker &worker = _workers[thread_id];
+    uint64_t old_todo = worker.todo.load(std::memory_order_acquire);
+    for (;;) {
+        DocidRange todo = unpack(old_todo);
+        if (todo.empty()) {
+            return DocidRange();
+        }
+        DocidRange chunk(todo.begin, todo.begin + std::min(todo.size(), size_t(_chunk_size)));
+        if (worker.todo.compare_exchange_weak(old_todo, pack(DocidRange(chunk.end, todo.end)),
+                                              std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            worker.assigned += chunk.size();
+            return chunk;
+        }
+    }
+}
+
+DocidRange
+WorkStealingDocidRangeScheduler::steal_from(size_t victim)
+{
+    Worker &worker = _workers[victim];
+    uint64_t old_todo = worker.todo.load(std::memory_order_acquire);
+    for (;;) {
+        DocidRange todo = unpack(old_todo);
+        if (todo.empty()) {
+            return DocidRange();
+        }
+        uint32_t split = todo.begin + (todo.size() / 2);
+        if (worker.todo.compare_exchange_weak(old_todo, pack(DocidRange(todo.begin, split)),
+                                              std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return DocidRange(split, todo.end);
+        }
+    }
+}
+
+size_t
+WorkStealingDocidRangeScheduler::next_victim(size_t thread_id)
+{
+    // xorshift64; only used to avoid all idle threads hitting the same victim
+    uint64_t &x = _workers[thread_id].random;
+    x ^= (x << 13);
+    x ^= (x >> 7);
+    x ^= (x << 17);
+    return (x % _workers.size());
+}
+
+WorkStealingDocidRangeScheduler::WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t chunk_size, uint32_t docid_limit)
+    : _chunk_size(std::max(1u, chunk_size)),
+      _workers(num_threads)
+{
+    DocidRangeSplitter splitter(DocidRange(1, docid_limit), num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        _workers[i].todo.store(pack(splitter.get(i)), std::memory_order_relaxed);
+        _workers[i].random = 0x9e3779b97f4a7c15ul * (i + 1);
+    }
+}
+
+WorkStealingDocidRangeScheduler::~WorkStealingDocidRangeScheduler() = default;
+
+DocidRange
+WorkStealingDocidRangeScheduler::next_range(size_t thread_id)
+{
+    for (;;) {
+        DocidRange chunk = take_chunk(thread_id);
+        if (!chunk.empty()) {
+            return chunk;
+        }
+        DocidRange stolen;
+        size_t first = next_victim(thread_id);
+        for (size_t i = 0; stolen.empty() && (i < _workers.size()); ++i) {
+            size_t victim = (first + i) % _workers.size();
+            if (victim != thread_id) {
+                stolen = steal_from(victim);
+                if (stolen.empty()) {
+                    ++_workers[thread_id].failed_steals;
+                }
+            }
+        }
+        if (stolen.empty()) {
+            // work only moves between threads; when nobody has
+            // anything left to steal, all remaining work is owned by
+            // threads that will do it themselves.
+            return DocidRange();
+        }
+        ++_workers[thread_id].steals;
+        _workers[thread_id].todo.store(pack(stolen), std::memory_order_release);
+    }
+}
+
+size_t
+WorkStealingDocidRangeScheduler::unassigned_size() const
+{
+    size_t sum = 0;
+    for (const auto &worker: _workers) {
+        sum += unpack(worker.todo.load(std::memory_order_relaxed)).size();
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+
 }
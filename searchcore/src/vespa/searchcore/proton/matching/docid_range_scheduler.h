@@ -103,6 +103,12 @@ public:
  * will return the remaining work to be done by the thread calling
  * it. The returned range is guaranteed to be a prefix of the range
  * passed as input to the 'share_range' function.
+ *
+ * The 'steal_count' and 'failed_steal_count' functions report how
+ * many times the given worker stole work from another worker and how
+ * many times it tried to without finding anything to steal. They are
+ * only used by schedulers employing work-stealing and should only be
+ * called by the worker itself or after all workers are done.
  **/
 struct DocidRangeScheduler {
     using UP = std::unique_ptr<DocidRangeScheduler>;
@@ -112,6 +118,8 @@ struct DocidRangeScheduler {
     virtual size_t unassigned_size() const = 0;
     virtual IdleObserver make_idle_observer() const = 0;
     virtual DocidRange share_range(size_t thread_id, DocidRange todo) = 0;
+    virtual size_t steal_count(size_t) const { return 0; }
+    virtual size_t failed_steal_count(size_t) const { return 0; }
     virtual ~DocidRangeScheduler() = default;
 };
 
@@ -201,4 +209,49 @@ public:
     DocidRange share_range(size_t, DocidRange todo) override;
 };
 
+/**
+ * A lock-free work-stealing scheduler that begins by giving each
+ * thread an equal part of the docid space. Each thread consumes its
+ * own remaining work in chunks of increasing docids. A thread running
+ * out of work steals the upper half of the remaining work of another
+ * thread, visiting the other threads in pseudo-random order. The
+ * remaining work of each thread is kept as a single atomic docid
+ * range, making both taking a chunk and stealing a single CAS.
+ **/
+class WorkStealingDocidRangeScheduler : public DocidRangeScheduler
+{
+private:
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> todo;
+        size_t                assigned;
+        size_t                steals;
+        size_t                failed_steals;
+        uint64_t              random;
+        Worker() noexcept : todo(0), assigned(0), steals(0), failed_steals(0), random(0) {}
+    };
+    uint32_t            _chunk_size;
+    std::vector<Worker> _workers;
+
+    static uint64_t pack(DocidRange range) noexcept {
+        return ((uint64_t(range.begin) << 32) | range.end);
+    }
+    static DocidRange unpack(uint64_t value) noexcept {
+        return DocidRange(uint32_t(value >> 32), uint32_t(value));
+    }
+    VESPA_DLL_LOCAL DocidRange take_chunk(size_t thread_id);
+    VESPA_DLL_LOCAL DocidRange steal_from(size_t victim);
+    VESPA_DLL_LOCAL size_t next_victim(size_t thread_id);
+public:
+    WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t chunk_size, uint32_t docid_limit);
+    ~WorkStealingDocidRangeScheduler() override;
+    DocidRange first_range(size_t thread_id) override { return next_range(thread_id); }
+    DocidRange next_range(size_t thread_id) override;
+    size_t total_size(size_t thread_id) const override { return _workers[thread_id].assigned; }
+    size_t unassigned_size() const override;
+    IdleObserver make_idle_observer() const override { return IdleObserver(); }
+    DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t steal_count(size_t thread_id) const override { return _workers[thread_id].steals; }
+    size_t failed_steal_count(size_t thread_id) const override { return _workers[thread_id].failed_steals; }
+};
+
 }
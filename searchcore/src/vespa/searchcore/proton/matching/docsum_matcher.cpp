@@ -60,6 +60,20 @@ get_feature_set(const MatchToolsFactory &mtf,
     return retval;
 }
 
+// Precondition: features contains all docs
+FeatureSet::UP
+select_features(const FeatureSet &features, const std::vector<uint32_t> &docs)
+{
+    auto retval = std::make_unique<FeatureSet>(features.getNames(), docs.size());
+    uint32_t num_features = features.numFeatures();
+    for (uint32_t docid : docs) {
+        uint32_t idx = retval->addDocId(docid);
+        const auto *src = features.getFeaturesByDocId(docid);
+        std::copy(src, src + num_features, retval->getFeaturesByIndex(idx));
+    }
+    return retval;
+}
+
 template<typename T>
 const T *as(const Blueprint &bp) { return dynamic_cast<const T *>(&bp); }
 
@@ -219,6 +233,12 @@ DocsumMatcher::get_summary_features() const
     if (!_mtf) {
         return std::make_unique<FeatureSet>();
     }
+    if (_from_session) {
+        const auto &precomputed = _from_session->get_summary_features();
+        if (precomputed && precomputed->contains(_docs)) {
+            return select_features(*precomputed, _docs);
+        }
+    }
     return get_feature_set(*_mtf, _docs, true);
 }
 
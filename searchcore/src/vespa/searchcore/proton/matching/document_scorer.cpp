@@ -28,10 +28,49 @@ extractScoreFeature(const RankProgram &rankProgram)
 DocumentScorer::DocumentScorer(RankProgram &rankProgram,
                                SearchIterator &searchItr)
     : _searchItr(searchItr),
-      _scoreFeature(extractScoreFeature(rankProgram))
+      _scoreFeature(extractScoreFeature(rankProgram)),
+      _batch_program(rankProgram.supports_batch() ? &rankProgram : nullptr),
+      _prefetch_program(rankProgram.supports_prefetch() ? &rankProgram : nullptr),
+      _batch_docids(),
+      _batch_scores()
 {
 }
 
+void
+DocumentScorer::score_batched(TaggedHits &hits)
+{
+    _batch_docids.reserve(RankProgram::BATCH_SIZE);
+    _batch_scores.resize(RankProgram::BATCH_SIZE);
+    for (size_t offset = 0; offset < hits.size(); offset += RankProgram::BATCH_SIZE) {
+        size_t n = std::min(RankProgram::BATCH_SIZE, hits.size() - offset);
+        _batch_docids.clear();
+        for (size_t i = 0; i < n; ++i) {
+            _batch_docids.push_back(hits[offset + i].first.first);
+        }
+        _batch_program->execute_batch(_batch_docids, _batch_scores);
+        for (size_t i = 0; i < n; ++i) {
+            hits[offset + i].first.second = _batch_scores[i];
+        }
+    }
+}
+
+void
+DocumentScorer::score_prefetched(TaggedHits &hits)
+{
+    _batch_docids.reserve(RankProgram::BATCH_SIZE);
+    for (size_t offset = 0; offset < hits.size(); offset += RankProgram::BATCH_SIZE) {
+        size_t n = std::min(RankProgram::BATCH_SIZE, hits.size() - offset);
+        _batch_docids.clear();
+        for (size_t i = 0; i < n; ++i) {
+            _batch_docids.push_back(hits[offset + i].first.first);
+        }
+        _prefetch_program->prefetch(_batch_docids);
+        for (size_t i = 0; i < n; ++i) {
+            hits[offset + i].first.second = doScore(hits[offset + i].first.first);
+        }
+    }
+}
+
 void
 DocumentScorer::score(TaggedHits &hits)
 {
@@ -40,7 +79,15 @@ DocumentScorer::score(TaggedHits &hits)
     }
     auto sort_on_docid = [](const TaggedHit &a, const TaggedHit &b){ return (a.first.first < b.first.first); };
     std::sort(hits.begin(), hits.end(), sort_on_docid);
+    if (_batch_program != nullptr) {
+        score_batched(hits);
+        return;
+    }
     _searchItr.initRange(hits.front().first.first, hits.back().first.first + 1);
+    if (_prefetch_program != nullptr) {
+        score_prefetched(hits);
+        return;
+    }
     for (auto &hit: hits) {
         hit.first.second = doScore(hit.first.first);
     }
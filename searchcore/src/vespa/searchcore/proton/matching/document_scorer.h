@@ -5,6 +5,7 @@
 #include "i_match_loop_communicator.h"
 #include <vespa/searchlib/fef/featureexecutor.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vector>
 
 namespace search::fef {
     class RankProgram;
@@ -16,13 +17,24 @@ namespace proton::matching {
  * Class used to calculate the rank score for a set of documents using
  * a rank program for calculation and a search iterator for unpacking
  * match data. The doScore function must be called with increasing
- * docid.
+ * docid. When the rank program supports batch execution, the hits
+ * given to score are calculated one batch at a time without
+ * unpacking match data. Otherwise, when the rank program supports
+ * prefetching, the hits are prefetched one batch at a time before
+ * they are unpacked and scored one by one.
  */
 class DocumentScorer
 {
 private:
     search::queryeval::SearchIterator &_searchItr;
     search::fef::LazyValue _scoreFeature;
+    search::fef::RankProgram *_batch_program;
+    search::fef::RankProgram *_prefetch_program;
+    std::vector<uint32_t> _batch_docids;
+    std::vector<search::feature_t> _batch_scores;
+
+    void score_batched(IMatchLoopCommunicator::TaggedHits &hits);
+    void score_prefetched(IMatchLoopCommunicator::TaggedHits &hits);
 
 public:
     using TaggedHit = IMatchLoopCommunicator::TaggedHit;
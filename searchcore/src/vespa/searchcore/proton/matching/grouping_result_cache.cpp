@@ -0,0 +1,177 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "grouping_result_cache.h"
+#include "query_result_cache.h"
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/searchlib/fef/properties.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+
+namespace proton::matching {
+
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using search::fef::Properties;
+
+namespace {
+
+size_t estimate_memory_used(const std::string &key, const SearchReply &reply) {
+    size_t bytes = key.size() + sizeof(std::string) + 64; // list node and map entry overhead
+    bytes += reply.hits.size() * sizeof(SearchReply::Hit);
+    bytes += reply.sortIndex.size() * sizeof(uint32_t);
+    bytes += reply.sortData.size();
+    bytes += reply.groupResult.size();
+    bytes += reply.match_features.values.size() * sizeof(SearchReply::FeatureValues::Value);
+    for (const auto &name : reply.match_features.names) {
+        bytes += name.size() + sizeof(std::string);
+    }
+    for (const auto &value : reply.match_features.values) {
+        if (value.is_data()) {
+            bytes += value.as_data().size;
+        }
+    }
+    return bytes;
+}
+
+}
+
+GroupingResultCache::Entry::Entry(const std::string &key_in, uint64_t generation_in, vespalib::steady_time expires_in,
+                                  const SearchReply &reply)
+    : key(key_in),
+      generation(generation_in),
+      expires(expires_in),
+      memory_used(estimate_memory_used(key_in, reply) + sizeof(Entry)),
+      total_hit_count(reply.totalHitCount),
+      coverage(reply.coverage),
+      hits(reply.hits),
+      sort_index(reply.sortIndex),
+      sort_data(reply.sortData),
+      group_result(reply.groupResult),
+      match_features(reply.match_features)
+{ }
+
+GroupingResultCache::Entry::~Entry() = default;
+
+GroupingResultCache::GroupingResultCache(size_t max_bytes, vespalib::duration ttl)
+    : _lock(),
+      _max_bytes(max_bytes),
+      _ttl(ttl),
+      _lru(),
+      _map(),
+      _stats()
+{ }
+
+GroupingResultCache::~GroupingResultCache() = default;
+
+bool
+GroupingResultCache::is_cacheable(const SearchRequest &request)
+{
+    if (request.groupSpec.empty() || request.dumpFeatures || (request.trace().getLevel() != 0)) {
+        return false;
+    }
+    if (request.sessionId.empty()) {
+        return true;
+    }
+    const Properties &cache_props = request.propertiesMap.cacheProperties();
+    return !cache_props.lookup("grouping").found() && !cache_props.lookup("query").found();
+}
+
+std::string
+GroupingResultCache::make_key(const void *owner, const SearchRequest &request)
+{
+    std::string key = QueryResultCache::make_key(request);
+    key.append(reinterpret_cast<const char *>(&owner), sizeof(owner));
+    key.append(request.groupSpec.data(), request.groupSpec.size());
+    return key;
+}
+
+void
+GroupingResultCache::erase(LruList::iterator entry)
+{
+    _stats.memory_used -= entry->memory_used;
+    _map.erase(entry->key);
+    _lru.erase(entry);
+}
+
+std::unique_ptr<SearchReply>
+GroupingResultCache::lookup(const std::string &key, uint64_t generation, vespalib::steady_time now)
+{
+    std::lock_guard guard(_lock);
+    auto found = _map.find(key);
+    if (found == _map.end()) {
+        ++_stats.misses;
+        return {};
+    }
+    if ((found->second->generation != generation) || (found->second->expires < now)) {
+        if (found->second->expires < now) {
+            ++_stats.expired;
+        }
+        erase(found->second);
+        _stats.entries = _lru.size();
+        ++_stats.misses;
+        return {};
+    }
+    ++_stats.hits;
+    _lru.splice(_lru.begin(), _lru, found->second);
+    const Entry &entry = *found->second;
+    auto reply = std::make_unique<SearchReply>();
+    reply->totalHitCount = entry.total_hit_count;
+    reply->coverage = entry.coverage;
+    reply->hits = entry.hits;
+    reply->sortIndex = entry.sort_index;
+    reply->sortData = entry.sort_data;
+    reply->groupResult = entry.group_result;
+    reply->match_features = entry.match_features;
+    return reply;
+}
+
+void
+GroupingResultCache::insert(const std::string &key, uint64_t generation, vespalib::steady_time now,
+                            const SearchReply &reply)
+{
+    std::lock_guard guard(_lock);
+    auto found = _map.find(key);
+    if (found != _map.end()) {
+        if (found->second->generation > generation) {
+            return; // a newer reply is already cached
+        }
+        erase(found->second);
+    }
+    _lru.emplace_front(key, generation, now + _ttl, reply);
+    Entry &entry = _lru.front();
+    if (entry.memory_used > _max_bytes) {
+        _lru.pop_front();
+        _stats.entries = _lru.size();
+        return;
+    }
+    _map[key] = _lru.begin();
+    _stats.memory_used += entry.memory_used;
+    ++_stats.inserts;
+    while (_stats.memory_used > _max_bytes) {
+        erase(std::prev(_lru.end()));
+        ++_stats.evictions;
+    }
+    _stats.entries = _lru.size();
+}
+
+void
+GroupingResultCache::prune(vespalib::steady_time now)
+{
+    std::lock_guard guard(_lock);
+    for (auto it = _lru.begin(); it != _lru.end();) {
+        auto entry = it++;
+        if (entry->expires < now) {
+            erase(entry);
+            ++_stats.expired;
+        }
+    }
+    _stats.entries = _lru.size();
+}
+
+GroupingResultCache::Stats
+GroupingResultCache::get_stats() const
+{
+    std::lock_guard guard(_lock);
+    return _stats;
+}
+
+}
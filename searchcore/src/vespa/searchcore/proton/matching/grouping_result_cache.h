@@ -0,0 +1,111 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/util/time.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace search::engine { class SearchRequest; }
+
+namespace proton::matching {
+
+/**
+ * Cache of the final replies (group tree and hits) of grouping
+ * requests, so that requesting the same page of groups again, or
+ * going back to a previous page, is served without matching. The key
+ * is built from the query and the serialized grouping request. Each
+ * entry is tagged with the commit generation of the sub db it was
+ * produced against and is only served for that generation. Entries
+ * expire after a fixed time to live, and are evicted in LRU order to
+ * stay within the memory budget.
+ **/
+class GroupingResultCache
+{
+public:
+    struct Stats {
+        size_t hits;
+        size_t misses;
+        size_t inserts;
+        size_t evictions;
+        size_t expired;
+        size_t entries;
+        size_t memory_used;
+        Stats() noexcept
+            : hits(0), misses(0), inserts(0), evictions(0), expired(0), entries(0), memory_used(0)
+        {}
+    };
+
+private:
+    using SearchReply = search::engine::SearchReply;
+    struct Entry {
+        std::string           key;
+        uint64_t              generation;
+        vespalib::steady_time expires;
+        size_t                memory_used;
+        uint64_t              total_hit_count;
+        search::engine::Coverage coverage;
+        std::vector<SearchReply::Hit> hits;
+        std::vector<uint32_t> sort_index;
+        std::vector<char>     sort_data;
+        vespalib::Array<char> group_result;
+        SearchReply::FeatureValues match_features;
+        Entry(const std::string &key_in, uint64_t generation_in, vespalib::steady_time expires_in,
+              const SearchReply &reply);
+        ~Entry();
+    };
+    using LruList = std::list<Entry>;
+    using Map = vespalib::hash_map<std::string, LruList::iterator>;
+
+    mutable std::mutex       _lock;
+    const size_t             _max_bytes;
+    const vespalib::duration _ttl;
+    LruList                  _lru;
+    Map                      _map;
+    Stats                    _stats;
+
+    void erase(LruList::iterator entry);
+public:
+    GroupingResultCache(size_t max_bytes, vespalib::duration ttl);
+    GroupingResultCache(const GroupingResultCache &) = delete;
+    GroupingResultCache & operator=(const GroupingResultCache &) = delete;
+    ~GroupingResultCache();
+
+    /**
+     * Only plain grouping requests are cached. Requests that keep
+     * grouping or search sessions, trace or dump features are not.
+     **/
+    static bool is_cacheable(const search::engine::SearchRequest &request);
+
+    /**
+     * The owner identifies the sub db the request is matched against,
+     * since the session manager is shared by all document dbs.
+     **/
+    static std::string make_key(const void *owner, const search::engine::SearchRequest &request);
+
+    /**
+     * Returns a copy of the cached reply for the given key, or an
+     * empty pointer if it is not cached for the given generation or
+     * has expired.
+     **/
+    std::unique_ptr<SearchReply> lookup(const std::string &key, uint64_t generation, vespalib::steady_time now);
+
+    /**
+     * Store a reply produced against the given generation.
+     **/
+    void insert(const std::string &key, uint64_t generation, vespalib::steady_time now, const SearchReply &reply);
+
+    /**
+     * Drop all entries that have expired at the given time.
+     **/
+    void prune(vespalib::steady_time now);
+
+    size_t max_bytes() const noexcept { return _max_bytes; }
+    vespalib::duration ttl() const noexcept { return _ttl; }
+    Stats get_stats() const;
+};
+
+}
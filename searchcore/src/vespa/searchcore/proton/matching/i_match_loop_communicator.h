@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/searchlib/common/feature.h>
 #include <vespa/searchlib/queryeval/scores.h>
 #include <vespa/searchlib/queryeval/sorted_hit_sequence.h>
 #include <utility>
@@ -32,6 +33,9 @@ struct IMatchLoopCommunicator {
     virtual double estimate_match_frequency(const Matches &matches) = 0;
     virtual TaggedHits get_second_phase_work(SortedHitSequence sortedHits, size_t thread_id) = 0;
     virtual std::pair<Hits,RangePair> complete_second_phase(TaggedHits my_results, size_t thread_id) = 0;
+    // true if match threads should publish the lowest first-phase score of their full hit heaps
+    virtual bool accepts_score_threshold() const = 0;
+    virtual void publish_score_threshold(search::feature_t score) = 0;
     virtual ~IMatchLoopCommunicator() = default;
 };
 
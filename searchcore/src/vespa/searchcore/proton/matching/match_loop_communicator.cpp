@@ -2,6 +2,7 @@
 
 #include "match_loop_communicator.h"
 #include <vespa/searchlib/features/first_phase_rank_lookup.h>
+#include <vespa/searchlib/queryeval/rank_score_threshold.h>
 #include <vespa/vespalib/util/priority_queue.h>
 #include <vespa/vespalib/util/rendezvous.hpp>
 
@@ -17,10 +18,19 @@ MatchLoopCommunicator::MatchLoopCommunicator(size_t threads, size_t topN, std::u
       _best_dropped(),
       _estimate_match_frequency(threads),
       _get_second_phase_work(threads, topN, _best_scores, _best_dropped, std::move(diversifier), first_phase_rank_lookup, std::move(before_second_phase)),
-      _complete_second_phase(threads, topN, _best_scores, _best_dropped)
+      _complete_second_phase(threads, topN, _best_scores, _best_dropped),
+      _score_threshold(nullptr)
 {}
 MatchLoopCommunicator::~MatchLoopCommunicator() = default;
 
+void
+MatchLoopCommunicator::publish_score_threshold(search::feature_t score)
+{
+    if (_score_threshold != nullptr) {
+        _score_threshold->raise(score);
+    }
+}
+
 void
 MatchLoopCommunicator::EstimateMatchFrequency::mingle()
 {
@@ -68,7 +78,9 @@ MatchLoopCommunicator::GetSecondPhaseWork::GetSecondPhaseWork(size_t n, size_t t
       best_dropped(best_dropped_in),
       _diversifier(std::move(diversifier)),
       _first_phase_rank_lookup(first_phase_rank_lookup),
-      _before_second_phase(std::move(before_second_phase))
+      _before_second_phase(std::move(before_second_phase)),
+      capture_hits(0),
+      captured_hits()
 {}
 
 MatchLoopCommunicator::GetSecondPhaseWork::~GetSecondPhaseWork() = default;
@@ -138,6 +150,25 @@ MatchLoopCommunicator::GetSecondPhaseWork::mingle()
     } else {
         mingle(queue, NoRegisterFirstPhaseRank());
     }
+    if (capture_hits > 0) {
+        capture_picked_hits();
+    }
+}
+
+void
+MatchLoopCommunicator::GetSecondPhaseWork::capture_picked_hits()
+{
+    // hits are picked in rank order and dealt round-robin to the threads
+    size_t picked = 0;
+    for (size_t i = 0; i < size(); ++i) {
+        picked += out(i).size();
+    }
+    size_t wanted = std::min(picked, capture_hits);
+    captured_hits.clear();
+    captured_hits.reserve(wanted);
+    for (size_t n = 0; n < wanted; ++n) {
+        captured_hits.push_back(out(n % size())[n / size()].first);
+    }
 }
 
 void
@@ -8,6 +8,7 @@
 #include <functional>
 
 namespace search::features { class FirstPhaseRankLookup; }
+namespace search::queryeval { class RankScoreThreshold; }
 
 namespace proton::matching {
 
@@ -16,6 +17,7 @@ class MatchLoopCommunicator final : public IMatchLoopCommunicator
 private:
     using IDiversifier = search::queryeval::IDiversifier;
     using FirstPhaseRankLookup = search::features::FirstPhaseRankLookup;
+    using RankScoreThreshold = search::queryeval::RankScoreThreshold;
     struct BestDropped {
         bool valid = false;
         search::feature_t score = 0.0;
@@ -31,9 +33,12 @@ private:
         std::unique_ptr<IDiversifier> _diversifier;
         FirstPhaseRankLookup* _first_phase_rank_lookup;
         std::function<void()> _before_second_phase;
+        size_t capture_hits;
+        Hits captured_hits;
         GetSecondPhaseWork(size_t n, size_t topN_in, Range &best_scores_in, BestDropped &best_dropped_in, std::unique_ptr<IDiversifier> diversifier, FirstPhaseRankLookup* first_phase_rank_lookup, std::function<void()> before_second_phase);
         ~GetSecondPhaseWork() override;
         void mingle() override;
+        void capture_picked_hits();
         template<typename Q, typename R>
         void mingle(Q &queue, R register_first_phase_rank);
         template<typename Q, typename F, typename R>
@@ -64,6 +69,7 @@ private:
     EstimateMatchFrequency _estimate_match_frequency;
     GetSecondPhaseWork     _get_second_phase_work;
     CompleteSecondPhase    _complete_second_phase;
+    RankScoreThreshold    *_score_threshold;
 
 public:
     MatchLoopCommunicator(size_t threads, size_t topN);
@@ -81,6 +87,16 @@ public:
     std::pair<Hits,RangePair> complete_second_phase(TaggedHits my_results, size_t thread_id) override {
         return _complete_second_phase.rendezvous(std::move(my_results), thread_id);
     }
+
+    // keep a copy of the best first-phase hits selected for second phase ranking
+    void capture_first_phase_hits(size_t max_hits) noexcept { _get_second_phase_work.capture_hits = max_hits; }
+    // only valid after get_second_phase_work has returned
+    const Hits &first_phase_hits() const noexcept { return _get_second_phase_work.captured_hits; }
+
+    // published thresholds are raised into the given shared threshold (nullptr disables publishing)
+    void set_score_threshold(RankScoreThreshold *score_threshold) noexcept { _score_threshold = score_threshold; }
+    bool accepts_score_threshold() const override { return (_score_threshold != nullptr); }
+    void publish_score_threshold(search::feature_t score) override;
 };
 
 }
@@ -8,7 +8,7 @@
 #include "extract_features.h"
 #include "partial_result.h"
 #include <vespa/searchlib/engine/trace.h>
-#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchapi.h>
 #include <vespa/vespalib/util/thread_bundle.h>
 #include <vespa/vespalib/util/issue.h>
 #include <vespa/vespalib/data/slime/inserter.h>
@@ -27,16 +27,23 @@ namespace {
 
 using namespace vespalib::literals;
 
+// number of chunks each thread initially splits its share of the docid space into when work-stealing
+constexpr uint32_t CHUNKS_PER_THREAD = 16;
+
 struct TimedMatchLoopCommunicator final : IMatchLoopCommunicator {
     IMatchLoopCommunicator &communicator;
     vespalib::Timer timer;
     vespalib::duration elapsed;
+    std::function<void()> first_phase_done;
     TimedMatchLoopCommunicator(IMatchLoopCommunicator &com) : communicator(com), elapsed(vespalib::duration::zero()) {}
     double estimate_match_frequency(const Matches &matches) override {
         return communicator.estimate_match_frequency(matches);
     }
     TaggedHits get_second_phase_work(SortedHitSequence sortedHits, size_t thread_id) override {
         auto result = communicator.get_second_phase_work(sortedHits, thread_id);
+        if (first_phase_done) {
+            first_phase_done();
+        }
         timer = vespalib::Timer();
         return result;
     }
@@ -45,11 +52,21 @@ struct TimedMatchLoopCommunicator final : IMatchLoopCommunicator {
         elapsed = timer.elapsed();
         return result;
     }
+    bool accepts_score_threshold() const override {
+        return communicator.accepts_score_threshold();
+    }
+    void publish_score_threshold(search::feature_t score) override {
+        communicator.publish_score_threshold(score);
+    }
 };
 
 DocidRangeScheduler::UP
-createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs)
+createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, bool workStealing, uint32_t numDocs)
 {
+    if (workStealing && (numThreads > 1)) {
+        uint32_t chunkSize = numDocs / (numThreads * CHUNKS_PER_THREAD);
+        return std::make_unique<WorkStealingDocidRangeScheduler>(numThreads, chunkSize, numDocs);
+    }
     if (numSearchPartitions == 0) {
         return std::make_unique<AdaptiveDocidRangeScheduler>(numThreads, 1, numDocs);
     }
@@ -82,7 +99,11 @@ MatchMaster::match(search::engine::Trace & trace,
                    const MatchToolsFactory &mtf,
                    ResultProcessor &resultProcessor,
                    uint32_t distributionKey,
-                   uint32_t numSearchPartitions)
+                   uint32_t numSearchPartitions,
+                   bool workStealing,
+                   search::queryeval::RankScoreThreshold *score_threshold,
+                   search::engine::SearchClient *partial_reply_client,
+                   AggregatedProfiles *sampled_profiles)
 {
     vespalib::Timer query_latency_time;
     vespalib::DualMergeDirector mergeDirector(threadBundle.size());
@@ -93,8 +114,18 @@ MatchMaster::match(search::engine::Trace & trace,
     MatchLoopCommunicator communicator(threadBundle.size(), params.heapSize, mtf.createDiversifier(params.diversity_want_hits),
                                        mtf.get_first_phase_rank_lookup(),
                                        [&mtf]() noexcept { mtf.query().set_matching_phase(MatchingPhase::SECOND_PHASE); });
+    communicator.set_score_threshold(score_threshold);
     TimedMatchLoopCommunicator timedCommunicator(communicator);
-    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs);
+    if (partial_reply_client != nullptr) {
+        // the first match thread hands out the first-phase top hits while the others start second phase ranking
+        communicator.capture_first_phase_hits(params.offset + params.hits);
+        timedCommunicator.first_phase_done = [&]() {
+            auto partial = resultProcessor.make_partial_reply(communicator.first_phase_hits());
+            partial->setDistributionKey(distributionKey);
+            partial_reply_client->searchPartial(std::move(partial));
+        };
+    }
+    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, workStealing, params.numDocs);
 
     std::vector<MatchThread::UP> threadState;
     for (size_t i = 0; i < threadBundle.size(); ++i) {
@@ -102,18 +133,22 @@ MatchMaster::match(search::engine::Trace & trace,
             ? static_cast<IMatchLoopCommunicator&>(timedCommunicator)
             : static_cast<IMatchLoopCommunicator&>(communicator);
         threadState.emplace_back(std::make_unique<MatchThread>(i, threadBundle.size(), params, mtf, com, *scheduler,
-                                                               resultProcessor, mergeDirector, distributionKey, trace));
+                                                               resultProcessor, mergeDirector, distributionKey, trace,
+                                                               sampled_profiles));
     }
     resultProcessor.prepareThreadContextCreation(threadBundle.size());
+    auto run_start = vespalib::steady_clock::now();
     threadBundle.run(threadState);
     auto reply = make_reply(mtf, resultProcessor, threadBundle, threadState[0]->extract_result());
     double query_time_s = vespalib::to_s(query_latency_time.elapsed());
     double rerank_time_s = vespalib::to_s(timedCommunicator.elapsed);
     double match_time_s = 0.0;
+    vespalib::duration wakeup_time = vespalib::duration::zero();
     auto inserter = trace.make_inserter("query_execution"_ssv);
     for (size_t i = 0; i < threadState.size(); ++i) {
         const MatchThread & matchThread = *threadState[i];
         match_time_s = std::max(match_time_s, matchThread.get_match_time());
+        wakeup_time = std::max(wakeup_time, matchThread.get_start_time() - run_start);
         _stats.merge_partition(matchThread.get_thread_stats(), i);
         inserter.handle_thread(matchThread.getTrace());
         matchThread.get_issues().for_each_message([](const auto &msg){ Issue::report(Issue(msg)); });
@@ -122,9 +157,17 @@ MatchMaster::match(search::engine::Trace & trace,
     _stats.matchTime(match_time_s - rerank_time_s);
     _stats.rerankTime(rerank_time_s);
     _stats.groupingTime(query_time_s - match_time_s);
+    if (threadState.size() > 1) {
+        _stats.wakeupTime(vespalib::to_s(wakeup_time));
+    }
     _stats.queries(1);
     if (mtf.match_limiter().was_limited()) {
         _stats.limited_queries(1);        
+        size_t adaptive_max_hits = mtf.match_limiter().adaptive_max_hits();
+        if (adaptive_max_hits > 0) {
+            _stats.adaptive_limited_queries(1);
+            _stats.adaptiveMaxHits(adaptive_max_hits);
+        }
     }
     return reply;
 }
@@ -7,10 +7,15 @@
 
 namespace vespalib { struct ThreadBundle; }
 namespace search { class FeatureSet; }
-namespace search::engine { class Trace; }
+namespace search::engine {
+    class SearchClient;
+    class Trace;
+}
+namespace search::queryeval { class RankScoreThreshold; }
 
 namespace proton::matching {
 
+class AggregatedProfiles;
 class MatchToolsFactory;
 struct MatchParams;
 
@@ -30,7 +35,11 @@ public:
                                       const MatchToolsFactory &mtf,
                                       ResultProcessor &resultProcessor,
                                       uint32_t distributionKey,
-                                      uint32_t numSearchPartitions);
+                                      uint32_t numSearchPartitions,
+                                      bool workStealing,
+                                      search::queryeval::RankScoreThreshold *score_threshold = nullptr,
+                                      search::engine::SearchClient *partial_reply_client = nullptr,
+                                      AggregatedProfiles *sampled_profiles = nullptr);
 
     static MatchingStats getStats(MatchMaster && rhs) { return std::move(rhs._stats); }
 };
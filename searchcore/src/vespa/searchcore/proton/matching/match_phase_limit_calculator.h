@@ -33,8 +33,12 @@ public:
     size_t sample_hits_per_thread(size_t num_threads) const noexcept {
         return std::max(size_t(1), std::max(128 / num_threads, _sample_hits / num_threads));
     }
+    size_t max_hits() const noexcept { return _max_hits; }
     size_t wanted_num_docs(double hit_rate) const noexcept {
-        return std::min((double)0x7fffFFFF, std::max(128.0, _max_hits / hit_rate));
+        return wanted_num_docs(hit_rate, _max_hits);
+    }
+    size_t wanted_num_docs(double hit_rate, size_t max_hits) const noexcept {
+        return std::min((double)0x7fffFFFF, std::max(128.0, max_hits / hit_rate));
     }
     size_t estimated_hits(double hit_rate, size_t num_docs) const noexcept {
         return (size_t) (hit_rate * num_docs);
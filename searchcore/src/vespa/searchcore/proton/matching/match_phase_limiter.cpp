@@ -2,7 +2,9 @@
 
 #include "match_phase_limiter.h"
 #include <vespa/searchlib/queryeval/andsearchstrict.h>
+#include <vespa/searchlib/queryeval/irequestcontext.h>
 #include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/util/doom.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.match_phase_limiter");
@@ -74,11 +76,15 @@ MatchPhaseLimiter::MatchPhaseLimiter(uint32_t docIdLimit,
                                      const DiversityParams &diversity)
     : _postFilterMultiplier(degradation.post_filter_multiplier),
       _maxFilterCoverage(degradation.max_filter_coverage),
+      _adaptive(degradation.adaptive),
+      _costPerHit(degradation.cost_per_hit_s),
+      _doom(requestContext.getDoom()),
       _calculator(degradation.max_hits, diversity.min_groups, degradation.sample_percentage),
       _limiter_factory(rangeQueryLocator, searchable_attributes, requestContext,
                        degradation.attribute, degradation.descending,
                        diversity.attribute, diversity.cutoff_factor, diversity.cutoff_strategy),
-      _coverage(docIdLimit)
+      _coverage(docIdLimit),
+      _adaptiveMaxHits(0)
 { }
 
 MatchPhaseLimiter::~MatchPhaseLimiter() = default;
@@ -105,12 +111,39 @@ do_limit(AttributeLimiter &limiter_factory, SearchIterator::UP search, double ma
 // When hitrate is below 0.2% limiting the query is often far more expensive than not.
 constexpr double MIN_HIT_RATE_LIMIT = 0.002;
 
+// Part of the time left that adaptive limiting plans to spend on matching, the rest is slack for ranking and merging.
+constexpr double ADAPTIVE_TIME_BUDGET_FRACTION = 0.8;
+
 } // namespace proton::matching::<unnamed>
 
+size_t
+MatchPhaseLimiter::select_max_hits(Cursor * trace)
+{
+    size_t max_hits = _calculator.max_hits();
+    if (!_adaptive || (_costPerHit <= 0.0)) {
+        return max_hits;
+    }
+    double time_left_s = std::max(0.0, vespalib::to_s(_doom.soft_left()));
+    double affordable_hits = (time_left_s * ADAPTIVE_TIME_BUDGET_FRACTION) / _costPerHit;
+    size_t adaptive_max_hits = (affordable_hits < max_hits)
+                               ? std::max(size_t(1), static_cast<size_t>(affordable_hits))
+                               : max_hits;
+    if (trace) {
+        trace->setBool("adaptive", true);
+        trace->setDouble("cost_per_hit_ms", _costPerHit * 1000.0);
+        trace->setDouble("time_left_ms", time_left_s * 1000.0);
+        trace->setLong("adaptive_max_hits", adaptive_max_hits);
+    }
+    if (adaptive_max_hits < max_hits) {
+        _adaptiveMaxHits.store(adaptive_max_hits, std::memory_order_relaxed);
+    }
+    return adaptive_max_hits;
+}
+
 SearchIterator::UP
 MatchPhaseLimiter::maybe_limit(SearchIterator::UP search, double match_freq, size_t num_docs, Cursor * trace)
 {
-    size_t wanted_num_docs = _calculator.wanted_num_docs(match_freq);
+    size_t wanted_num_docs = _calculator.wanted_num_docs(match_freq, select_max_hits(trace));
     size_t max_filter_docs = static_cast<size_t>(num_docs * _maxFilterCoverage);
     size_t upper_limited_corpus_size = std::min(num_docs, max_filter_docs);
     if (trace) {
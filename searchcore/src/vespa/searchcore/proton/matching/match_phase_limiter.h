@@ -7,6 +7,8 @@
 #include <vespa/searchlib/queryeval/searchiterator.h>
 #include <atomic>
 
+namespace vespalib { class Doom; }
+
 namespace proton::matching {
 
 class RangeQueryLocator;
@@ -50,6 +52,8 @@ struct MaybeMatchPhaseLimiter {
     virtual SearchIterator::UP maybe_limit(SearchIterator::UP search, double match_freq, size_t num_docs, Cursor * trace) = 0;
     virtual void updateDocIdSpaceEstimate(size_t searchedDocIdSpace, size_t remainingDocIdSpace) = 0;
     virtual size_t getDocIdSpaceEstimate() const = 0;
+    // max hits chosen to fit the time left for the query, 0 if the configured max hits was used
+    virtual size_t adaptive_max_hits() const = 0;
     virtual ~MaybeMatchPhaseLimiter() = default;
 };
 
@@ -65,6 +69,7 @@ struct NoMatchPhaseLimiter : MaybeMatchPhaseLimiter {
     }
     void updateDocIdSpaceEstimate(size_t, size_t) override { }
     size_t getDocIdSpaceEstimate() const override { return std::numeric_limits<size_t>::max(); }
+    size_t adaptive_max_hits() const override { return 0; }
 };
 
 struct DiversityParams {
@@ -92,7 +97,9 @@ struct DegradationParams {
           max_hits(max_hits_),
           max_filter_coverage(max_filter_coverage_),
           sample_percentage(sample_percentage_),
-          post_filter_multiplier(post_filter_multiplier_)
+          post_filter_multiplier(post_filter_multiplier_),
+          adaptive(false),
+          cost_per_hit_s(0.0)
     { }
     bool enabled() const { return !attribute.empty() && (max_hits > 0); }
     std::string attribute;
@@ -101,6 +108,9 @@ struct DegradationParams {
     double           max_filter_coverage;
     double           sample_percentage;
     double           post_filter_multiplier;
+    // lower max_hits to what can be matched within the time left, using the observed cost per hit
+    bool             adaptive;
+    double           cost_per_hit_s;
 };
 
 /**
@@ -129,10 +139,15 @@ private:
     };
     const double              _postFilterMultiplier;
     const double              _maxFilterCoverage;
+    const bool                _adaptive;
+    const double              _costPerHit;
+    const vespalib::Doom    & _doom;
     MatchPhaseLimitCalculator _calculator;
     AttributeLimiter          _limiter_factory;
     Coverage                  _coverage;
+    std::atomic<size_t>       _adaptiveMaxHits;
 
+    size_t select_max_hits(Cursor * trace);
 
 public:
     MatchPhaseLimiter(uint32_t docIdLimit,
@@ -150,6 +165,7 @@ public:
     SearchIterator::UP maybe_limit(SearchIterator::UP search, double match_freq, size_t num_docs, Cursor * trace) override;
     void updateDocIdSpaceEstimate(size_t searchedDocIdSpace, size_t remainingDocIdSpace) override;
     size_t getDocIdSpaceEstimate() const override;
+    size_t adaptive_max_hits() const override { return _adaptiveMaxHits.load(std::memory_order_relaxed); }
 };
 
 }
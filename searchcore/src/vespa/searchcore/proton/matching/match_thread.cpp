@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "match_thread.h"
+#include "aggregated_profiles.h"
 #include "document_scorer.h"
 #include "match_tools.h"
 #include "partial_result.h"
@@ -15,6 +16,7 @@
 #include <vespa/searchlib/queryeval/profiled_iterator.h>
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <vespa/vespalib/data/slime/slime.h>
 #include <limits>
 
 #include <vespa/log/log.h>
@@ -100,21 +102,56 @@ fillPartialResult(ResultProcessor::Context & context, size_t totalHits, size_t n
 
 //-----------------------------------------------------------------------------
 
-MatchThread::Context::Context(std::optional<double> first_phase_rank_score_drop_limit, MatchTools &tools, HitCollector &hits, uint32_t num_threads)
+MatchThread::Context::Context(std::optional<double> first_phase_rank_score_drop_limit, MatchTools &tools, HitCollector &hits,
+                              uint32_t num_threads, IMatchLoopCommunicator *threshold_communicator)
     : matches(0),
       _matches_limit(tools.match_limiter().sample_hits_per_thread(num_threads)),
       _score_feature(get_score_feature(tools.rank_program())),
+      _batch_program(tools.rank_program().supports_batch() ? &tools.rank_program() : nullptr),
+      _batch_docids(),
+      _batch_scores(),
       _first_phase_rank_score_drop_limit(first_phase_rank_score_drop_limit.value_or(0.0 /* ignored */)),
       _hits(hits),
+      _threshold_communicator(threshold_communicator),
+      _published_threshold(-HUGE_VAL),
       _doom(tools.getDoom()),
       dropped()
 {
+    if (_batch_program != nullptr) {
+        _batch_docids.reserve(RankProgram::BATCH_SIZE);
+        _batch_scores.resize(RankProgram::BATCH_SIZE);
+    }
 }
 
 template <MatchThread::RankDropLimitE use_rank_drop_limit>
 void
 MatchThread::Context::rankHit(uint32_t docId) {
-    double score = _score_feature.as_number(docId);
+    if (_batch_program != nullptr) {
+        _batch_docids.push_back(docId);
+        if (_batch_docids.size() == RankProgram::BATCH_SIZE) {
+            flushBatch<use_rank_drop_limit>();
+        }
+        return;
+    }
+    addScoredHit<use_rank_drop_limit>(docId, _score_feature.as_number(docId));
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::flushBatch() {
+    if (_batch_docids.empty()) {
+        return;
+    }
+    _batch_program->execute_batch(_batch_docids, _batch_scores);
+    for (size_t i = 0; i < _batch_docids.size(); ++i) {
+        addScoredHit<use_rank_drop_limit>(_batch_docids[i], _batch_scores[i]);
+    }
+    _batch_docids.clear();
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::addScoredHit(uint32_t docId, double score) {
     // convert NaN and Inf scores to -Inf
     if (__builtin_expect(std::isnan(score) || std::isinf(score), false)) {
         score = -HUGE_VAL;
@@ -128,6 +165,18 @@ MatchThread::Context::rankHit(uint32_t docId) {
     } else {
         _hits.addHit(docId, score);
     }
+    if (_threshold_communicator != nullptr) {
+        auto threshold = _hits.get_score_threshold();
+        if (__builtin_expect(threshold.has_value() && (threshold.value() > _published_threshold), false)) {
+            publishScoreThreshold(threshold.value());
+        }
+    }
+}
+
+void
+MatchThread::Context::publishScoreThreshold(double threshold) {
+    _published_threshold = threshold;
+    _threshold_communicator->publish_score_threshold(threshold);
 }
 
 //-----------------------------------------------------------------------------
@@ -207,6 +256,9 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
             docId = Strategy::seek_next(*search, docId + 1);
         }
     }
+    if (do_rank) {
+        context.flushBatch<use_rank_drop_limit>();
+    }
     return docId;
 }
 
@@ -218,7 +270,8 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     bool softDoomed = false;
     uint32_t docsCovered = 0;
     vespalib::duration overtime(vespalib::duration::zero());
-    Context context(matchParams.first_phase_rank_score_drop_limit, tools, hits, num_threads);
+    Context context(matchParams.first_phase_rank_score_drop_limit, tools, hits, num_threads,
+                    communicator.accepts_score_threshold() ? &communicator : nullptr);
     for (DocidRange docid_range = scheduler.first_range(thread_id);
          !docid_range.empty();
          docid_range = scheduler.next_range(thread_id))
@@ -245,6 +298,8 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     thread_stats.docsCovered(docsCovered);
     thread_stats.docsMatched(matches);
     thread_stats.softDoomed(softDoomed);
+    thread_stats.steals(scheduler.steal_count(thread_id));
+    thread_stats.failed_steals(scheduler.failed_steal_count(thread_id));
     if (softDoomed) {
         thread_stats.doomOvertime(overtime);
     }
@@ -427,17 +482,26 @@ MatchThread::processResult(const Doom & doom, search::ResultSet::UP result, Resu
     }
     if (doom.hard_doom()) return;
     if (hasGrouping) {
+        trace->addEvent(5, "Start unordered grouping");
+        vespalib::Timer grouping_time;
         search::grouping::GroupingManager man(*context.grouping);
         man.groupUnordered(_distributionKey, hits, numHits, bits);
+        grouping_time_s += vespalib::to_s(grouping_time.elapsed());
     }
     if (doom.hard_doom()) return;
     size_t sortLimit = hasGrouping ? numHits : context.result->maxSize();
+    // Each thread builds sort data for and sorts its own hits, the sorted runs are merged by the merge director
+    vespalib::Timer sort_time;
     result->sort(*context.sort->sorter, sortLimit);
+    sort_time_s = vespalib::to_s(sort_time.elapsed());
     if (doom.hard_doom()) return;
     if (hasGrouping) {
+        trace->addEvent(5, "Start grouping in relevance order");
+        vespalib::Timer grouping_time;
         search::grouping::GroupingManager man(*context.grouping);
         man.groupInRelevanceOrder(_distributionKey, hits, numHits);
         man.convertToGlobalId(matchToolsFactory.metaStore());
+        grouping_time_s += vespalib::to_s(grouping_time.elapsed());
     }
     if (doom.hard_doom()) return;
     fillPartialResult(context, totalHits, numHits, hits, bits);
@@ -461,7 +525,8 @@ MatchThread::MatchThread(size_t thread_id_in,
                          ResultProcessor &rp,
                          vespalib::DualMergeDirector &md,
                          uint32_t distributionKey,
-                         const Trace &parent_trace)
+                         const Trace &parent_trace,
+                         AggregatedProfiles *sampled_profiles)
   : thread_id(thread_id_in),
     num_threads(num_threads_in),
     matchParams(mp),
@@ -474,33 +539,45 @@ MatchThread::MatchThread(size_t thread_id_in,
     mergeDirector(md),
     resultContext(),
     thread_stats(),
+    start_time(),
     total_time_s(0.0),
     match_time_s(0.0),
     wait_time_s(0.0),
+    grouping_time_s(0.0),
+    sort_time_s(0.0),
+    merge_time_s(0.0),
     match_with_ranking(mtf.has_first_phase_rank() && mp.save_rank_scores()),
     trace(parent_trace.make_trace_up()),
     match_profiler(),
     first_phase_profiler(),
     second_phase_profiler(),
+    aggregated_profiles(nullptr),
     my_issues()
 {
     if (trace->getLevel() > 0) {
         if (int32_t depth = trace->match_profile_depth(); depth != 0) {
-            match_profiler = std::make_unique<vespalib::ExecutionProfiler>(depth);
+            match_profiler = std::make_unique<vespalib::ExecutionProfiler>(depth, trace->profile_hw_counters());
         }
         if (int32_t depth = trace->first_phase_profile_depth(); depth != 0) {
-            first_phase_profiler = std::make_unique<vespalib::ExecutionProfiler>(depth);
+            first_phase_profiler = std::make_unique<vespalib::ExecutionProfiler>(depth, trace->profile_hw_counters());
         }
         if (int32_t depth = trace->second_phase_profile_depth(); depth != 0) {
-            second_phase_profiler = std::make_unique<vespalib::ExecutionProfiler>(depth);
+            second_phase_profiler = std::make_unique<vespalib::ExecutionProfiler>(depth, trace->profile_hw_counters());
         }
     }
+    if ((sampled_profiles != nullptr) && !match_profiler && !first_phase_profiler && !second_phase_profiler) {
+        aggregated_profiles = sampled_profiles;
+        match_profiler = std::make_unique<vespalib::ExecutionProfiler>(sampled_profiles->depth());
+        first_phase_profiler = std::make_unique<vespalib::ExecutionProfiler>(sampled_profiles->depth());
+        second_phase_profiler = std::make_unique<vespalib::ExecutionProfiler>(sampled_profiles->depth());
+    }
 }
 
 void
 MatchThread::run()
 {
     vespalib::Timer total_time;
+    start_time = total_time.get_start();
     vespalib::Timer match_time(total_time);
     auto capture_issues = vespalib::Issue::listen(my_issues);
     trace->addEvent(4, "Start MatchThread::run");
@@ -529,8 +606,30 @@ MatchThread::run()
     total_time_s = vespalib::to_s(total_time.elapsed());
     thread_stats.active_time(total_time_s - wait_time_s).wait_time(wait_time_s);
     trace->addEvent(4, "Start thread merge");
+    vespalib::Timer merge_time;
     mergeDirector.dualMerge(thread_id, *resultContext->result, resultContext->groupingSource);
+    merge_time_s = vespalib::to_s(merge_time.elapsed());
     trace->addEvent(4, "MatchThread::run Done");
+    if (resultContext->grouping && trace->shouldTrace(4)) {
+        auto &cursor = trace->createCursor("grouping");
+        cursor.setDouble("aggregation_time_ms", grouping_time_s * 1000.0);
+        cursor.setDouble("merge_time_ms", merge_time_s * 1000.0);
+    }
+    if (resultContext->sort->hasSortData() && trace->shouldTrace(4)) {
+        auto &cursor = trace->createCursor("sort");
+        cursor.setDouble("sort_time_ms", sort_time_s * 1000.0);
+        cursor.setDouble("merge_time_ms", merge_time_s * 1000.0);
+    }
+    if (aggregated_profiles != nullptr) {
+        aggregate_profiles();
+    } else {
+        report_profiles();
+    }
+}
+
+void
+MatchThread::report_profiles()
+{
     if (match_profiler) {
         match_profiler->report(trace->createCursor("match_profiling"));
     }
@@ -544,6 +643,22 @@ MatchThread::run()
     }
 }
 
+void
+MatchThread::aggregate_profiles()
+{
+    auto merge = [](const vespalib::ExecutionProfiler &profiler, vespalib::ExecutionProfileAggregator &aggregator,
+                    const vespalib::ExecutionProfiler::NameMapper &name_mapper)
+                 {
+                     vespalib::Slime report;
+                     profiler.report(report.setObject(), name_mapper);
+                     aggregator.merge(report.get());
+                 };
+    auto describe_feature = [](const std::string &name){ return BlueprintResolver::describe_feature(name); };
+    merge(*match_profiler, aggregated_profiles->match(), [](const std::string &name) noexcept { return name; });
+    merge(*first_phase_profiler, aggregated_profiles->first_phase(), describe_feature);
+    merge(*second_phase_profiler, aggregated_profiles->second_phase(), describe_feature);
+}
+
 std::unique_ptr<PartialResult>
 MatchThread::extract_result() {
     return std::move(resultContext->result);
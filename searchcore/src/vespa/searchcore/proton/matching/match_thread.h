@@ -27,6 +27,7 @@ namespace search::queryeval { class SearchIterator; }
 
 namespace proton::matching {
 
+class AggregatedProfiles;
 class MatchTools;
 class MatchToolsFactory;
 
@@ -61,22 +62,29 @@ private:
     vespalib::DualMergeDirector  &mergeDirector;
     std::unique_ptr<ResultProcessor::Context>  resultContext;
     MatchingStats::Partition      thread_stats;
+    vespalib::steady_time         start_time;
     double                        total_time_s;
     double                        match_time_s;
     double                        wait_time_s;
+    double                        grouping_time_s;
+    double                        sort_time_s;
+    double                        merge_time_s;
     bool                          match_with_ranking;
     std::unique_ptr<Trace>        trace;
     std::unique_ptr<vespalib::ExecutionProfiler> match_profiler;
     std::unique_ptr<vespalib::ExecutionProfiler> first_phase_profiler;
     std::unique_ptr<vespalib::ExecutionProfiler> second_phase_profiler;
+    AggregatedProfiles           *aggregated_profiles;
     UniqueIssues                  my_issues;
 
     class Context {
     public:
         Context(std::optional<double> first_phase_rank_score_drop_limit, MatchTools &tools, HitCollector &hits,
-                uint32_t num_threads) __attribute__((noinline));
+                uint32_t num_threads, IMatchLoopCommunicator *threshold_communicator) __attribute__((noinline));
         template <RankDropLimitE use_rank_drop_limit>
         void rankHit(uint32_t docId);
+        template <RankDropLimitE use_rank_drop_limit>
+        void flushBatch();
         void addHit(uint32_t docId) { _hits.addHit(docId, search::zero_rank_value); }
         bool isBelowLimit() const { return matches < _matches_limit; }
         bool    isAtLimit() const { return matches == _matches_limit; }
@@ -84,10 +92,18 @@ private:
         vespalib::duration timeLeft() const { return _doom.soft_left(); }
         uint32_t        matches;
     private:
+        template <RankDropLimitE use_rank_drop_limit>
+        void addScoredHit(uint32_t docId, double score);
+        void publishScoreThreshold(double threshold) __attribute__((noinline));
         uint32_t        _matches_limit;
         LazyValue       _score_feature;
+        RankProgram    *_batch_program;
+        std::vector<uint32_t>  _batch_docids;
+        std::vector<search::feature_t> _batch_scores;
         double          _first_phase_rank_score_drop_limit;
         HitCollector   &_hits;
+        IMatchLoopCommunicator *_threshold_communicator;
+        double          _published_threshold;
         const Doom      _doom;
     public:
         std::vector<uint32_t> dropped;
@@ -117,6 +133,8 @@ private:
     void secondPhase(MatchTools & tools, HitCollector & hits);
 
     void processResult(const Doom & doom, search::ResultSet::UP result, ResultProcessor::Context &context);
+    void report_profiles();
+    void aggregate_profiles();
 
     bool isFirstThread() const { return thread_id == 0; }
 
@@ -132,10 +150,12 @@ public:
                 ResultProcessor &rp,
                 vespalib::DualMergeDirector &md,
                 uint32_t distributionKey,
-                const Trace &parent_trace);
+                const Trace &parent_trace,
+                AggregatedProfiles *sampled_profiles = nullptr);
     void run() override;
     const MatchingStats::Partition &get_thread_stats() const { return thread_stats; }
     double get_match_time() const { return match_time_s; }
+    vespalib::steady_time get_start_time() const { return start_time; }
     std::unique_ptr<PartialResult> extract_result();
     const Trace & getTrace() const { return *trace; }
     const UniqueIssues &get_issues() const { return my_issues; }
@@ -14,7 +14,11 @@
 #include <vespa/searchlib/queryeval/flow.h>
 #include <vespa/searchlib/queryeval/wand/wand_parts.h>
 #include <vespa/vespalib/util/issue.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/stash_chunk_pool.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/thread_bundle.h>
+#include <vespa/vespalib/util/time.h>
 
 using search::attribute::BasicType;
 using search::attribute::diversity::DiversityFilter;
@@ -22,6 +26,7 @@ using search::queryeval::CreateBlueprintParams;
 using search::queryeval::ExecuteInfo;
 using search::queryeval::IDiversifier;
 using vespalib::Issue;
+using vespalib::StashChunkPool;
 
 using namespace search::fef::indexproperties::matchphase;
 using namespace search::fef::indexproperties::matching;
@@ -57,13 +62,14 @@ bool contains_all(const HandleRecorder::HandleMap &old_map,
 DegradationParams
 extractDegradationParams(const RankSetup &rankSetup, const std::string & attribute, const Properties &rankProperties)
 {
-    return { attribute,
-             DegradationMaxHits::lookup(rankProperties, rankSetup.getDegradationMaxHits()),
-             !DegradationAscendingOrder::lookup(rankProperties, rankSetup.isDegradationOrderAscending()),
-             DegradationMaxFilterCoverage::lookup(rankProperties, rankSetup.getDegradationMaxFilterCoverage()),
-             DegradationSamplePercentage::lookup(rankProperties, rankSetup.getDegradationSamplePercentage()),
-             DegradationPostFilterMultiplier::lookup(rankProperties, rankSetup.getDegradationPostFilterMultiplier())};
-
+    DegradationParams params(attribute,
+                             DegradationMaxHits::lookup(rankProperties, rankSetup.getDegradationMaxHits()),
+                             !DegradationAscendingOrder::lookup(rankProperties, rankSetup.isDegradationOrderAscending()),
+                             DegradationMaxFilterCoverage::lookup(rankProperties, rankSetup.getDegradationMaxFilterCoverage()),
+                             DegradationSamplePercentage::lookup(rankProperties, rankSetup.getDegradationSamplePercentage()),
+                             DegradationPostFilterMultiplier::lookup(rankProperties, rankSetup.getDegradationPostFilterMultiplier()));
+    params.adaptive = DegradationAdaptive::lookup(rankProperties, rankSetup.isDegradationAdaptive());
+    return params;
 }
 
 DiversityParams
@@ -78,7 +84,8 @@ extractDiversityParams(const RankSetup &rankSetup, const Properties &rankPropert
 } // namespace proton::matching::<unnamed>
 
 void
-MatchTools::setup(std::unique_ptr<RankProgram> rank_program, ExecutionProfiler *profiler, double termwise_limit)
+MatchTools::setup(std::unique_ptr<RankProgram> rank_program, ExecutionProfiler *profiler, double termwise_limit,
+                  bool termwise_cost_model)
 {
     if (_search) {
         _match_data->soft_reset();
@@ -95,6 +102,7 @@ MatchTools::setup(std::unique_ptr<RankProgram> rank_program, ExecutionProfiler *
     if (!can_reuse_search) {
         recorder.tag_match_data(*_match_data);
         _match_data->set_termwise_limit(termwise_limit);
+        _match_data->set_use_termwise_cost_model(termwise_cost_model);
         _search = _query.createSearch(*_match_data);
         _used_handles = std::move(recorder).steal_handles();
         _search_has_changed = false;
@@ -108,7 +116,8 @@ MatchTools::MatchTools(QueryLimiter & queryLimiter,
                        const QueryEnvironment & queryEnv,
                        const MatchDataLayout & mdl,
                        const RankSetup & rankSetup,
-                       const Properties & featureOverrides)
+                       const Properties & featureOverrides,
+                       StashChunkPool * chunk_pool)
     : _queryLimiter(queryLimiter),
       _doom(doom),
       _query(query),
@@ -116,6 +125,7 @@ MatchTools::MatchTools(QueryLimiter & queryLimiter,
       _queryEnv(queryEnv),
       _rankSetup(rankSetup),
       _featureOverrides(featureOverrides),
+      _chunk_pool(chunk_pool),
       _match_data(mdl.createMatchData()),
       _rank_program(),
       _search(),
@@ -134,32 +144,34 @@ MatchTools::has_second_phase_rank() const {
 void
 MatchTools::setup_first_phase(ExecutionProfiler *profiler)
 {
-    setup(_rankSetup.create_first_phase_program(), profiler,
-          TermwiseLimit::lookup(_queryEnv.getProperties(), _rankSetup.get_termwise_limit()));
+    setup(_rankSetup.create_first_phase_program(_chunk_pool), profiler,
+          TermwiseLimit::lookup(_queryEnv.getProperties(), _rankSetup.get_termwise_limit()),
+          TermwiseCostModel::check(_queryEnv.getProperties(),
+                                   TermwiseCostModel::check(_queryEnv.getIndexEnvironment().getProperties())));
 }
 
 void
 MatchTools::setup_second_phase(ExecutionProfiler *profiler)
 {
-    setup(_rankSetup.create_second_phase_program(), profiler);
+    setup(_rankSetup.create_second_phase_program(_chunk_pool), profiler);
 }
 
 void
 MatchTools::setup_match_features()
 {
-    setup(_rankSetup.create_match_program(), nullptr);
+    setup(_rankSetup.create_match_program(_chunk_pool), nullptr);
 }
 
 void
 MatchTools::setup_summary()
 {
-    setup(_rankSetup.create_summary_program(), nullptr);
+    setup(_rankSetup.create_summary_program(_chunk_pool), nullptr);
 }
 
 void
 MatchTools::setup_dump()
 {
-    setup(_rankSetup.create_dump_program(), nullptr);
+    setup(_rankSetup.create_dump_program(_chunk_pool), nullptr);
 }
 
 //-----------------------------------------------------------------------------
@@ -180,6 +192,7 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                   const Properties           & featureOverrides,
                   vespalib::ThreadBundle     & thread_bundle,
                   const search::IDocumentMetaStoreContext::IReadGuard::SP * metaStoreReadGuard,
+                  double                       match_cost_per_hit_s,
                   uint32_t                     maxNumHits,
                   bool                         is_search)
     : _queryLimiter(queryLimiter),
@@ -195,11 +208,15 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
       _diversityParams(),
       _valid(false),
       _first_phase_rank_lookup(nullptr),
-      _metaStore(metaStore)
+      _metaStore(metaStore),
+      _chunk_pool(query_chunk_pool())
 {
     if (doom.soft_doom()) return;
     auto trace = root_trace.make_trace();
     trace.addEvent(4, "Start query setup");
+    if (is_search && RankScoreThresholdPushdown::check(rankProperties, RankScoreThresholdPushdown::check(indexEnv.getProperties()))) {
+        _requestContext.enable_rank_score_threshold();
+    }
     _query.setWhiteListBlueprint(metaStore.createWhiteListBlueprint());
     trace.addEvent(5, "Deserialize and build query tree");
     _valid = _query.buildTree(queryStack, location, viewResolver, indexEnv);
@@ -217,7 +234,16 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
             _query.enumerate_blueprint_nodes();
         }
         trace.addEvent(4, "Perform dictionary lookups and posting lists initialization");
-        _query.fetchPostings(ExecuteInfo::create(in_flow.rate(), _requestContext.getDoom(), thread_bundle));
+        auto exec_info = ExecuteInfo::create(in_flow.rate(), _requestContext.getDoom(), thread_bundle);
+        if (FetchPostingsInParallel::check(rankProperties, FetchPostingsInParallel::check(indexEnv.getProperties()))) {
+            vespalib::Timer fetch_timer;
+            auto stats = _query.fetchPostingsInParallel(exec_info);
+            trace.addEvent(4, vespalib::make_string("Fetched postings for %zu terms using %zu threads in %1.3f ms",
+                                                    stats.leafs, stats.threads,
+                                                    vespalib::count_ns(fetch_timer.elapsed()) / 1e6));
+        } else {
+            _query.fetchPostings(exec_info);
+        }
         if (is_search) {
             _query.handle_global_filter(_requestContext, searchContext.getDocIdLimit(),
                                         _create_blueprint_params.global_filter_lower_limit,
@@ -230,6 +256,7 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
         _diversityParams = extractDiversityParams(_rankSetup, rankProperties);
         std::string attribute = DegradationAttribute::lookup(rankProperties, _rankSetup.getDegradationAttribute());
         DegradationParams degradationParams = extractDegradationParams(_rankSetup, attribute, rankProperties);
+        degradationParams.cost_per_hit_s = match_cost_per_hit_s;
 
         if (degradationParams.enabled()) {
             trace.addEvent(5, "Setup match phase limiter");
@@ -255,7 +282,16 @@ MatchToolsFactory::createMatchTools() const
 {
     assert(_valid);
     return std::make_unique<MatchTools>(_queryLimiter, _requestContext.getDoom(), _query,
-                                        *_match_limiter, _queryEnv, _mdl, _rankSetup, _featureOverrides);
+                                        *_match_limiter, _queryEnv, _mdl, _rankSetup, _featureOverrides,
+                                        &_chunk_pool);
+}
+
+StashChunkPool &
+MatchToolsFactory::query_chunk_pool()
+{
+    // never destructed, since rank programs may outlive static destruction
+    static StashChunkPool *pool = new StashChunkPool(32_Ki, 1_Ki);
+    return *pool;
 }
 
 std::unique_ptr<IDiversifier>
@@ -18,7 +18,7 @@
 #include <vespa/searchlib/queryeval/idiversifier.h>
 #include <vespa/vespalib/util/doom.h>
 
-namespace vespalib { class ExecutionProfiler; }
+namespace vespalib { class ExecutionProfiler; class StashChunkPool; }
 namespace vespalib { struct ThreadBundle; }
 
 namespace search::engine { class Trace; }
@@ -42,6 +42,7 @@ private:
     using RankProgram = search::fef::RankProgram;
     using RankSetup = search::fef::RankSetup;
     using ExecutionProfiler = vespalib::ExecutionProfiler;
+    using StashChunkPool = vespalib::StashChunkPool;
     QueryLimiter                    &_queryLimiter;
     const vespalib::Doom             _doom;
     const Query                     &_query;
@@ -49,12 +50,14 @@ private:
     const QueryEnvironment          &_queryEnv;
     const RankSetup                 &_rankSetup;
     const Properties                &_featureOverrides;
+    StashChunkPool                  *_chunk_pool;
     std::unique_ptr<MatchData>       _match_data;
     std::unique_ptr<RankProgram>     _rank_program;
     std::unique_ptr<SearchIterator>  _search;
     HandleRecorder::HandleMap        _used_handles;
     bool                             _search_has_changed;
-    void setup(std::unique_ptr<RankProgram>, ExecutionProfiler *profiler, double termwise_limit = 1.0);
+    void setup(std::unique_ptr<RankProgram>, ExecutionProfiler *profiler, double termwise_limit = 1.0,
+               bool termwise_cost_model = false);
 public:
     using UP = std::unique_ptr<MatchTools>;
     MatchTools(const MatchTools &) = delete;
@@ -66,7 +69,8 @@ public:
                const QueryEnvironment &queryEnv,
                const MatchDataLayout &mdl,
                const RankSetup &rankSetup,
-               const Properties &featureOverrides);
+               const Properties &featureOverrides,
+               StashChunkPool *chunk_pool = nullptr);
     ~MatchTools();
     const vespalib::Doom &getDoom() const { return _doom; }
     QueryLimiter & getQueryLimiter() { return _queryLimiter; }
@@ -122,6 +126,7 @@ private:
     using IIndexEnvironment = search::fef::IIndexEnvironment;
     using IDiversifier = search::queryeval::IDiversifier;
     using FirstPhaseRankLookup = search::features::FirstPhaseRankLookup;
+    using StashChunkPool = vespalib::StashChunkPool;
     QueryLimiter                     & _queryLimiter;
     CreateBlueprintParams              _create_blueprint_params;
     Query                              _query;
@@ -136,6 +141,7 @@ private:
     bool                               _valid;
     FirstPhaseRankLookup*              _first_phase_rank_lookup;
     const search::IDocumentMetaStore & _metaStore;
+    StashChunkPool                   & _chunk_pool;
 
     std::unique_ptr<AttributeOperationTask>
     createTask(std::string_view attribute, std::string_view operation) const;
@@ -159,6 +165,7 @@ public:
                       const Properties &featureOverrides,
                       vespalib::ThreadBundle &thread_bundle,
                       const search::IDocumentMetaStoreContext::IReadGuard::SP * metaStoreReadGuard,
+                      double match_cost_per_hit_s,
                       uint32_t maxNumHits,
                       bool is_search);
     ~MatchToolsFactory();
@@ -193,6 +200,13 @@ public:
                                     uint32_t active_docids, uint32_t docid_limit);
     FirstPhaseRankLookup* get_first_phase_rank_lookup() const noexcept { return _first_phase_rank_lookup; }
     const search::IDocumentMetaStore & metaStore() const noexcept { return _metaStore; }
+    /**
+     * Memory used by the rank programs of this query is taken from
+     * (and given back to) this process wide pool, to avoid
+     * allocating it from scratch for each query.
+     **/
+    static StashChunkPool &query_chunk_pool();
+    StashChunkPool &chunk_pool() const noexcept { return _chunk_pool; }
     FieldIdToNameMapper getFieldIdToNameMapper() const {
         return FieldIdToNameMapper(_queryEnv.getIndexEnvironment());
     }
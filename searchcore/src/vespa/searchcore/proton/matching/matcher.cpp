@@ -104,6 +104,28 @@ handleGroupingSession(SessionManager &sessionMgr, GroupingContext & groupingCont
     return reply;
 }
 
+// Computes summary features for the returned hits while the session still holds the match phase state
+void
+precompute_summary_features(std::shared_ptr<SearchSession> session, const SearchReply &reply,
+                            const search::IDocumentMetaStore &metaStore)
+{
+    std::vector<uint32_t> docs;
+    docs.reserve(reply.hits.size());
+    for (const auto &hit : reply.hits) {
+        uint32_t lid = 0;
+        if (metaStore.getLid(hit.gid, lid)) {
+            docs.push_back(lid);
+        }
+    }
+    std::sort(docs.begin(), docs.end());
+    docs.erase(std::unique(docs.begin(), docs.end()), docs.end());
+    if (docs.empty()) {
+        return;
+    }
+    std::shared_ptr<const FeatureSet> features = DocsumMatcher(session, std::move(docs)).get_summary_features();
+    session->set_summary_features(std::move(features));
+}
+
 }  // namespace proton::matching::<unnamed>
 
 Matcher::Matcher(const search::index::Schema &schema, Properties props, const std::atomic<steady_time> & now_ref,
@@ -114,6 +136,8 @@ Matcher::Matcher(const search::index::Schema &schema, Properties props, const st
     _viewResolver(ViewResolver::createFromSchema(schema)),
     _statsLock(),
     _stats(softtimeout::Factor::lookup(_indexEnv.getProperties())),
+    _profiles(ProfileSampleInterval::lookup(_indexEnv.getProperties()),
+              ProfileSampleDepth::lookup(_indexEnv.getProperties())),
     _startTime(my_clock::now()),
     _now_ref(now_ref),
     _queryLimiter(queryLimiter),
@@ -137,6 +161,7 @@ Matcher::getStats()
     std::lock_guard<std::mutex> guard(_statsLock);
     MatchingStats stats = std::move(_stats);
     _stats = MatchingStats(stats.softDoomFactor());
+    _stats.matchCostPerHit(stats.matchCostPerHit());
     return stats;
 }
 
@@ -166,7 +191,7 @@ Matcher::create_match_tools_factory(const search::engine::Request &request, ISea
                                                request.trace(), request.getStackRef(), request.location,
                                                _viewResolver, metaStore, _indexEnv, *_rankSetup,
                                                rankProperties, feature_overrides, thread_bundle,
-                                               metaStoreReadGuard, maxHits, is_search);
+                                               metaStoreReadGuard, _stats.matchCostPerHit(), maxHits, is_search);
 }
 
 size_t
@@ -247,6 +272,7 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
     initCoverage(reply->coverage, metaStore, bucketdb);
 
     bool isDoomExplicit = false;
+    vespalib::duration queue_time = vespalib::duration::zero();
     { // we want to measure full set-up and tear-down time as part of
       // collateral time
         GroupingContext groupingContext(metaStore.getValidLids(), _now_ref, request.getTimeOfDoom());
@@ -271,6 +297,17 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
                 }
             }
         }
+        auto priority = QueryLimiter::to_priority(QueryPriority::lookup(request.propertiesMap.rankProperties(),
+                                                                        QueryPriority::lookup(_indexEnv.getProperties())));
+        auto admission = _queryLimiter.admit(vespalib::Doom(_now_ref, request.getTimeOfDoom()), priority);
+        if (!admission->admitted()) {
+            reply->coverage.degradeTimeout();
+            vespalib::Issue::report("Search request shed by admission control during overload.");
+            my_stats.shed_queries(1);
+            updateStats(my_stats, request, reply->coverage, false);
+            return reply;
+        }
+        queue_time = admission->queue_time();
         const Properties *feature_overrides = &request.propertiesMap.featureOverrides();
         if (shouldCacheSearchSession) {
             // These should have been moved instead.
@@ -312,11 +349,21 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
         vespalib::LimitedThreadBundleWrapper limitedThreadBundle(threadBundle, numThreadsPerSearch);
         MatchMaster master;
         uint32_t numParts = NumSearchPartitions::lookup(rankProperties, _rankSetup->getNumSearchPartitions());
+        bool workStealing = WorkStealing::check(rankProperties, WorkStealing::check(_indexEnv.getProperties()));
         if (limitedThreadBundle.size() > 1) {
             attrContext.enableMultiThreadSafe();
         }
+        // pruning on the first-phase score is only safe when the returned hits are the top ranked ones
+        bool use_score_threshold = (request.sortSpec.empty() && groupingContext.empty() && !mtf->should_diversify() &&
+                                    (params.offset + params.hits <= params.arraySize));
+        auto *score_threshold = use_score_threshold ? mtf->get_request_context().rank_score_threshold() : nullptr;
+        // early partial replies carry first-phase hits, which are only worth sending ahead of second phase ranking
+        SearchClient *partial_reply_client = (request.sortSpec.empty() && !_rankSetup->getSecondPhaseRank().empty())
+                                             ? request.partialReplyClient : nullptr;
+        AggregatedProfiles *sampled_profiles = _profiles.sample() ? &_profiles : nullptr;
         ResultProcessor::Result::UP result = master.match(request.trace(), params, limitedThreadBundle, *mtf, rp,
-                                                          _distributionKey, numParts);
+                                                          _distributionKey, numParts, workStealing, score_threshold,
+                                                          partial_reply_client, sampled_profiles);
         my_stats = MatchMaster::getStats(std::move(master));
         reply = std::move(result->_reply);
         updateCoverage(reply->coverage, mtf->match_limiter(), my_stats, metaStore, bucketdb);
@@ -326,24 +373,48 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
             request.ranking.c_str());
 
         if (shouldCacheSearchSession && ((result->_numFs4Hits != 0) || shouldCacheGroupingSession)) {
+            // on-summary attribute mutations must run when summaries are actually fetched
+            bool precompute = canProduceSummaryFeatures() && !mtf->createOnSummaryTask() &&
+                              summary::PrecomputeFeatures::check(rankProperties,
+                                                                 summary::PrecomputeFeatures::check(_indexEnv.getProperties()));
             auto session = std::make_shared<SearchSession>(sessionId, request.getStartTime(), request.getTimeOfDoom(),
                                                            std::move(mtf), std::move(owned_objects));
+            if (precompute) {
+                precompute_summary_features(session, *reply, metaStore);
+            }
             session->releaseEnumGuards();
             sessionMgr.insert(std::move(session));
         }
     }
     double querySetupTime = vespalib::to_s(total_matching_time.elapsed()) - my_stats.queryLatencyAvg();
     my_stats.querySetupTime(querySetupTime);
+    if (queue_time > vespalib::duration::zero()) {
+        my_stats.queued_queries(1).queueTime(vespalib::to_s(queue_time));
+    }
     updateStats(my_stats, request, reply->coverage, isDoomExplicit);
     return reply;
 }
 
+void
+Matcher::count_result_cache_lookup(bool hit)
+{
+    std::lock_guard<std::mutex> guard(_statsLock);
+    if (hit) {
+        _stats.result_cache_hits(_stats.result_cache_hits() + 1);
+    } else {
+        _stats.result_cache_misses(_stats.result_cache_misses() + 1);
+    }
+}
+
 void
 Matcher::updateStats(const MatchingStats & my_stats, const search::engine::Request & request,
                      const Coverage & coverage, bool isDoomExplicit) {
     vespalib::duration duration = request.getTimeUsed();
     std::lock_guard<std::mutex> guard(_statsLock);
     _stats.add(my_stats);
+    if (my_stats.matchTimeCount() > 0) {
+        _stats.updateMatchCostPerHit(my_stats.matchTimeAvg(), my_stats.docsMatched());
+    }
     if (my_stats.softDoomed()) {
         double old = _stats.softDoomFactor();
         vespalib::duration overtimeLimit = std::chrono::duration_cast<vespalib::duration>((1.0 - _rankSetup->getSoftTimeoutTailCost()) * request.getTimeout());
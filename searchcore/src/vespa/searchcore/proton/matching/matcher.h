@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "aggregated_profiles.h"
 #include "docsum_matcher.h"
 #include "indexenvironment.h"
 #include "matching_stats.h"
@@ -65,6 +66,7 @@ private:
     ViewResolver                    _viewResolver;
     std::mutex                      _statsLock;
     MatchingStats                   _stats;
+    AggregatedProfiles              _profiles;
     my_clock::time_point            _startTime;
     const std::atomic<steady_time> &_now_ref;
     QueryLimiter                   &_queryLimiter;
@@ -103,6 +105,18 @@ public:
      **/
     MatchingStats getStats();
 
+    /**
+     * Match and ranking profiles aggregated across the queries
+     * sampled for profiling by this matcher.
+     **/
+    AggregatedProfiles &get_aggregated_profiles() noexcept { return _profiles; }
+
+    /**
+     * Account for a lookup in the query result cache that was done
+     * on behalf of this matcher.
+     **/
+    void count_result_cache_lookup(bool hit);
+
     /**
      * Create the low-level tools needed to perform matching. This
      * function is exposed for testing purposes.
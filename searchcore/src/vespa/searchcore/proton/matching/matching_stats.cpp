@@ -16,24 +16,36 @@ MatchingStats::Partition &get_writable_partition(std::vector<MatchingStats::Part
 
 constexpr vespalib::duration MIN_TIMEOUT = 1ms;
 constexpr double MAX_CHANGE_FACTOR = 5;
+constexpr double MATCH_COST_PER_HIT_WEIGHT = 0.05;
 
 } // namespace proton::matching::<unnamed>
 
 MatchingStats::MatchingStats(double prev_soft_doom_factor) noexcept
     : _queries(0),
       _limited_queries(0),
+      _adaptive_limited_queries(0),
+      _queued_queries(0),
+      _shed_queries(0),
       _docidSpaceCovered(0),
       _docsMatched(0),
       _docsRanked(0),
       _docsReRanked(0),
       _softDoomed(0),
+      _steals(0),
+      _failed_steals(0),
+      _result_cache_hits(0),
+      _result_cache_misses(0),
       _doomOvertime(),
       _softDoomFactor(prev_soft_doom_factor),
+      _matchCostPerHit(0.0),
+      _adaptiveMaxHits(),
+      _queueTime(),
       _querySetupTime(),
       _queryLatency(),
       _matchTime(),
       _groupingTime(),
       _rerankTime(),
+      _wakeupTime(),
       _partitions()
 { }
 
@@ -48,6 +60,8 @@ MatchingStats::merge_partition(const Partition &partition, size_t id)
     _docsMatched += partition.docsMatched();
     _docsRanked += partition.docsRanked();
     _docsReRanked += partition.docsReRanked();
+    _steals += partition.steals();
+    _failed_steals += partition.failed_steals();
     _doomOvertime.add(partition._doomOvertime);
     if (partition.softDoomed()) {
         _softDoomed = 1;
@@ -61,12 +75,21 @@ MatchingStats::add(const MatchingStats &rhs) noexcept
 {
     _queries += rhs._queries;
     _limited_queries += rhs._limited_queries;
+    _adaptive_limited_queries += rhs._adaptive_limited_queries;
+    _adaptiveMaxHits.add(rhs._adaptiveMaxHits);
+    _queued_queries += rhs._queued_queries;
+    _shed_queries += rhs._shed_queries;
+    _queueTime.add(rhs._queueTime);
 
     _docidSpaceCovered += rhs._docidSpaceCovered;
     _docsMatched += rhs._docsMatched;
     _docsRanked += rhs._docsRanked;
     _docsReRanked += rhs._docsReRanked;
     _softDoomed += rhs.softDoomed();
+    _steals += rhs._steals;
+    _failed_steals += rhs._failed_steals;
+    _result_cache_hits += rhs._result_cache_hits;
+    _result_cache_misses += rhs._result_cache_misses;
     _doomOvertime.add(rhs._doomOvertime);
 
     _querySetupTime.add(rhs._querySetupTime);
@@ -74,6 +97,7 @@ MatchingStats::add(const MatchingStats &rhs) noexcept
     _matchTime.add(rhs._matchTime);
     _groupingTime.add(rhs._groupingTime);
     _rerankTime.add(rhs._rerankTime);
+    _wakeupTime.add(rhs._wakeupTime);
     for (size_t id = 0; id < rhs.getNumPartitions(); ++id) {
         get_writable_partition(_partitions, id).add(rhs.getPartition(id));
     }
@@ -103,4 +127,14 @@ MatchingStats::updatesoftDoomFactor(vespalib::duration hardLimit, vespalib::dura
     return *this;
 }
 
+MatchingStats &
+MatchingStats::updateMatchCostPerHit(double match_time_s, size_t docs_matched) {
+    if ((docs_matched > 0) && (match_time_s > 0.0)) {
+        double cost = match_time_s / docs_matched;
+        double prev = matchCostPerHit();
+        matchCostPerHit((prev > 0.0) ? (prev + MATCH_COST_PER_HIT_WEIGHT * (cost - prev)) : cost);
+    }
+    return *this;
+}
+
 }
@@ -63,6 +63,8 @@ public:
         size_t _docsRanked;
         size_t _docsReRanked;
         size_t _softDoomed;
+        size_t _steals;
+        size_t _failed_steals;
         Avg    _doomOvertime;
         Avg    _active_time;
         Avg    _wait_time;
@@ -74,6 +76,8 @@ public:
               _docsRanked(0),
               _docsReRanked(0),
               _softDoomed(0),
+              _steals(0),
+              _failed_steals(0),
               _doomOvertime(),
               _active_time(),
               _wait_time() { }
@@ -88,6 +92,10 @@ public:
         size_t docsReRanked() const noexcept { return _docsReRanked; }
         Partition &softDoomed(bool v) noexcept { _softDoomed += v ? 1 : 0; return *this; }
         size_t softDoomed() const noexcept { return _softDoomed; }
+        Partition &steals(size_t value) noexcept { _steals = value; return *this; }
+        size_t steals() const noexcept { return _steals; }
+        Partition &failed_steals(size_t value) noexcept { _failed_steals = value; return *this; }
+        size_t failed_steals() const noexcept { return _failed_steals; }
         Partition & doomOvertime(vespalib::duration overtime) noexcept { _doomOvertime.set(vespalib::to_s(overtime)); return *this; }
         vespalib::duration doomOvertime() const noexcept { return vespalib::from_s(_doomOvertime.max()); }
 
@@ -108,6 +116,8 @@ public:
             _docsRanked += rhs._docsRanked;
             _docsReRanked += rhs._docsReRanked;
             _softDoomed += rhs._softDoomed;
+            _steals += rhs._steals;
+            _failed_steals += rhs._failed_steals;
             _doomOvertime.add(rhs._doomOvertime);
 
             _active_time.add(rhs._active_time);
@@ -119,19 +129,30 @@ public:
 private:
     size_t                 _queries;
     size_t                 _limited_queries;
+    size_t                 _adaptive_limited_queries;
+    size_t                 _queued_queries;
+    size_t                 _shed_queries;
     size_t                 _docidSpaceCovered;
     size_t                 _docsMatched;
     size_t                 _docsRanked;
     size_t                 _docsReRanked;
     size_t                 _softDoomed;
+    size_t                 _steals;
+    size_t                 _failed_steals;
+    size_t                 _result_cache_hits;
+    size_t                 _result_cache_misses;
     Avg                    _doomOvertime;
     using SoftDoomFactor = vespalib::datastore::AtomicValueWrapper<double>;
     SoftDoomFactor         _softDoomFactor;
+    SoftDoomFactor         _matchCostPerHit;
+    Avg                    _adaptiveMaxHits;
+    Avg                    _queueTime;
     Avg                    _querySetupTime;
     Avg                    _queryLatency;
     Avg                    _matchTime;
     Avg                    _groupingTime;
     Avg                    _rerankTime;
+    Avg                    _wakeupTime;
     std::vector<Partition> _partitions;
 
 public:
@@ -150,6 +171,26 @@ public:
     MatchingStats &limited_queries(size_t value) { _limited_queries = value; return *this; }
     size_t limited_queries() const { return _limited_queries; }
 
+    // queries where match phase limiting used a max hits lowered to fit the time left
+    MatchingStats &adaptive_limited_queries(size_t value) { _adaptive_limited_queries = value; return *this; }
+    size_t adaptive_limited_queries() const { return _adaptive_limited_queries; }
+    MatchingStats &adaptiveMaxHits(double value) { _adaptiveMaxHits.set(value); return *this; }
+    double adaptiveMaxHitsAvg() const { return _adaptiveMaxHits.avg(); }
+    size_t adaptiveMaxHitsCount() const { return _adaptiveMaxHits.count(); }
+    double adaptiveMaxHitsMin() const { return _adaptiveMaxHits.min(); }
+    double adaptiveMaxHitsMax() const { return _adaptiveMaxHits.max(); }
+
+    // admission control in front of matching
+    MatchingStats &queued_queries(size_t value) { _queued_queries = value; return *this; }
+    size_t queued_queries() const { return _queued_queries; }
+    MatchingStats &shed_queries(size_t value) { _shed_queries = value; return *this; }
+    size_t shed_queries() const { return _shed_queries; }
+    MatchingStats &queueTime(double time_s) { _queueTime.set(time_s); return *this; }
+    double queueTimeAvg() const { return _queueTime.avg(); }
+    size_t queueTimeCount() const { return _queueTime.count(); }
+    double queueTimeMin() const { return _queueTime.min(); }
+    double queueTimeMax() const { return _queueTime.max(); }
+
     MatchingStats &docidSpaceCovered(size_t value) { _docidSpaceCovered = value; return *this; }
     size_t docidSpaceCovered() const { return _docidSpaceCovered; }
 
@@ -165,12 +206,29 @@ public:
     MatchingStats &softDoomed(size_t value) { _softDoomed = value; return *this; }
     size_t softDoomed() const { return _softDoomed; }
 
+    // work-stealing between match threads
+    MatchingStats &steals(size_t value) { _steals = value; return *this; }
+    size_t steals() const { return _steals; }
+    MatchingStats &failed_steals(size_t value) { _failed_steals = value; return *this; }
+    size_t failed_steals() const { return _failed_steals; }
+
+    // lookups in the document db query result cache
+    MatchingStats &result_cache_hits(size_t value) { _result_cache_hits = value; return *this; }
+    size_t result_cache_hits() const { return _result_cache_hits; }
+    MatchingStats &result_cache_misses(size_t value) { _result_cache_misses = value; return *this; }
+    size_t result_cache_misses() const { return _result_cache_misses; }
+
     vespalib::duration doomOvertime() const { return vespalib::from_s(_doomOvertime.max()); }
 
     MatchingStats &softDoomFactor(double value) { _softDoomFactor.store_relaxed(value); return *this; }
     double softDoomFactor() const { return _softDoomFactor.load_relaxed(); }
     MatchingStats &updatesoftDoomFactor(vespalib::duration hardLimit, vespalib::duration softLimit, vespalib::duration duration);
 
+    // smoothed match time per matched document, kept across getStats() like the soft doom factor
+    MatchingStats &matchCostPerHit(double value) { _matchCostPerHit.store_relaxed(value); return *this; }
+    double matchCostPerHit() const { return _matchCostPerHit.load_relaxed(); }
+    MatchingStats &updateMatchCostPerHit(double match_time_s, size_t docs_matched);
+
     MatchingStats &querySetupTime(double time_s) { _querySetupTime.set(time_s); return *this; }
     double querySetupTimeAvg() const { return _querySetupTime.avg(); }
     size_t querySetupTimeCount() const { return _querySetupTime.count(); }
@@ -201,6 +259,13 @@ public:
     double rerankTimeMin() const { return _rerankTime.min(); }
     double rerankTimeMax() const { return _rerankTime.max(); }
 
+    // time from handing out work until the last match thread started on it
+    MatchingStats &wakeupTime(double time_s) { _wakeupTime.set(time_s); return *this; }
+    double wakeupTimeAvg() const { return _wakeupTime.avg(); }
+    size_t wakeupTimeCount() const { return _wakeupTime.count(); }
+    double wakeupTimeMin() const { return _wakeupTime.min(); }
+    double wakeupTimeMax() const { return _wakeupTime.max(); }
+
     // used to merge in stats from each match thread
     MatchingStats &merge_partition(const Partition &partition, size_t id);
     size_t getNumPartitions() const { return _partitions.size(); }
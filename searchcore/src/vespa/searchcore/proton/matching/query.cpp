@@ -42,6 +42,7 @@ using search::queryeval::GlobalFilter;
 using search::queryeval::IRequestContext;
 using search::queryeval::IntermediateBlueprint;
 using search::queryeval::MatchingPhase;
+using search::queryeval::ParallelFetchPostings;
 using search::queryeval::RankBlueprint;
 using search::queryeval::SearchIterator;
 using vespalib::Issue;
@@ -243,6 +244,12 @@ Query::fetchPostings(const ExecuteInfo & executeInfo)
     _blueprint->fetchPostings(executeInfo);
 }
 
+ParallelFetchPostings::Stats
+Query::fetchPostingsInParallel(const ExecuteInfo & executeInfo)
+{
+    return ParallelFetchPostings::fetch_all(*_blueprint, executeInfo);
+}
+
 void
 Query::handle_global_filter(const IRequestContext & requestContext, uint32_t docid_limit,
                             double global_filter_lower_limit, double global_filter_upper_limit,
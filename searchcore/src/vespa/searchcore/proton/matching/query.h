@@ -9,6 +9,7 @@
 #include <vespa/searchlib/query/tree/node.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/searchlib/queryeval/irequestcontext.h>
+#include <vespa/searchlib/queryeval/parallel_fetch_postings.h>
 
 namespace vespalib { struct ThreadBundle; }
 namespace search::engine { class Trace; }
@@ -102,6 +103,12 @@ public:
      **/
     void optimize(InFlow in_flow, bool sort_by_cost);
     void fetchPostings(const ExecuteInfo & executeInfo);
+    /**
+     * Like fetchPostings, but the simple leafs of the blueprint tree
+     * fetch their postings in parallel using the thread bundle of
+     * the execute info.
+     **/
+    search::queryeval::ParallelFetchPostings::Stats fetchPostingsInParallel(const ExecuteInfo & executeInfo);
 
     void handle_global_filter(const IRequestContext & requestContext, uint32_t docid_limit,
                               double global_filter_lower_limit, double global_filter_upper_limit,
@@ -0,0 +1,211 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "query_result_cache.h"
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/searchlib/fef/properties.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+
+namespace proton::matching {
+
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using search::fef::IPropertiesVisitor;
+using search::fef::Properties;
+using search::fef::Property;
+
+namespace {
+
+void append(std::string &dst, std::string_view value) {
+    uint32_t len = value.size();
+    dst.append(reinterpret_cast<const char *>(&len), sizeof(len));
+    dst.append(value);
+}
+
+void append(std::string &dst, uint32_t value) {
+    dst.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+struct SortedPropertyCollector : IPropertiesVisitor {
+    std::vector<std::pair<std::string, std::vector<std::string>>> entries;
+    void visitProperty(const Property::Value &key, const Property &values) override {
+        std::vector<std::string> list;
+        list.reserve(values.size());
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            list.emplace_back(values.getAt(i));
+        }
+        entries.emplace_back(key, std::move(list));
+    }
+};
+
+// Property iteration order is not defined, so sort keys to make the cache key canonical.
+void append(std::string &dst, const Properties &props) {
+    SortedPropertyCollector collector;
+    props.visitProperties(collector);
+    std::sort(collector.entries.begin(), collector.entries.end());
+    append(dst, uint32_t(collector.entries.size()));
+    for (const auto &entry : collector.entries) {
+        append(dst, entry.first);
+        append(dst, uint32_t(entry.second.size()));
+        for (const auto &value : entry.second) {
+            append(dst, value);
+        }
+    }
+}
+
+size_t estimate_memory_used(const std::string &key, const SearchReply &reply) {
+    size_t bytes = key.size() + sizeof(std::string) + 64; // list node and map entry overhead
+    bytes += reply.hits.size() * sizeof(SearchReply::Hit);
+    bytes += reply.sortIndex.size() * sizeof(uint32_t);
+    bytes += reply.sortData.size();
+    bytes += reply.match_features.values.size() * sizeof(SearchReply::FeatureValues::Value);
+    for (const auto &name : reply.match_features.names) {
+        bytes += name.size() + sizeof(std::string);
+    }
+    for (const auto &value : reply.match_features.values) {
+        if (value.is_data()) {
+            bytes += value.as_data().size;
+        }
+    }
+    return bytes;
+}
+
+}
+
+QueryResultCache::Entry::Entry(const std::string &key_in, const SearchReply &reply)
+    : key(key_in),
+      memory_used(estimate_memory_used(key_in, reply) + sizeof(Entry)),
+      total_hit_count(reply.totalHitCount),
+      coverage(reply.coverage),
+      hits(reply.hits),
+      sort_index(reply.sortIndex),
+      sort_data(reply.sortData),
+      match_features(reply.match_features)
+{ }
+
+QueryResultCache::Entry::~Entry() = default;
+
+QueryResultCache::QueryResultCache(size_t max_bytes)
+    : _lock(),
+      _max_bytes(max_bytes),
+      _generation(0),
+      _lru(),
+      _map(),
+      _stats()
+{ }
+
+QueryResultCache::~QueryResultCache() = default;
+
+bool
+QueryResultCache::is_cacheable(const SearchRequest &request)
+{
+    return request.groupSpec.empty() &&
+           request.sessionId.empty() &&
+           !request.dumpFeatures &&
+           (request.trace().getLevel() == 0);
+}
+
+std::string
+QueryResultCache::make_key(const SearchRequest &request)
+{
+    std::string key;
+    key.reserve(request.stackDump.size() + request.ranking.size() + request.sortSpec.size() + 256);
+    append(key, request.ranking);
+    append(key, request.getStackRef());
+    append(key, request.location);
+    append(key, request.sortSpec);
+    append(key, request.offset);
+    append(key, request.maxhits);
+    append(key, request.propertiesMap.rankProperties());
+    append(key, request.propertiesMap.featureOverrides());
+    append(key, request.propertiesMap.matchProperties());
+    append(key, request.propertiesMap.modelOverrides());
+    return key;
+}
+
+void
+QueryResultCache::drop_all()
+{
+    _map.clear();
+    _lru.clear();
+    _stats.entries = 0;
+    _stats.memory_used = 0;
+}
+
+void
+QueryResultCache::invalidate_if_older(uint64_t generation)
+{
+    if (generation > _generation) {
+        if (!_lru.empty()) {
+            ++_stats.invalidations;
+            drop_all();
+        }
+        _generation = generation;
+    }
+}
+
+std::unique_ptr<SearchReply>
+QueryResultCache::lookup(const std::string &key, uint64_t generation)
+{
+    std::lock_guard guard(_lock);
+    invalidate_if_older(generation);
+    auto found = _map.find(key);
+    if ((found == _map.end()) || (generation != _generation)) {
+        ++_stats.misses;
+        return {};
+    }
+    ++_stats.hits;
+    _lru.splice(_lru.begin(), _lru, found->second);
+    const Entry &entry = *found->second;
+    auto reply = std::make_unique<SearchReply>();
+    reply->totalHitCount = entry.total_hit_count;
+    reply->coverage = entry.coverage;
+    reply->hits = entry.hits;
+    reply->sortIndex = entry.sort_index;
+    reply->sortData = entry.sort_data;
+    reply->match_features = entry.match_features;
+    return reply;
+}
+
+void
+QueryResultCache::insert(const std::string &key, uint64_t generation, const SearchReply &reply)
+{
+    std::lock_guard guard(_lock);
+    invalidate_if_older(generation);
+    if (generation != _generation) {
+        return; // produced against data that is no longer visible
+    }
+    auto found = _map.find(key);
+    if (found != _map.end()) {
+        _stats.memory_used -= found->second->memory_used;
+        _lru.erase(found->second);
+        _map.erase(found);
+    }
+    _lru.emplace_front(key, reply);
+    Entry &entry = _lru.front();
+    if (entry.memory_used > _max_bytes) {
+        _lru.pop_front();
+        _stats.entries = _lru.size();
+        return;
+    }
+    _map[key] = _lru.begin();
+    _stats.memory_used += entry.memory_used;
+    ++_stats.inserts;
+    while (_stats.memory_used > _max_bytes) {
+        const Entry &victim = _lru.back();
+        _stats.memory_used -= victim.memory_used;
+        _map.erase(victim.key);
+        _lru.pop_back();
+        ++_stats.evictions;
+    }
+    _stats.entries = _lru.size();
+}
+
+QueryResultCache::Stats
+QueryResultCache::get_stats() const
+{
+    std::lock_guard guard(_lock);
+    return _stats;
+}
+
+}
@@ -0,0 +1,96 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace search::engine { class SearchRequest; }
+
+namespace proton::matching {
+
+/**
+ * Cache of search replies (top-k hits and coverage) for repeated
+ * queries against a document db. The key is built from everything in
+ * the request that affects the produced hits. Each lookup and insert
+ * is tagged with the commit generation of the searchable sub db; as
+ * soon as a newer generation is observed all cached entries are
+ * dropped. Entries are evicted in LRU order to stay within the memory
+ * budget.
+ **/
+class QueryResultCache
+{
+public:
+    struct Stats {
+        size_t hits;
+        size_t misses;
+        size_t inserts;
+        size_t evictions;
+        size_t invalidations;
+        size_t entries;
+        size_t memory_used;
+        Stats() noexcept
+            : hits(0), misses(0), inserts(0), evictions(0), invalidations(0), entries(0), memory_used(0)
+        {}
+    };
+
+private:
+    using SearchReply = search::engine::SearchReply;
+    struct Entry {
+        std::string           key;
+        size_t                memory_used;
+        uint64_t              total_hit_count;
+        search::engine::Coverage coverage;
+        std::vector<SearchReply::Hit> hits;
+        std::vector<uint32_t> sort_index;
+        std::vector<char>     sort_data;
+        SearchReply::FeatureValues match_features;
+        Entry(const std::string &key_in, const SearchReply &reply);
+        ~Entry();
+    };
+    using LruList = std::list<Entry>;
+    using Map = vespalib::hash_map<std::string, LruList::iterator>;
+
+    mutable std::mutex _lock;
+    const size_t       _max_bytes;
+    uint64_t           _generation;
+    LruList            _lru;
+    Map                _map;
+    Stats              _stats;
+
+    void invalidate_if_older(uint64_t generation);
+    void drop_all();
+public:
+    explicit QueryResultCache(size_t max_bytes);
+    QueryResultCache(const QueryResultCache &) = delete;
+    QueryResultCache & operator=(const QueryResultCache &) = delete;
+    ~QueryResultCache();
+
+    /**
+     * Requests using grouping, search sessions, tracing or feature
+     * dumping are never cached since their replies carry more than
+     * the plain hit list.
+     **/
+    static bool is_cacheable(const search::engine::SearchRequest &request);
+    static std::string make_key(const search::engine::SearchRequest &request);
+
+    /**
+     * Returns a copy of the cached reply for the given key, or an
+     * empty pointer if it is not cached for the given generation.
+     **/
+    std::unique_ptr<SearchReply> lookup(const std::string &key, uint64_t generation);
+
+    /**
+     * Store a reply produced against the given generation. Replies
+     * for older generations than currently cached are ignored.
+     **/
+    void insert(const std::string &key, uint64_t generation, const SearchReply &reply);
+
+    size_t max_bytes() const noexcept { return _max_bytes; }
+    Stats get_stats() const;
+};
+
+}
@@ -4,6 +4,12 @@
 
 namespace proton:: matching {
 
+namespace {
+
+constexpr double SERVICE_TIME_WEIGHT = 0.1;
+
+}
+
 QueryLimiter::LimitedToken::LimitedToken(const Doom & doom, QueryLimiter & limiter) :
     _limiter(limiter)
 {
@@ -15,6 +21,32 @@ QueryLimiter::LimitedToken::~LimitedToken()
     _limiter.releaseToken();
 }
 
+QueryLimiter::Admission::Admission(QueryLimiter * limiter, bool admitted, vespalib::duration queue_time) noexcept
+    : _limiter(limiter),
+      _admitted(admitted),
+      _queue_time(queue_time),
+      _admit_time(vespalib::steady_clock::now())
+{
+}
+
+QueryLimiter::Admission::~Admission()
+{
+    if ((_limiter != nullptr) && _admitted) {
+        _limiter->release_admission(vespalib::steady_clock::now() - _admit_time);
+    }
+}
+
+QueryLimiter::Priority
+QueryLimiter::to_priority(std::string_view name) noexcept
+{
+    if (name == "high") {
+        return Priority::HIGH;
+    } else if (name == "low") {
+        return Priority::LOW;
+    }
+    return Priority::NORMAL;
+}
+
 void
 QueryLimiter::grabToken(const Doom & doom)
 {
@@ -42,7 +74,17 @@ QueryLimiter::QueryLimiter() :
     _activeThreads(0),
     _maxThreads(-1),
     _coverage(1.0),
-    _minHits(std::numeric_limits<uint32_t>::max())
+    _minHits(std::numeric_limits<uint32_t>::max()),
+    _admissionLock(),
+    _admissionCond(),
+    _maxQueries(0),
+    _targetDelay(5ms),
+    _interval(100ms),
+    _activeQueries(0),
+    _waiting(),
+    _serviceTime_s(0.0),
+    _firstAboveTarget(),
+    _shedding(false)
 {
 }
 
@@ -56,6 +98,16 @@ QueryLimiter::configure(int maxThreads, double coverage, uint32_t minHits)
     _cond.notify_all();
 }
 
+void
+QueryLimiter::configure_admission(uint32_t maxQueries, vespalib::duration targetDelay, vespalib::duration interval)
+{
+    std::lock_guard<std::mutex> guard(_admissionLock);
+    _maxQueries = maxQueries;
+    _targetDelay = targetDelay;
+    _interval = interval;
+    _admissionCond.notify_all();
+}
+
 QueryLimiter::Token::UP
 QueryLimiter::getToken(const Doom & doom, uint32_t numDocs, uint32_t numHits, bool hasSorting, bool hasGrouping)
 {
@@ -71,4 +123,105 @@ QueryLimiter::getToken(const Doom & doom, uint32_t numDocs, uint32_t numHits, bo
     return std::make_unique<NoLimitToken>();
 }
 
+size_t
+QueryLimiter::waiting_ahead(Priority priority) const noexcept
+{
+    size_t ahead = 0;
+    for (size_t i = 0; i <= size_t(priority); ++i) {
+        ahead += _waiting[i];
+    }
+    return ahead;
+}
+
+vespalib::duration
+QueryLimiter::queue_delay_estimate(Priority priority) const noexcept
+{
+    if ((_maxQueries == 0) || ((_activeQueries < _maxQueries) && (waiting_ahead(priority) == 0))) {
+        return vespalib::duration::zero();
+    }
+    // Each admitted query frees a slot after the average service time, spread over all slots
+    double delay_s = ((waiting_ahead(priority) + 1) * _serviceTime_s) / _maxQueries;
+    return vespalib::from_s(delay_s);
+}
+
+vespalib::duration
+QueryLimiter::estimated_queue_delay(Priority priority) const
+{
+    std::lock_guard<std::mutex> guard(_admissionLock);
+    return queue_delay_estimate(priority);
+}
+
+bool
+QueryLimiter::is_shedding() const
+{
+    std::lock_guard<std::mutex> guard(_admissionLock);
+    return _shedding;
+}
+
+void
+QueryLimiter::update_shedding(vespalib::duration queue_time, vespalib::steady_time now) noexcept
+{
+    if (queue_time < _targetDelay) {
+        _firstAboveTarget = vespalib::steady_time();
+        _shedding = false;
+    } else if (_firstAboveTarget == vespalib::steady_time()) {
+        _firstAboveTarget = now + _interval;
+    } else if (now >= _firstAboveTarget) {
+        _shedding = true;
+    }
+}
+
+QueryLimiter::Admission::UP
+QueryLimiter::admit(const Doom & doom, Priority priority)
+{
+    std::unique_lock<std::mutex> guard(_admissionLock);
+    if (_maxQueries == 0) {
+        return std::make_unique<Admission>(nullptr, true, vespalib::duration::zero());
+    }
+    auto start = vespalib::steady_clock::now();
+    size_t prio = size_t(priority);
+    // Waiting queries of higher priority go first, new queries queue behind waiting queries of same priority
+    auto may_run = [&]() noexcept {
+        return (_maxQueries == 0) || ((_activeQueries < _maxQueries) && (waiting_ahead(priority) == _waiting[prio]));
+    };
+    bool must_wait = (_activeQueries >= _maxQueries) || (waiting_ahead(priority) > 0);
+    if (must_wait) {
+        if ((priority == Priority::LOW) && _shedding) {
+            return std::make_unique<Admission>(nullptr, false, vespalib::duration::zero());
+        }
+        if (queue_delay_estimate(priority) > doom.soft_left()) {
+            return std::make_unique<Admission>(nullptr, false, vespalib::duration::zero());
+        }
+        ++_waiting[prio];
+        while (!may_run() && !doom.soft_doom()) {
+            vespalib::duration left = doom.soft_left();
+            if (left > vespalib::duration::zero()) {
+                _admissionCond.wait_for(guard, left);
+            }
+        }
+        --_waiting[prio];
+        if (!may_run()) {
+            _admissionCond.notify_all();
+            return std::make_unique<Admission>(nullptr, false, vespalib::steady_clock::now() - start);
+        }
+    }
+    auto now = vespalib::steady_clock::now();
+    vespalib::duration queue_time = must_wait ? (now - start) : vespalib::duration::zero();
+    update_shedding(queue_time, now);
+    ++_activeQueries;
+    return std::make_unique<Admission>(this, true, queue_time);
+}
+
+void
+QueryLimiter::release_admission(vespalib::duration service_time)
+{
+    std::lock_guard<std::mutex> guard(_admissionLock);
+    --_activeQueries;
+    double service_time_s = vespalib::to_s(service_time);
+    _serviceTime_s = (_serviceTime_s > 0.0)
+                     ? (_serviceTime_s + SERVICE_TIME_WEIGHT * (service_time_s - _serviceTime_s))
+                     : service_time_s;
+    _admissionCond.notify_all();
+}
+
 }
@@ -4,8 +4,10 @@
 
 #include <memory>
 #include <vespa/vespalib/util/doom.h>
+#include <array>
 #include <mutex>
 #include <condition_variable>
+#include <string_view>
 
 namespace proton::matching {
 
@@ -19,10 +21,49 @@ public:
         using UP = std::unique_ptr<Token>;
         virtual ~Token() = default;
     };
+
+    enum class Priority { HIGH = 0, NORMAL = 1, LOW = 2 };
+    static constexpr size_t NUM_PRIORITIES = 3;
+    // Unknown names give normal priority
+    static Priority to_priority(std::string_view name) noexcept;
+
+    /**
+     * The right of a query to match, held until matching is done. A
+     * query that is not admitted must not be matched.
+     */
+    class Admission {
+    public:
+        using UP = std::unique_ptr<Admission>;
+        Admission(QueryLimiter * limiter, bool admitted, vespalib::duration queue_time) noexcept;
+        Admission(const Admission &) = delete;
+        Admission & operator =(const Admission &) = delete;
+        ~Admission();
+        bool admitted() const noexcept { return _admitted; }
+        bool queued() const noexcept { return _queue_time > vespalib::duration::zero(); }
+        vespalib::duration queue_time() const noexcept { return _queue_time; }
+    private:
+        QueryLimiter         * _limiter;
+        bool                   _admitted;
+        vespalib::duration     _queue_time;
+        vespalib::steady_time  _admit_time;
+    };
 public:
     QueryLimiter();
     void configure(int maxThreads, double coverage, uint32_t minHits);
+    void configure_admission(uint32_t maxQueries, vespalib::duration targetDelay, vespalib::duration interval);
     Token::UP getToken(const Doom & doom, uint32_t numDocs, uint32_t numHits, bool hasSorting, bool hasGrouping);
+
+    /**
+     * Admits a query to matching when less than max queries are matching,
+     * waiting behind queries of higher or same priority otherwise. A query
+     * is rejected without waiting when the estimated queueing delay exceeds
+     * the time it has left, or when it has low priority while the queueing
+     * delay has stayed above target for a full interval (CoDel style).
+     */
+    Admission::UP admit(const Doom & doom, Priority priority);
+    // Estimated time a query with the given priority would wait for admission now
+    vespalib::duration estimated_queue_delay(Priority priority) const;
+    bool is_shedding() const;
 private:
     class NoLimitToken : public Token {
     };
@@ -37,6 +78,10 @@ private:
     };
     void grabToken(const Doom & doom);
     void releaseToken();
+    void release_admission(vespalib::duration service_time);
+    size_t waiting_ahead(Priority priority) const noexcept;
+    vespalib::duration queue_delay_estimate(Priority priority) const noexcept;
+    void update_shedding(vespalib::duration queue_time, vespalib::steady_time now) noexcept;
     std::mutex              _lock;
     std::condition_variable _cond;
     int _activeThreads;
@@ -46,6 +91,18 @@ private:
     std::atomic<double>   _coverage;
     std::atomic<uint32_t> _minHits;
 
+    // Admission control, protected by _admissionLock
+    mutable std::mutex                    _admissionLock;
+    std::condition_variable               _admissionCond;
+    uint32_t                              _maxQueries;
+    vespalib::duration                    _targetDelay;
+    vespalib::duration                    _interval;
+    uint32_t                              _activeQueries;
+    std::array<size_t, NUM_PRIORITIES>    _waiting;
+    double                                _serviceTime_s;
+    vespalib::steady_time                 _firstAboveTarget;
+    bool                                  _shedding;
+
     [[nodiscard]] int get_max_threads() const noexcept { return _maxThreads.load(std::memory_order_relaxed); }
     [[nodiscard]] double get_coverage() const noexcept { return _coverage.load(std::memory_order_relaxed); }
     [[nodiscard]] uint32_t get_min_hits() const noexcept { return _minHits.load(std::memory_order_relaxed); }
@@ -32,9 +32,18 @@ RequestContext::RequestContext(const Doom & doom,
       _query_env(query_env),
       _shared_store(shared_store),
       _create_blueprint_params(create_blueprint_params),
-      _metaStoreReadGuard(metaStoreReadGuard)
+      _metaStoreReadGuard(metaStoreReadGuard),
+      _rank_score_threshold()
 { }
 
+void
+RequestContext::enable_rank_score_threshold()
+{
+    if (!_rank_score_threshold) {
+        _rank_score_threshold = std::make_unique<search::queryeval::RankScoreThreshold>();
+    }
+}
+
 const search::attribute::IAttributeVector *
 RequestContext::getAttribute(std::string_view name) const
 {
@@ -7,6 +7,7 @@
 #include <vespa/searchlib/queryeval/create_blueprint_params.h>
 #include <vespa/searchlib/queryeval/i_element_gap_inspector.h>
 #include <vespa/searchlib/queryeval/irequestcontext.h>
+#include <vespa/searchlib/queryeval/rank_score_threshold.h>
 #include <vespa/vespalib/util/doom.h>
 
 namespace search::fef {
@@ -52,6 +53,18 @@ public:
 
     search::fef::ElementGap get_element_gap(uint32_t field_id) const noexcept override;
 
+    const search::queryeval::RankScoreThreshold *get_rank_score_threshold() const noexcept override {
+        return _rank_score_threshold.get();
+    }
+    /**
+     * Must be called before blueprints are created for the
+     * threshold to be visible to the search iterators.
+     **/
+    void enable_rank_score_threshold();
+    search::queryeval::RankScoreThreshold *rank_score_threshold() const noexcept {
+        return _rank_score_threshold.get();
+    }
+
 private:
     const Doom                                    _doom;
     vespalib::ThreadBundle                      & _thread_bundle;
@@ -60,6 +73,7 @@ private:
     search::fef::IObjectStore                   & _shared_store;
     search::queryeval::CreateBlueprintParams      _create_blueprint_params;
     const MetaStoreReadGuardSP                  * _metaStoreReadGuard;
+    std::unique_ptr<search::queryeval::RankScoreThreshold> _rank_score_threshold;
 };
 
 }
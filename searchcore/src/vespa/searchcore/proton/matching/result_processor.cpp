@@ -172,4 +172,22 @@ ResultProcessor::makeReply(PartialResultUP full_result)
     return std::make_unique<Result>(std::move(reply), numFs4Hits);
 }
 
+std::unique_ptr<search::engine::SearchReply>
+ResultProcessor::make_partial_reply(const std::vector<std::pair<uint32_t, search::feature_t>> &hits) const
+{
+    auto reply = std::make_unique<search::engine::SearchReply>();
+    size_t begin = std::min(_offset, hits.size());
+    size_t end = std::min(_offset + _hits, hits.size());
+    reply->hits.resize(end - begin);
+    document::GlobalId gid;
+    for (size_t i = begin; i < end; ++i) {
+        search::engine::SearchReply::Hit &dst = reply->hits[i - begin];
+        if (_metaStore.getGidEvenIfMoved(hits[i].first, gid)) {
+            dst.gid = gid;
+        }
+        dst.metric = hits[i].second;
+    }
+    return reply;
+}
+
 }
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/searchlib/common/feature.h>
 #include <vespa/searchlib/common/sortresults.h>
 #include <vespa/vespalib/util/dual_merge_director.h>
 
@@ -105,6 +106,8 @@ public:
     std::unique_ptr<Context> createThreadContext(const vespalib::Doom & hardDoom, size_t thread_id, uint32_t distributionKey);
     std::vector<std::pair<uint32_t,uint32_t>> extract_docid_ordering(const PartialResult &result) const;
     std::unique_ptr<Result> makeReply(PartialResultUP full_result);
+    // early reply with the given (docid, first-phase score) hits, before second phase ranking and grouping
+    std::unique_ptr<search::engine::SearchReply> make_partial_reply(const std::vector<std::pair<uint32_t, search::feature_t>> &hits) const;
 };
 
 }
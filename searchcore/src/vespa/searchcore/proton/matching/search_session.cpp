@@ -2,6 +2,7 @@
 #include "search_session.h"
 #include "match_tools.h"
 #include "match_context.h"
+#include <vespa/vespalib/util/featureset.h>
 
 namespace proton::matching {
 
@@ -12,7 +13,8 @@ SearchSession::SearchSession(const SessionId &id, vespalib::steady_time create_t
       _create_time(create_time),
       _time_of_doom(time_of_doom),
       _owned_objects(std::move(owned_objects)),
-      _match_tools_factory(std::move(match_tools_factory))
+      _match_tools_factory(std::move(match_tools_factory)),
+      _summary_features()
 {
 }
 
@@ -10,6 +10,7 @@
 #include <string>
 
 namespace search::fef { class Properties; }
+namespace vespalib { class FeatureSet; }
 
 namespace proton::matching {
 
@@ -43,6 +44,7 @@ private:
     vespalib::steady_time _time_of_doom;
     OwnershipBundle       _owned_objects;
     std::unique_ptr<MatchToolsFactory> _match_tools_factory;
+    std::shared_ptr<const vespalib::FeatureSet> _summary_features;
 
 public:
     using SP = std::shared_ptr<SearchSession>;
@@ -65,6 +67,18 @@ public:
     vespalib::steady_time getTimeOfDoom() const { return _time_of_doom; }
 
     MatchToolsFactory &getMatchToolsFactory() { return *_match_tools_factory; }
+
+    /**
+     * Summary features computed for the returned hits during the match
+     * phase, kept as long as the session. Must be set before the session
+     * is shared.
+     */
+    void set_summary_features(std::shared_ptr<const vespalib::FeatureSet> features) {
+        _summary_features = std::move(features);
+    }
+    const std::shared_ptr<const vespalib::FeatureSet> &get_summary_features() const noexcept {
+        return _summary_features;
+    }
     std::string_view getStackDump() const noexcept {
         return {_owned_objects.stackDump.data(), _owned_objects.stackDump.size()};
     }
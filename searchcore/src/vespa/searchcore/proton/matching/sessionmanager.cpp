@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "sessionmanager.h"
+#include "grouping_result_cache.h"
 #include <vespa/vespalib/stllike/lrucache_map.hpp>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/util/lambdatask.h>
@@ -164,8 +165,17 @@ struct SearchSessionCache : public SessionMap<SearchSession> {
 
 
 SessionManager::SessionManager(uint32_t maxSize)
+    : SessionManager(maxSize, 0, vespalib::duration::zero())
+{
+}
+
+SessionManager::SessionManager(uint32_t maxSize, size_t groupingResultMaxBytes, vespalib::duration groupingResultTtl)
     : _grouping_cache(std::make_unique<GroupingSessionCache>(maxSize)),
-      _search_map(std::make_unique<SearchSessionCache>()) {
+      _search_map(std::make_unique<SearchSessionCache>()),
+      _grouping_result_cache((groupingResultMaxBytes > 0)
+                             ? std::make_unique<GroupingResultCache>(groupingResultMaxBytes, groupingResultTtl)
+                             : std::unique_ptr<GroupingResultCache>())
+{
 }
 
 SessionManager::~SessionManager() {
@@ -236,6 +246,9 @@ void
 SessionManager::pruneTimedOutSessions(vespalib::steady_time currentTime, vespalib::ThreadExecutor & executor) {
     split_and_execute(_grouping_cache->stealTimedOutSessions(currentTime), executor);
     split_and_execute(_search_map->stealTimedOutSessions(currentTime), executor);
+    if (_grouping_result_cache) {
+        _grouping_result_cache->prune(currentTime);
+    }
 }
 
 SessionManager::Stats
@@ -13,6 +13,7 @@ using SessionId = std::string;
 
 struct GroupingSessionCache;
 struct SearchSessionCache;
+class GroupingResultCache;
 
 class SessionManager {
 public:
@@ -61,15 +62,24 @@ public:
 private:
     std::unique_ptr<GroupingSessionCache> _grouping_cache;
     std::unique_ptr<SearchSessionCache> _search_map;
+    std::unique_ptr<GroupingResultCache> _grouping_result_cache;
 
 public:
     explicit SessionManager(uint32_t maxSizeGrouping);
+    /**
+     * A positive groupingResultMaxBytes enables caching of the final
+     * replies of grouping requests, see GroupingResultCache.
+     **/
+    SessionManager(uint32_t maxSizeGrouping, size_t groupingResultMaxBytes, vespalib::duration groupingResultTtl);
     ~SessionManager();
 
     void insert(search::grouping::GroupingSession::UP session);
     search::grouping::GroupingSession::UP pickGrouping(const SessionId &id);
     Stats getGroupingStats();
 
+    // nullptr when caching of grouping results is disabled
+    GroupingResultCache *getGroupingResultCache() const noexcept { return _grouping_result_cache.get(); }
+
     void insert(SearchSession::SP session);
     SearchSession::SP pickSearch(const SessionId &id);
     Stats getSearchStats();
@@ -12,7 +12,8 @@ const std::string entry_description("Metrics for a given attribute vector");
 }
 
 AttributeMetricsEntry::AttributeMetricsEntry(const std::string& field_name)
-    : FieldMetricsEntry(entry_name, field_name, entry_description)
+    : FieldMetricsEntry(entry_name, field_name, entry_description),
+      bitvector_search_cache(this, "bitvector_search_cache", "Bit vector search cache metrics", "bitvector_search")
 {
 }
 
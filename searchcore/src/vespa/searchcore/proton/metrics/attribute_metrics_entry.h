@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "cache_metrics.h"
 #include "field_metrics_entry.h"
 
 namespace proton {
@@ -11,6 +12,7 @@ namespace proton {
  * an attribute vector.
  */
 struct AttributeMetricsEntry : public FieldMetricsEntry {
+    CacheMetrics bitvector_search_cache;
     AttributeMetricsEntry(const std::string& field_name);
     ~AttributeMetricsEntry() override;
 };
@@ -20,7 +20,9 @@ void update_helper(metrics::LongValueMetric &metric, const DiskIoStats &stats) {
 DiskIoMetrics::SearchMetrics::SearchMetrics(metrics::MetricSet* parent)
     : MetricSet("search", {}, "The search io for a given component", parent),
       _read_bytes("read_bytes", {}, "Bytes read in posting list files as part of search", this),
-      _cached_read_bytes("cached_read_bytes", {}, "Bytes read from posting list files cache as part of search", this)
+      _cached_read_bytes("cached_read_bytes", {}, "Bytes read from posting list files cache as part of search", this),
+      _direct_io_read_bytes("direct_io_read_bytes", {},
+                            "Bytes read in posting list files bypassing the OS page cache as part of search", this)
 {
 }
 
@@ -31,6 +33,7 @@ DiskIoMetrics::SearchMetrics::update(const FieldIndexIoStats& io_stats)
 {
     update_helper(_read_bytes, io_stats.read());
     update_helper(_cached_read_bytes, io_stats.cached_read());
+    update_helper(_direct_io_read_bytes, io_stats.direct_io_read());
 }
 
 DiskIoMetrics::DiskIoMetrics(metrics::MetricSet* parent)
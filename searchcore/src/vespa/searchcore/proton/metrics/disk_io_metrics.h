@@ -17,6 +17,7 @@ class DiskIoMetrics : public metrics::MetricSet {
     class SearchMetrics : public metrics::MetricSet {
         metrics::LongValueMetric _read_bytes;
         metrics::LongValueMetric _cached_read_bytes;
+        metrics::LongValueMetric _direct_io_read_bytes;
     public:
         explicit SearchMetrics(metrics::MetricSet* parent);
         ~SearchMetrics() override;
@@ -4,10 +4,40 @@
 
 namespace proton {
 
+namespace {
+
+std::string
+bucket_name(size_t bucket, size_t num_buckets)
+{
+    uint32_t lower = 1u << bucket;
+    if (bucket + 1 == num_buckets) {
+        return "ops_" + std::to_string(lower) + "_plus";
+    }
+    uint32_t upper = (lower << 1) - 1;
+    return (lower == upper) ? ("ops_" + std::to_string(lower))
+                            : ("ops_" + std::to_string(lower) + "_" + std::to_string(upper));
+}
+
+}
+
+DocumentDBCommitMetrics::BatchSizeMetrics::BatchSizeMetrics(metrics::MetricSet* parent)
+    : MetricSet("batch_size", {}, "number of commits per number of operations in a commit", parent),
+      commits()
+{
+    commits.reserve(num_buckets);
+    for (size_t bucket = 0; bucket < num_buckets; ++bucket) {
+        commits.emplace_back(std::make_unique<metrics::LongCountMetric>(bucket_name(bucket, num_buckets), metrics::Metric::Tags(),
+                                                                        "Number of commits with this many operations", this));
+    }
+}
+
+DocumentDBCommitMetrics::BatchSizeMetrics::~BatchSizeMetrics() = default;
+
 DocumentDBCommitMetrics::DocumentDBCommitMetrics(metrics::MetricSet* parent)
     : MetricSet("commit", {}, "commit metrics for feeding in a document database", parent),
       operations("operations", {}, "Number of operations included in a commit", this),
-      latency("latency", {}, "Latency for commit", this)
+      latency("latency", {}, "Latency for commit", this),
+      batch_size(this)
 {
 }
 
@@ -1,8 +1,11 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <vespa/metrics/countmetric.h>
 #include <vespa/metrics/metricset.h>
 #include <vespa/metrics/valuemetric.h>
+#include <memory>
+#include <vector>
 
 namespace proton {
 
@@ -11,8 +14,21 @@ namespace proton {
  */
 struct DocumentDBCommitMetrics : metrics::MetricSet
 {
+    /*
+     * Number of commits per number of operations in the commit. Bucket i
+     * counts commits with [2^i, 2^(i+1)) operations, the last bucket is open ended.
+     */
+    struct BatchSizeMetrics : metrics::MetricSet {
+        static constexpr size_t num_buckets = 11;
+        std::vector<std::unique_ptr<metrics::LongCountMetric>> commits;
+
+        BatchSizeMetrics(metrics::MetricSet* parent);
+        ~BatchSizeMetrics() override;
+    };
+
     metrics::DoubleAverageMetric operations;
     metrics::DoubleAverageMetric latency;
+    BatchSizeMetrics             batch_size;
 
     DocumentDBCommitMetrics(metrics::MetricSet* parent);
     ~DocumentDBCommitMetrics() override;
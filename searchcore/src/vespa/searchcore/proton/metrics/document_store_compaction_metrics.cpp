@@ -0,0 +1,45 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "document_store_compaction_metrics.h"
+
+using search::DataStoreCompactionStats;
+
+namespace proton {
+
+DocumentStoreCompactionMetrics::DocumentStoreCompactionMetrics(MetricSet *parent)
+    : MetricSet("compaction", {}, "Document store compaction metrics", parent),
+      compactedFiles("compacted_files", {}, "Number of files compacted", this),
+      bytesRead("bytes_read", {}, "Size of the compacted files (in bytes)", this),
+      bytesWritten("bytes_written", {}, "Size of the documents moved by compaction (in bytes)", this),
+      bloatRemoved("bloat_removed", {}, "Disk space bloat removed by compaction (in bytes)", this),
+      throughput("throughput", {}, "Bytes read per second while compacting", this),
+      throttledTime("throttled_time", {}, "Time (in seconds) compaction was delayed by the I/O rate limit since last update", this),
+      _last_stats()
+{
+}
+
+DocumentStoreCompactionMetrics::~DocumentStoreCompactionMetrics() = default;
+
+void
+DocumentStoreCompactionMetrics::update_count_metric(uint64_t currVal, uint64_t lastVal, metrics::LongCountMetric& metric)
+{
+    uint64_t delta = (currVal >= lastVal) ? (currVal - lastVal) : 0;
+    metric.inc(delta);
+}
+
+void
+DocumentStoreCompactionMetrics::update_metrics(const DataStoreCompactionStats& stats)
+{
+    update_count_metric(stats.compactedFiles(), _last_stats.compactedFiles(), compactedFiles);
+    update_count_metric(stats.bytesRead(), _last_stats.bytesRead(), bytesRead);
+    update_count_metric(stats.bytesWritten(), _last_stats.bytesWritten(), bytesWritten);
+    update_count_metric(stats.bloatRemoved(), _last_stats.bloatRemoved(), bloatRemoved);
+    double compaction_time = vespalib::to_s(stats.compactionTime() - _last_stats.compactionTime());
+    if ((compaction_time > 0.0) && (stats.bytesRead() >= _last_stats.bytesRead())) {
+        throughput.set((stats.bytesRead() - _last_stats.bytesRead()) / compaction_time);
+    }
+    throttledTime.set(vespalib::to_s(stats.throttledTime() - _last_stats.throttledTime()));
+    _last_stats = stats;
+}
+
+}
@@ -0,0 +1,30 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/metrics/countmetric.h>
+#include <vespa/metrics/metricset.h>
+#include <vespa/metrics/valuemetric.h>
+#include <vespa/searchlib/docstore/data_store_compaction_stats.h>
+
+namespace proton {
+
+/**
+ * Metrics for compactions done by a document store, e.g. search::LogDataStore.
+ */
+class DocumentStoreCompactionMetrics : public metrics::MetricSet {
+    metrics::LongCountMetric compactedFiles;
+    metrics::LongCountMetric bytesRead;
+    metrics::LongCountMetric bytesWritten;
+    metrics::LongCountMetric bloatRemoved;
+    metrics::DoubleValueMetric throughput;
+    metrics::DoubleValueMetric throttledTime;
+    search::DataStoreCompactionStats _last_stats;
+
+    static void update_count_metric(uint64_t currVal, uint64_t lastVal, metrics::LongCountMetric &metric);
+public:
+    explicit DocumentStoreCompactionMetrics(metrics::MetricSet* parent);
+    ~DocumentStoreCompactionMetrics() override;
+    void update_metrics(const search::DataStoreCompactionStats& stats);
+};
+
+}
@@ -63,7 +63,9 @@ DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics::DocumentStoreMetric
       diskBloat("disk_bloat", {}, "Disk space bloat in bytes", this),
       maxBucketSpread("max_bucket_spread", {}, "Max bucket spread in underlying files (sum(unique buckets in each chunk)/unique buckets in file)", this),
       memoryUsage(this),
-      cache(this, "cache", "Document store cache metrics", "Document store")
+      cache(this, "cache", "Document store cache metrics", "Document store"),
+      rendered_cache(this, "rendered_cache", "Rendered document summary cache metrics", "Rendered document summary"),
+      compaction(this)
 {
 }
 
@@ -113,6 +115,18 @@ DocumentDBTaggedMetrics::MatchingMetrics::update(const MatchingStats &stats)
                                       stats.querySetupTimeMin(), stats.querySetupTimeMax());
     queryLatency.addValueBatch(stats.queryLatencyAvg(), stats.queryLatencyCount(),
                                stats.queryLatencyMin(), stats.queryLatencyMax());
+    resultCacheHits.inc(stats.result_cache_hits());
+    resultCacheMisses.inc(stats.result_cache_misses());
+    size_t lookups = stats.result_cache_hits() + stats.result_cache_misses();
+    if (lookups > 0) {
+        resultCacheHitRatio.set(static_cast<double>(stats.result_cache_hits()) / lookups);
+    }
+    queuedQueries.inc(stats.queued_queries());
+    shedQueries.inc(stats.shed_queries());
+    queueTime.addValueBatch(stats.queueTimeAvg(), stats.queueTimeCount(),
+                            stats.queueTimeMin(), stats.queueTimeMax());
+    wakeupTime.addValueBatch(stats.wakeupTimeAvg(), stats.wakeupTimeCount(),
+                             stats.wakeupTimeMin(), stats.wakeupTimeMax());
 }
 
 DocumentDBTaggedMetrics::MatchingMetrics::MatchingMetrics(MetricSet *parent)
@@ -123,7 +137,14 @@ DocumentDBTaggedMetrics::MatchingMetrics::MatchingMetrics(MetricSet *parent)
       queries("queries", {}, "Number of queries executed", this),
       softDoomedQueries("soft_doomed_queries", {}, "Number of queries hitting the soft timeout", this),
       querySetupTime("query_setup_time", {}, "Average time (sec) spent setting up and tearing down queries", this),
-      queryLatency("query_latency", {}, "Total average latency (sec) when matching and ranking a query", this)
+      queryLatency("query_latency", {}, "Total average latency (sec) when matching and ranking a query", this),
+      resultCacheHits("result_cache_hits", {}, "Number of queries answered from the query result cache", this),
+      resultCacheMisses("result_cache_misses", {}, "Number of cacheable queries not found in the query result cache", this),
+      resultCacheHitRatio("result_cache_hit_ratio", {}, "Ratio of cacheable queries answered from the query result cache", this),
+      queuedQueries("queued_queries", {}, "Number of queries that waited for admission to matching", this),
+      shedQueries("shed_queries", {}, "Number of queries rejected by admission control without matching", this),
+      queueTime("queue_time", {}, "Average time (sec) queries waited for admission to matching", this),
+      wakeupTime("wakeup_time", {}, "Average time (sec) from handing out a query to the match threads until the last one started", this)
 {
 }
 
@@ -138,6 +159,9 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::RankProfileMetrics
       docsReRanked("docs_reranked", {}, "Number of documents re-ranked (second phase)", this),
       queries("queries", {}, "Number of queries executed", this),
       limitedQueries("limited_queries", {}, "Number of queries limited in match phase", this),
+      adaptiveLimitedQueries("adaptive_limited_queries", {}, "Number of queries limited in match phase with max hits lowered to fit the time left", this),
+      adaptiveMaxHits("adaptive_max_hits", {}, "Average max hits chosen by adaptive match phase limiting", this),
+      matchCostPerHit("match_cost_per_hit", {}, "Smoothed match time (sec) per matched document", this),
       softDoomedQueries("soft_doomed_queries", {}, "Number of queries hitting the soft timeout", this),
       softDoomFactor("soft_doom_factor", {}, "Factor used to compute soft-timeout", this),
       matchTime("match_time", {}, "Average time (sec) for matching a query (1st phase)", this),
@@ -187,6 +211,10 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::update(const metri
     docsReRanked.inc(stats.docsReRanked());
     queries.inc(stats.queries());
     limitedQueries.inc(stats.limited_queries());
+    adaptiveLimitedQueries.inc(stats.adaptive_limited_queries());
+    adaptiveMaxHits.addValueBatch(stats.adaptiveMaxHitsAvg(), stats.adaptiveMaxHitsCount(),
+                                  stats.adaptiveMaxHitsMin(), stats.adaptiveMaxHitsMax());
+    matchCostPerHit.set(stats.matchCostPerHit());
     softDoomedQueries.inc(stats.softDoomed());
     softDoomFactor.set(stats.softDoomFactor());
     matchTime.addValueBatch(stats.matchTimeAvg(), stats.matchTimeCount(),
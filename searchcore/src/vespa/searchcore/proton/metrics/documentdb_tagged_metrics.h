@@ -6,6 +6,7 @@
 #include "memory_usage_metrics.h"
 #include "executor_threading_service_metrics.h"
 #include "document_db_feeding_metrics.h"
+#include "document_store_compaction_metrics.h"
 #include "index_metrics.h"
 #include <vespa/metrics/metricset.h>
 #include <vespa/metrics/valuemetric.h>
@@ -59,6 +60,8 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
             metrics::DoubleValueMetric maxBucketSpread;
             MemoryUsageMetrics memoryUsage;
             CacheMetrics cache;
+            CacheMetrics rendered_cache;
+            DocumentStoreCompactionMetrics compaction;
 
             DocumentStoreMetrics(metrics::MetricSet *parent);
             ~DocumentStoreMetrics() override;
@@ -112,6 +115,13 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
         metrics::LongCountMetric softDoomedQueries;
         metrics::DoubleAverageMetric querySetupTime;
         metrics::DoubleAverageMetric queryLatency;
+        metrics::LongCountMetric resultCacheHits;
+        metrics::LongCountMetric resultCacheMisses;
+        metrics::DoubleValueMetric resultCacheHitRatio;
+        metrics::LongCountMetric queuedQueries;
+        metrics::LongCountMetric shedQueries;
+        metrics::DoubleAverageMetric queueTime;
+        metrics::DoubleAverageMetric wakeupTime;
 
         struct RankProfileMetrics : metrics::MetricSet {
             struct DocIdPartition : metrics::MetricSet {
@@ -134,6 +144,9 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
             metrics::LongCountMetric     docsReRanked;
             metrics::LongCountMetric     queries;
             metrics::LongCountMetric     limitedQueries;
+            metrics::LongCountMetric     adaptiveLimitedQueries;
+            metrics::DoubleAverageMetric adaptiveMaxHits;
+            metrics::DoubleValueMetric   matchCostPerHit;
             metrics::LongCountMetric     softDoomedQueries;
             metrics::DoubleValueMetric   softDoomFactor;
             metrics::DoubleAverageMetric matchTime;
@@ -2,18 +2,71 @@
 
 #include "trans_log_server_metrics.h"
 
+using search::transactionlog::CommitLatencyStats;
 using search::transactionlog::DomainInfo;
 using search::transactionlog::DomainStats;
 
 namespace proton {
 
+namespace {
+
+std::string
+latencyBucketName(size_t bucket)
+{
+    const auto &limits = CommitLatencyStats::bucket_limits;
+    bool last = (bucket == limits.size());
+    double ms = (last ? limits.back() : limits[bucket]) * 1000.0;
+    std::string name = std::to_string(static_cast<uint32_t>(ms));
+    uint32_t tenths = static_cast<uint32_t>(ms * 10.0 + 0.5) % 10;
+    if (tenths != 0) {
+        name += "_" + std::to_string(tenths);
+    }
+    return (last ? "above_" : "up_to_") + name + "ms";
+}
+
+}
+
+TransLogServerMetrics::CommitMetrics::CommitMetrics(metrics::MetricSet *parent)
+    : metrics::MetricSet("commit", {}, "Commit metrics for the transaction log", parent),
+      latency("latency", {}, "Latency (in seconds) from a commit is started until it is written and synced", this),
+      syncs("syncs", {}, "Number of syncs of commits, a sync can cover multiple commits", this),
+      latencyBuckets(),
+      last()
+{
+    latencyBuckets.reserve(CommitLatencyStats::NUM_BUCKETS);
+    for (size_t bucket = 0; bucket < CommitLatencyStats::NUM_BUCKETS; ++bucket) {
+        latencyBuckets.emplace_back(std::make_unique<metrics::LongCountMetric>(latencyBucketName(bucket), metrics::Metric::Tags(),
+                                                                               "Number of commits with this latency", this));
+    }
+}
+
+TransLogServerMetrics::CommitMetrics::~CommitMetrics() = default;
+
+void
+TransLogServerMetrics::CommitMetrics::update(const CommitLatencyStats &stats)
+{
+    if (stats.commits < last.commits) {
+        last = CommitLatencyStats(); // Domain was recreated
+    }
+    uint64_t commits = stats.commits - last.commits;
+    if (commits != 0) {
+        latency.addTotalValueWithCount(stats.total_latency - last.total_latency, commits);
+    }
+    syncs.inc(stats.syncs - last.syncs);
+    for (size_t bucket = 0; bucket < CommitLatencyStats::NUM_BUCKETS; ++bucket) {
+        latencyBuckets[bucket]->inc(stats.buckets[bucket] - last.buckets[bucket]);
+    }
+    last = stats;
+}
+
 TransLogServerMetrics::DomainMetrics::DomainMetrics(metrics::MetricSet *parent,
                                                     const std::string &documentType)
     : metrics::MetricSet("transactionlog", {{"documenttype", documentType}},
             "Transaction log metrics for a document type", parent),
       entries("entries", {}, "The current number of entries in the transaction log", this),
       diskUsage("disk_usage", {}, "The disk usage (in bytes) of the transaction log", this),
-      replayTime("replay_time", {}, "The replay time (in seconds) of the transaction log during start-up", this)
+      replayTime("replay_time", {}, "The replay time (in seconds) of the transaction log during start-up", this),
+      commit(this)
 {
 }
 
@@ -25,6 +78,7 @@ TransLogServerMetrics::DomainMetrics::update(const DomainInfo &stats)
     entries.set(stats.numEntries);
     diskUsage.set(stats.byteSize);
     replayTime.set(stats.maxSessionRunTime.count());
+    commit.update(stats.commitLatency);
 }
 
 void
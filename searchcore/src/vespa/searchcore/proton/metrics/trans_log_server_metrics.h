@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include <vespa/metrics/countmetric.h>
 #include <vespa/metrics/metricset.h>
 #include <vespa/metrics/valuemetric.h>
 #include <vespa/searchlib/transactionlog/domainconfig.h>
+#include <memory>
+#include <vector>
 
 namespace proton {
 
@@ -14,11 +17,30 @@ namespace proton {
 class TransLogServerMetrics
 {
 public:
+    /*
+     * Latency of commits to a domain, from a chunk is handed over for
+     * writing until it is written and synced. Commits are counted per
+     * latency bucket, see CommitLatencyStats for the bucket limits.
+     */
+    struct CommitMetrics : public metrics::MetricSet
+    {
+        using CommitLatencyStats = search::transactionlog::CommitLatencyStats;
+        metrics::DoubleAverageMetric latency;
+        metrics::LongCountMetric syncs;
+        std::vector<std::unique_ptr<metrics::LongCountMetric>> latencyBuckets;
+        CommitLatencyStats last;
+
+        CommitMetrics(metrics::MetricSet *parent);
+        ~CommitMetrics() override;
+        void update(const CommitLatencyStats &stats);
+    };
+
     struct DomainMetrics : public metrics::MetricSet
     {
         metrics::LongValueMetric entries;
         metrics::LongValueMetric diskUsage;
         metrics::DoubleValueMetric replayTime;
+        CommitMetrics commit;
 
         using UP = std::unique_ptr<DomainMetrics>;
         DomainMetrics(metrics::MetricSet *parent, const std::string &documentType);
@@ -51,6 +51,12 @@ CommitAndWaitDocumentRetriever::visitDocuments(const LidVector &lids, search::ID
     _retriever->visitDocuments(lids, visitor, readConsistency);
 }
 
+void
+CommitAndWaitDocumentRetriever::sortInReadOrder(LidVector &lids) const
+{
+    _retriever->sortInReadOrder(lids);
+}
+
 CachedSelect::SP
 CommitAndWaitDocumentRetriever::parseSelect(const std::string &selection) const {
     return _retriever->parseSelect(selection);
@@ -27,6 +27,7 @@ public:
     DocumentUP getFullDocument(search::DocumentIdT lid) const override;
     DocumentUP getPartialDocument(search::DocumentIdT lid, const document::DocumentId & docId, const document::FieldSet & fieldSet) const override;
     void visitDocuments(const LidVector &lids, search::IDocumentVisitor &visitor, ReadConsistency readConsistency) const override;
+    void sortInReadOrder(LidVector &lids) const override;
     CachedSelect::SP parseSelect(const std::string &selection) const override;
     ReadGuard getReadGuard() const override;
     uint32_t getDocIdLimit() const override;
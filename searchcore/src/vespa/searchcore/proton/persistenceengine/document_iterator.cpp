@@ -11,6 +11,10 @@
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <cassert>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.persistenceengine.document_iterator");
@@ -27,6 +31,13 @@ namespace proton {
 
 namespace {
 
+class Matcher;
+using LidIndexMap = vespalib::hash_map<uint32_t, uint32_t>;
+
+// Used for sizing the first read-ahead slice, before any documents have been read
+constexpr size_t INITIAL_DOC_SIZE_ESTIMATE = 4_Ki;
+constexpr size_t MIN_DOC_SIZE_ESTIMATE = 256;
+
 std::unique_ptr<DocEntry>
 createDocEntry(Timestamp timestamp, bool removed) {
     return DocEntry::create(timestamp, removed ? DocumentMetaEnum::REMOVE_ENTRY : DocumentMetaEnum::NONE);
@@ -53,6 +64,27 @@ createDocEntry(Timestamp timestamp, bool removed, Document::UP doc, ssize_t defa
 
 } // namespace proton::<unnamed>
 
+/**
+ * A source with the lids of its matching documents resolved from document meta data.
+ * The documents of the lids from nextLid and onwards have yet to be read.
+ */
+class DocumentIterator::PendingSource {
+public:
+    PendingSource(const IDocumentRetriever & retriever_in, IDocumentRetriever::ReadGuard readGuard_in);
+    PendingSource(const PendingSource &) = delete;
+    PendingSource & operator=(const PendingSource &) = delete;
+    ~PendingSource();
+    [[nodiscard]] size_t remaining() const noexcept { return lidsToFetch.size() - nextLid; }
+
+    const IDocumentRetriever         & retriever;
+    IDocumentRetriever::ReadGuard      readGuard;
+    search::DocumentMetaData::Vector   metaData;
+    std::unique_ptr<Matcher>           matcher;
+    LidIndexMap                        lidIndexMap;
+    IDocumentRetriever::LidVector      lidsToFetch;
+    size_t                             nextLid;
+};
+
 bool
 DocumentIterator::checkMeta(const search::DocumentMetaData &meta) const
 {
@@ -93,11 +125,23 @@ DocumentIterator::DocumentIterator(const storage::spi::Bucket &bucket,
       _fetchedData(false),
       _sources(),
       _nextItem(0),
-      _list()
+      _list(),
+      _readAheadBytes(0),
+      _readAheadExecutor(nullptr),
+      _pendingSources(),
+      _bufferedBytes(0),
+      _fetchedLids(0),
+      _fetchedBytes(0),
+      _readAhead()
 {
 }
 
-DocumentIterator::~DocumentIterator() = default;
+DocumentIterator::~DocumentIterator()
+{
+    if (_readAhead.valid()) {
+        _readAhead.wait();
+    }
+}
 
 void
 DocumentIterator::add(const DocTypeName &doc_type_name, IDocumentRetriever::SP retriever)
@@ -111,9 +155,21 @@ DocumentIterator::add(IDocumentRetriever::SP retriever)
     add(DocTypeName(), std::move(retriever));
 }
 
+void
+DocumentIterator::setReadAhead(size_t maxBytes, vespalib::Executor * executor)
+{
+    assert( ! _fetchedData);
+    bool applicable = ! (_metaOnly || _ignoreMaxBytes);
+    _readAheadBytes = applicable ? maxBytes : 0;
+    _readAheadExecutor = applicable ? executor : nullptr;
+}
+
 IterateResult
 DocumentIterator::iterate(size_t maxBytes)
 {
+    if (readAheadEnabled()) {
+        return iterateWithReadAhead(maxBytes);
+    }
     if ( ! _fetchedData ) {
         for (const auto & source : _sources) {
             fetchCompleteSource(source.first, *source.second, _list);
@@ -133,6 +189,99 @@ DocumentIterator::iterate(size_t maxBytes)
     }
 }
 
+IterateResult
+DocumentIterator::iterateWithReadAhead(size_t maxBytes)
+{
+    waitForReadAhead();
+    if ( ! _fetchedData ) {
+        for (const auto & source : _sources) {
+            auto pending = resolveSource(*source.second);
+            if (pending) {
+                pending->retriever.sortInReadOrder(pending->lidsToFetch);
+                _pendingSources.push_back(std::move(pending));
+            }
+        }
+        _fetchedData = true;
+    }
+    // Read-ahead might not have kept up, make sure a full batch is available
+    fetchUntilBuffered(std::max(maxBytes, size_t(1)));
+    IterateResult::List results;
+    size_t sz(0);
+    for (; (_nextItem < _list.size()) && ((sz < maxBytes) || results.empty()); _nextItem++) {
+        DocEntry::UP item = std::move(_list[_nextItem]);
+        sz += item->getSize();
+        results.push_back(std::move(item));
+    }
+    _bufferedBytes -= sz;
+    _list.erase(_list.begin(), _list.begin() + _nextItem);
+    _nextItem = 0;
+    bool completed = _list.empty() && _pendingSources.empty();
+    if ( ! completed ) {
+        startReadAhead();
+    }
+    return IterateResult(std::move(results), completed);
+}
+
+void
+DocumentIterator::fetchUntilBuffered(size_t bytes)
+{
+    while ((_bufferedBytes < bytes) && ! _pendingSources.empty()) {
+        PendingSource & source = *_pendingSources.front();
+        size_t docSizeEstimate = (_fetchedLids > 0)
+                ? std::max(MIN_DOC_SIZE_ESTIMATE, _fetchedBytes / _fetchedLids)
+                : INITIAL_DOC_SIZE_ESTIMATE;
+        size_t wantedLids = (bytes - _bufferedBytes + docSizeEstimate - 1) / docSizeEstimate;
+        size_t numLids = std::min(source.remaining(), wantedLids);
+        auto first = source.lidsToFetch.cbegin() + source.nextLid;
+        IDocumentRetriever::LidVector lids(first, first + numLids);
+        source.nextLid += numLids;
+
+        size_t firstItem = _list.size();
+        fetchLids(source, lids, _list);
+        size_t fetchedBytes(0);
+        for (size_t i(firstItem); i < _list.size(); i++) {
+            fetchedBytes += _list[i]->getSize();
+        }
+        _bufferedBytes += fetchedBytes;
+        _fetchedLids += numLids;
+        _fetchedBytes += fetchedBytes;
+        if (source.remaining() == 0) {
+            // Also releases the read guard of the source
+            _pendingSources.erase(_pendingSources.begin());
+        }
+    }
+}
+
+void
+DocumentIterator::startReadAhead()
+{
+    if ((_readAheadExecutor == nullptr) || _pendingSources.empty() || (_bufferedBytes >= _readAheadBytes)) {
+        return;
+    }
+    auto promise = std::make_shared<std::promise<void>>();
+    _readAhead = promise->get_future();
+    auto task = vespalib::makeLambdaTask([this, promise]() {
+        try {
+            fetchUntilBuffered(_readAheadBytes);
+            promise->set_value();
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    auto rejected = _readAheadExecutor->execute(std::move(task));
+    if (rejected) {
+        rejected->run();
+    }
+}
+
+void
+DocumentIterator::waitForReadAhead()
+{
+    if (_readAhead.valid()) {
+        _readAhead.get(); // Rethrows any exception from the read-ahead
+    }
+}
+
 namespace {
 
 class Matcher {
@@ -207,8 +356,6 @@ private:
     std::unique_ptr<SelectContext> _selectCxt;
 };
 
-using LidIndexMap = vespalib::hash_map<uint32_t, uint32_t>;
-
 class MatchVisitor : public search::IDocumentVisitor
 {
 public:
@@ -251,26 +398,40 @@ private:
 
 }
 
-void
-DocumentIterator::fetchCompleteSource(const DocTypeName & doc_type_name,
-                                      const IDocumentRetriever & source,
-                                      IterateResult::List & list)
+DocumentIterator::PendingSource::PendingSource(const IDocumentRetriever & retriever_in,
+                                               IDocumentRetriever::ReadGuard readGuard_in)
+    : retriever(retriever_in),
+      readGuard(std::move(readGuard_in)),
+      metaData(),
+      matcher(),
+      lidIndexMap(),
+      lidsToFetch(),
+      nextLid(0)
 {
-    IDocumentRetriever::ReadGuard sourceReadGuard(source.getReadGuard());
-    search::DocumentMetaData::Vector metaData;
+}
+
+DocumentIterator::PendingSource::~PendingSource() = default;
+
+std::unique_ptr<DocumentIterator::PendingSource>
+DocumentIterator::resolveSource(const IDocumentRetriever & source) const
+{
+    auto pending = std::make_unique<PendingSource>(source, source.getReadGuard());
+    search::DocumentMetaData::Vector & metaData = pending->metaData;
     source.getBucketMetaData(_bucket, metaData);
     if (metaData.empty()) {
-        return;
+        return {};
     }
     LOG(debug, "metadata count before filtering: %zu", metaData.size());
 
-    Matcher matcher(source, _metaOnly, _selection.getDocumentSelection().getDocumentSelection());
+    pending->matcher = std::make_unique<Matcher>(source, _metaOnly, _selection.getDocumentSelection().getDocumentSelection());
+    const Matcher & matcher = *pending->matcher;
     if (matcher.willAlwaysFail()) {
-        return;
+        return {};
     }
 
-    LidIndexMap lidIndexMap(3*metaData.size());
-    IDocumentRetriever::LidVector lidsToFetch;
+    LidIndexMap & lidIndexMap = pending->lidIndexMap;
+    lidIndexMap.resize(3*metaData.size());
+    IDocumentRetriever::LidVector & lidsToFetch = pending->lidsToFetch;
     lidsToFetch.reserve(metaData.size());
     for (size_t i(0); i < metaData.size(); i++) {
         const search::DocumentMetaData & meta = metaData[i];
@@ -282,20 +443,38 @@ DocumentIterator::fetchCompleteSource(const DocTypeName & doc_type_name,
         }
     }
     LOG(debug, "metadata count after filtering: %zu", lidsToFetch.size());
+    return pending;
+}
 
+void
+DocumentIterator::fetchCompleteSource(const DocTypeName & doc_type_name,
+                                      const IDocumentRetriever & source,
+                                      IterateResult::List & list)
+{
+    auto pending = resolveSource(source);
+    if ( ! pending) {
+        return;
+    }
+    const IDocumentRetriever::LidVector & lidsToFetch = pending->lidsToFetch;
     list.reserve(lidsToFetch.size());
     if ( _metaOnly ) {
         for (uint32_t lid : lidsToFetch) {
-            const search::DocumentMetaData & meta = metaData[lidIndexMap[lid]];
+            const search::DocumentMetaData & meta = pending->metaData[pending->lidIndexMap[lid]];
             assert(lid == meta.lid);
             list.push_back(createDocEntry(storage::spi::Timestamp(meta.timestamp), meta.removed, doc_type_name.getName(), meta.gid));
         }
     } else {
-        MatchVisitor visitor(matcher, metaData, lidIndexMap, _fields.get(), list, _defaultSerializedSize);
-        visitor.allowVisitCaching(isWeakRead());
-        source.visitDocuments(lidsToFetch, visitor, _readConsistency);
+        fetchLids(*pending, lidsToFetch, list);
     }
+}
 
+void
+DocumentIterator::fetchLids(const PendingSource & source, const IDocumentRetriever::LidVector & lids,
+                            IterateResult::List & list) const
+{
+    MatchVisitor visitor(*source.matcher, source.metaData, source.lidIndexMap, _fields.get(), list, _defaultSerializedSize);
+    visitor.allowVisitCaching(isWeakRead());
+    source.retriever.visitDocuments(lids, visitor, _readConsistency);
 }
 
 }
@@ -10,6 +10,9 @@
 #include <vespa/persistence/spi/result.h>
 #include <vespa/persistence/spi/read_consistency.h>
 #include <vespa/document/fieldset/fieldset.h>
+#include <future>
+
+namespace vespalib { class Executor; }
 
 namespace proton {
 
@@ -20,6 +23,8 @@ class DocumentIterator
 private:
     using ReadConsistency = storage::spi::ReadConsistency;
     using DocTypeNameAndRetriever = std::pair<DocTypeName, IDocumentRetriever::SP>;
+    class PendingSource;
+    using PendingSources = std::vector<std::unique_ptr<PendingSource>>;
 
     const storage::spi::Bucket            _bucket;;
     const storage::spi::Selection         _selection;
@@ -33,13 +38,27 @@ private:
     std::vector<DocTypeNameAndRetriever>  _sources;
     size_t                                _nextItem;
     storage::spi::IterateResult::List     _list;
-
+    size_t                                _readAheadBytes;
+    vespalib::Executor                   *_readAheadExecutor;
+    PendingSources                        _pendingSources;
+    size_t                                _bufferedBytes;
+    size_t                                _fetchedLids;
+    size_t                                _fetchedBytes;
+    std::future<void>                     _readAhead;
 
     [[nodiscard]] bool checkMeta(const search::DocumentMetaData &meta) const;
+    std::unique_ptr<PendingSource> resolveSource(const IDocumentRetriever & source) const;
     void fetchCompleteSource(const DocTypeName & doc_type_name,
                              const IDocumentRetriever & source,
                              storage::spi::IterateResult::List & list);
+    void fetchLids(const PendingSource & source, const IDocumentRetriever::LidVector & lids,
+                   storage::spi::IterateResult::List & list) const;
+    void fetchUntilBuffered(size_t bytes);
+    void startReadAhead();
+    void waitForReadAhead();
+    storage::spi::IterateResult iterateWithReadAhead(size_t maxBytes);
     [[nodiscard]] bool isWeakRead() const { return _readConsistency == ReadConsistency::WEAK; }
+    [[nodiscard]] bool readAheadEnabled() const noexcept { return _readAheadBytes > 0; }
 
 public:
     DocumentIterator(const storage::spi::Bucket &bucket, document::FieldSet::SP fields,
@@ -49,6 +68,16 @@ public:
     ~DocumentIterator();
     void add(const DocTypeName & doc_type_name, IDocumentRetriever::SP retriever);
     void add(IDocumentRetriever::SP retriever);
+    /**
+     * Enables incremental fetching of documents. Instead of reading all matching documents
+     * on the first call to iterate(), documents are read in docstore order as they are needed,
+     * and up to maxBytes of documents are read ahead of the caller. If an executor is given,
+     * the read-ahead happens there while the previous batch is being processed by the caller.
+     * The read guards of the sources are kept until all their documents have been read.
+     * Has no effect for meta data only iteration or when max bytes are ignored.
+     * Must be called before the first call to iterate().
+     */
+    void setReadAhead(size_t maxBytes, vespalib::Executor * executor);
     storage::spi::IterateResult iterate(size_t maxBytes);
 };
 
@@ -52,6 +52,12 @@ public:
      * @param Visitor to receive callback for each document found.
      */
     virtual void visitDocuments(const LidVector &lids, search::IDocumentVisitor &visitor, ReadConsistency readConsistency) const = 0;
+    /**
+     * Reorders the given lids so that visiting them in slices, one slice at a time,
+     * reads the underlying document store as sequentially as possible.
+     * The default is to leave the order untouched.
+     */
+    virtual void sortInReadOrder(LidVector &lids) const { (void) lids; }
 
     virtual CachedSelect::SP parseSelect(const std::string &selection) const = 0;
 
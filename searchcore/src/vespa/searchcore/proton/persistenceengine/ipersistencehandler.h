@@ -4,6 +4,7 @@
 #include "i_document_retriever.h"
 #include "resulthandler.h"
 #include <vespa/searchcore/proton/common/feedtoken.h>
+#include <vespa/persistence/spi/batched_feed_operation.h>
 
 namespace document {
     class Document;
@@ -30,6 +31,8 @@ public:
     using SP = std::shared_ptr<IPersistenceHandler>;
     // Note that you can not move away the handlers in the vector.
     using RetrieversSP = std::shared_ptr<std::vector<IDocumentRetriever::SP> >;
+    // Puts and removes towards one bucket; the completion callbacks have been moved into the feed tokens.
+    using FeedBatch = std::vector<std::pair<FeedToken, storage::spi::BatchedFeedOperation>>;
     IPersistenceHandler(const IPersistenceHandler &) = delete;
     IPersistenceHandler & operator = (const IPersistenceHandler &) = delete;
 
@@ -49,6 +52,20 @@ public:
 
     virtual void handleRemove(FeedToken token, const storage::spi::Bucket &bucket,
                               storage::spi::Timestamp timestamp, const document::DocumentId &id) = 0;
+
+    /**
+     * Handle a batch of puts and removes towards the same bucket, in order.
+     * The default implementation handles each operation separately.
+     */
+    virtual void handleFeedBatch(const storage::spi::Bucket &bucket, FeedBatch batch) {
+        for (auto &entry : batch) {
+            if (entry.second.is_put()) {
+                handlePut(std::move(entry.first), bucket, entry.second.timestamp(), entry.second.document());
+            } else {
+                handleRemove(std::move(entry.first), bucket, entry.second.timestamp(), entry.second.document_id());
+            }
+        }
+    }
     virtual void handleRemoveByGid(FeedToken token, const storage::spi::Bucket &bucket,
                                    storage::spi::Timestamp timestamp,
                                    std::string_view doc_type, const document::GlobalId& gid) = 0;
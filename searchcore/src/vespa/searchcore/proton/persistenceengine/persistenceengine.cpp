@@ -11,6 +11,10 @@
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/document/util/feed_reject_helper.h>
 #include <vespa/document/base/exceptions.h>
+#include <vespa/vespalib/util/cpu_usage.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
+#include <optional>
 #include <thread>
 
 #include <vespa/log/log.h>
@@ -38,6 +42,8 @@ namespace proton {
 
 namespace {
 
+VESPA_THREAD_STACK_TAG(proton_visit_read_ahead_executor)
+
 class ResultHandlerBase {
 private:
     virtual Result::UP createResult() const = 0;
@@ -221,6 +227,8 @@ PersistenceEngine::PersistenceEngine(IPersistenceEngineOwner &owner, const IReso
     : AbstractPersistenceProvider(),
       _defaultSerializedSize(defaultSerializedSize),
       _ignoreMaxBytes(ignoreMaxBytes),
+      _visitReadAheadBytes(0),
+      _visitReadAheadExecutor(),
       _handlers(),
       _lock(),
       _iterators(),
@@ -240,6 +248,20 @@ PersistenceEngine::~PersistenceEngine()
     destroyIterators();
 }
 
+void
+PersistenceEngine::configure_visit_read_ahead(size_t max_bytes, uint32_t num_threads)
+{
+    std::lock_guard<std::mutex> guard(_iterators_lock);
+    assert(_iterators.empty());
+    _visitReadAheadBytes = max_bytes;
+    if ((max_bytes > 0) && (num_threads > 0)) {
+        _visitReadAheadExecutor = std::make_unique<vespalib::ThreadStackExecutor>(
+                num_threads, vespalib::CpuUsage::wrap(proton_visit_read_ahead_executor, vespalib::CpuUsage::Category::READ));
+    } else {
+        _visitReadAheadExecutor.reset();
+    }
+}
+
 
 IPersistenceHandler::SP
 PersistenceEngine::putHandler(const WriteGuard &, document::BucketSpace bucketSpace, const DocTypeName &docType,const IPersistenceHandler::SP &handler)
@@ -432,6 +454,58 @@ PersistenceEngine::removeAsyncSingle(const Bucket& b, Timestamp t, const Documen
     handler->handleRemove(feedtoken::make(std::move(transportContext)), b, t, id);
 }
 
+void
+PersistenceEngine::feedBatchAsync(const Bucket& b, std::vector<storage::spi::BatchedFeedOperation> ops)
+{
+    std::optional<IResourceWriteFilter::State> put_reject_state;
+    if (!_writeFilter.acceptWriteOperation()) {
+        IResourceWriteFilter::State state = _writeFilter.getAcceptState();
+        if (!state.acceptWriteOperation()) {
+            put_reject_state = std::move(state);
+        }
+    }
+    ReadGuard rguard(_rwMutex);
+    LOG(spam, "feedBatch(%s, %zu operations)", b.toString().c_str(), ops.size());
+    // Operations for different document types are forwarded to their handlers in separate batches
+    std::vector<std::pair<IPersistenceHandler *, IPersistenceHandler::FeedBatch>> batches;
+    for (auto & op : ops) {
+        const DocumentId & id = op.is_put() ? op.document()->getId() : op.document_id();
+        auto make_error = [&op](Result::ErrorType type, const std::string & msg) -> std::unique_ptr<Result> {
+            if (op.is_put()) {
+                return std::make_unique<Result>(type, msg);
+            }
+            return std::make_unique<RemoveResult>(type, msg);
+        };
+        if (op.is_put() && put_reject_state) {
+            op.steal_on_complete()->onComplete(make_error(Result::ErrorType::RESOURCE_EXHAUSTED,
+                    fmt("Put operation rejected for document '%s': '%s'", id.toString().c_str(), put_reject_state->message().c_str())));
+            continue;
+        }
+        if (!id.hasDocType()) {
+            op.steal_on_complete()->onComplete(make_error(Result::ErrorType::PERMANENT_ERROR,
+                    fmt("Old id scheme not supported in elastic mode (%s)", id.toString().c_str())));
+            continue;
+        }
+        DocTypeName docType(id.getDocType());
+        IPersistenceHandler * handler = getHandler(rguard, b.getBucketSpace(), docType);
+        if (!handler) {
+            op.steal_on_complete()->onComplete(make_error(Result::ErrorType::PERMANENT_ERROR,
+                    fmt("No handler for document type '%s'", docType.toString().c_str())));
+            continue;
+        }
+        auto itr = std::find_if(batches.begin(), batches.end(), [handler](const auto & batch) { return batch.first == handler; });
+        if (itr == batches.end()) {
+            itr = batches.emplace(batches.end(), handler, IPersistenceHandler::FeedBatch());
+            itr->second.reserve(ops.size());
+        }
+        auto transportContext = std::make_shared<AsyncTransportContext>(1, op.steal_on_complete());
+        itr->second.emplace_back(feedtoken::make(std::move(transportContext)), std::move(op));
+    }
+    for (auto & batch : batches) {
+        batch.first->handleFeedBatch(b, std::move(batch.second));
+    }
+}
+
 void
 PersistenceEngine::removeByGidAsync(const Bucket& b, std::vector<storage::spi::DocTypeGidAndTimestamp> ids, std::unique_ptr<OperationComplete> onComplete)
 {
@@ -543,6 +617,9 @@ PersistenceEngine::createIterator(const Bucket &bucket, FieldSetSP fields, const
 
     auto entry = std::make_unique<IteratorEntry>(context.getReadConsistency(), bucket, std::move(fields), selection,
                                                  versions, _defaultSerializedSize, _ignoreMaxBytes);
+    if (_visitReadAheadBytes > 0) {
+        entry->it.setReadAhead(_visitReadAheadBytes, _visitReadAheadExecutor.get());
+    }
     for (; snap.handlers().valid(); snap.handlers().next()) {
         auto *handler = snap.handlers().get();
         IPersistenceHandler::RetrieversSP retrievers = handler->getDocumentRetrievers(context.getReadConsistency());
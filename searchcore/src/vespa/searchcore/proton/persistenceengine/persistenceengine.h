@@ -11,6 +11,8 @@
 #include <mutex>
 #include <shared_mutex>
 
+namespace vespalib { class ThreadStackExecutor; }
+
 namespace proton {
 
 class IPersistenceEngineOwner;
@@ -65,6 +67,8 @@ private:
 
     const ssize_t                           _defaultSerializedSize;
     const bool                              _ignoreMaxBytes;
+    size_t                                  _visitReadAheadBytes;
+    std::unique_ptr<vespalib::ThreadStackExecutor> _visitReadAheadExecutor;
     PersistenceHandlerMap                   _handlers;
     mutable std::mutex                      _lock;
     Iterators                               _iterators;
@@ -98,6 +102,12 @@ public:
                       ssize_t defaultSerializedSize, bool ignoreMaxBytes);
     ~PersistenceEngine() override;
 
+    /**
+     * Lets visitor iterators read up to max_bytes of documents ahead of the visitor,
+     * using num_threads background threads. Must be called before any iterators are created.
+     */
+    void configure_visit_read_ahead(size_t max_bytes, uint32_t num_threads);
+
     IPersistenceHandler::SP putHandler(const WriteGuard &, document::BucketSpace bucketSpace, const DocTypeName &docType, const IPersistenceHandler::SP &handler);
     IPersistenceHandler::SP removeHandler(const WriteGuard &, document::BucketSpace bucketSpace, const DocTypeName &docType);
 
@@ -110,6 +120,7 @@ public:
     void putAsync(const Bucket &, Timestamp, storage::spi::DocumentSP, OperationComplete::UP) override;
     void removeAsync(const Bucket&, std::vector<storage::spi::IdAndTimestamp> ids, OperationComplete::UP) override;
     void removeByGidAsync(const Bucket&, std::vector<storage::spi::DocTypeGidAndTimestamp> ids, std::unique_ptr<OperationComplete>) override;
+    void feedBatchAsync(const Bucket&, std::vector<storage::spi::BatchedFeedOperation> ops) override;
     void updateAsync(const Bucket&, Timestamp, storage::spi::DocumentUpdateSP, OperationComplete::UP) override;
     GetResult get(const Bucket&, const document::FieldSet&, const document::DocumentId&, Context&) const override;
     CreateIteratorResult
@@ -16,13 +16,25 @@ ReprocessDocumentsTask(IReprocessingInitializer &initializer,
                        const std::shared_ptr<const document::DocumentTypeRepo> &docTypeRepo,
                        const std::string &subDbName,
                        uint32_t docIdLimit)
+    : ReprocessDocumentsTask(initializer, sm, docTypeRepo, subDbName, docIdLimit, nullptr)
+{
+}
+
+ReprocessDocumentsTask::
+ReprocessDocumentsTask(IReprocessingInitializer &initializer,
+                       const proton::ISummaryManager::SP &sm,
+                       const std::shared_ptr<const document::DocumentTypeRepo> &docTypeRepo,
+                       const std::string &subDbName,
+                       uint32_t docIdLimit,
+                       vespalib::Executor *executor)
     : _sm(sm),
       _docTypeRepo(docTypeRepo),
       _subDbName(subDbName),
       _visitorProgress(0.0),
       _visitorCost(0.0),
       _handler(docIdLimit),
-      _loggedProgress(0.0)
+      _loggedProgress(0.0),
+      _executor(executor)
 {
     initializer.initialize(_handler);
     if (_handler.hasProcessors()) {
@@ -39,7 +51,10 @@ ReprocessDocumentsTask::run()
         _start = clock::now();
         search::IDocumentStore &docstore = _sm->getBackingStore();
         if (_handler.hasRewriters()) {
+            // Rewritten documents must be written before the document store prunes the chunk they were read from
             docstore.accept(_handler.getRewriteVisitor(), *this, *_docTypeRepo);
+        } else if (_executor != nullptr) {
+            docstore.accept_parallel(_handler, *this, *_docTypeRepo, *_executor, BATCH_SIZE, MAX_PENDING_BATCHES);
         } else {
             docstore.accept(_handler, *this, *_docTypeRepo);
         }
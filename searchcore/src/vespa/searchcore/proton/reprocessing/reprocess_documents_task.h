@@ -8,6 +8,8 @@
 #include "document_reprocessing_handler.h"
 #include "i_reprocessing_initializer.h"
 
+namespace vespalib { class Executor; }
+
 namespace proton
 {
 
@@ -16,11 +18,18 @@ namespace proton
  * e.g. populate attributes from document store when adding attribute
  * aspect on existing field and populating documents in document store
  * when removing attribute aspect on existing field.
+ *
+ * When only reading (populating attributes), documents are deserialized
+ * in parallel on the shared executor while the document store is read
+ * chunk by chunk. The number of batches in flight is bounded to limit
+ * both memory usage and the share of the shared executor taken.
  */
 class ReprocessDocumentsTask : public IReprocessingTask,
                                public search::IDocumentStoreVisitorProgress
 {
     using clock = std::chrono::steady_clock;
+    static constexpr uint32_t BATCH_SIZE = 256;
+    static constexpr uint32_t MAX_PENDING_BATCHES = 16;
     proton::ISummaryManager::SP          _sm;
     std::shared_ptr<const document::DocumentTypeRepo>       _docTypeRepo;
     std::string                     _subDbName;
@@ -30,6 +39,7 @@ class ReprocessDocumentsTask : public IReprocessingTask,
     clock::time_point                    _start;
     clock::time_point                    _lastLogTime;
     double                               _loggedProgress;
+    vespalib::Executor                  *_executor;
 
 public:
     ReprocessDocumentsTask(IReprocessingInitializer &initializer,
@@ -37,6 +47,13 @@ public:
                            const std::shared_ptr<const document::DocumentTypeRepo> &docTypeRepo,
                            const std::string &subDbName,
                            uint32_t docIdLimit);
+    // Deserialize documents in parallel on the given executor when possible
+    ReprocessDocumentsTask(IReprocessingInitializer &initializer,
+                           const proton::ISummaryManager::SP &sm,
+                           const std::shared_ptr<const document::DocumentTypeRepo> &docTypeRepo,
+                           const std::string &subDbName,
+                           uint32_t docIdLimit,
+                           vespalib::Executor *executor);
 
     void run() override;
     void updateProgress(double progress) override;
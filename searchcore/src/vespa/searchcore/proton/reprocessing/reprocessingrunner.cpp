@@ -9,7 +9,8 @@ namespace proton {
 ReprocessingRunner::ReprocessingRunner()
     : _lock(),
       _tasks(),
-      _state(NOT_STARTED)
+      _state(NOT_STARTED),
+      _start()
 {
 }
 
@@ -30,6 +31,7 @@ ReprocessingRunner::run()
     {
         std::lock_guard<std::mutex> guard(_lock);
         _state = RUNNING;
+        _start = vespalib::steady_clock::now();
     }
     for (auto &task : _tasks) {
         task->run();
@@ -62,6 +64,13 @@ double
 ReprocessingRunner::getProgress() const
 {
     std::lock_guard<std::mutex> guard(_lock);
+    return progress();
+}
+
+
+double
+ReprocessingRunner::progress() const
+{
     switch (_state) {
     case State::NOT_STARTED:
         return 0.0;
@@ -82,4 +91,35 @@ ReprocessingRunner::getProgress() const
     return weightedProgress / weight;
 }
 
+
+bool
+ReprocessingRunner::is_running() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _state == RUNNING;
+}
+
+
+vespalib::duration
+ReprocessingRunner::elapsed(vespalib::steady_time now) const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return (_state == RUNNING) ? (now - _start) : vespalib::duration::zero();
+}
+
+
+vespalib::duration
+ReprocessingRunner::estimated_time_left(vespalib::steady_time now) const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_state != RUNNING) {
+        return vespalib::duration::zero();
+    }
+    double done = progress();
+    if (done <= 0.0) {
+        return vespalib::duration::zero();
+    }
+    return vespalib::from_s(vespalib::to_s(now - _start) * (1.0 - done) / done);
+}
+
 } // namespace proton
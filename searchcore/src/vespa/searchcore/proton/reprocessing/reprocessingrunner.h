@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/time.h>
 #include <mutex>
 #include <memory>
 #include <vector>
@@ -27,6 +28,9 @@ private:
         DONE
     };
     State _state;
+    vespalib::steady_time _start; // Protected by _lock
+
+    double progress() const;
 public:
     ReprocessingRunner();
 
@@ -35,6 +39,10 @@ public:
     void reset();
     bool empty() const;
     double getProgress() const;
+    bool is_running() const;
+    vespalib::duration elapsed(vespalib::steady_time now) const;
+    // Estimated time left, extrapolated from progress so far. Zero until some progress is made.
+    vespalib::duration estimated_time_left(vespalib::steady_time now) const;
 };
 
 } // namespace proton
@@ -8,8 +8,9 @@
 #include <vespa/config-bucketspaces.h>
 #include <vespa/searchlib/common/tunefileinfo.hpp>
 #include <vespa/config/retriever/configsnapshot.hpp>
-#include <filesystem>
+#include <algorithm>
 #include <cassert>
+#include <filesystem>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.bootstrapconfigmanager");
@@ -26,6 +27,18 @@ using BucketspacesConfigSP = std::shared_ptr<BucketspacesConfig>;
 
 namespace proton {
 
+namespace {
+
+uint64_t
+deriveMemoryMapMaxFileSize(int64_t maxFileSize, const vespalib::HwInfo & hwInfo)
+{
+    return (maxFileSize < 0)
+           ? (hwInfo.memory().sizeBytes() * std::min(INT64_C(100), -maxFileSize)) / 100l
+           : maxFileSize;
+}
+
+}
+
 BootstrapConfigManager::BootstrapConfigManager(const std::string & configId)
     : _pendingConfigSnapshot(),
       _configId(configId),
@@ -64,6 +77,7 @@ BootstrapConfigManager::update(const ConfigSnapshot & snapshot)
     std::shared_ptr<const DocumentTypeRepo> newRepo;
     BucketspacesConfigSP newBucketspacesConfig;
     int64_t currentGen = -1;
+    bool protonConfigChanged = false;
 
     BootstrapConfig::SP current = _pendingConfigSnapshot;
     if (current) {
@@ -87,12 +101,15 @@ BootstrapConfigManager::update(const ConfigSnapshot & snapshot)
         tune._attr._write.setFromConfig<ProtonConfig::Attribute::Write>(conf.attribute.write.io);
         tune._index._search._read.setFromConfig<ProtonConfig::Search, ProtonConfig::Search::Mmap>(conf.search.io, conf.search.mmap);
         tune._index._search.set_force_memory_map_posting_list(conf.index.cache.postinglist.maxbytes == -1);
+        tune._index._search.set_dictionary_lookup_cache_max_bytes(std::max(int64_t(0), conf.index.cache.dictionary.maxbytes));
+        tune._index._search.set_bitvector_direct_io_min_bytes(std::max(int64_t(0), conf.index.cache.bitvector.directio_min_bytes));
         tune._summary._write.setFromConfig<ProtonConfig::Summary::Write>(conf.summary.write.io);
         tune._summary._seqRead.setFromConfig<ProtonConfig::Summary::Read>(conf.summary.read.io);
         tune._summary._randRead.setFromConfig<ProtonConfig::Summary::Read, ProtonConfig::Summary::Read::Mmap>(conf.summary.read.io, conf.summary.read.mmap);
 
         newProtonConfig = ProtonConfigSP(protonConfig.release());
         newTuneFileDocumentDB = tuneFileDocumentDB;
+        protonConfigChanged = true;
     }
 
     if (snapshot.isChanged<FiledistributorrpcConfig>(_configId, currentGen)) {
@@ -124,6 +141,10 @@ BootstrapConfigManager::update(const ConfigSnapshot & snapshot)
                                      hwDiskCfg.samplewritesize, hwDiskCfg.shared, hwMemoryCfg.size, hwCpuCfg.cores);
     std::filesystem::create_directories(std::filesystem::path(protonConfig.basedir));
     HwInfoSampler sampler(protonConfig.basedir, samplerCfg);
+    if (protonConfigChanged) {
+        newTuneFileDocumentDB->_summary._randRead.setMemoryMapMaxFileSize(
+                deriveMemoryMapMaxFileSize(protonConfig.summary.read.mmap.maxfilesize, sampler.hwInfo()));
+    }
 
     auto newSnapshot(std::make_shared<BootstrapConfig>(snapshot.getGeneration(), newDocumenttypesConfig, newRepo,
                                                        newProtonConfig, newFiledistRpcConfSP, newBucketspacesConfig,
@@ -67,6 +67,7 @@ BucketMoveJob::BucketMoveJob(std::shared_ptr<IBucketStateCalculator> calc,
                              IBucketStateChangedNotifier &bucketStateChangedNotifier,
                              IResourceUsageNotifier &resource_usage_notifier,
                              const BlockableMaintenanceJobConfig &blockableConfig,
+                             const BucketMoveConfig &bucketMoveConfig,
                              const std::string &docTypeName,
                              document::BucketSpace bucketSpace)
     : BlockableMaintenanceJob("move_buckets." + docTypeName, vespalib::duration::zero(), vespalib::duration::zero(), blockableConfig),
@@ -84,6 +85,7 @@ BucketMoveJob::BucketMoveJob(std::shared_ptr<IBucketStateCalculator> calc,
       _ready(ready),
       _notReady(notReady),
       _bucketSpace(bucketSpace),
+      _maxDocsToMovePerBucket(std::max(1u, bucketMoveConfig.getMaxDocsToMovePerBucket())),
       _iterateCount(0),
       _movers(),
       _bucketsInFlight(),
@@ -128,12 +130,13 @@ BucketMoveJob::create(std::shared_ptr<IBucketStateCalculator> calc,
                       IBucketStateChangedNotifier &bucketStateChangedNotifier,
                       IResourceUsageNotifier &resource_usage_notifier,
                       const BlockableMaintenanceJobConfig &blockableConfig,
+                      const BucketMoveConfig &bucketMoveConfig,
                       const std::string &docTypeName,
                       document::BucketSpace bucketSpace)
 {
     return {new BucketMoveJob(std::move(calc), std::move(dbRetainer), moveHandler, modifiedHandler, master, bucketExecutor, ready, notReady,
                               bucketCreateNotifier, clusterStateChangedNotifier, bucketStateChangedNotifier,
-                              resource_usage_notifier, blockableConfig, docTypeName, bucketSpace),
+                              resource_usage_notifier, blockableConfig, bucketMoveConfig, docTypeName, bucketSpace),
             [&master](auto job) {
                 auto failed = master.execute(makeLambdaTask([job]() { delete job; }));
                 assert(!failed);
@@ -389,7 +392,7 @@ BucketMoveJob::run()
     }
     /// Returning false here will immediately post the job back on the executor. This will give a busy loop,
     /// but this is considered fine as it is very rare and it will be intermingled with multiple feed operations.
-    if ( ! scanAndMove(1, 1) ) {
+    if ( ! scanAndMove(1, _maxDocsToMovePerBucket) ) {
         return false;
     }
 
@@ -19,6 +19,7 @@ namespace searchcorespi::index { struct IThreadService; }
 namespace proton {
 
 class BlockableMaintenanceJobConfig;
+class BucketMoveConfig;
 class IBucketStateChangedNotifier;
 class IClusterStateChangedNotifier;
 class IResourceUsageNotifier;
@@ -66,6 +67,7 @@ private:
     const MaintenanceDocumentSubDB            _ready;
     const MaintenanceDocumentSubDB            _notReady;
     const document::BucketSpace               _bucketSpace;
+    const uint32_t                            _maxDocsToMovePerBucket;
     size_t                                    _iterateCount;
     Movers                                    _movers;
     Bucket2Mover                              _bucketsInFlight;
@@ -102,6 +104,7 @@ private:
                   IBucketStateChangedNotifier &bucketStateChangedNotifier,
                   IResourceUsageNotifier &resource_usage_notifier,
                   const BlockableMaintenanceJobConfig &blockableConfig,
+                  const BucketMoveConfig &bucketMoveConfig,
                   const std::string &docTypeName,
                   document::BucketSpace bucketSpace);
 
@@ -137,6 +140,7 @@ public:
            IBucketStateChangedNotifier &bucketStateChangedNotifier,
            IResourceUsageNotifier &resource_usage_notifier,
            const BlockableMaintenanceJobConfig &blockableConfig,
+           const BucketMoveConfig &bucketMoveConfig,
            const std::string &docTypeName,
            document::BucketSpace bucketSpace);
 
@@ -31,6 +31,24 @@ DocumentDBExplorer::get_state(const Inserter &inserter, bool full) const
     {
         StateReporterUtils::convertToSlime(*_docDb->reportStatus(), ObjectInserter(object, "status"));
     }
+    const FeedHandler &feedHandler = _docDb->getFeedHandler();
+    const TlsReplayProgress *replayProgress = feedHandler.get_replay_progress();
+    if ((replayProgress != nullptr) && feedHandler.isDoingReplay()) {
+        Cursor &replay = object.setObject("replay");
+        replay.setLong("first", replayProgress->getFirst());
+        replay.setLong("last", replayProgress->getLast());
+        replay.setLong("current", replayProgress->getCurrent());
+        replay.setDouble("progress", replayProgress->getProgress());
+        replay.setDouble("operations_per_second", replayProgress->getOperationsPerSecond(vespalib::steady_clock::now()));
+    }
+    const ReprocessingRunner &reprocessingRunner = _docDb->getDocumentSubDBs().getReprocessingRunner();
+    if (reprocessingRunner.is_running()) {
+        auto now = vespalib::steady_clock::now();
+        Cursor &reprocessing = object.setObject("reprocessing");
+        reprocessing.setDouble("progress", reprocessingRunner.getProgress());
+        reprocessing.setDouble("elapsed_seconds", vespalib::to_s(reprocessingRunner.elapsed(now)));
+        reprocessing.setDouble("eta_seconds", vespalib::to_s(reprocessingRunner.estimated_time_left(now)));
+    }
     {
         DocumentMetaStoreReadGuards dmss(_docDb->getDocumentSubDBs());
         Cursor &documents = object.setObject("documents");
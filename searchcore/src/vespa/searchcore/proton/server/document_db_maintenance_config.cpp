@@ -50,6 +50,7 @@ DocumentDBLidSpaceCompactionConfig::DocumentDBLidSpaceCompactionConfig() noexcep
       _allowedLidBloatFactor(1.0),
       _remove_batch_block_rate(0.5),
       _remove_block_rate(100),
+      _max_moves_per_second(0.0),
       _disabled(false)
 {
 }
@@ -59,13 +60,15 @@ DocumentDBLidSpaceCompactionConfig::DocumentDBLidSpaceCompactionConfig(vespalib:
                                                                        double allowedLidBloatFactor,
                                                                        double remove_batch_block_rate,
                                                                        double remove_block_rate,
-                                                                       bool disabled) noexcept
+                                                                       bool disabled,
+                                                                       double max_moves_per_second) noexcept
     : _delay(std::min(MAX_DELAY_SEC, interval)),
       _interval(interval),
       _allowedLidBloat(allowedLidBloat),
       _allowedLidBloatFactor(allowedLidBloatFactor),
       _remove_batch_block_rate(remove_batch_block_rate),
       _remove_block_rate(remove_block_rate),
+      _max_moves_per_second(max_moves_per_second),
       _disabled(disabled)
 {
 }
@@ -85,6 +88,7 @@ DocumentDBLidSpaceCompactionConfig::operator==(const DocumentDBLidSpaceCompactio
            _interval == rhs._interval &&
            _allowedLidBloat == rhs._allowedLidBloat &&
            _allowedLidBloatFactor == rhs._allowedLidBloatFactor &&
+           _max_moves_per_second == rhs._max_moves_per_second &&
            _disabled == rhs._disabled;
 }
 
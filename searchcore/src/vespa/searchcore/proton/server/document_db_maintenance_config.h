@@ -50,6 +50,7 @@ private:
     double               _allowedLidBloatFactor;
     double               _remove_batch_block_rate;
     double               _remove_block_rate;
+    double               _max_moves_per_second;
     bool                 _disabled;
 
 public:
@@ -59,7 +60,8 @@ public:
                                        double allowwedLidBloatFactor,
                                        double remove_batch_block_rate,
                                        double remove_block_rate,
-                                       bool disabled) noexcept;
+                                       bool disabled,
+                                       double max_moves_per_second = 0.0) noexcept;
 
     static DocumentDBLidSpaceCompactionConfig createDisabled() noexcept;
     bool operator==(const DocumentDBLidSpaceCompactionConfig &rhs) const noexcept;
@@ -69,6 +71,8 @@ public:
     double getAllowedLidBloatFactor() const noexcept { return _allowedLidBloatFactor; }
     double get_remove_batch_block_rate() const noexcept { return _remove_batch_block_rate; }
     double get_remove_block_rate() const noexcept { return _remove_block_rate; }
+    // 0 means that the rate of document moves is not limited
+    double get_max_moves_per_second() const noexcept { return _max_moves_per_second; }
     bool isDisabled() const noexcept { return _disabled; }
 };
 
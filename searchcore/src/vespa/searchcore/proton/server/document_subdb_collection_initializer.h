@@ -23,6 +23,7 @@ public:
         addDependency(subDbInitializer);
     }
     void run() override;
+    std::string get_name() const override { return "subdbs"; }
 };
 
 } // namespace proton
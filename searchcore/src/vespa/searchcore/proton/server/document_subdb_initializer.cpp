@@ -35,4 +35,10 @@ DocumentSubDbInitializer::run()
     future.wait();
 }
 
+std::string
+DocumentSubDbInitializer::get_name() const
+{
+    return "subdb " + _subDB.getName();
+}
+
 } // namespace proton
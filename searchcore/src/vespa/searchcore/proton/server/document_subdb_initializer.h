@@ -46,6 +46,7 @@ public:
     }
 
     void run() override;
+    std::string get_name() const override;
 };
 
 } // namespace proton
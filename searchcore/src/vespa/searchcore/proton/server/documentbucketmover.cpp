@@ -8,6 +8,7 @@
 #include <vespa/searchcore/proton/feedoperation/moveoperation.h>
 #include <vespa/searchcore/proton/bucketdb/bucket_db_owner.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/searchlib/docstore/idocumentstore.h>
 
 using document::BucketId;
 using document::Document;
@@ -18,15 +19,50 @@ namespace proton::bucketdb {
 
 using Iterator = IDocumentMetaStore::Iterator;
 
+namespace {
+
+class CollectDocuments : public search::IDocumentVisitor {
+    std::unordered_map<uint32_t, DocumentUP> &_docs;
+public:
+    explicit CollectDocuments(std::unordered_map<uint32_t, DocumentUP> &docs) noexcept : _docs(docs) {}
+    void visit(uint32_t lid, DocumentUP doc) override {
+        if (doc) {
+            _docs[lid] = std::move(doc);
+        }
+    }
+    bool allowVisitCaching() const override { return false; }
+};
+
+}
+
+/*
+ * All documents in a batch are read in one go, which lets the document
+ * store read them in chunk order instead of one random read per document.
+ */
+BucketMover::Documents
+BucketMover::fetchDocuments(const std::vector<MoveKey> &keys) const {
+    Documents docs;
+    IDocumentRetriever::LidVector lids;
+    lids.reserve(keys.size());
+    for (const MoveKey &key : keys) {
+        lids.push_back(key._lid);
+    }
+    CollectDocuments collector(docs);
+    _source->retriever()->visitDocuments(lids, collector, storage::spi::ReadConsistency::STRONG);
+    return docs;
+}
+
 MoveOperation::UP
-BucketMover::createMoveOperation(const MoveKey &key) {
+BucketMover::createMoveOperation(const MoveKey &key, Documents &docs) {
     if (_source->lidNeedsCommit(key._lid)) return {};
 
     const RawDocumentMetaData &metaNow = _source->meta_store()->getRawMetaData(key._lid);
     if (metaNow.getGid() != key._gid) return {};
     if (metaNow.getTimestamp() != key._timestamp) return {};
 
-    Document::SP doc(_source->retriever()->getFullDocument(key._lid));
+    auto found = docs.find(key._lid);
+    if (found == docs.end()) return {};
+    Document::SP doc(std::move(found->second));
     if (!doc || doc->getId().getGlobalId() != key._gid) {
         // Failed to retrieve document, removed or changed identity
         return {};
@@ -115,9 +151,10 @@ BucketMover::GuardedMoveOps
 BucketMover::createMoveOperations(MoveKeys toMove) {
     GuardedMoveOps moveOps(toMove.stealMover());
     moveOps.success().reserve(toMove.size());
+    auto docs = fetchDocuments(toMove.keys());
     for (MoveKey &key : toMove.keys()) {
         if (moveOps.failed().empty()) {
-            auto moveOp = createMoveOperation(key);
+            auto moveOp = createMoveOperation(key, docs);
             if (moveOp) {
                 moveOps.success().emplace_back(std::move(moveOp), std::move(key._guard));
             } else {
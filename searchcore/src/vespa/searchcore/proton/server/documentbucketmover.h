@@ -6,7 +6,9 @@
 #include <vespa/document/base/globalid.h>
 #include <vespa/persistence/spi/types.h>
 #include <atomic>
+#include <unordered_map>
 
+namespace document { class Document; }
 namespace vespalib { class IDestructorCallback; }
 
 namespace proton {
@@ -152,7 +154,9 @@ private:
     bool                            _allScheduled; // All moves started, or operation has been cancelled
     bool                            _lastGidValid;
     document::GlobalId              _lastGid;
-    MoveOperationUP createMoveOperation(const MoveKey & key);
+    using Documents = std::unordered_map<uint32_t, std::unique_ptr<document::Document>>;
+    Documents fetchDocuments(const std::vector<MoveKey> &keys) const;
+    MoveOperationUP createMoveOperation(const MoveKey & key, Documents &docs);
     size_t pending() const {
         return _started.load(std::memory_order_relaxed) - _completed.load(std::memory_order_relaxed);
     }
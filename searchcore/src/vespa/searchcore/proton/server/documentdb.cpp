@@ -24,6 +24,7 @@
 #include <vespa/searchcore/proton/docsummary/isummarymanager.h>
 #include <vespa/searchcore/proton/feedoperation/noopoperation.h>
 #include <vespa/searchcore/proton/index/index_writer.h>
+#include <vespa/searchcore/proton/initializer/critical_path.h>
 #include <vespa/searchcore/proton/initializer/task_runner.h>
 #include <vespa/searchcore/proton/metrics/executor_threading_service_stats.h>
 #include <vespa/searchcore/proton/metrics/metricswireservice.h>
@@ -57,6 +58,7 @@ using namespace search::fef;
 using namespace search::index;
 using namespace search::transactionlog;
 using searchcorespi::index::IThreadService;
+using searchcorespi::index::FusionPolicy;
 using searchcorespi::index::WarmupConfig;
 using search::TuneFileDocumentDB;
 using storage::spi::Timestamp;
@@ -74,7 +76,10 @@ namespace {
 
 index::IndexConfig
 makeIndexConfig(const ProtonConfig::Index & cfg) {
-    return {WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), size_t(cfg.maxflushed)};
+    return {WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack, uint32_t(cfg.warmup.termSampleSize)),
+            size_t(cfg.maxflushed),
+            FusionPolicy(cfg.fusion.sizeRatio, uint32_t(cfg.fusion.maxDiskIndexes)),
+            uint32_t(std::max(1, cfg.memory.invertFieldShards))};
 }
 
 class MetricsUpdateHook : public metrics::UpdateHook {
@@ -209,7 +214,7 @@ DocumentDB::DocumentDB(const std::string &baseDir,
       _subDBs(*this, *this, *_feedHandler, _docTypeName,
               _writeService, shared_service.shared(), fileHeaderContext, std::move(attribute_interlock),
               metricsWireService, getMetrics(), queryLimiter, shared_service.nowRef(),
-              _configMutex, _baseDir, hwInfo, posting_list_cache),
+              _configMutex, _baseDir, hwInfo, posting_list_cache, protonCfg.search.resultcache.maxbytes),
       _maintenanceController(shared_service.transport(), _writeService.master(), _refCount, _docTypeName),
       _jobTrackers(),
       _calc(),
@@ -281,15 +286,18 @@ DocumentDB::internalInit()
 class InitDoneTask : public vespalib::Executor::Task {
     DocumentDB::InitializeThreads _initializeThreads;
     std::shared_ptr<TaskRunner>   _taskRunner;
+    InitializerTask::SP           _rootTask;
     DocumentDBConfig::SP          _configSnapshot;
     DocumentDB&                   _self;
 public:
     InitDoneTask(DocumentDB::InitializeThreads initializeThreads,
                  std::shared_ptr<TaskRunner> taskRunner,
+                 InitializerTask::SP rootTask,
                  DocumentDBConfig::SP configSnapshot,
                  DocumentDB& self)
         : _initializeThreads(std::move(initializeThreads)),
           _taskRunner(std::move(taskRunner)),
+          _rootTask(std::move(rootTask)),
           _configSnapshot(std::move(configSnapshot)),
           _self(self)
     {}
@@ -297,6 +305,9 @@ public:
     ~InitDoneTask() override;
 
     void run() override {
+        LOG(info, "%s: Initialization critical path: %s",
+            _self.getName().c_str(), initializer::critical_path_to_string(*_rootTask).c_str());
+        _rootTask.reset();
         _self.initFinish(std::move(_configSnapshot));
     }
 };
@@ -313,7 +324,7 @@ DocumentDB::initManagers()
     InitializeThreads initializeThreads = _initializeThreads;
     _initializeThreads.reset();
     std::shared_ptr<TaskRunner> taskRunner(std::make_shared<TaskRunner>(*initializeThreads));
-    auto doneTask = std::make_unique<InitDoneTask>(std::move(initializeThreads), taskRunner,
+    auto doneTask = std::make_unique<InitDoneTask>(std::move(initializeThreads), taskRunner, rootTask,
                                                    std::move(configSnapshot), *this);
     taskRunner->runTask(rootTask, _writeService.master(), std::move(doneTask));
 }
@@ -467,6 +478,8 @@ DocumentDB::applyConfig(DocumentDBConfig::SP configSnapshot, SerialNum serialNum
     _writeService.set_task_limits(_writeServiceConfig.master_task_limit(),
                                   _writeServiceConfig.defaultTaskLimit(),
                                   _writeServiceConfig.defaultTaskLimit());
+    _feedHandler->set_commit_batching(_writeServiceConfig.commit_max_delay(),
+                                      _writeServiceConfig.commit_max_operations());
     if (params.shouldSubDbsChange()) {
         applySubDBConfig(*configSnapshot, serialNum, params, *prepared_reconfig);
         if (serialNum < _feedHandler->get_replay_end_serial_num()) {
@@ -729,7 +742,8 @@ DocumentDB::startTransactionLogReplay()
                                       oldestFlushedSerial,
                                       newestFlushedSerial,
                                       *_config_store,
-                                      _owner.shared_replay_throttler());
+                                      _owner.shared_replay_throttler(),
+                                      _writeServiceConfig.replay_decode_tasks());
     _initGate.countDown();
 
     LOG(debug, "DocumentDB(%s): Database started.", _docTypeName.toString().c_str());
@@ -761,10 +775,10 @@ DocumentDB::match(const SearchRequest &req, vespalib::ThreadBundle &threadBundle
 }
 
 std::unique_ptr<DocsumReply>
-DocumentDB::getDocsums(const DocsumRequest & request)
+DocumentDB::getDocsums(const DocsumRequest & request, vespalib::ThreadBundle &threadBundle)
 {
     ISearchHandler::SP view(_subDBs.getReadySubDB()->getSearchView());
-    return view->getDocsums(request);
+    return view->getDocsums(request, threadBundle);
 }
 
 IFlushTarget::List
@@ -370,7 +370,7 @@ public:
     match(const search::engine::SearchRequest &req, vespalib::ThreadBundle &threadBundle) const;
 
     std::unique_ptr<search::engine::DocsumReply>
-    getDocsums(const search::engine::DocsumRequest & request);
+    getDocsums(const search::engine::DocsumRequest & request, vespalib::ThreadBundle &threadBundle);
 
     IFlushTargetList getFlushTargets();
     void flushDone(SerialNum flushedSerial);
@@ -15,6 +15,7 @@
 #include <vespa/searchcore/proton/metrics/documentdb_job_trackers.h>
 #include <vespa/searchcore/proton/metrics/executor_threading_service_stats.h>
 #include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/searchlib/attribute/bitvector_search_cache.h>
 #include <vespa/searchlib/attribute/imported_attribute_vector.h>
 #include <vespa/vespalib/stllike/cache_stats.h>
 #include <vespa/searchlib/util/index_stats.h>
@@ -98,11 +99,13 @@ struct TempAttributeMetric
     MemoryUsage memoryUsage;
     uint64_t    bitVectors;
     uint64_t    size_on_disk;
+    CacheStats  bitvector_search_cache;
 
     TempAttributeMetric()
         : memoryUsage(),
           bitVectors(0),
-          size_on_disk(0)
+          size_on_disk(0),
+          bitvector_search_cache()
     {}
 };
 
@@ -127,15 +130,18 @@ isNotReadySubDB(const IDocumentSubDB *subDb, const DocumentSubDBCollection &subD
 
 void
 fillTempAttributeMetrics(TempAttributeMetrics &metrics, const std::string &attrName,
-                         const MemoryUsage &memoryUsage, uint32_t bitVectors, uint64_t size_on_disk)
+                         const MemoryUsage &memoryUsage, uint32_t bitVectors, uint64_t size_on_disk,
+                         const CacheStats &bitvector_search_cache)
 {
     metrics.total.memoryUsage.merge(memoryUsage);
     metrics.total.bitVectors += bitVectors;
     metrics.total.size_on_disk += size_on_disk;
+    metrics.total.bitvector_search_cache += bitvector_search_cache;
     TempAttributeMetric &m = metrics.attrs[attrName];
     m.memoryUsage.merge(memoryUsage);
     m.bitVectors += bitVectors;
     m.size_on_disk += size_on_disk;
+    m.bitvector_search_cache += bitvector_search_cache;
 }
 
 void
@@ -157,9 +163,12 @@ fillTempAttributeMetrics(TempAttributeMetrics &totalMetrics,
                 MemoryUsage memoryUsage(status.getAllocated(), status.getUsed(), status.getDead(), status.getOnHold());
                 uint32_t bitVectors = status.getBitVectors();
                 uint64_t size_on_disk = attr->size_on_disk();
-                fillTempAttributeMetrics(totalMetrics, attr->getName(), memoryUsage, bitVectors, size_on_disk);
+                auto bitvector_search_cache = attr->get_bitvector_search_cache().get_stats();
+                fillTempAttributeMetrics(totalMetrics, attr->getName(), memoryUsage, bitVectors, size_on_disk,
+                                         bitvector_search_cache);
                 if (subMetrics != nullptr) {
-                    fillTempAttributeMetrics(*subMetrics, attr->getName(), memoryUsage, bitVectors, size_on_disk);
+                    fillTempAttributeMetrics(*subMetrics, attr->getName(), memoryUsage, bitVectors, size_on_disk,
+                                             bitvector_search_cache);
                 }
             }
             auto imported = attrMgr->getImportedAttributes();
@@ -168,9 +177,9 @@ fillTempAttributeMetrics(TempAttributeMetrics &totalMetrics,
                 imported->getAll(i_list);
                 for (const auto& attr : i_list) {
                     auto memory_usage = attr->get_memory_usage();
-                    fillTempAttributeMetrics(totalMetrics,  attr->getName(), memory_usage, 0, 0);
+                    fillTempAttributeMetrics(totalMetrics,  attr->getName(), memory_usage, 0, 0, CacheStats());
                     if (subMetrics != nullptr) {
-                        fillTempAttributeMetrics(*subMetrics,  attr->getName(), memory_usage, 0, 0);
+                        fillTempAttributeMetrics(*subMetrics,  attr->getName(), memory_usage, 0, 0, CacheStats());
                     }
                 }
             }
@@ -186,6 +195,7 @@ updateAttributeMetrics(AttributeMetrics &metrics, const TempAttributeMetrics &tm
         if (entry) {
             entry->memoryUsage.update(attr.second.memoryUsage);
             entry->disk_usage.set(attr.second.size_on_disk);
+            entry->bitvector_search_cache.update_metrics(attr.second.bitvector_search_cache);
         }
     }
 }
@@ -249,6 +259,10 @@ updateDocumentStoreMetrics(DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreM
     vespalib::CacheStats cacheStats = backingStore.getCacheStats();
     totalStats.memoryUsage.incAllocatedBytes(cacheStats.memory_used);
     metrics.cache.update_metrics(cacheStats);
+    vespalib::CacheStats renderedCacheStats = summaryMgr->get_rendered_docsum_cache_stats();
+    totalStats.memoryUsage.incAllocatedBytes(renderedCacheStats.memory_used);
+    metrics.rendered_cache.update_metrics(renderedCacheStats);
+    metrics.compaction.update_metrics(backingStore.getCompactionStats());
 }
 
 void
@@ -291,6 +305,11 @@ update_feeding_metrics(DocumentDBFeedingMetrics& metrics, FeedHandlerStats stats
         double max_latency = delta_stats.get_max_latency().value_or(0.0);
         double avg_latency = delta_stats.get_total_latency() / commits;
         metrics.commit.latency.addValueBatch(avg_latency, commits, min_latency, max_latency);
+        static_assert(FeedHandlerStats::NUM_BATCH_SIZE_BUCKETS == DocumentDBCommitMetrics::BatchSizeMetrics::num_buckets);
+        const auto& batch_sizes = delta_stats.get_batch_sizes();
+        for (size_t bucket = 0; bucket < batch_sizes.size(); ++bucket) {
+            metrics.commit.batch_size.commits[bucket]->inc(batch_sizes[bucket]);
+        }
     }
 }
 
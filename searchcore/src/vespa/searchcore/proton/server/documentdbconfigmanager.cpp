@@ -130,7 +130,8 @@ buildMaintenanceConfig(const BootstrapConfig::SP &bootstrapConfig,
                     proton.lidspacecompaction.allowedlidbloatfactor,
                     proton.lidspacecompaction.removebatchblockrate,
                     proton.lidspacecompaction.removeblockrate,
-                    isDocumentTypeGlobal),
+                    isDocumentTypeGlobal,
+                    proton.lidspacecompaction.maxmovespersecond),
             AttributeUsageFilterConfig(
                     proton.writefilter.attribute.addressSpaceLimit),
             vespalib::from_s(proton.writefilter.sampleinterval),
@@ -165,18 +166,24 @@ derive(ProtonConfig::Summary::Cache::UpdateStrategy strategy) {
     return DocumentStore::Config::UpdateStrategy::INVALIDATE;
 }
 
+size_t
+deriveCacheBytes(int64_t maxBytes, const vespalib::HwInfo & hwInfo)
+{
+    return (maxBytes < 0)
+           ? (hwInfo.memory().sizeBytes()*std::min(INT64_C(50), -maxBytes))/100l
+           : maxBytes;
+}
+
 DocumentStore::Config
 getStoreConfig(const ProtonConfig::Summary::Cache & cache, const vespalib::HwInfo & hwInfo)
 {
-    size_t maxBytes = (cache.maxbytes < 0)
-                      ? (hwInfo.memory().sizeBytes()*std::min(INT64_C(50), -cache.maxbytes))/100l
-                      : cache.maxbytes;
-    return DocumentStore::Config(deriveCompression(cache.compression), maxBytes)
-            .updateStrategy(derive(cache.updateStrategy));
+    return DocumentStore::Config(deriveCompression(cache.compression), deriveCacheBytes(cache.maxbytes, hwInfo))
+            .updateStrategy(derive(cache.updateStrategy))
+            .maxRenderedCacheBytes(deriveCacheBytes(cache.rendered.maxbytes, hwInfo));
 }
 
 LogDocumentStore::Config
-deriveConfig(const ProtonConfig::Summary & summary, const vespalib::HwInfo & hwInfo) {
+deriveConfig(const ProtonConfig::Summary & summary, const vespalib::HwInfo & hwInfo, int64_t compact_max_bytes_per_second) {
     DocumentStore::Config config(getStoreConfig(summary.cache, hwInfo));
     const ProtonConfig::Summary::Log & log(summary.log);
     const ProtonConfig::Summary::Log::Chunk & chunk(log.chunk);
@@ -184,16 +191,16 @@ deriveConfig(const ProtonConfig::Summary & summary, const vespalib::HwInfo & hwI
     LogDataStore::Config logConfig;
     logConfig.setMaxFileSize(log.maxfilesize)
             .setMaxNumLids(log.maxnumlids)
+            .setMaxReadConcurrency(std::max(1, log.read.maxconcurrency))
             .setMaxBucketSpread(log.maxbucketspread).setMinFileSizeFactor(log.minfilesizefactor)
             .compactCompression(deriveCompression(log.compact.compression))
-            .setFileConfig(fileConfig);
+            .setMaxCompactConcurrency(std::max(1, log.compact.maxconcurrency))
+            .setCompactMaxBytesPerSecond(std::max(int64_t(0), compact_max_bytes_per_second))
+            .setFileConfig(fileConfig)
+            .setCompressionDictionaryMaxBytes(std::max(0, chunk.compression.dictionary.maxbytes));
     return {config, logConfig};
 }
 
-search::LogDocumentStore::Config buildStoreConfig(const ProtonConfig & proton, const vespalib::HwInfo & hwInfo) {
-    return deriveConfig(proton.summary, hwInfo);
-}
-
 using AttributesConfigSP = DocumentDBConfig::AttributesConfigSP;
 using AttributesConfigBuilder = vespa::config::search::AttributesConfigBuilder;
 using AttributesConfigBuilderSP = std::shared_ptr<AttributesConfigBuilder>;
@@ -255,10 +262,20 @@ build_alloc_config(const vespalib::HwInfo & hwInfo, const ProtonConfig& proton_c
     auto& distribution_config = proton_config.distribution;
     search::GrowStrategy grow_strategy(target_numdocs, alloc_config.growfactor, alloc_config.growbias, target_numdocs, alloc_config.multivaluegrowfactor);
     CompactionStrategy compaction_strategy(alloc_config.maxDeadBytesRatio, alloc_config.maxDeadAddressSpaceRatio, alloc_config.maxCompactBuffers, alloc_config.activeBuffersRatio);
-    return AllocConfig(AllocStrategy(grow_strategy, compaction_strategy, alloc_config.amortizecount),
+    return AllocConfig(AllocStrategy(grow_strategy, compaction_strategy, alloc_config.amortizecount, alloc_config.gidHashIndex),
                        distribution_config.redundancy, distribution_config.searchablecopies);
 }
 
+search::LogDocumentStore::Config
+buildStoreConfig(const ProtonConfig & proton, const vespalib::HwInfo & hwInfo, const std::string& doc_type_name) {
+    auto& document_db_config_entry = find_document_db_config_entry(proton.documentdb, doc_type_name);
+    int64_t compact_max_bytes_per_second = document_db_config_entry.summary.compact.maxbytespersecond;
+    if (compact_max_bytes_per_second < 0) {
+        compact_max_bytes_per_second = proton.summary.log.compact.maxbytespersecond;
+    }
+    return deriveConfig(proton.summary, hwInfo, compact_max_bytes_per_second);
+}
+
 }
 
 void
@@ -344,7 +361,7 @@ DocumentDBConfigManager::update(FNET_Transport & transport, const ConfigSnapshot
     auto schema(buildSchema(*newAttributesConfig, *newIndexschemaConfig));
     newMaintenanceConfig = buildMaintenanceConfig(_bootstrapConfig, _docTypeName);
     search::LogDocumentStore::Config storeConfig = buildStoreConfig(_bootstrapConfig->getProtonConfig(),
-                                                                    _bootstrapConfig->getHwInfo());
+                                                                    _bootstrapConfig->getHwInfo(), _docTypeName);
     if (newMaintenanceConfig && oldMaintenanceConfig && (*newMaintenanceConfig == *oldMaintenanceConfig)) {
         newMaintenanceConfig = oldMaintenanceConfig;
     }
@@ -282,6 +282,12 @@ DocumentRetriever::visitDocuments(const LidVector & lids, search::IDocumentVisit
     _doc_store.visit(lids, getDocumentTypeRepo(), populater);
 }
 
+void
+DocumentRetriever::sortInReadOrder(LidVector & lids) const
+{
+    _doc_store.sortInReadOrder(lids);
+}
+
 void
 DocumentRetriever::populate(DocumentIdT lid, Document & doc) const {
     populate(lid, doc, _attributeFields);
@@ -45,6 +45,7 @@ public:
 
     document::Document::UP getFullDocument(search::DocumentIdT lid) const override;
     void visitDocuments(const LidVector & lids, search::IDocumentVisitor & visitor, ReadConsistency) const override;
+    void sortInReadOrder(LidVector & lids) const override;
     DocumentUP getPartialDocument(search::DocumentIdT lid, const document::DocumentId &, const document::FieldSet &) const override;
     void populate(search::DocumentIdT lid, document::Document & doc) const;
     bool needFetchFromDocStore(const document::FieldSet &) const;
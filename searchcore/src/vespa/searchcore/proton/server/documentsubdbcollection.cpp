@@ -38,7 +38,8 @@ DocumentSubDBCollection::DocumentSubDBCollection(
         std::mutex &configMutex,
         const std::string &baseDir,
         const vespalib::HwInfo &hwInfo,
-        std::shared_ptr<search::diskindex::IPostingListCache> posting_list_cache)
+        std::shared_ptr<search::diskindex::IPostingListCache> posting_list_cache,
+        size_t result_cache_max_bytes)
     : _subDBs(),
       _owner(owner),
       _calc(),
@@ -65,7 +66,8 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                                                                     metrics.ready.attributes,
                                                                     metricsWireService,
                                                                     attribute_interlock),
-                                        queryLimiter, now_ref, warmupExecutor, posting_list_cache)));
+                                        queryLimiter, now_ref, warmupExecutor, posting_list_cache,
+                                        result_cache_max_bytes)));
 
     _subDBs.push_back
         (new StoreOnlyDocSubDB(StoreOnlyDocSubDB::Config(docTypeName, "1.removed", baseDir, _remSubDbId, SubDbType::REMOVED),
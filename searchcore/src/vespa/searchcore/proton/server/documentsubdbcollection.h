@@ -96,7 +96,8 @@ public:
             std::mutex &configMutex,
             const std::string &baseDir,
             const vespalib::HwInfo &hwInfo,
-            std::shared_ptr<search::diskindex::IPostingListCache> posting_list_cache);
+            std::shared_ptr<search::diskindex::IPostingListCache> posting_list_cache,
+            size_t result_cache_max_bytes);
     ~DocumentSubDBCollection();
 
     void setBucketStateCalculator(const IBucketStateCalculatorSP &calc, OnDone onDone);
@@ -148,6 +149,7 @@ public:
     IFeedViewSP getFeedView();
     IFlushTargetList getFlushTargets();
     ReprocessingRunner &getReprocessingRunner() { return _reprocessingRunner; }
+    const ReprocessingRunner &getReprocessingRunner() const { return _reprocessingRunner; }
     double getReprocessingProgress() const;
     void close();
     void tearDownReferences(IDocumentDBReferenceResolver &resolver);
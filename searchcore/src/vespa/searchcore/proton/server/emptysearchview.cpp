@@ -19,7 +19,7 @@ using namespace vespalib::slime;
 namespace proton {
 
 DocsumReply::UP
-EmptySearchView::getDocsums(const DocsumRequest &req)
+EmptySearchView::getDocsums(const DocsumRequest &req, vespalib::ThreadBundle &)
 {
     LOG(debug, "getDocsums(): resultClass(%s), numHits(%zu)",
         req.resultClassName.c_str(), req.hits.size());
@@ -11,7 +11,7 @@ class EmptySearchView : public ISearchHandler
 public:
     using SP = std::shared_ptr<EmptySearchView>;
 
-    std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & req) override;
+    std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & req, vespalib::ThreadBundle &threadBundle) override;
     std::unique_ptr<SearchReply> match(const SearchRequest &req, vespalib::ThreadBundle &threadBundle) const override;
 private:
 };
@@ -55,7 +55,9 @@ void
 convert_adaptive_executor_to_slime(const AdaptiveSequencedExecutor& executor, Cursor& object)
 {
     set_type(object, "AdaptiveSequencedExecutor");
-    object.setLong("num_strands", executor.getNumExecutors());
+    object.setLong("num_strands", executor.num_strands());
+    object.setLong("num_executors", executor.getNumExecutors());
+    object.setLong("moved_ids", executor.get_moved_ids());
     auto cfg = executor.get_config();
     object.setLong("num_threads", cfg.num_threads);
     object.setLong("max_waiting", cfg.max_waiting);
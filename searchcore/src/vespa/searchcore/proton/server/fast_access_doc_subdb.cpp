@@ -175,7 +175,7 @@ FastAccessDocSubDB::createReprocessingTask(IReprocessingInitializer &initializer
     uint32_t docIdLimit = _metaStoreCtx->get().getCommittedDocIdLimit();
     assert(docIdLimit > 0);
     return std::make_unique<ReprocessDocumentsTask>(initializer, getSummaryManager(), docTypeRepo,
-                                                    getSubDbName(), docIdLimit);
+                                                    getSubDbName(), docIdLimit, &_writeService.shared());
 }
 
 FastAccessDocSubDB::FastAccessDocSubDB(const Config &cfg, const Context &ctx)
@@ -1,6 +1,8 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "feed_handler_stats.h"
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <vespa/log/log.h>
 
@@ -30,7 +32,8 @@ FeedHandlerStats::FeedHandlerStats(uint64_t commits, uint64_t operations, double
       _min_operations(),
       _max_operations(),
       _min_latency(),
-      _max_latency()
+      _max_latency(),
+      _batch_sizes()
 {
 }
 
@@ -48,6 +51,9 @@ FeedHandlerStats::operator-=(const FeedHandlerStats& rhs) noexcept
     _commits -= rhs._commits;
     _operations -= rhs._operations;
     _total_latency -= rhs._total_latency;
+    for (size_t i = 0; i < NUM_BATCH_SIZE_BUCKETS; ++i) {
+        _batch_sizes[i] -= rhs._batch_sizes[i];
+    }
     return *this;
 }
 
@@ -59,6 +65,16 @@ FeedHandlerStats::add_commit(uint32_t operations, double latency) noexcept
     _total_latency += latency;
     update_min_max(operations, _min_operations, _max_operations);
     update_min_max(latency, _min_latency, _max_latency);
+    ++_batch_sizes[batch_size_bucket(operations)];
+}
+
+size_t
+FeedHandlerStats::batch_size_bucket(uint32_t operations) noexcept
+{
+    if (operations == 0) {
+        return 0;
+    }
+    return std::min(size_t(std::bit_width(operations) - 1), NUM_BATCH_SIZE_BUCKETS - 1);
 }
 
 void
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 
@@ -12,6 +14,17 @@ namespace proton {
  */
 class FeedHandlerStats
 {
+public:
+    /*
+     * Number of commits per batch size. Bucket i counts commits with
+     * [2^i, 2^(i+1)) operations, and the last bucket is open ended.
+     * Commits without operations are counted in bucket 0.
+     */
+    static constexpr size_t NUM_BATCH_SIZE_BUCKETS = 11;
+    using BatchSizeHistogram = std::array<uint64_t, NUM_BATCH_SIZE_BUCKETS>;
+    static size_t batch_size_bucket(uint32_t operations) noexcept;
+    static uint32_t batch_size_bucket_lower_bound(size_t bucket) noexcept { return 1u << bucket; }
+private:
     uint64_t                _commits;
     uint64_t                _operations;
     double                  _total_latency;
@@ -19,6 +32,7 @@ class FeedHandlerStats
     std::optional<uint32_t> _max_operations;
     std::optional<double>   _min_latency;
     std::optional<double>   _max_latency;
+    BatchSizeHistogram      _batch_sizes;
 
 public:
     FeedHandlerStats(uint64_t commits, uint64_t operations, double total_latency) noexcept;
@@ -34,6 +48,7 @@ public:
     const std::optional<uint32_t>& get_max_operations() noexcept { return _max_operations; }
     const std::optional<double>& get_min_latency() noexcept { return _min_latency; }
     const std::optional<double>& get_max_latency() noexcept { return _max_latency; }
+    const BatchSizeHistogram& get_batch_sizes() noexcept { return _batch_sizes; }
 };
 
 /**
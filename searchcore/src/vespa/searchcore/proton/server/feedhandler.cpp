@@ -18,11 +18,14 @@
 #include <vespa/searchcore/proton/feedoperation/operations.h>
 #include <vespa/searchcore/proton/common/eventlogger.h>
 #include <vespa/searchcorespi/index/ithreadingservice.h>
+#include <vespa/fnet/task.h>
+#include <vespa/fnet/transport.h>
 #include <vespa/vespalib/util/destructor_callbacks.h>
 #include <vespa/searchlib/transactionlog/client_session.h>
 #include <vespa/vespalib/util/atomic.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/size_literals.h>
 #include <cassert>
 #include <thread>
 
@@ -59,11 +62,15 @@ ignoreOperation(const DocumentOperation &op) {
 class TlsMgrWriter : public TlsWriter {
     TransactionLogManager &_tls_mgr;
     std::shared_ptr<search::transactionlog::Writer> _writer;
+    // Reused by the master write thread when serializing operations
+    static constexpr size_t MAX_REUSED_STREAM_SIZE = 1_Mi;
+    vespalib::nbostream _stream;
 public:
     TlsMgrWriter(TransactionLogManager &tls_mgr,
                  const search::transactionlog::WriterFactory & factory)
         : _tls_mgr(tls_mgr),
-          _writer(factory.getWriter(tls_mgr.getDomainName()))
+          _writer(factory.getWriter(tls_mgr.getDomainName())),
+          _stream()
     { }
     void appendOperation(const FeedOperation &op, DoneCallback onDone) override;
     [[nodiscard]] CommitResult startCommit(DoneCallback onDone) override {
@@ -76,14 +83,17 @@ public:
 void
 TlsMgrWriter::appendOperation(const FeedOperation &op, DoneCallback onDone) {
     using Packet = search::transactionlog::Packet;
-    vespalib::nbostream stream;
-    op.serialize(stream);
+    _stream.clear();
+    op.serialize(_stream);
     LOG(debug, "appendOperation(): serialNum(%" PRIu64 "), type(%u), size(%zu)",
-        op.getSerialNum(), (uint32_t)op.getType(), stream.size());
-    Packet::Entry entry(op.getSerialNum(), op.getType(), vespalib::ConstBufferRef(stream.data(), stream.size()));
+        op.getSerialNum(), (uint32_t)op.getType(), _stream.size());
+    Packet::Entry entry(op.getSerialNum(), op.getType(), vespalib::ConstBufferRef(_stream.data(), _stream.size()));
     Packet packet(entry.serializedSize());
     packet.add(entry);
     _writer->append(packet, std::move(onDone));
+    if (_stream.size() > MAX_REUSED_STREAM_SIZE) {
+        vespalib::nbostream().swap(_stream);
+    }
 }
 
 bool
@@ -143,6 +153,20 @@ DaisyChainedFeedToken::~DaisyChainedFeedToken() = default;
 
 }  // namespace
 
+/*
+ * Starts the commit of the feed operations collected by the master write
+ * thread when the max commit delay has passed. Runs in the transport thread.
+ */
+class FeedHandler::DelayedCommitTask : public FNET_Task {
+    FeedHandler & _handler;
+public:
+    DelayedCommitTask(FNET_Scheduler *scheduler, FeedHandler & handler)
+        : FNET_Task(scheduler),
+          _handler(handler)
+    { }
+    void PerformTask() override { _handler.enqueDelayedCommitTask(); }
+};
+
 void
 FeedHandler::doHandleOperation(FeedToken token, FeedOperation::UP op)
 {
@@ -432,11 +456,20 @@ FeedHandler::FeedHandler(IThreadingService &writeService,
       _allowSync(false),
       _heart_beat_time(vespalib::steady_time()),
       _stats_lock(),
-      _stats()
+      _stats(),
+      _commit_max_delay(vespalib::duration::zero()),
+      _commit_max_operations(0),
+      _commit_delayed(false),
+      _delayedCommitTask()
 { }
 
 
-FeedHandler::~FeedHandler() = default;
+FeedHandler::~FeedHandler()
+{
+    if (_delayedCommitTask) {
+        _delayedCommitTask->Kill();
+    }
+}
 
 // Called on DocumentDB creatio
 void
@@ -460,6 +493,9 @@ FeedHandler::close()
         syncTls(load_relaxed(_serialNum));
     }
     _allowSync = false;
+    if (_delayedCommitTask) {
+        _delayedCommitTask->Kill();
+    }
     _tlsMgr.close();
 }
 
@@ -467,7 +503,8 @@ void
 FeedHandler::replayTransactionLog(SerialNum flushedIndexMgrSerial, SerialNum flushedSummaryMgrSerial,
                                   SerialNum oldestFlushedSerial, SerialNum newestFlushedSerial,
                                   ConfigStore &config_store,
-                                  std::shared_ptr<vespalib::SharedOperationThrottler> shared_replay_throttler)
+                                  std::shared_ptr<vespalib::SharedOperationThrottler> shared_replay_throttler,
+                                  uint32_t replay_decode_tasks)
 {
     (void) newestFlushedSerial;
     assert(_activeFeedView);
@@ -475,6 +512,9 @@ FeedHandler::replayTransactionLog(SerialNum flushedIndexMgrSerial, SerialNum flu
     auto state = make_shared<ReplayTransactionLogState>
                           (getDocTypeName(), _activeFeedView, *_bucketDBHandler, _replayConfig,
                            config_store, std::move(shared_replay_throttler), *this);
+    if (replay_decode_tasks > 1) {
+        state->set_parallel_decoding(_writeService.shared(), replay_decode_tasks);
+    }
     changeFeedState(state);
     // Resurrected attribute vector might cause oldestFlushedSerial to
     // be lower than _prunedSerialNum, so don't warn for now.
@@ -523,7 +563,7 @@ void
 FeedHandler::onCommitDone(size_t numOperations, vespalib::steady_time start_time) {
     _numOperations.commitCompleted(numOperations);
     if (_numOperations.shouldScheduleCommit()) {
-        enqueCommitTask();
+        scheduleCommit();
     }
     vespalib::steady_time now = vespalib::steady_clock::now();
     auto latency = vespalib::to_s(now - start_time);
@@ -537,6 +577,53 @@ void FeedHandler::enqueCommitTask() {
     }));
 }
 
+void
+FeedHandler::scheduleCommit() {
+    if ((_commit_max_delay > vespalib::duration::zero()) && !commitBatchIsFull()) {
+        _commit_delayed = true;
+        _delayedCommitTask->Schedule(vespalib::to_s(_commit_max_delay));
+    } else {
+        enqueCommitTask();
+    }
+}
+
+bool
+FeedHandler::commitBatchIsFull() const {
+    return (_commit_max_operations != 0) &&
+           (_numOperations.operationsSinceLastCommitStart() >= _commit_max_operations);
+}
+
+void
+FeedHandler::enqueDelayedCommitTask() {
+    _writeService.master().execute(makeLambdaTask([this, start_time(vespalib::steady_clock::now())]() {
+        performDelayedCommit(start_time);
+    }));
+}
+
+void
+FeedHandler::performDelayedCommit(vespalib::steady_time start_time) {
+    // The commit might already have been started due to a full batch
+    if (_commit_delayed) {
+        _commit_delayed = false;
+        initiateCommit(start_time);
+    }
+}
+
+void
+FeedHandler::set_commit_batching(vespalib::duration max_delay, uint32_t max_operations) {
+    assert(_writeService.master().isCurrentThread());
+    _commit_max_delay = max_delay;
+    _commit_max_operations = max_operations;
+    if ((max_delay > vespalib::duration::zero()) && !_delayedCommitTask) {
+        _delayedCommitTask = std::make_unique<DelayedCommitTask>(_writeService.transport().GetScheduler(), *this);
+    }
+    if (_commit_delayed && ((max_delay == vespalib::duration::zero()) || commitBatchIsFull())) {
+        _commit_delayed = false;
+        _delayedCommitTask->Unschedule();
+        enqueCommitTask();
+    }
+}
+
 void
 FeedHandler::initiateCommit(vespalib::steady_time start_time) {
     auto onCommitDoneContext = std::make_shared<OnCommitDone>(
@@ -561,6 +648,10 @@ FeedHandler::appendOperation(const FeedOperation &op, TlsWriter::DoneCallback on
     _tlsWriter->appendOperation(op, std::move(onDone));
     _numOperations.startOperation();
     if (_numOperations.operationsInFlight() == 1) {
+        scheduleCommit();
+    } else if (_commit_delayed && commitBatchIsFull()) {
+        _commit_delayed = false;
+        _delayedCommitTask->Unschedule();
         enqueCommitTask();
     }
 }
@@ -694,6 +785,17 @@ FeedHandler::handleOperation(FeedToken token, FeedOperation::UP op)
     }));
 }
 
+void
+FeedHandler::handleOperations(std::vector<std::pair<FeedToken, FeedOperation::UP>> ops)
+{
+    // Same as handleOperation(), but the persistence thread is only blocked once for the entire batch.
+    _writeService.blocking_master_execute(makeLambdaTask([this, ops = std::move(ops)]() mutable {
+        for (auto & entry : ops) {
+            doHandleOperation(std::move(entry.first), std::move(entry.second));
+        }
+    }));
+}
+
 IDocumentMoveHandler::MoveResult
 FeedHandler::handleMove(MoveOperation &op, vespalib::IDestructorCallback::SP moveDoneCtx)
 {
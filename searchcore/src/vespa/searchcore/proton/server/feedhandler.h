@@ -96,6 +96,12 @@ private:
     std::atomic<vespalib::steady_time>     _heart_beat_time;
     mutable std::mutex                     _stats_lock;
     mutable FeedHandlerStats               _stats;
+    // used by master write thread tasks to collect feed operations into larger commits
+    class DelayedCommitTask;
+    vespalib::duration                     _commit_max_delay;
+    uint32_t                               _commit_max_operations;
+    bool                                   _commit_delayed;
+    std::unique_ptr<DelayedCommitTask>     _delayedCommitTask;
 
     /**
      * Delayed handling of feed operations, in master write thread.
@@ -135,6 +141,10 @@ private:
     void onCommitDone(size_t numPendingAtStart, vespalib::steady_time start_time);
     void initiateCommit(vespalib::steady_time start_time);
     void enqueCommitTask();
+    void scheduleCommit();
+    bool commitBatchIsFull() const;
+    void enqueDelayedCommitTask();
+    void performDelayedCommit(vespalib::steady_time start_time);
 public:
     FeedHandler(const FeedHandler &) = delete;
     FeedHandler & operator = (const FeedHandler &) = delete;
@@ -178,6 +188,8 @@ public:
      * @param flushedSummaryMgrSerial The flushed serial number of the
      *                                document store.
      * @param config_store            Reference to the config store.
+     * @param replay_decode_tasks     Number of tasks decoding each packet,
+     *                                see ReplayTransactionLogState.
      */
 
     void
@@ -186,7 +198,8 @@ public:
                          SerialNum oldestFlushedSerial,
                          SerialNum newestFlushedSerial,
                          ConfigStore &config_store,
-                         std::shared_ptr<vespalib::SharedOperationThrottler> shared_replay_throttler);
+                         std::shared_ptr<vespalib::SharedOperationThrottler> shared_replay_throttler,
+                         uint32_t replay_decode_tasks = 1);
 
     /**
      * Called when a flush is done and allows pruning of the transaction log.
@@ -229,12 +242,15 @@ public:
     float getReplayProgress() const {
         return _tlsReplayProgress ? _tlsReplayProgress->getProgress() : 0;
     }
+    const TlsReplayProgress *get_replay_progress() const noexcept { return _tlsReplayProgress.get(); }
     bool getTransactionLogReplayDone() const;
     std::string getDocTypeName() const { return _docTypeName.getName(); }
     void tlsPrune(SerialNum oldest_to_keep);
 
     void performOperation(FeedToken token, FeedOperationUP op);
     void handleOperation(FeedToken token, FeedOperationUP op);
+    // Handles a batch of external feed operations in a single master thread task
+    void handleOperations(std::vector<std::pair<FeedToken, FeedOperationUP>> ops);
 
     MoveResult handleMove(MoveOperation &op, std::shared_ptr<vespalib::IDestructorCallback> moveDoneCtx) override;
     void heartBeat() override;
@@ -250,6 +266,13 @@ public:
     void considerDelayedPrune();
     vespalib::steady_time get_heart_beat_time() const;
     FeedHandlerStats get_stats(bool reset_min_max) const;
+    /**
+     * Collect feed operations for at most max_delay, or until max_operations
+     * operations are pending, before committing them as one batch. A max_delay
+     * of 0 starts a commit as soon as the previous one completes. Must be
+     * called by the master write thread.
+     */
+    void set_commit_batching(vespalib::duration max_delay, uint32_t max_operations);
 };
 
 } // namespace proton
@@ -11,10 +11,14 @@
 #include <vespa/searchcore/proton/common/eventlogger.h>
 #include <vespa/searchcore/proton/common/memory_usage_logger.h>
 #include <vespa/searchcore/proton/common/replay_feed_token_factory.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/idestructorcallback.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/shared_operation_throttler.h>
+#include <algorithm>
 #include <cassert>
+#include <limits>
+#include <vector>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.feedstates");
@@ -145,6 +149,75 @@ public:
     }
 };
 
+/**
+ * The entries of a packet, and the feed operations decoded from them
+ * ahead of replay. An entry without a decoded operation is decoded when
+ * replayed.
+ */
+struct DecodedPacket {
+    std::vector<Packet::Entry> entries;
+    std::vector<std::unique_ptr<FeedOperation>> operations;
+
+    DecodedPacket() noexcept : entries(), operations() {}
+    ~DecodedPacket();
+};
+
+DecodedPacket::~DecodedPacket() = default;
+
+void
+decodeEntries(DecodedPacket &decoded, size_t begin, size_t end, const document::DocumentTypeRepo &repo)
+{
+    for (size_t i = begin; i < end; ++i) {
+        try {
+            decoded.operations[i] = ReplayPacketDispatcher::decodeEntry(decoded.entries[i], repo);
+        } catch (const std::exception &) {
+            // Left for replay, which reports the failure in order
+        }
+    }
+}
+
+/*
+ * Decodes the entries of the packet using the calling thread and
+ * decode_tasks - 1 tasks in the executor. Decoding stops at the first new
+ * config operation, as replaying it can change the document type repo.
+ */
+std::unique_ptr<DecodedPacket>
+decodePacket(const Packet &packet, const document::DocumentTypeRepo &repo, Executor &executor, uint32_t decode_tasks)
+{
+    auto decoded = std::make_unique<DecodedPacket>();
+    vespalib::nbostream_longlivedbuf handle(packet.getHandle().data(), packet.getHandle().size());
+    size_t decode_limit = std::numeric_limits<size_t>::max();
+    while ( !handle.empty() ) {
+        Packet::Entry entry;
+        entry.deserialize(handle);
+        if ((entry.type() == FeedOperation::NEW_CONFIG) && (decode_limit > decoded->entries.size())) {
+            decode_limit = decoded->entries.size();
+        }
+        decoded->entries.push_back(entry);
+    }
+    decoded->operations.resize(decoded->entries.size());
+    decode_limit = std::min(decode_limit, decoded->entries.size());
+    size_t num_tasks = std::min(size_t(decode_tasks), decode_limit);
+    if (num_tasks == 0) {
+        return decoded;
+    }
+    vespalib::CountDownLatch latch(num_tasks - 1);
+    size_t per_task = (decode_limit + num_tasks - 1) / num_tasks;
+    for (size_t begin = per_task; begin < decode_limit; begin += per_task) {
+        size_t end = std::min(begin + per_task, decode_limit);
+        auto rejected = executor.execute(makeLambdaTask([&decoded = *decoded, &repo, &latch, begin, end]() {
+            decodeEntries(decoded, begin, end, repo);
+            latch.countDown();
+        }));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    decodeEntries(*decoded, 0, std::min(per_task, decode_limit), repo);
+    latch.await();
+    return decoded;
+}
+
 class PacketDispatcher {
 public:
     PacketDispatcher(IReplayPacketHandler *packet_handler)
@@ -152,8 +225,9 @@ public:
     {}
 
     void handlePacket(PacketWrapper & wrap);
+    void handlePacket(PacketWrapper & wrap, const DecodedPacket &decoded);
 private:
-    void handleEntry(const Packet::Entry &entry);
+    void handleEntry(const Packet::Entry &entry, const FeedOperation *op);
     IReplayPacketHandler *_packet_handler;
 };
 
@@ -164,7 +238,21 @@ PacketDispatcher::handlePacket(PacketWrapper & wrap)
     while ( !handle.empty() ) {
         Packet::Entry entry;
         entry.deserialize(handle);
-        handleEntry(entry);
+        handleEntry(entry, nullptr);
+        if (wrap.progress != nullptr) {
+            handleProgress(*wrap.progress, entry.serial());
+        }
+    }
+    wrap.result = RPC::OK;
+    wrap.gate.countDown();
+}
+
+void
+PacketDispatcher::handlePacket(PacketWrapper & wrap, const DecodedPacket &decoded)
+{
+    for (size_t i = 0; i < decoded.entries.size(); ++i) {
+        const Packet::Entry &entry = decoded.entries[i];
+        handleEntry(entry, decoded.operations[i].get());
         if (wrap.progress != nullptr) {
             handleProgress(*wrap.progress, entry.serial());
         }
@@ -174,14 +262,18 @@ PacketDispatcher::handlePacket(PacketWrapper & wrap)
 }
 
 void
-PacketDispatcher::handleEntry(const Packet::Entry &entry) {
+PacketDispatcher::handleEntry(const Packet::Entry &entry, const FeedOperation *op) {
     // Called by handlePacket() in executor thread.
     LOG(spam, "replay packet entry: entrySerial(%" PRIu64 "), entryType(%u)", entry.serial(), entry.type());
 
     auto entry_serial_num = entry.serial();
     _packet_handler->check_serial_num(entry_serial_num);
     ReplayPacketDispatcher dispatcher(*_packet_handler);
-    dispatcher.replayEntry(entry);
+    if (op != nullptr) {
+        dispatcher.replayOperation(*op);
+    } else {
+        dispatcher.replayEntry(entry);
+    }
     _packet_handler->optionalCommit(entry_serial_num);
 }
 
@@ -199,16 +291,38 @@ ReplayTransactionLogState::ReplayTransactionLogState(
       _doc_type_name(name),
       _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(
             feed_view_ptr, bucketDBHandler, replay_config, config_store,
-            std::move(shared_replay_throttler), inc_serial_num))
+            std::move(shared_replay_throttler), inc_serial_num)),
+      _decode_executor(nullptr),
+      _decode_tasks(1)
 { }
 
 ReplayTransactionLogState::~ReplayTransactionLogState() = default;
 
+void
+ReplayTransactionLogState::set_parallel_decoding(Executor &decode_executor, uint32_t decode_tasks)
+{
+    _decode_executor = &decode_executor;
+    _decode_tasks = decode_tasks;
+}
+
 void
 ReplayTransactionLogState::receive(const PacketWrapper::SP &wrap, Executor &executor) {
-    executor.execute(makeLambdaTask([this, wrap = wrap] () {
+    if ((_decode_executor == nullptr) || (_decode_tasks <= 1)) {
+        executor.execute(makeLambdaTask([this, wrap = wrap] () {
+            PacketDispatcher dispatcher(_packet_handler.get());
+            dispatcher.handlePacket(*wrap);
+        }));
+        return;
+    }
+    /*
+     * The previous packet has been replayed when a new packet is received,
+     * so the document type repo cannot change while decoding.
+     */
+    std::shared_ptr<DecodedPacket> decoded = decodePacket(wrap->packet, _packet_handler->getDeserializeRepo(),
+                                                          *_decode_executor, _decode_tasks);
+    executor.execute(makeLambdaTask([this, wrap = wrap, decoded = std::move(decoded)] () {
         PacketDispatcher dispatcher(_packet_handler.get());
-        dispatcher.handlePacket(*wrap);
+        dispatcher.handlePacket(*wrap, *decoded);
     }));
 }
 
@@ -48,6 +48,8 @@ public:
 class ReplayTransactionLogState : public FeedState {
     std::string _doc_type_name;
     std::unique_ptr<IReplayPacketHandler> _packet_handler;
+    vespalib::Executor *_decode_executor;
+    uint32_t            _decode_tasks;
 
 public:
     ReplayTransactionLogState(const std::string &name,
@@ -59,6 +61,12 @@ public:
             IIncSerialNum &inc_serial_num);
 
     ~ReplayTransactionLogState() override;
+    /**
+     * Decode the entries of each packet with the given number of tasks,
+     * using the decode executor for all but one of them. The decoded
+     * operations are still replayed in serial order.
+     */
+    void set_parallel_decoding(vespalib::Executor &decode_executor, uint32_t decode_tasks);
     void handleOperation(FeedToken, FeedOperationUP op) override {
         throwExceptionInHandleOperation(_doc_type_name, *op);
     }
@@ -25,6 +25,7 @@ HwInfoExplorer::get_state(const vespalib::slime::Inserter& inserter, bool full)
 
         auto& cpu = object.setObject("cpu");
         cpu.setLong("cores", _info.cpu().cores());
+        cpu.setLong("numa_nodes", _info.cpu().numa_nodes());
     }
 }
 
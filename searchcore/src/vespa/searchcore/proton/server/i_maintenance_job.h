@@ -6,6 +6,8 @@
 #include <memory>
 #include <string>
 
+namespace vespalib::slime { struct Cursor; }
+
 namespace proton {
 
 class IBlockableMaintenanceJob;
@@ -46,6 +48,11 @@ public:
     virtual bool isBlocked() const { return false; }
     virtual IBlockableMaintenanceJob *asBlockable() { return nullptr; }
     virtual void updateMetrics(DocumentDBTaggedMetrics &) const {}
+    /**
+     * Insert job specific progress into the given object (used by the state explorer).
+     * Called by a state explorer thread.
+     */
+    virtual void report_progress(vespalib::slime::Cursor &) const {}
     void stop() {
         _stopped = true;
         onStop();
@@ -10,6 +10,7 @@ namespace document {
     class DocumentTypeRepo;
 }
 namespace search { class IDocumentStore; }
+namespace search::docsummary { class RenderedDocsumCache; }
 namespace vespalib { class nbostream; }
 
 namespace proton {
@@ -36,6 +37,8 @@ public:
     virtual const search::IDocumentStore &getDocumentStore() const = 0;
     virtual std::unique_ptr<Document> get(const DocumentIdT lid, const DocumentTypeRepo &repo) = 0;
     virtual void compactLidSpace(uint32_t wantedDocIdLimit) = 0;
+    // Cache of rendered docsums to invalidate when documents change, if any
+    virtual std::shared_ptr<search::docsummary::RenderedDocsumCache> get_rendered_docsum_cache() const { return {}; }
 };
 
 } // namespace proton
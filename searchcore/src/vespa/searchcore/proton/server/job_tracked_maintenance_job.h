@@ -24,6 +24,7 @@ public:
 
     bool isBlocked() const override { return _job->isBlocked(); }
     IBlockableMaintenanceJob *asBlockable() override { return _job->asBlockable(); }
+    void report_progress(vespalib::slime::Cursor &object) const override { _job->report_progress(object); }
     void registerRunner(IMaintenanceJobRunner *runner) override {
         _job->registerRunner(runner);
     }
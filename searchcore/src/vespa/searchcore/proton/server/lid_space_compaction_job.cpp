@@ -14,6 +14,7 @@
 #include <vespa/searchcorespi/index/i_thread_service.h>
 #include <vespa/persistence/spi/bucket_tasks.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/vespalib/util/destructor_callbacks.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/gate.h>
@@ -28,6 +29,7 @@ using storage::spi::makeBucketTask;
 using storage::spi::Bucket;
 using vespalib::RetainGuard;
 using vespalib::makeLambdaTask;
+using vespalib::slime::Cursor;
 
 namespace proton::lidspace {
 
@@ -42,6 +44,16 @@ isSameDocument(const search::DocumentMetaData &a, const search::DocumentMetaData
            (a.timestamp == b.timestamp);
 }
 
+uint32_t
+max_moves_per_interval(const DocumentDBLidSpaceCompactionConfig &config)
+{
+    if (config.get_max_moves_per_second() <= 0.0) {
+        return 0;
+    }
+    double moves = config.get_max_moves_per_second() * vespalib::to_s(config.getInterval());
+    return std::max(1u, static_cast<uint32_t>(std::min(moves, 4294967295.0)));
+}
+
 }
 
 class CompactionJob::MoveTask : public storage::spi::BucketTask {
@@ -73,11 +85,15 @@ bool
 CompactionJob::scanDocuments(const LidUsageStats &stats)
 {
     if (_scanItr->valid()) {
+        if (move_budget_spent()) {
+            return true; // wait for next interval
+        }
         DocumentMetaData document = getNextDocument(stats);
         if (document.valid()) {
             Bucket metaBucket(document::Bucket(_bucketSpace, document.bucketId));
             _bucketExecutor.execute(metaBucket, std::make_unique<MoveTask>(shared_from_this(), document, getLimiter().beginOperation()));
-            if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
+            ++_moves_in_window;
+            if (isBlocked(BlockedReason::OUTSTANDING_OPS) || move_budget_spent()) {
                 return true;
             }
         }
@@ -85,6 +101,20 @@ CompactionJob::scanDocuments(const LidUsageStats &stats)
     return false;
 }
 
+bool
+CompactionJob::move_budget_spent()
+{
+    if (_max_moves_per_interval == 0) {
+        return false;
+    }
+    auto now = vespalib::steady_clock::now();
+    if (now >= _move_window_start + getInterval()) {
+        _move_window_start = now;
+        _moves_in_window = 0;
+    }
+    return _moves_in_window >= _max_moves_per_interval;
+}
+
 void
 CompactionJob::moveDocument(std::shared_ptr<CompactionJob> job, const search::DocumentMetaData & metaThen,
                             std::shared_ptr<IDestructorCallback> context)
@@ -120,6 +150,11 @@ CompactionJob::completeMove(const search::DocumentMetaData & metaThen, std::uniq
     moveOp->setTargetLid(lowestLid);
     _opStorer.appendOperation(*moveOp, onDone);
     _handler->handleMove(*moveOp, std::move(onDone));
+    _moved_docs.store(_moved_docs.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    uint32_t remaining = _remaining_moves.load(std::memory_order_relaxed);
+    if (remaining > 0) {
+        _remaining_moves.store(remaining - 1, std::memory_order_relaxed);
+    }
 }
 
 CompactionJob::CompactionJob(const DocumentDBLidSpaceCompactionConfig &config,
@@ -152,7 +187,14 @@ CompactionJob::CompactionJob(const DocumentDBLidSpaceCompactionConfig &config,
       _master(master),
       _bucketExecutor(bucketExecutor),
       _dbRetainer(std::move(dbRetainer)),
-      _bucketSpace(bucketSpace)
+      _bucketSpace(bucketSpace),
+      _max_moves_per_interval(max_moves_per_interval(config)),
+      _move_window_start(),
+      _moves_in_window(0),
+      _scan_start_ns(0),
+      _moved_docs(0),
+      _moved_docs_at_scan_start(0),
+      _remaining_moves(0)
 {
     _token_source = std::move(maintenance_job_token_source);
     _resource_usage_notifier.add_resource_usage_listener(this);
@@ -239,9 +281,9 @@ CompactionJob::run()
         if (shouldRestartScanDocuments(stats)) {
             EventLogger::lidSpaceCompactionRestart(_handler->getName(), stats.getUsedLids(), _cfg.getAllowedLidBloat(),
                                                    stats.getHighestUsedLid(), stats.getLowestFreeLid());
-            _scanItr = _handler->getIterator();
+            start_scan(stats, true);
         } else {
-            _scanItr.reset();
+            end_scan();
             _shouldCompactLidSpace = true;
             return false;
         }
@@ -257,13 +299,56 @@ CompactionJob::run()
         EventLogger::lidSpaceCompactionStart(_handler->getName(), stats.getLidBloat(), _cfg.getAllowedLidBloat(),
                                              stats.getLidBloatFactor(), _cfg.getAllowedLidBloatFactor(),
                                              stats.getLidLimit(), stats.getLowestFreeLid());
-        _scanItr = _handler->getIterator();
+        start_scan(stats, false);
         return scanDocuments(stats);
     }
     _token.reset();
     return true;
 }
 
+void
+CompactionJob::start_scan(const LidUsageStats &stats, bool restart)
+{
+    _scanItr = _handler->getIterator();
+    // Every used lid above the number of used lids must be moved, this is an upper bound on the remaining moves.
+    uint32_t remaining = (stats.getHighestUsedLid() > stats.getUsedLids())
+                         ? (stats.getHighestUsedLid() - stats.getUsedLids()) : 0u;
+    _remaining_moves.store(remaining, std::memory_order_relaxed);
+    if (!restart) {
+        _moved_docs_at_scan_start.store(_moved_docs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        _scan_start_ns.store(vespalib::count_ns(vespalib::steady_clock::now().time_since_epoch()), std::memory_order_release);
+    }
+}
+
+void
+CompactionJob::end_scan()
+{
+    _scanItr.reset();
+    _remaining_moves.store(0, std::memory_order_relaxed);
+    _scan_start_ns.store(0, std::memory_order_release);
+}
+
+void
+CompactionJob::report_progress(Cursor &object) const
+{
+    int64_t scan_start_ns = _scan_start_ns.load(std::memory_order_acquire);
+    Cursor &progress = object.setObject("progress");
+    progress.setBool("scanning", scan_start_ns != 0);
+    progress.setLong("moved_documents", _moved_docs.load(std::memory_order_relaxed));
+    if (scan_start_ns == 0) {
+        return;
+    }
+    uint64_t moved = _moved_docs.load(std::memory_order_relaxed) - _moved_docs_at_scan_start.load(std::memory_order_relaxed);
+    uint32_t remaining = _remaining_moves.load(std::memory_order_relaxed);
+    double elapsed = vespalib::to_s(vespalib::steady_clock::now().time_since_epoch() - std::chrono::nanoseconds(scan_start_ns));
+    double moves_per_second = (elapsed > 0.0) ? (moved / elapsed) : 0.0;
+    progress.setLong("remaining_moves_estimate", remaining);
+    progress.setDouble("moves_per_second", moves_per_second);
+    if (moves_per_second > 0.0) {
+        progress.setDouble("expected_remaining_seconds", remaining / moves_per_second);
+    }
+}
+
 bool
 CompactionJob::remove_batch_is_ongoing() const
 {
@@ -14,6 +14,7 @@
 namespace storage::spi { struct BucketExecutor; }
 namespace searchcorespi::index { struct IThreadService; }
 namespace vespalib { class IDestructorCallback; }
+namespace vespalib::slime { struct Cursor; }
 namespace proton {
     class MoveOperation;
     class IResourceUsageNotifier;
@@ -52,6 +53,15 @@ private:
     BucketExecutor                               &_bucketExecutor;
     vespalib::RetainGuard                         _dbRetainer;
     document::BucketSpace                         _bucketSpace;
+    // Budget of document moves per job interval, 0 means unlimited. Only used by master thread.
+    const uint32_t                                _max_moves_per_interval;
+    vespalib::steady_time                         _move_window_start;
+    uint32_t                                      _moves_in_window;
+    // Progress of the current scan, written by master thread and read by state explorer.
+    std::atomic<int64_t>                          _scan_start_ns;
+    std::atomic<uint64_t>                         _moved_docs;
+    std::atomic<uint64_t>                         _moved_docs_at_scan_start;
+    std::atomic<uint32_t>                         _remaining_moves;
 
     bool hasTooMuchLidBloat(const search::LidUsageStats &stats) const;
     bool shouldRestartScanDocuments(const search::LidUsageStats &stats) const;
@@ -59,6 +69,9 @@ private:
     bool remove_batch_is_ongoing() const;
     bool remove_is_ongoing() const;
     search::DocumentMetaData getNextDocument(const search::LidUsageStats &stats);
+    bool move_budget_spent();
+    void start_scan(const search::LidUsageStats &stats, bool restart);
+    void end_scan();
 
     bool scanDocuments(const search::LidUsageStats &stats);
     static void moveDocument(std::shared_ptr<CompactionJob> job, const search::DocumentMetaData & metaThen,
@@ -97,6 +110,7 @@ public:
     void notify_resource_usage(const ResourceUsageState& state) override;
     void notifyClusterStateChanged(const std::shared_ptr<IBucketStateCalculator> &newCalc) override;
     bool run() override;
+    void report_progress(vespalib::slime::Cursor &object) const override;
 };
 
 } // namespace proton
@@ -31,6 +31,7 @@ convertAllJobsToSlime(const std::vector<MaintenanceJobRunner::SP> &jobs, Cursor
         object.setDouble("delay", vespalib::to_s(job.getDelay()));
         object.setDouble("interval", vespalib::to_s(job.getInterval()));
         object.setBool("blocked", job.isBlocked());
+        job.report_progress(object);
     }
 }
 
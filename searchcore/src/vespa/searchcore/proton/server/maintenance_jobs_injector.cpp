@@ -63,7 +63,8 @@ injectBucketMoveJob(MaintenanceController &controller,
     auto bmj = BucketMoveJob::create(std::move(calc), controller.retainDB(), moveHandler, bucketModifiedHandler, controller.masterThread(),
                                      bucketExecutor, controller.getReadySubDB(), controller.getNotReadySubDB(),
                                      bucketCreateNotifier, clusterStateChangedNotifier, bucketStateChangedNotifier,
-                                     resource_usage_notifier, config.getBlockableJobConfig(), docTypeName, bucketSpace);
+                                     resource_usage_notifier, config.getBlockableJobConfig(), config.getBucketMoveConfig(),
+                                     docTypeName, bucketSpace);
     controller.registerJob(trackJob(jobTrackers.getBucketMove(), std::move(bmj)));
 }
 
@@ -2,9 +2,11 @@
 
 #include "malloc_info_explorer.h"
 #include <vespa/vespalib/data/slime/cursor.h>
-#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/mimalloc_intercept.h>
 #include <cassert>
 #include <cstdio>
+#include <cstdlib>
+#include <functional>
 #include <ranges>
 #include <string>
 #include <string_view>
@@ -18,7 +20,7 @@ extern "C" {
 // both detect the presence of a particular malloc implementation and to do the
 // info dumping for it.
 void vespamalloc_dump_info(FILE* out_file) __attribute__((weak));
-// TODO mimalloc and friends
+void vespamalloc_dump_alloc_samples(FILE* out_file, size_t max_stacks) __attribute__((weak));
 
 }
 
@@ -31,9 +33,13 @@ namespace {
 
 #ifdef __linux__
 
+// Number of call stacks emitted from the allocation samples
+constexpr size_t max_sampled_stacks = 32;
+
 enum class MallocImpl {
     LibcOrUnknown,
-    VespaMalloc
+    VespaMalloc,
+    MiMalloc
 };
 
 [[nodiscard]]
@@ -41,6 +47,9 @@ MallocImpl detect_malloc_impl() noexcept {
     if (vespamalloc_dump_info != nullptr) {
         return MallocImpl::VespaMalloc;
     }
+    if (vespalib::is_mi_malloc_present()) {
+        return MallocImpl::MiMalloc;
+    }
     return MallocImpl::LibcOrUnknown;
 }
 
@@ -48,40 +57,49 @@ MallocImpl detect_malloc_impl() noexcept {
 std::string_view to_string(MallocImpl mi) noexcept {
     switch (mi) {
     case MallocImpl::VespaMalloc:   return "vespamalloc";
+    case MallocImpl::MiMalloc:      return "mimalloc";
     case MallocImpl::LibcOrUnknown: return "libc_or_unknown";
     }
     abort();
 }
 
-[[maybe_unused]]
-void fclose_helper(FILE* f) {
-    fclose(f);
-}
-
-std::string get_vespamalloc_info_dump() {
+std::string dump_to_string(const std::function<void(FILE*)>& dump) {
 #ifdef _POSIX_C_SOURCE // For open_memstream()
-    constexpr size_t max_buf_size = 16_Ki;
-    auto buf = std::make_unique<char[]>(max_buf_size);
-
-    char* buf_loc = buf.get();
-    size_t buf_size = max_buf_size;
-    {
-        // buf_loc and buf_size will be updated on fclose().
-        // In particular, buf_size will be set to #bytes written.
-        std::unique_ptr<FILE, decltype(&fclose_helper)> mem_f(open_memstream(&buf_loc, &buf_size), &fclose_helper);
-        if (!mem_f) {
-            return "<open_memstream failed>";
-        }
-        assert(vespamalloc_dump_info != nullptr);
-        vespamalloc_dump_info(mem_f.get());
+    char* buf_loc = nullptr;
+    size_t buf_size = 0;
+    // buf_loc and buf_size will be updated on fclose().
+    // In particular, buf_size will be set to #bytes written.
+    FILE* mem_f = open_memstream(&buf_loc, &buf_size);
+    if (mem_f == nullptr) {
+        return "<open_memstream failed>";
     }
-    assert(buf_size < max_buf_size); // Excludes implicit terminating null
-    return {buf_loc, buf_size};
+    dump(mem_f);
+    fclose(mem_f);
+    std::string result(buf_loc, buf_size);
+    free(buf_loc);
+    return result;
 #else
+    (void) dump;
     return "<unsupported by platform>";
 #endif
 }
 
+std::string get_vespamalloc_info_dump() {
+    assert(vespamalloc_dump_info != nullptr);
+    return dump_to_string([](FILE* f) { vespamalloc_dump_info(f); });
+}
+
+// Returns an empty string if allocation sampling is not available or not enabled
+std::string get_allocation_samples_dump(MallocImpl malloc_impl) {
+    if (malloc_impl == MallocImpl::VespaMalloc && vespamalloc_dump_alloc_samples != nullptr) {
+        return dump_to_string([](FILE* f) { vespamalloc_dump_alloc_samples(f, max_sampled_stacks); });
+    }
+    if (malloc_impl == MallocImpl::MiMalloc && vespalib::mi_malloc_allocation_sample_interval() != 0) {
+        return dump_to_string([](FILE* f) { vespalib::dump_mi_malloc_allocation_samples(f, max_sampled_stacks); });
+    }
+    return {};
+}
+
 #ifdef __GLIBC__
 // mallinfo() and mallinfo2() only differ in the type of the underlying
 // struct fields (int vs size_t, respectively).
@@ -111,13 +129,17 @@ void dump_mallinfo(Cursor& parent) {
 
 #endif // __GLIBC__
 
-void emit_malloc_internal_info_dump(Cursor& parent, std::string_view info_dump) {
+void emit_lines(Cursor& parent, std::string_view name, std::string_view dump) {
     // Emit as JSON array of strings with one entry per line.
     // This is a lot easier to read than a single raw, newline-escaped string.
-    Cursor& lines_arr = parent.setArray("internal_info");
-    for (const auto line : std::views::split(info_dump, "\n"sv)) {
+    Cursor& lines_arr = parent.setArray(name);
+    for (const auto line : std::views::split(dump, "\n"sv)) {
         lines_arr.addString(std::string_view(line));
     }
+}
+
+void emit_malloc_internal_info_dump(Cursor& parent, std::string_view info_dump) {
+    emit_lines(parent, "internal_info", info_dump);
     // Also emit the raw string to make tooling easier (no need to collapse array).
     parent.setString("raw_internal_info", info_dump);
 }
@@ -140,6 +162,10 @@ void MallocInfoExplorer::get_state(const Inserter& inserter, bool full) const {
     if (malloc_impl == MallocImpl::VespaMalloc) {
         emit_malloc_internal_info_dump(object, get_vespamalloc_info_dump());
     }
+    auto samples = get_allocation_samples_dump(malloc_impl);
+    if (!samples.empty()) {
+        emit_lines(object, "allocation_samples", samples);
+    }
 #else
     (void) object;
 #endif // __linux__
@@ -14,6 +14,8 @@ namespace proton {
  *      by the platform).
  *   2. Malloc-implementation specific information for implementations we know about.
  *      Currently only covers vespamalloc.
+ *   3. The most allocating call stacks, if allocation sampling is enabled in vespamalloc
+ *      (alloc_sample_interval in vespamalloc.conf) or mimalloc (VESPA_MIMALLOC_SAMPLE_INTERVAL).
  */
 class MallocInfoExplorer : public vespalib::StateExplorer {
 public:
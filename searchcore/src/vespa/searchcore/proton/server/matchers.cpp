@@ -2,11 +2,13 @@
 
 #include "matchers.h"
 #include <vespa/searchcore/proton/matching/matcher.h>
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
 #include <vespa/searchlib/fef/onnx_models.h>
 #include <vespa/searchlib/fef/ranking_expressions.h>
 #include <vespa/vespalib/util/issue.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
 
 namespace proton {
 
@@ -19,11 +21,18 @@ using namespace vespalib::make_string_short;
 Matchers::Matchers(const std::atomic<vespalib::steady_time> & now_ref,
                    matching::QueryLimiter &queryLimiter,
                    const search::fef::RankingAssetsRepo &rankingAssetsRepo)
+    : Matchers(now_ref, queryLimiter, std::make_shared<const search::fef::RankingAssetsRepo>(rankingAssetsRepo))
+{ }
+
+Matchers::Matchers(const std::atomic<vespalib::steady_time> & now_ref,
+                   matching::QueryLimiter &queryLimiter,
+                   std::shared_ptr<const search::fef::RankingAssetsRepo> rankingAssetsRepo)
     : _rpmap(),
-      _ranking_assets_repo(rankingAssetsRepo),
+      _ranking_assets_repo(std::move(rankingAssetsRepo)),
       _fallback(std::make_shared<Matcher>(search::index::Schema(), search::fef::Properties(), now_ref, queryLimiter,
-                                          _ranking_assets_repo, -1)),
-      _default()
+                                          *_ranking_assets_repo, -1)),
+      _default(),
+      _result_cache()
 { }
 
 Matchers::~Matchers() = default;
@@ -70,4 +79,23 @@ Matchers::lookup(const std::string &name) const
     return found->second;
 }
 
+std::shared_ptr<Matcher>
+Matchers::find(const std::string &name) const
+{
+    auto found = _rpmap.find(name);
+    return (found != _rpmap.end()) ? found->second : std::shared_ptr<Matcher>();
+}
+
+std::vector<std::string>
+Matchers::get_rank_profile_names() const
+{
+    std::vector<std::string> names;
+    names.reserve(_rpmap.size());
+    for (const auto & entry : _rpmap) {
+        names.push_back(entry.first);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
 } // namespace proton
@@ -11,20 +11,26 @@ namespace proton {
 namespace matching {
     class Matcher;
     class QueryLimiter;
+    class QueryResultCache;
 }
 
 class Matchers {
 private:
     using Map = vespalib::hash_map<std::string, std::shared_ptr<matching::Matcher>>;
     Map                                  _rpmap;
-    const search::fef::RankingAssetsRepo _ranking_assets_repo;
+    std::shared_ptr<const search::fef::RankingAssetsRepo> _ranking_assets_repo;
     std::shared_ptr<matching::Matcher>   _fallback;
     std::shared_ptr<matching::Matcher>   _default;
+    std::shared_ptr<matching::QueryResultCache> _result_cache;
 public:
     using SP = std::shared_ptr<Matchers>;
     Matchers(const std::atomic<vespalib::steady_time> & now_ref,
              matching::QueryLimiter &queryLimiter,
              const search::fef::RankingAssetsRepo &rankingAssetsRepo);
+    // Shares ranking assets with other matchers, needed to reuse their matcher instances
+    Matchers(const std::atomic<vespalib::steady_time> & now_ref,
+             matching::QueryLimiter &queryLimiter,
+             std::shared_ptr<const search::fef::RankingAssetsRepo> rankingAssetsRepo);
     Matchers(const Matchers &) = delete;
     Matchers & operator =(const Matchers &) = delete;
     ~Matchers();
@@ -32,7 +38,15 @@ public:
     matching::MatchingStats getStats() const;
     matching::MatchingStats getStats(const std::string &name) const;
     std::shared_ptr<matching::Matcher> lookup(const std::string &name) const;
-    const search::fef::RankingAssetsRepo& get_ranking_assets_repo() const noexcept { return _ranking_assets_repo; }
+    // exact lookup without fallback; nullptr if the rank profile is unknown
+    std::shared_ptr<matching::Matcher> find(const std::string &name) const;
+    std::vector<std::string> get_rank_profile_names() const;
+    const search::fef::RankingAssetsRepo& get_ranking_assets_repo() const noexcept { return *_ranking_assets_repo; }
+    const std::shared_ptr<const search::fef::RankingAssetsRepo>& get_shared_ranking_assets_repo() const noexcept {
+        return _ranking_assets_repo;
+    }
+    void set_result_cache(std::shared_ptr<matching::QueryResultCache> cache) noexcept { _result_cache = std::move(cache); }
+    matching::QueryResultCache *get_result_cache() const noexcept { return _result_cache.get(); }
 };
 
 } // namespace proton
@@ -0,0 +1,83 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "matchers_explorer.h"
+#include "matchers.h"
+#include <vespa/searchcore/proton/matching/matcher.h>
+#include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/data/slime/inserter.h>
+
+using proton::matching::Matcher;
+using vespalib::slime::Cursor;
+using vespalib::slime::Inserter;
+using vespalib::StateExplorer;
+
+namespace proton {
+
+namespace {
+
+const std::string RESET = "reset";
+
+class ResetProfilesExplorer : public StateExplorer
+{
+private:
+    std::shared_ptr<Matcher> _matcher;
+
+public:
+    ResetProfilesExplorer(std::shared_ptr<Matcher> matcher) : _matcher(std::move(matcher)) {}
+    void get_state(const Inserter &inserter, bool) const override {
+        Cursor &state = inserter.insertObject();
+        state.setLong("sampled_queries", _matcher->get_aggregated_profiles().sampled_queries());
+        _matcher->get_aggregated_profiles().reset();
+        state.setBool("reset", true);
+    }
+};
+
+class MatcherProfilesExplorer : public StateExplorer
+{
+private:
+    std::shared_ptr<Matcher> _matcher;
+
+public:
+    MatcherProfilesExplorer(std::shared_ptr<Matcher> matcher) : _matcher(std::move(matcher)) {}
+    void get_state(const Inserter &inserter, bool full) const override {
+        _matcher->get_aggregated_profiles().report(inserter.insertObject(), full);
+    }
+    std::unique_ptr<StateExplorer> get_child(std::string_view name) const override {
+        if (name == RESET) {
+            return std::make_unique<ResetProfilesExplorer>(_matcher);
+        }
+        return {};
+    }
+};
+
+}
+
+MatchersExplorer::MatchersExplorer(std::shared_ptr<Matchers> matchers)
+    : _matchers(std::move(matchers))
+{
+}
+
+MatchersExplorer::~MatchersExplorer() = default;
+
+void
+MatchersExplorer::get_state(const Inserter &, bool) const
+{
+}
+
+std::vector<std::string>
+MatchersExplorer::get_children_names() const
+{
+    return _matchers->get_rank_profile_names();
+}
+
+std::unique_ptr<StateExplorer>
+MatchersExplorer::get_child(std::string_view name) const
+{
+    auto matcher = _matchers->find(std::string(name));
+    if (matcher) {
+        return std::make_unique<MatcherProfilesExplorer>(std::move(matcher));
+    }
+    return {};
+}
+
+}
@@ -0,0 +1,30 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/net/http/state_explorer.h>
+
+namespace proton {
+
+class Matchers;
+
+/**
+ * Class used to explore the profiles aggregated by the matchers of a
+ * document sub database, one child per rank profile. The aggregated
+ * profiles of a rank profile are cleared by exploring its (unlisted)
+ * 'reset' child.
+ */
+class MatchersExplorer : public vespalib::StateExplorer
+{
+private:
+    std::shared_ptr<Matchers> _matchers;
+
+public:
+    MatchersExplorer(std::shared_ptr<Matchers> matchers);
+    ~MatchersExplorer() override;
+    void get_state(const vespalib::slime::Inserter &inserter, bool full) const override;
+    std::vector<std::string> get_children_names() const override;
+    std::unique_ptr<vespalib::StateExplorer> get_child(std::string_view name) const override;
+};
+
+}
@@ -3,7 +3,10 @@
 #include "matchview.h"
 #include "searchcontext.h"
 #include <vespa/searchcore/proton/attribute/i_attribute_manager.h>
+#include <vespa/searchcore/proton/matching/grouping_result_cache.h>
 #include <vespa/searchcore/proton/matching/matcher.h>
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
+#include <vespa/searchcore/proton/matching/sessionmanager.h>
 #include <vespa/searchlib/engine/searchrequest.h>
 #include <vespa/searchlib/engine/searchreply.h>
 #include <vespa/vespalib/util/stringfmt.h>
@@ -13,6 +16,8 @@
 LOG_SETUP(".proton.server.matchview");
 
 using proton::matching::MatchContext;
+using proton::matching::GroupingResultCache;
+using proton::matching::QueryResultCache;
 using proton::matching::SearchSession;
 using search::AttributeGuard;
 using search::AttributeVector;
@@ -67,13 +72,50 @@ MatchView::match(std::shared_ptr<const ISearchHandler> searchHandler, const Sear
                  vespalib::ThreadBundle &threadBundle) const
 {
     Matcher::SP matcher = getMatcher(req.ranking);
+    QueryResultCache *cache = _matchers->get_result_cache();
+    if ((cache != nullptr) && QueryResultCache::is_cacheable(req)) {
+        // Sample the generation before matching, so that a commit during matching prevents caching the reply
+        uint64_t generation = _docIdLimit.getCommitGeneration();
+        std::string key = QueryResultCache::make_key(req);
+        auto cached = cache->lookup(key, generation);
+        matcher->count_result_cache_lookup(static_cast<bool>(cached));
+        if (cached) {
+            return cached;
+        }
+        auto reply = match_uncached(std::move(searchHandler), req, threadBundle, *matcher);
+        if (!reply->coverage.wasDegradedByTimeout()) {
+            cache->insert(key, generation, *reply);
+        }
+        return reply;
+    }
+    GroupingResultCache *grouping_cache = _sessionMgr.getGroupingResultCache();
+    if ((grouping_cache != nullptr) && GroupingResultCache::is_cacheable(req)) {
+        uint64_t generation = _docIdLimit.getCommitGeneration();
+        std::string key = GroupingResultCache::make_key(&_docIdLimit, req);
+        auto cached = grouping_cache->lookup(key, generation, vespalib::steady_clock::now());
+        if (cached) {
+            return cached;
+        }
+        auto reply = match_uncached(std::move(searchHandler), req, threadBundle, *matcher);
+        if (!reply->coverage.wasDegradedByTimeout()) {
+            grouping_cache->insert(key, generation, vespalib::steady_clock::now(), *reply);
+        }
+        return reply;
+    }
+    return match_uncached(std::move(searchHandler), req, threadBundle, *matcher);
+}
+
+std::unique_ptr<SearchReply>
+MatchView::match_uncached(std::shared_ptr<const ISearchHandler> searchHandler, const SearchRequest &req,
+                          vespalib::ThreadBundle &threadBundle, Matcher &matcher) const
+{
     SearchSession::OwnershipBundle owned_objects(createContext(), std::move(searchHandler));
     owned_objects.readGuard = _metaStore->getReadGuard();
     ISearchContext & search_ctx = owned_objects.context.getSearchContext();
     IAttributeContext & attribute_ctx = owned_objects.context.getAttributeContext();
     const search::IDocumentMetaStore & dms = owned_objects.readGuard->get();
     const bucketdb::BucketDBOwner & bucketDB = _metaStore->get().getBucketDB();
-    return matcher->match(req, threadBundle, search_ctx, attribute_ctx,
+    return matcher.match(req, threadBundle, search_ctx, attribute_ctx,
                           _sessionMgr, dms, bucketDB, std::move(owned_objects));
 }
 
@@ -32,6 +32,12 @@ class MatchView {
         return _metaStore->get().getNumActiveLids();
     }
 
+    std::unique_ptr<search::engine::SearchReply>
+    match_uncached(std::shared_ptr<const ISearchHandler> searchHandler,
+                   const search::engine::SearchRequest &req,
+                   vespalib::ThreadBundle &threadBundle,
+                   matching::Matcher &matcher) const;
+
 public:
     using SP = std::shared_ptr<MatchView>;
     MatchView(const MatchView &) = delete;
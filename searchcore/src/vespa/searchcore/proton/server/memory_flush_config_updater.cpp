@@ -161,7 +161,8 @@ MemoryFlushConfigUpdater::convertConfig(const ProtonConfig::Flush::Memory &confi
                                config.diskbloatfactor,
                                eachMaxMemory,
                                config.each.diskbloatfactor,
-                               vespalib::from_s(config.maxage.time));
+                               vespalib::from_s(config.maxage.time),
+                               config.gainperwrittenbyte);
 }
 
 } // namespace proton
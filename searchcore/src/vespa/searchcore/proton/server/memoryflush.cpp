@@ -7,6 +7,7 @@
 #include <vespa/vespalib/stllike/hash_set.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/time.h>
+#include <algorithm>
 #include <cinttypes>
 
 #include <vespa/log/log.h>
@@ -43,6 +44,18 @@ estimateNeededTlsSizeForFlushTarget(const TlsStats &tlsStats, SerialNum flushedS
     return bytesPerEntry * (tlsStats.getLastSerial() - flushedSerialNum);
 }
 
+/*
+ * Memory gain per byte written to disk when flushing the target. Small writes are
+ * counted as 1 MiB to avoid favoring targets that don't report bytes to write.
+ */
+double
+memoryGainPerWrittenByte(const IFlushTarget &target)
+{
+    constexpr uint64_t min_bytes_to_write = 1_Mi;
+    uint64_t bytes_to_write = std::max(target.getApproxBytesToWriteToDisk(), min_bytes_to_write);
+    return static_cast<double>(target.getApproxMemoryGain().gain()) / bytes_to_write;
+}
+
 }
 
 MemoryFlush::Config::Config()
@@ -51,7 +64,8 @@ MemoryFlush::Config::Config()
       globalDiskBloatFactor(0.2),
       maxMemoryGain(1000_Mi),
       diskBloatFactor(0.2),
-      maxTimeGain(std::chrono::hours(24))
+      maxTimeGain(std::chrono::hours(24)),
+      memoryGainPerWrittenByte(false)
 { }
 
 
@@ -60,13 +74,15 @@ MemoryFlush::Config::Config(uint64_t maxGlobalMemory_in,
                             double globalDiskBloatFactor_in,
                             uint64_t maxMemoryGain_in,
                             double diskBloatFactor_in,
-                            vespalib::duration maxTimeGain_in)
+                            vespalib::duration maxTimeGain_in,
+                            bool memoryGainPerWrittenByte_in)
     : maxGlobalMemory(maxGlobalMemory_in),
       maxGlobalTlsSize(maxGlobalTlsSize_in),
       globalDiskBloatFactor(globalDiskBloatFactor_in),
       maxMemoryGain(maxMemoryGain_in),
       diskBloatFactor(diskBloatFactor_in),
-      maxTimeGain(maxTimeGain_in)
+      maxTimeGain(maxTimeGain_in),
+      memoryGainPerWrittenByte(memoryGainPerWrittenByte_in)
 { }
 
 std::string
@@ -77,7 +93,8 @@ MemoryFlush::Config::toString() const {
     os << "globalDiskBloatFactor=" << globalDiskBloatFactor << " ";
     os << "maxMemoryGain=" << maxMemoryGain << " ";
     os << "diskBloatFactor=" << diskBloatFactor << " ";
-    os << "maxTimeGain(ns)=" << maxTimeGain.count();
+    os << "maxTimeGain(ns)=" << maxTimeGain.count() << " ";
+    os << "memoryGainPerWrittenByte=" << (memoryGainPerWrittenByte ? "true" : "false");
     return os.str();
 }
 
@@ -205,7 +222,7 @@ MemoryFlush::getFlushTargets(const FlushContext::List& targetList,
         }
     }
     FlushContext::List fv(targetList);
-    std::sort(fv.begin(), fv.end(), CompareTarget(order, tlsStatsMap));
+    std::sort(fv.begin(), fv.end(), CompareTarget(order, tlsStatsMap, config.memoryGainPerWrittenByte));
     // No desired order and no urgent needs; no flush required at this moment.
     if (order == DEFAULT &&
         !fv.empty() &&
@@ -243,6 +260,9 @@ MemoryFlush::CompareTarget::operator()(const FlushContext::SP &lfc, const FlushC
 
     switch (_order) {
     case MEMORY:
+        if (_memoryGainPerWrittenByte) {
+            return (memoryGainPerWrittenByte(lhs) > memoryGainPerWrittenByte(rhs));
+        }
         return (lhs.getApproxMemoryGain().gain() > rhs.getApproxMemoryGain().gain());
     case TLSSIZE: {
         const flushengine::TlsStats &lhsTlsStats = _tlsStatsMap.getTlsStats(lfc->getHandler()->getName());
@@ -27,13 +27,17 @@ public:
 
         /// Maximum age of unflushed data.
         vespalib::duration maxTimeGain;
+        /// When flushing due to memory, order targets by memory gain per byte
+        /// written to disk instead of by memory gain.
+        bool              memoryGainPerWrittenByte;
         Config();
         Config(uint64_t maxGlobalMemory_in,
                uint64_t maxGlobalTlsSize_in,
                double globalDiskBloatFactor_in,
                uint64_t maxMemoryGain_in,
                double diskBloatFactor_in,
-               vespalib::duration maxTimeGain_in);
+               vespalib::duration maxTimeGain_in,
+               bool memoryGainPerWrittenByte_in = false);
         bool operator == (const Config & rhs) const { return equal(rhs); }
         bool operator != (const Config & rhs) const { return ! equal(rhs); }
         bool equal(const Config & rhs) const {
@@ -42,7 +46,8 @@ public:
                    (globalDiskBloatFactor == rhs.globalDiskBloatFactor) &&
                    (maxMemoryGain == rhs.maxMemoryGain) &&
                    (maxTimeGain == rhs.maxTimeGain) &&
-                   (diskBloatFactor == rhs. diskBloatFactor);
+                   (diskBloatFactor == rhs. diskBloatFactor) &&
+                   (memoryGainPerWrittenByte == rhs.memoryGainPerWrittenByte);
         }
         std::string toString() const;
     };
@@ -59,15 +64,17 @@ private:
     class CompareTarget
     {
     public:
-        CompareTarget(OrderType order, const flushengine::TlsStatsMap &tlsStatsMap)
+        CompareTarget(OrderType order, const flushengine::TlsStatsMap &tlsStatsMap, bool memoryGainPerWrittenByte)
             : _order(order),
-              _tlsStatsMap(tlsStatsMap)
+              _tlsStatsMap(tlsStatsMap),
+              _memoryGainPerWrittenByte(memoryGainPerWrittenByte)
         { }
 
         bool operator ()(const FlushContext::SP &lfc, const FlushContext::SP &rfc) const;
     private:
         OrderType     _order;
         const flushengine::TlsStatsMap &_tlsStatsMap;
+        bool          _memoryGainPerWrittenByte;
     };
 
 public:
@@ -54,6 +54,24 @@ PersistenceHandlerProxy::handleRemove(FeedToken token, const Bucket &bucket, Tim
     _feedHandler.handleOperation(std::move(token), std::move(op));
 }
 
+void
+PersistenceHandlerProxy::handleFeedBatch(const Bucket &bucket, FeedBatch batch)
+{
+    std::vector<std::pair<FeedToken, FeedOperation::UP>> ops;
+    ops.reserve(batch.size());
+    for (auto &entry : batch) {
+        const auto &op = entry.second;
+        FeedOperation::UP feed_op;
+        if (op.is_put()) {
+            feed_op = std::make_unique<PutOperation>(bucket.getBucketId().stripUnused(), op.timestamp(), op.document());
+        } else {
+            feed_op = std::make_unique<RemoveOperationWithDocId>(bucket.getBucketId().stripUnused(), op.timestamp(), op.document_id());
+        }
+        ops.emplace_back(std::move(entry.first), std::move(feed_op));
+    }
+    _feedHandler.handleOperations(std::move(ops));
+}
+
 void
 PersistenceHandlerProxy::handleRemoveByGid(FeedToken token, const storage::spi::Bucket &bucket, Timestamp timestamp, std::string_view doc_type, const document::GlobalId& gid)
 {
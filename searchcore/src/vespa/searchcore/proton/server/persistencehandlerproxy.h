@@ -35,6 +35,7 @@ public:
     void handleRemove(FeedToken token, const storage::spi::Bucket &bucket,
                       storage::spi::Timestamp timestamp,
                       const document::DocumentId &id) override;
+    void handleFeedBatch(const storage::spi::Bucket &bucket, FeedBatch batch) override;
     void handleRemoveByGid(FeedToken token, const storage::spi::Bucket &bucket,
                            storage::spi::Timestamp timestamp,
                            std::string_view doc_type, const document::GlobalId& gid) override;
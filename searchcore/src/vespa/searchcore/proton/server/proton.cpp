@@ -43,10 +43,12 @@
 #include <vespa/searchlib/attribute/interlock.h>
 #include <vespa/searchlib/common/packets.h>
 #include <vespa/searchlib/diskindex/posting_list_cache.h>
+#include <vespa/searchlib/diskindex/posting_list_cache_snapshot.h>
 #include <vespa/searchlib/transactionlog/trans_log_server_explorer.h>
 #include <vespa/searchlib/transactionlog/translogserverapp.h>
 #include <vespa/searchlib/util/fileheadertk.h>
 #include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/datastore/compaction_context.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/net/http/state_server.h>
 #include <vespa/vespalib/util/blockingthreadstackexecutor.h>
@@ -54,6 +56,7 @@
 #include <vespa/vespalib/util/host_name.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/mmap_file_allocator_factory.h>
+#include <vespa/vespalib/util/numa_topology.h>
 #include <vespa/vespalib/util/random.h>
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
 #include <vespa/vespalib/util/shared_operation_throttler.h>
@@ -63,6 +66,7 @@
 #include <malloc.h>
 #endif
 
+#include <filesystem>
 #include <sstream>
 
 #include <vespa/log/log.h>
@@ -74,6 +78,7 @@ using document::DocumentTypeRepo;
 using proton::flushengine::SetStrategyResult;
 using search::diskindex::IPostingListCache;
 using search::diskindex::PostingListCache;
+using search::diskindex::PostingListCacheSnapshot;
 using search::engine::MonitorReply;
 using search::transactionlog::DomainStats;
 using vespa::config::search::core::ProtonConfig;
@@ -83,6 +88,7 @@ using vespalib::FileHeader;
 using vespalib::IllegalStateException;
 using vespalib::Slime;
 using vespalib::compression::CompressionConfig;
+using vespalib::coro::AsyncIo;
 using vespalib::makeLambdaTask;
 using vespalib::slime::ArrayInserter;
 using vespalib::slime::Cursor;
@@ -172,8 +178,8 @@ void ensureWritableDir(const std::string &dirName) {
     probe.unlink();
 }
 
-std::shared_ptr<IPostingListCache>
-make_posting_list_cache(const ProtonConfig& cfg)
+std::shared_ptr<PostingListCache>
+make_posting_list_cache(const ProtonConfig& cfg, std::optional<AsyncIo::Owner>& async_io)
 {
     int64_t posting_max_bytes = cfg.index.cache.postinglist.maxbytes;
     if (posting_max_bytes == -1) { // Force memory map posting lists, cf. BootstrapConfigManager::update
@@ -190,7 +196,12 @@ make_posting_list_cache(const ProtonConfig& cfg)
                                                cfg.index.cache.postinglist.slruProtectedSegmentRatio,
                                                cfg.index.cache.bitvector.slruProtectedSegmentRatio,
                                                posting_lfu_max_element_count, bitvector_lfu_max_element_count);
-    return std::make_shared<PostingListCache>(params);
+    auto cache = std::make_shared<PostingListCache>(params);
+    if (cfg.index.cache.asyncReads && (cache->enabled_for_posting_lists() || cache->enabled_for_bitvectors())) {
+        async_io.emplace(AsyncIo::create(AsyncIo::ImplTag::URING));
+        cache->set_async_io(async_io->share());
+    }
+    return cache;
 }
 
 ReplayThrottlingPolicy
@@ -321,6 +332,8 @@ Proton::Proton(FNET_Transport & transport, const config::ConfigUri & configUri,
       _nodeUpLock(),
       _nodeUp(),
       _posting_list_cache(),
+      _posting_list_async_io(),
+      _posting_list_cache_snapshot_file(),
       _lid_space_compaction_job_token_source(std::make_shared<MaintenanceJobTokenSource>()),
       _shared_replay_throttler(vespalib::SharedOperationThrottler::make_unlimited_throttler())
 { }
@@ -354,20 +367,30 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _write_filter = std::make_shared<ResourceUsageWriteFilter>(hwInfo);
     _resource_usage_notifier = std::make_shared<ResourceUsageNotifier>(*_write_filter);
     _diskMemUsageSampler = std::make_unique<DiskMemUsageSampler>(protonConfig.basedir, *_write_filter, *_resource_usage_notifier);
-    _posting_list_cache = make_posting_list_cache(protonConfig);
+    _posting_list_cache = make_posting_list_cache(protonConfig, _posting_list_async_io);
 
     _tls = std::make_unique<TLS>(_configUri.createWithNewId(protonConfig.tlsconfigid), _fileHeaderContext);
     _metricsEngine->addMetricsHook(*_metricsHook);
     _fileHeaderContext.setClusterName(protonConfig.clustername, protonConfig.basedir);
+    auto numa = protonConfig.numa.pinThreads ? vespalib::NumaTopology::discover() : vespalib::NumaTopology();
+    if (numa.is_multi_node()) {
+        LOG(info, "Pinning search, summary and shared threads to %u NUMA nodes", numa.num_nodes());
+    }
     _matchEngine = std::make_unique<MatchEngine>(protonConfig.numsearcherthreads,
                                                  getNumThreadsPerSearch(),
                                                  protonConfig.distributionkey,
-                                                 protonConfig.search.async);
+                                                 protonConfig.search.async, numa,
+                                                 vespalib::from_s(protonConfig.search.threadbundle.spintime));
     _matchEngine->set_issue_forwarding(protonConfig.forwardIssues);
     _distributionKey = protonConfig.distributionkey;
-    _summaryEngine = std::make_unique<SummaryEngine>(protonConfig.numsummarythreads, protonConfig.docsum.async);
+    _summaryEngine = std::make_unique<SummaryEngine>(protonConfig.numsummarythreads,
+                                                     std::max(1, protonConfig.numthreadsperdocsum),
+                                                     protonConfig.docsum.async, numa);
     _summaryEngine->set_issue_forwarding(protonConfig.forwardIssues);
-    _sessionManager = std::make_unique<matching::SessionManager>(protonConfig.grouping.sessionmanager.maxentries);
+    const auto & session_config = protonConfig.grouping.sessionmanager;
+    _sessionManager = std::make_unique<matching::SessionManager>(session_config.maxentries,
+                                                                 session_config.resultcache.maxbytes,
+                                                                 vespalib::from_s(session_config.resultcache.ttl));
 
     IFlushStrategy::SP strategy;
     const ProtonConfig::Flush & flush(protonConfig.flush);
@@ -391,6 +414,7 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _tls->start(_transport, hwInfo.cpu().cores());
     _flushEngine = std::make_unique<FlushEngine>(std::make_shared<flushengine::TlsStatsFactory>(_tls->getTransLogServer()),
                                                  strategy, flush.maxconcurrent, vespalib::from_s(flush.idleinterval));
+    _flushEngine->set_max_pending_write_bytes(flush.maxpendingwritebytes);
     _metricsEngine->addExternalMetrics(_summaryEngine->getMetrics());
 
     LOG(debug, "Start proton server with root at %s and cwd at %s",
@@ -400,11 +424,14 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
                                                              *_resource_usage_notifier,
                                                              protonConfig.visit.defaultserializedsize,
                                                              protonConfig.visit.ignoremaxbytes);
+    _persistenceEngine->configure_visit_read_ahead(std::max(int64_t(0), protonConfig.visit.readaheadbytes),
+                                                   std::max(0, protonConfig.visit.readaheadthreads));
     auto resource_usage_tracker = _persistenceEngine->get_resource_usage_tracker().shared_from_this();
     _attribute_usage_notifier = std::make_shared<AttributeUsageNotifier>(_resource_usage_notifier);
     _shared_service = std::make_unique<SharedThreadingService>(
-            SharedThreadingServiceConfig::make(protonConfig, hwInfo.cpu()), _transport, *_persistenceEngine);
+            SharedThreadingServiceConfig::make(protonConfig, hwInfo.cpu()), _transport, *_persistenceEngine, numa);
     _scheduler = std::make_unique<ScheduledForwardExecutor>(_transport, _shared_service->shared());
+    vespalib::datastore::CompactionContext::set_helper_executor(&_shared_service->shared());
     _diskMemUsageSampler->setConfig(diskMemUsageSamplerConfig(protonConfig, hwInfo), *_scheduler);
     auto replay_throttle_policy = make_replay_throttling_policy(protonConfig.replayThrottlingPolicy, _hw_info);
     if (replay_throttle_policy.get_params()) {
@@ -414,6 +441,12 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
 
     std::string fileConfigId;
     _compile_cache_executor_binding = vespalib::eval::CompileCache::bind(_shared_service->shared_raw());
+    if (protonConfig.ranking.compilecache.persistent) {
+        auto compile_cache_dir = protonConfig.basedir + "/compile-cache";
+        std::filesystem::create_directories(std::filesystem::path(compile_cache_dir));
+        ensureWritableDir(compile_cache_dir);
+        vespalib::eval::CompileCache::set_persistent_dir(compile_cache_dir);
+    }
 
     InitializeThreadsCalculator calc(hwInfo.cpu(), protonConfig.basedir, protonConfig.initialize.threads);
     LOG(info, "Start initializing components: threads=%u, configured=%u",
@@ -424,6 +457,7 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _prepareRestartHandler = std::make_unique<PrepareRestartHandler>(*_flushEngine);
     RPCHooks::Params rpcParams(*this, protonConfig.rpcport, _configUri, protonConfig.slobrokconfigid,
                                std::max(2u, computeRpcTransportThreads(protonConfig, hwInfo.cpu())));
+    rpcParams.priorityStreakLimit = std::max(0, protonConfig.rpc.priorityStreakLimit);
     _rpcHooks = std::make_unique<RPCHooks>(rpcParams);
     _metricsEngine->addExternalMetrics(_rpcHooks->proto_rpc_adapter_metrics());
 
@@ -452,11 +486,58 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _sessionPruneHandle = _scheduler->scheduleAtFixedRate(makeLambdaTask([&]() {
         _sessionManager->pruneTimedOutSessions(vespalib::steady_clock::now(), _shared_service->shared());
     }), pruneSessionsInterval, pruneSessionsInterval);
+    start_posting_list_cache_snapshots(protonConfig);
     _isInitializing = false;
     _protonConfigurer.setAllowReconfig(true);
     _initComplete = true;
 }
 
+void
+Proton::start_posting_list_cache_snapshots(const ProtonConfig & protonConfig)
+{
+    // All disk indexes have been loaded, entries in the snapshot for other disk indexes are skipped
+    vespalib::duration interval = vespalib::from_s(protonConfig.index.cache.snapshot.interval);
+    if (interval <= vespalib::duration::zero() || !_posting_list_cache ||
+        (!_posting_list_cache->enabled_for_posting_lists() && !_posting_list_cache->enabled_for_bitvectors())) {
+        return;
+    }
+    _posting_list_cache_snapshot_file = protonConfig.basedir + "/posting_list_cache.snapshot";
+    auto snapshot = PostingListCacheSnapshot::load(_posting_list_cache_snapshot_file);
+    if (snapshot) {
+        LOG(info, "Reading %zu posting lists and bitvectors from cache snapshot '%s' into cache",
+            snapshot->num_entries(), _posting_list_cache_snapshot_file.c_str());
+        _posting_list_cache->start_warmup(std::move(snapshot));
+        // Spread the reads over the second to bound the io rate
+        constexpr int64_t warmup_steps_per_second = 10;
+        uint64_t max_bytes = std::max(protonConfig.index.cache.snapshot.warmupMaxBytesPerSecond / warmup_steps_per_second,
+                                      INT64_C(1));
+        vespalib::duration warmup_interval = std::chrono::milliseconds(1000 / warmup_steps_per_second);
+        _posting_list_cache_warmup_handle = _scheduler->scheduleAtFixedRate(makeLambdaTask([this, max_bytes]() {
+            _posting_list_cache->warmup(max_bytes);
+        }), warmup_interval, warmup_interval);
+    }
+    _posting_list_cache_snapshot_handle = _scheduler->scheduleAtFixedRate(makeLambdaTask([this]() {
+        save_posting_list_cache_snapshot();
+    }), interval, interval);
+}
+
+void
+Proton::save_posting_list_cache_snapshot()
+{
+    if (_posting_list_cache_snapshot_file.empty() || !_initComplete) {
+        return;
+    }
+    if (_posting_list_cache->get_warmup_stats().active) {
+        // Keep the old snapshot, the cache does not yet contain all of its entries
+        return;
+    }
+    auto snapshot = _posting_list_cache->make_snapshot();
+    if (snapshot->save(_posting_list_cache_snapshot_file)) {
+        LOG(debug, "Saved %zu posting lists and bitvectors to cache snapshot '%s'",
+            snapshot->num_entries(), _posting_list_cache_snapshot_file.c_str());
+    }
+}
+
 BootstrapConfig::SP
 Proton::getActiveConfigSnapshot() const
 {
@@ -475,6 +556,9 @@ Proton::applyConfig(const BootstrapConfig::SP & configSnapshot)
     _queryLimiter.configure(protonConfig.search.memory.limiter.maxthreads,
                             protonConfig.search.memory.limiter.mincoverage,
                             protonConfig.search.memory.limiter.minhits);
+    _queryLimiter.configure_admission(protonConfig.search.admission.maxqueries,
+                                      vespalib::from_s(protonConfig.search.admission.targetdelay),
+                                      vespalib::from_s(protonConfig.search.admission.interval));
     const std::shared_ptr<const DocumentTypeRepo> repo = configSnapshot->getDocumentTypeRepoSP();
 
     _diskMemUsageSampler->setConfig(diskMemUsageSamplerConfig(protonConfig, configSnapshot->getHwInfo()), *_scheduler);
@@ -541,6 +625,9 @@ Proton::~Proton()
         _resource_usage_notifier->remove_resource_usage_listener(_memoryFlushConfigUpdater.get());
     }
     _sessionPruneHandle.reset();
+    _posting_list_cache_warmup_handle.reset();
+    _posting_list_cache_snapshot_handle.reset();
+    save_posting_list_cache_snapshot();
     if (_diskMemUsageSampler) {
         _diskMemUsageSampler->close();
     }
@@ -575,9 +662,11 @@ Proton::~Proton()
     }
     _sessionManager.reset();
     _documentDBMap.clear();
+    _posting_list_async_io.reset();
     _persistenceEngine.reset();
     _tls.reset();
     _compile_cache_executor_binding.reset();
+    vespalib::datastore::CompactionContext::set_helper_executor(nullptr);
     _shared_service.reset();
     LOG(debug, "Explicit destructor done");
 }
@@ -1039,6 +1128,8 @@ const std::string HW_INFO = "hwinfo";
 const std::string SESSION = "session";
 const std::string CACHE_NAME = "cache";
 const std::string MALLOC_INFO = "mallocinfo";
+const std::string COMPILE_CACHE = "compilecache";
+const std::string TRANSPORT = "transport";
 
 struct StateExplorerProxy : vespalib::StateExplorer {
     const StateExplorer &explorer;
@@ -1082,6 +1173,15 @@ void insert_cache_stats(Cursor& object, const vespalib::CacheStats& stats)
     object.setLong("lookups", stats.lookups());
 }
 
+void insert_warmup_stats(Cursor& object, const IPostingListCache::WarmupStats& stats)
+{
+    object.setBool("active", stats.active);
+    object.setLong("pending", stats.pending);
+    object.setLong("prefetched", stats.prefetched);
+    object.setLong("skipped", stats.skipped);
+    object.setLong("read_bytes", stats.read_bytes);
+}
+
 class CacheExplorer : public vespalib::StateExplorer {
     const IPostingListCache& _posting_list_cache;
 public:
@@ -1104,6 +1204,76 @@ CacheExplorer::get_state(const vespalib::slime::Inserter& inserter, bool full) c
     if (full) {
         insert_cache_stats(object.setObject("postinglist"), _posting_list_cache.get_stats());
         insert_cache_stats(object.setObject("bitvector"), _posting_list_cache.get_bitvector_stats());
+        insert_warmup_stats(object.setObject("warmup"), _posting_list_cache.get_warmup_stats());
+    }
+}
+
+class CompileCacheExplorer : public vespalib::StateExplorer {
+public:
+    void get_state(const vespalib::slime::Inserter& inserter, bool full) const override;
+};
+
+void
+CompileCacheExplorer::get_state(const vespalib::slime::Inserter& inserter, bool) const
+{
+    auto &object = inserter.insertObject();
+    object.setLong("cached", vespalib::eval::CompileCache::num_cached());
+    object.setLong("pending", vespalib::eval::CompileCache::count_pending());
+    auto &persistent = object.setObject("persistent");
+    auto stats = vespalib::eval::CompileCache::persistent_stats();
+    persistent.setBool("enabled", !vespalib::eval::LLVMObjectCache::get_dir().empty());
+    persistent.setLong("hits", stats.hits);
+    persistent.setLong("misses", stats.misses);
+}
+
+void
+insert_latency(vespalib::slime::Cursor &object, const fnet::LatencyHistogram::Snapshot &hist)
+{
+    object.setLong("count", hist.count());
+    object.setDouble("average_ms", vespalib::count_us(hist.average()) / 1000.0);
+    object.setDouble("p50_ms", vespalib::count_us(hist.percentile(0.5)) / 1000.0);
+    object.setDouble("p99_ms", vespalib::count_us(hist.percentile(0.99)) / 1000.0);
+    object.setDouble("p999_ms", vespalib::count_us(hist.percentile(0.999)) / 1000.0);
+    object.setDouble("max_ms", vespalib::count_us(hist.max()) / 1000.0);
+}
+
+class TransportExplorer : public vespalib::StateExplorer {
+    const FNET_Transport &_transport;
+public:
+    explicit TransportExplorer(const FNET_Transport &transport) noexcept : _transport(transport) {}
+    void get_state(const vespalib::slime::Inserter& inserter, bool full) const override;
+};
+
+void
+TransportExplorer::get_state(const vespalib::slime::Inserter& inserter, bool full) const
+{
+    auto &object = inserter.insertObject();
+    auto stats = _transport.get_buffer_pool_stats();
+    size_t cached_bytes = 0;
+    for (const auto &thread_stats: stats) {
+        cached_bytes += thread_stats.cached_bytes;
+    }
+    object.setLong("threads", stats.size());
+    object.setLong("buffer_pool_cached_bytes", cached_bytes);
+    auto latency = _transport.get_latency_stats();
+    auto &latency_object = object.setObject("latency");
+    insert_latency(latency_object.setObject("read_to_decode"), latency.read_to_decode);
+    insert_latency(latency_object.setObject("event_queue"), latency.event_queue);
+    insert_latency(latency_object.setObject("read_to_invoke"), latency.read_to_invoke);
+    insert_latency(latency_object.setObject("output_drain"), latency.output_drain);
+    auto &invoke_queue = latency_object.setObject("invoke_queue");
+    insert_latency(invoke_queue.setObject("high"), latency.invoke_queue[uint32_t(fnet::Priority::HIGH)]);
+    insert_latency(invoke_queue.setObject("normal"), latency.invoke_queue[uint32_t(fnet::Priority::NORMAL)]);
+    insert_latency(invoke_queue.setObject("low"), latency.invoke_queue[uint32_t(fnet::Priority::LOW)]);
+    if (full) {
+        auto &threads = object.setArray("thread");
+        for (const auto &thread_stats: stats) {
+            auto &pool = threads.addObject().setObject("buffer_pool");
+            pool.setLong("allocs", thread_stats.allocs);
+            pool.setLong("reused", thread_stats.reused);
+            pool.setLong("cached_bytes", thread_stats.cached_bytes);
+            pool.setLong("cached_buffers", thread_stats.cached_buffers);
+        }
     }
 }
 
@@ -1118,7 +1288,7 @@ std::vector<std::string>
 Proton::get_children_names() const
 {
     return {DOCUMENT_DB, THREAD_POOLS, MATCH_ENGINE, FLUSH_ENGINE, TLS_NAME,
-            HW_INFO, RESOURCE_USAGE, SESSION, CACHE_NAME, MALLOC_INFO};
+            HW_INFO, RESOURCE_USAGE, SESSION, CACHE_NAME, MALLOC_INFO, COMPILE_CACHE, TRANSPORT};
 }
 
 std::unique_ptr<vespalib::StateExplorer>
@@ -1152,6 +1322,10 @@ Proton::get_child(std::string_view name) const
         return std::make_unique<CacheExplorer>(*_posting_list_cache);
     } else if (name == MALLOC_INFO) {
         return std::make_unique<MallocInfoExplorer>();
+    } else if (name == COMPILE_CACHE) {
+        return std::make_unique<CompileCacheExplorer>();
+    } else if (name == TRANSPORT) {
+        return std::make_unique<TransportExplorer>(_transport);
     }
     return {};
 }
@@ -22,6 +22,7 @@
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/searchlib/engine/monitorapi.h>
 #include <vespa/eval/eval/llvm/compile_cache.h>
+#include <vespa/vespalib/coro/async_io.h>
 #include <vespa/vespalib/net/http/component_config_producer.h>
 #include <vespa/vespalib/net/http/generic_state_handler.h>
 #include <vespa/vespalib/net/http/json_get_handler.h>
@@ -29,11 +30,13 @@
 #include <vespa/vespalib/net/http/state_explorer.h>
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
 
 namespace vespalib { class StateServer; }
 namespace search {
     namespace attribute { class Interlock; }
+    namespace diskindex { class PostingListCache; }
     namespace transactionlog { class TransLogServerApp; }
 }
 namespace metrics {
@@ -124,6 +127,8 @@ private:
     std::unique_ptr<SharedThreadingService>   _shared_service;
     std::unique_ptr<matching::SessionManager> _sessionManager;
     IScheduledExecutor::Handle                _sessionPruneHandle;
+    IScheduledExecutor::Handle                _posting_list_cache_snapshot_handle;
+    IScheduledExecutor::Handle                _posting_list_cache_warmup_handle;
     std::unique_ptr<ScheduledForwardExecutor> _scheduler;
     vespalib::eval::CompileCache::ExecutorBinding::UP _compile_cache_executor_binding;
     matching::QueryLimiter          _queryLimiter;
@@ -138,7 +143,9 @@ private:
     std::shared_ptr<IDocumentDBReferenceRegistry> _documentDBReferenceRegistry;
     std::mutex                      _nodeUpLock;
     std::set<BucketSpace>           _nodeUp;   // bucketspaces where node is up
-    std::shared_ptr<search::diskindex::IPostingListCache> _posting_list_cache;
+    std::shared_ptr<search::diskindex::PostingListCache> _posting_list_cache;
+    std::optional<vespalib::coro::AsyncIo::Owner> _posting_list_async_io;
+    std::string                     _posting_list_cache_snapshot_file; // Empty if snapshots are disabled
     std::shared_ptr<MaintenanceJobTokenSource> _lid_space_compaction_job_token_source;
     std::shared_ptr<vespalib::SharedOperationThrottler> _shared_replay_throttler;
 
@@ -163,6 +170,8 @@ private:
     // Returns true if the node is up in _any_ bucket space
     bool updateNodeUp(BucketSpace bucketSpace, bool nodeUpInBucketSpace);
     void closeDocumentDBs(vespalib::ThreadStackExecutorBase & executor);
+    void start_posting_list_cache_snapshots(const ProtonConfig & protonConfig);
+    void save_posting_list_cache_snapshot();
 public:
     using UP = std::unique_ptr<Proton>;
     using SP = std::shared_ptr<Proton>;
@@ -43,6 +43,12 @@ ReconfigParams::shouldMatchersChange() const
     return _res.rankProfilesChanged || _res.rankingConstantsChanged || _res.rankingExpressionsChanged || _res.onnxModelsChanged || shouldSchemaChange();
 }
 
+bool
+ReconfigParams::canReuseUnchangedMatchers() const
+{
+    return !(_res.rankingConstantsChanged || _res.rankingExpressionsChanged || _res.onnxModelsChanged || shouldSchemaChange());
+}
+
 bool
 ReconfigParams::shouldIndexManagerChange() const
 {
@@ -18,6 +18,8 @@ public:
     bool configHasChanged() const;
     bool shouldSchemaChange() const;
     bool shouldMatchersChange() const;
+    // Matchers for rank profiles that are unchanged may be reused when only rank profiles changed
+    bool canReuseUnchangedMatchers() const;
     bool shouldIndexManagerChange() const;
     bool shouldAttributeManagerChange() const;
     bool shouldSummaryManagerChange() const;
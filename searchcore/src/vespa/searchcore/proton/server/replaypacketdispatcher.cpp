@@ -9,14 +9,24 @@ using vespalib::IllegalStateException;
 
 namespace proton {
 
+namespace {
+
+template <typename OperationType, typename ... Args>
+std::unique_ptr<FeedOperation>
+deserialize(vespalib::nbostream &is, const document::DocumentTypeRepo &repo, Args && ... args)
+{
+    auto op = std::make_unique<OperationType>(std::forward<Args>(args)...);
+    op->deserialize(is, repo);
+    return op;
+}
+
+}
+
 template <typename OperationType>
 void
-ReplayPacketDispatcher::replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry)
+ReplayPacketDispatcher::replay(const FeedOperation &op)
 {
-    op.deserialize(is, _handler.getDeserializeRepo());
-    op.setSerialNum(entry.serial());
-    store(op);
-    _handler.replay(op);
+    _handler.replay(static_cast<const OperationType &>(op));
 }
 
 
@@ -26,65 +36,51 @@ ReplayPacketDispatcher::ReplayPacketDispatcher(IReplayPacketHandler &handler)
 }
 
 
-void
-ReplayPacketDispatcher::replayEntry(const Packet::Entry &entry)
+std::unique_ptr<FeedOperation>
+ReplayPacketDispatcher::decodeEntry(const Packet::Entry &entry, const document::DocumentTypeRepo &repo)
 {
     vespalib::nbostream is(entry.data().c_str(), entry.data().size());
+    std::unique_ptr<FeedOperation> op;
     switch (entry.type()) {
-    case FeedOperation::PUT: {
-        PutOperation op;
-        replay(op, is, entry);
+    case FeedOperation::PUT:
+        op = deserialize<PutOperation>(is, repo);
         break;
-    } case FeedOperation::REMOVE: {
-        RemoveOperationWithDocId op;
-        replay(op, is, entry);
+    case FeedOperation::REMOVE:
+        op = deserialize<RemoveOperationWithDocId>(is, repo);
         break;
-    } case FeedOperation::REMOVE_GID: {
-        RemoveOperationWithGid op;
-        replay(op, is, entry);
+    case FeedOperation::REMOVE_GID:
+        op = deserialize<RemoveOperationWithGid>(is, repo);
         break;
-    } case FeedOperation::UPDATE: {
-        UpdateOperation op(static_cast<FeedOperation::Type>(entry.type()));
-        replay(op, is, entry);
+    case FeedOperation::UPDATE:
+        op = deserialize<UpdateOperation>(is, repo, static_cast<FeedOperation::Type>(entry.type()));
         break;
-    } case FeedOperation::NOOP: {
-        NoopOperation op;
-        replay(op, is, entry);
+    case FeedOperation::NOOP:
+        op = deserialize<NoopOperation>(is, repo);
         break;
-    } case FeedOperation::NEW_CONFIG: {
-        NewConfigOperation op(entry.serial(), _handler.getNewConfigStreamHandler());
-        op.deserialize(is, _handler.getDeserializeRepo());
-        _handler.replay(op);
-        break;
-    } case FeedOperation::DELETE_BUCKET: {
-        DeleteBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::NEW_CONFIG:
+        return {};
+    case FeedOperation::DELETE_BUCKET:
+        op = deserialize<DeleteBucketOperation>(is, repo);
         break;
-    } case FeedOperation::SPLIT_BUCKET: {
-        SplitBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::SPLIT_BUCKET:
+        op = deserialize<SplitBucketOperation>(is, repo);
         break;
-    } case FeedOperation::JOIN_BUCKETS: {
-        JoinBucketsOperation op;
-        replay(op, is, entry);
+    case FeedOperation::JOIN_BUCKETS:
+        op = deserialize<JoinBucketsOperation>(is, repo);
         break;
-    } case FeedOperation::PRUNE_REMOVED_DOCUMENTS: {
-        PruneRemovedDocumentsOperation op;
-        replay(op, is, entry);
+    case FeedOperation::PRUNE_REMOVED_DOCUMENTS:
+        op = deserialize<PruneRemovedDocumentsOperation>(is, repo);
         break;
-    } case FeedOperation::MOVE: {
-        MoveOperation op;
-        replay(op, is, entry);
+    case FeedOperation::MOVE:
+        op = deserialize<MoveOperation>(is, repo);
         break;
-    } case FeedOperation::CREATE_BUCKET: {
-        CreateBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::CREATE_BUCKET:
+        op = deserialize<CreateBucketOperation>(is, repo);
         break;
-    } case FeedOperation::COMPACT_LID_SPACE: {
-        CompactLidSpaceOperation op;
-        replay(op, is, entry);
+    case FeedOperation::COMPACT_LID_SPACE:
+        op = deserialize<CompactLidSpaceOperation>(is, repo);
         break;
-    } default:
+    default:
         throw IllegalStateException
             (make_string("Got packet entry with unknown type id '%u' from TLS", entry.type()));
     }
@@ -93,6 +89,74 @@ ReplayPacketDispatcher::replayEntry(const Packet::Entry &entry)
             (make_string("Too much data in packet entry (type id '%u', %ld bytes)",
                          entry.type(), is.size()));
     }
+    op->setSerialNum(entry.serial());
+    return op;
+}
+
+
+void
+ReplayPacketDispatcher::replayEntry(const Packet::Entry &entry)
+{
+    if (entry.type() == FeedOperation::NEW_CONFIG) {
+        vespalib::nbostream is(entry.data().c_str(), entry.data().size());
+        NewConfigOperation op(entry.serial(), _handler.getNewConfigStreamHandler());
+        op.deserialize(is, _handler.getDeserializeRepo());
+        _handler.replay(op);
+        if ( ! is.empty()) {
+            throw document::DeserializeException
+                (make_string("Too much data in packet entry (type id '%u', %ld bytes)",
+                             entry.type(), is.size()));
+        }
+        return;
+    }
+    auto op = decodeEntry(entry, _handler.getDeserializeRepo());
+    replayOperation(*op);
+}
+
+
+void
+ReplayPacketDispatcher::replayOperation(const FeedOperation &op)
+{
+    store(op);
+    switch (op.getType()) {
+    case FeedOperation::PUT:
+        replay<PutOperation>(op);
+        break;
+    case FeedOperation::REMOVE:
+    case FeedOperation::REMOVE_GID:
+        replay<RemoveOperation>(op);
+        break;
+    case FeedOperation::UPDATE:
+        replay<UpdateOperation>(op);
+        break;
+    case FeedOperation::NOOP:
+        replay<NoopOperation>(op);
+        break;
+    case FeedOperation::DELETE_BUCKET:
+        replay<DeleteBucketOperation>(op);
+        break;
+    case FeedOperation::SPLIT_BUCKET:
+        replay<SplitBucketOperation>(op);
+        break;
+    case FeedOperation::JOIN_BUCKETS:
+        replay<JoinBucketsOperation>(op);
+        break;
+    case FeedOperation::PRUNE_REMOVED_DOCUMENTS:
+        replay<PruneRemovedDocumentsOperation>(op);
+        break;
+    case FeedOperation::MOVE:
+        replay<MoveOperation>(op);
+        break;
+    case FeedOperation::CREATE_BUCKET:
+        replay<CreateBucketOperation>(op);
+        break;
+    case FeedOperation::COMPACT_LID_SPACE:
+        replay<CompactLidSpaceOperation>(op);
+        break;
+    default:
+        throw IllegalStateException
+            (make_string("Cannot replay feed operation with type id '%u'", op.getType()));
+    }
 }
 
 
@@ -4,6 +4,7 @@
 
 #include "ireplaypackethandler.h"
 #include <vespa/searchlib/transactionlog/common.h>
+#include <memory>
 
 namespace proton {
 
@@ -20,7 +21,7 @@ private:
     IReplayPacketHandler &_handler;
 
     template <typename OperationType>
-    void replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry);
+    void replay(const FeedOperation &op);
 
 protected:
     virtual void store(const FeedOperation &op);
@@ -30,6 +31,15 @@ public:
     virtual ~ReplayPacketDispatcher();
 
     void replayEntry(const Packet::Entry &entry);
+    /**
+     * Deserializes the packet entry into a feed operation. Can be called
+     * by any thread. Returns nullptr for new config operations, as these
+     * must be deserialized in order by replayEntry().
+     */
+    static std::unique_ptr<FeedOperation> decodeEntry(const Packet::Entry &entry,
+                                                      const document::DocumentTypeRepo &repo);
+    // Replays a feed operation returned by decodeEntry().
+    void replayOperation(const FeedOperation &op);
 };
 
 } // namespace proton
@@ -7,6 +7,7 @@
 #include "proton.h"
 #include <vespa/searchcore/proton/flushengine/set_strategy_result.h>
 #include <vespa/searchcore/proton/matchengine/matchengine.h>
+#include <vespa/searchlib/engine/query_capture.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/compressionconfig.h>
 #include <vespa/fnet/frt/require_capabilities.h>
@@ -44,6 +45,26 @@ namespace {
 
 std::string delayed_configs_string("delayedConfigs");
 
+uint64_t env_or_default(const char *name, uint64_t default_value) {
+    const char *env = getenv(name);
+    return (env != nullptr) ? strtoull(env, nullptr, 10) : default_value;
+}
+
+/*
+ * Sampled capture of search and docsum requests, for replaying
+ * production traffic against a test instance with vespa-search-replay.
+ * Disabled unless VESPA_PROTON_QUERY_CAPTURE_FILE is set.
+ */
+std::unique_ptr<search::engine::QueryCapture> make_query_capture() {
+    const char *file_name = getenv("VESPA_PROTON_QUERY_CAPTURE_FILE");
+    if (file_name == nullptr || *file_name == '\0') {
+        return {};
+    }
+    uint64_t max_size_mb = env_or_default("VESPA_PROTON_QUERY_CAPTURE_MAX_SIZE_MB", 256);
+    uint32_t sample_interval = env_or_default("VESPA_PROTON_QUERY_CAPTURE_SAMPLE_INTERVAL", 100);
+    return std::make_unique<search::engine::QueryCapture>(file_name, max_size_mb << 20, sample_interval);
+}
+
 using Pair = std::pair<std::string, std::string>;
 
 }
@@ -147,14 +168,16 @@ RPCHooksBase::Params::Params(Proton &parent, uint32_t port, const config::Config
       slobrok_config(configUri.createWithNewId(std::string(slobrokId))),
       identity(configUri.getConfigId()),
       rtcPort(port),
-      numTranportThreads(transportThreads)
+      numTranportThreads(transportThreads),
+      priorityStreakLimit(0)
 { }
 
 RPCHooksBase::Params::~Params() = default;
 
 RPCHooksBase::RPCHooksBase(Params &params)
     : _proton(params.proton),
-      _transport(std::make_unique<FNET_Transport>(params.numTranportThreads)),
+      _transport(std::make_unique<FNET_Transport>(fnet::TransportConfig(params.numTranportThreads).
+              priority_streak_limit(params.priorityStreakLimit))),
       _detached_requests_owner(std::make_shared<DetachedRpcRequestsOwner>()),
       _orb(std::make_unique<FRT_Supervisor>(_transport.get())),
       _proto_rpc_adapter(std::make_unique<ProtoRpcAdapter>(
@@ -162,7 +185,9 @@ RPCHooksBase::RPCHooksBase(Params &params)
                       _proton.get_docsum_server(),
                       _proton.get_monitor_server(), *_orb)),
       _regAPI(*_orb, slobrok::ConfiguratorFactory(params.slobrok_config))
-{ }
+{
+    _proto_rpc_adapter->set_query_capture(make_query_capture());
+}
 
 void
 RPCHooksBase::open(Params & params)
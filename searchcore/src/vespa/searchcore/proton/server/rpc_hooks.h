@@ -43,6 +43,7 @@ public:
         std::string  identity;
         uint32_t          rtcPort;
         uint32_t          numTranportThreads;
+        uint32_t          priorityStreakLimit;
 
         Params(Proton &parent, uint32_t port, const config::ConfigUri & configUri,
                std::string_view slobrokId, uint32_t numTransportThreads);
@@ -7,6 +7,7 @@
 #include "searchview.h"
 #include <vespa/config-rank-profiles.h>
 #include <vespa/searchcore/proton/matching/matcher.h>
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
 #include <vespa/searchcore/proton/attribute/attribute_collection_spec.h>
 #include <vespa/searchcore/proton/attribute/attribute_collection_spec_factory.h>
 #include <vespa/searchcore/proton/attribute/attribute_writer.h>
@@ -97,7 +98,8 @@ SearchableDocSubDBConfigurer(const std::shared_ptr<ISummaryManager>& summaryMgr,
                              const vespalib::eval::ConstantValueFactory& constant_value_factory,
                              const std::atomic<steady_time> & now_ref,
                              const std::string &subDbName,
-                             uint32_t distributionKey) :
+                             uint32_t distributionKey,
+                             size_t result_cache_max_bytes) :
     _summaryMgr(summaryMgr),
     _searchView(searchView),
     _feedView(feedView),
@@ -105,7 +107,8 @@ SearchableDocSubDBConfigurer(const std::shared_ptr<ISummaryManager>& summaryMgr,
     _constant_value_factory(constant_value_factory),
     _now_ref(now_ref),
     _subDbName(subDbName),
-    _distributionKey(distributionKey)
+    _distributionKey(distributionKey),
+    _result_cache_max_bytes(result_cache_max_bytes)
 { }
 
 SearchableDocSubDBConfigurer::~SearchableDocSubDBConfigurer() = default;
@@ -113,26 +116,50 @@ SearchableDocSubDBConfigurer::~SearchableDocSubDBConfigurer() = default;
 std::shared_ptr<Matchers>
 SearchableDocSubDBConfigurer::createMatchers(const DocumentDBConfig& new_config_snapshot)
 {
-    auto& schema = new_config_snapshot.getSchemaSP();
-    auto& cfg = new_config_snapshot.getRankProfilesConfig();
     search::fef::RankingAssetsRepo ranking_assets_repo_source(_constant_value_factory,
                                                               new_config_snapshot.getRankingConstantsSP(),
                                                               new_config_snapshot.getRankingExpressionsSP(),
                                                               new_config_snapshot.getOnnxModelsSP());
     auto newMatchers = std::make_shared<Matchers>(_now_ref, _queryLimiter, ranking_assets_repo_source);
-    auto& ranking_assets_repo = newMatchers->get_ranking_assets_repo();
+    addMatchers(*newMatchers, new_config_snapshot, nullptr);
+    return newMatchers;
+}
+
+std::shared_ptr<Matchers>
+SearchableDocSubDBConfigurer::createMatchers(const DocumentDBConfig& new_config_snapshot, const Matchers& old_matchers)
+{
+    // Reused matchers refer to the ranking assets, which must then be shared
+    auto newMatchers = std::make_shared<Matchers>(_now_ref, _queryLimiter, old_matchers.get_shared_ranking_assets_repo());
+    addMatchers(*newMatchers, new_config_snapshot, &old_matchers);
+    return newMatchers;
+}
+
+void
+SearchableDocSubDBConfigurer::addMatchers(Matchers& matchers, const DocumentDBConfig& new_config_snapshot,
+                                          const Matchers* old_matchers)
+{
+    auto& schema = new_config_snapshot.getSchemaSP();
+    auto& cfg = new_config_snapshot.getRankProfilesConfig();
+    if (_result_cache_max_bytes > 0) {
+        matchers.set_result_cache(std::make_shared<matching::QueryResultCache>(_result_cache_max_bytes));
+    }
+    auto& ranking_assets_repo = matchers.get_ranking_assets_repo();
     for (const auto &profile : cfg.rankprofile) {
         std::string name = profile.name;
         search::fef::Properties properties;
         for (const auto &property : profile.fef.property) {
             properties.add(property.name, property.value);
         }
+        auto old_matcher = (old_matchers != nullptr) ? old_matchers->find(name) : std::shared_ptr<Matcher>();
+        if (old_matcher && (old_matcher->get_index_env().getProperties() == properties)) {
+            matchers.add(name, std::move(old_matcher));
+            continue;
+        }
         // schema instance only used during call.
         auto profptr = std::make_shared<Matcher>(*schema, std::move(properties), _now_ref, _queryLimiter,
                                                  ranking_assets_repo, _distributionKey);
-        newMatchers->add(name, std::move(profptr));
+        matchers.add(name, std::move(profptr));
     }
-    return newMatchers;
 }
 
 void
@@ -153,9 +180,13 @@ SearchableDocSubDBConfigurer::prepare_reconfig(const DocumentDBConfig& new_confi
 {
     auto old_matchers = _searchView.get()->getMatchers();
     auto old_attribute_manager = _searchView.get()->getAttributeManager();
-    auto reconfig = std::make_unique<DocumentSubDBReconfig>(std::move(old_matchers), old_attribute_manager);
+    auto reconfig = std::make_unique<DocumentSubDBReconfig>(old_matchers, old_attribute_manager);
     if (reconfig_params.shouldMatchersChange()) {
-        reconfig->set_matchers(createMatchers(new_config_snapshot));
+        if (reconfig_params.canReuseUnchangedMatchers() && old_matchers) {
+            reconfig->set_matchers(createMatchers(new_config_snapshot, *old_matchers));
+        } else {
+            reconfig->set_matchers(createMatchers(new_config_snapshot));
+        }
     }
     if (reconfig_params.shouldAttributeManagerChange()) {
         auto attr_spec = attr_spec_factory.create(new_config_snapshot.getAttributesConfig(), docid_limit, serial_num);
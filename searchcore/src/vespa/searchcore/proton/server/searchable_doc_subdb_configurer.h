@@ -49,12 +49,14 @@ private:
     const std::atomic<steady_time> & _now_ref;
     std::string             _subDbName;
     uint32_t                     _distributionKey;
+    size_t                       _result_cache_max_bytes;
 
     void reconfigureFeedView(std::shared_ptr<IAttributeWriter> attrWriter,
                              std::shared_ptr<const search::index::Schema> schema,
                              std::shared_ptr<const document::DocumentTypeRepo> repo);
 
     void reconfigureMatchView(const std::shared_ptr<searchcorespi::IndexSearchable>& indexSearchable);
+    void addMatchers(Matchers& matchers, const DocumentDBConfig& new_config_snapshot, const Matchers* old_matchers);
 
     void reconfigureMatchView(const std::shared_ptr<Matchers>& matchers,
                               const std::shared_ptr<searchcorespi::IndexSearchable>& indexSearchable,
@@ -74,10 +76,17 @@ public:
                                  const vespalib::eval::ConstantValueFactory& constant_value_factory,
                                  const std::atomic<steady_time> & now_ref,
                                  const std::string &subDbName,
-                                 uint32_t distributionKey);
+                                 uint32_t distributionKey,
+                                 size_t result_cache_max_bytes);
     ~SearchableDocSubDBConfigurer();
 
     std::shared_ptr<Matchers> createMatchers(const DocumentDBConfig& new_config_snapshot);
+    /**
+     * Creates matchers, reusing the matchers in old_matchers for rank
+     * profiles with unchanged properties. Only valid when schema and
+     * ranking assets are unchanged since old_matchers were created.
+     */
+    std::shared_ptr<Matchers> createMatchers(const DocumentDBConfig& new_config_snapshot, const Matchers& old_matchers);
 
     void reconfigureIndexSearchable();
 
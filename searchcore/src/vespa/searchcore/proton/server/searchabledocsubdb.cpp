@@ -43,7 +43,8 @@ SearchableDocSubDB::SearchableDocSubDB(const Config &cfg, const Context &ctx)
       _tensorLoader(FastValueBuilderFactory::get()),
       _constantValueCache(_tensorLoader),
       _configurer(_iSummaryMgr, _rSearchView, _rFeedView, ctx._queryLimiter, _constantValueCache, ctx._now_ref,
-                  getSubDbName(), ctx._fastUpdCtx._storeOnlyCtx._owner.getDistributionKey()),
+                  getSubDbName(), ctx._fastUpdCtx._storeOnlyCtx._owner.getDistributionKey(),
+                  ctx._result_cache_max_bytes),
       _warmupExecutor(ctx._warmupExecutor),
       _realGidToLidChangeHandler(std::make_shared<GidToLidChangeHandler>()),
       _flushConfig(),
@@ -336,6 +337,12 @@ SearchableDocSubDB::getMatcherStats(const std::string &rankProfile) const
     return _rSearchView.get()->getMatcherStats(rankProfile);
 }
 
+std::shared_ptr<Matchers>
+SearchableDocSubDB::getMatchers() const
+{
+    return _rSearchView.get()->getMatchers();
+}
+
 void
 SearchableDocSubDB::close()
 {
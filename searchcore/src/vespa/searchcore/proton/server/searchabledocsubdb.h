@@ -47,17 +47,20 @@ public:
         const std::atomic<steady_time>    &_now_ref;
         vespalib::Executor                &_warmupExecutor;
         std::shared_ptr<search::diskindex::IPostingListCache> _posting_list_cache;
+        size_t                             _result_cache_max_bytes;
 
         Context(const FastAccessDocSubDB::Context &fastUpdCtx,
                 matching::QueryLimiter &queryLimiter,
                 const std::atomic<steady_time> & now_ref,
                 vespalib:: Executor &warmupExecutor,
-                std::shared_ptr<search::diskindex::IPostingListCache> posting_list_cache)
+                std::shared_ptr<search::diskindex::IPostingListCache> posting_list_cache,
+                size_t result_cache_max_bytes)
             : _fastUpdCtx(fastUpdCtx),
               _queryLimiter(queryLimiter),
               _now_ref(now_ref),
               _warmupExecutor(warmupExecutor),
-              _posting_list_cache(std::move(posting_list_cache))
+              _posting_list_cache(std::move(posting_list_cache)),
+              _result_cache_max_bytes(result_cache_max_bytes)
         { }
         ~Context();
     };
@@ -137,6 +140,7 @@ public:
     search::IndexStats get_index_stats(bool clear_disk_io_stats) const override ;
     std::shared_ptr<IDocumentRetriever> getDocumentRetriever() override;
     matching::MatchingStats getMatcherStats(const std::string &rankProfile) const override;
+    std::shared_ptr<Matchers> getMatchers() const override;
     void close() override;
     std::shared_ptr<IDocumentDBReference> getDocumentDBReference() override;
     void tearDownReferences(IDocumentDBReferenceResolver &resolver) override;
@@ -15,9 +15,9 @@ SearchHandlerProxy::SearchHandlerProxy(DocumentDB::SP documentDB)
 SearchHandlerProxy::~SearchHandlerProxy() = default;
 
 std::unique_ptr<search::engine::DocsumReply>
-SearchHandlerProxy::getDocsums(const DocsumRequest & request)
+SearchHandlerProxy::getDocsums(const DocsumRequest & request, vespalib::ThreadBundle &threadBundle)
 {
-    return _documentDB->getDocsums(request);
+    return _documentDB->getDocsums(request, threadBundle);
 }
 
 std::unique_ptr<search::engine::SearchReply>
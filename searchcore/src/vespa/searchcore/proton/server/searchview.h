@@ -33,11 +33,11 @@ public:
     DocIdLimit &getDocIdLimit() const noexcept { return _matchView->getDocIdLimit(); }
     matching::MatchingStats getMatcherStats(const std::string &rankProfile) const { return _matchView->getMatcherStats(rankProfile); }
 
-    std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & req) override;
+    std::unique_ptr<DocsumReply> getDocsums(const DocsumRequest & req, vespalib::ThreadBundle &threadBundle) override;
     std::unique_ptr<SearchReply> match(const SearchRequest &req, vespalib::ThreadBundle &threadBundle) const override;
 private:
     SearchView(std::shared_ptr<ISummaryManager::ISummarySetup> summarySetup, std::shared_ptr<MatchView> matchView);
-    InternalDocsumReply getDocsumsInternal(const DocsumRequest & req);
+    InternalDocsumReply getDocsumsInternal(const DocsumRequest & req, vespalib::ThreadBundle &threadBundle);
     std::shared_ptr<ISummaryManager::ISummarySetup> _summarySetup;
     std::shared_ptr<MatchView>                      _matchView;
 };
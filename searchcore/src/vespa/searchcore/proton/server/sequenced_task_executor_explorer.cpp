@@ -3,8 +3,10 @@
 #include "sequenced_task_executor_explorer.h"
 #include "executor_explorer_utils.h"
 #include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/util/adaptive_sequenced_executor.h>
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
 
+using vespalib::AdaptiveSequencedExecutor;
 using vespalib::ISequencedTaskExecutor;
 using vespalib::SequencedTaskExecutor;
 using vespalib::slime::Cursor;
@@ -49,6 +51,23 @@ convert_raw_executor_stats_to_slime(ISequencedTaskExecutor* executor, Cursor& ar
     }
 }
 
+void
+convert_strand_stats_to_slime(AdaptiveSequencedExecutor& executor, Cursor& array)
+{
+    auto strand_stats = executor.get_strand_stats();
+    for (size_t strand_id = 0; strand_id < strand_stats.size(); ++strand_id) {
+        const auto& stats = strand_stats[strand_id];
+        if ((stats.accepted_tasks == 0) && (stats.queue_size == 0)) {
+            continue;
+        }
+        auto& obj = array.addObject();
+        obj.setLong("strand_id", strand_id);
+        obj.setLong("queue_size", stats.queue_size);
+        obj.setLong("max_queue_size", stats.max_queue_size);
+        obj.setLong("accepted_tasks", stats.accepted_tasks);
+    }
+}
+
 }
 
 void
@@ -58,6 +77,10 @@ SequencedTaskExecutorExplorer::get_state(const vespalib::slime::Inserter& insert
     convert_executor_to_slime(_executor, object);
     if (full) {
         convert_raw_executor_stats_to_slime(_executor, object.setArray("executors"));
+        if (auto* ada = dynamic_cast<AdaptiveSequencedExecutor*>(_executor)) {
+            // only strands that have been in use since the last full report
+            convert_strand_stats_to_slime(*ada, object.setArray("strands"));
+        }
     }
 }
 
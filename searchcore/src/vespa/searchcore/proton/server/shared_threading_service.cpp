@@ -18,10 +18,11 @@ namespace proton {
 
 SharedThreadingService::SharedThreadingService(const SharedThreadingServiceConfig& cfg,
                                                FNET_Transport& transport,
-                                               storage::spi::BucketExecutor& bucket_executor)
+                                               storage::spi::BucketExecutor& bucket_executor,
+                                               const vespalib::NumaTopology& numa)
     : _transport(transport),
       _shared(std::make_shared<vespalib::BlockingThreadStackExecutor>(cfg.shared_threads(),
-                                                                      cfg.shared_task_limit(), vespalib::be_nice(proton_shared_executor, cfg.feeding_niceness()))),
+                                                                      cfg.shared_task_limit(), numa.spread_over_nodes(vespalib::be_nice(proton_shared_executor, cfg.feeding_niceness())))),
       _field_writer(),
       _invokeService(std::make_unique<vespalib::InvokeServiceImpl>(std::max(vespalib::adjustTimeoutByDetectedHz(1ms),
                                                                             cfg.field_writer_config().reactionTime()))),
@@ -29,7 +30,7 @@ SharedThreadingService::SharedThreadingService(const SharedThreadingServiceConfi
       _bucket_executor(bucket_executor)
 {
     const auto& fw_cfg = cfg.field_writer_config();
-    _field_writer = vespalib::SequencedTaskExecutor::create(vespalib::be_nice(CpuUsage::wrap(proton_field_writer_executor, CpuUsage::Category::WRITE), cfg.feeding_niceness()),
+    _field_writer = vespalib::SequencedTaskExecutor::create(numa.spread_over_nodes(vespalib::be_nice(CpuUsage::wrap(proton_field_writer_executor, CpuUsage::Category::WRITE), cfg.feeding_niceness())),
                                                             cfg.field_writer_threads(),
                                                             fw_cfg.defaultTaskLimit(),
                                                             fw_cfg.is_task_limit_hard(),
@@ -3,6 +3,7 @@
 
 #include "i_shared_threading_service.h"
 #include "shared_threading_service_config.h"
+#include <vespa/vespalib/util/numa_topology.h>
 #include <vespa/vespalib/util/threadexecutor.h>
 #include <vespa/vespalib/util/syncable.h>
 #include <memory>
@@ -27,7 +28,8 @@ private:
 public:
     SharedThreadingService(const SharedThreadingServiceConfig& cfg,
                            FNET_Transport& transport,
-                           storage::spi::BucketExecutor& bucket_executor);
+                           storage::spi::BucketExecutor& bucket_executor,
+                           const vespalib::NumaTopology& numa = vespalib::NumaTopology());
     ~SharedThreadingService() override;
 
     std::shared_ptr<vespalib::Executor> shared_raw() { return _shared; }
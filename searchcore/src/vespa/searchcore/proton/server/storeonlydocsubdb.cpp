@@ -261,7 +261,8 @@ createDocumentMetaStoreInitializer(const AllocStrategy& alloc_strategy,
     // initializers to get hold of document meta store instance in
     // their constructors.
     *result = std::make_shared<DocumentMetaStoreInitializerResult>
-              (std::make_shared<DocumentMetaStore>(_bucketDB, attrFileName, grow, _subDbType), tuneFile);
+              (std::make_shared<DocumentMetaStore>(_bucketDB, attrFileName, grow, _subDbType,
+                                                   alloc_strategy.get_gid_hash_index()), tuneFile);
     return std::make_shared<documentmetastore::DocumentMetaStoreInitializer>
         (baseDir, getSubDbName(), _docTypeName.toString(), (*result)->documentMetaStore());
 }
@@ -299,6 +300,10 @@ createStoreConfig(const search::LogDocumentStore::Config &original, SubDbType su
     if (subDbType == SubDbType::REMOVED) {
         cfg.disableCache();
     }
+    if (subDbType != SubDbType::READY) {
+        // Docsums are only served from the ready sub database
+        cfg.maxRenderedCacheBytes(0);
+    }
     return cfg;
 }
 
@@ -564,6 +569,12 @@ StoreOnlyDocSubDB::getMatcherStats(const std::string &rankProfile) const
     return {};
 }
 
+std::shared_ptr<Matchers>
+StoreOnlyDocSubDB::getMatchers() const
+{
+    return {};
+}
+
 void
 StoreOnlyDocSubDB::close()
 {
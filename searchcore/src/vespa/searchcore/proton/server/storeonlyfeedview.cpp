@@ -11,6 +11,7 @@
 #include <vespa/searchcore/proton/reference/i_gid_to_lid_change_handler.h>
 #include <vespa/searchcore/proton/reference/i_pending_gid_to_lid_changes.h>
 #include <vespa/searchlib/index/uri_field.h>
+#include <vespa/searchsummary/docsummary/rendered_docsum_cache.h>
 #include <vespa/document/repo/documenttyperepo.h>
 #include <vespa/document/datatype/documenttype.h>
 #include <vespa/document/fieldvalue/document.h>
@@ -30,6 +31,7 @@ using document::DocumentUpdate;
 using document::GlobalId;
 using proton::documentmetastore::LidReuseDelayer;
 using search::SerialNum;
+using search::docsummary::RenderedDocsumCache;
 using search::index::Schema;
 using storage::spi::BucketInfoResult;
 using storage::spi::Timestamp;
@@ -51,11 +53,35 @@ createPutDoneContext(FeedToken token, std::shared_ptr<IDestructorCallback> done_
 }
 
 std::shared_ptr<UpdateDoneContext>
-createUpdateDoneContext(FeedToken token, IPendingLidTracker::Token uncommitted, const DocumentUpdate::SP &upd)
+createUpdateDoneContext(FeedToken token, std::shared_ptr<IDestructorCallback> done_callback, IPendingLidTracker::Token uncommitted,
+                        const DocumentUpdate::SP &upd)
 {
-    return std::make_shared<UpdateDoneContext>(std::move(token), std::move(uncommitted), upd);
+    return std::make_shared<UpdateDoneContext>(std::move(token), std::move(done_callback), std::move(uncommitted), upd);
 }
 
+/**
+ * Invalidates the rendered docsums of a set of lids when destroyed, i.e. when all writes
+ * of the operation changing the documents are visible.
+ */
+class RenderedDocsumInvalidator : public IDestructorCallback
+{
+    std::shared_ptr<RenderedDocsumCache>  _cache;
+    std::vector<search::DocumentIdT>      _lids;
+    std::shared_ptr<IDestructorCallback>  _done_callback;
+public:
+    RenderedDocsumInvalidator(std::shared_ptr<RenderedDocsumCache> cache, std::vector<search::DocumentIdT> lids,
+                              std::shared_ptr<IDestructorCallback> done_callback) noexcept
+        : _cache(std::move(cache)),
+          _lids(std::move(lids)),
+          _done_callback(std::move(done_callback))
+    {}
+    ~RenderedDocsumInvalidator() override {
+        for (auto lid : _lids) {
+            _cache->invalidate(lid);
+        }
+    }
+};
+
 void setPrev(DocumentOperation &op, const documentmetastore::IStore::Result &result,
              uint32_t subDbId, bool markedAsRemoved)
 {
@@ -146,6 +172,12 @@ moveMetaData(documentmetastore::IStore &meta_store, const DocumentId & doc_id, c
     meta_store.move(op.getPrevLid(), op.getLid(), op.get_prepare_serial_num());
 }
 
+/*
+ * Tracks which fields an update touches. Updates that only touch attributes
+ * updateable in memory (e.g. assign, increment and tensor modify of counters
+ * and scores) are applied directly to the attributes, without reading and
+ * writing the document in the document store.
+ */
 class UpdateScope final : public IFieldUpdateCallback
 {
 private:
@@ -183,6 +215,7 @@ StoreOnlyFeedView::StoreOnlyFeedView(Context ctx, const PersistentParams &params
     : IFeedView(),
       FeedDebugger(),
       _summaryAdapter(std::move(ctx._summaryAdapter)),
+      _renderedDocsumCache(_summaryAdapter->get_rendered_docsum_cache()),
       _documentMetaStoreContext(std::move(ctx._documentMetaStoreContext)),
       _repo(ctx._repo),
       _docType(nullptr),
@@ -305,8 +338,14 @@ StoreOnlyFeedView::internalPut(FeedToken token, const PutOperation &putOp)
             FeedToken token_copy = (token && !token->is_replay()) ? token : FeedToken();
             _gidToLidChangeHandler.notifyPut(std::move(token_copy), docId.getGlobalId(), putOp.getLid(), serialNum);
         }
-        auto onWriteDone = createPutDoneContext(std::move(token), {}, get_pending_lid_token(putOp), doc, putOp.getLid());
-        putSummary(serialNum, putOp.getLid(), doc, onWriteDone);
+        auto onWriteDone = createPutDoneContext(std::move(token), invalidateRenderedDocsumsWhenDone({putOp.getLid()}, {}),
+                                                get_pending_lid_token(putOp), doc, putOp.getLid());
+        // Reuse the serialized document from the transaction log if present, avoiding serializing it again
+        if (putOp.getSerializedDocument()) {
+            putSummary(serialNum, putOp.getLid(), putOp.getSerializedDocument(), onWriteDone);
+        } else {
+            putSummary(serialNum, putOp.getLid(), doc, onWriteDone);
+        }
         putAttributes(serialNum, putOp.getLid(), *doc, onWriteDone);
         putIndexedFields(serialNum, putOp.getLid(), doc, onWriteDone);
     }
@@ -396,6 +435,17 @@ StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid, Document::SP doc, co
                 _summaryAdapter->put(serialNum, lid, *doc);
             }));
 }
+
+void
+StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid, SerializedDocumentSP doc, const OnOperationDoneType& onDone)
+{
+    summaryExecutor().execute(
+            makeLambdaTask([serialNum, doc = std::move(doc), trackerToken = _pendingLidsForDocStore.produce(lid), onDone, lid, this] {
+                (void) onDone;
+                (void) trackerToken;
+                _summaryAdapter->put(serialNum, lid, *doc);
+            }));
+}
 void
 StoreOnlyFeedView::removeSummary(SerialNum serialNum, Lid lid, const OnWriteDoneType& onDone) {
     summaryExecutor().execute(
@@ -431,6 +481,15 @@ StoreOnlyFeedView::heartBeatSummary(SerialNum serialNum, const DoneCallback& onD
             }));
 }
 
+StoreOnlyFeedView::DoneCallback
+StoreOnlyFeedView::invalidateRenderedDocsumsWhenDone(LidVector lids, DoneCallback done_callback) const
+{
+    if ( ! _renderedDocsumCache) {
+        return done_callback;
+    }
+    return std::make_shared<RenderedDocsumInvalidator>(_renderedDocsumCache, std::move(lids), std::move(done_callback));
+}
+
 void
 StoreOnlyFeedView::internalUpdate(FeedToken token, const UpdateOperation &updOp) {
     if ( ! updOp.getUpdate()) {
@@ -459,7 +518,8 @@ StoreOnlyFeedView::internalUpdate(FeedToken token, const UpdateOperation &updOp)
         (void) updateOk;
     }
 
-    auto onWriteDone = createUpdateDoneContext(std::move(token), get_pending_lid_token(updOp), updOp.getUpdate());
+    auto onWriteDone = createUpdateDoneContext(std::move(token), invalidateRenderedDocsumsWhenDone({lid}, {}),
+                                               get_pending_lid_token(updOp), updOp.getUpdate());
     UpdateScope updateScope(_indexedFields, upd);
     updateAttributes(serialNum, lid, upd, onWriteDone, updateScope);
 
@@ -618,7 +678,8 @@ void
 StoreOnlyFeedView::internalRemove(FeedToken token, std::shared_ptr<IDestructorCallback> done_callback, IPendingLidTracker::Token uncommitted, SerialNum serialNum, Lid lid)
 {
     _lidReuseDelayer.delayReuse(lid);
-    auto onWriteDone = createRemoveDoneContext(std::move(token), std::move(done_callback), std::move(uncommitted));
+    auto onWriteDone = createRemoveDoneContext(std::move(token), invalidateRenderedDocsumsWhenDone({lid}, std::move(done_callback)),
+                                               std::move(uncommitted));
     removeSummary(serialNum, lid, onWriteDone);
     removeAttributes(serialNum, lid, onWriteDone);
     removeIndexedFields(serialNum, lid, onWriteDone);
@@ -654,7 +715,7 @@ void
 StoreOnlyFeedView::removeIndexedFields(SerialNum , const LidVector &, const OnWriteDoneType&) {}
 
 size_t
-StoreOnlyFeedView::removeDocuments(const RemoveDocumentsOperation &op, bool remove_index_and_attributes, const DoneCallback& onWriteDone)
+StoreOnlyFeedView::removeDocuments(const RemoveDocumentsOperation &op, bool remove_index_and_attributes, const DoneCallback& onDone)
 {
     const SerialNum serialNum = op.getSerialNum();
     const LidVectorContext::SP &ctx = op.getLidsToRemove(_params._subDbId);
@@ -671,6 +732,7 @@ StoreOnlyFeedView::removeDocuments(const RemoveDocumentsOperation &op, bool remo
         _metaStore.removeBatch(lidsToRemove, ctx->getDocIdLimit());
         _lidReuseDelayer.delayReuse(lidsToRemove);
     }
+    auto onWriteDone = invalidateRenderedDocsumsWhenDone(lidsToRemove, onDone);
 
     if (remove_index_and_attributes) {
         removeIndexedFields(serialNum, lidsToRemove, onWriteDone);
@@ -755,7 +817,8 @@ StoreOnlyFeedView::handleMove(const MoveOperation &moveOp, const DoneCallback& d
         if (moveOp.changedDbdId() && useDocumentMetaStore(serialNum)) {
             _gidToLidChangeHandler.notifyPut(FeedToken(), docId.getGlobalId(), moveOp.getLid(), serialNum);
         }
-        auto onWriteDone = createPutDoneContext({}, doneCtx, _pendingLidsForCommit->produce(moveOp.getLid()), doc, moveOp.getLid());
+        auto onWriteDone = createPutDoneContext({}, invalidateRenderedDocsumsWhenDone({moveOp.getLid()}, doneCtx),
+                                                _pendingLidsForCommit->produce(moveOp.getLid()), doc, moveOp.getLid());
         putSummary(serialNum, moveOp.getLid(), doc, onWriteDone);
         putAttributes(serialNum, moveOp.getLid(), *doc, onWriteDone);
         putIndexedFields(serialNum, moveOp.getLid(), doc, onWriteDone);
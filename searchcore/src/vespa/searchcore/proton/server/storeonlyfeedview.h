@@ -23,6 +23,7 @@
 #include <future>
 
 namespace vespalib { class IDestructorCallback; }
+namespace search::docsummary { class RenderedDocsumCache; }
 
 namespace proton {
 
@@ -63,6 +64,7 @@ public:
     using FutureStream = std::future<vespalib::nbostream>;
     using PromisedStream = std::promise<vespalib::nbostream>;
     using DocumentSP = std::shared_ptr<Document>;
+    using SerializedDocumentSP = std::shared_ptr<const vespalib::nbostream>;
     using DocumentUpdateSP = std::shared_ptr<DocumentUpdate>;
     using LidReuseDelayer = documentmetastore::LidReuseDelayer;
 
@@ -120,6 +122,7 @@ public:
 
 private:
     const ISummaryAdapter::SP                                _summaryAdapter;
+    const std::shared_ptr<search::docsummary::RenderedDocsumCache> _renderedDocsumCache;
     const IDocumentMetaStoreContext::SP                      _documentMetaStoreContext;
     const std::shared_ptr<const document::DocumentTypeRepo>  _repo;
     const document::DocumentType                            *_docType;
@@ -141,9 +144,12 @@ private:
     void putSummary(SerialNum serialNum, Lid lid, FutureStream doc, const OnOperationDoneType& onDone);
     void putSummaryNoop(FutureStream doc, const OnOperationDoneType& onDone);
     void putSummary(SerialNum serialNum, Lid lid, DocumentSP doc, const OnOperationDoneType& onDone);
+    void putSummary(SerialNum serialNum, Lid lid, SerializedDocumentSP doc, const OnOperationDoneType& onDone);
     void removeSummary(SerialNum serialNum, Lid lid, const OnWriteDoneType& onDone);
     void removeSummaries(SerialNum serialNum, const LidVector & lids, const OnWriteDoneType& onDone);
     void heartBeatSummary(SerialNum serialNum, const DoneCallback& onDone);
+    // Wraps done_callback to invalidate the rendered docsums of the lids when the operation is done
+    DoneCallback invalidateRenderedDocsumsWhenDone(LidVector lids, DoneCallback done_callback) const;
 
     bool useDocumentStore(SerialNum replaySerialNum) const {
         return replaySerialNum > _params._flushedDocumentStoreSerialNum;
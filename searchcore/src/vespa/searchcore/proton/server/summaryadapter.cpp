@@ -87,4 +87,9 @@ SummaryAdapter::compactLidSpace(uint32_t wantedDocIdLimit) {
     _mgr->getBackingStore().compactLidSpace(wantedDocIdLimit);
 }
 
+std::shared_ptr<search::docsummary::RenderedDocsumCache>
+SummaryAdapter::get_rendered_docsum_cache() const {
+    return _mgr->get_rendered_docsum_cache();
+}
+
 } // namespace proton
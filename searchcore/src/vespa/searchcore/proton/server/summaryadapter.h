@@ -27,6 +27,7 @@ public:
     const search::IDocumentStore &getDocumentStore() const override;
     std::unique_ptr<document::Document> get(const DocumentIdT lid, const DocumentTypeRepo &repo) override;
     void compactLidSpace(uint32_t wantedDocIdLimit) override;
+    std::shared_ptr<search::docsummary::RenderedDocsumCache> get_rendered_docsum_cache() const override;
 };
 
 } // namespace proton
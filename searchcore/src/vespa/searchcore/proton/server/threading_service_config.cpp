@@ -2,6 +2,7 @@
 
 #include "threading_service_config.h"
 #include <vespa/config-proton.h>
+#include <algorithm>
 #include <cmath>
 
 namespace proton {
@@ -14,13 +15,19 @@ ThreadingServiceConfig::ThreadingServiceConfig(uint32_t master_task_limit_,
                                                int32_t defaultTaskLimit_,
                                                OptimizeFor optimize_,
                                                uint32_t kindOfWatermark_,
-                                               vespalib::duration reactionTime_)
+                                               vespalib::duration reactionTime_,
+                                               vespalib::duration commit_max_delay_,
+                                               uint32_t commit_max_operations_,
+                                               uint32_t replay_decode_tasks_)
     : _master_task_limit(master_task_limit_),
       _defaultTaskLimit(std::abs(defaultTaskLimit_)),
       _is_task_limit_hard(defaultTaskLimit_ >= 0),
       _optimize(optimize_),
       _kindOfWatermark(kindOfWatermark_),
-      _reactionTime(reactionTime_)
+      _reactionTime(reactionTime_),
+      _commit_max_delay(commit_max_delay_),
+      _commit_max_operations(commit_max_operations_),
+      _replay_decode_tasks(replay_decode_tasks_)
 {
 }
 
@@ -46,12 +53,15 @@ ThreadingServiceConfig::make(const ProtonConfig& cfg)
                                   cfg.indexing.tasklimit,
                                   selectOptimization(cfg.indexing.optimize),
                                   cfg.indexing.kindOfWatermark,
-                                  vespalib::from_s(cfg.indexing.reactiontime));
+                                  vespalib::from_s(cfg.indexing.reactiontime),
+                                  vespalib::from_s(std::max(0.0, cfg.feeding.commit.maxdelay)),
+                                  std::max(0, cfg.feeding.commit.maxoperations),
+                                  std::max(1, cfg.feeding.replay.decodetasks));
 }
 
 ThreadingServiceConfig
 ThreadingServiceConfig::make() {
-    return ThreadingServiceConfig(0, 100, OptimizeFor::LATENCY, 0, 10ms);
+    return ThreadingServiceConfig(0, 100, OptimizeFor::LATENCY, 0, 10ms, vespalib::duration::zero(), 0, 1);
 }
 
 void
@@ -59,6 +69,8 @@ ThreadingServiceConfig::update(const ThreadingServiceConfig& cfg)
 {
     _master_task_limit = cfg._master_task_limit;
     _defaultTaskLimit = cfg._defaultTaskLimit;
+    _commit_max_delay = cfg._commit_max_delay;
+    _commit_max_operations = cfg._commit_max_operations;
 }
 
 bool
@@ -69,7 +81,10 @@ ThreadingServiceConfig::operator==(const ThreadingServiceConfig &rhs) const
         _is_task_limit_hard == rhs._is_task_limit_hard &&
         _optimize == rhs._optimize &&
         _kindOfWatermark == rhs._kindOfWatermark &&
-        _reactionTime == rhs._reactionTime;
+        _reactionTime == rhs._reactionTime &&
+        _commit_max_delay == rhs._commit_max_delay &&
+        _commit_max_operations == rhs._commit_max_operations &&
+        _replay_decode_tasks == rhs._replay_decode_tasks;
 }
 
 }
@@ -25,10 +25,15 @@ private:
     OptimizeFor        _optimize;
     uint32_t           _kindOfWatermark;
     vespalib::duration _reactionTime;         // Maximum reaction time to new tasks
+    vespalib::duration _commit_max_delay;     // Max time feed operations are collected before commit
+    uint32_t           _commit_max_operations; // Max feed operations collected before delayed commit, 0 means no limit
+    uint32_t           _replay_decode_tasks;   // Tasks decoding each transaction log packet during replay
 
 private:
     ThreadingServiceConfig(uint32_t master_task_limit_, int32_t defaultTaskLimit_,
-                           OptimizeFor optimize_, uint32_t kindOfWatermark_, vespalib::duration reactionTime_);
+                           OptimizeFor optimize_, uint32_t kindOfWatermark_, vespalib::duration reactionTime_,
+                           vespalib::duration commit_max_delay_, uint32_t commit_max_operations_,
+                           uint32_t replay_decode_tasks_);
 
 public:
     static ThreadingServiceConfig make(const ProtonConfig& cfg);
@@ -40,6 +45,9 @@ public:
     OptimizeFor optimize() const { return _optimize; }
     uint32_t kindOfwatermark() const { return _kindOfWatermark; }
     vespalib::duration reactionTime() const { return _reactionTime; }
+    vespalib::duration commit_max_delay() const { return _commit_max_delay; }
+    uint32_t commit_max_operations() const { return _commit_max_operations; }
+    uint32_t replay_decode_tasks() const { return _replay_decode_tasks; }
     bool operator==(const ThreadingServiceConfig &rhs) const;
 };
 
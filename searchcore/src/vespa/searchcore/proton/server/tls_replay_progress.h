@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/searchlib/common/serialnum.h>
+#include <vespa/vespalib/util/time.h>
 #include <atomic>
 #include <memory>
 #include <string>
@@ -16,6 +17,7 @@ private:
     const search::SerialNum _first;
     const search::SerialNum _last;
     std::atomic<search::SerialNum> _current;
+    const vespalib::steady_time _start;
 
 public:
     using UP = std::unique_ptr<TlsReplayProgress>;
@@ -26,7 +28,8 @@ public:
         : _domainName(domainName),
           _first(first),
           _last(last),
-          _current(first)
+          _current(first),
+          _start(vespalib::steady_clock::now())
     {
     }
     const std::string &getDomainName() const noexcept { return _domainName; }
@@ -40,6 +43,11 @@ public:
             return ((float)(getCurrent() - _first)/float(_last - _first));
         }
     }
+    // Average number of operations replayed per second since replay started
+    double getOperationsPerSecond(vespalib::steady_time now) const noexcept {
+        double elapsed = vespalib::to_s(now - _start);
+        return (elapsed > 0.0) ? (double(getCurrent() - _first) / elapsed) : 0.0;
+    }
     void updateCurrent(search::SerialNum current) noexcept { _current.store(current, std::memory_order_relaxed); }
 };
 
@@ -7,8 +7,9 @@ using document::Document;
 
 namespace proton {
 
-UpdateDoneContext::UpdateDoneContext(std::shared_ptr<feedtoken::IState> token, IPendingLidTracker::Token uncommitted, const document::DocumentUpdate::SP &upd)
-    : OperationDoneContext(std::move(token), {}),
+UpdateDoneContext::UpdateDoneContext(std::shared_ptr<feedtoken::IState> token, std::shared_ptr<vespalib::IDestructorCallback> done_callback,
+                                     IPendingLidTracker::Token uncommitted, const document::DocumentUpdate::SP &upd)
+    : OperationDoneContext(std::move(token), std::move(done_callback)),
       _uncommitted(std::move(uncommitted)),
       _upd(upd),
       _doc()
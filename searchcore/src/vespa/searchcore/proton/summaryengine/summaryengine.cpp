@@ -42,6 +42,7 @@ uint32_t getNumDocs(const DocsumReply &reply) {
 }
 
 VESPA_THREAD_STACK_TAG(summary_engine_executor)
+VESPA_THREAD_STACK_TAG(summary_engine_thread_bundle)
 
 } // namespace anonymous
 
@@ -57,13 +58,15 @@ SummaryEngine::DocsumMetrics::DocsumMetrics()
 
 SummaryEngine::DocsumMetrics::~DocsumMetrics() = default;
 
-SummaryEngine::SummaryEngine(size_t numThreads, bool async)
+SummaryEngine::SummaryEngine(size_t numThreads, size_t threadsPerDocsum, bool async, const vespalib::NumaTopology &numa)
     : _lock(),
       _async(async),
       _closed(false),
       _forward_issues(true),
       _handlers(),
-      _executor(numThreads, CpuUsage::wrap(summary_engine_executor, CpuUsage::Category::READ)),
+      _executor(numThreads, numa.spread_over_nodes(CpuUsage::wrap(summary_engine_executor, CpuUsage::Category::READ))),
+      _threadBundlePool(std::max(size_t(1), threadsPerDocsum),
+                        CpuUsage::wrap(summary_engine_thread_bundle, CpuUsage::Category::READ), numa),
       _metrics(std::make_unique<DocsumMetrics>())
 { }
 
@@ -130,8 +133,9 @@ SummaryEngine::getDocsums(DocsumRequest::UP req)
     DocsumReply::UP reply;
     if (req) {
         ISearchHandler::SP searchHandler = getSearchHandler(DocTypeName(*req));
+        auto threadBundle = _threadBundlePool.getBundle();
         if (searchHandler) {
-            reply = searchHandler->getDocsums(*req);
+            reply = searchHandler->getDocsums(*req, threadBundle.bundle());
         } else {
             HandlerMap<ISearchHandler>::Snapshot snapshot;
             {
@@ -139,7 +143,7 @@ SummaryEngine::getDocsums(DocsumRequest::UP req)
                 snapshot = _handlers.snapshot();
             }
             if (snapshot.valid()) {
-                reply = snapshot.get()->getDocsums(*req); // use the first handler
+                reply = snapshot.get()->getDocsums(*req, threadBundle.bundle()); // use the first handler
             }
         }
         updateDocsumMetrics(vespalib::to_s(req->getTimeUsed()), getNumDocs(*reply));
@@ -5,6 +5,7 @@
 #include <vespa/searchcore/proton/common/doctypename.h>
 #include <vespa/searchcore/proton/common/handlermap.hpp>
 #include <vespa/searchlib/engine/docsumapi.h>
+#include <vespa/vespalib/util/numa_thread_bundle_pool.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/metrics/valuemetric.h>
 #include <vespa/metrics/countmetric.h>
@@ -37,6 +38,7 @@ private:
     std::atomic<bool>             _forward_issues;
     HandlerMap<ISearchHandler>    _handlers;
     vespalib::ThreadStackExecutor _executor;
+    vespalib::NumaThreadBundlePool     _threadBundlePool;
     std::unique_ptr<metrics::MetricSet> _metrics;
 
 public:
@@ -50,8 +52,16 @@ public:
      * using the putSearchHandler() method.
      *
      * @param numThreads Number of threads allocated for handling summary requests.
+     * @param threadsPerDocsum Number of threads used to generate the docsums for a single request.
+     * @param numa NUMA nodes to spread the summary threads over.
      */
-    SummaryEngine(size_t numThreads, bool async);
+    SummaryEngine(size_t numThreads, size_t threadsPerDocsum, bool async, const vespalib::NumaTopology &numa);
+    SummaryEngine(size_t numThreads, size_t threadsPerDocsum, bool async)
+        : SummaryEngine(numThreads, threadsPerDocsum, async, vespalib::NumaTopology())
+    { }
+    SummaryEngine(size_t numThreads, bool async)
+        : SummaryEngine(numThreads, 1, async)
+    { }
     SummaryEngine(size_t numThreads)
         : SummaryEngine(numThreads, true)
     { }
@@ -83,6 +83,9 @@ struct DummyDocumentSubDb : public IDocumentSubDB
     matching::MatchingStats getMatcherStats(const std::string &) const override {
         return {};
     }
+    std::shared_ptr<Matchers> getMatchers() const override {
+        return {};
+    }
     std::shared_ptr<IDocumentDBReference> getDocumentDBReference() override {
         return {};
     }
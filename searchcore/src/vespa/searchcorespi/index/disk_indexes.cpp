@@ -77,6 +77,17 @@ DiskIndexes::remove(IndexDiskDir index_disk_dir)
     return true;
 }
 
+std::optional<uint64_t>
+DiskIndexes::get_size_on_disk(IndexDiskDir index_disk_dir) const
+{
+    std::lock_guard lock(_lock);
+    auto it = _active.find(index_disk_dir);
+    if (it == _active.end()) {
+        return std::nullopt;
+    }
+    return it->second.get_size_on_disk();
+}
+
 uint64_t
 DiskIndexes::get_transient_size(IndexDiskLayout& layout, IndexDiskDir index_disk_dir) const
 {
@@ -5,6 +5,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 
 namespace searchcorespi::index {
@@ -40,6 +41,7 @@ public:
     bool isActive(const std::string & index) const;
     void add_not_active(IndexDiskDir index_disk_dir);
     bool remove(IndexDiskDir index_disk_dir);
+    std::optional<uint64_t> get_size_on_disk(IndexDiskDir index_disk_dir) const;
     uint64_t get_transient_size(IndexDiskLayout& layout, IndexDiskDir index_disk_dir) const;
 };
 
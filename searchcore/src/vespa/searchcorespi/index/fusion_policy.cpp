@@ -0,0 +1,29 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "fusion_policy.h"
+#include <algorithm>
+
+namespace searchcorespi::index {
+
+bool
+FusionPolicy::fusion_due(const std::vector<uint64_t>& disk_index_sizes, uint32_t max_flushed) const noexcept
+{
+    uint32_t num_unfused = disk_index_sizes.size();
+    if (!is_tiered()) {
+        return num_unfused > max_flushed;
+    }
+    if (num_unfused > std::max(max_flushed, _max_disk_indexes)) {
+        return true;
+    }
+    if (num_unfused < 2) {
+        return false;
+    }
+    uint64_t base_size = disk_index_sizes.front();
+    uint64_t newer_size = 0;
+    for (auto it = disk_index_sizes.begin() + 1; it != disk_index_sizes.end(); ++it) {
+        newer_size += *it;
+    }
+    return static_cast<double>(newer_size) >= _size_ratio * static_cast<double>(base_size);
+}
+
+}
@@ -0,0 +1,45 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace searchcorespi::index {
+
+/**
+ * Policy deciding when fusion of disk indexes is due.
+ *
+ * Fusion merges the last fusion index with all flushed indexes after it.
+ * With the count based policy (size ratio 0), fusion is due when the number
+ * of unfused disk indexes exceeds max flushed.
+ *
+ * With the size tiered policy (size ratio > 0), flushed indexes are kept
+ * until their total size reaches size ratio times the size of the oldest
+ * disk index. Each fusion thus grows the fusion index by a constant factor
+ * instead of rewriting it for every few flushes. The number of disk indexes
+ * searched by queries is still bounded by max disk indexes, or by max flushed
+ * when that is larger (e.g. when the node is retired).
+ */
+class FusionPolicy {
+    double   _size_ratio;
+    uint32_t _max_disk_indexes;
+public:
+    FusionPolicy() noexcept : FusionPolicy(0.0, 0) { }
+    FusionPolicy(double size_ratio, uint32_t max_disk_indexes) noexcept
+        : _size_ratio(size_ratio), _max_disk_indexes(max_disk_indexes) { }
+    double get_size_ratio() const noexcept { return _size_ratio; }
+    uint32_t get_max_disk_indexes() const noexcept { return _max_disk_indexes; }
+    bool is_tiered() const noexcept { return _size_ratio > 0.0; }
+    bool operator==(const FusionPolicy& rhs) const noexcept = default;
+
+    /**
+     * Returns true if fusion is due.
+     *
+     * @param disk_index_sizes size on disk of the unfused disk indexes, oldest first.
+     *                         The first entry is the last fusion index, if present.
+     * @param max_flushed      max number of unfused disk indexes before fusion is forced.
+     */
+    bool fusion_due(const std::vector<uint64_t>& disk_index_sizes, uint32_t max_flushed) const noexcept;
+};
+
+}
@@ -8,6 +8,7 @@
 
 using vespalib::slime::Cursor;
 using vespalib::slime::Inserter;
+using search::FieldIndexStats;
 using search::IndexStats;
 using searchcorespi::index::DiskIndexStats;
 using searchcorespi::index::MemoryIndexStats;
@@ -42,6 +43,15 @@ insertMemoryUsage(Cursor &object, const vespalib::MemoryUsage &usage)
     memory.setLong("onHoldBytes", usage.allocatedBytesOnHold());
 }
 
+void
+insertFeatureStats(Cursor &object, const FieldIndexStats &stats)
+{
+    Cursor &features = object.setObject("features");
+    features.setLong("rawBytes", stats.raw_feature_bytes());
+    features.setLong("storedBytes", stats.stored_feature_bytes());
+    features.setDouble("compressionRatio", stats.feature_compression_ratio());
+}
+
 void
 insertMemoryIndex(Cursor &arrayCursor, const MemoryIndexStats &memoryIndex)
 {
@@ -50,6 +60,11 @@ insertMemoryIndex(Cursor &arrayCursor, const MemoryIndexStats &memoryIndex)
     memoryIndexCursor.setLong("serialNum", memoryIndex.getSerialNum());
     memoryIndexCursor.setLong("docsInMemory", sstats.docsInMemory());
     insertMemoryUsage(memoryIndexCursor, sstats.memoryUsage());
+    FieldIndexStats feature_stats;
+    for (auto& field_stats : sstats.get_field_stats()) {
+        feature_stats.merge(field_stats.second);
+    }
+    insertFeatureStats(memoryIndexCursor, feature_stats);
 }
 
 class WriteContextInserter : public IndexSearchableVisitor {
@@ -2,6 +2,8 @@
 
 #include "indexcollection.h"
 #include "indexsearchablevisitor.h"
+#include "warmup_term_sample.h"
+#include <vespa/searchlib/query/tree/termnodes.h>
 #include <vespa/searchlib/queryeval/isourceselector.h>
 #include <vespa/searchlib/queryeval/create_blueprint_visitor_helper.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
@@ -19,15 +21,21 @@ namespace searchcorespi {
 
 IndexCollection::IndexCollection(const ISourceSelector::SP & selector)
     : _source_selector(selector),
-      _sources()
+      _sources(),
+      _term_sample()
 {
 }
 
 IndexCollection::IndexCollection(const ISourceSelector::SP & selector,
                                  const ISearchableIndexCollection &sources)
     : _source_selector(selector),
-      _sources()
+      _sources(),
+      _term_sample()
 {
+    auto* index_collection = dynamic_cast<const IndexCollection *>(&sources);
+    if (index_collection != nullptr) {
+        _term_sample = index_collection->get_term_sample();
+    }
     for (size_t i(0), m(sources.getSourceCount()); i < m; i++) {
         append(sources.getSourceId(i), sources.getSearchableSP(i));
     }
@@ -43,6 +51,12 @@ IndexCollection::setSource(uint32_t docId)
     _source_selector->setSource(docId, getCurrentIndex());
 }
 
+void
+IndexCollection::set_term_sample(std::shared_ptr<index::WarmupTermSample> term_sample)
+{
+    _term_sample = std::move(term_sample);
+}
+
 ISearchableIndexCollection::UP
 IndexCollection::replaceAndRenumber(const ISourceSelector::SP & selector,
                                     const ISearchableIndexCollection &fsc,
@@ -50,6 +64,10 @@ IndexCollection::replaceAndRenumber(const ISourceSelector::SP & selector,
                                     const IndexSearchable::SP &new_source)
 {
     auto new_fsc = std::make_unique<IndexCollection>(selector);
+    auto* index_collection = dynamic_cast<const IndexCollection *>(&fsc);
+    if (index_collection != nullptr) {
+        new_fsc->set_term_sample(index_collection->get_term_sample());
+    }
     new_fsc->append(0, new_source);
     for (size_t i = 0; i < fsc.getSourceCount(); ++i) {
         if (fsc.getSourceId(i) > id_diff) {
@@ -237,11 +255,27 @@ IndexCollection::createBlueprint(const IRequestContext & requestContext,
                                  const FieldSpecList &fields,
                                  const Node &term)
 {
+    if (_term_sample) {
+        sample_terms(fields, term);
+    }
     CreateBlueprintVisitor visitor(*this, fields, requestContext);
     const_cast<Node &>(term).accept(visitor);
     return visitor.getResult();
 }
 
+void
+IndexCollection::sample_terms(const FieldSpecList &fields, const Node &term)
+{
+    // Only plain string terms are sampled, they are replayed as string terms
+    const auto * string_term = dynamic_cast<const StringTerm *>(&term);
+    if (string_term == nullptr) {
+        return;
+    }
+    for (size_t i = 0; i < fields.size(); ++i) {
+        _term_sample->add(fields[i].getName(), string_term->getTerm());
+    }
+}
+
 FieldLengthInfo
 IndexCollection::get_field_length_info(const std::string& field_name) const
 {
@@ -7,6 +7,8 @@
 
 namespace searchcorespi {
 
+namespace index { class WarmupTermSample; }
+
 /**
  * Holds a set of index searchables with source ids, and a source selector for
  * determining which index to use for each document.
@@ -27,6 +29,10 @@ class IndexCollection : public ISearchableIndexCollection
     using ISourceSelectorSP = std::shared_ptr<ISourceSelector>;
     ISourceSelectorSP         _source_selector;
     std::vector<SourceWithId> _sources;
+    // Optional sample of query terms, used for warmup of new disk indexes
+    std::shared_ptr<index::WarmupTermSample> _term_sample;
+
+    void sample_terms(const FieldSpecList &fields, const Node &term);
 
 public:
     IndexCollection(const ISourceSelectorSP & selector);
@@ -37,7 +43,8 @@ public:
     void replace(uint32_t id, const IndexSearchable::SP &source) override;
     IndexSearchable::SP getSearchableSP(uint32_t i) const override;
     void setSource(uint32_t docId)  override;
-
+    void set_term_sample(std::shared_ptr<index::WarmupTermSample> term_sample);
+    const std::shared_ptr<index::WarmupTermSample>& get_term_sample() const noexcept { return _term_sample; }
 
     // Implements IIndexCollection
     const ISourceSelector &getSourceSelector() const override;
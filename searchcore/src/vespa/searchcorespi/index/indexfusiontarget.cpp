@@ -61,15 +61,17 @@ IndexFusionTarget::getApproxDiskGain() const
     uint64_t diskUsageBefore = _fusionStats.diskUsage;
     uint64_t diskUsageGain = static_cast<uint64_t>((0.1 * (diskUsageBefore * std::max(0,static_cast<int>(_fusionStats.numUnfused - 1)))));
     diskUsageGain = std::min(diskUsageGain, diskUsageBefore);
-    if (!_fusionStats._canRunFusion)
+    if (!_fusionStats._canRunFusion || (_fusionStats.tiered && !_fusionStats.fusionDue)) {
+        // Size tiered fusion policy defers fusion until it is due
         diskUsageGain = 0;
+    }
     return DiskGain(diskUsageBefore, diskUsageBefore - diskUsageGain);
 }
 
 bool
 IndexFusionTarget::needUrgentFlush() const
 {
-    bool urgent = (_fusionStats.numUnfused > _fusionStats.maxFlushed || _indexMaintainer.urgent_disk_index_fusion()) &&
+    bool urgent = (_fusionStats.fusionDue || _indexMaintainer.urgent_disk_index_fusion()) &&
                   (_fusionStats._canRunFusion);
     LOG(debug, "Num flushed: %d Urgent: %d", _fusionStats.numUnfused, urgent);
     return urgent;
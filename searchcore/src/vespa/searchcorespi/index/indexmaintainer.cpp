@@ -319,6 +319,7 @@ IndexMaintainer::loadDiskIndex(const string &indexDir)
     }
     vespalib::Timer timer;
     auto index = _operations.loadDiskIndex(indexDir);
+    warmup_disk_index(*index, indexDir);
     auto stats = index->get_index_stats(false);
     _disk_indexes->setActive(indexDir, stats.sizeOnDisk());
     auto retval = std::make_shared<DiskIndexWithDestructorCleanup>(_remove_lock, std::move(index),
@@ -329,6 +330,34 @@ IndexMaintainer::loadDiskIndex(const string &indexDir)
     return retval;
 }
 
+void
+IndexMaintainer::save_warmup_terms(const string &indexDir)
+{
+    // Called by a flush worker thread
+    if (_warmup_term_sample) {
+        _warmup_term_sample->save(indexDir);
+    }
+}
+
+void
+IndexMaintainer::warmup_disk_index(IDiskIndex &index, const string &indexDir)
+{
+    // Called by a flush worker thread OR CTOR (in document db init executor thread)
+    if (!_warmup_term_sample) {
+        return;
+    }
+    auto terms = WarmupTermSample::load(indexDir);
+    if (terms.empty()) {
+        return;
+    }
+    vespalib::Timer timer;
+    uint32_t warmed_up = WarmupIndexCollection::warmup_terms(index, terms);
+    LOG(debug, "Warmed up disk index '%s' with %u of %zu sampled terms in %" PRId64 " ms",
+        indexDir.c_str(), warmed_up, terms.size(), vespalib::count_ms(timer.elapsed()));
+    // Seeds the sample after restart, terms already in the sample are ignored
+    _warmup_term_sample->add(terms);
+}
+
 std::shared_ptr<IDiskIndex>
 IndexMaintainer::reloadDiskIndex(const IDiskIndex &oldIndex)
 {
@@ -367,6 +396,7 @@ IndexMaintainer::flushMemoryIndex(IMemoryIndex &memoryIndex,
     IndexWriteUtilities::writeSourceSelector(saveInfo, indexId, getAttrTune(),
                                              _ctx.getFileHeaderContext(), serialNum);
     IndexWriteUtilities::writeSerialNum(serialNum, flushDir, _ctx.getFileHeaderContext());
+    save_warmup_terms(flushDir);
     return loadDiskIndex(flushDir);
 }
 
@@ -857,6 +887,7 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
                                  IIndexMaintainerOperations &operations)
     : _base_dir(config.getBaseDir()),
       _warmupConfig(config.getWarmup()),
+      _warmup_term_sample(),
       _disk_indexes(std::make_shared<DiskIndexes>()),
       _layout(std::make_shared<IndexDiskLayout>(config.getBaseDir())),
       _schema(config.getSchema()),
@@ -882,6 +913,7 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
       _fusion_spec(),
       _fusion_lock(),
       _maxFlushed(config.getMaxFlushed()),
+      _fusion_policy(config.get_fusion_policy()),
       _maxFrozen(10),
       _changeGens(),
       _schemaUpdateLock(),
@@ -890,6 +922,9 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
       _operations(operations)
 {
     // Called by document db init executor thread
+    if (_warmupConfig.get_term_sample_size() > 0) {
+        _warmup_term_sample = std::make_shared<WarmupTermSample>(_warmupConfig.get_term_sample_size());
+    }
     _changeGens.bumpPruneGen();
     DiskIndexCleaner::clean(_base_dir, *_disk_indexes);
     FusionSpec spec = IndexReadUtilities::readFusionSpec(_base_dir);
@@ -921,7 +956,9 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
     }
     set_id_for_new_memory_index();
     _selector->setDefaultSource(_current_index_id);
-    auto sourceList = loadDiskIndexes(spec, std::make_unique<IndexCollection>(_selector));
+    auto initialSourceList = std::make_unique<IndexCollection>(_selector);
+    initialSourceList->set_term_sample(_warmup_term_sample);
+    auto sourceList = loadDiskIndexes(spec, std::move(initialSourceList));
     _current_index = operations.createMemoryIndex(_schema, *sourceList, current_serial_num());
     LOG(debug, "Index manager created with flushed serial num %" PRIu64, flush_serial_num());
     sourceList->append(_current_index_id, _current_index);
@@ -1100,6 +1137,7 @@ IndexMaintainer::runFusion(const FusionSpec &fusion_spec, std::shared_ptr<search
     if (prunedSchema) {
         updateDiskIndexSchema(new_fusion_dir, *prunedSchema, noSerialNumHigh);
     }
+    save_warmup_terms(new_fusion_dir);
     ChangeGens changeGens = getChangeGens();
     auto new_index(loadDiskIndex(new_fusion_dir));
     remove_fusion_index_guard.reset();
@@ -1172,12 +1210,27 @@ IndexMaintainer::getFlushStats() const
     return stats;
 }
 
+std::vector<uint64_t>
+IndexMaintainer::get_unfused_disk_index_sizes(const FusionSpec &spec) const
+{
+    std::vector<uint64_t> sizes;
+    sizes.reserve(spec.flush_ids.size() + 1);
+    if (spec.last_fusion_id != 0) {
+        sizes.emplace_back(_disk_indexes->get_size_on_disk(IndexDiskDir(spec.last_fusion_id, true)).value_or(0));
+    }
+    for (uint32_t id : spec.flush_ids) {
+        sizes.emplace_back(_disk_indexes->get_size_on_disk(IndexDiskDir(id, false)).value_or(0));
+    }
+    return sizes;
+}
+
 IndexMaintainer::FusionStats
 IndexMaintainer::getFusionStats() const
 {
     // Called by flush engine scheduler thread (from getFlushTargets())
     FusionStats stats;
     std::shared_ptr<IndexSearchable> source_list;
+    std::vector<uint64_t> disk_index_sizes;
 
     {
         LockGuard lock(_new_search_lock);
@@ -1189,8 +1242,12 @@ IndexMaintainer::getFusionStats() const
         LockGuard guard(_fusion_lock);
         stats.numUnfused = _fusion_spec.flush_ids.size() + ((_fusion_spec.last_fusion_id != 0) ? 1 : 0);
         stats._canRunFusion = canRunFusion(_fusion_spec);
+        disk_index_sizes = get_unfused_disk_index_sizes(_fusion_spec);
     }
-    LOG(debug, "Get fusion stats. Disk usage: %" PRIu64 ", maxflushed: %d", stats.diskUsage, stats.maxFlushed);
+    stats.fusionDue = _fusion_policy.fusion_due(disk_index_sizes, stats.maxFlushed);
+    stats.tiered = _fusion_policy.is_tiered();
+    LOG(debug, "Get fusion stats. Disk usage: %" PRIu64 ", maxflushed: %d, fusion due: %s",
+        stats.diskUsage, stats.maxFlushed, (stats.fusionDue ? "true" : "false"));
     return stats;
 }
 
@@ -1323,7 +1380,9 @@ IndexMaintainer::pruneRemovedFields(const Schema &schema, SerialNum serialNum)
     }
     {
         LockGuard state_lock(_state_lock);
-        new_source_list = std::make_shared<IndexCollection>(_selector, *_source_list);
+        auto index_collection = std::make_shared<IndexCollection>(_selector, *_source_list);
+        index_collection->set_term_sample(_warmup_term_sample);
+        new_source_list = std::move(index_collection);
     }
     if (reopenDiskIndexes(*new_source_list)) {
         commit_and_wait();
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "iindexmanager.h"
+#include "fusion_policy.h"
 #include "fusionspec.h"
 #include "iindexmaintaineroperations.h"
 #include "indexdisklayout.h"
@@ -73,6 +74,8 @@ class IndexMaintainer : public IIndexManager,
 
     const std::string _base_dir;
     const WarmupConfig     _warmupConfig;
+    // Sample of recent query terms, saved with and replayed against new disk indexes
+    std::shared_ptr<WarmupTermSample> _warmup_term_sample;
     std::shared_ptr<DiskIndexes>  _disk_indexes;
     std::shared_ptr<IndexDiskLayout> _layout;
     Schema                  _schema;             // Protected by SL + IUL
@@ -133,6 +136,7 @@ class IndexMaintainer : public IIndexManager,
     FusionSpec                       _fusion_spec;       // Protected by FL
     mutable std::mutex               _fusion_lock;       // Fusion spec lock (FL)
     uint32_t                         _maxFlushed;        // Protected by NSL
+    const FusionPolicy               _fusion_policy;
     const uint32_t                   _maxFrozen;
     ChangeGens                       _changeGens;        // Protected by SL + IUL
     std::mutex                       _schemaUpdateLock;  // Serialize rewrite of schema
@@ -166,6 +170,8 @@ class IndexMaintainer : public IIndexManager,
 
     void updateActiveFusionPrunedSchema(const Schema &schema);
     std::shared_ptr<IDiskIndex> loadDiskIndex(const std::string &indexDir);
+    void save_warmup_terms(const std::string &indexDir);
+    void warmup_disk_index(IDiskIndex &index, const std::string &indexDir);
     std::shared_ptr<IDiskIndex> reloadDiskIndex(const IDiskIndex &oldIndex);
 
     std::shared_ptr<IDiskIndex> flushMemoryIndex(IMemoryIndex &memoryIndex,
@@ -230,6 +236,7 @@ class IndexMaintainer : public IIndexManager,
 
     void scheduleFusion(const FlushIds &flushIds);
     bool canRunFusion(const FusionSpec &spec) const;
+    std::vector<uint64_t> get_unfused_disk_index_sizes(const FusionSpec &spec) const;
     bool doneFusion(FusionArgs *args, std::shared_ptr<IDiskIndex> *new_index);
 
     class SetSchemaArgs {
@@ -315,13 +322,17 @@ public:
             : diskUsage(0),
               maxFlushed(0),
               numUnfused(0),
-              _canRunFusion(false)
+              _canRunFusion(false),
+              fusionDue(false),
+              tiered(false)
         { }
 
         uint64_t diskUsage;
         uint32_t maxFlushed;
         uint32_t numUnfused;
         bool _canRunFusion;
+        bool fusionDue;  // Decided by fusion policy
+        bool tiered;
     };
 
     /**
@@ -10,12 +10,14 @@ namespace searchcorespi::index {
 IndexMaintainerConfig::IndexMaintainerConfig(const std::string &baseDir,
                                              const WarmupConfig & warmup,
                                              size_t maxFlushed,
+                                             const FusionPolicy & fusion_policy,
                                              const Schema &schema,
                                              const search::SerialNum serialNum,
                                              const TuneFileAttributes &tuneFileAttributes)
     : _baseDir(baseDir),
       _warmup(warmup),
       _maxFlushed(maxFlushed),
+      _fusion_policy(fusion_policy),
       _schema(schema),
       _serialNum(serialNum),
       _tuneFileAttributes(tuneFileAttributes)
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "fusion_policy.h"
 #include "warmupconfig.h"
 #include <vespa/searchlib/common/tunefileinfo.h>
 #include <vespa/searchlib/common/serialnum.h>
@@ -17,6 +18,7 @@ private:
     const std::string _baseDir;
     const WarmupConfig _warmup;
     const size_t _maxFlushed;
+    const FusionPolicy _fusion_policy;
     const search::index::Schema _schema;
     const search::SerialNum _serialNum;
     const search::TuneFileAttributes _tuneFileAttributes;
@@ -25,6 +27,7 @@ public:
     IndexMaintainerConfig(const std::string &baseDir,
                           const WarmupConfig & warmup,
                           size_t maxFlushed,
+                          const FusionPolicy & fusion_policy,
                           const search::index::Schema &schema,
                           const search::SerialNum serialNum,
                           const search::TuneFileAttributes &tuneFileAttributes);
@@ -59,6 +62,13 @@ public:
     size_t getMaxFlushed() const {
         return _maxFlushed;
     }
+
+    /**
+     * Returns the policy deciding when fusion of disk indexes is due.
+     */
+    const FusionPolicy &get_fusion_policy() const {
+        return _fusion_policy;
+    }
 };
 
 }
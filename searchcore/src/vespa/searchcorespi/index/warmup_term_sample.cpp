@@ -0,0 +1,168 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "warmup_term_sample.h"
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/stllike/hash_set.hpp>
+#include <vespa/vespalib/util/exceptions.h>
+#include <filesystem>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".searchcorespi.index.warmup_term_sample");
+
+using vespalib::nbostream;
+
+namespace fs = std::filesystem;
+
+namespace searchcorespi::index {
+
+namespace {
+
+constexpr uint32_t file_magic = 0x5754524d; // "WTRM"
+
+}
+
+WarmupTermSample::WarmupTermSample(uint32_t max_terms)
+    : _max_terms(max_terms),
+      _lock(),
+      _terms(),
+      _next(0),
+      _keys()
+{
+    _terms.reserve(max_terms);
+}
+
+WarmupTermSample::~WarmupTermSample() = default;
+
+std::string
+WarmupTermSample::make_key(std::string_view field, std::string_view term)
+{
+    std::string key;
+    key.reserve(field.size() + 1 + term.size());
+    key.append(field);
+    key.push_back('\0');
+    key.append(term);
+    return key;
+}
+
+void
+WarmupTermSample::add_locked(std::string_view field, std::string_view term)
+{
+    if (_max_terms == 0) {
+        return;
+    }
+    auto key = make_key(field, term);
+    if (_keys.find(key) != _keys.end()) {
+        return;
+    }
+    if (_terms.size() < _max_terms) {
+        _terms.emplace_back(std::string(field), std::string(term));
+    } else {
+        // Replace the oldest term
+        auto& oldest = _terms[_next];
+        _keys.erase(make_key(oldest.field, oldest.term));
+        oldest = Term(std::string(field), std::string(term));
+        _next = (_next + 1) % _max_terms;
+    }
+    _keys.insert(std::move(key));
+}
+
+void
+WarmupTermSample::add(std::string_view field, std::string_view term)
+{
+    std::unique_lock guard(_lock, std::try_to_lock);
+    if (guard.owns_lock()) {
+        add_locked(field, term);
+    }
+}
+
+void
+WarmupTermSample::add(const std::vector<Term>& terms)
+{
+    std::lock_guard guard(_lock);
+    for (const auto& term : terms) {
+        add_locked(term.field, term.term);
+    }
+}
+
+std::vector<WarmupTermSample::Term>
+WarmupTermSample::get_terms() const
+{
+    std::lock_guard guard(_lock);
+    std::vector<Term> result;
+    result.reserve(_terms.size());
+    result.insert(result.end(), _terms.begin() + _next, _terms.end());
+    result.insert(result.end(), _terms.begin(), _terms.begin() + _next);
+    return result;
+}
+
+void
+WarmupTermSample::save(const std::string& dir) const
+{
+    // Called by a flush worker thread
+    auto terms = get_terms();
+    if (terms.empty()) {
+        return;
+    }
+    nbostream os;
+    os << file_magic << uint32_t(terms.size());
+    for (const auto& term : terms) {
+        os << term.field << term.term;
+    }
+    const std::string file_name = get_file_name(dir);
+    const std::string tmp_file_name = file_name + ".tmp";
+    try {
+        {
+            vespalib::File file(tmp_file_name);
+            file.open(vespalib::File::CREATE | vespalib::File::TRUNC);
+            file.write(os.data(), os.size(), 0);
+            file.close();
+        }
+        vespalib::File::sync(tmp_file_name);
+        fs::rename(fs::path(tmp_file_name), fs::path(file_name));
+        vespalib::File::sync(dir);
+    } catch (const std::exception& e) {
+        // The sampled terms are only used for warmup, the index is still usable without them
+        LOG(warning, "Unable to save warmup terms to '%s': %s", file_name.c_str(), e.what());
+    }
+}
+
+std::vector<WarmupTermSample::Term>
+WarmupTermSample::load(const std::string& dir)
+{
+    std::vector<Term> result;
+    const std::string file_name = get_file_name(dir);
+    if (!fs::exists(fs::path(file_name))) {
+        return result;
+    }
+    try {
+        auto buf = vespalib::File::readAll(file_name);
+        nbostream is(buf.data(), buf.size());
+        uint32_t magic = 0;
+        uint32_t num_terms = 0;
+        is >> magic >> num_terms;
+        if (magic != file_magic) {
+            LOG(warning, "Bad magic in warmup terms file '%s'", file_name.c_str());
+            return result;
+        }
+        result.reserve(std::min(num_terms, uint32_t(is.size() / (2 * sizeof(uint32_t)))));
+        for (uint32_t i = 0; i < num_terms; ++i) {
+            std::string field;
+            std::string term;
+            is >> field >> term;
+            result.emplace_back(std::move(field), std::move(term));
+        }
+    } catch (const std::exception& e) {
+        LOG(warning, "Unable to load warmup terms from '%s': %s", file_name.c_str(), e.what());
+        result.clear();
+    }
+    return result;
+}
+
+std::string
+WarmupTermSample::get_file_name(const std::string& dir)
+{
+    return dir + "/warmup.terms";
+}
+
+}
@@ -0,0 +1,59 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/hash_set.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace searchcorespi::index {
+
+/**
+ * Bounded sample of the most recent distinct (field, term) pairs used by
+ * queries against an index collection.
+ *
+ * The sample is saved to a new disk index directory when a memory index is
+ * flushed or disk indexes are fused, and the terms are replayed against the
+ * new disk index before it is swapped in. This populates the posting list
+ * cache and avoids a latency spike when the new disk index starts serving.
+ * On restart the sample is seeded from the terms saved with the disk indexes.
+ *
+ * Adding terms is done by query threads and is skipped when the sample is
+ * being updated by another thread.
+ */
+class WarmupTermSample {
+public:
+    struct Term {
+        std::string field;
+        std::string term;
+        Term(std::string field_in, std::string term_in) noexcept
+            : field(std::move(field_in)), term(std::move(term_in))
+        { }
+        bool operator==(const Term& rhs) const noexcept = default;
+    };
+private:
+    const uint32_t                  _max_terms;
+    mutable std::mutex              _lock;
+    std::vector<Term>               _terms;
+    uint32_t                        _next;
+    vespalib::hash_set<std::string> _keys;
+
+    static std::string make_key(std::string_view field, std::string_view term);
+    void add_locked(std::string_view field, std::string_view term);
+public:
+    explicit WarmupTermSample(uint32_t max_terms);
+    ~WarmupTermSample();
+    uint32_t max_terms() const noexcept { return _max_terms; }
+    // Called by query threads, skips the term if the sample is contended
+    void add(std::string_view field, std::string_view term);
+    void add(const std::vector<Term>& terms);
+    // Returns the sampled terms, oldest first
+    std::vector<Term> get_terms() const;
+    void save(const std::string& dir) const;
+    // Returns an empty vector if the file is missing or corrupt
+    static std::vector<Term> load(const std::string& dir);
+    static std::string get_file_name(const std::string& dir);
+};
+
+}
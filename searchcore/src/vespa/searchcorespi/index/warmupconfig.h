@@ -10,13 +10,18 @@ namespace searchcorespi::index {
  **/
 class WarmupConfig {
 public:
-    WarmupConfig() : _duration(vespalib::duration::zero()), _unpack(false) { }
-    WarmupConfig(vespalib::duration duration, bool unpack) : _duration(duration), _unpack(unpack) { }
+    WarmupConfig() : WarmupConfig(vespalib::duration::zero(), false) { }
+    WarmupConfig(vespalib::duration duration, bool unpack) : WarmupConfig(duration, unpack, 0) { }
+    WarmupConfig(vespalib::duration duration, bool unpack, uint32_t term_sample_size)
+        : _duration(duration), _unpack(unpack), _term_sample_size(term_sample_size) { }
     vespalib::duration getDuration() const { return _duration; }
     bool getUnpack() const { return _unpack; }
+    // Max number of recent query terms sampled for warmup of new disk indexes, 0 disables sampling
+    uint32_t get_term_sample_size() const { return _term_sample_size; }
 private:
     const vespalib::duration _duration;
     const bool               _unpack;
+    const uint32_t           _term_sample_size;
 };
 
 }
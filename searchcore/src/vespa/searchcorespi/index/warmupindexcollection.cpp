@@ -3,6 +3,7 @@
 #include "warmupindexcollection.h"
 #include "idiskindex.h"
 #include <vespa/searchlib/fef/matchdatalayout.h>
+#include <vespa/searchlib/query/tree/simplequery.h>
 #include <vespa/searchlib/query/tree/termnodes.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/searchlib/queryeval/i_element_gap_inspector.h>
@@ -18,6 +19,7 @@ LOG_SETUP(".searchcorespi.index.warmupindexcollection");
 namespace searchcorespi {
 
 using index::IDiskIndex;
+using index::WarmupTermSample;
 using search::fef::ElementGap;
 using search::fef::MatchDataLayout;
 using search::fef::MatchData;
@@ -280,6 +282,29 @@ WarmupIndexCollection::drainPending() {
     _pendingTasks.waitForZeroRefCount();
 }
 
+uint32_t
+WarmupIndexCollection::warmup_terms(IDiskIndex & index, const std::vector<WarmupTermSample::Term> & terms)
+{
+    WarmupRequestContext requestContext;
+    const auto & schema = index.getSchema();
+    uint32_t warmed_up = 0;
+    for (const auto & term : terms) {
+        uint32_t fieldId = schema.getIndexFieldId(term.field);
+        if (fieldId == search::index::Schema::UNKNOWN_FIELD_ID) {
+            continue;
+        }
+        MatchDataLayout mdl;
+        FieldSpec field(term.field, fieldId, mdl.allocTermField(fieldId));
+        search::query::SimpleStringTerm node(term.term, term.field, 0, search::query::Weight(100));
+        auto blueprint = index.createBlueprint(requestContext, field, node);
+        uint32_t dummy_docid_limit = 1337;
+        blueprint->basic_plan(true, dummy_docid_limit);
+        blueprint->fetchPostings(search::queryeval::ExecuteInfo::FULL);
+        ++warmed_up;
+    }
+    return warmed_up;
+}
+
 WarmupRequestContext::WarmupRequestContext() = default;
 WarmupRequestContext::~WarmupRequestContext() = default;
 
@@ -4,6 +4,7 @@
 
 #include "isearchableindexcollection.h"
 #include "warmupconfig.h"
+#include "warmup_term_sample.h"
 #include <vespa/searchlib/queryeval/create_blueprint_params.h>
 #include <vespa/vespalib/util/doom.h>
 #include <vespa/vespalib/util/executor.h>
@@ -12,6 +13,8 @@
 
 namespace searchcorespi {
 
+namespace index { struct IDiskIndex; }
+
 class FieldTermMap;
 class WarmupIndexCollection;
 
@@ -67,6 +70,13 @@ public:
     void drainPending();
     vespalib::steady_time warmupEndTime() const { return _warmupEndTime; }
     vespalib::MonitoredRefCount & pendingTasks() { return _pendingTasks; }
+    /**
+     * Warms up a disk index that is not yet serving by looking up the given sampled
+     * terms in its dictionaries and fetching their posting lists, populating the
+     * posting list cache. Terms for fields not in the disk index are ignored.
+     * Returns the number of terms looked up.
+     */
+    static uint32_t warmup_terms(index::IDiskIndex & index, const std::vector<index::WarmupTermSample::Term> & terms);
 private:
     using Task = vespalib::Executor::Task;
 
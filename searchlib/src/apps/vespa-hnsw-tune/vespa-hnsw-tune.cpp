@@ -0,0 +1,621 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/typed_cells.h>
+#include <vespa/eval/eval/value.h>
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchlib/attribute/distance_metric_utils.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/queryeval/global_filter.h>
+#include <vespa/searchlib/tensor/dense_tensor_attribute.h>
+#include <vespa/searchlib/tensor/distance_function_factory.h>
+#include <vespa/searchlib/tensor/hnsw_index.h>
+#include <vespa/searchlib/tensor/inv_log_level_generator.h>
+#include <vespa/vespalib/util/doom.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/signalhandler.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/time.h>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <getopt.h>
+#include <limits>
+#include <random>
+#include <sstream>
+
+#include <vespa/log/log.h>
+LOG_SETUP("vespa-hnsw-tune");
+
+using search::BitVector;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+using search::attribute::DistanceMetric;
+using search::attribute::DistanceMetricUtils;
+using search::queryeval::GlobalFilter;
+using search::tensor::DenseTensorAttribute;
+using search::tensor::DistanceFunctionFactory;
+using search::tensor::HnswIndex;
+using search::tensor::HnswIndexConfig;
+using search::tensor::HnswIndexType;
+using search::tensor::InvLogLevelGenerator;
+using search::tensor::NearestNeighborIndex;
+using vespalib::GenerationHandler;
+using vespalib::IllegalArgumentException;
+using vespalib::eval::CellType;
+using vespalib::eval::DenseValueView;
+using vespalib::eval::TypedCells;
+using vespalib::eval::ValueType;
+
+namespace {
+
+/**
+ * Vectors read from an ANN dataset file, stored contiguously as floats.
+ */
+struct VectorSet {
+    uint32_t dims;
+    std::vector<float> cells;
+    VectorSet() noexcept : dims(0), cells() {}
+    size_t size() const noexcept { return (dims == 0) ? 0 : cells.size() / dims; }
+    TypedCells operator[](size_t i) const noexcept {
+        return TypedCells(std::span<const float>(cells.data() + i * dims, dims));
+    }
+};
+
+bool
+ends_with(const std::string& str, const std::string& suffix)
+{
+    return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+ * Reads a file in the fvecs, bvecs or ivecs format, where each vector is stored as
+ * its number of dimensions (int32) followed by the cells (float, uint8 or int32).
+ */
+template <typename CellT, typename ResultT>
+std::vector<ResultT>
+read_vecs(const std::string& file_name, size_t max_vectors, uint32_t& dims)
+{
+    std::ifstream file(file_name, std::ios::binary);
+    if (!file) {
+        throw IllegalArgumentException("Cannot open '" + file_name + "'");
+    }
+    std::vector<ResultT> result;
+    std::vector<CellT> buf;
+    dims = 0;
+    for (size_t i = 0; i < max_vectors; ++i) {
+        int32_t d = 0;
+        if (!file.read(reinterpret_cast<char*>(&d), sizeof(d))) {
+            break;
+        }
+        if (d <= 0 || (dims != 0 && uint32_t(d) != dims)) {
+            throw IllegalArgumentException("Bad vector dimension " + std::to_string(d) + " in '" + file_name + "'");
+        }
+        dims = d;
+        buf.resize(dims);
+        if (!file.read(reinterpret_cast<char*>(buf.data()), dims * sizeof(CellT))) {
+            throw IllegalArgumentException("Truncated vector in '" + file_name + "'");
+        }
+        result.insert(result.end(), buf.begin(), buf.end());
+    }
+    return result;
+}
+
+VectorSet
+read_vectors(const std::string& file_name, size_t max_vectors)
+{
+    VectorSet result;
+    if (ends_with(file_name, ".fvecs")) {
+        result.cells = read_vecs<float, float>(file_name, max_vectors, result.dims);
+    } else if (ends_with(file_name, ".bvecs")) {
+        result.cells = read_vecs<uint8_t, float>(file_name, max_vectors, result.dims);
+    } else {
+        throw IllegalArgumentException("Unsupported vector file format '" + file_name + "' (expected .fvecs or .bvecs)");
+    }
+    if (result.size() == 0) {
+        throw IllegalArgumentException("No vectors in '" + file_name + "'");
+    }
+    return result;
+}
+
+/**
+ * Reads the ids of the true nearest neighbors per query (ivecs), converted to docids.
+ */
+std::vector<std::vector<uint32_t>>
+read_ground_truth(const std::string& file_name, size_t max_queries, uint32_t k)
+{
+    uint32_t dims = 0;
+    auto ids = read_vecs<int32_t, int32_t>(file_name, max_queries, dims);
+    if (dims < k) {
+        throw IllegalArgumentException("Ground truth in '" + file_name + "' has fewer than " + std::to_string(k) + " neighbors per query");
+    }
+    std::vector<std::vector<uint32_t>> result;
+    for (size_t i = 0; i < ids.size() / dims; ++i) {
+        std::vector<uint32_t> docids;
+        for (uint32_t j = 0; j < k; ++j) {
+            docids.push_back(ids[i * dims + j] + 1);
+        }
+        result.push_back(std::move(docids));
+    }
+    return result;
+}
+
+template <typename T>
+std::vector<T>
+parse_list(const char* arg)
+{
+    std::vector<T> result;
+    std::istringstream is(arg);
+    std::string item;
+    while (std::getline(is, item, ',')) {
+        std::istringstream item_is(item);
+        T value;
+        if (!(item_is >> value)) {
+            throw IllegalArgumentException("Bad list value '" + item + "' in '" + arg + "'");
+        }
+        result.push_back(value);
+    }
+    return result;
+}
+
+double
+to_mb(size_t bytes)
+{
+    return double(bytes) / 1_Mi;
+}
+
+struct Options {
+    std::string base_file;
+    std::string query_file;
+    std::string ground_truth_file;
+    size_t max_docs;
+    size_t max_queries;
+    DistanceMetric metric;
+    uint32_t threads;
+    uint32_t search_threads;
+    uint32_t target_hits;
+    std::vector<uint32_t> max_links_per_node;
+    std::vector<uint32_t> neighbors_to_explore_at_insert;
+    std::vector<uint32_t> explore_additional_hits;
+    std::vector<double> exploration_slack;
+    std::vector<double> filter_hit_ratios;
+    std::vector<double> filter_first_exploration;
+    double approximate_threshold;
+    double filter_first_threshold;
+    Options();
+    ~Options();
+};
+
+// The query defaults match the rank profile defaults for nearest neighbor search.
+Options::Options()
+    : base_file(),
+      query_file(),
+      ground_truth_file(),
+      max_docs(std::numeric_limits<size_t>::max()),
+      max_queries(1000),
+      metric(DistanceMetric::Euclidean),
+      threads(1),
+      search_threads(1),
+      target_hits(10),
+      max_links_per_node({16}),
+      neighbors_to_explore_at_insert({200}),
+      explore_additional_hits({0}),
+      exploration_slack({0.0}),
+      filter_hit_ratios({1.0}),
+      filter_first_exploration({0.01}),
+      approximate_threshold(0.05),
+      filter_first_threshold(0.0)
+{
+}
+
+Options::~Options() = default;
+
+struct SearchParams {
+    uint32_t explore_additional_hits;
+    double exploration_slack;
+    double filter_first_exploration;
+};
+
+struct SearchResult {
+    double recall;
+    double qps;
+    double avg_latency_ms;
+    double visited_nodes;
+    double distance_computations;
+};
+
+class HnswTuneApp {
+    Options _opts;
+    VectorSet _docs;
+    VectorSet _queries;
+    ValueType _tensor_type;
+    std::shared_ptr<DenseTensorAttribute> _attr;
+    std::unique_ptr<DistanceFunctionFactory> _dff;
+    std::unique_ptr<vespalib::ThreadStackExecutor> _executor;
+
+    void usage(const char* self);
+    bool parse_options(int argc, char** argv);
+    void load_vectors();
+    std::shared_ptr<GlobalFilter> make_filter(double hit_ratio, uint32_t seed) const;
+    std::vector<uint32_t> exact_top_k(TypedCells query, const GlobalFilter* filter) const;
+    std::vector<std::vector<uint32_t>> exact_ground_truth(const GlobalFilter* filter);
+    std::unique_ptr<NearestNeighborIndex> build_index(uint32_t max_links_per_node, uint32_t neighbors_to_explore_at_insert);
+    std::vector<uint32_t> search(const NearestNeighborIndex& index, TypedCells query, const GlobalFilter* filter,
+                                 double hit_ratio, const SearchParams& params, NearestNeighborIndex::SearchStats& stats) const;
+    SearchResult run_queries(const NearestNeighborIndex& index, const GlobalFilter* filter, double hit_ratio,
+                             const SearchParams& params, const std::vector<std::vector<uint32_t>>& ground_truth);
+    void sweep(const NearestNeighborIndex& index);
+public:
+    HnswTuneApp();
+    ~HnswTuneApp();
+    int main(int argc, char** argv);
+};
+
+HnswTuneApp::HnswTuneApp()
+    : _opts(),
+      _docs(),
+      _queries(),
+      _tensor_type(ValueType::error_type()),
+      _attr(),
+      _dff(),
+      _executor()
+{
+}
+
+HnswTuneApp::~HnswTuneApp() = default;
+
+void
+HnswTuneApp::usage(const char* self)
+{
+    fprintf(stderr,
+            "Usage: %s [options] <base.fvecs|base.bvecs> <query.fvecs|query.bvecs>\n"
+            "Builds hnsw indexes over the base vectors and sweeps the search parameters, reporting recall, QPS, build time and memory.\n"
+            "List options take comma separated values, and all combinations are tried.\n"
+            "  --ground-truth <file.ivecs>              true nearest neighbors per query (otherwise computed by exact search)\n"
+            "  --max-docs <num>                         number of base vectors to use (default all)\n"
+            "  --max-queries <num>                      number of queries to use (default 1000)\n"
+            "  --distance-metric <metric>               euclidean, angular, innerproduct, prenormalized_angular, dotproduct (default euclidean)\n"
+            "  --threads <num>                          threads used to build the index (default 1)\n"
+            "  --search-threads <num>                   threads issuing queries (default 1)\n"
+            "  --target-hits <num>                      k in recall@k (default 10)\n"
+            "  --max-links-per-node <list>              (default 16)\n"
+            "  --neighbors-to-explore-at-insert <list>  (default 200)\n"
+            "  --explore-additional-hits <list>         (default 0)\n"
+            "  --exploration-slack <list>               (default 0.0)\n"
+            "  --filter-hit-ratios <list>               hit ratios of synthetic global filters, 1.0 is no filter (default 1.0)\n"
+            "  --filter-first-exploration <list>        (default 0.01)\n"
+            "  --approximate-threshold <ratio>          use exact search below this filter hit ratio (default 0.05)\n"
+            "  --filter-first-threshold <ratio>         use filter first below this filter hit ratio (default 0.0)\n",
+            self);
+}
+
+bool
+HnswTuneApp::parse_options(int argc, char** argv)
+{
+    static struct option long_opts[] = {
+        { "ground-truth", 1, nullptr, 0 },
+        { "max-docs", 1, nullptr, 0 },
+        { "max-queries", 1, nullptr, 0 },
+        { "distance-metric", 1, nullptr, 0 },
+        { "threads", 1, nullptr, 0 },
+        { "search-threads", 1, nullptr, 0 },
+        { "target-hits", 1, nullptr, 0 },
+        { "max-links-per-node", 1, nullptr, 0 },
+        { "neighbors-to-explore-at-insert", 1, nullptr, 0 },
+        { "explore-additional-hits", 1, nullptr, 0 },
+        { "exploration-slack", 1, nullptr, 0 },
+        { "filter-hit-ratios", 1, nullptr, 0 },
+        { "filter-first-exploration", 1, nullptr, 0 },
+        { "approximate-threshold", 1, nullptr, 0 },
+        { "filter-first-threshold", 1, nullptr, 0 },
+        { nullptr, 0, nullptr, 0 }
+    };
+    int c;
+    int long_opt_index = 0;
+    optind = 1;
+    while ((c = getopt_long(argc, argv, "", long_opts, &long_opt_index)) != -1) {
+        if (c != 0) {
+            return false;
+        }
+        std::string name(long_opts[long_opt_index].name);
+        if (name == "ground-truth") {
+            _opts.ground_truth_file = optarg;
+        } else if (name == "max-docs") {
+            _opts.max_docs = strtoul(optarg, nullptr, 10);
+        } else if (name == "max-queries") {
+            _opts.max_queries = strtoul(optarg, nullptr, 10);
+        } else if (name == "distance-metric") {
+            _opts.metric = DistanceMetricUtils::to_distance_metric(optarg);
+        } else if (name == "threads") {
+            _opts.threads = std::max(1ul, strtoul(optarg, nullptr, 10));
+        } else if (name == "search-threads") {
+            _opts.search_threads = std::max(1ul, strtoul(optarg, nullptr, 10));
+        } else if (name == "target-hits") {
+            _opts.target_hits = std::max(1ul, strtoul(optarg, nullptr, 10));
+        } else if (name == "max-links-per-node") {
+            _opts.max_links_per_node = parse_list<uint32_t>(optarg);
+        } else if (name == "neighbors-to-explore-at-insert") {
+            _opts.neighbors_to_explore_at_insert = parse_list<uint32_t>(optarg);
+        } else if (name == "explore-additional-hits") {
+            _opts.explore_additional_hits = parse_list<uint32_t>(optarg);
+        } else if (name == "exploration-slack") {
+            _opts.exploration_slack = parse_list<double>(optarg);
+        } else if (name == "filter-hit-ratios") {
+            _opts.filter_hit_ratios = parse_list<double>(optarg);
+        } else if (name == "filter-first-exploration") {
+            _opts.filter_first_exploration = parse_list<double>(optarg);
+        } else if (name == "approximate-threshold") {
+            _opts.approximate_threshold = strtod(optarg, nullptr);
+        } else if (name == "filter-first-threshold") {
+            _opts.filter_first_threshold = strtod(optarg, nullptr);
+        }
+    }
+    if (optind + 2 != argc) {
+        return false;
+    }
+    _opts.base_file = argv[optind];
+    _opts.query_file = argv[optind + 1];
+    for (double ratio : _opts.filter_hit_ratios) {
+        if (ratio <= 0.0 || ratio > 1.0) {
+            throw IllegalArgumentException("Filter hit ratio must be in the range (0.0, 1.0]");
+        }
+    }
+    return true;
+}
+
+void
+HnswTuneApp::load_vectors()
+{
+    vespalib::Timer timer;
+    _docs = read_vectors(_opts.base_file, _opts.max_docs);
+    _queries = read_vectors(_opts.query_file, _opts.max_queries);
+    if (_docs.dims != _queries.dims) {
+        throw IllegalArgumentException("Base vectors and query vectors have different dimensions");
+    }
+    _tensor_type = ValueType::from_spec("tensor<float>(x[" + std::to_string(_docs.dims) + "])");
+    Config cfg(BasicType::TENSOR, CollectionType::SINGLE);
+    cfg.setTensorType(_tensor_type);
+    cfg.set_distance_metric(_opts.metric);
+    // The attribute only stores the vectors, the hnsw indexes are built separately.
+    _attr = std::make_shared<DenseTensorAttribute>("vectors", cfg);
+    _attr->addReservedDoc();
+    _attr->addDocs(_docs.size());
+    for (size_t i = 0; i < _docs.size(); ++i) {
+        _attr->setTensor(i + 1, DenseValueView(_tensor_type, _docs[i]));
+        if ((i % 10000) == 0) {
+            _attr->commit();
+        }
+    }
+    _attr->commit(true);
+    _dff = search::tensor::make_distance_function_factory(_opts.metric, CellType::FLOAT);
+    fprintf(stdout, "loaded %zu documents and %zu queries with %u dimensions in %.3f s, vectors memory: %.1f MB\n",
+            _docs.size(), _queries.size(), _docs.dims, vespalib::to_s(timer.elapsed()),
+            to_mb(_attr->getStatus().getUsed()));
+}
+
+std::shared_ptr<GlobalFilter>
+HnswTuneApp::make_filter(double hit_ratio, uint32_t seed) const
+{
+    uint32_t docid_limit = _docs.size() + 1;
+    auto bits = BitVector::create(docid_limit);
+    std::mt19937 gen(seed);
+    std::bernoulli_distribution dist(hit_ratio);
+    for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+        if (dist(gen)) {
+            bits->setBit(docid);
+        }
+    }
+    bits->invalidateCachedCount();
+    return GlobalFilter::create(std::move(bits));
+}
+
+std::vector<uint32_t>
+HnswTuneApp::exact_top_k(TypedCells query, const GlobalFilter* filter) const
+{
+    auto df = _dff->for_query_vector(query);
+    std::vector<std::pair<double, uint32_t>> hits;
+    hits.reserve(_docs.size());
+    for (size_t i = 0; i < _docs.size(); ++i) {
+        uint32_t docid = i + 1;
+        if (filter == nullptr || filter->check(docid)) {
+            hits.emplace_back(df->calc(_docs[i]), docid);
+        }
+    }
+    size_t k = std::min(size_t(_opts.target_hits), hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + k, hits.end());
+    std::vector<uint32_t> result;
+    for (size_t i = 0; i < k; ++i) {
+        result.push_back(hits[i].second);
+    }
+    return result;
+}
+
+std::vector<std::vector<uint32_t>>
+HnswTuneApp::exact_ground_truth(const GlobalFilter* filter)
+{
+    std::vector<std::vector<uint32_t>> result(_queries.size());
+    for (size_t i = 0; i < _queries.size(); ++i) {
+        _executor->execute(vespalib::makeLambdaTask([this, &result, filter, i]() {
+            result[i] = exact_top_k(_queries[i], filter);
+        }));
+    }
+    _executor->sync();
+    return result;
+}
+
+std::unique_ptr<NearestNeighborIndex>
+HnswTuneApp::build_index(uint32_t max_links_per_node, uint32_t neighbors_to_explore_at_insert)
+{
+    // This matches how DefaultNearestNeighborIndexFactory configures the index.
+    uint32_t m = max_links_per_node;
+    HnswIndexConfig cfg(m * 2, m, neighbors_to_explore_at_insert, 10000, true);
+    auto index = std::make_unique<HnswIndex<HnswIndexType::SINGLE>>(*_attr,
+                                                                    search::tensor::make_distance_function_factory(_opts.metric, CellType::FLOAT),
+                                                                    std::make_unique<InvLogLevelGenerator>(m),
+                                                                    cfg);
+    GenerationHandler gen_handler;
+    constexpr size_t batch_size = 4096;
+    std::vector<uint32_t> batch;
+    vespalib::Timer timer;
+    for (size_t i = 0; i < _docs.size(); ++i) {
+        batch.push_back(i + 1);
+        if (batch.size() == batch_size || (i + 1) == _docs.size()) {
+            index->add_documents_in_parallel(batch, *_executor, _opts.threads);
+            batch.clear();
+            index->assign_generation(gen_handler.getCurrentGeneration());
+            gen_handler.incGeneration();
+            index->reclaim_memory(gen_handler.get_oldest_used_generation());
+        }
+    }
+    double build_time = vespalib::to_s(timer.elapsed());
+    auto memory = index->memory_usage();
+    fprintf(stdout, "\nbuild: max-links-per-node=%u neighbors-to-explore-at-insert=%u threads=%u: "
+            "build time %.3f s (%.0f docs/s), index memory used %.1f MB, allocated %.1f MB\n",
+            max_links_per_node, neighbors_to_explore_at_insert, _opts.threads, build_time,
+            _docs.size() / build_time, to_mb(memory.usedBytes()), to_mb(memory.allocatedBytes()));
+    return index;
+}
+
+std::vector<uint32_t>
+HnswTuneApp::search(const NearestNeighborIndex& index, TypedCells query, const GlobalFilter* filter,
+                    double hit_ratio, const SearchParams& params, NearestNeighborIndex::SearchStats& stats) const
+{
+    uint32_t k = _opts.target_hits;
+    auto df = index.distance_function_factory().for_query_vector(query);
+    double distance_threshold = std::numeric_limits<double>::max();
+    std::vector<NearestNeighborIndex::Neighbor> neighbors;
+    if (filter != nullptr) {
+        neighbors = index.find_top_k_with_filter(k, *df, *filter, hit_ratio < _opts.filter_first_threshold,
+                                                 params.filter_first_exploration, k + params.explore_additional_hits,
+                                                 params.exploration_slack, vespalib::Doom::never(), distance_threshold, &stats);
+    } else {
+        neighbors = index.find_top_k(k, *df, k + params.explore_additional_hits, params.exploration_slack,
+                                     vespalib::Doom::never(), distance_threshold, &stats);
+    }
+    std::vector<uint32_t> result;
+    for (const auto& neighbor : neighbors) {
+        result.push_back(neighbor.docid);
+    }
+    return result;
+}
+
+SearchResult
+HnswTuneApp::run_queries(const NearestNeighborIndex& index, const GlobalFilter* filter, double hit_ratio,
+                         const SearchParams& params, const std::vector<std::vector<uint32_t>>& ground_truth)
+{
+    size_t num_queries = _queries.size();
+    bool exact = (filter != nullptr) && (hit_ratio < _opts.approximate_threshold);
+    std::vector<std::vector<uint32_t>> results(num_queries);
+    std::vector<NearestNeighborIndex::SearchStats> stats(num_queries);
+    std::vector<double> latencies(num_queries);
+    std::atomic<size_t> next_query(0);
+    auto run = [&]() {
+        for (size_t i = next_query++; i < num_queries; i = next_query++) {
+            vespalib::Timer timer;
+            if (exact) {
+                results[i] = exact_top_k(_queries[i], filter);
+            } else {
+                results[i] = search(index, _queries[i], filter, hit_ratio, params, stats[i]);
+            }
+            latencies[i] = vespalib::to_s(timer.elapsed());
+        }
+    };
+    vespalib::Timer timer;
+    for (uint32_t i = 0; i < _opts.search_threads; ++i) {
+        _executor->execute(vespalib::makeLambdaTask(run));
+    }
+    _executor->sync();
+    double elapsed = vespalib::to_s(timer.elapsed());
+    SearchResult result{0.0, num_queries / elapsed, 0.0, 0.0, 0.0};
+    for (size_t i = 0; i < num_queries; ++i) {
+        const auto& expected = ground_truth[i];
+        size_t found = 0;
+        for (uint32_t docid : results[i]) {
+            found += std::count(expected.begin(), expected.end(), docid);
+        }
+        result.recall += expected.empty() ? 1.0 : double(found) / expected.size();
+        result.avg_latency_ms += latencies[i] * 1000.0;
+        result.visited_nodes += stats[i].visited_nodes;
+        result.distance_computations += stats[i].distance_computations;
+    }
+    result.recall /= num_queries;
+    result.avg_latency_ms /= num_queries;
+    result.visited_nodes /= num_queries;
+    result.distance_computations /= num_queries;
+    return result;
+}
+
+void
+HnswTuneApp::sweep(const NearestNeighborIndex& index)
+{
+    fprintf(stdout, "| filter_hit_ratio | algorithm        | explore_additional_hits | exploration_slack | filter_first_exploration "
+            "| recall@%-3u |        qps | avg_latency_ms | visited_nodes | distance_computations |\n", _opts.target_hits);
+    uint32_t seed = 1234;
+    for (double hit_ratio : _opts.filter_hit_ratios) {
+        std::shared_ptr<GlobalFilter> filter;
+        std::vector<std::vector<uint32_t>> ground_truth;
+        if (hit_ratio < 1.0) {
+            filter = make_filter(hit_ratio, seed++);
+            ground_truth = exact_ground_truth(filter.get());
+        } else if (!_opts.ground_truth_file.empty()) {
+            ground_truth = read_ground_truth(_opts.ground_truth_file, _queries.size(), _opts.target_hits);
+            if (ground_truth.size() < _queries.size()) {
+                throw IllegalArgumentException("Too few queries in '" + _opts.ground_truth_file + "'");
+            }
+        } else {
+            ground_truth = exact_ground_truth(nullptr);
+        }
+        const char* algorithm = (filter == nullptr) ? "index_top_k" :
+                                (hit_ratio < _opts.approximate_threshold) ? "exact_fallback" :
+                                (hit_ratio < _opts.filter_first_threshold) ? "filter_first" : "index_with_filter";
+        for (uint32_t explore_additional_hits : _opts.explore_additional_hits) {
+            for (double exploration_slack : _opts.exploration_slack) {
+                for (double filter_first_exploration : _opts.filter_first_exploration) {
+                    SearchParams params{explore_additional_hits, exploration_slack, filter_first_exploration};
+                    auto res = run_queries(index, filter.get(), hit_ratio, params, ground_truth);
+                    fprintf(stdout, "| %16.4f | %-16s | %23u | %17.3f | %24.3f | %10.4f | %10.1f | %14.3f | %13.1f | %21.1f |\n",
+                            hit_ratio, algorithm, explore_additional_hits, exploration_slack, filter_first_exploration,
+                            res.recall, res.qps, res.avg_latency_ms, res.visited_nodes, res.distance_computations);
+                    fflush(stdout);
+                }
+            }
+        }
+    }
+}
+
+int
+HnswTuneApp::main(int argc, char** argv)
+{
+    try {
+        if (!parse_options(argc, argv)) {
+            usage(argv[0]);
+            return 1;
+        }
+        _executor = std::make_unique<vespalib::ThreadStackExecutor>(std::max(_opts.threads, _opts.search_threads));
+        load_vectors();
+        for (uint32_t max_links_per_node : _opts.max_links_per_node) {
+            for (uint32_t neighbors_to_explore_at_insert : _opts.neighbors_to_explore_at_insert) {
+                auto index = build_index(max_links_per_node, neighbors_to_explore_at_insert);
+                sweep(*index);
+            }
+        }
+    } catch (const vespalib::Exception& e) {
+        fprintf(stderr, "%s\n", e.getMessage().c_str());
+        return 1;
+    }
+    return 0;
+}
+
+}
+
+int
+main(int argc, char** argv)
+{
+    vespalib::SignalHandler::PIPE.ignore();
+    HnswTuneApp app;
+    return app.main(argc, argv);
+}
@@ -0,0 +1,337 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/fnet/frt/invoker.h>
+#include <vespa/fnet/frt/rpcrequest.h>
+#include <vespa/fnet/frt/supervisor.h>
+#include <vespa/fnet/frt/target.h>
+#include <vespa/searchlib/engine/proto_rpc_adapter.h>
+#include <vespa/searchlib/engine/query_capture.h>
+#include <vespa/searchlib/engine/search_protocol_proto.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/signalhandler.h>
+#include <vespa/vespalib/util/time.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <getopt.h>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include <vespa/log/log.h>
+LOG_SETUP("vespa-search-replay");
+
+using search::engine::ProtoRpcAdapter;
+using search::engine::QueryCapture;
+using search::engine::QueryCaptureKind;
+using search::engine::QueryCaptureRecord;
+using vespalib::steady_clock;
+using vespalib::steady_time;
+
+namespace {
+
+struct Options {
+    std::string capture_file;
+    std::string target;
+    std::string baseline;
+    double      speed;
+    double      timeout_s;
+    uint32_t    max_requests;
+    Options() : capture_file(), target(), baseline(), speed(1.0), timeout_s(10.0), max_requests(0) {}
+    ~Options();
+};
+
+Options::~Options() = default;
+
+struct Distribution {
+    std::vector<double> samples;
+    uint32_t            failed = 0;
+    void sort() { std::sort(samples.begin(), samples.end()); }
+    double percentile(double p) const {
+        if (samples.empty()) {
+            return 0.0;
+        }
+        return samples[std::min(samples.size() - 1, size_t(p * samples.size()))];
+    }
+    double mean() const {
+        double sum = 0.0;
+        for (double sample : samples) {
+            sum += sample;
+        }
+        return samples.empty() ? 0.0 : sum / samples.size();
+    }
+};
+
+struct ReplayResult {
+    std::string  target;
+    Distribution search_ms;
+    Distribution docsum_ms;
+    Distribution send_lag_ms;
+    double       elapsed_s = 0.0;
+    Distribution &latency(QueryCaptureKind kind) {
+        return (kind == QueryCaptureKind::SEARCH) ? search_ms : docsum_ms;
+    }
+};
+
+constexpr double percentiles[] = { 0.5, 0.9, 0.99, 0.999 };
+
+/*
+ * Replays the captured requests against a single target with the
+ * original spacing between them (scaled by speed). Each request is
+ * sent asynchronously when due, so a slow target does not delay the
+ * requests behind it. A search answered with a partial reply is
+ * followed by fetching the final reply, and the latency is measured
+ * until the final reply arrives.
+ */
+class Replayer {
+    struct Call : FRT_IRequestWait {
+        Replayer        &owner;
+        QueryCaptureKind kind;
+        steady_time      start;
+        Call(Replayer &owner_in, QueryCaptureKind kind_in) noexcept
+            : owner(owner_in), kind(kind_in), start() {}
+        void RequestDone(FRT_RPCRequest *req) override { owner.done(*this, req); }
+    };
+
+    FRT_Supervisor          &_orb;
+    FRT_Target              *_target;
+    double                   _timeout_s;
+    std::mutex               _lock;
+    std::condition_variable  _cond;
+    uint32_t                 _pending;
+    std::deque<Call>         _calls;
+    ReplayResult             _result;
+
+    void done(Call &call, FRT_RPCRequest *req);
+public:
+    Replayer(FRT_Supervisor &orb, const std::string &spec, double timeout_s);
+    ~Replayer();
+    ReplayResult run(const std::vector<QueryCaptureRecord> &records, double speed);
+};
+
+Replayer::Replayer(FRT_Supervisor &orb, const std::string &spec, double timeout_s)
+    : _orb(orb),
+      _target(orb.GetTarget(spec.c_str())),
+      _timeout_s(timeout_s),
+      _lock(),
+      _cond(),
+      _pending(0),
+      _calls(),
+      _result()
+{
+    _result.target = spec;
+}
+
+Replayer::~Replayer()
+{
+    _target->internal_subref();
+}
+
+void
+Replayer::done(Call &call, FRT_RPCRequest *req)
+{
+    auto now = steady_clock::now();
+    bool failed = req->IsError();
+    if (!failed && call.kind == QueryCaptureKind::SEARCH) {
+        ProtoRpcAdapter::ProtoSearchReply reply;
+        if (!ProtoRpcAdapter::decode_search_reply(*req, reply)) {
+            failed = true;
+        } else if (reply.partial()) {
+            req->internal_subref();
+            auto *next = _orb.AllocRPCRequest();
+            ProtoRpcAdapter::encode_final_search_reply_request(reply.final_reply_id(), *next);
+            _target->InvokeAsync(next, _timeout_s, &call);
+            return;
+        }
+    }
+    if (failed) {
+        LOG(debug, "request to %s failed: %s (%u)", _result.target.c_str(), req->GetErrorMessage(), req->GetErrorCode());
+    }
+    req->internal_subref();
+    std::lock_guard guard(_lock);
+    auto &latency = _result.latency(call.kind);
+    if (failed) {
+        ++latency.failed;
+    } else {
+        latency.samples.push_back(vespalib::count_ns(now - call.start) / 1e6);
+    }
+    if (--_pending == 0) {
+        _cond.notify_all();
+    }
+}
+
+ReplayResult
+Replayer::run(const std::vector<QueryCaptureRecord> &records, double speed)
+{
+    int64_t first_timestamp_ns = records.empty() ? 0 : records.front().timestamp_ns;
+    auto start = steady_clock::now();
+    for (const auto &record : records) {
+        auto due = start;
+        if (speed > 0.0) {
+            int64_t offset_ns = std::max(int64_t(0), record.timestamp_ns - first_timestamp_ns);
+            due += std::chrono::duration_cast<vespalib::duration>(std::chrono::nanoseconds(int64_t(offset_ns / speed)));
+            std::this_thread::sleep_until(due);
+        }
+        auto &call = _calls.emplace_back(*this, record.kind);
+        auto *req = _orb.AllocRPCRequest();
+        ProtoRpcAdapter::encode_captured_request(record, *req);
+        {
+            std::lock_guard guard(_lock);
+            ++_pending;
+        }
+        call.start = steady_clock::now();
+        _result.send_lag_ms.samples.push_back(vespalib::count_ns(call.start - due) / 1e6);
+        _target->InvokeAsync(req, _timeout_s, &call);
+    }
+    {
+        std::unique_lock guard(_lock);
+        _cond.wait(guard, [this]() noexcept { return _pending == 0; });
+    }
+    _result.elapsed_s = vespalib::to_s(steady_clock::now() - start);
+    _result.search_ms.sort();
+    _result.docsum_ms.sort();
+    _result.send_lag_ms.sort();
+    return std::move(_result);
+}
+
+void
+print_distribution(const char *name, const Distribution &dist)
+{
+    fprintf(stdout, "| %-10s | %8zu | %6u | %9.3f |", name, dist.samples.size(), dist.failed, dist.mean());
+    for (double p : percentiles) {
+        fprintf(stdout, " %9.3f |", dist.percentile(p));
+    }
+    fprintf(stdout, " %9.3f |\n", dist.samples.empty() ? 0.0 : dist.samples.back());
+}
+
+void
+print_result(const ReplayResult &result)
+{
+    fprintf(stdout, "\ntarget %s (replayed in %.1f s), latencies in ms:\n", result.target.c_str(), result.elapsed_s);
+    fprintf(stdout, "| type       |    count | failed |      mean |       p50 |       p90 |       p99 |     p99.9 |       max |\n");
+    print_distribution("search", result.search_ms);
+    print_distribution("docsum", result.docsum_ms);
+    print_distribution("send lag", result.send_lag_ms);
+}
+
+void
+print_ratio(const char *name, const Distribution &target, const Distribution &baseline)
+{
+    auto ratio = [](double a, double b) { return (b > 0.0) ? (a / b) : 0.0; };
+    fprintf(stdout, "| %-10s | %9.3f |", name, ratio(target.mean(), baseline.mean()));
+    for (double p : percentiles) {
+        fprintf(stdout, " %9.3f |", ratio(target.percentile(p), baseline.percentile(p)));
+    }
+    fprintf(stdout, "\n");
+}
+
+void
+print_comparison(const ReplayResult &target, const ReplayResult &baseline)
+{
+    fprintf(stdout, "\nlatency of %s relative to %s:\n", target.target.c_str(), baseline.target.c_str());
+    fprintf(stdout, "| type       |      mean |       p50 |       p90 |       p99 |     p99.9 |\n");
+    print_ratio("search", target.search_ms, baseline.search_ms);
+    print_ratio("docsum", target.docsum_ms, baseline.docsum_ms);
+}
+
+void
+usage(const char *self)
+{
+    fprintf(stderr,
+            "Usage: %s [options] <capture-file> <target> [<baseline-target>]\n"
+            "Replays search and docsum requests captured by proton (VESPA_PROTON_QUERY_CAPTURE_FILE) against a\n"
+            "proton instance, preserving the time between requests, and reports the latency distributions.\n"
+            "With a baseline target, the capture is first replayed against the baseline and the latencies are compared.\n"
+            "Targets are rpc connect specs for the search protocol, e.g. tcp/localhost:19106.\n"
+            "  --speed <factor>        replay speed relative to the capture, 0 sends as fast as possible (default 1.0)\n"
+            "  --timeout <seconds>     rpc timeout per request (default 10.0)\n"
+            "  --max-requests <num>    only replay the first num captured requests (default all)\n",
+            self);
+}
+
+bool
+parse_options(int argc, char **argv, Options &opts)
+{
+    static struct option long_opts[] = {
+        { "speed", 1, nullptr, 0 },
+        { "timeout", 1, nullptr, 0 },
+        { "max-requests", 1, nullptr, 0 },
+        { nullptr, 0, nullptr, 0 }
+    };
+    int c;
+    int long_opt_index = 0;
+    optind = 1;
+    while ((c = getopt_long(argc, argv, "", long_opts, &long_opt_index)) != -1) {
+        if (c != 0) {
+            return false;
+        }
+        std::string name(long_opts[long_opt_index].name);
+        if (name == "speed") {
+            opts.speed = strtod(optarg, nullptr);
+        } else if (name == "timeout") {
+            opts.timeout_s = strtod(optarg, nullptr);
+        } else if (name == "max-requests") {
+            opts.max_requests = strtoul(optarg, nullptr, 10);
+        }
+    }
+    int args = argc - optind;
+    if (args < 2 || args > 3 || opts.speed < 0.0 || opts.timeout_s <= 0.0) {
+        return false;
+    }
+    opts.capture_file = argv[optind];
+    opts.target = argv[optind + 1];
+    if (args == 3) {
+        opts.baseline = argv[optind + 2];
+    }
+    return true;
+}
+
+int
+replay_main(int argc, char **argv)
+{
+    Options opts;
+    if (!parse_options(argc, argv, opts)) {
+        usage(argv[0]);
+        return 1;
+    }
+    std::vector<QueryCaptureRecord> records;
+    try {
+        records = QueryCapture::read(opts.capture_file);
+    } catch (const vespalib::Exception &e) {
+        fprintf(stderr, "%s\n", e.getMessage().c_str());
+        return 1;
+    }
+    if (opts.max_requests != 0 && records.size() > opts.max_requests) {
+        records.resize(opts.max_requests);
+    }
+    if (records.empty()) {
+        fprintf(stderr, "no requests in '%s'\n", opts.capture_file.c_str());
+        return 1;
+    }
+    size_t searches = std::count_if(records.begin(), records.end(),
+                                    [](const auto &r) noexcept { return r.kind == QueryCaptureKind::SEARCH; });
+    fprintf(stdout, "replaying %zu searches and %zu docsum requests spanning %.1f s at speed %.2f\n",
+            searches, records.size() - searches,
+            (records.back().timestamp_ns - records.front().timestamp_ns) / 1e9, opts.speed);
+    fnet::frt::StandaloneFRT server;
+    std::optional<ReplayResult> baseline;
+    if (!opts.baseline.empty()) {
+        baseline = Replayer(server.supervisor(), opts.baseline, opts.timeout_s).run(records, opts.speed);
+        print_result(*baseline);
+    }
+    auto result = Replayer(server.supervisor(), opts.target, opts.timeout_s).run(records, opts.speed);
+    print_result(result);
+    if (baseline) {
+        print_comparison(result, *baseline);
+    }
+    return 0;
+}
+
+}
+
+int
+main(int argc, char **argv)
+{
+    vespalib::SignalHandler::PIPE.ignore();
+    return replay_main(argc, argv);
+}
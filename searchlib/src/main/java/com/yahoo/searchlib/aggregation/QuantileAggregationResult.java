@@ -0,0 +1,225 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.searchlib.expression.FloatResultNode;
+import com.yahoo.searchlib.expression.ResultNode;
+import com.yahoo.vespa.objects.Deserializer;
+import com.yahoo.vespa.objects.ObjectVisitor;
+import com.yahoo.vespa.objects.Serializer;
+
+import java.util.ArrayList;
+import java.util.Comparator;
+import java.util.List;
+
+/**
+ * This is an aggregated result holding an estimate of a quantile of the aggregating expression for all matching hits.
+ * The values are summarized in a merging t-digest, which is bounded in size and can be merged with the digests from
+ * other nodes. This must be kept in sync with the c++ implementation.
+ */
+public class QuantileAggregationResult extends AggregationResult {
+
+    public static final int classId = registerClass(0x4000 + 178, QuantileAggregationResult.class, QuantileAggregationResult::new);
+    public static final int COMPRESSION = 100;
+
+    /** A cluster of values, represented by their mean and the number of values. */
+    public record Centroid(double mean, long weight) { }
+
+    private static final Comparator<Centroid> CENTROID_ORDER =
+            Comparator.comparingDouble(Centroid::mean).thenComparingLong(Centroid::weight);
+
+    private double quantile;
+    private long count = 0;
+    private double min = Double.POSITIVE_INFINITY;
+    private double max = Double.NEGATIVE_INFINITY;
+    private List<Centroid> centroids = new ArrayList<>();
+
+    /**
+     * Constructor used for deserialization.
+     */
+    @SuppressWarnings("unused")
+    public QuantileAggregationResult() {
+        this(0.5);
+    }
+
+    public QuantileAggregationResult(double quantile) {
+        this.quantile = quantile;
+    }
+
+    public double getQuantile() {
+        return quantile;
+    }
+
+    public QuantileAggregationResult setQuantile(double quantile) {
+        this.quantile = quantile;
+        return this;
+    }
+
+    public long getCount() {
+        return count;
+    }
+
+    /** Returns the centroids of this digest, compressed and ordered by mean. */
+    public List<Centroid> getCentroids() {
+        return compress(centroids);
+    }
+
+    /** Adds a single value to this digest. NaN values are ignored. */
+    public QuantileAggregationResult add(double value) {
+        if (Double.isNaN(value)) {
+            return this;
+        }
+        centroids.add(new Centroid(value, 1));
+        ++count;
+        min = Math.min(min, value);
+        max = Math.max(max, value);
+        if (centroids.size() >= 5 * COMPRESSION) {
+            centroids = compress(centroids);
+        }
+        return this;
+    }
+
+    /** Returns the estimated value at the quantile of this, or 0 if nothing has been aggregated. */
+    public double getQuantileValue() {
+        List<Centroid> sorted = getCentroids();
+        if (sorted.isEmpty()) {
+            return 0.0;
+        }
+        if (sorted.size() == 1) {
+            return sorted.get(0).mean();
+        }
+        double target = Math.max(0.0, Math.min(1.0, quantile)) * count;
+        Centroid first = sorted.get(0);
+        double firstCenter = first.weight() / 2.0;
+        if (target < firstCenter) {
+            return min + (first.mean() - min) * target / firstCenter;
+        }
+        double weightSoFar = 0;
+        for (int i = 0; i + 1 < sorted.size(); ++i) {
+            Centroid cur = sorted.get(i);
+            Centroid next = sorted.get(i + 1);
+            double center = weightSoFar + cur.weight() / 2.0;
+            double nextCenter = weightSoFar + cur.weight() + next.weight() / 2.0;
+            if (target < nextCenter) {
+                return cur.mean() + (next.mean() - cur.mean()) * (target - center) / (nextCenter - center);
+            }
+            weightSoFar += cur.weight();
+        }
+        Centroid last = sorted.get(sorted.size() - 1);
+        double lastCenter = count - last.weight() / 2.0;
+        double tail = count - lastCenter;
+        return (tail > 0)
+               ? last.mean() + (max - last.mean()) * Math.min(1.0, (target - lastCenter) / tail)
+               : last.mean();
+    }
+
+    private static List<Centroid> compress(List<Centroid> input) {
+        List<Centroid> sorted = new ArrayList<>(input);
+        if (sorted.size() <= 1) {
+            return sorted;
+        }
+        sorted.sort(CENTROID_ORDER);
+        double total = 0;
+        for (Centroid c : sorted) {
+            total += c.weight();
+        }
+        List<Centroid> result = new ArrayList<>();
+        Centroid cur = sorted.get(0);
+        double weightSoFar = 0;
+        for (int i = 1; i < sorted.size(); ++i) {
+            Centroid next = sorted.get(i);
+            double proposed = cur.weight() + next.weight();
+            double q0 = weightSoFar / total;
+            double q2 = (weightSoFar + proposed) / total;
+            double limit = Math.PI * total * Math.sqrt(Math.min(q0 * (1 - q0), q2 * (1 - q2))) / COMPRESSION;
+            if (proposed <= limit) {
+                cur = new Centroid(cur.mean() + (next.mean() - cur.mean()) * next.weight() / proposed,
+                                   cur.weight() + next.weight());
+            } else {
+                weightSoFar += cur.weight();
+                result.add(cur);
+                cur = next;
+            }
+        }
+        result.add(cur);
+        return result;
+    }
+
+    @Override
+    public ResultNode getRank() {
+        return new FloatResultNode(getQuantileValue());
+    }
+
+    @Override
+    protected void onMerge(AggregationResult obj) {
+        QuantileAggregationResult other = (QuantileAggregationResult) obj;
+        List<Centroid> merged = new ArrayList<>(centroids);
+        merged.addAll(other.centroids);
+        centroids = compress(merged);
+        count += other.count;
+        min = Math.min(min, other.min);
+        max = Math.max(max, other.max);
+    }
+
+    @Override
+    protected boolean equalsAggregation(AggregationResult obj) {
+        QuantileAggregationResult other = (QuantileAggregationResult) obj;
+        return quantile == other.quantile && count == other.count &&
+               getCentroids().equals(other.getCentroids());
+    }
+
+    @Override
+    public int hashCode() {
+        return super.hashCode() + Double.hashCode(quantile) + (int)count;
+    }
+
+    @Override
+    public QuantileAggregationResult clone() {
+        QuantileAggregationResult obj = (QuantileAggregationResult) super.clone();
+        obj.centroids = new ArrayList<>(centroids);
+        return obj;
+    }
+
+    @Override
+    protected void onSerialize(Serializer buf) {
+        super.onSerialize(buf);
+        List<Centroid> sorted = getCentroids();
+        buf.putDouble(null, quantile);
+        buf.putLong(null, count);
+        buf.putDouble(null, min);
+        buf.putDouble(null, max);
+        buf.putInt(null, sorted.size());
+        for (Centroid c : sorted) {
+            buf.putDouble(null, c.mean());
+            buf.putLong(null, c.weight());
+        }
+    }
+
+    @Override
+    protected void onDeserialize(Deserializer buf) {
+        super.onDeserialize(buf);
+        quantile = buf.getDouble(null);
+        count = buf.getLong(null);
+        min = buf.getDouble(null);
+        max = buf.getDouble(null);
+        int numCentroids = buf.getInt(null);
+        centroids = new ArrayList<>(numCentroids);
+        for (int i = 0; i < numCentroids; ++i) {
+            double mean = buf.getDouble(null);
+            long weight = buf.getLong(null);
+            centroids.add(new Centroid(mean, weight));
+        }
+    }
+
+    @Override
+    protected int onGetClassId() {
+        return classId;
+    }
+
+    @Override
+    public void visitMembers(ObjectVisitor visitor) {
+        super.visitMembers(visitor);
+        visitor.visit("quantile", quantile);
+        visitor.visit("count", count);
+        visitor.visit("value", getQuantileValue());
+    }
+}
@@ -0,0 +1,54 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.vespa.objects.BufferSerializer;
+import org.junit.Test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+public class QuantileAggregationResultTest {
+
+    @Test
+    public void rank_is_estimated_quantile() {
+        QuantileAggregationResult result = new QuantileAggregationResult(0.9);
+        assertEquals(0.0, result.getRank().getFloat(), 0);
+        for (int i = 1; i <= 10000; ++i) {
+            result.add(i);
+        }
+        assertEquals(10000, result.getCount());
+        assertTrue(result.getCentroids().size() <= 2 * QuantileAggregationResult.COMPRESSION);
+        assertEquals(9000, result.getRank().getFloat(), 20);
+        assertEquals(1, result.setQuantile(0.0).getQuantileValue(), 1);
+        assertEquals(10000, result.setQuantile(1.0).getQuantileValue(), 1);
+    }
+
+    @Test
+    public void merged_digests_estimate_quantile_of_all_values() {
+        QuantileAggregationResult a = new QuantileAggregationResult(0.99);
+        QuantileAggregationResult b = new QuantileAggregationResult(0.99);
+        for (int i = 0; i < 10000; ++i) {
+            ((i % 2 == 0) ? a : b).add(i);
+        }
+        a.merge(b);
+        assertEquals(10000, a.getCount());
+        assertTrue(a.getCentroids().size() <= 2 * QuantileAggregationResult.COMPRESSION);
+        assertEquals(9900, a.getQuantileValue(), 10);
+    }
+
+    @Test
+    public void digest_survives_serialization() {
+        QuantileAggregationResult result = new QuantileAggregationResult(0.75);
+        for (int i = 0; i < 1000; ++i) {
+            result.add(i * 3);
+        }
+        BufferSerializer buf = new BufferSerializer();
+        result.serialize(buf);
+        buf.flip();
+        QuantileAggregationResult copy = new QuantileAggregationResult();
+        copy.deserialize(buf);
+        assertEquals(result, copy);
+        assertEquals(result.getQuantileValue(), copy.getQuantileValue(), 0);
+    }
+
+}
@@ -261,6 +261,60 @@ TEST(PerDocExprTest, require_that_StandardDeviationAggregationResult_aggregates_
     EXPECT_NEAR(41.5, aggr.getRank().getFloat(), 0.1);
 }
 
+TEST(PerDocExprTest, require_that_QuantileAggregationResult_estimates_quantile_of_aggregated_values) {
+    QuantileAggregationResult aggr(0.9);
+    EXPECT_EQ(0.0, aggr.getRank().getFloat());
+    for (uint32_t i = 1; i <= 10000; ++i) {
+        aggr.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(i))).aggregate(DocId(i), HitRank(0));
+    }
+    EXPECT_EQ(10000u, aggr.getCount());
+    EXPECT_LE(aggr.getCentroids().size(), 2 * QuantileAggregationResult::COMPRESSION);
+    EXPECT_NEAR(9000.0, aggr.getRank().getFloat(), 20.0);
+    EXPECT_NEAR(5000.0, aggr.setQuantile(0.5).getRank().getFloat(), 50.0);
+    EXPECT_NEAR(1.0, aggr.setQuantile(0.0).getRank().getFloat(), 1.0);
+    EXPECT_NEAR(10000.0, aggr.setQuantile(1.0).getRank().getFloat(), 1.0);
+}
+
+TEST(PerDocExprTest, require_that_QuantileAggregationResult_aggregates_multi_value_expression) {
+    QuantileAggregationResult aggr(0.5);
+    aggr.setExpression(createVectorFloat(std::vector<double>({1.5, 100.25, 30.125}))).
+            aggregate(DocId(42), HitRank(21));
+    EXPECT_EQ(3u, aggr.getCount());
+    EXPECT_EQ(30.125, aggr.getRank().getFloat());
+}
+
+TEST(PerDocExprTest, require_that_QuantileAggregationResult_can_be_merged) {
+    QuantileAggregationResult aggr1(0.99);
+    QuantileAggregationResult aggr2(0.99);
+    for (uint32_t i = 0; i < 10000; ++i) {
+        QuantileAggregationResult &aggr = (i % 2 == 0) ? aggr1 : aggr2;
+        aggr.setExpression(MU<ConstantNode>(MU<FloatResultNode>(i))).aggregate(DocId(i), HitRank(0));
+    }
+    aggr1.merge(aggr2);
+    EXPECT_EQ(10000u, aggr1.getCount());
+    EXPECT_LE(aggr1.getCentroids().size(), 2 * QuantileAggregationResult::COMPRESSION);
+    EXPECT_NEAR(9900.0, aggr1.getRank().getFloat(), 10.0);
+}
+
+TEST(PerDocExprTest, require_that_QuantileAggregationResult_can_be_serialized) {
+    QuantileAggregationResult aggr1(0.75);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        aggr1.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(i * 3))).aggregate(DocId(i), HitRank(0));
+    }
+
+    nbostream os;
+    NBOSerializer nos(os);
+    nos << aggr1;
+    Identifiable::UP obj = Identifiable::create(nos);
+    auto *aggr2 = dynamic_cast<QuantileAggregationResult *>(obj.get());
+    ASSERT_TRUE(aggr2);
+    EXPECT_TRUE(os.empty());
+    EXPECT_EQ(aggr1.getQuantile(), aggr2->getQuantile());
+    EXPECT_EQ(aggr1.getCount(), aggr2->getCount());
+    EXPECT_EQ(aggr1.getCentroids(), aggr2->getCentroids());
+    EXPECT_EQ(aggr1.getRank().getFloat(), aggr2->getRank().getFloat());
+}
+
 void testAdd(const ResultNode &a, const ResultNode &b, const ResultNode &c) {
     AddFunctionNode func;
     func.appendArg(MU<ConstantNode>(ResultNode::UP(a.clone())))
@@ -21,6 +21,7 @@
 #include <vespa/vespalib/util/mmap_file_allocator.h>
 #include <vespa/vespalib/util/mmap_file_allocator_factory.h>
 #include <vespa/vespalib/util/round_up_to_page_size.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/fastos/file.h>
@@ -2464,6 +2465,31 @@ test_multi_value_mapping_has_free_lists_enabled()
     EXPECT_TRUE(attr.has_free_lists_enabled());
 }
 
+void
+test_parallel_load_of_single_value_numeric_attribute()
+{
+    constexpr uint32_t num_docs = 2_Mi + 1000;
+    auto attr = createAttribute("sint64_parallel", Config(BasicType::INT64));
+    auto& iattr = dynamic_cast<IntegerAttribute&>(*attr);
+    attr->addDocs(num_docs);
+    for (uint32_t docid = 0; docid < num_docs; ++docid) {
+        iattr.update(docid, int64_t(docid) * 7 - 1000);
+    }
+    attr->commit();
+    EXPECT_TRUE(attr->save());
+    vespalib::ThreadStackExecutor executor(4);
+    auto attr2 = createAttribute("sint64_parallel", Config(BasicType::INT64));
+    EXPECT_TRUE(attr2->load(&executor));
+    ASSERT_EQ(num_docs, attr2->getNumDocs());
+    uint32_t mismatches = 0;
+    for (uint32_t docid = 0; docid < num_docs; ++docid) {
+        if (attr2->getInt(docid) != int64_t(docid) * 7 - 1000) {
+            ++mismatches;
+        }
+    }
+    EXPECT_EQ(0u, mismatches);
+}
+
 TEST_F(AttributeTest, base_name)
 {
     testBaseName();
@@ -2584,6 +2610,11 @@ TEST_F(AttributeTest, paged_attributes)
     test_paged_attributes();
 }
 
+TEST_F(AttributeTest, single_value_numeric_attribute_is_loaded_in_parallel)
+{
+    test_parallel_load_of_single_value_numeric_attribute();
+}
+
 }
 
 void
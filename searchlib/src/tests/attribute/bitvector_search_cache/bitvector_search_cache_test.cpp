@@ -2,6 +2,7 @@
 
 #include <vespa/searchlib/attribute/bitvector_search_cache.h>
 #include <vespa/searchlib/common/bitvector.h>
+#include <vespa/vespalib/stllike/cache_stats.h>
 #include <vespa/vespalib/util/memoryusage.h>
 #include <vespa/vespalib/gtest/gtest.h>
 
@@ -18,6 +19,13 @@ makeEntry()
     return std::make_shared<Entry>(IDocumentMetaStoreContext::IReadGuard::SP(), BitVector::create(5), 10);
 }
 
+EntrySP
+make_entry(uint32_t docid_limit, uint64_t generation)
+{
+    return std::make_shared<Entry>(IDocumentMetaStoreContext::IReadGuard::SP(), BitVector::create(docid_limit),
+                                   docid_limit, generation);
+}
+
 class BitVectorSearchCacheTest : public ::testing::Test {
 protected:
     BitVectorSearchCache cache;
@@ -80,4 +88,59 @@ TEST_F(BitVectorSearchCacheTest, require_that_cache_can_be_cleared)
     EXPECT_GT(old_mem_usage.allocatedBytes(), new_mem_usage.allocatedBytes());
 }
 
+TEST_F(BitVectorSearchCacheTest, require_that_entry_for_newer_generation_replaces_existing_entry)
+{
+    auto old_entry = make_entry(10, 1);
+    auto new_entry = make_entry(10, 2);
+    cache.insert("foo", old_entry);
+    cache.insert("foo", new_entry);
+    EXPECT_EQ(1u, cache.size());
+    EXPECT_EQ(new_entry, cache.find("foo"));
+    cache.insert("foo", old_entry);
+    EXPECT_EQ(new_entry, cache.find("foo"));
+    EXPECT_EQ(1u, cache.get_stats().invalidations);
+}
+
+TEST_F(BitVectorSearchCacheTest, require_that_find_checks_generation_and_docid_limit)
+{
+    auto entry = make_entry(10, 3);
+    cache.insert("foo", entry);
+    EXPECT_EQ(entry, cache.find("foo", 3, 10));
+    EXPECT_TRUE(cache.find("foo", 4, 10).get() == nullptr);
+    EXPECT_TRUE(cache.find("foo", 3, 11).get() == nullptr);
+    EXPECT_TRUE(cache.find("bar", 3, 10).get() == nullptr);
+    auto stats = cache.get_stats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(3u, stats.misses);
+    EXPECT_EQ(1u, stats.elements);
+}
+
+TEST_F(BitVectorSearchCacheTest, require_that_least_recently_used_entries_are_evicted_when_memory_is_bounded)
+{
+    auto entry = make_entry(100000, 1);
+    size_t entry_memory = entry->extra_memory_usage();
+    BitVectorSearchCache bounded(2 * entry_memory);
+    bounded.insert("foo", entry);
+    bounded.insert("bar", make_entry(100000, 1));
+    EXPECT_EQ(2u, bounded.size());
+    EXPECT_EQ(entry, bounded.find("foo", 1, 100000));
+    bounded.insert("baz", make_entry(100000, 1));
+    EXPECT_EQ(2u, bounded.size());
+    EXPECT_TRUE(bounded.find("foo", 1, 100000));
+    EXPECT_FALSE(bounded.find("bar", 1, 100000));
+    EXPECT_TRUE(bounded.find("baz", 1, 100000));
+    EXPECT_EQ(1u, bounded.get_stats().invalidations);
+    bounded.set_max_memory(entry_memory);
+    EXPECT_EQ(1u, bounded.size());
+    EXPECT_TRUE(bounded.find("baz", 1, 100000));
+}
+
+TEST_F(BitVectorSearchCacheTest, require_that_entries_are_not_inserted_when_max_memory_is_zero)
+{
+    BitVectorSearchCache disabled(0);
+    disabled.insert("foo", make_entry(10, 1));
+    EXPECT_EQ(0u, disabled.size());
+    EXPECT_TRUE(disabled.find("foo", 1, 10).get() == nullptr);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -408,11 +408,9 @@ TEST_P(DirectMultiTermBlueprintTest, only_bitvectors_used_for_filter_field_when_
 TEST_P(DirectMultiTermBlueprintTest, hash_filter_used_for_non_strict_iterator_with_10_or_more_terms)
 {
     setup(true, true);
-    if (!single_type) {
-        return;
-    }
     add_terms({1, 3, 3, 3, 3, 3, 3, 3, 3, 3});
     auto itr = create_leaf_search(false);
+    EXPECT_THAT(blueprint->asString(), HasSubstr("strategy: 'hash_filter'"));
     EXPECT_THAT(itr->asString(), StartsWith("search::attribute::MultiTermHashFilter"));
     expect_hits({10, 30, 31}, *itr);
     // filter should not use MultiTermHashFilter
@@ -425,9 +423,6 @@ TEST_P(DirectMultiTermBlueprintTest, hash_filter_used_for_non_strict_iterator_wi
 TEST_P(DirectMultiTermBlueprintTest, btree_iterators_used_for_non_strict_iterator_with_9_or_less_terms)
 {
     setup(true, true);
-    if (!single_type) {
-        return;
-    }
     add_terms({1, 3, 3, 3, 3, 3, 3, 3, 3});
     auto itr = create_leaf_search(false);
     EXPECT_THAT(itr->asString(), StartsWith(iterator_unpack_docid));
@@ -437,7 +432,7 @@ TEST_P(DirectMultiTermBlueprintTest, btree_iterators_used_for_non_strict_iterato
 TEST_P(DirectMultiTermBlueprintTest, hash_filter_with_string_folding_used_for_non_strict_iterator)
 {
     setup(true, true);
-    if (!single_type || integer_type) {
+    if (integer_type) {
         return;
     }
     // "foo" matches documents with "foo" (40) and "Foo" (41).
@@ -452,12 +447,60 @@ TEST_P(DirectMultiTermBlueprintTest, hash_filter_with_string_folding_used_for_no
     expect_hits({30, 31, 40, 41}, *filter);
 }
 
+TEST_P(DirectMultiTermBlueprintTest, hash_filter_unpacks_weights_for_non_strict_iterator)
+{
+    setup(false, true);
+    if (in_operator) {
+        return;
+    }
+    add_terms({1, 3, 3, 3, 3, 3, 3, 3, 3, 3});
+    auto itr = create_leaf_search(false);
+    EXPECT_THAT(itr->asString(), StartsWith("search::attribute::MultiTermHashFilter"));
+    itr->initRange(1, doc_id_limit);
+    EXPECT_TRUE(itr->seek(30));
+    itr->unpack(30);
+    EXPECT_EQ(30, tfmd.getDocId());
+    ASSERT_EQ(1, tfmd.getNumOccs());
+    EXPECT_EQ(1, tfmd.begin()->getElementWeight());
+    EXPECT_FALSE(itr->seek(35));
+}
+
+TEST_P(DirectMultiTermBlueprintTest, bitvector_union_used_for_strict_filter_field_with_16_or_more_terms)
+{
+    setup(true, true);
+    add_terms({1, 3, 100, 300, 1, 3, 100, 300, 1, 3, 100, 300, 1, 3, 100, 300});
+    auto itr = create_leaf_search();
+    EXPECT_THAT(blueprint->asString(), HasSubstr("strategy: 'bitvector_union'"));
+    EXPECT_THAT(itr->asString(), StartsWith("search::queryeval::TermwiseSearch"));
+    expect_hits(concat({10, 30, 31}, concat(range(100, 128), range(300, 128))), *itr);
+    // the docid is still unpacked for the filter field
+    itr->initRange(1, doc_id_limit);
+    EXPECT_TRUE(itr->seek(30));
+    itr->unpack(30);
+    EXPECT_EQ(30, tfmd.getDocId());
+}
+
+TEST_P(DirectMultiTermBlueprintTest, heap_used_for_strict_filter_field_with_15_or_less_terms)
+{
+    setup(true, true);
+    add_terms({1, 3, 100, 300, 1, 3, 100, 300, 1, 3, 100, 300, 1, 3, 100});
+    auto itr = create_leaf_search();
+    EXPECT_THAT(blueprint->asString(), HasSubstr("strategy: 'heap'"));
+    EXPECT_THAT(itr->asString(), Not(StartsWith("search::queryeval::TermwiseSearch")));
+    expect_hits(concat({10, 30, 31}, concat(range(100, 128), range(300, 128))), *itr);
+}
+
 TEST_P(DirectMultiTermBlueprintTest, supports_more_than_64k_btree_iterators) {
     setup(false, true);
     std::vector<int64_t> term_values(std::numeric_limits<uint16_t>::max() + 1, 3);
     add_terms(term_values);
     auto itr = create_leaf_search();
-    EXPECT_THAT(itr->asString(), StartsWith(resolve_iterator_with_unpack()));
+    if (in_operator) {
+        // The in operator only needs the docid, making the bitvector union cheaper than the heap
+        EXPECT_THAT(itr->asString(), StartsWith("search::queryeval::TermwiseSearch"));
+    } else {
+        EXPECT_THAT(itr->asString(), StartsWith(resolve_iterator_with_unpack()));
+    }
     expect_hits({30, 31}, *itr);
 }
 
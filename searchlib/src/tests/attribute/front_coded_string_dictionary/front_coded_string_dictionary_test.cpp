@@ -0,0 +1,117 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/attribute/enumstore.h>
+#include <vespa/searchlib/attribute/front_coded_string_dictionary.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+using search::DictionaryConfig;
+using search::EnumStoreT;
+using search::attribute::FrontCodedStringDictionary;
+
+namespace {
+
+std::vector<std::string>
+make_urls(uint32_t count)
+{
+    std::vector<std::string> result;
+    for (uint32_t i = 0; i < count; ++i) {
+        result.emplace_back(vespalib::make_string("https://www.example.com/path/to/document/%06u", i));
+    }
+    return result;
+}
+
+std::vector<std::string>
+prefix_matches(const FrontCodedStringDictionary& dict, std::string_view prefix)
+{
+    std::vector<std::string> result;
+    dict.foreach_prefix(prefix, [&result](std::string_view value) { result.emplace_back(value); });
+    return result;
+}
+
+}
+
+TEST(FrontCodedStringDictionaryTest, strings_can_be_found_in_static_part)
+{
+    auto urls = make_urls(100);
+    FrontCodedStringDictionary dict(urls);
+    EXPECT_EQ(100u, dict.static_size());
+    for (uint32_t i = 0; i < urls.size(); ++i) {
+        EXPECT_EQ(i, dict.find(urls[i]).value_or(100u));
+        EXPECT_EQ(urls[i], dict.get(i));
+    }
+    EXPECT_FALSE(dict.find("").has_value());
+    EXPECT_FALSE(dict.find("https://www.example.com/path/to/document/").has_value());
+    EXPECT_FALSE(dict.find("https://www.example.com/path/to/document/0000999").has_value());
+    EXPECT_FALSE(dict.find("zzz").has_value());
+}
+
+TEST(FrontCodedStringDictionaryTest, shared_prefixes_are_only_stored_once_per_block)
+{
+    auto urls = make_urls(1000);
+    size_t raw_bytes = 0;
+    for (const auto& url : urls) {
+        raw_bytes += url.size();
+    }
+    FrontCodedStringDictionary dict(urls);
+    EXPECT_LT(dict.get_memory_usage().usedBytes() * 4, raw_bytes);
+}
+
+TEST(FrontCodedStringDictionaryTest, prefix_search_merges_static_part_and_delta)
+{
+    FrontCodedStringDictionary dict(std::vector<std::string>{"aa", "ab", "abc", "b", "ba"});
+    EXPECT_TRUE(dict.add("abb"));
+    EXPECT_TRUE(dict.add("a"));
+    EXPECT_FALSE(dict.add("ab"));
+    EXPECT_FALSE(dict.add("abb"));
+    EXPECT_EQ(2u, dict.delta_size());
+    EXPECT_EQ(7u, dict.size());
+    EXPECT_TRUE(dict.contains("abb"));
+    EXPECT_TRUE(dict.contains("aa"));
+    EXPECT_FALSE(dict.contains("abd"));
+    EXPECT_EQ((std::vector<std::string>{"a", "aa", "ab", "abb", "abc"}), prefix_matches(dict, "a"));
+    EXPECT_EQ((std::vector<std::string>{"ab", "abb", "abc"}), prefix_matches(dict, "ab"));
+    EXPECT_EQ((std::vector<std::string>{"b", "ba"}), prefix_matches(dict, "b"));
+    EXPECT_EQ((std::vector<std::string>{}), prefix_matches(dict, "c"));
+    EXPECT_EQ(7u, prefix_matches(dict, "").size());
+}
+
+TEST(FrontCodedStringDictionaryTest, prefix_search_spans_blocks)
+{
+    auto urls = make_urls(1000);
+    FrontCodedStringDictionary dict(urls);
+    auto matches = prefix_matches(dict, "https://www.example.com/path/to/document/0001");
+    ASSERT_EQ(100u, matches.size());
+    EXPECT_EQ(urls[100], matches.front());
+    EXPECT_EQ(urls[199], matches.back());
+}
+
+TEST(FrontCodedStringDictionaryTest, rebuild_merges_delta_into_static_part)
+{
+    FrontCodedStringDictionary dict(std::vector<std::string>{"b", "d"});
+    dict.add("c");
+    dict.add("a");
+    dict.rebuild();
+    EXPECT_EQ(0u, dict.delta_size());
+    EXPECT_EQ(4u, dict.static_size());
+    EXPECT_EQ(0u, dict.find("a").value_or(4u));
+    EXPECT_EQ(2u, dict.find("c").value_or(4u));
+    EXPECT_EQ(3u, dict.find("d").value_or(4u));
+}
+
+TEST(FrontCodedStringDictionaryTest, dictionary_can_be_built_from_enum_store)
+{
+    EnumStoreT<const char*> store(false, DictionaryConfig(DictionaryConfig::Type::BTREE));
+    for (const char* value : {"foo", "Foo", "bar", "baz"}) {
+        store.insert(value);
+    }
+    store.freeze_dictionary();
+    auto dict = FrontCodedStringDictionary::make(store);
+    // The default value (empty string) is always present in the enum store
+    EXPECT_EQ(5u, dict.static_size());
+    EXPECT_EQ((std::vector<std::string>{"", "Foo", "bar", "baz", "foo"}), prefix_matches(dict, ""));
+    EXPECT_EQ((std::vector<std::string>{"bar", "baz"}), prefix_matches(dict, "ba"));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -238,6 +238,23 @@ TEST_F(IntMappingTest, test_that_set_and_get_works)
     assertGet(5, {3});
 }
 
+TEST_F(IntMappingTest, test_that_values_can_be_prefetched_using_read_view)
+{
+    setup(3);
+    addDocs(6);
+    set(2, {4, 7});
+    set(3, {5});
+    set(4, {10, 14, 17, 16, 20, 22, 25, 29});
+    auto read_view = _mvMapping->make_read_view(size());
+    std::vector<uint32_t> docids{1, 2, 3, 4, 5, 100};
+    read_view.prefetch(docids);
+    read_view.prefetch(100);
+    assertArray({}, read_view.get(1));
+    assertArray({4, 7}, read_view.get(2));
+    assertArray({5}, read_view.get(3));
+    assertArray({10, 14, 17, 16, 20, 22, 25, 29}, read_view.get(4));
+}
+
 TEST_F(IntMappingTest, test_that_old_value_is_not_overwritten_while_held)
 {
     setup(3, 32, 64, 0);
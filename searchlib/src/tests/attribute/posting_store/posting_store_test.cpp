@@ -253,6 +253,61 @@ TEST_P(PostingStoreTest, require_that_bitvectors_are_compacted)
     test_compact_sequence(huge_sequence_length);
 }
 
+TEST_P(PostingStoreTest, require_that_compressed_posting_lists_are_used_for_filter_attributes)
+{
+    constexpr int sequence_length = 280;
+    constexpr int end_key = 4 + sequence_length;
+    EntryRef ref = add_sequence(4, end_key);
+    inc_generation();
+    bool exp_compressed = _config.getIsFilter();
+    EXPECT_EQ(exp_compressed, _store.has_compressed(ref));
+    EXPECT_EQ(sequence_length, _store.frozenSize(ref));
+    EXPECT_EQ(make_exp_sequence(4, end_key), get_sequence(ref));
+    std::vector<MyPostingStore::KeyDataType> additions;
+    std::vector<MyPostingStore::KeyType> removals;
+    std::vector<int> exp_sequence;
+    for (int i = 4; i < 100; i += 2) {
+        removals.emplace_back(i);
+        exp_sequence.emplace_back(i + 1);
+    }
+    for (int i = 100; i < end_key + 10; ++i) {
+        if (i >= end_key) {
+            additions.emplace_back(i, 1);
+        }
+        exp_sequence.emplace_back(i);
+    }
+    _store.apply(ref, additions.data(), additions.data() + additions.size(),
+                 removals.data(), removals.data() + removals.size());
+    inc_generation();
+    EXPECT_EQ(exp_compressed, _store.has_compressed(ref));
+    EXPECT_EQ(exp_sequence, get_sequence(ref));
+    if (exp_compressed) {
+        CompressedPostingIterator itr(*_store.getCompressedEntry(MyPostingStore::RefType(ref))->_list);
+        EXPECT_EQ(5, itr.getKey());
+        itr.linearSeek(200);
+        EXPECT_EQ(200, itr.getKey());
+        itr.lower_bound(6);
+        EXPECT_EQ(7, itr.getKey());
+        itr.linearSeek(end_key + 9);
+        EXPECT_EQ(end_key + 9, itr.getKey());
+        ++itr;
+        EXPECT_FALSE(itr.valid());
+    }
+    // Shrinking further converts compressed posting list back to btree
+    additions.clear();
+    removals.clear();
+    for (int i = 100; i < 250; ++i) {
+        removals.emplace_back(i);
+    }
+    std::erase_if(exp_sequence, [](int key) { return key >= 100 && key < 250; });
+    _store.apply(ref, additions.data(), additions.data() + additions.size(),
+                 removals.data(), removals.data() + removals.size());
+    inc_generation();
+    EXPECT_FALSE(_store.has_compressed(ref));
+    EXPECT_EQ(exp_sequence, get_sequence(ref));
+    _store.clear(ref);
+}
+
 namespace {
 
 /*
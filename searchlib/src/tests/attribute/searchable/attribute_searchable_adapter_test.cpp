@@ -8,6 +8,7 @@
 #include <vespa/searchlib/attribute/attributeguard.h>
 #include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/searchlib/attribute/attribute_read_guard.h>
+#include <vespa/searchlib/attribute/diversity.h>
 #include <vespa/searchlib/attribute/singlestringattribute.h>
 #include <vespa/searchlib/attribute/iattributemanager.h>
 #include <vespa/searchlib/attribute/predicate_attribute.h>
@@ -748,6 +749,45 @@ TEST(AttributeSearchableAdapterTest, require_that_diversity_also_works_for_a_sin
     EXPECT_EQ(2u, diversity_hits(manager, "[2;2;-100;other;2]", false));
 }
 
+TEST(AttributeSearchableAdapterTest, require_that_batched_diversity_filtering_matches_filtering_one_by_one) {
+    using search::attribute::diversity::DiversityFilter;
+    for (auto other_type : {BasicType::STRING, BasicType::INT32, BasicType::DOUBLE}) {
+        Config other_cfg(other_type, CollectionType::SINGLE);
+        other_cfg.setFastSearch(true);
+        AttributeVector::SP other_attr = AttributeFactory::createAttribute(other, other_cfg);
+        add_docs(&*other_attr, num_docs);
+        for (size_t i = 1; i < num_docs; ++i) {
+            set_attr_value(*other_attr, i, i % 97);
+        }
+        for (size_t max_per_group : {1, 3}) {
+            for (size_t cutoff_groups : {10, 50, 1000}) {
+                for (bool cutoff_strict : {false, true}) {
+                    SCOPED_TRACE(make_string("type=%s, max_per_group=%zu, cutoff_groups=%zu, strict=%s",
+                                             BasicType(other_type).asString(), max_per_group, cutoff_groups,
+                                             cutoff_strict ? "true" : "false"));
+                    auto one_by_one = DiversityFilter::create(*other_attr, 200, max_per_group, cutoff_groups, cutoff_strict);
+                    auto batched = DiversityFilter::create(*other_attr, 200, max_per_group, cutoff_groups, cutoff_strict);
+                    std::vector<uint32_t> docids;
+                    std::vector<bool> expected;
+                    for (uint32_t docid = 1; docid < num_docs; ++docid) {
+                        docids.push_back(docid);
+                        expected.push_back(one_by_one->accepted(docid));
+                    }
+                    // Batches not aligned with the internal batch size
+                    std::unique_ptr<bool[]> accepted(new bool[docids.size()]);
+                    for (size_t offset = 0; offset < docids.size(); offset += 71) {
+                        size_t n = std::min(size_t(71), docids.size() - offset);
+                        batched->accepted_batch(docids.data() + offset, n, accepted.get() + offset);
+                    }
+                    for (size_t i = 0; i < docids.size(); ++i) {
+                        EXPECT_EQ(expected[i], accepted[i]) << "docid " << docids[i];
+                    }
+                }
+            }
+        }
+    }
+}
+
 TEST(AttributeSearchableAdapterTest, require_that_diversity_range_searches_gives_empty_results_for_non_existing_diversity_attributes) {
     MyAttributeManager manager = make_diversity_setup(BasicType::INT32, true, BasicType::INT32, true);
     EXPECT_EQ(0u, diversity_hits(manager, "[;;1000;bogus;10]", true));
@@ -10,6 +10,7 @@
 #include <vespa/searchlib/attribute/attribute_read_guard.h>
 #include <vespa/searchlib/attribute/attributecontext.h>
 #include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/value_statistics.h>
 #include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/query/tree/location.h>
 #include <vespa/searchlib/query/tree/point.h>
@@ -228,6 +229,35 @@ TEST(AttributeBlueprintTest, require_that_range_terms_work)
     EXPECT_TRUE(search_for_term("[10;]", attribute_manager));
 }
 
+double
+estimate_for_term(const string &term, IAttributeManager &attribute_manager, uint32_t docid_limit)
+{
+    AttributeContext ac(attribute_manager);
+    FakeRequestContext requestContext(&ac);
+    SimpleStringTerm node(term, field, 0, Weight(0));
+    Blueprint::UP result = AttributeBlueprintFactory().createBlueprint(requestContext, FieldSpec(field, 0, 0), node);
+    return result->calculate_flow_stats(docid_limit).estimate;
+}
+
+TEST(AttributeBlueprintTest, value_statistics_are_used_to_estimate_hits_without_fast_search)
+{
+    Config cfg(BasicType::INT32, CollectionType::SINGLE);
+    auto attr = AttributeBuilder(field, cfg).fill({1, 1, 1, 1, 1, 1, 2, 3}).get();
+    auto statistics = attr->get_value_statistics();
+    ASSERT_TRUE(statistics);
+    EXPECT_EQ(8, statistics->sampled_docs());
+    MyAttributeManager attribute_manager(attr);
+    EXPECT_DOUBLE_EQ(0.75, estimate_for_term("1", attribute_manager, 9));
+    EXPECT_DOUBLE_EQ(0.25, estimate_for_term("[2;3]", attribute_manager, 9));
+    EXPECT_DOUBLE_EQ(1.0 / 16, estimate_for_term("5", attribute_manager, 9));
+}
+
+TEST(AttributeBlueprintTest, value_statistics_are_not_made_for_fast_search_or_string_attributes)
+{
+    EXPECT_FALSE(make_fast_search_long_attribute(42)->get_value_statistics());
+    EXPECT_FALSE(make_string_attribute("foo")->get_value_statistics());
+}
+
 TEST(AttributeBlueprintTest, require_that_prefix_terms_work)
 {
     auto attribute_manager = makeAttributeManager("foo");
@@ -20,6 +20,7 @@
 #include <vespa/searchlib/test/attribute_builder.h>
 #include <vespa/searchlib/test/searchiteratorverifier.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/objects/objectdumper.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/util/compress.h>
 #include <vespa/vespalib/util/simple_thread_bundle.h>
@@ -1481,6 +1482,17 @@ SearchContextTest::testRegexSearch(const std::string& name, const Config& cfg)
         performSearch(*attr, terms[i], expected[i], TermType::REGEXP);
         performSearch(*attr, terms[i], empty, TermType::WORD);
     }
+
+    auto sc = getSearch(*attr, "bc2de", TermType::REGEXP);
+    sc->fetchPostings(queryeval::ExecuteInfo::FULL, true);
+    vespalib::ObjectDumper dumper;
+    sc->visitMembers(dumper);
+    EXPECT_NE(std::string::npos, dumper.toString().find("regex_required_literal: 'bc2de'"));
+    if (attr->getConfig().fastSearch()) {
+        // dictionary entries without the required literal never reach the regex engine
+        EXPECT_NE(std::string::npos, dumper.toString().find("regex_prefilter_rejected: "));
+        EXPECT_EQ(std::string::npos, dumper.toString().find("regex_prefilter_rejected: 0\n"));
+    }
 }
 
 
@@ -2,6 +2,7 @@
 
 #include <vespa/searchcommon/common/undefinedvalues.h>
 #include <vespa/searchlib/attribute/numeric_sort_blob_writer.h>
+#include <vespa/searchlib/attribute/sort_key_cache.h>
 #include <vespa/searchlib/attribute/string_sort_blob_writer.h>
 #include <vespa/searchlib/common/converters.h>
 #include <vespa/searchlib/common/sortspec.h>
@@ -11,6 +12,7 @@
 #include <span>
 
 using search::attribute::NumericSortBlobWriter;
+using search::attribute::SortKeyCache;
 using search::attribute::StringSortBlobWriter;
 using search::common::BlobConverter;
 using search::common::LowercaseConverter;
@@ -132,11 +134,12 @@ sort_data_integer(std::vector<int32_t> values, MissingPolicy policy, int32_t mis
 template <bool asc>
 SortData
 sort_data_string(std::vector<const char*> values, const BlobConverter* bc, MissingPolicy missing_policy,
-                 std::string_view missing_value, bool multi_value)
+                 std::string_view missing_value, bool multi_value,
+                 std::shared_ptr<const SortKeyCache::Keys> keys = {})
 {
     size_t len = 0;
     SortData s;
-    StringSortBlobWriter<asc> writer(bc, missing_policy, missing_value, multi_value);
+    StringSortBlobWriter<asc> writer(bc, std::move(keys), missing_policy, missing_value, multi_value);
     while (true) {
         s.clear();
         s.resize(len);
@@ -398,6 +401,61 @@ TEST_F(SortBlobStringWriterTest, blob_converter_is_used)
     EXPECT_EQ(serialized_present_string("hello", false), sort_data_string<false>({"Hello", "always"}, &lowercase));
 }
 
+class CountingLowercaseConverter : public BlobConverter
+{
+    LowercaseConverter _lowercase;
+    mutable uint32_t   _converts;
+public:
+    CountingLowercaseConverter() noexcept : _lowercase(), _converts(0) {}
+    uint32_t converts() const noexcept { return _converts; }
+    std::string id() const override { return "lowercase"; }
+    UP clone() const override { return std::make_unique<CountingLowercaseConverter>(); }
+private:
+    ConstBufferRef onConvert(const ConstBufferRef & src) const override {
+        ++_converts;
+        return _lowercase.convert(src);
+    }
+};
+
+TEST_F(SortBlobStringWriterTest, materialized_sort_keys_are_used)
+{
+    CountingLowercaseConverter lowercase;
+    SortKeyCache cache;
+    EXPECT_FALSE(cache.needs_materialize());
+    EXPECT_EQ(nullptr, cache.get(lowercase));
+    EXPECT_TRUE(cache.needs_materialize());
+    cache.materialize({"Hello", "always"});
+    EXPECT_FALSE(cache.needs_materialize());
+    auto keys = cache.get(lowercase);
+    ASSERT_NE(nullptr, keys);
+    EXPECT_EQ(2u, keys->size());
+    EXPECT_EQ(serialized_present_string("always", true),
+              sort_data_string<true>({"Hello", "always"}, &lowercase, MissingPolicy::DEFAULT, "", true, keys));
+    EXPECT_EQ(0u, lowercase.converts());
+    EXPECT_EQ(0u, keys->misses());
+    // Values added after materialization are converted, and trigger a new materialization
+    EXPECT_EQ(serialized_present_string("hello", false),
+              sort_data_string<false>({"Hello", "Aaa"}, &lowercase, MissingPolicy::DEFAULT, "", true, keys));
+    EXPECT_LT(0u, lowercase.converts());
+    EXPECT_LT(0u, keys->misses());
+    EXPECT_TRUE(cache.needs_materialize());
+    cache.materialize({"Hello", "always", "Aaa"});
+    EXPECT_EQ(3u, cache.get(lowercase)->size());
+    auto stats = cache.get_stats();
+    ASSERT_EQ(1u, stats.size());
+    EXPECT_EQ("lowercase", stats[0].id);
+    EXPECT_EQ(3u, stats[0].num_values);
+    EXPECT_EQ(0u, stats[0].misses);
+}
+
+TEST_F(SortBlobStringWriterTest, converter_without_id_is_not_materialized)
+{
+    LowercaseConverter lowercase;
+    SortKeyCache cache;
+    EXPECT_EQ(nullptr, cache.get(lowercase));
+    EXPECT_FALSE(cache.needs_materialize());
+}
+
 TEST_F(SortBlobStringWriterTest, prefix_is_first)
 {
     EXPECT_EQ(serialized_present_string("aaa", true), sort_data_string({"aaa", "aaaa"}, true));
@@ -2,6 +2,8 @@
 
 #include <vespa/searchlib/attribute/attribute_read_guard.h>
 #include <vespa/searchlib/attribute/attributeguard.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/searchlib/queryeval/nearest_neighbor_blueprint.h>
 #include <vespa/searchlib/tensor/default_nearest_neighbor_index_factory.h>
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
@@ -20,6 +22,7 @@
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/util/mmap_file_allocator_factory.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <vespa/searchlib/util/bufferwriter.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/document/base/exceptions.h>
@@ -314,7 +317,8 @@ public:
                                      uint32_t explore_k,
                                      double exploration_slack,
                                      const vespalib::Doom& doom,
-                                     double distance_threshold) const override
+                                     double distance_threshold,
+                                     SearchStats* stats) const override
     {
         (void) k;
         (void) df;
@@ -322,6 +326,7 @@ public:
         (void) exploration_slack;
         (void) doom;
         (void) distance_threshold;
+        (void) stats;
         return {};
     }
     std::vector<Neighbor> find_top_k_with_filter(uint32_t k,
@@ -329,7 +334,8 @@ public:
                                                  const GlobalFilter& filter, bool low_hit_ratio, double exploration, uint32_t explore_k,
                                                  double exploration_slack,
                                                  const vespalib::Doom& doom,
-                                                 double distance_threshold) const override
+                                                 double distance_threshold,
+                                                 SearchStats* stats) const override
     {
         (void) k;
         (void) df;
@@ -340,6 +346,7 @@ public:
         (void) exploration;
         (void) doom;
         (void) distance_threshold;
+        (void) stats;
         return {};
     }
 
@@ -1560,6 +1567,37 @@ TEST(TensorAttributeTest, NN_blueprint_handles_strong_filter_triggering_exact_se
     EXPECT_EQ(NNBA::EXACT_FALLBACK, bp->get_algorithm());
 }
 
+TEST(TensorAttributeTest, NN_blueprint_calculates_exact_top_k_in_parallel_when_strong_filter_triggers_exact_search)
+{
+    NearestNeighborBlueprintFixture f;
+    auto bp = f.make_blueprint(true, 0.5);
+    vespalib::SimpleThreadBundle thread_bundle(3);
+    bp->set_thread_bundle(&thread_bundle);
+    auto filter = search::BitVector::create(1,11);
+    filter->setBit(3);
+    filter->setBit(5);
+    filter->setBit(7);
+    filter->setBit(9);
+    filter->setBit(10);
+    filter->invalidateCachedCount();
+    auto strong_filter = GlobalFilter::create(std::move(filter));
+    bp->set_global_filter(*strong_filter, 0.6);
+    EXPECT_EQ(3u, bp->getState().estimate().estHits);
+    EXPECT_EQ(NNBA::EXACT_FALLBACK_TOP_K, bp->get_algorithm());
+    search::fef::TermFieldMatchData tfmd;
+    search::fef::TermFieldMatchDataArray tfmda;
+    tfmda.add(&tfmd);
+    auto itr = bp->createLeafSearch(tfmda);
+    itr->initRange(1, 11);
+    std::vector<uint32_t> hits;
+    for (uint32_t docid = 1; docid < 11; ++docid) {
+        if (itr->seek(docid)) {
+            hits.push_back(docid);
+        }
+    }
+    EXPECT_EQ((std::vector<uint32_t>{5, 7, 9}), hits);
+}
+
 TEST(TensorAttributeTest, NN_blueprint_wants_global_filter_when_having_index)
 {
     NearestNeighborBlueprintFixture f;
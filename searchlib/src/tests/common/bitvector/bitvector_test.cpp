@@ -800,6 +800,41 @@ TEST(BitvectorTest, Require_that_parallell_OR_computes_same_result_as_serial) {
     }
 }
 
+TEST(BitvectorTest, require_that_or_words_and_and_words_only_change_range)
+{
+    auto every_third = [](uint32_t first, uint32_t last) noexcept {
+        BitWord::Word bits = 0;
+        for (uint32_t i = first; i < last; ++i) {
+            if ((i % 3) == 0) {
+                bits |= BitWord::Word(1) << (i % BitWord::WordLen);
+            }
+        }
+        return bits;
+    };
+    for (uint32_t start : {0u, 1u, 63u, 64u, 100u}) {
+        for (uint32_t end : {start, start + 1, 128u, 200u, 1000u}) {
+            AllocatedBitVector bv(1000);
+            bv.setInterval(500, 600);
+            bv.or_words(start, end, every_third);
+            for (uint32_t i = 0; i < bv.size(); ++i) {
+                bool expected = (i >= 500 && i < 600) || (i >= start && i < end && (i % 3) == 0);
+                EXPECT_EQ(expected, bv.testBit(i)) << "or: start=" << start << ", end=" << end << ", i=" << i;
+            }
+            bv.setInterval(0, bv.size());
+            bv.and_words(start, end, every_third);
+            for (uint32_t i = 0; i < bv.size(); ++i) {
+                bool expected = (i < start || i >= end || (i % 3) == 0);
+                EXPECT_EQ(expected, bv.testBit(i)) << "and: start=" << start << ", end=" << end << ", i=" << i;
+            }
+            uint32_t expected_count = 0;
+            for (uint32_t i = 0; i < bv.size(); ++i) {
+                expected_count += bv.testBit(i) ? 1 : 0;
+            }
+            EXPECT_EQ(expected_count, bv.countTrueBits());
+        }
+    }
+}
+
 namespace {
 
 bool check_full_term_field_match_data_reset_on_unpack(bool strict, bool full_reset)
@@ -235,6 +235,25 @@ void check_box(const GeoLocation &location, Box expected)
     EXPECT_FALSE(location.inside_limit(Point{minus_inf,minus_inf}));
 }
 
+TEST(GeoLocationTest, box_overlap_with_circle_is_checked_against_closest_point) {
+    GeoLocation location(Point{100, 200}, 10);
+    EXPECT_TRUE(location.may_be_inside_limit(Box{{90, 110}, {190, 210}}));
+    EXPECT_TRUE(location.may_be_inside_limit(Box{{0, 1000}, {0, 1000}}));
+    EXPECT_TRUE(location.may_be_inside_limit(Box{{110, 120}, {200, 300}}));
+    EXPECT_TRUE(location.may_be_inside_limit(Box{{106, 120}, {208, 300}}));
+    EXPECT_FALSE(location.may_be_inside_limit(Box{{111, 120}, {200, 300}}));
+    EXPECT_FALSE(location.may_be_inside_limit(Box{{108, 120}, {208, 300}}));
+    EXPECT_FALSE(location.may_be_inside_limit(Box{{0, 89}, {0, 189}}));
+
+    GeoLocation wide(Point{100, 200}, 10, Aspect(0.5));
+    EXPECT_TRUE(wide.may_be_inside_limit(Box{{121, 130}, {200, 300}}));
+    EXPECT_FALSE(wide.may_be_inside_limit(Box{{122, 130}, {200, 300}}));
+
+    GeoLocation box_only(Box{{0, 10}, {0, 10}});
+    EXPECT_TRUE(box_only.may_be_inside_limit(Box{{10, 20}, {10, 20}}));
+    EXPECT_FALSE(box_only.may_be_inside_limit(Box{{11, 20}, {0, 20}}));
+}
+
 TEST(GeoLocationTest, invalid_location) {
     GeoLocation invalid;
     EXPECT_FALSE(invalid.valid());
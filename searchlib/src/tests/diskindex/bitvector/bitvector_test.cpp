@@ -3,6 +3,7 @@
 #include <vespa/searchlib/index/field_length_info.h>
 #include <vespa/searchlib/diskindex/bitvectordictionary.h>
 #include <vespa/searchlib/diskindex/fieldwriter.h>
+#include <vespa/searchlib/common/read_stats.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchcommon/common/schema.h>
 #include <vespa/vespalib/gtest/gtest.h>
@@ -194,6 +195,46 @@ TEST_P(BitVectorTest, require_that_dictionary_handles_multiple_entries)
     EXPECT_TRUE(*bv5exp == *bv5act);
 }
 
+TEST_P(BitVectorTest, require_that_large_bitvectors_can_be_read_with_direct_io)
+{
+    TuneFileSeqWrite tuneFileWrite;
+    TuneFileRandRead tuneFileRead;
+    DummyFileHeaderContext fileHeaderContext;
+
+    if (GetParam().directio) {
+        tuneFileWrite.setWantDirectIO();
+    }
+    if (GetParam().readmmap) {
+        tuneFileRead.setWantMemoryMap();
+    }
+    FieldWriterWrapper fww(64, 1, "dump/3/");
+    EXPECT_TRUE(fww.open(_schema, _indexId, tuneFileWrite, fileHeaderContext));
+    BitVector::UP bv1exp(BitVector::create(64));
+    fww.newWord("1");
+    for (uint32_t docId = 1; docId < 40; ++docId) {
+        fww.add(docId);
+        bv1exp->setBit(docId);
+    }
+    EXPECT_TRUE(fww._writer.close());
+
+    BitVectorDictionary dict;
+    dict.set_direct_io_min_bytes(1);
+    BitVectorKeyScope bvScope(BitVectorKeyScope::PERFIELD_WORDS);
+    EXPECT_TRUE(dict.open("dump/3/", tuneFileRead, bvScope));
+    if (GetParam().readmmap) {
+        EXPECT_FALSE(dict.get_direct_io());
+    }
+    auto bv1lr = dict.lookup(1);
+    EXPECT_TRUE(bv1lr.valid());
+    ReadStats read_stats;
+    auto bv1act = dict.read_bitvector(bv1lr, read_stats);
+    EXPECT_TRUE(bv1act);
+    EXPECT_TRUE(*bv1exp == *bv1act);
+    EXPECT_LT(0u, read_stats.read_bytes);
+    // Direct io might not be supported by the file system used for the test
+    EXPECT_EQ(dict.get_direct_io(), read_stats.direct_io);
+}
+
 }
 
 int
@@ -2,6 +2,7 @@
 
 #include <vespa/searchlib/common/bitvectoriterator.h>
 #include <vespa/searchlib/diskindex/disktermblueprint.h>
+#include <vespa/searchlib/diskindex/posting_list_cache.h>
 #include <vespa/searchlib/test/diskindex/testdiskindex.h>
 #include <vespa/searchlib/test/searchiteratorverifier.h>
 #include <vespa/searchlib/test/fakedata/fakeword.h>
@@ -14,9 +15,11 @@
 #include <vespa/searchlib/queryeval/simpleresult.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/test/fakedata/fpfactory.h>
+#include <vespa/vespalib/coro/async_io.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <filesystem>
+#include <optional>
 #include <set>
 
 using search::BitVector;
@@ -24,6 +27,7 @@ using search::BitVectorIterator;
 using search::diskindex::DiskIndex;
 using search::diskindex::DiskTermBlueprint;
 using search::diskindex::FieldIndex;
+using search::diskindex::PostingListCache;
 using search::diskindex::TestDiskIndex;
 using search::diskindex::ZcRareWordPosOccIterator;
 using search::fef::FilterThreshold;
@@ -48,6 +52,7 @@ using search::fakedata::FPFactory;
 using search::fakedata::FakePosting;
 using search::fakedata::FakeWord;
 using search::fakedata::getFPFactory;
+using vespalib::coro::AsyncIo;
 
 namespace {
 
@@ -108,15 +113,18 @@ struct IOSettings
     bool _use_directio;
     bool _use_mmap;
     bool _use_posting_list_cache;
+    bool _use_async_io;
     IOSettings()
         : _use_directio(false),
           _use_mmap(false),
-          _use_posting_list_cache(false)
+          _use_posting_list_cache(false),
+          _use_async_io(false)
     {
     }
     IOSettings use_directio() && { _use_directio = true; return *this; }
     IOSettings use_mmap() && { _use_mmap = true; return *this; }
     IOSettings use_posting_list_cache() && { _use_posting_list_cache = true; return *this; }
+    IOSettings use_async_io() && { _use_async_io = true; return *this; }
 };
 
 class DiskIndexTest : public ::testing::Test, public TestDiskIndex {
@@ -456,6 +464,9 @@ DiskIndexTest::build_index(const IOSettings& io_settings, const EmptySettings& e
     if (io_settings._use_posting_list_cache) {
         io_settings_num += 4;
     }
+    if (io_settings._use_async_io) {
+        io_settings_num += 8;
+    }
     name << test_dir << "/" << io_settings_num;
     if (empty_settings._empty_field) {
         name << "fe";
@@ -502,6 +513,12 @@ DiskIndexTest::test_io_settings(const IOSettings& io_settings)
 {
     EmptySettings empty_settings;
     build_index(io_settings, empty_settings);
+    std::optional<AsyncIo::Owner> async_io;
+    if (io_settings._use_async_io) {
+        async_io.emplace(AsyncIo::create(AsyncIo::ImplTag::URING));
+        auto& posting_list_cache = dynamic_cast<PostingListCache&>(*getIndex().get_posting_list_cache());
+        posting_list_cache.set_async_io(async_io->share());
+    }
     requireThatLookupIsWorking(empty_settings);
     requireThatWeCanReadPostingList(io_settings);
     require_that_we_can_get_field_length_info();
@@ -580,6 +597,11 @@ TEST_F(DiskIndexTest, io_settings_directio_posting_list_cache)
     test_io_settings(IOSettings().use_directio().use_posting_list_cache());
 }
 
+TEST_F(DiskIndexTest, io_settings_directio_posting_list_cache_async_io)
+{
+    test_io_settings(IOSettings().use_directio().use_posting_list_cache().use_async_io());
+}
+
 TEST_F(DiskIndexTest, search_iterators_conformance)
 {
     requireThatSearchIteratorsConforms();
@@ -75,6 +75,7 @@ uint32_t minChunkDocs = 256_Ki;
 constexpr uint64_t disable_features_size_flush = std::numeric_limits<uint64_t>::max();
 constexpr uint64_t force_features_size_flush = 2; // Unrealistic low for testing, 1 document per chunk
 uint64_t features_size_flush_bits = disable_features_size_flush;
+bool block_doc_ids = false;
 
 std::string dirprefix = "index/";
 
@@ -211,7 +212,7 @@ WrappedFieldWriter::WrappedFieldWriter(const std::string &namepref,
       _indexId()
 {
     schema::CollectionType ct(CollectionType::SINGLE);
-    _schema.addIndexField(Schema::IndexField("field1", DataType::STRING, ct));
+    _schema.addIndexField(Schema::IndexField("field1", DataType::STRING, ct).set_block_doc_ids(block_doc_ids));
     _indexId = _schema.getIndexFieldId("field1");
 }
 
@@ -652,6 +653,13 @@ testFieldWriterVariants(FakeWordSet &wordSet,
     testFieldWriterVariant(wordSet, docIdLimit, "newchunk4", true, false, verbose);
     testFieldWriterVariant(wordSet, docIdLimit, "newchunk5", false, false, verbose);
     testFieldWriterVariant(wordSet, docIdLimit, "newchunkcf4", true, true, verbose);
+    block_doc_ids = true;
+    enableSkip();
+    testFieldWriterVariant(wordSet, docIdLimit, "newskipbd5", false, false, verbose);
+    enableSkipChunks();
+    testFieldWriterVariant(wordSet, docIdLimit, "newchunkbd4", true, false, verbose);
+    testFieldWriterVariant(wordSet, docIdLimit, "newchunkbdcf4", true, true, verbose);
+    block_doc_ids = false;
     enable_features_size_flush();
     testFieldWriterVariant(wordSet, docIdLimit, "newfs4", true, false, verbose);
     testFieldWriterVariant(wordSet, docIdLimit, "newfs5", false, false, verbose);
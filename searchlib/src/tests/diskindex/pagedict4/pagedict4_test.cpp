@@ -660,6 +660,58 @@ testWords(const std::string &logname,
         (void) closeres;
         LOG(info, "%s: pagedict4 randverify OK", logname.c_str());
     }
+    {
+        PageDict4RandRead drr;
+        if (mmap_file_size_threshold.has_value()) {
+            drr.set_mmap_file_size_threshold(mmap_file_size_threshold.value());
+        }
+        drr.set_lookup_cache_max_bytes(1_Mi);
+        search::TuneFileRandRead tuneFileRead;
+        bool openres = drr.open("fakedict", tuneFileRead);
+        assert(openres);
+        (void) openres;
+        PostingListOffsetAndCounts rOffsetAndCounts;
+        std::vector<std::string_view> words;
+        std::vector<uint64_t> offsets;
+        uint64_t wOffset = 0;
+        uint64_t wordNum = 1;
+        for (const auto& wc : myrand) {
+            makeCounts(counts, wc, chunkSize);
+            for (uint32_t pass = 0; pass < 2; ++pass) {
+                uint64_t checkWordNum = 0;
+                bool lres = drr.lookup(wc._word, checkWordNum, rOffsetAndCounts);
+                assert(lres);
+                (void) lres;
+                assert(rOffsetAndCounts._counts == counts);
+                assert(rOffsetAndCounts._offset == wOffset);
+                assert(checkWordNum == wordNum);
+                std::string missWord = wc._word;
+                missWord.append(1, '\1');
+                lres = drr.lookup(missWord, checkWordNum, rOffsetAndCounts);
+                assert(!lres);
+                assert(checkWordNum == wordNum + 1);
+            }
+            words.emplace_back(wc._word);
+            words.emplace_back(wc._word);
+            offsets.emplace_back(wOffset);
+            wOffset += counts._bitLength;
+            ++wordNum;
+        }
+        assert(myrand.empty() || drr.get_lookup_cache_stats().hits > 0);
+        std::vector<DictionaryLookupResult> results;
+        drr.lookup_many(words, results);
+        assert(results.size() == words.size());
+        for (size_t i = 0; i < results.size(); ++i) {
+            makeCounts(counts, myrand[i / 2], chunkSize);
+            assert(results[i].counts == counts);
+            assert(results[i].bitOffset == offsets[i / 2]);
+            assert(results[i].wordNum == i / 2 + 1);
+        }
+        bool closeres = drr.close();
+        assert(closeres);
+        (void) closeres;
+        LOG(info, "%s: pagedict4 cached randverify OK", logname.c_str());
+    }
 }
 
 
@@ -2,11 +2,14 @@
 
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/diskindex/posting_list_cache.h>
+#include <vespa/searchlib/diskindex/posting_list_cache_snapshot.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <filesystem>
 
 using search::BitVector;
 using search::diskindex::PostingListCache;
+using search::diskindex::PostingListCacheSnapshot;
 using search::index::PostingListHandle;
 
 namespace {
@@ -33,6 +36,7 @@ MockFile::read(const PostingListCache::Key& key, PostingListCache::Context& ctx)
     ctx.cache_miss = true;
     PostingListHandle handle;
     handle._allocSize = key.bit_length / 8;
+    handle._read_bytes = handle._allocSize;
     return handle;
 }
 
@@ -130,6 +134,24 @@ TEST_F(PostingListCacheTest, file_id_is_part_of_key)
     EXPECT_EQ(2, stats.elements);
 }
 
+TEST_F(PostingListCacheTest, has_checks_presence_without_reading)
+{
+    _key.bit_length = 24 * 8;
+    _bv_key.lookup_result.idx = 1;
+    EXPECT_FALSE(_cache.has(_key));
+    EXPECT_FALSE(_cache.has(_bv_key));
+    (void) read();
+    (void) read_bv();
+    EXPECT_TRUE(_cache.has(_key));
+    EXPECT_TRUE(_cache.has(_bv_key));
+    _key.file_id = 1;
+    EXPECT_FALSE(_cache.has(_key));
+    auto stats = _cache.get_stats();
+    EXPECT_EQ(1, stats.misses);
+    EXPECT_EQ(0, stats.hits);
+    EXPECT_FALSE(_cache.get_async_io());
+}
+
 TEST_F(PostingListCacheTest, repeated_bitvector_lookup_gives_hit)
 {
     _bv_key.lookup_result.idx = 1;
@@ -146,4 +168,81 @@ TEST_F(PostingListCacheTest, repeated_bitvector_lookup_gives_hit)
     EXPECT_EQ(PostingListCache::bitvector_element_size() + bv->get_allocated_bytes(true), stats.memory_used);
 }
 
+TEST(PostingListCacheSnapshotTest, snapshot_is_used_for_warmup_after_restart)
+{
+    using PostingListEntry = PostingListCacheSnapshot::PostingListEntry;
+    using BitVectorEntry = PostingListCacheSnapshot::BitVectorEntry;
+    PostingListCache::CacheSizingParams params(256_Ki, 256_Ki, 0.5, 0.5, 0, 0);
+    auto file = std::make_shared<MockFile>();
+    PostingListCache cache(params);
+    cache.register_file(1, "dir1/", 1000, file);
+    PostingListCache::Context ctx(file.get());
+    PostingListCache::Key key;
+    key.file_id = 1;
+    key.bit_length = 24 * 8;
+    (void) cache.read(key, ctx);
+    (void) cache.read(key, ctx); // Promoted to protected segment
+    key.bit_offset = 1000;
+    (void) cache.read(key, ctx);
+    key.file_id = 2; // Not registered, not part of snapshot
+    (void) cache.read(key, ctx);
+    PostingListCache::BitVectorKey bv_key;
+    bv_key.file_id = 1;
+    bv_key.lookup_result.idx = 3;
+    (void) cache.read(bv_key, ctx);
+
+    auto snapshot = cache.make_snapshot();
+    ASSERT_EQ(1, snapshot->files().size());
+    auto& entries = snapshot->files().at("dir1/");
+    EXPECT_EQ(1000, entries.size_on_disk);
+    EXPECT_EQ((std::vector<PostingListEntry>{{1000, 192, false}, {0, 192, true}}), entries.posting_lists);
+    EXPECT_EQ((std::vector<BitVectorEntry>{{3, false}}), entries.bit_vectors);
+
+    std::string file_name("posting_list_cache.snapshot");
+    ASSERT_TRUE(snapshot->save(file_name));
+    auto loaded = PostingListCacheSnapshot::load(file_name);
+    std::filesystem::remove(file_name);
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(snapshot->files(), loaded->files());
+    EXPECT_FALSE(PostingListCacheSnapshot::load(file_name));
+
+    // Field index in dir2 is not opened after restart, its entries are skipped
+    loaded->add_file("dir2/", 1000).posting_lists.emplace_back(0, 8, false);
+    PostingListCache restarted(params);
+    restarted.register_file(7, "dir1/", 1000, file);
+    restarted.start_warmup(std::move(loaded));
+    auto stats = restarted.get_warmup_stats();
+    EXPECT_TRUE(stats.active);
+    EXPECT_EQ(4, stats.pending);
+    EXPECT_TRUE(restarted.warmup(1)); // Budget exhausted after first posting list
+    stats = restarted.get_warmup_stats();
+    EXPECT_EQ(3, stats.pending);
+    EXPECT_EQ(1, stats.prefetched);
+    EXPECT_EQ(24, stats.read_bytes);
+    EXPECT_FALSE(restarted.warmup(1_Mi));
+    stats = restarted.get_warmup_stats();
+    EXPECT_FALSE(stats.active);
+    EXPECT_EQ(0, stats.pending);
+    EXPECT_EQ(3, stats.prefetched);
+    EXPECT_EQ(1, stats.skipped);
+    auto restarted_snapshot = restarted.make_snapshot();
+    ASSERT_EQ(1, restarted_snapshot->files().size());
+    EXPECT_EQ(entries, restarted_snapshot->files().at("dir1/"));
+}
+
+TEST(PostingListCacheSnapshotTest, expired_file_backing_is_not_part_of_snapshot)
+{
+    PostingListCache cache(256_Ki, 256_Ki);
+    auto file = std::make_shared<MockFile>();
+    cache.register_file(1, "dir1/", 1000, file);
+    PostingListCache::Context ctx(file.get());
+    PostingListCache::Key key;
+    key.file_id = 1;
+    key.bit_length = 24 * 8;
+    (void) cache.read(key, ctx);
+    EXPECT_EQ(1, cache.make_snapshot()->num_entries());
+    file.reset();
+    EXPECT_EQ(0, cache.make_snapshot()->num_entries());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
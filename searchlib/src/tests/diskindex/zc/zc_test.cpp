@@ -1,10 +1,14 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
+#include <vespa/searchlib/diskindex/zc_block_codec.h>
 #include <vespa/searchlib/diskindex/zc_decoder_validator.h>
 #include <vespa/searchlib/diskindex/zcbuf.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
 #include <limits>
 
+using search::diskindex::ZcBlockCodec;
+using search::diskindex::ZcBlockDecoder;
 using search::diskindex::ZcBuf;
 using search::diskindex::ZcDecoderValidator;
 
@@ -108,6 +112,56 @@ TEST_F(ZcTest, encode_then_decode_should_give_original_result)
     EXPECT_EQ(5, encode_used_bytes(std::numeric_limits<uint32_t>::max()));
 }
 
+TEST_F(ZcTest, encode_block_then_unpack_should_give_original_result)
+{
+    constexpr uint32_t block_size = ZcBlockCodec::block_size;
+    for (uint32_t bits = 0; bits <= 32; ++bits) {
+        SCOPED_TRACE(std::string("bits=") + std::to_string(bits));
+        uint32_t values[block_size];
+        uint32_t max_value = (bits == 32) ? std::numeric_limits<uint32_t>::max() : ((1u << bits) - 1);
+        for (uint32_t i = 0; i < block_size; ++i) {
+            values[i] = (i * 2654435761u) & max_value;
+        }
+        values[block_size - 1] = max_value;
+        _zc_buf.clear();
+        _zc_buf.encode_block(values);
+        auto view = _zc_buf.view();
+        EXPECT_EQ(1 + ZcBlockCodec::packed_bytes(bits), view.size());
+        EXPECT_EQ(bits, view[0]);
+        uint32_t unpacked[block_size];
+        ZcBlockCodec::unpack(view.data() + 1, bits, unpacked);
+        EXPECT_TRUE(std::equal(values, values + block_size, unpacked));
+    }
+}
+
+TEST_F(ZcTest, block_decoder_gives_absolute_doc_ids_and_features)
+{
+    constexpr uint32_t block_size = ZcBlockCodec::block_size;
+    uint32_t deltas[block_size];
+    uint32_t field_lengths[block_size];
+    uint32_t num_occs[block_size];
+    for (uint32_t i = 0; i < block_size; ++i) {
+        deltas[i] = i % 5;
+        field_lengths[i] = i + 10;
+        num_occs[i] = i % 3;
+    }
+    _zc_buf.encode_block(deltas);
+    _zc_buf.encode_block(field_lengths);
+    _zc_buf.encode_block(num_occs);
+    auto view = _zc_buf.view();
+    ZcBlockDecoder decoder;
+    EXPECT_EQ(view.data() + view.size(), decoder.decode(view.data(), 1000, true));
+    uint32_t doc_id = 1000;
+    for (uint32_t i = 0; i < block_size; ++i) {
+        doc_id += deltas[i] + 1;
+        EXPECT_EQ(doc_id, decoder.get_doc_id(i));
+        EXPECT_EQ(field_lengths[i] + 1, decoder.get_field_length(i));
+        EXPECT_EQ(num_occs[i] + 1, decoder.get_num_occs(i));
+    }
+    EXPECT_EQ(view.data() + 1 + ZcBlockCodec::packed_bytes(3), decoder.decode(view.data(), 1000, false));
+    EXPECT_EQ(1001u, decoder.get_doc_id(0));
+}
+
 TEST_F(ZcTest, DISABLED_decode_speed_decoder)
 {
     fill();
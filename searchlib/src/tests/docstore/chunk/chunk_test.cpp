@@ -5,6 +5,8 @@
 #include <vespa/searchlib/docstore/chunkformats.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/objects/hexdump.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <string>
 #include <zstd.h>
 
@@ -13,6 +15,7 @@ LOG_SETUP("chunk_test");
 
 using namespace search;
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
 
 TEST(ChunkTest, require_that_Chunk_obey_limits)
 {
@@ -99,4 +102,70 @@ TEST(ChunkTest, require_that_V2_can_create_and_handle_lz4_zstd_and_none) {
     verifyChunkCompression(CompressionConfig::ZSTD, MY_LONG_STRING, strlen(MY_LONG_STRING), zstd_compressed_length);
 }
 
+std::string makeDocument(uint32_t i) {
+    return vespalib::make_string("{\"id\":\"id:test:music::%u\",\"title\":\"Title of song %u\",\"year\":%u,\"body\":\"%s\"}",
+                                 i, i * 7, 1900 + (i % 125), MY_LONG_STRING + (i % 64));
+}
+
+ZStdDictionary::SP trainDictionary() {
+    std::vector<char> samples;
+    std::vector<size_t> sampleSizes;
+    for (uint32_t i(0); i < 2000; i++) {
+        std::string doc = makeDocument(i);
+        samples.insert(samples.end(), doc.begin(), doc.end());
+        sampleSizes.push_back(doc.size());
+    }
+    return ZStdDictionary::train(samples, sampleSizes, 4096);
+}
+
+size_t packDocument(ChunkFormat & chunk, const std::string & doc, vespalib::DataBuffer & buffer) {
+    chunk.getBuffer().write(doc.data(), doc.size());
+    chunk.pack(7, buffer, CompressionConfig(CompressionConfig::ZSTD));
+    return buffer.getDataLen();
+}
+
+TEST(ChunkTest, require_that_V3_compresses_with_dictionary) {
+    auto dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    std::string doc = makeDocument(4001);
+    ChunkFormatV2 v2(10);
+    vespalib::DataBuffer v2Buffer;
+    size_t v2Len = packDocument(v2, doc, v2Buffer);
+    ChunkFormatV3 v3(10, dictionary);
+    vespalib::DataBuffer v3Buffer;
+    size_t v3Len = packDocument(v3, doc, v3Buffer);
+    EXPECT_LT(v3Len, v2Len);
+    EXPECT_EQ(ChunkFormatV3::VERSION, uint8_t(v3Buffer.getData()[0]));
+
+    ChunkFormat::UP deserialized = ChunkFormat::deserialize(v3Buffer.getData(), v3Buffer.getDataLen(), dictionary);
+    std::string result(doc.size(), '\0');
+    deserialized->getBuffer().read(result.data(), result.size());
+    EXPECT_EQ(doc, result);
+}
+
+TEST(ChunkTest, require_that_V3_requires_matching_dictionary) {
+    auto dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    ChunkFormatV3 v3(10, dictionary);
+    vespalib::DataBuffer buffer;
+    packDocument(v3, makeDocument(4001), buffer);
+    EXPECT_THROW(ChunkFormat::deserialize(buffer.getData(), buffer.getDataLen()), ChunkException);
+}
+
+TEST(ChunkTest, require_that_Chunk_with_dictionary_can_be_read_back) {
+    auto dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    Chunk c(0, Chunk::Config(0x10000, dictionary));
+    std::string doc1 = makeDocument(5001);
+    std::string doc2 = makeDocument(5002);
+    c.append(1, {doc1.data(), doc1.size()});
+    c.append(2, {doc2.data(), doc2.size()});
+    vespalib::DataBuffer buffer;
+    c.pack(7, buffer, CompressionConfig(CompressionConfig::ZSTD));
+    Chunk deserialized(0, buffer.getData(), buffer.getDataLen(), dictionary);
+    EXPECT_EQ(2u, deserialized.count());
+    vespalib::ConstBufferRef buf = deserialized.getLid(2);
+    EXPECT_EQ(doc2, std::string(buf.c_str(), buf.size()));
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
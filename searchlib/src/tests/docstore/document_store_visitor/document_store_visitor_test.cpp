@@ -394,6 +394,24 @@ TEST_F(DocumentStoreVisitorTest, require_that_visit_with_remove_works)
     checkRemovePostCond(numDocs, docIdLimit, rmDocs, true);
 }
 
+TEST_F(DocumentStoreVisitorTest, require_that_parallel_visit_with_remove_works)
+{
+    uint32_t numDocs = 1000;
+    uint32_t docIdLimit = numDocs + 1;
+    populate(1, docIdLimit, docIdLimit);
+    uint32_t rmDocs = 20;
+    applyRemoves(rmDocs);
+    flush();
+    vespalib::ThreadStackExecutor executor(4);
+    MyVisitor visitor(_repo, docIdLimit, true);
+    MyVisitorProgress visitorProgress;
+    _store->accept_parallel(visitor, visitorProgress, _repo, executor, 16, 4);
+    EXPECT_EQ(numDocs - rmDocs + 1, visitor._visitCount);
+    EXPECT_EQ(rmDocs - 1, visitor._visitRmCount);
+    EXPECT_EQ(1.0, visitorProgress.getProgress());
+    EXPECT_TRUE(*_valid == *visitor._valid);
+}
+
 TEST_F(DocumentStoreVisitorTest, require_that_visit_with_rewrite_and_remove_works)
 {
     uint32_t numDocs = 1000;
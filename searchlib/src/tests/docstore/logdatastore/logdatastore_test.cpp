@@ -24,6 +24,7 @@
 #include <charconv>
 #include <filesystem>
 #include <iomanip>
+#include <map>
 #include <random>
 
 using document::BucketId;
@@ -277,7 +278,16 @@ void verifyGrowing(const std::string& dir, const LogDataStore::Config & config,
             datastore.remove(i + 20000, i);
         }
         datastore.flush(datastore.initFlush(lastSyncToken));
+        DataStoreCompactionCost cost = datastore.getApproxCompactionCost(true);
+        EXPECT_LT(0u, cost.bytesToRead);
+        EXPECT_GE(cost.bytesToRead, cost.bytesToWrite);
         datastore.compactBloat(30000);
+        DataStoreCompactionStats compactionStats = datastore.getCompactionStats();
+        EXPECT_LE(1u, compactionStats.compactedFiles());
+        EXPECT_GE(config.getMaxCompactConcurrency(), compactionStats.compactedFiles());
+        EXPECT_LT(0u, compactionStats.bytesRead());
+        EXPECT_GE(compactionStats.bytesRead(), compactionStats.bytesWritten());
+        EXPECT_LT(0u, compactionStats.bloatRemoved());
         datastore.remove(31000, 0);
         checkStats(datastore, 31000, 30000);
         EXPECT_LE(minFiles, datastore.getAllActiveFiles().size());
@@ -311,6 +321,34 @@ TEST_F(LogDataStoreTest, testGrowingChunkedByNumLids)
     verifyGrowing(build_testdata() + "/growing2", config,10, 10);
 }
 
+TEST_F(LogDataStoreTest, testGrowingWithConcurrentThrottledCompaction)
+{
+    LogDataStore::Config config;
+    config.setMaxNumLids(1000).setMaxBucketSpread(3.0).setMinFileSizeFactor(0.2)
+            .setMaxCompactConcurrency(4).setCompactMaxBytesPerSecond(4_Mi)
+            .compactCompression({CompressionConfig::LZ4})
+            .setFileConfig({{CompressionConfig::ZSTD, 9, 60}, 1000});
+    verifyGrowing(build_testdata() + "/growing3", config, 7, 12);
+}
+
+TEST_F(LogDataStoreTest, require_that_compaction_throttle_delays_according_to_rate)
+{
+    CompactionThrottle unlimited(0);
+    EXPECT_EQ(vespalib::duration::zero(), unlimited.acquire(1_Gi));
+
+    CompactionThrottle throttle(100_Mi);
+    // A full bucket lets one second worth of bytes through without waiting.
+    EXPECT_EQ(vespalib::duration::zero(), throttle.acquire(50_Mi));
+    EXPECT_EQ(vespalib::duration::zero(), throttle.acquire(40_Mi));
+    vespalib::duration wait = throttle.acquire(20_Mi);
+    EXPECT_LT(vespalib::duration::zero(), wait);
+    EXPECT_GE(vespalib::from_s(0.1), wait);
+
+    throttle.setMaxBytesPerSecond(0);
+    EXPECT_EQ(0u, throttle.getMaxBytesPerSecond());
+    EXPECT_EQ(vespalib::duration::zero(), throttle.acquire(1_Gi));
+}
+
 void fetchAndTest(IDataStore & datastore, uint32_t lid, const void *a, size_t sz)
 {
     vespalib::DataBuffer buf;
@@ -776,6 +814,36 @@ TEST_F(LogDataStoreTest, test_that_the_integrated_visit_cache_works)
     verifyCacheStats(ds.getCacheStats(), 101, 108, 99, BASE_SZ - 611, "tenth visit");
 }
 
+TEST_F(LogDataStoreTest, test_that_single_reads_are_served_from_cached_visit_sets)
+{
+    VisitCacheStore vcs(DocumentStore::Config::UpdateStrategy::INVALIDATE);
+    IDocumentStore & ds = vcs.getStore();
+    for (size_t i(1); i <= 10; i++) {
+        vcs.write(i);
+    }
+    vcs.verifyVisit({3,4,5}, true);
+    CacheStats cs = ds.getCacheStats();
+    EXPECT_EQ(0u, cs.hits);
+    EXPECT_EQ(1u, cs.misses);
+    EXPECT_EQ(1u, cs.elements);
+    vcs.verifyRead(4);
+    cs = ds.getCacheStats();
+    EXPECT_EQ(1u, cs.hits); // From the visit cache
+    EXPECT_EQ(2u, cs.misses);
+    EXPECT_EQ(2u, cs.elements);
+    vcs.verifyRead(7);
+    cs = ds.getCacheStats();
+    EXPECT_EQ(1u, cs.hits);
+    EXPECT_EQ(3u, cs.misses);
+    EXPECT_EQ(3u, cs.elements);
+    vcs.rewrite(5);
+    vcs.verifyRead(5);
+    cs = ds.getCacheStats();
+    EXPECT_EQ(1u, cs.hits);
+    EXPECT_EQ(4u, cs.misses);
+    EXPECT_EQ(3u, cs.elements);
+}
+
 TEST_F(LogDataStoreTest, testWriteRead)
 {
     auto empty = build_testdata() + "/empty";
@@ -1192,6 +1260,97 @@ TEST_F(LogDataStoreTest, require_that_config_equality_operator_detects_inequalit
     EXPECT_FALSE(C() == C().setMinFileSizeFactor(0.3));
     EXPECT_FALSE(C() == C().setFileConfig(WriteableFileChunk::Config({}, 70)));
     EXPECT_FALSE(C() == C().compactCompression({CompressionConfig::ZSTD}));
+    EXPECT_FALSE(C() == C().setMaxReadConcurrency(4));
+    EXPECT_FALSE(C() == C().setMaxCompactConcurrency(4));
+    EXPECT_FALSE(C() == C().setCompactMaxBytesPerSecond(1_Mi));
+    EXPECT_FALSE(C() == C().setCompressionDictionaryMaxBytes(4_Ki));
+}
+
+class CollectingBufferVisitor : public IBufferVisitor {
+public:
+    std::map<uint32_t, std::string> visited;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buffer) override {
+        EXPECT_TRUE(visited.emplace(lid, std::string(buffer.c_str(), buffer.size())).second);
+    }
+};
+
+TEST_F(LogDataStoreTest, require_that_many_lids_can_be_read_with_concurrent_chunk_reads)
+{
+    auto dirName = build_testdata() + "/concurrent_read";
+    vespalib::ThreadStackExecutor executor(4);
+    search::test::DirectoryHandler dir(dirName);
+    DummyFileHeaderContext fileHeaderContext;
+    MyTlSyncer tlSyncer;
+    LogDataStore::Config config = getBasicConfig(64_Ki).setMaxReadConcurrency(4);
+    config.setFileConfig(WriteableFileChunk::Config({}, 8_Ki));
+    LogDataStore store(executor, dirName, config, GrowStrategy(), TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+    uint64_t serialNum = 0;
+    for (uint32_t lid = 1; lid < 300; ++lid) {
+        std::string data = genData(lid, 1000);
+        store.write(++serialNum, lid, data.c_str(), data.size());
+        if (lid == 200) {
+            store.initFlush(serialNum);
+            store.flush(serialNum);
+        }
+    }
+    EXPECT_LT(1u, store.getFileChunkStats().size());
+    IDataStore::LidVector lids;
+    for (uint32_t lid = 299; lid > 3; lid -= 3) {
+        lids.push_back(lid);
+    }
+    lids.push_back(400); // Beyond docid limit
+    CollectingBufferVisitor visitor;
+    store.read(lids, visitor);
+    EXPECT_EQ(lids.size() - 1, visitor.visited.size());
+    for (uint32_t lid : lids) {
+        if (lid < 300) {
+            EXPECT_EQ(genData(lid, 1000), visitor.visited[lid]);
+        }
+    }
+}
+
+TEST_F(LogDataStoreTest, require_that_frozen_files_are_read_with_mmap_or_pread_depending_on_file_size)
+{
+    auto dirName = build_testdata() + "/mmap_max_file_size";
+    vespalib::ThreadStackExecutor executor(1);
+    search::test::DirectoryHandler dir(dirName);
+    DummyFileHeaderContext fileHeaderContext;
+    MyTlSyncer tlSyncer;
+    LogDataStore::Config config = getBasicConfig(64_Ki).setMaxReadConcurrency(1);
+    config.setFileConfig(WriteableFileChunk::Config({}, 8_Ki));
+    {
+        LogDataStore store(executor, dirName, config, GrowStrategy(), TuneFileSummary(), fileHeaderContext, tlSyncer, nullptr);
+        uint64_t serialNum = 0;
+        for (uint32_t lid = 1; lid < 300; ++lid) {
+            std::string data = genData(lid, 1000);
+            store.write(++serialNum, lid, data.c_str(), data.size());
+            if (lid == 200) {
+                store.initFlush(serialNum);
+                store.flush(serialNum);
+            }
+        }
+        store.initFlush(serialNum);
+        store.flush(serialNum);
+    }
+    IDataStore::LidVector lids;
+    for (uint32_t lid = 1; lid < 300; lid += 7) {
+        lids.push_back(lid);
+    }
+    for (uint64_t maxFileSize : {uint64_t(0), uint64_t(1), uint64_t(1_Gi)}) {
+        TuneFileSummary tune;
+        tune._randRead.setWantMemoryMap();
+        tune._randRead.setMemoryMapMaxFileSize(maxFileSize);
+        EXPECT_EQ(maxFileSize != 1, tune._randRead.getWantMemoryMap(64_Ki));
+        LogDataStore store(executor, dirName, config, GrowStrategy(), tune, fileHeaderContext, tlSyncer, nullptr);
+        EXPECT_LT(1u, store.getFileChunkStats().size());
+        store.prefetch(lids);
+        CollectingBufferVisitor visitor;
+        store.read(lids, visitor);
+        EXPECT_EQ(lids.size(), visitor.visited.size());
+        for (uint32_t lid : lids) {
+            EXPECT_EQ(genData(lid, 1000), visitor.visited[lid]);
+        }
+    }
 }
 
 namespace {
@@ -6,6 +6,7 @@
 #include <vespa/searchlib/engine/searchapi.h>
 #include <vespa/searchlib/engine/docsumapi.h>
 #include <vespa/searchlib/engine/monitorapi.h>
+#include <vespa/searchlib/engine/query_capture.h>
 #include <vespa/fnet/frt/supervisor.h>
 #include <vespa/fnet/frt/target.h>
 #include <vespa/fnet/frt/rpcrequest.h>
@@ -13,6 +14,7 @@
 #include <vespa/vespalib/data/slime/binary_format.h>
 #include <thread>
 #include <chrono>
+#include <filesystem>
 
 using namespace search::engine;
 
@@ -33,6 +35,12 @@ struct MySearchServer : SearchServer {
     SearchReply::UP search(SearchRequest::Source src, SearchClient &client) override {
         auto req = src.release();
         assert(req);
+        if (req->partialReplyClient != nullptr) {
+            auto partial = std::make_unique<SearchReply>();
+            partial->hits.resize(1);
+            partial->hits[0].metric = 1.5;
+            req->partialReplyClient->searchPartial(std::move(partial));
+        }
         auto reply = std::make_unique<SearchReply>();
         reply->totalHitCount = req->offset; // simplified search implementation
         reply->request = std::move(req);
@@ -118,6 +126,61 @@ TEST(DocsumMetricTest, require_that_update_docsum_metrics_works_as_intended) {
     EXPECT_EQ(metrics.docsum().requested_documents.getValue(), 10);
 }
 
+TEST(QueryCaptureTest, require_that_oldest_records_are_overwritten_when_capture_file_is_full) {
+    std::string file_name("query_capture_ring.dat");
+    {
+        // room for 3 records with 10 byte blobs
+        QueryCapture capture(file_name, QueryCapture::header_size + 3 * (QueryCapture::record_header_size + 10) + 5, 1);
+        for (int i = 0; i < 8; ++i) {
+            std::string blob = "blob" + std::to_string(i) + "_____";
+            auto kind = (i % 2 == 0) ? QueryCapture::Kind::SEARCH : QueryCapture::Kind::DOCSUM;
+            capture.add(kind, vespalib::system_time(std::chrono::seconds(i)), 0, blob.size(), blob.data(), blob.size());
+        }
+        EXPECT_EQ(capture.captured(), 8);
+    }
+    auto records = QueryCapture::read(file_name);
+    ASSERT_EQ(records.size(), 3u);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(records[i].blob, "blob" + std::to_string(i + 5) + "_____");
+        EXPECT_EQ(records[i].timestamp_ns, (i + 5) * 1000000000L);
+        EXPECT_EQ(records[i].uncompressed_size, 10u);
+    }
+    EXPECT_EQ(records[0].kind, QueryCapture::Kind::DOCSUM);
+    EXPECT_EQ(records[1].kind, QueryCapture::Kind::SEARCH);
+    std::filesystem::remove(file_name);
+}
+
+TEST_F(ProtoRpcAdapterTest, require_that_sampled_requests_are_captured_and_can_be_replayed) {
+    std::string file_name("query_capture_adapter.dat");
+    adapter.set_query_capture(std::make_unique<QueryCapture>(file_name, 1024 * 1024, 2));
+    adapter.set_online();
+    auto target = connect();
+    for (int offset = 1; offset <= 4; ++offset) {
+        auto *rpc = new FRT_RPCRequest();
+        ProtoSearchRequest req;
+        req.set_offset(offset);
+        ProtoRpcAdapter::encode_search_request(req, *rpc);
+        target->InvokeSync(rpc, 60.0);
+        rpc->internal_subref();
+    }
+    adapter.set_query_capture({});
+    auto records = QueryCapture::read(file_name);
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_LE(records[0].timestamp_ns, records[1].timestamp_ns);
+    for (size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ(records[i].kind, QueryCapture::Kind::SEARCH);
+        auto *rpc = new FRT_RPCRequest();
+        ProtoRpcAdapter::encode_captured_request(records[i], *rpc);
+        target->InvokeSync(rpc, 60.0);
+        ProtoSearchReply reply;
+        EXPECT_TRUE(ProtoRpcAdapter::decode_search_reply(*rpc, reply));
+        EXPECT_EQ(reply.total_hit_count(), 1 + 2 * i);
+        rpc->internal_subref();
+    }
+    target->internal_subref();
+    std::filesystem::remove(file_name);
+}
+
 TEST_F(ProtoRpcAdapterTest, require_that_plain_rpc_ping_works) {
     auto target = connect();
     auto *req = new FRT_RPCRequest();
@@ -156,6 +219,44 @@ TEST_F(ProtoRpcAdapterTest, require_that_proto_rpc_search_works) {
     EXPECT_EQ(metrics.docsum().latency.getCount(), 0);
 }
 
+TEST_F(ProtoRpcAdapterTest, require_that_partial_search_reply_is_superseded_by_final_reply) {
+    adapter.set_online();
+    auto target = connect();
+    auto *rpc = new FRT_RPCRequest();
+    ProtoSearchRequest req;
+    req.set_offset(42);
+    req.set_partial_reply(true);
+    ProtoRpcAdapter::encode_search_request(req, *rpc);
+    target->InvokeSync(rpc, 60.0);
+    ProtoSearchReply partial;
+    ASSERT_TRUE(ProtoRpcAdapter::decode_search_reply(*rpc, partial));
+    EXPECT_TRUE(partial.partial());
+    EXPECT_NE(partial.final_reply_id(), 0u);
+    ASSERT_EQ(partial.hits_size(), 1);
+    EXPECT_EQ(partial.hits(0).relevance(), 1.5);
+    rpc->internal_subref();
+    for (bool first: {true, false}) {
+        rpc = new FRT_RPCRequest();
+        ProtoRpcAdapter::encode_final_search_reply_request(partial.final_reply_id(), *rpc);
+        target->InvokeSync(rpc, 60.0);
+        if (first) {
+            ProtoSearchReply reply;
+            ASSERT_TRUE(ProtoRpcAdapter::decode_search_reply(*rpc, reply));
+            EXPECT_FALSE(reply.partial());
+            EXPECT_EQ(reply.total_hit_count(), 42);
+        } else {
+            EXPECT_EQ(rpc->GetErrorCode(), FRTE_RPC_METHOD_FAILED);
+        }
+        rpc->internal_subref();
+    }
+    target->internal_subref();
+    SearchProtocolMetrics &metrics = adapter.metrics();
+    EXPECT_EQ(metrics.query().latency.getCount(), 1);
+    EXPECT_EQ(metrics.query().partial_reply_requested.getValue(), 1);
+    EXPECT_EQ(metrics.query().partial_replies.getValue(), 1);
+    EXPECT_EQ(metrics.query().final_replies_expired.getValue(), 0);
+}
+
 TEST_F(ProtoRpcAdapterTest, require_that_proto_rpc_getDocsums_works) {
     auto target = connect();
     for (bool online: {false, true, true}) {
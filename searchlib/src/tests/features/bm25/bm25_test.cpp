@@ -452,4 +452,32 @@ TEST_P(Bm25ExecutorTest, multiple_elements_and_terms)
     }
 }
 
+TEST_P(Bm25ExecutorTest, output_is_rebuilt_for_each_document)
+{
+    setup();
+    prepare_term(0, 0, 0, 0);
+    append_term(0, 0, 3, 2, 20);
+    append_term(0, 0, 5, 1, 10);
+    if (!GetParam()._elementwise) {
+        EXPECT_TRUE(execute(score(3, 30, idf(25))));
+    } else {
+        auto spec = spec_from_value(test.resolveObjectFeature().get());
+        TensorSpec exp_spec(GetParam()._tensor_type_spec);
+        exp_spec.add({{"x", "3"}}, score(2, 20, idf(25)));
+        exp_spec.add({{"x", "5"}}, score(1, 10, idf(25)));
+        EXPECT_EQ(exp_spec.normalize(), spec);
+    }
+    uint32_t next_doc_id = 2;
+    prepare_term(0, 0, 0, 0, next_doc_id);
+    append_term(0, 0, 4, 1, 8);
+    if (!GetParam()._elementwise) {
+        EXPECT_TRUE(test.execute(score(1, 8, idf(25)), 0.000001, next_doc_id));
+    } else {
+        auto spec = spec_from_value(test.resolveObjectFeature(next_doc_id).get());
+        TensorSpec exp_spec(GetParam()._tensor_type_spec);
+        exp_spec.add({{"x", "4"}}, score(1, 8, idf(25)));
+        EXPECT_EQ(exp_spec.normalize(), spec);
+    }
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
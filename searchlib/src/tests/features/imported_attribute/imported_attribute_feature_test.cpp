@@ -0,0 +1,74 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/attribute/attribute_read_guard.h>
+#include <vespa/searchlib/features/attributefeature.h>
+#include <vespa/searchlib/test/imported_attribute_fixture.h>
+#include <vespa/searchlib/fef/test/ftlib.h>
+#include <vespa/searchlib/fef/test/rankresult.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <cmath>
+
+using namespace search;
+using namespace search::attribute;
+using namespace search::features;
+using namespace search::fef;
+using namespace search::fef::test;
+using namespace search::index;
+
+struct ImportedAttributeFeatureTest : ::testing::Test, ImportedAttributeFixture {
+    BlueprintFactory _factory;
+    ImportedAttributeFeatureTest() {
+        AttributeBlueprint bp;
+        _factory.addPrototype(bp.createInstance());
+    }
+    ~ImportedAttributeFeatureTest() override;
+
+    feature_t execute(DocId doc_id) {
+        std::string feature_name = "attribute(" + imported_attr->getName() + ")";
+        RankResult result;
+        result.addScore(feature_name, 0.0);
+        FtFeatureTest feature(_factory, result.getKeys());
+        feature.getIndexEnv().getAttributeMap().add(imported_attr->makeReadGuard(false));
+        feature.getIndexEnv().getBuilder().addField(FieldType::ATTRIBUTE, schema::CollectionType::SINGLE,
+                                                    imported_attr->getName());
+        EXPECT_TRUE(feature.setup());
+        RankResult actual;
+        EXPECT_TRUE(feature.executeOnly(actual, doc_id));
+        return actual.getScore(feature_name);
+    }
+};
+
+ImportedAttributeFeatureTest::~ImportedAttributeFeatureTest() = default;
+
+TEST_F(ImportedAttributeFeatureTest, single_value_integer_is_read_from_target_attribute)
+{
+    reset_with_single_value_reference_mappings<IntegerAttribute, int32_t>(
+            BasicType::INT32,
+            {{DocId(1), dummy_gid(3), DocId(3), 1234},
+             {DocId(3), dummy_gid(7), DocId(7), 5678}});
+    EXPECT_EQ(1234.0, execute(1));
+    EXPECT_EQ(5678.0, execute(3));
+    EXPECT_TRUE(std::isnan(execute(2)));
+}
+
+TEST_F(ImportedAttributeFeatureTest, single_value_double_is_read_from_target_attribute)
+{
+    reset_with_single_value_reference_mappings<FloatingPointAttribute, double>(
+            BasicType::DOUBLE,
+            {{DocId(2), dummy_gid(4), DocId(4), 12.5},
+             {DocId(4), dummy_gid(8), DocId(8), -7.25}});
+    EXPECT_EQ(12.5, execute(2));
+    EXPECT_EQ(-7.25, execute(4));
+    EXPECT_TRUE(std::isnan(execute(3)));
+}
+
+TEST_F(ImportedAttributeFeatureTest, lid_beyond_reference_attribute_is_undefined)
+{
+    reset_with_single_value_reference_mappings<IntegerAttribute, int64_t>(
+            BasicType::INT64,
+            {{DocId(1), dummy_gid(3), DocId(3), 42}});
+    EXPECT_EQ(42.0, execute(1));
+    EXPECT_TRUE(std::isnan(execute(1000)));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
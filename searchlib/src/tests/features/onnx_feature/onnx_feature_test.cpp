@@ -138,6 +138,31 @@ TEST_F(OnnxFeatureTest, dynamic_onnx_model_can_be_calculated) {
     EXPECT_EQ(get(3), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, 89.0));
 }
 
+TEST_F(OnnxFeatureTest, dynamic_onnx_model_can_be_calculated_in_batches) {
+    add_expr("query_tensor", "tensor<float>(a[1],b[4]):[[docid,2,3,4]]");
+    add_expr("attribute_tensor", "tensor<float>(a[4],b[1]):[[5],[6],[7],[8]]");
+    add_expr("bias_tensor", "tensor<float>(a[1],b[2]):[[4,5]]");
+    add_onnx(std::move(OnnxModel("dynamic", dynamic_model).max_batch_size(4)));
+    compile(onnx_feature("dynamic"));
+    EXPECT_TRUE(program.supports_prefetch());
+    std::vector<uint32_t> docids({1, 2, 3, 5, 6});
+    program.prefetch(docids);
+    for (uint32_t docid: {1, 2, 3, 5, 6, 7}) {
+        double expect = 79.0 + 5.0 * (docid - 1);
+        EXPECT_EQ(get(docid), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, expect));
+    }
+}
+
+TEST_F(OnnxFeatureTest, models_without_batch_dimension_are_not_prefetched) {
+    add_expr("query_tensor", "tensor<float>(a[1],b[4]):[[docid,2,3,4]]");
+    add_expr("attribute_tensor", "tensor<float>(a[4],b[1]):[[5],[6],[7],[8]]");
+    add_expr("bias_tensor", "tensor<float>(a[1],b[1]):[[9]]");
+    add_onnx(std::move(OnnxModel("simple", simple_model).max_batch_size(4)));
+    compile(onnx_feature("simple"));
+    EXPECT_FALSE(program.supports_prefetch());
+    EXPECT_EQ(get(2), TensorSpec("tensor<float>(d0[1],d1[1])").add({{"d0",0},{"d1",0}}, 84.0));
+}
+
 TEST_F(OnnxFeatureTest, strange_input_and_output_names_are_normalized) {
     add_expr("input_0", "tensor<float>(a[2]):[10,20]");
     add_expr("input_1", "tensor<float>(a[2]):[5,10]");
@@ -47,6 +47,16 @@ Value::UP make_empty(const std::string &type) {
     return SimpleValue::from_spec(TensorSpec(type));
 }
 
+// more subspaces than exposed as a streamed view by SerializedTensorAttributeExecutor
+TensorSpec make_big_spec() {
+    TensorSpec spec("tensor(x{},y[2])");
+    for (size_t i = 0; i < 40; ++i) {
+        spec.add({{"x", std::to_string(i)}, {"y", 0}}, i);
+        spec.add({{"x", std::to_string(i)}, {"y", 1}}, i + 0.5);
+    }
+    return spec;
+}
+
 }
 
 struct ExecFixture
@@ -95,11 +105,13 @@ struct ExecFixture
         attrs.push_back(createTensorAttribute("directattr", "tensor(x{})", true));
         attrs.push_back(createStringAttribute("singlestr"));
         attrs.push_back(createTensorAttribute("wrongtype", "tensor(y{})"));
+        attrs.push_back(createTensorAttribute("bigattr", "tensor(x{},y[2])"));
         addAttributeField("null");
         setAttributeTensorType("tensorattr", "tensor(x{})");
         setAttributeTensorType("directattr", "tensor(x{})");
         setAttributeTensorType("wrongtype", "tensor(x{})");
         setAttributeTensorType("null", "tensor(x{})");
+        setAttributeTensorType("bigattr", "tensor(x{},y[2])");
 
         for (const auto &attr : attrs) {
             attr->addReservedDoc();
@@ -121,6 +133,7 @@ struct ExecFixture
                                                  .add({{"x", "c"}}, 7));
         tensorAttr->setTensor(1, *doc_tensor);
         directAttr->setTensor(1, *doc_tensor);
+        dynamic_cast<TensorAttribute &>(*attrs[4]).setTensor(1, *SimpleValue::from_spec(make_big_spec()));
 
         for (const auto &attr : attrs) {
             attr->commit();
@@ -173,6 +186,13 @@ TEST(TensorTest, require_that_tensor_attribute_can_be_extracted_as_tensor_in_att
               .add({{"x", "a"}}, 3), spec_from_value(f.execute()));
 }
 
+TEST(TensorTest, require_that_tensor_attribute_with_many_subspaces_can_be_extracted_in_attribute_feature)
+{
+    ExecFixture f("attribute(bigattr)");
+    EXPECT_EQ(make_big_spec(), spec_from_value(f.execute()));
+    EXPECT_EQ(*make_empty("tensor(x{},y[2])"), f.execute(2));
+}
+
 TEST(TensorTest, require_that_direct_tensor_attribute_can_be_extracted_in_attribute_feature)
 {
     ExecFixture f("attribute(directattr)");
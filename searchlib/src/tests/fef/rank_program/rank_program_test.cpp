@@ -10,6 +10,7 @@
 #include <vespa/searchlib/fef/test/plugin/sum.h>
 #include <vespa/searchlib/fef/test/plugin/double.h>
 #include <vespa/searchlib/fef/rank_program.h>
+#include <vespa/searchlib/fef/rank_program_shape_cache.h>
 #include <vespa/searchlib/test/test_features.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/execution_profiler.h>
@@ -19,6 +20,7 @@
 using namespace search::fef;
 using namespace search::fef::test;
 using namespace search::features;
+using search::feature_t;
 using vespalib::ExecutionProfiler;
 using vespalib::Slime;
 
@@ -241,6 +243,44 @@ TEST(RankProgramTest, rank_program_can_calculate_scores_for_multiple_documents)
     EXPECT_EQ(f1.get(1), 11.0);
 }
 
+TEST(RankProgramTest, compiled_expressions_can_be_calculated_for_batches_of_documents)
+{
+    Fixture f1;
+    f1.lazy_expressions(false).add_expr("foo", "value(10) + 2 * docid").compile();
+    ASSERT_TRUE(f1.program.supports_batch());
+    std::vector<uint32_t> docids({3, 5, 8, 13});
+    std::vector<feature_t> scores(docids.size(), 0.0);
+    f1.program.execute_batch(docids, scores);
+    for (size_t i = 0; i < docids.size(); ++i) {
+        EXPECT_EQ(scores[i], f1.get(docids[i]));
+        EXPECT_EQ(scores[i], 10.0 + 2 * docids[i]);
+    }
+}
+
+TEST(RankProgramTest, const_programs_can_be_calculated_for_batches_of_documents)
+{
+    Fixture f1;
+    f1.add_expr("foo", "value(10) + 2").compile();
+    ASSERT_TRUE(f1.program.supports_batch());
+    std::vector<uint32_t> docids({1, 2});
+    std::vector<feature_t> scores(docids.size(), 0.0);
+    f1.program.execute_batch(docids, scores);
+    EXPECT_EQ(scores, std::vector<feature_t>({12.0, 12.0}));
+}
+
+TEST(RankProgramTest, batch_execution_is_not_supported_when_some_executor_does_not_support_it)
+{
+    Fixture f1;
+    f1.add("mysum(value(10),docid)").compile();
+    EXPECT_FALSE(f1.program.supports_batch());
+    Fixture f2;
+    f2.lazy_expressions(false).add_expr("foo", "value(10) + 2 * docid").override("docid", 5.0).compile();
+    EXPECT_FALSE(f2.program.supports_batch());
+    Fixture f3;
+    f3.add("docid").add("value(1)").compile();
+    EXPECT_FALSE(f3.program.supports_batch());
+}
+
 TEST(RankProgramTest, only_non_const_features_are_calculated_per_document)
 {
     Fixture f1;
@@ -477,4 +517,44 @@ TEST(RankProgramTest, rank_program_can_be_profiled)
     EXPECT_EQ((*b)["count"].asLong(), 1);
 }
 
+TEST(RankProgramTest, const_executors_are_remembered_per_query_shape)
+{
+    Fixture f1;
+    f1.add("mysum(value(10),ivalue(5))").add("mysum(value(1),value(2))");
+    ASSERT_TRUE(f1.resolver->compile());
+    RankProgramShapeCache shapes;
+    MatchDataLayout mdl;
+    QueryEnvironment queryEnv(&f1.indexEnv);
+    auto md = mdl.createMatchData();
+    auto setup_and_check = [&](const Properties &overrides, double expect) {
+        RankProgram program(f1.resolver, nullptr, &shapes);
+        program.setup(*md, queryEnv, overrides);
+        EXPECT_EQ(6u, program.num_executors());
+        EXPECT_EQ(4u, count_const_features(program));
+        auto seeds = program.get_seeds();
+        ASSERT_EQ(2u, seeds.num_features());
+        for (size_t i = 0; i < seeds.num_features(); ++i) {
+            double value = seeds.resolve(i).as_number(default_docid);
+            EXPECT_EQ((seeds.name_of(i) == "mysum(value(1),value(2))") ? 3.0 : expect, value);
+        }
+    };
+    setup_and_check(Properties(), 15.0);
+    EXPECT_EQ(1u, shapes.size());
+    EXPECT_EQ(0u, shapes.hits());
+    setup_and_check(Properties(), 15.0);
+    EXPECT_EQ(1u, shapes.size());
+    EXPECT_EQ(1u, shapes.hits());
+    Properties overrides;
+    overrides.add("ivalue(5)", "7");
+    setup_and_check(overrides, 17.0);
+    EXPECT_EQ(2u, shapes.size());
+    EXPECT_EQ(1u, shapes.hits());
+    EXPECT_EQ(2u, shapes.misses());
+    overrides.clear();
+    overrides.add("ivalue(5)", "8");
+    setup_and_check(overrides, 18.0);
+    EXPECT_EQ(2u, shapes.size());
+    EXPECT_EQ(2u, shapes.hits());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
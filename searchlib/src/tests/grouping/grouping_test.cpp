@@ -2,6 +2,7 @@
 
 #include <vespa/searchlib/aggregation/perdocexpression.h>
 #include <vespa/searchlib/aggregation/aggregation.h>
+#include <vespa/searchlib/aggregation/columnar_grouping.h>
 #include <vespa/searchlib/attribute/extendableattributes.h>
 #include <vespa/searchlib/attribute/attributemanager.h>
 #include <vespa/searchlib/aggregation/hitsaggregationresult.h>
@@ -1860,6 +1861,91 @@ TEST(GroupingTest, test_that_attributes_can_be_unconditionally_converted_to_docu
     EXPECT_TRUE(attrRequest.getRoot().getAggregationResult(0).getExpression()->inherits(DocumentFieldNode::classId));
 }
 
+TEST(GroupingTest, columnar_aggregation_matches_per_hit_aggregation)
+{
+    AggregationContext ctx;
+    IntAttrBuilder key("key");
+    IntAttrBuilder val("val");
+    for (uint32_t docid = 0; docid < 1000; ++docid) {
+        key.add(docid % 37);
+        val.add((docid * 7919) % 1009 - 500);
+        ctx.result().add(docid, (docid * 31) % 101);
+    }
+    ctx.add(key.sp());
+    ctx.add(val.sp());
+
+    GroupingLevel level;
+    level.setExpression(MU<AttributeNode>("key"))
+        .addResult(CountAggregationResult().setExpression(MU<ConstantNode>(MU<Int64ResultNode>(0))))
+        .addResult(SumAggregationResult().setExpression(MU<AttributeNode>("val")))
+        .addResult(MinAggregationResult().setExpression(MU<AttributeNode>("val")))
+        .addResult(MaxAggregationResult().setExpression(MU<AttributeNode>("val")));
+    Grouping request = Grouping().setLastLevel(1).addLevel(std::move(level));
+
+    Grouping columnar = request;
+    ctx.setup(columnar);
+    columnar.preAggregate(false);
+    EXPECT_TRUE(ColumnarGrouping::try_create(columnar));
+    columnar.postProcess();
+    columnar.aggregate(ctx.result().hits(), ctx.result().size());
+
+    Grouping perHit = request;
+    ctx.setup(perHit);
+    perHit.preAggregate(true);
+    for (uint32_t i = 0; i < ctx.result().size(); ++i) {
+        perHit.aggregate(ctx.result().hits()[i].getDocId(), ctx.result().hits()[i].getRank());
+    }
+    perHit.postProcess();
+
+    EXPECT_EQ(37u, columnar.getRoot().getChildrenSize());
+    EXPECT_EQ(perHit.getRoot().asString(), columnar.getRoot().asString());
+
+    Grouping capped = request;
+    capped.levels()[0].setMaxGroups(5);
+    ctx.setup(capped);
+    capped.aggregate(ctx.result().hits(), ctx.result().size());
+    EXPECT_EQ(5u, capped.getRoot().getChildrenSize());
+}
+
+TEST(GroupingTest, arena_allocated_groups_outlive_the_merged_grouping)
+{
+    AggregationContext ctx;
+    IntAttrBuilder key("key");
+    for (uint32_t docid = 0; docid < 100; ++docid) {
+        key.add(docid % 10);
+        ctx.result().add(docid);
+    }
+    ctx.add(key.sp());
+
+    GroupingLevel level;
+    level.setExpression(MU<AttributeNode>("key"))
+        .addResult(CountAggregationResult().setExpression(MU<ConstantNode>(MU<Int64ResultNode>(0))));
+    Grouping request = Grouping().setLastLevel(1).addLevel(std::move(level));
+
+    Grouping expect = request;
+    ctx.setup(expect);
+    expect.aggregate(0u, 100u);
+    EXPECT_EQ(10u, expect.getRoot().getChildrenSize());
+
+    Grouping target = request;
+    ctx.setup(target);
+    target.aggregate(0u, 50u);
+    EXPECT_LT(0u, target.arena().allocated_bytes());
+    {
+        auto source = std::make_unique<Grouping>(request);
+        ctx.setup(*source);
+        source->aggregate(50u, 100u);
+        target.merge(*source);
+    }
+    target.postMerge();
+    target.sortById();
+    EXPECT_EQ(expect.getRoot().asString(), target.getRoot().asString());
+
+    Grouping copy = target;
+    target = Grouping();
+    EXPECT_EQ(expect.getRoot().asString(), copy.getRoot().asString());
+}
+
 TEST(GroupingTest, test_bad_grouping)
 {
     Grouping baseRequest;
@@ -660,4 +660,94 @@ TEST(HitCollectorTest, require_that_bitvector_is_dropped_with_second_phase_rank_
                    {}, {14,15,16});
 }
 
+TEST(HitCollectorTest, require_that_score_threshold_is_lowest_kept_score_when_heap_is_full)
+{
+    HitCollector hc(20, 3);
+    EXPECT_FALSE(hc.get_score_threshold().has_value());
+    hc.addHit(1, 5.0);
+    hc.addHit(2, 2.0);
+    hc.addHit(3, 7.0);
+    EXPECT_FALSE(hc.get_score_threshold().has_value());
+    hc.addHit(4, 3.0);
+    EXPECT_EQ(3.0, hc.get_score_threshold().value());
+    hc.addHit(5, 1.0);
+    EXPECT_EQ(3.0, hc.get_score_threshold().value());
+    hc.addHit(6, 6.0);
+    EXPECT_EQ(5.0, hc.get_score_threshold().value());
+}
+
+TEST(HitCollectorTest, require_that_no_score_threshold_is_reported_without_ranked_hits)
+{
+    HitCollector hc(20, 0);
+    hc.addHit(1, 5.0);
+    hc.addHit(2, 2.0);
+    EXPECT_FALSE(hc.get_score_threshold().has_value());
+}
+
+// the original heap based selection of the best hits
+std::vector<HitCollector::Hit> select_best_hits_using_heap(const std::vector<HitCollector::Hit> &hits, size_t max_hits) {
+    auto worse = [](const HitCollector::Hit &a, const HitCollector::Hit &b) {
+        return (a.second == b.second) ? (a.first > b.first) : (a.second < b.second);
+    };
+    std::vector<HitCollector::Hit> best;
+    for (const auto &hit : hits) {
+        if (best.size() < max_hits) {
+            best.push_back(hit);
+        } else {
+            auto worst = std::min_element(best.begin(), best.end(), worse);
+            if (hit.second > worst->second) {
+                *worst = hit;
+            }
+        }
+    }
+    std::sort(best.begin(), best.end(), [&worse](const auto &a, const auto &b) { return worse(b, a); });
+    return best;
+}
+
+void check_buffered_hits(const std::vector<HitCollector::Hit> &hits, uint32_t max_hits) {
+    HitCollector hc(10000, max_hits);
+    feature_t last_threshold = -1.0;
+    for (const auto &hit : hits) {
+        hc.addHit(hit.first, hit.second);
+        auto threshold = hc.get_score_threshold();
+        if (threshold.has_value()) {
+            EXPECT_LE(last_threshold, threshold.value());
+            last_threshold = threshold.value();
+        }
+    }
+    auto expect = select_best_hits_using_heap(hits, max_hits);
+    EXPECT_LE(last_threshold, expect.back().second);
+    EXPECT_EQ(expect, extract(hc.getSortedHitSequence(max_hits)));
+    EXPECT_EQ(expect.back().second, hc.get_score_threshold().value());
+    std::sort(expect.begin(), expect.end());
+    auto rs = hc.getResultSet();
+    ASSERT_EQ(expect.size(), rs->getArrayUsed());
+    for (size_t i = 0; i < expect.size(); ++i) {
+        EXPECT_EQ(expect[i].first, rs->getArray()[i].getDocId());
+        EXPECT_EQ(expect[i].second, rs->getArray()[i].getRank());
+    }
+}
+
+TEST(HitCollectorTest, require_that_buffered_hits_give_same_result_as_heap)
+{
+    std::vector<HitCollector::Hit> hits;
+    for (uint32_t docid = 0; docid < 5000; ++docid) {
+        hits.emplace_back(docid, (docid * 7919) % 13); // lots of score ties
+    }
+    check_buffered_hits(hits, 200);
+    check_buffered_hits(hits, 1000);
+}
+
+TEST(HitCollectorTest, require_that_buffered_hits_give_same_result_as_heap_when_hits_are_added_out_of_order)
+{
+    std::vector<HitCollector::Hit> hits;
+    for (uint32_t docid = 1000; docid < 5000; ++docid) {
+        hits.emplace_back(docid, (docid * 7919) % 13);
+    }
+    for (uint32_t docid = 1000; docid-- > 0; ) {
+        hits.emplace_back(docid, (docid * 7919) % 13);
+    }
+    check_buffered_hits(hits, 200);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -118,16 +118,21 @@ struct DocumentInverterTest : public ::testing::Test {
     DocumentInverter                _inv;
 
     DocumentInverterTest()
+        : DocumentInverterTest(1, 1)
+    {
+    }
+
+    DocumentInverterTest(uint32_t num_invert_threads, uint32_t num_field_shards)
         : _b(make_add_fields()),
           _schema(SchemaBuilder(_b).add_all_indexes().build()),
-          _invertThreads(SequencedTaskExecutor::create(invert_executor, 1)),
+          _invertThreads(SequencedTaskExecutor::create(invert_executor, num_invert_threads)),
           _pushThreads(SequencedTaskExecutor::create(push_executor, 1)),
           _word_store(),
           _remover(_word_store),
           _inserter_backend(),
           _calculator(),
           _fic(_remover, _inserter_backend, _calculator),
-          _inv_context(_schema, *_invertThreads, *_pushThreads, _fic),
+          _inv_context(_schema, *_invertThreads, *_pushThreads, _fic, num_field_shards),
           _inv(_inv_context)
     {
     }
@@ -139,6 +144,13 @@ struct DocumentInverterTest : public ::testing::Test {
     }
 };
 
+struct ShardedDocumentInverterTest : public DocumentInverterTest {
+    ShardedDocumentInverterTest()
+        : DocumentInverterTest(4, 3)
+    {
+    }
+};
+
 TEST_F(DocumentInverterTest, require_that_fresh_insert_works)
 {
     auto doc10 = makeDoc10(_b);
@@ -282,6 +294,73 @@ TEST_F(DocumentInverterTest, require_that_empty_document_can_be_inverted)
               _inserter_backend.toStr());
 }
 
+TEST_F(ShardedDocumentInverterTest, require_that_shards_are_merged_when_pushing)
+{
+    EXPECT_EQ(3u, _inv_context.get_num_field_shards());
+    auto doc10 = makeDoc10(_b);
+    auto doc11 = makeDoc11(_b);
+    auto doc12 = makeDoc12(_b);
+    auto doc13 = makeDoc13(_b);
+    auto doc14 = makeDoc14(_b);
+    _inv.invertDocument(10, *doc10, {});
+    _inv.invertDocument(11, *doc11, {});
+    _inv.invertDocument(12, *doc12, {});
+    _inv.invertDocument(13, *doc13, {});
+    _inv.invertDocument(14, *doc14, {});
+    pushDocuments();
+    EXPECT_EQ("f=0,w=a,a=10,a=11,"
+              "w=b,a=10,a=11,"
+              "w=c,a=10,"
+              "w=d,a=10,"
+              "w=doc12,a=12,"
+              "w=doc13,a=13,"
+              "w=doc14,a=14,"
+              "w=e,a=11,"
+              "w=f,a=11,"
+              "w=h,a=12,"
+              "w=i,a=13,"
+              "w=j,a=14,"
+              "f=1,w=a,a=11,"
+              "w=g,a=11",
+              _inserter_backend.toStr());
+    EXPECT_EQ(5u, _calculator.get_num_samples());
+}
+
+TEST_F(ShardedDocumentInverterTest, require_that_removes_and_reputs_are_handled_by_owning_shard)
+{
+    auto doc10 = makeDoc10(_b);
+    auto doc11 = makeDoc11(_b);
+    auto doc12 = makeDoc12(_b);
+    _inv.invertDocument(10, *doc10, {});
+    _inv.invertDocument(11, *doc11, {});
+    _inv.invertDocument(12, *doc12, {});
+    _inv.removeDocument(11);
+    _inv.invertDocument(12, *doc10, {});
+    pushDocuments();
+    EXPECT_EQ("f=0,w=a,a=10,a=12,"
+              "w=b,a=10,a=12,"
+              "w=c,a=10,a=12,"
+              "w=d,a=10,a=12",
+              _inserter_backend.toStr());
+}
+
+TEST_F(ShardedDocumentInverterTest, require_that_mix_of_add_and_remove_works)
+{
+    _inv.get_shard_inverters(_inv_context.get_field_shard(11))[0]->remove("a", 11);
+    _inv.get_shard_inverters(_inv_context.get_field_shard(9))[0]->remove("c", 9);
+    _inv.get_shard_inverters(_inv_context.get_field_shard(10))[0]->remove("d", 10);
+    _inv.get_shard_inverters(_inv_context.get_field_shard(12))[0]->remove("z", 12);
+    auto doc10 = makeDoc10(_b);
+    _inv.invertDocument(10, *doc10, {});
+    pushDocuments();
+    EXPECT_EQ("f=0,w=a,a=10,r=11,"
+              "w=b,a=10,"
+              "w=c,r=9,a=10,"
+              "w=d,r=10,a=10,"
+              "w=z,r=12",
+              _inserter_backend.toStr());
+}
+
 }
 
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -28,6 +28,7 @@
 #include <vespa/vespalib/util/gate.h>
 #include <vespa/vespalib/util/destructor_callbacks.h>
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <unordered_set>
 
 #include <vespa/vespalib/gtest/gtest.h>
@@ -154,6 +155,39 @@ MyBuilder::MyBuilder(const Schema &schema)
 {}
 MyBuilder::~MyBuilder() = default;
 
+/*
+ * Index builder where fields can be built in parallel, each field is built
+ * by a separate MyBuilder.
+ */
+class PerFieldBuilder : public IndexBuilder {
+    std::vector<std::unique_ptr<MyBuilder>> _builders;
+public:
+    explicit PerFieldBuilder(const Schema &schema)
+        : IndexBuilder(schema),
+          _builders()
+    {
+        for (uint32_t i = 0; i < schema.getNumIndexFields(); ++i) {
+            _builders.push_back(std::make_unique<MyBuilder>(schema));
+        }
+    }
+    ~PerFieldBuilder() override;
+    std::unique_ptr<index::FieldIndexBuilder> startField(uint32_t fieldId) override {
+        return _builders[fieldId]->startField(fieldId);
+    }
+    std::string toStr() const {
+        std::string result;
+        for (auto& builder : _builders) {
+            if (!result.empty()) {
+                result += ",";
+            }
+            result += builder->toStr();
+        }
+        return result;
+    }
+};
+
+PerFieldBuilder::~PerFieldBuilder() = default;
+
 struct SimpleMatchData {
     TermFieldMatchData term;
     TermFieldMatchDataArray array;
@@ -873,6 +907,23 @@ TEST_F(FieldIndexCollectionTest, require_that_dumping_of_multiple_fields_to_inde
               b.toStr());
 }
 
+TEST_F(FieldIndexCollectionTest, require_that_fields_can_be_dumped_in_parallel)
+{
+    WrapInserter(fic, 0).word("a").add(3, getFeatures(2, 1)).flush();
+    WrapInserter(fic, 1).word("a").add(5, getFeatures(2, 1)).
+            word("b").add(5, getFeatures(12, 2)).flush();
+    WrapInserter(fic, 3).word("c").add(7, getFeatures(3, 2)).flush();
+    MyBuilder expected(schema);
+    fic.dump(expected);
+    vespalib::ThreadStackExecutor executor(3);
+    for (uint32_t max_threads : {1u, 2u, 4u, 8u}) {
+        SCOPED_TRACE(max_threads);
+        PerFieldBuilder b(schema);
+        fic.dump(b, executor, max_threads);
+        EXPECT_EQ(expected.toStr(), b.toStr());
+    }
+}
+
 TEST_F(FieldIndexCollectionTest, require_that_dumping_words_with_no_docs_to_index_builder_is_working)
 {
     WrapInserter(fic, 0).word("a").add(2, getFeatures(2, 1)).
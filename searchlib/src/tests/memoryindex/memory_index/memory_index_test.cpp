@@ -480,8 +480,8 @@ FieldIndexStats get_field_stats(const IndexStats &stats, const std::string& fiel
 }
 TEST(MemoryIndexTest, require_that_we_understand_the_memory_footprint)
 {
-    constexpr size_t BASE_ALLOCATED = 360936u;
-    constexpr size_t BASE_USED = 150676u;
+    constexpr size_t BASE_ALLOCATED = 342504u;
+    constexpr size_t BASE_USED = 132241u;
     {
         MySetup setup;
         Index index(setup);
@@ -507,6 +507,22 @@ TEST(MemoryIndexTest, require_that_we_understand_the_memory_footprint)
     }
 }
 
+TEST(MemoryIndexTest, require_that_feature_compression_is_reported)
+{
+    Index index(MySetup().field(title).field(body));
+    auto stats = get_field_stats(index.index.get_stats(), title);
+    EXPECT_EQ(0u, stats.raw_feature_bytes());
+    EXPECT_EQ(0u, stats.stored_feature_bytes());
+    EXPECT_EQ(0.0, stats.feature_compression_ratio());
+    index.doc(1).field(title).add(foo).add(bar).add(foo).commit();
+    index.doc(2).field(title).add(foo).commit();
+    stats = get_field_stats(index.index.get_stats(), title);
+    EXPECT_LT(0u, stats.stored_feature_bytes());
+    EXPECT_LT(stats.stored_feature_bytes(), stats.raw_feature_bytes());
+    EXPECT_LT(1.0, stats.feature_compression_ratio());
+    EXPECT_EQ(0u, get_field_stats(index.index.get_stats(), body).stored_feature_bytes());
+}
+
 TEST(MemoryIndexTest, require_that_num_words_is_returned)
 {
     Index index(MySetup().field(title));
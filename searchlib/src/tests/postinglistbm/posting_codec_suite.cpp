@@ -0,0 +1,375 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcommon/attribute/config.h>
+#include <vespa/searchcommon/attribute/search_context_params.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/ipostinglistattributebase.h>
+#include <vespa/searchlib/attribute/search_context.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
+#include <vespa/searchlib/query/query_term_simple.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchlib/test/fakedata/fakeposting.h>
+#include <vespa/searchlib/test/fakedata/fakeword.h>
+#include <vespa/searchlib/test/fakedata/fakewordset.h>
+#include <vespa/searchlib/test/fakedata/fpfactory.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/util/rand48.h>
+#include <vespa/vespalib/util/signalhandler.h>
+#include <vespa/vespalib/util/time.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <unistd.h>
+
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::BitVector;
+using search::BitVectorIterator;
+using search::IntegerAttribute;
+using search::QueryTermSimple;
+using search::fef::TermFieldMatchData;
+using search::fef::TermFieldMatchDataArray;
+using search::queryeval::SearchIterator;
+using vespalib::slime::Cursor;
+
+using namespace search::fakedata;
+
+/**
+ * Benchmark suite comparing the posting list codecs used for disk index
+ * posting lists, memory index posting lists, bitvectors and attribute
+ * posting lists on the same synthetic posting lists.
+ *
+ * For each codec and document frequency the suite reports the size per
+ * posting, the decode throughput when iterating over all postings, and
+ * the time per seek when skipping to target documents at various
+ * selectivities (simulating a strict posting list driven by a rarer
+ * term). The results are printed as JSON on stdout, to be compared
+ * against a baseline from another version.
+ *
+ * usage: searchlib_posting_codec_suite_app [-d numDocs] [-b budgetSec] [-c codecFilter] [-f docFreqRatio]...
+ */
+
+namespace postinglistbm {
+
+namespace {
+
+constexpr uint32_t format_version = 1;
+constexpr uint32_t word_seed = 42;
+constexpr uint32_t seek_seed = 4242;
+
+const std::vector<double> default_doc_freq_ratios = {0.0001, 0.001, 0.01, 0.1, 0.5};
+const std::vector<double> seek_ratios = {0.0001, 0.001, 0.01, 0.1};
+
+struct SuiteParams {
+    uint32_t num_docs;
+    double budget_sec;
+    std::string codec_filter;
+    std::vector<double> doc_freq_ratios;
+    SuiteParams() : num_docs(10'000'000), budget_sec(0.5), codec_filter(), doc_freq_ratios() {}
+};
+
+/**
+ * A posting list encoded with one codec, able to create strict
+ * iterators over its postings.
+ */
+class EncodedPostings {
+public:
+    virtual ~EncodedPostings() = default;
+    virtual std::unique_ptr<SearchIterator> create_iterator(TermFieldMatchData &tfmd, TermFieldMatchDataArray &tfmda) = 0;
+    virtual double bits() const = 0;
+    virtual double skip_bits() const { return 0.0; }
+};
+
+class FakePostingEncoded : public EncodedPostings {
+    FakePosting::SP _posting;
+public:
+    explicit FakePostingEncoded(FakePosting::SP posting) : _posting(std::move(posting)) {}
+    std::unique_ptr<SearchIterator> create_iterator(TermFieldMatchData &tfmd, TermFieldMatchDataArray &tfmda) override {
+        tfmd.setNeedNormalFeatures(_posting->enable_unpack_normal_features());
+        tfmd.setNeedInterleavedFeatures(_posting->enable_unpack_interleaved_features());
+        return _posting->createIterator(tfmda);
+    }
+    double bits() const override { return _posting->bitSize(); }
+    double skip_bits() const override { return _posting->skipBitSize(); }
+};
+
+class BitVectorEncoded : public EncodedPostings {
+    std::unique_ptr<BitVector> _bv;
+public:
+    explicit BitVectorEncoded(const FakeWord &word)
+        : _bv(BitVector::create(word._docIdLimit))
+    {
+        for (const auto &posting : word._postings) {
+            _bv->setBit(posting._docId);
+        }
+        _bv->invalidateCachedCount();
+    }
+    std::unique_ptr<SearchIterator> create_iterator(TermFieldMatchData &tfmd, TermFieldMatchDataArray &) override {
+        return BitVectorIterator::create(_bv.get(), _bv->size(), tfmd, true);
+    }
+    double bits() const override { return _bv->size(); }
+};
+
+/**
+ * Posting list in a fast-search int32 array attribute, where all documents
+ * in the posting list contain the value 1. Filter attributes use compressed
+ * posting lists or bitvectors, other attributes use btrees (possibly
+ * combined with bitvectors for common values).
+ */
+class AttributeEncoded : public EncodedPostings {
+    AttributeVector::SP                                _attr;
+    std::unique_ptr<search::attribute::SearchContext> _search_context;
+public:
+    AttributeEncoded(const FakeWord &word, bool filter)
+        : _attr(),
+          _search_context()
+    {
+        search::attribute::Config cfg(search::attribute::BasicType::INT32, search::attribute::CollectionType::ARRAY);
+        cfg.setFastSearch(true);
+        cfg.setIsFilter(filter);
+        _attr = AttributeFactory::createAttribute("attr", cfg);
+        _attr->addDocs(word._docIdLimit);
+        auto &int_attr = dynamic_cast<IntegerAttribute &>(*_attr);
+        for (const auto &posting : word._postings) {
+            int_attr.append(posting._docId, 1, 1);
+        }
+        _attr->commit(true);
+        _search_context = _attr->getSearch(std::make_unique<QueryTermSimple>("1", search::TermType::WORD),
+                                           search::attribute::SearchContextParams());
+        _search_context->fetchPostings(search::queryeval::ExecuteInfo::FULL, true);
+    }
+    std::unique_ptr<SearchIterator> create_iterator(TermFieldMatchData &tfmd, TermFieldMatchDataArray &) override {
+        return _search_context->createIterator(&tfmd, true);
+    }
+    double bits() const override {
+        return _attr->getIPostingListAttributeBase()->getMemoryUsage().total.usedBytes() * 8.0;
+    }
+};
+
+struct Codec {
+    std::string name;
+    std::function<std::unique_ptr<EncodedPostings>(const FakeWordSet &, const FakeWord &)> encode;
+};
+
+std::function<std::unique_ptr<EncodedPostings>(const FakeWordSet &, const FakeWord &)>
+fake_posting_codec(const std::string &posting_type)
+{
+    return [posting_type](const FakeWordSet &word_set, const FakeWord &word) -> std::unique_ptr<EncodedPostings> {
+        std::unique_ptr<FPFactory> factory(getFPFactory(posting_type, word_set.getSchema()));
+        if (!factory) {
+            return {};
+        }
+        factory->setup(word_set);
+        return std::make_unique<FakePostingEncoded>(factory->make(word));
+    };
+}
+
+// Note: Only append new codecs, and never change existing ones, as the codec names are used
+//       to match results between versions.
+const std::vector<Codec> codecs = {
+    {"zc4_skip",              fake_posting_codec("Zc4SkipPosOccBE.cf")},
+    {"zc4_noskip",            fake_posting_codec("Zc4NoSkipPosOccBE.cf")},
+    {"zc4_skip_dynamic_k",    fake_posting_codec("ZcSkipPosOccBE")},
+    {"zc5_noskip",            fake_posting_codec("Zc5NoSkipPosOccBE.cf")},
+    {"zc4_skip_block_docids", fake_posting_codec("Zc4SkipPosOccBE.cf.bd")},
+    {"zc_skip_filter",        fake_posting_codec("ZcSkipFilterOcc")},
+    {"memory_index_btree",    fake_posting_codec("MemTreeOcc")},
+    {"bitvector",             [](const FakeWordSet &, const FakeWord &word) { return std::make_unique<BitVectorEncoded>(word); }},
+    {"attribute_btree",       [](const FakeWordSet &, const FakeWord &word) { return std::make_unique<AttributeEncoded>(word, false); }},
+    {"attribute_filter",      [](const FakeWordSet &, const FakeWord &word) { return std::make_unique<AttributeEncoded>(word, true); }}
+};
+
+/**
+ * Runs the given function until the time budget is used (at least once)
+ * and returns the fastest run in nanoseconds.
+ */
+template <typename F>
+double
+best_run_ns(double budget_sec, F &&run)
+{
+    double best = std::numeric_limits<double>::max();
+    vespalib::Timer total;
+    do {
+        vespalib::Timer timer;
+        run();
+        best = std::min(best, double(vespalib::count_ns(timer.elapsed())));
+    } while (vespalib::to_s(total.elapsed()) < budget_sec);
+    return best;
+}
+
+void
+run_decode(EncodedPostings &encoded, const FakeWord &word, double budget_sec, Cursor &obj)
+{
+    TermFieldMatchData tfmd;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&tfmd);
+    uint32_t hits = 0;
+    double ns = best_run_ns(budget_sec, [&]() {
+        auto it = encoded.create_iterator(tfmd, tfmda);
+        it->initRange(1, word._docIdLimit);
+        hits = 0;
+        for (uint32_t docid = it->seekFirst(1); !it->isAtEnd(); docid = it->seekNext(docid + 1)) {
+            ++hits;
+        }
+    });
+    if (hits != word._postings.size()) {
+        std::cerr << "decoded " << hits << " postings, expected " << word._postings.size() << std::endl;
+        abort();
+    }
+    obj.setDouble("ns_per_posting", ns / std::max(hits, 1u));
+    obj.setDouble("mpostings_per_sec", (ns > 0.0) ? (hits * 1000.0 / ns) : 0.0);
+}
+
+std::vector<uint32_t>
+make_seek_targets(uint32_t doc_id_limit, double seek_ratio)
+{
+    vespalib::Rand48 rnd;
+    rnd.srand48(seek_seed);
+    std::vector<uint32_t> targets;
+    uint32_t num_targets = std::max(1u, uint32_t(doc_id_limit * seek_ratio));
+    targets.reserve(num_targets);
+    for (uint32_t i = 0; i < num_targets; ++i) {
+        targets.push_back(1 + rnd.lrand48() % (doc_id_limit - 1));
+    }
+    std::sort(targets.begin(), targets.end());
+    targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+    return targets;
+}
+
+void
+run_skip_to(EncodedPostings &encoded, const FakeWord &word, double seek_ratio, double budget_sec, Cursor &obj)
+{
+    auto targets = make_seek_targets(word._docIdLimit, seek_ratio);
+    TermFieldMatchData tfmd;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&tfmd);
+    uint32_t hits = 0;
+    double ns = best_run_ns(budget_sec, [&]() {
+        auto it = encoded.create_iterator(tfmd, tfmda);
+        it->initRange(1, word._docIdLimit);
+        hits = 0;
+        for (uint32_t target : targets) {
+            if (it->seek(target)) {
+                ++hits;
+            }
+            if (it->isAtEnd()) {
+                break;
+            }
+        }
+    });
+    obj.setDouble("seek_ratio", seek_ratio);
+    obj.setLong("seeks", targets.size());
+    obj.setLong("hits", hits);
+    obj.setDouble("ns_per_seek", ns / targets.size());
+}
+
+void
+run_case(Cursor &cases, const Codec &codec, const FakeWordSet &word_set, const FakeWord &word,
+         double doc_freq_ratio, const SuiteParams &params)
+{
+    std::cerr << "running codec " << codec.name << " with doc freq ratio " << doc_freq_ratio << std::endl;
+    auto encoded = codec.encode(word_set, word);
+    if (!encoded) {
+        std::cerr << "codec " << codec.name << " is not available" << std::endl;
+        return;
+    }
+    uint32_t postings = word._postings.size();
+    Cursor &obj = cases.addObject();
+    obj.setString("codec", codec.name);
+    obj.setDouble("doc_freq_ratio", doc_freq_ratio);
+    obj.setLong("postings", postings);
+    obj.setDouble("bits_per_posting", encoded->bits() / postings);
+    obj.setDouble("skip_bits_per_posting", encoded->skip_bits() / postings);
+    {
+        TermFieldMatchData tfmd;
+        TermFieldMatchDataArray tfmda;
+        tfmda.add(&tfmd);
+        obj.setString("iterator", encoded->create_iterator(tfmd, tfmda)->getClassName());
+    }
+    run_decode(*encoded, word, params.budget_sec, obj.setObject("decode"));
+    Cursor &skip_to = obj.setArray("skip_to");
+    for (double seek_ratio : seek_ratios) {
+        run_skip_to(*encoded, word, seek_ratio, params.budget_sec, skip_to.addObject());
+    }
+}
+
+void
+usage()
+{
+    fprintf(stderr, "usage: searchlib_posting_codec_suite_app [-d numDocs] [-b budgetSec] [-c codecFilter] [-f docFreqRatio]...\n");
+}
+
+}
+
+int
+run_suite(int argc, char **argv)
+{
+    SuiteParams params;
+    int c;
+    while ((c = getopt(argc, argv, "b:c:d:f:")) != -1) {
+        switch (c) {
+        case 'b':
+            params.budget_sec = strtod(optarg, nullptr);
+            break;
+        case 'c':
+            params.codec_filter = optarg;
+            break;
+        case 'd':
+            params.num_docs = strtoul(optarg, nullptr, 10);
+            break;
+        case 'f':
+            params.doc_freq_ratios.push_back(strtod(optarg, nullptr));
+            break;
+        default:
+            usage();
+            return 1;
+        }
+    }
+    if (params.doc_freq_ratios.empty()) {
+        params.doc_freq_ratios = default_doc_freq_ratios;
+    }
+    if (params.num_docs < 2 || params.budget_sec < 0.0) {
+        usage();
+        return 1;
+    }
+    vespalib::Slime slime;
+    Cursor &root = slime.setObject();
+    root.setLong("format_version", format_version);
+    root.setLong("num_docs", params.num_docs);
+    root.setDouble("budget_sec", params.budget_sec);
+    Cursor &cases = root.setArray("cases");
+    for (double doc_freq_ratio : params.doc_freq_ratios) {
+        uint32_t doc_freq = std::clamp(uint32_t(params.num_docs * doc_freq_ratio), 1u, params.num_docs - 1);
+        // Same posting list for all codecs, and for all runs with the same parameters
+        vespalib::Rand48 rnd;
+        rnd.srand48(word_seed);
+        FakeWordSet word_set(false, false);
+        word_set.setupWords(rnd, params.num_docs, doc_freq, doc_freq, doc_freq, 1);
+        const FakeWord &word = *word_set.words()[FakeWordSet::COMMON_WORD][0];
+        for (const auto &codec : codecs) {
+            if (codec.name.find(params.codec_filter) != std::string::npos) {
+                run_case(cases, codec, word_set, word, doc_freq_ratio, params);
+            }
+        }
+    }
+    std::cout << slime.toString() << std::endl;
+    return 0;
+}
+
+}
+
+int
+main(int argc, char **argv)
+{
+    vespalib::SignalHandler::PIPE.ignore();
+    return postinglistbm::run_suite(argc, argv);
+}
@@ -78,6 +78,28 @@ TEST(GlobalFilterTest, create_can_make_single_bitvector_filter) {
     verify(*filter);
 }
 
+TEST(GlobalFilterTest, create_can_make_sparse_filter) {
+    std::vector<uint32_t> docs;
+    for (uint32_t docid = 11; docid < 100; docid += 11) {
+        docs.push_back(docid);
+    }
+    auto filter = GlobalFilter::create_sparse(std::move(docs), 100, false);
+    EXPECT_EQ(filter->representation(), GlobalFilter::Representation::SPARSE);
+    verify(*filter);
+}
+
+TEST(GlobalFilterTest, create_can_make_inverted_sparse_filter) {
+    std::vector<uint32_t> docs;
+    for (uint32_t docid = 1; docid < 100; ++docid) {
+        if ((docid % 11) != 0) {
+            docs.push_back(docid);
+        }
+    }
+    auto filter = GlobalFilter::create_sparse(std::move(docs), 100, true);
+    EXPECT_EQ(filter->representation(), GlobalFilter::Representation::INVERTED);
+    verify(*filter);
+}
+
 TEST(GlobalFilterTest, global_filter_pointer_guard) {
     auto inactive = GlobalFilter::create();
     auto active = GlobalFilter::create(BitVector::create(1,100));
@@ -203,6 +225,29 @@ TEST(GlobalFilterTest, multi_threaded_global_filter_works_with_docid_limit_0) {
     verify(*filter, 2, 1);
 }
 
+TEST(GlobalFilterTest, global_filter_representation_depends_on_hit_ratio) {
+    SimpleThreadBundle thread_bundle(7);
+    auto sparse = GlobalFilter::create(*Blueprint::optimize_and_sort(create_blueprint(200, 10000)), 10000, thread_bundle);
+    EXPECT_EQ(sparse->representation(), GlobalFilter::Representation::SPARSE);
+    verify(*sparse, 200, 10000);
+    auto plain = GlobalFilter::create(*Blueprint::optimize_and_sort(create_blueprint(11, 10000)), 10000, thread_bundle);
+    EXPECT_EQ(plain->representation(), GlobalFilter::Representation::BITVECTOR);
+    verify(*plain, 11, 10000);
+    auto dense = GlobalFilter::create(*Blueprint::optimize_and_sort(create_blueprint(1, 10000)), 10000, thread_bundle);
+    EXPECT_EQ(dense->representation(), GlobalFilter::Representation::INVERTED);
+    verify(*dense, 1, 10000);
+}
+
+TEST(GlobalFilterTest, sparse_global_filter_falls_back_to_bitvector_when_estimate_is_too_low) {
+    SimpleThreadBundle thread_bundle(7);
+    // flow stats are not calculated for a blueprint that is not optimized
+    auto blueprint = create_blueprint(11, 10000);
+    ASSERT_LT(blueprint->estimate(), GlobalFilter::sparse_hit_ratio);
+    auto filter = GlobalFilter::create(*blueprint, 10000, thread_bundle);
+    EXPECT_EQ(filter->representation(), GlobalFilter::Representation::BITVECTOR);
+    verify(*filter, 11, 10000);
+}
+
 TEST(GlobalFilterTest, global_filter_matching_any_document_becomes_invalid) {
     SimpleThreadBundle thread_bundle(7);
     AlwaysTrueBlueprint blueprint;
@@ -10,7 +10,10 @@
 #include <vespa/searchlib/query/tree/simplequery.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
+#include <vespa/searchlib/queryeval/simple_phrase_blueprint.h>
+#include <algorithm>
 #include <cmath>
+#include <numeric>
 
 using search::query::IntegerTermVector;
 using search::query::MultiTerm;
@@ -29,20 +32,36 @@ namespace {
 const std::string field_name = "myfield";
 const std::string index_dir = "indexdir";
 
-uint32_t
-calc_hits_per_term(uint32_t num_docs, double op_hit_ratio, uint32_t children, QueryOperator query_op)
+std::vector<uint32_t>
+calc_hits_per_term(uint32_t num_docs, double op_hit_ratio, uint32_t children, QueryOperator query_op, double child_skew)
 {
-    if (query_op == QueryOperator::And) {
-        double child_hit_ratio = std::pow(op_hit_ratio, (1.0/(double)children));
-        return num_docs * child_hit_ratio;
+    std::vector<double> scales;
+    for (uint32_t i = 0; i < children; ++i) {
+        scales.push_back(std::pow(child_skew, -(double)i));
+    }
+    std::vector<uint32_t> res;
+    if (query_op == QueryOperator::And || query_op == QueryOperator::Phrase) {
+        // The children are populated independently, so the operator hit ratio is the product of the child hit ratios.
+        double log_scale_sum = 0.0;
+        for (double scale : scales) {
+            log_scale_sum += std::log(scale);
+        }
+        double first_hit_ratio = std::exp((std::log(op_hit_ratio) - log_scale_sum) / (double)children);
+        for (double scale : scales) {
+            res.push_back(num_docs * std::min(1.0, first_hit_ratio * scale));
+        }
     } else {
         uint32_t op_num_hits = num_docs * op_hit_ratio;
-        return op_num_hits / children;
+        double scale_sum = std::accumulate(scales.begin(), scales.end(), 0.0);
+        for (double scale : scales) {
+            res.push_back(op_num_hits * (scale / scale_sum));
+        }
     }
+    return res;
 }
 
 std::unique_ptr<BenchmarkSearchable>
-make_searchable(const FieldConfig& cfg, uint32_t num_docs, const HitSpecs& hit_specs, bool disjunct_terms)
+make_searchable(const FieldConfig& cfg, uint32_t num_docs, const HitSpecs& hit_specs, bool disjunct_terms, uint32_t num_occs)
 {
     if (cfg.is_attr()) {
         AttributeContextBuilder builder;
@@ -52,8 +71,6 @@ make_searchable(const FieldConfig& cfg, uint32_t num_docs, const HitSpecs& hit_s
         uint32_t docid_limit = num_docs + 1;
         DiskIndexBuilder builder(cfg.index_cfg(), index_dir, docid_limit, hit_specs.size());
         for (auto spec : hit_specs) {
-            // TODO: make number of occurrences configurable.
-            uint32_t num_occs = 1;
             builder.add_word(std::to_string(spec.term_value), *random_docids(docid_limit, spec.num_hits), num_occs);
         }
         return builder.build();
@@ -127,6 +144,22 @@ make_intermediate_blueprint(std::unique_ptr<IntermediateBlueprint> blueprint, Be
     return blueprint;
 }
 
+Blueprint::UP
+make_phrase_blueprint(BenchmarkSearchable& searchable, const TermVector& terms, uint32_t docid_limit)
+{
+    FieldSpec field(field_name, 0, 0);
+    auto blueprint = std::make_unique<SimplePhraseBlueprint>(field, false);
+    for (auto term : terms) {
+        SimpleStringTerm sterm(std::to_string(term), field_name, 0, Weight(1));
+        auto child = searchable.create_blueprint(blueprint->getNextChildField(field), sterm);
+        assert(child.get());
+        blueprint->addTerm(std::move(child));
+    }
+    blueprint->setDocIdLimit(docid_limit);
+    blueprint->update_flow_stats(docid_limit);
+    return blueprint;
+}
+
 Blueprint::UP
 make_blueprint_helper(BenchmarkSearchable& searchable, QueryOperator query_op, const TermVector& terms, uint32_t docid_limit)
 {
@@ -137,6 +170,8 @@ make_blueprint_helper(BenchmarkSearchable& searchable, QueryOperator query_op, c
     } else if (query_op == QueryOperator::WeakAnd) {
         uint32_t target_hits = 100;
         return make_intermediate_blueprint(std::make_unique<WeakAndBlueprint>(target_hits), searchable, terms, docid_limit);
+    } else if (query_op == QueryOperator::Phrase) {
+        return make_phrase_blueprint(searchable, terms, docid_limit);
     } else {
         auto query_node = make_query_node(query_op, terms);
         return make_leaf_blueprint(*query_node, searchable, docid_limit);
@@ -148,6 +183,9 @@ make_blueprint_helper(BenchmarkSearchable& searchable, QueryOperator query_op, c
  *
  * This populates an attribute or disk index field such that the query operator hits
  * the given ratio of the total document corpus.
+ *
+ * For the phrase operator (disk index only) each word occurs at positions [0, children)
+ * in its documents, such that the phrase matches all documents containing all its terms.
  */
 class MyFactory : public BenchmarkBlueprintFactory {
 private:
@@ -159,7 +197,7 @@ private:
 public:
     MyFactory(const FieldConfig& field_cfg, QueryOperator query_op,
               uint32_t num_docs, uint32_t default_values_per_document,
-              double op_hit_ratio, uint32_t children, bool disjunct_children);
+              double op_hit_ratio, uint32_t children, bool disjunct_children, double child_skew);
 
     std::unique_ptr<Blueprint> make_blueprint() override;
     std::string get_name(Blueprint& blueprint) const override {
@@ -169,25 +207,27 @@ public:
 
 MyFactory::MyFactory(const FieldConfig& field_cfg, QueryOperator query_op,
                      uint32_t num_docs, uint32_t default_values_per_document,
-                     double op_hit_ratio, uint32_t children, bool disjunct_children)
+                     double op_hit_ratio, uint32_t children, bool disjunct_children, double child_skew)
     : _query_op(query_op),
       _docid_limit(num_docs + 1),
       _terms(),
       _searchable()
 {
-    uint32_t hits_per_term = calc_hits_per_term(num_docs, op_hit_ratio, children, query_op);
+    assert(query_op != QueryOperator::Phrase || !field_cfg.is_attr());
+    auto hits_per_term = calc_hits_per_term(num_docs, op_hit_ratio, children, query_op, child_skew);
     HitSpecs hit_specs(55555);
     if (!disjunct_children) {
         hit_specs.add(default_values_per_document, num_docs);
     }
-    _terms = hit_specs.add(children, hits_per_term);
+    _terms = hit_specs.add(hits_per_term);
     if (disjunct_children && default_values_per_document != 0) {
         // This ensures that the remaining docids are populated with a "default value".
         // Only a single default value is supported.
         uint32_t op_num_hits = num_docs * op_hit_ratio;
         hit_specs.add(1, num_docs - op_num_hits);
     }
-    _searchable = make_searchable(field_cfg, num_docs, hit_specs, disjunct_children);
+    uint32_t num_occs = (query_op == QueryOperator::Phrase) ? children : 1;
+    _searchable = make_searchable(field_cfg, num_docs, hit_specs, disjunct_children, num_occs);
 }
 
 std::unique_ptr<Blueprint>
@@ -201,9 +241,10 @@ MyFactory::make_blueprint()
 std::unique_ptr<BenchmarkBlueprintFactory>
 make_blueprint_factory(const FieldConfig& field_cfg, QueryOperator query_op,
                        uint32_t num_docs, uint32_t default_values_per_document,
-                       double op_hit_ratio, uint32_t children, bool disjunct_children)
+                       double op_hit_ratio, uint32_t children, bool disjunct_children,
+                       double child_skew)
 {
-    return std::make_unique<MyFactory>(field_cfg, query_op, num_docs, default_values_per_document, op_hit_ratio, children, disjunct_children);
+    return std::make_unique<MyFactory>(field_cfg, query_op, num_docs, default_values_per_document, op_hit_ratio, children, disjunct_children, child_skew);
 }
 
 }
@@ -19,9 +19,16 @@ public:
     virtual std::string get_name(Blueprint& blueprint) const = 0;
 };
 
+/**
+ * Creates a factory for the given query operator where the operator hits 'op_hit_ratio' of the corpus.
+ *
+ * With 'child_skew' > 1.0 the posting lists of the children are skewed, where the hit ratio
+ * of child i is (1/child_skew)^i of the hit ratio of the first child.
+ */
 std::unique_ptr<BenchmarkBlueprintFactory>
 make_blueprint_factory(const FieldConfig& field_cfg, QueryOperator query_op,
                        uint32_t num_docs, uint32_t default_values_per_document,
-                       double op_hit_ratio, uint32_t children, bool disjunct_children);
+                       double op_hit_ratio, uint32_t children, bool disjunct_children,
+                       double child_skew = 1.0);
 
 }
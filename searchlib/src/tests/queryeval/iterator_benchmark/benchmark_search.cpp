@@ -0,0 +1,195 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "benchmark_search.h"
+#include "benchmark_blueprint_factory.h"
+#include <vespa/searchlib/fef/matchdata.h>
+#include <vespa/searchlib/queryeval/blueprint.h>
+#include <vespa/searchlib/queryeval/multibitvectoriterator.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <cassert>
+
+using search::fef::MatchData;
+using vespalib::BenchmarkTimer;
+
+namespace search::queryeval::test {
+
+std::string
+to_string(PlanningAlgo algo)
+{
+    switch (algo) {
+        case PlanningAlgo::Order: return "ordr";
+        case PlanningAlgo::Estimate: return "esti";
+        case PlanningAlgo::Cost: return "cost";
+        case PlanningAlgo::CostForceStrict: return "forc";
+    }
+    return "unknown";
+}
+
+BenchmarkResult::BenchmarkResult(const BenchmarkResult&) = default;
+BenchmarkResult::~BenchmarkResult() = default;
+BenchmarkResult& BenchmarkResult::operator=(const BenchmarkResult&) = default;
+
+namespace {
+
+double estimate_actual_cost(Blueprint &bp, InFlow in_flow) {
+    if (in_flow.strict()) {
+        assert(bp.strict());
+        return bp.strict_cost();
+    } else if (bp.strict()) {
+        auto stats = FlowStats::from(flow::DefaultAdapter(), &bp);
+        return flow::forced_strict_cost(stats, in_flow.rate());
+    } else {
+        return bp.cost() * in_flow.rate();
+    }
+}
+
+struct MatchLoopContext {
+    Blueprint::UP blueprint;
+    MatchData::UP match_data;
+    SearchIterator::UP iterator;
+    MatchLoopContext() : blueprint(), match_data(), iterator() {}
+    MatchLoopContext(Blueprint::UP blueprint_in,
+                     MatchData::UP match_data_in,
+                     SearchIterator::UP iterator_in)
+        : blueprint(std::move(blueprint_in)),
+          match_data(std::move(match_data_in)),
+          iterator(std::move(iterator_in))
+    {}
+    void operator=(MatchLoopContext&& rhs) {
+        blueprint = std::move(rhs.blueprint);
+        match_data = std::move(rhs.match_data);
+        iterator = std::move(rhs.iterator);
+    }
+    ~MatchLoopContext();
+};
+
+MatchLoopContext::~MatchLoopContext() = default;
+
+Blueprint::Options
+to_sort_options(PlanningAlgo algo)
+{
+    Blueprint::Options opts;
+    if (algo == PlanningAlgo::Order) {
+        opts.keep_order(true);
+    } else if (algo == PlanningAlgo::Cost) {
+        opts.sort_by_cost(true);
+    } else if (algo == PlanningAlgo::CostForceStrict) {
+        opts.sort_by_cost(true).allow_force_strict(true);
+    }
+    return opts;
+}
+
+void
+sort_blueprint(Blueprint& blueprint, InFlow in_flow, uint32_t docid_limit, Blueprint::Options opts)
+{
+    auto opts_guard = blueprint.bind_opts(opts);
+    blueprint.setDocIdLimit(docid_limit);
+    blueprint.each_node_post_order([docid_limit](Blueprint &bp){
+        bp.update_flow_stats(docid_limit);
+    });
+    blueprint.sort(in_flow);
+}
+
+MatchLoopContext
+make_match_loop_context(BenchmarkBlueprintFactory& factory, InFlow in_flow, uint32_t docid_limit, PlanningAlgo algo)
+{
+    auto blueprint = factory.make_blueprint();
+    assert(blueprint);
+    sort_blueprint(*blueprint, in_flow, docid_limit, to_sort_options(algo));
+    blueprint->fetchPostings(ExecuteInfo::FULL);
+    // Note: All blueprints get the same TermFieldMatchData instance.
+    //       This is OK as long as we don't do unpacking and only use 1 thread.
+    auto md = MatchData::makeTestInstance(1, 1);
+    // Note: This matches how the match thread combines bitvector children into a MultiBitVectorIterator.
+    auto itr = MultiBitVectorIteratorBase::optimize(blueprint->createSearch(*md));
+    assert(itr);
+    return {std::move(blueprint), std::move(md), std::move(itr)};
+}
+
+template <bool do_unpack>
+BenchmarkResult
+strict_search(BenchmarkBlueprintFactory& factory, uint32_t docid_limit, PlanningAlgo algo, double budget_sec)
+{
+    BenchmarkTimer timer(budget_sec);
+    uint32_t hits = 0;
+    MatchLoopContext ctx;
+    while (timer.has_budget()) {
+        ctx = make_match_loop_context(factory, true, docid_limit, algo);
+        auto* itr = ctx.iterator.get();
+        timer.before();
+        hits = 0;
+        itr->initRange(1, docid_limit);
+        uint32_t docid = itr->seekFirst(1);
+        if constexpr (do_unpack) {
+            itr->unpack(docid);
+        }
+        while (docid < docid_limit) {
+            ++hits;
+            docid = itr->seekNext(docid + 1);
+            if constexpr (do_unpack) {
+                itr->unpack(docid);
+            }
+        }
+        timer.after();
+    }
+    FlowStats flow(ctx.blueprint->estimate(), ctx.blueprint->cost(), ctx.blueprint->strict_cost());
+    double actual_cost = estimate_actual_cost(*ctx.blueprint, InFlow(true));
+    return {timer.min_time() * 1000.0, hits + 1, hits, flow, actual_cost, get_class_name(*ctx.iterator), factory.get_name(*ctx.blueprint)};
+}
+
+template <bool do_unpack>
+BenchmarkResult
+non_strict_search(BenchmarkBlueprintFactory& factory, uint32_t docid_limit, double filter_hit_ratio, bool force_strict, PlanningAlgo algo, double budget_sec)
+{
+    BenchmarkTimer timer(budget_sec);
+    uint32_t seeks = 0;
+    uint32_t hits = 0;
+    // This simulates a filter that is evaluated before this iterator.
+    // The filter returns 'filter_hit_ratio' amount of the document corpus.
+    uint32_t docid_skip = 1.0 / filter_hit_ratio;
+    MatchLoopContext ctx;
+    while (timer.has_budget()) {
+        ctx = make_match_loop_context(factory, InFlow(force_strict, filter_hit_ratio), docid_limit, algo);
+        auto* itr = ctx.iterator.get();
+        timer.before();
+        seeks = 0;
+        hits = 0;
+        itr->initRange(1, docid_limit);
+        for (uint32_t docid = 1; !itr->isAtEnd(docid); docid += docid_skip) {
+            ++seeks;
+            if (itr->seek(docid)) {
+                ++hits;
+                if constexpr (do_unpack) {
+                    itr->unpack(docid);
+                }
+            }
+        }
+        timer.after();
+    }
+    FlowStats flow(ctx.blueprint->estimate(), ctx.blueprint->cost(), ctx.blueprint->strict_cost());
+    double actual_cost = estimate_actual_cost(*ctx.blueprint, InFlow(filter_hit_ratio));
+    return {timer.min_time() * 1000.0, seeks, hits, flow, actual_cost, get_class_name(*ctx.iterator), factory.get_name(*ctx.blueprint)};
+}
+
+}
+
+BenchmarkResult
+benchmark_search(BenchmarkBlueprintFactory& factory, uint32_t docid_limit, bool strict_context, bool force_strict,
+                 bool unpack_iterator, double filter_hit_ratio, PlanningAlgo algo, double budget_sec)
+{
+    if (strict_context) {
+        if (unpack_iterator) {
+            return strict_search<true>(factory, docid_limit, algo, budget_sec);
+        } else {
+            return strict_search<false>(factory, docid_limit, algo, budget_sec);
+        }
+    } else {
+        if (unpack_iterator) {
+            return non_strict_search<true>(factory, docid_limit, filter_hit_ratio, force_strict, algo, budget_sec);
+        } else {
+            return non_strict_search<false>(factory, docid_limit, filter_hit_ratio, force_strict, algo, budget_sec);
+        }
+    }
+}
+
+}
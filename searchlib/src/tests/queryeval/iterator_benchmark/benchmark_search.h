@@ -0,0 +1,59 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/queryeval/flow.h>
+#include <string>
+
+namespace search::queryeval::test {
+
+class BenchmarkBlueprintFactory;
+
+enum class PlanningAlgo {
+    Order,
+    Estimate,
+    Cost,
+    CostForceStrict
+};
+
+std::string to_string(PlanningAlgo algo);
+
+struct BenchmarkResult {
+    double time_ms;
+    uint32_t seeks;
+    uint32_t hits;
+    FlowStats flow;
+    double actual_cost;
+    std::string iterator_name;
+    std::string blueprint_name;
+    BenchmarkResult() : BenchmarkResult(0, 0, 0, {0, 0, 0}, 0, "", "") {}
+    BenchmarkResult(double time_ms_in, uint32_t seeks_in, uint32_t hits_in, FlowStats flow_in, double actual_cost_in,
+                    const std::string& iterator_name_in, const std::string& blueprint_name_in)
+        : time_ms(time_ms_in),
+          seeks(seeks_in),
+          hits(hits_in),
+          flow(flow_in),
+          actual_cost(actual_cost_in),
+          iterator_name(iterator_name_in),
+          blueprint_name(blueprint_name_in)
+    {}
+    BenchmarkResult(const BenchmarkResult&);
+    BenchmarkResult(BenchmarkResult&&) noexcept = default;
+    ~BenchmarkResult();
+    BenchmarkResult& operator=(const BenchmarkResult&);
+    BenchmarkResult& operator=(BenchmarkResult&&) noexcept = default;
+    double ns_per_seek() const { return (time_ms / seeks) * 1000.0 * 1000.0; }
+    double ns_per_hit() const { return (hits > 0) ? (time_ms / hits) * 1000.0 * 1000.0 : 0.0; }
+    double ms_per_actual_cost() const { return (time_ms / actual_cost); }
+};
+
+/**
+ * Runs the match loop over the iterator created by the given factory, either in a strict context
+ * (seekFirst/seekNext over all docids) or in a non-strict context where a simulated filter hitting
+ * 'filter_hit_ratio' of the corpus drives the seeks. The fastest run within the time budget is reported.
+ */
+BenchmarkResult
+benchmark_search(BenchmarkBlueprintFactory& factory, uint32_t docid_limit, bool strict_context, bool force_strict,
+                 bool unpack_iterator, double filter_hit_ratio, PlanningAlgo algo, double budget_sec = 1.0);
+
+}
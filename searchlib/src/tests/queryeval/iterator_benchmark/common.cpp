@@ -41,6 +41,7 @@ to_string(QueryOperator query_op)
         case QueryOperator::Or: return "Or";
         case QueryOperator::WeakAnd: return "WeakAnd";
         case QueryOperator::ParallelWeakAnd: return "ParallelWeakAnd";
+        case QueryOperator::Phrase: return "Phrase";
     }
     return "unknown";
 }
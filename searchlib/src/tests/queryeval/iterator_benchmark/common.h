@@ -42,7 +42,8 @@ enum class QueryOperator {
     And,
     Or,
     WeakAnd,
-    ParallelWeakAnd
+    ParallelWeakAnd,
+    Phrase
 };
 
 std::string to_string(QueryOperator query_op);
@@ -74,6 +75,15 @@ public:
         }
         return res;
     }
+    TermVector add(const std::vector<uint32_t>& hits_per_term) {
+        TermVector res;
+        for (uint32_t num_hits : hits_per_term) {
+            uint32_t term_value = _next_term_value++;
+            _specs.push_back({term_value, num_hits});
+            res.push_back(term_value);
+        }
+        return res;
+    }
     size_t size() const { return _specs.size(); }
     auto begin() const { return _specs.begin(); }
     auto end() const { return _specs.end(); }
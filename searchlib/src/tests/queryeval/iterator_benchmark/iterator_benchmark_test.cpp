@@ -2,11 +2,10 @@
 
 #include "intermediate_blueprint_factory.h"
 #include "benchmark_blueprint_factory.h"
+#include "benchmark_search.h"
 #include "common.h"
-#include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/vespalib/gtest/gtest.h>
-#include <vespa/vespalib/util/benchmark_timer.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <cmath>
 #include <iomanip>
@@ -20,75 +19,10 @@ using namespace search;
 using namespace vespalib;
 
 using search::index::Schema;
-using search::fef::MatchData;
 
 using vespalib::make_string_short::fmt;
 
 const std::string field_name = "myfield";
-double budget_sec = 1.0;
-
-double estimate_actual_cost(Blueprint &bp, InFlow in_flow) {
-    if (in_flow.strict()) {
-        assert(bp.strict());
-        return bp.strict_cost();
-    } else if (bp.strict()) {
-        auto stats = FlowStats::from(flow::DefaultAdapter(), &bp);
-        return flow::forced_strict_cost(stats, in_flow.rate());
-    } else {
-        return bp.cost() * in_flow.rate();
-    }
-}
-
-enum class PlanningAlgo {
-    Order,
-    Estimate,
-    Cost,
-    CostForceStrict
-};
-
-std::string
-to_string(PlanningAlgo algo)
-{
-    switch (algo) {
-        case PlanningAlgo::Order: return "ordr";
-        case PlanningAlgo::Estimate: return "esti";
-        case PlanningAlgo::Cost: return "cost";
-        case PlanningAlgo::CostForceStrict: return "forc";
-    }
-    return "unknown";
-}
-
-struct BenchmarkResult {
-    double time_ms;
-    uint32_t seeks;
-    uint32_t hits;
-    FlowStats flow;
-    double actual_cost;
-    std::string iterator_name;
-    std::string blueprint_name;
-    BenchmarkResult() : BenchmarkResult(0, 0, 0, {0, 0, 0}, 0, "", "") {}
-    BenchmarkResult(double time_ms_in, uint32_t seeks_in, uint32_t hits_in, FlowStats flow_in, double actual_cost_in,
-                    const std::string& iterator_name_in, const std::string& blueprint_name_in)
-        : time_ms(time_ms_in),
-          seeks(seeks_in),
-          hits(hits_in),
-          flow(flow_in),
-          actual_cost(actual_cost_in),
-          iterator_name(iterator_name_in),
-          blueprint_name(blueprint_name_in)
-    {}
-    BenchmarkResult(const BenchmarkResult&);
-    BenchmarkResult(BenchmarkResult&&) noexcept = default;
-    ~BenchmarkResult();
-    BenchmarkResult& operator=(const BenchmarkResult&);
-    BenchmarkResult& operator=(BenchmarkResult&&) noexcept = default;
-    double ns_per_seek() const { return (time_ms / seeks) * 1000.0 * 1000.0; }
-    double ms_per_actual_cost() const { return (time_ms / actual_cost); }
-};
-
-BenchmarkResult::BenchmarkResult(const BenchmarkResult&) = default;
-BenchmarkResult::~BenchmarkResult() = default;
-BenchmarkResult& BenchmarkResult::operator=(const BenchmarkResult&) = default;
 
 struct Stats {
     double average;
@@ -167,151 +101,6 @@ public:
     }
 };
 
-struct MatchLoopContext {
-    Blueprint::UP blueprint;
-    MatchData::UP match_data;
-    SearchIterator::UP iterator;
-    MatchLoopContext() : blueprint(), match_data(), iterator() {}
-    MatchLoopContext(Blueprint::UP blueprint_in,
-                     MatchData::UP match_data_in,
-                     SearchIterator::UP iterator_in)
-        : blueprint(std::move(blueprint_in)),
-          match_data(std::move(match_data_in)),
-          iterator(std::move(iterator_in))
-    {}
-    void operator=(MatchLoopContext&& rhs) {
-        blueprint = std::move(rhs.blueprint);
-        match_data = std::move(rhs.match_data);
-        iterator = std::move(rhs.iterator);
-    }
-    ~MatchLoopContext();
-};
-
-MatchLoopContext::~MatchLoopContext() = default;
-
-Blueprint::Options
-to_sort_options(PlanningAlgo algo)
-{
-    Blueprint::Options opts;
-    if (algo == PlanningAlgo::Order) {
-        opts.keep_order(true);
-    } else if (algo == PlanningAlgo::Cost) {
-        opts.sort_by_cost(true);
-    } else if (algo == PlanningAlgo::CostForceStrict) {
-        opts.sort_by_cost(true).allow_force_strict(true);
-    }
-    return opts;
-}
-
-void
-sort_blueprint(Blueprint& blueprint, InFlow in_flow, uint32_t docid_limit, Blueprint::Options opts)
-{
-    auto opts_guard = blueprint.bind_opts(opts);
-    blueprint.setDocIdLimit(docid_limit);
-    blueprint.each_node_post_order([docid_limit](Blueprint &bp){
-        bp.update_flow_stats(docid_limit);
-    });
-    blueprint.sort(in_flow);
-}
-
-MatchLoopContext
-make_match_loop_context(BenchmarkBlueprintFactory& factory, InFlow in_flow, uint32_t docid_limit, PlanningAlgo algo)
-{
-    auto blueprint = factory.make_blueprint();
-    assert(blueprint);
-    sort_blueprint(*blueprint, in_flow, docid_limit, to_sort_options(algo));
-    blueprint->fetchPostings(ExecuteInfo::FULL);
-    // Note: All blueprints get the same TermFieldMatchData instance.
-    //       This is OK as long as we don't do unpacking and only use 1 thread.
-    auto md = MatchData::makeTestInstance(1, 1);
-    auto itr = blueprint->createSearch(*md);
-    assert(itr);
-    return {std::move(blueprint), std::move(md), std::move(itr)};
-}
-
-template <bool do_unpack>
-BenchmarkResult
-strict_search(BenchmarkBlueprintFactory& factory, uint32_t docid_limit, PlanningAlgo algo)
-{
-    BenchmarkTimer timer(budget_sec);
-    uint32_t hits = 0;
-    MatchLoopContext ctx;
-    while (timer.has_budget()) {
-        ctx = make_match_loop_context(factory, true, docid_limit, algo);
-        auto* itr = ctx.iterator.get();
-        timer.before();
-        hits = 0;
-        itr->initRange(1, docid_limit);
-        uint32_t docid = itr->seekFirst(1);
-        if constexpr (do_unpack) {
-            itr->unpack(docid);
-        }
-        while (docid < docid_limit) {
-            ++hits;
-            docid = itr->seekNext(docid + 1);
-            if constexpr (do_unpack) {
-                itr->unpack(docid);
-            }
-        }
-        timer.after();
-    }
-    FlowStats flow(ctx.blueprint->estimate(), ctx.blueprint->cost(), ctx.blueprint->strict_cost());
-    double actual_cost = estimate_actual_cost(*ctx.blueprint, InFlow(true));
-    return {timer.min_time() * 1000.0, hits + 1, hits, flow, actual_cost, get_class_name(*ctx.iterator), factory.get_name(*ctx.blueprint)};
-}
-
-template <bool do_unpack>
-BenchmarkResult
-non_strict_search(BenchmarkBlueprintFactory& factory, uint32_t docid_limit, double filter_hit_ratio, bool force_strict, PlanningAlgo algo)
-{
-    BenchmarkTimer timer(budget_sec);
-    uint32_t seeks = 0;
-    uint32_t hits = 0;
-    // This simulates a filter that is evaluated before this iterator.
-    // The filter returns 'filter_hit_ratio' amount of the document corpus.
-    uint32_t docid_skip = 1.0 / filter_hit_ratio;
-    MatchLoopContext ctx;
-    while (timer.has_budget()) {
-        ctx = make_match_loop_context(factory, InFlow(force_strict, filter_hit_ratio), docid_limit, algo);
-        auto* itr = ctx.iterator.get();
-        timer.before();
-        seeks = 0;
-        hits = 0;
-        itr->initRange(1, docid_limit);
-        for (uint32_t docid = 1; !itr->isAtEnd(docid); docid += docid_skip) {
-            ++seeks;
-            if (itr->seek(docid)) {
-                ++hits;
-                if constexpr (do_unpack) {
-                    itr->unpack(docid);
-                }
-            }
-        }
-        timer.after();
-    }
-    FlowStats flow(ctx.blueprint->estimate(), ctx.blueprint->cost(), ctx.blueprint->strict_cost());
-    double actual_cost = estimate_actual_cost(*ctx.blueprint, InFlow(filter_hit_ratio));
-    return {timer.min_time() * 1000.0, seeks, hits, flow, actual_cost, get_class_name(*ctx.iterator), factory.get_name(*ctx.blueprint)};
-}
-
-BenchmarkResult
-benchmark_search(BenchmarkBlueprintFactory& factory, uint32_t docid_limit, bool strict_context, bool force_strict, bool unpack_iterator, double filter_hit_ratio, PlanningAlgo algo)
-{
-    if (strict_context) {
-        if (unpack_iterator) {
-            return strict_search<true>(factory, docid_limit, algo);
-        } else {
-            return strict_search<false>(factory, docid_limit, algo);
-        }
-    } else {
-        if (unpack_iterator) {
-            return non_strict_search<true>(factory, docid_limit, filter_hit_ratio, force_strict, algo);
-        } else {
-            return non_strict_search<false>(factory, docid_limit, filter_hit_ratio, force_strict, algo);
-        }
-    }
-}
-
 //-----------------------------------------------------------------------------
 
 double est_forced_strict_cost(double estimate, double strict_cost, double rate) {
@@ -0,0 +1,168 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "benchmark_blueprint_factory.h"
+#include "benchmark_search.h"
+#include "common.h"
+#include <vespa/vespalib/data/slime/slime.h>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace search::attribute;
+using namespace search::queryeval::test;
+using namespace search::queryeval;
+using namespace search;
+
+using search::index::Schema;
+using vespalib::slime::Cursor;
+
+/**
+ * Runs a fixed suite of iterator benchmarks over synthetic posting lists and prints the
+ * results as JSON on stdout, to be compared between versions to catch iterator regressions.
+ *
+ * Each case is run in a strict context and in a non-strict context (driven by a simulated
+ * filter), both with and without unpacking. The corpus of each case is populated from a fixed
+ * seed, so the posting lists are identical between runs with the same number of documents.
+ *
+ * usage: searchlib_iterator_suite_benchmark_app [num_docs] [budget_sec] [case_filter]
+ */
+
+namespace {
+
+const std::string field_name = "myfield";
+constexpr uint32_t format_version = 1;
+constexpr uint32_t case_seed = 1234;
+constexpr double non_strict_in_flow = 0.1;
+
+FieldConfig
+make_attr_config(BasicType basic_type, CollectionType col_type, bool fast_search, bool rank_filter = false)
+{
+    Config cfg(basic_type, col_type);
+    cfg.setFastSearch(fast_search);
+    cfg.setIsFilter(rank_filter);
+    return FieldConfig(cfg);
+}
+
+FieldConfig
+make_index_config()
+{
+    Schema::IndexField field(field_name, search::index::schema::DataType::STRING, search::index::schema::CollectionType::SINGLE);
+    field.set_interleaved_features(true);
+    return FieldConfig(field);
+}
+
+const auto int32_fs = make_attr_config(BasicType::INT32, CollectionType::SINGLE, true);
+const auto int32_fs_rf = make_attr_config(BasicType::INT32, CollectionType::SINGLE, true, true);
+const auto int32_wset_fs = make_attr_config(BasicType::INT32, CollectionType::WSET, true);
+const auto str_index = make_index_config();
+
+struct SuiteCase {
+    std::string name;
+    FieldConfig field_cfg;
+    QueryOperator query_op;
+    double op_hit_ratio;
+    uint32_t children;
+    double child_skew;
+};
+
+// Note: Only append new cases, and never change existing ones, as the case names are used
+//       to match results between versions.
+const std::vector<SuiteCase> suite_cases = {
+    {"and",                 int32_fs,      QueryOperator::And,             0.01,  3,  1.0},
+    {"and_skewed",          int32_fs,      QueryOperator::And,             0.01,  3,  3.0},
+    {"or",                  int32_fs,      QueryOperator::Or,              0.1,  10,  1.0},
+    {"or_skewed",           int32_fs,      QueryOperator::Or,              0.1,  10,  2.0},
+    {"weak_and",            int32_wset_fs, QueryOperator::WeakAnd,         0.1,  10,  1.0},
+    {"parallel_weak_and",   int32_wset_fs, QueryOperator::ParallelWeakAnd, 0.1,  10,  1.0},
+    {"weighted_set",        int32_fs,      QueryOperator::WeightedSet,     0.1, 100,  1.0},
+    {"dot_product",         int32_wset_fs, QueryOperator::DotProduct,      0.1, 100,  1.0},
+    {"bitvector",           int32_fs_rf,   QueryOperator::Term,            0.5,   1,  1.0},
+    {"and_multi_bitvector", int32_fs_rf,   QueryOperator::And,             0.1,   3,  1.0},
+    {"or_multi_bitvector",  int32_fs_rf,   QueryOperator::Or,              0.5,   3,  1.0},
+    {"phrase",              str_index,     QueryOperator::Phrase,          0.01,  2,  1.0},
+    {"phrase_skewed",       str_index,     QueryOperator::Phrase,          0.01,  3,  3.0}
+};
+
+struct SuiteParams {
+    uint32_t num_docs;
+    double budget_sec;
+    std::string case_filter;
+    SuiteParams() : num_docs(1'000'000), budget_sec(1.0), case_filter() {}
+};
+
+void
+add_result(Cursor& runs, const BenchmarkResult& res, bool strict, bool unpack, uint32_t num_docs)
+{
+    Cursor& obj = runs.addObject();
+    obj.setBool("strict", strict);
+    obj.setBool("unpack", unpack);
+    obj.setDouble("in_flow", strict ? 1.0 : non_strict_in_flow);
+    obj.setLong("seeks", res.seeks);
+    obj.setLong("hits", res.hits);
+    obj.setDouble("time_ms", res.time_ms);
+    obj.setDouble("ns_per_docid", (res.time_ms / num_docs) * 1000.0 * 1000.0);
+    obj.setDouble("ns_per_seek", res.ns_per_seek());
+    obj.setDouble("ns_per_hit", res.ns_per_hit());
+    obj.setString("iterator", res.iterator_name);
+    obj.setString("blueprint", res.blueprint_name);
+}
+
+void
+run_case(Cursor& cases, const SuiteCase& scase, const SuiteParams& params)
+{
+    std::cerr << "running case: " << scase.name << std::endl;
+    // Re-seed per case so a case gets the same corpus regardless of which cases are run.
+    get_gen().seed(case_seed);
+    auto factory = make_blueprint_factory(scase.field_cfg, scase.query_op, params.num_docs, 0,
+                                          scase.op_hit_ratio, scase.children, false, scase.child_skew);
+    Cursor& obj = cases.addObject();
+    obj.setString("name", scase.name);
+    obj.setString("operator", to_string(scase.query_op));
+    obj.setString("field", scase.field_cfg.to_string());
+    obj.setDouble("op_hit_ratio", scase.op_hit_ratio);
+    obj.setLong("children", scase.children);
+    obj.setDouble("child_skew", scase.child_skew);
+    Cursor& runs = obj.setArray("runs");
+    for (bool strict : {true, false}) {
+        for (bool unpack : {false, true}) {
+            auto res = benchmark_search(*factory, params.num_docs + 1, strict, false, unpack,
+                                        non_strict_in_flow, PlanningAlgo::Cost, params.budget_sec);
+            add_result(runs, res, strict, unpack, params.num_docs);
+        }
+    }
+}
+
+}
+
+int
+main(int argc, char **argv)
+{
+    SuiteParams params;
+    if (argc > 1) {
+        params.num_docs = std::strtoul(argv[1], nullptr, 10);
+    }
+    if (argc > 2) {
+        params.budget_sec = std::strtod(argv[2], nullptr);
+    }
+    if (argc > 3) {
+        params.case_filter = argv[3];
+    }
+    if (params.num_docs == 0 || params.budget_sec <= 0.0) {
+        fprintf(stderr, "usage: %s [num_docs] [budget_sec] [case_filter]\n", argv[0]);
+        return 1;
+    }
+    vespalib::Slime slime;
+    Cursor& root = slime.setObject();
+    root.setLong("format_version", format_version);
+    root.setLong("num_docs", params.num_docs);
+    root.setDouble("budget_sec", params.budget_sec);
+    Cursor& cases = root.setArray("cases");
+    for (const auto& scase : suite_cases) {
+        if (scase.name.find(params.case_filter) != std::string::npos) {
+            run_case(cases, scase, params);
+        }
+    }
+    std::cout << slime.toString() << std::endl;
+    return 0;
+}
@@ -0,0 +1,97 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/queryeval/blueprint.h>
+#include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/searchlib/queryeval/executeinfo.h>
+#include <vespa/searchlib/queryeval/intermediate_blueprints.h>
+#include <vespa/searchlib/queryeval/parallel_fetch_postings.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <map>
+#include <mutex>
+
+using namespace search::queryeval;
+using vespalib::SimpleThreadBundle;
+using vespalib::ThreadBundle;
+
+struct FetchLog {
+    std::mutex lock;
+    std::map<std::string, double> hit_rates;
+    size_t nested_thread_bundle_size = 0;
+};
+
+class MyLeaf : public SimpleLeafBlueprint
+{
+private:
+    std::string _name;
+    uint32_t    _hits;
+    FetchLog   &_log;
+public:
+    MyLeaf(const std::string &name, uint32_t hits, FetchLog &log)
+        : SimpleLeafBlueprint(), _name(name), _hits(hits), _log(log)
+    {
+        setEstimate(HitEstimate(hits, false));
+    }
+    SearchIteratorUP createLeafSearch(const search::fef::TermFieldMatchDataArray &) const override {
+        return std::make_unique<EmptySearch>();
+    }
+    SearchIteratorUP createFilterSearchImpl(FilterConstraint constraint) const override {
+        return create_default_filter(constraint);
+    }
+    FlowStats calculate_flow_stats(uint32_t docid_limit) const override {
+        return default_flow_stats(docid_limit, _hits, 0);
+    }
+    void fetchPostings(const ExecuteInfo &execInfo) override {
+        std::lock_guard guard(_log.lock);
+        _log.hit_rates[_name] = execInfo.hit_rate();
+        _log.nested_thread_bundle_size = std::max(_log.nested_thread_bundle_size, execInfo.thread_bundle().size());
+    }
+};
+
+Blueprint::UP make_tree(FetchLog &log) {
+    auto my_or = std::make_unique<OrBlueprint>();
+    my_or->addChild(std::make_unique<MyLeaf>("b", 100, log));
+    my_or->addChild(std::make_unique<MyLeaf>("c", 200, log));
+    my_or->addChild(std::make_unique<MyLeaf>("d", 300, log));
+    auto my_and = std::make_unique<AndBlueprint>();
+    my_and->addChild(std::make_unique<MyLeaf>("a", 10, log));
+    my_and->addChild(std::move(my_or));
+    my_and->addChild(std::make_unique<MyLeaf>("e", 500, log));
+    Blueprint::UP root = std::move(my_and);
+    root->basic_plan(true, 1000);
+    return root;
+}
+
+TEST(ParallelFetchPostingsTest, require_that_all_leafs_are_fetched_with_same_hit_rates_as_sequential_fetch)
+{
+    FetchLog expect;
+    auto plain = make_tree(expect);
+    plain->fetchPostings(ExecuteInfo::FULL);
+    EXPECT_EQ(5u, expect.hit_rates.size());
+
+    SimpleThreadBundle thread_bundle(4);
+    FetchLog actual;
+    auto parallel = make_tree(actual);
+    auto stats = ParallelFetchPostings::fetch_all(*parallel, ExecuteInfo::createForTest(1.0, vespalib::Doom::never()));
+    EXPECT_EQ(expect.hit_rates, actual.hit_rates);
+    EXPECT_EQ(5u, stats.leafs);
+    EXPECT_EQ(1u, stats.threads); // trivial thread bundle used by test execute info
+    stats = ParallelFetchPostings::fetch_all(*parallel, ExecuteInfo::create(1.0, vespalib::Doom::never(), thread_bundle));
+    EXPECT_EQ(expect.hit_rates, actual.hit_rates);
+    EXPECT_EQ(5u, stats.leafs);
+    EXPECT_EQ(4u, stats.threads);
+    EXPECT_EQ(1u, actual.nested_thread_bundle_size);
+}
+
+TEST(ParallelFetchPostingsTest, require_that_single_leaf_is_fetched_directly)
+{
+    FetchLog log;
+    MyLeaf leaf("a", 10, log);
+    leaf.basic_plan(true, 1000);
+    auto stats = ParallelFetchPostings::fetch_all(leaf, ExecuteInfo::createForTest(0.5));
+    EXPECT_EQ(1u, stats.leafs);
+    EXPECT_EQ(1u, stats.threads);
+    EXPECT_EQ(0.5, log.hit_rates["a"]);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -3,6 +3,8 @@
 #include <vespa/searchlib/queryeval/docid_with_weight_search_iterator.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
 #include <vespa/searchlib/queryeval/fake_searchable.h>
+#include <vespa/searchlib/queryeval/posting_info.h>
+#include <vespa/searchlib/queryeval/rank_score_threshold.h>
 #include <vespa/searchlib/queryeval/simpleresult.h>
 #include <vespa/searchlib/queryeval/test/eagerchild.h>
 #include <vespa/searchlib/queryeval/test/leafspec.h>
@@ -12,6 +14,8 @@
 #include <vespa/searchlib/test/document_weight_attribute_helper.h>
 #include <vespa/searchlib/test/weightedchildrenverifiers.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
+#include <limits>
 
 using namespace search::query;
 using namespace search::queryeval;
@@ -453,6 +457,152 @@ TEST(ParallelWeakAndTest, require_that_dot_product_score_is_calculated)
 }
 
 
+/**
+ * Search iterator exposing block max element weights for fixed size
+ * blocks of its posting list, counting how many times it is unpacked.
+ **/
+class BlockMaxSearch : public SearchIterator
+{
+    std::vector<std::pair<uint32_t, int32_t>> _docs;
+    uint32_t                                  _block_size;
+    size_t                                    _pos;
+    TermFieldMatchData                       &_tfmd;
+    MinMaxPostingInfo                         _posting_info;
+    uint32_t                                 &_unpacks;
+public:
+    BlockMaxSearch(std::vector<std::pair<uint32_t, int32_t>> docs, uint32_t block_size,
+                   TermFieldMatchData &tfmd, uint32_t &unpacks)
+        : _docs(std::move(docs)),
+          _block_size(block_size),
+          _pos(0),
+          _tfmd(tfmd),
+          _posting_info(1, 100),
+          _unpacks(unpacks)
+    {}
+    void initRange(uint32_t begin, uint32_t end) override {
+        SearchIterator::initRange(begin, end);
+        _pos = 0;
+    }
+    void doSeek(uint32_t docid) override {
+        while (_pos < _docs.size() && _docs[_pos].first < docid) {
+            ++_pos;
+        }
+        if (_pos < _docs.size()) {
+            setDocId(_docs[_pos].first);
+        } else {
+            setAtEnd();
+        }
+    }
+    void doUnpack(uint32_t docid) override {
+        ++_unpacks;
+        _tfmd.reset(docid);
+        _tfmd.appendPosition(search::fef::TermFieldMatchDataPosition(0, 0, _docs[_pos].second, 1));
+    }
+    const PostingInfo *getPostingInfo() const override { return &_posting_info; }
+    BlockMaxMeta get_block_max() const noexcept override {
+        if (_block_size == 0 || _pos >= _docs.size()) {
+            return {};
+        }
+        size_t begin = _pos - (_pos % _block_size);
+        size_t end = std::min(begin + _block_size, _docs.size());
+        int32_t max_weight = std::numeric_limits<int32_t>::min();
+        for (size_t i = begin; i < end; ++i) {
+            max_weight = std::max(max_weight, _docs[i].second);
+        }
+        return {_docs[end - 1].first, max_weight};
+    }
+};
+
+struct BlockMaxFixture
+{
+    uint32_t   unpacks;
+    FakeResult result;
+    explicit BlockMaxFixture(uint32_t block_size) : unpacks(0), result() {
+        std::vector<std::pair<uint32_t, int32_t>> docs_a;
+        std::vector<std::pair<uint32_t, int32_t>> docs_b;
+        for (uint32_t docid = 1; docid < 1000; ++docid) {
+            docs_a.emplace_back(docid, (docid % 250 == 0) ? 100 : 1);
+            if (docid % 2 == 0) {
+                docs_b.emplace_back(docid, (docid % 500 == 0) ? 100 : 2);
+            }
+        }
+        MatchDataLayout layout;
+        TermFieldHandle handle_a = layout.allocTermField(0);
+        TermFieldHandle handle_b = layout.allocTermField(0);
+        MatchData::UP md = layout.createMatchData();
+        TermFieldMatchData *tfmd_a = md->resolveTermField(handle_a);
+        TermFieldMatchData *tfmd_b = md->resolveTermField(handle_b);
+        wand::Terms terms;
+        terms.emplace_back(new BlockMaxSearch(docs_a, block_size, *tfmd_a, unpacks), 1, docs_a.size(), tfmd_a);
+        terms.emplace_back(new BlockMaxSearch(docs_b, block_size, *tfmd_b, unpacks), 1, docs_b.size(), tfmd_b);
+        SharedWeakAndPriorityQueue heap(2);
+        TermFieldMatchData root;
+        auto search = ParallelWeakAndSearch::create(terms, MatchParams(heap, 0, 1.0, 1, 1000),
+                                                    RankParams(root, std::move(md)), true, false);
+        result = doSearch(*search, root);
+    }
+};
+
+TEST(ParallelWeakAndTest, require_that_block_max_weights_are_used_to_skip_blocks_that_cannot_beat_threshold)
+{
+    BlockMaxFixture plain(0);
+    BlockMaxFixture block_max(16);
+    FakeResult expect = FakeResult()
+                        .doc(1).score(1)
+                        .doc(2).score(3)
+                        .doc(4).score(3)
+                        .doc(250).score(102)
+                        .doc(500).score(200);
+    EXPECT_EQ(expect, plain.result);
+    EXPECT_EQ(expect, block_max.result);
+    EXPECT_LT(block_max.unpacks * 4, plain.unpacks);
+}
+
+struct RankScoreThresholdFixture
+{
+    WandSpec                   spec;
+    SharedWeakAndPriorityQueue heap;
+    RankScoreThreshold         threshold;
+    TermFieldMatchData         root;
+    SearchIterator::UP         search;
+    RankScoreThresholdFixture()
+        : spec(), heap(100), threshold(), root(), search()
+    {
+        spec.leaf(LeafSpec("A", 1).doc(1, 1).doc(2, 2).doc(3, 3).doc(4, 4).doc(5, 5).doc(6, 6));
+        spec.leaf(LeafSpec("B", 4).doc(1, 1).doc(3, 3).doc(5, 5));
+        MatchData::UP md = spec.createMatchData();
+        MatchData *tmp = md.get();
+        search = ParallelWeakAndSearch::create(spec.getTerms(tmp), MatchParams(heap, 0, 1.0, 1, 0, &threshold),
+                                               RankParams(root, std::move(md)), true, false);
+    }
+    FakeResult result() { return doSearch(*search, root); }
+};
+
+TEST(ParallelWeakAndTest, require_that_shared_rank_score_threshold_is_used_to_skip_documents)
+{
+    RankScoreThresholdFixture f1;
+    EXPECT_EQ(FakeResult()
+              .doc(1).score(5)
+              .doc(2).score(2)
+              .doc(3).score(15)
+              .doc(4).score(4)
+              .doc(5).score(25)
+              .doc(6).score(6), f1.result());
+    RankScoreThresholdFixture f2;
+    f2.threshold.raise(5.0);
+    EXPECT_EQ(FakeResult()
+              .doc(1).score(5)
+              .doc(3).score(15)
+              .doc(5).score(25)
+              .doc(6).score(6), f2.result());
+    RankScoreThresholdFixture f3;
+    f3.threshold.raise(5.5);
+    EXPECT_EQ(FakeResult()
+              .doc(3).score(15)
+              .doc(5).score(25)
+              .doc(6).score(6), f3.result());
+}
+
 struct BlueprintFixtureBase
 {
     WandBlueprintSpec spec;
@@ -370,6 +370,33 @@ TEST(PredicateSearchTest, require_that_subquery_bitmap_is_unpacked_to_subqueries
     EXPECT_EQ(0xffffffffffffffffUL, data.getSubqueries());
 }
 
+TEST(PredicateSearchTest, require_that_zero_constraint_documents_are_merged_with_other_hits) {
+    MyPostingList plists[] = {{{2, 0x0001ffff}, {5, 0x0001ffff}, {6, 0x00010002}}};
+    auto zero_constraint_docs = std::make_unique<MyPostingList>(
+            std::initializer_list<pair<uint32_t, uint32_t>>{{3, 0x00010001}, {4, 0x00010001}, {7, 0x00010001}});
+    TermFieldMatchDataArray array;
+    TermFieldMatchData data;
+    array.add(&data);
+    MF mf{0, 0, 0, 0, 0, 0, 0, 0};
+    CV cv{0, 0, 1, 1, 1, 1, 1, 1};
+    IR ir{0, 0, 0xffff, 1, 1, 0xffff, 0xffff, 1};
+    PredicateSearch search(&mf[0], &ir[0], 0xffff, cv, make_posting_lists_vector(plists), array,
+                           std::move(zero_constraint_docs));
+    search.initFullRange();
+    EXPECT_FALSE(search.seek(1));
+    EXPECT_EQ(2u, search.getDocId());
+    EXPECT_TRUE(search.seek(3));
+    search.unpack(3);
+    EXPECT_EQ(0xffffffffffffffffUL, data.getSubqueries());
+    EXPECT_TRUE(search.seek(4));
+    EXPECT_TRUE(search.seek(5));
+    EXPECT_FALSE(search.seek(6));
+    EXPECT_EQ(7u, search.getDocId());
+    search.unpack(7);
+    EXPECT_EQ(0xffffffffffffffffUL, data.getSubqueries());
+    EXPECT_FALSE(search.seek(8));
+    EXPECT_TRUE(search.isAtEnd());
+}
 
 }  // namespace
 
@@ -252,6 +252,26 @@ TEST(SimplePhraseTest, requireThatTermsCanBeEvaluatedInPriorityOrder) {
     EXPECT_TRUE(!search->seek(doc_no_match));
 }
 
+TEST(SimplePhraseTest, requireThatPositionsAreSkippedAcrossElements) {
+    for (bool useBlueprint: {false, true}) {
+        PhraseSearchTest test;
+        test.addTerm("foo", FakeResult()
+                     .doc(doc_match).elem(0).pos(3).pos(7).elem(2).pos(5).pos(9)
+                     .doc(doc_no_match).elem(0).pos(3).elem(1).pos(4));
+        test.addTerm("bar", FakeResult()
+                     .doc(doc_match).elem(0).pos(2).pos(9).elem(1).pos(6).elem(2).pos(10)
+                     .doc(doc_no_match).elem(0).pos(4).elem(1).pos(5));
+        test.addTerm("baz", FakeResult()
+                     .doc(doc_match).elem(1).pos(7).elem(2).pos(11)
+                     .doc(doc_no_match).elem(0).pos(6).elem(1).pos(7));
+
+        test.fetchPostings(useBlueprint);
+        unique_ptr<SearchIterator> search(test.createSearch(useBlueprint));
+        EXPECT_TRUE(search->seek(doc_match));
+        EXPECT_TRUE(!search->seek(doc_no_match));
+    }
+}
+
 TEST(SimplePhraseTest, requireThatBlueprintExposesFieldWithEstimate) {
     FieldSpec f("foo", 1, 1);
     SimplePhraseBlueprint phrase(f, false);
@@ -704,6 +704,64 @@ TEST(TermwiseEvalTest, require_that_termwise_blueprint_helper_calculates_unpack_
     EXPECT_TRUE(!helper.termwise_unpack.needUnpack(5));
 }
 
+struct MyCostBlueprint : MyBlueprint {
+    double my_cost;
+    MyCostBlueprint(const std::vector<uint32_t> &hits_in, TermFieldHandle handle, double my_cost_in)
+        : MyBlueprint(hits_in, true, handle), my_cost(my_cost_in) {}
+    FlowStats calculate_flow_stats(uint32_t docid_limit) const override {
+        double est = double(hits.size()) / docid_limit;
+        return {est, my_cost, est};
+    }
+};
+
+std::vector<uint32_t> every_other_doc() {
+    std::vector<uint32_t> hits;
+    for (uint32_t docid = 1; docid < 100; docid += 2) {
+        hits.push_back(docid);
+    }
+    return hits;
+}
+
+bool creates_termwise_search(OrBlueprint &my_or, bool strict, double termwise_limit) {
+    auto md = make_match_data();
+    md->set_termwise_limit(termwise_limit);
+    md->set_use_termwise_cost_model(true);
+    md->resolveTermField(1)->tagAsNotNeeded();
+    md->resolveTermField(2)->tagAsNotNeeded();
+    my_or.basic_plan(strict, 100);
+    return (my_or.createSearch(*md)->asString().find("TermwiseSearch") != std::string::npos);
+}
+
+TEST(TermwiseEvalTest, require_that_match_data_keeps_track_of_the_termwise_cost_model)
+{
+    auto md = make_match_data();
+    EXPECT_FALSE(md->use_termwise_cost_model());
+    md->set_use_termwise_cost_model(true);
+    EXPECT_TRUE(md->use_termwise_cost_model());
+    md->soft_reset();
+    EXPECT_FALSE(md->use_termwise_cost_model());
+}
+
+TEST(TermwiseEvalTest, require_that_cost_model_selects_termwise_evaluation_for_expensive_non_strict_children)
+{
+    OrBlueprint my_or;
+    my_or.addChild(UP(new MyCostBlueprint(every_other_doc(), 1, 10.0)));
+    my_or.addChild(UP(new MyCostBlueprint(every_other_doc(), 2, 10.0)));
+    // the termwise limit is not used with the cost model
+    EXPECT_TRUE(creates_termwise_search(my_or, false, 1.0));
+    // strict iteration of the children is needed in both cases
+    EXPECT_FALSE(creates_termwise_search(my_or, true, 0.0));
+}
+
+TEST(TermwiseEvalTest, require_that_cost_model_keeps_cheap_children_in_the_iterator_tree)
+{
+    OrBlueprint my_or;
+    my_or.addChild(UP(new MyCostBlueprint(every_other_doc(), 1, 1.0)));
+    my_or.addChild(UP(new MyCostBlueprint(every_other_doc(), 2, 1.0)));
+    EXPECT_FALSE(creates_termwise_search(my_or, false, 0.0));
+    EXPECT_FALSE(creates_termwise_search(my_or, true, 0.0));
+}
+
 class Verifier : public search::test::SearchIteratorVerifier {
 public:
     SearchIterator::UP create(bool strict) const override {
@@ -38,6 +38,7 @@ assertIndexField(const Schema::IndexField& exp,
     assertField(exp, act);
     EXPECT_EQ(exp.getAvgElemLen(), act.getAvgElemLen());
     EXPECT_EQ(exp.use_interleaved_features(), act.use_interleaved_features());
+    EXPECT_EQ(exp.use_block_doc_ids(), act.use_block_doc_ids());
 }
 
 void
@@ -152,7 +153,7 @@ TEST(SchemaTest, test_load_and_save)
         SchemaConfigurer configurer(s, src_path("dir:", "load-save-cfg"));
         EXPECT_EQ(3u, s.getNumIndexFields());
         assertIndexField(SIF("a", SDT::STRING), s.getIndexField(0));
-        assertIndexField(SIF("b", SDT::INT64), s.getIndexField(1));
+        assertIndexField(SIF("b", SDT::INT64).set_block_doc_ids(true), s.getIndexField(1));
         assertIndexField(SIF("c", SDT::STRING).set_interleaved_features(true), s.getIndexField(2));
 
         EXPECT_EQ(9u, s.getNumAttributeFields());
@@ -334,7 +335,8 @@ TEST(SchemaTest, require_that_index_field_is_loaded_with_default_values_when_pro
     ASSERT_EQ(1, index_fields.size());
     assertIndexField(SIF("foo", DataType::STRING, CollectionType::SINGLE).
                              setAvgElemLen(512).
-                             set_interleaved_features(false),
+                             set_interleaved_features(false).
+                             set_block_doc_ids(false),
                      index_fields[0]);
     assertIndexField(SIF("foo", DataType::STRING, CollectionType::SINGLE), index_fields[0]);
 }
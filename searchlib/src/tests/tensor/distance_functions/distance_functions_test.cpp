@@ -751,7 +751,7 @@ TEST(DistanceFunctionsTest, angular_can_reference_insertion_vector)
     expect_reference_insertion_vector<float>(1.0, DistanceMetric::Angular, CellType::FLOAT);
     expect_reference_insertion_vector<double>(1.0, DistanceMetric::Angular, CellType::DOUBLE);
     expect_reference_insertion_vector<Int8Float>(1.0, DistanceMetric::Angular, CellType::INT8);
-    expect_not_reference_insertion_vector<BFloat16>(1.0, DistanceMetric::Angular, CellType::BFLOAT16);
+    expect_reference_insertion_vector<BFloat16>(1.0, DistanceMetric::Angular, CellType::BFLOAT16);
 }
 
 TEST(DistanceFunctionsTest, prenormalized_angular_can_reference_insertion_vector)
@@ -767,7 +767,7 @@ TEST(DistanceFunctionsTest, euclidean_can_reference_insertion_vector)
     expect_reference_insertion_vector<float>(2.0, DistanceMetric::Euclidean, CellType::FLOAT);
     expect_reference_insertion_vector<double>(2.0, DistanceMetric::Euclidean, CellType::DOUBLE);
     expect_reference_insertion_vector<Int8Float>(2.0, DistanceMetric::Euclidean, CellType::INT8);
-    expect_not_reference_insertion_vector<BFloat16>(2.0, DistanceMetric::Euclidean, CellType::BFLOAT16);
+    expect_reference_insertion_vector<BFloat16>(2.0, DistanceMetric::Euclidean, CellType::BFLOAT16);
 }
 
 TEST(DistanceFunctionsTest, dotproduct_can_reference_insertion_vector)
@@ -786,5 +786,57 @@ TEST(DistanceFunctionsTest, hamming_can_reference_insertion_vector)
     expect_not_reference_insertion_vector<BFloat16>(2.0, DistanceMetric::Hamming, CellType::BFLOAT16);
 }
 
+TEST(DistanceFunctionsTest, bfloat16_kernels_give_same_distances_as_converting_to_float)
+{
+    std::vector<BFloat16> lhs{1.0, -2.0, 3.0, 0.5, -1.5};
+    std::vector<std::vector<BFloat16>> rhs_vectors{{1.0, -2.0, 3.0, 0.5, -1.5}, {0.0, 1.0, 0.0, 2.0, 0.25}, {-3.0, 5.0, 2.0, -0.75, 1.0}};
+    for (auto metric : {DistanceMetric::Euclidean, DistanceMetric::Angular}) {
+        auto bf16_func = make_distance_function_factory(metric, CellType::BFLOAT16)->for_query_vector(t(lhs));
+        auto float_func = (metric == DistanceMetric::Euclidean)
+            ? EuclideanDistanceFunctionFactory<float>().for_query_vector(t(lhs))
+            : AngularDistanceFunctionFactory<float>().for_query_vector(t(lhs));
+        for (const auto& rhs : rhs_vectors) {
+            EXPECT_DOUBLE_EQ(float_func->calc(t(rhs)), bf16_func->calc(t(rhs)));
+        }
+    }
+}
+
+template <typename FloatType>
+void
+expect_batch_matches_single_calc(DistanceMetric metric, CellType cell_type)
+{
+    SCOPED_TRACE(std::to_string(static_cast<int>(metric)) + " " + std::to_string(static_cast<int>(cell_type)));
+    std::vector<FloatType> lhs{1.0, -2.0, 3.0};
+    std::vector<std::vector<FloatType>> rhs_vectors{{1.0, -2.0, 3.0}, {0.0, 1.0, 0.0}, {-3.0, 5.0, 2.0}, {4.0, 0.0, -1.0}};
+    std::vector<TypedCells> rhs;
+    for (const auto& v : rhs_vectors) {
+        rhs.push_back(t(v));
+    }
+    auto factory = make_distance_function_factory(metric, cell_type);
+    std::vector<BoundDistanceFunction::UP> funcs;
+    funcs.push_back(factory->for_query_vector(t(lhs)));
+    funcs.push_back(factory->for_insertion_vector(t(lhs)));
+    for (const auto& func : funcs) {
+        std::vector<double> distances(rhs.size());
+        func->calc_batch(rhs, distances);
+        for (size_t i = 0; i < rhs.size(); ++i) {
+            EXPECT_EQ(func->calc(rhs[i]), distances[i]);
+        }
+        func->calc_batch({}, {});
+    }
+}
+
+TEST(DistanceFunctionsTest, batch_calculation_gives_same_distances_as_single_calculation)
+{
+    for (auto metric : {DistanceMetric::Euclidean, DistanceMetric::Angular, DistanceMetric::PrenormalizedAngular,
+                        DistanceMetric::InnerProduct, DistanceMetric::Dotproduct, DistanceMetric::Hamming})
+    {
+        expect_batch_matches_single_calc<float>(metric, CellType::FLOAT);
+        expect_batch_matches_single_calc<double>(metric, CellType::DOUBLE);
+        expect_batch_matches_single_calc<Int8Float>(metric, CellType::INT8);
+        expect_batch_matches_single_calc<BFloat16>(metric, CellType::BFLOAT16);
+    }
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
 
@@ -21,8 +21,12 @@
 #include <vespa/vespalib/net/http/state_explorer.h>
 #include <vespa/vespalib/util/fake_doom.h>
 #include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/stllike/asciistream.h>
+#include <algorithm>
+#include <atomic>
+#include <random>
 #include <type_traits>
 #include <vector>
 
@@ -52,7 +56,7 @@ private:
     mutable std::vector<Vector> _vectors;
     SubspaceType                _subspace_type;
     EmptySubspace               _empty;
-    mutable uint32_t            _get_vector_count;
+    mutable std::atomic<uint32_t> _get_vector_count;
     mutable uint32_t            _schedule_clear_tensor;
     mutable uint32_t            _cleared_tensor_docid;
 
@@ -218,6 +222,14 @@ public:
                                             std::move(generator),
                                             HnswIndexConfig(5, 2, 10, 0, heuristic_select_neighbors));
     }
+    void init_quantized(HnswQuantization quantization) {
+        auto generator = std::make_unique<LevelGenerator>();
+        level_generator = generator.get();
+        auto angular = std::make_unique<MyDistanceFunctionFactory>(search::tensor::make_distance_function_factory(
+                search::attribute::DistanceMetric::Angular, vespalib::eval::CellType::FLOAT));
+        index = std::make_unique<IndexType>(vectors, std::move(angular), std::move(generator),
+                                            HnswIndexConfig(5, 2, 10, 0, true, quantization));
+    }
     void add_document(uint32_t docid, uint32_t max_level = 0) {
         level_generator->level = max_level;
         index->add_document(docid);
@@ -236,6 +248,10 @@ public:
         uint32_t sz = 10;
         global_filter = GlobalFilter::create(docids, sz);
     }
+    void set_sparse_filter(std::vector<uint32_t> docids) {
+        uint32_t sz = 10;
+        global_filter = GlobalFilter::create_sparse(std::move(docids), sz, false);
+    }
     GenerationHandler::Guard take_read_guard() {
         return gen_handler.takeGuard();
     }
@@ -473,6 +489,18 @@ TYPED_TEST(HnswIndexTest, 2d_vectors_inserted_in_level_0_graph_with_simple_selec
     this->expect_top_3(2, {});
 }
 
+TYPED_TEST(HnswIndexTest, 2d_vectors_inserted_in_level_0_graph_sparse_filter_search) {
+    this->init(false);
+    for (uint32_t docid = 1; docid < 8; ++docid) {
+        this->add_document(docid);
+    }
+    this->set_sparse_filter({2,3,4,6});
+    this->expect_top_3(2, {2, 3});
+    this->expect_top_3(5, {6, 2});
+    this->expect_top_3(8, {4, 3});
+    this->expect_top_3(9, {3, 2});
+}
+
 TYPED_TEST(HnswIndexTest, 2d_vectors_inserted_in_level_0_graph_filter_first_search) {
     this->init(false);
     this->add_document(1);
@@ -952,9 +980,12 @@ TYPED_TEST(HnswIndexTest, hnsw_graph_is_compacted)
     auto link_graph_1 = make_link_graph(*this->index);
     auto link_array_refs_1 = make_link_array_refs(*this->index);
     auto level_array_refs_1 = make_level_array_refs(*this->index);
-    // Normal compaction
+    // Normal compaction, level arrays and link arrays are compacted by separate calls
     EXPECT_TRUE(this->index->consider_compact(CompactionStrategy()));
     auto mem_2 = this->commit_and_update_stat();
+    while (this->index->consider_compact(CompactionStrategy())) {
+        mem_2 = this->commit_and_update_stat();
+    }
     EXPECT_LT(mem_2.usedBytes(), mem_1.usedBytes());
     for (uint32_t i = 0; i < 10; ++i) {
         mem_1 = mem_2;
@@ -988,6 +1019,85 @@ TYPED_TEST(HnswIndexTest, hnsw_graph_is_compacted)
     }
 }
 
+TYPED_TEST(HnswIndexTest, hnsw_graph_is_compacted_incrementally)
+{
+    this->init(true);
+    this->get_vectors().clear();
+    uint32_t doc_id = 1;
+    for (uint32_t x = 0; x < 20; ++x) {
+        for (uint32_t y = 0; y < 10; ++y) {
+            this->get_vectors().set(doc_id, { float(x), float(y) });
+            ++doc_id;
+        }
+    }
+    uint32_t doc_id_end = doc_id;
+    for (doc_id = 1; doc_id < doc_id_end; ++doc_id) {
+        this->add_document(doc_id);
+    }
+    for (doc_id = 100; doc_id < doc_id_end; ++doc_id) {
+        this->remove_document(doc_id);
+    }
+    this->commit_and_update_stat();
+    auto level_array_refs_1 = make_level_array_refs(*this->index);
+    auto& graph = this->index->get_graph();
+    graph.levels_store.set_compaction_spec(CompactionSpec(true, false));
+    this->index->set_compaction_step_nodes(10);
+    EXPECT_TRUE(this->index->consider_compact(CompactionStrategy()));
+    auto progress = this->index->get_compaction_progress();
+    EXPECT_TRUE(progress.active);
+    EXPECT_EQ(10u, progress.compacted_nodes);
+    EXPECT_EQ(99u, progress.total_nodes);
+    // Graph changes between steps are handled
+    this->remove_document(50);
+    this->add_document(50);
+    auto link_graph_1 = make_link_graph(*this->index);
+    uint32_t steps = 1;
+    while (this->index->is_compacting()) {
+        EXPECT_TRUE(this->index->consider_compact(CompactionStrategy()));
+        this->commit();
+        ++steps;
+    }
+    EXPECT_EQ(10u, steps);
+    EXPECT_FALSE(this->index->get_compaction_progress().active);
+    this->commit_and_update_stat();
+    EXPECT_EQ(link_graph_1, make_link_graph(*this->index));
+    EXPECT_NE(level_array_refs_1, make_level_array_refs(*this->index));
+    EXPECT_EQ(0u, this->index->check_consistency(100));
+}
+
+TYPED_TEST(HnswIndexTest, traversal_order_used_by_compaction_is_breadth_first_from_entry_node)
+{
+    this->init(true);
+    for (uint32_t docid = 1; docid < 10; ++docid) {
+        this->add_document(docid);
+    }
+    this->commit();
+    auto& graph = this->index->get_graph();
+    auto order = this->index->make_traversal_order();
+    std::vector<uint32_t> exp_nodeids;
+    for (uint32_t nodeid = 1; nodeid < graph.size(); ++nodeid) {
+        if (graph.get_levels_ref(nodeid).valid()) {
+            exp_nodeids.push_back(nodeid);
+        }
+    }
+    ASSERT_EQ(exp_nodeids.size(), order.size());
+    EXPECT_EQ(graph.get_entry_node().nodeid, order[0]);
+    // Each node is linked to from a node earlier in the order, except the first node of each component.
+    std::vector<uint32_t> position(graph.size(), 0);
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        position[order[i]] = i;
+    }
+    for (uint32_t i = 1; i < order.size(); ++i) {
+        bool linked_from_earlier = false;
+        for (uint32_t neighbor : graph.get_link_array(order[i], 0)) {
+            linked_from_earlier |= (position[neighbor] < i);
+        }
+        EXPECT_TRUE(linked_from_earlier);
+    }
+    std::sort(order.begin(), order.end());
+    EXPECT_EQ(exp_nodeids, order);
+}
+
 TYPED_TEST(HnswIndexTest, hnsw_graph_can_be_saved_and_loaded)
 {
     this->init(false);
@@ -1007,6 +1117,92 @@ TYPED_TEST(HnswIndexTest, search_during_remove)
     this->expect_top_3_by_docid("{0, 0}", {0, 0}, {7});
 }
 
+TYPED_TEST(HnswIndexTest, quantized_vectors_are_used_for_traversal_and_candidates_are_reranked)
+{
+    for (auto quantization : {HnswQuantization::INT8, HnswQuantization::BINARY}) {
+        SCOPED_TRACE(quantization == HnswQuantization::INT8 ? "int8" : "binary");
+        this->init_quantized(quantization);
+        EXPECT_TRUE(this->index->get_quantized_vectors().enabled());
+        for (uint32_t docid = 1; docid < 10; ++docid) {
+            this->add_document(docid);
+        }
+        auto codes = this->index->get_quantized_vectors().get(this->get_single_nodeid(5));
+        ASSERT_EQ((quantization == HnswQuantization::INT8) ? 2 : 1, codes.size);
+        auto code = codes.template unsafe_typify<vespalib::eval::Int8Float>();
+        if (quantization == HnswQuantization::INT8) {
+            EXPECT_EQ(127, code[0].get_bits());
+            EXPECT_EQ(48, code[1].get_bits());
+        } else {
+            EXPECT_EQ(int8_t(0xc0), code[0].get_bits());
+        }
+        // closest angles to {5, 1} are {7, 2}, {8, 3} and {3, 2}
+        this->expect_top_3_by_docid("{5, 1}", {5, 1}, {2, 5, 6});
+
+        std::vector<float> qv = {5, 1};
+        vespalib::eval::TypedCells qv_cells(std::span<const float>(qv.data(), qv.size()));
+        auto df = this->index->distance_function_factory().for_query_vector(qv_cells);
+        auto hits = this->index->find_top_k(3, *df, 100, 0.0, this->_doom->get_doom(), 10000.0);
+        for (const auto& hit : hits) {
+            // reranked distances are full precision
+            EXPECT_DOUBLE_EQ(df->calc(this->vectors.get_vector(hit.docid, 0)), hit.distance);
+        }
+    }
+}
+
+TYPED_TEST(HnswIndexTest, search_stats_count_visited_nodes_and_distance_computations)
+{
+    this->init(false);
+    for (uint32_t docid = 1; docid < 10; ++docid) {
+        this->add_document(docid);
+    }
+    std::vector<float> qv = {5, 1};
+    vespalib::eval::TypedCells qv_cells(std::span<const float>(qv.data(), qv.size()));
+    auto df = this->index->distance_function_factory().for_query_vector(qv_cells);
+    NearestNeighborIndex::SearchStats stats;
+    auto hits = this->index->find_top_k(3, *df, 100, 0.0, this->_doom->get_doom(), 10000.0, &stats);
+    EXPECT_EQ(3u, hits.size());
+    // explore_k is larger than the graph, so all reachable nodes are visited once
+    auto reachable = this->index->count_reachable_nodes();
+    EXPECT_EQ(reachable.first, stats.visited_nodes);
+    EXPECT_EQ(stats.visited_nodes, stats.distance_computations);
+    // each distance computation reads a 2d float vector, in addition some link arrays are read
+    EXPECT_GT(stats.visited_bytes, stats.distance_computations * 2 * sizeof(float));
+}
+
+TYPED_TEST(HnswIndexTest, documents_can_be_added_in_parallel)
+{
+    constexpr uint32_t num_docs = 2000;
+    constexpr uint32_t num_threads = 4;
+    this->init(true);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(0.0, 100.0);
+    std::vector<uint32_t> docids;
+    for (uint32_t docid = 1; docid <= num_docs; ++docid) {
+        this->vectors.set(docid, {dist(gen), dist(gen)});
+        docids.push_back(docid);
+    }
+    EXPECT_TRUE(this->index->can_add_documents_in_parallel());
+    vespalib::ThreadStackExecutor executor(num_threads);
+    this->index->add_documents_in_parallel(docids, executor, num_threads);
+    this->commit();
+    EXPECT_EQ(num_docs, this->get_active_nodes());
+    EXPECT_TRUE(this->index->check_link_symmetry());
+    auto reachable = this->index->count_reachable_nodes();
+    EXPECT_TRUE(reachable.second);
+    EXPECT_LT(num_docs - reachable.first, num_docs / 100);
+    auto df = this->index->distance_function_factory().for_query_vector(this->vectors.get_vector(1, 0));
+    auto hits = this->index->find_top_k(1, *df, 100, 0.0, this->_doom->get_doom(), 10000.0);
+    ASSERT_EQ(1u, hits.size());
+    EXPECT_EQ(1u, hits[0].docid);
+
+    Slime actualSlime;
+    SlimeInserter inserter(actualSlime);
+    this->index->make_state_explorer()->get_state(inserter, true);
+    const auto &bulk_build = actualSlime.get()["bulk_build"];
+    EXPECT_EQ(0, bulk_build["active_threads"].asLong());
+    EXPECT_EQ(num_docs, bulk_build["added_documents"].asLong());
+}
+
 TYPED_TEST(HnswIndexTest, inconsistent_index)
 {
     this->init(false);
@@ -0,0 +1,218 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/searchlib/queryeval/global_filter.h>
+#include <vespa/searchlib/tensor/distance_function_factory.h>
+#include <vespa/searchlib/tensor/doc_vector_access.h>
+#include <vespa/searchlib/tensor/empty_subspace.h>
+#include <vespa/searchlib/tensor/ivf_pq_index.h>
+#include <vespa/searchlib/tensor/prepare_result.h>
+#include <vespa/searchlib/tensor/subspace_type.h>
+#include <vespa/searchlib/tensor/vector_bundle.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/fake_doom.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <limits>
+#include <vector>
+
+using search::attribute::DistanceMetric;
+using search::attribute::IvfPqIndexParams;
+using search::queryeval::GlobalFilter;
+using vespalib::GenerationHandler;
+using vespalib::eval::CellType;
+using vespalib::eval::TypedCells;
+using vespalib::eval::ValueType;
+using namespace search::tensor;
+
+using Vector = std::vector<float>;
+using DocidVector = std::vector<uint32_t>;
+
+class MyDocVectorAccess : public DocVectorAccess {
+    std::vector<Vector> _vectors;
+    SubspaceType        _subspace_type;
+    EmptySubspace       _empty;
+public:
+    MyDocVectorAccess()
+        : _vectors(),
+          _subspace_type(ValueType::make_type(CellType::FLOAT, {{"dims", 2}})),
+          _empty(_subspace_type)
+    {
+    }
+    void set(uint32_t docid, const Vector& vec) {
+        if (docid >= _vectors.size()) {
+            _vectors.resize(docid + 1);
+        }
+        _vectors[docid] = vec;
+    }
+    void clear(uint32_t docid) {
+        if (docid < _vectors.size()) {
+            _vectors[docid].clear();
+        }
+    }
+    TypedCells get_vector(uint32_t docid, uint32_t subspace) const noexcept override {
+        auto bundle = get_vectors(docid);
+        return (subspace < bundle.subspaces()) ? bundle.cells(subspace) : _empty.cells();
+    }
+    VectorBundle get_vectors(uint32_t docid) const noexcept override {
+        if (docid >= _vectors.size()) {
+            return {nullptr, 0, _subspace_type};
+        }
+        const auto& vec = _vectors[docid];
+        return {vec.data(), uint32_t(vec.size() / _subspace_type.size()), _subspace_type};
+    }
+};
+
+class IvfPqIndexTest : public ::testing::Test {
+protected:
+    MyDocVectorAccess           vectors;
+    GenerationHandler           gen_handler;
+    std::unique_ptr<IvfPqIndex> index;
+    vespalib::FakeDoom          doom;
+
+    IvfPqIndexTest();
+    ~IvfPqIndexTest() override;
+    void init(uint32_t num_lists, uint32_t num_probes, uint32_t min_training_size) {
+        index = std::make_unique<IvfPqIndex>(vectors, make_distance_function_factory(DistanceMetric::Euclidean, CellType::FLOAT),
+                                             DistanceMetric::Euclidean, IvfPqIndexParams(num_lists, 0, num_probes, min_training_size));
+    }
+    void commit() {
+        index->assign_generation(gen_handler.getCurrentGeneration());
+        gen_handler.incGeneration();
+        index->reclaim_memory(gen_handler.get_oldest_used_generation());
+    }
+    void add_document(uint32_t docid, const Vector& vec) {
+        vectors.set(docid, vec);
+        index->add_document(docid);
+        commit();
+    }
+    void remove_document(uint32_t docid) {
+        index->remove_document(docid);
+        vectors.clear(docid);
+        commit();
+    }
+    // Adds documents 1-100 as 4 clusters of 25 documents on a 5x5 grid, centered around the corners of a 100x100 square
+    void add_clusters() {
+        for (uint32_t docid = 1; docid <= 100; ++docid) {
+            uint32_t cluster = (docid - 1) / 25;
+            uint32_t i = (docid - 1) % 25;
+            add_document(docid, {float(100 * (cluster % 2) + i % 5), float(100 * (cluster / 2) + i / 5)});
+        }
+    }
+    DocidVector find(uint32_t k, const Vector& query, const GlobalFilter* filter = nullptr) {
+        TypedCells cells(query.data(), CellType::FLOAT, query.size());
+        auto df = index->distance_function_factory().for_query_vector(cells);
+        double threshold = std::numeric_limits<double>::max();
+        auto neighbors = (filter != nullptr)
+            ? index->find_top_k_with_filter(k, *df, *filter, false, 0.01, 10, 0.0, doom.get_doom(), threshold)
+            : index->find_top_k(k, *df, 10, 0.0, doom.get_doom(), threshold);
+        DocidVector result;
+        for (const auto& neighbor : neighbors) {
+            result.push_back(neighbor.docid);
+        }
+        return result;
+    }
+};
+
+IvfPqIndexTest::IvfPqIndexTest()
+    : vectors(),
+      gen_handler(),
+      index(),
+      doom()
+{
+}
+
+IvfPqIndexTest::~IvfPqIndexTest() = default;
+
+TEST_F(IvfPqIndexTest, untrained_index_is_searched_exactly)
+{
+    init(4, 1, 1000);
+    add_document(1, {0, 0});
+    add_document(2, {5, 5});
+    add_document(3, {1, 0});
+    add_document(4, {9, 9});
+    EXPECT_FALSE(index->is_trained());
+    EXPECT_EQ(4u, index->num_docs());
+    EXPECT_EQ((DocidVector{1, 3}), find(2, {0, 0}));
+    EXPECT_EQ((DocidVector{4}), find(1, {10, 10}));
+}
+
+TEST_F(IvfPqIndexTest, index_is_trained_when_min_training_size_is_reached)
+{
+    init(4, 1, 100);
+    for (uint32_t docid = 1; docid < 100; ++docid) {
+        add_document(docid, {float(docid), 0});
+    }
+    EXPECT_FALSE(index->is_trained());
+    EXPECT_EQ(99u, index->num_untrained_docs());
+    add_document(100, {100, 0});
+    EXPECT_TRUE(index->is_trained());
+    EXPECT_EQ(100u, index->num_docs());
+    EXPECT_EQ(0u, index->num_untrained_docs());
+    EXPECT_EQ(4u, index->num_lists());
+    EXPECT_EQ(1u, index->num_subquantizers());
+    EXPECT_EQ(0u, index->check_consistency(101));
+}
+
+TEST_F(IvfPqIndexTest, number_of_lists_is_chosen_from_training_size_when_not_specified)
+{
+    init(0, 1, 100);
+    add_clusters();
+    EXPECT_TRUE(index->is_trained());
+    EXPECT_EQ(10u, index->num_lists());
+}
+
+TEST_F(IvfPqIndexTest, closest_lists_are_probed)
+{
+    init(4, 1, 100);
+    add_clusters();
+    EXPECT_EQ((DocidVector{1, 2, 6}), find(3, {0, 0}));
+    EXPECT_EQ((DocidVector{76, 77, 81}), find(3, {100, 100}));
+}
+
+TEST_F(IvfPqIndexTest, more_lists_are_probed_when_global_filter_leaves_too_few_candidates)
+{
+    init(4, 1, 100);
+    add_clusters();
+    auto filter = GlobalFilter::create(DocidVector{30, 80, 99}, 101);
+    EXPECT_EQ((DocidVector{30, 80}), find(2, {0, 0}, filter.get()));
+    EXPECT_EQ((DocidVector{99}), find(1, {104, 104}, filter.get()));
+}
+
+TEST_F(IvfPqIndexTest, removed_documents_are_not_found)
+{
+    init(4, 1, 100);
+    add_clusters();
+    remove_document(1);
+    remove_document(2);
+    EXPECT_EQ(98u, index->num_docs());
+    EXPECT_EQ(0u, index->check_consistency(101));
+    EXPECT_EQ((DocidVector{6, 7}), find(2, {0, 0}));
+    add_document(1, {0, 0});
+    EXPECT_EQ(99u, index->num_docs());
+    EXPECT_EQ((DocidVector{1, 6}), find(2, {0, 0}));
+}
+
+TEST_F(IvfPqIndexTest, document_can_be_added_in_two_phases)
+{
+    init(4, 1, 100);
+    add_clusters();
+    vectors.set(101, {50, 50});
+    auto prepared = index->prepare_add_document(101, vectors.get_vectors(101), gen_handler.takeGuard());
+    index->complete_add_document(101, std::move(prepared));
+    commit();
+    EXPECT_EQ(101u, index->num_docs());
+    EXPECT_EQ(0u, index->check_consistency(102));
+    EXPECT_EQ((DocidVector{101}), find(1, {50, 50}));
+}
+
+TEST_F(IvfPqIndexTest, updated_document_is_moved_to_list_of_new_vector)
+{
+    init(4, 1, 100);
+    add_clusters();
+    add_document(1, {100, 0});
+    EXPECT_EQ(100u, index->num_docs());
+    EXPECT_EQ((DocidVector{1, 26}), find(2, {100, 0}));
+    EXPECT_EQ((DocidVector{2, 6}), find(2, {0, 0}));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -11,6 +11,7 @@
 #include <vespa/vespalib/util/destructor_callbacks.h>
 #include <vespa/fnet/transport.h>
 #include <vespa/fastos/file.h>
+#include <filesystem>
 #include <thread>
 
 #include <vespa/log/log.h>
@@ -1004,4 +1005,56 @@ TEST(TransactionLogClientTest, test_truncation_after_short_read) {
     EXPECT_EQ(2u, countFiles(dir));
 }
 
+TEST(TransactionLogClientTest, test_commit_latency_with_fsync_and_preallocation) {
+    const unsigned int NUM_PACKETS = 50;
+    const unsigned int NUM_ENTRIES = 4;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+    test::DirectoryHandler topdir("test12");
+    std::string domain("latency");
+    std::string tlsspec("tcp/localhost:18377");
+    DomainConfig domainConfig = createDomainConfig(0x1000000).setFSyncOnCommit(true).setPreallocateSize(1_Mi);
+    DummyFileHeaderContext fileHeaderContext;
+    {
+        TLS tlss(topdir.getDir(), 18377, ".", fileHeaderContext, domainConfig);
+        TransLogClient tls(tlss.transport, tlsspec);
+        createDomainTest(tls, domain, 0);
+        fillDomainTest(tlss.tls, domain, NUM_PACKETS, NUM_ENTRIES);
+        auto stats = tlss.tls.getDomainStats()[domain].commitLatency;
+        EXPECT_LE(NUM_PACKETS, stats.commits);
+        EXPECT_LT(0u, stats.syncs);
+        EXPECT_GE(stats.commits, stats.syncs);
+        uint64_t bucketed = 0;
+        for (uint64_t commits : stats.buckets) {
+            bucketed += commits;
+        }
+        EXPECT_EQ(stats.commits, bucketed);
+        EXPECT_LE(stats.max_latency, stats.total_latency);
+    }
+    {
+        TLS tlss(topdir.getDir(), 18377, ".", fileHeaderContext, domainConfig);
+        TransLogClient tls(tlss.transport, tlsspec);
+        auto s1 = openDomainTest(tls, domain);
+        checkFilledDomainTest(*s1, TOTAL_NUM_ENTRIES);
+        DomainInfo info = tlss.tls.getDomainStats()[domain];
+        for (const auto &part : info.parts) {
+            EXPECT_EQ(part.byteSize, std::filesystem::file_size(part.file));
+        }
+    }
+}
+
+TEST(TransactionLogClientTest, test_commit_latency_buckets) {
+    EXPECT_EQ(0u, CommitLatencyStats::bucket(0.0));
+    EXPECT_EQ(0u, CommitLatencyStats::bucket(0.0005));
+    EXPECT_EQ(1u, CommitLatencyStats::bucket(0.0006));
+    EXPECT_EQ(CommitLatencyStats::NUM_BUCKETS - 1, CommitLatencyStats::bucket(10.0));
+    CommitLatencyStats stats;
+    stats.add(0.001);
+    stats.add(0.003);
+    EXPECT_EQ(2u, stats.commits);
+    EXPECT_DOUBLE_EQ(0.004, stats.total_latency);
+    EXPECT_DOUBLE_EQ(0.003, stats.max_latency);
+    EXPECT_EQ(1u, stats.buckets[1]);
+    EXPECT_EQ(1u, stats.buckets[3]);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,111 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/common/flush_token.h>
+#include <vespa/searchlib/util/posting_priority_queue_merger.hpp>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+
+using search::FlushToken;
+using search::PostingPriorityQueueMerger;
+
+namespace {
+
+using Values = std::vector<uint32_t>;
+
+struct MyWriter {
+    Values _values;
+};
+
+class MyReader {
+    Values _values;
+    size_t _pos;
+public:
+    explicit MyReader(Values values)
+        : _values(std::move(values)),
+          _pos(0)
+    {
+    }
+    bool isValid() const noexcept { return _pos < _values.size(); }
+    void read() { ++_pos; }
+    void write(MyWriter& writer) { writer._values.push_back(_values[_pos]); }
+    bool operator<(const MyReader& rhs) const noexcept { return _values[_pos] < rhs._values[rhs._pos]; }
+};
+
+}
+
+class PostingPriorityQueueMergerTest : public ::testing::TestWithParam<uint32_t>
+{
+protected:
+    std::vector<std::unique_ptr<MyReader>> _readers;
+    PostingPriorityQueueMerger<MyReader, MyWriter> _merger;
+    MyWriter _writer;
+    Values _expected;
+
+    PostingPriorityQueueMergerTest();
+    ~PostingPriorityQueueMergerTest() override;
+
+    void setup(uint32_t num_readers, uint32_t tournament_limit) {
+        for (uint32_t i = 0; i < num_readers; ++i) {
+            // Readers of different lengths interleaving their values
+            Values values;
+            for (uint32_t j = 0; j < 1 + (i * 7) % 11; ++j) {
+                values.push_back(i + j * num_readers);
+            }
+            _expected.insert(_expected.end(), values.begin(), values.end());
+            _readers.emplace_back(std::make_unique<MyReader>(std::move(values)));
+            _merger.initialAdd(_readers.back().get());
+        }
+        std::sort(_expected.begin(), _expected.end());
+        _merger.setup(4);
+        _merger.set_tournament_limit(tournament_limit);
+    }
+
+    void merge(uint32_t merge_chunk) {
+        FlushToken flush_token;
+        _merger.set_merge_chunk(merge_chunk);
+        while (!_merger.empty()) {
+            _merger.merge(_writer, flush_token);
+        }
+    }
+};
+
+PostingPriorityQueueMergerTest::PostingPriorityQueueMergerTest()
+    : ::testing::TestWithParam<uint32_t>(),
+      _readers(),
+      _merger(),
+      _writer(),
+      _expected()
+{
+}
+
+PostingPriorityQueueMergerTest::~PostingPriorityQueueMergerTest() = default;
+
+INSTANTIATE_TEST_SUITE_P(PostingPriorityQueueMergerMultiTest,
+                         PostingPriorityQueueMergerTest,
+                         testing::Values(1, 2, 3, 4, 5, 16, 17, 40),
+                         testing::PrintToStringParamName());
+
+TEST_P(PostingPriorityQueueMergerTest, sorted_vector_merge_gives_sorted_output)
+{
+    setup(GetParam(), 0);
+    merge(3);
+    EXPECT_EQ(_expected, _writer._values);
+}
+
+TEST_P(PostingPriorityQueueMergerTest, tournament_merge_gives_sorted_output)
+{
+    setup(GetParam(), 1);
+    EXPECT_TRUE(_merger.uses_tournament());
+    merge(3);
+    EXPECT_EQ(_expected, _writer._values);
+}
+
+TEST_P(PostingPriorityQueueMergerTest, tournament_merge_in_single_chunk_gives_sorted_output)
+{
+    setup(GetParam(), 1);
+    merge(1000);
+    EXPECT_EQ(_expected, _writer._values);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -23,10 +23,12 @@ Config::Config(BasicType bt, CollectionType ct, bool fastSearch_) noexcept
       _fastAccess(false),
       _mutable(false),
       _paged(false),
+      _tiered_memory(false),
       _distance_metric(DistanceMetric::Euclidean),
       _match(Match::UNCASED),
       _dictionary(),
       _maxUnCommittedMemory(MAX_UNCOMMITTED_MEMORY),
+      _bitvector_search_cache_max_memory(0),
       _growStrategy(),
       _compactionStrategy(),
       _predicateParams(),
@@ -51,7 +53,9 @@ Config::operator==(const Config &b) const noexcept
            _fastAccess == b._fastAccess &&
            _mutable == b._mutable &&
            _paged == b._paged &&
+           _tiered_memory == b._tiered_memory &&
            _maxUnCommittedMemory == b._maxUnCommittedMemory &&
+           _bitvector_search_cache_max_memory == b._bitvector_search_cache_max_memory &&
            _match == b._match &&
            _dictionary == b._dictionary &&
            _growStrategy == b._growStrategy &&
@@ -37,6 +37,7 @@ public:
     CollectionType collectionType()       const noexcept { return _type; }
     bool fastSearch()                     const noexcept { return _fastSearch; }
     bool paged()                          const noexcept { return _paged; }
+    bool tiered_memory()                  const noexcept { return _tiered_memory; }
     const PredicateParams &predicateParams() const noexcept { return _predicateParams; }
     const vespalib::eval::ValueType & tensorType() const noexcept { return _tensorType; }
     DistanceMetric distance_metric() const noexcept { return _distance_metric; }
@@ -84,6 +85,11 @@ public:
     Config & setIsFilter(bool isFilter) { _isFilter = isFilter; return *this; }
     Config & setMutable(bool isMutable) { _mutable = isMutable; return *this; }
     Config & setPaged(bool paged_in) { _paged = paged_in; return *this; }
+    /**
+     * Enable tiered memory, where data store buffers that are not changed
+     * for a while are migrated to file backed memory. Ignored for paged attributes.
+     */
+    Config & set_tiered_memory(bool tiered_memory_in) { _tiered_memory = tiered_memory_in; return *this; }
     Config & setFastAccess(bool v) { _fastAccess = v; return *this; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config & setCompactionStrategy(const CompactionStrategy &compactionStrategy) {
@@ -97,6 +103,12 @@ public:
 
     uint64_t getMaxUnCommittedMemory() const noexcept { return _maxUnCommittedMemory; }
     Config & setMaxUnCommittedMemory(uint64_t value) { _maxUnCommittedMemory = value; return *this; }
+    /**
+     * Max memory used for caching bit vectors for expensive search terms on a filter attribute.
+     * 0 means that no bit vectors are cached.
+     */
+    uint64_t bitvector_search_cache_max_memory() const noexcept { return _bitvector_search_cache_max_memory; }
+    Config & set_bitvector_search_cache_max_memory(uint64_t value) { _bitvector_search_cache_max_memory = value; return *this; }
     std::string type_to_string() const;
 
 private:
@@ -107,10 +119,12 @@ private:
     bool           _fastAccess : 1;
     bool           _mutable : 1;
     bool           _paged : 1;
+    bool           _tiered_memory : 1;
     DistanceMetric                 _distance_metric;
     Match                          _match;
     DictionaryConfig               _dictionary;
     uint64_t                       _maxUnCommittedMemory;
+    uint64_t                       _bitvector_search_cache_max_memory;
     GrowStrategy                   _growStrategy;
     CompactionStrategy             _compactionStrategy;
     PredicateParams                _predicateParams;
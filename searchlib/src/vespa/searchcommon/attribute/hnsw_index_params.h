@@ -3,12 +3,18 @@
 #pragma once
 
 #include "distance_metric.h"
+#include "hnsw_quantization.h"
+#include "ivf_pq_index_params.h"
+#include <optional>
 
 namespace search::attribute {
 
 /**
  * Configuration parameters for a hnsw index used together with a 1-dimensional indexed tensor
  * for approximate nearest neighbor search.
+ *
+ * When ivf-pq parameters are present, an ivf-pq index is used instead of the hnsw index,
+ * and only the distance metric and multi-threaded indexing settings apply to it.
  */
 class HnswIndexParams {
 private:
@@ -17,28 +23,38 @@ private:
     // This is always the same as in the attribute config, and is duplicated here to simplify usage.
     DistanceMetric _distance_metric;
     bool _multi_threaded_indexing;
+    HnswQuantization _quantization;
+    std::optional<IvfPqIndexParams> _ivf_pq;
 
 public:
     HnswIndexParams(uint32_t max_links_per_node_in,
                     uint32_t neighbors_to_explore_at_insert_in,
                     DistanceMetric distance_metric_in,
-                    bool multi_threaded_indexing_in = false) noexcept
+                    bool multi_threaded_indexing_in = false,
+                    HnswQuantization quantization_in = HnswQuantization::NONE,
+                    std::optional<IvfPqIndexParams> ivf_pq_in = std::nullopt) noexcept
             : _max_links_per_node(max_links_per_node_in),
               _neighbors_to_explore_at_insert(neighbors_to_explore_at_insert_in),
               _distance_metric(distance_metric_in),
-              _multi_threaded_indexing(multi_threaded_indexing_in)
+              _multi_threaded_indexing(multi_threaded_indexing_in),
+              _quantization(quantization_in),
+              _ivf_pq(ivf_pq_in)
     {}
 
     uint32_t max_links_per_node() const { return _max_links_per_node; }
     uint32_t neighbors_to_explore_at_insert() const { return _neighbors_to_explore_at_insert; }
     DistanceMetric distance_metric() const { return _distance_metric; }
     bool multi_threaded_indexing() const { return _multi_threaded_indexing; }
+    HnswQuantization quantization() const { return _quantization; }
+    const std::optional<IvfPqIndexParams>& ivf_pq() const { return _ivf_pq; }
 
     bool operator==(const HnswIndexParams& rhs) const {
         return (_max_links_per_node == rhs._max_links_per_node &&
                 _neighbors_to_explore_at_insert == rhs._neighbors_to_explore_at_insert &&
                 _distance_metric == rhs._distance_metric &&
-                _multi_threaded_indexing == rhs._multi_threaded_indexing);
+                _multi_threaded_indexing == rhs._multi_threaded_indexing &&
+                _quantization == rhs._quantization &&
+                _ivf_pq == rhs._ivf_pq);
     }
 };
 
@@ -0,0 +1,14 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::attribute {
+
+/*
+ * Quantization of the compact vector copy used by a hnsw index for graph traversal at query time.
+ */
+enum class HnswQuantization : uint8_t { NONE, INT8, BINARY };
+
+}
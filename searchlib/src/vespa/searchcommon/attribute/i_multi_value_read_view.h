@@ -17,6 +17,12 @@ class IMultiValueReadView {
 public:
     virtual ~IMultiValueReadView() = default;
     virtual std::span<const MultiValueType> get_values(uint32_t docid) const = 0;
+    /*
+     * Hint that the values for the given documents will soon be read by
+     * get_values(), allowing the memory access to be started early.
+     * The default implementation does nothing.
+     */
+    virtual void prefetch(std::span<const uint32_t> docids) const { (void) docids; }
 };
 
 /**
@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 
+namespace vespalib { class ObjectVisitor; }
 namespace search::fef { class TermFieldMatchData; }
 namespace search::queryeval {
     class SearchIterator;
@@ -56,6 +57,12 @@ public:
     virtual const QueryTermUCS4 * queryTerm() const = 0;
     virtual const std::string &attributeName() const = 0;
 
+    /**
+     * Visit details about how this search context matches, used when
+     * dumping the query execution plan. Visits nothing by default.
+     **/
+    virtual void visitMembers(vespalib::ObjectVisitor &visitor) const { (void) visitor; }
+
     int32_t find(DocId docId, int32_t elementId, int32_t &weight) const { return onFind(docId, elementId, weight); }
     int32_t find(DocId docId, int32_t elementId) const { return onFind(docId, elementId); }
     template<typename SC>
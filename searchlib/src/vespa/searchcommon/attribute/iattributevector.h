@@ -7,6 +7,7 @@
 #include <vespa/searchcommon/common/iblobconverter.h>
 #include <vespa/searchlib/common/sortspec.h>
 #include <vespa/vespalib/datastore/atomic_entry_ref.h>
+#include <memory>
 #include <ostream>
 #include <span>
 #include <vector>
@@ -27,6 +28,7 @@ class IMultiValueAttribute;
 class ISearchContext;
 class ISortBlobWriter;
 class SearchContextParams;
+class ValueStatistics;
 
 /**
  * This class is used to store a value and a weight.
@@ -468,6 +470,14 @@ public:
         return EnumRefs();
     }
 
+    /**
+     * Returns statistics over the values of this attribute, used to estimate
+     * hits when a search context is not able to, or nullptr if not available.
+     */
+    virtual std::shared_ptr<const ValueStatistics> get_value_statistics() const {
+        return {};
+    }
+
 };
 
 }
@@ -0,0 +1,47 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::attribute {
+
+/**
+ * Configuration parameters for an ivf-pq index, used instead of a hnsw index
+ * together with a 1-dimensional indexed tensor for approximate nearest neighbor search.
+ *
+ * A value of 0 for num_lists or num_subquantizers means that the index chooses it from
+ * the number of training vectors or the vector size.
+ */
+class IvfPqIndexParams {
+private:
+    uint32_t _num_lists;
+    uint32_t _num_subquantizers;
+    uint32_t _num_probes;
+    uint32_t _min_training_size;
+
+public:
+    IvfPqIndexParams(uint32_t num_lists_in,
+                     uint32_t num_subquantizers_in,
+                     uint32_t num_probes_in,
+                     uint32_t min_training_size_in) noexcept
+        : _num_lists(num_lists_in),
+          _num_subquantizers(num_subquantizers_in),
+          _num_probes(num_probes_in),
+          _min_training_size(min_training_size_in)
+    {}
+
+    uint32_t num_lists() const { return _num_lists; }
+    uint32_t num_subquantizers() const { return _num_subquantizers; }
+    uint32_t num_probes() const { return _num_probes; }
+    uint32_t min_training_size() const { return _min_training_size; }
+
+    bool operator==(const IvfPqIndexParams& rhs) const {
+        return (_num_lists == rhs._num_lists &&
+                _num_subquantizers == rhs._num_subquantizers &&
+                _num_probes == rhs._num_probes &&
+                _min_training_size == rhs._min_training_size);
+    }
+};
+
+}
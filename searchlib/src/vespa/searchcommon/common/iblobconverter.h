@@ -4,6 +4,7 @@
 
 #include <vespa/vespalib/util/buffer.h>
 #include <memory>
+#include <string>
 
 namespace search::common {
 
@@ -15,6 +16,10 @@ public:
     using ConstBufferRef = vespalib::ConstBufferRef;
     virtual ~BlobConverter() = default;
     ConstBufferRef convert(const ConstBufferRef & src) const { return onConvert(src); }
+    // Converters with the same non-empty id convert equally, allowing converted values to be reused
+    virtual std::string id() const { return {}; }
+    // Returns a converter doing the same conversion, or nullptr if not supported
+    virtual UP clone() const { return {}; }
 private:
     virtual ConstBufferRef onConvert(const ConstBufferRef & src) const = 0;
 };
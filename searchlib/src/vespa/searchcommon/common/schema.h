@@ -74,6 +74,7 @@ public:
     private:
         uint32_t _avgElemLen;
         bool _interleaved_features;
+        bool _block_doc_ids;
 
     public:
         IndexField(std::string_view name, DataType dt) noexcept;
@@ -92,12 +93,17 @@ public:
             _interleaved_features = value;
             return *this;
         }
+        IndexField &set_block_doc_ids(bool value) noexcept {
+            _block_doc_ids = value;
+            return *this;
+        }
 
         void write(vespalib::asciistream &os,
                    std::string_view prefix) const override;
 
         uint32_t getAvgElemLen() const noexcept { return _avgElemLen; }
         bool use_interleaved_features() const noexcept { return _interleaved_features; }
+        bool use_block_doc_ids() const noexcept { return _block_doc_ids; }
 
         bool operator==(const IndexField &rhs) const noexcept;
         bool operator!=(const IndexField &rhs) const noexcept;
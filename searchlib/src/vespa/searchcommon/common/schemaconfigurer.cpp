@@ -113,7 +113,8 @@ SchemaBuilder::build(const IndexschemaConfig &cfg, Schema &schema)
         schema.addIndexField(Schema::IndexField(f.name, convertIndexDataType(f.datatype),
                                                 convertIndexCollectionType(f.collectiontype)).
                 setAvgElemLen(f.averageelementlen).
-                set_interleaved_features(f.interleavedfeatures));
+                set_interleaved_features(f.interleavedfeatures).
+                set_block_doc_ids(f.blockdocids));
     }
     for (size_t i = 0; i < cfg.fieldset.size(); ++i) {
         const IndexschemaConfig::Fieldset &fs = cfg.fieldset[i];
@@ -6,6 +6,9 @@
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/vespalib/objects/visit.hpp>
 #include <xxhash.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 using namespace search::expression;
 
@@ -28,6 +31,79 @@ createAndEnsureWanted(const ResultNode & result) {
     }
 }
 
+using Centroid = QuantileAggregationResult::Centroid;
+using CentroidList = QuantileAggregationResult::CentroidList;
+
+// Sort the centroids and merge neighbours as long as the merged
+// centroid stays within the size limit for the quantile range it
+// covers. The limit is proportional to sqrt(q * (1 - q)), which keeps
+// the tails accurate and bounds the number of centroids to about
+// COMPRESSION.
+void
+compressCentroids(CentroidList & centroids)
+{
+    if (centroids.size() <= 1) {
+        return;
+    }
+    std::sort(centroids.begin(), centroids.end(), [](const Centroid & a, const Centroid & b) {
+        return (a.mean < b.mean) || ((a.mean == b.mean) && (a.weight < b.weight));
+    });
+    double total(0);
+    for (const Centroid & c : centroids) {
+        total += c.weight;
+    }
+    size_t last(0);
+    double weightSoFar(0);
+    for (size_t i(1); i < centroids.size(); i++) {
+        Centroid & cur = centroids[last];
+        const Centroid & next = centroids[i];
+        double proposed = cur.weight + next.weight;
+        double q0 = weightSoFar / total;
+        double q2 = (weightSoFar + proposed) / total;
+        double limit = M_PI * total * std::sqrt(std::min(q0 * (1 - q0), q2 * (1 - q2))) / QuantileAggregationResult::COMPRESSION;
+        if (proposed <= limit) {
+            cur.mean += (next.mean - cur.mean) * next.weight / proposed;
+            cur.weight += next.weight;
+        } else {
+            weightSoFar += cur.weight;
+            centroids[++last] = next;
+        }
+    }
+    centroids.erase(centroids.begin() + last + 1, centroids.end());
+}
+
+// Interpolate linearly between the centers of neighbouring centroids,
+// and between the outermost centroids and the observed min and max.
+double
+quantileOf(const CentroidList & centroids, uint64_t count, double min, double max, double q)
+{
+    if (centroids.empty()) {
+        return 0.0;
+    }
+    if (centroids.size() == 1) {
+        return centroids[0].mean;
+    }
+    double target = std::clamp(q, 0.0, 1.0) * count;
+    double firstCenter = centroids[0].weight / 2.0;
+    if (target < firstCenter) {
+        return min + (centroids[0].mean - min) * target / firstCenter;
+    }
+    double weightSoFar(0);
+    for (size_t i(0); i + 1 < centroids.size(); i++) {
+        double center = weightSoFar + centroids[i].weight / 2.0;
+        double nextCenter = weightSoFar + centroids[i].weight + centroids[i + 1].weight / 2.0;
+        if (target < nextCenter) {
+            return centroids[i].mean + (centroids[i + 1].mean - centroids[i].mean) * (target - center) / (nextCenter - center);
+        }
+        weightSoFar += centroids[i].weight;
+    }
+    double lastCenter = count - centroids.back().weight / 2.0;
+    double tail = count - lastCenter;
+    return (tail > 0)
+        ? centroids.back().mean + (max - centroids.back().mean) * std::min(1.0, (target - lastCenter) / tail)
+        : centroids.back().mean;
+}
+
 } // namespace search::aggregation::<unnamed>
 
 using vespalib::Serializer;
@@ -45,6 +121,7 @@ IMPLEMENT_AGGREGATIONRESULT(AverageAggregationResult, AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(XorAggregationResult,     AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(ExpressionCountAggregationResult, AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(StandardDeviationAggregationResult, AggregationResult);
+IMPLEMENT_AGGREGATIONRESULT(QuantileAggregationResult, AggregationResult);
 
 AggregationResult::AggregationResult() :
     _expressionTree(std::make_shared<ExpressionTree>()),
@@ -629,6 +706,133 @@ StandardDeviationAggregationResult::visitMembers(vespalib::ObjectVisitor &visito
     visit(visitor, "sumOfSquared", _sumOfSquared);
 }
 
+QuantileAggregationResult::QuantileAggregationResult()
+    : QuantileAggregationResult(0.5)
+{ }
+
+QuantileAggregationResult::QuantileAggregationResult(double quantile)
+    : AggregationResult(),
+      _quantile(quantile),
+      _count(0),
+      _min(std::numeric_limits<double>::infinity()),
+      _max(-std::numeric_limits<double>::infinity()),
+      _centroids(),
+      _quantileScratchPad()
+{ }
+
+QuantileAggregationResult::~QuantileAggregationResult() = default;
+
+void
+QuantileAggregationResult::add(double value)
+{
+    if (std::isnan(value)) {
+        return;
+    }
+    _centroids.emplace_back(value, 1);
+    _count++;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+    if (_centroids.size() >= 5 * COMPRESSION) {
+        compress();
+    }
+}
+
+void
+QuantileAggregationResult::compress()
+{
+    compressCentroids(_centroids);
+}
+
+QuantileAggregationResult::CentroidList
+QuantileAggregationResult::getCentroids() const
+{
+    CentroidList centroids(_centroids);
+    compressCentroids(centroids);
+    return centroids;
+}
+
+double
+QuantileAggregationResult::getQuantileValue() const
+{
+    return quantileOf(getCentroids(), _count, _min, _max, _quantile);
+}
+
+const ResultNode &
+QuantileAggregationResult::onGetRank() const
+{
+    _quantileScratchPad.set(getQuantileValue());
+    return _quantileScratchPad;
+}
+
+void
+QuantileAggregationResult::onMerge(const AggregationResult &r) {
+    const auto & result = Identifiable::cast<const QuantileAggregationResult &>(r);
+    _centroids.insert(_centroids.end(), result._centroids.begin(), result._centroids.end());
+    _count += result._count;
+    _min = std::min(_min, result._min);
+    _max = std::max(_max, result._max);
+    compress();
+}
+
+void
+QuantileAggregationResult::onAggregate(const ResultNode &result) {
+    if (result.isMultiValue()) {
+        const auto & v = static_cast<const ResultNodeVector &>(result);
+        for (size_t i(0), m(v.size()); i < m; i++) {
+            add(v.get(i).getFloat());
+        }
+    } else {
+        add(result.getFloat());
+    }
+}
+
+void
+QuantileAggregationResult::onReset()
+{
+    _count = 0;
+    _min = std::numeric_limits<double>::infinity();
+    _max = -std::numeric_limits<double>::infinity();
+    _centroids.clear();
+}
+
+Serializer &
+QuantileAggregationResult::onSerialize(Serializer & os) const
+{
+    AggregationResult::onSerialize(os);
+    CentroidList centroids = getCentroids();
+    os << _quantile << _count << _min << _max << static_cast<uint32_t>(centroids.size());
+    for (const Centroid & c : centroids) {
+        os << c.mean << c.weight;
+    }
+    return os;
+}
+
+Deserializer &
+QuantileAggregationResult::onDeserialize(Deserializer & is)
+{
+    AggregationResult::onDeserialize(is);
+    uint32_t numCentroids(0);
+    is >> _quantile >> _count >> _min >> _max >> numCentroids;
+    _centroids.clear();
+    _centroids.reserve(numCentroids);
+    for (uint32_t i(0); i < numCentroids; i++) {
+        double mean(0);
+        uint64_t weight(0);
+        is >> mean >> weight;
+        _centroids.emplace_back(mean, weight);
+    }
+    return is;
+}
+
+void
+QuantileAggregationResult::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    AggregationResult::visitMembers(visitor);
+    visit(visitor, "quantile", _quantile);
+    visit(visitor, "count", _count);
+    visit(visitor, "value", getQuantileValue());
+}
+
 }
 
 // this function was added by ../../forcelink.sh
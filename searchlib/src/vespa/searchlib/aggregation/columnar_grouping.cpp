@@ -0,0 +1,231 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "columnar_grouping.h"
+#include "grouping.h"
+#include "countaggregationresult.h"
+#include "maxaggregationresult.h"
+#include "minaggregationresult.h"
+#include "sumaggregationresult.h"
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <vespa/searchlib/expression/attributenode.h>
+#include <vespa/searchlib/expression/constantnode.h>
+#include <vespa/searchlib/expression/integerresultnode.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace search::aggregation {
+
+using attribute::IAttributeVector;
+using expression::AttributeNode;
+using expression::ConstantNode;
+using expression::ExpressionNode;
+using expression::Int64ResultNode;
+
+namespace {
+
+const IAttributeVector *
+single_value_integer_attribute(const ExpressionNode *node)
+{
+    if ((node == nullptr) || (node->getClass().id() != AttributeNode::classId)) {
+        return nullptr;
+    }
+    const auto &attrNode = static_cast<const AttributeNode &>(*node);
+    const IAttributeVector *attr = attrNode.getAttribute();
+    if ((attr == nullptr) || attrNode.hasMultiValue() || attr->hasMultiValue() || !attr->isIntegerType()) {
+        return nullptr;
+    }
+    return attr;
+}
+
+}
+
+ColumnarGrouping::Column::Column(Op op_in, uint32_t aggr_idx_in, const IAttributeVector * attr_in) noexcept
+    : op(op_in),
+      aggr_idx(aggr_idx_in),
+      attr(attr_in),
+      values()
+{ }
+
+ColumnarGrouping::Column::Column(Column &&) noexcept = default;
+ColumnarGrouping::Column::~Column() = default;
+
+std::unique_ptr<ColumnarGrouping>
+ColumnarGrouping::try_create(Grouping &grouping)
+{
+    if ((grouping.getLevels().size() != 1) || (grouping.getFirstLevel() != 0) ||
+        (grouping.getRoot().getAggrSize() != 0) || (grouping.getRoot().getChildrenSize() != 0))
+    {
+        return {};
+    }
+    const GroupingLevel &level = grouping.getLevels()[0];
+    if (level.isFrozen() || level.hasFilter()) {
+        return {};
+    }
+    const IAttributeVector *classify = single_value_integer_attribute(level.getExpression().getRoot());
+    if (classify == nullptr) {
+        return {};
+    }
+    std::vector<Column> columns;
+    if (grouping.getLastLevel() > 0) {
+        const Group &proto = level.getGroupPrototype();
+        for (uint32_t i = 0; i < proto.getAggrSize(); ++i) {
+            const AggregationResult &aggr = proto.getAggregationResult(i);
+            const ExpressionNode *expr = aggr.getExpression();
+            uint32_t cid = aggr.getClass().id();
+            if (cid == CountAggregationResult::classId) {
+                if ((expr != nullptr) && (expr->getClass().id() != ConstantNode::classId) &&
+                    (single_value_integer_attribute(expr) == nullptr))
+                {
+                    return {};
+                }
+                columns.emplace_back(Op::COUNT, i, nullptr);
+                continue;
+            }
+            const IAttributeVector *attr = single_value_integer_attribute(expr);
+            if (attr == nullptr) {
+                return {};
+            }
+            if (cid == SumAggregationResult::classId) {
+                columns.emplace_back(Op::SUM, i, attr);
+            } else if (cid == MinAggregationResult::classId) {
+                columns.emplace_back(Op::MIN, i, attr);
+            } else if (cid == MaxAggregationResult::classId) {
+                columns.emplace_back(Op::MAX, i, attr);
+            } else {
+                return {};
+            }
+        }
+    }
+    return std::unique_ptr<ColumnarGrouping>(new ColumnarGrouping(grouping.root(), level, *classify, std::move(columns)));
+}
+
+ColumnarGrouping::ColumnarGrouping(Group &root, const GroupingLevel &level, const IAttributeVector &classify,
+                                   std::vector<Column> columns)
+    : _root(root),
+      _level(level),
+      _classify(classify),
+      _columns(std::move(columns)),
+      _groupMap(),
+      _groups(),
+      _groupRanks(),
+      _pending(0),
+      _docIds(),
+      _ranks(),
+      _groupIdx(),
+      _values()
+{ }
+
+ColumnarGrouping::~ColumnarGrouping() = default;
+
+uint32_t
+ColumnarGrouping::resolve_group(int64_t key, DocId docId, HitRank rank)
+{
+    auto found = _groupMap.find(key);
+    if (found != _groupMap.end()) {
+        return found->second;
+    }
+    if (!_level.allowMoreGroups(_groups.size())) {
+        return NO_GROUP;
+    }
+    const auto &selector = _level.getExpression();
+    if (!selector.execute(docId, rank)) {
+        throw std::runtime_error("Does not know how to handle failed select statements");
+    }
+    auto group = std::make_unique<Group>(_level.getGroupPrototype());
+    group->setId(*selector.getResult());
+    group->setRank(rank);
+    _groupRanks.push_back(group->getRank());
+    _groups.push_back(std::move(group));
+    for (Column &column : _columns) {
+        switch (column.op) {
+        case Op::COUNT:
+        case Op::SUM:
+            column.values.push_back(0);
+            break;
+        case Op::MIN:
+            column.values.push_back(std::numeric_limits<int64_t>::max());
+            break;
+        case Op::MAX:
+            column.values.push_back(std::numeric_limits<int64_t>::min());
+            break;
+        }
+    }
+    uint32_t idx = _groups.size() - 1;
+    _groupMap[key] = idx;
+    return idx;
+}
+
+void
+ColumnarGrouping::flush()
+{
+    const size_t num = _pending;
+    _pending = 0;
+    for (size_t i = 0; i < num; ++i) {
+        _values[i] = _classify.getInt(_docIds[i]);
+    }
+    for (size_t i = 0; i < num; ++i) {
+        uint32_t idx = resolve_group(_values[i], _docIds[i], _ranks[i]);
+        _groupIdx[i] = idx;
+        if (idx != NO_GROUP) {
+            _groupRanks[idx] = std::max(_groupRanks[idx], _ranks[i]);
+        }
+    }
+    for (Column &column : _columns) {
+        int64_t *dst = column.values.data();
+        if (column.op == Op::COUNT) {
+            for (size_t i = 0; i < num; ++i) {
+                if (_groupIdx[i] != NO_GROUP) {
+                    ++dst[_groupIdx[i]];
+                }
+            }
+            continue;
+        }
+        for (size_t i = 0; i < num; ++i) {
+            _values[i] = column.attr->getInt(_docIds[i]);
+        }
+        for (size_t i = 0; i < num; ++i) {
+            uint32_t idx = _groupIdx[i];
+            if (idx == NO_GROUP) {
+                continue;
+            }
+            switch (column.op) {
+            case Op::SUM:
+                dst[idx] = static_cast<int64_t>(static_cast<uint64_t>(dst[idx]) + static_cast<uint64_t>(_values[i]));
+                break;
+            case Op::MIN:
+                dst[idx] = std::min(dst[idx], _values[i]);
+                break;
+            case Op::MAX:
+                dst[idx] = std::max(dst[idx], _values[i]);
+                break;
+            case Op::COUNT:
+                break;
+            }
+        }
+    }
+}
+
+void
+ColumnarGrouping::finish()
+{
+    flush();
+    for (size_t idx = 0; idx < _groups.size(); ++idx) {
+        Group &group = *_groups[idx];
+        group.setRank(_groupRanks[idx]);
+        for (const Column &column : _columns) {
+            AggregationResult &aggr = group.getAggregationResult(column.aggr_idx);
+            if (column.op == Op::COUNT) {
+                static_cast<CountAggregationResult &>(aggr).setCount(column.values[idx]);
+            } else {
+                aggr.getResult().set(Int64ResultNode(column.values[idx]));
+            }
+        }
+        _root.addChild(std::move(_groups[idx]));
+    }
+    _groups.clear();
+    _groupRanks.clear();
+    _groupMap.clear();
+}
+
+}
@@ -0,0 +1,89 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "group.h"
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace search::attribute { class IAttributeVector; }
+
+namespace search::aggregation {
+
+class Grouping;
+class GroupingLevel;
+
+/**
+ * Specialized aggregation of a single grouping level on a single
+ * value integer attribute, collecting only count, sum, min and max
+ * of single value integer attributes per group. Hits are buffered
+ * and handled a block at a time: attribute values are read for all
+ * hits in the block, group ids are resolved through a hash map on
+ * the raw attribute value, and the aggregates are updated in
+ * contiguous per group arrays. The group tree is materialized when
+ * finish is called, and is identical to the one produced by calling
+ * Grouping::aggregate for each hit.
+ **/
+class ColumnarGrouping
+{
+public:
+    /**
+     * Create a columnar aggregator for the given grouping if its
+     * shape allows it. Must be called after Grouping::preAggregate.
+     *
+     * @return the columnar aggregator, or nullptr if not applicable.
+     **/
+    static std::unique_ptr<ColumnarGrouping> try_create(Grouping &grouping);
+
+    ColumnarGrouping(const ColumnarGrouping &) = delete;
+    ColumnarGrouping & operator=(const ColumnarGrouping &) = delete;
+    ~ColumnarGrouping();
+
+    void aggregate(DocId docId, HitRank rank) {
+        _docIds[_pending] = docId;
+        _ranks[_pending] = rank;
+        if (++_pending == BLOCK_SIZE) {
+            flush();
+        }
+    }
+
+    /**
+     * Add the collected groups to the root of the grouping.
+     **/
+    void finish();
+
+private:
+    static constexpr size_t BLOCK_SIZE = 256;
+    static constexpr uint32_t NO_GROUP = -1;
+    enum class Op : uint8_t { COUNT, SUM, MIN, MAX };
+    struct Column {
+        Op                                         op;
+        uint32_t                                   aggr_idx;
+        const attribute::IAttributeVector        * attr;
+        std::vector<int64_t>                       values;
+        Column(Op op_in, uint32_t aggr_idx_in, const attribute::IAttributeVector * attr_in) noexcept;
+        Column(Column &&) noexcept;
+        ~Column();
+    };
+
+    ColumnarGrouping(Group &root, const GroupingLevel &level, const attribute::IAttributeVector &classify,
+                     std::vector<Column> columns);
+    uint32_t resolve_group(int64_t key, DocId docId, HitRank rank);
+    void flush();
+
+    Group                                   &_root;
+    const GroupingLevel                     &_level;
+    const attribute::IAttributeVector       &_classify;
+    std::vector<Column>                      _columns;
+    vespalib::hash_map<int64_t, uint32_t>    _groupMap;
+    std::vector<std::unique_ptr<Group>>      _groups;
+    std::vector<HitRank>                     _groupRanks;
+    size_t                                   _pending;
+    std::array<DocId, BLOCK_SIZE>            _docIds;
+    std::array<HitRank, BLOCK_SIZE>          _ranks;
+    std::array<uint32_t, BLOCK_SIZE>         _groupIdx;
+    std::array<int64_t, BLOCK_SIZE>          _values;
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include "group.h"
 #include "grouping.h"
+#include "group_arena.h"
 #include <vespa/searchlib/expression/aggregationrefnode.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/objects/object2slime.h>
@@ -49,6 +50,35 @@ destruct(Group::GroupList & l, size_t m)
 
 IMPLEMENT_IDENTIFIABLE_NS2(search, aggregation, Group, vespalib::Identifiable);
 
+namespace {
+
+// Each group is prefixed by the arena it was allocated from, or nullptr if allocated from the heap.
+constexpr size_t ALLOC_HEADER_SIZE = alignof(std::max_align_t);
+
+}
+
+void *
+Group::operator new(size_t sz)
+{
+    GroupArena *arena = GroupArena::current();
+    size_t total = sz + ALLOC_HEADER_SIZE;
+    void *mem = (arena != nullptr) ? arena->allocate(total) : ::operator new(total);
+    *static_cast<GroupArena **>(mem) = arena;
+    return static_cast<char *>(mem) + ALLOC_HEADER_SIZE;
+}
+
+void
+Group::operator delete(void *ptr) noexcept
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    void *mem = static_cast<char *>(ptr) - ALLOC_HEADER_SIZE;
+    if (*static_cast<GroupArena **>(mem) == nullptr) {
+        ::operator delete(mem);
+    }
+}
+
 int
 Group::cmpRank(const Group &rhs) const
 {
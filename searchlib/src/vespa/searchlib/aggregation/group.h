@@ -198,6 +198,13 @@ public:
     Group & operator = (Group &&) noexcept = default;
     ~Group() override;
 
+    /**
+     * Groups are allocated from the GroupArena of the active scope on
+     * the current thread, if any, and from the heap otherwise.
+     **/
+    static void *operator new(size_t sz);
+    static void operator delete(void *ptr) noexcept;
+
     int cmpId(const Group &rhs) const { return _id->cmpFast(*rhs._id); }
     int cmpRank(const Group &rhs) const;
     Group & setRank(RawRank r);
@@ -0,0 +1,61 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "group_arena.h"
+#include <algorithm>
+
+namespace search::aggregation {
+
+namespace {
+
+thread_local GroupArena *_current = nullptr;
+
+constexpr size_t align_up(size_t sz) noexcept {
+    constexpr size_t align = alignof(std::max_align_t);
+    return (sz + align - 1) & ~(align - 1);
+}
+
+}
+
+GroupArena::Scope::Scope(GroupArena &arena) noexcept
+    : _prev(_current)
+{
+    _current = &arena;
+}
+
+GroupArena::Scope::~Scope()
+{
+    _current = _prev;
+}
+
+GroupArena::GroupArena() noexcept
+    : _chunks(),
+      _pos(nullptr),
+      _end(nullptr),
+      _allocated(0)
+{ }
+
+GroupArena::~GroupArena() = default;
+
+void *
+GroupArena::allocate(size_t sz)
+{
+    sz = align_up(sz);
+    if (static_cast<size_t>(_end - _pos) < sz) {
+        size_t chunk_size = std::max(CHUNK_SIZE, sz);
+        _chunks.emplace_back(new char[chunk_size]);
+        _pos = _chunks.back().get();
+        _end = _pos + chunk_size;
+    }
+    void *mem = _pos;
+    _pos += sz;
+    _allocated += sz;
+    return mem;
+}
+
+GroupArena *
+GroupArena::current() noexcept
+{
+    return _current;
+}
+
+}
@@ -0,0 +1,58 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace search::aggregation {
+
+/**
+ * Bump allocator for the Group nodes of grouping trees. While a Scope
+ * is active on a thread, all Group instances created by that thread
+ * are carved out of the arena instead of being allocated one at a
+ * time from the heap. Deleting such a group only runs its destructor;
+ * the memory is released in one go when the arena is destructed.
+ *
+ * The arena must outlive all groups allocated from it. A Grouping owns
+ * the arena used for its own tree, and keeps the arenas of the trees
+ * merged into it alive as well.
+ **/
+class GroupArena
+{
+public:
+    /**
+     * Makes an arena the target of Group allocations on the current
+     * thread for the lifetime of the scope.
+     **/
+    class Scope {
+    public:
+        explicit Scope(GroupArena &arena) noexcept;
+        Scope(const Scope &) = delete;
+        Scope & operator=(const Scope &) = delete;
+        ~Scope();
+    private:
+        GroupArena *_prev;
+    };
+
+    GroupArena() noexcept;
+    GroupArena(const GroupArena &) = delete;
+    GroupArena & operator=(const GroupArena &) = delete;
+    ~GroupArena();
+
+    void *allocate(size_t sz);
+    size_t allocated_bytes() const noexcept { return _allocated; }
+
+    // the arena of the innermost active scope on this thread, or nullptr
+    static GroupArena *current() noexcept;
+
+private:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> _chunks;
+    char                                *_pos;
+    char                                *_end;
+    size_t                               _allocated;
+};
+
+}
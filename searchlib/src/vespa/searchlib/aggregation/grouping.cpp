@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "grouping.h"
+#include "columnar_grouping.h"
 #include "hitsaggregationresult.h"
 #include <vespa/searchlib/attribute/stringbase.h>
 #include <vespa/searchlib/common/idocumentmetastore.h>
@@ -177,13 +178,54 @@ Grouping::Grouping() noexcept
       _firstLevel(0),
       _lastLevel(0),
       _levels(),
+      _arena(),
+      _mergedArenas(),
       _root()
 { }
 
 Grouping::Grouping(const Grouping &) = default;
-Grouping & Grouping::operator = (const Grouping &) = default;
+
+// The old tree may live in the old arenas, so it must be replaced before they are released.
+Grouping &
+Grouping::operator = (const Grouping & rhs)
+{
+    if (this != &rhs) {
+        Grouping tmp(rhs);
+        *this = std::move(tmp);
+    }
+    return *this;
+}
+
+Grouping &
+Grouping::operator = (Grouping && rhs) noexcept
+{
+    _id = rhs._id;
+    _valid = rhs._valid;
+    _all = rhs._all;
+    _topN = rhs._topN;
+    _firstLevel = rhs._firstLevel;
+    _lastLevel = rhs._lastLevel;
+    _levels = std::move(rhs._levels);
+    {
+        Group old(std::move(_root));
+        _root = std::move(rhs._root);
+    }
+    _arena = std::move(rhs._arena);
+    _mergedArenas = std::move(rhs._mergedArenas);
+    return *this;
+}
+
 Grouping::~Grouping() = default;
 
+GroupArena &
+Grouping::arena()
+{
+    if ( ! _arena) {
+        _arena = std::make_shared<GroupArena>();
+    }
+    return *_arena;
+}
+
 void
 Grouping::selectMembers(const vespalib::ObjectPredicate &predicate,
                         vespalib::ObjectOperation &operation)
@@ -210,7 +252,17 @@ Grouping::mergePartial(const Grouping & b)
 void
 Grouping::merge(Grouping & b)
 {
-    _root.merge(_levels, _firstLevel, 0, b._root);
+    // groups are moved from b into this tree, so this tree must keep b's arenas
+    if (b._arena) {
+        _mergedArenas.push_back(b._arena);
+    }
+    _mergedArenas.insert(_mergedArenas.end(), b._mergedArenas.begin(), b._mergedArenas.end());
+    if (_arena) {
+        GroupArena::Scope scope(*_arena);
+        _root.merge(_levels, _firstLevel, 0, b._root);
+    } else {
+        _root.merge(_levels, _firstLevel, 0, b._root);
+    }
 }
 
 void
@@ -231,12 +283,21 @@ Grouping::preAggregate(bool isOrdered)
 void
 Grouping::aggregate(DocId from, DocId to)
 {
+    GroupArena::Scope arenaScope(arena());
     preAggregate(false);
+    auto columnar = ColumnarGrouping::try_create(*this);
     if (to > from) {
         for(DocId i(from), m(i + getMaxN(to-from)); i < m; i++) {
-            aggregate(i, 0.0);
+            if (columnar) {
+                columnar->aggregate(i, 0.0);
+            } else {
+                aggregate(i, 0.0);
+            }
         }
     }
+    if (columnar) {
+        columnar->finish();
+    }
     postProcess();
 }
 
@@ -268,12 +329,21 @@ Grouping::postProcess()
 void
 Grouping::aggregate(const RankedHit * rankedHit, unsigned int len)
 {
+    GroupArena::Scope arenaScope(arena());
     bool isOrdered(! needResort());
     preAggregate(isOrdered);
     HitsAggregationResult::SetOrdered pred;
     select(pred, pred);
+    auto columnar = ColumnarGrouping::try_create(*this);
     for(unsigned int i(0), m(getMaxN(len)); i < m; i++) {
-        aggregate(rankedHit[i].getDocId(), rankedHit[i].getRank());
+        if (columnar) {
+            columnar->aggregate(rankedHit[i].getDocId(), rankedHit[i].getRank());
+        } else {
+            aggregate(rankedHit[i].getDocId(), rankedHit[i].getRank());
+        }
+    }
+    if (columnar) {
+        columnar->finish();
     }
     postProcess();
 }
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "groupinglevel.h"
+#include "group_arena.h"
 #include <vespa/searchlib/common/rankedhit.h>
 
 namespace search {
@@ -28,7 +29,9 @@ private:
     uint32_t                 _firstLevel; // first processing level this iteration (levels before considered frozen)
     uint32_t                 _lastLevel;  // last processing level this iteration
     GroupingLevelList        _levels;     // grouping parameters per level
-    Group                    _root;       // the grouping tree
+    std::shared_ptr<GroupArena>              _arena;          // allocates the groups aggregated into this tree
+    std::vector<std::shared_ptr<GroupArena>> _mergedArenas;   // arenas of groups merged into this tree
+    Group                    _root;       // the grouping tree, must be destructed before the arenas
 public:
     DECLARE_IDENTIFIABLE_NS2(search, aggregation, Grouping);
     DECLARE_NBO_SERIALIZE;
@@ -37,7 +40,7 @@ public:
     Grouping(const Grouping &);
     Grouping & operator = (const Grouping &);
     Grouping(Grouping &&) noexcept = default;
-    Grouping & operator = (Grouping &&) noexcept = default;
+    Grouping & operator = (Grouping &&) noexcept;
     ~Grouping() override;
 
     Grouping unchain() const { return *this; }
@@ -65,6 +68,13 @@ public:
     GroupingLevelList &levels() noexcept { return _levels; }
     Group &root() noexcept { return _root; }
 
+    /**
+     * The arena used for the groups of this tree. Activate it with a
+     * GroupArena::Scope around aggregation to avoid allocating each
+     * group from the heap. It is kept until this grouping is destructed.
+     **/
+    GroupArena &arena();
+
     void selectMembers(const vespalib::ObjectPredicate &predicate,
                        vespalib::ObjectOperation &operation) override;
 
@@ -0,0 +1,58 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "aggregationresult.h"
+#include <vespa/searchlib/expression/floatresultnode.h>
+#include <vector>
+
+namespace search::aggregation {
+
+/**
+ * Aggregator that estimates a quantile of the aggregated values. The
+ * values are summarized in a merging t-digest: a list of centroids
+ * (mean and weight) where centroids near the tails are kept small and
+ * centroids near the median are allowed to grow. The number of
+ * centroids is bounded by the compression, independent of the number
+ * of aggregated values, and two digests can be merged by combining
+ * and recompressing their centroids. The same algorithm is
+ * implemented in the java QuantileAggregationResult, which merges the
+ * results from the content nodes.
+ **/
+class QuantileAggregationResult : public AggregationResult
+{
+public:
+    struct Centroid {
+        double   mean;
+        uint64_t weight;
+        Centroid(double mean_in, uint64_t weight_in) noexcept : mean(mean_in), weight(weight_in) { }
+        bool operator==(const Centroid &rhs) const noexcept = default;
+    };
+    using CentroidList = std::vector<Centroid>;
+    static constexpr uint32_t COMPRESSION = 100;
+
+    DECLARE_AGGREGATIONRESULT(QuantileAggregationResult);
+    QuantileAggregationResult();
+    explicit QuantileAggregationResult(double quantile);
+    ~QuantileAggregationResult() override;
+
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+    QuantileAggregationResult &setQuantile(double quantile) { _quantile = quantile; return *this; }
+    double getQuantile() const noexcept { return _quantile; }
+    uint64_t getCount() const noexcept { return _count; }
+    double getQuantileValue() const;
+    CentroidList getCentroids() const;
+    void add(double value);
+private:
+    const ResultNode& onGetRank() const override;
+    void onPrepare(const ResultNode&, bool) override { };
+    void compress();
+
+    double       _quantile;
+    uint64_t     _count;
+    double       _min;
+    double       _max;
+    CentroidList _centroids;
+    mutable expression::FloatResultNode _quantileScratchPad;
+};
+
+}
@@ -23,5 +23,6 @@ const std::string AddressSpaceComponents::shared_string_repo = "shared-string-re
 const std::string AddressSpaceComponents::hnsw_levels_store = "hnsw-levels-store";
 const std::string AddressSpaceComponents::hnsw_links_store = "hnsw-links-store";
 const std::string AddressSpaceComponents::hnsw_nodeid_mapping = "hnsw-nodeid-mapping";
+const std::string AddressSpaceComponents::ivf_pq_codes_store = "ivf-pq-codes-store";
 
 }
@@ -22,6 +22,7 @@ public:
     static const std::string hnsw_levels_store;
     static const std::string hnsw_links_store;
     static const std::string hnsw_nodeid_mapping;
+    static const std::string ivf_pq_codes_store;
 };
 
 }
@@ -10,6 +10,7 @@
 #include "in_term_search.h"
 #include "multi_term_or_filter_search.h"
 #include "predicate_attribute.h"
+#include "value_statistics.h"
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchcommon/attribute/hit_estimate_flow_stats_adapter.h>
 #include <vespa/searchlib/common/location.h>
@@ -138,9 +139,12 @@ private:
     std::string _query_term;
     ISearchContext::UP _search_context;
     attribute::HitEstimate _hit_estimate;
+    std::shared_ptr<const attribute::ValueStatistics> _value_statistics;
     enum Type {INT, FLOAT, OTHER};
     Type _type;
 
+    double estimate_from_value_statistics() const;
+
 public:
     AttributeFieldBlueprint(FieldSpecBase field, const IAttributeVector &attribute,
                             const string &query_stack, const SearchContextParams &params);
@@ -153,7 +157,7 @@ public:
             // E.g. attributes without fast-search are not able to provide a hit estimate.
             // In addition, matching is lookup based, and we are not able to skip documents efficiently when being strict.
             size_t indirections = get_num_indirections(_attr.getBasicType(), _attr.getCollectionType());
-            return {estimate_when_unknown(), lookup_cost(indirections), lookup_strict_cost(indirections)};
+            return {estimate_from_value_statistics(), lookup_cost(indirections), lookup_strict_cost(indirections)};
         } else {
             double rel_est = abs_to_rel_est(_hit_estimate.est_hits(), docid_limit);
             return {rel_est, btree_cost(rel_est), btree_strict_cost(rel_est)};
@@ -204,6 +208,7 @@ AttributeFieldBlueprint::AttributeFieldBlueprint(FieldSpecBase field, const IAtt
       _query_term(term->getTermString()),
       _search_context(attribute.createSearchContext(std::move(term), params)),
       _hit_estimate(_search_context->calc_hit_estimate()),
+      _value_statistics(),
       _type(OTHER)
 {
     uint32_t estHits = _hit_estimate.est_hits();
@@ -214,6 +219,24 @@ AttributeFieldBlueprint::AttributeFieldBlueprint(FieldSpecBase field, const IAtt
     } else if (attribute.isIntegerType()) {
         _type = INT;
     }
+    if (_hit_estimate.is_unknown() && (_type != OTHER)) {
+        _value_statistics = attribute.get_value_statistics();
+    }
+}
+
+double
+AttributeFieldBlueprint::estimate_from_value_statistics() const
+{
+    if (!_value_statistics || !_search_context->valid()) {
+        return estimate_when_unknown();
+    }
+    if (_type == INT) {
+        Int64Range range = _search_context->getAsIntegerTerm();
+        return _value_statistics->estimate_hit_ratio(range.lower(), range.upper());
+    } else {
+        DoubleRange range = _search_context->getAsDoubleTerm();
+        return _value_statistics->estimate_hit_ratio(range.lower(), range.upper());
+    }
 }
 
 void
@@ -222,6 +245,7 @@ AttributeFieldBlueprint::visitMembers(vespalib::ObjectVisitor &visitor) const
     LeafBlueprint::visitMembers(visitor);
     visit_attribute(visitor, _attr);
     visit(visitor, "query_term", _query_term);
+    _search_context->visitMembers(visitor);
 }
 
 //-----------------------------------------------------------------------------
@@ -402,7 +426,16 @@ make_location_blueprint(const FieldSpec &field, const IAttributeVector &attribut
     {
         return std::make_unique<queryeval::EmptyBlueprint>(field);
     }
-    ZCurve::RangeVector rangeVector = ZCurve::find_ranges(
+    ZCurve::RangeVector rangeVector = location.has_radius()
+        ? ZCurve::find_ranges(
+            location.bounding_box.x.low,
+            location.bounding_box.y.low,
+            location.bounding_box.x.high,
+            location.bounding_box.y.high,
+            [&location](int32_t min_x, int32_t min_y, int32_t max_x, int32_t max_y) {
+                return location.may_be_inside_limit(common::GeoLocation::Box{{min_x, max_x}, {min_y, max_y}});
+            })
+        : ZCurve::find_ranges(
             location.bounding_box.x.low,
             location.bounding_box.y.low,
             location.bounding_box.x.high,
@@ -453,7 +486,7 @@ private:
     const IDocidWithWeightPostingStore            &_attr;
     vespalib::datastore::EntryRef                  _dictionary_snapshot;
     MatchingPhase                                  _matching_phase;
-
+    const queryeval::RankScoreThreshold           *_rank_score_threshold;
 
 public:
     DirectWandBlueprint(const FieldSpec &field, const IDocidWithWeightPostingStore &attr, uint32_t scoresToTrack,
@@ -468,7 +501,8 @@ public:
           _terms(),
           _attr(attr),
           _dictionary_snapshot(_attr.get_dictionary_snapshot()),
-          _matching_phase(MatchingPhase::FIRST_PHASE)
+          _matching_phase(MatchingPhase::FIRST_PHASE),
+          _rank_score_threshold(nullptr)
     {
         _weights.reserve(size_hint);
         _terms.reserve(size_hint);
@@ -476,6 +510,8 @@ public:
 
     ~DirectWandBlueprint() override;
 
+    void set_rank_score_threshold(const queryeval::RankScoreThreshold *threshold) noexcept { _rank_score_threshold = threshold; }
+
     void addTerm(const IDirectPostingStore::LookupKey & key, int32_t weight, HitEstimate & estimate) {
         IDirectPostingStore::LookupResult result = _attr.lookup(key, _dictionary_snapshot);
         HitEstimate childEst(result.posting_size, (result.posting_size == 0));
@@ -513,9 +549,11 @@ public:
             return std::make_unique<queryeval::EmptySearch>();
         }
         bool readonly_scores_heap = (_matching_phase != MatchingPhase::FIRST_PHASE);
+        const auto *rank_score_threshold = readonly_scores_heap ? nullptr : _rank_score_threshold;
         return queryeval::ParallelWeakAndSearch::create(*tfmda[0],
                 queryeval::ParallelWeakAndSearch::MatchParams(*_scores, _scoreThreshold, _thresholdBoostFactor,
-                                                              _scoresAdjustFrequency, get_docid_limit()),
+                                                              _scoresAdjustFrequency, get_docid_limit(),
+                                                              rank_score_threshold),
                                                         _weights, _terms, _attr, strict(), readonly_scores_heap);
     }
     std::unique_ptr<SearchIterator> createFilterSearchImpl(FilterConstraint constraint) const override;
@@ -742,10 +780,12 @@ public:
         if (has_always_btree_iterators_with_docid_and_weight()) {
             auto *bp = new DirectWandBlueprint(_field, *_dwwps, n.getTargetNumHits(), n.getScoreThreshold(),
                                                n.getThresholdBoostFactor(), n.getNumTerms(), is_search_multi_threaded());
+            bp->set_rank_score_threshold(getRequestContext().get_rank_score_threshold());
             createDirectMultiTerm(bp, n);
         } else {
             auto *bp = new ParallelWeakAndBlueprint(_field, n.getTargetNumHits(), n.getScoreThreshold(),
                                                     n.getThresholdBoostFactor(), is_search_multi_threaded());
+            bp->set_rank_score_threshold(getRequestContext().get_rank_score_threshold());
             createShallowWeightedSet(bp, n, _field, _attr.isIntegerType());
         }
     }
@@ -767,7 +807,7 @@ public:
         try {
             auto calc = tensor::DistanceCalculator::make_with_validation(_attr, *query_tensor);
             const auto& params = getRequestContext().get_create_blueprint_params();
-            setResult(std::make_unique<queryeval::NearestNeighborBlueprint>(_field,
+            auto bp = std::make_unique<queryeval::NearestNeighborBlueprint>(_field,
                                                                             std::move(calc),
                                                                             n.get_target_num_hits(),
                                                                             n.get_allow_approximate(),
@@ -779,7 +819,10 @@ public:
                                                                             params.filter_first_exploration,
                                                                             params.exploration_slack,
                                                                             params.target_hits_max_adjustment_factor,
-                                                                            getRequestContext().getDoom()));
+                                                                            getRequestContext().getDoom());
+            bp->set_rank_score_threshold(getRequestContext().get_rank_score_threshold());
+            bp->set_thread_bundle(&getRequestContext().thread_bundle());
+            setResult(std::move(bp));
         } catch (const vespalib::IllegalArgumentException& ex) {
             return fail_nearest_neighbor_term(n, ex.getMessage());
 
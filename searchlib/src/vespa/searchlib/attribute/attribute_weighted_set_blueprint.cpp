@@ -41,6 +41,7 @@ class StringEnumWrapper : public AttrWrapper
 public:
     using TokenT = uint32_t;
     static constexpr bool unpack_weights = true;
+    static constexpr bool multi_value = false;
     explicit StringEnumWrapper(const IAttributeVector & attr)
         : AttrWrapper(attr) {}
     auto mapToken(const ISearchContext &context) const {
@@ -56,6 +57,7 @@ class IntegerWrapper : public AttrWrapper
 public:
     using TokenT = uint64_t;
     static constexpr bool unpack_weights = true;
+    static constexpr bool multi_value = false;
     explicit IntegerWrapper(const IAttributeVector & attr) : AttrWrapper(attr) {}
     std::vector<int64_t> mapToken(const ISearchContext &context) const {
         std::vector<int64_t> result;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "array_iterator.h"
+#include "compressed_posting_list.h"
 #include "postinglisttraits.h"
 #include <vespa/searchlib/queryeval/searchiterator.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
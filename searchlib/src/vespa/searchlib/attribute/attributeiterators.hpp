@@ -8,6 +8,7 @@
 #include <vespa/searchlib/fef/termfieldmatchdataposition.h>
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/vespalib/objects/visit.h>
+#include <concepts>
 
 namespace search {
 
@@ -18,20 +19,37 @@ bool matches(const SC & sc, uint32_t doc) {
     return sc.find(doc, 0) >= 0;
 }
 
+/*
+ * Search contexts that can match a word (64 docids) at a time, e.g.
+ * for single value numeric attributes.
+ */
+template <typename SC>
+concept WordMatchable = requires(const SC &sc, uint32_t first, uint32_t last) {
+    { sc.match_word(first, last) } -> std::same_as<uint64_t>;
+};
+
 }
 
 template <typename SC>
 void
 AttributeIteratorBase::and_hits_into(const SC & sc, BitVector & result, uint32_t begin_id) const {
-    result.foreach_truebit([&](uint32_t key) { if ( ! matches(sc, key)) { result.clearBit(key); }}, begin_id);
-    result.invalidateCachedCount();
+    if constexpr (WordMatchable<SC>) {
+        result.and_words(begin_id, result.size(), [&sc](uint32_t first, uint32_t last) noexcept { return sc.match_word(first, last); });
+    } else {
+        result.foreach_truebit([&](uint32_t key) { if ( ! matches(sc, key)) { result.clearBit(key); }}, begin_id);
+        result.invalidateCachedCount();
+    }
 }
 
 template <typename SC>
 void
 AttributeIteratorBase::or_hits_into(const SC & sc, BitVector & result, uint32_t begin_id) const {
-    result.foreach_falsebit([&](uint32_t key) { if ( matches(sc, key)) { result.setBit(key); }}, begin_id);
-    result.invalidateCachedCount();
+    if constexpr (WordMatchable<SC>) {
+        result.or_words(begin_id, result.size(), [&sc](uint32_t first, uint32_t last) noexcept { return sc.match_word(first, last); });
+    } else {
+        result.foreach_falsebit([&](uint32_t key) { if ( matches(sc, key)) { result.setBit(key); }}, begin_id);
+        result.invalidateCachedCount();
+    }
 }
 
 
@@ -39,9 +57,13 @@ template <typename SC>
 std::unique_ptr<BitVector>
 AttributeIteratorBase::get_hits(const SC & sc, uint32_t begin_id) const {
     BitVector::UP result = BitVector::create(begin_id, getEndId());
-    for (uint32_t docId(std::max(begin_id, getDocId())); docId < getEndId(); docId++) {
-        if (matches(sc, docId)) {
-            result->setBit(docId);
+    if constexpr (WordMatchable<SC>) {
+        result->or_words(std::max(begin_id, getDocId()), getEndId(), [&sc](uint32_t first, uint32_t last) noexcept { return sc.match_word(first, last); });
+    } else {
+        for (uint32_t docId(std::max(begin_id, getDocId())); docId < getEndId(); docId++) {
+            if (matches(sc, docId)) {
+                result->setBit(docId);
+            }
         }
     }
     result->invalidateCachedCount();
@@ -124,6 +146,11 @@ struct is_tree_iterator<DocIdMinMaxIterator<P>> {
     static constexpr bool value = false;
 };
 
+template <>
+struct is_tree_iterator<attribute::CompressedPostingIterator> {
+    static constexpr bool value = false;
+};
+
 template <typename KeyT, typename DataT, typename AggrT, typename CompareT, typename TraitsT>
 struct is_tree_iterator<vespalib::btree::BTreeConstIterator<KeyT, DataT, AggrT, CompareT, TraitsT>> {
     static constexpr bool value = true;
@@ -132,6 +159,22 @@ struct is_tree_iterator<vespalib::btree::BTreeConstIterator<KeyT, DataT, AggrT,
 template <typename PL>
 inline constexpr bool is_tree_iterator_v = is_tree_iterator<PL>::value;
 
+// Number of documents to look ahead when strict iterators prefetch values
+constexpr uint32_t strict_prefetch_distance = 8;
+
+/*
+ * Prefetch the values for a document a few documents ahead of docId when
+ * the search context supports it, e.g. for multi-value attributes where
+ * the values are stored separately from the per document entry refs.
+ */
+template <typename SC>
+void prefetch_ahead(const SC& sc, uint32_t docId) noexcept
+{
+    if constexpr (requires { sc.prefetch(docId); }) {
+        sc.prefetch(docId + strict_prefetch_distance);
+    }
+}
+
 template <typename PL>
 void get_hits_helper(BitVector& result, PL& iterator, uint32_t end_id)
 {
@@ -429,6 +472,7 @@ void
 AttributeIteratorStrict<SC>::doSeek(uint32_t docId)
 {
     for (uint32_t nextId = docId; !isAtEnd(nextId); ++nextId) {
+        prefetch_ahead(_concreteSearchCtx, nextId);
         if (this->matches(nextId, _weight)) {
             setDocId(nextId);
             return;
@@ -442,6 +486,7 @@ void
 FilterAttributeIteratorStrict<SC>::doSeek(uint32_t docId)
 {
     for (uint32_t nextId = docId; !isAtEnd(nextId); ++nextId) {
+        prefetch_ahead(_concreteSearchCtx, nextId);
         if (this->matches(nextId)) {
             setDocId(nextId);
             return;
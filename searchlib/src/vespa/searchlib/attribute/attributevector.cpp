@@ -5,11 +5,13 @@
 #include "attribute_read_guard.h"
 #include "attributefilesavetarget.h"
 #include "attributesaver.h"
+#include "bitvector_search_cache.h"
 #include "floatbase.h"
 #include "interlock.h"
 #include "ipostinglistattributebase.h"
 #include "stringbase.h"
 #include "enummodifier.h"
+#include "value_statistics.h"
 #include "valuemodifier.h"
 #include <vespa/document/update/assignvalueupdate.h>
 #include <vespa/document/update/mapvalueupdate.h>
@@ -19,11 +21,13 @@
 #include <vespa/searchlib/common/tunefileinfo.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/query/query_term_decoder.h>
+#include <vespa/searchlib/query/query_term_simple.h>
 #include <vespa/searchlib/util/file_settings.h>
 #include <vespa/vespalib/util/jsonwriter.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/mmap_file_allocator_factory.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <thread>
 #include <filesystem>
 
@@ -73,6 +77,38 @@ make_memory_allocator(const std::string& name, const search::attribute::Config&
     if (allow_paged(config)) {
         return vespalib::alloc::MmapFileAllocatorFactory::instance().make_memory_allocator(name);
     }
+    if (config.tiered_memory() && !config.paged()) {
+        return vespalib::alloc::MmapFileAllocatorFactory::instance().make_tiered_memory_allocator(name);
+    }
+    return {};
+}
+
+/*
+ * Returns the key used for caching the hits for an expensive query term in the
+ * bit vector search cache, or an empty string if hits should not be cached.
+ */
+std::string
+make_bitvector_search_cache_key(const search::QueryTermSimple& term, const search::AttributeVector& attr, bool& range)
+{
+    range = false;
+    if (!term.isValid()) {
+        return {};
+    }
+    if (term.isRegex()) {
+        return "regex:" + term.getTermString();
+    }
+    if (term.isFuzzy()) {
+        return vespalib::make_string("fuzzy:%zu:%zu:%d:", term.fuzzy_max_edit_distance(), term.fuzzy_prefix_lock_length(),
+                                     term.fuzzy_prefix_match() ? 1 : 0) + term.getTermString();
+    }
+    double low = 0;
+    double high = 0;
+    if ((attr.isIntegerType() || attr.isFloatingPointType()) && term.getRangeLimit() == 0 && term.getMaxPerGroup() == 0 &&
+        term.getAsFloatTerm(low, high) && low < high)
+    {
+        range = true;
+        return vespalib::make_string("range:%a:%a", low, high);
+    }
     return {};
 }
 
@@ -88,7 +124,7 @@ AttributeVector::AttributeVector(std::string_view baseFileName, const Config &c)
       _config(std::make_unique<Config>(c)),
       _interlock(std::make_shared<attribute::Interlock>()),
       _enumLock(),
-      _genHandler(),
+      _genHandler(GenerationHandler::sharded()), // read guards are taken by every query
       _genHolder(),
       _status(),
       _highestValueCount(1),
@@ -102,8 +138,11 @@ AttributeVector::AttributeVector(std::string_view baseFileName, const Config &c)
       _isUpdateableInMemoryOnly(attribute::isUpdateableInMemoryOnly(getName(), getConfig())),
       _nextStatUpdateTime(),
       _memory_allocator(make_memory_allocator(_baseFileName.getAttributeName(), c)),
+      _bitvector_search_cache(std::make_unique<attribute::BitVectorSearchCache>(c.bitvector_search_cache_max_memory())),
       _size_on_disk(0),
-      _last_flush_duration(0)
+      _last_flush_duration(0),
+      _value_statistics_lock(),
+      _value_statistics()
 {
 }
 
@@ -113,12 +152,35 @@ void
 AttributeVector::updateStat(bool force) {
     if (force) {
         onUpdateStat();
+        update_value_statistics();
+        update_sort_keys();
     } else if (_nextStatUpdateTime < vespalib::steady_clock::now()) {
         onUpdateStat();
+        update_value_statistics();
+        update_sort_keys();
         _nextStatUpdateTime = vespalib::steady_clock::now() + 5s;
     }
 }
 
+void
+AttributeVector::update_value_statistics()
+{
+    // Attributes with fast-search estimate hits from their posting lists
+    if (getIsFastSearch()) {
+        return;
+    }
+    auto statistics = attribute::ValueStatistics::sample(*this, getCommittedDocIdLimit());
+    std::lock_guard guard(_value_statistics_lock);
+    _value_statistics = std::move(statistics);
+}
+
+std::shared_ptr<const attribute::ValueStatistics>
+AttributeVector::get_value_statistics() const
+{
+    std::lock_guard guard(_value_statistics_lock);
+    return _value_statistics;
+}
+
 bool AttributeVector::hasEnum() const { return _hasEnum; }
 uint32_t AttributeVector::getMaxValueCount() const { return _highestValueCount.load(std::memory_order_relaxed); }
 bool AttributeVector::hasMultiValue() const { return _config->collectionType().isMultiValue(); }
@@ -390,7 +452,16 @@ AttributeVector::getSearch(QueryPacketT searchSpec, const SearchContextParams &p
 std::unique_ptr<attribute::ISearchContext>
 AttributeVector::createSearchContext(QueryTermSimpleUP term, const attribute::SearchContextParams &params) const
 {
-    return getSearch(std::move(term), params);
+    std::string cache_key;
+    bool range = false;
+    if (getIsFilter() && _bitvector_search_cache->max_memory() > 0) {
+        cache_key = make_bitvector_search_cache_key(*term, *this, range);
+    }
+    auto result = getSearch(std::move(term), params);
+    if (!cache_key.empty()) {
+        result->use_bitvector_search_cache(std::move(cache_key), range);
+    }
+    return result;
 }
 
 
@@ -726,6 +797,8 @@ AttributeVector::update_config(const Config& cfg)
 {
     commit(true);
     _config->setGrowStrategy(cfg.getGrowStrategy());
+    _config->set_bitvector_search_cache_max_memory(cfg.bitvector_search_cache_max_memory());
+    _bitvector_search_cache->set_max_memory(cfg.bitvector_search_cache_max_memory());
     if (cfg.getCompactionStrategy() == _config->getCompactionStrategy()) {
         return;
     }
@@ -57,6 +57,7 @@ namespace search {
 
     namespace attribute {
         class AttributeHeader;
+        class BitVectorSearchCache;
         class IPostingListSearchContext;
         class IPostingListAttributeBase;
         class Interlock;
@@ -66,6 +67,7 @@ namespace search {
         class Config;
         class ValueModifier;
         class EnumModifier;
+        class ValueStatistics;
     }
 
     namespace fileutil {
@@ -266,9 +268,11 @@ protected:
     virtual vespalib::MemoryUsage getEnumStoreValuesMemoryUsage() const;
     virtual void populate_address_space_usage(AddressSpaceUsage& usage) const;
 
-    const std::shared_ptr<vespalib::alloc::MemoryAllocator>& get_memory_allocator() const noexcept { return _memory_allocator; }
     vespalib::alloc::Alloc get_initial_alloc();
 public:
+    const std::shared_ptr<vespalib::alloc::MemoryAllocator>& get_memory_allocator() const noexcept { return _memory_allocator; }
+    // Cache of hits for expensive query terms, used by search contexts when searching a filter attribute.
+    attribute::BitVectorSearchCache& get_bitvector_search_cache() const noexcept { return *_bitvector_search_cache; }
     bool isLoaded() const { return _loaded; }
     void logEnumStoreEvent(const char *reason, const char *stage);
 
@@ -280,6 +284,7 @@ public:
     bool getIsFilter() const override final;
     bool getIsFastSearch() const override final;
     bool isMutable() const;
+    std::shared_ptr<const attribute::ValueStatistics> get_value_statistics() const override;
 
     const Config &getConfig() const noexcept { return *_config; }
     void update_config(const Config& cfg);
@@ -430,13 +435,19 @@ private:
     bool                                  _isUpdateableInMemoryOnly;
     vespalib::steady_time                 _nextStatUpdateTime;
     std::shared_ptr<vespalib::alloc::MemoryAllocator> _memory_allocator;
+    std::unique_ptr<attribute::BitVectorSearchCache> _bitvector_search_cache;
     std::atomic<uint64_t>                 _size_on_disk;
     std::atomic<std::chrono::steady_clock::rep> _last_flush_duration;
+    mutable std::mutex                    _value_statistics_lock;
+    std::shared_ptr<const attribute::ValueStatistics> _value_statistics;
 
     /// Clean up [0, firstUsed>
     virtual void reclaim_memory(generation_t oldest_used_gen);
     virtual void before_inc_generation(generation_t current_gen);
     virtual void onUpdateStat() = 0;
+    void update_value_statistics();
+    // Materializes sort keys requested by queries, called by the write thread when stats are updated
+    virtual void update_sort_keys() {}
     friend class AttributeTest;
 
 public:
@@ -2,41 +2,100 @@
 
 #include "bitvector_search_cache.h"
 #include <vespa/searchlib/common/bitvector.h>
+#include <vespa/vespalib/stllike/cache_stats.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/util/memoryusage.h>
 #include <mutex>
 
 namespace search::attribute {
 
+size_t
+BitVectorSearchCache::Entry::extra_memory_usage() const noexcept
+{
+    size_t result = sizeof(Entry);
+    if (bitVector) {
+        result += bitVector->getFileBytes();
+    }
+    return result;
+}
+
 BitVectorSearchCache::BitVectorSearchCache()
+    : BitVectorSearchCache(unbounded_memory)
+{}
+
+BitVectorSearchCache::BitVectorSearchCache(size_t max_memory)
     : _mutex(),
       _size(0),
       _entries_extra_memory_usage(0),
+      _max_memory(max_memory),
+      _use_count(0),
+      _hits(0),
+      _misses(0),
+      _invalidations(0),
       _cache()
 {}
 
 BitVectorSearchCache::~BitVectorSearchCache() = default;
 
+void
+BitVectorSearchCache::touch(const Entry &entry) const noexcept
+{
+    entry.last_used.store(_use_count.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void
+BitVectorSearchCache::evict_lru(size_t max_memory)
+{
+    while (_entries_extra_memory_usage > max_memory && !_cache.empty()) {
+        auto lru = _cache.begin();
+        for (auto itr = _cache.begin(); itr != _cache.end(); ++itr) {
+            if (itr->second && (!lru->second || itr->second->last_used.load(std::memory_order_relaxed) <
+                                                lru->second->last_used.load(std::memory_order_relaxed))) {
+                lru = itr;
+            }
+        }
+        if (!lru->second) {
+            break;
+        }
+        _entries_extra_memory_usage -= lru->second->extra_memory_usage();
+        std::string term = lru->first;
+        _cache.erase(term);
+        ++_invalidations;
+    }
+}
+
 void
 BitVectorSearchCache::insert(const std::string &term, std::shared_ptr<Entry> entry)
 {
     size_t entry_extra_memory_usage = 0;
     if (entry) {
-        entry_extra_memory_usage = sizeof(Entry);
-        if (entry->bitVector) {
-            entry_extra_memory_usage += entry->bitVector->getFileBytes();
-        }
+        entry_extra_memory_usage = entry->extra_memory_usage();
+        touch(*entry);
+    }
+    size_t max_memory = _max_memory.load(std::memory_order_relaxed);
+    if (entry_extra_memory_usage > max_memory) {
+        return;
     }
     std::unique_lock guard(_mutex);
-    auto ins_res = _cache.insert(std::make_pair(term, std::move(entry)));
-    _size.store(_cache.size());
+    auto ins_res = _cache.insert(std::make_pair(term, entry));
     if (ins_res.second) {
         _entries_extra_memory_usage += entry_extra_memory_usage;
+    } else {
+        auto &old_entry = ins_res.first->second;
+        if (!old_entry || !entry || old_entry->generation >= entry->generation) {
+            return;
+        }
+        _entries_extra_memory_usage -= old_entry->extra_memory_usage();
+        _entries_extra_memory_usage += entry_extra_memory_usage;
+        old_entry = std::move(entry);
+        ++_invalidations;
     }
+    evict_lru(max_memory);
+    _size.store(_cache.size());
 }
 
 std::shared_ptr<BitVectorSearchCache::Entry>
-BitVectorSearchCache::find(const std::string &term) const
+BitVectorSearchCache::lookup(const std::string &term) const
 {
     if (size() > 0ul) {
         std::shared_lock guard(_mutex);
@@ -48,6 +107,50 @@ BitVectorSearchCache::find(const std::string &term) const
     return {};
 }
 
+std::shared_ptr<BitVectorSearchCache::Entry>
+BitVectorSearchCache::find(const std::string &term) const
+{
+    auto entry = lookup(term);
+    if (entry) {
+        touch(*entry);
+        _hits.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        _misses.fetch_add(1, std::memory_order_relaxed);
+    }
+    return entry;
+}
+
+std::shared_ptr<BitVectorSearchCache::Entry>
+BitVectorSearchCache::find(const std::string &term, uint64_t generation, uint32_t docid_limit) const
+{
+    auto entry = lookup(term);
+    if (entry && entry->generation == generation && entry->docIdLimit == docid_limit) {
+        touch(*entry);
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        return entry;
+    }
+    _misses.fetch_add(1, std::memory_order_relaxed);
+    return {};
+}
+
+void
+BitVectorSearchCache::set_max_memory(size_t max_memory)
+{
+    std::unique_lock guard(_mutex);
+    _max_memory.store(max_memory, std::memory_order_relaxed);
+    evict_lru(max_memory);
+    _size.store(_cache.size());
+}
+
+vespalib::CacheStats
+BitVectorSearchCache::get_stats() const
+{
+    auto memory_usage = get_memory_usage();
+    std::shared_lock guard(_mutex);
+    return vespalib::CacheStats(_hits.load(std::memory_order_relaxed), _misses.load(std::memory_order_relaxed),
+                                _cache.size(), memory_usage.allocatedBytes(), _invalidations);
+}
+
 vespalib::MemoryUsage
 BitVectorSearchCache::get_memory_usage() const
 {
@@ -5,19 +5,27 @@
 #include <vespa/searchcommon/attribute/i_document_meta_store_context.h>
 #include <vespa/vespalib/stllike/hash_map.h>
 #include <atomic>
+#include <limits>
 #include <memory>
 #include <shared_mutex>
 #include <string>
 
 namespace search { class BitVector; }
-namespace vespalib { class MemoryUsage; }
+namespace vespalib {
+class MemoryUsage;
+struct CacheStats;
+}
 
 namespace search::attribute {
 
 /**
  * Class that caches posting lists (as bit vectors) for a set of search terms.
  *
- * Lifetime of cached bit vectors is controlled by calling clear() at regular intervals.
+ * Lifetime of cached bit vectors is controlled by calling clear() at regular intervals,
+ * or by inserting bit vectors populated for a newer generation of the searched attribute.
+ *
+ * Memory usage for cached bit vectors can be bounded, the least recently used bit vectors
+ * are evicted when inserting a bit vector would exceed the bound.
  */
 class BitVectorSearchCache {
 public:
@@ -30,9 +38,17 @@ public:
         ReadGuardSP dmsReadGuard;
         BitVectorSP bitVector;
         uint32_t docIdLimit;
+        // Generation of the searched attribute when the bit vector was populated
+        uint64_t generation;
+        mutable std::atomic<uint64_t> last_used;
         Entry(ReadGuardSP dmsReadGuard_, BitVectorSP bitVector_, uint32_t docIdLimit_) noexcept
-            : dmsReadGuard(std::move(dmsReadGuard_)), bitVector(std::move(bitVector_)), docIdLimit(docIdLimit_) {}
+            : Entry(std::move(dmsReadGuard_), std::move(bitVector_), docIdLimit_, 0) {}
+        Entry(ReadGuardSP dmsReadGuard_, BitVectorSP bitVector_, uint32_t docIdLimit_, uint64_t generation_) noexcept
+            : dmsReadGuard(std::move(dmsReadGuard_)), bitVector(std::move(bitVector_)), docIdLimit(docIdLimit_),
+              generation(generation_), last_used(0) {}
+        size_t extra_memory_usage() const noexcept;
     };
+    static constexpr size_t unbounded_memory = std::numeric_limits<size_t>::max();
 
 private:
     using Cache = vespalib::hash_map<std::string, std::shared_ptr<Entry>>;
@@ -40,14 +56,36 @@ private:
     mutable std::shared_mutex _mutex;
     std::atomic<uint64_t>     _size;
     size_t                    _entries_extra_memory_usage;
+    std::atomic<size_t>       _max_memory;
+    mutable std::atomic<uint64_t> _use_count;
+    mutable std::atomic<size_t>   _hits;
+    mutable std::atomic<size_t>   _misses;
+    size_t                    _invalidations;
     Cache _cache;
 
+    std::shared_ptr<Entry> lookup(const std::string &term) const;
+    void touch(const Entry &entry) const noexcept;
+    void evict_lru(size_t max_memory);
+
 public:
     BitVectorSearchCache();
+    explicit BitVectorSearchCache(size_t max_memory);
     ~BitVectorSearchCache();
+    /*
+     * Inserts an entry for the term. An existing entry for the term is only replaced
+     * if the new entry is for a newer generation.
+     */
     void insert(const std::string &term, std::shared_ptr<Entry> entry);
     std::shared_ptr<Entry> find(const std::string &term) const;
+    /*
+     * Returns the entry for the term if it was populated for the given attribute
+     * generation and docid limit, i.e. no changes to the attribute has been committed since.
+     */
+    std::shared_ptr<Entry> find(const std::string &term, uint64_t generation, uint32_t docid_limit) const;
     size_t size() const { return _size.load(std::memory_order_relaxed); }
+    size_t max_memory() const noexcept { return _max_memory.load(std::memory_order_relaxed); }
+    void set_max_memory(size_t max_memory);
+    vespalib::CacheStats get_stats() const;
     vespalib::MemoryUsage get_memory_usage() const;
     void clear();
 };
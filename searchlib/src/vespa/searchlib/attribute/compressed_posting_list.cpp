@@ -0,0 +1,125 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compressed_posting_list.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace search::attribute {
+
+CompressedPostingList::CompressedPostingList(std::span<const uint32_t> docids)
+    : _blocks(),
+      _words(),
+      _size(docids.size())
+{
+    _blocks.reserve((docids.size() + block_size - 1) / block_size);
+    for (size_t start = 0; start < docids.size(); start += block_size) {
+        size_t end = std::min(start + block_size, docids.size());
+        uint32_t max_delta = 0;
+        for (size_t i = start + 1; i < end; ++i) {
+            assert(docids[i] > docids[i - 1]);
+            max_delta = std::max(max_delta, docids[i] - docids[i - 1] - 1);
+        }
+        uint32_t bits = std::bit_width(max_delta);
+        _blocks.emplace_back(docids[start], _words.size(), bits);
+        uint64_t acc = 0;
+        uint32_t acc_bits = 0;
+        for (size_t i = start + 1; i < end; ++i) {
+            acc |= uint64_t(docids[i] - docids[i - 1] - 1) << acc_bits;
+            acc_bits += bits;
+            if (acc_bits >= 32) {
+                _words.push_back(static_cast<uint32_t>(acc));
+                acc >>= 32;
+                acc_bits -= 32;
+            }
+        }
+        if (acc_bits > 0) {
+            _words.push_back(static_cast<uint32_t>(acc));
+        }
+    }
+    // Padding word, decoding always reads two adjacent words
+    _words.push_back(0);
+    _words.shrink_to_fit();
+}
+
+CompressedPostingList::~CompressedPostingList() = default;
+
+uint32_t
+CompressedPostingList::find_block(uint32_t first, uint32_t docId) const noexcept
+{
+    auto itr = std::upper_bound(_blocks.begin() + first, _blocks.end(), docId,
+                                [](uint32_t lhs, const BlockHeader &rhs) noexcept { return lhs < rhs.first_docid; });
+    uint32_t idx = itr - _blocks.begin();
+    return (idx > first) ? (idx - 1) : first;
+}
+
+uint32_t
+CompressedPostingList::decode_block(uint32_t idx, uint32_t *dst) const noexcept
+{
+    const BlockHeader &header = _blocks[idx];
+    uint32_t count = block_docs(idx);
+    const uint32_t *words = _words.data() + header.offset;
+    uint32_t bits = header.bits;
+    uint64_t mask = (uint64_t(1) << bits) - 1;
+    // Unpack deltas first, then calculate docids using prefix sum
+    if (bits == 0) {
+        std::fill(dst + 1, dst + count, 1u);
+    } else {
+        for (uint32_t i = 1; i < count; ++i) {
+            uint32_t bit_pos = (i - 1) * bits;
+            uint32_t word = bit_pos >> 5;
+            uint64_t value = words[word] | (uint64_t(words[word + 1]) << 32);
+            dst[i] = ((value >> (bit_pos & 31)) & mask) + 1;
+        }
+    }
+    dst[0] = header.first_docid;
+    for (uint32_t i = 1; i < count; ++i) {
+        dst[i] += dst[i - 1];
+    }
+    return count;
+}
+
+std::vector<uint32_t>
+CompressedPostingList::decode() const
+{
+    std::vector<uint32_t> result(_size);
+    for (uint32_t idx = 0; idx < _blocks.size(); ++idx) {
+        decode_block(idx, result.data() + idx * block_size);
+    }
+    return result;
+}
+
+void
+CompressedPostingIterator::linearSeek(uint32_t docId) noexcept
+{
+    if (!valid() || getKey() >= docId) {
+        return;
+    }
+    if (_docids[_count - 1] < docId) {
+        // Skip blocks using block headers
+        load_block(_block + 1 < _list->num_blocks() ? _list->find_block(_block + 1, docId) : _block + 1);
+    }
+    while (_pos < _count && _docids[_pos] < docId) {
+        ++_pos;
+    }
+    if (_pos == _count) {
+        load_block(_block + 1);
+    }
+}
+
+void
+CompressedPostingIterator::lower_bound(uint32_t docId) noexcept
+{
+    if (_list == nullptr) {
+        return;
+    }
+    load_block(_list->num_blocks() > 0 ? _list->find_block(0, docId) : 0);
+    while (_pos < _count && _docids[_pos] < docId) {
+        ++_pos;
+    }
+    if (_pos == _count) {
+        load_block(_block + 1);
+    }
+}
+
+}
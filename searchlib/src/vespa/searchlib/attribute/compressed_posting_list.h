@@ -0,0 +1,114 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace search::attribute {
+
+/**
+ * Immutable posting list with docids compressed in blocks of block_size docids.
+ *
+ * Each block header contains the first docid in the block, and the
+ * remaining docids are stored as deltas (minus one) bit packed using the
+ * width of the largest delta in the block. The block headers are used as
+ * a skip list, only the block containing the wanted docid is decoded.
+ *
+ * A compressed posting list is never changed after it has been built.
+ * Changes to the posting list creates a new compressed posting list, and
+ * the old one is kept on hold until no readers can observe it.
+ */
+class CompressedPostingList
+{
+public:
+    static constexpr uint32_t block_size = 128;
+    struct BlockHeader {
+        uint32_t first_docid;
+        uint32_t offset; // first word containing packed deltas for block
+        uint32_t bits;   // number of bits used for each delta
+        BlockHeader(uint32_t first_docid_in, uint32_t offset_in, uint32_t bits_in) noexcept
+            : first_docid(first_docid_in),
+              offset(offset_in),
+              bits(bits_in)
+        { }
+    };
+private:
+    std::vector<BlockHeader> _blocks;
+    std::vector<uint32_t>    _words;
+    uint32_t                 _size;
+
+public:
+    // docids must be sorted and unique
+    explicit CompressedPostingList(std::span<const uint32_t> docids);
+    ~CompressedPostingList();
+    CompressedPostingList(const CompressedPostingList &) = delete;
+    CompressedPostingList &operator=(const CompressedPostingList &) = delete;
+
+    uint32_t size() const noexcept { return _size; }
+    uint32_t num_blocks() const noexcept { return _blocks.size(); }
+    const BlockHeader &block(uint32_t idx) const noexcept { return _blocks[idx]; }
+    uint32_t block_docs(uint32_t idx) const noexcept {
+        return (idx + 1 < _blocks.size()) ? block_size : (_size - idx * block_size);
+    }
+    // Returns the last block at or after block first where the block starts at or before docId
+    uint32_t find_block(uint32_t first, uint32_t docId) const noexcept;
+    // Decode docids in block to dst (with room for block_size docids), returns number of docids
+    uint32_t decode_block(uint32_t idx, uint32_t *dst) const noexcept;
+    std::vector<uint32_t> decode() const;
+    size_t extra_bytes() const noexcept {
+        return _blocks.capacity() * sizeof(BlockHeader) + _words.capacity() * sizeof(uint32_t);
+    }
+
+    template <typename FunctionType>
+    void foreach_key(FunctionType func) const {
+        uint32_t docids[block_size];
+        for (uint32_t idx = 0; idx < _blocks.size(); ++idx) {
+            uint32_t count = decode_block(idx, docids);
+            for (uint32_t i = 0; i < count; ++i) {
+                func(docids[i]);
+            }
+        }
+    }
+};
+
+/**
+ * Inner attribute iterator used for compressed posting lists, decoding one
+ * block of docids at a time.
+ */
+class CompressedPostingIterator
+{
+    const CompressedPostingList *_list;
+    uint32_t                     _block;
+    uint32_t                     _pos;
+    uint32_t                     _count;
+    uint32_t                     _docids[CompressedPostingList::block_size];
+
+    void load_block(uint32_t idx) noexcept {
+        _block = idx;
+        _pos = 0;
+        _count = (idx < _list->num_blocks()) ? _list->decode_block(idx, _docids) : 0;
+    }
+public:
+    CompressedPostingIterator() noexcept : _list(nullptr), _block(0), _pos(0), _count(0) { }
+    explicit CompressedPostingIterator(const CompressedPostingList &list) noexcept
+        : _list(&list), _block(0), _pos(0), _count(0)
+    {
+        load_block(0);
+    }
+    bool valid() const noexcept { return _pos < _count; }
+    uint32_t getKey() const noexcept { return _docids[_pos]; }
+    int32_t getData() const noexcept { return 1; }
+    CompressedPostingIterator &operator++() noexcept {
+        if (++_pos == _count) {
+            load_block(_block + 1);
+        }
+        return *this;
+    }
+    void linearSeek(uint32_t docId) noexcept;
+    void lower_bound(uint32_t docId) noexcept;
+};
+
+}
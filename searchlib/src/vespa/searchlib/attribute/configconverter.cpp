@@ -92,6 +92,19 @@ convertMatch(AttributesConfig::Attribute::Match match_cfg) {
     assert(false);
 }
 
+HnswQuantization
+convert_quantization(AttributesConfig::Attribute::Index::Hnsw::Quantization quantization_cfg) {
+    switch (quantization_cfg) {
+        case AttributesConfig::Attribute::Index::Hnsw::Quantization::NONE:
+            return HnswQuantization::NONE;
+        case AttributesConfig::Attribute::Index::Hnsw::Quantization::INT8:
+            return HnswQuantization::INT8;
+        case AttributesConfig::Attribute::Index::Hnsw::Quantization::BINARY:
+            return HnswQuantization::BINARY;
+    }
+    assert(false);
+}
+
 }
 
 Config
@@ -108,7 +121,9 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     retval.setFastAccess(cfg.fastaccess);
     retval.setMutable(cfg.ismutable);
     retval.setPaged(cfg.paged);
+    retval.set_tiered_memory(cfg.tieredmemory);
     retval.setMaxUnCommittedMemory(cfg.maxuncommittedmemory);
+    retval.set_bitvector_search_cache_max_memory(cfg.bitvectorsearchcache.maxmemory);
     predicateParams.setArity(cfg.arity);
     predicateParams.setBounds(cfg.lowerbound, cfg.upperbound);
     predicateParams.setDensePostingListThreshold(cfg.densepostinglistthreshold);
@@ -141,10 +156,17 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
             break;
     }
     retval.set_distance_metric(dm);
-    if (cfg.index.hnsw.enabled) {
+    if (cfg.index.hnsw.enabled || cfg.index.ivfpq.enabled) {
+        std::optional<IvfPqIndexParams> ivf_pq;
+        if (cfg.index.ivfpq.enabled) {
+            ivf_pq.emplace(cfg.index.ivfpq.numlists, cfg.index.ivfpq.numsubquantizers,
+                           cfg.index.ivfpq.numprobes, cfg.index.ivfpq.mintrainingsize);
+        }
         retval.set_hnsw_index_params(HnswIndexParams(cfg.index.hnsw.maxlinkspernode,
                                                      cfg.index.hnsw.neighborstoexploreatinsert,
-                                                     dm, cfg.index.hnsw.multithreadedindexing));
+                                                     dm, cfg.index.hnsw.multithreadedindexing,
+                                                     convert_quantization(cfg.index.hnsw.quantization),
+                                                     ivf_pq));
     }
     if (retval.basicType().type() == BasicType::Type::TENSOR) {
         if (!cfg.tensortype.empty()) {
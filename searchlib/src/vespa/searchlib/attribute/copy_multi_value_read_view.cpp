@@ -33,6 +33,13 @@ CopyMultiValueReadView<MultiValueType, RawMultiValueType>::get_values(uint32_t d
     return std::span<const MultiValueType>(_copy.data(), raw.size());
 }
 
+template <typename MultiValueType, typename RawMultiValueType>
+void
+CopyMultiValueReadView<MultiValueType, RawMultiValueType>::prefetch(std::span<const uint32_t> docids) const
+{
+    _mv_mapping_read_view.prefetch(docids);
+}
+
 using multivalue::WeightedValue;
 
 template class CopyMultiValueReadView<int8_t, WeightedValue<int8_t>>;
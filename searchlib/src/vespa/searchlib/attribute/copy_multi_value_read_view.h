@@ -26,6 +26,7 @@ public:
     CopyMultiValueReadView(MultiValueMappingReadView<RawMultiValueType> mv_mapping_read_view);
     ~CopyMultiValueReadView() override;
     std::span<const MultiValueType> get_values(uint32_t docid) const override;
+    void prefetch(std::span<const uint32_t> docids) const override;
 };
 
 }
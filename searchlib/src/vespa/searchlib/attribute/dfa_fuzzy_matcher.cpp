@@ -2,9 +2,11 @@
 
 #include "dfa_fuzzy_matcher.h"
 #include "i_enum_store_dictionary.h"
+#include <vespa/vespalib/fuzzy/unicode_utils.h>
 #include <vespa/vespalib/text/utf8.h>
 #include <vespa/vespalib/text/lowercase.h>
 
+using vespalib::fuzzy::BitParallelLevenshtein;
 using vespalib::fuzzy::LevenshteinDfa;
 using vespalib::LowerCase;
 using vespalib::Utf8Reader;
@@ -42,6 +44,20 @@ extract_suffix(std::string_view target, uint32_t prefix_size)
     return result;
 }
 
+std::optional<BitParallelLevenshtein>
+make_bit_parallel(std::string_view suffix, uint8_t max_edits, bool cased, bool prefix_match, LevenshteinDfa::DfaType dfa_type)
+{
+    if (dfa_type != LevenshteinDfa::DfaType::Implicit) {
+        return std::nullopt;
+    }
+    auto suffix_u32 = cased ? vespalib::fuzzy::utf8_string_to_utf32(suffix)
+                            : vespalib::fuzzy::utf8_string_to_utf32_lowercased(suffix);
+    if (!BitParallelLevenshtein::supports_target_length(suffix_u32.size())) {
+        return std::nullopt;
+    }
+    return BitParallelLevenshtein(suffix_u32, max_edits, cased, prefix_match);
+}
+
 }
 
 DfaFuzzyMatcher::DfaFuzzyMatcher(std::string_view target, uint8_t max_edits, uint32_t prefix_size,
@@ -50,6 +66,7 @@ DfaFuzzyMatcher::DfaFuzzyMatcher(std::string_view target, uint8_t max_edits, uin
                                                   (cased ? LevenshteinDfa::Casing::Cased : LevenshteinDfa::Casing::Uncased),
                                                   dfa_type, // TODO reorder args
                                                   (prefix_match ? LevenshteinDfa::Matching::Prefix : LevenshteinDfa::Matching::FullString))),
+      _bit_parallel(make_bit_parallel(extract_suffix(target, prefix_size), max_edits, cased, prefix_match, dfa_type)),
       _successor(),
       _prefix(extract_prefix(target, prefix_size, cased)),
       _prefix_size(prefix_size),
@@ -100,7 +117,7 @@ DfaFuzzyMatcher::is_match(std::string_view word) const
         }
         word = word.substr(reader.getPos());
     }
-    auto match = _dfa.match(word);
+    auto match = _bit_parallel ? _bit_parallel->match(word) : _dfa.match(word);
     return match.matches();
 }
 
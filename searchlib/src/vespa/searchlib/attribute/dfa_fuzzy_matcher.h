@@ -4,7 +4,9 @@
 
 #include "dfa_string_comparator.h"
 #include <vespa/vespalib/datastore/atomic_entry_ref.h>
+#include <vespa/vespalib/fuzzy/bit_parallel_levenshtein.h>
 #include <vespa/vespalib/fuzzy/levenshtein_dfa.h>
+#include <optional>
 
 namespace search::attribute {
 
@@ -13,10 +15,16 @@ namespace search::attribute {
  *
  * The dictionary iterator is advanced based on the successor string from the DFA
  * each time the candidate word is _not_ a match.
+ *
+ * When an implicit DFA is requested, words that are matched one by one (without
+ * a dictionary iterator) are matched with a bit-parallel matcher instead if the
+ * target word (after the locked prefix) is short enough. It is as cheap to build
+ * as the implicit DFA, but much faster when no successor string is needed.
  */
 class DfaFuzzyMatcher {
 private:
     vespalib::fuzzy::LevenshteinDfa _dfa;
+    std::optional<vespalib::fuzzy::BitParallelLevenshtein> _bit_parallel;
     std::vector<uint32_t>           _successor;
     std::vector<uint32_t>           _prefix;
     uint32_t                        _prefix_size;
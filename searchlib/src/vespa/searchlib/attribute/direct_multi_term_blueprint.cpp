@@ -10,6 +10,17 @@
 
 namespace search::attribute {
 
+const char*
+to_string(MultiTermStrategy strategy) noexcept
+{
+    switch (strategy) {
+    case MultiTermStrategy::Heap: return "heap";
+    case MultiTermStrategy::HashFilter: return "hash_filter";
+    case MultiTermStrategy::BitvectorUnion: return "bitvector_union";
+    }
+    return "unknown";
+}
+
 template class DirectMultiTermBlueprint<IDocidPostingStore, InTermSearch>;
 template class DirectMultiTermBlueprint<IDocidPostingStore, queryeval::WeightedSetTermSearch>;
 template class DirectMultiTermBlueprint<IDocidWithWeightPostingStore, InTermSearch>;
@@ -17,6 +17,18 @@ namespace search::queryeval { class SearchIterator; }
 
 namespace search::attribute {
 
+/**
+ * How a DirectMultiTermBlueprint evaluates its terms:
+ *   Heap:           merge the posting list iterators using a heap.
+ *   HashFilter:     look up the attribute value(s) of each candidate document in a hash map
+ *                   of the terms (non-strict only).
+ *   BitvectorUnion: OR all posting lists into a bitvector per docid range up front
+ *                   (strict filter only).
+ */
+enum class MultiTermStrategy { Heap, HashFilter, BitvectorUnion };
+
+const char* to_string(MultiTermStrategy strategy) noexcept;
+
 /**
  * Blueprint used for multi-term query operators as InTerm, WeightedSetTerm or DotProduct
  * over an attribute which supports the IDocidPostingStore or IDocidWithWeightPostingStore interface.
@@ -36,7 +48,12 @@ private:
     using IteratorType = typename PostingStoreType::IteratorType;
     using IteratorWeights = std::variant<std::reference_wrapper<const std::vector<int32_t>>, std::vector<int32_t>>;
 
-    bool use_hash_filter(bool strict) const;
+    double hash_filter_cost_per_doc_ns() const;
+    double btree_iterator_cost_per_doc_ns() const;
+    bool use_bitvector_union(bool strict, bool filter_search) const;
+    MultiTermStrategy select_strategy(bool strict, bool filter_search, bool allow_hash_filter) const;
+
+    std::unique_ptr<queryeval::SearchIterator> create_bitvector_union(fef::TermFieldMatchData& tfmd, bool strict) const;
 
     IteratorWeights create_iterators(std::vector<IteratorType>& btree_iterators,
                                      std::vector<std::unique_ptr<queryeval::SearchIterator>>& bitvectors,
@@ -82,10 +99,7 @@ public:
 
     std::unique_ptr<queryeval::SearchIterator> createFilterSearchImpl(FilterConstraint constraint) const override;
     std::unique_ptr<queryeval::MatchingElementsSearch> create_matching_elements_search(const MatchingElementsFields &fields) const override;
-    void visitMembers(vespalib::ObjectVisitor& visitor) const override {
-        LeafBlueprint::visitMembers(visitor);
-        visit_attribute(visitor, _iattr);
-    }
+    void visitMembers(vespalib::ObjectVisitor& visitor) const override;
 };
 
 }
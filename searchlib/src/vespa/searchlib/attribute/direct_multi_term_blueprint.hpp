@@ -9,6 +9,8 @@
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/searchlib/queryeval/filter_wrapper.h>
 #include <vespa/searchlib/queryeval/orsearch.h>
+#include <vespa/searchlib/queryeval/termwise_search.h>
+#include <vespa/vespalib/objects/objectvisitor.h>
 #include <cmath>
 #include <memory>
 #include <type_traits>
@@ -42,12 +44,19 @@ DirectMultiTermBlueprint<PostingStoreType, SearchType>::~DirectMultiTermBlueprin
 
 
 template <typename PostingStoreType, typename SearchType>
-bool
-DirectMultiTermBlueprint<PostingStoreType, SearchType>::use_hash_filter(bool strict) const
+double
+DirectMultiTermBlueprint<PostingStoreType, SearchType>::hash_filter_cost_per_doc_ns() const
+{
+    // See btree_iterator_cost_per_doc_ns() for how the cost of a single lookup was measured.
+    // A document in a multi-value attribute needs one lookup per value. The average value count is not tracked,
+    // so the max value count is used as a conservative estimate.
+    return 26.0 * std::max(1u, _iattr.getMaxValueCount());
+}
+
+template <typename PostingStoreType, typename SearchType>
+double
+DirectMultiTermBlueprint<PostingStoreType, SearchType>::btree_iterator_cost_per_doc_ns() const
 {
-    if (strict || _iattr.hasMultiValue()) {
-        return false;
-    }
     // The following very simplified formula was created after analysing performance of the IN operator
     // on a 10M document corpus using a machine with an Intel Xeon 2.5 GHz CPU with 48 cores and 256 Gb of memory:
     // https://github.com/vespa-engine/system-test/tree/master/tests/performance/in_operator
@@ -71,10 +80,39 @@ DirectMultiTermBlueprint<PostingStoreType, SearchType>::use_hash_filter(bool str
     // The latency diff is divided with the number of hits the test filter produces and convert to nanoseconds:
     //   10M * (filter_hits_ratio / 1000) * 1000 * 1000
     // Based on the numbers we calculate the average cost per document (in nanoseconds) as 26.0 ns.
+    return 8.0 * std::log2(_terms.size());
+}
 
-    float hash_filter_cost_per_doc_ns = 26.0;
-    float btree_iterator_cost_per_doc_ns = 8.0 * std::log2(_terms.size());
-    return hash_filter_cost_per_doc_ns < btree_iterator_cost_per_doc_ns;
+template <typename PostingStoreType, typename SearchType>
+bool
+DirectMultiTermBlueprint<PostingStoreType, SearchType>::use_bitvector_union(bool strict, bool filter_search) const
+{
+    // Only used when no match data beyond the docid is needed, and when there are enough terms for
+    // the heap to be expensive.
+    if (!strict || !filter_search || (_terms.size() < 16)) {
+        return false;
+    }
+    // Building the union touches each posting once and then scans a bitvector over the docid range,
+    // while the heap pays for merging the posting lists for each hit.
+    double est_hits = getState().estimate().estHits;
+    double bitvector_union_cost_ns = est_hits * 1.0 + get_docid_limit() * 0.1;
+    double heap_cost_ns = est_hits * btree_iterator_cost_per_doc_ns();
+    return bitvector_union_cost_ns < heap_cost_ns;
+}
+
+template <typename PostingStoreType, typename SearchType>
+MultiTermStrategy
+DirectMultiTermBlueprint<PostingStoreType, SearchType>::select_strategy(bool strict, bool filter_search, bool allow_hash_filter) const
+{
+    if (use_bitvector_union(strict, filter_search)) {
+        return MultiTermStrategy::BitvectorUnion;
+    }
+    if (SearchType::supports_hash_filter && allow_hash_filter && !strict &&
+        (hash_filter_cost_per_doc_ns() < btree_iterator_cost_per_doc_ns()))
+    {
+        return MultiTermStrategy::HashFilter;
+    }
+    return MultiTermStrategy::Heap;
 }
 
 template <typename PostingStoreType, typename SearchType>
@@ -88,14 +126,20 @@ DirectMultiTermBlueprint<PostingStoreType, SearchType>::create_iterators(std::ve
     std::vector<int32_t> result_weights;
     for (size_t i = 0; i < _terms.size(); ++i) {
         const auto& r = _terms[i];
-        if (use_bitvector_when_available && _attr.has_bitvector(r.posting_idx)) {
+        bool use_bitvector = use_bitvector_when_available && _attr.has_bitvector(r.posting_idx);
+        // Compressed posting lists (filter attributes only) have no btree iterator
+        if (use_bitvector || _attr.has_compressed(r.posting_idx)) {
             if (bitvectors.empty()) {
                 // With a combination of weight iterators and bitvectors,
                 // ensure that the resulting weight vector matches the weight iterators.
                 result_weights.reserve(_weights.size());
                 result_weights.insert(result_weights.begin(), _weights.begin(), _weights.begin() + i);
             }
-            bitvectors.push_back(_attr.make_bitvector_iterator(r.posting_idx, get_docid_limit(), tfmd, strict));
+            if (use_bitvector) {
+                bitvectors.push_back(_attr.make_bitvector_iterator(r.posting_idx, get_docid_limit(), tfmd, strict));
+            } else {
+                bitvectors.push_back(_attr.make_compressed_iterator(r.posting_idx, get_docid_limit(), tfmd));
+            }
         } else {
             _attr.create(r.posting_idx, btree_iterators);
             if (!bitvectors.empty()) {
@@ -126,6 +170,20 @@ DirectMultiTermBlueprint<PostingStoreType, SearchType>::combine_iterators(std::u
     return multi_term_iterator;
 }
 
+template <typename PostingStoreType, typename SearchType>
+std::unique_ptr<SearchIterator>
+DirectMultiTermBlueprint<PostingStoreType, SearchType>::create_bitvector_union(fef::TermFieldMatchData& tfmd, bool strict) const
+{
+    std::vector<IteratorType> btree_iterators;
+    std::vector<SearchIterator::UP> bitvectors;
+    btree_iterators.reserve(_terms.size());
+    create_iterators(btree_iterators, bitvectors, true, tfmd, true);
+    auto multi_term = !btree_iterators.empty()
+            ? MultiTermOrFilterSearch::create(std::move(btree_iterators))
+            : std::unique_ptr<SearchIterator>();
+    return queryeval::make_termwise(combine_iterators(std::move(multi_term), std::move(bitvectors), true), strict, tfmd);
+}
+
 template <typename PostingStoreType, typename SearchType>
 template <bool filter_search, bool allow_hash_filter>
 std::unique_ptr<queryeval::SearchIterator>
@@ -137,8 +195,12 @@ DirectMultiTermBlueprint<PostingStoreType, SearchType>::create_search_helper(con
     }
     auto& tfmd = *tfmda[0];
     bool field_is_filter = getState().fields()[0].isFilter();
+    auto strategy = select_strategy(strict, (filter_search || field_is_filter), allow_hash_filter);
+    if (strategy == MultiTermStrategy::BitvectorUnion) {
+        return create_bitvector_union(tfmd, strict);
+    }
     if constexpr (SearchType::supports_hash_filter) {
-        if (allow_hash_filter && use_hash_filter(strict)) {
+        if (strategy == MultiTermStrategy::HashFilter) {
             return SearchType::create_hash_filter(tfmd, (filter_search || field_is_filter),
                                                   _weights, _terms,
                                                   _iattr, _attr, _dictionary_snapshot);
@@ -190,12 +252,17 @@ DirectMultiTermBlueprint<PostingStoreType, SearchType>::calculate_flow_stats(uin
     using MyAdapter = DirectPostingStoreFlowStatsAdapter;
     double est = OrFlow::estimate_of(MyAdapter(docid_limit), _terms);
     // Iterator benchmarking has shown that non-strict cost is different for attributes
-    // that support using a reverse hash filter (see use_hash_filter()).
+    // that support using a reverse hash filter (see select_strategy()).
     // Program used: searchlib/src/tests/queryeval/iterator_benchmark
     // Tests: analyze_and_with_filter_vs_in(), analyze_and_with_filter_vs_in_array()
-    double non_strict_cost = (SearchType::supports_hash_filter && !_iattr.hasMultiValue())
-            ? queryeval::flow::reverse_hash_lookup()
-            : OrFlow::cost_of(MyAdapter(docid_limit), _terms, false);
+    double non_strict_cost = OrFlow::cost_of(MyAdapter(docid_limit), _terms, false);
+    if (SearchType::supports_hash_filter) {
+        if (!_iattr.hasMultiValue()) {
+            non_strict_cost = queryeval::flow::reverse_hash_lookup();
+        } else if (hash_filter_cost_per_doc_ns() < btree_iterator_cost_per_doc_ns()) {
+            non_strict_cost = queryeval::flow::reverse_hash_lookup() * std::max(1u, _iattr.getMaxValueCount());
+        }
+    }
     return {est, non_strict_cost, OrFlow::cost_of(MyAdapter(docid_limit), _terms, true) + queryeval::flow::heap_cost(est, _terms.size())};
 }
 
@@ -210,4 +277,14 @@ DirectMultiTermBlueprint<PostingStoreType, SearchType>::create_matching_elements
     }
 }
 
+template <typename PostingStoreType, typename SearchType>
+void
+DirectMultiTermBlueprint<PostingStoreType, SearchType>::visitMembers(vespalib::ObjectVisitor& visitor) const
+{
+    LeafBlueprint::visitMembers(visitor);
+    visit_attribute(visitor, _iattr);
+    bool field_is_filter = getState().fields()[0].isFilter();
+    visitor.visitString("strategy", to_string(select_strategy(strict(), (SearchType::filter_search || field_is_filter), true)));
+}
+
 }
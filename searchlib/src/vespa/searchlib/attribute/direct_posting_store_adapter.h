@@ -35,6 +35,10 @@ public:
     make_bitvector_iterator(vespalib::datastore::EntryRef posting_idx, uint32_t doc_id_limit,
                             fef::TermFieldMatchData& match_data, bool strict) const override;
     bool has_bitvector(vespalib::datastore::EntryRef posting_idx) const noexcept override;
+    std::unique_ptr<queryeval::SearchIterator>
+    make_compressed_iterator(vespalib::datastore::EntryRef posting_idx, uint32_t doc_id_limit,
+                             fef::TermFieldMatchData& match_data) const override;
+    bool has_compressed(vespalib::datastore::EntryRef posting_idx) const noexcept override;
     bool has_always_btree_iterator() const noexcept override { return !_attr_is_filter; }
     void create(vespalib::datastore::EntryRef idx, std::vector<IteratorType>& dst) const override;
     IteratorType create(vespalib::datastore::EntryRef idx) const override;
@@ -53,6 +53,23 @@ has_bitvector(vespalib::datastore::EntryRef posting_idx) const noexcept
     return _posting_store.has_bitvector(posting_idx);
 }
 
+template <typename ParentType, typename PostingStoreType, typename EnumStoreType>
+std::unique_ptr<queryeval::SearchIterator>
+DirectPostingStoreAdapter<ParentType, PostingStoreType, EnumStoreType>::
+make_compressed_iterator(vespalib::datastore::EntryRef posting_idx, uint32_t doc_id_limit,
+                         fef::TermFieldMatchData& match_data) const
+{
+    return _posting_store.make_compressed_iterator(posting_idx, doc_id_limit, match_data);
+}
+
+template <typename ParentType, typename PostingStoreType, typename EnumStoreType>
+bool
+DirectPostingStoreAdapter<ParentType, PostingStoreType, EnumStoreType>::
+has_compressed(vespalib::datastore::EntryRef posting_idx) const noexcept
+{
+    return _posting_store.has_compressed(posting_idx);
+}
+
 template <typename ParentType, typename PostingStoreType, typename EnumStoreType>
 void
 DirectPostingStoreAdapter<ParentType, PostingStoreType, EnumStoreType>::
@@ -3,6 +3,7 @@
 #include "diversity.hpp"
 #include "singlenumericattribute.h"
 #include <vespa/vespalib/stllike/hash_map.h>
+#include <bit>
 
 using std::make_unique;
 namespace search::attribute::diversity {
@@ -45,27 +46,109 @@ struct FetchFloat {
     ValueType get(uint32_t docid) const { return attr->getFloat(docid); }
 };
 
-template <typename Fetcher>
+// Per group counts for any group value type
+template <typename T>
+class HashGroupCounts {
+    vespalib::hash_map<T, uint32_t> _counts;
+public:
+    explicit HashGroupCounts(size_t expected_groups) : _counts(expected_groups * 3) {}
+    size_t size() const noexcept { return _counts.size(); }
+    uint32_t &operator[](T group) { return _counts[group]; }
+    uint32_t *find(T group) {
+        auto found = _counts.find(group);
+        return (found != _counts.end()) ? &found->second : nullptr;
+    }
+};
+
+/*
+ * Per group counts for enum handles, stored in a flat open addressed
+ * table indexed by the hashed enum handle. Avoids the node allocations
+ * and indirections of a general hash map for the common case of
+ * diversifying on an enum attribute.
+ */
+class EnumGroupCounts {
+    struct Slot {
+        uint32_t group;
+        uint32_t count;
+        bool     used;
+    };
+    std::vector<Slot> _slots;
+    uint32_t          _mask;
+    size_t            _size;
+
+    uint32_t slot_of(uint32_t group) const noexcept {
+        // Fibonacci hashing, enum handles are not well distributed in the low bits
+        return uint32_t((uint64_t(group) * 0x9e3779b97f4a7c15ul) >> 32) & _mask;
+    }
+    Slot &lookup(uint32_t group) noexcept {
+        uint32_t idx = slot_of(group);
+        while (_slots[idx].used && (_slots[idx].group != group)) {
+            idx = (idx + 1) & _mask;
+        }
+        return _slots[idx];
+    }
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(_slots);
+        _slots.resize(old.size() * 2);
+        _mask = _slots.size() - 1;
+        for (const auto &slot : old) {
+            if (slot.used) {
+                lookup(slot.group) = slot;
+            }
+        }
+    }
+public:
+    explicit EnumGroupCounts(size_t expected_groups)
+        : _slots(std::bit_ceil(std::max(expected_groups * 2, size_t(64)))),
+          _mask(_slots.size() - 1),
+          _size(0)
+    { }
+    size_t size() const noexcept { return _size; }
+    uint32_t &operator[](uint32_t group) {
+        Slot *slot = &lookup(group);
+        if (!slot->used) {
+            if ((_size + 1) * 2 > _slots.size()) {
+                grow();
+                slot = &lookup(group);
+            }
+            *slot = Slot{group, 0, true};
+            ++_size;
+        }
+        return slot->count;
+    }
+    uint32_t *find(uint32_t group) noexcept {
+        Slot &slot = lookup(group);
+        return slot.used ? &slot.count : nullptr;
+    }
+};
+
+template <typename Fetcher, typename Counts>
 class DiversityFilterT final : public DiversityFilter {
 private:
+    using ValueType = typename Fetcher::ValueType;
+    static constexpr size_t max_batch_size = 64;
     size_t  _total_count;
     Fetcher _diversity;
     size_t  _max_per_group;
     size_t  _cutoff_max_groups;
     bool    _cutoff_strict;
-
-    using Diversity = vespalib::hash_map<typename Fetcher::ValueType, uint32_t>;
-    Diversity _seen;
+    Counts  _seen;
 public:
     DiversityFilterT(Fetcher diversity, size_t max_per_group, size_t cutoff_max_groups,
                      bool cutoff_strict, size_t max_total)
         : DiversityFilter(max_total), _total_count(0), _diversity(diversity), _max_per_group(max_per_group),
           _cutoff_max_groups(cutoff_max_groups), _cutoff_strict(cutoff_strict),
-          _seen(std::min(cutoff_max_groups, 10000ul)*3)
+          _seen(std::min(cutoff_max_groups, 10000ul))
     { }
 
     bool accepted(uint32_t docId) override;
+    void accepted_batch(const uint32_t *docids, size_t num_docids, bool *accepted_out) override;
 private:
+    bool must_fetch() const noexcept {
+        return (_total_count < _max_total) && ((_seen.size() < _cutoff_max_groups) || _cutoff_strict);
+    }
+    bool accepted_group(ValueType group);
     bool add() {
         ++_total_count;
         return true;
@@ -80,18 +163,23 @@ private:
     }
 };
 
-template <typename Fetcher>
+template <typename Fetcher, typename Counts>
 bool
-DiversityFilterT<Fetcher>::accepted(uint32_t docId) {
+DiversityFilterT<Fetcher, Counts>::accepted_group(ValueType group) {
+    if (_seen.size() < _cutoff_max_groups) {
+        return conditional_add(_seen[group]);
+    } else {
+        uint32_t *found = _seen.find(group);
+        return (found == nullptr) ? add() : conditional_add(*found);
+    }
+}
+
+template <typename Fetcher, typename Counts>
+bool
+DiversityFilterT<Fetcher, Counts>::accepted(uint32_t docId) {
     if (_total_count < _max_total) {
         if ((_seen.size() < _cutoff_max_groups) || _cutoff_strict) {
-            typename Fetcher::ValueType group = _diversity.get(docId);
-            if (_seen.size() < _cutoff_max_groups) {
-                return conditional_add(_seen[group]);
-            } else {
-                auto found = _seen.find(group);
-                return (found == _seen.end()) ? add() : conditional_add(found->second);
-            }
+            return accepted_group(_diversity.get(docId));
         } else if ( !_cutoff_strict) {
             return add();
         }
@@ -99,6 +187,48 @@ DiversityFilterT<Fetcher>::accepted(uint32_t docId) {
     return false;
 }
 
+template <typename Fetcher, typename Counts>
+void
+DiversityFilterT<Fetcher, Counts>::accepted_batch(const uint32_t *docids, size_t num_docids, bool *accepted_out) {
+    ValueType groups[max_batch_size];
+    for (size_t offset = 0; offset < num_docids; offset += max_batch_size) {
+        size_t n = std::min(num_docids - offset, max_batch_size);
+        if (!must_fetch()) {
+            for (size_t i = 0; i < n; ++i) {
+                accepted_out[offset + i] = accepted(docids[offset + i]);
+            }
+            continue;
+        }
+        // Independent loads of the diversity values, then the sequential counting
+        for (size_t i = 0; i < n; ++i) {
+            groups[i] = _diversity.get(docids[offset + i]);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (_total_count >= _max_total) {
+                accepted_out[offset + i] = false;
+            } else if ((_seen.size() < _cutoff_max_groups) || _cutoff_strict) {
+                accepted_out[offset + i] = accepted_group(groups[i]);
+            } else {
+                accepted_out[offset + i] = add();
+            }
+        }
+    }
+}
+
+void
+DiversityFilter::accepted_batch(const uint32_t *docids, size_t num_docids, bool *accepted_out)
+{
+    for (size_t i = 0; i < num_docids; ++i) {
+        accepted_out[i] = accepted(docids[i]);
+    }
+}
+
+template <typename Fetcher>
+using HashDiversityFilter = DiversityFilterT<Fetcher, HashGroupCounts<typename Fetcher::ValueType>>;
+
+template <typename Fetcher>
+using EnumDiversityFilter = DiversityFilterT<Fetcher, EnumGroupCounts>;
+
 std::unique_ptr<DiversityFilter>
 DiversityFilter::create(const IAttributeVector &diversity_attr, size_t wanted_hits,
                         size_t max_per_group, size_t cutoff_max_groups, bool cutoff_strict)
@@ -106,9 +236,9 @@ DiversityFilter::create(const IAttributeVector &diversity_attr, size_t wanted_hi
     if (diversity_attr.hasEnum()) { // must handle enum first
         FetchEnumFast fastEnum(diversity_attr);
         if (fastEnum.valid()) {
-            return make_unique<DiversityFilterT<FetchEnumFast>> (fastEnum, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<EnumDiversityFilter<FetchEnumFast>>(fastEnum, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
         } else {
-            return make_unique<DiversityFilterT<FetchEnum>>(FetchEnum(diversity_attr), max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<EnumDiversityFilter<FetchEnum>>(FetchEnum(diversity_attr), max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
         }
     } else if (diversity_attr.isIntegerType()) {
         using FetchInt32Fast = FetchNumberFast<SingleValueNumericAttribute<IntegerAttributeTemplate<int32_t> > >;
@@ -117,11 +247,11 @@ DiversityFilter::create(const IAttributeVector &diversity_attr, size_t wanted_hi
         FetchInt32Fast fastInt32(diversity_attr);
         FetchInt64Fast fastInt64(diversity_attr);
         if (fastInt32.valid()) {
-            return make_unique<DiversityFilterT<FetchInt32Fast>>(fastInt32, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<HashDiversityFilter<FetchInt32Fast>>(fastInt32, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
         } else if (fastInt64.valid()) {
-            return make_unique<DiversityFilterT<FetchInt64Fast>>(fastInt64, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<HashDiversityFilter<FetchInt64Fast>>(fastInt64, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
         } else {
-            return make_unique<DiversityFilterT<FetchInteger>>(FetchInteger(diversity_attr), max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<HashDiversityFilter<FetchInteger>>(FetchInteger(diversity_attr), max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
         }
     } else if (diversity_attr.isFloatingPointType()) {
         using FetchFloatFast = FetchNumberFast<SingleValueNumericAttribute<FloatingPointAttributeTemplate<float> > >;
@@ -129,11 +259,11 @@ DiversityFilter::create(const IAttributeVector &diversity_attr, size_t wanted_hi
         FetchFloatFast fastFloat(diversity_attr);
         FetchDoubleFast fastDouble(diversity_attr);
         if (fastFloat.valid()) {
-            return make_unique<DiversityFilterT<FetchFloatFast>>(fastFloat, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<HashDiversityFilter<FetchFloatFast>>(fastFloat, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
         } else if (fastDouble.valid()) {
-            return make_unique<DiversityFilterT<FetchDoubleFast>>(fastDouble, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<HashDiversityFilter<FetchDoubleFast>>(fastDouble, max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
         } else {
-            return make_unique<DiversityFilterT<FetchFloat>>(FetchFloat(diversity_attr), max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
+            return make_unique<HashDiversityFilter<FetchFloat>>(FetchFloat(diversity_attr), max_per_group, cutoff_max_groups, cutoff_strict, wanted_hits);
         }
     }
     return std::unique_ptr<DiversityFilter>();
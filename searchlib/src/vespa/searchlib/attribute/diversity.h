@@ -63,6 +63,11 @@ class DiversityFilter : public queryeval::IDiversifier {
 public:
     DiversityFilter(size_t max_total) : _max_total(max_total) {}
     size_t getMaxTotal() const { return _max_total; }
+    /**
+     * Same as calling accepted() for each docid in order, but lets the
+     * diversity values for the whole batch be fetched up front.
+     */
+    virtual void accepted_batch(const uint32_t *docids, size_t num_docids, bool *accepted_out);
     static std::unique_ptr<DiversityFilter>
     create(const IAttributeVector &diversity_attr, size_t wanted_hits,
            size_t max_per_group, size_t cutoff_max_groups, bool cutoff_strict);
@@ -70,39 +75,61 @@ protected:
     size_t _max_total;
 };
 
-template <typename Result>
+/**
+ * Collects posting list entries in batches before filtering them, the
+ * batch must be flushed before the result is inspected.
+ */
+template <typename Result, typename Item>
 class DiversityRecorder {
 private:
-    DiversityFilter & _filter;
-    Result &_result;
+    static constexpr size_t batch_size = 64;
+    DiversityFilter &_filter;
+    Result          &_result;
+    size_t           _size;
+    Item             _items[batch_size];
+    uint32_t         _docids[batch_size];
+    bool             _accepted[batch_size];
 public:
     DiversityRecorder(DiversityFilter & filter, Result &result)
-        : _filter(filter), _result(result)
+        : _filter(filter), _result(result), _size(0)
     { }
 
-    template <typename Item>
     void push_back(Item item) {
-        if (_filter.accepted(item._key)) {
-            _result.push_back(item);
+        _docids[_size] = item._key;
+        _items[_size++] = item;
+        if (_size == batch_size) {
+            flush();
         }
     }
 
+    void flush() {
+        if (_size == 0) {
+            return;
+        }
+        _filter.accepted_batch(_docids, _size, _accepted);
+        for (size_t i = 0; i < _size; ++i) {
+            if (_accepted[i]) {
+                _result.push_back(_items[i]);
+            }
+        }
+        _size = 0;
+    }
 };
 
 template <typename DictRange, typename PostingStore, typename Result>
 void diversify_2(const DictRange &range_in, const PostingStore &posting, DiversityFilter & filter,
                  Result &result, std::vector<size_t> &fragments)
 {
-
-    DiversityRecorder<Result> recorder(filter, result);
-    DictRange range(range_in);
     using DataType = typename PostingStore::DataType;
     using KeyDataType = typename PostingStore::KeyDataType;
+    DiversityRecorder<Result, KeyDataType> recorder(filter, result);
+    DictRange range(range_in);
     while (range.has_next() && (result.size() < filter.getMaxTotal())) {
         typename DictRange::Next dict_entry(range);
         posting.foreach_frozen(dict_entry.get().getData().load_acquire(),
                                [&](uint32_t key, const DataType &data)
                                { recorder.push_back(KeyDataType(key, data)); });
+        recorder.flush();
         if (fragments.back() < result.size()) {
             fragments.push_back(result.size());
         }
@@ -130,12 +157,13 @@ void diversify_single(vespalib::datastore::EntryRef posting_idx, const PostingSt
                Result &result, std::vector<size_t> &fragments)
 {
     auto filter = DiversityFilter::create(diversity_attr, wanted_hits, max_per_group, cutoff_max_groups, cutoff_strict);
-    DiversityRecorder<Result> recorder(*filter, result);
     using DataType = typename PostingStore::DataType;
     using KeyDataType = typename PostingStore::KeyDataType;
+    DiversityRecorder<Result, KeyDataType> recorder(*filter, result);
     posting.foreach_frozen(posting_idx,
                            [&](uint32_t key, const DataType &data)
                            { recorder.push_back(KeyDataType(key, data)); });
+    recorder.flush();
     if (fragments.back() < result.size()) {
         fragments.push_back(result.size());
     }
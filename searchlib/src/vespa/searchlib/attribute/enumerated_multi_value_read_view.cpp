@@ -34,6 +34,13 @@ EnumeratedMultiValueReadView<MultiValueType, RawMultiValueType, EnumEntryType>::
     return std::span<const MultiValueType>(_copy.data(), raw.size());
 }
 
+template <typename MultiValueType, typename RawMultiValueType, typename EnumEntryType>
+void
+EnumeratedMultiValueReadView<MultiValueType, RawMultiValueType, EnumEntryType>::prefetch(std::span<const uint32_t> docids) const
+{
+    _mv_mapping_read_view.prefetch(docids);
+}
+
 using multivalue::WeightedValue;
 
 using WeightedAtomicEntryRef = WeightedValue<AtomicEntryRef>;
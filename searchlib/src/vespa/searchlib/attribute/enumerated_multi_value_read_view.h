@@ -27,6 +27,7 @@ public:
     EnumeratedMultiValueReadView(MultiValueMappingReadView<RawMultiValueType> mv_mapping_read_view, const EnumStoreT<EnumEntryType>& enum_store);
     ~EnumeratedMultiValueReadView() override;
     std::span<const MultiValueType> get_values(uint32_t docid) const override;
+    void prefetch(std::span<const uint32_t> docids) const override;
 };
 
 }
@@ -0,0 +1,262 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "front_coded_string_dictionary.h"
+#include "enumstore.h"
+#include <vespa/vespalib/datastore/i_unique_store_dictionary_read_snapshot.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <algorithm>
+#include <cassert>
+
+namespace search::attribute {
+
+namespace {
+
+// Approximate size of a node in the delta set, excluding the string itself
+constexpr size_t delta_node_size = 4 * sizeof(void*) + sizeof(std::string);
+
+void
+put_varint(std::vector<char>& data, uint32_t value)
+{
+    while (value >= 0x80) {
+        data.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<char>(value));
+}
+
+uint32_t
+get_varint(const char* data, size_t& pos) noexcept
+{
+    uint32_t result = 0;
+    for (uint32_t shift = 0;; shift += 7) {
+        uint8_t byte = static_cast<uint8_t>(data[pos++]);
+        result |= uint32_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return result;
+        }
+    }
+}
+
+uint32_t
+shared_prefix_length(std::string_view lhs, std::string_view rhs) noexcept
+{
+    auto mismatch = std::mismatch(lhs.begin(), lhs.begin() + std::min(lhs.size(), rhs.size()), rhs.begin());
+    return mismatch.first - lhs.begin();
+}
+
+}
+
+FrontCodedStringDictionary::FrontCodedStringDictionary()
+    : _data(),
+      _block_offsets(),
+      _size(0),
+      _delta()
+{
+}
+
+FrontCodedStringDictionary::FrontCodedStringDictionary(std::span<const std::string> sorted_values)
+    : FrontCodedStringDictionary()
+{
+    build(sorted_values);
+}
+
+FrontCodedStringDictionary::FrontCodedStringDictionary(FrontCodedStringDictionary&&) noexcept = default;
+FrontCodedStringDictionary& FrontCodedStringDictionary::operator=(FrontCodedStringDictionary&&) noexcept = default;
+FrontCodedStringDictionary::~FrontCodedStringDictionary() = default;
+
+void
+FrontCodedStringDictionary::build(std::span<const std::string> sorted_values)
+{
+    std::vector<char> data;
+    std::vector<uint32_t> block_offsets;
+    block_offsets.reserve((sorted_values.size() + block_size - 1) / block_size);
+    for (size_t i = 0; i < sorted_values.size(); ++i) {
+        const auto& value = sorted_values[i];
+        if ((i % block_size) == 0) {
+            block_offsets.push_back(data.size());
+            put_varint(data, value.size());
+            data.insert(data.end(), value.begin(), value.end());
+        } else {
+            const auto& prev = sorted_values[i - 1];
+            assert(prev < value);
+            uint32_t shared = shared_prefix_length(prev, value);
+            put_varint(data, shared);
+            put_varint(data, value.size() - shared);
+            data.insert(data.end(), value.begin() + shared, value.end());
+        }
+    }
+    data.shrink_to_fit();
+    _data = std::move(data);
+    _block_offsets = std::move(block_offsets);
+    _size = sorted_values.size();
+}
+
+std::string_view
+FrontCodedStringDictionary::block_first(uint32_t block) const noexcept
+{
+    size_t pos = _block_offsets[block];
+    uint32_t len = get_varint(_data.data(), pos);
+    return {_data.data() + pos, len};
+}
+
+uint32_t
+FrontCodedStringDictionary::find_block(std::string_view value) const noexcept
+{
+    // Find last block where the first string is less than or equal to value
+    uint32_t lo = 0;
+    uint32_t hi = _block_offsets.size();
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (value < block_first(mid)) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return (lo > 0) ? (lo - 1) : 0;
+}
+
+template <typename Func>
+void
+FrontCodedStringDictionary::decode_block(uint32_t block, Func&& func) const
+{
+    uint32_t ordinal = block * block_size;
+    uint32_t end = std::min(ordinal + block_size, _size);
+    size_t pos = _block_offsets[block];
+    uint32_t len = get_varint(_data.data(), pos);
+    std::string value(_data.data() + pos, len);
+    pos += len;
+    if (!func(ordinal, value)) {
+        return;
+    }
+    while (++ordinal < end) {
+        uint32_t shared = get_varint(_data.data(), pos);
+        uint32_t suffix_len = get_varint(_data.data(), pos);
+        value.resize(shared);
+        value.append(_data.data() + pos, suffix_len);
+        pos += suffix_len;
+        if (!func(ordinal, value)) {
+            return;
+        }
+    }
+}
+
+FrontCodedStringDictionary
+FrontCodedStringDictionary::make(const EnumStoreT<const char*>& enum_store)
+{
+    std::vector<std::string> values;
+    auto snapshot = enum_store.get_dictionary().get_read_snapshot();
+    snapshot->fill();
+    snapshot->sort();
+    snapshot->foreach_key([&values, &enum_store](const vespalib::datastore::AtomicEntryRef& ref) {
+        values.emplace_back(enum_store.get_value(IEnumStore::Index(ref.load_acquire())));
+    });
+    // Enum store order depends on the folding of the attribute, the dictionary uses byte order
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return FrontCodedStringDictionary(values);
+}
+
+std::optional<uint32_t>
+FrontCodedStringDictionary::find(std::string_view value) const
+{
+    std::optional<uint32_t> result;
+    if (_size == 0) {
+        return result;
+    }
+    decode_block(find_block(value), [&result, value](uint32_t ordinal, const std::string& candidate) {
+        if (candidate == value) {
+            result = ordinal;
+            return false;
+        }
+        return std::string_view(candidate) < value;
+    });
+    return result;
+}
+
+std::string
+FrontCodedStringDictionary::get(uint32_t ordinal) const
+{
+    assert(ordinal < _size);
+    std::string result;
+    decode_block(ordinal / block_size, [&result, ordinal](uint32_t candidate_ordinal, const std::string& candidate) {
+        if (candidate_ordinal == ordinal) {
+            result = candidate;
+            return false;
+        }
+        return true;
+    });
+    return result;
+}
+
+bool
+FrontCodedStringDictionary::contains(std::string_view value) const
+{
+    return find(value).has_value() || _delta.contains(value);
+}
+
+bool
+FrontCodedStringDictionary::add(std::string_view value)
+{
+    if (find(value).has_value()) {
+        return false;
+    }
+    return _delta.emplace(value).second;
+}
+
+void
+FrontCodedStringDictionary::foreach_prefix(std::string_view prefix, const Callback& func) const
+{
+    auto delta_itr = _delta.lower_bound(prefix);
+    auto emit_delta_before = [this, &delta_itr, prefix, &func](const std::string* limit) {
+        while (delta_itr != _delta.end() && delta_itr->starts_with(prefix) && (limit == nullptr || *delta_itr < *limit)) {
+            func(*delta_itr);
+            ++delta_itr;
+        }
+    };
+    if (_size > 0) {
+        bool done = false;
+        for (uint32_t block = find_block(prefix); block < _block_offsets.size() && !done; ++block) {
+            decode_block(block, [prefix, &done, &emit_delta_before, &func](uint32_t, const std::string& value) {
+                if (std::string_view(value) < prefix) {
+                    return true;
+                }
+                if (!value.starts_with(prefix)) {
+                    done = true;
+                    return false;
+                }
+                emit_delta_before(&value);
+                func(value);
+                return true;
+            });
+        }
+    }
+    emit_delta_before(nullptr);
+}
+
+void
+FrontCodedStringDictionary::rebuild()
+{
+    if (_delta.empty()) {
+        return;
+    }
+    std::vector<std::string> values;
+    values.reserve(size());
+    foreach_prefix("", [&values](std::string_view value) { values.emplace_back(value); });
+    build(values);
+    _delta.clear();
+}
+
+vespalib::MemoryUsage
+FrontCodedStringDictionary::get_memory_usage() const
+{
+    size_t delta_bytes = 0;
+    for (const auto& value : _delta) {
+        delta_bytes += delta_node_size + ((value.capacity() > std::string().capacity()) ? value.capacity() : 0);
+    }
+    size_t allocated = _data.capacity() + _block_offsets.capacity() * sizeof(uint32_t) + delta_bytes;
+    size_t used = _data.size() + _block_offsets.size() * sizeof(uint32_t) + delta_bytes;
+    return {allocated, used, 0, 0};
+}
+
+}
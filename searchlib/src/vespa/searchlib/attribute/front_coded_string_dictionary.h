@@ -0,0 +1,84 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <set>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vespalib { class MemoryUsage; }
+
+namespace search {
+
+template <class EntryT> class EnumStoreT;
+
+namespace attribute {
+
+/**
+ * Compact dictionary of unique strings for read-mostly string attributes.
+ *
+ * The static part contains the strings sorted in byte order, front coded in
+ * blocks of block_size strings. The first string in each block is stored in
+ * full, and is used when binary searching for the block containing a string.
+ * The remaining strings in the block are stored as the length of the prefix
+ * shared with the previous string followed by the suffix. Long shared prefixes,
+ * e.g. urls and ids, are thus only stored once per block.
+ *
+ * New strings are added to a small mutable delta. The static part is rebuilt
+ * with the strings in the delta by calling rebuild(), e.g. during flush.
+ *
+ * Not thread safe, readers and writers must be synchronized by the owner.
+ */
+class FrontCodedStringDictionary {
+public:
+    static constexpr uint32_t block_size = 16;
+    using Callback = std::function<void(std::string_view)>;
+private:
+    std::vector<char>                    _data;
+    std::vector<uint32_t>                _block_offsets;
+    uint32_t                             _size;
+    std::set<std::string, std::less<>>   _delta;
+
+    void build(std::span<const std::string> sorted_values);
+    std::string_view block_first(uint32_t block) const noexcept;
+    uint32_t find_block(std::string_view value) const noexcept;
+    // Decode strings in block, calling func for each until it returns false
+    template <typename Func>
+    void decode_block(uint32_t block, Func&& func) const;
+public:
+    FrontCodedStringDictionary();
+    // values must be sorted in byte order and unique
+    explicit FrontCodedStringDictionary(std::span<const std::string> sorted_values);
+    FrontCodedStringDictionary(FrontCodedStringDictionary&&) noexcept;
+    FrontCodedStringDictionary& operator=(FrontCodedStringDictionary&&) noexcept;
+    ~FrontCodedStringDictionary();
+
+    // Build the static part from all unique values in an enum store
+    static FrontCodedStringDictionary make(const EnumStoreT<const char*>& enum_store);
+
+    uint32_t static_size() const noexcept { return _size; }
+    size_t delta_size() const noexcept { return _delta.size(); }
+    size_t size() const noexcept { return _size + _delta.size(); }
+
+    // Returns the ordinal of value in the static part
+    std::optional<uint32_t> find(std::string_view value) const;
+    // Returns the string with the given ordinal in the static part
+    std::string get(uint32_t ordinal) const;
+    bool contains(std::string_view value) const;
+    // Returns true if value was not already present
+    bool add(std::string_view value);
+    // Calls func for all strings starting with prefix, in byte order
+    void foreach_prefix(std::string_view prefix, const Callback& func) const;
+    // Merge the delta into the static part
+    void rebuild();
+    vespalib::MemoryUsage get_memory_usage() const;
+};
+
+}
+
+}
@@ -57,6 +57,8 @@ public:
     virtual bool has_btree_iterator(vespalib::datastore::EntryRef posting_idx) const noexcept = 0;
     virtual std::unique_ptr<queryeval::SearchIterator> make_bitvector_iterator(vespalib::datastore::EntryRef posting_idx, uint32_t doc_id_limit, fef::TermFieldMatchData &match_data, bool strict) const = 0;
     virtual bool has_bitvector(vespalib::datastore::EntryRef posting_idx) const noexcept = 0;
+    virtual std::unique_ptr<queryeval::SearchIterator> make_compressed_iterator(vespalib::datastore::EntryRef posting_idx, uint32_t doc_id_limit, fef::TermFieldMatchData &match_data) const = 0;
+    virtual bool has_compressed(vespalib::datastore::EntryRef posting_idx) const noexcept = 0;
     virtual int64_t get_integer_value(vespalib::datastore::EntryRef enum_idx) const noexcept = 0;
 
     /**
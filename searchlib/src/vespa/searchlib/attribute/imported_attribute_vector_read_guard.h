@@ -104,13 +104,21 @@ private:
 protected:
     const IAttributeVector              &_target_attribute;
 
+public:
     uint32_t getTargetLid(uint32_t lid) const {
         // Check range to avoid reading memory beyond end of mapping array
         uint32_t target_lid = lid < _targetLids.size() ? _targetLids[lid].load_acquire() : 0u;
         // Check target range
         return target_lid < _target_docid_limit ? target_lid : 0u;
     }
+    /*
+     * The target attribute, for callers that want to map lids with
+     * getTargetLid() and then read from the concrete target attribute
+     * type without going through the virtual getters of this class.
+     */
+    const IAttributeVector &target_attribute() const noexcept { return _target_attribute; }
 
+protected:
     bool is_sortable() const noexcept override;
     std::unique_ptr<ISortBlobWriter> make_sort_blob_writer(bool ascending, const common::BlobConverter* converter,
                                                            common::sortspec::MissingPolicy policy,
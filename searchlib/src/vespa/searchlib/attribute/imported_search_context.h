@@ -84,6 +84,9 @@ public:
     DoubleRange getAsDoubleTerm() const override;
     const QueryTermUCS4 * queryTerm() const override;
     const std::string& attributeName() const override;
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override {
+        _target_search_context->visitMembers(visitor);
+    }
 
     using DocId = uint32_t;
 
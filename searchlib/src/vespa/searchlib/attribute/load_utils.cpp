@@ -9,7 +9,12 @@
 #include <vespa/searchlib/util/fileutil.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/array.hpp>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadexecutor.h>
+#include <atomic>
 #include <filesystem>
+#include <thread>
 
 using search::multivalue::WeightedValue;
 using vespalib::datastore::AtomicEntryRef;
@@ -79,6 +84,37 @@ LoadUtils::loadUDAT(const AttributeVector& attr)
     return loadFile(attr, "udat");
 }
 
+void
+LoadUtils::for_each_chunk(vespalib::Executor* executor, size_t size, size_t chunk_size,
+                          const std::function<void(size_t, size_t)>& func)
+{
+    size_t num_chunks = (size + chunk_size - 1) / chunk_size;
+    std::atomic<size_t> next_chunk(0);
+    auto process_chunks = [&]() {
+        for (size_t i = next_chunk.fetch_add(1, std::memory_order_relaxed); i < num_chunks;
+             i = next_chunk.fetch_add(1, std::memory_order_relaxed))
+        {
+            size_t begin = i * chunk_size;
+            func(begin, std::min(begin + chunk_size, size));
+        }
+    };
+    size_t num_threads = 1;
+    if (executor != nullptr) {
+        auto* thread_executor = dynamic_cast<vespalib::ThreadExecutor*>(executor);
+        num_threads = (thread_executor != nullptr) ? thread_executor->getNumThreads() : std::thread::hardware_concurrency();
+    }
+    size_t num_tasks = std::min(std::max(num_threads, size_t(1)), std::max(num_chunks, size_t(1))) - 1;
+    vespalib::CountDownLatch latch(num_tasks);
+    for (size_t i = 0; i < num_tasks; ++i) {
+        auto rejected = executor->execute(vespalib::makeLambdaTask([&]() { process_chunks(); latch.countDown(); }));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    process_chunks();
+    latch.await();
+}
+
 
 #define INSTANTIATE_ARRAY(ValueType, Saver) \
 template uint32_t loadFromEnumeratedMultiValue(MultiValueMapping<ValueType>&, ReaderBase &, std::span<const atomic_utils::NonAtomicValue_t<ValueType>>, std::span<const uint32_t>, Saver)
@@ -5,6 +5,7 @@
 #include "atomic_utils.h"
 #include "readerbase.h"
 #include <vespa/searchcommon/attribute/multi_value_traits.h>
+#include <functional>
 #include <span>
 
 namespace vespalib::datastore {
@@ -12,7 +13,10 @@ namespace vespalib::datastore {
     class EntryRef;
 }
 
-namespace vespalib { class GenerationHolder; }
+namespace vespalib {
+    class Executor;
+    class GenerationHolder;
+}
 
 namespace search { class AttributeVector; }
 
@@ -38,6 +42,14 @@ public:
     static LoadedBufferUP loadIDX(const AttributeVector& attr);
     static LoadedBufferUP loadWeight(const AttributeVector& attr);
     static LoadedBufferUP loadUDAT(const AttributeVector& attr);
+
+    /**
+     * Calls func(begin, end) for each chunk of at most chunk_size elements in [0, size).
+     * Chunks are processed in parallel by the threads in the executor when given,
+     * and this function returns when all chunks have been processed.
+     */
+    static void for_each_chunk(vespalib::Executor* executor, size_t size, size_t chunk_size,
+                               const std::function<void(size_t, size_t)>& func);
 };
 
 /**
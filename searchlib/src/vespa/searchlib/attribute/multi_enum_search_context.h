@@ -33,6 +33,9 @@ protected:
     MultiEnumSearchContext(typename BaseSC::MatcherType&& matcher, const AttributeVector& toBeSearched, MultiValueMappingReadView<M> mv_mapping_read_view, const EnumStoreT<T>& enum_store);
 
 public:
+    // Prefetch the values for doc, to be matched by a later call to find()
+    void prefetch(DocId doc) const noexcept { _mv_mapping_read_view.prefetch(doc); }
+
     int32_t find(DocId doc, int32_t elemId, int32_t & weight) const {
         auto indices(_mv_mapping_read_view.get(doc));
         for (uint32_t i(elemId); i < indices.size(); i++) {
@@ -30,6 +30,8 @@ private:
 
 public:
     MultiNumericSearchContext(std::unique_ptr<QueryTermSimple> qTerm, const AttributeVector& toBeSearched, MultiValueMappingReadView<M> mv_mapping_read_view);
+    // Prefetch the values for doc, to be matched by a later call to find()
+    void prefetch(DocId doc) const noexcept { _mv_mapping_read_view.prefetch(doc); }
     int32_t find(DocId doc, int32_t elemId, int32_t & weight) const {
         auto values(_mv_mapping_read_view.get(doc));
         for (uint32_t i(elemId); i < values.size(); i++) {
@@ -4,32 +4,39 @@
 
 #include <vespa/searchlib/queryeval/searchiterator.h>
 #include <vespa/vespalib/stllike/hash_map.h>
+#include <vector>
 
 namespace search::fef { class TermFieldMatchData; }
 
 namespace search::attribute {
 
 /**
- * Search iterator used to match a multi-term query operator against a single value attribute.
+ * Search iterator used to match a multi-term query operator against a single value or multi-value attribute.
  *
  * The caller must provide a hash map (token -> weight) containing all tokens in the multi-term operator.
- * In doSeek() the attribute value for the docid is matched against the tokens hash map.
+ * In doSeek() the attribute value(s) for the docid is matched against the tokens hash map.
+ * For a multi-value attribute the weights of all distinct matching tokens are unpacked, highest weight first.
  *
- * @tparam WrapperType Type that wraps an attribute vector and provides access to the attribute value for a given docid.
+ * @tparam WrapperType Type that wraps an attribute vector and provides access to the attribute value (single value)
+ *                     or values (multi-value) for a given docid.
  */
 template <typename WrapperType>
 class MultiTermHashFilter final : public queryeval::SearchIterator
 {
 public:
     using Key = typename WrapperType::TokenT;
-    using TokenMap = vespalib::hash_map<Key, int32_t, vespalib::hash<Key>, std::equal_to<Key>, vespalib::hashtable_base::and_modulator>;
+    using TokenMap = vespalib::hash_map<Key, int32_t, vespalib::hash<Key>, std::equal_to<Key>, vespalib::hashtable_base::open_addressing>;
     static constexpr bool unpack_weights = WrapperType::unpack_weights;
+    static constexpr bool multi_value = WrapperType::multi_value;
 
 private:
     fef::TermFieldMatchData& _tfmd;
     WrapperType _attr;
     TokenMap _map;
     int32_t _weight;
+    std::vector<int32_t> _matched_weights;
+
+    bool matches(uint32_t docId);
 
 public:
     MultiTermHashFilter(fef::TermFieldMatchData& tfmd,
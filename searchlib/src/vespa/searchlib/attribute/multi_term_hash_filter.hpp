@@ -5,6 +5,8 @@
 #include "multi_term_hash_filter.h"
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <algorithm>
+#include <functional>
 
 namespace search::attribute {
 
@@ -15,25 +17,44 @@ MultiTermHashFilter<WrapperType>::MultiTermHashFilter(fef::TermFieldMatchData& t
     : _tfmd(tfmd),
       _attr(attr),
       _map(std::move(map)),
-      _weight(0)
+      _weight(0),
+      _matched_weights()
 {
 }
 
+template <typename WrapperType>
+bool
+MultiTermHashFilter<WrapperType>::matches(uint32_t docId)
+{
+    if constexpr (multi_value) {
+        for (auto token : _attr.getTokens(docId)) {
+            if (_map.find(token) != _map.end()) {
+                return true;
+            }
+        }
+        return false;
+    } else {
+        auto pos = _map.find(_attr.getToken(docId));
+        if (pos != _map.end()) {
+            _weight = pos->second;
+            return true;
+        }
+        return false;
+    }
+}
+
 template <typename WrapperType>
 void
 MultiTermHashFilter<WrapperType>::and_hits_into(BitVector& result, uint32_t begin_id)
 {
-    auto end = _map.end();
-    result.foreach_truebit([&, end](uint32_t key) { if ( _map.find(_attr.getToken(key)) == end) { result.clearBit(key); }}, begin_id);
+    result.foreach_truebit([&](uint32_t key) { if (!matches(key)) { result.clearBit(key); }}, begin_id);
 }
 
 template <typename WrapperType>
 void
 MultiTermHashFilter<WrapperType>::doSeek(uint32_t docId)
 {
-    auto pos = _map.find(_attr.getToken(docId));
-    if (pos != _map.end()) {
-        _weight = pos->second;
+    if (matches(docId)) {
         setDocId(docId);
     }
 }
@@ -42,7 +63,26 @@ template <typename WrapperType>
 void
 MultiTermHashFilter<WrapperType>::doUnpack(uint32_t docId)
 {
-    if constexpr (unpack_weights) {
+    if constexpr (unpack_weights && multi_value) {
+        _tfmd.reset(docId);
+        // A token present in several elements (array attribute) is a single match, as for the posting lists
+        auto tokens = _attr.getTokens(docId);
+        std::sort(tokens.begin(), tokens.end());
+        auto tokens_end = std::unique(tokens.begin(), tokens.end());
+        _matched_weights.clear();
+        for (auto itr = tokens.begin(); itr != tokens_end; ++itr) {
+            auto pos = _map.find(*itr);
+            if (pos != _map.end()) {
+                _matched_weights.push_back(pos->second);
+            }
+        }
+        std::sort(_matched_weights.begin(), _matched_weights.end(), std::greater<>());
+        for (int32_t weight : _matched_weights) {
+            fef::TermFieldMatchDataPosition pos;
+            pos.setElementWeight(weight);
+            _tfmd.appendPosition(pos);
+        }
+    } else if constexpr (unpack_weights) {
         _tfmd.reset(docId);
         fef::TermFieldMatchDataPosition pos;
         pos.setElementWeight(_weight);
@@ -51,5 +91,5 @@ MultiTermHashFilter<WrapperType>::doUnpack(uint32_t docId)
         _tfmd.resetOnlyDocId(docId);
     }
 }
-    
+
 }
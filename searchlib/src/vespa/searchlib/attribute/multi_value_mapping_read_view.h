@@ -7,6 +7,7 @@
 #include <vespa/vespalib/datastore/array_store_dynamic_type_mapper.h>
 #include <vespa/vespalib/datastore/dynamic_array_buffer_type.h>
 #include <vespa/vespalib/util/address_space.h>
+#include <span>
 
 namespace search::attribute {
 
@@ -35,6 +36,27 @@ public:
     {
     }
     std::span<const ElemT> get(uint32_t doc_id) const { return _store->get(_indices[doc_id].load_acquire()); }
+    // Prefetch the values for doc_id, to be read by a later call to get()
+    void prefetch(uint32_t doc_id) const noexcept {
+        if (doc_id < _indices.size()) {
+            _store->prefetch(_indices[doc_id].load_acquire());
+        }
+    }
+    /*
+     * Prefetch the values for multiple documents. All entry refs are
+     * prefetched before any of them are followed, overlapping the cache
+     * misses for the documents.
+     */
+    void prefetch(std::span<const uint32_t> doc_ids) const noexcept {
+        for (uint32_t doc_id : doc_ids) {
+            if (doc_id < _indices.size()) {
+                __builtin_prefetch(&_indices[doc_id]);
+            }
+        }
+        for (uint32_t doc_id : doc_ids) {
+            prefetch(doc_id);
+        }
+    }
     bool valid() const noexcept { return _store != nullptr; }
     uint32_t get_committed_docid_limit() const noexcept { return _indices.size(); }
 };
@@ -77,9 +77,10 @@ private:
     attribute::StringSortBlobWriter<asc> _writer;
 public:
     MultiStringSortBlobWriter(const MultiValueMappingT &mv_mapping, const EnumStoreT &enum_store,
-                              const common::BlobConverter *converter, search::common::sortspec::MissingPolicy policy,
-                              std::string_view missing_value)
-        : _mv_mapping(mv_mapping), _enum_store(enum_store), _writer(converter, policy, missing_value, true)
+                              const common::BlobConverter *converter,
+                              std::shared_ptr<const attribute::SortKeyCache::Keys> keys,
+                              search::common::sortspec::MissingPolicy policy, std::string_view missing_value)
+        : _mv_mapping(mv_mapping), _enum_store(enum_store), _writer(converter, std::move(keys), policy, missing_value, true)
     {}
     long write(uint32_t docid, void* buf, long available) override {
         _writer.reset(buf, available);
@@ -101,10 +102,10 @@ MultiValueStringAttributeT<B, M>::make_sort_blob_writer(bool ascending, const co
 {
     if (ascending) {
         using SBW = MultiStringSortBlobWriter<MultiValueMapping, EnumStore, true>;
-        return std::make_unique<SBW>(this->_mvMapping, this->_enumStore, converter, policy, missing_value);
+        return std::make_unique<SBW>(this->_mvMapping, this->_enumStore, converter, this->get_sort_keys(converter), policy, missing_value);
     } else {
         using SBW = MultiStringSortBlobWriter<MultiValueMapping, EnumStore, false>;
-        return std::make_unique<SBW>(this->_mvMapping, this->_enumStore, converter, policy, missing_value);
+        return std::make_unique<SBW>(this->_mvMapping, this->_enumStore, converter, this->get_sort_keys(converter), policy, missing_value);
     }
 }
 
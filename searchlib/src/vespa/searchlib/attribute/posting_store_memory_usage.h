@@ -13,18 +13,22 @@ struct PostingStoreMemoryUsage {
     vespalib::MemoryUsage btrees;
     vespalib::MemoryUsage short_arrays;
     vespalib::MemoryUsage bitvectors;
+    vespalib::MemoryUsage compressed;
     vespalib::MemoryUsage total;
     PostingStoreMemoryUsage(vespalib::MemoryUsage btrees_in,
                             vespalib::MemoryUsage short_arrays_in,
-                            vespalib::MemoryUsage bitvectors_in)
+                            vespalib::MemoryUsage bitvectors_in,
+                            vespalib::MemoryUsage compressed_in)
         : btrees(btrees_in),
           short_arrays(short_arrays_in),
           bitvectors(bitvectors_in),
+          compressed(compressed_in),
           total()
     {
         total.merge(btrees);
         total.merge(short_arrays);
         total.merge(bitvectors);
+        total.merge(compressed);
     }
 
 };
@@ -26,6 +26,7 @@ PostingListSearchContext(const IEnumStoreDictionary& dictionary, bool has_btree_
       _dictSize(_frozenDictionary.size()),
       _pidx(),
       _frozenRoot(),
+      _compressed(nullptr),
       _useBitVector(useBitVector),
       _estimated_hits()
 {
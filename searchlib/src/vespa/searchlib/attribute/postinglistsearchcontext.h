@@ -48,6 +48,7 @@ protected:
     uint32_t                      _dictSize;
     EntryRef                      _pidx;
     EntryRef                      _frozenRoot; // Posting list in tree form
+    const CompressedPostingList*  _compressed; // Posting list in compressed form
     bool                          _useBitVector;
     mutable std::optional<size_t> _estimated_hits; // Snapshot of size of posting lists in range
     static bool                   _preserve_weight; // Use temporary posting list with weight information
@@ -195,6 +196,10 @@ private:
     using Parent = PostingSearchContext<BaseSC, PostingListFoldedSearchContextT<DataT>, AttrT>;
     using RegexpUtil = vespalib::RegexpUtil;
     using Parent::_enumStore;
+    // Dictionary entries checked against a regex, and how many of them were rejected by
+    // the required literal prefilter. Only updated while looking up posting lists.
+    mutable uint32_t _regex_dictionary_entries;
+    mutable uint32_t _regex_prefilter_rejected;
     // Note: Steps iterator one or more steps when not using dictionary entry
     bool use_dictionary_entry(PostingListSearchContext::DictionaryConstIterator& it) const override;
     // Note: Uses copy of dictionary iterator to avoid stepping original.
@@ -204,6 +209,7 @@ private:
     bool use_posting_lists_when_non_strict(const ExecuteInfo& info) const override;
 public:
     StringPostingSearchContext(BaseSC&& base_sc, bool useBitVector, const AttrT &toBeSearched);
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
 };
 
 template <typename BaseSC, typename AttrT, typename DataT>
@@ -11,6 +11,8 @@
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/searchlib/common/bitvectoriterator.h>
 #include <vespa/searchlib/common/growablebitvector.h>
+#include <vespa/vespalib/objects/visit.h>
+#include <vespa/vespalib/regex/regex.h>
 
 
 using search::queryeval::EmptySearch;
@@ -40,6 +42,10 @@ PostingListSearchContextT<DataT>::lookupSingle()
         return;
     uint32_t typeId = _posting_store.getTypeId(_pidx);
     if (!_posting_store.isSmallArray(typeId)) {
+        if (_posting_store.isCompressed(typeId)) {
+            _compressed = _posting_store.getCompressedEntry(_pidx)->_list.get();
+            return;
+        }
         if (_posting_store.isBitVector(typeId)) {
             const BitVectorEntry *bve = _posting_store.getBitVectorEntry(_pidx);
             const GrowableBitVector *bv = bve->_bv.get();
@@ -239,6 +245,9 @@ createPostingIterator(fef::TermFieldMatchData *matchData, bool strict)
         if (!_pidx.valid()) {
             return std::make_unique<EmptySearch>();
         }
+        if (_compressed != nullptr) {
+            return std::make_unique<FilterAttributePostingListIteratorT<CompressedPostingIterator>>(_baseSearchCtx, matchData, *_compressed);
+        }
         if (!_frozenRoot.valid()) {
             uint32_t clusterSize = _posting_store.getClusterSize(_pidx);
             assert(clusterSize != 0);
@@ -277,6 +286,9 @@ PostingListSearchContextT<DataT>::singleHits() const
     if (!_pidx.valid()) {
         return 0u;
     }
+    if (_compressed != nullptr) {
+        return _compressed->size();
+    }
     if (!_frozenRoot.valid()) {
         return _posting_store.getClusterSize(_pidx);
     }
@@ -438,7 +450,9 @@ PostingListFoldedSearchContextT<DataT>::fillBitVector(const ExecuteInfo & exec_i
 template <typename BaseSC, typename AttrT, typename DataT>
 StringPostingSearchContext<BaseSC, AttrT, DataT>::
 StringPostingSearchContext(BaseSC&& base_sc, bool useBitVector, const AttrT &toBeSearched)
-    : Parent(std::move(base_sc), useBitVector, toBeSearched)
+    : Parent(std::move(base_sc), useBitVector, toBeSearched),
+      _regex_dictionary_entries(0),
+      _regex_prefilter_rejected(0)
 {
     if (this->valid()) {
         if (this->isPrefix()) {
@@ -474,9 +488,15 @@ template <typename BaseSC, typename AttrT, typename DataT>
 bool
 StringPostingSearchContext<BaseSC, AttrT, DataT>::use_dictionary_entry(PostingListSearchContext::DictionaryConstIterator& it) const {
     if ( this->isRegex() ) {
-        if (this->getRegex().valid() &&
-            this->getRegex().partial_match(_enumStore.get_value(it.getKey().load_acquire()))) {
-            return true;
+        const auto& regex = this->getRegex();
+        if (regex.valid()) {
+            const char* word = _enumStore.get_value(it.getKey().load_acquire());
+            ++_regex_dictionary_entries;
+            if (!regex.may_match(word)) {
+                ++_regex_prefilter_rejected;
+            } else if (regex.partial_match(word)) {
+                return true;
+            }
         }
         ++it;
         return false;
@@ -492,6 +512,21 @@ StringPostingSearchContext<BaseSC, AttrT, DataT>::use_dictionary_entry(PostingLi
     return true;
 }
 
+template <typename BaseSC, typename AttrT, typename DataT>
+void
+StringPostingSearchContext<BaseSC, AttrT, DataT>::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    Parent::visitMembers(visitor);
+    if (this->isRegex()) {
+        visit(visitor, "regex_dictionary_entries", _regex_dictionary_entries);
+        visit(visitor, "regex_prefilter_rejected", _regex_prefilter_rejected);
+        if (_regex_dictionary_entries > 0) {
+            visit(visitor, "regex_prefilter_selectivity",
+                  double(_regex_dictionary_entries - _regex_prefilter_rejected) / _regex_dictionary_entries);
+        }
+    }
+}
+
 template <typename BaseSC, typename AttrT, typename DataT>
 bool
 StringPostingSearchContext<BaseSC, AttrT, DataT>::use_posting_lists_when_non_strict(const ExecuteInfo& info) const
@@ -3,6 +3,7 @@
 #include "postingstore.h"
 #include <vespa/searchlib/common/bitvectoriterator.h>
 #include <vespa/searchlib/common/growablebitvector.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchcommon/attribute/config.h>
 #include <vespa/searchcommon/attribute/status.h>
 #include <vespa/vespalib/btree/btreeiterator.hpp>
@@ -18,15 +19,60 @@ namespace search::attribute {
 using vespalib::btree::BTreeNoLeafData;
 using vespalib::datastore::EntryRefFilter;
 
+namespace {
+
+/*
+ * Search iterator over a compressed posting list, used when no search
+ * context is available (e.g. multi term search on a filter attribute).
+ */
+class CompressedPostingListSearch : public queryeval::SearchIterator
+{
+    CompressedPostingIterator _iterator;
+    fef::TermFieldMatchData  &_match_data;
+    uint32_t                  _doc_id_limit;
+
+    void initRange(uint32_t begin, uint32_t end) override {
+        SearchIterator::initRange(begin, std::min(end, _doc_id_limit));
+        _iterator.lower_bound(begin);
+        update_doc_id();
+    }
+    void doSeek(uint32_t docId) override {
+        _iterator.linearSeek(docId);
+        update_doc_id();
+    }
+    void doUnpack(uint32_t docId) override {
+        _match_data.resetOnlyDocId(docId);
+    }
+    void update_doc_id() {
+        if (_iterator.valid() && !isAtEnd(_iterator.getKey())) {
+            setDocId(_iterator.getKey());
+        } else {
+            setAtEnd();
+        }
+    }
+public:
+    CompressedPostingListSearch(const CompressedPostingList &list, uint32_t doc_id_limit, fef::TermFieldMatchData &match_data)
+        : SearchIterator(),
+          _iterator(list),
+          _match_data(match_data),
+          _doc_id_limit(doc_id_limit)
+    { }
+    Trinary is_strict() const override { return Trinary::True; }
+};
+
+}
+
 PostingStoreBase2::PostingStoreBase2(IEnumStoreDictionary& dictionary, Status &status, const Config &config)
     : _bvSize(64u),
       _bvCapacity(128u),
       _minBvDocFreq(64),
       _maxBvDocFreq(std::numeric_limits<uint32_t>::max()),
+      _minCompressedDocFreq(256),
       _bvs(),
       _dictionary(dictionary),
       _status(status),
       _bvExtraBytes(0),
+      _compressedExtraBytes(0),
       _compaction_spec(),
       _isFilter(config.getIsFilter())
 { }
@@ -61,10 +107,12 @@ template <typename DataT>
 PostingStore<DataT>::PostingStore(IEnumStoreDictionary& dictionary, Status &status, const Config &config)
     : Parent(false),
       PostingStoreBase2(dictionary, status, config),
-      _bvType(1, 1024u, RefType::offsetSize())
+      _bvType(1, 1024u, RefType::offsetSize()),
+      _compressedType(1, 1024u, RefType::offsetSize())
 {
     // TODO: Add type for bitvector
     _store.addType(&_bvType);
+    _store.addType(&_compressedType);
     _store.init_primary_buffers();
     _store.enableFreeLists();
 }
@@ -174,6 +222,8 @@ PostingStore<DataT>::applyNew(EntryRef &ref, AddIter a, AddIter ae)
         applyNewArray(ref, a, ae);
     } else if (clusterSize >= _maxBvDocFreq) {
         applyNewBitVector(ref, a, ae);
+    } else if (use_compressed(clusterSize)) {
+        applyNewCompressed(ref, a, ae);
     } else {
         applyNewTree(ref, a, ae, CompareT());
     }
@@ -309,6 +359,116 @@ PostingStore<DataT>::applyNewBitVector(EntryRef &ref, AddIter aOrg, AddIter ae)
 }
 
 
+template <typename DataT>
+void
+PostingStore<DataT>::makeCompressed(EntryRef &ref, std::span<const uint32_t> docids)
+{
+    assert(!ref.valid());
+    auto list = std::make_shared<const CompressedPostingList>(docids);
+    CompressedRefPair cPair(allocCompressed());
+    _compressedExtraBytes += list->extra_bytes();
+    cPair.data->_list = std::move(list);
+    ref = cPair.ref;
+}
+
+
+template <typename DataT>
+void
+PostingStore<DataT>::makeCompressed(EntryRef &ref)
+{
+    assert(ref.valid());
+    RefType iRef(ref);
+    assert(isBTree(getTypeId(iRef)));
+    std::vector<uint32_t> docids;
+    BTreeType *tree = getWTreeEntry(iRef);
+    docids.reserve(tree->size(_allocator));
+    for (Iterator it = begin(ref); it.valid(); ++it) {
+        docids.push_back(it.getKey());
+    }
+    tree->clear(_allocator);
+    _store.hold_entry(ref);
+    ref = EntryRef();
+    makeCompressed(ref, docids);
+}
+
+
+template <typename DataT>
+void
+PostingStore<DataT>::dropCompressed(EntryRef ref)
+{
+    RefType iRef(ref);
+    assert(isCompressed(getTypeId(iRef)));
+    // The compressed posting list is released when the entry is reclaimed
+    const CompressedPostingEntry *cpe = getCompressedEntry(iRef);
+    _compressedExtraBytes -= cpe->_list->extra_bytes();
+    _store.hold_entry(ref);
+}
+
+
+template <typename DataT>
+void
+PostingStore<DataT>::applyNewCompressed(EntryRef &ref, AddIter a, AddIter ae)
+{
+    assert(!ref.valid());
+    std::vector<uint32_t> docids;
+    docids.reserve(ae - a);
+    for (; a != ae; ++a) {
+        docids.push_back(a->_key);
+    }
+    makeCompressed(ref, docids);
+}
+
+
+template <typename DataT>
+void
+PostingStore<DataT>::applyCompressed(EntryRef &ref, AddIter a, AddIter ae, RemoveIter r, RemoveIter re)
+{
+    RefType iRef(ref);
+    const CompressedPostingList &list = *getCompressedEntry(iRef)->_list;
+    std::vector<uint32_t> old_docids = list.decode();
+    std::vector<KeyDataType> merged;
+    merged.reserve(old_docids.size() + (ae - a));
+    auto o = old_docids.cbegin();
+    auto oe = old_docids.cend();
+    while (o != oe || a != ae) {
+        if (a == ae || (o != oe && *o < a->_key)) {
+            while (r != re && *r < *o) {
+                ++r;
+            }
+            if (r != re && *r == *o) {
+                ++r;
+            } else {
+                merged.emplace_back(*o, bitVectorWeight());
+            }
+            ++o;
+        } else {
+            if (o != oe && *o == a->_key) {
+                ++o; // update
+            }
+            merged.emplace_back(a->_key, a->getData());
+            ++a;
+        }
+    }
+    dropCompressed(ref);
+    ref = EntryRef();
+    uint32_t docFreq = merged.size();
+    if (docFreq == 0) {
+        return;
+    }
+    if (docFreq >= _minCompressedDocFreq / 2 && docFreq < _maxBvDocFreq) {
+        // Keep compressed form when shrinking slightly, to avoid flipping between posting list types
+        std::vector<uint32_t> docids;
+        docids.reserve(docFreq);
+        for (const auto &elem : merged) {
+            docids.push_back(elem._key);
+        }
+        makeCompressed(ref, docids);
+    } else {
+        applyNew(ref, merged.data(), merged.data() + merged.size());
+    }
+}
+
+
 template <typename DataT>
 void
 PostingStore<DataT>::apply(BitVector &bv, AddIter a, AddIter ae, RemoveIter r, RemoveIter re)
@@ -356,8 +516,10 @@ PostingStore<DataT>::apply(EntryRef &ref, AddIter a, AddIter ae, RemoveIter r, R
         typeId = getTypeId(iRef);
     }
     // Old data was tree or has been converted to a tree
-    // ... or old data was bitvector
-    if (isBitVector(typeId)) {
+    // ... or old data was bitvector or compressed
+    if (isCompressed(typeId)) {
+        applyCompressed(ref, a, ae, r, re);
+    } else if (isBitVector(typeId)) {
         BitVectorEntry *bve = getWBitVectorEntry(iRef);
         EntryRef ref2(bve->_tree);
         RefType iRef2(ref2);
@@ -390,6 +552,10 @@ PostingStore<DataT>::apply(EntryRef &ref, AddIter a, AddIter ae, RemoveIter r, R
             makeBitVector(ref);
             return;
         }
+        if (use_compressed(docFreq)) {
+            makeCompressed(ref);
+            return;
+        }
         normalizeTree(ref, tree, wasArray);
     }
 }
@@ -399,7 +565,9 @@ template <typename DataT>
 size_t
 PostingStore<DataT>::internalSize(uint32_t typeId, const RefType & iRef) const
 {
-    if (isBitVector(typeId)) {
+    if (isCompressed(typeId)) {
+        return getCompressedEntry(iRef)->_list->size();
+    } else if (isBitVector(typeId)) {
         const BitVectorEntry *bve = getBitVectorEntry(iRef);
         RefType iRef2(bve->_tree);
         if (iRef2.valid()) {
@@ -421,7 +589,9 @@ template <typename DataT>
 size_t
 PostingStore<DataT>::internalFrozenSize(uint32_t typeId, const RefType & iRef) const
 {
-    if (isBitVector(typeId)) {
+    if (isCompressed(typeId)) {
+        return getCompressedEntry(iRef)->_list->size();
+    } else if (isBitVector(typeId)) {
         const BitVectorEntry *bve = getBitVectorEntry(iRef);
         RefType iRef2(bve->_tree);
         if (iRef2.valid()) {
@@ -459,6 +629,9 @@ PostingStore<DataT>::begin(const EntryRef ref) const
             }
             return Iterator();
         }
+        if (isCompressed(typeId)) {
+            return Iterator();
+        }
         const BTreeType *tree = getTreeEntry(iRef);
         return tree->begin(_allocator);
     }
@@ -487,6 +660,9 @@ PostingStore<DataT>::beginFrozen(const EntryRef ref) const
             }
             return ConstIterator();
         }
+        if (isCompressed(typeId)) {
+            return ConstIterator();
+        }
         const BTreeType *tree = getTreeEntry(iRef);
         return tree->getFrozenView(_allocator).begin();
     }
@@ -518,6 +694,10 @@ PostingStore<DataT>::beginFrozen(const EntryRef ref, std::vector<ConstIterator>
             where.emplace_back();
             return;
         }
+        if (isCompressed(typeId)) {
+            where.emplace_back();
+            return;
+        }
         const BTreeType *tree = getTreeEntry(iRef);
         tree->getFrozenView(_allocator).begin(where);
         return;
@@ -547,6 +727,9 @@ PostingStore<DataT>::getAggregated(const EntryRef ref) const
             }
             return AggregatedType();
         }
+        if (isCompressed(typeId)) {
+            return AggregatedType();
+        }
         const BTreeType *tree = getTreeEntry(iRef);
         return tree->getAggregated(_allocator);
     }
@@ -582,6 +765,8 @@ PostingStore<DataT>::clear(const EntryRef ref)
             _status.decBitVectors();
             _bvExtraBytes -= bve->_bv->writer().extraByteSize();
             _store.hold_entry(ref);
+        } else if (isCompressed(typeId)) {
+            dropCompressed(ref);
         } else {
             BTreeType *tree = getWTreeEntry(iRef);
             tree->clear(_allocator);
@@ -603,7 +788,11 @@ PostingStore<DataT>::getMemoryUsage() const
     uint64_t bvExtraBytes = _bvExtraBytes;
     bitvectors.incUsedBytes(bvExtraBytes);
     bitvectors.incAllocatedBytes(bvExtraBytes);
-    return {btrees, short_arrays, bitvectors};
+    vespalib::MemoryUsage compressed;
+    uint64_t compressedExtraBytes = _compressedExtraBytes;
+    compressed.incUsedBytes(compressedExtraBytes);
+    compressed.incAllocatedBytes(compressedExtraBytes);
+    return {btrees, short_arrays, bitvectors, compressed};
 }
 
 template <typename DataT>
@@ -620,9 +809,9 @@ PostingStore<DataT>::update_stat(const CompactionStrategy& compaction_strategy)
     } else {
         _compaction_spec = PostingStoreCompactionSpec();
     }
-    uint64_t bvExtraBytes = _bvExtraBytes;
-    usage.incUsedBytes(bvExtraBytes);
-    usage.incAllocatedBytes(bvExtraBytes);
+    uint64_t extraBytes = _bvExtraBytes + _compressedExtraBytes;
+    usage.incUsedBytes(extraBytes);
+    usage.incAllocatedBytes(extraBytes);
     return usage;
 }
 
@@ -683,6 +872,9 @@ PostingStore<DataT>::move(std::vector<EntryRef>& refs)
                     _bvs.insert(new_ref.ref());
                     ref = new_ref;
                 }
+            } else if (isCompressed(typeId)) {
+                assert(_store.getCompacting(iRef));
+                ref = allocCompressedCopy(*getCompressedEntry(iRef)).ref;
             } else {
                 assert(isBTree(typeId));
                 assert(_store.getCompacting(iRef));
@@ -780,6 +972,16 @@ PostingStore<DataT>::make_bitvector_iterator(RefType ref, uint32_t doc_id_limit,
     return BitVectorIterator::create(&bv, std::min(bv.size(), doc_id_limit), match_data, strict, false);
 }
 
+template <typename DataT>
+std::unique_ptr<queryeval::SearchIterator>
+PostingStore<DataT>::make_compressed_iterator(RefType ref, uint32_t doc_id_limit, fef::TermFieldMatchData &match_data) const
+{
+    if (!ref.valid() || !isCompressed(getTypeId(ref))) {
+        return {};
+    }
+    return std::make_unique<CompressedPostingListSearch>(*getCompressedEntry(ref)->_list, doc_id_limit, match_data);
+}
+
 template class PostingStore<BTreeNoLeafData>;
 template class PostingStore<int32_t>;
 
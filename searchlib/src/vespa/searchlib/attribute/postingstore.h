@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "compressed_posting_list.h"
 #include "enum_store_dictionary.h"
 #include "posting_store_compaction_spec.h"
 #include "posting_store_memory_usage.h"
@@ -34,19 +35,33 @@ public:
     { }
 };
 
+class CompressedPostingEntry
+{
+public:
+    std::shared_ptr<const CompressedPostingList> _list; // immutable, replaced on change
+
+public:
+    CompressedPostingEntry() noexcept
+        : _list()
+    { }
+};
+
 
 class PostingStoreBase2
 {
 protected:
     static constexpr uint32_t BUFFERTYPE_BITVECTOR = 9u;
+    static constexpr uint32_t BUFFERTYPE_COMPRESSED = 10u;
     uint32_t _bvSize;
     uint32_t _bvCapacity;
     uint32_t _minBvDocFreq; // Less than this ==> destroy bv
     uint32_t _maxBvDocFreq; // Greater than or equal to this ==> create bv
+    uint32_t _minCompressedDocFreq; // Greater than or equal to this ==> compress tree (filter only)
     std::set<uint32_t>         _bvs; // Current bitvectors
     IEnumStoreDictionary&      _dictionary;
     Status                    &_status;
     uint64_t                   _bvExtraBytes;
+    uint64_t                   _compressedExtraBytes;
     PostingStoreCompactionSpec _compaction_spec;
 private:
     bool                       _isFilter;
@@ -67,6 +82,7 @@ class PostingStore : public PostingListTraits<DataT>::PostingStoreBase,
     public PostingStoreBase2
 {
     vespalib::datastore::BufferType<BitVectorEntry> _bvType;
+    vespalib::datastore::BufferType<CompressedPostingEntry> _compressedType;
 public:
     using DataType = DataT;
     using Parent = typename PostingListTraits<DataT>::PostingStoreBase;
@@ -106,6 +122,7 @@ public:
     using Parent::_aggrCalc;
     using Parent::BUFFERTYPE_BTREE;
     using BitVectorRefPair = vespalib::datastore::Handle<BitVectorEntry>;
+    using CompressedRefPair = vespalib::datastore::Handle<CompressedPostingEntry>;
 
 
     PostingStore(IEnumStoreDictionary& dictionary, Status &status, const Config &config);
@@ -114,6 +131,7 @@ public:
     bool removeSparseBitVectors() override;
     void consider_remove_sparse_bitvector(std::vector<EntryRef> &refs);
     static bool isBitVector(uint32_t typeId) noexcept { return typeId == BUFFERTYPE_BITVECTOR; }
+    static bool isCompressed(uint32_t typeId) noexcept { return typeId == BUFFERTYPE_COMPRESSED; }
 
     void applyNew(EntryRef &ref, AddIter a, AddIter ae);
 
@@ -127,6 +145,16 @@ public:
             vespalib::datastore::DefaultReclaimer<BitVectorEntry> >(BUFFERTYPE_BITVECTOR).alloc(bve);
     }
 
+    CompressedRefPair allocCompressed() {
+        return _store.template freeListAllocator<CompressedPostingEntry,
+            vespalib::datastore::DefaultReclaimer<CompressedPostingEntry> >(BUFFERTYPE_COMPRESSED).alloc();
+    }
+
+    CompressedRefPair allocCompressedCopy(const CompressedPostingEntry& cpe) {
+        return _store.template freeListAllocator<CompressedPostingEntry,
+            vespalib::datastore::DefaultReclaimer<CompressedPostingEntry> >(BUFFERTYPE_COMPRESSED).alloc(cpe);
+    }
+
     /*
      * Recreate btree from bitvector. Weight information is not recreated.
      */
@@ -137,6 +165,21 @@ public:
     void applyNewBitVector(EntryRef &ref, AddIter aOrg, AddIter ae);
     void apply(BitVector &bv, AddIter a, AddIter ae, RemoveIter r, RemoveIter re);
 
+    /*
+     * Compressed posting lists are only used for filter attributes, where
+     * weight information is not needed. A change to a compressed posting
+     * list creates a new compressed posting list (or another posting list
+     * type), the old one is put on hold.
+     */
+    bool use_compressed(uint32_t docFreq) const noexcept {
+        return isFilter() && docFreq >= _minCompressedDocFreq && docFreq < _maxBvDocFreq;
+    }
+    void makeCompressed(EntryRef &ref, std::span<const uint32_t> docids);
+    void makeCompressed(EntryRef &ref);
+    void dropCompressed(EntryRef ref);
+    void applyNewCompressed(EntryRef &ref, AddIter a, AddIter ae);
+    void applyCompressed(EntryRef &ref, AddIter a, AddIter ae, RemoveIter r, RemoveIter re);
+
     /**
      * Apply multiple changes at once.
      *
@@ -188,14 +231,30 @@ public:
     BitVectorEntry *getWBitVectorEntry(RefType ref) {
         return _store.template getEntry<BitVectorEntry>(ref);
     }
+
+    const CompressedPostingEntry *getCompressedEntry(RefType ref) const {
+        return _store.template getEntry<CompressedPostingEntry>(ref);
+    }
+
+    CompressedPostingEntry *getWCompressedEntry(RefType ref) {
+        return _store.template getEntry<CompressedPostingEntry>(ref);
+    }
     bool has_btree(const EntryRef ref) const noexcept {
-        return !ref.valid() || !isBitVector(getTypeId(RefType(ref))) || !isFilter();
+        if (!ref.valid()) {
+            return true;
+        }
+        uint32_t typeId = getTypeId(RefType(ref));
+        return !isCompressed(typeId) && (!isBitVector(typeId) || !isFilter());
     }
     bool has_bitvector(const EntryRef ref) const noexcept {
         return ref.valid() && isBitVector(getTypeId(RefType(ref)));
     }
+    bool has_compressed(const EntryRef ref) const noexcept {
+        return ref.valid() && isCompressed(getTypeId(RefType(ref)));
+    }
 
     std::unique_ptr<queryeval::SearchIterator> make_bitvector_iterator(RefType ref, uint32_t doc_id_limit, fef::TermFieldMatchData &match_data, bool strict) const;
+    std::unique_ptr<queryeval::SearchIterator> make_compressed_iterator(RefType ref, uint32_t doc_id_limit, fef::TermFieldMatchData &match_data) const;
 
     static inline DataT bitVectorWeight();
     PostingStoreMemoryUsage getMemoryUsage() const;
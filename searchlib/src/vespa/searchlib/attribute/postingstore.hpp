@@ -33,6 +33,8 @@ PostingStore<DataT>::foreach_frozen_key(EntryRef ref, FunctionType func) const {
                     docId = bv->getNextTrueBit(docId + 1);
                 }
             }
+        } else if (isCompressed(typeId)) {
+            getCompressedEntry(iRef)->_list->foreach_key(func);
         } else {
             assert(isBTree(typeId));
             const BTreeType *tree = getTreeEntry(iRef);
@@ -75,6 +77,8 @@ PostingStore<DataT>::foreach_frozen(EntryRef ref, FunctionType func) const {
                     docId = bv->getNextTrueBit(docId + 1);
                 }
             }
+        } else if (isCompressed(typeId)) {
+            getCompressedEntry(iRef)->_list->foreach_key([&func](uint32_t docId) { func(docId, bitVectorWeight()); });
         } else {
             const BTreeType *tree = getTreeEntry(iRef);
             _allocator.getNodeStore().foreach(tree->getFrozenRoot(), func);
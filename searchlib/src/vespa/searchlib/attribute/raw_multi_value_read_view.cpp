@@ -20,6 +20,13 @@ RawMultiValueReadView<MultiValueType>::get_values(uint32_t docid) const
     return _mv_mapping_read_view.get(docid);
 }
 
+template <typename MultiValueType>
+void
+RawMultiValueReadView<MultiValueType>::prefetch(std::span<const uint32_t> docids) const
+{
+    _mv_mapping_read_view.prefetch(docids);
+}
+
 template class RawMultiValueReadView<int8_t>;
 template class RawMultiValueReadView<int16_t>;
 template class RawMultiValueReadView<int32_t>;
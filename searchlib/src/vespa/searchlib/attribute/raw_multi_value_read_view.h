@@ -19,6 +19,7 @@ public:
     RawMultiValueReadView(MultiValueMappingReadView<MultiValueType> mv_mapping_read_view);
     ~RawMultiValueReadView() override;
     std::span<const MultiValueType> get_values(uint32_t docid) const override;
+    void prefetch(std::span<const uint32_t> docids) const override;
 };
 
 }
@@ -3,7 +3,11 @@
 #include "search_context.h"
 #include "attributevector.h"
 #include "attributeiterators.hpp"
+#include "bitvector_search_cache.h"
 #include "ipostinglistsearchcontext.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 
 using search::queryeval::SearchIterator;
@@ -21,6 +25,15 @@ SearchContext::calc_hit_estimate() const
 
 std::unique_ptr<SearchIterator>
 SearchContext::createIterator(fef::TermFieldMatchData* matchData, bool strict)
+{
+    if (_cached_hits) {
+        return BitVectorIterator::create(_cached_hits.get(), _cache_docid_limit, *matchData, strict);
+    }
+    return create_uncached_iterator(matchData, strict);
+}
+
+std::unique_ptr<SearchIterator>
+SearchContext::create_uncached_iterator(fef::TermFieldMatchData* matchData, bool strict)
 {
     if (_plsc != nullptr) {
         auto res = _plsc->createPostingIterator(matchData, strict);
@@ -52,9 +65,22 @@ SearchContext::createFilterIterator(fef::TermFieldMatchData* matchData, bool str
 void
 SearchContext::fetchPostings(const queryeval::ExecuteInfo& execInfo, bool strict)
 {
+    if (!_cache_key.empty()) {
+        _cache_generation = _attr.getCurrentGeneration();
+        _cache_docid_limit = _attr.getCommittedDocIdLimit();
+        auto entry = _attr.get_bitvector_search_cache().find(_cache_key, _cache_generation, _cache_docid_limit);
+        if (entry) {
+            // Cached hits are used instead of the posting lists
+            _cached_hits = entry->bitVector;
+            return;
+        }
+    }
     if (_plsc != nullptr) {
         _plsc->fetchPostings(execInfo, strict);
     }
+    if (!_cache_key.empty() && strict && should_populate_cache()) {
+        populate_cache();
+    }
 }
 
 const std::string&
@@ -69,5 +95,40 @@ SearchContext::getIsFilter() const
     return _attr.getIsFilter();
 }
 
+void
+SearchContext::use_bitvector_search_cache(std::string key, bool range)
+{
+    _cache_key = std::move(key);
+    _cache_range = range;
+}
+
+bool
+SearchContext::should_populate_cache() const
+{
+    if (_cache_docid_limit <= 1u) {
+        return false;
+    }
+    if (!_cache_range) {
+        return true;
+    }
+    auto estimate = calc_hit_estimate();
+    return estimate.is_unknown() || (uint64_t(estimate.est_hits()) * wide_range_divisor >= _cache_docid_limit);
+}
+
+void
+SearchContext::populate_cache()
+{
+    fef::TermFieldMatchData tfmd;
+    auto iterator = create_uncached_iterator(&tfmd, true);
+    auto hits = BitVector::create(_cache_docid_limit);
+    iterator->initRange(1, _cache_docid_limit);
+    iterator->or_hits_into(*hits, 1);
+    hits->invalidateCachedCount();
+    _cached_hits = std::move(hits);
+    auto entry = std::make_shared<BitVectorSearchCache::Entry>(IDocumentMetaStoreContext::IReadGuard::SP(), _cached_hits,
+                                                               _cache_docid_limit, _cache_generation);
+    _attr.get_bitvector_search_cache().insert(_cache_key, std::move(entry));
+}
+
 
 }
@@ -3,10 +3,13 @@
 #pragma once
 
 #include <vespa/searchcommon/attribute/i_search_context.h>
+#include <memory>
+#include <string>
 
 namespace search {
 
 class AttributeVector;
+class BitVector;
 class QueryTermSimple;
 
 }
@@ -20,6 +23,9 @@ class IPostingListSearchContext;
 /*
  * SearchContext handles the creation of search iterators for a query term on an attribute vector.
  * This is an abstract class.
+ *
+ * Hits for expensive query terms can be cached as bit vectors in the bit vector search cache
+ * for the attribute vector. A cached bit vector is used until a change to the attribute is committed.
  */
 class SearchContext : public ISearchContext
 {
@@ -46,10 +52,27 @@ public:
 
     const AttributeVector& attribute() const { return _attr; }
 
+    /*
+     * Use the bit vector search cache for the attribute vector, with the given normalized
+     * query term as key. If range is true, hits are only cached for wide ranges.
+     */
+    void use_bitvector_search_cache(std::string key, bool range);
+
+    /*
+     * A range matching at least this fraction of the documents is considered wide,
+     * i.e. a bit vector is cheaper than merging the posting lists for each query.
+     */
+    static constexpr uint32_t wide_range_divisor = 64;
+
 protected:
     SearchContext(const AttributeVector& attr) noexcept
         : _attr(attr),
-          _plsc(nullptr)
+          _plsc(nullptr),
+          _cache_key(),
+          _cache_range(false),
+          _cache_generation(0),
+          _cache_docid_limit(0),
+          _cached_hits()
     {}
 
     const AttributeVector&                _attr;
@@ -62,6 +85,17 @@ protected:
     virtual std::unique_ptr<queryeval::SearchIterator> createFilterIterator(fef::TermFieldMatchData* matchData, bool strict);
 
     bool getIsFilter() const;
+
+private:
+    std::string                           _cache_key;
+    bool                                  _cache_range;
+    uint64_t                              _cache_generation;
+    uint32_t                              _cache_docid_limit;
+    std::shared_ptr<BitVector>            _cached_hits;
+
+    std::unique_ptr<queryeval::SearchIterator> create_uncached_iterator(fef::TermFieldMatchData* matchData, bool strict);
+    bool should_populate_cache() const;
+    void populate_cache();
 };
 
 }
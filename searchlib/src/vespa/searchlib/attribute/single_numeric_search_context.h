@@ -42,6 +42,13 @@ public:
         return this->match(v) ? 0 : -1;
     }
 
+    /*
+     * Returns a bitvector word with bits set for matching docids in
+     * [first, last), which must be within the same word. Used to scan a
+     * block of values at a time instead of calling find for each docid.
+     */
+    uint64_t match_word(DocId first, DocId last) const noexcept;
+
     std::unique_ptr<queryeval::SearchIterator>
     createFilterIterator(fef::TermFieldMatchData* matchData, bool strict) override;
     uint32_t get_committed_docid_limit() const noexcept override;
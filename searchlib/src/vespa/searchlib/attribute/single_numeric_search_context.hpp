@@ -32,6 +32,28 @@ SingleNumericSearchContext<T, M>::createFilterIterator(fef::TermFieldMatchData*
         : std::make_unique<AttributeIteratorT<SingleNumericSearchContext<T, M>>>(*this, matchData);
 }
 
+template <typename T, typename M>
+uint64_t
+SingleNumericSearchContext<T, M>::match_word(DocId first, DocId last) const noexcept
+{
+    constexpr uint32_t word_len = 64;
+    last = std::min(last, static_cast<DocId>(_data.size()));
+    if (first >= last) {
+        return 0;
+    }
+    uint32_t count = last - first;
+    // Load the values with relaxed atomics first, to allow the comparisons to be vectorized
+    T values[word_len];
+    for (uint32_t i = 0; i < count; ++i) {
+        values[i] = vespalib::atomic::load_ref_relaxed(_data[first + i]);
+    }
+    uint64_t bits = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        bits |= static_cast<uint64_t>(this->match(values[i])) << i;
+    }
+    return bits << (first % word_len);
+}
+
 template <typename T, typename M>
 uint32_t
 SingleNumericSearchContext<T, M>::get_committed_docid_limit() const noexcept
@@ -131,7 +131,7 @@ SingleValueNumericAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
 
 template <typename B>
 bool
-SingleValueNumericAttribute<B>::onLoad(vespalib::Executor *)
+SingleValueNumericAttribute<B>::onLoad(vespalib::Executor *executor)
 {
     PrimitiveReader<T> attrReader(*this);
     bool ok(attrReader.getHasLoadData());
@@ -148,9 +148,23 @@ SingleValueNumericAttribute<B>::onLoad(vespalib::Executor *)
     const size_t sz(attrReader.getDataCount());
     getGenerationHolder().reclaim_all();
     _data.reset();
-    _data.unsafe_reserve(sz);
-    for (uint32_t i = 0; i < sz; ++i) {
-        _data.push_back(attrReader.getNextData());
+    if (executor != nullptr && sz > 0) {
+        // Mmap the data file and copy chunks of it in parallel
+        constexpr size_t load_chunk_size = 1024 * 1024;
+        auto datBuffer = attribute::LoadUtils::loadDAT(*this);
+        assert(datBuffer->size(sizeof(T)) == sz);
+        const T *src = static_cast<const T *>(datBuffer->buffer());
+        _data.unsafe_resize(sz);
+        T *dst = &_data[0];
+        attribute::LoadUtils::for_each_chunk(executor, sz, load_chunk_size,
+                                             [src, dst](size_t begin, size_t end) {
+                                                 std::copy(src + begin, src + end, dst + begin);
+                                             });
+    } else {
+        _data.unsafe_reserve(sz);
+        for (uint32_t i = 0; i < sz; ++i) {
+            _data.push_back(attrReader.getNextData());
+        }
     }
 
     B::setNumDocs(sz);
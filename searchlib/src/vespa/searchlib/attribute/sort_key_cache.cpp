@@ -0,0 +1,130 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sort_key_cache.h"
+#include <vespa/searchcommon/common/iblobconverter.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+
+using search::common::BlobConverter;
+
+namespace search::attribute {
+
+SortKeyCache::Keys::Keys(vespalib::hash_map<std::string, std::string> keys)
+    : _keys(std::move(keys)),
+      _memory_usage(_keys.getMemoryConsumption()),
+      _misses(0)
+{
+    for (const auto& entry : _keys) {
+        _memory_usage += entry.first.capacity() + entry.second.capacity();
+    }
+}
+
+SortKeyCache::Keys::~Keys() = default;
+
+const std::string*
+SortKeyCache::Keys::find(const char* value) const
+{
+    auto itr = _keys.find(std::string_view(value));
+    if (itr == _keys.end()) {
+        _misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return &itr->second;
+}
+
+SortKeyCache::Entry::Entry(std::unique_ptr<BlobConverter> converter_in)
+    : converter(std::move(converter_in)),
+      keys()
+{
+}
+
+SortKeyCache::Entry::Entry(Entry&&) noexcept = default;
+SortKeyCache::Entry::~Entry() = default;
+
+SortKeyCache::SortKeyCache()
+    : _lock(),
+      _entries()
+{
+}
+
+SortKeyCache::~SortKeyCache() = default;
+
+std::shared_ptr<const SortKeyCache::Keys>
+SortKeyCache::get(const BlobConverter& converter) const
+{
+    auto id = converter.id();
+    if (id.empty()) {
+        return {};
+    }
+    std::lock_guard guard(_lock);
+    auto itr = _entries.find(id);
+    if (itr != _entries.end()) {
+        return itr->second.keys;
+    }
+    if (_entries.size() < max_converters) {
+        if (auto clone = converter.clone()) {
+            _entries.emplace(std::move(id), Entry(std::move(clone)));
+        }
+    }
+    return {};
+}
+
+bool
+SortKeyCache::needs_materialize() const
+{
+    std::lock_guard guard(_lock);
+    for (const auto& entry : _entries) {
+        if (entry.second.stale()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+SortKeyCache::materialize(const std::vector<std::string>& values)
+{
+    std::vector<std::pair<std::string, const BlobConverter*>> todo;
+    {
+        std::lock_guard guard(_lock);
+        for (const auto& entry : _entries) {
+            if (entry.second.stale()) {
+                todo.emplace_back(entry.first, entry.second.converter.get());
+            }
+        }
+    }
+    // Entries are never removed, and converters are only used here, so they can be used without the lock
+    for (const auto& [id, converter] : todo) {
+        vespalib::hash_map<std::string, std::string> keys(values.size());
+        for (const auto& value : values) {
+            auto key = converter->convert(vespalib::ConstBufferRef(value.c_str(), value.size() + 1));
+            keys[value] = std::string(key.c_str(), key.size());
+        }
+        auto materialized = std::make_shared<const Keys>(std::move(keys));
+        std::lock_guard guard(_lock);
+        _entries.find(id)->second.keys = std::move(materialized);
+    }
+}
+
+std::vector<SortKeyCache::Stats>
+SortKeyCache::get_stats() const
+{
+    std::vector<Stats> result;
+    std::lock_guard guard(_lock);
+    for (const auto& entry : _entries) {
+        const auto& keys = entry.second.keys;
+        result.push_back({entry.first, keys ? keys->size() : 0, keys ? keys->memory_usage() : 0, keys ? keys->misses() : 0});
+    }
+    return result;
+}
+
+size_t
+SortKeyCache::memory_usage() const
+{
+    size_t result = 0;
+    for (const auto& stats : get_stats()) {
+        result += stats.memory_usage;
+    }
+    return result;
+}
+
+}
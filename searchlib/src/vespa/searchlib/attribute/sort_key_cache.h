@@ -0,0 +1,77 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace search::common { class BlobConverter; }
+
+namespace search::attribute {
+
+/**
+ * Sort keys (e.g. UCA collation keys) for all unique values of a string
+ * attribute, materialized per converter on the attribute write thread.
+ *
+ * A converter is registered when a query first sorts with it, and its
+ * keys are materialized at the next stats update. Queries look up the
+ * key for a value, and only convert values missing from the keys, e.g.
+ * values added after the keys were materialized. Keys are materialized
+ * again when misses have been seen.
+ */
+class SortKeyCache {
+public:
+    class Keys {
+        vespalib::hash_map<std::string, std::string> _keys; // value -> sort key
+        size_t                                       _memory_usage;
+        mutable std::atomic<uint64_t>                _misses;
+    public:
+        explicit Keys(vespalib::hash_map<std::string, std::string> keys);
+        ~Keys();
+        // Returns nullptr and counts a miss if the value is unknown
+        const std::string* find(const char* value) const;
+        size_t size() const noexcept { return _keys.size(); }
+        size_t memory_usage() const noexcept { return _memory_usage; }
+        uint64_t misses() const noexcept { return _misses.load(std::memory_order_relaxed); }
+    };
+    struct Stats {
+        std::string id;
+        size_t      num_values;
+        size_t      memory_usage;
+        uint64_t    misses;
+    };
+    // Bounds the memory used, converters beyond this are not materialized
+    static constexpr size_t max_converters = 4;
+
+    SortKeyCache();
+    ~SortKeyCache();
+
+    /*
+     * Returns the materialized keys for the converter, or nullptr if
+     * none are available yet (or the converter can not be materialized).
+     */
+    std::shared_ptr<const Keys> get(const common::BlobConverter& converter) const;
+    bool needs_materialize() const;
+    // Called by the write thread with all unique values of the attribute
+    void materialize(const std::vector<std::string>& values);
+    std::vector<Stats> get_stats() const;
+    size_t memory_usage() const;
+private:
+    struct Entry {
+        std::unique_ptr<common::BlobConverter> converter; // only used by the write thread
+        std::shared_ptr<const Keys>            keys;
+        Entry(std::unique_ptr<common::BlobConverter> converter_in);
+        Entry(Entry&&) noexcept;
+        ~Entry();
+        bool stale() const noexcept { return !keys || (keys->misses() != 0); }
+    };
+    mutable std::mutex                   _lock;
+    mutable std::map<std::string, Entry> _entries; // keyed by converter id
+};
+
+}
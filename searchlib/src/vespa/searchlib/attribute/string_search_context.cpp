@@ -4,6 +4,8 @@
 #include "enumhintsearchcontext.h"
 #include "enumstore.h"
 #include <vespa/searchlib/query/query_term_ucs4.h>
+#include <vespa/vespalib/objects/visit.h>
+#include <vespa/vespalib/regex/regex.h>
 #include <vespa/vespalib/util/regexp.h>
 #include <vespa/vespalib/fuzzy/fuzzy_matcher.h>
 
@@ -37,6 +39,14 @@ StringSearchContext::valid() const
     return StringMatcher::isValid();
 }
 
+void
+StringSearchContext::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    if (isRegex() && getRegex().valid()) {
+        visit(visitor, "regex_required_literal", getRegex().required_literal());
+    }
+}
+
 void
 StringSearchContext::setup_enum_hint_sc(const EnumStoreT<const char*>& enum_store, EnumHintSearchContext& enum_hint_sc)
 {
@@ -32,6 +32,7 @@ public:
     ~StringSearchContext() override;
     const QueryTermUCS4* queryTerm() const override;
     bool valid() const override;
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
 
     void setup_enum_hint_sc(const EnumStoreT<const char*>& enum_store, EnumHintSearchContext& enum_hint_sc);
 };
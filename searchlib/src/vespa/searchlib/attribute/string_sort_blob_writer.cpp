@@ -23,10 +23,19 @@ unsigned char remap(unsigned char val)
 template <bool asc>
 StringSortBlobWriter<asc>::StringSortBlobWriter(const BlobConverter* bc, MissingPolicy policy,
                                                 std::string_view missing_value, bool multi_value) noexcept
+    : StringSortBlobWriter(bc, {}, policy, missing_value, multi_value)
+{
+}
+
+template <bool asc>
+StringSortBlobWriter<asc>::StringSortBlobWriter(const BlobConverter* bc, std::shared_ptr<const SortKeyCache::Keys> keys,
+                                                MissingPolicy policy, std::string_view missing_value,
+                                                bool multi_value) noexcept
     : _best_size(),
       _serialize_to(nullptr),
       _available(0),
       _bc(bc),
+      _keys(std::move(keys)),
       _missing_blob(),
       _value_prefix()
 {
@@ -84,7 +93,10 @@ StringSortBlobWriter<asc>::candidate(const char* val)
 {
     size_t size = std::strlen(val) + 1;
     vespalib::ConstBufferRef buf(val, size);
-    if (_bc != nullptr) {
+    const std::string* key = _keys ? _keys->find(val) : nullptr;
+    if (key != nullptr) {
+        buf = vespalib::ConstBufferRef(key->data(), key->size());
+    } else if (_bc != nullptr) {
         buf = _bc->convert(buf);
     }
     if (_best_size.has_value()) {
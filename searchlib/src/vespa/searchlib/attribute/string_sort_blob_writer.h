@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "sort_key_cache.h"
 #include <vespa/searchlib/common/sortspec.h>
 #include <optional>
 
@@ -21,6 +22,7 @@ class StringSortBlobWriter {
     unsigned char*               _serialize_to;
     size_t                       _available;
     const BlobConverter*         _bc;
+    std::shared_ptr<const SortKeyCache::Keys> _keys; // materialized conversions, if available
     std::vector<unsigned char>   _missing_blob; // blob to emit when not having a value
     std::optional<unsigned char> _value_prefix; // optional prefix to emit when having a value
 
@@ -29,6 +31,9 @@ class StringSortBlobWriter {
 public:
     StringSortBlobWriter(const BlobConverter* bc, search::common::sortspec::MissingPolicy policy,
                          std::string_view missing_value, bool multi_value) noexcept;
+    StringSortBlobWriter(const BlobConverter* bc, std::shared_ptr<const SortKeyCache::Keys> keys,
+                         search::common::sortspec::MissingPolicy policy,
+                         std::string_view missing_value, bool multi_value) noexcept;
     ~StringSortBlobWriter() noexcept;
     bool candidate(const char* val);
     void reset(void* serialize_to, size_t available);
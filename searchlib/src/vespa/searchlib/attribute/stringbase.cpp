@@ -5,11 +5,13 @@
 #include "load_utils.h"
 #include "readerbase.h"
 #include "enum_store_loaders.h"
+#include "enumstore.h"
 #include "string_sort_blob_writer.h"
 #include <vespa/searchlib/common/sort.h>
 #include <vespa/searchlib/query/query_term_ucs4.h>
 #include <vespa/searchcommon/attribute/i_sort_blob_writer.h>
 #include <vespa/searchcommon/attribute/config.h>
+#include <vespa/vespalib/datastore/i_unique_store_dictionary_read_snapshot.h>
 #include <vespa/vespalib/locale/c.h>
 
 #include <vespa/log/log.h>
@@ -32,14 +34,16 @@ StringAttribute::countZero(const char * bt, size_t sz)
 StringAttribute::StringAttribute(const std::string & name) :
     AttributeVector(name, Config(BasicType::STRING)),
     _changes(),
-    _defaultValue(ChangeBase::UPDATE, 0, std::string(""))
+    _defaultValue(ChangeBase::UPDATE, 0, std::string("")),
+    _sort_keys()
 {
 }
 
 StringAttribute::StringAttribute(const std::string & name, const Config & c) :
     AttributeVector(name, c),
     _changes(),
-    _defaultValue(ChangeBase::UPDATE, 0, std::string(""))
+    _defaultValue(ChangeBase::UPDATE, 0, std::string("")),
+    _sort_keys()
 {
 }
 
@@ -119,6 +123,7 @@ class SingleStringSortBlobWriter : public attribute::ISortBlobWriter {
     attribute::StringSortBlobWriter<asc> _writer;
 public:
     SingleStringSortBlobWriter(const StringAttribute& attr, const common::BlobConverter* bc,
+                               std::shared_ptr<const attribute::SortKeyCache::Keys> keys,
                                common::sortspec::MissingPolicy policy, std::string_view missing_value) noexcept;
     ~SingleStringSortBlobWriter() override;
     long write(uint32_t docid, void* ser_to, long available) override;
@@ -127,10 +132,11 @@ public:
 template <bool asc>
 SingleStringSortBlobWriter<asc>::SingleStringSortBlobWriter(const StringAttribute& attr,
                                                             const common::BlobConverter* bc,
+                                                            std::shared_ptr<const attribute::SortKeyCache::Keys> keys,
                                                             common::sortspec::MissingPolicy policy,
                                                             std::string_view missing_value) noexcept
     : _attr(attr),
-      _writer(bc, policy, missing_value, false)
+      _writer(bc, std::move(keys), policy, missing_value, false)
 {
 }
 
@@ -158,12 +164,40 @@ StringAttribute::make_sort_blob_writer(bool ascending, const common::BlobConvert
                                        std::string_view missing_value) const
 {
     if (ascending) {
-        return std::make_unique<SingleStringSortBlobWriter<true>>(*this, bc, policy, missing_value);
+        return std::make_unique<SingleStringSortBlobWriter<true>>(*this, bc, get_sort_keys(bc), policy, missing_value);
     } else {
-        return std::make_unique<SingleStringSortBlobWriter<false>>(*this, bc, policy, missing_value);
+        return std::make_unique<SingleStringSortBlobWriter<false>>(*this, bc, get_sort_keys(bc), policy, missing_value);
     }
 }
 
+std::shared_ptr<const attribute::SortKeyCache::Keys>
+StringAttribute::get_sort_keys(const common::BlobConverter* bc) const
+{
+    if (bc == nullptr) {
+        return {};
+    }
+    return _sort_keys.get(*bc);
+}
+
+void
+StringAttribute::update_sort_keys()
+{
+    if (!_sort_keys.needs_materialize()) {
+        return;
+    }
+    const auto* enum_store = dynamic_cast<const EnumStoreT<const char*>*>(getEnumStoreBase());
+    if (enum_store == nullptr) {
+        return;
+    }
+    std::vector<std::string> values;
+    auto snapshot = enum_store->get_dictionary().get_read_snapshot();
+    snapshot->fill();
+    snapshot->foreach_key([&values, enum_store](const vespalib::datastore::AtomicEntryRef& ref) {
+        values.emplace_back(enum_store->get_value(IEnumStore::Index(ref.load_acquire())));
+    });
+    _sort_keys.materialize(values);
+}
+
 uint32_t
 StringAttribute::clearDoc(DocId doc)
 {
@@ -6,6 +6,7 @@
 #include "attributevector.h"
 #include "i_enum_store.h"
 #include "loadedenumvalue.h"
+#include "sort_key_cache.h"
 #include "string_search_context.h"
 
 namespace search {
@@ -54,6 +55,7 @@ public:
     double getFloat(DocId doc)    const override;
     std::span<const char> get_raw(DocId) const override;
     static const char * defaultValue() { return ""; }
+    const attribute::SortKeyCache& get_sort_key_cache() const noexcept { return _sort_keys; }
 protected:
     StringAttribute(const std::string & name);
     StringAttribute(const std::string & name, const Config & c);
@@ -63,6 +65,7 @@ protected:
     using EnumEntryType = const char*;
     ChangeVector _changes;
     const Change _defaultValue;
+    attribute::SortKeyCache _sort_keys;
     bool onLoad(vespalib::Executor *executor) override;
 
     bool onLoadEnumerated(ReaderBase &attrReader);
@@ -77,6 +80,8 @@ protected:
     std::unique_ptr<attribute::ISortBlobWriter>
     make_sort_blob_writer(bool ascending, const common::BlobConverter* bc, common::sortspec::MissingPolicy policy,
                           std::string_view missing_value) const override;
+    std::shared_ptr<const attribute::SortKeyCache::Keys> get_sort_keys(const common::BlobConverter* bc) const;
+    void update_sort_keys() override;
 private:
     virtual void load_posting_lists(LoadedVector& loaded);
     virtual void load_enum_store(LoadedVector& loaded);
@@ -0,0 +1,63 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "value_statistics.h"
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <algorithm>
+#include <random>
+
+namespace search::attribute {
+
+ValueStatistics::ValueStatistics(std::vector<double> values, uint32_t sampled_docs)
+    : _values(std::move(values)),
+      _sampled_docs(sampled_docs)
+{
+    std::sort(_values.begin(), _values.end());
+}
+
+ValueStatistics::~ValueStatistics() = default;
+
+double
+ValueStatistics::estimate_hit_ratio(double low, double high) const noexcept
+{
+    if ((_sampled_docs == 0) || !(low <= high)) {
+        return 0.0;
+    }
+    auto first = std::lower_bound(_values.begin(), _values.end(), low);
+    auto last = std::upper_bound(first, _values.end(), high);
+    // A value missing from the sample might still be present in documents not sampled
+    double hits = std::max(double(last - first), 0.5);
+    return std::min(hits / _sampled_docs, 1.0);
+}
+
+std::shared_ptr<const ValueStatistics>
+ValueStatistics::sample(const IAttributeVector &attr, uint32_t docid_limit)
+{
+    bool integer = attr.isIntegerType();
+    if ((!integer && !attr.isFloatingPointType()) || attr.hasMultiValue() || (docid_limit <= 1)) {
+        return {};
+    }
+    auto add_value = [&attr, integer](std::vector<double> &values, uint32_t docid) {
+        if (!attr.isUndefined(docid)) {
+            values.push_back(integer ? double(attr.getInt(docid)) : attr.getFloat(docid));
+        }
+    };
+    uint32_t num_docs = docid_limit - 1;
+    std::vector<double> values;
+    if (num_docs <= max_sampled_docs) {
+        values.reserve(num_docs);
+        for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+            add_value(values, docid);
+        }
+        return std::make_shared<ValueStatistics>(std::move(values), num_docs);
+    }
+    // Fixed seed keeps the statistics (and thereby query planning) stable between samples
+    std::minstd_rand rnd(docid_limit);
+    std::uniform_int_distribution<uint32_t> dist(1, docid_limit - 1);
+    values.reserve(max_sampled_docs);
+    for (uint32_t i = 0; i < max_sampled_docs; ++i) {
+        add_value(values, dist(rnd));
+    }
+    return std::make_shared<ValueStatistics>(std::move(values), max_sampled_docs);
+}
+
+}
@@ -0,0 +1,45 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace search::attribute {
+
+class IAttributeVector;
+
+/**
+ * Statistics over the values of a single value numeric attribute, made
+ * from a uniform sample of its documents. The sorted sample works both
+ * as an equi-depth histogram for range terms and as a sketch of the
+ * frequent values for equality terms.
+ *
+ * Used to estimate hits for attributes that can not calculate a hit
+ * estimate from posting lists, e.g. attributes without fast-search.
+ */
+class ValueStatistics {
+private:
+    std::vector<double> _values; // sorted, defined values of the sampled documents
+    uint32_t            _sampled_docs;
+
+public:
+    static constexpr uint32_t max_sampled_docs = 1024;
+
+    ValueStatistics(std::vector<double> values, uint32_t sampled_docs);
+    ~ValueStatistics();
+    uint32_t sampled_docs() const noexcept { return _sampled_docs; }
+
+    // Estimated ratio of documents having a value in the inclusive range [low, high]
+    double estimate_hit_ratio(double low, double high) const noexcept;
+
+    /*
+     * Samples documents in [1, docid_limit), all of them when there are
+     * few enough. Returns nullptr if the attribute is not a single value
+     * numeric attribute or has no documents.
+     */
+    static std::shared_ptr<const ValueStatistics> sample(const IAttributeVector &attr, uint32_t docid_limit);
+};
+
+}
@@ -8,7 +8,9 @@
 #include <vespa/searchlib/index/postinglistparams.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/data/fileheader.h>
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".posocccompression");
@@ -68,11 +70,13 @@ readFeatures(search::index::DocIdAndFeatures &features)
         numElements = static_cast<uint32_t>(val64) + 1;
     }
     const uint64_t *valE = _valE;
+    int32_t max_element_weight = fieldParams._hasElementWeights ? std::numeric_limits<int32_t>::min() : 1;
     for (uint32_t elementDone = 0; elementDone < numElements; ++elementDone) {
         if (fieldParams._hasElements) {
             UC64_SKIPEXPGOLOMB_SMALL_NS(o, K_VALUE_POSOCC_ELEMENTID, EC);
             if (fieldParams._hasElementWeights) {
-                UC64_SKIPEXPGOLOMB_SMALL_NS(o, K_VALUE_POSOCC_ELEMENTWEIGHT, EC);
+                UC64_DECODEEXPGOLOMB_SMALL_NS(o, K_VALUE_POSOCC_ELEMENTWEIGHT, EC);
+                max_element_weight = std::max(max_element_weight, static_cast<int32_t>(this->convertToSigned(val64)));
             }
             if (__builtin_expect(oCompr >= valE, false)) {
                 UC64_DECODECONTEXT_STORE(o, _);
@@ -106,6 +110,7 @@ readFeatures(search::index::DocIdAndFeatures &features)
     }
     UC64_DECODECONTEXT_STORE(o, _);
     raw_features_collector.finish(*this, features);
+    features.set_max_element_weight(max_element_weight);
     this->readComprBufferIfNeeded();
 }
 
@@ -463,11 +468,13 @@ readFeatures(search::index::DocIdAndFeatures &features)
         numElements = static_cast<uint32_t>(val64) + 1;
     }
     const uint64_t *valE = _valE;
+    int32_t max_element_weight = fieldParams._hasElementWeights ? std::numeric_limits<int32_t>::min() : 1;
     for (uint32_t elementDone = 0; elementDone < numElements; ++elementDone) {
         if (fieldParams._hasElements) {
             UC64_SKIPEXPGOLOMB_SMALL_NS(o, K_VALUE_POSOCC_ELEMENTID, EC);
             if (fieldParams._hasElementWeights) {
-                UC64_SKIPEXPGOLOMB_SMALL_NS(o, K_VALUE_POSOCC_ELEMENTWEIGHT, EC);
+                UC64_DECODEEXPGOLOMB_SMALL_NS(o, K_VALUE_POSOCC_ELEMENTWEIGHT, EC);
+                max_element_weight = std::max(max_element_weight, static_cast<int32_t>(this->convertToSigned(val64)));
             }
             if (__builtin_expect(oCompr >= valE, false)) {
                 UC64_DECODECONTEXT_STORE(o, _);
@@ -495,6 +502,7 @@ readFeatures(search::index::DocIdAndFeatures &features)
     }
     UC64_DECODECONTEXT_STORE(o, _);
     raw_features_collector.finish(*this, features);
+    features.set_max_element_weight(max_element_weight);
     this->readComprBufferIfNeeded();
 }
 
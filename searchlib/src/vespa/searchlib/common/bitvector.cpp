@@ -384,23 +384,35 @@ BitVector::create(Index numberOfElements, FastOS_FileInterface &file,
         read_stats.read_bytes = vespalib::round_up_to_page_size(pad_before + getFileBytes(numberOfElements));
         bv = std::make_unique<MMappedBitVector>(numberOfElements, file, offset, doccount);
     } else {
-        size_t padbefore, padafter;
-        size_t vectorsize = getFileBytes(numberOfElements);
-        file.DirectIOPadding(offset, vectorsize, padbefore, padafter);
-        assert((padbefore & (getAlignment() - 1)) == 0);
-        AllocatedBitVector::Alloc alloc = Alloc::alloc(padbefore + vectorsize + padafter,
-                                                       MMAP_LIMIT, FileSettings::DIRECTIO_ALIGNMENT);
-        void * alignedBuffer = alloc.get();
-        file.ReadBuf(alignedBuffer, padbefore + vectorsize + padafter, offset - padbefore);
-        read_stats.read_bytes = padbefore + vectorsize + padafter;
-        bv = std::make_unique<AllocatedBitVector>(numberOfElements, std::move(alloc), padbefore);
-        bv->setTrueBits(doccount);
-        // Check guard bit for getNextTrueBit()
-        assert(bv->testBit(bv->size()));
+        auto buffer = make_file_read_buffer(numberOfElements, file, offset);
+        file.ReadBuf(buffer.alloc.get(), buffer.read_size, buffer.read_offset);
+        read_stats.read_bytes = buffer.read_size;
+        bv = create(numberOfElements, std::move(buffer), doccount);
     }
     return bv;
 }
 
+BitVector::FileReadBuffer
+BitVector::make_file_read_buffer(Index numberOfElements, FastOS_FileInterface &file, int64_t offset)
+{
+    size_t padbefore, padafter;
+    size_t vectorsize = getFileBytes(numberOfElements);
+    file.DirectIOPadding(offset, vectorsize, padbefore, padafter);
+    assert((padbefore & (getAlignment() - 1)) == 0);
+    Alloc alloc = Alloc::alloc(padbefore + vectorsize + padafter, MMAP_LIMIT, FileSettings::DIRECTIO_ALIGNMENT);
+    return {std::move(alloc), padbefore, offset - static_cast<int64_t>(padbefore), padbefore + vectorsize + padafter};
+}
+
+BitVector::UP
+BitVector::create(Index numberOfElements, FileReadBuffer buffer, Index doccount)
+{
+    UP bv = std::make_unique<AllocatedBitVector>(numberOfElements, std::move(buffer.alloc), buffer.pad_before);
+    bv->setTrueBits(doccount);
+    // Check guard bit for getNextTrueBit()
+    assert(bv->testBit(bv->size()));
+    return bv;
+}
+
 BitVector::UP
 BitVector::create(Index start, Index end)
 {
@@ -117,6 +117,26 @@ public:
         foreach(func, [](Word w) { return ~w; }, start, end);
     }
 
+    /**
+     * Calculate bits for the range [start, end) one word at a time and
+     * or them into this bitvector. calc(first, last) is called with a
+     * range within a single word, and returns the word with bits set
+     * for indexes in [first, last) that should be set.
+     */
+    template <typename CalcType>
+    void or_words(Index start, Index end, CalcType calc) {
+        update_words(start, end, calc, [](Word old, Word bits, Word mask) noexcept { return old | (bits & mask); });
+    }
+
+    /**
+     * Calculate bits for the range [start, end) one word at a time and
+     * and them into this bitvector. See or_words.
+     */
+    template <typename CalcType>
+    void and_words(Index start, Index end, CalcType calc) {
+        update_words(start, end, calc, [](Word old, Word bits, Word mask) noexcept { return old & (bits | ~mask); });
+    }
+
     Index getFirstTrueBit(Index start=0) const {
         return getNextTrueBit(std::max(start, getStartIndex()));
     }
@@ -279,6 +299,20 @@ public:
      * @param doccount          Number of bits set in bitvector
      */
     static UP create(Index numberOfElements, FastOS_FileInterface &file, int64_t offset, Index doccount, ReadStats& read_stats);
+
+    /*
+     * Buffer for reading a bit vector from a file that is not memory mapped
+     * when the caller performs the read, e.g. using async io.
+     */
+    struct FileReadBuffer {
+        vespalib::alloc::Alloc alloc;
+        size_t                 pad_before;
+        int64_t                read_offset; // Where to start reading into buffer
+        size_t                 read_size;   // Number of bytes to read into buffer
+    };
+    static FileReadBuffer make_file_read_buffer(Index numberOfElements, FastOS_FileInterface &file, int64_t offset);
+    // Create bit vector from a file read buffer that has been filled
+    static UP create(Index numberOfElements, FileReadBuffer buffer, Index doccount);
     static UP create(Index start, Index end);
     static UP create(const BitVector & org, Index start, Index end);
     static UP create(Index numberOfElements);
@@ -328,6 +362,22 @@ private:
     const Word * getActiveStart() const noexcept { return getWordIndex(getStartIndex()); }
     Word * getActiveStart() noexcept { return getWordIndex(getStartIndex()); }
     Index getStartWordNum() const noexcept { return wordNum(getStartIndex()); }
+    template <typename CalcType, typename CombineType>
+    void update_words(Index start, Index end, CalcType calc, CombineType combine) {
+        start = std::max(start, getStartIndex());
+        end = std::min(end, size());
+        while (start < end) {
+            Index word_end = std::min(end, (wordNum(start) + 1) << numWordBits());
+            Word mask = std::numeric_limits<Word>::max() << bitNum(start);
+            if (bitNum(word_end) != 0) {
+                mask &= std::numeric_limits<Word>::max() >> (WordLen - bitNum(word_end));
+            }
+            Word &word = *getWordIndex(start);
+            store_unchecked(word, combine(load(word), calc(start, word_end), mask));
+            start = word_end;
+        }
+        invalidateCachedCount();
+    }
     Index getActiveSize() const noexcept { return size() - getStartIndex(); }
     size_t getActiveBytes() const noexcept { return numActiveBytes(getStartIndex(), size()); }
     size_t numActiveWords() const noexcept { return numActiveWords(getStartIndex(), size()); }
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "geo_location.h"
+#include <algorithm>
 
 using vespalib::geo::ZCurve;
 
@@ -187,4 +188,18 @@ bool GeoLocation::inside_limit(Point p) const {
     return sq_dist <= _sq_radius;
 }
 
+bool GeoLocation::may_be_inside_limit(Box box) const {
+    if (box.x.high < bounding_box.x.low) return false;
+    if (box.x.low > bounding_box.x.high) return false;
+
+    if (box.y.high < bounding_box.y.low) return false;
+    if (box.y.low > bounding_box.y.high) return false;
+
+    if (!has_point || !has_radius()) return true;
+    // the point in the box closest to our point decides
+    Point closest(std::clamp(point.x, box.x.low, box.x.high),
+                  std::clamp(point.y, box.y.low, box.y.high));
+    return sq_distance_to(closest) <= _sq_radius;
+}
+
 } // namespace search::common
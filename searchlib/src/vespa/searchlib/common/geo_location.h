@@ -74,6 +74,8 @@ struct GeoLocation
 
     uint64_t sq_distance_to(Point p) const;
     bool inside_limit(Point p) const;
+    // whether any point in the given (inclusive) box may be inside the limit
+    bool may_be_inside_limit(Box box) const;
 
     bool inside_limit(int64_t zcurve_encoded_xy) const {
         if (_z_bounding_box.getzFailBoundingBoxTest(zcurve_encoded_xy)) return false;
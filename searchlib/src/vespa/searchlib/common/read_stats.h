@@ -13,11 +13,14 @@ namespace search {
 struct ReadStats
 {
     uint64_t read_bytes;        // bytes read from disk or bytes in pages containing the data
+    bool     direct_io;         // data was read bypassing the OS page cache
     ReadStats() noexcept
-        : read_bytes(0)
+        : read_bytes(0),
+          direct_io(false)
     { }
     void clear() noexcept {
         read_bytes = 0;
+        direct_io = false;
     }
 };
 
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 namespace search {
@@ -98,14 +99,17 @@ private:
     TuneControl _tuneControl;
     int         _mmapFlags;
     int         _advise;
+    uint64_t    _mmapMaxFileSize; // 0 means no limit
 public:
     TuneFileRandRead() noexcept
         : _tuneControl(NORMAL),
           _mmapFlags(0),
-          _advise(0)
+          _advise(0),
+          _mmapMaxFileSize(0)
     { }
 
     void setAdvise(int advise) noexcept { _advise = advise; }
+    void setMemoryMapMaxFileSize(uint64_t maxFileSize) noexcept { _mmapMaxFileSize = maxFileSize; }
     void setWantMemoryMap() noexcept { _tuneControl = MMAP; }
     void setWantDirectIO()  noexcept { _tuneControl = DIRECTIO; }
     void setWantNormal()    noexcept { _tuneControl = NORMAL; }
@@ -113,14 +117,22 @@ public:
     bool getWantMemoryMap()  const noexcept { return _tuneControl == MMAP; }
     int  getMemoryMapFlags() const noexcept { return _mmapFlags; }
     int  getAdvise()         const noexcept { return _advise; }
-
+    uint64_t getMemoryMapMaxFileSize() const noexcept { return _mmapMaxFileSize; }
+    /**
+     * Memory map is wanted for an immutable file unless it is larger than the max
+     * file size. Larger files are read with pread instead.
+     */
+    bool getWantMemoryMap(uint64_t fileSize) const noexcept {
+        return getWantMemoryMap() && ((_mmapMaxFileSize == 0) || (fileSize <= _mmapMaxFileSize));
+    }
     template <typename TuneControlConfig, typename MMapConfig>
     void setFromConfig(const enum TuneControlConfig::Io & tuneControlConfig, const MMapConfig & mmapFlags) noexcept;
     template <typename MMapConfig>
     void setFromMmapConfig(const MMapConfig & mmapFlags) noexcept;
 
     bool operator==(const TuneFileRandRead &rhs) const noexcept {
-        return (_tuneControl == rhs._tuneControl) && (_mmapFlags == rhs._mmapFlags);
+        return (_tuneControl == rhs._tuneControl) && (_mmapFlags == rhs._mmapFlags) &&
+               (_mmapMaxFileSize == rhs._mmapMaxFileSize);
     }
 
     bool operator!=(const TuneFileRandRead &rhs) const noexcept {
@@ -162,16 +174,26 @@ class TuneFileSearch
 public:
     TuneFileRandRead _read;
     bool _force_memory_map_posting_list;
-
-    TuneFileSearch() noexcept : _read(), _force_memory_map_posting_list(false) { }
-    TuneFileSearch(const TuneFileRandRead &r) noexcept : _read(r), _force_memory_map_posting_list(false) { }
+    size_t _dictionary_lookup_cache_max_bytes; // per field
+    size_t _bitvector_direct_io_min_bytes;     // 0 means disabled
+
+    TuneFileSearch() noexcept
+        : _read(), _force_memory_map_posting_list(false), _dictionary_lookup_cache_max_bytes(0),
+          _bitvector_direct_io_min_bytes(0) { }
+    TuneFileSearch(const TuneFileRandRead &r) noexcept
+        : _read(r), _force_memory_map_posting_list(false), _dictionary_lookup_cache_max_bytes(0),
+          _bitvector_direct_io_min_bytes(0) { }
     void set_force_memory_map_posting_list(bool value) noexcept { _force_memory_map_posting_list = value; }
+    void set_dictionary_lookup_cache_max_bytes(size_t value) noexcept { _dictionary_lookup_cache_max_bytes = value; }
+    void set_bitvector_direct_io_min_bytes(size_t value) noexcept { _bitvector_direct_io_min_bytes = value; }
     TuneFileRandRead get_tune_file_search_posting_list() const noexcept {
         return _read.consider_force_memory_map(_force_memory_map_posting_list);
     }
     bool operator==(const TuneFileSearch &rhs) const noexcept {
         return _read == rhs._read &&
-               _force_memory_map_posting_list == rhs._force_memory_map_posting_list;
+               _force_memory_map_posting_list == rhs._force_memory_map_posting_list &&
+               _dictionary_lookup_cache_max_bytes == rhs._dictionary_lookup_cache_max_bytes &&
+               _bitvector_direct_io_min_bytes == rhs._bitvector_direct_io_min_bytes;
     }
     bool operator!=(const TuneFileSearch &rhs) const noexcept { return !operator==(rhs); }
 };
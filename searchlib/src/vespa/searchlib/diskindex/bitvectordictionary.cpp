@@ -4,6 +4,7 @@
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/common/fileheadertags.h>
 #include <vespa/searchlib/common/read_stats.h>
+#include <vespa/vespalib/coro/async_io.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/fastos/file.h>
 #include <cassert>
@@ -24,7 +25,9 @@ BitVectorDictionary::BitVectorDictionary()
       _vectorSize(0u),
       _datFile(),
       _datHeaderLen(0u),
-      _memory_mapped(false)
+      _memory_mapped(false),
+      _direct_io(false),
+      _direct_io_min_bytes(0u)
 { }
 
 BitVectorDictionary::~BitVectorDictionary() = default;
@@ -75,7 +78,8 @@ BitVectorDictionary::open(const std::string &pathPrefix,
 
     if (tuneFileRead.getWantMemoryMap()) {
         _datFile->enableMemoryMap(tuneFileRead.getMemoryMapFlags());
-    } else if (tuneFileRead.getWantDirectIO()) {
+    } else if (tuneFileRead.getWantDirectIO() ||
+               (_direct_io_min_bytes != 0 && _vectorSize >= _direct_io_min_bytes)) {
         _datFile->EnableDirectIO();
     }
     _datFile->OpenReadOnly(booloccDatName.c_str());
@@ -87,6 +91,11 @@ BitVectorDictionary::open(const std::string &pathPrefix,
     _datHeaderLen = datHeader.readFile(*_datFile);
     assert(_datFile->getSize() >= static_cast<int64_t>(_vectorSize * _entries.size() + _datHeaderLen));
     _memory_mapped = (_datFile->MemoryMapPtr(0) != nullptr);
+    size_t memory_alignment = 0;
+    size_t transfer_granularity = 0;
+    size_t transfer_maximum = 0;
+    _direct_io = !_memory_mapped &&
+        _datFile->GetDirectIORestrictions(memory_alignment, transfer_granularity, transfer_maximum);
     return true;
 }
 
@@ -108,7 +117,9 @@ BitVectorDictionary::read_bitvector(BitVectorDictionaryLookupResult lookup_resul
         return {};
     }
     int64_t offset = ((int64_t) _vectorSize) * lookup_result.idx + _datHeaderLen;
-    return BitVector::create(_docIdLimit, *_datFile, offset, _entries[lookup_result.idx]._numDocs, read_stats);
+    auto result = BitVector::create(_docIdLimit, *_datFile, offset, _entries[lookup_result.idx]._numDocs, read_stats);
+    read_stats.direct_io = _direct_io;
+    return result;
 }
 
 std::unique_ptr<BitVector>
@@ -118,6 +129,27 @@ BitVectorDictionary::read_bitvector(BitVectorDictionaryLookupResult lookup_resul
     return read_bitvector(lookup_result, read_stats);
 }
 
+vespalib::coro::Lazy<std::unique_ptr<BitVector>>
+BitVectorDictionary::async_read_bitvector(vespalib::coro::AsyncIo& async_io, BitVectorDictionaryLookupResult lookup_result,
+                                          ReadStats& read_stats)
+{
+    int fd = _datFile->get_fd();
+    if (!lookup_result.valid() || _datFile->IsMemoryMapped() || fd < 0) {
+        co_return read_bitvector(lookup_result, read_stats);
+    }
+    int64_t offset = ((int64_t) _vectorSize) * lookup_result.idx + _datHeaderLen;
+    auto buffer = BitVector::make_file_read_buffer(_docIdLimit, *_datFile, offset);
+    ssize_t res = co_await async_io.pread(fd, static_cast<char *>(buffer.alloc.get()), buffer.read_size,
+                                          buffer.read_offset);
+    if (res != ssize_t(buffer.read_size)) {
+        // Short read or error, retry with synchronous read which reports errors
+        co_return read_bitvector(lookup_result, read_stats);
+    }
+    read_stats.read_bytes = buffer.read_size;
+    read_stats.direct_io = _direct_io;
+    co_return BitVector::create(_docIdLimit, std::move(buffer), _entries[lookup_result.idx]._numDocs);
+}
+
 PostingListFileRange
 BitVectorDictionary::get_bitvector_file_range(index::BitVectorDictionaryLookupResult lookup_result) const
 {
@@ -6,11 +6,14 @@
 #include <vespa/searchlib/index/posting_list_file_range.h>
 #include <vespa/searchlib/index/bitvectorkeys.h>
 #include <vespa/searchlib/common/tunefileinfo.h>
+#include <vespa/vespalib/coro/lazy.h>
 #include <string>
 #include <vector>
 
 class FastOS_FileInterface;
 
+namespace vespalib::coro { struct AsyncIo; }
+
 namespace search { class BitVector; }
 namespace search { struct ReadStats; }
 
@@ -32,6 +35,8 @@ private:
     std::unique_ptr<FastOS_FileInterface> _datFile;
     uint32_t                              _datHeaderLen;
     bool                                  _memory_mapped;
+    bool                                  _direct_io;
+    size_t                                _direct_io_min_bytes;
 
 public:
     using SP = std::shared_ptr<BitVectorDictionary>;
@@ -40,6 +45,15 @@ public:
     BitVectorDictionary();
     ~BitVectorDictionary();
 
+    /**
+     * Read bit vectors of at least the given size using direct io, bypassing
+     * the OS page cache, unless the dat file is memory mapped. Each bit
+     * vector is then read using a single read sized to the bit vector.
+     * 0 means that the io mode given by the tune file settings is used.
+     * Must be called before open.
+     **/
+    void set_direct_io_min_bytes(size_t value) noexcept { _direct_io_min_bytes = value; }
+
     /**
      * Open this dictionary using the following path prefix to where
      * the files are located.  The boolocc idx file is loaded into
@@ -71,12 +85,22 @@ public:
     std::unique_ptr<BitVector> read_bitvector(index::BitVectorDictionaryLookupResult lookup_result,
                                               ReadStats &read_stats);
     std::unique_ptr<BitVector> read_bitvector(index::BitVectorDictionaryLookupResult lookup_result);
+    /**
+     * Load and return the associated bit vector using async io. Falls back
+     * to synchronous read when the dat file is memory mapped.
+     * Lifetime of async_io and read_stats must exceed the lifetime of the
+     * returned coroutine.
+     **/
+    vespalib::coro::Lazy<std::unique_ptr<BitVector>>
+    async_read_bitvector(vespalib::coro::AsyncIo& async_io, index::BitVectorDictionaryLookupResult lookup_result,
+                         ReadStats& read_stats);
     index::PostingListFileRange get_bitvector_file_range(index::BitVectorDictionaryLookupResult lookup_result) const;
 
     uint32_t getDocIdLimit() const noexcept { return _docIdLimit; }
 
     const std::vector<WordSingleKey> & getEntries() const noexcept { return _entries; }
     bool get_memory_mapped() const noexcept { return _memory_mapped; }
+    bool get_direct_io() const noexcept { return _direct_io; }
 };
 
 }
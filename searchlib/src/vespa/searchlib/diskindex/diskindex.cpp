@@ -131,6 +131,16 @@ DiskIndex::lookup(uint32_t index, std::string_view word)
     }
 }
 
+std::vector<DictionaryLookupResult>
+DiskIndex::lookup_many(uint32_t index, const std::vector<std::string_view>& words)
+{
+    if (index < _field_indexes.size()) {
+        return _field_indexes[index].lookup_many(words);
+    } else {
+        return std::vector<DictionaryLookupResult>(words.size());
+    }
+}
+
 namespace {
 
 const std::vector<std::string> nonfield_file_names{
@@ -52,6 +52,11 @@ public:
      */
     index::DictionaryLookupResult lookup(uint32_t indexId, std::string_view word);
 
+    /**
+     * Perform dictionary lookups for the given words, sorted in ascending order, in the given field.
+     */
+    std::vector<index::DictionaryLookupResult> lookup_many(uint32_t indexId, const std::vector<std::string_view>& words);
+
     std::unique_ptr<queryeval::Blueprint> createBlueprint(const queryeval::IRequestContext & requestContext,
                                                           const queryeval::FieldSpec &field,
                                                           const query::Node &term) override;
@@ -50,8 +50,11 @@ DiskTermBlueprint::DiskTermBlueprint(FieldSpec field,
       _bitvector_lookup_result(_field_index.lookup_bit_vector(_lookupRes)),
       _is_filter_field(_field.isFilter()),
       _fetchPostingsDone(false),
+      _prefetchStarted(false),
       _postingHandle(),
       _bitVector(),
+      _prefetchedPostingHandle(),
+      _prefetchedBitVector(),
       _mutex(),
       _late_bitvector()
 {
@@ -59,6 +62,8 @@ DiskTermBlueprint::DiskTermBlueprint(FieldSpec field,
                             _lookupRes.counts._numDocs == 0));
 }
 
+DiskTermBlueprint::~DiskTermBlueprint() = default;
+
 void
 DiskTermBlueprint::log_bitvector_read() const
 {
@@ -84,6 +89,21 @@ DiskTermBlueprint::log_posting_list_read() const
         range.start_offset, range.size());
 }
 
+void
+DiskTermBlueprint::setDocIdLimit(uint32_t limit) noexcept
+{
+    SimpleLeafBlueprint::setDocIdLimit(limit);
+    if (_prefetchStarted || _fetchPostingsDone) {
+        return;
+    }
+    _prefetchStarted = true;
+    if (use_bitvector() && _bitvector_lookup_result.valid()) {
+        _prefetchedBitVector = _field_index.prefetch_bit_vector(_bitvector_lookup_result);
+    } else {
+        _prefetchedPostingHandle = _field_index.prefetch_posting_list(_lookupRes);
+    }
+}
+
 void
 DiskTermBlueprint::fetchPostings(const queryeval::ExecuteInfo &execInfo)
 {
@@ -93,13 +113,17 @@ DiskTermBlueprint::fetchPostings(const queryeval::ExecuteInfo &execInfo)
             if (LOG_WOULD_LOG(debug)) [[unlikely]] {
                 log_bitvector_read();
             }
-            _bitVector = _field_index.read_bit_vector(_bitvector_lookup_result);
+            _bitVector = _prefetchedBitVector.valid()
+                         ? _prefetchedBitVector.get()
+                         : _field_index.read_bit_vector(_bitvector_lookup_result);
         }
         if (!_bitVector) {
             if (LOG_WOULD_LOG(debug)) [[unlikely]] {
                 log_posting_list_read();
             }
-            _postingHandle = _field_index.read_posting_list(_lookupRes);
+            _postingHandle = _prefetchedPostingHandle.valid()
+                             ? _prefetchedPostingHandle.get()
+                             : _field_index.read_posting_list(_lookupRes);
         }
     }
     _fetchPostingsDone = true;
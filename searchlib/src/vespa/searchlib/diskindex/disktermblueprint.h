@@ -20,8 +20,11 @@ private:
     index::BitVectorDictionaryLookupResult _bitvector_lookup_result;
     bool                             _is_filter_field;
     bool                             _fetchPostingsDone;
+    bool                             _prefetchStarted;
     index::PostingListHandle         _postingHandle;
     std::shared_ptr<BitVector>       _bitVector;
+    std::future<index::PostingListHandle>   _prefetchedPostingHandle;
+    std::future<std::shared_ptr<BitVector>> _prefetchedBitVector;
     mutable std::mutex               _mutex;
     mutable std::shared_ptr<BitVector> _late_bitvector;
 
@@ -49,7 +52,15 @@ public:
                       const std::string& query_term,
                       index::DictionaryLookupResult lookupRes);
 
+    ~DiskTermBlueprint() override;
+
     queryeval::FlowStats calculate_flow_stats(uint32_t docid_limit) const override;
+
+    /*
+     * The docid limit is set on all leaf blueprints before fetchPostings is called. Start reading
+     * posting list or bit vector using async io here, to issue all reads for a query at once.
+     */
+    void setDocIdLimit(uint32_t limit) noexcept override;
     
     // Inherit doc from Blueprint.
     // For now, this DiskTermBlueprint instance must have longer lifetime than the created iterator.
@@ -7,6 +7,8 @@
 #include <vespa/searchlib/common/read_stats.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
 #include <vespa/searchlib/util/disk_space_calculator.h>
+#include <vespa/vespalib/coro/async_io.h>
+#include <vespa/vespalib/coro/completion.h>
 #include <cassert>
 #include <filesystem>
 
@@ -17,6 +19,9 @@ using search::index::BitVectorDictionaryLookupResult;
 using search::index::DictionaryLookupResult;
 using search::index::PostingListHandle;
 using search::index::PostingListOffsetAndCounts;
+using vespalib::coro::AsyncIo;
+using vespalib::coro::Lazy;
+using vespalib::coro::make_future;
 
 namespace search::diskindex {
 
@@ -31,6 +36,29 @@ const std::vector<std::string> field_file_names{
     "dictionary.ssdat"
 };
 
+/*
+ * Backing used to insert a posting list or bitvector that has been read
+ * using async io into the posting list cache.
+ */
+class PrefetchedFileBacking : public IPostingListCache::IPostingListFileBacking {
+    mutable PostingListHandle          _handle;
+    mutable std::shared_ptr<BitVector> _bit_vector;
+public:
+    PrefetchedFileBacking(PostingListHandle handle, std::shared_ptr<BitVector> bit_vector) noexcept
+        : _handle(std::move(handle)),
+          _bit_vector(std::move(bit_vector))
+    {
+    }
+    PostingListHandle read(const IPostingListCache::Key&, IPostingListCache::Context& ctx) const override {
+        ctx.cache_miss = true;
+        return std::move(_handle);
+    }
+    std::shared_ptr<BitVector> read(const IPostingListCache::BitVectorKey&, IPostingListCache::Context& ctx) const override {
+        ctx.cache_miss = true;
+        return std::move(_bit_vector);
+    }
+};
+
 }
 
 std::atomic<uint64_t> FieldIndex::_file_id_source(0);
@@ -43,6 +71,55 @@ FieldIndex::LockedFieldIndexIoStats::LockedFieldIndexIoStats() noexcept
 
 FieldIndex::LockedFieldIndexIoStats::~LockedFieldIndexIoStats() = default;
 
+/*
+ * Backing for reading posting lists and bitvectors that shares ownership
+ * of the files, allowing it to outlive the field index.
+ */
+class FieldIndex::SharedFileBacking : public IPostingListCache::IPostingListFileBacking {
+    std::shared_ptr<DiskPostingFile>         _posting_file;
+    std::shared_ptr<BitVectorDictionary>     _bit_vector_dict;
+    std::shared_ptr<LockedFieldIndexIoStats> _io_stats;
+public:
+    SharedFileBacking(std::shared_ptr<DiskPostingFile> posting_file,
+                      std::shared_ptr<BitVectorDictionary> bit_vector_dict,
+                      std::shared_ptr<LockedFieldIndexIoStats> io_stats) noexcept
+        : _posting_file(std::move(posting_file)),
+          _bit_vector_dict(std::move(bit_vector_dict)),
+          _io_stats(std::move(io_stats))
+    {
+    }
+    ~SharedFileBacking() override;
+    PostingListHandle read(const IPostingListCache::Key& key, IPostingListCache::Context& ctx) const override;
+    std::shared_ptr<BitVector> read(const IPostingListCache::BitVectorKey& key, IPostingListCache::Context& ctx) const override;
+};
+
+FieldIndex::SharedFileBacking::~SharedFileBacking() = default;
+
+PostingListHandle
+FieldIndex::SharedFileBacking::read(const IPostingListCache::Key& key, IPostingListCache::Context& ctx) const
+{
+    ctx.cache_miss = true;
+    DictionaryLookupResult lookup_result;
+    lookup_result.bitOffset = key.bit_offset;
+    lookup_result.counts._bitLength = key.bit_length;
+    auto handle = _posting_file->read_posting_list(lookup_result);
+    assert(handle._read_bytes != 0);
+    _io_stats->add_uncached_read_operation(handle._read_bytes);
+    _posting_file->consider_trim_posting_list(lookup_result, handle, 0.2); // Trim posting list if more than 20% bloat
+    return handle;
+}
+
+std::shared_ptr<BitVector>
+FieldIndex::SharedFileBacking::read(const IPostingListCache::BitVectorKey& key, IPostingListCache::Context& ctx) const
+{
+    ctx.cache_miss = true;
+    ReadStats read_stats;
+    std::shared_ptr<BitVector> result = _bit_vector_dict->read_bitvector(key.lookup_result, read_stats);
+    assert(read_stats.read_bytes != 0);
+    _io_stats->add_uncached_read_operation(read_stats);
+    return result;
+}
+
 FieldIndex::FieldIndex()
     : _posting_file(),
       _bit_vector_dict(),
@@ -53,6 +130,7 @@ FieldIndex::FieldIndex()
       _posting_list_cache(),
       _posting_list_cache_enabled(false),
       _bitvector_cache_enabled(false),
+      _shared_file_backing(),
       _field_id(0)
 {
 }
@@ -100,6 +178,7 @@ FieldIndex::open_dictionary(const std::string& field_dir, const TuneFileSearch&
 {
     std::string dictName = field_dir + "/dictionary";
     auto dict = std::make_unique<PageDict4RandRead>();
+    dict->set_lookup_cache_max_bytes(tune_file_search._dictionary_lookup_cache_max_bytes);
     if (!dict->open(dictName, tune_file_search._read)) {
         LOG(warning, "Could not open disk dictionary '%s'", dictName.c_str());
         return false;
@@ -146,6 +225,7 @@ FieldIndex::open(const std::string& field_dir, const TuneFileSearch& tune_file_s
     }
 
     bDict = std::make_shared<BitVectorDictionary>();
+    bDict->set_direct_io_min_bytes(tune_file_search._bitvector_direct_io_min_bytes);
     if (!bDict->open(field_dir, tune_file_search._read, BitVectorKeyScope::PERFIELD_WORDS)) {
         LOG(warning, "Could not open bit vector dictionary in '%s'", field_dir.c_str());
         return false;
@@ -154,6 +234,10 @@ FieldIndex::open(const std::string& field_dir, const TuneFileSearch& tune_file_s
     _bit_vector_dict = std::move(bDict);
     _file_id = get_next_file_id();
     _size_on_disk = calculate_field_index_size_on_disk(field_dir);
+    if (_posting_list_cache_enabled || _bitvector_cache_enabled) {
+        _shared_file_backing = std::make_shared<SharedFileBacking>(_posting_file, _bit_vector_dict, _io_stats);
+        _posting_list_cache->register_file(_file_id, field_dir, _size_on_disk, _shared_file_backing);
+    }
     return true;
 }
 
@@ -165,6 +249,7 @@ FieldIndex::reuse_files(const FieldIndex& rhs)
     _file_id = rhs._file_id;
     _size_on_disk = rhs._size_on_disk;
     _io_stats = rhs._io_stats;
+    _shared_file_backing = rhs._shared_file_backing;
 }
 
 DictionaryLookupResult
@@ -178,6 +263,14 @@ FieldIndex::lookup(std::string_view word) const
     return lookup_result;
 }
 
+std::vector<DictionaryLookupResult>
+FieldIndex::lookup_many(const std::vector<std::string_view>& words) const
+{
+    std::vector<DictionaryLookupResult> results;
+    _dict->lookup_many(words, results);
+    return results;
+}
+
 PostingListHandle
 FieldIndex::read_uncached_posting_list(const DictionaryLookupResult& lookup_result, bool trim) const
 {
@@ -223,6 +316,45 @@ FieldIndex::read_posting_list(const DictionaryLookupResult& lookup_result) const
     return result;
 }
 
+Lazy<PostingListHandle>
+FieldIndex::async_read_posting_list(std::shared_ptr<AsyncIo> async_io,
+                                    std::shared_ptr<DiskPostingFile> posting_file,
+                                    std::shared_ptr<LockedFieldIndexIoStats> io_stats,
+                                    std::shared_ptr<IPostingListCache> posting_list_cache,
+                                    IPostingListCache::Key key, DictionaryLookupResult lookup_result)
+{
+    auto handle = co_await posting_file->async_read_posting_list(*async_io, lookup_result);
+    assert(handle._read_bytes != 0);
+    io_stats->add_uncached_read_operation(handle._read_bytes);
+    posting_file->consider_trim_posting_list(lookup_result, handle, 0.2); // Trim posting list if more than 20% bloat
+    PrefetchedFileBacking backing(std::move(handle), {});
+    IPostingListCache::Context ctx(&backing);
+    co_return posting_list_cache->read(key, ctx);
+}
+
+std::future<PostingListHandle>
+FieldIndex::prefetch_posting_list(const DictionaryLookupResult& lookup_result) const
+{
+    auto file = _posting_file.get();
+    if (file == nullptr || lookup_result.counts._bitLength == 0 || file->getMemoryMapped() ||
+        !_posting_list_cache_enabled) {
+        return {};
+    }
+    auto async_io = _posting_list_cache->get_async_io();
+    if (!async_io) {
+        return {};
+    }
+    IPostingListCache::Key key;
+    key.file_id = _file_id;
+    key.bit_offset = lookup_result.bitOffset;
+    key.bit_length = lookup_result.counts._bitLength;
+    if (_posting_list_cache->has(key)) {
+        return {};
+    }
+    return make_future(async_read_posting_list(std::move(async_io), _posting_file, _io_stats, _posting_list_cache,
+                                               key, lookup_result));
+}
+
 BitVectorDictionaryLookupResult
 FieldIndex::lookup_bit_vector(const DictionaryLookupResult& lookup_result) const
 {
@@ -238,7 +370,7 @@ FieldIndex::read_uncached_bit_vector(BitVectorDictionaryLookupResult lookup_resu
     ReadStats read_stats;
     auto result = _bit_vector_dict->read_bitvector(lookup_result, read_stats);
     assert(read_stats.read_bytes != 0);
-    _io_stats->add_uncached_read_operation(read_stats.read_bytes);
+    _io_stats->add_uncached_read_operation(read_stats);
     return result;
 }
 
@@ -269,6 +401,44 @@ FieldIndex::read_bit_vector(BitVectorDictionaryLookupResult lookup_result) const
     return result;
 }
 
+Lazy<std::shared_ptr<BitVector>>
+FieldIndex::async_read_bit_vector(std::shared_ptr<AsyncIo> async_io,
+                                  std::shared_ptr<BitVectorDictionary> bit_vector_dict,
+                                  std::shared_ptr<LockedFieldIndexIoStats> io_stats,
+                                  std::shared_ptr<IPostingListCache> posting_list_cache,
+                                  IPostingListCache::BitVectorKey key)
+{
+    ReadStats read_stats;
+    std::shared_ptr<BitVector> bit_vector = co_await bit_vector_dict->async_read_bitvector(*async_io, key.lookup_result,
+                                                                                           read_stats);
+    assert(read_stats.read_bytes != 0);
+    io_stats->add_uncached_read_operation(read_stats.read_bytes);
+    PrefetchedFileBacking backing({}, std::move(bit_vector));
+    IPostingListCache::Context ctx(&backing);
+    co_return posting_list_cache->read(key, ctx);
+}
+
+std::future<std::shared_ptr<BitVector>>
+FieldIndex::prefetch_bit_vector(BitVectorDictionaryLookupResult lookup_result) const
+{
+    if (!_bit_vector_dict || !lookup_result.valid() || _bit_vector_dict->get_memory_mapped() ||
+        !_bitvector_cache_enabled) {
+        return {};
+    }
+    auto async_io = _posting_list_cache->get_async_io();
+    if (!async_io) {
+        return {};
+    }
+    IPostingListCache::BitVectorKey key;
+    key.file_id = _file_id;
+    key.lookup_result = lookup_result;
+    if (_posting_list_cache->has(key)) {
+        return {};
+    }
+    return make_future(async_read_bit_vector(std::move(async_io), _bit_vector_dict, _io_stats, _posting_list_cache,
+                                             key));
+}
+
 std::unique_ptr<search::queryeval::SearchIterator>
 FieldIndex::create_iterator(const DictionaryLookupResult& lookup_result,
                             const index::PostingListHandle& handle,
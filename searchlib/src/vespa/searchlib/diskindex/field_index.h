@@ -5,11 +5,13 @@
 #include "bitvectordictionary.h"
 #include "i_posting_list_cache.h"
 #include "zcposoccrandread.h"
+#include <vespa/searchlib/common/read_stats.h>
 #include <vespa/searchlib/index/dictionary_lookup_result.h>
 #include <vespa/searchlib/index/dictionaryfile.h>
 #include <vespa/searchlib/index/field_length_info.h>
 #include <vespa/searchlib/util/field_index_stats.h>
 #include <atomic>
+#include <future>
 #include <mutex>
 #include <string>
 
@@ -38,6 +40,14 @@ class FieldIndex : public IPostingListCache::IPostingListFileBacking {
             std::lock_guard guard(_mutex);
             _stats.add_uncached_read_operation(bytes);
         }
+        void add_uncached_read_operation(const ReadStats& read_stats) {
+            std::lock_guard guard(_mutex);
+            if (read_stats.direct_io) {
+                _stats.add_uncached_direct_io_read_operation(read_stats.read_bytes);
+            } else {
+                _stats.add_uncached_read_operation(read_stats.read_bytes);
+            }
+        }
         void add_cached_read_operation(uint64_t bytes) {
             std::lock_guard guard(_mutex);
             _stats.add_cached_read_operation(bytes);
@@ -49,6 +59,8 @@ class FieldIndex : public IPostingListCache::IPostingListFileBacking {
         }
     };
 
+    class SharedFileBacking;
+
     std::shared_ptr<DiskPostingFile> _posting_file;
     std::shared_ptr<BitVectorDictionary> _bit_vector_dict;
     std::unique_ptr<index::DictionaryFileRandRead> _dict;
@@ -58,10 +70,24 @@ class FieldIndex : public IPostingListCache::IPostingListFileBacking {
     std::shared_ptr<IPostingListCache> _posting_list_cache;
     bool                               _posting_list_cache_enabled;
     bool                               _bitvector_cache_enabled;
+    // Registered with posting list cache, used when prefetching from a cache snapshot
+    std::shared_ptr<const IPostingListCache::IPostingListFileBacking> _shared_file_backing;
     static std::atomic<uint64_t> _file_id_source;
     uint32_t _field_id;
 
     static uint64_t get_next_file_id() noexcept { return _file_id_source.fetch_add(1) + 1; }
+    static vespalib::coro::Lazy<index::PostingListHandle>
+    async_read_posting_list(std::shared_ptr<vespalib::coro::AsyncIo> async_io,
+                            std::shared_ptr<DiskPostingFile> posting_file,
+                            std::shared_ptr<LockedFieldIndexIoStats> io_stats,
+                            std::shared_ptr<IPostingListCache> posting_list_cache,
+                            IPostingListCache::Key key, index::DictionaryLookupResult lookup_result);
+    static vespalib::coro::Lazy<std::shared_ptr<BitVector>>
+    async_read_bit_vector(std::shared_ptr<vespalib::coro::AsyncIo> async_io,
+                          std::shared_ptr<BitVectorDictionary> bit_vector_dict,
+                          std::shared_ptr<LockedFieldIndexIoStats> io_stats,
+                          std::shared_ptr<IPostingListCache> posting_list_cache,
+                          IPostingListCache::BitVectorKey key);
 public:
     FieldIndex();
     FieldIndex(uint32_t field_id, std::shared_ptr<IPostingListCache> posting_list_cache);
@@ -74,10 +100,17 @@ public:
     bool open(const std::string& field_dir, const TuneFileSearch &tune_file_search);
     void reuse_files(const FieldIndex& rhs);
     index::DictionaryLookupResult lookup(std::string_view word) const;
+    // Lookup words sorted in ascending order
+    std::vector<index::DictionaryLookupResult> lookup_many(const std::vector<std::string_view>& words) const;
     index::PostingListHandle read_uncached_posting_list(const search::index::DictionaryLookupResult &lookup_result,
                                                         bool trim) const;
     index::PostingListHandle read(const IPostingListCache::Key& key, IPostingListCache::Context& ctx) const override;
     index::PostingListHandle read_posting_list(const search::index::DictionaryLookupResult& lookup_result) const;
+    /*
+     * Start reading posting list into the posting list cache using async io. Returns an invalid future
+     * if the posting list should be read synchronously, e.g. when it is already cached.
+     */
+    std::future<index::PostingListHandle> prefetch_posting_list(const search::index::DictionaryLookupResult& lookup_result) const;
     PostingListFileRange get_posting_list_file_range(const search::index::DictionaryLookupResult& lookup_result) const {
         return _posting_file->get_posting_list_file_range(lookup_result);
     }
@@ -85,6 +118,7 @@ public:
     std::shared_ptr<BitVector> read_uncached_bit_vector(index::BitVectorDictionaryLookupResult lookup_result) const;
     std::shared_ptr<BitVector> read(const IPostingListCache::BitVectorKey& key, IPostingListCache::Context& ctx) const override;
     std::shared_ptr<BitVector> read_bit_vector(index::BitVectorDictionaryLookupResult lookup_result) const;
+    std::future<std::shared_ptr<BitVector>> prefetch_bit_vector(index::BitVectorDictionaryLookupResult lookup_result) const;
     PostingListFileRange get_bitvector_file_range(index::BitVectorDictionaryLookupResult lookup_result) const {
         return _bit_vector_dict->get_bitvector_file_range(lookup_result);
     }
@@ -42,8 +42,10 @@ namespace {
 
 constexpr uint32_t renumber_word_ids_heap_limit = 4;
 constexpr uint32_t renumber_word_ids_merge_chunk = 1000000;
+constexpr uint32_t renumber_word_ids_tournament_limit = 16;
 constexpr uint32_t merge_postings_heap_limit = 4;
 constexpr uint32_t merge_postings_merge_chunk = 50000;
+constexpr uint32_t merge_postings_tournament_limit = 16;
 constexpr uint32_t scan_chunk = 80000;
 
 std::string
@@ -187,6 +189,7 @@ FieldMerger::renumber_word_ids_start()
     _word_aggregator = std::make_unique<WordAggregator>();
     _word_heap->setup(renumber_word_ids_heap_limit);
     _word_heap->set_merge_chunk(_fusion_out_index.get_force_small_merge_chunk() ? 1u : renumber_word_ids_merge_chunk);
+    _word_heap->set_tournament_limit(renumber_word_ids_tournament_limit);
     return true;
 }
 
@@ -409,6 +412,7 @@ FieldMerger::setup_merge_heap()
     }
     _heap->setup(merge_postings_heap_limit);
     _heap->set_merge_chunk(_fusion_out_index.get_force_small_merge_chunk() ? 1u : merge_postings_merge_chunk);
+    _heap->set_tournament_limit(merge_postings_tournament_limit);
     return true;
 }
 
@@ -5,6 +5,7 @@
 #include "zcposocc.h"
 #include "extposocc.h"
 #include "pagedict4file.h"
+#include <vespa/searchcommon/common/schema.h>
 #include <vespa/vespalib/util/error.h>
 #include <filesystem>
 
@@ -69,7 +70,15 @@ FieldWriter::open(uint32_t minSkipDocs,
     if (encode_interleaved_features) {
         params.set("interleaved_features", encode_interleaved_features);
     }
-    
+    if (schema.getIndexField(indexId).getCollectionType() == index::schema::CollectionType::WEIGHTEDSET) {
+        // Max element weight per skip block, used by block-max wand
+        params.set("block_max_weights", true);
+    }
+    if (schema.getIndexField(indexId).use_block_doc_ids()) {
+        // Bit packed blocks of doc id deltas for long posting lists
+        params.set("block_doc_ids", true);
+    }
+
     _dictFile = std::make_unique<PageDict4FileSeqWrite>();
     _dictFile->setParams(countParams);
 
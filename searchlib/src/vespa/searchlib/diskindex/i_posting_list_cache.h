@@ -6,8 +6,10 @@
 #include <vespa/searchlib/index/postinglisthandle.h>
 #include <vespa/vespalib/stllike/cache_stats.h>
 #include <bit>
+#include <string>
 
 namespace search { class BitVector; }
+namespace vespalib::coro { struct AsyncIo; }
 
 namespace search::diskindex {
 
@@ -58,9 +60,34 @@ public:
         virtual search::index::PostingListHandle read(const Key& key, Context& ctx) const = 0;
         virtual std::shared_ptr<BitVector> read(const BitVectorKey& key, Context& ctx) const = 0;
     };
+    /*
+     * Progress of prefetching posting lists and bitvectors from a cache snapshot.
+     */
+    struct WarmupStats {
+        bool     active     = false;
+        size_t   pending    = 0;
+        size_t   prefetched = 0;
+        size_t   skipped    = 0;
+        uint64_t read_bytes = 0;
+    };
     virtual ~IPostingListCache() = default;
     virtual search::index::PostingListHandle read(const Key& key, Context& ctx) const = 0;
     virtual std::shared_ptr<BitVector> read(const BitVectorKey& key, Context& ctx) const = 0;
+    virtual bool has(const Key& key) const = 0;
+    virtual bool has(const BitVectorKey& key) const = 0;
+    /*
+     * Async io used for reading posting lists and bitvectors into the cache
+     * ahead of use, or nullptr if all reads should be synchronous.
+     */
+    virtual std::shared_ptr<vespalib::coro::AsyncIo> get_async_io() const noexcept = 0;
+    /*
+     * Register the field index directory and the file backing for a file id. Cache entries
+     * for the file are part of cache snapshots while the file backing is alive, and the
+     * file backing is used when prefetching entries from a cache snapshot after restart.
+     */
+    virtual void register_file(uint64_t file_id, const std::string& dir, uint64_t size_on_disk,
+                               std::shared_ptr<const IPostingListFileBacking> backing) = 0;
+    virtual WarmupStats get_warmup_stats() const = 0;
     virtual vespalib::CacheStats get_stats() const = 0;
     virtual vespalib::CacheStats get_bitvector_stats() const = 0;
     virtual bool enabled_for_posting_lists() const noexcept = 0;
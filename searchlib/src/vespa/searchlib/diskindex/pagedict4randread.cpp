@@ -3,6 +3,7 @@
 #include "pagedict4randread.h"
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/stllike/asciistream.h>
+#include <vespa/vespalib/stllike/cache.hpp>
 #include <vespa/fastos/file.h>
 
 #include <vespa/log/log.h>
@@ -20,9 +21,56 @@ using vespalib::getLastErrorString;
 
 namespace search::diskindex {
 
+namespace {
+
+struct CachedLookup {
+    uint64_t                          word_num;
+    index::PostingListOffsetAndCounts offset_and_counts;
+    bool                              found;
+    CachedLookup() noexcept : word_num(0), offset_and_counts(), found(false) { }
+};
+
+class LookupBackingStore {
+public:
+    bool read(const std::string& word, CachedLookup& value, const PageDict4RandRead& dict) const {
+        value.found = dict.lookup_uncached(word, value.word_num, value.offset_and_counts);
+        return true;
+    }
+};
+
+struct CachedWordSize {
+    size_t operator() (const std::string& word) const noexcept { return word.size(); }
+};
+
+struct CachedLookupSize {
+    size_t operator() (const CachedLookup& value) const noexcept {
+        return sizeof(CachedLookup) +
+            value.offset_and_counts._counts._segments.size() * sizeof(index::PostingListCounts::Segment);
+    }
+};
+
+using LookupCacheParams = vespalib::CacheParam<
+    vespalib::LruParam<std::string, CachedLookup>,
+    const LookupBackingStore,
+    CachedWordSize,
+    CachedLookupSize
+>;
+
+LookupBackingStore lookup_backing_store;
+
+}
+
+class PageDict4RandRead::LookupCache : public vespalib::cache<LookupCacheParams> {
+public:
+    using Parent = vespalib::cache<LookupCacheParams>;
+    explicit LookupCache(size_t max_bytes) : Parent(lookup_backing_store, max_bytes) { }
+    ~LookupCache() override = default;
+};
+
 PageDict4RandRead::PageDict4RandRead()
     : DictionaryFileRandRead(),
       _ssReader(),
+      _lookup_cache(),
       _ssd(),
       _ssReadContext(_ssd),
       _ssfile(std::make_unique<FastOS_File>()),
@@ -34,7 +82,8 @@ PageDict4RandRead::PageDict4RandRead()
       _ssHeaderLen(0u),
       _spHeaderLen(0u),
       _pHeaderLen(0u),
-      _mmap_file_size_threshold(32_Mi)
+      _mmap_file_size_threshold(32_Mi),
+      _lookup_cache_max_bytes(0)
 {
     _ssd.setReadContext(&_ssReadContext);
 }
@@ -147,6 +196,20 @@ bool
 PageDict4RandRead::lookup(std::string_view word,
                           uint64_t &wordNum,
                           PostingListOffsetAndCounts &offsetAndCounts)
+{
+    if (!_lookup_cache) {
+        return lookup_uncached(word, wordNum, offsetAndCounts);
+    }
+    auto cached = _lookup_cache->read(std::string(word), *this);
+    wordNum = cached.word_num;
+    offsetAndCounts = std::move(cached.offset_and_counts);
+    return cached.found;
+}
+
+bool
+PageDict4RandRead::lookup_uncached(std::string_view word,
+                                   uint64_t &wordNum,
+                                   PostingListOffsetAndCounts &offsetAndCounts) const
 {
     SSLookupRes ssRes(_ssReader->lookup(word));
     if (!ssRes._res) {
@@ -272,6 +335,9 @@ PageDict4RandRead::open(const std::string &name,
     _ssReader = std::make_unique<SSReader>(_ssReadContext, _ssHeaderLen, _ssFileBitSize, _spHeaderLen,
                                            _spFileBitSize, _pHeaderLen, _pFileBitSize);
     _ssReader->setup(_ssd);
+    if (_lookup_cache_max_bytes > 0) {
+        _lookup_cache = std::make_unique<LookupCache>(_lookup_cache_max_bytes);
+    }
 
     return true;
 }
@@ -280,6 +346,7 @@ PageDict4RandRead::open(const std::string &name,
 bool
 PageDict4RandRead::close()
 {
+    _lookup_cache.reset();
     _ssReader.reset();
 
     _ssReadContext.dropComprBuf();
@@ -296,4 +363,10 @@ PageDict4RandRead::getNumWordIds() const
     return _ssd._numWordIds;
 }
 
+vespalib::CacheStats
+PageDict4RandRead::get_lookup_cache_stats() const
+{
+    return _lookup_cache ? _lookup_cache->get_stats() : vespalib::CacheStats();
+}
+
 }
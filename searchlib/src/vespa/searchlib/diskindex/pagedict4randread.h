@@ -6,6 +6,7 @@
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/bitcompression/countcompression.h>
 #include <vespa/searchlib/bitcompression/pagedict4.h>
+#include <vespa/vespalib/stllike/cache_stats.h>
 
 namespace search::diskindex {
 
@@ -22,7 +23,10 @@ class PageDict4RandRead : public index::DictionaryFileRandRead
     using PostingListCounts = index::PostingListCounts;
     using PostingListOffsetAndCounts = index::PostingListOffsetAndCounts;
 
+    class LookupCache;
+
     std::unique_ptr<SSReader> _ssReader;
+    std::unique_ptr<LookupCache> _lookup_cache;
 
     DC _ssd;
     ComprFileReadContext _ssReadContext;
@@ -37,6 +41,7 @@ class PageDict4RandRead : public index::DictionaryFileRandRead
     uint32_t _spHeaderLen;
     uint32_t _pHeaderLen;
     uint32_t _mmap_file_size_threshold;
+    size_t   _lookup_cache_max_bytes;
 
     void readSSHeader();
     void readSPHeader();
@@ -47,12 +52,20 @@ public:
 
     bool lookup(std::string_view word, uint64_t &wordNum,
                 PostingListOffsetAndCounts &offsetAndCounts) override;
+    bool lookup_uncached(std::string_view word, uint64_t &wordNum,
+                         PostingListOffsetAndCounts &offsetAndCounts) const;
 
     bool open(const std::string &name, const TuneFileRandRead &tuneFileRead) override;
 
     bool close() override;
     uint64_t getNumWordIds() const override;
     void set_mmap_file_size_threshold(uint32_t v) { _mmap_file_size_threshold = v; }
+    /*
+     * Cache lookup results for hot words, avoiding decoding of sparse and
+     * page level entries for repeated lookups. Must be set before open(). 0 disables the cache.
+     */
+    void set_lookup_cache_max_bytes(size_t v) { _lookup_cache_max_bytes = v; }
+    vespalib::CacheStats get_lookup_cache_stats() const;
 };
 
 }
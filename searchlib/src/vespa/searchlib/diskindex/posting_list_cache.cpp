@@ -1,16 +1,20 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "posting_list_cache.h"
+#include "posting_list_cache_snapshot.h"
 #include <vespa/searchlib/common/allocatedbitvector.h>
 #include <vespa/searchlib/index/dictionary_lookup_result.h>
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/vespalib/stllike/cache.hpp>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
 #include <iostream>
 #include <vespa/searchlib/index/bitvector_dictionary_lookup_result.h>
 
 using search::index::BitVectorDictionaryLookupResult;
 using search::index::DictionaryLookupResult;
 using search::index::PostingListHandle;
+using vespalib::CacheSegment;
 
 namespace search::diskindex {
 
@@ -101,7 +105,14 @@ PostingListCache::PostingListCache(const CacheSizingParams& params)
                                      params.posting_slru_protected_bytes())),
       _bitvector_cache(std::make_unique<BitVectorCache>(*_backing_store,
                                                         params.bitvector_slru_probationary_bytes(),
-                                                        params.bitvector_slru_protected_bytes()))
+                                                        params.bitvector_slru_protected_bytes())),
+      _async_io(),
+      _files_lock(),
+      _files(),
+      _warmup_lock(),
+      _warmup_snapshot(),
+      _warmup_stats_lock(),
+      _warmup_stats()
 {
     if (params.posting_lfu_max_element_count() > 0) {
         _cache->set_frequency_sketch_size(params.posting_lfu_max_element_count());
@@ -129,6 +140,205 @@ PostingListCache::read(const BitVectorKey& key, Context& ctx) const
     return _bitvector_cache->read(key, ctx);
 }
 
+bool
+PostingListCache::has(const Key& key) const
+{
+    return _cache->hasKey(key);
+}
+
+bool
+PostingListCache::has(const BitVectorKey& key) const
+{
+    return _bitvector_cache->hasKey(key);
+}
+
+std::shared_ptr<vespalib::coro::AsyncIo>
+PostingListCache::get_async_io() const noexcept
+{
+    return _async_io;
+}
+
+void
+PostingListCache::set_async_io(std::shared_ptr<vespalib::coro::AsyncIo> async_io)
+{
+    _async_io = std::move(async_io);
+}
+
+void
+PostingListCache::register_file(uint64_t file_id, const std::string& dir, uint64_t size_on_disk,
+                                std::shared_ptr<const IPostingListFileBacking> backing)
+{
+    std::lock_guard guard(_files_lock);
+    // Forget files for field indexes that have been removed
+    std::vector<uint64_t> expired;
+    for (const auto& file : _files) {
+        if (file.second.backing.expired()) {
+            expired.emplace_back(file.first);
+        }
+    }
+    for (auto expired_file_id : expired) {
+        _files.erase(expired_file_id);
+    }
+    _files[file_id] = RegisteredFile{dir, size_on_disk, backing};
+}
+
+IPostingListCache::WarmupStats
+PostingListCache::get_warmup_stats() const
+{
+    std::lock_guard guard(_warmup_stats_lock);
+    return _warmup_stats;
+}
+
+std::shared_ptr<const IPostingListCache::IPostingListFileBacking>
+PostingListCache::find_file(const std::string& dir, uint64_t size_on_disk, uint64_t& file_id) const
+{
+    std::lock_guard guard(_files_lock);
+    for (const auto& file : _files) {
+        if (file.second.dir == dir && file.second.size_on_disk == size_on_disk) {
+            auto backing = file.second.backing.lock();
+            if (backing) {
+                file_id = file.first;
+                return backing;
+            }
+        }
+    }
+    return {};
+}
+
+std::unique_ptr<PostingListCacheSnapshot>
+PostingListCache::make_snapshot() const
+{
+    vespalib::hash_map<uint64_t, std::pair<std::string, uint64_t>> files;
+    {
+        std::lock_guard guard(_files_lock);
+        for (const auto& file : _files) {
+            if (!file.second.backing.expired()) {
+                files[file.first] = std::make_pair(file.second.dir, file.second.size_on_disk);
+            }
+        }
+    }
+    auto snapshot = std::make_unique<PostingListCacheSnapshot>();
+    auto get_file_entries = [&files, &snapshot](uint64_t file_id) -> PostingListCacheSnapshot::FileEntries* {
+        auto itr = files.find(file_id);
+        return (itr != files.end()) ? &snapshot->add_file(itr->second.first, itr->second.second) : nullptr;
+    };
+    for (auto segment : {CacheSegment::Probationary, CacheSegment::Protected}) {
+        bool protected_segment = (segment == CacheSegment::Protected);
+        // Keys are dumped from most recently used to least recently used
+        auto keys = _cache->dump_segment_keys_in_lru_order(segment);
+        for (auto itr = keys.rbegin(); itr != keys.rend(); ++itr) {
+            auto* entries = get_file_entries(itr->file_id);
+            if (entries != nullptr) {
+                entries->posting_lists.emplace_back(itr->bit_offset, itr->bit_length, protected_segment);
+            }
+        }
+        auto bitvector_keys = _bitvector_cache->dump_segment_keys_in_lru_order(segment);
+        for (auto itr = bitvector_keys.rbegin(); itr != bitvector_keys.rend(); ++itr) {
+            auto* entries = get_file_entries(itr->file_id);
+            if (entries != nullptr) {
+                entries->bit_vectors.emplace_back(itr->lookup_result.idx, protected_segment);
+            }
+        }
+    }
+    return snapshot;
+}
+
+void
+PostingListCache::start_warmup(std::unique_ptr<PostingListCacheSnapshot> snapshot)
+{
+    std::lock_guard guard(_warmup_lock);
+    // Entries are consumed from the back, least recently used first
+    for (auto& file : snapshot->files()) {
+        std::reverse(file.second.posting_lists.begin(), file.second.posting_lists.end());
+        std::reverse(file.second.bit_vectors.begin(), file.second.bit_vectors.end());
+    }
+    std::lock_guard stats_guard(_warmup_stats_lock);
+    _warmup_stats = WarmupStats();
+    _warmup_stats.pending = snapshot->num_entries();
+    _warmup_stats.active = _warmup_stats.pending != 0;
+    if (_warmup_stats.active) {
+        _warmup_snapshot = std::move(snapshot);
+    } else {
+        _warmup_snapshot.reset();
+    }
+}
+
+bool
+PostingListCache::warmup(uint64_t max_bytes)
+{
+    std::lock_guard guard(_warmup_lock);
+    if (!_warmup_snapshot) {
+        return false;
+    }
+    uint64_t read_bytes = 0;
+    auto& files = _warmup_snapshot->files();
+    while (read_bytes < max_bytes && !files.empty()) {
+        auto& [dir, entries] = *files.begin();
+        uint64_t file_id = 0;
+        auto backing = find_file(dir, entries.size_on_disk, file_id);
+        size_t prefetched = 0;
+        size_t skipped = 0;
+        if (!backing) {
+            skipped = entries.posting_lists.size() + entries.bit_vectors.size();
+            entries.posting_lists.clear();
+            entries.bit_vectors.clear();
+        }
+        Context ctx(backing.get());
+        while (read_bytes < max_bytes && !entries.posting_lists.empty()) {
+            auto entry = entries.posting_lists.back();
+            entries.posting_lists.pop_back();
+            Key key;
+            key.file_id = file_id;
+            key.bit_offset = entry.bit_offset;
+            key.bit_length = entry.bit_length;
+            if (!enabled_for_posting_lists() || _cache->hasKey(key)) {
+                ++skipped;
+                continue;
+            }
+            ctx.cache_miss = false;
+            auto handle = _cache->read(key, ctx);
+            if (entry.protected_segment) {
+                (void) _cache->read(key, ctx); // Promote to protected segment
+            }
+            read_bytes += handle._read_bytes;
+            ++prefetched;
+        }
+        while (read_bytes < max_bytes && !entries.bit_vectors.empty()) {
+            auto entry = entries.bit_vectors.back();
+            entries.bit_vectors.pop_back();
+            BitVectorKey key;
+            key.file_id = file_id;
+            key.lookup_result = index::BitVectorDictionaryLookupResult(entry.idx);
+            if (!enabled_for_bitvectors() || _bitvector_cache->hasKey(key)) {
+                ++skipped;
+                continue;
+            }
+            ctx.cache_miss = false;
+            auto bit_vector = _bitvector_cache->read(key, ctx);
+            if (entry.protected_segment) {
+                (void) _bitvector_cache->read(key, ctx); // Promote to protected segment
+            }
+            read_bytes += bit_vector->getFileBytes();
+            ++prefetched;
+        }
+        if (entries.posting_lists.empty() && entries.bit_vectors.empty()) {
+            files.erase(files.begin());
+        }
+        std::lock_guard stats_guard(_warmup_stats_lock);
+        _warmup_stats.pending -= prefetched + skipped;
+        _warmup_stats.prefetched += prefetched;
+        _warmup_stats.skipped += skipped;
+    }
+    std::lock_guard stats_guard(_warmup_stats_lock);
+    _warmup_stats.read_bytes += read_bytes;
+    if (files.empty()) {
+        _warmup_snapshot.reset();
+        _warmup_stats.active = false;
+        return false;
+    }
+    return true;
+}
+
 vespalib::CacheStats
 PostingListCache::get_stats() const
 {
@@ -3,12 +3,19 @@
 #pragma once
 
 #include "i_posting_list_cache.h"
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <mutex>
 
 namespace search::diskindex {
 
+class PostingListCacheSnapshot;
+
 /*
  * Class for caching posting lists read from disk.
  * It uses an LRU cache from vespalib.
+ *
+ * The keys in the cache can be saved as a snapshot and prefetched into the
+ * cache after a restart, cf. PostingListCacheSnapshot.
  */
 class PostingListCache : public IPostingListCache {
 public:
@@ -16,9 +23,24 @@ public:
 private:
     class Cache;
     class BitVectorCache;
+    struct RegisteredFile {
+        std::string                                   dir;
+        uint64_t                                      size_on_disk;
+        std::weak_ptr<const IPostingListFileBacking> backing;
+    };
     std::unique_ptr<const BackingStore> _backing_store;
     std::unique_ptr<Cache> _cache;
     std::unique_ptr<BitVectorCache> _bitvector_cache;
+    std::shared_ptr<vespalib::coro::AsyncIo> _async_io;
+    mutable std::mutex                            _files_lock;
+    vespalib::hash_map<uint64_t, RegisteredFile> _files;
+    std::mutex                                    _warmup_lock;
+    std::unique_ptr<PostingListCacheSnapshot>     _warmup_snapshot;
+    mutable std::mutex                            _warmup_stats_lock;
+    WarmupStats                                   _warmup_stats;
+
+    std::shared_ptr<const IPostingListFileBacking> find_file(const std::string& dir, uint64_t size_on_disk,
+                                                             uint64_t& file_id) const;
 public:
     class CacheSizingParams {
         size_t _posting_max_bytes               = 0;
@@ -73,6 +95,26 @@ public:
     ~PostingListCache() override;
     search::index::PostingListHandle read(const Key& key, Context& ctx) const override;
     std::shared_ptr<BitVector> read(const BitVectorKey& key, Context& ctx) const override;
+    bool has(const Key& key) const override;
+    bool has(const BitVectorKey& key) const override;
+    std::shared_ptr<vespalib::coro::AsyncIo> get_async_io() const noexcept override;
+    // Must be called before the cache is used by field indexes
+    void set_async_io(std::shared_ptr<vespalib::coro::AsyncIo> async_io);
+    void register_file(uint64_t file_id, const std::string& dir, uint64_t size_on_disk,
+                       std::shared_ptr<const IPostingListFileBacking> backing) override;
+    WarmupStats get_warmup_stats() const override;
+    // Returns a snapshot of the keys in the cache for files that are still registered
+    std::unique_ptr<PostingListCacheSnapshot> make_snapshot() const;
+    /*
+     * Start prefetching the entries in a snapshot taken before restart. Entries for
+     * files that are not registered when they are reached are skipped.
+     */
+    void start_warmup(std::unique_ptr<PostingListCacheSnapshot> snapshot);
+    /*
+     * Prefetch entries from the snapshot until at least max_bytes have been read from disk.
+     * Returns false when there are no more entries to prefetch.
+     */
+    bool warmup(uint64_t max_bytes);
     vespalib::CacheStats get_stats() const override;
     vespalib::CacheStats get_bitvector_stats() const override;
     bool enabled_for_posting_lists() const noexcept override;
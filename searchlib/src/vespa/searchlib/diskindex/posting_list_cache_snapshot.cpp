@@ -0,0 +1,142 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "posting_list_cache_snapshot.h"
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <filesystem>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".diskindex.posting_list_cache_snapshot");
+
+using vespalib::nbostream;
+
+namespace fs = std::filesystem;
+
+namespace search::diskindex {
+
+namespace {
+
+constexpr uint32_t file_magic = 0x504c4353; // "PLCS"
+constexpr uint32_t file_version = 1;
+
+}
+
+PostingListCacheSnapshot::FileEntries::FileEntries() noexcept
+    : size_on_disk(0),
+      posting_lists(),
+      bit_vectors()
+{
+}
+
+PostingListCacheSnapshot::FileEntries::~FileEntries() = default;
+
+PostingListCacheSnapshot::PostingListCacheSnapshot()
+    : _files()
+{
+}
+
+PostingListCacheSnapshot::~PostingListCacheSnapshot() = default;
+
+PostingListCacheSnapshot::FileEntries&
+PostingListCacheSnapshot::add_file(const std::string& dir, uint64_t size_on_disk)
+{
+    auto& entries = _files[dir];
+    entries.size_on_disk = size_on_disk;
+    return entries;
+}
+
+size_t
+PostingListCacheSnapshot::num_entries() const noexcept
+{
+    size_t result = 0;
+    for (const auto& file : _files) {
+        result += file.second.posting_lists.size() + file.second.bit_vectors.size();
+    }
+    return result;
+}
+
+bool
+PostingListCacheSnapshot::save(const std::string& file_name) const
+{
+    nbostream os;
+    os << file_magic << file_version << uint32_t(_files.size());
+    for (const auto& [dir, entries] : _files) {
+        os << dir << entries.size_on_disk;
+        os << uint32_t(entries.posting_lists.size());
+        for (const auto& entry : entries.posting_lists) {
+            os << entry.bit_offset << entry.bit_length << entry.protected_segment;
+        }
+        os << uint32_t(entries.bit_vectors.size());
+        for (const auto& entry : entries.bit_vectors) {
+            os << entry.idx << entry.protected_segment;
+        }
+    }
+    os << file_magic;
+    const std::string tmp_file_name = file_name + ".tmp";
+    try {
+        {
+            vespalib::File file(tmp_file_name);
+            file.open(vespalib::File::CREATE | vespalib::File::TRUNC);
+            file.write(os.data(), os.size(), 0);
+            file.close();
+        }
+        vespalib::File::sync(tmp_file_name);
+        fs::rename(fs::path(tmp_file_name), fs::path(file_name));
+        vespalib::File::sync(vespalib::dirname(file_name));
+    } catch (const std::exception& e) {
+        LOG(warning, "Unable to save posting list cache snapshot to '%s': %s", file_name.c_str(), e.what());
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<PostingListCacheSnapshot>
+PostingListCacheSnapshot::load(const std::string& file_name)
+{
+    if (!fs::exists(fs::path(file_name))) {
+        return {};
+    }
+    auto snapshot = std::make_unique<PostingListCacheSnapshot>();
+    try {
+        auto buf = vespalib::File::readAll(file_name);
+        nbostream is(buf.data(), buf.size());
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint32_t num_files = 0;
+        is >> magic >> version >> num_files;
+        if (magic != file_magic || version != file_version) {
+            LOG(warning, "Bad header in posting list cache snapshot '%s'", file_name.c_str());
+            return {};
+        }
+        for (uint32_t i = 0; i < num_files; ++i) {
+            std::string dir;
+            uint64_t size_on_disk = 0;
+            uint32_t num_posting_lists = 0;
+            uint32_t num_bit_vectors = 0;
+            is >> dir >> size_on_disk >> num_posting_lists;
+            auto& entries = snapshot->add_file(dir, size_on_disk);
+            for (uint32_t j = 0; j < num_posting_lists; ++j) {
+                PostingListEntry entry{0, 0, false};
+                is >> entry.bit_offset >> entry.bit_length >> entry.protected_segment;
+                entries.posting_lists.emplace_back(entry);
+            }
+            is >> num_bit_vectors;
+            for (uint32_t j = 0; j < num_bit_vectors; ++j) {
+                BitVectorEntry entry{0, false};
+                is >> entry.idx >> entry.protected_segment;
+                entries.bit_vectors.emplace_back(entry);
+            }
+        }
+        is >> magic;
+        if (magic != file_magic || !is.empty()) {
+            LOG(warning, "Bad trailer in posting list cache snapshot '%s'", file_name.c_str());
+            return {};
+        }
+    } catch (const std::exception& e) {
+        LOG(warning, "Unable to load posting list cache snapshot from '%s': %s", file_name.c_str(), e.what());
+        return {};
+    }
+    return snapshot;
+}
+
+}
@@ -0,0 +1,64 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace search::diskindex {
+
+/*
+ * Snapshot of the keys in a posting list cache, used for prefetching
+ * posting lists and bitvectors into the cache after a restart.
+ *
+ * File ids are process local, thus the keys are grouped by the directory
+ * of the field index instead. The size on disk of the field index is used
+ * to detect that the directory no longer contains the same field index.
+ * Within each file, entries are ordered from least recently used to most
+ * recently used, with the entries in the protected segment last.
+ */
+class PostingListCacheSnapshot {
+public:
+    struct PostingListEntry {
+        uint64_t bit_offset;
+        uint64_t bit_length;
+        bool     protected_segment;
+        bool operator==(const PostingListEntry& rhs) const noexcept = default;
+    };
+    struct BitVectorEntry {
+        uint32_t idx;
+        bool     protected_segment;
+        bool operator==(const BitVectorEntry& rhs) const noexcept = default;
+    };
+    struct FileEntries {
+        uint64_t                      size_on_disk;
+        std::vector<PostingListEntry> posting_lists;
+        std::vector<BitVectorEntry>   bit_vectors;
+        FileEntries() noexcept;
+        ~FileEntries();
+        bool operator==(const FileEntries& rhs) const noexcept = default;
+    };
+    using FileMap = std::map<std::string, FileEntries>;
+private:
+    FileMap _files;
+public:
+    PostingListCacheSnapshot();
+    ~PostingListCacheSnapshot();
+    FileEntries& add_file(const std::string& dir, uint64_t size_on_disk);
+    const FileMap& files() const noexcept { return _files; }
+    FileMap& files() noexcept { return _files; }
+    size_t num_entries() const noexcept;
+    /*
+     * Save snapshot to the given file, replacing it atomically. Returns false on failure.
+     */
+    bool save(const std::string& file_name) const;
+    /*
+     * Load snapshot from the given file. Returns nullptr if the file is missing or corrupt.
+     */
+    static std::unique_ptr<PostingListCacheSnapshot> load(const std::string& file_name);
+};
+
+}
@@ -58,15 +58,50 @@ Zc4PostingReaderBase::NoSkipBase::check_end(uint32_t last_doc_id)
 Zc4PostingReaderBase::NoSkip::NoSkip()
     : NoSkipBase(),
       _field_length(1),
-      _num_occs(1)
+      _num_occs(1),
+      _decode_block_doc_ids(false),
+      _block_idx(ZcBlockDecoder::block_size),
+      _block_decoder()
 {
 }
 
 Zc4PostingReaderBase::NoSkip::~NoSkip() = default;
 
+void
+Zc4PostingReaderBase::NoSkip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, bool decode_block_doc_ids)
+{
+    NoSkipBase::setup(decode_context, size, doc_id);
+    _decode_block_doc_ids = decode_block_doc_ids;
+    _block_idx = ZcBlockDecoder::block_size;
+}
+
+void
+Zc4PostingReaderBase::NoSkip::read_block(bool decode_interleaved_features)
+{
+    if (_block_idx == ZcBlockDecoder::block_size) {
+        assert(_zc_decoder.before_end());
+        auto next = _block_decoder.decode(_zc_decoder.get_cur(), _doc_id, decode_interleaved_features);
+        assert(next <= _zc_buf.data() + _zc_buf.size());
+        _zc_decoder.set_cur(next);
+        _block_idx = 0;
+        // Skip info refers to start of next block
+        _doc_id_pos = _zc_decoder.pos();
+    }
+    _doc_id = _block_decoder.get_doc_id(_block_idx);
+    if (decode_interleaved_features) {
+        _field_length = _block_decoder.get_field_length(_block_idx);
+        _num_occs = _block_decoder.get_num_occs(_block_idx);
+    }
+    ++_block_idx;
+}
+
 void
 Zc4PostingReaderBase::NoSkip::read(bool decode_interleaved_features)
 {
+    if (_decode_block_doc_ids) {
+        read_block(decode_interleaved_features);
+        return;
+    }
     assert(_zc_decoder.before_end());
     _doc_id += (_zc_decoder.decode32() + 1);
     if (decode_interleaved_features) {
@@ -80,7 +115,7 @@ void
 Zc4PostingReaderBase::NoSkip::check_not_end(uint32_t last_doc_id)
 {
     assert(_doc_id < last_doc_id);
-    assert(_zc_decoder.before_end());
+    assert(_zc_decoder.before_end() || (_decode_block_doc_ids && _block_idx < ZcBlockDecoder::block_size));
 }
 
 Zc4PostingReaderBase::L1Skip::L1Skip()
@@ -90,12 +125,12 @@ Zc4PostingReaderBase::L1Skip::L1Skip()
 }
 
 void
-Zc4PostingReaderBase::L1Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id)
+Zc4PostingReaderBase::L1Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max_weights)
 {
     NoSkipBase::setup(decode_context, size, doc_id);
     _l1_skip_pos = 0;
     if (size != 0) {
-        next_skip_entry();
+        next_skip_entry(decode_block_max_weights);
     } else {
         _doc_id = last_doc_id;
     }
@@ -121,9 +156,13 @@ Zc4PostingReaderBase::L1Skip::check(const Zc4PostingReaderBase& rb, const std::s
 }
 
 void
-Zc4PostingReaderBase::L1Skip::next_skip_entry()
+Zc4PostingReaderBase::L1Skip::next_skip_entry(bool decode_block_max_weights)
 {
     _doc_id += (_zc_decoder.decode32() + 1);
+    if (decode_block_max_weights) {
+        // Max element weight in skip block, only used by iterators during search
+        _zc_decoder.decode32();
+    }
 }
 
 Zc4PostingReaderBase::L2Skip::L2Skip()
@@ -133,9 +172,9 @@ Zc4PostingReaderBase::L2Skip::L2Skip()
 }
 
 void
-Zc4PostingReaderBase::L2Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id)
+Zc4PostingReaderBase::L2Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max_weights)
 {
-    L1Skip::setup(decode_context, size, doc_id, last_doc_id);
+    L1Skip::setup(decode_context, size, doc_id, last_doc_id, decode_block_max_weights);
     _l2_skip_pos = 0;
 }
 
@@ -157,9 +196,9 @@ Zc4PostingReaderBase::L3Skip::L3Skip()
 }
 
 void
-Zc4PostingReaderBase::L3Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id)
+Zc4PostingReaderBase::L3Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max_weights)
 {
-    L2Skip::setup(decode_context, size, doc_id, last_doc_id);
+    L2Skip::setup(decode_context, size, doc_id, last_doc_id, decode_block_max_weights);
     _l3_skip_pos = 0;
 }
 
@@ -180,9 +219,9 @@ Zc4PostingReaderBase::L4Skip::L4Skip()
 }
 
 void
-Zc4PostingReaderBase::L4Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id)
+Zc4PostingReaderBase::L4Skip::setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max_weights)
 {
-    L3Skip::setup(decode_context, size, doc_id, last_doc_id);
+    L3Skip::setup(decode_context, size, doc_id, last_doc_id, decode_block_max_weights);
 }
 
 void
@@ -231,13 +270,13 @@ Zc4PostingReaderBase::read_common_word_doc_id(DecodeContext64Base &decode_contex
                 _l3_skip.check(*this, l3_name, _l2_skip, true, _posting_params._encode_features);
                 if (_no_skip.get_doc_id() >= _l4_skip.get_doc_id()) {
                     _l4_skip.check(*this, l4_name, _l3_skip, _posting_params._encode_features);
-                    _l4_skip.next_skip_entry();
+                    _l4_skip.next_skip_entry(_posting_params._encode_block_max_weights);
                 }
-                _l3_skip.next_skip_entry();
+                _l3_skip.next_skip_entry(_posting_params._encode_block_max_weights);
             }
-            _l2_skip.next_skip_entry();
+            _l2_skip.next_skip_entry(_posting_params._encode_block_max_weights);
         }
-        _l1_skip.next_skip_entry();
+        _l1_skip.next_skip_entry(_posting_params._encode_block_max_weights);
     }
     _no_skip.read(_posting_params._encode_interleaved_features);
     if (_residue == 1) {
@@ -269,11 +308,11 @@ Zc4PostingReaderBase::read_word_start_with_skip(DecodeContext64Base &decode_cont
         assert(_num_docs == _counts._numDocs);
     }
     uint32_t prev_doc_id = _no_skip.get_doc_id();
-    _no_skip.setup(decode_context, header._doc_ids_size, prev_doc_id);
-    _l1_skip.setup(decode_context, header._l1_skip_size, prev_doc_id, _last_doc_id);
-    _l2_skip.setup(decode_context, header._l2_skip_size, prev_doc_id, _last_doc_id);
-    _l3_skip.setup(decode_context, header._l3_skip_size, prev_doc_id, _last_doc_id);
-    _l4_skip.setup(decode_context, header._l4_skip_size, prev_doc_id, _last_doc_id);
+    _no_skip.setup(decode_context, header._doc_ids_size, prev_doc_id, _posting_params._encode_block_doc_ids);
+    _l1_skip.setup(decode_context, header._l1_skip_size, prev_doc_id, _last_doc_id, _posting_params._encode_block_max_weights);
+    _l2_skip.setup(decode_context, header._l2_skip_size, prev_doc_id, _last_doc_id, _posting_params._encode_block_max_weights);
+    _l3_skip.setup(decode_context, header._l3_skip_size, prev_doc_id, _last_doc_id, _posting_params._encode_block_max_weights);
+    _l4_skip.setup(decode_context, header._l4_skip_size, prev_doc_id, _last_doc_id, _posting_params._encode_block_max_weights);
     if (_has_more || has_more) {
         assert(_last_doc_id == _counts._segments[_chunkNo]._lastDoc);
     }
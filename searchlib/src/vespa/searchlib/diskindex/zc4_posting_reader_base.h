@@ -3,6 +3,7 @@
 #pragma once
 
 #include "zc4_posting_params.h"
+#include "zc_block_codec.h"
 #include "zc_decoder_validator.h"
 #include "zcbuf.h"
 #include <vespa/searchlib/bitcompression/compression.h>
@@ -44,9 +45,14 @@ protected:
     protected:
         uint32_t _field_length;
         uint32_t _num_occs;
+        bool _decode_block_doc_ids;
+        uint32_t _block_idx;    // index of next doc id in decoded block
+        ZcBlockDecoder _block_decoder;
+        void read_block(bool decode_interleaved_features);
     public:
         NoSkip();
         ~NoSkip();
+        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, bool decode_block_doc_ids);
         void read(bool decode_interleaved_features);
         void check_not_end(uint32_t last_doc_id);
         uint32_t get_field_length() const { return _field_length; }
@@ -60,9 +66,9 @@ protected:
         uint32_t _l1_skip_pos;
     public:
         L1Skip();
-        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
+        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max_weights);
         void check(const Zc4PostingReaderBase& rb, const std::string& level_name, const NoSkipBase &no_skip, bool top_level, bool decode_features);
-        void next_skip_entry();
+        void next_skip_entry(bool decode_block_max_weights);
         uint32_t get_l1_skip_pos() const { return _l1_skip_pos; }
     };
     class L2Skip : public L1Skip
@@ -71,7 +77,7 @@ protected:
         uint32_t _l2_skip_pos;
     public:
         L2Skip();
-        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
+        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max_weights);
         void check(const Zc4PostingReaderBase& rb, const std::string& level_name, const L1Skip &l1_skip, bool top_level, bool decode_features);
         uint32_t get_l2_skip_pos() const { return _l2_skip_pos; }
     };
@@ -81,7 +87,7 @@ protected:
         uint32_t _l3_skip_pos;
     public:
         L3Skip();
-        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
+        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max_weights);
         void check(const Zc4PostingReaderBase& rb, const std::string& level_name, const L2Skip &l2_skip, bool top_level, bool decode_features);
         uint32_t get_l3_skip_pos() const { return _l3_skip_pos; }
     };
@@ -89,7 +95,7 @@ protected:
     {
     public:
         L4Skip();
-        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id);
+        void setup(DecodeContext &decode_context, uint32_t size, uint32_t doc_id, uint32_t last_doc_id, bool decode_block_max_weights);
         void check(const Zc4PostingReaderBase& rb, const std::string& level_name, const L3Skip &l3_skip, bool decode_features);
     };
     uint32_t _doc_id_k;
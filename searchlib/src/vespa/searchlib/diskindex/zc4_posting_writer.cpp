@@ -4,7 +4,9 @@
 #include "zc4_posting_writer.h"
 #include <vespa/searchlib/index/docidandfeatures.h>
 #include <vespa/searchlib/index/postinglistcounts.h>
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 using search::index::DocIdAndFeatures;
 using search::index::PostingListCounts;
@@ -12,6 +14,26 @@ using search::index::PostingListParams;
 
 namespace search::diskindex {
 
+namespace {
+
+int32_t
+calc_max_element_weight(const DocIdAndFeatures &features)
+{
+    if (features.has_raw_data()) {
+        return features.max_element_weight();
+    }
+    if (features.elements().empty()) {
+        return 1;
+    }
+    int32_t max_element_weight = std::numeric_limits<int32_t>::min();
+    for (const auto &element : features.elements()) {
+        max_element_weight = std::max(max_element_weight, element.getWeight());
+    }
+    return max_element_weight;
+}
+
+}
+
 template <bool bigEndian>
 Zc4PostingWriter<bigEndian>::Zc4PostingWriter(PostingListCounts &counts)
     : Zc4PostingWriterBase(counts),
@@ -147,10 +169,11 @@ Zc4PostingWriter<bigEndian>::write_docid_and_features(const DocIdAndFeatures &fe
         uint64_t featureSize = writeOffset - _featureOffset;
         assert(static_cast<uint32_t>(featureSize) == featureSize);
         _docIds.emplace_back(features.doc_id(), features.field_length(), features.num_occs(),
-                             static_cast<uint32_t>(featureSize));
+                             static_cast<uint32_t>(featureSize), calc_max_element_weight(features));
         _featureOffset = writeOffset;
     } else {
-        _docIds.emplace_back(features.doc_id(), features.field_length(), features.num_occs(), 0);
+        _docIds.emplace_back(features.doc_id(), features.field_length(), features.num_occs(), 0,
+                             calc_max_element_weight(features));
     }
 }
 
@@ -2,10 +2,14 @@
 
 #include "zc4_posting_writer_base.h"
 #include "features_size_flush.h"
+#include "zc_block_codec.h"
+#include "zc_block_max_weight.h"
 #include <vespa/searchlib/index/postinglistcounts.h>
 #include <vespa/searchlib/index/postinglistparams.h>
+#include <algorithm>
 #include <cassert>
 #include <limits>
+#include <type_traits>
 
 using search::index::PostingListCounts;
 using search::index::PostingListParams;
@@ -36,18 +40,54 @@ public:
     uint64_t get_feature_pos() const { return _feature_pos; }
 };
 
+/*
+ * Doc id encoder writing bit packed blocks of doc id deltas (and
+ * interleaved features). Doc id position is only updated when a block
+ * has been written, thus skip entries must be aligned with blocks.
+ */
+class BlockDocIdEncoder : public DocIdEncoder {
+    static constexpr uint32_t block_size = ZcBlockCodec::block_size;
+    uint32_t _block_idx;
+    uint32_t _deltas[block_size];
+    uint32_t _field_lengths[block_size];
+    uint32_t _num_occs[block_size];
+
+public:
+    BlockDocIdEncoder()
+        : DocIdEncoder(),
+          _block_idx(0u),
+          _deltas(),
+          _field_lengths(),
+          _num_occs()
+    {
+    }
+
+    void write(ZcBuf &zc_buf, const DocIdAndFeatureSize &doc_id_and_feature_size, bool encode_interleaved_features);
+    void flush(ZcBuf &zc_buf, bool encode_interleaved_features);
+};
+
 class L1SkipEncoder : public DocIdEncoder {
 protected:
     uint32_t _stride_check;
     uint32_t _l1_skip_pos;
+    int32_t  _block_max_weight; // Max element weight for documents after previous skip entry
     const bool _encode_features;
+    const bool _encode_block_max_weights;
 
+    void encode_block_max_weight(ZcBuf &zc_buf) {
+        if (_encode_block_max_weights) {
+            zc_buf.encode32(encode_block_max_weight_value(_block_max_weight));
+        }
+        _block_max_weight = std::numeric_limits<int32_t>::min();
+    }
 public:
-    L1SkipEncoder(bool encode_features)
+    L1SkipEncoder(bool encode_features, bool encode_block_max_weights)
         : DocIdEncoder(),
           _stride_check(0u),
           _l1_skip_pos(0u),
-          _encode_features(encode_features)
+          _block_max_weight(std::numeric_limits<int32_t>::min()),
+          _encode_features(encode_features),
+          _encode_block_max_weights(encode_block_max_weights)
     {
     }
 
@@ -57,6 +97,8 @@ public:
     void dec_stride_check() { --_stride_check; }
     void write_partial_skip(ZcBuf &zc_buf, uint32_t doc_id);
     uint32_t get_l1_skip_pos() const { return _l1_skip_pos; }
+    void add_block_max_weight(int32_t weight) { _block_max_weight = std::max(_block_max_weight, weight); }
+    int32_t get_block_max_weight() const { return _block_max_weight; }
 };
 
 struct L2SkipEncoder : public L1SkipEncoder {
@@ -64,8 +106,8 @@ protected:
     uint32_t _l2_skip_pos;
 
 public:
-    L2SkipEncoder(bool encode_features)
-        : L1SkipEncoder(encode_features),
+    L2SkipEncoder(bool encode_features, bool encode_block_max_weights)
+        : L1SkipEncoder(encode_features, encode_block_max_weights),
           _l2_skip_pos(0u)
     {
     }
@@ -80,8 +122,8 @@ protected:
     uint32_t _l3_skip_pos;
 
 public:
-    L3SkipEncoder(bool encode_features)
-        : L2SkipEncoder(encode_features),
+    L3SkipEncoder(bool encode_features, bool encode_block_max_weights)
+        : L2SkipEncoder(encode_features, encode_block_max_weights),
           _l3_skip_pos(0u)
     {
     }
@@ -94,8 +136,8 @@ public:
 class L4SkipEncoder : public L3SkipEncoder {
 
 public:
-    L4SkipEncoder(bool encode_features)
-        : L3SkipEncoder(encode_features)
+    L4SkipEncoder(bool encode_features, bool encode_block_max_weights)
+        : L3SkipEncoder(encode_features, encode_block_max_weights)
     {
     }
 
@@ -118,6 +160,42 @@ DocIdEncoder::write(ZcBuf &zc_buf, const DocIdAndFeatureSize &doc_id_and_feature
     _doc_id_pos = zc_buf.size();
 }
 
+void
+BlockDocIdEncoder::write(ZcBuf &zc_buf, const DocIdAndFeatureSize &doc_id_and_feature_size, bool encode_interleaved_features)
+{
+    _feature_pos += doc_id_and_feature_size._features_size;
+    _deltas[_block_idx] = doc_id_and_feature_size._doc_id - _doc_id - 1;
+    _doc_id = doc_id_and_feature_size._doc_id;
+    if (encode_interleaved_features) {
+        assert(doc_id_and_feature_size._field_length > 0);
+        _field_lengths[_block_idx] = doc_id_and_feature_size._field_length - 1;
+        assert(doc_id_and_feature_size._num_occs > 0);
+        _num_occs[_block_idx] = doc_id_and_feature_size._num_occs - 1;
+    }
+    if (++_block_idx == block_size) {
+        flush(zc_buf, encode_interleaved_features);
+    }
+}
+
+void
+BlockDocIdEncoder::flush(ZcBuf &zc_buf, bool encode_interleaved_features)
+{
+    if (_block_idx == 0) {
+        return;
+    }
+    // Pad partial block
+    std::fill(_deltas + _block_idx, _deltas + block_size, 0u);
+    std::fill(_field_lengths + _block_idx, _field_lengths + block_size, 0u);
+    std::fill(_num_occs + _block_idx, _num_occs + block_size, 0u);
+    zc_buf.encode_block(_deltas);
+    if (encode_interleaved_features) {
+        zc_buf.encode_block(_field_lengths);
+        zc_buf.encode_block(_num_occs);
+    }
+    _block_idx = 0;
+    _doc_id_pos = zc_buf.size();
+}
+
 void
 L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
 {
@@ -127,6 +205,8 @@ L1SkipEncoder::encode_skip(ZcBuf &zc_buf, const DocIdEncoder &doc_id_encoder)
     assert(static_cast<int32_t>(doc_id_delta) > 0);
     zc_buf.encode32(doc_id_delta - 1);
     _doc_id = doc_id_encoder.get_doc_id();
+    // max element weight in skip block
+    encode_block_max_weight(zc_buf);
     // doc id pos
     zc_buf.encode32(doc_id_encoder.get_doc_id_pos() - _doc_id_pos - 1);
     _doc_id_pos = doc_id_encoder.get_doc_id_pos();
@@ -149,6 +229,7 @@ L1SkipEncoder::write_partial_skip(ZcBuf &zc_buf, uint32_t doc_id)
 {
     if (zc_buf.size() > 0) {
         zc_buf.encode32(doc_id - _doc_id - 1);
+        encode_block_max_weight(zc_buf);
     }
 }
 
@@ -210,6 +291,8 @@ Zc4PostingWriterBase::Zc4PostingWriterBase(PostingListCounts &counts)
       _writePos(0),
       _dynamicK(false),
       _encode_interleaved_features(false),
+      _encode_block_max_weights(false),
+      _encode_block_doc_ids(false),
       _features_size_flush_bits(std::numeric_limits<uint64_t>::max()),
       _zcDocIds(),
       _l1Skip(),
@@ -231,14 +314,14 @@ Zc4PostingWriterBase::~Zc4PostingWriterBase() = default;
 #define L3SKIPSTRIDE 8
 #define L4SKIPSTRIDE 8
 
+template <typename DocIdEncoderType>
 void
-Zc4PostingWriterBase::calc_skip_info(bool encode_features)
+Zc4PostingWriterBase::calc_skip_info(DocIdEncoderType &doc_id_encoder, uint32_t l1_skip_stride, bool encode_features)
 {
-    DocIdEncoder doc_id_encoder;
-    L1SkipEncoder l1_skip_encoder(encode_features);
-    L2SkipEncoder l2_skip_encoder(encode_features);
-    L3SkipEncoder l3_skip_encoder(encode_features);
-    L4SkipEncoder l4_skip_encoder(encode_features);
+    L1SkipEncoder l1_skip_encoder(encode_features, _encode_block_max_weights);
+    L2SkipEncoder l2_skip_encoder(encode_features, _encode_block_max_weights);
+    L3SkipEncoder l3_skip_encoder(encode_features, _encode_block_max_weights);
+    L4SkipEncoder l4_skip_encoder(encode_features, _encode_block_max_weights);
     l1_skip_encoder.dec_stride_check();
     if (!_counts._segments.empty()) {
         uint32_t doc_id = _counts._segments.back()._lastDoc;
@@ -249,11 +332,14 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
         l4_skip_encoder.set_doc_id(doc_id);
     }
     for (const auto &doc_id_and_feature_size : _docIds) {
-        if (l1_skip_encoder.should_write_skip(L1SKIPSTRIDE)) {
+        if (l1_skip_encoder.should_write_skip(l1_skip_stride)) {
+            l2_skip_encoder.add_block_max_weight(l1_skip_encoder.get_block_max_weight());
             l1_skip_encoder.write_skip(_l1Skip, doc_id_encoder);
             if (l2_skip_encoder.should_write_skip(L2SKIPSTRIDE)) {
+                l3_skip_encoder.add_block_max_weight(l2_skip_encoder.get_block_max_weight());
                 l2_skip_encoder.write_skip(_l2Skip, l1_skip_encoder);
                 if (l3_skip_encoder.should_write_skip(L3SKIPSTRIDE)) {
+                    l4_skip_encoder.add_block_max_weight(l3_skip_encoder.get_block_max_weight());
                     l3_skip_encoder.write_skip(_l3Skip, l2_skip_encoder);
                     if (l4_skip_encoder.should_write_skip(L4SKIPSTRIDE)) {
                         l4_skip_encoder.write_skip(_l4Skip, l3_skip_encoder);
@@ -262,14 +348,34 @@ Zc4PostingWriterBase::calc_skip_info(bool encode_features)
             }
         }
         doc_id_encoder.write(_zcDocIds, doc_id_and_feature_size, _encode_interleaved_features);
+        l1_skip_encoder.add_block_max_weight(doc_id_and_feature_size._max_element_weight);
+    }
+    if constexpr (std::is_same_v<DocIdEncoderType, BlockDocIdEncoder>) {
+        doc_id_encoder.flush(_zcDocIds, _encode_interleaved_features);
     }
     // Extra partial entries for skip tables to simplify iterator during search
+    l2_skip_encoder.add_block_max_weight(l1_skip_encoder.get_block_max_weight());
     l1_skip_encoder.write_partial_skip(_l1Skip, doc_id_encoder.get_doc_id());
+    l3_skip_encoder.add_block_max_weight(l2_skip_encoder.get_block_max_weight());
     l2_skip_encoder.write_partial_skip(_l2Skip, doc_id_encoder.get_doc_id());
+    l4_skip_encoder.add_block_max_weight(l3_skip_encoder.get_block_max_weight());
     l3_skip_encoder.write_partial_skip(_l3Skip, doc_id_encoder.get_doc_id());
     l4_skip_encoder.write_partial_skip(_l4Skip, doc_id_encoder.get_doc_id());
 }
 
+void
+Zc4PostingWriterBase::calc_skip_info(bool encode_features)
+{
+    if (_encode_block_doc_ids) {
+        // Skip entries must be aligned with blocks
+        BlockDocIdEncoder doc_id_encoder;
+        calc_skip_info(doc_id_encoder, ZcBlockCodec::block_size, encode_features);
+    } else {
+        DocIdEncoder doc_id_encoder;
+        calc_skip_info(doc_id_encoder, L1SKIPSTRIDE, encode_features);
+    }
+}
+
 void
 Zc4PostingWriterBase::clear_skip_info()
 {
@@ -287,6 +393,8 @@ Zc4PostingWriterBase::set_posting_list_params(const PostingListParams &params)
     params.get("minChunkDocs", _minChunkDocs);
     params.get("minSkipDocs", _minSkipDocs);
     params.get("interleaved_features", _encode_interleaved_features);
+    params.get("block_max_weights", _encode_block_max_weights);
+    params.get("block_doc_ids", _encode_block_doc_ids);
     params.get(tags::FEATURES_SIZE_FLUSH_BITS, _features_size_flush_bits);
 }
 
@@ -24,11 +24,14 @@ public:
         uint32_t _field_length;
         uint32_t _num_occs;
         uint32_t _features_size;
-        DocIdAndFeatureSize(uint32_t doc_id, uint32_t field_length, uint32_t num_occs, uint32_t features_size) noexcept
+        int32_t  _max_element_weight;
+        DocIdAndFeatureSize(uint32_t doc_id, uint32_t field_length, uint32_t num_occs, uint32_t features_size,
+                            int32_t max_element_weight) noexcept
             : _doc_id(doc_id),
               _field_length(field_length),
               _num_occs(num_occs),
-              _features_size(features_size)
+              _features_size(features_size),
+              _max_element_weight(max_element_weight)
         {
         }
     };
@@ -44,6 +47,8 @@ protected:
     uint64_t _writePos; // Bit position for start of current word
     bool _dynamicK;     // Caclulate EG compression parameters ?
     bool _encode_interleaved_features;
+    bool _encode_block_max_weights; // Max element weight per skip block ?
+    bool _encode_block_doc_ids;     // Bit packed blocks of doc id deltas ?
     uint64_t _features_size_flush_bits;
     ZcBuf _zcDocIds;    // Document id deltas
     ZcBuf _l1Skip;      // L1 skip info
@@ -62,6 +67,8 @@ protected:
     Zc4PostingWriterBase &operator=(Zc4PostingWriterBase &&) = delete;
     Zc4PostingWriterBase(index::PostingListCounts &counts);
     ~Zc4PostingWriterBase();
+    template <typename DocIdEncoderType>
+    void calc_skip_info(DocIdEncoderType &doc_id_encoder, uint32_t l1_skip_stride, bool encode_features);
     void calc_skip_info(bool encode_features);
     void clear_skip_info();
 
@@ -74,8 +81,12 @@ public:
     uint64_t get_num_words() const { return _numWords; }
     bool get_dynamic_k() const { return _dynamicK; }
     bool get_encode_interleaved_features() const { return _encode_interleaved_features; }
+    bool get_encode_block_max_weights() const { return _encode_block_max_weights; }
+    bool get_encode_block_doc_ids() const { return _encode_block_doc_ids; }
     void set_dynamic_k(bool dynamicK) { _dynamicK = dynamicK; }
     void set_encode_interleaved_features(bool encode_interleaved_features) { _encode_interleaved_features = encode_interleaved_features; }
+    void set_encode_block_max_weights(bool encode_block_max_weights) { _encode_block_max_weights = encode_block_max_weights; }
+    void set_encode_block_doc_ids(bool encode_block_doc_ids) { _encode_block_doc_ids = encode_block_doc_ids; }
     void set_posting_list_params(const index::PostingListParams &params);
 };
 
@@ -0,0 +1,154 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "zc_block_codec.h"
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace search::diskindex {
+
+namespace {
+
+constexpr uint32_t lanes = ZcBlockCodec::lanes;
+constexpr uint32_t rows = ZcBlockCodec::rows;
+
+void
+load_words(const uint8_t* src, uint32_t num_words, uint32_t* words) noexcept
+{
+    memcpy(words, src, num_words * sizeof(uint32_t));
+    if constexpr (std::endian::native == std::endian::big) {
+        for (uint32_t i = 0; i < num_words; ++i) {
+            words[i] = __builtin_bswap32(words[i]);
+        }
+    }
+}
+
+void
+store_words(uint32_t* words, uint32_t num_words, uint8_t* dst) noexcept
+{
+    if constexpr (std::endian::native == std::endian::big) {
+        for (uint32_t i = 0; i < num_words; ++i) {
+            words[i] = __builtin_bswap32(words[i]);
+        }
+    }
+    memcpy(dst, words, num_words * sizeof(uint32_t));
+}
+
+template <uint32_t bits>
+void
+unpack_bits(const uint32_t* words, uint32_t* values) noexcept
+{
+    constexpr uint32_t mask = (bits == 32) ? ~0u : ((1u << bits) - 1);
+    for (uint32_t row = 0; row < rows; ++row) {
+        uint32_t bit_pos = row * bits;
+        uint32_t word = bit_pos / 32;
+        uint32_t shift = bit_pos % 32;
+        const uint32_t* lo = words + word * lanes;
+        uint32_t* dst = values + row * lanes;
+        if (shift + bits > 32) {
+            const uint32_t* hi = lo + lanes;
+            for (uint32_t lane = 0; lane < lanes; ++lane) {
+                dst[lane] = ((lo[lane] >> shift) | (hi[lane] << (32 - shift))) & mask;
+            }
+        } else {
+            for (uint32_t lane = 0; lane < lanes; ++lane) {
+                dst[lane] = (lo[lane] >> shift) & mask;
+            }
+        }
+    }
+}
+
+using UnpackFunc = void (*)(const uint32_t*, uint32_t*) noexcept;
+
+template <size_t... bits>
+constexpr std::array<UnpackFunc, sizeof...(bits)>
+make_unpack_funcs(std::index_sequence<bits...>) noexcept
+{
+    return {&unpack_bits<bits>...};
+}
+
+constexpr auto unpack_funcs = make_unpack_funcs(std::make_index_sequence<33>());
+
+void
+unpack_values(const uint8_t*& src, uint32_t* values) noexcept
+{
+    uint32_t bits = *src++;
+    assert(bits <= 32);
+    ZcBlockCodec::unpack(src, bits, values);
+    src += ZcBlockCodec::packed_bytes(bits);
+}
+
+}
+
+uint32_t
+ZcBlockCodec::calc_bits(const uint32_t* values) noexcept
+{
+    uint32_t acc = 0;
+    for (uint32_t i = 0; i < block_size; ++i) {
+        acc |= values[i];
+    }
+    return std::bit_width(acc);
+}
+
+void
+ZcBlockCodec::pack(const uint32_t* values, uint32_t bits, uint8_t* dst) noexcept
+{
+    assert(bits <= 32);
+    if (bits == 0) {
+        return;
+    }
+    uint32_t words[block_size] = {};
+    for (uint32_t row = 0; row < rows; ++row) {
+        uint32_t bit_pos = row * bits;
+        uint32_t word = bit_pos / 32;
+        uint32_t shift = bit_pos % 32;
+        for (uint32_t lane = 0; lane < lanes; ++lane) {
+            uint32_t value = values[row * lanes + lane];
+            assert(bits == 32 || (value >> bits) == 0);
+            words[word * lanes + lane] |= value << shift;
+            if (shift + bits > 32) {
+                words[(word + 1) * lanes + lane] |= value >> (32 - shift);
+            }
+        }
+    }
+    store_words(words, bits * lanes, dst);
+}
+
+void
+ZcBlockCodec::unpack(const uint8_t* src, uint32_t bits, uint32_t* values) noexcept
+{
+    uint32_t words[block_size];
+    load_words(src, bits * lanes, words);
+    unpack_funcs[bits](words, values);
+}
+
+ZcBlockDecoder::ZcBlockDecoder() noexcept
+    : _doc_ids(),
+      _field_lengths(),
+      _num_occs()
+{
+}
+
+const uint8_t*
+ZcBlockDecoder::decode(const uint8_t* src, uint32_t prev_doc_id, bool decode_interleaved_features) noexcept
+{
+    unpack_values(src, _doc_ids);
+    uint32_t doc_id = prev_doc_id;
+    for (uint32_t i = 0; i < block_size; ++i) {
+        doc_id += _doc_ids[i] + 1;
+        _doc_ids[i] = doc_id;
+    }
+    if (decode_interleaved_features) {
+        unpack_values(src, _field_lengths);
+        unpack_values(src, _num_occs);
+        for (uint32_t i = 0; i < block_size; ++i) {
+            ++_field_lengths[i];
+            ++_num_occs[i];
+        }
+    }
+    return src;
+}
+
+}
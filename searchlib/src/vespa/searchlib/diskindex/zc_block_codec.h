@@ -0,0 +1,60 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace search::diskindex {
+
+/*
+ * Bit packing of blocks of block_size 32-bit values, used for docid deltas
+ * and interleaved features in posting lists with block coded doc ids.
+ *
+ * The values are packed in a vertical layout over 4 lanes, i.e. value i
+ * is stored in lane (i % lanes). Each lane is bit packed into 32-bit words
+ * interleaved with the words for the other lanes, and all lanes use the
+ * same shifts and masks. This allows the compiler to unpack all lanes in
+ * parallel using 128-bit vector instructions.
+ *
+ * A packed block is stored as one byte containing the bit width followed
+ * by (bits * block_size / 8) bytes containing the packed words in little
+ * endian byte order. Partial blocks are padded with zero values.
+ */
+class ZcBlockCodec {
+public:
+    static constexpr uint32_t block_size = 128;
+    static constexpr uint32_t lanes = 4;
+    static constexpr uint32_t rows = block_size / lanes;
+
+    static constexpr size_t packed_bytes(uint32_t bits) noexcept { return bits * (block_size / 8); }
+    // Returns number of bits needed to represent the largest value
+    static uint32_t calc_bits(const uint32_t* values) noexcept;
+    // Packs block_size values to packed_bytes(bits) bytes at dst
+    static void pack(const uint32_t* values, uint32_t bits, uint8_t* dst) noexcept;
+    // Unpacks block_size values from packed_bytes(bits) bytes at src
+    static void unpack(const uint8_t* src, uint32_t bits, uint32_t* values) noexcept;
+};
+
+/*
+ * Class for decoding a block of block coded doc ids, with interleaved
+ * features if present. Doc ids are decoded as absolute values.
+ */
+class ZcBlockDecoder {
+public:
+    static constexpr uint32_t block_size = ZcBlockCodec::block_size;
+private:
+    uint32_t _doc_ids[block_size];
+    uint32_t _field_lengths[block_size];
+    uint32_t _num_occs[block_size];
+public:
+    ZcBlockDecoder() noexcept;
+    // Decode block at src following prev_doc_id. Returns start of next block.
+    const uint8_t* decode(const uint8_t* src, uint32_t prev_doc_id, bool decode_interleaved_features) noexcept;
+    const uint32_t* get_doc_ids() const noexcept { return _doc_ids; }
+    uint32_t get_doc_id(uint32_t idx) const noexcept { return _doc_ids[idx]; }
+    uint32_t get_field_length(uint32_t idx) const noexcept { return _field_lengths[idx]; }
+    uint32_t get_num_occs(uint32_t idx) const noexcept { return _num_occs[idx]; }
+};
+
+}
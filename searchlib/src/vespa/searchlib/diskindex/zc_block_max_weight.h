@@ -0,0 +1,22 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search::diskindex {
+
+/*
+ * Mapping of max element weight for a skip block to and from the
+ * unsigned value stored in the skip info (zigzag encoding, small
+ * absolute values use few bytes).
+ */
+constexpr uint32_t encode_block_max_weight_value(int32_t weight) noexcept {
+    return (static_cast<uint32_t>(weight) << 1) ^ static_cast<uint32_t>(weight >> 31);
+}
+
+constexpr int32_t decode_block_max_weight_value(uint32_t value) noexcept {
+    return static_cast<int32_t>((value >> 1) ^ (0u - (value & 1)));
+}
+
+}
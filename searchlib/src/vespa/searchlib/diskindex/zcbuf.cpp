@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "zcbuf.h"
+#include "zc_block_codec.h"
 #include <cstdlib>
 #include <cstring>
 
@@ -13,4 +14,14 @@ ZcBuf::ZcBuf()
 
 ZcBuf::~ZcBuf() = default;
 
+void
+ZcBuf::encode_block(const uint32_t* values)
+{
+    uint32_t bits = ZcBlockCodec::calc_bits(values);
+    _buffer.push_back(bits);
+    size_t pos = _buffer.size();
+    _buffer.resize(pos + ZcBlockCodec::packed_bytes(bits));
+    ZcBlockCodec::pack(values, bits, _buffer.data() + pos);
+}
+
 }
@@ -47,6 +47,9 @@ public:
         assert(num <= encode42_max);
         internal_encode(num);
     }
+
+    // Bit pack a block of ZcBlockCodec::block_size values
+    void encode_block(const uint32_t* values);
 };
 
 }
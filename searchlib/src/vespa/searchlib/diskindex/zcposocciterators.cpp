@@ -80,15 +80,19 @@ create_zc_posocc_iterator(const PostingListCounts &counts, bitcompression::Posit
                     unpack_interleaved_features, &fields_params, std::move(match_data));
         }
     } else {
+        std::unique_ptr<ZcPostingIteratorBase> result;
         if (posting_params._dynamic_k) {
-            return std::make_unique<ZcPosOccIterator<bigEndian, true>>(start, bit_length, posting_params._doc_id_limit,
+            result = std::make_unique<ZcPosOccIterator<bigEndian, true>>(start, bit_length, posting_params._doc_id_limit,
                     posting_params._encode_features, posting_params._encode_interleaved_features, unpack_normal_features,
                     unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, std::move(match_data));
         } else {
-            return std::make_unique<ZcPosOccIterator<bigEndian, false>>(start, bit_length, posting_params._doc_id_limit,
+            result = std::make_unique<ZcPosOccIterator<bigEndian, false>>(start, bit_length, posting_params._doc_id_limit,
                     posting_params._encode_features, posting_params._encode_interleaved_features, unpack_normal_features,
                     unpack_interleaved_features, posting_params._min_chunk_docs, counts, &fields_params, std::move(match_data));
         }
+        result->set_decode_block_max_weights(posting_params._encode_block_max_weights);
+        result->set_decode_block_doc_ids(posting_params._encode_block_doc_ids);
+        return result;
     }
 }
 
@@ -2,6 +2,7 @@
 
 #include "zcposoccrandread.h"
 #include "zcposocciterators.h"
+#include <vespa/vespalib/coro/async_io.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/fastos/file.h>
@@ -26,12 +27,16 @@ using search::index::PostingListCounts;
 using search::index::PostingListFileRange;
 using search::index::PostingListHandle;
 using search::ComprFileReadContext;
+using vespalib::coro::AsyncIo;
+using vespalib::coro::Lazy;
 
 namespace {
 
 std::string myId4("Zc.4");
 std::string myId5("Zc.5");
 std::string interleaved_features("interleaved_features");
+std::string block_max_weights("block_max_weights");
+std::string block_doc_ids("block_doc_ids");
 
 PostingListFileRange get_file_range(const DictionaryLookupResult& lookup_result, uint64_t header_bit_size)
 {
@@ -111,41 +116,63 @@ ZcPosOccRandRead::read_posting_list(const DictionaryLookupResult& lookup_result)
         size_t pad_before = file_range.start_offset - vespalib::round_down_to_page_boundary(file_range.start_offset);
         handle._read_bytes = vespalib::round_up_to_page_size(pad_before + file_range.size() + decode_prefetch_size);
     } else {
-        uint64_t vectorLen = file_range.size();
-        size_t padBefore;
-        size_t padAfter;
-        size_t padExtraAfter;       // Decode prefetch space
-        _file->DirectIOPadding(file_range.start_offset, vectorLen, padBefore, padAfter);
-        padExtraAfter = 0;
-        if (padAfter < decode_prefetch_size) {
-            padExtraAfter = decode_prefetch_size - padAfter;
-        }
-
-        size_t mallocLen = padBefore + vectorLen + padAfter + padExtraAfter;
-        void *alignedBuffer = nullptr;
-        if (mallocLen > 0) {
-            alignedBuffer = _file->AllocateDirectIOBuffer(mallocLen);
-            assert(alignedBuffer != nullptr);
-            assert(file_range.end_offset + padAfter + padExtraAfter <= _fileSize);
-            _file->ReadBuf(alignedBuffer,
-                           padBefore + vectorLen + padAfter,
-                           file_range.start_offset - padBefore);
-        }
-        // Zero decode prefetch memory to avoid uninitialized reads
-        if (padExtraAfter > 0) {
-            memset(reinterpret_cast<char *>(alignedBuffer) + padBefore + vectorLen + padAfter,
-                   '\0',
-                   padExtraAfter);
-        }
-        handle._mem = static_cast<char *>(alignedBuffer) + padBefore;
-        handle._allocMem = std::shared_ptr<void>(alignedBuffer, free);
-        handle._allocSize = mallocLen;
-        handle._read_bytes = padBefore + vectorLen + padAfter;
+        auto read_range = alloc_direct_io_buffer(file_range, handle);
+        _file->ReadBuf(handle._allocMem.get(), read_range.size(), read_range.start_offset);
     }
     handle._bitOffsetMem = (file_range.start_offset << 3) - _headerBitSize;
     return handle;
 }
 
+PostingListFileRange
+ZcPosOccRandRead::alloc_direct_io_buffer(const PostingListFileRange& file_range, PostingListHandle& handle) const
+{
+    uint64_t vectorLen = file_range.size();
+    size_t padBefore;
+    size_t padAfter;
+    size_t padExtraAfter;       // Decode prefetch space
+    _file->DirectIOPadding(file_range.start_offset, vectorLen, padBefore, padAfter);
+    padExtraAfter = 0;
+    if (padAfter < decode_prefetch_size) {
+        padExtraAfter = decode_prefetch_size - padAfter;
+    }
+
+    size_t mallocLen = padBefore + vectorLen + padAfter + padExtraAfter;
+    void *alignedBuffer = _file->AllocateDirectIOBuffer(mallocLen);
+    assert(alignedBuffer != nullptr);
+    assert(file_range.end_offset + padAfter + padExtraAfter <= _fileSize);
+    // Zero decode prefetch memory to avoid uninitialized reads
+    if (padExtraAfter > 0) {
+        memset(reinterpret_cast<char *>(alignedBuffer) + padBefore + vectorLen + padAfter,
+               '\0',
+               padExtraAfter);
+    }
+    handle._mem = static_cast<char *>(alignedBuffer) + padBefore;
+    handle._allocMem = std::shared_ptr<void>(alignedBuffer, free);
+    handle._allocSize = mallocLen;
+    handle._read_bytes = padBefore + vectorLen + padAfter;
+    return {file_range.start_offset - padBefore, file_range.end_offset + padAfter};
+}
+
+Lazy<PostingListHandle>
+ZcPosOccRandRead::async_read_posting_list(AsyncIo& async_io, const DictionaryLookupResult& lookup_result)
+{
+    int fd = _file->get_fd();
+    if (lookup_result.counts._bitLength == 0 || _file->IsMemoryMapped() || fd < 0) {
+        co_return read_posting_list(lookup_result);
+    }
+    PostingListHandle handle;
+    auto file_range = get_file_range(lookup_result, _headerBitSize);
+    auto read_range = alloc_direct_io_buffer(file_range, handle);
+    ssize_t res = co_await async_io.pread(fd, static_cast<char *>(handle._allocMem.get()), read_range.size(),
+                                          read_range.start_offset);
+    if (res != ssize_t(read_range.size())) {
+        // Short read or error, retry with synchronous read which reports errors
+        co_return read_posting_list(lookup_result);
+    }
+    handle._bitOffsetMem = (file_range.start_offset << 3) - _headerBitSize;
+    co_return handle;
+}
+
 void
 ZcPosOccRandRead::consider_trim_posting_list(const DictionaryLookupResult &lookup_result, PostingListHandle &handle,
                                              double bloat_factor) const
@@ -254,6 +281,12 @@ ZcPosOccRandRead::readHeader(const std::string &identifier)
     if (header.hasTag(interleaved_features) && (header.getTag(interleaved_features).asInteger() != 0)) {
         _posting_params._encode_interleaved_features = true;
     }
+    if (header.hasTag(block_max_weights) && (header.getTag(block_max_weights).asInteger() != 0)) {
+        _posting_params._encode_block_max_weights = true;
+    }
+    if (header.hasTag(block_doc_ids) && (header.getTag(block_doc_ids).asInteger() != 0)) {
+        _posting_params._encode_block_doc_ids = true;
+    }
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
     // Align on 64-bit unit
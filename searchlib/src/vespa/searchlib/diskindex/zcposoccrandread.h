@@ -24,6 +24,10 @@ protected:
 
     static constexpr size_t decode_prefetch_size = 16;
 
+    // Allocate direct io buffer for posting list in handle, returns the file range to read into buffer
+    index::PostingListFileRange alloc_direct_io_buffer(const index::PostingListFileRange& file_range,
+                                                       index::PostingListHandle& handle) const;
+
 public:
     ZcPosOccRandRead();
     ~ZcPosOccRandRead();
@@ -45,6 +49,8 @@ public:
      * Read (possibly partial) posting list into handle.
      */
     PostingListHandle read_posting_list(const DictionaryLookupResult& lookup_result) override;
+    vespalib::coro::Lazy<PostingListHandle>
+    async_read_posting_list(vespalib::coro::AsyncIo& async_io, const DictionaryLookupResult& lookup_result) override;
     void consider_trim_posting_list(const DictionaryLookupResult &lookup_result, PostingListHandle &handle,
                                     double bloat_factor) const override;
     PostingListFileRange get_posting_list_file_range(const DictionaryLookupResult& lookup_result) const override;
@@ -18,6 +18,8 @@ namespace {
 std::string myId5("Zc.5");
 std::string myId4("Zc.4");
 std::string interleaved_features("interleaved_features");
+std::string block_max_weights("block_max_weights");
+std::string block_doc_ids("block_doc_ids");
 
 }
 
@@ -122,6 +124,8 @@ Zc4PostingSeqRead::getParams(PostingListParams &params)
     }
     params.set("minSkipDocs", _reader.get_posting_params()._min_skip_docs);
     params.set(interleaved_features, _reader.get_posting_params()._encode_interleaved_features);
+    params.set(block_max_weights, _reader.get_posting_params()._encode_block_max_weights);
+    params.set(block_doc_ids, _reader.get_posting_params()._encode_block_doc_ids);
 }
 
 
@@ -168,6 +172,12 @@ Zc4PostingSeqRead::readHeader()
     if (header.hasTag(interleaved_features) && (header.getTag(interleaved_features).asInteger() != 0)) {
        posting_params._encode_interleaved_features = true;
     }
+    if (header.hasTag(block_max_weights) && (header.getTag(block_max_weights).asInteger() != 0)) {
+       posting_params._encode_block_max_weights = true;
+    }
+    if (header.hasTag(block_doc_ids) && (header.getTag(block_doc_ids).asInteger() != 0)) {
+       posting_params._encode_block_doc_ids = true;
+    }
     assert(header.getTag("endian").asString() == "big");
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
@@ -235,6 +245,8 @@ Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
     header.putTag(Tag("format.0", myId));
     header.putTag(Tag("format.1", f.getIdentifier()));
     header.putTag(Tag("interleaved_features", _writer.get_encode_interleaved_features() ? 1 : 0));
+    header.putTag(Tag(block_max_weights, _writer.get_encode_block_max_weights() ? 1 : 0));
+    header.putTag(Tag(block_doc_ids, _writer.get_encode_block_doc_ids() ? 1 : 0));
     header.putTag(Tag("numWords", 0));
     header.putTag(Tag("minChunkDocs", _writer.get_min_chunk_docs()));
     header.putTag(Tag("docIdLimit", _writer.get_docid_limit()));
@@ -356,6 +368,8 @@ getParams(PostingListParams &params)
     }
     params.set("minSkipDocs", _writer.get_min_skip_docs());
     params.set(interleaved_features, _writer.get_encode_interleaved_features());
+    params.set(block_max_weights, _writer.get_encode_block_max_weights());
+    params.set(block_doc_ids, _writer.get_encode_block_doc_ids());
 }
 
 
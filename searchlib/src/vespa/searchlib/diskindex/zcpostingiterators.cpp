@@ -196,6 +196,8 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(TermFieldMatchDataArray matchData,
       _zc_decoder(),
       _zc_decoder_start(nullptr),
       _featureSeekPos(0),
+      _block_decoder(),
+      _block_idx(0),
       _l1(),
       _l2(),
       _l3(),
@@ -213,6 +215,42 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(TermFieldMatchDataArray matchData,
 {
 }
 
+ZcPostingIteratorBase::~ZcPostingIteratorBase() = default;
+
+void
+ZcPostingIteratorBase::set_decode_block_max_weights(bool decode_block_max_weights)
+{
+    _l1._decode_block_max_weights = decode_block_max_weights;
+    _l2._decode_block_max_weights = decode_block_max_weights;
+    _l3._decode_block_max_weights = decode_block_max_weights;
+    _l4._decode_block_max_weights = decode_block_max_weights;
+}
+
+void
+ZcPostingIteratorBase::set_decode_block_doc_ids(bool decode_block_doc_ids)
+{
+    if (decode_block_doc_ids) {
+        _block_decoder = std::make_unique<ZcBlockDecoder>();
+    } else {
+        _block_decoder.reset();
+    }
+}
+
+queryeval::SearchIterator::BlockMaxMeta
+ZcPostingIteratorBase::get_block_max() const noexcept
+{
+    /*
+     * The reported weight (first element weight) is only bounded by the
+     * block max element weight when normal features are unpacked. All
+     * documents up to the next L1 skip entry belong to the same block.
+     */
+    if (!_l1._decode_block_max_weights || !_decode_normal_features || !_unpack_normal_features ||
+        _l1._zc_decoder_start == nullptr || isAtEnd()) {
+        return {};
+    }
+    return {_l1._skipDocId, _l1._blockMaxWeight};
+}
+
 template <bool bigEndian>
 ZcPostingIterator<bigEndian>::
 ZcPostingIterator(uint32_t minChunkDocs,
@@ -317,7 +355,6 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     assert((d.getBitOffset() & 7) == 0);
     const uint8_t *bcompr = d.getByteCompr();
     _zc_decoder_start = bcompr;
-    _zc_decoder.set_cur(bcompr);
     bcompr += docIdsSize;
     _l1.setup(prevDocId, _chunk._lastDocId, bcompr, l1SkipSize);
     _l2.setup(prevDocId, _chunk._lastDocId, bcompr, l2SkipSize);
@@ -335,7 +372,7 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     _featureSeekPos = 0;
     clearUnpacked();
     // Unpack first docid delta in chunk
-    nextDocId(prevDocId);
+    seekDocIds(_zc_decoder_start, prevDocId);
 #if DEBUG_ZCPOSTING_PRINTF
     printf("Decode docId=%d\n", getDocId());
 #endif
@@ -391,7 +428,6 @@ ZcPostingIteratorBase::doL4SkipSeek(uint32_t docId)
     _l3._docIdPos = _l4._docIdPos;
     _l2._docIdPos = _l4._docIdPos;
     _l1._docIdPos = _l4._docIdPos;
-    _zc_decoder.set_cur(_l4._docIdPos);
     _l3._skipFeaturePos = _l4._skipFeaturePos;
     _l2._skipFeaturePos = _l4._skipFeaturePos;
     _l1._skipFeaturePos = _l4._skipFeaturePos;
@@ -404,7 +440,7 @@ ZcPostingIteratorBase::doL4SkipSeek(uint32_t docId)
     _l3._l2Pos = _l4._l2Pos;
     _l2._zc_decoder.set_cur(_l4._l2Pos);
     _l3._zc_decoder.set_cur(_l4._l3Pos);
-    nextDocId(lastL4SkipDocId);
+    seekDocIds(_l4._docIdPos, lastL4SkipDocId);
     _l1.nextDocId();
     _l2.nextDocId();
     _l3.nextDocId();
@@ -450,7 +486,6 @@ ZcPostingIteratorBase::doL3SkipSeek(uint32_t docId)
     } while (docId > _l3._skipDocId);
     _l2._docIdPos = _l3._docIdPos;
     _l1._docIdPos = _l3._docIdPos;
-    _zc_decoder.set_cur(_l3._docIdPos);
     _l2._skipFeaturePos = _l3._skipFeaturePos;
     _l1._skipFeaturePos = _l3._skipFeaturePos;
     _l2._skipDocId = lastL3SkipDocId;
@@ -458,7 +493,7 @@ ZcPostingIteratorBase::doL3SkipSeek(uint32_t docId)
     _l2._l1Pos = _l3._l1Pos;
     _l1._zc_decoder.set_cur(_l3._l1Pos);
     _l2._zc_decoder.set_cur(_l3._l2Pos);
-    nextDocId(lastL3SkipDocId);
+    seekDocIds(_l3._docIdPos, lastL3SkipDocId);
     _l1.nextDocId();
     _l2.nextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
@@ -499,11 +534,10 @@ ZcPostingIteratorBase::doL2SkipSeek(uint32_t docId)
 #endif
     } while (docId > _l2._skipDocId);
     _l1._docIdPos = _l2._docIdPos;
-    _zc_decoder.set_cur(_l2._docIdPos);
     _l1._skipFeaturePos = _l2._skipFeaturePos;
     _l1._skipDocId = lastL2SkipDocId;
     _l1._zc_decoder.set_cur(_l2._l1Pos);
-    nextDocId(lastL2SkipDocId);
+    seekDocIds(_l2._docIdPos, lastL2SkipDocId);
     _l1.nextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L2Seek, docId %d docIdPos %d L1SkipPos %d, nextDocId %d\n",
@@ -539,8 +573,7 @@ ZcPostingIteratorBase::doL1SkipSeek(uint32_t docId)
                 _l1._skipDocId);
 #endif
     } while (docId > _l1._skipDocId);
-    _zc_decoder.set_cur(_l1._docIdPos);
-    nextDocId(lastL1SkipDocId);
+    seekDocIds(_l1._docIdPos, lastL1SkipDocId);
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L1SkipSeek, docId %d docIdPos %d, nextDocId %d\n",
            lastL1SkipDocId,
@@ -552,12 +585,35 @@ ZcPostingIteratorBase::doL1SkipSeek(uint32_t docId)
 }
 
 
+void
+ZcPostingIteratorBase::doBlockSeek(uint32_t docId)
+{
+    // Skip info is aligned with blocks, thus docId is within current block
+    uint32_t idx = _block_idx;
+    const uint32_t *doc_ids = _block_decoder->get_doc_ids();
+    while (__builtin_expect(doc_ids[idx] < docId, true)) {
+        ++idx;
+    }
+#if DEBUG_ZCPOSTING_ASSERT
+    assert(idx < ZcBlockDecoder::block_size);
+#endif
+    incNeedUnpack(idx - _block_idx);
+    _block_idx = idx;
+    set_block_doc_id();
+}
+
 void
 ZcPostingIteratorBase::doSeek(uint32_t docId)
 {
     if (docId > _l1._skipDocId) {
         doL1SkipSeek(docId);
     }
+    if (_block_decoder) {
+        if (getDocId() < docId) {
+            doBlockSeek(docId);
+        }
+        return;
+    }
     uint32_t oDocId = getDocId();
 #if DEBUG_ZCPOSTING_ASSERT
     assert(oDocId <= _l1._skipDocId);
@@ -2,10 +2,14 @@
 
 #pragma once
 
+#include "zc_block_codec.h"
+#include "zc_block_max_weight.h"
 #include "zc_decoder.h"
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/queryeval/iterators.h>
+#include <limits>
+#include <memory>
 
 namespace search::diskindex {
 
@@ -111,23 +115,29 @@ protected:
     ZcDecoder      _zc_decoder;     // docid deltas
     const uint8_t* _zc_decoder_start; // start of docid deltas
     uint64_t _featureSeekPos;
+    std::unique_ptr<ZcBlockDecoder> _block_decoder; // Set when doc ids are block coded
+    uint32_t _block_idx;            // index of current doc id in decoded block
 
     // Helper class for L1 skip info
     class L1Skip
     {
     public:
         uint32_t _skipDocId;
+        int32_t  _blockMaxWeight; // Max element weight for documents up to _skipDocId
         ZcDecoder _zc_decoder;
         const uint8_t *_docIdPos;
         uint64_t _skipFeaturePos;
         const uint8_t* _zc_decoder_start;
+        bool _decode_block_max_weights;
 
         L1Skip()
             : _skipDocId(0),
+              _blockMaxWeight(std::numeric_limits<int32_t>::max()),
               _zc_decoder(),
               _docIdPos(nullptr),
               _skipFeaturePos(0),
-              _zc_decoder_start(nullptr)
+              _zc_decoder_start(nullptr),
+              _decode_block_max_weights(false)
         {
         }
 
@@ -136,12 +146,19 @@ protected:
                 _zc_decoder.set_cur(_zc_decoder_start = bcompr);
                 bcompr += skipSize;
                 _skipDocId = prevDocId + 1 + _zc_decoder.decode32();
+                decodeBlockMaxWeight();
             } else {
                 _zc_decoder.set_cur(_zc_decoder_start = nullptr);
                 _skipDocId = lastDocId;
+                _blockMaxWeight = std::numeric_limits<int32_t>::max();
             }
             _skipFeaturePos = 0;
         }
+        void decodeBlockMaxWeight() {
+            if (_decode_block_max_weights) {
+                _blockMaxWeight = decode_block_max_weight_value(_zc_decoder.decode32());
+            }
+        }
         void postSetup(const ZcPostingIteratorBase &l0) {
             _docIdPos = l0._zc_decoder_start;
         }
@@ -153,6 +170,7 @@ protected:
         }
         void nextDocId() {
             _skipDocId += (1 + _zc_decoder.decode32());
+            decodeBlockMaxWeight();
         }
     };
 
@@ -260,7 +278,26 @@ protected:
             _num_occs = 1 + _zc_decoder.decode32();
         }
     }
+    void set_block_doc_id() {
+        setDocId(_block_decoder->get_doc_id(_block_idx));
+        if (_decode_interleaved_features) {
+            _field_length = _block_decoder->get_field_length(_block_idx);
+            _num_occs = _block_decoder->get_num_occs(_block_idx);
+        }
+    }
+    // Position at first doc id after prevDocId, starting at pos (start of block when block coded)
+    void seekDocIds(const uint8_t *pos, uint32_t prevDocId) {
+        if (_block_decoder) {
+            _block_decoder->decode(pos, prevDocId, _decode_interleaved_features);
+            _block_idx = 0;
+            set_block_doc_id();
+        } else {
+            _zc_decoder.set_cur(pos);
+            nextDocId(prevDocId);
+        }
+    }
     virtual void featureSeek(uint64_t offset) = 0;
+    VESPA_DLL_LOCAL void doBlockSeek(uint32_t docId);
     VESPA_DLL_LOCAL void doChunkSkipSeek(uint32_t docId);
     VESPA_DLL_LOCAL void doL4SkipSeek(uint32_t docId);
     VESPA_DLL_LOCAL void doL3SkipSeek(uint32_t docId);
@@ -271,6 +308,10 @@ public:
     ZcPostingIteratorBase(fef::TermFieldMatchDataArray matchData, Position start, uint32_t docIdLimit,
                           bool decode_normal_features, bool decode_interleaved_features,
                           bool unpack_normal_features, bool unpack_interleaved_features);
+    ~ZcPostingIteratorBase() override;
+    void set_decode_block_max_weights(bool decode_block_max_weights);
+    void set_decode_block_doc_ids(bool decode_block_doc_ids);
+    BlockMaxMeta get_block_max() const noexcept override;
 };
 
 template <bool bigEndian>
@@ -14,6 +14,7 @@ namespace vespalib {
     class DataBuffer;
 }
 namespace vespalib::alloc { class Alloc; }
+namespace vespalib::compression { class ZStdDictionary; }
 
 namespace search {
 
@@ -60,12 +61,16 @@ public:
     using UP = std::unique_ptr<Chunk>;
     using CompressionConfig = vespalib::compression::CompressionConfig;
     using ConstBufferRef = vespalib::ConstBufferRef;
+    using DictionarySP = std::shared_ptr<const vespalib::compression::ZStdDictionary>;
     class Config {
     public:
-        Config(size_t maxBytes) noexcept : _maxBytes(maxBytes) { }
+        Config(size_t maxBytes) noexcept : _maxBytes(maxBytes), _dictionary() { }
+        Config(size_t maxBytes, DictionarySP dictionary) noexcept : _maxBytes(maxBytes), _dictionary(std::move(dictionary)) { }
         size_t getMaxBytes() const { return _maxBytes; }
+        const DictionarySP & getDictionary() const { return _dictionary; }
     private:
-      size_t _maxBytes;
+      size_t       _maxBytes;
+      DictionarySP _dictionary;
     };
     class Entry {
     public:
@@ -83,7 +88,7 @@ public:
     };
     using LidList = std::vector<Entry>;
     Chunk(uint32_t id, const Config & config);
-    Chunk(uint32_t id, const void * buffer, size_t len);
+    Chunk(uint32_t id, const void * buffer, size_t len, DictionarySP dictionary = {});
     ~Chunk();
     LidMeta append(uint32_t lid, ConstBufferRef data);
     ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const;
@@ -3,6 +3,7 @@
 #include "chunkformats.h"
 #include <vespa/vespalib/util/compressor.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 namespace search {
 
@@ -12,6 +13,26 @@ using vespalib::compression::compress;
 using vespalib::compression::decompress;
 using vespalib::compression::computeMaxCompressedsize;
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionaryCompressor;
+
+namespace {
+
+CompressionConfig::Type
+compressWithDictionary(const vespalib::compression::ZStdDictionary & dictionary, CompressionConfig compression,
+                       const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest)
+{
+    CompressionConfig::Type type(CompressionConfig::NONE);
+    if (org.size() >= compression.minSize) {
+        ZStdDictionaryCompressor compressor(dictionary);
+        type = compress(compressor, compression, org, dest);
+    }
+    if (type == CompressionConfig::NONE) {
+        dest.writeBytes(org.c_str(), org.size());
+    }
+    return type;
+}
+
+}
 
 ChunkException::ChunkException(const std::string & msg, std::string_view location) :
     Exception(make_string("Illegal chunk: %s", msg.c_str()), location)
@@ -33,7 +54,10 @@ ChunkFormat::pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, Compre
     const size_t oldPos(compressed.getDataLen());
     compressed.writeInt8(compression.type);
     compressed.writeInt32(os.size());
-    CompressionConfig::Type type(compress(compression, vespalib::ConstBufferRef(os.data(), os.size()), compressed, false));
+    vespalib::ConstBufferRef org(os.data(), os.size());
+    CompressionConfig::Type type((_dictionary && (compression.type == CompressionConfig::ZSTD))
+                                 ? compressWithDictionary(*_dictionary, compression, org, compressed)
+                                 : compress(compression, org, compressed, false));
     if (compression.type != type) {
         compressed.getData()[oldPos] = type;
     }
@@ -67,7 +91,7 @@ ChunkFormat::verifyCompression(uint8_t type)
 }
 
 ChunkFormat::UP
-ChunkFormat::deserialize(const void * buffer, size_t len)
+ChunkFormat::deserialize(const void * buffer, size_t len, DictionarySP dictionary)
 {
     uint8_t version(0);
     vespalib::nbostream raw(buffer, len);
@@ -85,6 +109,8 @@ ChunkFormat::deserialize(const void * buffer, size_t len)
         return std::make_unique<ChunkFormatV1>(raw, crc32);
     } else if (version == ChunkFormatV2::VERSION) {
             return std::make_unique<ChunkFormatV2>(raw, crc32);
+    } else if (version == ChunkFormatV3::VERSION) {
+        return std::make_unique<ChunkFormatV3>(raw, crc32, std::move(dictionary));
     } else {
         throw ChunkException(make_string("Unknown version %d", version), VESPA_STRLOC);
     }
@@ -128,7 +154,12 @@ ChunkFormat::deserializeBody(vespalib::nbostream & is)
     // This is a dirty trick to fool some odd sanity checking in DataBuffer::swap
     vespalib::DataBuffer uncompressed(const_cast<char *>(is.peek()), (size_t)0);
     vespalib::ConstBufferRef data(is.peek(), is.size() - sizeof(uint32_t));
-    decompress(CompressionConfig::Type(type), uncompressedLen, data, uncompressed, true);
+    if (_dictionary && (type == CompressionConfig::ZSTD)) {
+        ZStdDictionaryCompressor decompressor(*_dictionary);
+        decompress(decompressor, uncompressedLen, data, uncompressed, true);
+    } else {
+        decompress(CompressionConfig::Type(type), uncompressedLen, data, uncompressed, true);
+    }
     assert(uncompressed.getData() == uncompressed.getDead());
     if (uncompressed.getData() != data.c_str()) {
         const size_t sz(uncompressed.getDataLen());
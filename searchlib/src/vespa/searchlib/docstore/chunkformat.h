@@ -7,6 +7,8 @@
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/exception.h>
 
+namespace vespalib::compression { class ZStdDictionary; }
+
 namespace search {
 
 class ChunkException : public vespalib::Exception
@@ -22,6 +24,7 @@ public:
     virtual ~ChunkFormat();
     using UP = std::unique_ptr<ChunkFormat>;
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using DictionarySP = std::shared_ptr<const vespalib::compression::ZStdDictionary>;
     vespalib::nbostream & getBuffer() { return _dataBuf; }
     const vespalib::nbostream & getBuffer() const { return _dataBuf; }
 
@@ -30,14 +33,16 @@ public:
      * @param lastSerial The last serial number of any entry in the packet.
      * @param compressed The buffer where the serialized data shall be placed.
      * @param compression What kind of compression shall be employed.
+     *                    Zstd will use the dictionary of the format if it has one.
      */
     void pack(uint64_t lastSerial, vespalib::DataBuffer & compressed, CompressionConfig compression);
     /**
      * Will deserialize and create a representation of the uncompressed data.
      * param buffer Pointer to the serialized data
      * @param len Length of serialized data
+     * @param dictionary The compression dictionary required by chunks in format V3.
      */
-    static ChunkFormat::UP deserialize(const void * buffer, size_t len);
+    static ChunkFormat::UP deserialize(const void * buffer, size_t len, DictionarySP dictionary = {});
     /**
      * return the maximum size a packet can have. It allows correct size estimation
      * need for direct io alignment.
@@ -66,6 +71,8 @@ protected:
      * Thows exception if check fails.
      */
     void verifyCrc(const vespalib::nbostream & is, uint32_t expected) const;
+
+    DictionarySP _dictionary;
 private:
     /**
      * Used when serializing to obtain correct version.
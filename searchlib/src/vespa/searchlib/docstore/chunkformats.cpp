@@ -3,7 +3,9 @@
 #include "chunkformats.h"
 #include <vespa/vespalib/util/crc.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <xxhash.h>
+#include <cassert>
 
 namespace search {
 
@@ -57,4 +59,48 @@ ChunkFormatV2::verifyMagic(vespalib::nbostream & is) const
     }
 }
 
+ChunkFormatV3::ChunkFormatV3(vespalib::nbostream & is, uint32_t expectedCrc, DictionarySP dictionary) :
+    ChunkFormat()
+{
+    _dictionary = std::move(dictionary);
+    verifyCrc(is, expectedCrc);
+    verifyHeader(is);
+    deserializeBody(is);
+}
+
+ChunkFormatV3::ChunkFormatV3(size_t maxSize, DictionarySP dictionary) :
+    ChunkFormat(maxSize)
+{
+    _dictionary = std::move(dictionary);
+    assert(_dictionary);
+}
+
+uint32_t
+ChunkFormatV3::computeCrc(const void * buf, size_t sz) const
+{
+    return XXH32(buf, sz, 0);
+}
+
+void
+ChunkFormatV3::writeHeader(vespalib::DataBuffer & buf) const
+{
+    buf.writeInt32(MAGIC);
+    buf.writeInt32(_dictionary->id());
+}
+
+void
+ChunkFormatV3::verifyHeader(vespalib::nbostream & is) const
+{
+    uint32_t magic;
+    is >> magic;
+    if (magic != MAGIC) {
+        throw ChunkException(make_string("Unknown magic %0x, expected %0x", magic, MAGIC), VESPA_STRLOC);
+    }
+    uint32_t dictionaryId;
+    is >> dictionaryId;
+    if ( ! _dictionary || (_dictionary->id() != dictionaryId)) {
+        throw ChunkException(make_string("Missing compression dictionary %u", dictionaryId), VESPA_STRLOC);
+    }
+}
+
 } // namespace search
@@ -42,5 +42,28 @@ private:
     void verifyMagic(vespalib::nbostream & is) const;
 };
 
+/**
+ * As V2, but compressed with a trained zstd dictionary. The id of the
+ * dictionary is stored in the header, the dictionary itself is stored
+ * in the idx file header of the file chunk.
+ */
+class ChunkFormatV3 : public ChunkFormat
+{
+public:
+    enum {VERSION=2, MAGIC=0x5ba32de8};
+    ChunkFormatV3(vespalib::nbostream & is, uint32_t expectedCrc, DictionarySP dictionary);
+    ChunkFormatV3(size_t maxSize, DictionarySP dictionary);
+private:
+    bool includeSerializedSize() const override { return true; }
+    size_t getHeaderSize() const override {
+        // MAGIC + dictionary id
+        return 8;
+    }
+    uint8_t getVersion() const override { return VERSION; }
+    uint32_t computeCrc(const void * buf, size_t sz) const override;
+    void writeHeader(vespalib::DataBuffer & buf) const override;
+    void verifyHeader(vespalib::nbostream & is) const;
+};
+
 } // namespace search
 
@@ -1,9 +1,11 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "compacter.h"
+#include "compaction_throttle.h"
 #include "logdatastore.h"
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/array.hpp>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <cassert>
 
 #include <vespa/log/log.h>
@@ -15,6 +17,8 @@ using vespalib::alloc::Alloc;
 
 namespace {
     constexpr size_t INITIAL_BACKING_BUFFER_SIZE = 64_Mi;
+    // Larger samples do not improve the dictionary, only the start of large documents are used.
+    constexpr size_t MAX_SAMPLE_SIZE = 128_Ki;
 }
 
 void
@@ -24,6 +28,59 @@ Compacter::write(LockGuard guard, uint32_t chunkId, uint32_t lid, ConstBufferRef
     _ds.write(std::move(guard), fileId, lid, data);
 }
 
+DictionarySampler::DictionarySampler(std::unique_ptr<IWriteData> target, size_t maxSampleBytes)
+    : _target(std::move(target)),
+      _maxSampleBytes(maxSampleBytes),
+      _samples(),
+      _sampleSizes()
+{}
+
+DictionarySampler::~DictionarySampler() = default;
+
+void
+DictionarySampler::write(LockGuard guard, uint32_t chunkId, uint32_t lid, ConstBufferRef data) {
+    if ((data.size() > 0) && (_samples.size() < _maxSampleBytes)) {
+        size_t sz = std::min(data.size(), MAX_SAMPLE_SIZE);
+        _samples.insert(_samples.end(), data.c_str(), data.c_str() + sz);
+        _sampleSizes.push_back(sz);
+    }
+    _target->write(std::move(guard), chunkId, lid, data);
+}
+
+Chunk::DictionarySP
+DictionarySampler::train(size_t maxDictionaryBytes) const {
+    return vespalib::compression::ZStdDictionary::train(_samples, _sampleSizes, maxDictionaryBytes);
+}
+
+ThrottledCompacter::ThrottledCompacter(std::unique_ptr<IWriteData> target, CompactionThrottle & throttle)
+    : _target(std::move(target)),
+      _throttle(throttle),
+      _pendingBytes(0),
+      _bytesWritten(0),
+      _throttledTime(vespalib::duration::zero())
+{}
+
+ThrottledCompacter::~ThrottledCompacter() = default;
+
+void
+ThrottledCompacter::write(LockGuard guard, uint32_t chunkId, uint32_t lid, ConstBufferRef data) {
+    _pendingBytes += data.size();
+    _target->write(std::move(guard), chunkId, lid, data);
+}
+
+void
+ThrottledCompacter::updateProgress() {
+    _bytesWritten += _pendingBytes;
+    _throttledTime += _throttle.acquire(_pendingBytes);
+    _pendingBytes = 0;
+}
+
+void
+ThrottledCompacter::close() {
+    updateProgress();
+    _target->close();
+}
+
 BucketIndexStore::BucketIndexStore(size_t maxSignificantBucketBits, uint32_t numPartitions) noexcept
     : _inSignificantBucketBits((maxSignificantBucketBits > 8) ? (maxSignificantBucketBits - 8) : 0),
       _where(),
@@ -23,6 +23,56 @@ private:
     LogDataStore & _ds;
 };
 
+/**
+ * Write through decorator that samples the documents passing through
+ * during compaction, used for training a compression dictionary.
+ * The first documents are sampled until maxSampleBytes is reached.
+ * Writes are done sequentially during compaction, so no locking is needed.
+ */
+class DictionarySampler : public IWriteData
+{
+public:
+    DictionarySampler(std::unique_ptr<IWriteData> target, size_t maxSampleBytes);
+    ~DictionarySampler() override;
+    void write(LockGuard guard, uint32_t chunkId, uint32_t lid, ConstBufferRef data) override;
+    void close() override { _target->close(); }
+    size_t getNumSamples() const noexcept { return _sampleSizes.size(); }
+    size_t getSampleBytes() const noexcept { return _samples.size(); }
+    /// Returns nullptr if training fails.
+    Chunk::DictionarySP train(size_t maxDictionaryBytes) const;
+private:
+    std::unique_ptr<IWriteData> _target;
+    size_t                      _maxSampleBytes;
+    std::vector<char>           _samples;
+    std::vector<size_t>         _sampleSizes;
+};
+
+class CompactionThrottle;
+
+/**
+ * Write through decorator that counts the bytes passing through compaction and
+ * charges them to a shared throttle after each chunk. Throttling is done from
+ * updateProgress() as the lid guard is held while writing.
+ */
+class ThrottledCompacter : public IWriteData,
+                           public IFileChunkVisitorProgress
+{
+public:
+    ThrottledCompacter(std::unique_ptr<IWriteData> target, CompactionThrottle & throttle);
+    ~ThrottledCompacter() override;
+    void write(LockGuard guard, uint32_t chunkId, uint32_t lid, ConstBufferRef data) override;
+    void close() override;
+    void updateProgress() override;
+    uint64_t getBytesWritten() const noexcept { return _bytesWritten; }
+    vespalib::duration getThrottledTime() const noexcept { return _throttledTime; }
+private:
+    std::unique_ptr<IWriteData> _target;
+    CompactionThrottle        & _throttle;
+    size_t                      _pendingBytes;
+    uint64_t                    _bytesWritten;
+    vespalib::duration          _throttledTime;
+};
+
 class BucketIndexStore : public StoreByBucket::StoreIndex {
 public:
     BucketIndexStore(size_t maxSignificantBucketBits, uint32_t numPartitions) noexcept;
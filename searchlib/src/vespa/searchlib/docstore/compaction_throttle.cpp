@@ -0,0 +1,61 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compaction_throttle.h"
+#include <algorithm>
+#include <thread>
+
+namespace search::docstore {
+
+CompactionThrottle::CompactionThrottle(uint64_t maxBytesPerSecond)
+    : _lock(),
+      _maxBytesPerSecond(maxBytesPerSecond),
+      _tokens(maxBytesPerSecond),
+      _lastRefill(vespalib::steady_clock::now())
+{}
+
+CompactionThrottle::~CompactionThrottle() = default;
+
+void
+CompactionThrottle::setMaxBytesPerSecond(uint64_t maxBytesPerSecond)
+{
+    std::lock_guard guard(_lock);
+    _maxBytesPerSecond = maxBytesPerSecond;
+    _tokens = std::min(_tokens, double(maxBytesPerSecond));
+}
+
+uint64_t
+CompactionThrottle::getMaxBytesPerSecond() const
+{
+    std::lock_guard guard(_lock);
+    return _maxBytesPerSecond;
+}
+
+vespalib::duration
+CompactionThrottle::reserve(size_t numBytes, vespalib::steady_time now)
+{
+    std::lock_guard guard(_lock);
+    if (_maxBytesPerSecond == 0) {
+        return vespalib::duration::zero();
+    }
+    double rate = _maxBytesPerSecond;
+    _tokens = std::min(rate, _tokens + rate * vespalib::to_s(now - std::min(now, _lastRefill)));
+    _lastRefill = std::max(now, _lastRefill);
+    _tokens -= numBytes;
+    if (_tokens >= 0.0) {
+        return vespalib::duration::zero();
+    }
+    // Tokens are consumed up front, so concurrent callers queue up behind the deficit.
+    return vespalib::from_s(-_tokens / rate);
+}
+
+vespalib::duration
+CompactionThrottle::acquire(size_t numBytes)
+{
+    vespalib::duration wait = reserve(numBytes, vespalib::steady_clock::now());
+    if (wait > vespalib::duration::zero()) {
+        std::this_thread::sleep_for(wait);
+    }
+    return wait;
+}
+
+}
@@ -0,0 +1,34 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/time.h>
+#include <mutex>
+
+namespace search::docstore {
+
+/**
+ * Token bucket limiting the number of bytes per second passing through compaction.
+ * The bucket holds at most one second worth of bytes. A request larger than the
+ * available tokens is let through after waiting for the deficit to be refilled.
+ * A rate of 0 disables throttling. Shared by all files compacted concurrently.
+ */
+class CompactionThrottle
+{
+public:
+    explicit CompactionThrottle(uint64_t maxBytesPerSecond);
+    ~CompactionThrottle();
+    void setMaxBytesPerSecond(uint64_t maxBytesPerSecond);
+    uint64_t getMaxBytesPerSecond() const;
+    /// Blocks until numBytes can pass. Returns the time spent waiting.
+    vespalib::duration acquire(size_t numBytes);
+private:
+    vespalib::duration reserve(size_t numBytes, vespalib::steady_time now);
+
+    mutable std::mutex   _lock;
+    uint64_t             _maxBytesPerSecond;
+    double               _tokens;
+    vespalib::steady_time _lastRefill;
+};
+
+}
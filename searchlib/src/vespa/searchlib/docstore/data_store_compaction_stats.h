@@ -0,0 +1,64 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/time.h>
+#include <cstdint>
+
+namespace search {
+
+/*
+ * Class representing accumulated stats for compactions done by a data store.
+ */
+class DataStoreCompactionStats
+{
+    uint64_t           _compactedFiles;
+    uint64_t           _bytesRead;
+    uint64_t           _bytesWritten;
+    uint64_t           _bloatRemoved;
+    vespalib::duration _compactionTime;
+    vespalib::duration _throttledTime;
+public:
+    DataStoreCompactionStats() noexcept
+        : _compactedFiles(0),
+          _bytesRead(0),
+          _bytesWritten(0),
+          _bloatRemoved(0),
+          _compactionTime(vespalib::duration::zero()),
+          _throttledTime(vespalib::duration::zero())
+    { }
+    void addCompactedFile(uint64_t bytesRead, uint64_t bytesWritten, uint64_t bloatRemoved,
+                          vespalib::duration compactionTime, vespalib::duration throttledTime) noexcept {
+        ++_compactedFiles;
+        _bytesRead += bytesRead;
+        _bytesWritten += bytesWritten;
+        _bloatRemoved += bloatRemoved;
+        _compactionTime += compactionTime;
+        _throttledTime += throttledTime;
+    }
+    uint64_t compactedFiles() const noexcept           { return _compactedFiles; }
+    // Size of the compacted files
+    uint64_t bytesRead() const noexcept                { return _bytesRead; }
+    // Size of the live documents moved by compaction
+    uint64_t bytesWritten() const noexcept             { return _bytesWritten; }
+    // Disk bloat removed by compaction
+    uint64_t bloatRemoved() const noexcept             { return _bloatRemoved; }
+    vespalib::duration compactionTime() const noexcept { return _compactionTime; }
+    vespalib::duration throttledTime() const noexcept  { return _throttledTime; }
+};
+
+/*
+ * Approximate amount of I/O done by the next compaction of a data store.
+ */
+struct DataStoreCompactionCost
+{
+    uint64_t bytesToRead;
+    uint64_t bytesToWrite;
+    DataStoreCompactionCost() noexcept : bytesToRead(0), bytesToWrite(0) { }
+    DataStoreCompactionCost(uint64_t bytesToRead_in, uint64_t bytesToWrite_in) noexcept
+        : bytesToRead(bytesToRead_in),
+          bytesToWrite(bytesToWrite_in)
+    { }
+};
+
+} // namespace search
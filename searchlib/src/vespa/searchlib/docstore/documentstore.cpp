@@ -6,9 +6,14 @@
 #include "value.h"
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/vespalib/stllike/cache.hpp>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/gate.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <deque>
 
 #include <vespa/log/log.h>
 
@@ -43,12 +48,31 @@ DocumentVisitorAdapter::visit(uint32_t lid, vespalib::ConstBufferRef buf) {
     }
 }
 
+/*
+ * An uncompressed value is not copied when decompressed, and the document
+ * then references the buffer shared with the cache instead of copying
+ * field contents out of it.
+ */
+std::unique_ptr<document::Document>
+make_document(const DocumentTypeRepo &repo, const docstore::Value &value, vespalib::DataBuffer &&uncompressed)
+{
+    if (uncompressed.referencesExternalData() && (uncompressed.getData() == value.get())) {
+        return std::make_unique<document::Document>(repo, vespalib::ConstBufferRef(uncompressed.getData(), uncompressed.getDataLen()),
+                                                    value.shared_buffer());
+    }
+    return std::make_unique<document::Document>(repo, std::move(uncompressed));
+}
+
 }
 
 using vespalib::nbostream;
 
 namespace docstore {
 
+using PrefetchedValues = vespalib::hash_map<DocumentIdT, Value>;
+
+constexpr size_t MAX_VISIT_SET_BYTES_FOR_SINGLE_READ = 256_Ki;
+
 class BackingStore {
 public:
     BackingStore(IDataStore &store, CompressionConfig compression) :
@@ -57,6 +81,11 @@ public:
     { }
 
     bool read(DocumentIdT key, Value &value) const;
+    // Uses the cached visit set containing the lid if there is one, avoiding a read from the backing store
+    bool read(DocumentIdT key, Value &value, const VisitCache &visitCache) const;
+    // Uses the prefetched value if the lid was prefetched, used by the cache when reading many lids
+    bool read(DocumentIdT key, Value &value, PrefetchedValues &prefetched) const;
+    void prefetch(const IDocumentStore::LidVector &lids, PrefetchedValues &prefetched) const;
     void visit(const IDocumentStore::LidVector &lids, const DocumentTypeRepo &repo, IDocumentVisitor &visitor) const;
     void write(DocumentIdT, const Value &);
     void erase(DocumentIdT) {}
@@ -86,6 +115,55 @@ BackingStore::read(DocumentIdT key, Value &value) const {
     return found;
 }
 
+bool
+BackingStore::read(DocumentIdT key, Value &value, const VisitCache &visitCache) const {
+    CompressedBlobSet cached = visitCache.readCached(key);
+    // Decompressing a large set for a single document is more expensive than reading its chunk
+    if (cached.empty() || (cached.uncompressedSize() > MAX_VISIT_SET_BYTES_FOR_SINGLE_READ) || !cached.contains(key)) {
+        return read(key, value);
+    }
+    vespalib::ConstBufferRef blob = cached.getBlobSet().get(key);
+    vespalib::DataBuffer buf(blob.size());
+    buf.writeBytes(blob.c_str(), blob.size());
+    value.set(std::move(buf), blob.size(), getCompression());
+    return true;
+}
+
+bool
+BackingStore::read(DocumentIdT key, Value &value, PrefetchedValues &prefetched) const {
+    auto found = prefetched.find(key);
+    if (found == prefetched.end()) {
+        return read(key, value);
+    }
+    value = std::move(found->second);
+    return ! value.empty();
+}
+
+void
+BackingStore::prefetch(const IDocumentStore::LidVector &lids, PrefetchedValues &prefetched) const {
+    class Collector : public IBufferVisitor {
+    public:
+        Collector(PrefetchedValues &values, CompressionConfig compression) noexcept
+            : _values(values), _compression(compression) { }
+        void visit(uint32_t lid, vespalib::ConstBufferRef buf) override {
+            if (buf.size() > 0) {
+                vespalib::DataBuffer copy(buf.size());
+                copy.writeBytes(buf.c_str(), buf.size());
+                _values[lid].set(std::move(copy), buf.size(), _compression);
+            }
+        }
+    private:
+        PrefetchedValues  &_values;
+        CompressionConfig  _compression;
+    };
+    for (DocumentIdT lid : lids) {
+        // Lids without a document are kept as empty values to avoid reading them again
+        prefetched[lid];
+    }
+    Collector collector(prefetched, getCompression());
+    _backingStore.read(lids, collector);
+}
+
 void
 BackingStore::write(DocumentIdT lid, const Value & value)
 {
@@ -117,6 +195,7 @@ using docstore::Value;
 bool
 DocumentStore::Config::operator == (const Config &rhs) const {
     return  (_maxCacheBytes == rhs._maxCacheBytes) &&
+            (_maxRenderedCacheBytes == rhs._maxRenderedCacheBytes) &&
             (_updateStrategy == rhs._updateStrategy) &&
             (_compression == rhs._compression);
 }
@@ -169,18 +248,83 @@ DocumentStore::visit(const LidVector & lids, const DocumentTypeRepo &repo, IDocu
     }
 }
 
+void
+DocumentStore::prefetch(const LidVector & lids) const
+{
+    if ( ! useCache()) {
+        _backingStore.prefetch(lids);
+        return;
+    }
+    LidVector missing;
+    for (DocumentIdT lid : lids) {
+        if ( ! _cache->hasKey(lid)) {
+            missing.push_back(lid);
+        }
+    }
+    if ( ! missing.empty()) {
+        _backingStore.prefetch(missing);
+    }
+}
+
+void
+DocumentStore::sortInReadOrder(LidVector & lids) const
+{
+    _backingStore.sortInReadOrder(lids);
+}
+
+void
+DocumentStore::readMany(const LidVector & lids, const DocumentTypeRepo &repo, IDocumentVisitor & visitor) const
+{
+    if (lids.size() < 2) {
+        IDocumentStore::readMany(lids, repo, visitor);
+        return;
+    }
+    // Read all lids not in the cache with one batched read, then go through the cache as read() does.
+    LidVector missing;
+    for (DocumentIdT lid : lids) {
+        if ( ! useCache() || ! _cache->hasKey(lid)) {
+            missing.push_back(lid);
+        }
+    }
+    docstore::PrefetchedValues prefetched;
+    if ( ! missing.empty()) {
+        _uncached_lookups.fetch_add(missing.size());
+        _store->prefetch(missing, prefetched);
+    }
+    for (DocumentIdT lid : lids) {
+        Value value;
+        if (useCache()) {
+            value = _cache->read(lid, prefetched);
+        } else {
+            _store->read(lid, value, prefetched);
+        }
+        DocumentUP doc;
+        if ( ! value.empty()) {
+            Value::Result result = value.decompressed();
+            if ( ! result.second) {
+                LOG(warning, "Summary cache for lid %u is corrupt. Invalidating and reading directly from backing store", lid);
+                _cache->invalidate(lid);
+                doc = read(lid, repo);
+            } else {
+                doc = make_document(repo, value, std::move(result.first));
+            }
+        }
+        visitor.visit(lid, std::move(doc));
+    }
+}
+
 std::unique_ptr<document::Document>
 DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
 {
     Value value;
     if (useCache()) {
-        value = _cache->read(lid);
+        value = _cache->read(lid, *_visitCache);
         if (value.empty()) {
             return std::unique_ptr<document::Document>();
         }
         Value::Result result = value.decompressed();
         if ( result.second ) {
-            return std::make_unique<document::Document>(repo, std::move(result.first));
+            return make_document(repo, value, std::move(result.first));
         } else {
             LOG(warning, "Summary cache for lid %u is corrupt. Invalidating and reading directly from backing store", lid);
             _cache->invalidate(lid);
@@ -192,7 +336,7 @@ DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
     if ( ! value.empty() ) {
         Value::Result result = value.decompressed();
         assert(result.second);
-        return std::make_unique<document::Document>(repo, std::move(result.first));
+        return make_document(repo, value, std::move(result.first));
     }
     return std::unique_ptr<document::Document>();
 }
@@ -207,6 +351,8 @@ DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const document::Docume
 void
 DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const vespalib::nbostream & stream) {
     if (useCache()) {
+        // The visit cache is invalidated first as single document reads can be served from it.
+        _visitCache->invalidate(lid); // The cost and complexity of this updating this is not worth it.
         switch (updateStrategy()) {
             case Config::UpdateStrategy::INVALIDATE:
                 _backingStore.write(syncToken, lid, stream.peek(), stream.size());
@@ -224,7 +370,6 @@ DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const vespalib::nbostr
                 }
                 break;
         }
-        _visitCache->invalidate(lid); // The cost and complexity of this updating this is not worth it.
     } else {
         _backingStore.write(syncToken, lid, stream.peek(), stream.size());
     }
@@ -235,8 +380,8 @@ DocumentStore::remove(uint64_t syncToken, DocumentIdT lid)
 {
     _backingStore.remove(syncToken, lid);
     if (useCache()) {
-        _cache->invalidate(lid);
         _visitCache->invalidate(lid);
+        _cache->invalidate(lid);
     }
 }
 
@@ -284,6 +429,28 @@ DocumentStore::getLastFlushTime() const
     return _backingStore.getLastFlushTime();
 }
 
+namespace {
+
+// Returns nullptr for a removed document
+std::shared_ptr<document::Document>
+deserialize_document(const DocumentTypeRepo &repo, const void *buffer, size_t sz)
+{
+    Value value;
+    vespalib::DataBuffer buf(4_Ki);
+    buf.clear();
+    buf.writeBytes(buffer, sz);
+    ssize_t len = sz;
+    if (len > 0) {
+        value.set(std::move(buf), len);
+    }
+    if (value.empty()) {
+        return {};
+    }
+    return std::make_shared<document::Document>(repo, value.decompressed().first);
+}
+
+}
+
 template <class Visitor>
 class DocumentStore::WrapVisitor : public IDataStoreVisitor
 {
@@ -364,16 +531,8 @@ template <class Visitor>
 void
 DocumentStore::WrapVisitor<Visitor>::visit(uint32_t lid, const void *buffer, size_t sz)
 {
-    Value value;
-    vespalib::DataBuffer buf(4_Ki);
-    buf.clear();
-    buf.writeBytes(buffer, sz);
-    ssize_t len = sz;
-    if (len > 0) {
-        value.set(std::move(buf), len);
-    }
-    if (! value.empty()) {
-        auto doc = std::make_shared<document::Document>(_repo, value.decompressed().first);
+    auto doc = deserialize_document(_repo, buffer, sz);
+    if (doc) {
         _visitor.visit(lid, doc);
         rewrite(lid, *doc);
     } else {
@@ -414,6 +573,143 @@ DocumentStore::accept(IDocumentStoreRewriteVisitor &visitor, IDocumentStoreVisit
     _backingStore.accept(wrap, wrapVisitorProgress, true);
 }
 
+/**
+ * Deserializes batches of visited documents on an executor while the
+ * backing store continues reading, and hands the documents to the
+ * visitor in visit order from the visiting thread.
+ */
+class DocumentStore::ParallelReadVisitor : public IDataStoreVisitor
+{
+    struct Batch {
+        std::vector<uint32_t>                             lids;
+        std::vector<std::vector<char>>                    serialized;
+        std::vector<IDocumentStoreReadVisitor::DocumentSP> docs;
+        vespalib::Gate                                    done;
+        Batch() noexcept;
+        ~Batch();
+        void deserialize(const DocumentTypeRepo &repo);
+    };
+    IDocumentStoreReadVisitor              &_visitor;
+    const DocumentTypeRepo                 &_repo;
+    vespalib::Executor                     &_executor;
+    uint32_t                                _batch_size;
+    uint32_t                                _max_pending_batches;
+    std::shared_ptr<Batch>                  _current;
+    std::deque<std::shared_ptr<Batch>>      _pending;
+
+    void submit();
+    void deliver_oldest();
+public:
+    ParallelReadVisitor(IDocumentStoreReadVisitor &visitor, const DocumentTypeRepo &repo,
+                        vespalib::Executor &executor, uint32_t batch_size, uint32_t max_pending_batches);
+    ~ParallelReadVisitor() override;
+    void visit(uint32_t lid, const void *buffer, size_t sz) override;
+    // Must be called after the backing store is done visiting
+    void drain();
+};
+
+DocumentStore::ParallelReadVisitor::Batch::Batch() noexcept = default;
+DocumentStore::ParallelReadVisitor::Batch::~Batch() = default;
+
+void
+DocumentStore::ParallelReadVisitor::Batch::deserialize(const DocumentTypeRepo &repo)
+{
+    docs.reserve(serialized.size());
+    for (auto &buf : serialized) {
+        docs.push_back(deserialize_document(repo, buf.data(), buf.size()));
+        std::vector<char>().swap(buf);
+    }
+    done.countDown();
+}
+
+DocumentStore::ParallelReadVisitor::ParallelReadVisitor(IDocumentStoreReadVisitor &visitor, const DocumentTypeRepo &repo,
+                                                        vespalib::Executor &executor, uint32_t batch_size,
+                                                        uint32_t max_pending_batches)
+    : _visitor(visitor),
+      _repo(repo),
+      _executor(executor),
+      _batch_size(std::max(1u, batch_size)),
+      _max_pending_batches(std::max(1u, max_pending_batches)),
+      _current(),
+      _pending()
+{
+}
+
+DocumentStore::ParallelReadVisitor::~ParallelReadVisitor()
+{
+    // Tasks may still refer to the repo when unwinding
+    for (auto &batch : _pending) {
+        batch->done.await();
+    }
+}
+
+void
+DocumentStore::ParallelReadVisitor::visit(uint32_t lid, const void *buffer, size_t sz)
+{
+    if (!_current) {
+        _current = std::make_shared<Batch>();
+        _current->lids.reserve(_batch_size);
+        _current->serialized.reserve(_batch_size);
+    }
+    const char *data = static_cast<const char *>(buffer);
+    _current->lids.push_back(lid);
+    _current->serialized.emplace_back(data, data + sz);
+    if (_current->lids.size() >= _batch_size) {
+        submit();
+    }
+}
+
+void
+DocumentStore::ParallelReadVisitor::submit()
+{
+    auto batch = std::move(_current);
+    _pending.push_back(batch);
+    auto rejected = _executor.execute(vespalib::makeLambdaTask([batch, &repo = _repo]() { batch->deserialize(repo); }));
+    if (rejected) {
+        rejected->run();
+    }
+    while (_pending.size() > _max_pending_batches) {
+        deliver_oldest();
+    }
+}
+
+void
+DocumentStore::ParallelReadVisitor::deliver_oldest()
+{
+    auto batch = std::move(_pending.front());
+    _pending.pop_front();
+    batch->done.await();
+    for (size_t i = 0; i < batch->lids.size(); ++i) {
+        if (batch->docs[i]) {
+            _visitor.visit(batch->lids[i], batch->docs[i]);
+        } else {
+            _visitor.visit(batch->lids[i]);
+        }
+    }
+}
+
+void
+DocumentStore::ParallelReadVisitor::drain()
+{
+    if (_current) {
+        submit();
+    }
+    while (!_pending.empty()) {
+        deliver_oldest();
+    }
+}
+
+void
+DocumentStore::accept_parallel(IDocumentStoreReadVisitor &visitor, IDocumentStoreVisitorProgress &visitorProgress,
+                               const DocumentTypeRepo &repo, vespalib::Executor &executor,
+                               uint32_t batch_size, uint32_t max_pending_batches)
+{
+    ParallelReadVisitor parallel(visitor, repo, executor, batch_size, max_pending_batches);
+    WrapVisitorProgress wrapVisitorProgress(visitorProgress);
+    _backingStore.accept(parallel, wrapVisitorProgress, false);
+    parallel.drain();
+}
+
 double
 DocumentStore::getVisitCost() const
 {
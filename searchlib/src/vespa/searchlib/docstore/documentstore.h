@@ -28,22 +28,31 @@ public:
         Config() noexcept :
             _compression(CompressionConfig::LZ4, 9, 70),
             _maxCacheBytes(1000000000),
+            _maxRenderedCacheBytes(0),
             _updateStrategy(INVALIDATE)
         { }
         Config(CompressionConfig compression, size_t maxCacheBytes) noexcept :
             _compression((maxCacheBytes != 0) ? compression : CompressionConfig::NONE),
             _maxCacheBytes(maxCacheBytes),
+            _maxRenderedCacheBytes(0),
             _updateStrategy(INVALIDATE)
         { }
         CompressionConfig getCompression() const { return _compression; }
         size_t getMaxCacheBytes()   const { return _maxCacheBytes; }
-        Config & disableCache() { _maxCacheBytes = 0; return *this; }
+        Config & disableCache() { _maxCacheBytes = 0; _maxRenderedCacheBytes = 0; return *this; }
         Config & updateStrategy(UpdateStrategy strategy) { _updateStrategy = strategy; return *this; }
         UpdateStrategy updateStrategy() const { return _updateStrategy; }
+        /*
+         * Size of the cache of rendered document summaries kept on top of this store
+         * by the summary layer. Not used by the document store itself.
+         */
+        Config & maxRenderedCacheBytes(size_t maxBytes) { _maxRenderedCacheBytes = maxBytes; return *this; }
+        size_t getMaxRenderedCacheBytes() const { return _maxRenderedCacheBytes; }
         bool operator == (const Config &) const;
     private:
         CompressionConfig _compression;
         size_t            _maxCacheBytes;
+        size_t            _maxRenderedCacheBytes;
         UpdateStrategy    _updateStrategy;
     };
 
@@ -58,7 +67,10 @@ public:
     ~DocumentStore() override;
 
     DocumentUP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const override;
+    void readMany(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const override;
     void visit(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const override;
+    void prefetch(const LidVector & lids) const override;
+    void sortInReadOrder(LidVector & lids) const override;
     void write(uint64_t synkToken, DocumentIdT lid, const document::Document& doc) override;
     void write(uint64_t synkToken, DocumentIdT lid, const vespalib::nbostream & os) override;
     void remove(uint64_t syncToken, DocumentIdT lid) override;
@@ -81,8 +93,15 @@ public:
                 const document::DocumentTypeRepo &repo) override;
     void accept(IDocumentStoreRewriteVisitor &visitor, IDocumentStoreVisitorProgress &visitorProgress,
                 const document::DocumentTypeRepo &repo) override;
+    void accept_parallel(IDocumentStoreReadVisitor &visitor, IDocumentStoreVisitorProgress &visitorProgress,
+                         const document::DocumentTypeRepo &repo, vespalib::Executor &executor,
+                         uint32_t batch_size, uint32_t max_pending_batches) override;
     double getVisitCost() const override;
     DataStoreStorageStats getStorageStats() const override;
+    DataStoreCompactionStats getCompactionStats() const override { return _backingStore.getCompactionStats(); }
+    DataStoreCompactionCost getApproxCompactionCost(bool dueToBloat) const override {
+        return _backingStore.getApproxCompactionCost(dueToBloat);
+    }
     vespalib::MemoryUsage getMemoryUsage() const override;
     std::vector<DataStoreFileChunkStats> getFileChunkStats() const override;
     size_t getCacheCapacity() const;
@@ -101,6 +120,7 @@ private:
     Config::UpdateStrategy updateStrategy() const;
 
     template <class> class WrapVisitor;
+    class ParallelReadVisitor;
     class WrapVisitorProgress;
     IDataStore &                             _backingStore;
     std::unique_ptr<docstore::BackingStore>  _store;
@@ -12,6 +12,8 @@
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/executor.h>
 #include <vespa/vespalib/util/arrayqueue.hpp>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/fastos/file.h>
 #include <exception>
 #include <filesystem>
@@ -31,6 +33,45 @@ namespace {
 constexpr size_t ALIGNMENT=0x1000;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const std::string DOC_ID_LIMIT_KEY("docIdLimit");
+const std::string COMPRESSION_DICTIONARY_ID_KEY("compression.dictionary.id");
+const std::string COMPRESSION_DICTIONARY_KEY("compression.dictionary");
+
+// Header string tags can not contain null bytes, the dictionary is hex encoded.
+std::string
+toHex(const std::vector<char> & data)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string result;
+    result.reserve(data.size() * 2);
+    for (char c : data) {
+        uint8_t v = c;
+        result.push_back(digits[v >> 4]);
+        result.push_back(digits[v & 0xf]);
+    }
+    return result;
+}
+
+uint8_t
+fromHexDigit(char c)
+{
+    if ((c >= '0') && (c <= '9')) {
+        return c - '0';
+    } else if ((c >= 'a') && (c <= 'f')) {
+        return c - 'a' + 10;
+    }
+    throw vespalib::IllegalArgumentException(vespalib::make_string("Illegal hex digit '%c'", c), VESPA_STRLOC);
+}
+
+std::vector<char>
+fromHex(const std::string & hex)
+{
+    std::vector<char> result;
+    result.reserve(hex.size() / 2);
+    for (size_t i(0); (i + 1) < hex.size(); i += 2) {
+        result.push_back(char((fromHexDigit(hex[i]) << 4) | fromHexDigit(hex[i + 1])));
+    }
+    return result;
+}
 
 }
 
@@ -84,6 +125,7 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const std::string & baseName,
       _idxHeaderLen(0u),
       _numLids(0),
       _docIdLimit(std::numeric_limits<uint32_t>::max()),
+      _compressionDictionary(),
       _modificationTime()
 {
     FastOS_File dataFile(_dataFileName.c_str());
@@ -148,7 +190,7 @@ FileChunk::updateLidMap(const unique_lock &guard, ISetLid &ds, uint64_t serialNu
     }
     const int64_t fileSize = idxFile.getSize();
     if (_idxHeaderLen == 0) {
-        _idxHeaderLen = readIdxHeader(idxFile, _docIdLimit);
+        _idxHeaderLen = readIdxHeader(idxFile, _docIdLimit, _compressionDictionary);
     }
     BucketDensityComputer globalBucketMap(_bucketizer);
     // Guard comes from the same bucketizer so the same guard can be used
@@ -228,8 +270,16 @@ FileChunk::enableRead()
         const int mmapFlags(_tune._randRead.getMemoryMapFlags());
         const int fadviseOptions(_tune._randRead.getAdvise());
         if (frozen()) {
-            LOG(debug, "enableRead(): MMapRandRead: file='%s'", _dataFileName.c_str());
-            _file = std::make_unique<MMapRandRead>(_dataFileName, mmapFlags, fadviseOptions);
+            std::error_code ec;
+            uint64_t fileSize = std::filesystem::file_size(std::filesystem::path(_dataFileName), ec);
+            if (ec || _tune._randRead.getWantMemoryMap(fileSize)) {
+                LOG(debug, "enableRead(): MMapRandRead: file='%s'", _dataFileName.c_str());
+                _file = std::make_unique<MMapRandRead>(_dataFileName, mmapFlags, fadviseOptions);
+            } else {
+                LOG(debug, "enableRead(): NormalRandRead: file='%s', size %" PRIu64 " above mmap limit %" PRIu64,
+                    _dataFileName.c_str(), fileSize, _tune._randRead.getMemoryMapMaxFileSize());
+                _file = std::make_unique<NormalRandRead>(_dataFileName);
+            }
         } else {
             LOG(debug, "enableRead(): MMapRandReadDynamic: file='%s'", _dataFileName.c_str());
             _file = std::make_unique<MMapRandReadDynamic>(_dataFileName, mmapFlags, fadviseOptions);
@@ -339,7 +389,7 @@ FileChunk::appendTo(vespalib::Executor & executor, const IGetLid & db, IWriteDat
             try {
                 vespalib::DataBuffer whole(0ul, ALIGNMENT);
                 FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
-                promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen()));
+                promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), _compressionDictionary));
             } catch (std::exception& e) {
                 promise.set_exception(std::make_exception_ptr(
                     std::runtime_error(std::string("File '") + _dataFileName +
@@ -384,12 +434,27 @@ FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisi
     read(begin + start, count - start, ci, visitor);
 }
 
+void
+FileChunk::prefetch(LidInfoWithLidV::const_iterator begin, size_t count) const
+{
+    if ( ! frozen()) { return; }
+    uint32_t prevChunk = std::numeric_limits<uint32_t>::max();
+    for (size_t i(0); i < count; i++) {
+        uint32_t chunkId = (begin + i)->getChunkId();
+        if ((chunkId != prevChunk) && (chunkId < _chunkInfo.size())) {
+            const ChunkInfo & ci = _chunkInfo[chunkId];
+            _file->prefetch(ci.getOffset(), ci.getSize());
+        }
+        prevChunk = chunkId;
+    }
+}
+
 void
 FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen());
+    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _compressionDictionary);
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
@@ -414,7 +479,7 @@ FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen());
+    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _compressionDictionary);
     return chunk.read(lid, buffer);
 }
 
@@ -439,6 +504,13 @@ FileChunk::readDataHeader(FileRandRead &datFile)
 
 uint64_t
 FileChunk::readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit)
+{
+    Chunk::DictionarySP dictionary;
+    return readIdxHeader(idxFile, docIdLimit, dictionary);
+}
+
+uint64_t
+FileChunk::readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit, Chunk::DictionarySP &dictionary)
 {
     int64_t fileSize = idxFile.getSize();
     uint32_t hl = GenericHeader::getMinSize();
@@ -457,6 +529,7 @@ FileChunk::readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit)
     GenericHeader header;
     header.read(reader);
     docIdLimit = readDocIdLimit(header);
+    dictionary = readCompressionDictionary(header);
     return idxHeaderLen;
 }
 
@@ -476,6 +549,32 @@ FileChunk::writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit)
     header.putTag(vespalib::GenericHeader::Tag(DOC_ID_LIMIT_KEY, docIdLimit));
 }
 
+Chunk::DictionarySP
+FileChunk::readCompressionDictionary(const vespalib::GenericHeader &header)
+{
+    if ( ! header.hasTag(COMPRESSION_DICTIONARY_KEY)) {
+        return {};
+    }
+    auto dictionary = std::make_shared<const vespalib::compression::ZStdDictionary>(fromHex(header.getTag(COMPRESSION_DICTIONARY_KEY).asString()));
+    if (header.hasTag(COMPRESSION_DICTIONARY_ID_KEY) &&
+        (uint32_t(header.getTag(COMPRESSION_DICTIONARY_ID_KEY).asInteger()) != dictionary->id()))
+    {
+        throw vespalib::IllegalArgumentException(make_string("Compression dictionary id mismatch, header says %" PRId64 ", dictionary has %u",
+                                                             header.getTag(COMPRESSION_DICTIONARY_ID_KEY).asInteger(), dictionary->id()),
+                                                 VESPA_STRLOC);
+    }
+    return dictionary;
+}
+
+void
+FileChunk::writeCompressionDictionary(vespalib::GenericHeader &header, const Chunk::DictionarySP &dictionary)
+{
+    if (dictionary) {
+        header.putTag(vespalib::GenericHeader::Tag(COMPRESSION_DICTIONARY_ID_KEY, int64_t(dictionary->id())));
+        header.putTag(vespalib::GenericHeader::Tag(COMPRESSION_DICTIONARY_KEY, toHex(dictionary->data())));
+    }
+}
+
 void
 FileChunk::verify(bool reportOnly) const
 {
@@ -490,7 +589,7 @@ FileChunk::verify(bool reportOnly) const
         vespalib::DataBuffer whole(0ul, ALIGNMENT);
         FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
         try {
-            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen());
+            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen(), _compressionDictionary);
             assert(chunk.getLastSerial() >= lastSerial);
             lastSerial = chunk.getLastSerial();
             if (errorInPrev) {
@@ -112,6 +112,11 @@ public:
     virtual void updateLidMap(const unique_lock &guard, ISetLid &lidMap, uint64_t serialNum, uint32_t docIdLimit);
     virtual ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const;
     virtual void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const;
+    /**
+     * Hint that the chunks holding the given lids are read soon. Lids must be
+     * sorted on chunk. Only frozen files are prefetched.
+     */
+    void prefetch(LidInfoWithLidV::const_iterator begin, size_t count) const;
     void remove(uint32_t lid, uint32_t size);
     virtual size_t getDiskFootprint() const { return _diskFootprint.load(std::memory_order_relaxed); }
     virtual size_t getMemoryFootprint() const;
@@ -160,6 +165,8 @@ public:
     size_t   getErasedBytes() const { return _erasedBytes.load(std::memory_order_relaxed); }
     uint64_t getLastPersistedSerialNum() const;
     uint32_t getDocIdLimit() const { return _docIdLimit; }
+    // Dictionary used for compressing the chunks in this file, if any. Stored in idx file header.
+    const Chunk::DictionarySP & getCompressionDictionary() const { return _compressionDictionary; }
     virtual vespalib::system_time getModificationTime() const;
     virtual bool frozen() const { return true; }
     const std::string & getName() const { return _name; }
@@ -169,7 +176,8 @@ public:
     /**
      * Must be called after chunk has been created to allow correct
      * underlying file object to be created.  Must be called before
-     * any read.
+     * any read. A frozen file larger than the max memory map file
+     * size is read with pread even if memory map is wanted.
      */
     void enableRead();
     // This should never be done to something that is used. Backing
@@ -193,6 +201,7 @@ public:
      * Read header and return number of bytes it consist of.
      */
     static uint64_t readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit);
+    static uint64_t readIdxHeader(FastOS_FileInterface &idxFile, uint32_t &docIdLimit, Chunk::DictionarySP &dictionary);
     static uint64_t readDataHeader(FileRandRead &idxFile);
     static bool isIdxFileEmpty(const std::string & name);
     static void eraseIdxFile(const std::string & name);
@@ -246,6 +255,8 @@ protected:
     void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
+    static Chunk::DictionarySP readCompressionDictionary(const vespalib::GenericHeader &header);
+    static void writeCompressionDictionary(vespalib::GenericHeader &header, const Chunk::DictionarySP &dictionary);
 
     using ChunkInfoVector = std::vector<ChunkInfo, vespalib::allocator_large<ChunkInfo>>;
     const IBucketizer    * _bucketizer;
@@ -259,6 +270,7 @@ protected:
     uint32_t               _idxHeaderLen;
     uint32_t               _numLids;
     uint32_t               _docIdLimit; // Limit when the file was created. Stored in idx file header.
+    Chunk::DictionarySP    _compressionDictionary;
     vespalib::system_time  _modificationTime;
 };
 
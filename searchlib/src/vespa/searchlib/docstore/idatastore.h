@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "data_store_compaction_stats.h"
 #include "data_store_file_chunk_stats.h"
 #include <vespa/searchlib/common/i_compactable_lid_space.h>
 #include <vespa/vespalib/util/memoryusage.h>
@@ -58,6 +59,17 @@ public:
      **/
     virtual ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const = 0;
     virtual void read(const LidVector & lids, IBufferVisitor & visitor) const = 0;
+    /**
+     * Hint that the given lids are read soon, letting the store start the
+     * disk reads ahead. The default is to ignore the hint.
+     **/
+    virtual void prefetch(const LidVector & lids) const { (void) lids; }
+    /**
+     * Reorder the given lids so that reading them in sequence accesses the
+     * underlying storage in sequential order. Lids without any stored data are
+     * moved to the end. The default is to leave the order untouched.
+     **/
+    virtual void sortInReadOrder(LidVector & lids) const { (void) lids; }
 
     /**
      * Write data to the data store.
@@ -159,6 +171,19 @@ public:
      */
     virtual DataStoreStorageStats getStorageStats() const = 0;
 
+    /*
+     * Return accumulated stats for compactions done by data store.
+     */
+    virtual DataStoreCompactionStats getCompactionStats() const { return {}; }
+
+    /*
+     * Return the approximate amount of I/O done by the next compaction, either due to bloat or bucket spread.
+     */
+    virtual DataStoreCompactionCost getApproxCompactionCost(bool dueToBloat) const {
+        (void) dueToBloat;
+        return {};
+    }
+
     /*
      * Return the memory usage for data store.
      */
@@ -5,6 +5,12 @@
 
 namespace search {
 
+void IDocumentStore::readMany(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const {
+    for (uint32_t lid : lids) {
+        visitor.visit(lid, read(lid, repo));
+    }
+}
+
 void IDocumentStore::visit(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const {
     for (uint32_t lid : lids) {
         visitor.visit(lid, read(lid, repo));
@@ -14,6 +14,7 @@ namespace document {
 
 namespace vespalib {
 struct CacheStats;
+class Executor;
 class nbostream;
 }
 
@@ -75,7 +76,22 @@ public:
      * @return NULL if there is no document associated with the lid.
      **/
     virtual DocumentUP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const = 0;
+    /**
+     * Make Documents for many lids, as read() does for a single lid, allowing the
+     * store to batch the reads. Lids without a document are visited with NULL.
+     * The order of the visited lids is not defined.
+     **/
+    virtual void readMany(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
     virtual void visit(const LidVector & lidVector, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
+    /**
+     * Hint that the documents for the given lids are read soon. The default is to ignore the hint.
+     **/
+    virtual void prefetch(const LidVector & lids) const { (void) lids; }
+    /**
+     * Reorder the given lids into the order in which the backing store most
+     * efficiently reads them. The default is to leave the order untouched.
+     **/
+    virtual void sortInReadOrder(LidVector & lids) const { (void) lids; }
 
     /**
      * Serialize and store a document.
@@ -187,6 +203,27 @@ public:
            IDocumentStoreVisitorProgress &visitorProgress,
            const document::DocumentTypeRepo &repo) = 0;
 
+    /**
+     * Visit all documents found in document store, deserializing
+     * batches of batch_size documents on the given executor with at
+     * most max_pending_batches batches in flight. The visitor is
+     * called from the calling thread in the same order as accept().
+     * The default implementation visits serially.
+     */
+    virtual void
+    accept_parallel(IDocumentStoreReadVisitor &visitor,
+                    IDocumentStoreVisitorProgress &visitorProgress,
+                    const document::DocumentTypeRepo &repo,
+                    vespalib::Executor &executor,
+                    uint32_t batch_size,
+                    uint32_t max_pending_batches)
+    {
+        (void) executor;
+        (void) batch_size;
+        (void) max_pending_batches;
+        accept(visitor, visitorProgress, repo);
+    }
+
     /**
      * Return cost of visiting all documents found in document store.
      */
@@ -197,6 +234,19 @@ public:
      */
     virtual DataStoreStorageStats getStorageStats() const = 0;
 
+    /*
+     * Return accumulated stats for compactions done by document store.
+     */
+    virtual DataStoreCompactionStats getCompactionStats() const { return {}; }
+
+    /*
+     * Return the approximate amount of I/O done by the next compactBloat() or compactSpread().
+     */
+    virtual DataStoreCompactionCost getApproxCompactionCost(bool dueToBloat) const {
+        (void) dueToBloat;
+        return {};
+    }
+
     /*
      * Return the memory usage for document store.
      */
@@ -9,10 +9,14 @@
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
+#include <algorithm>
 #include <thread>
 #include <cassert>
 #include <filesystem>
+#include <future>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.docstore.logdatastore");
@@ -24,6 +28,147 @@ namespace search {
 namespace {
     constexpr size_t DEFAULT_MAX_FILESIZE = 256_Mi;
     constexpr uint32_t DEFAULT_MAX_LIDS_PER_FILE = 1_Mi;
+
+bool
+sameChunk(const LidInfoWithLid & a, const LidInfoWithLid & b) noexcept {
+    return (a.getFileId() == b.getFileId()) && (a.getChunkId() == b.getChunkId());
+}
+
+size_t
+countChunks(const LidInfoWithLidV & orderedLids) noexcept {
+    size_t count = orderedLids.empty() ? 0 : 1;
+    for (size_t i(1); i < orderedLids.size(); i++) {
+        if ( ! sameChunk(orderedLids[i - 1], orderedLids[i])) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/*
+ * Keeps a copy of the buffers visited when a chunk is read by another
+ * thread, as the visitor given to read() is only used by the calling thread.
+ */
+class BufferedVisitor : public IBufferVisitor {
+public:
+    BufferedVisitor() noexcept : _entries(), _data() { }
+    void visit(uint32_t lid, vespalib::ConstBufferRef buffer) override {
+        _entries.push_back({lid, _data.size(), buffer.size()});
+        _data.insert(_data.end(), buffer.c_str(), buffer.c_str() + buffer.size());
+    }
+    void replay(IBufferVisitor & visitor) const {
+        for (const Entry & entry : _entries) {
+            visitor.visit(entry.lid, vespalib::ConstBufferRef(_data.data() + entry.offset, entry.size));
+        }
+    }
+private:
+    struct Entry {
+        uint32_t lid;
+        size_t   offset;
+        size_t   size;
+    };
+    std::vector<Entry> _entries;
+    std::vector<char>  _data;
+};
+
+/*
+ * The chunks to read for a multi lid read. Chunks are claimed in order both
+ * by helper tasks and by the calling thread, which visits the results in
+ * order. A busy executor thus only reduces the concurrency, it never makes
+ * the calling thread wait for a chunk nobody is reading.
+ */
+class ChunkReads {
+public:
+    ChunkReads(LidInfoWithLidV orderedLids, const std::vector<FileChunk::UP> & fileChunks);
+    size_t size() const noexcept { return _reads.size(); }
+    // Claims and reads the next unclaimed chunk, returns false if there are none left
+    bool readNext();
+    void visit(IBufferVisitor & visitor);
+private:
+    struct Read {
+        Read(const FileChunk * file_in, LidInfoWithLidV::const_iterator begin_in, size_t count_in);
+        const FileChunk                 * file;
+        LidInfoWithLidV::const_iterator   begin;
+        size_t                            count;
+        BufferedVisitor                   result;
+        std::promise<void>                promise;
+        std::future<void>                 future;
+    };
+    void waitForClaimed();
+
+    LidInfoWithLidV     _orderedLids;
+    std::vector<Read>   _reads;
+    std::atomic<size_t> _next;
+};
+
+ChunkReads::Read::Read(const FileChunk * file_in, LidInfoWithLidV::const_iterator begin_in, size_t count_in)
+    : file(file_in),
+      begin(begin_in),
+      count(count_in),
+      result(),
+      promise(),
+      future(promise.get_future())
+{ }
+
+ChunkReads::ChunkReads(LidInfoWithLidV orderedLids, const std::vector<FileChunk::UP> & fileChunks)
+    : _orderedLids(std::move(orderedLids)),
+      _reads(),
+      _next(0)
+{
+    _reads.reserve(countChunks(_orderedLids));
+    size_t start = 0;
+    for (size_t curr(1); curr <= _orderedLids.size(); curr++) {
+        if ((curr == _orderedLids.size()) || ! sameChunk(_orderedLids[start], _orderedLids[curr])) {
+            _reads.emplace_back(fileChunks[_orderedLids[start].getFileId()].get(), _orderedLids.cbegin() + start, curr - start);
+            start = curr;
+        }
+    }
+}
+
+bool
+ChunkReads::readNext()
+{
+    size_t next = _next.fetch_add(1, std::memory_order_relaxed);
+    if (next >= _reads.size()) {
+        return false;
+    }
+    Read & read = _reads[next];
+    try {
+        read.file->read(read.begin, read.count, read.result);
+        read.promise.set_value();
+    } catch (...) {
+        read.promise.set_exception(std::current_exception());
+    }
+    return true;
+}
+
+void
+ChunkReads::visit(IBufferVisitor & visitor)
+{
+    try {
+        for (Read & read : _reads) {
+            while ((read.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) && readNext()) { }
+            read.future.get();
+            read.result.replay(visitor);
+        }
+    } catch (...) {
+        waitForClaimed();
+        throw;
+    }
+}
+
+void
+ChunkReads::waitForClaimed()
+{
+    // Chunks being read refer to file chunks that are only kept alive by the caller, stop claiming and wait.
+    size_t claimed = std::min(_next.exchange(_reads.size(), std::memory_order_relaxed), _reads.size());
+    for (size_t i(0); i < claimed; i++) {
+        if (_reads[i].future.valid()) {
+            _reads[i].future.wait();
+        }
+    }
+}
+
 }
 
 using common::FileHeaderContext;
@@ -47,8 +192,12 @@ LogDataStore::Config::Config()
       _maxBucketSpread(2.5),
       _minFileSizeFactor(0.2),
       _maxNumLids(DEFAULT_MAX_LIDS_PER_FILE),
+      _maxReadConcurrency(1),
+      _maxCompactConcurrency(1),
+      _compactMaxBytesPerSecond(0),
       _compactCompression(CompressionConfig::LZ4),
-      _fileConfig()
+      _fileConfig(),
+      _compressionDictionaryMaxBytes(0)
 { }
 
 bool
@@ -56,8 +205,12 @@ LogDataStore::Config::operator == (const Config & rhs) const {
     return (_maxBucketSpread == rhs._maxBucketSpread) &&
             (_maxFileSize == rhs._maxFileSize) &&
             (_minFileSizeFactor == rhs._minFileSizeFactor) &&
+            (_maxReadConcurrency == rhs._maxReadConcurrency) &&
+            (_maxCompactConcurrency == rhs._maxCompactConcurrency) &&
+            (_compactMaxBytesPerSecond == rhs._compactMaxBytesPerSecond) &&
             (_compactCompression == rhs._compactCompression) &&
-            (_fileConfig == rhs._fileConfig);
+            (_fileConfig == rhs._fileConfig) &&
+            (_compressionDictionaryMaxBytes == rhs._compressionDictionaryMaxBytes);
 }
 
 class LogDataStore::FileChunkHolder
@@ -91,7 +244,10 @@ LogDataStore::LogDataStore(vespalib::Executor &executor, const std::string &dirN
       _bucketizer(std::move(bucketizer)),
       _currentlyCompacting(),
       _compactLidSpaceGeneration(),
-      _last_name_id(0)
+      _last_name_id(0),
+      _compressionDictionary(),
+      _compactionThrottle(config.getCompactMaxBytesPerSecond()),
+      _compactionStats()
 {
     // Reserve space for 1TB summary in order to avoid locking.
     // Even if we have reserved 16 bits for file id there is no chance that we will even get close to that.
@@ -103,10 +259,13 @@ LogDataStore::LogDataStore(vespalib::Executor &executor, const std::string &dirN
     preload();
     updateLidMap(getLastFileChunkDocIdLimit());
     updateSerialNum();
+    // Continue using the dictionary from the last compaction until a new one is trained
+    _compressionDictionary = _fileChunks[_active.getId()]->getCompressionDictionary();
 }
 
 void LogDataStore::reconfigure(const Config & config) {
     _config = config;
+    _compactionThrottle.setMaxBytesPerSecond(config.getCompactMaxBytesPerSecond());
 }
 
 void
@@ -143,11 +302,10 @@ LogDataStore::updateLidMap(uint32_t lastFileChunkDocIdLimit)
     }
 }
 
-void
-LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
+LidInfoWithLidV
+LogDataStore::getOrderedLids(const LidVector & lids) const
 {
     LidInfoWithLidV orderedLids;
-    GenerationHandler::Guard guard(_genHandler.takeGuard());
     for (uint32_t lid : lids) {
         if (lid < getDocIdLimit()) {
             LidInfo li = vespalib::atomic::load_ref_acquire(_lidInfo.acquire_elem_ref(lid));
@@ -156,9 +314,77 @@ LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
             }
         }
     }
+    std::sort(orderedLids.begin(), orderedLids.end());
+    return orderedLids;
+}
+
+void
+LogDataStore::prefetch(const LidInfoWithLidV & orderedLids) const
+{
+    size_t start = 0;
+    for (size_t curr(1); curr <= orderedLids.size(); curr++) {
+        if ((curr == orderedLids.size()) || (orderedLids[curr].getFileId() != orderedLids[start].getFileId())) {
+            _fileChunks[orderedLids[start].getFileId()]->prefetch(orderedLids.begin() + start, curr - start);
+            start = curr;
+        }
+    }
+}
+
+void
+LogDataStore::prefetch(const LidVector & lids) const
+{
+    GenerationHandler::Guard guard(_genHandler.takeGuard());
+    prefetch(getOrderedLids(lids));
+}
+
+void
+LogDataStore::sortInReadOrder(LidVector & lids) const
+{
+    LidInfoWithLidV orderedLids;
+    {
+        GenerationHandler::Guard guard(_genHandler.takeGuard());
+        orderedLids = getOrderedLids(lids);
+    }
+    if (orderedLids.size() < lids.size()) {
+        // Keep lids without any stored data, in their original order, after the stored ones.
+        std::vector<uint32_t> stored;
+        stored.reserve(orderedLids.size());
+        for (const LidInfoWithLid & li : orderedLids) {
+            stored.push_back(li.getLid());
+        }
+        std::sort(stored.begin(), stored.end());
+        std::stable_partition(lids.begin(), lids.end(), [&stored](uint32_t lid) {
+            return std::binary_search(stored.begin(), stored.end(), lid);
+        });
+    }
+    for (size_t i(0); i < orderedLids.size(); i++) {
+        lids[i] = orderedLids[i].getLid();
+    }
+}
+
+void
+LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
+{
+    GenerationHandler::Guard guard(_genHandler.takeGuard());
+    LidInfoWithLidV orderedLids = getOrderedLids(lids);
     if (orderedLids.empty()) { return; }
 
-    std::sort(orderedLids.begin(), orderedLids.end());
+    const uint32_t maxConcurrency = _config.getMaxReadConcurrency();
+    const size_t numChunks = countChunks(orderedLids);
+    if ((maxConcurrency > 1) && (numChunks > 1)) {
+        auto reads = std::make_shared<ChunkReads>(std::move(orderedLids), _fileChunks);
+        size_t numHelpers = std::min(size_t(maxConcurrency), reads->size()) - 1;
+        for (size_t i(0); i < numHelpers; i++) {
+            auto task = vespalib::makeLambdaTask([reads]() { while (reads->readNext()) { } });
+            _executor.execute(CpuUsage::wrap(std::move(task), CpuCategory::READ));
+        }
+        reads->visit(visitor);
+        return;
+    }
+    if (numChunks > 1) {
+        // Let the os read the following chunks while the first ones are decompressed
+        prefetch(orderedLids);
+    }
     uint32_t prevFile = orderedLids[0].getFileId();
     uint32_t start = 0;
     for (size_t curr(1); curr < orderedLids.size(); curr++) {
@@ -351,12 +577,11 @@ LogDataStore::initFlush(uint64_t syncToken)
     return syncToken;
 }
 
-std::pair<bool, LogDataStore::FileId>
-LogDataStore::findNextToCompact(bool dueToBloat)
+LogDataStore::CostMap
+LogDataStore::rankFilesToCompact(const MonitorGuard & guard, bool dueToBloat) const
 {
-    using CostMap = std::multimap<double, FileId, std::greater<double>>;
+    assert(hasUpdateLock(guard));
     CostMap worst;
-    MonitorGuard guard(_updateLock);
     for (size_t i(0); i < _fileChunks.size(); i++) {
         const auto & fc(_fileChunks[i]);
         if (fc && fc->frozen() && (_currentlyCompacting.find(fc->getNameId()) == _currentlyCompacting.end())) {
@@ -369,6 +594,14 @@ LogDataStore::findNextToCompact(bool dueToBloat)
             }
         }
     }
+    return worst;
+}
+
+std::vector<LogDataStore::FileId>
+LogDataStore::findNextToCompact(bool dueToBloat)
+{
+    MonitorGuard guard(_updateLock);
+    CostMap worst = rankFilesToCompact(guard, dueToBloat);
     if (LOG_WOULD_LOG(debug)) {
         for (const auto & it : worst) {
             const FileChunk & fc = *_fileChunks[it.second.getId()];
@@ -376,17 +609,41 @@ LogDataStore::findNextToCompact(bool dueToBloat)
                        fc.getName().c_str(), it.first * 100, fc.getBucketSpread(), fc.getNumChunks(), fc.getNumBuckets(), fc.getNumUniqueBuckets());
         }
     }
-    std::pair<bool, FileId> retval(false, FileId(-1));
-    if ( ! worst.empty()) {
-        retval.first = true;
-        retval.second = worst.begin()->second;
-    }
-    if (retval.first) {
-        _currentlyCompacting.insert(_fileChunks[retval.second.getId()]->getNameId());
+    // The worst file is always compacted, additional files only when there is something to gain.
+    std::vector<FileId> retval;
+    size_t maxFiles = std::max(1u, _config.getMaxCompactConcurrency());
+    for (auto it = worst.begin(); (it != worst.end()) && (retval.size() < maxFiles); ++it) {
+        if (retval.empty() || (it->first > 0.0)) {
+            retval.push_back(it->second);
+            _currentlyCompacting.insert(_fileChunks[it->second.getId()]->getNameId());
+        }
     }
     return retval;
 }
 
+DataStoreCompactionCost
+LogDataStore::getApproxCompactionCost(bool dueToBloat) const
+{
+    MonitorGuard guard(_updateLock);
+    if (_fileChunks.size() <= 1) {
+        return {};
+    }
+    CostMap worst = rankFilesToCompact(guard, dueToBloat);
+    DataStoreCompactionCost cost;
+    size_t numFiles(0);
+    size_t maxFiles = std::max(1u, _config.getMaxCompactConcurrency());
+    for (auto it = worst.begin(); (it != worst.end()) && (numFiles < maxFiles); ++it) {
+        if ((numFiles == 0) || (it->first > 0.0)) {
+            const FileChunk & fc = *_fileChunks[it->second.getId()];
+            size_t footprint = fc.getDiskFootprint();
+            cost.bytesToRead += footprint;
+            cost.bytesToWrite += footprint - std::min(footprint, fc.getDiskBloat());
+            ++numFiles;
+        }
+    }
+    return cost;
+}
+
 void
 LogDataStore::compactWorst(uint64_t syncToken, bool compactDiskBloat) {
     uint64_t usage = getDiskFootprint();
@@ -397,8 +654,15 @@ LogDataStore::compactWorst(uint64_t syncToken, bool compactDiskBloat) {
     if (doCompact) {
         LOG(debug, "Will compact due to %s: %s", reason, bloatMsg(bloat, usage).c_str());
         auto worst = findNextToCompact(compactDiskBloat);
-        if (worst.first) {
-            compactFile(worst.second);
+        std::vector<std::thread> helpers;
+        for (size_t i(1); i < worst.size(); i++) {
+            helpers.emplace_back([this, fileId = worst[i]]() { compactFile(fileId); });
+        }
+        if ( ! worst.empty()) {
+            compactFile(worst[0]);
+        }
+        for (auto & helper : helpers) {
+            helper.join();
         }
         flushActiveAndWait(syncToken);
         usage = getDiskFootprint();
@@ -447,6 +711,24 @@ bool LogDataStore::shouldCompactToActiveFile(size_t compactedSize) const {
     return (_config.getMinFileSizeFactor() * _config.getMaxFileSize() > compactedSize);
 }
 
+void LogDataStore::trainCompressionDictionary(const docstore::DictionarySampler & sampler, const FileChunk & source)
+{
+    vespalib::BenchmarkTimer timer(1.0);
+    timer.before();
+    auto dictionary = sampler.train(_config.getCompressionDictionaryMaxBytes());
+    timer.after();
+    if ( ! dictionary) {
+        LOG(warning, "Failed training compression dictionary from %zu samples of %zu bytes in file '%s'",
+            sampler.getNumSamples(), sampler.getSampleBytes(), source.getName().c_str());
+        return;
+    }
+    LOG(info, "Trained compression dictionary %u of %zu bytes from %zu samples of %zu bytes in file '%s' in %1.3f seconds",
+        dictionary->id(), dictionary->data().size(), sampler.getNumSamples(), sampler.getSampleBytes(),
+        source.getName().c_str(), timer.min_time());
+    MonitorGuard guard(_updateLock);
+    _compressionDictionary = std::move(dictionary);
+}
+
 void LogDataStore::setNewFileChunk(const MonitorGuard & guard, FileChunk::UP file)
 {
     assert(hasUpdateLock(guard));
@@ -461,16 +743,18 @@ void LogDataStore::compactFile(FileId fileId)
     NameId compactedNameId = fc->getNameId();
     LOG(info, "Compacting file '%s' which has bloat '%2.2f' and bucket-spread '%1.4f",
               fc->getName().c_str(), 100*fc->getDiskBloat()/double(fc->getDiskFootprint()), fc->getBucketSpread());
+    vespalib::Timer timer;
+    size_t disk_footprint;
+    size_t disk_bloat;
+    {
+        MonitorGuard guard(_updateLock);
+        disk_footprint = fc->getDiskFootprint();
+        disk_bloat = fc->getDiskBloat();
+    }
     std::unique_ptr<IWriteData> compacter;
     FileId destinationFileId = FileId::active();
     if (_bucketizer) {
-        size_t compacted_size;
-        {
-            MonitorGuard guard(_updateLock);
-            size_t disk_footprint = fc->getDiskFootprint();
-            size_t disk_bloat = fc->getDiskBloat();
-            compacted_size = (disk_footprint <= disk_bloat) ? 0u : (disk_footprint - disk_bloat);
-        }
+        size_t compacted_size = (disk_footprint <= disk_bloat) ? 0u : (disk_footprint - disk_bloat);
         if ( ! shouldCompactToActiveFile(compacted_size)) {
             MonitorGuard guard(_updateLock);
             destinationFileId = allocateFileId(guard);
@@ -482,8 +766,21 @@ void LogDataStore::compactFile(FileId fileId)
     } else {
         compacter = std::make_unique<docstore::Compacter>(*this);
     }
+    const docstore::DictionarySampler * sampler = nullptr;
+    if (_config.useCompressionDictionary()) {
+        auto dictionarySampler = std::make_unique<docstore::DictionarySampler>(std::move(compacter),
+                                                                               100 * _config.getCompressionDictionaryMaxBytes());
+        sampler = dictionarySampler.get();
+        compacter = std::move(dictionarySampler);
+    }
+    auto throttled = std::make_unique<docstore::ThrottledCompacter>(std::move(compacter), _compactionThrottle);
+    docstore::ThrottledCompacter & throttler = *throttled;
+    compacter = std::move(throttled);
 
-    fc->appendTo(_executor, *this, *compacter, fc->getNumChunks(), nullptr, CpuCategory::COMPACT);
+    fc->appendTo(_executor, *this, *compacter, fc->getNumChunks(), &throttler, CpuCategory::COMPACT);
+    if (sampler != nullptr) {
+        trainCompressionDictionary(*sampler, *fc);
+    }
 
     flushActiveAndWait(0);
     if (!destinationFileId.isActive()) {
@@ -492,6 +789,9 @@ void LogDataStore::compactFile(FileId fileId)
         flushFileAndWait(std::move(guard), compactTo, 0);
         compactTo.freeze(CpuCategory::COMPACT);
     }
+    uint64_t bytesWritten = throttler.getBytesWritten();
+    vespalib::duration throttledTime = throttler.getThrottledTime();
+    vespalib::duration compactionTime = timer.elapsed();
     compacter.reset();
 
     std::this_thread::sleep_for(1s);
@@ -522,6 +822,7 @@ void LogDataStore::compactFile(FileId fileId)
     toDie->erase();
     MonitorGuard guard(_updateLock);
     _currentlyCompacting.erase(compactedNameId);
+    _compactionStats.addCompactedFile(disk_footprint, bytesWritten, disk_bloat, compactionTime, throttledTime);
 }
 
 size_t
@@ -666,7 +967,8 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
     uint32_t docIdLimit = (getDocIdLimit() != 0) ? getDocIdLimit() : std::numeric_limits<uint32_t>::max();
     auto file = std::make_unique< WriteableFileChunk>(_executor, fileId, nameId, getBaseDir(), serialNum,docIdLimit,
                                                       _config.getFileConfig(), _tune, _fileHeaderContext,
-                                                      _bucketizer.get());
+                                                      _bucketizer.get(),
+                                                      _config.useCompressionDictionary() ? _compressionDictionary : Chunk::DictionarySP());
     file->enableRead();
     return file;
 }
@@ -1204,6 +1506,13 @@ LogDataStore::getStorageStats() const
                                  lastSerialNum, lastFlushedSerialNum, docIdLimit);
 }
 
+DataStoreCompactionStats
+LogDataStore::getCompactionStats() const
+{
+    MonitorGuard guard(_updateLock);
+    return _compactionStats;
+}
+
 vespalib::MemoryUsage
 LogDataStore::getMemoryUsage() const
 {
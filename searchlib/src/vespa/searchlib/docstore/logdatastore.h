@@ -3,6 +3,7 @@
 #pragma once
 
 #include "idatastore.h"
+#include "compaction_throttle.h"
 #include "lid_info.h"
 #include "writeablefilechunk.h"
 #include <vespa/searchcommon/common/growstrategy.h>
@@ -15,11 +16,13 @@
 #include <vespa/vespalib/util/executor.h>
 #include <vespa/vespalib/util/rcuvector.h>
 
+#include <map>
 #include <set>
 
 namespace search {
 
 namespace common { class FileHeaderContext; }
+namespace docstore { class DictionarySampler; }
 
 
 /**
@@ -48,18 +51,34 @@ public:
         Config & setMaxNumLids(size_t v) { _maxNumLids = v; return *this; }
         Config & setMaxBucketSpread(double v) noexcept { _maxBucketSpread.store_relaxed(v); return *this; }
         Config & setMinFileSizeFactor(double v) { _minFileSizeFactor = v; return *this; }
+        // Max number of chunks read concurrently by a multi lid read, including the calling thread.
+        Config & setMaxReadConcurrency(uint32_t v) { _maxReadConcurrency = v; return *this; }
+        // Max number of files compacted concurrently by a single compaction, including the calling thread.
+        Config & setMaxCompactConcurrency(uint32_t v) { _maxCompactConcurrency = v; return *this; }
+        // Max bytes per second passing through compaction, shared by all files compacted. 0 means unlimited.
+        Config & setCompactMaxBytesPerSecond(uint64_t v) { _compactMaxBytesPerSecond = v; return *this; }
 
         Config & compactCompression(CompressionConfig v) { _compactCompression = v; return *this; }
         Config & setFileConfig(WriteableFileChunk::Config v) { _fileConfig = v; return *this; }
+        // Max size of a zstd dictionary trained during compaction, 0 disables dictionary compression.
+        Config & setCompressionDictionaryMaxBytes(size_t v) { _compressionDictionaryMaxBytes = v; return *this; }
 
         size_t getMaxFileSize() const { return _maxFileSize; }
         double getMaxBucketSpread() const noexcept { return _maxBucketSpread.load_relaxed(); }
         double getMinFileSizeFactor() const { return _minFileSizeFactor; }
         uint32_t getMaxNumLids() const { return _maxNumLids; }
+        uint32_t getMaxReadConcurrency() const { return _maxReadConcurrency; }
+        uint32_t getMaxCompactConcurrency() const { return _maxCompactConcurrency; }
+        uint64_t getCompactMaxBytesPerSecond() const { return _compactMaxBytesPerSecond; }
 
         CompressionConfig compactCompression() const { return _compactCompression; }
 
         const WriteableFileChunk::Config & getFileConfig() const { return _fileConfig; }
+        size_t getCompressionDictionaryMaxBytes() const { return _compressionDictionaryMaxBytes; }
+        bool useCompressionDictionary() const {
+            return (_compressionDictionaryMaxBytes > 0) &&
+                   (_fileConfig.getCompression().type == CompressionConfig::ZSTD);
+        }
 
         bool operator == (const Config &) const;
     private:
@@ -67,8 +86,12 @@ public:
         AtomicValueWrapper<double>  _maxBucketSpread;
         double                      _minFileSizeFactor;
         uint32_t                    _maxNumLids;
+        uint32_t                    _maxReadConcurrency;
+        uint32_t                    _maxCompactConcurrency;
+        uint64_t                    _compactMaxBytesPerSecond;
         CompressionConfig           _compactCompression;
         WriteableFileChunk::Config  _fileConfig;
+        size_t                      _compressionDictionaryMaxBytes;
     };
 public:
     using ConstBufferRef = vespalib::ConstBufferRef;
@@ -97,6 +120,8 @@ public:
     // Implements IDataStore API
     ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const override;
     void read(const LidVector & lids, IBufferVisitor & visitor) const override;
+    void prefetch(const LidVector & lids) const override;
+    void sortInReadOrder(LidVector & lids) const override;
     void write(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len) override;
     void remove(uint64_t serialNum, uint32_t lid) override;
     void flush(uint64_t syncToken) override;
@@ -165,6 +190,8 @@ public:
     }
 
     DataStoreStorageStats getStorageStats() const override;
+    DataStoreCompactionStats getCompactionStats() const override;
+    DataStoreCompactionCost getApproxCompactionCost(bool dueToBloat) const override;
     vespalib::MemoryUsage getMemoryUsage() const override;
     std::vector<DataStoreFileChunkStats> getFileChunkStats() const override;
 
@@ -183,9 +210,13 @@ private:
     class FileChunkHolder;
 
     void setLid(const ISetLid::unique_lock & guard, uint32_t lid, const LidInfo & lm) override;
+    // Must be called while holding a generation guard
+    LidInfoWithLidV getOrderedLids(const LidVector & lids) const;
+    void prefetch(const LidInfoWithLidV & orderedLids) const;
 
     void compactWorst(uint64_t syncToken, bool compactDiskBloat);
     void compactFile(FileId chunkId);
+    void trainCompressionDictionary(const docstore::DictionarySampler & sampler, const FileChunk & source);
 
     using LidInfoVector = vespalib::RcuVector<uint64_t>;
     using FileChunkVector = std::vector<FileChunk::UP>;
@@ -242,7 +273,9 @@ private:
         return (_fileChunks.empty() ? 0 : _fileChunks.back()->getLastPersistedSerialNum());
     }
     bool shouldCompactToActiveFile(size_t compactedSize) const;
-    std::pair<bool, FileId> findNextToCompact(bool compactDiskBloat);
+    using CostMap = std::multimap<double, FileId, std::greater<double>>;
+    CostMap rankFilesToCompact(const MonitorGuard & guard, bool dueToBloat) const;
+    std::vector<FileId> findNextToCompact(bool compactDiskBloat);
     void incGeneration();
     bool canShrinkLidSpace(const MonitorGuard &guard) const;
 
@@ -265,6 +298,9 @@ private:
     NameIdSet                                _currentlyCompacting;
     uint64_t                                 _compactLidSpaceGeneration;
     NameId                                   _last_name_id;
+    Chunk::DictionarySP                      _compressionDictionary; // Used for new files, protected by _updateLock
+    docstore::CompactionThrottle             _compactionThrottle;
+    DataStoreCompactionStats                 _compactionStats; // Protected by _updateLock
 };
 
 } // namespace search
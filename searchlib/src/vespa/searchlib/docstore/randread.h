@@ -19,6 +19,11 @@ public:
     virtual ~FileRandRead() = default;
     virtual FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) = 0;
     virtual int64_t getSize() const = 0;
+    /**
+     * Hint that the given range is read soon, so the os can start reading it
+     * into the page cache. The default is to ignore the hint.
+     */
+    virtual void prefetch(size_t offset, size_t sz) { (void) offset; (void) sz; }
 };
 
 }
@@ -4,12 +4,31 @@
 #include "summaryexceptions.h"
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/fastos/file.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".search.docstore.randreaders");
 
 namespace search {
 
+namespace {
+
+void
+adviseWillNeed(const void * mapping, size_t offset, size_t sz)
+{
+    static const size_t pageSize = getpagesize();
+    size_t start = offset & ~(pageSize - 1);
+    void * addr = const_cast<char *>(static_cast<const char *>(mapping) + start);
+    if (madvise(addr, offset + sz - start, MADV_WILLNEED) != 0) {
+        LOG(debug, "madvise(%p, %zu, MADV_WILLNEED) failed with errno %d", addr, offset + sz - start, errno);
+    }
+}
+
+}
+
 DirectIORandRead::DirectIORandRead(const std::string & fileName)
     : _file(std::make_unique<FastOS_File>(fileName.c_str())),
       _alignment(1),
@@ -93,6 +112,14 @@ MMapRandRead::getSize() const {
     return _file->getSize();
 }
 
+void
+MMapRandRead::prefetch(size_t offset, size_t sz)
+{
+    if ((sz > 0) && (_file->MemoryMapPtr(offset + sz - 1) != nullptr)) {
+        adviseWillNeed(_file->MemoryMapPtr(0), offset, sz);
+    }
+}
+
 const void *
 MMapRandRead::getMapping() {
     return _file->MemoryMapPtr(0);
@@ -157,6 +184,15 @@ MMapRandReadDynamic::getSize() const {
     return _holder.get()->getSize();
 }
 
+void
+MMapRandReadDynamic::prefetch(size_t offset, size_t sz)
+{
+    FSP file(_holder.get());
+    if ((sz > 0) && contains(*file, offset + sz)) {
+        adviseWillNeed(file->MemoryMapPtr(0), offset, sz);
+    }
+}
+
 FileRandRead::FSP
 NormalRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
 {
@@ -173,4 +209,15 @@ NormalRandRead::getSize() const
     return _file->getSize();
 }
 
+void
+NormalRandRead::prefetch(size_t offset, size_t sz)
+{
+#ifdef __linux__
+    posix_fadvise(_file->get_fd(), offset, sz, POSIX_FADV_WILLNEED);
+#else
+    (void) offset;
+    (void) sz;
+#endif
+}
+
 }
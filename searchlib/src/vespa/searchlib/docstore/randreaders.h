@@ -31,6 +31,7 @@ public:
     ~MMapRandRead() override;
     FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
     int64_t getSize() const override;
+    void prefetch(size_t offset, size_t sz) override;
     const void * getMapping();
 private:
     std::unique_ptr<FastOS_FileInterface>  _file;
@@ -43,6 +44,7 @@ public:
     ~MMapRandReadDynamic() override;
     FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
     int64_t getSize() const override;
+    void prefetch(size_t offset, size_t sz) override;
 private:
     static bool contains(const FastOS_FileInterface & file, size_t sz);
     void remap(size_t end);
@@ -60,6 +62,7 @@ public:
     ~NormalRandRead() override;
     FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) override;
     int64_t getSize() const override;
+    void prefetch(size_t offset, size_t sz) override;
 private:
     std::unique_ptr<FastOS_FileInterface>  _file;
 };
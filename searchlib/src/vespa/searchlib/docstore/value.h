@@ -47,6 +47,8 @@ public:
     bool empty() const { return size() == 0; }
     operator const void *() const { return get(); }
     const void *get() const;
+    // The buffer is shared by all copies of this value and never modified
+    const std::shared_ptr<Alloc> & shared_buffer() const noexcept { return _buf; }
 private:
     uint64_t                _syncToken;
     uint64_t                _uncompressedCrc;
@@ -116,6 +116,21 @@ CompressedBlobSet::getBlobSet() const
     return BlobSet(_positions, std::move(uncompressed).stealBuffer());
 }
 
+size_t
+CompressedBlobSet::uncompressedSize() const {
+    return getBufferSize(_positions);
+}
+
+bool
+CompressedBlobSet::contains(uint32_t lid) const {
+    for (const auto & pos : _positions) {
+        if (pos.lid() == lid) {
+            return true;
+        }
+    }
+    return false;
+}
+
 size_t
 CompressedBlobSet::bytesAllocated() const {
     return _positions.capacity() * sizeof(BlobSet::Positions::value_type) + _buffer->size();
@@ -163,6 +178,7 @@ public:
     Cache(BackingStore & b, size_t maxBytes);
     ~Cache() override;
     CompressedBlobSet readSet(const KeySet & keys);
+    CompressedBlobSet readCachedSet(uint32_t key);
     void removeKey(uint32_t key);
     vespalib::MemoryUsage getStaticMemoryUsage() const override;
     CacheStats get_stats() const override;
@@ -240,6 +256,22 @@ VisitCache::Cache::readSet(const KeySet & key)
     return CompressedBlobSet();
 }
 
+CompressedBlobSet
+VisitCache::Cache::readCachedSet(uint32_t subKey)
+{
+    KeySet key;
+    {
+        auto cacheGuard = getGuard();
+        const auto foundLid = _lid2Id.find(subKey);
+        if (foundLid == _lid2Id.end()) {
+            return CompressedBlobSet();
+        }
+        key = _id2KeySet[foundLid->second];
+    }
+    // If the set is evicted in the meantime, nothing is read from the backing store.
+    return read(key, BackingStore::CachedOnly());
+}
+
 void
 VisitCache::Cache::locateAndInvalidateOtherSubsets(const UniqueLock & cacheGuard, const KeySet & keys)
 {
@@ -261,6 +293,11 @@ VisitCache::read(const IDocumentStore::LidVector & lids) const {
     return _cache->readSet(KeySet(lids));
 }
 
+CompressedBlobSet
+VisitCache::readCached(uint32_t key) const {
+    return _cache->readCachedSet(key);
+}
+
 void
 VisitCache::remove(uint32_t key) {
     _cache->removeKey(key);
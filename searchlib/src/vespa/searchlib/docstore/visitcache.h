@@ -78,7 +78,9 @@ public:
     CompressedBlobSet & operator=(const CompressedBlobSet & rhs) = default;
     ~CompressedBlobSet();
     size_t bytesAllocated() const;
+    size_t uncompressedSize() const;
     bool empty() const { return _positions.empty(); }
+    bool contains(uint32_t lid) const;
     BlobSet getBlobSet() const;
 private:
     using Alloc = vespalib::alloc::Alloc;
@@ -100,6 +102,11 @@ public:
     ~VisitCache();
 
     CompressedBlobSet read(const IDocumentStore::LidVector & keys) const;
+    /**
+     * Returns the cached set containing the given key, or an empty set if no cached set contains it.
+     * The backing store is never consulted. Used to serve single document reads from visited buckets.
+     */
+    CompressedBlobSet readCached(uint32_t key) const;
     void remove(uint32_t key);
     void invalidate(uint32_t key) { remove(key); }
 
@@ -115,11 +122,14 @@ public:
  */
     class BackingStore {
     public:
+        // Tag used to read only what is already cached
+        struct CachedOnly {};
         BackingStore(IDataStore &store, CompressionConfig compression)
             : _backingStore(store),
               _compression(compression)
         { }
         bool read(const KeySet &key, CompressedBlobSet &blobs) const;
+        bool read(const KeySet &, CompressedBlobSet &, CachedOnly) const { return false; }
         void write(const KeySet &, const CompressedBlobSet &) { }
         void erase(const KeySet &) { }
         void reconfigure(CompressionConfig compression);
@@ -81,7 +81,8 @@ WriteableFileChunk(vespalib::Executor &executor,
                    const Config &config,
                    const TuneFileSummary &tune,
                    const FileHeaderContext &fileHeaderContext,
-                   const IBucketizer * bucketizer)
+                   const IBucketizer * bucketizer,
+                   Chunk::DictionarySP compressionDictionary)
     : FileChunk(fileId, nameId, baseName, tune, bucketizer),
       _config(config),
       _serialNum(initialSerialNum),
@@ -132,7 +133,9 @@ WriteableFileChunk(vespalib::Executor &executor,
         auto idxFile = openIdx();
         readIdxHeader(*idxFile);
         if (_idxHeaderLen == 0) {
-            _idxHeaderLen = writeIdxHeader(fileHeaderContext, _docIdLimit, *idxFile);
+            // A new file uses the given dictionary, an existing file keeps the one in its header
+            _compressionDictionary = std::move(compressionDictionary);
+            _idxHeaderLen = writeIdxHeader(fileHeaderContext, _docIdLimit, *idxFile, _compressionDictionary);
         }
         auto idxFileSize = idxFile->getSize();
         {
@@ -145,6 +148,9 @@ WriteableFileChunk(vespalib::Executor &executor,
     } else {
         throw SummaryException("Failed opening data file", _dataFile, VESPA_STRLOC);
     }
+    if (_compressionDictionary) {
+        _active = std::make_unique<Chunk>(_active->getId(), activeChunkConfig());
+    }
     _firstChunkIdToBeWritten = _active->getId();
     std::lock_guard guard(_lock);
     updateCurrentDiskFootprint(guard);
@@ -184,7 +190,7 @@ WriteableFileChunk::updateLidMap(const unique_lock &guard, ISetLid &ds, uint64_t
 {
     FileChunk::updateLidMap(guard, ds, serialNum, docIdLimit);
     _nextChunkId = _chunkInfo.size();
-    _active = std::make_unique<Chunk>(_nextChunkId++, Chunk::Config(_config.getMaxChunkBytes()));
+    _active = std::make_unique<Chunk>(_nextChunkId++, activeChunkConfig());
     _serialNum = getLastPersistedSerialNum();
     _firstChunkIdToBeWritten = _active->getId();
 }
@@ -674,7 +680,7 @@ int32_t WriteableFileChunk::flushLastIfNonEmpty(bool force)
         chunkId = _active->getId();
         _chunkMap[chunkId] = std::move(_active);
         assert(_nextChunkId < LidInfo::getChunkIdLimit());
-        _active = std::make_unique<Chunk>(_nextChunkId++, Chunk::Config(_config.getMaxChunkBytes()));
+        _active = std::make_unique<Chunk>(_nextChunkId++, activeChunkConfig());
     }
     return chunkId;
 }
@@ -798,6 +804,7 @@ WriteableFileChunk::readIdxHeader(FastOS_FileInterface & idxFile)
         _idxHeaderLen = h.readFile(idxFile);
         idxFile.SetPosition(_idxHeaderLen);
         _docIdLimit = readDocIdLimit(h);
+        _compressionDictionary = readCompressionDictionary(h);
     } catch (IllegalHeaderException &e) {
         idxFile.SetPosition(0);
         try {
@@ -836,7 +843,8 @@ WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext)
 
 
 uint64_t
-WriteableFileChunk::writeIdxHeader(const FileHeaderContext &fileHeaderContext, uint32_t docIdLimit, FastOS_FileInterface &file)
+WriteableFileChunk::writeIdxHeader(const FileHeaderContext &fileHeaderContext, uint32_t docIdLimit, FastOS_FileInterface &file,
+                                   const Chunk::DictionarySP &compressionDictionary)
 {
     using Tag = FileHeader::Tag;
     FileHeader h;
@@ -846,6 +854,7 @@ WriteableFileChunk::writeIdxHeader(const FileHeaderContext &fileHeaderContext, u
     fileHeaderContext.addTags(h, file.GetFileName());
     h.putTag(Tag("desc", "Log data store chunk index"));
     writeDocIdLimit(h, docIdLimit);
+    writeCompressionDictionary(h, compressionDictionary);
     return h.writeFile(file);
 }
 
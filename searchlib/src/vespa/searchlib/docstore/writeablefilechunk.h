@@ -46,7 +46,7 @@ public:
                        const std::string & baseName, uint64_t initialSerialNum,
                        uint32_t docIdLimit, const Config & config,
                        const TuneFileSummary &tune, const common::FileHeaderContext &fileHeaderContext,
-                       const IBucketizer * bucketizer);
+                       const IBucketizer * bucketizer, Chunk::DictionarySP compressionDictionary = {});
     ~WriteableFileChunk() override;
 
     ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const override;
@@ -69,7 +69,8 @@ public:
     void flushPendingChunks(uint64_t serialNum);
     DataStoreFileChunkStats getStats() const override;
 
-    static uint64_t writeIdxHeader(const common::FileHeaderContext &fileHeaderContext, uint32_t docIdLimit, FastOS_FileInterface &file);
+    static uint64_t writeIdxHeader(const common::FileHeaderContext &fileHeaderContext, uint32_t docIdLimit, FastOS_FileInterface &file,
+                                   const Chunk::DictionarySP &compressionDictionary = {});
 private:
     using ProcessedChunkUP = std::unique_ptr<ProcessedChunk>;
     using ProcessedChunkMap = std::map<uint32_t, ProcessedChunkUP >;
@@ -88,6 +89,7 @@ private:
     ProcessedChunkQ drainQ(unique_lock & guard);
     void readDataHeader();
     void readIdxHeader(FastOS_FileInterface & idxFile);
+    Chunk::Config activeChunkConfig() const { return {_config.getMaxChunkBytes(), _compressionDictionary}; }
     void writeDataHeader(const common::FileHeaderContext &fileHeaderContext);
     bool needFlushPendingChunks(uint64_t serialNum, uint64_t datFileLen);
     bool needFlushPendingChunks(const unique_lock & guard, uint64_t serialNum, uint64_t datFileLen);
@@ -4,7 +4,7 @@
 #include <vespa/searchlib/common/mapnames.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/data/slime/binary_format.h>
-#include <vespa/vespalib/data/smart_buffer.h>
+#include <vespa/vespalib/data/output.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <cinttypes>
 
@@ -35,6 +35,27 @@ std::string escape_message(const std::string &item) {
     return r;
 }
 
+// Output appending to a string, used to encode directly into a protobuf field
+class StringOutput : public vespalib::Output {
+private:
+    std::string &_str;
+    size_t       _used;
+public:
+    explicit StringOutput(std::string &str) noexcept : _str(str), _used(0) { _str.clear(); }
+    vespalib::WritableMemory reserve(size_t bytes) override {
+        if (_str.size() < _used + bytes) {
+            _str.resize(std::max(_used + bytes, 2 * _str.size()));
+        }
+        return {_str.data() + _used, _str.size() - _used};
+    }
+    Output &commit(size_t bytes) override {
+        _used += bytes;
+        return *this;
+    }
+    size_t size() const noexcept { return _used; }
+    void finish() { _str.resize(_used); }
+};
+
 template <typename T>
 std::string make_sort_spec(const T &sorting) {
     std::string spec;
@@ -102,6 +123,9 @@ ProtoConverter::search_request_from_proto(const ProtoSearchRequest &proto, Searc
     if (int32_t value = proto.profiling().second_phase().depth(); value != 0) {
         request.trace().second_phase_profile_depth(value);
     }
+    if (proto.profiling().hw_counters()) {
+        request.trace().profile_hw_counters(true);
+    }
     request.sortSpec = make_sort_spec(proto.sorting());
     request.sessionId.assign(proto.session_key().begin(), proto.session_key().end());
     request.propertiesMap.lookupCreate(MapNames::MATCH).add("documentdb.searchdoctype", proto.document_type());
@@ -235,11 +259,14 @@ void
 ProtoConverter::docsum_reply_to_proto(const DocsumReply &reply, ProtoDocsumReply &proto)
 {
     if (reply.hasResult()) {
-        vespalib::SmartBuffer buf(4_Ki);
-        vespalib::slime::BinaryFormat::encode(reply.slime(), buf);
-        if (buf.obtain().size < 2_Gi - 4_Ki) {
-            proto.set_slime_summaries(buf.obtain().data, buf.obtain().size);
+        // Encode directly into the protobuf field to avoid copying large summaries
+        std::string &summaries = *proto.mutable_slime_summaries();
+        StringOutput output(summaries);
+        vespalib::slime::BinaryFormat::encode(reply.slime(), output);
+        if (output.size() < 2_Gi - 4_Ki) {
+            output.finish();
         } else {
+            proto.clear_slime_summaries();
             proto.add_errors()->set_message("Error: DocsumReply too big, > 2GB");
         }
     }
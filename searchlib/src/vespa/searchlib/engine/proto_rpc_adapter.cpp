@@ -4,12 +4,17 @@
 #include "searchapi.h"
 #include "docsumapi.h"
 #include "monitorapi.h"
+#include "query_capture.h"
 #include <vespa/fnet/frt/require_capabilities.h>
 #include <vespa/fnet/frt/rpcrequest.h>
 #include <vespa/fnet/frt/supervisor.h>
+#include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/time.h>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/searchlib/common/packets.h>
+#include <map>
+#include <mutex>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".engine.proto_rpc_adapter");
@@ -27,9 +32,13 @@ using ProtoMonitorRequest = ProtoConverter::ProtoMonitorRequest;
 using ProtoMonitorReply = ProtoConverter::ProtoMonitorReply;
 using QueryStats = SearchProtocolMetrics::QueryStats;
 using DocsumStats = SearchProtocolMetrics::DocsumStats;
+using namespace std::chrono_literals;
 
 namespace {
 
+// for how long the final reply to a search answered with a partial reply is kept if not fetched
+constexpr vespalib::duration final_reply_keep_time = 10s;
+
 CompressionConfig get_compression_config() {
     using search::fs4transport::FS4PersistentPacketStreamer;
     const FS4PersistentPacketStreamer & streamer = FS4PersistentPacketStreamer::Instance;
@@ -39,13 +48,20 @@ CompressionConfig get_compression_config() {
 template <typename MSG>
 void encode_message(const MSG &src, FRT_Values &dst) {
     using vespalib::compression::compress;
-    auto output = src.SerializeAsString();
-    ConstBufferRef buf(output.data(), output.size());
-    DataBuffer compressed(output.data(), output.size());
+    // Serialize into a buffer that is handed over to the rpc layer, avoiding a copy when it is not compressed
+    size_t size = src.ByteSizeLong();
+    auto output = vespalib::alloc::Alloc::alloc(size);
+    src.SerializeWithCachedSizesToArray(static_cast<uint8_t *>(output.get()));
+    ConstBufferRef buf(output.get(), size);
+    DataBuffer compressed(output.get(), size);
     CompressionConfig::Type type = compress(get_compression_config(), buf, compressed, true);
     dst.AddInt8(type);
     dst.AddInt32(buf.size());
-    dst.AddData(compressed.getData(), compressed.getDataLen());
+    if (compressed.referencesExternalData()) {
+        dst.AddData(std::move(output), size);
+    } else {
+        dst.AddData(std::move(compressed));
+    }
 }
 
 void encode_search_reply(const ProtoSearchReply &src, FRT_Values &dst) {
@@ -82,9 +98,10 @@ bool decode_message(const FRT_Values &src, MSG &dst) {
 struct SearchRequestDecoder : SearchRequest::Source::Decoder {
     FRT_RPCRequest &rpc; // valid until Return is called
     QueryStats &stats;
+    SearchClient &client;
     RelativeTime relative_time;
-    SearchRequestDecoder(FRT_RPCRequest &rpc_in, QueryStats &stats_in)
-        : rpc(rpc_in), stats(stats_in), relative_time(std::make_unique<SteadyClock>()) {}
+    SearchRequestDecoder(FRT_RPCRequest &rpc_in, QueryStats &stats_in, SearchClient &client_in)
+        : rpc(rpc_in), stats(stats_in), client(client_in), relative_time(std::make_unique<SteadyClock>()) {}
     std::unique_ptr<SearchRequest> decode() override {
         ProtoSearchRequest msg;
         stats.request_size = (*rpc.GetParams())[2]._data._len;
@@ -94,22 +111,156 @@ struct SearchRequestDecoder : SearchRequest::Source::Decoder {
         }
         auto req = std::make_unique<SearchRequest>(std::move(relative_time));
         ProtoConverter::search_request_from_proto(msg, *req);
+        if (msg.partial_reply()) {
+            stats.partial_reply_requested = true;
+            req->partialReplyClient = &client;
+        }
         return req;
     }
 };
 
-std::unique_ptr<SearchRequest::Source::Decoder> search_request_decoder(FRT_RPCRequest &rpc, QueryStats &stats) {
-    return std::make_unique<SearchRequestDecoder>(rpc, stats);
+std::unique_ptr<SearchRequest::Source::Decoder> search_request_decoder(FRT_RPCRequest &rpc, QueryStats &stats, SearchClient &client) {
+    return std::make_unique<SearchRequestDecoder>(rpc, stats, client);
 }
 
+} // namespace search::engine::<unnamed>
+
+/**
+ * Final replies to searches that were answered early with a partial
+ * reply, kept until fetched. A fetch arriving before the final reply
+ * is ready waits for it.
+ **/
+class FinalSearchReplies {
+private:
+    struct Entry {
+        vespalib::steady_time             expires;
+        FRT_RPCRequest                   *waiting;
+        std::unique_ptr<ProtoSearchReply> reply;
+        QueryStats                        stats;
+        Entry(vespalib::steady_time expires_in) noexcept
+            : expires(expires_in), waiting(nullptr), reply(), stats() {}
+    };
+    SearchProtocolMetrics     &_metrics;
+    std::mutex                 _lock;
+    uint64_t                   _next_id;
+    std::map<uint64_t, Entry>  _entries;
+
+    void deliver(FRT_RPCRequest &req, const ProtoSearchReply &reply, QueryStats stats) {
+        encode_search_reply(reply, *req.GetReturn());
+        stats.reply_size = (*req.GetReturn())[2]._data._len;
+        _metrics.update_query_metrics(stats);
+        req.Return();
+    }
+    // drop final replies nobody came to fetch; must hold the lock
+    void prune(vespalib::steady_time now) {
+        size_t expired = 0;
+        for (auto itr = _entries.begin(); itr != _entries.end();) {
+            if (itr->second.reply && (itr->second.expires < now)) {
+                itr = _entries.erase(itr);
+                ++expired;
+            } else {
+                ++itr;
+            }
+        }
+        if (expired > 0) {
+            _metrics.count_expired_final_replies(expired);
+        }
+    }
+public:
+    explicit FinalSearchReplies(SearchProtocolMetrics &metrics)
+        : _metrics(metrics), _lock(), _next_id(1), _entries() {}
+    ~FinalSearchReplies() {
+        for (auto &entry : _entries) {
+            if (entry.second.waiting != nullptr) {
+                entry.second.waiting->SetError(FRTE_RPC_METHOD_FAILED, "Server shutting down");
+                entry.second.waiting->Return();
+            }
+        }
+    }
+    uint64_t add() {
+        auto now = vespalib::steady_clock::now();
+        std::lock_guard guard(_lock);
+        prune(now);
+        uint64_t id = _next_id++;
+        _entries.emplace(id, Entry(now + final_reply_keep_time));
+        return id;
+    }
+    void complete(uint64_t id, std::unique_ptr<ProtoSearchReply> reply, QueryStats stats) {
+        auto now = vespalib::steady_clock::now();
+        FRT_RPCRequest *waiting = nullptr;
+        {
+            std::lock_guard guard(_lock);
+            auto itr = _entries.find(id);
+            assert(itr != _entries.end());
+            if (itr->second.waiting != nullptr) {
+                waiting = itr->second.waiting;
+                _entries.erase(itr);
+            } else {
+                itr->second.expires = now + final_reply_keep_time;
+                itr->second.reply = std::move(reply);
+                itr->second.stats = stats;
+            }
+        }
+        if (waiting != nullptr) {
+            deliver(*waiting, *reply, stats);
+        }
+    }
+    void fetch(uint64_t id, FRT_RPCRequest &req) {
+        std::unique_ptr<ProtoSearchReply> reply;
+        QueryStats stats;
+        {
+            std::lock_guard guard(_lock);
+            auto itr = _entries.find(id);
+            if ((itr == _entries.end()) || (itr->second.waiting != nullptr)) {
+                req.SetError(FRTE_RPC_METHOD_FAILED, "Unknown or expired final reply id");
+                req.Return();
+                return;
+            }
+            if (!itr->second.reply) {
+                itr->second.waiting = &req;
+                return;
+            }
+            reply = std::move(itr->second.reply);
+            stats = itr->second.stats;
+            _entries.erase(itr);
+        }
+        deliver(req, *reply, stats);
+    }
+};
+
+namespace {
+
 // allocated in the stash of the request it is completing; no self-delete needed
 struct SearchCompletionHandler : SearchClient {
     FRT_RPCRequest &req;
     SearchProtocolMetrics &metrics;
+    FinalSearchReplies &final_replies;
     QueryStats stats;
-    SearchCompletionHandler(FRT_RPCRequest &req_in, SearchProtocolMetrics &metrics_in)
-        : req(req_in), metrics(metrics_in), stats() {}
+    uint64_t final_reply_id;
+    SearchCompletionHandler(FRT_RPCRequest &req_in, SearchProtocolMetrics &metrics_in, FinalSearchReplies &final_replies_in)
+        : req(req_in), metrics(metrics_in), final_replies(final_replies_in), stats(), final_reply_id(0) {}
+    void searchPartial(SearchReply::UP reply) override {
+        ProtoSearchReply msg;
+        ProtoConverter::search_reply_to_proto(*reply, msg);
+        final_reply_id = final_replies.add();
+        msg.set_partial(true);
+        msg.set_final_reply_id(final_reply_id);
+        encode_search_reply(msg, *req.GetReturn());
+        stats.partial_reply_sent = true;
+        req.internal_addref(); // keeps this handler alive until the final reply is done
+        req.Return();
+    }
     void searchDone(SearchReply::UP reply) override {
+        if (final_reply_id != 0) {
+            auto msg = std::make_unique<ProtoSearchReply>();
+            ProtoConverter::search_reply_to_proto(*reply, *msg);
+            if (reply->request) {
+                stats.latency = vespalib::to_s(reply->request->getTimeUsed());
+            }
+            final_replies.complete(final_reply_id, std::move(msg), stats);
+            req.internal_subref(); // may destruct this handler
+            return;
+        }
         ProtoSearchReply msg;
         ProtoConverter::search_reply_to_proto(*reply, msg);
         encode_search_reply(msg, *req.GetReturn());
@@ -193,6 +344,12 @@ void describe_bix_param_return(FRT_ReflectionBuilder &rb) {
     rb.ReturnDesc("reply", "possibly compressed serialized reply");
 }
 
+void capture_request(QueryCapture &capture, QueryCapture::Kind kind, FRT_RPCRequest &req) {
+    const FRT_Values &params = *req.GetParams();
+    capture.add(kind, vespalib::system_clock::now(), params[0]._intval8, params[1]._intval32,
+                params[2]._data._buf, params[2]._data._len);
+}
+
 std::unique_ptr<FRT_RequireCapabilities> make_search_api_capability_filter() {
     return FRT_RequireCapabilities::of(vespalib::net::tls::Capability::content_search_api());
 }
@@ -207,7 +364,9 @@ ProtoRpcAdapter::ProtoRpcAdapter(SearchServer &search_server,
       _docsum_server(docsum_server),
       _monitor_server(monitor_server),
       _online(false),
-      _metrics()
+      _metrics(),
+      _final_replies(std::make_unique<FinalSearchReplies>(_metrics)),
+      _query_capture()
 {
     FRT_ReflectionBuilder rb(&orb);
     //-------------------------------------------------------------------------
@@ -215,8 +374,19 @@ ProtoRpcAdapter::ProtoRpcAdapter(SearchServer &search_server,
                     FRT_METHOD(ProtoRpcAdapter::rpc_search), this);
     rb.MethodDesc("perform a search against this back-end");
     rb.RequestAccessFilter(make_search_api_capability_filter());
+    rb.MethodPriority(fnet::Priority::HIGH);
     describe_bix_param_return(rb);
     //-------------------------------------------------------------------------
+    rb.DefineMethod("vespa.searchprotocol.getFinalSearchReply", "l", "bix",
+                    FRT_METHOD(ProtoRpcAdapter::rpc_getFinalSearchReply), this);
+    rb.MethodDesc("fetch the final reply to a search answered with a partial reply");
+    rb.RequestAccessFilter(make_search_api_capability_filter());
+    rb.MethodPriority(fnet::Priority::HIGH);
+    rb.ParamDesc("final_reply_id", "id given in the partial reply");
+    rb.ReturnDesc("encoding",  "0=raw, 6=lz4, 7=zstd");
+    rb.ReturnDesc("uncompressed_size", "uncompressed size of serialized reply");
+    rb.ReturnDesc("reply", "possibly compressed serialized reply");
+    //-------------------------------------------------------------------------
     rb.DefineMethod("vespa.searchprotocol.getDocsums", "bix", "bix",
                     FRT_METHOD(ProtoRpcAdapter::rpc_getDocsums), this);
     rb.MethodDesc("fetch document summaries from this back-end");
@@ -227,30 +397,52 @@ ProtoRpcAdapter::ProtoRpcAdapter(SearchServer &search_server,
                     FRT_METHOD(ProtoRpcAdapter::rpc_ping), this);
     rb.MethodDesc("ping this back-end");
     rb.RequestAccessFilter(make_search_api_capability_filter());
+    rb.MethodPriority(fnet::Priority::HIGH);
     describe_bix_param_return(rb);
     //-------------------------------------------------------------------------
 }
 
+ProtoRpcAdapter::~ProtoRpcAdapter() = default;
+
+void
+ProtoRpcAdapter::set_query_capture(std::unique_ptr<QueryCapture> query_capture)
+{
+    _query_capture = std::move(query_capture);
+}
+
 void
 ProtoRpcAdapter::rpc_search(FRT_RPCRequest *req)
 {
     if (!is_online()) {
         return req->SetError(FRTE_RPC_METHOD_FAILED, "Server not online");
     }
+    if (_query_capture && _query_capture->sample()) {
+        capture_request(*_query_capture, QueryCapture::Kind::SEARCH, *req);
+    }
     req->Detach();
-    auto &client = req->getStash().create<SearchCompletionHandler>(*req, _metrics);
-    auto reply = _search_server.search(search_request_decoder(*req, client.stats), client);
+    auto &client = req->getStash().create<SearchCompletionHandler>(*req, _metrics, *_final_replies);
+    auto reply = _search_server.search(search_request_decoder(*req, client.stats, client), client);
     if (reply) {
         client.searchDone(std::move(reply));
     }
 }
 
+void
+ProtoRpcAdapter::rpc_getFinalSearchReply(FRT_RPCRequest *req)
+{
+    req->Detach();
+    _final_replies->fetch((*req->GetParams())[0]._intval64, *req);
+}
+
 void
 ProtoRpcAdapter::rpc_getDocsums(FRT_RPCRequest *req)
 {
     if (!is_online()) {
         return req->SetError(FRTE_RPC_METHOD_FAILED, "Server not online");
     }
+    if (_query_capture && _query_capture->sample()) {
+        capture_request(*_query_capture, QueryCapture::Kind::DOCSUM, *req);
+    }
     req->Detach();
     auto &client = req->getStash().create<GetDocsumsCompletionHandler>(*req, _metrics);
     auto reply = _docsum_server.getDocsums(docsum_request_decoder(*req, client.stats), client);
@@ -297,6 +489,13 @@ ProtoRpcAdapter::decode_search_reply(FRT_RPCRequest &src, ProtoSearchReply &dst)
     return (src.CheckReturnTypes("bix") && decode_message(*src.GetReturn(), dst));
 }
 
+void
+ProtoRpcAdapter::encode_final_search_reply_request(uint64_t final_reply_id, FRT_RPCRequest &dst)
+{
+    dst.SetMethodName("vespa.searchprotocol.getFinalSearchReply");
+    dst.GetParams()->AddInt64(final_reply_id);
+}
+
 void
 ProtoRpcAdapter::encode_docsum_request(const ProtoDocsumRequest &src, FRT_RPCRequest &dst)
 {
@@ -323,4 +522,16 @@ ProtoRpcAdapter::decode_monitor_reply(FRT_RPCRequest &src, ProtoMonitorReply &ds
     return (src.CheckReturnTypes("bix") && decode_message(*src.GetReturn(), dst));
 }
 
+void
+ProtoRpcAdapter::encode_captured_request(const QueryCaptureRecord &src, FRT_RPCRequest &dst)
+{
+    dst.SetMethodName((src.kind == QueryCaptureKind::SEARCH)
+                      ? "vespa.searchprotocol.search"
+                      : "vespa.searchprotocol.getDocsums");
+    FRT_Values &params = *dst.GetParams();
+    params.AddInt8(src.encoding);
+    params.AddInt32(src.uncompressed_size);
+    params.AddData(src.blob.data(), src.blob.size());
+}
+
 }
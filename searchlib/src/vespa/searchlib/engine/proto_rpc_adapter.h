@@ -5,6 +5,7 @@
 #include <vespa/fnet/frt/invokable.h>
 #include "proto_converter.h"
 #include <atomic>
+#include <memory>
 
 #include "search_protocol_metrics.h"
 
@@ -15,11 +16,21 @@ namespace search::engine {
 class SearchServer;
 class DocsumServer;
 class MonitorServer;
+class FinalSearchReplies;
+class QueryCapture;
+struct QueryCaptureRecord;
 
 /**
  * Class adapting the internal search engine interfaces (SearchServer,
  * DocsumServer, MonitorServer) to the external searchprotocol api
  * (possibly compressed protobuf over frt rpc).
+ *
+ * A search request may accept an early partial reply. The rpc is then
+ * answered with the partial reply as soon as it is available, and the
+ * final reply superseding it is fetched with a separate rpc.
+ *
+ * Search and docsum requests may optionally be sampled into a
+ * QueryCapture to be replayed against another back-end later.
  **/
 class ProtoRpcAdapter : FRT_Invokable
 {
@@ -36,24 +47,32 @@ private:
     MonitorServer  &_monitor_server;
     std::atomic<bool> _online;
     SearchProtocolMetrics _metrics;
+    std::unique_ptr<FinalSearchReplies> _final_replies;
+    std::unique_ptr<QueryCapture> _query_capture;
 public:
     ProtoRpcAdapter(SearchServer &search_server,
                     DocsumServer &docsum_server,
                     MonitorServer &monitor_server,
                     FRT_Supervisor &orb);
+    ~ProtoRpcAdapter();
 
     SearchProtocolMetrics &metrics() { return _metrics; }
 
     void set_online() { _online.store(true, std::memory_order_release); }
     bool is_online() const { return _online.load(std::memory_order_acquire); }
 
+    // must be called before going online
+    void set_query_capture(std::unique_ptr<QueryCapture> query_capture);
+
     void rpc_search(FRT_RPCRequest *req);
+    void rpc_getFinalSearchReply(FRT_RPCRequest *req);
     void rpc_getDocsums(FRT_RPCRequest *req);
     void rpc_ping(FRT_RPCRequest *req);
 
     // convenience functions used for testing
     static void encode_search_request(const ProtoSearchRequest &src, FRT_RPCRequest &dst);
     static bool decode_search_reply(FRT_RPCRequest &src, ProtoSearchReply &dst);
+    static void encode_final_search_reply_request(uint64_t final_reply_id, FRT_RPCRequest &dst);
 
     static void encode_docsum_request(const ProtoDocsumRequest &src, FRT_RPCRequest &dst);
     static bool decode_docsum_reply(FRT_RPCRequest &src, ProtoDocsumReply &dst);
@@ -61,6 +80,9 @@ public:
     static void encode_monitor_request(const ProtoMonitorRequest &src, FRT_RPCRequest &dst);
     static bool decode_monitor_reply(FRT_RPCRequest &src, ProtoMonitorReply &dst);
 
+    // re-issue a request exactly as it was captured by a QueryCapture
+    static void encode_captured_request(const QueryCaptureRecord &src, FRT_RPCRequest &dst);
+
 };
 
 }
@@ -0,0 +1,195 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "query_capture.h"
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <algorithm>
+#include <cinttypes>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".engine.query_capture");
+
+namespace search::engine {
+
+using vespalib::IllegalArgumentException;
+using vespalib::nbostream;
+
+namespace {
+
+constexpr uint32_t capture_magic = 0x56514350; // "VQCP"
+constexpr uint32_t capture_version = 1;
+constexpr uint8_t end_marker_kind = 0;
+
+/*
+ * File layout (network byte order):
+ *
+ * header: magic(4) version(4) capacity(8) oldest_pos(8) count(8)
+ * record: len(4) kind(1) encoding(1) reserved(2) uncompressed_size(4) timestamp_ns(8) blob(len)
+ *
+ * A record with kind 0 marks that the rest of the file is unused and
+ * that reading continues right after the header. The same applies if
+ * there is no room for a record header before the end of the file.
+ */
+void serialize_record_header(nbostream &os, uint32_t len, uint8_t kind, uint8_t encoding,
+                             uint32_t uncompressed_size, int64_t timestamp_ns)
+{
+    os << len << kind << encoding << uint16_t(0) << uncompressed_size << timestamp_ns;
+}
+
+}
+
+QueryCaptureRecord::QueryCaptureRecord() noexcept
+    : kind(QueryCaptureKind::SEARCH),
+      timestamp_ns(0),
+      encoding(0),
+      uncompressed_size(0),
+      blob()
+{
+}
+
+QueryCaptureRecord::QueryCaptureRecord(QueryCaptureRecord &&) noexcept = default;
+QueryCaptureRecord::~QueryCaptureRecord() = default;
+
+QueryCapture::QueryCapture(const std::string &file_name, uint64_t max_file_size, uint32_t sample_interval)
+    : _seq(0),
+      _sample_interval(std::max(sample_interval, 1u)),
+      _lock(),
+      _file(file_name),
+      _capacity(std::max(max_file_size, uint64_t(header_size + record_header_size))),
+      _write_pos(header_size),
+      _live(),
+      _captured(0),
+      _failed(false)
+{
+    try {
+        _file.open(vespalib::File::CREATE | vespalib::File::TRUNC, true);
+        write_header();
+        LOG(info, "capturing every %u. search protocol request to '%s' (max %" PRIu64 " bytes)",
+            _sample_interval, file_name.c_str(), _capacity);
+    } catch (vespalib::IoException &e) {
+        LOG(warning, "unable to open query capture file '%s', capture disabled: %s",
+            file_name.c_str(), e.getMessage().c_str());
+        _failed = true;
+    }
+}
+
+QueryCapture::~QueryCapture() = default;
+
+void
+QueryCapture::write_header()
+{
+    nbostream os(header_size);
+    os << capture_magic << capture_version << _capacity
+       << (_live.empty() ? _write_pos : _live.front()) << uint64_t(_live.size());
+    _file.write(os.data(), os.size(), 0);
+}
+
+void
+QueryCapture::write_end_marker()
+{
+    if (_capacity - _write_pos >= record_header_size) {
+        nbostream os(record_header_size);
+        serialize_record_header(os, 0, end_marker_kind, 0, 0, 0);
+        _file.write(os.data(), os.size(), _write_pos);
+    }
+}
+
+void
+QueryCapture::add(Kind kind, vespalib::system_time received, uint8_t encoding,
+                  uint32_t uncompressed_size, const char *data, size_t len)
+{
+    uint64_t need = record_header_size + len;
+    if (need > _capacity - header_size) {
+        return; // would not fit even in an empty file
+    }
+    int64_t timestamp_ns = vespalib::count_ns(received.time_since_epoch());
+    nbostream os(need);
+    serialize_record_header(os, len, static_cast<uint8_t>(kind), encoding, uncompressed_size, timestamp_ns);
+    os.write(data, len);
+    std::lock_guard guard(_lock);
+    if (_failed) {
+        return;
+    }
+    try {
+        if (_write_pos + need > _capacity) {
+            // records from the previous lap beyond this point can no longer be reached
+            write_end_marker();
+            while (!_live.empty() && _live.front() >= _write_pos) {
+                _live.pop_front();
+            }
+            _write_pos = header_size;
+        }
+        while (!_live.empty() && _live.front() >= _write_pos && _live.front() < _write_pos + need) {
+            _live.pop_front();
+        }
+        _file.write(os.data(), os.size(), _write_pos);
+        _live.push_back(_write_pos);
+        _write_pos += need;
+        write_header();
+        ++_captured;
+    } catch (vespalib::IoException &e) {
+        LOG(warning, "failed writing to query capture file '%s', capture disabled: %s",
+            _file.getFilename().c_str(), e.getMessage().c_str());
+        _failed = true;
+    }
+}
+
+uint64_t
+QueryCapture::captured() const
+{
+    std::lock_guard guard(_lock);
+    return _captured;
+}
+
+std::vector<QueryCapture::Record>
+QueryCapture::read(const std::string &file_name)
+{
+    std::string content = vespalib::File::readAll(file_name);
+    if (content.size() < header_size) {
+        throw IllegalArgumentException("'" + file_name + "' is too small to be a query capture file");
+    }
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t capacity = 0;
+    uint64_t pos = 0;
+    uint64_t count = 0;
+    nbostream header(content.data(), header_size);
+    header >> magic >> version >> capacity >> pos >> count;
+    if (magic != capture_magic || version != capture_version) {
+        throw IllegalArgumentException("'" + file_name + "' is not a query capture file");
+    }
+    uint64_t end = std::min(capacity, uint64_t(content.size()));
+    std::vector<Record> result;
+    result.reserve(count);
+    while (result.size() < count) {
+        if (pos + record_header_size > end) {
+            pos = header_size;
+        }
+        if (pos + record_header_size > end) {
+            throw IllegalArgumentException("'" + file_name + "' is truncated");
+        }
+        uint32_t len = 0;
+        uint8_t kind = 0;
+        uint16_t reserved = 0;
+        Record record;
+        nbostream is(content.data() + pos, record_header_size);
+        is >> len >> kind >> record.encoding >> reserved >> record.uncompressed_size >> record.timestamp_ns;
+        if (kind == end_marker_kind) {
+            if (pos == header_size) {
+                throw IllegalArgumentException("'" + file_name + "' has no records after the header");
+            }
+            pos = header_size;
+            continue;
+        }
+        if (pos + record_header_size + len > end) {
+            throw IllegalArgumentException("'" + file_name + "' has a record extending beyond the end of the file");
+        }
+        record.kind = static_cast<Kind>(kind);
+        record.blob.assign(content.data() + pos + record_header_size, len);
+        pos += record_header_size + len;
+        result.push_back(std::move(record));
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,93 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/time.h>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace search::engine {
+
+enum class QueryCaptureKind : uint8_t { SEARCH = 1, DOCSUM = 2 };
+
+/**
+ * A single captured request, see QueryCapture.
+ **/
+struct QueryCaptureRecord {
+    QueryCaptureKind kind;
+    int64_t          timestamp_ns; // system clock, when received
+    uint8_t          encoding;
+    uint32_t         uncompressed_size;
+    std::string      blob;
+    QueryCaptureRecord() noexcept;
+    QueryCaptureRecord(QueryCaptureRecord &&) noexcept;
+    ~QueryCaptureRecord();
+};
+
+/**
+ * Sampled capture of the search protocol requests received by a
+ * back-end, used to replay actual query traffic against a test
+ * instance (see vespa-search-replay).
+ *
+ * Every n'th search and docsum request is written to a ring file of
+ * fixed size exactly as it was received over rpc (encoding,
+ * uncompressed size and possibly compressed serialized protobuf),
+ * together with the system time it was received. When the file is
+ * full, the oldest records are overwritten. The file header tracks
+ * the position of the oldest record and the number of live records,
+ * so the capture can be read after the back-end has stopped.
+ *
+ * Write errors are logged once and disable the capture; they never
+ * affect the request being served.
+ **/
+class QueryCapture
+{
+public:
+    using Kind = QueryCaptureKind;
+    using Record = QueryCaptureRecord;
+
+    static constexpr uint32_t header_size = 32;
+    static constexpr uint32_t record_header_size = 20;
+
+private:
+    std::atomic<uint64_t> _seq;
+    uint32_t              _sample_interval;
+    mutable std::mutex    _lock;
+    vespalib::File        _file;
+    uint64_t              _capacity;
+    uint64_t              _write_pos;
+    std::deque<uint64_t>  _live; // file position of live records, oldest first
+    uint64_t              _captured;
+    bool                  _failed;
+
+    void write_header();
+    void write_end_marker();
+public:
+    QueryCapture(const std::string &file_name, uint64_t max_file_size, uint32_t sample_interval);
+    ~QueryCapture();
+
+    // whether the next request should be captured; cheap enough to call for every request
+    bool sample() noexcept {
+        return (_seq.fetch_add(1, std::memory_order_relaxed) % _sample_interval) == 0;
+    }
+
+    void add(Kind kind, vespalib::system_time received, uint8_t encoding,
+             uint32_t uncompressed_size, const char *data, size_t len);
+
+    uint64_t captured() const;
+
+    /**
+     * Read all live records in a capture file, oldest first. Throws
+     * vespalib::IllegalArgumentException if the file is not a valid
+     * capture file.
+     **/
+    static std::vector<Record> read(const std::string &file_name);
+};
+
+}
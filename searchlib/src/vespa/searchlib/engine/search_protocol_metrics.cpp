@@ -8,7 +8,10 @@ SearchProtocolMetrics::QueryMetrics::QueryMetrics(metrics::MetricSet *parent)
     : metrics::MetricSet("query", {}, "Query metrics", parent),
       latency("latency", {{"logdefault"}}, "Query request latency (seconds)", this),
       request_size("request_size", {{"logdefault"}}, "Query request size (network bytes)", this),
-      reply_size("reply_size", {{"logdefault"}}, "Query reply size (network bytes)", this)
+      reply_size("reply_size", {{"logdefault"}}, "Query reply size (network bytes)", this),
+      partial_reply_requested("partial_reply_requested", {}, "Queries accepting an early partial reply", this),
+      partial_replies("partial_replies", {}, "Queries answered with an early partial reply before the final reply", this),
+      final_replies_expired("final_replies_expired", {}, "Final replies dropped since they were not fetched in time", this)
 {
 }
 SearchProtocolMetrics::QueryMetrics::~QueryMetrics() = default;
@@ -40,6 +43,12 @@ SearchProtocolMetrics::update_query_metrics(const QueryStats &stats)
     _query.latency.set(stats.latency);
     _query.request_size.set(stats.request_size);
     _query.reply_size.set(stats.reply_size);
+    if (stats.partial_reply_requested) {
+        _query.partial_reply_requested.inc();
+    }
+    if (stats.partial_reply_sent) {
+        _query.partial_replies.inc();
+    }
 }
 
 void
@@ -52,4 +61,11 @@ SearchProtocolMetrics::update_docsum_metrics(const DocsumStats &stats)
     _docsum.requested_documents.inc(stats.requested_documents);
 }
 
+void
+SearchProtocolMetrics::count_expired_final_replies(size_t count)
+{
+    auto guard = std::lock_guard(_lock);
+    _query.final_replies_expired.inc(count);
+}
+
 }
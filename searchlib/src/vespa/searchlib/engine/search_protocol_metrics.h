@@ -21,6 +21,9 @@ public:
         metrics::DoubleAverageMetric latency;
         metrics::LongAverageMetric   request_size;
         metrics::LongAverageMetric   reply_size;
+        metrics::LongCountMetric     partial_reply_requested;
+        metrics::LongCountMetric     partial_replies;
+        metrics::LongCountMetric     final_replies_expired;
 
         QueryMetrics(metrics::MetricSet *parent);
         ~QueryMetrics() override;
@@ -31,7 +34,9 @@ public:
         double latency;
         size_t request_size;
         size_t reply_size;
-        QueryStats() : latency(0.0), request_size(0), reply_size(0) {}
+        bool   partial_reply_requested;
+        bool   partial_reply_sent;
+        QueryStats() : latency(0.0), request_size(0), reply_size(0), partial_reply_requested(false), partial_reply_sent(false) {}
     };
 
     // sub-metrics for docsum request/reply
@@ -68,6 +73,7 @@ public:
 
     void update_query_metrics(const QueryStats &stats);
     void update_docsum_metrics(const DocsumStats &stats);
+    void count_expired_final_replies(size_t count);
 };
 
 }
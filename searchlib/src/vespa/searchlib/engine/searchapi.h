@@ -22,6 +22,18 @@ public:
      **/
     virtual void searchDone(SearchReply::UP reply) = 0;
 
+    /**
+     * Invoked by the search server with early results for a request
+     * that accepts partial replies (see
+     * SearchRequest::partialReplyClient). The partial reply holds the
+     * best hits so far, and is always followed by a call to
+     * searchDone with the final reply superseding it. At most one
+     * partial reply is given per request.
+     *
+     * @param reply the partial search reply
+     **/
+    virtual void searchPartial(SearchReply::UP reply) { (void) reply; }
+
     /**
      * Empty, needed for subclassing
      **/
@@ -12,7 +12,8 @@ SearchRequest::SearchRequest(RelativeTime relativeTime)
       offset(0),
       maxhits(10),
       sortSpec(),
-      groupSpec()
+      groupSpec(),
+      partialReplyClient(nullptr)
 {
 }
 
@@ -8,6 +8,8 @@
 
 namespace search::engine {
 
+class SearchClient;
+
 class SearchRequest : public Request
 {
 public:
@@ -19,6 +21,8 @@ public:
     uint32_t          maxhits;
     std::string  sortSpec;
     std::vector<char> groupSpec;
+    // set when the client accepts an early partial reply before the final one
+    SearchClient     *partialReplyClient;
 
     SearchRequest();
     explicit SearchRequest(RelativeTime relativeTime);
@@ -75,7 +75,8 @@ Trace::Trace(const Trace &parent, ctor_tag)
       _level(parent._level),
       _match_profile_depth(parent._match_profile_depth),
       _first_phase_profile_depth(parent._first_phase_profile_depth),
-      _second_phase_profile_depth(parent._second_phase_profile_depth)
+      _second_phase_profile_depth(parent._second_phase_profile_depth),
+      _profile_hw_counters(parent._profile_hw_counters)
 {
 }
 
@@ -87,7 +88,8 @@ Trace::Trace(const RelativeTime & relativeTime, uint32_t level)
       _level(level),
       _match_profile_depth(0),
       _first_phase_profile_depth(0),
-      _second_phase_profile_depth(0)
+      _second_phase_profile_depth(0),
+      _profile_hw_counters(false)
 {
 }
 
@@ -131,6 +131,9 @@ public:
     int32_t match_profile_depth() const { return _match_profile_depth; }
     int32_t first_phase_profile_depth() const { return _first_phase_profile_depth; }
     int32_t second_phase_profile_depth() const { return _second_phase_profile_depth; }
+    // also sample hardware performance counters when profiling
+    Trace &profile_hw_counters(bool value) { _profile_hw_counters = value; return *this; }
+    bool profile_hw_counters() const { return _profile_hw_counters; }
     Trace make_trace() const { return Trace(*this, ctor_tag()); }
     std::unique_ptr<Trace> make_trace_up() const { return std::make_unique<Trace>(*this, ctor_tag()); }
     LazyTraceInserter make_inserter(vespalib::StaticStringView name) { return {*this, name}; }
@@ -164,6 +167,7 @@ private:
     int32_t               _match_profile_depth;
     int32_t               _first_phase_profile_depth;
     int32_t               _second_phase_profile_depth;
+    bool                  _profile_hw_counters;
 };
 
 }
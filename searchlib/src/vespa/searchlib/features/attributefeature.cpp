@@ -6,6 +6,7 @@
 #include "constant_tensor_executor.h"
 #include "dense_tensor_attribute_executor.h"
 #include "direct_tensor_attribute_executor.h"
+#include "serialized_tensor_attribute_executor.h"
 #include "tensor_attribute_executor.h"
 
 #include <vespa/searchcommon/common/undefinedvalues.h>
@@ -13,6 +14,7 @@
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
 #include <vespa/searchlib/tensor/direct_tensor_attribute.h>
 #include <vespa/searchlib/fef/indexproperties.h>
+#include <vespa/searchlib/attribute/imported_attribute_vector_read_guard.h>
 #include <vespa/searchlib/attribute/singlenumericattribute.h>
 #include <vespa/searchlib/attribute/multinumericattribute.h>
 #include <vespa/vespalib/util/issue.h>
@@ -21,6 +23,7 @@
 LOG_SETUP(".features.attributefeature");
 
 using search::attribute::IAttributeVector;
+using search::attribute::ImportedAttributeVectorReadGuard;
 using search::attribute::BasicType;
 using search::attribute::CollectionType;
 using search::attribute::ConstCharContent;
@@ -99,20 +102,36 @@ considerUndefined<ConstCharPtr>(ConstCharPtr value, BasicType::Type )
     return util::getAsFeature(value);
 }
 
+struct DirectLid {
+    uint32_t operator()(uint32_t docId) const noexcept { return docId; }
+};
+
+/**
+ * Maps to the lid in the target attribute of an imported attribute
+ * using the lid mapping maintained by the reference attribute.
+ */
+struct ImportedLid {
+    const ImportedAttributeVectorReadGuard & _imported;
+    uint32_t operator()(uint32_t docId) const noexcept { return _imported.getTargetLid(docId); }
+};
+
 /**
  * Implements the executor for fetching values from a single or array attribute vector
  */
-template <typename T>
+template <typename T, typename LidMapper = DirectLid>
 class SingleAttributeExecutor final : public fef::FeatureExecutor {
 private:
     const T & _attribute;
+    LidMapper _lid_mapper;
 public:
     /**
      * Constructs an executor.
      *
      * @param attribute The attribute vector to use.
+     * @param lid_mapper Maps from docid to the lid used in the attribute vector.
      */
-    explicit SingleAttributeExecutor(const T & attribute) : _attribute(attribute) { }
+    explicit SingleAttributeExecutor(const T & attribute, LidMapper lid_mapper = LidMapper())
+        : _attribute(attribute), _lid_mapper(lid_mapper) { }
     void handle_bind_outputs(std::span<fef::NumberOrObject> outputs_in) override {
         fef::FeatureExecutor::handle_bind_outputs(outputs_in);
         auto o = outputs().get_bound();
@@ -121,6 +140,10 @@ public:
         o[3].as_number = 1;  // count
     }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(std::span<const uint32_t> docids,
+                       std::span<const feature_t * const> inputs,
+                       std::span<feature_t * const> outputs) override;
 };
 
 class BoolAttributeExecutor final : public fef::FeatureExecutor {
@@ -133,6 +156,15 @@ public:
     void execute(uint32_t docId) override {
         outputs().set_number(0, _attribute.getFloat(docId));
     }
+    bool supports_batch() const override { return true; }
+    void execute_batch(std::span<const uint32_t> docids,
+                       std::span<const feature_t * const>,
+                       std::span<feature_t * const> outputs) override
+    {
+        for (size_t i = 0; i < docids.size(); ++i) {
+            outputs[0][i] = _attribute.getFloat(docids[i]);
+        }
+    }
 };
 
 /**
@@ -224,11 +256,11 @@ public:
     void execute(uint32_t docId) override;
 };
 
-template <typename T>
+template <typename T, typename LidMapper>
 void
-SingleAttributeExecutor<T>::execute(uint32_t docId)
+SingleAttributeExecutor<T, LidMapper>::execute(uint32_t docId)
 {
-    typename T::LoadedValueType v = _attribute.getFast(docId);
+    typename T::LoadedValueType v = _attribute.getFast(_lid_mapper(docId));
     // value
     auto o = outputs().get_bound();
     o[0].as_number = __builtin_expect(attribute::isUndefined(v), false)
@@ -236,6 +268,23 @@ SingleAttributeExecutor<T>::execute(uint32_t docId)
                      : util::getAsFeature(v);
 }
 
+template <typename T, typename LidMapper>
+void
+SingleAttributeExecutor<T, LidMapper>::execute_batch(std::span<const uint32_t> docids,
+                                                     std::span<const feature_t * const>,
+                                                     std::span<feature_t * const> o)
+{
+    for (size_t i = 0; i < docids.size(); ++i) {
+        typename T::LoadedValueType v = _attribute.getFast(_lid_mapper(docids[i]));
+        o[0][i] = __builtin_expect(attribute::isUndefined(v), false)
+                  ? attribute::getUndefined<feature_t>()
+                  : util::getAsFeature(v);
+    }
+    std::fill(o[1], o[1] + docids.size(), 0.0); // weight
+    std::fill(o[2], o[2] + docids.size(), 0.0); // contains
+    std::fill(o[3], o[3] + docids.size(), 1.0); // count
+}
+
 template <typename BaseType>
 void
 ArrayAttributeExecutor<BaseType>::execute(uint32_t docId)
@@ -316,16 +365,27 @@ struct SingleValueExecutorCreator {
     using AttrType = SingleValueNumericAttribute<T>;
     using PtrType = const AttrType *;
     using ExecType = SingleAttributeExecutor<AttrType>;
-    SingleValueExecutorCreator() : ptr(nullptr) {}
+    using ImportedExecType = SingleAttributeExecutor<AttrType, ImportedLid>;
+    SingleValueExecutorCreator() : ptr(nullptr), imported(nullptr) {}
     bool handle(const IAttributeVector *attribute) {
-        ptr = dynamic_cast<PtrType>(attribute);
+        if (attribute->isImported()) {
+            // Read directly from the target attribute, one lid mapping lookup per document
+            imported = dynamic_cast<const ImportedAttributeVectorReadGuard *>(attribute);
+            ptr = (imported != nullptr) ? dynamic_cast<PtrType>(&imported->target_attribute()) : nullptr;
+        } else {
+            ptr = dynamic_cast<PtrType>(attribute);
+        }
         return ptr != nullptr;
     }
     fef::FeatureExecutor & create(vespalib::Stash &stash) const {
+        if (imported != nullptr) {
+            return stash.create<ImportedExecType>(*ptr, ImportedLid{*imported});
+        }
         return stash.create<ExecType>(*ptr);
     }
 private:
     PtrType ptr;
+    const ImportedAttributeVectorReadGuard *imported;
 };
 
 template <typename T>
@@ -469,6 +529,9 @@ createTensorAttributeExecutor(const IAttributeVector *attribute, const std::stri
     if (tensorAttribute->supports_get_tensor_ref()) {
         return stash.create<DirectTensorAttributeExecutor>(*tensorAttribute);
     }
+    if (tensorAttribute->supports_get_serialized_tensor_ref()) {
+        return stash.create<SerializedTensorAttributeExecutor>(*tensorAttribute);
+    }
     return stash.create<TensorAttributeExecutor>(*tensorAttribute);
 }
 
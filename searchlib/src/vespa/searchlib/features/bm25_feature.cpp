@@ -30,8 +30,7 @@ Bm25Executor::Bm25Executor(const fef::FieldInfo& field,
                            double b_param)
     : FeatureExecutor(),
       _terms(),
-      _avg_field_length(avg_field_length),
-      _k1_mul_b(k1_param * b_param),
+      _k1_mul_b_div_avg_field_length((k1_param * b_param) / avg_field_length),
       _k1_mul_one_minus_b(k1_param * (1 - b_param))
 {
     for (size_t i = 0; i < env.getNumTerms(); ++i) {
@@ -60,16 +59,16 @@ Bm25Executor::execute(uint32_t doc_id)
 {
     feature_t score = 0;
     for (const auto& term : _terms) {
-        if (term.tfmd->getDocId() == doc_id) {
-            auto raw_num_occs = term.tfmd->getNumOccs();
+        const auto* tfmd = term.tfmd;
+        if (tfmd->getDocId() == doc_id) {
+            auto raw_num_occs = tfmd->getNumOccs();
             if (raw_num_occs == 0) {
                 // Interleaved features are missing. Assume 1 occurrence and average field length.
                 score += term.degraded_score;
             } else {
                 feature_t num_occs = raw_num_occs;
-                feature_t norm_field_length = ((feature_t) term.tfmd->getFieldLength()) / _avg_field_length;
                 feature_t numerator = num_occs * term.idf_mul_k1_plus_one;
-                feature_t denominator = num_occs + (_k1_mul_one_minus_b + _k1_mul_b * norm_field_length);
+                feature_t denominator = num_occs + (_k1_mul_one_minus_b + _k1_mul_b_div_avg_field_length * tfmd->getFieldLength());
 
                 score += numerator / denominator;
             }
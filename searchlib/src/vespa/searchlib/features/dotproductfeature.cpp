@@ -101,6 +101,20 @@ DotProductByWeightedSetReadViewExecutor<BaseType>::getAttributeValues(uint32_t d
     return _weighted_set_read_view->get_values(docId);
 }
 
+template <typename BaseType>
+bool
+DotProductByWeightedSetReadViewExecutor<BaseType>::supports_prefetch() const
+{
+    return true;
+}
+
+template <typename BaseType>
+void
+DotProductByWeightedSetReadViewExecutor<BaseType>::prefetch(std::span<const uint32_t> docids)
+{
+    _weighted_set_read_view->prefetch(docids);
+}
+
 namespace {
 
 class DotProductExecutorByEnum final : public fef::FeatureExecutor {
@@ -117,6 +131,8 @@ public:
     DotProductExecutorByEnum(const IWeightedSetEnumReadView* weighted_set_enum_read_view, std::unique_ptr<V> queryVector);
     ~DotProductExecutorByEnum() override;
     void execute(uint32_t docId) override;
+    bool supports_prefetch() const override { return true; }
+    void prefetch(std::span<const uint32_t> docids) override { _weighted_set_enum_read_view->prefetch(docids); }
 };
 
 DotProductExecutorByEnum::DotProductExecutorByEnum(const IWeightedSetEnumReadView* weighted_set_enum_read_view, const V & queryVector)
@@ -171,6 +187,8 @@ public:
         }
         outputs().set_number(0, 0);
     }
+    bool supports_prefetch() const override { return true; }
+    void prefetch(std::span<const uint32_t> docids) override { _weighted_set_enum_read_view->prefetch(docids); }
 private:
     const IWeightedSetEnumReadView * _weighted_set_enum_read_view;
     EnumHandle                   _key;
@@ -198,6 +216,8 @@ public:
         }
         outputs().set_number(0, 0);
     }
+    bool supports_prefetch() const override { return true; }
+    void prefetch(std::span<const uint32_t> docids) override { _weighted_set_read_view->prefetch(docids); }
 private:
     const WeightedSetReadView* _weighted_set_read_view;
     StoredKeyType              _key;
@@ -246,6 +266,20 @@ DotProductByArrayReadViewExecutor<BaseType>::getAttributeValues(uint32_t docId)
     return _array_read_view->get_values(docId);
 }
 
+template <typename BaseType>
+bool
+DotProductByArrayReadViewExecutor<BaseType>::supports_prefetch() const
+{
+    return true;
+}
+
+template <typename BaseType>
+void
+DotProductByArrayReadViewExecutor<BaseType>::prefetch(std::span<const uint32_t> docids)
+{
+    _array_read_view->prefetch(docids);
+}
+
 template <typename A>
 DotProductExecutor<A>::DotProductExecutor(const A * attribute, const V & queryVector) :
     DotProductExecutorBase<typename A::BaseType>(queryVector),
@@ -289,6 +323,20 @@ SparseDotProductByArrayReadViewExecutor<BaseType>::getAttributeValues(uint32_t d
     return std::span<const BaseType>(_scratch.data(), i);
 }
 
+template <typename BaseType>
+bool
+SparseDotProductByArrayReadViewExecutor<BaseType>::supports_prefetch() const
+{
+    return true;
+}
+
+template <typename BaseType>
+void
+SparseDotProductByArrayReadViewExecutor<BaseType>::prefetch(std::span<const uint32_t> docids)
+{
+    _array_read_view->prefetch(docids);
+}
+
 }
 
 namespace {
@@ -152,6 +152,8 @@ public:
     DotProductByWeightedSetReadViewExecutor(const WeightedSetReadView* weighted_set_read_view, const V & queryVector);
     DotProductByWeightedSetReadViewExecutor(const WeightedSetReadView * weighted_set_read_view, std::unique_ptr<V> queryVector);
     ~DotProductByWeightedSetReadViewExecutor();
+    bool supports_prefetch() const override;
+    void prefetch(std::span<const uint32_t> docids) override;
 };
 
 }
@@ -192,6 +194,8 @@ private:
 public:
     DotProductByArrayReadViewExecutor(const ArrayReadView* array_read_view, const V & queryVector);
     ~DotProductByArrayReadViewExecutor();
+    bool supports_prefetch() const override;
+    void prefetch(std::span<const uint32_t> docids) override;
 };
 
 /**
@@ -230,6 +234,8 @@ public:
     using ArrayReadView = attribute::IArrayReadView<BaseType>;
     SparseDotProductByArrayReadViewExecutor(const ArrayReadView* array_read_view, const V & queryVector, const IV & queryIndexes);
     ~SparseDotProductByArrayReadViewExecutor();
+    bool supports_prefetch() const override;
+    void prefetch(std::span<const uint32_t> docids) override;
 private:
     std::span<const BaseType> getAttributeValues(uint32_t docid) override;
     const ArrayReadView* _array_read_view;
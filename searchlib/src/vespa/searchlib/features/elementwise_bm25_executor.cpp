@@ -5,6 +5,7 @@
 #include <vespa/searchlib/fef/itermdata.h>
 #include <vespa/searchlib/fef/iqueryenvironment.h>
 #include <vespa/searchlib/fef/match_data_details.h>
+#include <algorithm>
 
 namespace search::features {
 
@@ -22,8 +23,7 @@ ElementwiseBm25Executor::ElementwiseBm25Executor(const fef::FieldInfo& field,
                            const Value& empty_output)
     : FeatureExecutor(),
       _terms(),
-      _avg_element_length(avg_element_length),
-      _k1_mul_b(k1_param * b_param),
+      _k1_mul_b_div_avg_element_length((k1_param * b_param) / avg_element_length),
       _k1_mul_one_minus_b(k1_param * (1 - b_param)),
       _scores(),
       _output(empty_output)
@@ -55,14 +55,26 @@ void
 ElementwiseBm25Executor::apply_bm25_score(uint32_t num_occs, uint32_t element_id, uint32_t element_length,
                                           const QueryTerm& term)
 {
-    feature_t norm_element_length = ((feature_t) element_length) / _avg_element_length;
     feature_t numerator = num_occs * term.idf_mul_k1_plus_one;
-    feature_t denominator = num_occs + (_k1_mul_one_minus_b + _k1_mul_b * norm_element_length);
-    feature_t score = numerator / denominator;
-    auto ins_res = _scores.insert(std::make_pair(element_id, score));
-    if (!ins_res.second) {
-        ins_res.first->second += score;
+    feature_t denominator = num_occs + (_k1_mul_one_minus_b + _k1_mul_b_div_avg_element_length * element_length);
+    _scores.emplace_back(element_id, numerator / denominator);
+}
+
+void
+ElementwiseBm25Executor::aggregate_scores(bool sorted)
+{
+    if (!sorted) {
+        std::sort(_scores.begin(), _scores.end(), [](const auto& lhs, const auto& rhs) noexcept { return lhs.first < rhs.first; });
     }
+    auto dst = _scores.begin();
+    for (auto src = _scores.begin() + 1; src != _scores.end(); ++src) {
+        if (src->first == dst->first) {
+            dst->second += src->second;
+        } else {
+            *++dst = *src;
+        }
+    }
+    _scores.erase(dst + 1, _scores.end());
 }
 
 void
@@ -72,8 +84,10 @@ ElementwiseBm25Executor::execute(uint32_t doc_id)
     uint32_t element_id = 0;
     uint32_t element_length = 0;
     uint32_t num_occs = 0;
+    uint32_t matching_terms = 0;
     for (const auto& term : _terms) {
         if (term.tfmd->getDocId() == doc_id) {
+            ++matching_terms;
             num_occs = 0;
             for (auto& pos : *term.tfmd) {
                 if (num_occs > 0 && element_id == pos.getElementId()) {
@@ -92,6 +106,10 @@ ElementwiseBm25Executor::execute(uint32_t doc_id)
             }
         }
     }
+    if (!_scores.empty()) {
+        // Positions of a single term are sorted on element id
+        aggregate_scores(matching_terms == 1);
+    }
     outputs().set_object(0, _output.build(_scores));
 }
 
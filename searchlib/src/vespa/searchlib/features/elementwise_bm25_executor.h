@@ -5,7 +5,7 @@
 #include <vespa/searchlib/fef/featureexecutor.h>
 #include "bm25_utils.h"
 #include "elementwise_output.h"
-#include <vespa/vespalib/stllike/hash_map.h>
+#include <vector>
 
 namespace search::fef { class IQueryEnvironment; }
 
@@ -21,15 +21,17 @@ class ElementwiseBm25Executor : public fef::FeatureExecutor {
     using QueryTermVector = std::vector<QueryTerm>;
 
     QueryTermVector _terms;
-    double _avg_element_length;
 
     // The 'k1' param determines term frequency saturation characteristics.
     // The 'b' param adjusts the effects of the element length of the document matched compared to the average element length.
-    double _k1_mul_b;
+    double _k1_mul_b_div_avg_element_length;
     double _k1_mul_one_minus_b;
-    vespalib::hash_map<uint32_t, double> _scores; // element id -> aggregated score mapping
+    // Flat scratch of (element id, score) per matching term, sorted and aggregated per element id before output
+    std::vector<std::pair<uint32_t, double>> _scores;
     ElementwiseOutput _output;
 
+    void aggregate_scores(bool sorted);
+
     void apply_bm25_score(uint32_t num_occs, uint32_t element_id, uint32_t element_length, const QueryTerm& term);
 public:
     ElementwiseBm25Executor(const fef::FieldInfo &field,
@@ -22,7 +22,7 @@ struct InitializeCells {
 
 struct ElementwiseOutput::CallBuilderHelper {
     template <typename CT>
-    static TypedCells invoke(ElementwiseOutput& output, const vespalib::hash_map<uint32_t, double>& scores) {
+    static TypedCells invoke(ElementwiseOutput& output, ElementScores scores) {
         return output.build_helper<CT>(scores);
     }
 };
@@ -34,14 +34,14 @@ ElementwiseOutput::ElementwiseOutput(const vespalib::eval::Value& empty_output)
       _empty_output(empty_output),
       _output()
 {
-    typify_invoke<1, TypifyCellType, InitializeCells>(_empty_output.type().cell_type(), _cells);
+    vespalib::typify_invoke<1, TypifyCellType, InitializeCells>(_empty_output.type().cell_type(), _cells);
 }
 
 ElementwiseOutput::~ElementwiseOutput() = default;
 
 template <typename CT>
 TypedCells
-ElementwiseOutput::build_helper(const vespalib::hash_map<uint32_t, double>& scores)
+ElementwiseOutput::build_helper(ElementScores scores)
 {
     auto& cells = std::get<std::vector<CT>>(_cells);
     cells.clear();
@@ -53,14 +53,18 @@ ElementwiseOutput::build_helper(const vespalib::hash_map<uint32_t, double>& scor
 }
 
 const vespalib::eval::Value&
-ElementwiseOutput::build(const vespalib::hash_map<uint32_t, double>& scores)
+ElementwiseOutput::build(ElementScores scores)
 {
     if (scores.empty()) {
         return _empty_output;
     }
     _labels.clear();
-    auto cells = typify_invoke<1, TypifyCellType, CallBuilderHelper>(_empty_output.type().cell_type(), *this, scores);
-    _output = std::make_unique<FastValueView>(_empty_output.type(), _labels.view(), cells, 1, (size_t)cells.size);
+    auto cells = vespalib::typify_invoke<1, TypifyCellType, CallBuilderHelper>(_empty_output.type().cell_type(), *this, scores);
+    if (_output) {
+        _output->assign(_labels.view(), cells, (size_t)cells.size);
+    } else {
+        _output = std::make_unique<FastValueView>(_empty_output.type(), _labels.view(), cells, 1, (size_t)cells.size);
+    }
     return *_output;
 }
 
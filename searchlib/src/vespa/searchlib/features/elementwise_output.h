@@ -3,31 +3,38 @@
 #pragma once
 
 #include <vespa/eval/eval/value.h>
-#include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/vespalib/util/shared_string_repo.h>
+#include <span>
 #include <variant>
 
+namespace search::tensor { struct FastValueView; }
+
 namespace search::features {
 
 /*
  * Class containing a locally built output tensor for elementwise features. The tensor has a single mapped dimension
  * with element id as label value and the score for the element as cell value. Lifetime of output tensor is until
- * build() or destructor is called.
+ * build() or destructor is called. Labels, cells and the output tensor are reused between calls to build(), so
+ * building does not allocate memory once it has seen as many elements as the current document has.
  */
 class ElementwiseOutput {
+    public:
+        // Element id and score, sorted on element id without duplicates
+        using ElementScores = std::span<const std::pair<uint32_t, double>>;
+    private:
         struct CallBuilderHelper;
         friend struct CallBuilderHelper;
         vespalib::SharedStringRepo::Handles _labels;
         std::variant<std::monostate, std::vector<double>, std::vector<float>, std::vector<vespalib::BFloat16>, std::vector<vespalib::eval::Int8Float>> _cells;
         const vespalib::eval::Value& _empty_output;
-        std::unique_ptr<vespalib::eval::Value> _output;
+        std::unique_ptr<tensor::FastValueView> _output;
 
        template <typename CT>
-       vespalib::eval::TypedCells build_helper(const vespalib::hash_map<uint32_t, double>& scores);
+       vespalib::eval::TypedCells build_helper(ElementScores scores);
     public:
         ElementwiseOutput(const vespalib::eval::Value& empty_output);
         ~ElementwiseOutput();
-        const vespalib::eval::Value &build(const vespalib::hash_map<uint32_t, double>& scores);
+        const vespalib::eval::Value &build(ElementScores scores);
 };
 
 }
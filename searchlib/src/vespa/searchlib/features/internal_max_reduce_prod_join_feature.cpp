@@ -42,6 +42,8 @@ public:
     RawExecutor(const ArrayReadView* array_read_view, std::unique_ptr<IntegerVector> queryVector);
 
     void execute(uint32_t docId) override;
+    bool supports_prefetch() const override { return true; }
+    void prefetch(std::span<const uint32_t> docids) override { _array_read_view->prefetch(docids); }
 };
 
 template<typename BaseType>
@@ -48,35 +48,12 @@ NativeFieldMatchExecutorSharedState::NativeFieldMatchExecutorSharedState(const I
 
 NativeFieldMatchExecutorSharedState::~NativeFieldMatchExecutorSharedState() = default;
 
-feature_t
-NativeFieldMatchExecutor::calculateScore(const MyQueryTerm &qt, uint32_t docId)
-{
-    feature_t termScore = 0;
-    for (size_t i = 0; i < qt.handles().size(); ++i) {
-        TermFieldHandle tfh = qt.handles()[i].first;
-        const TermFieldMatchData *tfmd = _md->resolveTermField(tfh);
-        const NativeFieldMatchParam & param = _params.vector[tfmd->getFieldId()];
-        if (tfmd->getDocId() == docId) { // do we have a hit
-            FieldPositionsIterator pos = tfmd->getIterator();
-            if (pos.valid()) {
-                uint32_t fieldLength = getFieldLength(param, pos.getFieldLength());
-                termScore +=
-                    ((getFirstOccBoost(param, pos.getPosition(), fieldLength) * param.firstOccImportance) +
-                     (getNumOccBoost(param, pos.size(), fieldLength) * (1 - param.firstOccImportance))) *
-                    param.fieldWeight / param.maxTableSum;
-            }
-        }
-    }
-    termScore *= (qt.significance() * qt.termData()->getWeight().percent());
-    return termScore;
-}
-
 NativeFieldMatchExecutor::NativeFieldMatchExecutor(const NativeFieldMatchExecutorSharedState& shared_state)
     : FeatureExecutor(),
       _params(shared_state.get_params()),
       _queryTerms(shared_state.get_query_terms()),
       _divisor(shared_state.get_divisor()),
-      _md(nullptr)
+      _term_fields()
 {
     for (const auto& qt : _queryTerms) {
         for (const auto& handle : qt.handles()) {
@@ -90,8 +67,19 @@ void
 NativeFieldMatchExecutor::execute(uint32_t docId)
 {
     feature_t score = 0;
-    for (size_t i = 0; i < _queryTerms.size(); ++i) {
-        score += calculateScore(_queryTerms[i], docId);
+    for (const auto & term_field : _term_fields) {
+        const TermFieldMatchData *tfmd = term_field.tfmd;
+        if (tfmd->getDocId() == docId) { // do we have a hit
+            FieldPositionsIterator pos = tfmd->getIterator();
+            if (pos.valid()) {
+                const NativeFieldMatchParam & param = *term_field.param;
+                uint32_t fieldLength = getFieldLength(param, pos.getFieldLength());
+                score +=
+                    ((getFirstOccBoost(param, pos.getPosition(), fieldLength) * param.firstOccImportance) +
+                     (getNumOccBoost(param, pos.size(), fieldLength) * (1 - param.firstOccImportance))) *
+                    term_field.scale;
+            }
+        }
     }
     if (_divisor > 0) {
         score /= _divisor;
@@ -102,7 +90,15 @@ NativeFieldMatchExecutor::execute(uint32_t docId)
 void
 NativeFieldMatchExecutor::handle_bind_match_data(const fef::MatchData &md)
 {
-    _md = &md;
+    _term_fields.clear();
+    for (const auto& qt : _queryTerms) {
+        feature_t term_scale = qt.significance() * qt.termData()->getWeight().percent();
+        for (const auto& handle : qt.handles()) {
+            const TermFieldMatchData *tfmd = md.resolveTermField(handle.first);
+            const NativeFieldMatchParam & param = _params.vector[tfmd->getFieldId()];
+            _term_fields.push_back({tfmd, &param, (param.fieldWeight / param.maxTableSum) * term_scale});
+        }
+    }
 }
 
 NativeFieldMatchBlueprint::NativeFieldMatchBlueprint() :
@@ -63,12 +63,20 @@ class NativeFieldMatchExecutor : public fef::FeatureExecutor
 {
 private:
     using MyQueryTerm = NativeFieldMatchExecutorSharedState::MyQueryTerm;
+    /**
+     * A term field with match data resolved when match data is bound, and with the
+     * field weight, table normalization and term significance and weight folded
+     * into a single factor.
+     */
+    struct ResolvedTermField {
+        const fef::TermFieldMatchData *tfmd;
+        const NativeFieldMatchParam   *param;
+        feature_t                      scale;
+    };
     const NativeFieldMatchParams & _params;
     std::span<const MyQueryTerm> _queryTerms;
     feature_t                      _divisor;
-    const fef::MatchData          *_md;
-
-    VESPA_DLL_LOCAL feature_t calculateScore(const MyQueryTerm &qt, uint32_t docId);
+    std::vector<ResolvedTermField> _term_fields;
 
     uint32_t getFieldLength(const NativeFieldMatchParam & param, uint32_t fieldLength) const {
         if (param.averageFieldLength != NativeFieldMatchParam::NOT_DEF_FIELD_LENGTH) {
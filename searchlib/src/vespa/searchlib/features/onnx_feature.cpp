@@ -11,7 +11,10 @@
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/util/issue.h>
+#include <algorithm>
 #include <cctype>
+#include <cstring>
+#include <optional>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".features.onnx_feature");
@@ -23,6 +26,9 @@ using search::fef::IIndexEnvironment;
 using search::fef::IQueryEnvironment;
 using search::fef::ParameterList;
 using vespalib::Stash;
+using vespalib::eval::CellTypeUtils;
+using vespalib::eval::DenseValueView;
+using vespalib::eval::TypedCells;
 using vespalib::eval::Value;
 using vespalib::eval::ValueType;
 using vespalib::eval::TensorSpec;
@@ -70,25 +76,184 @@ std::string my_dry_run(const Onnx &model, const Onnx::WireInfo &wire) {
     return error_msg;
 }
 
+size_t cell_bytes(const ValueType &type) {
+    return CellTypeUtils::mem_size(type.cell_type(), type.dense_subspace_size());
+}
+
+// which inputs to stack along the batch dimension of the model (the
+// outer dimension of all outputs); empty if the model cannot be batched
+std::vector<bool> find_batch_inputs(const Onnx &model, const Onnx::WirePlanner &planner) {
+    const auto &outputs = model.outputs();
+    if (outputs.empty() || outputs[0].dimensions.empty() || !outputs[0].dimensions[0].is_symbolic()) {
+        return {};
+    }
+    const std::string batch_dim = outputs[0].dimensions[0].name;
+    auto is_batch_dim = [&batch_dim](const Onnx::DimSize &dim) {
+        return (dim.is_symbolic() && (dim.name == batch_dim));
+    };
+    auto has_inner_batch_dim = [&is_batch_dim](const Onnx::TensorInfo &info) {
+        return std::any_of(info.dimensions.begin() + 1, info.dimensions.end(), is_batch_dim);
+    };
+    for (const auto &output: outputs) {
+        if (output.dimensions.empty() || !is_batch_dim(output.dimensions[0]) || has_inner_batch_dim(output)) {
+            return {};
+        }
+    }
+    std::vector<bool> result;
+    for (const auto &input: model.inputs()) {
+        if (input.dimensions.empty()) {
+            result.push_back(false);
+        } else if (is_batch_dim(input.dimensions[0])) {
+            if (has_inner_batch_dim(input) || (planner.get_bound_sizes(input)[batch_dim] != 1)) {
+                return {};
+            }
+            result.push_back(true);
+        } else if (has_inner_batch_dim(input)) {
+            return {};
+        } else {
+            result.push_back(false);
+        }
+    }
+    if (std::find(result.begin(), result.end(), true) == result.end()) {
+        return {};
+    }
+    return result;
+}
+
+std::optional<Onnx::WireInfo> make_batch_wire_info(const Onnx &model, const Onnx::WireInfo &wire_info,
+                                                   const std::vector<bool> &batch_inputs, size_t size)
+{
+    Onnx::WirePlanner planner;
+    for (size_t i = 0; i < model.inputs().size(); ++i) {
+        ValueType type = wire_info.vespa_inputs[i];
+        if (batch_inputs[i]) {
+            if (!type.is_dense()) {
+                return std::nullopt;
+            }
+            auto dimensions = type.dimensions();
+            dimensions[0].size = size;
+            type = ValueType::make_type(type.cell_type(), std::move(dimensions));
+        }
+        if (!planner.bind_input_type(type, model.inputs()[i])) {
+            return std::nullopt;
+        }
+    }
+    planner.prepare_output_types(model);
+    for (const auto &output: model.outputs()) {
+        if (planner.make_output_type(output).is_error()) {
+            return std::nullopt;
+        }
+    }
+    auto result = planner.get_wire_info(model);
+    for (size_t i = 0; i < result.vespa_inputs.size(); ++i) {
+        size_t expect = batch_inputs[i] ? (size * cell_bytes(wire_info.vespa_inputs[i])) : cell_bytes(wire_info.vespa_inputs[i]);
+        if (cell_bytes(result.vespa_inputs[i]) != expect) {
+            return std::nullopt;
+        }
+    }
+    for (size_t i = 0; i < result.vespa_outputs.size(); ++i) {
+        if ((result.vespa_outputs[i].cell_type() != wire_info.vespa_outputs[i].cell_type()) ||
+            (cell_bytes(result.vespa_outputs[i]) != (size * cell_bytes(wire_info.vespa_outputs[i]))))
+        {
+            return std::nullopt;
+        }
+    }
+    return result;
+}
+
 } // <unnamed>
 
 /**
- * Feature executor that evaluates an onnx model
+ * Feature executor that evaluates an onnx model. Prefetched documents
+ * are evaluated in batches according to the batch plans (ordered by
+ * increasing size), and their results are kept until the documents
+ * are executed.
  */
 class OnnxFeatureExecutor : public FeatureExecutor
 {
 private:
-    Onnx::EvalContext _eval_context;
+    using BatchPlan = OnnxBlueprint::BatchPlan;
+    const Onnx                                     &_model;
+    const Onnx::WireInfo                           &_wire_info;
+    Onnx::EvalContext                               _eval_context;
+    const std::vector<bool>                        &_batch_inputs;
+    const std::vector<BatchPlan>                   &_batch_plans;
+    bool                                            _can_prefetch;
+    std::vector<std::unique_ptr<Onnx::EvalContext>> _batch_contexts;
+    std::vector<std::vector<char>>                  _input_cells;
+    std::vector<std::vector<char>>                  _output_cells;
+    std::vector<uint32_t>                           _prefetched_docids;
+    std::vector<DenseValueView>                     _prefetched_results;
+    size_t                                          _prefetch_pos;
+
+    void eval_batch(std::span<const uint32_t> docids, size_t offset);
 public:
-    OnnxFeatureExecutor(const Onnx &model, const Onnx::WireInfo &wire_info)
-        : _eval_context(model, wire_info) {}
+    OnnxFeatureExecutor(const Onnx &model, const Onnx::WireInfo &wire_info,
+                        const std::vector<bool> &batch_inputs, const std::vector<BatchPlan> &batch_plans)
+        : _model(model),
+          _wire_info(wire_info),
+          _eval_context(model, wire_info),
+          _batch_inputs(batch_inputs),
+          _batch_plans(batch_plans),
+          _can_prefetch(false),
+          _batch_contexts(batch_plans.size()),
+          _input_cells(batch_inputs.size()),
+          _output_cells(_eval_context.num_results()),
+          _prefetched_docids(),
+          _prefetched_results(),
+          _prefetch_pos(0) {}
+    ~OnnxFeatureExecutor() override;
     bool isPure() override { return true; }
+    void handle_bind_inputs(std::span<const fef::LazyValue> values) override {
+        // inputs without a batch dimension are shared by all documents in a batch
+        _can_prefetch = !_batch_plans.empty();
+        for (size_t i = 0; _can_prefetch && (i < values.size()); ++i) {
+            if (!_batch_inputs[i] && !values[i].is_const()) {
+                _can_prefetch = false;
+            }
+        }
+    }
     void handle_bind_outputs(std::span<fef::NumberOrObject>) override {
         for (size_t i = 0; i < _eval_context.num_results(); ++i) {
             outputs().set_object(i, _eval_context.get_result(i));
         }
     }
-    void execute(uint32_t) override {
+    bool supports_prefetch() const override { return _can_prefetch; }
+    void prefetch(std::span<const uint32_t> docids) override {
+        size_t num_results = _eval_context.num_results();
+        for (size_t i = 0; i < num_results; ++i) {
+            _output_cells[i].resize(docids.size() * cell_bytes(_wire_info.vespa_outputs[i]));
+        }
+        size_t max_size = _batch_plans.back().size;
+        for (size_t offset = 0; offset < docids.size(); offset += max_size) {
+            eval_batch(docids.subspan(offset, std::min(max_size, docids.size() - offset)), offset);
+        }
+        _prefetched_docids.assign(docids.begin(), docids.end());
+        _prefetched_results.clear();
+        _prefetched_results.reserve(docids.size() * num_results);
+        for (size_t doc = 0; doc < docids.size(); ++doc) {
+            for (size_t i = 0; i < num_results; ++i) {
+                const auto &type = _wire_info.vespa_outputs[i];
+                const char *cells = _output_cells[i].data() + doc * cell_bytes(type);
+                _prefetched_results.emplace_back(type, TypedCells(cells, type.cell_type(), type.dense_subspace_size()));
+            }
+        }
+        _prefetch_pos = 0;
+    }
+    void execute(uint32_t docid) override {
+        size_t num_results = _eval_context.num_results();
+        while ((_prefetch_pos < _prefetched_docids.size()) && (_prefetched_docids[_prefetch_pos] < docid)) {
+            ++_prefetch_pos;
+        }
+        if ((_prefetch_pos < _prefetched_docids.size()) && (_prefetched_docids[_prefetch_pos] == docid)) {
+            for (size_t i = 0; i < num_results; ++i) {
+                outputs().set_object(i, _prefetched_results[_prefetch_pos * num_results + i]);
+            }
+            return;
+        }
+        for (size_t i = 0; i < num_results; ++i) {
+            outputs().set_object(i, _eval_context.get_result(i));
+        }
         for (size_t i = 0; i < _eval_context.num_params(); ++i) {
             _eval_context.bind_param(i, inputs().get_object(i).get());
         }
@@ -101,12 +266,57 @@ public:
     }
 };
 
+OnnxFeatureExecutor::~OnnxFeatureExecutor() = default;
+
+void
+OnnxFeatureExecutor::eval_batch(std::span<const uint32_t> docids, size_t offset)
+{
+    size_t plan_idx = 0;
+    while (_batch_plans[plan_idx].size < docids.size()) {
+        ++plan_idx;
+    }
+    const BatchPlan &plan = _batch_plans[plan_idx];
+    auto &context = _batch_contexts[plan_idx];
+    if (!context) {
+        context = std::make_unique<Onnx::EvalContext>(_model, plan.wire_info);
+    }
+    for (size_t i = 0; i < context->num_params(); ++i) {
+        if (_batch_inputs[i]) {
+            // unused slots in the batch are filled with the last document
+            size_t bytes = cell_bytes(_wire_info.vespa_inputs[i]);
+            auto &cells = _input_cells[i];
+            cells.resize(plan.size * bytes);
+            for (size_t slot = 0; slot < plan.size; ++slot) {
+                const Value &value = inputs().get_object(i, docids[std::min(slot, docids.size() - 1)]);
+                memcpy(cells.data() + slot * bytes, value.cells().data, bytes);
+            }
+            const auto &type = plan.wire_info.vespa_inputs[i];
+            DenseValueView param(type, TypedCells(cells.data(), type.cell_type(), type.dense_subspace_size()));
+            context->bind_param(i, param);
+        } else {
+            context->bind_param(i, inputs().get_object(i, docids[0]).get());
+        }
+    }
+    try {
+        context->eval();
+    } catch (const Ort::Exception &ex) {
+        Issue::report("onnx model evaluation failed: %s", ex.what());
+        context->clear_results();
+    }
+    for (size_t i = 0; i < context->num_results(); ++i) {
+        size_t bytes = cell_bytes(_wire_info.vespa_outputs[i]);
+        memcpy(_output_cells[i].data() + offset * bytes, context->get_result(i).cells().data, docids.size() * bytes);
+    }
+}
+
 OnnxBlueprint::OnnxBlueprint(std::string_view baseName)
     : Blueprint(baseName),
       _cache_token(),
       _debug_model(),
       _model(nullptr),
-      _wire_info()
+      _wire_info(),
+      _batch_inputs(),
+      _batch_plans()
 {
     assert((baseName == "onnx") || (baseName == "onnxModel"));
 }
@@ -173,14 +383,50 @@ OnnxBlueprint::setup(const IIndexEnvironment &env,
     } else {
         LOG(warning, "dry-run disabled for onnx model '%s'", model_cfg->name().c_str());
     }
+    if (model_cfg->max_batch_size() > 1) {
+        plan_batching(model_cfg->name(), model_cfg->max_batch_size(), planner);
+    }
     return true;
 }
 
+void
+OnnxBlueprint::plan_batching(const std::string &model_name, size_t max_batch_size, const Onnx::WirePlanner &planner)
+{
+    auto batch_inputs = find_batch_inputs(*_model, planner);
+    if (batch_inputs.empty()) {
+        LOG(warning, "onnx model '%s' has no symbolic batch dimension of size 1; not using batch evaluation",
+            model_name.c_str());
+        return;
+    }
+    std::vector<size_t> sizes;
+    for (size_t size = 2; size < max_batch_size; size *= 2) {
+        sizes.push_back(size);
+    }
+    sizes.push_back(max_batch_size);
+    std::vector<BatchPlan> plans;
+    for (size_t size: sizes) {
+        std::optional<Onnx::WireInfo> wire_info;
+        try {
+            wire_info = make_batch_wire_info(*_model, _wire_info, batch_inputs, size);
+        } catch (const Ort::Exception &ex) {
+            LOG(warning, "onnx model '%s' failed to probe batch size %zu: %s", model_name.c_str(), size, ex.what());
+        }
+        if (!wire_info.has_value()) {
+            LOG(warning, "onnx model '%s' cannot be wired for batch size %zu; not using batch evaluation",
+                model_name.c_str(), size);
+            return;
+        }
+        plans.push_back(BatchPlan{size, std::move(wire_info.value())});
+    }
+    _batch_inputs = std::move(batch_inputs);
+    _batch_plans = std::move(plans);
+}
+
 FeatureExecutor &
 OnnxBlueprint::createExecutor(const IQueryEnvironment &, Stash &stash) const
 {
     assert(_model != nullptr);
-    return stash.create<OnnxFeatureExecutor>(*_model, _wire_info);
+    return stash.create<OnnxFeatureExecutor>(*_model, _wire_info, _batch_inputs, _batch_plans);
 }
 
 }
@@ -9,8 +9,18 @@ namespace search::features {
 
 /**
  * Blueprint for the ranking feature used to evaluate an onnx model.
+ *
+ * Models with a symbolic batch dimension may be configured with a
+ * max batch size, in which case prefetched documents are evaluated
+ * together by stacking their inputs along the batch dimension.
  **/
 class OnnxBlueprint : public fef::Blueprint {
+public:
+    // how to wire the model when evaluating a batch of documents
+    struct BatchPlan {
+        size_t size;
+        vespalib::eval::Onnx::WireInfo wire_info;
+    };
 private:
     using Onnx = vespalib::eval::Onnx;
     using Optimize = vespalib::eval::Onnx::Optimize;
@@ -19,6 +29,10 @@ private:
     std::unique_ptr<Onnx> _debug_model;
     const Onnx *_model;
     Onnx::WireInfo _wire_info;
+    std::vector<bool> _batch_inputs;
+    std::vector<BatchPlan> _batch_plans;
+
+    void plan_batching(const std::string &model_name, size_t max_batch_size, const Onnx::WirePlanner &planner);
 public:
     OnnxBlueprint(std::string_view baseName);
     ~OnnxBlueprint() override;
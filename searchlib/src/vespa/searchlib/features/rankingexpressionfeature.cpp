@@ -6,13 +6,18 @@
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/features/rankingexpression/feature_name_extractor.h>
 #include <vespa/eval/eval/param_usage.h>
+#include <vespa/eval/eval/compile_tensor_function.h>
 #include <vespa/eval/eval/fast_value.h>
+#include <vespa/vespalib/util/execution_profiler.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".features.rankingexpression");
 
 using search::fef::FeatureType;
+using vespalib::ExecutionProfiler;
+using vespalib::eval::CTFMetaData;
 using vespalib::eval::CompileCache;
 using vespalib::eval::CompiledFunction;
 using vespalib::eval::DoubleValue;
@@ -38,6 +43,28 @@ std::string list_issues(const std::vector<std::string> &issues) {
     return result;
 }
 
+/**
+ * Tracks each instruction of an interpreted function as a separate
+ * task when the rank program is profiled.
+ **/
+struct InstructionProfiling {
+    const std::vector<std::string>   &names;
+    ExecutionProfiler                *profiler;
+    std::vector<ExecutionProfiler::TaskId> tasks;
+    explicit InstructionProfiling(const std::vector<std::string> &names_in) noexcept
+      : names(names_in), profiler(nullptr), tasks() {}
+    void bind(ExecutionProfiler &profiler_in) {
+        profiler = &profiler_in;
+        tasks.clear();
+        for (const auto &name: names) {
+            tasks.push_back(profiler->resolve(name));
+        }
+    }
+    const Value &eval(const InterpretedFunction &function, InterpretedFunction::Context &ctx, const LazyParams &params) const {
+        return profiler ? function.eval(ctx, params, *profiler, tasks) : function.eval(ctx, params);
+    }
+};
+
 } // namespace search::features::<unnamed>
 
 //-----------------------------------------------------------------------------
@@ -51,11 +78,16 @@ private:
     const FastForest &_forest;
     FastForest::Context::UP _ctx;
     std::span<float> _params;
+    std::vector<float> _batch_params; // feature-major
 
 public:
     FastForestExecutor(std::span<float> param_space, const FastForest &forest);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(std::span<const uint32_t> docids,
+                       std::span<const feature_t * const> inputs,
+                       std::span<feature_t * const> outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -74,6 +106,10 @@ public:
     CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return true; }
+    void execute_batch(std::span<const uint32_t> docids,
+                       std::span<const feature_t * const> inputs,
+                       std::span<feature_t * const> outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -118,9 +154,12 @@ private:
     const InterpretedFunction   &_function;
     InterpretedFunction::Context _context;
     MyLazyParams                 _params;
+    InstructionProfiling         _profiling;
 
+    void handle_bind_profiler(ExecutionProfiler &profiler) override { _profiling.bind(profiler); }
 public:
     InterpretedRankingExpressionExecutor(const InterpretedFunction &function,
+                                         const std::vector<std::string> &instruction_names,
                                          std::span<const char> input_is_object);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
@@ -136,12 +175,21 @@ private:
     const InterpretedFunction   &_function;
     InterpretedFunction::Context _context;
     MyLazyParams                 _params;
+    InstructionProfiling         _profiling;
+    std::unique_ptr<InterpretedFunction::BatchContext> _batch_context;
 
+    void handle_bind_profiler(ExecutionProfiler &profiler) override { _profiling.bind(profiler); }
 public:
     UnboxingInterpretedRankingExpressionExecutor(const InterpretedFunction &function,
+                                                 const std::vector<std::string> &instruction_names,
                                                  std::span<const char> input_is_object);
+    ~UnboxingInterpretedRankingExpressionExecutor() override;
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    bool supports_batch() const override { return bool(_batch_context); }
+    void execute_batch(std::span<const uint32_t> docids,
+                       std::span<const feature_t * const> inputs,
+                       std::span<feature_t * const> outputs) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -149,7 +197,8 @@ public:
 FastForestExecutor::FastForestExecutor(std::span<float> param_space, const FastForest &forest)
     : _forest(forest),
       _ctx(_forest.create_context()),
-      _params(param_space)
+      _params(param_space),
+      _batch_params()
 {
 }
 
@@ -169,6 +218,22 @@ FastForestExecutor::execute(uint32_t)
     outputs().set_number(0, _forest.eval(*_ctx, &_params[0]));
 }
 
+void
+FastForestExecutor::execute_batch(std::span<const uint32_t> docids,
+                                  std::span<const feature_t * const> in,
+                                  std::span<feature_t * const> out)
+{
+    size_t num_docs = docids.size();
+    _batch_params.resize(_params.size() * num_docs);
+    float *dst = _batch_params.data();
+    for (size_t i = 0; i < _params.size(); ++i) {
+        for (size_t doc = 0; doc < num_docs; ++doc) {
+            *dst++ = in[i][doc];
+        }
+    }
+    _forest.eval_batch(*_ctx, _batch_params.data(), num_docs, out[0]);
+}
+
 //-----------------------------------------------------------------------------
 
 CompiledRankingExpressionExecutor::CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
@@ -193,6 +258,19 @@ CompiledRankingExpressionExecutor::execute(uint32_t)
     outputs().set_number(0, _ranking_function(_params.data()));
 }
 
+void
+CompiledRankingExpressionExecutor::execute_batch(std::span<const uint32_t> docids,
+                                                 std::span<const feature_t * const> in,
+                                                 std::span<feature_t * const> out)
+{
+    for (size_t doc = 0; doc < docids.size(); ++doc) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = in[i][doc];
+        }
+        out[0][doc] = _ranking_function(_params.data());
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 namespace {
@@ -217,33 +295,52 @@ LazyCompiledRankingExpressionExecutor::execute(uint32_t)
 //-----------------------------------------------------------------------------
 
 InterpretedRankingExpressionExecutor::InterpretedRankingExpressionExecutor(const InterpretedFunction &function,
+                                                                           const std::vector<std::string> &instruction_names,
                                                                            std::span<const char> input_is_object)
     : _function(function),
       _context(function),
-      _params(inputs(), input_is_object)
+      _params(inputs(), input_is_object),
+      _profiling(instruction_names)
 {
 }
 
 void
 InterpretedRankingExpressionExecutor::execute(uint32_t)
 {
-    outputs().set_object(0, _function.eval(_context, _params));
+    outputs().set_object(0, _profiling.eval(_function, _context, _params));
 }
 
 //-----------------------------------------------------------------------------
 
 UnboxingInterpretedRankingExpressionExecutor::UnboxingInterpretedRankingExpressionExecutor(const InterpretedFunction &function,
+                                                                                           const std::vector<std::string> &instruction_names,
                                                                                            std::span<const char> input_is_object)
     : _function(function),
       _context(function),
-      _params(inputs(), input_is_object)
+      _params(inputs(), input_is_object),
+      _profiling(instruction_names),
+      _batch_context()
 {
+    bool all_numbers = std::find(input_is_object.begin(), input_is_object.end(), 1) == input_is_object.end();
+    if (all_numbers && function.supports_batch()) {
+        _batch_context = std::make_unique<InterpretedFunction::BatchContext>(function);
+    }
 }
 
+UnboxingInterpretedRankingExpressionExecutor::~UnboxingInterpretedRankingExpressionExecutor() = default;
+
 void
 UnboxingInterpretedRankingExpressionExecutor::execute(uint32_t)
 {
-    outputs().set_number(0, _function.eval(_context, _params).as_double());
+    outputs().set_number(0, _profiling.eval(_function, _context, _params).as_double());
+}
+
+void
+UnboxingInterpretedRankingExpressionExecutor::execute_batch(std::span<const uint32_t> docids,
+                                                            std::span<const feature_t * const> in,
+                                                            std::span<feature_t * const> out)
+{
+    _function.eval_batch(*_batch_context, in, std::span<double>(out[0], docids.size()));
 }
 
 //-----------------------------------------------------------------------------
@@ -257,6 +354,7 @@ RankingExpressionBlueprint::RankingExpressionBlueprint(rankingexpression::Expres
       _intrinsic_expression(),
       _fast_forest(),
       _interpreted_function(),
+      _instruction_names(),
       _compile_token(),
       _input_is_object(),
       _should_unbox(false)
@@ -360,8 +458,12 @@ RankingExpressionBlueprint::setup(const fef::IIndexEnvironment &env,
                 }
             }
         } else {
+            CTFMetaData meta;
             _interpreted_function.reset(new InterpretedFunction(FastValueBuilderFactory::get(),
-                                                                *rank_function, node_types));
+                                                                rank_function->root(), node_types, &meta));
+            for (const auto &step: meta.steps) {
+                _instruction_names.push_back(step.class_name);
+            }
             _should_unbox = root_type.is_double();
         }
     }
@@ -395,9 +497,9 @@ RankingExpressionBlueprint::createExecutor(const fef::IQueryEnvironment &env, ve
     if (_interpreted_function) {
         std::span<const char> input_is_object = stash.copy_array<char>(_input_is_object);
         if (_should_unbox) {
-            return stash.create<UnboxingInterpretedRankingExpressionExecutor>(*_interpreted_function, input_is_object);
+            return stash.create<UnboxingInterpretedRankingExpressionExecutor>(*_interpreted_function, _instruction_names, input_is_object);
         } else {
-            return stash.create<InterpretedRankingExpressionExecutor>(*_interpreted_function, input_is_object);
+            return stash.create<InterpretedRankingExpressionExecutor>(*_interpreted_function, _instruction_names, input_is_object);
         }
     }
     if (_fast_forest) {
@@ -22,6 +22,7 @@ private:
     rankingexpression::IntrinsicExpression::UP _intrinsic_expression;
     vespalib::eval::gbdt::FastForest::UP       _fast_forest;
     vespalib::eval::InterpretedFunction::UP    _interpreted_function;
+    std::vector<std::string>                   _instruction_names; // used when profiling
     vespalib::eval::CompileCache::Token::UP    _compile_token;
     std::vector<char>                          _input_is_object;
     bool                                       _should_unbox;
@@ -0,0 +1,37 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "serialized_tensor_attribute_executor.h"
+#include <vespa/searchlib/tensor/i_tensor_attribute.h>
+#include <vespa/searchlib/tensor/serialized_tensor_ref.h>
+
+namespace search::features {
+
+SerializedTensorAttributeExecutor::
+SerializedTensorAttributeExecutor(const ITensorAttribute& attribute)
+    : _attribute(attribute),
+      _type(attribute.getTensorType()),
+      _emptyTensor(attribute.getEmptyTensor()),
+      _view(),
+      _tensor()
+{
+}
+
+SerializedTensorAttributeExecutor::~SerializedTensorAttributeExecutor() = default;
+
+void
+SerializedTensorAttributeExecutor::execute(uint32_t docId)
+{
+    auto ref = _attribute.get_serialized_tensor_ref(docId);
+    const auto& vectors = ref.get_vectors();
+    if (vectors.subspaces() == 0) {
+        outputs().set_object(0, *_emptyTensor);
+    } else if (vectors.subspaces() <= max_streamed_subspaces) {
+        _view.emplace(_type, ref.get_num_mapped_dimensions(), vectors.cells(), vectors.subspaces(), ref.get_labels());
+        outputs().set_object(0, *_view);
+    } else {
+        _tensor = _attribute.getTensor(docId);
+        outputs().set_object(0, _tensor ? *_tensor : *_emptyTensor);
+    }
+}
+
+}
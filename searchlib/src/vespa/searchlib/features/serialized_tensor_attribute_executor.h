@@ -0,0 +1,38 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/fef/featureexecutor.h>
+#include <vespa/eval/eval/value.h>
+#include <vespa/eval/streamed/streamed_value_view.h>
+#include <optional>
+
+namespace search::tensor { class ITensorAttribute; }
+namespace search::features {
+
+/**
+ * Executor for tensor attributes storing serialized tensors.
+ *
+ * Tensors with few subspaces are exposed as a streamed view over the
+ * labels and cells in the attribute buffer, without copying anything
+ * or building an address map. Larger tensors are fetched with a
+ * decoded address map, since looking up labels in a streamed view
+ * is a linear scan.
+ */
+class SerializedTensorAttributeExecutor : public fef::FeatureExecutor
+{
+public:
+    using ITensorAttribute = search::tensor::ITensorAttribute;
+    static constexpr uint32_t max_streamed_subspaces = 32;
+    SerializedTensorAttributeExecutor(const ITensorAttribute& attribute);
+    ~SerializedTensorAttributeExecutor() override;
+    void execute(uint32_t docId) override;
+private:
+    const ITensorAttribute&                          _attribute;
+    const vespalib::eval::ValueType&                 _type;
+    std::unique_ptr<vespalib::eval::Value>           _emptyTensor;
+    std::optional<vespalib::eval::StreamedValueView> _view;
+    std::unique_ptr<vespalib::eval::Value>           _tensor;
+};
+
+}
@@ -2,6 +2,8 @@
 
 #include "featureexecutor.h"
 #include <vespa/vespalib/util/classname.h>
+#include <vespa/log/log.h>
+LOG_SETUP(".fef.featureexecutor");
 
 namespace search::fef {
 
@@ -20,6 +22,30 @@ FeatureExecutor::isPure()
     return false;
 }
 
+bool
+FeatureExecutor::supports_batch() const
+{
+    return false;
+}
+
+void
+FeatureExecutor::execute_batch(std::span<const uint32_t>, std::span<const feature_t * const>, std::span<feature_t * const>)
+{
+    LOG_ABORT("should not be reached");
+}
+
+bool
+FeatureExecutor::supports_prefetch() const
+{
+    return false;
+}
+
+void
+FeatureExecutor::prefetch(std::span<const uint32_t>)
+{
+    LOG_ABORT("should not be reached");
+}
+
 void
 FeatureExecutor::handle_bind_inputs(std::span<const LazyValue>)
 {
@@ -35,6 +61,11 @@ FeatureExecutor::handle_bind_match_data(const MatchData &)
 {
 }
 
+void
+FeatureExecutor::handle_bind_profiler(vespalib::ExecutionProfiler &)
+{
+}
+
 void
 FeatureExecutor::bind_inputs(std::span<const LazyValue> inputs)
 {
@@ -55,4 +86,10 @@ FeatureExecutor::bind_match_data(const MatchData &md)
     handle_bind_match_data(md);
 }
 
+void
+FeatureExecutor::bind_profiler(vespalib::ExecutionProfiler &profiler)
+{
+    handle_bind_profiler(profiler);
+}
+
 }
@@ -6,6 +6,8 @@
 #include "number_or_object.h"
 #include <span>
 
+namespace vespalib { class ExecutionProfiler; }
+
 namespace search::fef {
 
 class FeatureExecutor;
@@ -53,6 +55,7 @@ public:
         void bind(std::span<const LazyValue> inputs) { _inputs = inputs; }
         inline feature_t get_number(size_t idx) const;
         inline vespalib::eval::Value::CREF get_object(size_t idx) const;
+        inline vespalib::eval::Value::CREF get_object(size_t idx, uint32_t docid) const;
         size_t size() const { return _inputs.size(); }
     };
 
@@ -98,6 +101,7 @@ protected:
     virtual void handle_bind_inputs(std::span<const LazyValue> inputs);
     virtual void handle_bind_outputs(std::span<NumberOrObject> outputs);
     virtual void handle_bind_match_data(const MatchData &md);
+    virtual void handle_bind_profiler(vespalib::ExecutionProfiler &profiler);
 
     /**
      * Execute this feature executor for the given document.
@@ -127,6 +131,13 @@ public:
     void bind_outputs(std::span<NumberOrObject> outputs);
     void bind_match_data(const MatchData &md);
 
+    /**
+     * Bind the profiler used when profiling the rank program this
+     * executor is part of, before any other binding. Executors may
+     * use it to track the cost of their own sub-tasks.
+     **/
+    void bind_profiler(vespalib::ExecutionProfiler &profiler);
+
     const Inputs &inputs() const { return _inputs; }
     const Outputs &outputs() const { return _outputs; }
     Outputs &outputs() { return _outputs; }
@@ -148,6 +159,55 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Check if this feature executor supports batch execution. A
+     * feature executor supporting batch execution must only have
+     * number inputs and outputs and must not look at match data,
+     * since match data only reflects the last unpacked document. This
+     * method is implemented to return false by default.
+     *
+     * @return true if this feature executor supports execute_batch
+     **/
+    virtual bool supports_batch() const;
+
+    /**
+     * Execute this feature executor for a batch of documents. Each
+     * input and output is given as an array with one number per
+     * document in the batch. This function does not touch the values
+     * bound with bind_inputs and bind_outputs. It is only called for
+     * executors claiming to support batch execution.
+     *
+     * @param docids the local document ids being evaluated
+     * @param inputs one array of input values per input
+     * @param outputs one array of output values per output
+     **/
+    virtual void execute_batch(std::span<const uint32_t> docids,
+                               std::span<const feature_t * const> inputs,
+                               std::span<feature_t * const> outputs);
+
+    /**
+     * Check if this feature executor supports prefetching. A feature
+     * executor supporting prefetching is able to calculate its
+     * outputs for multiple documents at once before they are
+     * executed one by one. Since the inputs for all documents are
+     * calculated up front, the executor must only claim to support
+     * prefetching when its inputs do not depend on match data. This
+     * method is implemented to return false by default.
+     *
+     * @return true if this feature executor supports prefetch
+     **/
+    virtual bool supports_prefetch() const;
+
+    /**
+     * Calculate the outputs of this feature executor for the given
+     * documents, to be used when it is later executed for each of
+     * them in the same order. It is only called for executors
+     * claiming to support prefetching.
+     *
+     * @param docids the local document ids about to be evaluated
+     **/
+    virtual void prefetch(std::span<const uint32_t> docids);
+
     /**
      * Make sure this executor has been executed for the given
      * document.
@@ -189,6 +249,10 @@ vespalib::eval::Value::CREF FeatureExecutor::Inputs::get_object(size_t idx) cons
     return _inputs[idx].as_object(_docid);
 }
 
+vespalib::eval::Value::CREF FeatureExecutor::Inputs::get_object(size_t idx, uint32_t docid) const {
+    return _inputs[idx].as_object(docid);
+}
+
 }
 
 //  LocalWords:  param
@@ -311,6 +311,12 @@ Feature::lookup(const Properties &props)
     return lookupStringVector(props, NAME, DEFAULT_VALUE);
 }
 
+const std::string PrecomputeFeatures::NAME("vespa.summary.precompute_features");
+const bool PrecomputeFeatures::DEFAULT_VALUE(false);
+bool PrecomputeFeatures::check(const Properties &props, bool fallback) {
+    return lookupBool(props, NAME, fallback);
+}
+
 } // namespace summary
 
 namespace dump {
@@ -578,6 +584,48 @@ bool SortBlueprintsByCost::check(const Properties &props, bool fallback) {
     return lookupBool(props, NAME, fallback);
 }
 
+const std::string WorkStealing::NAME("vespa.matching.work_stealing");
+const bool WorkStealing::DEFAULT_VALUE(false);
+bool WorkStealing::check(const Properties &props, bool fallback) {
+    return lookupBool(props, NAME, fallback);
+}
+
+const std::string RankScoreThresholdPushdown::NAME("vespa.matching.rank_score_threshold_pushdown");
+const bool RankScoreThresholdPushdown::DEFAULT_VALUE(false);
+bool RankScoreThresholdPushdown::check(const Properties &props, bool fallback) {
+    return lookupBool(props, NAME, fallback);
+}
+
+const std::string FetchPostingsInParallel::NAME("vespa.matching.fetch_postings_in_parallel");
+const bool FetchPostingsInParallel::DEFAULT_VALUE(false);
+bool FetchPostingsInParallel::check(const Properties &props, bool fallback) {
+    return lookupBool(props, NAME, fallback);
+}
+
+const std::string TermwiseCostModel::NAME("vespa.matching.termwise_cost_model");
+const bool TermwiseCostModel::DEFAULT_VALUE(false);
+bool TermwiseCostModel::check(const Properties &props, bool fallback) {
+    return lookupBool(props, NAME, fallback);
+}
+
+const std::string QueryPriority::NAME("vespa.matching.priority");
+const std::string QueryPriority::DEFAULT_VALUE("normal");
+std::string QueryPriority::lookup(const Properties &props, const std::string &defaultValue) {
+    return lookupString(props, NAME, defaultValue);
+}
+
+const std::string ProfileSampleInterval::NAME("vespa.matching.profile.sample_interval");
+const uint32_t ProfileSampleInterval::DEFAULT_VALUE(0);
+uint32_t ProfileSampleInterval::lookup(const Properties &props) {
+    return lookupUint32(props, NAME, DEFAULT_VALUE);
+}
+
+const std::string ProfileSampleDepth::NAME("vespa.matching.profile.sample_depth");
+const uint32_t ProfileSampleDepth::DEFAULT_VALUE(8);
+uint32_t ProfileSampleDepth::lookup(const Properties &props) {
+    return lookupUint32(props, NAME, DEFAULT_VALUE);
+}
+
 } // namespace matching
 
 namespace softtimeout {
@@ -636,6 +684,9 @@ const double DegradationMaxFilterCoverage::DEFAULT_VALUE(0.2);
 const std::string DegradationPostFilterMultiplier::NAME("vespa.matchphase.degradation.postfiltermultiplier");
 const double DegradationPostFilterMultiplier::DEFAULT_VALUE(1.0);
 
+const std::string DegradationAdaptive::NAME("vespa.matchphase.degradation.adaptive");
+const bool DegradationAdaptive::DEFAULT_VALUE(false);
+
 const std::string DiversityAttribute::NAME("vespa.matchphase.diversity.attribute");
 const std::string DiversityAttribute::DEFAULT_VALUE("");
 
@@ -684,6 +735,12 @@ DegradationPostFilterMultiplier::lookup(const Properties &props, double defaultV
     return lookupDouble(props, NAME, defaultValue);
 }
 
+bool
+DegradationAdaptive::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
 std::string
 DiversityAttribute::lookup(const Properties &props, const std::string & defaultValue)
 {
@@ -101,6 +101,18 @@ namespace summary {
         static std::vector<std::string> lookup(const Properties &props);
     };
 
+    /**
+     * Property to compute summary features for the returned hits during
+     * the match phase when the search session is cached, letting docsum
+     * requests for those hits reuse them instead of matching again.
+     **/
+    struct PrecomputeFeatures {
+        static const std::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool check(const Properties &props) { return check(props, DEFAULT_VALUE); }
+        static bool check(const Properties &props, bool fallback);
+    };
+
 } // namespace summary
 
 namespace dump {
@@ -440,6 +452,91 @@ namespace matching {
         static bool check(const Properties &props) { return check(props, DEFAULT_VALUE); }
         static bool check(const Properties &props, bool fallback);
     };
+
+    /**
+     * Property to enable work-stealing between match threads when
+     * distributing the docid space. Takes precedence over the number
+     * of search partitions.
+     **/
+    struct WorkStealing {
+        static const std::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool check(const Properties &props) { return check(props, DEFAULT_VALUE); }
+        static bool check(const Properties &props, bool fallback);
+    };
+
+    /**
+     * Property to let match threads share the lowest first-phase rank
+     * score that can still make the top hits with search iterators
+     * able to skip documents scoring below it (wand and exact nearest
+     * neighbor). This is only correct when the first-phase rank score
+     * is bounded from above by the raw score of these terms, e.g.
+     * 'rawScore(field)' or 'closeness(field)' ranking.
+     **/
+    struct RankScoreThresholdPushdown {
+        static const std::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool check(const Properties &props) { return check(props, DEFAULT_VALUE); }
+        static bool check(const Properties &props, bool fallback);
+    };
+
+    /**
+     * Property to let the dictionary lookups and posting list reads
+     * of simple query terms run in parallel over the threads of the
+     * query before matching starts.
+     **/
+    struct FetchPostingsInParallel {
+        static const std::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool check(const Properties &props) { return check(props, DEFAULT_VALUE); }
+        static bool check(const Properties &props, bool fallback);
+    };
+
+    /**
+     * Property to select termwise evaluation per subtree by comparing
+     * the estimated cost of evaluating it as part of the iterator
+     * tree against evaluating it termwise into a bitvector. When
+     * enabled, the termwise limit is not used.
+     **/
+    struct TermwiseCostModel {
+        static const std::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool check(const Properties &props) { return check(props, DEFAULT_VALUE); }
+        static bool check(const Properties &props, bool fallback);
+    };
+
+    /**
+     * Property for the priority class ("high", "normal" or "low") of a
+     * query when admitted to matching during overload. Low priority
+     * queries are shed first.
+     **/
+    struct QueryPriority {
+        static const std::string NAME;
+        static const std::string DEFAULT_VALUE;
+        static std::string lookup(const Properties &props) { return lookup(props, DEFAULT_VALUE); }
+        static std::string lookup(const Properties &props, const std::string &defaultValue);
+    };
+
+    /**
+     * Property to profile one out of every N queries for a rank
+     * profile and aggregate the resulting match and ranking profiles
+     * on the node. 0 (default) disables sampling.
+     **/
+    struct ProfileSampleInterval {
+        static const std::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+    };
+
+    /**
+     * Property to control the depth of the profiles taken for
+     * sampled queries (see ProfileSampleInterval).
+     **/
+    struct ProfileSampleDepth {
+        static const std::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+    };
 }
 
 namespace softtimeout {
@@ -537,6 +634,18 @@ namespace matchphase {
         static double lookup(const Properties &props, double defaultValue);
     };
 
+    /**
+     * Property for letting the query latency budget (time left until soft
+     * timeout) and the observed match cost per hit lower max hits during
+     * graceful degradation in match phase. Max hits is never raised.
+     **/
+    struct DegradationAdaptive {
+        static const std::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props) { return lookup(props, DEFAULT_VALUE); }
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
+
     /**
      * The name of the attribute used to ensure result diversity
      * during match phase limiting. If this property is "" (empty
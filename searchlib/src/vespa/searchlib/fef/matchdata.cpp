@@ -7,7 +7,8 @@ namespace fef {
 
 MatchData::MatchData(const Params &cparams)
     : _termFields(cparams.numTermFields()),
-      _termwise_limit(1.0)
+      _termwise_limit(1.0),
+      _termwise_cost_model(false)
 {
 }
 
@@ -18,6 +19,7 @@ MatchData::soft_reset()
         tfmd.resetOnlyDocId(TermFieldMatchData::invalidId());
     }
     _termwise_limit = 1.0;
+    _termwise_cost_model = false;
 }
 
 MatchData::UP
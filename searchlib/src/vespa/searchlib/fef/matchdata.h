@@ -18,6 +18,7 @@ class MatchData
 private:
     std::vector<TermFieldMatchData> _termFields;
     double                          _termwise_limit;
+    bool                            _termwise_cost_model;
 
 public:
     /**
@@ -80,6 +81,15 @@ public:
     double get_termwise_limit() const { return _termwise_limit; }
     void set_termwise_limit(double value) { _termwise_limit = value; }
 
+    /**
+     * Whether termwise evaluation should be selected per subtree by
+     * comparing estimated costs (from the flow stats of the query
+     * blueprints) instead of using the termwise limit. The initial
+     * value is false.
+     **/
+    bool use_termwise_cost_model() const { return _termwise_cost_model; }
+    void set_use_termwise_cost_model(bool value) { _termwise_cost_model = value; }
+
     /**
      * Obtain the number of term fields allocated in this match data
      * structure.
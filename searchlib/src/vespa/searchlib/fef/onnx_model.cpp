@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "onnx_model.h"
+#include <algorithm>
 #include <tuple>
 
 namespace search::fef {
@@ -11,7 +12,8 @@ OnnxModel::OnnxModel(const std::string &name_in,
       _file_path(file_path_in),
       _input_features(),
       _output_names(),
-      _dry_run_on_setup(false)
+      _dry_run_on_setup(false),
+      _max_batch_size(1)
 {
 }
 
@@ -38,6 +40,13 @@ OnnxModel::dry_run_on_setup(bool value)
     return *this;
 }
 
+OnnxModel &
+OnnxModel::max_batch_size(uint32_t value)
+{
+    _max_batch_size = std::max(value, 1u);
+    return *this;
+}
+
 std::optional<std::string>
 OnnxModel::input_feature(const std::string &model_input_name) const {
     auto pos = _input_features.find(model_input_name);
@@ -58,8 +67,8 @@ OnnxModel::output_name(const std::string &model_output_name) const {
 
 bool
 OnnxModel::operator==(const OnnxModel &rhs) const {
-    return (std::tie(_name, _file_path, _input_features, _output_names, _dry_run_on_setup) ==
-            std::tie(rhs._name, rhs._file_path, rhs._input_features, rhs._output_names, rhs._dry_run_on_setup));
+    return (std::tie(_name, _file_path, _input_features, _output_names, _dry_run_on_setup, _max_batch_size) ==
+            std::tie(rhs._name, rhs._file_path, rhs._input_features, rhs._output_names, rhs._dry_run_on_setup, rhs._max_batch_size));
 }
 
 }
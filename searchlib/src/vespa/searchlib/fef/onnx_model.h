@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <string>
@@ -20,6 +21,7 @@ private:
     std::map<std::string,std::string> _input_features;
     std::map<std::string,std::string> _output_names;
     bool _dry_run_on_setup;
+    uint32_t _max_batch_size;
 
 public:
     OnnxModel(const std::string &name_in,
@@ -35,9 +37,11 @@ public:
     OnnxModel &input_feature(const std::string &model_input_name, const std::string &input_feature);
     OnnxModel &output_name(const std::string &model_output_name, const std::string &output_name);
     OnnxModel &dry_run_on_setup(bool value);
+    OnnxModel &max_batch_size(uint32_t value);
     std::optional<std::string> input_feature(const std::string &model_input_name) const;
     std::optional<std::string> output_name(const std::string &model_output_name) const;
     bool dry_run_on_setup() const { return _dry_run_on_setup; }
+    uint32_t max_batch_size() const { return _max_batch_size; }
     bool operator==(const OnnxModel &rhs) const;
     const std::map<std::string,std::string> &inspect_input_features() const { return _input_features; }
     const std::map<std::string,std::string> &inspect_output_names() const { return _output_names; }
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "onnx_models.h"
+#include <algorithm>
 #include <cassert>
 
 namespace search::fef {
@@ -44,6 +45,7 @@ OnnxModels::configure(const ModelConfig &config, Model &model)
         model.output_name(output.name, output.as);
     }
     model.dry_run_on_setup(config.dryRunOnSetup);
+    model.max_batch_size(std::max(config.maxBatchSize, 1));
 }
 
 }
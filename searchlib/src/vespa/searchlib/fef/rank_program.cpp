@@ -2,6 +2,7 @@
 
 #include "rank_program.h"
 #include "featureoverrider.h"
+#include "rank_program_shape_cache.h"
 #include "blueprint.h"
 #include <vespa/vespalib/locale/c.h>
 #include <vespa/eval/eval/fast_value.h>
@@ -123,6 +124,14 @@ struct ProfiledExecutor : FeatureExecutor {
     bool isPure() override {
         return executor.isPure();
     }
+    bool supports_prefetch() const override {
+        return executor.supports_prefetch();
+    }
+    void prefetch(std::span<const uint32_t> docids) override {
+        profiler.start(self);
+        executor.prefetch(docids);
+        profiler.complete();
+    }
     void execute(uint32_t docId) override {
         profiler.start(self);
         executor.lazy_execute(docId);
@@ -217,13 +226,83 @@ RankProgram::resolve(const BlueprintResolver::FeatureMap &features, bool unbox_s
     return result;
 }
 
+void
+RankProgram::setup_batch()
+{
+    const auto &specs = _resolver->getExecutorSpecs();
+    const auto &seeds = _resolver->getSeedMap();
+    if ((seeds.size() != 1) || specs[seeds.begin()->second.executor].output_types[seeds.begin()->second.output].is_object()) {
+        return;
+    }
+    std::vector<bool> needed(specs.size(), false);
+    needed[seeds.begin()->second.executor] = true;
+    auto is_const_executor = [this](size_t i) {
+        const auto &outputs = _executors[i]->outputs();
+        return ((outputs.size() == 0) || check_const(outputs.get_raw(0)));
+    };
+    for (size_t i = specs.size(); i-- > 0; ) {
+        if (needed[i] && !is_const_executor(i)) {
+            if (!_executors[i]->supports_batch()) {
+                return;
+            }
+            for (const auto &ref: specs[i].inputs) {
+                if (specs[ref.executor].output_types[ref.output].is_object()) {
+                    return;
+                }
+                needed[ref.executor] = true;
+            }
+        }
+    }
+    std::vector<std::span<feature_t *>> values(specs.size());
+    for (size_t i = 0; i < specs.size(); ++i) {
+        if (!needed[i]) {
+            continue;
+        }
+        const auto &outputs = _executors[i]->outputs();
+        values[i] = _hot_stash.create_array<feature_t *>(outputs.size(), nullptr);
+        for (size_t out_idx = 0; out_idx < outputs.size(); ++out_idx) {
+            if (specs[i].output_types[out_idx].is_object()) {
+                continue;
+            }
+            std::span<feature_t> array = _hot_stash.create_array<feature_t>(BATCH_SIZE);
+            if (check_const(outputs.get_raw(out_idx))) {
+                std::fill(array.begin(), array.end(), outputs.get_number(out_idx));
+            }
+            values[i][out_idx] = array.data();
+        }
+        if (!is_const_executor(i)) {
+            std::span<const feature_t *> inputs = _hot_stash.create_array<const feature_t *>(specs[i].inputs.size(), nullptr);
+            for (size_t input_idx = 0; input_idx < inputs.size(); ++input_idx) {
+                auto ref = specs[i].inputs[input_idx];
+                inputs[input_idx] = values[ref.executor][ref.output];
+            }
+            _batch_steps.push_back(BatchStep{_executors[i], inputs, values[i]});
+        }
+    }
+    _batch_seed = values[seeds.begin()->second.executor][seeds.begin()->second.output];
+}
+
 RankProgram::RankProgram(BlueprintResolver::SP resolver)
+    : RankProgram(std::move(resolver), nullptr)
+{
+}
+
+RankProgram::RankProgram(BlueprintResolver::SP resolver, vespalib::StashChunkPool *chunk_pool)
+    : RankProgram(std::move(resolver), chunk_pool, nullptr)
+{
+}
+
+RankProgram::RankProgram(BlueprintResolver::SP resolver, vespalib::StashChunkPool *chunk_pool, RankProgramShapeCache *shape_cache)
     : _resolver(std::move(resolver)),
-      _hot_stash(32_Ki),
-      _cold_stash(),
+      _shape_cache(shape_cache),
+      _hot_stash(chunk_pool ? vespalib::Stash(*chunk_pool) : vespalib::Stash(32_Ki)),
+      _cold_stash(chunk_pool ? vespalib::Stash(*chunk_pool) : vespalib::Stash()),
       _executors(),
       _unboxed_seeds(),
-      _is_const()
+      _is_const(),
+      _batch_steps(),
+      _batch_seed(nullptr),
+      _prefetch_executors()
 {
 }
 
@@ -240,19 +319,39 @@ RankProgram::setup(const MatchData &md,
     std::vector<Override> overrides = prepare_overrides(specs, _resolver->getFeatureMap(), featureOverrides);
     auto override = overrides.begin();
     auto override_end = overrides.end();
+    std::string shape_key;
+    std::shared_ptr<const RankProgramShapeCache::ConstExecutors> const_hints;
+    if (_shape_cache != nullptr) {
+        shape_key = RankProgramShapeCache::make_key(md, featureOverrides);
+        const_hints = _shape_cache->lookup(shape_key);
+        if (const_hints && (const_hints->size() != specs.size())) {
+            const_hints.reset();
+        }
+    }
+    RankProgramShapeCache::ConstExecutors const_executors;
 
     _executors.reserve(specs.size());
     _is_const.resize(specs.size()*2); // Reserve space in hashmap for executors to be const
     for (uint32_t i = 0; i < specs.size(); ++i) {
         std::span<NumberOrObject> outputs = _hot_stash.create_array<NumberOrObject>(specs[i].output_types.size());
         StashSelector stash(_hot_stash, _cold_stash);
+        bool expect_const = const_hints && (*const_hints)[i];
+        if (expect_const) {
+            stash.use_secondary();
+        }
         FeatureExecutor *executor = &(specs[i].blueprint->createExecutor(queryEnv, stash.get()));
         bool is_const = check_const(executor, specs[i].inputs);
-        if (is_const) {
+        if (is_const && !expect_const) {
             stash.use_secondary();
             executor = &(specs[i].blueprint->createExecutor(queryEnv, stash.get()));
             is_const = executor->isPure();
         }
+        if (_shape_cache != nullptr) {
+            const_executors.push_back(is_const);
+        }
+        if (profiler) {
+            executor->bind_profiler(*profiler);
+        }
         size_t num_inputs = specs[i].inputs.size();
         std::span<LazyValue> inputs = stash.get().create_array<LazyValue>(num_inputs, nullptr);
         for (size_t input_idx = 0; input_idx < num_inputs; ++input_idx) {
@@ -288,6 +387,18 @@ RankProgram::setup(const MatchData &md,
         }
     }
     assert(_executors.size() == specs.size());
+    for (FeatureExecutor *executor: _executors) {
+        const auto &outputs = executor->outputs();
+        if ((outputs.size() > 0) && !check_const(outputs.get_raw(0)) && executor->supports_prefetch()) {
+            _prefetch_executors.push_back(executor);
+        }
+    }
+    if (profiler == nullptr) {
+        setup_batch();
+    }
+    if ((_shape_cache != nullptr) && !const_hints) {
+        _shape_cache->insert(shape_key, std::move(const_executors));
+    }
     LOG(debug, "Num executors = %ld, hot stash = %ld, cold stash = %ld, match data fields = %d",
                _executors.size(), _hot_stash.count_used(), _cold_stash.count_used(), md.getNumTermFields());
     if (LOG_WOULD_LOG(debug)) {
@@ -318,4 +429,22 @@ RankProgram::get_all_features(bool unbox_seeds) const
     return resolve(_resolver->getFeatureMap(), unbox_seeds);
 }
 
+void
+RankProgram::execute_batch(std::span<const uint32_t> docids, std::span<feature_t> scores)
+{
+    assert(supports_batch() && (docids.size() <= BATCH_SIZE) && (scores.size() >= docids.size()));
+    for (const auto &step: _batch_steps) {
+        step.executor->execute_batch(docids, step.inputs, step.outputs);
+    }
+    std::copy(_batch_seed, _batch_seed + docids.size(), scores.begin());
+}
+
+void
+RankProgram::prefetch(std::span<const uint32_t> docids)
+{
+    for (FeatureExecutor *executor: _prefetch_executors) {
+        executor->prefetch(docids);
+    }
+}
+
 }
@@ -16,6 +16,7 @@ namespace vespalib { class ExecutionProfiler; }
 namespace search::fef {
 
 class IQueryEnvironment;
+class RankProgramShapeCache;
 
 /**
  * A rank program is able to lazily calculate a set of feature
@@ -30,25 +31,36 @@ class IQueryEnvironment;
 class RankProgram
 {
 private:
+    struct BatchStep {
+        FeatureExecutor                 *executor;
+        std::span<const feature_t *>     inputs;
+        std::span<feature_t *>           outputs;
+    };
     using MappedValues = std::map<const NumberOrObject *, LazyValue>;
     using ValueSet = vespalib::hash_set<const NumberOrObject *, vespalib::hash<const NumberOrObject *>,
                                         std::equal_to<>, vespalib::hashtable_base::and_modulator>;
 
     BlueprintResolver::SP            _resolver;
+    RankProgramShapeCache           *_shape_cache;
     vespalib::Stash                  _hot_stash;
     vespalib::Stash                  _cold_stash;
     std::vector<FeatureExecutor *>   _executors;
     MappedValues                     _unboxed_seeds;
     ValueSet                         _is_const;
+    std::vector<BatchStep>           _batch_steps;
+    const feature_t                 *_batch_seed;
+    std::vector<FeatureExecutor *>   _prefetch_executors;
 
     bool check_const(const NumberOrObject *value) const { return (_is_const.count(value) == 1); }
     bool check_const(FeatureExecutor *executor, const std::vector<BlueprintResolver::FeatureRef> &inputs) const;
     void run_const(FeatureExecutor *executor);
     void unbox(BlueprintResolver::FeatureRef seed, const MatchData &md);
     FeatureResolver resolve(const BlueprintResolver::FeatureMap &features, bool unbox_seeds) const;
+    void setup_batch();
 
 public:
     using UP = std::unique_ptr<RankProgram>;
+    static constexpr size_t BATCH_SIZE = 64;
     RankProgram(const RankProgram &) = delete;
     RankProgram &operator=(const RankProgram &) = delete;
 
@@ -58,6 +70,27 @@ public:
      * @param resolver description on how to set up executors
      **/
     RankProgram(BlueprintResolver::SP resolver);
+
+    /**
+     * Create a new rank program whose executors and feature values
+     * are stored in memory chunks taken from the given pool (when
+     * not null). The pool must outlive the rank program.
+     *
+     * @param resolver description on how to set up executors
+     * @param chunk_pool where to get stash memory from
+     **/
+    RankProgram(BlueprintResolver::SP resolver, vespalib::StashChunkPool *chunk_pool);
+
+    /**
+     * Create a new rank program that uses (and fills) the given shape
+     * cache (when not null) to avoid creating executors that turn out
+     * to be constant twice. The cache must outlive the rank program.
+     *
+     * @param resolver description on how to set up executors
+     * @param chunk_pool where to get stash memory from
+     * @param shape_cache constant executors seen for earlier query shapes
+     **/
+    RankProgram(BlueprintResolver::SP resolver, vespalib::StashChunkPool *chunk_pool, RankProgramShapeCache *shape_cache);
     ~RankProgram();
 
     size_t num_executors() const { return _executors.size(); }
@@ -91,6 +124,42 @@ public:
      * @params unbox_seeds make sure seeds values are numbers
      **/
     FeatureResolver get_all_features(bool unbox_seeds = true) const;
+
+    /**
+     * Check if the single seed of this rank program can be calculated
+     * for multiple documents at a time using execute_batch. This is
+     * the case when all non-constant executors the seed depends on
+     * support batch execution.
+     **/
+    bool supports_batch() const { return (_batch_seed != nullptr); }
+
+    /**
+     * Calculate the single seed of this rank program for a batch of
+     * at most BATCH_SIZE documents. Since batch executors do not look
+     * at match data, documents do not need to be unpacked in between.
+     *
+     * @param docids the local document ids being evaluated
+     * @param scores where to store the seed value for each document
+     **/
+    void execute_batch(std::span<const uint32_t> docids, std::span<feature_t> scores);
+
+    /**
+     * Check if any of the executors in this rank program are able to
+     * calculate their outputs for multiple documents up front (see
+     * FeatureExecutor::prefetch).
+     **/
+    bool supports_prefetch() const { return !_prefetch_executors.empty(); }
+
+    /**
+     * Let all executors supporting prefetching calculate their
+     * outputs for the given documents. The documents must be
+     * evaluated afterwards in the same (increasing) order. Executors
+     * only support prefetching when their inputs do not depend on
+     * match data, so documents do not need to be unpacked first.
+     *
+     * @param docids the local document ids about to be evaluated
+     **/
+    void prefetch(std::span<const uint32_t> docids);
 };
 
 }
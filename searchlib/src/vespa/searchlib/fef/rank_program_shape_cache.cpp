@@ -0,0 +1,74 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "rank_program_shape_cache.h"
+#include "matchdata.h"
+#include "properties.h"
+#include <vespa/vespalib/stllike/hash_map.hpp>
+
+namespace search::fef {
+
+namespace {
+
+struct KeyBuilder : public IPropertiesVisitor {
+    std::string &key;
+    explicit KeyBuilder(std::string &key_in) noexcept : key(key_in) {}
+    void visitProperty(const Property::Value &name, const Property &) override {
+        // Keys are visited in sorted order
+        key.push_back('\n');
+        key.append(name);
+    }
+};
+
+}
+
+RankProgramShapeCache::RankProgramShapeCache(size_t max_shapes)
+    : _lock(),
+      _shapes(),
+      _max_shapes(max_shapes),
+      _hits(0),
+      _misses(0)
+{
+}
+
+RankProgramShapeCache::~RankProgramShapeCache() = default;
+
+std::string
+RankProgramShapeCache::make_key(const MatchData &md, const Properties &featureOverrides)
+{
+    std::string key = std::to_string(md.getNumTermFields());
+    KeyBuilder builder(key);
+    featureOverrides.visitProperties(builder);
+    return key;
+}
+
+std::shared_ptr<const RankProgramShapeCache::ConstExecutors>
+RankProgramShapeCache::lookup(const std::string &key) const
+{
+    std::lock_guard guard(_lock);
+    auto pos = _shapes.find(key);
+    if (pos == _shapes.end()) {
+        _misses.fetch_add(1, std::memory_order_relaxed);
+        return {};
+    }
+    _hits.fetch_add(1, std::memory_order_relaxed);
+    return pos->second;
+}
+
+void
+RankProgramShapeCache::insert(const std::string &key, ConstExecutors const_executors)
+{
+    auto shape = std::make_shared<const ConstExecutors>(std::move(const_executors));
+    std::lock_guard guard(_lock);
+    if (_shapes.size() < _max_shapes) {
+        _shapes.insert(std::make_pair(key, std::move(shape)));
+    }
+}
+
+size_t
+RankProgramShapeCache::size() const
+{
+    std::lock_guard guard(_lock);
+    return _shapes.size();
+}
+
+}
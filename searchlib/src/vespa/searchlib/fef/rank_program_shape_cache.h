@@ -0,0 +1,64 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace search::fef {
+
+class MatchData;
+class Properties;
+
+/**
+ * Remembers which executors of a rank program turned out to be
+ * constant for a given query shape, i.e. the number of term fields in
+ * the match data and the set of feature override keys. A rank program
+ * set up for a known shape creates the executors expected to be
+ * constant directly in its cold stash, instead of creating them first
+ * in the hot stash only to throw them away. The hints are verified
+ * while setting up, so a query with the same shape but different
+ * constness only loses the benefit.
+ *
+ * Executors are bound to the query environment and match data of a
+ * single query, so they can not be shared between rank programs.
+ *
+ * There is one cache per blueprint resolver (rank profile and phase).
+ * It is thread-safe and holds a bounded number of shapes; new shapes
+ * are not remembered when it is full.
+ **/
+class RankProgramShapeCache
+{
+public:
+    using ConstExecutors = std::vector<bool>;
+    static constexpr size_t DEFAULT_MAX_SHAPES = 256;
+
+private:
+    using Shapes = vespalib::hash_map<std::string, std::shared_ptr<const ConstExecutors>>;
+    mutable std::mutex          _lock;
+    Shapes                      _shapes;
+    size_t                      _max_shapes;
+    mutable std::atomic<size_t> _hits;
+    mutable std::atomic<size_t> _misses;
+
+public:
+    explicit RankProgramShapeCache(size_t max_shapes = DEFAULT_MAX_SHAPES);
+    RankProgramShapeCache(const RankProgramShapeCache &) = delete;
+    RankProgramShapeCache &operator=(const RankProgramShapeCache &) = delete;
+    ~RankProgramShapeCache();
+
+    static std::string make_key(const MatchData &md, const Properties &featureOverrides);
+
+    std::shared_ptr<const ConstExecutors> lookup(const std::string &key) const;
+    void insert(const std::string &key, ConstExecutors const_executors);
+
+    size_t size() const;
+    size_t hits() const noexcept { return _hits.load(std::memory_order_relaxed); }
+    size_t misses() const noexcept { return _misses.load(std::memory_order_relaxed); }
+};
+
+}
@@ -37,6 +37,10 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _match_resolver(std::make_shared<BlueprintResolver>(factory, indexEnv)),
       _summary_resolver(std::make_shared<BlueprintResolver>(factory, indexEnv)),
       _dumpResolver(std::make_shared<BlueprintResolver>(factory, indexEnv)),
+      _first_phase_shapes(std::make_unique<RankProgramShapeCache>()),
+      _second_phase_shapes(std::make_unique<RankProgramShapeCache>()),
+      _match_shapes(std::make_unique<RankProgramShapeCache>()),
+      _summary_shapes(std::make_unique<RankProgramShapeCache>()),
       _firstPhaseRankFeature(),
       _secondPhaseRankFeature(),
       _degradationAttribute(),
@@ -52,6 +56,7 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
       _degradationMaxFilterCoverage(1.0),
       _degradationSamplePercentage(0.2),
       _degradationPostFilterMultiplier(1.0),
+      _degradationAdaptive(false),
       _first_phase_rank_score_drop_limit(),
       _second_phase_rank_score_drop_limit(),
       _match_features(),
@@ -121,6 +126,7 @@ RankSetup::configure()
     setDegradationMaxFilterCoverage(matchphase::DegradationMaxFilterCoverage::lookup(_indexEnv.getProperties()));
     setDegradationSamplePercentage(matchphase::DegradationSamplePercentage::lookup(_indexEnv.getProperties()));
     setDegradationPostFilterMultiplier(matchphase::DegradationPostFilterMultiplier::lookup(_indexEnv.getProperties()));
+    setDegradationAdaptive(matchphase::DegradationAdaptive::lookup(_indexEnv.getProperties()));
     setDiversityAttribute(matchphase::DiversityAttribute::lookup(_indexEnv.getProperties()));
     setDiversityMinGroups(matchphase::DiversityMinGroups::lookup(_indexEnv.getProperties()));
     setDiversityCutoffFactor(matchphase::DiversityCutoffFactor::lookup(_indexEnv.getProperties()));
@@ -7,6 +7,7 @@
 #include "iqueryenvironment.h"
 #include "blueprintresolver.h"
 #include "rank_program.h"
+#include "rank_program_shape_cache.h"
 #include <vespa/searchlib/common/stringmap.h>
 #include <vespa/vespalib/fuzzy/fuzzy_matching_algorithm.h>
 #include <optional>
@@ -46,6 +47,10 @@ private:
     BlueprintResolver::SP    _match_resolver;
     BlueprintResolver::SP    _summary_resolver;
     BlueprintResolver::SP    _dumpResolver;
+    std::unique_ptr<RankProgramShapeCache> _first_phase_shapes;
+    std::unique_ptr<RankProgramShapeCache> _second_phase_shapes;
+    std::unique_ptr<RankProgramShapeCache> _match_shapes;
+    std::unique_ptr<RankProgramShapeCache> _summary_shapes;
     std::string         _firstPhaseRankFeature;
     std::string         _secondPhaseRankFeature;
     std::string         _degradationAttribute;
@@ -61,6 +66,7 @@ private:
     double                   _degradationMaxFilterCoverage;
     double                   _degradationSamplePercentage;
     double                   _degradationPostFilterMultiplier;
+    bool                     _degradationAdaptive;
     std::optional<feature_t> _first_phase_rank_score_drop_limit;
     std::optional<feature_t> _second_phase_rank_score_drop_limit;
     std::vector<std::string> _match_features;
@@ -246,6 +252,9 @@ public:
         return _degradationPostFilterMultiplier;
     }
 
+    /** check whether max hits should adapt to the time left for the query during graceful degradation in match phase */
+    bool isDegradationAdaptive() const { return _degradationAdaptive; }
+
     /** get the attribute used to ensure diversity during match phase limiting **/
     std::string getDiversityAttribute() const {
         return _diversityAttribute;
@@ -291,6 +300,9 @@ public:
         _degradationPostFilterMultiplier = samplePercentage;
     }
 
+    /** set whether max hits should adapt to the time left for the query during graceful degradation in match phase */
+    void setDegradationAdaptive(bool adaptive) { _degradationAdaptive = adaptive; }
+
     /** set the attribute used to ensure diversity during match phase limiting **/
     void setDiversityAttribute(const std::string &value) {
         _diversityAttribute = value;
@@ -462,13 +474,17 @@ public:
     // These functions create rank programs for different tasks. Note
     // that the setup function must be called on rank programs for
     // them to be ready to use. Also keep in mind that creating a rank
-    // program is cheap while setting it up is more expensive.
-
-    RankProgram::UP create_first_phase_program() const { return std::make_unique<RankProgram>(_first_phase_resolver); }
-    RankProgram::UP create_second_phase_program() const { return std::make_unique<RankProgram>(_second_phase_resolver); }
-    RankProgram::UP create_match_program() const { return std::make_unique<RankProgram>(_match_resolver); }
-    RankProgram::UP create_summary_program() const { return std::make_unique<RankProgram>(_summary_resolver); }
-    RankProgram::UP create_dump_program() const { return std::make_unique<RankProgram>(_dumpResolver); }
+    // program is cheap while setting it up is more expensive. A
+    // chunk pool may be given to recycle rank program memory across
+    // queries. The programs share a shape cache per phase, making
+    // setup cheaper for repeated query shapes.
+
+    using ChunkPool = vespalib::StashChunkPool;
+    RankProgram::UP create_first_phase_program(ChunkPool *pool = nullptr) const { return std::make_unique<RankProgram>(_first_phase_resolver, pool, _first_phase_shapes.get()); }
+    RankProgram::UP create_second_phase_program(ChunkPool *pool = nullptr) const { return std::make_unique<RankProgram>(_second_phase_resolver, pool, _second_phase_shapes.get()); }
+    RankProgram::UP create_match_program(ChunkPool *pool = nullptr) const { return std::make_unique<RankProgram>(_match_resolver, pool, _match_shapes.get()); }
+    RankProgram::UP create_summary_program(ChunkPool *pool = nullptr) const { return std::make_unique<RankProgram>(_summary_resolver, pool, _summary_shapes.get()); }
+    RankProgram::UP create_dump_program(ChunkPool *pool = nullptr) const { return std::make_unique<RankProgram>(_dumpResolver, pool); }
 
     /**
      * Here you can do some preprocessing. State must be stored in the IObjectStore.
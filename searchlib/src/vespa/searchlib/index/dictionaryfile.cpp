@@ -2,6 +2,7 @@
 
 #include "dictionaryfile.h"
 #include <vespa/fastos/file.h>
+#include <cassert>
 
 namespace search::index {
 
@@ -16,6 +17,27 @@ DictionaryFileRandRead::DictionaryFileRandRead()
 
 DictionaryFileRandRead::~DictionaryFileRandRead() = default;
 
+void
+DictionaryFileRandRead::lookup_many(const std::vector<std::string_view>& words,
+                                    std::vector<DictionaryLookupResult>& results)
+{
+    results.clear();
+    results.resize(words.size());
+    PostingListOffsetAndCounts offset_and_counts;
+    for (size_t i = 0; i < words.size(); ++i) {
+        auto& result = results[i];
+        if (i > 0 && words[i] == words[i - 1]) {
+            result = results[i - 1];
+            continue;
+        }
+        assert(i == 0 || words[i - 1] < words[i]);
+        offset_and_counts._counts.clear();
+        lookup(words[i], result.wordNum, offset_and_counts);
+        result.counts.swap(offset_and_counts._counts);
+        result.bitOffset = offset_and_counts._offset;
+    }
+}
+
 void
 DictionaryFileRandRead::afterOpen(FastOS_FileInterface &file)
 {
@@ -1,10 +1,13 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "dictionary_lookup_result.h"
 #include "postinglisthandle.h"
 #include "postinglistcountfile.h"
 #include <vespa/searchlib/common/tunefileinfo.h>
 #include <limits>
+#include <string_view>
+#include <vector>
 
 class FastOS_FileInterface;
 
@@ -62,6 +65,14 @@ public:
     virtual bool lookup(std::string_view word, uint64_t &wordNum,
                         PostingListOffsetAndCounts &offsetAndCounts) = 0;
 
+    /**
+     * Lookup a batch of words, sorted in ascending order. Repeated words
+     * are only looked up once. Results are returned in the same order as
+     * the words.
+     */
+    virtual void lookup_many(const std::vector<std::string_view>& words,
+                             std::vector<DictionaryLookupResult>& results);
+
     /**
      * Open dictionary file for random read.
      */
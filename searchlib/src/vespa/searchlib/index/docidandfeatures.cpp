@@ -14,6 +14,7 @@ DocIdAndFeatures::DocIdAndFeatures()
       _blob(),
       _bit_offset(0u),
       _bit_length(0u),
+      _max_element_weight(std::numeric_limits<int32_t>::max()),
       _has_raw_data(false)
 {
 }
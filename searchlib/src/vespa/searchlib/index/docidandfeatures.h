@@ -2,8 +2,9 @@
 #pragma once
 
 #include <vespa/searchlib/common/fslimits.h>
-#include <vector>
 #include <cstdint>
+#include <limits>
+#include <vector>
 
 namespace search::index {
 
@@ -104,6 +105,7 @@ protected:
     RawData  _blob; // Feature data for (word, docid) pair
     uint32_t _bit_offset; // Offset of feature start ([0..63])
     uint32_t _bit_length; // Length of features
+    int32_t  _max_element_weight; // Max element weight, only tracked for raw data
     bool     _has_raw_data;
 
 public:
@@ -119,6 +121,7 @@ public:
         _word_positions.clear();
         _bit_offset = 0u;
         _bit_length = 0u;
+        _max_element_weight = std::numeric_limits<int32_t>::max();
         _blob.clear();
     }
 
@@ -127,6 +130,7 @@ public:
         _word_positions.clear();
         _bit_offset = bit_offset;
         _bit_length = 0u;
+        _max_element_weight = std::numeric_limits<int32_t>::max();
         _blob.clear();
     }
 
@@ -159,6 +163,8 @@ public:
     uint32_t bit_offset() const { return _bit_offset; }
     uint32_t bit_length() const { return _bit_length; }
     void set_bit_length(uint32_t val) { _bit_length = val; }
+    int32_t max_element_weight() const { return _max_element_weight; }
+    void set_max_element_weight(int32_t val) { _max_element_weight = val; }
     bool has_raw_data() const { return _has_raw_data; }
     void set_has_raw_data(bool val) { _has_raw_data = val; }
 };
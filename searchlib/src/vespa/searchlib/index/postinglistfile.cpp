@@ -74,6 +74,14 @@ PostingListFileRandRead()
 
 PostingListFileRandRead::~PostingListFileRandRead() = default;
 
+vespalib::coro::Lazy<PostingListHandle>
+PostingListFileRandRead::async_read_posting_list(vespalib::coro::AsyncIo& async_io,
+                                                 const DictionaryLookupResult& lookup_result)
+{
+    (void) async_io;
+    co_return read_posting_list(lookup_result);
+}
+
 void
 PostingListFileRandRead::afterOpen(FastOS_FileInterface &file)
 {
@@ -110,6 +118,13 @@ PostingListFileRandReadPassThrough::read_posting_list(const DictionaryLookupResu
     return _lower->read_posting_list(lookup_result);
 }
 
+vespalib::coro::Lazy<PostingListHandle>
+PostingListFileRandReadPassThrough::async_read_posting_list(vespalib::coro::AsyncIo& async_io,
+                                                            const DictionaryLookupResult& lookup_result)
+{
+    return _lower->async_read_posting_list(async_io, lookup_result);
+}
+
 void
 PostingListFileRandReadPassThrough::consider_trim_posting_list(const DictionaryLookupResult &lookup_result,
                                                                PostingListHandle &handle, double bloat_factor) const
@@ -6,10 +6,13 @@
 #include "postinglistcounts.h"
 #include "postinglisthandle.h"
 #include <vespa/searchlib/common/tunefileinfo.h>
+#include <vespa/vespalib/coro/lazy.h>
 #include <string>
 
 class FastOS_FileInterface;
 
+namespace vespalib::coro { struct AsyncIo; }
+
 namespace search::common { class FileHeaderContext; }
 namespace search::fef { class TermFieldMatchDataArray; }
 namespace search::queryeval { class SearchIterator; }
@@ -162,6 +165,14 @@ public:
      */
     virtual PostingListHandle read_posting_list(const DictionaryLookupResult& lookup_result) = 0;
 
+    /**
+     * Read posting list into handle using async io. Default implementation
+     * performs a synchronous read. Lifetime of async_io and lookup_result
+     * must exceed the lifetime of the returned coroutine.
+     */
+    virtual vespalib::coro::Lazy<PostingListHandle>
+    async_read_posting_list(vespalib::coro::AsyncIo& async_io, const DictionaryLookupResult& lookup_result);
+
     /**
      * Remove directio padding from posting list if bloat is excessive.
      */
@@ -207,6 +218,8 @@ public:
                    const search::fef::TermFieldMatchDataArray &matchData) const override;
 
     PostingListHandle read_posting_list(const DictionaryLookupResult& lookup_result) override;
+    vespalib::coro::Lazy<PostingListHandle>
+    async_read_posting_list(vespalib::coro::AsyncIo& async_io, const DictionaryLookupResult& lookup_result) override;
     void consider_trim_posting_list(const DictionaryLookupResult &lookup_result, PostingListHandle &handle,
                                     double bloat_factor) const override;
     PostingListFileRange get_posting_list_file_range(const DictionaryLookupResult& lookup_result) const override;
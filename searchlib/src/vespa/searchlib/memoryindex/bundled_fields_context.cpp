@@ -7,7 +7,9 @@ namespace search::memoryindex {
 BundledFieldsContext::BundledFieldsContext(vespalib::ISequencedTaskExecutor::ExecutorId id)
     : _id(id),
       _fields(),
-      _uri_fields()
+      _uri_fields(),
+      _uri_all_field_ids(),
+      _shard(0)
 {
 }
 
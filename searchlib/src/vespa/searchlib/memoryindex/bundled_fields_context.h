@@ -10,6 +10,10 @@ namespace search::memoryindex {
  * Base class for PushContext and InvertContext, with mapping to
  * the fields and uri fields handled by this context. Fields using
  * the same thread appear in the same context.
+ *
+ * When inversion of text fields is sharded by document, each invert
+ * context handles the documents belonging to a single shard. Uri fields
+ * are not sharded and only appear in contexts for shard 0.
  */
 class BundledFieldsContext
 {
@@ -17,6 +21,7 @@ class BundledFieldsContext
     std::vector<uint32_t>                        _fields;
     std::vector<uint32_t>                        _uri_fields;
     std::vector<uint32_t>                        _uri_all_field_ids;
+    uint32_t                                     _shard;
 protected:
     BundledFieldsContext(vespalib::ISequencedTaskExecutor::ExecutorId id);
     ~BundledFieldsContext();
@@ -24,6 +29,8 @@ public:
     void add_field(uint32_t field_id);
     void add_uri_field(uint32_t uri_field_id, uint32_t uri_all_field_id);
     void set_id(vespalib::ISequencedTaskExecutor::ExecutorId id) { _id = id; }
+    void set_shard(uint32_t shard) noexcept { _shard = shard; }
+    uint32_t get_shard() const noexcept { return _shard; }
     vespalib::ISequencedTaskExecutor::ExecutorId get_id() const noexcept { return _id; }
     const std::vector<uint32_t>& get_fields() const noexcept { return _fields; }
     const std::vector<uint32_t>& get_uri_fields() const noexcept { return _uri_fields; }
@@ -25,17 +25,34 @@ using vespalib::RetainGuard;
 DocumentInverter::DocumentInverter(DocumentInverterContext& context)
     : _context(context),
       _inverters(),
+      _shard_inverters(),
       _urlInverters()
 {
     auto& schema = context.get_schema();
     auto& field_indexes = context.get_field_indexes();
+    auto& schema_index_fields = context.get_schema_index_fields();
+    uint32_t num_shards = context.get_num_field_shards();
+    std::vector<bool> sharded(schema.getNumIndexFields(), false);
+    if (num_shards > 1) {
+        for (auto field_id : schema_index_fields._textFields) {
+            sharded[field_id] = true;
+        }
+    }
     for (uint32_t fieldId = 0; fieldId < schema.getNumIndexFields(); ++fieldId) {
         auto &remover(field_indexes.get_remover(fieldId));
         auto &inserter(field_indexes.get_inserter(fieldId));
         auto &calculator(field_indexes.get_calculator(fieldId));
-        _inverters.push_back(std::make_unique<FieldInverter>(schema, fieldId, remover, inserter, calculator));
+        _inverters.push_back(std::make_unique<FieldInverter>(schema, fieldId, remover, inserter, calculator, sharded[fieldId]));
+    }
+    for (uint32_t shard = 1; shard < num_shards; ++shard) {
+        auto& inverters = _shard_inverters.emplace_back(schema.getNumIndexFields());
+        for (auto field_id : schema_index_fields._textFields) {
+            auto &remover(field_indexes.get_remover(field_id));
+            auto &inserter(field_indexes.get_inserter(field_id));
+            auto &calculator(field_indexes.get_calculator(field_id));
+            inverters[field_id] = std::make_unique<FieldInverter>(schema, field_id, remover, inserter, calculator, true);
+        }
     }
-    auto& schema_index_fields = context.get_schema_index_fields();
     for (auto &urlField : schema_index_fields._uriFields) {
         Schema::CollectionType collectionType =
             schema.getIndexField(urlField._all).getCollectionType();
@@ -62,9 +79,13 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc, const OnWr
 {
     auto& invert_threads = _context.get_invert_threads();
     auto& invert_contexts = _context.get_invert_contexts();
+    uint32_t shard = _context.get_field_shard(docId);
     for (auto& invert_context : invert_contexts) {
+        if (invert_context.get_shard() != shard && invert_context.get_uri_fields().empty()) {
+            continue; // Document belongs to another shard
+        }
         auto id = invert_context.get_id();
-        auto task = std::make_unique<InvertTask>(_context, invert_context, _inverters, _urlInverters, docId, doc, on_write_done);
+        auto task = std::make_unique<InvertTask>(_context, invert_context, get_shard_inverters(invert_context.get_shard()), _urlInverters, docId, doc, on_write_done);
         invert_threads.executeTask(id, std::move(task));
     }
 }
@@ -82,7 +103,7 @@ DocumentInverter::removeDocuments(LidVector lids)
     auto& invert_contexts = _context.get_invert_contexts();
     for (auto& invert_context : invert_contexts) {
         auto id = invert_context.get_id();
-        auto task = std::make_unique<RemoveTask>(invert_context, _inverters, _urlInverters, lids);
+        auto task = std::make_unique<RemoveTask>(_context, invert_context, get_shard_inverters(invert_context.get_shard()), _urlInverters, lids);
         invert_threads.executeTask(id, std::move(task));
     }
 }
@@ -96,7 +117,7 @@ DocumentInverter::pushDocuments(const OnWriteDoneType& on_write_done)
     auto& push_threads = _context.get_push_threads();
     auto& push_contexts = _context.get_push_contexts();
     for (auto& push_context : push_contexts) {
-        auto task = std::make_unique<PushTask>(push_context, _inverters, _urlInverters, on_write_done, retain);
+        auto task = std::make_unique<PushTask>(push_context, _inverters, _shard_inverters, _urlInverters, on_write_done, retain);
         all_push_tasks.emplace_back(std::make_shared<ScheduleSequencedTaskCallback>(push_threads, push_context.get_id(), std::move(task)));
     }
     auto& invert_threads = _context.get_invert_threads();
@@ -29,6 +29,7 @@ class IFieldIndexCollection;
  * Class used to invert the fields for a set of documents, preparing for pushing changes info field indexes.
  *
  * Each text and uri field in the document is handled separately by a FieldInverter and UrlFieldInverter.
+ * When inversion is sharded by document, each text field has one FieldInverter per shard.
  */
 class DocumentInverter {
 private:
@@ -39,8 +40,10 @@ private:
 
     using LidVector = std::vector<uint32_t>;
     using OnWriteDoneType = std::shared_ptr<vespalib::IDestructorCallback>;
+    using FieldInverters = std::vector<std::unique_ptr<FieldInverter>>;
 
     std::vector<std::unique_ptr<FieldInverter>> _inverters;
+    std::vector<FieldInverters>                    _shard_inverters; // Text field inverters for shards 1 and above
     std::vector<std::unique_ptr<UrlFieldInverter>> _urlInverters;
     vespalib::MonitoredRefCount                    _ref_count;
 
@@ -91,6 +94,10 @@ public:
         return _inverters[fieldId].get();
     }
 
+    const FieldInverters& get_shard_inverters(uint32_t shard) const {
+        return (shard == 0) ? _inverters : _shard_inverters[shard - 1];
+    }
+
     uint32_t getNumFields() const { return _inverters.size(); }
     void wait_for_zero_ref_count() { _ref_count.waitForZeroRefCount(); }
     bool has_zero_ref_count() { return _ref_count.has_zero_ref_count(); }
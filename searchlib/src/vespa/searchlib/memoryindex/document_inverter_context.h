@@ -15,6 +15,10 @@ class IFieldIndexCollection;
 /*
  * Class containing shared context for document inverters that changes
  * rarely (type dependent data, wiring).
+ *
+ * Inversion of each text field can be sharded by document across
+ * num_field_shards invert threads, to avoid a single large field
+ * serializing inversion on one thread. Shards are merged when pushing.
  */
 class DocumentInverterContext {
     const index::Schema&              _schema;
@@ -22,6 +26,7 @@ class DocumentInverterContext {
     vespalib::ISequencedTaskExecutor& _invert_threads;
     vespalib::ISequencedTaskExecutor& _push_threads;
     IFieldIndexCollection&            _field_indexes;
+    uint32_t                          _num_field_shards;
     std::vector<InvertContext>        _invert_contexts;
     std::vector<PushContext>          _push_contexts;
     void setup_contexts();
@@ -30,6 +35,11 @@ public:
                             vespalib::ISequencedTaskExecutor &invert_threads,
                             vespalib::ISequencedTaskExecutor &push_threads,
                             IFieldIndexCollection& field_indexes);
+    DocumentInverterContext(const index::Schema &schema,
+                            vespalib::ISequencedTaskExecutor &invert_threads,
+                            vespalib::ISequencedTaskExecutor &push_threads,
+                            IFieldIndexCollection& field_indexes,
+                            uint32_t num_field_shards);
     ~DocumentInverterContext();
     const index::Schema& get_schema() const noexcept { return _schema; }
     const index::SchemaIndexFields& get_schema_index_fields() const noexcept { return _schema_index_fields; }
@@ -38,6 +48,8 @@ public:
     IFieldIndexCollection& get_field_indexes() noexcept { return _field_indexes; }
     const std::vector<InvertContext>& get_invert_contexts() const noexcept { return _invert_contexts; }
     const std::vector<PushContext>& get_push_contexts() const noexcept { return _push_contexts; }
+    uint32_t get_num_field_shards() const noexcept { return _num_field_shards; }
+    uint32_t get_field_shard(uint32_t lid) const noexcept { return lid % _num_field_shards; }
 };
 
 }
@@ -10,7 +10,7 @@
 
 namespace search::memoryindex {
 
-constexpr size_t MIN_BUFFER_ARRAYS = 1024u;
+constexpr size_t MIN_BUFFER_ARRAYS = 4096u;
 
 using index::SchemaUtil;
 using vespalib::datastore::CompactionSpec;
@@ -36,15 +36,10 @@ FeatureStore::writeFeatures(uint32_t packedIndex, const DocIdAndFeatures &featur
 EntryRef
 FeatureStore::addFeatures(const uint8_t *src, uint64_t byteLen)
 {
-    uint32_t pad = Aligner::pad(byteLen);
-    auto result = _store.rawAllocator<uint8_t>(_typeId).alloc((byteLen + pad) / buffer_array_size, DECODE_SAFETY_ENTRIES);
+    auto result = _store.rawAllocator<uint8_t>(_typeId).alloc(byteLen / buffer_array_size, DECODE_SAFETY_ENTRIES);
     uint8_t *dst = result.data;
     memcpy(dst, src, byteLen);
     dst += byteLen;
-    if (pad > 0) {
-        memset(dst, 0, pad);
-        dst += pad;
-    }
     memset(dst, 0, DECODE_SAFETY);
     return result.ref;
 }
@@ -74,6 +69,8 @@ FeatureStore::moveFeatures(EntryRef ref, uint64_t bitLen)
 
 FeatureStore::FeatureStore(const Schema &schema)
     : _store(),
+      _raw_bytes(0),
+      _stored_bytes(0),
       _f(nullptr),
       _fctx(_f),
       _d(nullptr),
@@ -106,16 +103,20 @@ FeatureStore::addFeatures(uint32_t packedIndex, const DocIdAndFeatures &features
     uint64_t oldOffset = writeFeatures(packedIndex, features);
     uint64_t newOffset = _f.getWriteOffset();
     _f.flush();
-    return addFeatures(oldOffset, newOffset);
+    auto result = addFeatures(oldOffset, newOffset);
+    uint64_t raw_bytes = features.elements().size() * sizeof(index::WordDocElementFeatures) +
+                         features.word_positions().size() * sizeof(index::WordDocElementWordPosFeatures);
+    _raw_bytes.store(get_raw_bytes() + raw_bytes, std::memory_order_relaxed);
+    _stored_bytes.store(get_stored_bytes() + (result.second + 7) / 8, std::memory_order_relaxed);
+    return result;
 }
 
 void
 FeatureStore::add_features_guard_bytes()
 {
     uint32_t len = DECODE_SAFETY;
-    uint32_t pad = Aligner::pad(len);
-    auto result = _store.rawAllocator<uint8_t>(_typeId).alloc((len + pad) / buffer_array_size);
-    memset(result.data, 0, len + pad);
+    auto result = _store.rawAllocator<uint8_t>(_typeId).alloc(len / buffer_array_size);
+    memset(result.data, 0, len);
 }
 
 void
@@ -7,20 +7,24 @@
 #include <vespa/searchlib/bitcompression/posocccompression.h>
 #include <vespa/searchlib/bitcompression/posocc_fields_params.h>
 #include <vespa/vespalib/datastore/datastore.h>
+#include <atomic>
 
 namespace search::memoryindex {
 
 /**
  * Class storing DocIdAndFeatures in an underlying DataStore, using 32-bit refs to access entries.
+ *
+ * Features are bitwise compressed and stored with byte granularity, i.e. entries are
+ * not padded. The decoder handles features starting at any byte offset.
  */
 class FeatureStore {
 public:
-    using DataStoreType = vespalib::datastore::DataStoreT<vespalib::datastore::EntryRefT<22>>;
+    using DataStoreType = vespalib::datastore::DataStoreT<vespalib::datastore::EntryRefT<24>>;
     using RefType = DataStoreType::RefType;
     using EncodeContext = bitcompression::EG2PosOccEncodeContext<true>;
     using DecodeContextCooked = bitcompression::EG2PosOccDecodeContextCooked<true>;
     using generation_t = vespalib::GenerationHandler::generation_t;
-    static constexpr uint32_t buffer_array_size = 4u; // Must be a power of 2
+    static constexpr uint32_t buffer_array_size = 1u; // Must be a power of 2
     using Aligner = vespalib::datastore::Aligner<buffer_array_size>;
 
 private:
@@ -33,6 +37,10 @@ private:
 
     DataStoreType _store;
 
+    // Size of added features, uncompressed and as stored in the data store.
+    std::atomic<uint64_t> _raw_bytes;
+    std::atomic<uint64_t> _stored_bytes;
+
     // Feature Encoder
     EncodeContext _f;
     // Buffer for compressed features.
@@ -208,6 +216,14 @@ public:
     std::unique_ptr<vespalib::datastore::CompactingBuffers> start_compact();
     vespalib::MemoryUsage getMemoryUsage() const { return _store.getMemoryUsage(); }
     vespalib::datastore::MemoryStats getMemStats() const { return _store.getMemStats(); }
+
+    /**
+     * Returns the accumulated size of added features, as decoded into
+     * DocIdAndFeatures and as stored in compressed form.
+     * Features moved by compaction are not counted again.
+     */
+    uint64_t get_raw_bytes() const noexcept { return _raw_bytes.load(std::memory_order_relaxed); }
+    uint64_t get_stored_bytes() const noexcept { return _stored_bytes.load(std::memory_order_relaxed); }
 };
 
 }
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "field_index_collection.h"
+#include "feature_store.h"
 #include "field_inverter.h"
 #include "ordered_field_index_inserter.h"
 #include <vespa/searchlib/bitcompression/posocccompression.h>
@@ -9,7 +10,12 @@
 #include <vespa/vespalib/btree/btreeiterator.hpp>
 #include <vespa/vespalib/btree/btreenodeallocator.hpp>
 #include <vespa/vespalib/btree/btreenodestore.hpp>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/executor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <atomic>
 
 namespace search {
 
@@ -49,6 +55,34 @@ FieldIndexCollection::dump(search::index::IndexBuilder &indexBuilder)
     }
 }
 
+void
+FieldIndexCollection::dump(search::index::IndexBuilder &indexBuilder, vespalib::Executor &executor, uint32_t max_threads)
+{
+    std::atomic<uint32_t> next_field(0);
+    auto dump_fields = [&]() {
+        for (uint32_t fieldId = next_field.fetch_add(1, std::memory_order_relaxed); fieldId < _numFields;
+             fieldId = next_field.fetch_add(1, std::memory_order_relaxed))
+        {
+            // Each field index builder writes its own dictionary, posting and bitvector files
+            auto fieldIndexBuilder = indexBuilder.startField(fieldId);
+            if (fieldIndexBuilder) {
+                _fieldIndexes[fieldId]->dump(*fieldIndexBuilder);
+            }
+        }
+    };
+    uint32_t num_tasks = std::min(std::max(max_threads, 1u), std::max(_numFields, 1u)) - 1;
+    vespalib::CountDownLatch latch(num_tasks);
+    for (uint32_t i = 0; i < num_tasks; ++i) {
+        auto task = vespalib::makeLambdaTask([&]() { dump_fields(); latch.countDown(); });
+        auto rejected = executor.execute(vespalib::CpuUsage::wrap(std::move(task), vespalib::CpuUsage::Category::COMPACT));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    dump_fields();
+    latch.await();
+}
+
 vespalib::MemoryUsage
 FieldIndexCollection::getMemoryUsage() const
 {
@@ -68,7 +102,10 @@ FieldIndexCollection::get_stats(const index::Schema& schema) const
         auto &field_index = _fieldIndexes[field_id];
         auto field_memory_usage = field_index->getMemoryUsage();
         memory_usage.merge(field_memory_usage);
-        stats.add_field_stats(schema.getIndexField(field_id).getName(), FieldIndexStats().memory_usage(field_memory_usage));
+        auto& feature_store = field_index->getFeatureStore();
+        stats.add_field_stats(schema.getIndexField(field_id).getName(),
+                              FieldIndexStats().memory_usage(field_memory_usage).
+                              feature_bytes(feature_store.get_raw_bytes(), feature_store.get_stored_bytes()));
     }
     stats.memoryUsage(memory_usage);
     return stats;
@@ -13,6 +13,7 @@ namespace search::index {
     class Schema;
     class IndexBuilder;
 }
+namespace vespalib { class Executor; }
 
 namespace search::memoryindex {
 
@@ -45,6 +46,11 @@ public:
     }
 
     void dump(search::index::IndexBuilder & indexBuilder);
+    /*
+     * Dump fields in parallel, using at most max_threads threads (the calling thread included),
+     * which bounds the number of fields written to disk at the same time.
+     */
+    void dump(search::index::IndexBuilder & indexBuilder, vespalib::Executor & executor, uint32_t max_threads);
 
     vespalib::MemoryUsage getMemoryUsage() const;
     IndexStats get_stats(const index::Schema& schema) const;
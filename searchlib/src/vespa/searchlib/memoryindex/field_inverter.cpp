@@ -182,7 +182,11 @@ FieldInverter::endDoc()
             ++itr;
         }
     }
-    _calculator.add_field_length(field_length, _elem);
+    if (_sharded) {
+        _field_lengths.emplace_back(field_length, _elem);
+    } else {
+        _calculator.add_field_length(field_length, _elem);
+    }
     uint32_t newPosSize = static_cast<uint32_t>(_positions.size());
     _pendingDocs.insert({ _docId, { _oldPosSize, newPosSize - _oldPosSize } });
     _docId = 0;
@@ -243,6 +247,15 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
                              FieldIndexRemover &remover,
                              IOrderedFieldIndexInserter &inserter,
                              index::FieldLengthCalculator &calculator)
+    : FieldInverter(schema, fieldId, remover, inserter, calculator, false)
+{
+}
+
+FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
+                             FieldIndexRemover &remover,
+                             IOrderedFieldIndexInserter &inserter,
+                             index::FieldLengthCalculator &calculator,
+                             bool sharded)
     : _fieldId(fieldId),
       _elem(0u),
       _wpos(0u),
@@ -261,7 +274,9 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
       _removeDocs(),
       _remover(remover),
       _inserter(inserter),
-      _calculator(calculator)
+      _calculator(calculator),
+      _sharded(sharded),
+      _field_lengths()
 {
 }
 
@@ -400,14 +415,13 @@ FieldInverter::applyRemoves()
     _removeDocs.clear();
 }
 
-void
-FieldInverter::push_documents_internal()
+bool
+FieldInverter::sort_positions()
 {
     trimAbortedDocs();
 
     if (_positions.empty()) {
-        reset();
-        return;             // All documents with words aborted
+        return false;       // All documents with words aborted
     }
 
     sortWords();
@@ -415,78 +429,140 @@ FieldInverter::push_documents_internal()
     // Sort for terms.
     ShiftBasedRadixSorter<PosInfo, FullRadix, std::less<PosInfo>, 56, true>::
         radix_sort(FullRadix(), std::less<PosInfo>(), &_positions[0], _positions.size(), 16);
+    return true;
+}
 
+const FieldInverter::PosInfo*
+FieldInverter::push_word_doc(const PosInfo* pos, const PosInfo* pos_end, IOrderedFieldIndexInserter& inserter)
+{
     constexpr uint32_t NO_ELEMENT_ID = std::numeric_limits<uint32_t>::max();
     constexpr uint32_t NO_WORD_POS = std::numeric_limits<uint32_t>::max();
-    uint32_t lastWordNum = 0;
-    uint32_t lastElemId = 0;
-    uint32_t lastWordPos = 0;
-    uint32_t numWordIds = _wordRefs.size() - 1;
-    uint32_t lastDocId = 0;
-    std::string_view word;
-    bool emptyFeatures = true;
-    uint32_t last_field_length = 0;
-
-    _inserter.rewind();
-
-    for (auto &i : _positions) {
-        assert(i._wordNum <= numWordIds);
-        (void) numWordIds;
-        if (lastWordNum != i._wordNum || lastDocId != i._docId) {
-            if (!emptyFeatures) {
-                _features.set_num_occs(_features.word_positions().size());
-                _inserter.add(lastDocId, _features);
-                emptyFeatures = true;
-            }
-            if (lastWordNum != i._wordNum) {
-                lastWordNum = i._wordNum;
-                word = getWordFromNum(lastWordNum);
-                _inserter.setNextWord(word);
-            }
-            lastDocId = i._docId;
-            if (i.removed()) {
-                _inserter.remove(lastDocId);
-                continue;
-            }
-        }
-        if (emptyFeatures) {
-            if (!i.removed()) {
-                emptyFeatures = false;
-                _features.clear(lastDocId);
-                lastElemId = NO_ELEMENT_ID;
-                lastWordPos = NO_WORD_POS;
-                const ElemInfo &elem = _elems[i._elemRef];
-                _features.set_field_length(elem.get_field_length());
-                last_field_length = elem.get_field_length();
-            } else {
-                continue; // ignore dup remove
-            }
-        } else {
-            // removes must come before non-removes
-            assert(!i.removed());
-            const ElemInfo &elem = _elems[i._elemRef];
-            assert(last_field_length == elem.get_field_length());
+    const uint32_t word_num = pos->_wordNum;
+    const uint32_t doc_id = pos->_docId;
+    assert(word_num < _wordRefs.size());
+    // removes come before non-removes
+    if (pos->removed()) {
+        inserter.remove(doc_id);
+        ++pos;
+        while (pos != pos_end && pos->_wordNum == word_num && pos->_docId == doc_id && pos->removed()) {
+            ++pos; // ignore dup remove
         }
-        const ElemInfo &elem = _elems[i._elemRef];
-        if (i._wordPos != lastWordPos || i._elemId != lastElemId) {
-            _features.addNextOcc(i._elemId, i._wordPos,
+    }
+    if (pos == pos_end || pos->_wordNum != word_num || pos->_docId != doc_id) {
+        return pos;
+    }
+    _features.clear(doc_id);
+    uint32_t lastElemId = NO_ELEMENT_ID;
+    uint32_t lastWordPos = NO_WORD_POS;
+    const uint32_t field_length = _elems[pos->_elemRef].get_field_length();
+    _features.set_field_length(field_length);
+    for (; pos != pos_end && pos->_wordNum == word_num && pos->_docId == doc_id; ++pos) {
+        assert(!pos->removed());
+        const ElemInfo &elem = _elems[pos->_elemRef];
+        assert(field_length == elem.get_field_length());
+        if (pos->_wordPos != lastWordPos || pos->_elemId != lastElemId) {
+            _features.addNextOcc(pos->_elemId, pos->_wordPos,
                                  elem._weight, elem._len);
-            lastElemId = i._elemId;
-            lastWordPos = i._wordPos;
+            lastElemId = pos->_elemId;
+            lastWordPos = pos->_wordPos;
         } else {
             // silently ignore duplicate annotations
         }
     }
+    _features.set_num_occs(_features.word_positions().size());
+    inserter.add(doc_id, _features);
+    return pos;
+}
+
+void
+FieldInverter::apply_field_lengths()
+{
+    for (auto& field_length : _field_lengths) {
+        _calculator.add_field_length(field_length.first, field_length.second);
+    }
+    _field_lengths.clear();
+}
+
+void
+FieldInverter::push_documents_internal()
+{
+    apply_field_lengths();
+    if (!sort_positions()) {
+        reset();
+        return;
+    }
+
+    _inserter.rewind();
 
-    if (!emptyFeatures) {
-        _features.set_num_occs(_features.word_positions().size());
-        _inserter.add(lastDocId, _features);
+    const PosInfo* pos = _positions.data();
+    const PosInfo* pos_end = pos + _positions.size();
+    uint32_t lastWordNum = 0;
+    while (pos != pos_end) {
+        if (lastWordNum != pos->_wordNum) {
+            lastWordNum = pos->_wordNum;
+            _inserter.setNextWord(getWordFromNum(lastWordNum));
+        }
+        pos = push_word_doc(pos, pos_end, _inserter);
     }
+
     _inserter.flush();
     _inserter.commit();
     reset();
 }
 
+void
+FieldInverter::push_sharded_documents_internal(const std::vector<FieldInverter*>& shards)
+{
+    struct Cursor {
+        FieldInverter* inverter;
+        const PosInfo* pos;
+        const PosInfo* pos_end;
+        const char*    word;
+    };
+    std::vector<Cursor> cursors;
+    for (auto* shard : shards) {
+        assert(&shard->_inserter == &_inserter);
+        shard->apply_field_lengths();
+        if (shard->sort_positions()) {
+            const PosInfo* pos = shard->_positions.data();
+            cursors.push_back({shard, pos, pos + shard->_positions.size(), shard->getWordFromNum(pos->_wordNum)});
+        }
+    }
+    if (!cursors.empty()) {
+        _inserter.rewind();
+        /*
+         * Each document belongs to a single shard, thus the {word, docId} pairs
+         * from different shards are distinct. Word buffers in all shards are
+         * kept until the inserter has been flushed.
+         */
+        const char* last_word = nullptr;
+        while (!cursors.empty()) {
+            auto best = cursors.begin();
+            for (auto itr = best + 1; itr != cursors.end(); ++itr) {
+                int cmpres = strcmp(itr->word, best->word);
+                if (cmpres < 0 || (cmpres == 0 && itr->pos->_docId < best->pos->_docId)) {
+                    best = itr;
+                }
+            }
+            if (last_word == nullptr || strcmp(last_word, best->word) != 0) {
+                last_word = best->word;
+                _inserter.setNextWord(last_word);
+            }
+            best->pos = best->inverter->push_word_doc(best->pos, best->pos_end, _inserter);
+            if (best->pos == best->pos_end) {
+                cursors.erase(best);
+            } else {
+                best->word = best->inverter->getWordFromNum(best->pos->_wordNum);
+            }
+        }
+        _inserter.flush();
+        _inserter.commit();
+    }
+    for (auto* shard : shards) {
+        shard->reset();
+    }
+}
+
 void
 FieldInverter::pushDocuments()
 {
@@ -500,5 +576,19 @@ FieldInverter::pushDocuments()
     }
 }
 
+void
+FieldInverter::pushDocuments(const std::vector<FieldInverter*>& shards)
+{
+    assert(!shards.empty());
+    auto& primary = *shards.front();
+    try {
+        primary.push_sharded_documents_internal(shards);
+    } catch (vespalib::OverflowException &e) {
+        const Schema::IndexField &field = primary._schema.getIndexField(primary._fieldId);
+        vespalib::asciistream s;
+        s << "FieldInverter::pushDocuments(), caught exception for field " << field.getName();
+        throw vespalib::OverflowException(s.c_str(), e);
+    }
 }
 
+}
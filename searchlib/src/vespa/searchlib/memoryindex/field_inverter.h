@@ -32,6 +32,11 @@ class FieldIndexRemover;
  *
  * It creates a set of sorted {word, docId, features} tuples based on the field content of the documents,
  * and uses this when updating the posting lists of the FieldIndex.
+ *
+ * Inversion of a field can be sharded by document across multiple field inverters, each used by a
+ * separate invert thread. The sorted tuples from all shards are then merged when pushing, see
+ * pushDocuments(const std::vector<FieldInverter*>&). Sharded field inverters defer updating the
+ * field length calculator until pushing, since it only supports a single writer.
  */
 class FieldInverter : public IFieldIndexRemoveListener {
 public:
@@ -192,6 +197,8 @@ private:
     FieldIndexRemover                &_remover;
     IOrderedFieldIndexInserter       &_inserter;
     index::FieldLengthCalculator     &_calculator;
+    const bool                        _sharded;
+    std::vector<std::pair<uint32_t, uint32_t>> _field_lengths; // Deferred {field length, elements} when sharded
 
     void invertNormalDocTextField(const document::FieldValue &val, const document::Document& doc);
 
@@ -249,6 +256,7 @@ public:
     processAnnotations(const document::StringFieldValue &value, const document::Document& doc);
 
     void push_documents_internal();
+    void push_sharded_documents_internal(const std::vector<FieldInverter*>& shards);
 
 private:
     void processNormalDocTextField(const document::StringFieldValue &field, const document::Document& doc);
@@ -276,6 +284,20 @@ private:
      */
     void abortPendingDoc(uint32_t docId);
 
+    /**
+     * Trim aborted documents and sort the positions for the current batch.
+     * Returns false if there is nothing to push.
+     */
+    bool sort_positions();
+
+    /**
+     * Push the changes for the {word, docId} pair starting at pos using the given inserter,
+     * after the word has been set. Returns the first position for the next {word, docId} pair.
+     */
+    const PosInfo* push_word_doc(const PosInfo* pos, const PosInfo* pos_end, IOrderedFieldIndexInserter& inserter);
+
+    void apply_field_lengths();
+
 public:
     /**
      * Create a new field inverter for the given fieldId, using the given schema.
@@ -284,6 +306,14 @@ public:
                   FieldIndexRemover &remover,
                   IOrderedFieldIndexInserter &inserter,
                   index::FieldLengthCalculator &calculator);
+    /**
+     * Create a new field inverter for one shard of the given fieldId when sharded is true.
+     */
+    FieldInverter(const index::Schema &schema, uint32_t fieldId,
+                  FieldIndexRemover &remover,
+                  IOrderedFieldIndexInserter &inserter,
+                  index::FieldLengthCalculator &calculator,
+                  bool sharded);
     FieldInverter(const FieldInverter &) = delete;
     FieldInverter(const FieldInverter &&) = delete;
     FieldInverter &operator=(const FieldInverter &) = delete;
@@ -303,6 +333,13 @@ public:
      */
     void pushDocuments();
 
+    /**
+     * Push the current batch of inverted documents from all shards for a field to the FieldIndex,
+     * merging the sorted {word, docId, features} tuples from the shards. Pending removes must
+     * have been applied for all shards.
+     */
+    static void pushDocuments(const std::vector<FieldInverter*>& shards);
+
     /**
      * Invert a normal text field, based on annotations.
      */
@@ -58,11 +58,20 @@ MemoryIndex::MemoryIndex(const Schema& schema,
                          const IFieldLengthInspector& inspector,
                          ISequencedTaskExecutor& invertThreads,
                          ISequencedTaskExecutor& pushThreads)
+    : MemoryIndex(schema, inspector, invertThreads, pushThreads, 1)
+{
+}
+
+MemoryIndex::MemoryIndex(const Schema& schema,
+                         const IFieldLengthInspector& inspector,
+                         ISequencedTaskExecutor& invertThreads,
+                         ISequencedTaskExecutor& pushThreads,
+                         uint32_t num_field_shards)
     : _schema(schema),
       _invertThreads(invertThreads),
       _pushThreads(pushThreads),
       _fieldIndexes(std::make_unique<FieldIndexCollection>(_schema, inspector)),
-      _inverter_context(std::make_unique<DocumentInverterContext>(_schema, _invertThreads, _pushThreads, *_fieldIndexes)),
+      _inverter_context(std::make_unique<DocumentInverterContext>(_schema, _invertThreads, _pushThreads, *_fieldIndexes, num_field_shards)),
       _inverters(std::make_unique<DocumentInverterCollection>(*_inverter_context, 3)),
       _frozen(false),
       _maxDocId(0), // docId 0 is reserved
@@ -131,6 +140,12 @@ MemoryIndex::dump(IndexBuilder &indexBuilder)
     _fieldIndexes->dump(indexBuilder);
 }
 
+void
+MemoryIndex::dump(IndexBuilder &indexBuilder, vespalib::Executor &executor, uint32_t max_threads)
+{
+    _fieldIndexes->dump(indexBuilder, executor, max_threads);
+}
+
 namespace {
 
 /**
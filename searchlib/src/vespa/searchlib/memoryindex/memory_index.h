@@ -17,7 +17,10 @@ namespace search::index {
     class IndexBuilder;
 }
 
-namespace vespalib { class ISequencedTaskExecutor; }
+namespace vespalib {
+    class Executor;
+    class ISequencedTaskExecutor;
+}
 namespace vespalib::slime { struct Cursor; }
 namespace document { class Document; }
 
@@ -96,6 +99,16 @@ public:
                 ISequencedTaskExecutor& invertThreads,
                 ISequencedTaskExecutor& pushThreads);
 
+    /**
+     * Create a new memory index where inversion of each text field is
+     * sharded by document across num_field_shards invert threads.
+     */
+    MemoryIndex(const index::Schema& schema,
+                const index::IFieldLengthInspector& inspector,
+                ISequencedTaskExecutor& invertThreads,
+                ISequencedTaskExecutor& pushThreads,
+                uint32_t num_field_shards);
+
     MemoryIndex(const MemoryIndex &) = delete;
     MemoryIndex(MemoryIndex &&) = delete;
     MemoryIndex &operator=(const MemoryIndex &) = delete;
@@ -141,6 +154,13 @@ public:
      */
     void dump(index::IndexBuilder &indexBuilder);
 
+    /**
+     * Dump the contents of this index into the given index builder, with
+     * up to max_threads fields being dumped in parallel using the executor.
+     * The index builder must support building several fields at the same time.
+     */
+    void dump(index::IndexBuilder &indexBuilder, vespalib::Executor &executor, uint32_t max_threads);
+
     // Implements Searchable
     std::unique_ptr<queryeval::Blueprint> createBlueprint(const queryeval::IRequestContext & requestContext,
                                                           const queryeval::FieldSpec &field,
@@ -19,9 +19,10 @@ void push_inverter(Inverter& inverter)
 }
 
 
-PushTask::PushTask(const PushContext& context, const std::vector<std::unique_ptr<FieldInverter>>& inverters, const std::vector<std::unique_ptr<UrlFieldInverter>>& uri_inverters, const OnWriteDoneType& on_write_done, std::shared_ptr<vespalib::RetainGuard> retain)
+PushTask::PushTask(const PushContext& context, const std::vector<std::unique_ptr<FieldInverter>>& inverters, const std::vector<std::vector<std::unique_ptr<FieldInverter>>>& shard_inverters, const std::vector<std::unique_ptr<UrlFieldInverter>>& uri_inverters, const OnWriteDoneType& on_write_done, std::shared_ptr<vespalib::RetainGuard> retain)
     : _context(context),
       _inverters(inverters),
+      _shard_inverters(shard_inverters),
       _uri_inverters(uri_inverters),
       _on_write_done(on_write_done),
       _retain(std::move(retain))
@@ -33,8 +34,21 @@ PushTask::~PushTask() = default;
 void
 PushTask::run()
 {
+    std::vector<FieldInverter*> shards;
     for (auto field_id : _context.get_fields()) {
-        push_inverter(*_inverters[field_id]);
+        if (_shard_inverters.empty()) {
+            push_inverter(*_inverters[field_id]);
+            continue;
+        }
+        shards.clear();
+        shards.emplace_back(_inverters[field_id].get());
+        for (auto& inverters : _shard_inverters) {
+            shards.emplace_back(inverters[field_id].get());
+        }
+        for (auto* shard : shards) {
+            shard->applyRemoves();
+        }
+        FieldInverter::pushDocuments(shards);
     }
     for (auto uri_field_id : _context.get_uri_fields()) {
         push_inverter(*_uri_inverters[uri_field_id]);
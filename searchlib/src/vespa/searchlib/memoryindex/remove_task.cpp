@@ -20,8 +20,9 @@ void remove_documents(Inverter& inverter, const std::vector<uint32_t>& lids)
 
 }
 
-RemoveTask::RemoveTask(const InvertContext& context, const std::vector<std::unique_ptr<FieldInverter>>& inverters,  const std::vector<std::unique_ptr<UrlFieldInverter>>& uri_inverters, const std::vector<uint32_t>& lids)
-    : _context(context),
+RemoveTask::RemoveTask(const DocumentInverterContext& inv_context, const InvertContext& context, const std::vector<std::unique_ptr<FieldInverter>>& inverters,  const std::vector<std::unique_ptr<UrlFieldInverter>>& uri_inverters, const std::vector<uint32_t>& lids)
+    : _inv_context(inv_context),
+      _context(context),
       _inverters(inverters),
       _uri_inverters(uri_inverters),
       _lids(lids)
@@ -33,8 +34,20 @@ RemoveTask::~RemoveTask() = default;
 void
 RemoveTask::run()
 {
-    for (auto field_id : _context.get_fields()) {
-        remove_documents(*_inverters[field_id], _lids);
+    if (_inv_context.get_num_field_shards() > 1) {
+        std::vector<uint32_t> lids;
+        for (auto lid : _lids) {
+            if (_inv_context.get_field_shard(lid) == _context.get_shard()) {
+                lids.emplace_back(lid);
+            }
+        }
+        for (auto field_id : _context.get_fields()) {
+            remove_documents(*_inverters[field_id], lids);
+        }
+    } else {
+        for (auto field_id : _context.get_fields()) {
+            remove_documents(*_inverters[field_id], _lids);
+        }
     }
     for (auto uri_field_id : _context.get_uri_fields()) {
         remove_documents(*_uri_inverters[uri_field_id], _lids);
@@ -7,6 +7,7 @@
 
 namespace search::memoryindex {
 
+class DocumentInverterContext;
 class FieldInverter;
 class InvertContext;
 class UrlFieldInverter;
@@ -17,12 +18,13 @@ class UrlFieldInverter;
  */
 class RemoveTask : public vespalib::Executor::Task
 {
+    const DocumentInverterContext&                        _inv_context;
     const InvertContext&                                  _context;
     const std::vector<std::unique_ptr<FieldInverter>>&    _inverters;
     const std::vector<std::unique_ptr<UrlFieldInverter>>& _uri_inverters;
     std::vector<uint32_t>                                 _lids;
 public:
-    RemoveTask(const InvertContext& context, const std::vector<std::unique_ptr<FieldInverter>>& inverters,  const std::vector<std::unique_ptr<UrlFieldInverter>>& uri_inverters, const std::vector<uint32_t>& lids);
+    RemoveTask(const DocumentInverterContext& inv_context, const InvertContext& context, const std::vector<std::unique_ptr<FieldInverter>>& inverters,  const std::vector<std::unique_ptr<UrlFieldInverter>>& uri_inverters, const std::vector<uint32_t>& lids);
     ~RemoveTask() override;
     void run() override;
 };
@@ -10,6 +10,7 @@
 #include "leaf_blueprints.h"
 #include "matching_elements_search.h"
 #include "orsearch.h"
+#include "parallel_fetch_postings.h"
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/vespalib/objects/visit.hpp>
 #include <vespa/vespalib/objects/objectdumper.h>
@@ -126,6 +127,7 @@ Blueprint::Blueprint() noexcept
       _sourceId(0xffffffff),
       _docid_limit(0),
       _id(0),
+      _in_flow_rate(1.0),
       _strict(false),
       _frozen(false)
 {
@@ -143,6 +145,7 @@ Blueprint::resolve_strict(InFlow &in_flow) noexcept
         }
     }
     _strict = in_flow.strict();
+    _in_flow_rate = in_flow.rate();
 }
 
 uint32_t
@@ -607,10 +610,40 @@ IntermediateBlueprint::calculateState() const
     return state;
 }
 
+double
+IntermediateBlueprint::termwise_estimate_of(const std::vector<const Blueprint *> &children) const
+{
+    return OrFlow::estimate_of(children);
+}
+
+IntermediateBlueprint::TermwiseCost
+IntermediateBlueprint::calculate_termwise_cost(const UnpackInfo &unpack) const
+{
+    TermwiseCost cost{0.0, 0.0};
+    std::vector<const Blueprint *> termwise_children;
+    for (size_t i = 0; i < _children.size(); ++i) {
+        const Blueprint &child = *_children[i];
+        if (child.getState().allow_termwise_eval() && !unpack.needUnpack(i)) {
+            termwise_children.push_back(&child);
+            cost.inline_cost += child.strict() ? child.strict_cost() : (child.in_flow_rate() * child.cost());
+            cost.termwise_cost += child.strict_cost();
+        }
+    }
+    if (!termwise_children.empty()) {
+        // the termwise result is used like a bitvector in the place of its first child
+        const Blueprint &first = *termwise_children[0];
+        cost.termwise_cost += flow::termwise_overhead(termwise_children.size());
+        cost.termwise_cost += first.strict()
+                              ? flow::bitvector_strict_cost(termwise_estimate_of(termwise_children))
+                              : (first.in_flow_rate() * flow::bitvector_cost());
+    }
+    return cost;
+}
+
 bool
-IntermediateBlueprint::should_do_termwise_eval(const UnpackInfo &unpack, double match_limit) const
+IntermediateBlueprint::should_do_termwise_eval(const UnpackInfo &unpack, double match_limit, bool use_cost_model) const
 {
-    if (root().hit_ratio() <= match_limit) {
+    if (!use_cost_model && (root().hit_ratio() <= match_limit)) {
         return false; // global hit density too low
     }
     if (getState().allow_termwise_eval() && unpack.empty() &&
@@ -618,7 +651,14 @@ IntermediateBlueprint::should_do_termwise_eval(const UnpackInfo &unpack, double
     {
         return false; // higher up will be better
     }
-    return (count_termwise_nodes(unpack) > 1);
+    if (count_termwise_nodes(unpack) <= 1) {
+        return false;
+    }
+    if (use_cost_model) {
+        auto cost = calculate_termwise_cost(unpack);
+        return (cost.termwise_cost < cost.inline_cost);
+    }
+    return true;
 }
 
 void
@@ -717,7 +757,7 @@ IntermediateBlueprint::fetchPostings(const ExecuteInfo &execInfo)
     auto flow = my_flow(InFlow(strict(), execInfo.hit_rate()));
     for (const auto & child : _children) {
         double nextHitRate = flow.flow();
-        child->fetchPostings(ExecuteInfo::create(nextHitRate, execInfo));
+        ParallelFetchPostings::fetch(*child, ExecuteInfo::create(nextHitRate, execInfo));
         flow.add(child->estimate());
     }
 }
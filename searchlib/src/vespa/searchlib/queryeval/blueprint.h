@@ -29,6 +29,7 @@ class SearchIterator;
 class ExecuteInfo;
 class MatchingElementsSearch;
 class LeafBlueprint;
+struct SimpleLeafBlueprint;
 class IntermediateBlueprint;
 class SourceBlenderBlueprint;
 class WeakAndBlueprint;
@@ -242,6 +243,7 @@ private:
     uint32_t   _sourceId;
     uint32_t   _docid_limit;
     uint32_t   _id;
+    double     _in_flow_rate;
     bool       _strict;
     bool       _frozen;
     thread_local static Options _opts;
@@ -296,6 +298,8 @@ public:
     virtual uint32_t enumerate(uint32_t next_id) noexcept;
 
     bool strict() const noexcept { return _strict; }
+    // the rate of the in-flow seen by the last sort; 1.0 when strict
+    double in_flow_rate() const noexcept { return _in_flow_rate; }
 
     virtual void each_node_post_order(const std::function<void(Blueprint&)> &f);
 
@@ -419,6 +423,7 @@ public:
     virtual IntermediateBlueprint * asIntermediate() noexcept { return nullptr; }
     const IntermediateBlueprint * asIntermediate() const noexcept { return const_cast<Blueprint *>(this)->asIntermediate(); }
     virtual const LeafBlueprint * asLeaf() const noexcept { return nullptr; }
+    virtual const SimpleLeafBlueprint * asSimpleLeaf() const noexcept { return nullptr; }
     virtual const AlwaysTrueBlueprint *asAlwaysTrue() const noexcept { return nullptr; }
     virtual AndBlueprint * asAnd() noexcept { return nullptr; }
     bool isAnd() const noexcept { return const_cast<Blueprint *>(this)->asAnd() != nullptr; }
@@ -478,6 +483,8 @@ private:
 
     size_t count_termwise_nodes(const UnpackInfo &unpack) const;
     virtual AnyFlow my_flow(InFlow in_flow) const = 0;
+    // estimate of the given children when combined termwise by this operator
+    virtual double termwise_estimate_of(const std::vector<const Blueprint *> &children) const;
 
 protected:
     // returns an empty collection if children have empty or
@@ -488,7 +495,20 @@ protected:
 
     virtual bool isPositive(size_t index) const { (void) index; return true; }
 
-    bool should_do_termwise_eval(const UnpackInfo &unpack, double match_limit) const;
+    /**
+     * Cost of evaluating the children that allow termwise evaluation
+     * (and need no unpacking) as part of the iterator tree, compared
+     * to evaluating them termwise into a bitvector up front.
+     **/
+    struct TermwiseCost {
+        double inline_cost;
+        double termwise_cost;
+    };
+    TermwiseCost calculate_termwise_cost(const UnpackInfo &unpack) const;
+
+    // With the cost model the match limit is ignored and termwise
+    // evaluation is only selected when it is estimated to be cheaper.
+    bool should_do_termwise_eval(const UnpackInfo &unpack, double match_limit, bool use_cost_model) const;
 
     const Children& get_children() const { return _children; }
 
@@ -586,6 +606,7 @@ struct SimpleLeafBlueprint : LeafBlueprint {
     explicit SimpleLeafBlueprint(FieldSpecBase field) noexcept : LeafBlueprint(field, true) {}
     explicit SimpleLeafBlueprint(FieldSpecBaseList fields) noexcept: LeafBlueprint(std::move(fields), true) {}
     void sort(InFlow in_flow) override;
+    const SimpleLeafBlueprint * asSimpleLeaf() const noexcept final { return this; }
 };
 
 // for leaf nodes representing more complex structures like wand/phrase
@@ -108,10 +108,11 @@ CreateBlueprintVisitorHelper::visitDotProduct(query::DotProduct &n)
 void
 CreateBlueprintVisitorHelper::visitWandTerm(query::WandTerm &n)
 {
-    createWeightedSet(std::make_unique<ParallelWeakAndBlueprint>(_field, n.getTargetNumHits(),
-                                                                 n.getScoreThreshold(), n.getThresholdBoostFactor(),
-                                                                 is_search_multi_threaded()),
-                      n);
+    auto bp = std::make_unique<ParallelWeakAndBlueprint>(_field, n.getTargetNumHits(),
+                                                         n.getScoreThreshold(), n.getThresholdBoostFactor(),
+                                                         is_search_multi_threaded());
+    bp->set_rank_score_threshold(getRequestContext().get_rank_score_threshold());
+    createWeightedSet(std::move(bp), n);
 }
 
 void
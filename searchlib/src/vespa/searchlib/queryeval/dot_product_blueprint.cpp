@@ -4,6 +4,7 @@
 #include "dot_product_search.h"
 #include "flow_tuning.h"
 #include "field_spec.hpp"
+#include "parallel_fetch_postings.h"
 #include <vespa/vespalib/objects/visit.hpp>
 
 namespace search::queryeval {
@@ -89,7 +90,7 @@ void
 DotProductBlueprint::fetchPostings(const ExecuteInfo &execInfo)
 {
     for (size_t i = 0; i < _terms.size(); ++i) {
-        _terms[i]->fetchPostings(execInfo);
+        ParallelFetchPostings::fetch(*_terms[i], execInfo);
     }    
 }
 
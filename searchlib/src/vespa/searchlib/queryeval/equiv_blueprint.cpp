@@ -4,6 +4,7 @@
 #include "equivsearch.h"
 #include "field_spec.hpp"
 #include "flow_tuning.h"
+#include "parallel_fetch_postings.h"
 #include <vespa/vespalib/objects/visit.hpp>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 
@@ -115,7 +116,7 @@ void
 EquivBlueprint::fetchPostings(const ExecuteInfo &execInfo)
 {
     for (size_t i = 0; i < _terms.size(); ++i) {
-        _terms[i]->fetchPostings(execInfo);
+        ParallelFetchPostings::fetch(*_terms[i], execInfo);
     }
 }
 
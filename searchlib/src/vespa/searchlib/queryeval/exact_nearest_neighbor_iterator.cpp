@@ -2,6 +2,7 @@
 
 #include "exact_nearest_neighbor_iterator.h"
 #include "global_filter.h"
+#include "rank_score_threshold.h"
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/tensor/distance_calculator.h>
 #include <vespa/searchlib/tensor/distance_function.h>
@@ -15,11 +16,13 @@ namespace search::queryeval {
 ExactNearestNeighborIterator::Params::Params(fef::TermFieldMatchData &tfmd_in,
                                              std::unique_ptr<search::tensor::DistanceCalculator> distance_calc_in,
                                              NearestNeighborDistanceHeap &distanceHeap_in,
-                                             const GlobalFilter &filter_in)
+                                             const GlobalFilter &filter_in,
+                                             const RankScoreThreshold *score_threshold_in)
     : tfmd(tfmd_in),
       distance_calc(std::move(distance_calc_in)),
       distanceHeap(distanceHeap_in),
-      filter(filter_in)
+      filter(filter_in),
+      score_threshold(score_threshold_in)
 {}
 
 ExactNearestNeighborIterator::Params::Params(Params&& rhs) = default;
@@ -50,7 +53,7 @@ public:
         while (__builtin_expect((docId < getEndId()), true)) {
             if ((!has_filter) || params().filter.check(docId)) {
                 double d = computeDistance(docId, distanceLimit);
-                if (d <= distanceLimit) {
+                if ((d <= distanceLimit) && can_beat_score_threshold(d)) {
                     _lastScore = d;
                     setDocId(docId);
                     return;
@@ -76,6 +79,11 @@ public:
     Trinary is_strict() const override { return strict ? Trinary::True : Trinary::False ; }
 
 private:
+    bool can_beat_score_threshold(double distance) const {
+        const RankScoreThreshold *threshold = params().score_threshold;
+        return ((threshold == nullptr) ||
+                !(params().distance_calc->function().to_rawscore(distance) < threshold->get()));
+    }
     double computeDistance(uint32_t docId, double limit) {
         return params().distance_calc->template calc_with_limit<has_single_subspace>(docId, limit);
     }
@@ -119,9 +127,9 @@ std::unique_ptr<ExactNearestNeighborIterator>
 ExactNearestNeighborIterator::create(bool strict, fef::TermFieldMatchData &tfmd,
                                      std::unique_ptr<search::tensor::DistanceCalculator> distance_calc,
                                      NearestNeighborDistanceHeap &distanceHeap, const GlobalFilter &filter,
-                                     bool readonly_distance_heap)
+                                     bool readonly_distance_heap, const RankScoreThreshold *score_threshold)
 {
-    Params params(tfmd, std::move(distance_calc), distanceHeap, filter);
+    Params params(tfmd, std::move(distance_calc), distanceHeap, filter, score_threshold);
     if (filter.is_active()) {
         return resolve_strict<true>(strict, readonly_distance_heap, std::move(params));
     } else  {
@@ -15,6 +15,7 @@ namespace search::tensor { class DistanceCalculator; }
 namespace search::queryeval {
 
 class GlobalFilter;
+class RankScoreThreshold;
 
 class ExactNearestNeighborIterator : public SearchIterator
 {
@@ -27,11 +28,14 @@ public:
         std::unique_ptr<search::tensor::DistanceCalculator> distance_calc;
         NearestNeighborDistanceHeap &distanceHeap;
         const GlobalFilter &filter;
+        // optional first-phase rank score shared by all match threads; documents with a lower raw score are skipped
+        const RankScoreThreshold *score_threshold;
 
         Params(fef::TermFieldMatchData &tfmd_in,
                std::unique_ptr<search::tensor::DistanceCalculator> distance_calc_in,
                NearestNeighborDistanceHeap &distanceHeap_in,
-               const GlobalFilter &filter_in);
+               const GlobalFilter &filter_in,
+               const RankScoreThreshold *score_threshold_in = nullptr);
         Params(Params&& rhs);
         ~Params();
     };
@@ -46,7 +50,8 @@ public:
             std::unique_ptr<search::tensor::DistanceCalculator> distance_calc,
             NearestNeighborDistanceHeap &distanceHeap,
             const GlobalFilter &filter,
-            bool readonly_distance_heap);
+            bool readonly_distance_heap,
+            const RankScoreThreshold *score_threshold = nullptr);
 
     const Params& params() const { return _params; }
 private:
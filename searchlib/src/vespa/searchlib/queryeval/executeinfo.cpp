@@ -5,10 +5,10 @@
 using vespalib::Doom;
 namespace search::queryeval {
 
-const ExecuteInfo ExecuteInfo::FULL(1.0, Doom::never(), vespalib::ThreadBundle::trivial());
+const ExecuteInfo ExecuteInfo::FULL(1.0, Doom::never(), vespalib::ThreadBundle::trivial(), nullptr);
 
 ExecuteInfo::ExecuteInfo() noexcept
-    : ExecuteInfo(1.0, Doom::never(), vespalib::ThreadBundle::trivial())
+    : ExecuteInfo(1.0, Doom::never(), vespalib::ThreadBundle::trivial(), nullptr)
 { }
 
 ExecuteInfo
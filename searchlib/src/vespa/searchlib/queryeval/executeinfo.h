@@ -7,6 +7,8 @@
 
 namespace search::queryeval {
 
+class ParallelFetchPostings;
+
 /**
  * Holds information about how query will be executed and how large part of corpus will pass through.
  * @author baldersheim
@@ -17,19 +19,24 @@ public:
     double hit_rate() const noexcept { return _hitRate; }
     const vespalib::Doom & doom() const noexcept { return _doom; }
     vespalib::ThreadBundle & thread_bundle() const noexcept { return _thread_bundle; }
+    // when set, fetchPostings for simple leafs may be deferred (see ParallelFetchPostings)
+    ParallelFetchPostings * deferred() const noexcept { return _deferred; }
 
     static const ExecuteInfo FULL;
     static ExecuteInfo create(const ExecuteInfo & org) noexcept {
         return create(org._hitRate, org);
     }
     static ExecuteInfo create(double hitRate, const ExecuteInfo & org) noexcept {
-        return {hitRate, org._doom, org.thread_bundle()};
+        return {hitRate, org._doom, org.thread_bundle(), org._deferred};
+    }
+    static ExecuteInfo create_deferred(const ExecuteInfo & org, ParallelFetchPostings & deferred) noexcept {
+        return {org._hitRate, org._doom, org.thread_bundle(), &deferred};
     }
 
     static ExecuteInfo create(double hitRate, const vespalib::Doom & doom,
                               vespalib::ThreadBundle & thread_bundle_in) noexcept
     {
-         return {hitRate, doom, thread_bundle_in};
+         return {hitRate, doom, thread_bundle_in, nullptr};
     }
     static ExecuteInfo createForTest() noexcept {
         return createForTest(1.0);
@@ -40,14 +47,16 @@ public:
     }
 private:
     ExecuteInfo(double hitRate_in, const vespalib::Doom & doom,
-                vespalib::ThreadBundle & thread_bundle_in) noexcept
+                vespalib::ThreadBundle & thread_bundle_in, ParallelFetchPostings * deferred) noexcept
         : _doom(doom),
           _thread_bundle(thread_bundle_in),
-          _hitRate(hitRate_in)
+          _hitRate(hitRate_in),
+          _deferred(deferred)
     { }
     const vespalib::Doom     _doom;
     vespalib::ThreadBundle & _thread_bundle;
     double                   _hitRate;
+    ParallelFetchPostings  * _deferred;
 };
 
 }
@@ -122,6 +122,14 @@ inline double bitvector_strict_cost(double my_est) {
     return 1.5 * my_est;
 }
 
+// Cost of evaluating children termwise into a bitvector covering the
+// docid space, on top of the strict cost of the children themselves.
+// The bitvector is cleared up front and each child is combined into
+// it one word (64 docids) at a time.
+inline double termwise_overhead(size_t num_children) {
+    return (num_children + 1) / 64.0;
+}
+
 // Strict cost of matching in a disk index posting list.
 // Test used: IteratorBenchmark::analyze_term_search_in_disk_index
 inline double disk_index_strict_cost(double my_est) {
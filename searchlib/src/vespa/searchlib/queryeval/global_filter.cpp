@@ -9,6 +9,7 @@
 #include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/engine/trace.h>
 #include <vespa/vespalib/data/slime/slime.h>
+#include <algorithm>
 #include <cassert>
 
 using search::engine::Trace;
@@ -52,6 +53,31 @@ struct BitVectorFilter : public GlobalFilter {
     bool check(uint32_t docid) const override { return vector->testBit(docid); }
 };
 
+struct SparseFilter : public GlobalFilter {
+    std::vector<uint32_t> docids;
+    uint32_t docid_limit;
+    bool inverted;
+    SparseFilter(std::vector<uint32_t> docids_in, uint32_t docid_limit_in, bool inverted_in) noexcept
+      : docids(std::move(docids_in)),
+        docid_limit(docid_limit_in),
+        inverted(inverted_in) {}
+    ~SparseFilter() override;
+    bool is_active() const override { return true; }
+    uint32_t size() const override { return docid_limit; }
+    uint32_t count() const override {
+        return inverted ? (std::max(docid_limit, 1u) - 1 - docids.size()) : docids.size();
+    }
+    bool check(uint32_t docid) const override {
+        return std::binary_search(docids.begin(), docids.end(), docid) != inverted;
+    }
+    Representation representation() const override {
+        return inverted ? Representation::INVERTED : Representation::SPARSE;
+    }
+    std::span<const uint32_t> sparse_docids() const override { return docids; }
+};
+
+SparseFilter::~SparseFilter() = default;
+
 struct MultiBitVectorFilter : public GlobalFilter {
     std::vector<std::unique_ptr<BitVector>> vectors;
     std::vector<uint32_t> splits;
@@ -80,24 +106,41 @@ struct MultiBitVectorFilter : public GlobalFilter {
 struct PartResult {
     Trinary matches_any;
     std::unique_ptr<BitVector> bits;
+    std::vector<uint32_t> docids;
     PartResult()
-      : matches_any(Trinary::False), bits() {}
+      : matches_any(Trinary::False), bits(), docids() {}
     explicit PartResult(Trinary matches_any_in)
-      : matches_any(matches_any_in), bits() {}
+      : matches_any(matches_any_in), bits(), docids() {}
     explicit PartResult(std::unique_ptr<BitVector> &&bits_in)
-      : matches_any(Trinary::Undefined), bits(std::move(bits_in)) {}
+      : matches_any(Trinary::Undefined), bits(std::move(bits_in)), docids() {}
+    explicit PartResult(std::vector<uint32_t> &&docids_in)
+      : matches_any(Trinary::Undefined), bits(), docids(std::move(docids_in)) {}
 };
 
+std::vector<uint32_t> collect_docids(SearchIterator &filter, uint32_t begin, uint32_t end) {
+    std::vector<uint32_t> docids;
+    uint32_t docid = begin;
+    while (docid < end) {
+        if (filter.seek(docid)) {
+            docids.push_back(docid++);
+        } else {
+            docid = std::max(docid + 1, filter.getDocId());
+        }
+    }
+    return docids;
+}
+
 struct MakePart : Runnable {
     Blueprint &blueprint;
     uint32_t begin;
     uint32_t end;
+    bool sparse;
     PartResult result;
     std::unique_ptr<Trace> trace;
     std::unique_ptr<ExecutionProfiler> profiler;
     MakePart(MakePart &&) = default;
-    MakePart(Blueprint &blueprint_in, uint32_t begin_in, uint32_t end_in, Trace *parent_trace)
-      : blueprint(blueprint_in), begin(begin_in), end(end_in), result(), trace(), profiler()
+    MakePart(Blueprint &blueprint_in, uint32_t begin_in, uint32_t end_in, bool sparse_in, Trace *parent_trace)
+      : blueprint(blueprint_in), begin(begin_in), end(end_in), sparse(sparse_in), result(), trace(), profiler()
     {
         if (parent_trace && parent_trace->getLevel() > 0) {
             trace = parent_trace->make_trace_up();
@@ -121,10 +164,14 @@ struct MakePart : Runnable {
                 filter = ProfiledIterator::profile(*profiler, std::move(filter));
             }
             filter->initRange(begin, end);
-            auto bits = filter->get_hits(begin);
-            // count bits in parallel and cache the results for later
-            bits->countTrueBits();
-            result = PartResult(std::move(bits));
+            if (sparse) {
+                result = PartResult(collect_docids(*filter, begin, end));
+            } else {
+                auto bits = filter->get_hits(begin);
+                // count bits in parallel and cache the results for later
+                bits->countTrueBits();
+                result = PartResult(std::move(bits));
+            }
         } else {
             result = PartResult(matches_any);
         }
@@ -136,6 +183,66 @@ struct MakePart : Runnable {
 };
 MakePart::~MakePart() = default;
 
+// Extracts the set (or cleared) bits of a part into a sorted docid array
+struct ExtractPart : Runnable {
+    const BitVector &bits;
+    bool inverted;
+    std::vector<uint32_t> docids;
+    ExtractPart(const BitVector &bits_in, bool inverted_in) noexcept
+      : bits(bits_in), inverted(inverted_in), docids() {}
+    void run() override {
+        auto add = [this](uint32_t docid) { docids.push_back(docid); };
+        if (inverted) {
+            docids.reserve(bits.size() - bits.getStartIndex() - bits.countTrueBits());
+            bits.foreach_falsebit(add, bits.getStartIndex(), bits.size());
+        } else {
+            docids.reserve(bits.countTrueBits());
+            bits.foreach_truebit(add, bits.getStartIndex(), bits.size());
+        }
+    }
+    ~ExtractPart() override;
+};
+ExtractPart::~ExtractPart() = default;
+
+template <typename Parts>
+std::vector<uint32_t> concat_docids(Parts &parts) {
+    size_t total = 0;
+    for (const auto &part: parts) {
+        total += part.docids.size();
+    }
+    std::vector<uint32_t> docids;
+    docids.reserve(total);
+    for (const auto &part: parts) {
+        docids.insert(docids.end(), part.docids.begin(), part.docids.end());
+    }
+    return docids;
+}
+
+std::shared_ptr<GlobalFilter>
+create_from_bitvectors(std::vector<std::unique_ptr<BitVector>> vectors, uint32_t docid_limit, ThreadBundle &thread_bundle)
+{
+    uint32_t total_count = 0;
+    for (const auto &bits: vectors) {
+        total_count += bits->countTrueBits();
+    }
+    double hit_ratio = double(total_count) / std::max(docid_limit, 2u);
+    bool sparse = (hit_ratio < GlobalFilter::sparse_hit_ratio);
+    bool inverted = ((1.0 - hit_ratio) < GlobalFilter::sparse_hit_ratio);
+    if (sparse || inverted) {
+        std::vector<ExtractPart> parts;
+        parts.reserve(vectors.size());
+        for (const auto &bits: vectors) {
+            parts.emplace_back(*bits, inverted);
+        }
+        thread_bundle.run(parts);
+        return GlobalFilter::create_sparse(concat_docids(parts), docid_limit, inverted);
+    }
+    if (vectors.size() == 1) {
+        return GlobalFilter::create(std::move(vectors[0]));
+    }
+    return GlobalFilter::create(std::move(vectors));
+}
+
 void insert_traces(Trace *trace, const std::vector<MakePart> &parts) {
     if (trace) {
         auto inserter = trace->make_inserter("global_filter_execution"_ssv);
@@ -199,18 +306,26 @@ GlobalFilter::create(std::vector<std::unique_ptr<BitVector>> vectors)
                                                   total_size, total_count);
 }
 
+std::shared_ptr<GlobalFilter>
+GlobalFilter::create_sparse(std::vector<uint32_t> docids, uint32_t size, bool inverted)
+{
+    return std::make_shared<SparseFilter>(std::move(docids), size, inverted);
+}
+
 std::shared_ptr<GlobalFilter>
 GlobalFilter::create(Blueprint &blueprint, uint32_t docid_limit, ThreadBundle &thread_bundle, Trace *trace)
 {
     uint32_t num_threads = thread_bundle.size();
     std::vector<MakePart> parts;
     parts.reserve(num_threads);
+    // Collect docids directly when the flow estimate says few documents will match
+    bool sparse = (blueprint.estimate() < sparse_hit_ratio);
     uint32_t docid = 1;
     uint32_t per_thread = (docid_limit - docid) / num_threads;
     uint32_t rest_docs = (docid_limit - docid) % num_threads;
     while (docid < docid_limit) {
         uint32_t part_size = per_thread + (parts.size() < rest_docs);
-        parts.emplace_back(blueprint, docid, docid + part_size, trace);
+        parts.emplace_back(blueprint, docid, docid + part_size, sparse, trace);
         docid += part_size;
     }
     assert(parts.size() <= num_threads);
@@ -218,19 +333,32 @@ GlobalFilter::create(Blueprint &blueprint, uint32_t docid_limit, ThreadBundle &t
     thread_bundle.run(parts);
     insert_traces(trace, parts);
     std::vector<std::unique_ptr<BitVector>> vectors;
+    if (parts.empty()) {
+        return create(std::move(vectors));
+    }
     vectors.reserve(parts.size());
+    std::vector<PartResult> sparse_parts;
     for (MakePart &part: parts) {
         switch (part.result.matches_any) {
         case Trinary::False: return std::make_unique<EmptyFilter>(docid_limit);
         case Trinary::True: return create(); // filter not needed after all
         case Trinary::Undefined:
-            vectors.push_back(std::move(part.result.bits));
+            if (sparse) {
+                sparse_parts.push_back(std::move(part.result));
+            } else {
+                vectors.push_back(std::move(part.result.bits));
+            }
         }
     }
-    if (vectors.size() == 1) {
-        return create(std::move(vectors[0]));
+    if (sparse) {
+        auto docids = concat_docids(sparse_parts);
+        if (docids.size() >= sparse_hit_ratio * docid_limit) {
+            // flow estimate was too low, fall back to a bitvector
+            return create(docids, docid_limit);
+        }
+        return create_sparse(std::move(docids), docid_limit, false);
     }
-    return create(std::move(vectors));
+    return create_from_bitvectors(std::move(vectors), docid_limit, thread_bundle);
 }
 
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <vector>
 
 namespace vespalib { struct ThreadBundle; }
@@ -20,11 +21,19 @@ class Blueprint;
  * white-list (documents that may possibly become hits have their bit
  * set, documents that are certain to be filtered away should have
  * theirs cleared).
+ *
+ * Filters built from a blueprint pick their representation based on
+ * how many documents they match: a sorted array of matching docids
+ * when few documents match, a sorted array of non-matching docids when
+ * almost all documents match, and bitvectors otherwise.
  **/
 class GlobalFilter : public std::enable_shared_from_this<GlobalFilter>
 {
 public:
     using Trace = search::engine::Trace;
+    enum class Representation { BITVECTOR, SPARSE, INVERTED };
+    // Below this hit ratio (or above 1 minus it) a docid array is smaller than a bitvector
+    static constexpr double sparse_hit_ratio = 1.0 / 64;
     GlobalFilter() noexcept;
     GlobalFilter(const GlobalFilter &) = delete;
     GlobalFilter(GlobalFilter &&) = delete;
@@ -32,6 +41,9 @@ public:
     virtual uint32_t size() const = 0;
     virtual uint32_t count() const = 0;
     virtual bool check(uint32_t docid) const = 0;
+    virtual Representation representation() const { return Representation::BITVECTOR; }
+    // Sorted docids matching (SPARSE) or not matching (INVERTED) the filter, empty for bitvectors
+    virtual std::span<const uint32_t> sparse_docids() const { return {}; }
     virtual ~GlobalFilter();
 
     const GlobalFilter *ptr_if_active() const {
@@ -42,6 +54,8 @@ public:
     static std::shared_ptr<GlobalFilter> create(const std::vector<uint32_t> & docids, uint32_t size);
     static std::shared_ptr<GlobalFilter> create(std::unique_ptr<BitVector> vector);
     static std::shared_ptr<GlobalFilter> create(std::vector<std::unique_ptr<BitVector>> vectors);
+    // 'docids' must be sorted; they are the documents not matching when 'inverted' is set
+    static std::shared_ptr<GlobalFilter> create_sparse(std::vector<uint32_t> docids, uint32_t size, bool inverted);
     static std::shared_ptr<GlobalFilter> create(Blueprint &blueprint, uint32_t docid_limit, vespalib::ThreadBundle &thread_bundle, Trace *trace);
     static std::shared_ptr<GlobalFilter> create(Blueprint &blueprint, uint32_t docid_limit, vespalib::ThreadBundle &thread_bundle) {
         return create(blueprint, docid_limit, thread_bundle, nullptr);
@@ -8,6 +8,50 @@
 
 namespace search::queryeval {
 
+void
+HitCollector::startKeepingBestHits()
+{
+    if (_maxHitsSize >= MIN_HITS_SIZE_FOR_BUFFERING) {
+        // buffer hits beating the threshold and select the best ones
+        // only when the buffer is full, instead of updating a heap per hit
+        _hits.reserve(_maxHitsSize * 2);
+        _maxBufferedDocId = 0;
+        for (const auto& hit : _hits) {
+            _maxBufferedDocId = std::max(_maxBufferedDocId, hit.first);
+        }
+        _hitsSortOrder = SortOrder::BUFFERED;
+        compactBufferedHits();
+    } else {
+        // treat hit vector as a heap
+        std::make_heap(_hits.begin(), _hits.end(), ScoreComparator());
+        _hitsSortOrder = SortOrder::HEAP;
+        _scoreThreshold = _hits[0].second;
+    }
+}
+
+void
+HitCollector::compactBufferedHits()
+{
+    // keeps the same hits as the heap would have, since ties are
+    // resolved by doc id and buffered hits arrive in doc id order
+    std::nth_element(_hits.begin(), _hits.begin() + (_maxHitsSize - 1), _hits.end(), ScoreComparator());
+    _hits.resize(_maxHitsSize);
+    _scoreThreshold = _hits.back().second;
+}
+
+void
+HitCollector::makeHeapOfBufferedHits()
+{
+    if (_hitsSortOrder == SortOrder::BUFFERED) {
+        if (_hits.size() > _maxHitsSize) {
+            compactBufferedHits();
+        }
+        std::make_heap(_hits.begin(), _hits.end(), ScoreComparator());
+        _hitsSortOrder = SortOrder::HEAP;
+        _scoreThreshold = _hits[0].second;
+    }
+}
+
 void
 HitCollector::sortHitsByScore(size_t topn)
 {
@@ -41,6 +85,8 @@ HitCollector::HitCollector(uint32_t numDocs, uint32_t maxHitsSize)
       _maxDocIdVectorSize((numDocs + 31) / 32),
       _hits(),
       _hitsSortOrder(SortOrder::DOC_ID),
+      _scoreThreshold(0.0),
+      _maxBufferedDocId(0),
       _unordered(false),
       _docIdVector(),
       _bitVector(),
@@ -85,11 +131,27 @@ HitCollector::BitVectorCollector<CollectRankedHit>::collect(uint32_t docId, feat
 
 void
 HitCollector::CollectorBase::replaceHitInVector(uint32_t docId, feature_t score) noexcept {
+    if (_hc._hitsSortOrder == SortOrder::BUFFERED) {
+        if (__builtin_expect((docId > _hc._maxBufferedDocId), true)) {
+            _hc._hits.emplace_back(docId, score);
+            _hc._maxBufferedDocId = docId;
+            if (_hc._hits.size() == (_hc._maxHitsSize * 2)) {
+                _hc.compactBufferedHits();
+            }
+            return;
+        }
+        // out of order hits; the heap resolves score ties by arrival order
+        _hc.makeHeapOfBufferedHits();
+        if (!(score > _hc._scoreThreshold)) {
+            return;
+        }
+    }
     // replace lowest scored hit in hit vector
     std::pop_heap(_hc._hits.begin(), _hc._hits.end(), ScoreComparator());
     _hc._hits.back().first = docId;
     _hc._hits.back().second = score;
     std::push_heap(_hc._hits.begin(), _hc._hits.end(), ScoreComparator());
+    _hc._scoreThreshold = _hc._hits[0].second;
 }
 
 void
@@ -118,9 +180,7 @@ HitCollector::RankedHitCollector::collectAndChangeCollector(uint32_t docId, feat
         hc._bitVector->setBit(docId);
         newCollector = std::make_unique<BitVectorCollector<true>>(hc);
     }
-    // treat hit vector as a heap
-    std::make_heap(hc._hits.begin(), hc._hits.end(), ScoreComparator());
-    hc._hitsSortOrder = SortOrder::HEAP;
+    hc.startKeepingBestHits();
     this->considerForHitVector(docId, score);
     hc._collector = std::move(newCollector); // note - self-destruct.
 }
@@ -166,6 +226,7 @@ HitCollector::DocIdCollector<CollectRankedHit>::collectAndChangeCollector(uint32
 SortedHitSequence
 HitCollector::getSortedHitSequence(size_t max_hits)
 {
+    makeHeapOfBufferedHits();
     size_t num_hits = std::min(_hits.size(), max_hits);
     sortHitsByScore(num_hits);
     return {_hits.data(), _scoreOrder.data(), num_hits};
@@ -378,6 +439,7 @@ HitCollector::get_result_set(std::optional<double> second_phase_rank_drop_limit,
     }
 
     // destroys the heap property or score sort order
+    makeHeapOfBufferedHits();
     sortHitsByDocId();
 
     auto rs = std::make_unique<ResultSet>();
@@ -21,15 +21,21 @@ public:
     using Hit = std::pair<uint32_t, feature_t>;
 
 private:
-    enum class SortOrder { NONE, DOC_ID, HEAP };
+    // BUFFERED: the best hits followed by candidates scoring above _scoreThreshold
+    enum class SortOrder { NONE, DOC_ID, HEAP, BUFFERED };
+
+    // Smaller hit vectors are kept as a heap at all times
+    static constexpr uint32_t MIN_HITS_SIZE_FOR_BUFFERING = 128;
 
     const uint32_t _numDocs;
     const uint32_t _maxHitsSize;
     const uint32_t _maxDocIdVectorSize;
 
-    std::vector<Hit>            _hits;  // used as a heap when _hits.size == _maxHitsSize
+    std::vector<Hit>            _hits;  // used as a heap or buffer when _hits.size reaches _maxHitsSize
     std::vector<uint32_t>       _scoreOrder; // Holds an indirection to the N best hits
     SortOrder                   _hitsSortOrder;
+    feature_t                   _scoreThreshold; // lowest kept score when hit vector is full
+    uint32_t                    _maxBufferedDocId;
     bool                        _unordered;
     std::vector<uint32_t>       _docIdVector;
     std::unique_ptr<BitVector>  _bitVector;
@@ -87,7 +93,7 @@ private:
     public:
         explicit CollectorBase(HitCollector &hc) noexcept : _hc(hc) { }
         void considerForHitVector(uint32_t docId, feature_t score) {
-            if (__builtin_expect((score > _hc._hits[0].second), false)) {
+            if (__builtin_expect((score > _hc._scoreThreshold), false)) {
                 replaceHitInVector(docId, score);
             }
         }
@@ -119,6 +125,9 @@ private:
         void collect(uint32_t docId, feature_t score) override;
     };
 
+    VESPA_DLL_LOCAL void startKeepingBestHits();
+    VESPA_DLL_LOCAL void compactBufferedHits();
+    VESPA_DLL_LOCAL void makeHeapOfBufferedHits();
     VESPA_DLL_LOCAL void sortHitsByScore(size_t topn);
     VESPA_DLL_LOCAL void sortHitsByDocId();
 
@@ -151,6 +160,21 @@ public:
         _collector->collect(docId, score);
     }
 
+    /**
+     * Returns a score a new hit must beat to be kept among the n
+     * (=maxHitsSize) best hits, or nothing while there is still room
+     * for more ranked hits. The returned value never decreases as
+     * more hits are added. With large hit vectors it is only updated
+     * when buffered hits are compacted, and may lag behind the actual
+     * lowest kept score.
+     **/
+    std::optional<feature_t> get_score_threshold() const noexcept {
+        if (((_hitsSortOrder == SortOrder::HEAP) || (_hitsSortOrder == SortOrder::BUFFERED)) && !_hits.empty()) {
+            return _scoreThreshold;
+        }
+        return std::nullopt;
+    }
+
     /**
      * Returns a sorted sequence of hits that reference internal
      * data. The number of hits returned in the sequence is controlled
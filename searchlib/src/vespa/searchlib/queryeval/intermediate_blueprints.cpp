@@ -184,7 +184,7 @@ AndNotBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
                                           search::fef::MatchData &md) const
 {
     UnpackInfo unpack_info(calculateUnpackInfo(md));
-    if (should_do_termwise_eval(unpack_info, md.get_termwise_limit())) {
+    if (should_do_termwise_eval(unpack_info, md.get_termwise_limit(), md.use_termwise_cost_model())) {
         TermwiseBlueprintHelper helper(*this, std::move(sub_searches), unpack_info);
         bool termwise_strict = ((helper.first_termwise < childCnt()) &&
                                 getChild(helper.first_termwise).strict());
@@ -214,6 +214,16 @@ AndNotBlueprint::my_flow(InFlow in_flow) const
     return AnyFlow::create<AndNotFlow>(in_flow);
 }
 
+double
+AndNotBlueprint::termwise_estimate_of(const std::vector<const Blueprint *> &children) const
+{
+    // termwise children not including the positive child are combined using OR
+    if (!children.empty() && (children[0] == &getChild(0))) {
+        return AndNotFlow::estimate_of(children);
+    }
+    return OrFlow::estimate_of(children);
+}
+
 //-----------------------------------------------------------------------------
 
 FlowStats
@@ -283,7 +293,7 @@ AndBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
 {
     UnpackInfo unpack_info(calculateUnpackInfo(md));
     std::unique_ptr<AndSearch> search;
-    if (should_do_termwise_eval(unpack_info, md.get_termwise_limit())) {
+    if (should_do_termwise_eval(unpack_info, md.get_termwise_limit(), md.use_termwise_cost_model())) {
         TermwiseBlueprintHelper helper(*this, std::move(sub_searches), unpack_info);
         bool termwise_strict = ((helper.first_termwise < childCnt()) &&
                                 getChild(helper.first_termwise).strict());
@@ -314,6 +324,12 @@ AndBlueprint::my_flow(InFlow in_flow) const
     return AnyFlow::create<AndFlow>(in_flow);
 }
 
+double
+AndBlueprint::termwise_estimate_of(const std::vector<const Blueprint *> &children) const
+{
+    return AndFlow::estimate_of(children);
+}
+
 //-----------------------------------------------------------------------------
 
 OrBlueprint::~OrBlueprint() = default;
@@ -382,7 +398,7 @@ OrBlueprint::createIntermediateSearch(MultiSearch::Children sub_searches,
                                       search::fef::MatchData & md) const
 {
     UnpackInfo unpack_info(calculateUnpackInfo(md));
-    if (should_do_termwise_eval(unpack_info, md.get_termwise_limit())) {
+    if (should_do_termwise_eval(unpack_info, md.get_termwise_limit(), md.use_termwise_cost_model())) {
         TermwiseBlueprintHelper helper(*this, std::move(sub_searches), unpack_info);
         bool termwise_strict = ((helper.first_termwise < childCnt()) &&
                                 getChild(helper.first_termwise).strict());
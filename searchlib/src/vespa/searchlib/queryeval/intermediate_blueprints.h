@@ -32,6 +32,7 @@ public:
     createFilterSearchImpl(FilterConstraint constraint) const override;
 private:
     AnyFlow my_flow(InFlow in_flow) const override;
+    double termwise_estimate_of(const std::vector<const Blueprint *> &children) const override;
     uint8_t calculate_cost_tier() const override {
         return (childCnt() > 0) ? get_children()[0]->getState().cost_tier() : State::COST_TIER_NORMAL;
     }
@@ -59,6 +60,7 @@ public:
     createFilterSearchImpl(FilterConstraint constraint) const override;
 private:
     AnyFlow my_flow(InFlow in_flow) const override;
+    double termwise_estimate_of(const std::vector<const Blueprint *> &children) const override;
 };
 
 //-----------------------------------------------------------------------------
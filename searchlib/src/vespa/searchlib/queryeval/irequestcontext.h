@@ -16,6 +16,7 @@ namespace search::queryeval {
 
 struct CreateBlueprintParams;
 class IElementGapInspector;
+class RankScoreThreshold;
 
 /**
  * Provides a context that follows the life of a query.
@@ -54,6 +55,14 @@ public:
     virtual const MetaStoreReadGuardSP * getMetaStoreReadGuard() const = 0;
 
     virtual const IElementGapInspector& get_element_gap_inspector() const noexcept = 0;
+
+    /**
+     * Returns the shared first-phase rank score threshold for this
+     * query, or nullptr if threshold pushdown is not enabled. Only
+     * usable by iterators whose raw score bounds the first-phase rank
+     * score from above.
+     */
+    virtual const RankScoreThreshold *get_rank_score_threshold() const noexcept { return nullptr; }
 };
 
 }
@@ -45,6 +45,10 @@ public:
         return _childMatch[ref]->getWeight();
     }
 
+    SearchIterator::BlockMaxMeta get_block_max(uint32_t ref) const noexcept {
+        return _children[ref]->get_block_max();
+    }
+
     void unpack(uint32_t ref, uint32_t docid) {
         _children[ref]->doUnpack(docid);
     }
@@ -115,6 +115,7 @@ public:
     }
     Trinary is_strict() const override { return _search->is_strict(); }
     const PostingInfo *getPostingInfo() const override;
+    BlockMaxMeta get_block_max() const noexcept override { return _search->get_block_max(); }
     void visitMembers(vespalib::ObjectVisitor &visitor) const override;
 
     const SearchIterator &getIterator() const { return *_search; }
@@ -8,18 +8,132 @@
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
 #include <vespa/searchlib/tensor/distance_function_factory.h>
 #include <vespa/vespalib/objects/objectvisitor.h>
+#include <vespa/vespalib/util/doom.h>
+#include <vespa/vespalib/util/runnable.h>
+#include <vespa/vespalib/util/thread_bundle.h>
+#include <algorithm>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".searchlib.queryeval.nearest_neighbor_blueprint");
 
+using search::tensor::DistanceCalculator;
+using search::tensor::ITensorAttribute;
+using vespalib::eval::TypedCells;
 using vespalib::eval::Value;
 
-namespace vespalib { class Doom; }
-
 namespace search::queryeval {
 
 namespace {
 
+using Neighbor = search::tensor::NearestNeighborIndex::Neighbor;
+
+// Number of vectors passed to the batched distance calculation at a time
+constexpr uint32_t exact_top_k_batch_size = 64;
+
+bool
+closer(const Neighbor& lhs, const Neighbor& rhs) noexcept
+{
+    return lhs.distance < rhs.distance;
+}
+
+/*
+ * Brute force search for the k closest documents matching the global
+ * filter in a docid range, run by one of the threads in the thread bundle.
+ * Each part uses its own distance calculator, as bound distance functions
+ * keep scratch space for the conversion of document vectors.
+ */
+class ExactTopKPart : public vespalib::Runnable {
+    const ITensorAttribute& _attr_tensor;
+    const Value&            _query_tensor;
+    const GlobalFilter&     _filter;
+    uint32_t                _k;
+    double                  _distance_threshold;
+    uint32_t                _begin;
+    uint32_t                _end;
+    const vespalib::Doom&   _doom;
+    std::vector<TypedCells> _batch_cells;
+    std::vector<uint32_t>   _batch_docids;
+    std::vector<double>     _batch_distances;
+
+    double distance_limit() const noexcept {
+        return (hits.size() < _k) ? _distance_threshold : std::min(_distance_threshold, hits.front().distance);
+    }
+    void consider(uint32_t docid, double distance) {
+        if (distance <= distance_limit()) {
+            hits.emplace_back(docid, distance);
+            std::push_heap(hits.begin(), hits.end(), closer);
+            if (hits.size() > _k) {
+                std::pop_heap(hits.begin(), hits.end(), closer);
+                hits.pop_back();
+            }
+        }
+    }
+    void flush_batch(const DistanceCalculator& calc) {
+        calc.function().calc_batch(_batch_cells, _batch_distances);
+        distance_computations += _batch_cells.size();
+        for (size_t i = 0; i < _batch_cells.size(); ++i) {
+            consider(_batch_docids[i], _batch_distances[i]);
+        }
+        _batch_cells.clear();
+        _batch_docids.clear();
+    }
+public:
+    std::vector<Neighbor> hits; // max heap on distance while running
+    uint32_t              visited_docs;
+    uint32_t              distance_computations;
+
+    ExactTopKPart(const ITensorAttribute& attr_tensor, const Value& query_tensor, const GlobalFilter& filter,
+                  uint32_t k, double distance_threshold, uint32_t begin, uint32_t end, const vespalib::Doom& doom)
+        : _attr_tensor(attr_tensor),
+          _query_tensor(query_tensor),
+          _filter(filter),
+          _k(k),
+          _distance_threshold(distance_threshold),
+          _begin(begin),
+          _end(end),
+          _doom(doom),
+          _batch_cells(),
+          _batch_docids(),
+          _batch_distances(exact_top_k_batch_size),
+          hits(),
+          visited_docs(0),
+          distance_computations(0)
+    {}
+    ~ExactTopKPart() override;
+    void run() override {
+        DistanceCalculator calc(_attr_tensor, _query_tensor);
+        bool single_subspace = calc.has_single_subspace();
+        for (uint32_t docid = _begin; docid < _end; ++docid) {
+            if (!_filter.check(docid)) {
+                continue;
+            }
+            ++visited_docs;
+            if (single_subspace) {
+                auto cells = _attr_tensor.get_vector(docid, 0);
+                if (cells.non_existing_attribute_value()) [[unlikely]] {
+                    continue;
+                }
+                _batch_cells.push_back(cells);
+                _batch_docids.push_back(docid);
+                if (_batch_cells.size() == exact_top_k_batch_size) {
+                    flush_batch(calc);
+                    if (_doom.soft_doom()) {
+                        break;
+                    }
+                }
+            } else {
+                ++distance_computations;
+                consider(docid, calc.calc_with_limit<false>(docid, distance_limit()));
+            }
+        }
+        if (!_batch_cells.empty()) {
+            flush_batch(calc);
+        }
+    }
+};
+
+ExactTopKPart::~ExactTopKPart() = default;
+
 std::string
 to_string(NearestNeighborBlueprint::Algorithm algorithm)
 {
@@ -27,6 +141,7 @@ to_string(NearestNeighborBlueprint::Algorithm algorithm)
     switch (algorithm) {
         case NNBA::EXACT: return "exact";
         case NNBA::EXACT_FALLBACK: return "exact fallback";
+        case NNBA::EXACT_FALLBACK_TOP_K: return "exact fallback top k";
         case NNBA::INDEX_TOP_K: return "index top k";
         case NNBA::INDEX_TOP_K_WITH_FILTER: return "index top k using filter";
     }
@@ -65,13 +180,16 @@ NearestNeighborBlueprint::NearestNeighborBlueprint(const queryeval::FieldSpec& f
       _target_hits_max_adjustment_factor(target_hits_max_adjustment_factor),
       _distance_heap(target_hits),
       _found_hits(),
+      _search_stats(),
       _algorithm(Algorithm::EXACT),
       _global_filter(GlobalFilter::create()),
       _global_filter_set(false),
       _global_filter_hits(),
       _global_filter_hit_ratio(),
       _doom(doom),
-      _matching_phase(MatchingPhase::FIRST_PHASE)
+      _matching_phase(MatchingPhase::FIRST_PHASE),
+      _rank_score_threshold(nullptr),
+      _thread_bundle(nullptr)
 {
     if (distance_threshold < std::numeric_limits<double>::max()) {
         _distance_threshold = _distance_calc->function().convert_threshold(distance_threshold);
@@ -98,6 +216,10 @@ NearestNeighborBlueprint::set_global_filter(const GlobalFilter &global_filter, d
             _global_filter_hit_ratio = static_cast<double>(_global_filter_hits.value()) / est_hits;
             if (_global_filter_hit_ratio.value() < _global_filter_lower_limit) {
                 _algorithm = Algorithm::EXACT_FALLBACK;
+                if (_thread_bundle != nullptr && _thread_bundle->size() > 1) {
+                    setEstimate(HitEstimate(std::min(_global_filter_hits.value(), _target_hits), false));
+                    perform_exact_top_k();
+                }
             } else {
                 est_hits = std::min(est_hits, _global_filter_hits.value());
             }
@@ -125,14 +247,46 @@ NearestNeighborBlueprint::perform_top_k(const search::tensor::NearestNeighborInd
     const auto &df = _distance_calc->function();
     if (_global_filter->is_active()) {
         _found_hits = nns_index->find_top_k_with_filter(k, df, *_global_filter, _global_filter_hit_ratio.value() < _filter_first_upper_limit, _filter_first_exploration,
-                                                        k + _explore_additional_hits, _exploration_slack, _doom, _distance_threshold);
+                                                        k + _explore_additional_hits, _exploration_slack, _doom, _distance_threshold, &_search_stats);
         _algorithm = Algorithm::INDEX_TOP_K_WITH_FILTER;
     } else {
-        _found_hits = nns_index->find_top_k(k, df, k + _explore_additional_hits, _exploration_slack, _doom, _distance_threshold);
+        _found_hits = nns_index->find_top_k(k, df, k + _explore_additional_hits, _exploration_slack, _doom, _distance_threshold, &_search_stats);
         _algorithm = Algorithm::INDEX_TOP_K;
     }
 }
 
+void
+NearestNeighborBlueprint::perform_exact_top_k()
+{
+    uint32_t k = _target_hits;
+    uint32_t docid_limit = _global_filter->size();
+    uint32_t num_threads = _thread_bundle->size();
+    std::vector<ExactTopKPart> parts;
+    parts.reserve(num_threads);
+    uint32_t docid = 1;
+    uint32_t per_thread = (docid_limit > docid) ? (docid_limit - docid) / num_threads : 0;
+    uint32_t rest_docs = (docid_limit > docid) ? (docid_limit - docid) % num_threads : 0;
+    while (docid < docid_limit) {
+        uint32_t part_size = per_thread + (parts.size() < rest_docs);
+        parts.emplace_back(_attr_tensor, _query_tensor, *_global_filter, k, _distance_threshold, docid, docid + part_size, _doom);
+        docid += part_size;
+    }
+    _thread_bundle->run(parts);
+    _found_hits.clear();
+    for (auto& part : parts) {
+        _found_hits.insert(_found_hits.end(), part.hits.begin(), part.hits.end());
+        _search_stats.visited_nodes += part.visited_docs;
+        _search_stats.distance_computations += part.distance_computations;
+    }
+    if (_found_hits.size() > k) {
+        std::nth_element(_found_hits.begin(), _found_hits.begin() + k, _found_hits.end(), closer);
+        _found_hits.resize(k);
+    }
+    std::sort(_found_hits.begin(), _found_hits.end(),
+              [](const Neighbor& lhs, const Neighbor& rhs) { return lhs.docid < rhs.docid; });
+    _algorithm = Algorithm::EXACT_FALLBACK_TOP_K;
+}
+
 void
 NearestNeighborBlueprint::sort(InFlow in_flow)
 {
@@ -145,16 +299,18 @@ NearestNeighborBlueprint::createLeafSearch(const search::fef::TermFieldMatchData
     assert(tfmda.size() == 1);
     fef::TermFieldMatchData &tfmd = *tfmda[0]; // always search in only one field
     switch (_algorithm) {
+    case Algorithm::EXACT_FALLBACK_TOP_K:
     case Algorithm::INDEX_TOP_K_WITH_FILTER:
     case Algorithm::INDEX_TOP_K:
         return NnsIndexIterator::create(tfmd, _found_hits, _distance_calc->function());
     default:
         ;
     }
+    bool readonly_distance_heap = (_matching_phase != MatchingPhase::FIRST_PHASE);
     return ExactNearestNeighborIterator::create(strict(), tfmd,
                                                 std::make_unique<search::tensor::DistanceCalculator>(_attr_tensor, _query_tensor),
-                                                _distance_heap, *_global_filter,
-                                                _matching_phase != MatchingPhase::FIRST_PHASE);
+                                                _distance_heap, *_global_filter, readonly_distance_heap,
+                                                readonly_distance_heap ? nullptr : _rank_score_threshold);
 }
 
 void
@@ -169,8 +325,13 @@ NearestNeighborBlueprint::visitMembers(vespalib::ObjectVisitor& visitor) const
     visitor.visitBool("wanted_approximate", _approximate);
     visitor.visitBool("has_index", _attr_tensor.nearest_neighbor_index());
     visitor.visitString("algorithm", to_string(_algorithm));
-    if (_algorithm == Algorithm::INDEX_TOP_K || _algorithm == Algorithm::INDEX_TOP_K_WITH_FILTER) {
+    if (_algorithm == Algorithm::INDEX_TOP_K || _algorithm == Algorithm::INDEX_TOP_K_WITH_FILTER ||
+        _algorithm == Algorithm::EXACT_FALLBACK_TOP_K)
+    {
         visitor.visitInt("top_k_hits", _found_hits.size());
+        visitor.visitInt("visited_nodes", _search_stats.visited_nodes);
+        visitor.visitInt("distance_computations", _search_stats.distance_computations);
+        visitor.visitInt("visited_bytes", _search_stats.visited_bytes);
     }
 
     visitor.openStruct("global_filter", "GlobalFilter");
@@ -10,9 +10,12 @@
 
 namespace search::tensor { class ITensorAttribute; }
 namespace vespalib::eval { struct Value; }
+namespace vespalib { struct ThreadBundle; }
 
 namespace search::queryeval {
 
+class RankScoreThreshold;
+
 /**
  * Blueprint for nearest neighbor search iterator.
  *
@@ -24,6 +27,7 @@ public:
     enum class Algorithm {
         EXACT,
         EXACT_FALLBACK,
+        EXACT_FALLBACK_TOP_K,
         INDEX_TOP_K,
         INDEX_TOP_K_WITH_FILTER
     };
@@ -44,6 +48,7 @@ private:
     double _target_hits_max_adjustment_factor;
     mutable NearestNeighborDistanceHeap _distance_heap;
     std::vector<search::tensor::NearestNeighborIndex::Neighbor> _found_hits;
+    search::tensor::NearestNeighborIndex::SearchStats _search_stats;
     Algorithm _algorithm;
     std::shared_ptr<const GlobalFilter> _global_filter;
     bool _global_filter_set;
@@ -51,8 +56,11 @@ private:
     std::optional<double> _global_filter_hit_ratio;
     const vespalib::Doom& _doom;
     MatchingPhase _matching_phase;
+    const RankScoreThreshold* _rank_score_threshold;
+    vespalib::ThreadBundle* _thread_bundle;
 
     void perform_top_k(const search::tensor::NearestNeighborIndex* nns_index);
+    void perform_exact_top_k();
 public:
     NearestNeighborBlueprint(const queryeval::FieldSpec& field,
                              std::unique_ptr<search::tensor::DistanceCalculator> distance_calc,
@@ -75,6 +83,10 @@ public:
     void set_global_filter(const GlobalFilter &global_filter, double estimated_hit_ratio) override;
     Algorithm get_algorithm() const { return _algorithm; }
     double get_distance_threshold() const { return _distance_threshold; }
+    // only used by exact (brute force) search
+    void set_rank_score_threshold(const RankScoreThreshold* threshold) noexcept { _rank_score_threshold = threshold; }
+    // used to calculate the exact top k in parallel when falling back to brute force due to a strong filter
+    void set_thread_bundle(vespalib::ThreadBundle* thread_bundle) noexcept { _thread_bundle = thread_bundle; }
 
     void sort(InFlow in_flow) override;
     FlowStats calculate_flow_stats(uint32_t docid_limit) const override {
@@ -0,0 +1,80 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "parallel_fetch_postings.h"
+#include "blueprint.h"
+#include "executeinfo.h"
+#include <vespa/vespalib/util/runnable.h>
+#include <vespa/vespalib/util/thread_bundle.h>
+#include <algorithm>
+#include <atomic>
+
+using vespalib::Runnable;
+using vespalib::ThreadBundle;
+
+namespace search::queryeval {
+
+namespace {
+
+// leafs are handed out one at a time since their cost vary a lot
+struct FetchPart : Runnable {
+    using Entry = ParallelFetchPostings::Entry;
+    const std::vector<Entry> &leafs;
+    std::atomic<size_t> &next;
+    const vespalib::Doom &doom;
+    FetchPart(const std::vector<Entry> &leafs_in, std::atomic<size_t> &next_in, const vespalib::Doom &doom_in) noexcept
+        : leafs(leafs_in), next(next_in), doom(doom_in) {}
+    void run() override {
+        for (size_t i = next++; i < leafs.size(); i = next++) {
+            // nested use of the thread bundle is not allowed
+            leafs[i].blueprint->fetchPostings(ExecuteInfo::create(leafs[i].hit_rate, doom, ThreadBundle::trivial()));
+        }
+    }
+};
+
+}
+
+ParallelFetchPostings::ParallelFetchPostings() = default;
+ParallelFetchPostings::~ParallelFetchPostings() = default;
+
+ParallelFetchPostings::Stats
+ParallelFetchPostings::run(const vespalib::Doom &doom, ThreadBundle &thread_bundle)
+{
+    Stats stats;
+    stats.leafs = _entries.size();
+    stats.threads = std::min(thread_bundle.size(), _entries.size());
+    if (stats.threads <= 1) {
+        for (const Entry &entry: _entries) {
+            entry.blueprint->fetchPostings(ExecuteInfo::create(entry.hit_rate, doom, thread_bundle));
+        }
+        return stats;
+    }
+    std::atomic<size_t> next(0);
+    std::vector<FetchPart> parts;
+    parts.reserve(stats.threads);
+    for (size_t i = 0; i < stats.threads; ++i) {
+        parts.emplace_back(_entries, next, doom);
+    }
+    thread_bundle.run(parts);
+    return stats;
+}
+
+void
+ParallelFetchPostings::fetch(Blueprint &blueprint, const ExecuteInfo &execInfo)
+{
+    ParallelFetchPostings *deferred = execInfo.deferred();
+    if ((deferred != nullptr) && (blueprint.asSimpleLeaf() != nullptr)) {
+        deferred->add(blueprint, execInfo.hit_rate());
+    } else {
+        blueprint.fetchPostings(execInfo);
+    }
+}
+
+ParallelFetchPostings::Stats
+ParallelFetchPostings::fetch_all(Blueprint &root, const ExecuteInfo &execInfo)
+{
+    ParallelFetchPostings deferred;
+    fetch(root, ExecuteInfo::create_deferred(execInfo, deferred));
+    return deferred.run(execInfo.doom(), execInfo.thread_bundle());
+}
+
+}
@@ -0,0 +1,67 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace vespalib {
+    class Doom;
+    struct ThreadBundle;
+}
+
+namespace search::queryeval {
+
+class Blueprint;
+class ExecuteInfo;
+
+/**
+ * Collects fetchPostings calls for simple leaf blueprints during a
+ * walk of the blueprint tree and performs them afterwards, spread
+ * across the threads of a thread bundle. Simple leafs (single terms)
+ * do not depend on each other when fetching postings, so this only
+ * changes when and where each leaf does its dictionary lookups and
+ * posting list reads. Intermediate and complex leaf blueprints are
+ * still visited by the calling thread to calculate the hit rate of
+ * each leaf.
+ **/
+class ParallelFetchPostings
+{
+public:
+    struct Stats {
+        size_t leafs;
+        size_t threads;
+        Stats() noexcept : leafs(0), threads(0) {}
+    };
+    struct Entry {
+        Blueprint *blueprint;
+        double     hit_rate;
+    };
+private:
+    std::vector<Entry> _entries;
+
+    Stats run(const vespalib::Doom &doom, vespalib::ThreadBundle &thread_bundle);
+public:
+    ParallelFetchPostings();
+    ParallelFetchPostings(const ParallelFetchPostings &) = delete;
+    ParallelFetchPostings &operator=(const ParallelFetchPostings &) = delete;
+    ~ParallelFetchPostings();
+
+    void add(Blueprint &leaf, double hit_rate) { _entries.push_back({&leaf, hit_rate}); }
+    size_t size() const noexcept { return _entries.size(); }
+
+    /**
+     * Fetch postings for a child blueprint. Simple leafs are deferred
+     * if the execute info allows it.
+     **/
+    static void fetch(Blueprint &blueprint, const ExecuteInfo &execInfo);
+
+    /**
+     * Fetch postings for the blueprint tree below root, performing
+     * the simple leaf calls in parallel using the thread bundle of
+     * the execute info.
+     **/
+    static Stats fetch_all(Blueprint &root, const ExecuteInfo &execInfo);
+};
+
+}
@@ -301,7 +301,7 @@ PredicateBlueprint::createLeafSearch(const fef::TermFieldMatchDataArray &tfmda)
     auto interval_range_vector = attribute.getIntervalRangeVector();
     auto max_interval_range = attribute.getMaxIntervalRange();
     return std::make_unique<PredicateSearch>(mfh.first, interval_range_vector, max_interval_range, _kV,
-                                             createPostingLists(), tfmda);
+                                             createPostingLists(), tfmda, createZeroConstraintPostingList());
 }
 
 namespace {
@@ -326,7 +326,7 @@ createPredicatePostingLists(const std::vector<IteratorEntry> &iterator_entries,
 std::vector<PredicatePostingList::UP>
 PredicateBlueprint::createPostingLists() const {
     size_t total_size = _interval_btree_iterators.size() + _interval_vector_iterators.size() +
-                        _bounds_btree_iterators.size() + _bounds_vector_iterators.size() + 2;
+                        _bounds_btree_iterators.size() + _bounds_vector_iterators.size() + 1;
     std::vector<PredicatePostingList::UP> posting_lists;
     posting_lists.reserve(total_size);
     const auto &interval_store = _index.getIntervalStore();
@@ -364,12 +364,16 @@ PredicateBlueprint::createPostingLists() const {
         auto posting_list = std::make_unique<PredicateZstarCompressedPostingList<BTreeIterator>>(interval_store, *_zstar_btree_iterator);
         posting_lists.emplace_back(std::move(posting_list));
     }
+    return posting_lists;
+}
+
+PredicatePostingList::UP
+PredicateBlueprint::createZeroConstraintPostingList() const {
     auto iterator = _index.getZeroConstraintDocs().begin();
     if (iterator.valid()) {
-        auto posting_list = std::make_unique<PredicateZeroConstraintPostingList>(iterator);
-        posting_lists.emplace_back(std::move(posting_list));
+        return std::make_unique<PredicateZeroConstraintPostingList>(iterator);
     }
-    return posting_lists;
+    return {};
 }
 
 }
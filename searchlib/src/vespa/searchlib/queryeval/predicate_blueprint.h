@@ -81,6 +81,7 @@ private:
     void addPostingToK(uint64_t feature);
     void addZeroConstraintToK();
     std::vector<predicate::PredicatePostingList::UP> createPostingLists() const;
+    predicate::PredicatePostingList::UP createZeroConstraintPostingList() const;
 
     const PredicateAttribute        & _attribute;
     const predicate::PredicateIndex &_index;
@@ -134,7 +134,8 @@ PredicateSearch::PredicateSearch(const uint8_t * minFeatureVector,
                                  IntervalRange max_interval_range,
                                  std::span<uint8_t> kV,
                                  vector<PredicatePostingList::UP> posting_lists,
-                                 const fef::TermFieldMatchDataArray &tfmda)
+                                 const fef::TermFieldMatchDataArray &tfmda,
+                                 PredicatePostingList::UP zero_constraint_posting_list)
     : _skip(SkipMinFeature::create(minFeatureVector, kV.data(), kV.size())),
       _posting_lists(std::move(posting_lists)),
       _sorted_indexes(_posting_lists.size()),
@@ -142,6 +143,8 @@ PredicateSearch::PredicateSearch(const uint8_t * minFeatureVector,
       _doc_ids(_posting_lists.size()),
       _intervals(_posting_lists.size()),
       _subqueries(_posting_lists.size()),
+      _zero_constraint_posting_list(std::move(zero_constraint_posting_list)),
+      _zero_constraint_doc_id(UINT32_MAX),
       _subquery_markers(new uint64_t[max_interval_range+1]),
       _visited(new bool[max_interval_range+1]),
       _termFieldMatchData(tfmda.valid()? tfmda[0] : nullptr),
@@ -154,6 +157,9 @@ PredicateSearch::PredicateSearch(const uint8_t * minFeatureVector,
         _doc_ids[i] = _posting_lists[i]->getDocId();
         _subqueries[i] = _posting_lists[i]->getSubquery();
     }
+    if (_zero_constraint_posting_list && _zero_constraint_posting_list->next(0)) {
+        _zero_constraint_doc_id = _zero_constraint_posting_list->getDocId();
+    }
 }
 
 PredicateSearch::~PredicateSearch()
@@ -204,6 +210,14 @@ PredicateSearch::advanceAllTo(uint32_t doc_id) {
     }
 }
 
+void
+PredicateSearch::advanceZeroConstraintTo(uint32_t doc_id) {
+    if (_zero_constraint_doc_id < doc_id) {
+        _zero_constraint_doc_id = _zero_constraint_posting_list->next(doc_id - 1)
+                                  ? _zero_constraint_posting_list->getDocId()
+                                  : UINT32_MAX;
+    }
+}
 
 namespace {
 bool
@@ -306,6 +320,7 @@ PredicateSearch::skipMinFeature(uint32_t doc_id_in)
 
     if (__builtin_expect( ! isAtEnd(doc_id), true)) {
         advanceAllTo(doc_id);
+        advanceZeroConstraintTo(doc_id);
     } else {
         setAtEnd();
     }
@@ -314,8 +329,17 @@ PredicateSearch::skipMinFeature(uint32_t doc_id_in)
 void
 PredicateSearch::doSeek(uint32_t doc_id) {
     skipMinFeature(doc_id);
-    while (!_sorted_indexes.empty() && ! isAtEnd()) {
-        uint32_t doc_id_0 = _doc_ids[_sorted_indexes[0]];
+    while (! isAtEnd()) {
+        uint32_t doc_id_0 = _sorted_indexes.empty() ? UINT32_MAX : _doc_ids[_sorted_indexes[0]];
+        if (_zero_constraint_doc_id <= doc_id_0) {
+            if (_zero_constraint_doc_id == UINT32_MAX) {
+                break;
+            }
+            // Always a hit, covering the whole interval range with all subqueries
+            _subquery_markers[_interval_range_vector[_zero_constraint_doc_id]] = _zero_constraint_posting_list->getSubquery();
+            setDocId(_zero_constraint_doc_id);
+            return;
+        }
         uint8_t min_feature = _min_feature_vector[doc_id_0];
         uint8_t k = static_cast<uint8_t>(min_feature == 0 ? 0 : min_feature - 1);
         if (k < _sorted_indexes.size()) {
@@ -27,6 +27,11 @@ public:
 /**
  * Search iterator implementing the interval algorithm for boolean
  * search. It operates on PredicatePostingLists, as defined above.
+ *
+ * Zero constraint documents (predicate 'true') match any query and are
+ * never present in any other posting list. If their posting list is
+ * given separately, these documents are returned directly instead of
+ * being merged with the other posting lists and evaluated.
  */
 using IntervalRange = uint16_t;
 
@@ -38,6 +43,8 @@ class PredicateSearch : public SearchIterator {
     std::vector<uint32_t> _doc_ids;
     std::vector<uint32_t> _intervals;
     std::vector<uint64_t> _subqueries;
+    predicate::PredicatePostingList::UP _zero_constraint_posting_list;
+    uint32_t _zero_constraint_doc_id;
     uint64_t *_subquery_markers;
     bool * _visited;
     fef::TermFieldMatchData *_termFieldMatchData;
@@ -46,6 +53,7 @@ class PredicateSearch : public SearchIterator {
 
     VESPA_DLL_LOCAL bool advanceOneTo(uint32_t doc_id, size_t index);
     VESPA_DLL_LOCAL void advanceAllTo(uint32_t doc_id);
+    VESPA_DLL_LOCAL void advanceZeroConstraintTo(uint32_t doc_id);
     VESPA_DLL_LOCAL bool evaluateHit(uint32_t doc_id, uint32_t k);
     VESPA_DLL_LOCAL size_t sortIntervals(uint32_t doc_id, uint32_t k);
     VESPA_DLL_LOCAL void skipMinFeature(uint32_t doc_id) __attribute__((noinline));
@@ -56,7 +64,8 @@ public:
                     IntervalRange max_interval_range,
                     std::span<uint8_t> kV,
                     std::vector<predicate::PredicatePostingList::UP> posting_lists,
-                    const fef::TermFieldMatchDataArray &tfmda);
+                    const fef::TermFieldMatchDataArray &tfmda,
+                    predicate::PredicatePostingList::UP zero_constraint_posting_list = {});
     ~PredicateSearch() override;
 
     void doSeek(uint32_t doc_id) override;
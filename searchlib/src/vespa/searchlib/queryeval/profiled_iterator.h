@@ -60,6 +60,7 @@ public:
     Trinary is_strict() const override { return _search->is_strict(); }
     Trinary matches_any() const override { return _search->matches_any(); }
     const PostingInfo *getPostingInfo() const override { return _search->getPostingInfo(); }
+    BlockMaxMeta get_block_max() const noexcept override { return _search->get_block_max(); }
     static std::unique_ptr<SearchIterator> profile(Profiler &profiler, std::unique_ptr<SearchIterator> node);
 };
 
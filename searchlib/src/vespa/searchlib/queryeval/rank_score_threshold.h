@@ -0,0 +1,35 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <atomic>
+#include <limits>
+
+namespace search::queryeval {
+
+/**
+ * The lowest first-phase rank score a hit must beat to enter the
+ * global top-k, shared between all match threads of a query. The
+ * match threads raise it as their hit heaps fill up; search iterators
+ * that know an upper bound of their own contribution to the rank
+ * score may use it to skip documents that can never become hits.
+ *
+ * The threshold starts at -inf and never decreases.
+ **/
+class RankScoreThreshold {
+private:
+    std::atomic<double> _value;
+public:
+    RankScoreThreshold() noexcept : _value(-std::numeric_limits<double>::infinity()) {}
+    double get() const noexcept { return _value.load(std::memory_order_relaxed); }
+    void raise(double value) noexcept {
+        double old_value = _value.load(std::memory_order_relaxed);
+        while ((value > old_value) &&
+               !_value.compare_exchange_weak(old_value, value, std::memory_order_relaxed))
+        {
+            // old_value is refreshed by failed exchange
+        }
+    }
+};
+
+}
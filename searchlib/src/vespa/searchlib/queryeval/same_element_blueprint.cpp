@@ -3,6 +3,7 @@
 #include "same_element_blueprint.h"
 #include "same_element_search.h"
 #include "field_spec.hpp"
+#include "parallel_fetch_postings.h"
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchlib/attribute/searchcontextelementiterator.h>
 #include <vespa/vespalib/objects/visit.hpp>
@@ -82,11 +83,11 @@ void
 SameElementBlueprint::fetchPostings(const ExecuteInfo &execInfo)
 {
     if (_terms.empty()) return;
-    _terms[0]->fetchPostings(execInfo);
+    ParallelFetchPostings::fetch(*_terms[0], execInfo);
     double hit_rate = execInfo.hit_rate() * _terms[0]->estimate();
     for (size_t i = 1; i < _terms.size(); ++i) {
         Blueprint & term = *_terms[i];
-        term.fetchPostings(ExecuteInfo::create(hit_rate, execInfo));
+        ParallelFetchPostings::fetch(term, ExecuteInfo::create(hit_rate, execInfo));
         hit_rate = hit_rate * _terms[i]->estimate();
     }
 }
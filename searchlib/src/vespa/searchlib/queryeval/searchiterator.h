@@ -295,6 +295,35 @@ public:
      **/
     virtual const PostingInfo *getPostingInfo() const { return nullptr; }
 
+    /**
+     * Upper bound for the weight (as reported by the match data after
+     * unpack) of documents in the posting list block containing the
+     * current docid, together with the last docid covered by that
+     * block. Used by block-max wand to skip blocks that cannot
+     * produce hits above the current threshold.
+     **/
+    class BlockMaxMeta {
+    public:
+        BlockMaxMeta() noexcept : BlockMaxMeta(0, 0) {}
+        BlockMaxMeta(uint32_t last_docid_in, int32_t max_weight_in) noexcept
+            : _last_docid(last_docid_in), _max_weight(max_weight_in)
+        {}
+        uint32_t last_docid() const noexcept { return _last_docid; }
+        int32_t max_weight() const noexcept { return _max_weight; }
+        bool valid() const noexcept { return _last_docid != 0; }
+    private:
+        uint32_t _last_docid;
+        int32_t  _max_weight;
+    };
+
+    /**
+     * Return block max information for the current position of this
+     * iterator.
+     *
+     * @return block max info, not valid if no info is available.
+     **/
+    virtual BlockMaxMeta get_block_max() const noexcept { return {}; }
+
     /**
      * Create a human-readable representation of this object. This
      * method will use object visitation internally to capture the
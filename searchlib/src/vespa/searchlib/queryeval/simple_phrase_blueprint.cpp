@@ -3,6 +3,7 @@
 #include "simple_phrase_blueprint.h"
 #include "simple_phrase_search.h"
 #include "field_spec.hpp"
+#include "parallel_fetch_postings.h"
 #include <vespa/vespalib/objects/visit.hpp>
 #include <map>
 
@@ -105,7 +106,7 @@ void
 SimplePhraseBlueprint::fetchPostings(const ExecuteInfo &execInfo)
 {
     for (auto & term : _terms) {
-        term->fetchPostings(execInfo);
+        ParallelFetchPostings::fetch(*term, execInfo);
     }
 }
 
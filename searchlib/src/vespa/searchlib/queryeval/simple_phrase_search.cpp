@@ -3,6 +3,7 @@
 #include "simple_phrase_search.h"
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/vespalib/objects/visit.h>
+#include <algorithm>
 #include <functional>
 #include <cassert>
 
@@ -19,6 +20,7 @@ class PhraseMatcher {
     const fef::TermFieldMatchDataArray &_tmds;
     const vector<uint32_t> &_eval_order;
     vector<TermFieldMatchData::PositionsIterator> &_iterators;
+    uint32_t _num_terms;
     uint32_t _element_id;
     uint32_t _position;
 
@@ -38,11 +40,14 @@ class PhraseMatcher {
         return iterator(word_index)->getPosition();
     }
 
-    void iterateToElement(uint32_t word_index) {
-        while (iterator(word_index) != end(word_index) &&
-               elementId(word_index) < _element_id) {
-            ++iterator(word_index);
-        }
+    /*
+     * Skip positions before the wanted position. Positions are sorted on
+     * (element id, position), and the wanted positions are increasing,
+     * thus the skipped positions will never be needed again.
+     */
+    void seekPosition(uint32_t word_index, uint32_t wanted_position) {
+        fef::TermFieldMatchDataPositionKey key(_element_id, wanted_position);
+        iterator(word_index) = std::lower_bound(iterator(word_index), end(word_index), key);
     }
 
     template <typename FwdIt>
@@ -52,15 +57,11 @@ class PhraseMatcher {
         }
         uint32_t word_index = *first;
 
-        iterateToElement(word_index);
-        while (iterator(word_index) != end(word_index) &&
-               elementId(word_index) == _element_id) {
-            if (position(word_index) == _position + word_index) {
-                return match(++first, last);
-            } else if (position(word_index) > _position + word_index) {
-                return false;
-            }
-            ++iterator(word_index);
+        seekPosition(word_index, _position + word_index);
+        if (iterator(word_index) != end(word_index) &&
+            elementId(word_index) == _element_id &&
+            position(word_index) == _position + word_index) {
+            return match(++first, last);
         }
         return false;
     }
@@ -72,26 +73,39 @@ class PhraseMatcher {
             return false;
         }
         _position = position(_eval_order[0]) - _eval_order[0];
-        return match(++_eval_order.begin(), _eval_order.end());
+        return match(_eval_order.begin() + 1, _eval_order.begin() + _num_terms);
     }
 
 public:
+    /*
+     * Only the first num_terms terms in eval order are matched, allowing
+     * a partial phrase to be checked before the remaining terms are unpacked.
+     */
     PhraseMatcher(const fef::TermFieldMatchDataArray &tmds,
                   const vector<uint32_t> &eval_order,
-                  vector<TermFieldMatchData::PositionsIterator> &iterators)
+                  vector<TermFieldMatchData::PositionsIterator> &iterators,
+                  uint32_t num_terms)
         : _tmds(tmds),
           _eval_order(eval_order),
           _iterators(iterators),
+          _num_terms(num_terms),
           _element_id(0),
           _position(0)
     {
-        for (size_t i = 0; i < _tmds.size(); ++i) {
-            _iterators[i] = _tmds[i]->begin();
+        for (uint32_t i = 0; i < _num_terms; ++i) {
+            _iterators[_eval_order[i]] = _tmds[_eval_order[i]]->begin();
         }
     }
 
+    PhraseMatcher(const fef::TermFieldMatchDataArray &tmds,
+                  const vector<uint32_t> &eval_order,
+                  vector<TermFieldMatchData::PositionsIterator> &iterators)
+        : PhraseMatcher(tmds, eval_order, iterators, tmds.size())
+    {
+    }
+
     bool hasMatch() {
-        if (_tmds.size() == 1) {
+        if (_num_terms == 1) {
             return true;
         }
 
@@ -155,7 +169,17 @@ SimplePhraseSearch::phraseSeek(uint32_t doc_id) {
 
 void
 SimplePhraseSearch::matchPhrase(uint32_t doc_id) {
-    AndSearch::doUnpack(doc_id);
+    // Unpack terms in eval order, giving up as soon as the terms unpacked so far
+    // cannot form a phrase. This avoids decoding positions for the remaining terms.
+    const Children & children = getChildren();
+    uint32_t num_terms = _eval_order.size();
+    children[_eval_order[0]]->doUnpack(doc_id);
+    for (uint32_t i = 1; i < num_terms; ++i) {
+        children[_eval_order[i]]->doUnpack(doc_id);
+        if (i + 1 < num_terms && !PhraseMatcher(_childMatch, _eval_order, _iterators, i + 1).hasMatch()) {
+            return;
+        }
+    }
     if (PhraseMatcher(_childMatch, _eval_order, _iterators).hasMatch()) {
         setDocId(doc_id);
     }
@@ -3,23 +3,26 @@
 #include "termwise_search.h"
 #include <vespa/vespalib/objects/visit.h>
 #include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
 
 namespace search::queryeval {
 
 template <bool IS_STRICT>
 struct TermwiseSearch : public SearchIterator {
 
-    SearchIterator::UP search;
-    BitVector::UP      result;
-    uint32_t           my_beginid;
-    uint32_t           my_first_hit;
+    SearchIterator::UP        search;
+    BitVector::UP             result;
+    uint32_t                  my_beginid;
+    uint32_t                  my_first_hit;
+    fef::TermFieldMatchData  *tfmd;
 
     bool same_range(uint32_t beginid, uint32_t endid) const {
         return ((beginid == my_beginid) && endid == getEndId());
     }
 
-    TermwiseSearch(SearchIterator::UP search_in)
-        : search(std::move(search_in)), result(), my_beginid(0), my_first_hit(0) {}
+    TermwiseSearch(SearchIterator::UP search_in, fef::TermFieldMatchData *tfmd_in)
+        : search(std::move(search_in)), result(), my_beginid(0), my_first_hit(0),
+          tfmd((tfmd_in != nullptr && !tfmd_in->isNotNeeded()) ? tfmd_in : nullptr) {}
 
     Trinary is_strict() const override { return IS_STRICT ? Trinary::True : Trinary::False; }
     void initRange(uint32_t beginid, uint32_t endid) override {
@@ -46,21 +49,41 @@ struct TermwiseSearch : public SearchIterator {
             setDocId(docid);
         }
     }
-    void doUnpack(uint32_t) override {}
+    void doUnpack(uint32_t docid) override {
+        if (tfmd != nullptr) {
+            tfmd->resetOnlyDocId(docid);
+        }
+    }
     void visitMembers(vespalib::ObjectVisitor &visitor) const override {
         visit(visitor, "search", *search);
         visit(visitor, "strict", IS_STRICT);
     }
 };
 
+namespace {
+
 SearchIterator::UP
-make_termwise(SearchIterator::UP search, bool strict)
+make_termwise_helper(SearchIterator::UP search, bool strict, fef::TermFieldMatchData *tfmd)
 {
     if (strict) {
-        return std::make_unique<TermwiseSearch<true>>(std::move(search));
+        return std::make_unique<TermwiseSearch<true>>(std::move(search), tfmd);
     } else {
-        return std::make_unique<TermwiseSearch<false>>(std::move(search));
+        return std::make_unique<TermwiseSearch<false>>(std::move(search), tfmd);
     }
 }
 
 }
+
+SearchIterator::UP
+make_termwise(SearchIterator::UP search, bool strict)
+{
+    return make_termwise_helper(std::move(search), strict, nullptr);
+}
+
+SearchIterator::UP
+make_termwise(SearchIterator::UP search, bool strict, fef::TermFieldMatchData &tfmd)
+{
+    return make_termwise_helper(std::move(search), strict, &tfmd);
+}
+
+}
@@ -4,6 +4,8 @@
 
 #include "searchiterator.h"
 
+namespace search::fef { class TermFieldMatchData; }
+
 namespace search::queryeval {
 
 /**
@@ -22,4 +24,11 @@ namespace search::queryeval {
  **/
 SearchIterator::UP make_termwise(SearchIterator::UP search, bool strict);
 
+/**
+ * Same as above, but the docid of each unpacked hit is stored in the
+ * given term field match data (unless it is not needed), making the
+ * wrapper usable as a leaf for a filter field.
+ **/
+SearchIterator::UP make_termwise(SearchIterator::UP search, bool strict, fef::TermFieldMatchData &tfmd);
+
 }
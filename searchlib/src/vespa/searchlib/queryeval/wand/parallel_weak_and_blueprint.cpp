@@ -3,6 +3,7 @@
 #include "parallel_weak_and_blueprint.h"
 #include "parallel_weak_and_search.h"
 #include <vespa/searchlib/queryeval/field_spec.hpp>
+#include <vespa/searchlib/queryeval/parallel_fetch_postings.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
 #include <vespa/searchlib/queryeval/flow_tuning.h>
 #include <vespa/vespalib/objects/visit.hpp>
@@ -21,7 +22,8 @@ ParallelWeakAndBlueprint::ParallelWeakAndBlueprint(FieldSpecBase field, uint32_t
       _layout(),
       _weights(),
       _terms(),
-      _matching_phase(MatchingPhase::FIRST_PHASE)
+      _matching_phase(MatchingPhase::FIRST_PHASE),
+      _rank_score_threshold(nullptr)
 {
 }
 
@@ -89,9 +91,11 @@ ParallelWeakAndBlueprint::createLeafSearch(const search::fef::TermFieldMatchData
                            childState.field(0).resolve(*childrenMatchData));
     }
     bool readonly_scores_heap = (_matching_phase != MatchingPhase::FIRST_PHASE);
+    const RankScoreThreshold *rank_score_threshold = readonly_scores_heap ? nullptr : _rank_score_threshold;
     return ParallelWeakAndSearch::create(terms,
                                          ParallelWeakAndSearch::MatchParams(*_scores, _scoreThreshold, _thresholdBoostFactor,
-                                                                            _scoresAdjustFrequency, get_docid_limit()),
+                                                                            _scoresAdjustFrequency, get_docid_limit(),
+                                                                            rank_score_threshold),
                                          ParallelWeakAndSearch::RankParams(*tfmda[0],std::move(childrenMatchData)),
                                          strict(), readonly_scores_heap);
 }
@@ -106,7 +110,7 @@ void
 ParallelWeakAndBlueprint::fetchPostings(const ExecuteInfo & execInfo)
 {
     for (const auto & _term : _terms) {
-        _term->fetchPostings(execInfo);
+        ParallelFetchPostings::fetch(*_term, execInfo);
     }
 }
 
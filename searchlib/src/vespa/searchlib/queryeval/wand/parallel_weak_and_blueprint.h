@@ -11,6 +11,8 @@
 
 namespace search::queryeval {
 
+class RankScoreThreshold;
+
 /**
  * Blueprint for the parallel weak and search operator.
  */
@@ -27,6 +29,7 @@ private:
     std::vector<int32_t>                  _weights;
     std::vector<Blueprint::UP>            _terms;
     MatchingPhase                         _matching_phase;
+    const RankScoreThreshold             *_rank_score_threshold;
 
 public:
     ParallelWeakAndBlueprint(const ParallelWeakAndBlueprint &) = delete;
@@ -39,6 +42,7 @@ public:
     const WeakAndHeap &getScores() const { return *_scores; }
     score_t getScoreThreshold() const { return _scoreThreshold; }
     double getThresholdBoostFactor() const { return _thresholdBoostFactor; }
+    void set_rank_score_threshold(const RankScoreThreshold *threshold) noexcept { _rank_score_threshold = threshold; }
 
     // Used by create visitor
     FieldSpecBase getNextChildField(FieldSpecBase parent) {
@@ -3,8 +3,11 @@
 #include "parallel_weak_and_search.h"
 #include <vespa/searchlib/queryeval/docid_with_weight_search_iterator.h>
 #include <vespa/searchlib/queryeval/monitoring_dump_iterator.h>
+#include <vespa/searchlib/queryeval/rank_score_threshold.h>
 #include <vespa/searchlib/fef/matchdatalayout.h>
 #include <vespa/vespalib/objects/visit.h>
+#include <cmath>
+#include <limits>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".queryeval.parallel_weak_and_search");
@@ -17,7 +20,25 @@ using MatchParams = ParallelWeakAndSearch::MatchParams;
 
 namespace wand {
 
-namespace { bool should_monitor_wand() { return LOG_WOULD_LOG(spam); } }
+namespace {
+
+bool should_monitor_wand() { return LOG_WOULD_LOG(spam); }
+
+/**
+ * Documents with a score below the rank score threshold cannot become
+ * hits. Since wand scores are integers and wand keeps documents with
+ * a score above its threshold, ceil(threshold) - 1 keeps all documents
+ * that may tie with the threshold.
+ **/
+score_t to_wand_threshold(double threshold) {
+    constexpr double max_threshold = double(std::numeric_limits<score_t>::max() / 2);
+    if (!(threshold > double(std::numeric_limits<score_t>::min() / 2))) {
+        return std::numeric_limits<score_t>::min(); // also covers NaN
+    }
+    return score_t(std::ceil(std::min(threshold, max_threshold))) - 1;
+}
+
+}
 
 
 template <typename VectorizedTerms, typename FutureHeap, typename PastHeap, bool IS_STRICT>
@@ -44,6 +65,14 @@ private:
     void seek_strict(uint32_t docid) {
         _algo.set_candidate(_terms, _heaps, docid);
         while (_algo.solve_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
+            if constexpr (VectorizedTerms::has_block_max) {
+                docid_t next = _algo.check_block_max(_terms, _heaps, GreaterThan(_boostedThreshold));
+                if (next > _algo.get_candidate()) {
+                    // no document in the current posting blocks can beat the threshold
+                    _algo.set_candidate(_terms, _heaps, next);
+                    continue;
+                }
+            }
             if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
                 setDocId(_algo.get_candidate());
                 return;
@@ -89,6 +118,9 @@ public:
 
     void doSeek(uint32_t docid) override {
         updateThreshold(_matchParams.scores.getMinScore());
+        if (_matchParams.rankScoreThreshold != nullptr) {
+            updateThreshold(to_wand_threshold(_matchParams.rankScoreThreshold->get()));
+        }
         if (IS_STRICT) {
             seek_strict(docid);
         } else {
@@ -9,6 +9,8 @@
 
 namespace search::queryeval {
 
+class RankScoreThreshold;
+
 /**
  * WAND search iterator that uses a shared heap between match threads.
  */
@@ -27,16 +29,20 @@ struct ParallelWeakAndSearch : public SearchIterator
         const uint32_t scoresAdjustFrequency;
         const double   thresholdBoostFactor;
         const docid_t  docIdLimit;
+        // optional first-phase rank score shared by all match threads; documents scoring below it are skipped
+        const RankScoreThreshold *rankScoreThreshold;
         MatchParams(WeakAndHeap &scores_in,
                     score_t scoreThreshold_in,
                     double thresholdBoostFactor_in,
                     uint32_t scoresAdjustFrequency_in,
-                    uint32_t docIdLimit_in) noexcept
+                    uint32_t docIdLimit_in,
+                    const RankScoreThreshold *rankScoreThreshold_in = nullptr) noexcept
             : scores(scores_in),
               scoreThreshold(scoreThreshold_in),
               scoresAdjustFrequency(scoresAdjustFrequency_in),
               thresholdBoostFactor(thresholdBoostFactor_in),
-              docIdLimit(docIdLimit_in)
+              docIdLimit(docIdLimit_in),
+              rankScoreThreshold(rankScoreThreshold_in)
         {}
     };
 
@@ -228,6 +228,7 @@ public:
 
     size_t size() const { return _docId.size(); }
     IteratorPack &iteratorPack() { return _iteratorPack; }
+    const IteratorPack &iteratorPack() const { return _iteratorPack; }
 
     uint32_t seek(uint16_t ref, uint32_t docid) { return _iteratorPack.seek(ref, docid); }
     int32_t get_weight(uint16_t ref, uint32_t docid) { return _iteratorPack.get_weight(ref, docid); }
@@ -298,6 +299,20 @@ public:
     VectorizedIteratorTerms & operator=(VectorizedIteratorTerms &&) noexcept;
 
     ~VectorizedIteratorTerms();
+    static constexpr bool has_block_max = true;
+    /**
+     * Upper bound for the score of the given term for documents from
+     * its current docid up to and including block_end.
+     **/
+    score_t block_max_score(ref_t ref, docid_t &block_end) const {
+        auto block_max = iteratorPack().get_block_max(ref);
+        if (block_max.valid() && weight(ref) > 0) {
+            block_end = block_max.last_docid();
+            return std::min(maxScore(ref), weight(ref) * (score_t)block_max.max_weight());
+        }
+        block_end = search::endDocId;
+        return maxScore(ref);
+    }
     void unpack(uint16_t ref, uint32_t docid) { iteratorPack().unpack(ref, docid); }
     void visit_members(vespalib::ObjectVisitor &visitor) const;
     const Terms &input_terms() const { return _terms; }
@@ -325,6 +340,7 @@ VectorizedIteratorTerms::VectorizedIteratorTerms(const Terms &t, const Scorer &
 //-----------------------------------------------------------------------------
 
 struct VectorizedAttributeTerms : VectorizedState<DocidWithWeightIteratorPack> {
+    static constexpr bool has_block_max = false;
     template <typename Scorer>
     VectorizedAttributeTerms(const std::vector<int32_t> &weights,
                              const std::vector<IDirectPostingStore::LookupResult> &dict_entries,
@@ -682,6 +698,46 @@ public:
         return true;
     }
 
+    /**
+     * Use block max scores to check if the candidate might be above
+     * the threshold. Returns the candidate if it might, otherwise the
+     * lowest docid that might be above the threshold. Terms behind
+     * the candidate are stepped to the candidate when any of the
+     * terms matching it has block max information, since the bound
+     * is only tight when all terms are positioned.
+     **/
+    template <typename VectorizedTerms, typename Heaps, typename AboveThreshold>
+    docid_t check_block_max(VectorizedTerms &terms, Heaps &heaps, AboveThreshold &&aboveThreshold) {
+        docid_t block_end;
+        bool has_block_max = false;
+        for (ref_t *ref = heaps.present_begin(); ref != heaps.present_end() && !has_block_max; ++ref) {
+            terms.block_max_score(*ref, block_end);
+            has_block_max = (block_end != search::endDocId);
+        }
+        if (!has_block_max) {
+            return _candidate;
+        }
+        while (heaps.has_past()) {
+            step_optimal_term(terms, heaps);
+        }
+        score_t max_score = 0;
+        docid_t next = search::endDocId;
+        ref_t *end = heaps.present_end();
+        for (ref_t *ref = heaps.present_begin(); ref != end; ++ref) {
+            max_score += terms.block_max_score(*ref, block_end);
+            if (block_end < next) {
+                next = block_end + 1;
+            }
+        }
+        if (aboveThreshold(max_score)) {
+            return _candidate;
+        }
+        if (heaps.has_future() && terms.docId(heaps.future()) < next) {
+            next = terms.docId(heaps.future());
+        }
+        return next;
+    }
+
     template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
     bool check_score(VectorizedTerms &terms, Heaps &heaps, const Scorer &scorer, AboveThreshold &&aboveThreshold) {
         _partial_score = 0;
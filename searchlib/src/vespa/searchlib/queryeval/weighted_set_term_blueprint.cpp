@@ -5,6 +5,7 @@
 #include "orsearch.h"
 #include "matching_elements_search.h"
 #include "flow_tuning.h"
+#include "parallel_fetch_postings.h"
 #include <vespa/searchlib/common/matching_elements.h>
 #include <vespa/searchlib/common/matching_elements_fields.h>
 #include <vespa/vespalib/objects/visit.hpp>
@@ -155,7 +156,7 @@ void
 WeightedSetTermBlueprint::fetchPostings(const ExecuteInfo &execInfo)
 {
     for (const auto & _term : _terms) {
-        _term->fetchPostings(execInfo);
+        ParallelFetchPostings::fetch(*_term, execInfo);
     }
 }
 
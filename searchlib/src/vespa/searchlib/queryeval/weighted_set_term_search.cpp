@@ -9,6 +9,7 @@
 #include <vespa/searchlib/queryeval/field_spec.hpp>
 #include <vespa/vespalib/objects/visit.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
+#include <span>
 
 #include "iterator_pack.h"
 #include "blueprint.h"
@@ -312,6 +313,7 @@ class StringHashFilterWrapper : public HashFilterWrapper {
 public:
     using TokenT = attribute::IAttributeVector::EnumHandle;
     static constexpr bool unpack_weights = unpack_weights_t;
+    static constexpr bool multi_value = false;
     StringHashFilterWrapper(const attribute::IAttributeVector& attr)
         : HashFilterWrapper(attr)
     {}
@@ -330,6 +332,7 @@ class IntegerHashFilterWrapper : public HashFilterWrapper {
 public:
     using TokenT = attribute::IAttributeVector::largeint_t;
     static constexpr bool unpack_weights = unpack_weights_t;
+    static constexpr bool multi_value = false;
     IntegerHashFilterWrapper(const attribute::IAttributeVector& attr)
         : HashFilterWrapper(attr)
     {}
@@ -345,6 +348,32 @@ public:
     }
 };
 
+/**
+ * Provides all values of a document in a multi-value attribute, using the token
+ * mapping of the single value wrapper.
+ */
+template <typename SingleValueWrapperType>
+class MultiValueHashFilterWrapper : public SingleValueWrapperType {
+public:
+    using TokenT = typename SingleValueWrapperType::TokenT;
+private:
+    std::vector<TokenT> _buffer;
+public:
+    static constexpr bool multi_value = true;
+    MultiValueHashFilterWrapper(const attribute::IAttributeVector& attr)
+        : SingleValueWrapperType(attr),
+          _buffer(std::max(1u, attr.getMaxValueCount()))
+    {}
+    std::span<TokenT> getTokens(uint32_t docid) {
+        uint32_t num_values = this->_attr.get(docid, _buffer.data(), _buffer.size());
+        if (num_values > _buffer.size()) {
+            _buffer.resize(num_values);
+            num_values = this->_attr.get(docid, _buffer.data(), _buffer.size());
+        }
+        return {_buffer.data(), std::min(num_values, uint32_t(_buffer.size()))};
+    }
+};
+
 template <typename WrapperType>
 SearchIterator::UP
 create_hash_filter_helper(fef::TermFieldMatchData& tfmd,
@@ -376,6 +405,22 @@ WeightedSetTermSearch::create_hash_filter(search::fef::TermFieldMatchData& tmd,
                                           const IDirectPostingStore& posting_store,
                                           vespalib::datastore::EntryRef dict_snapshot)
 {
+    if (attr.hasMultiValue()) {
+        if (attr.isStringType()) {
+            if (is_filter_search) {
+                return create_hash_filter_helper<MultiValueHashFilterWrapper<StringHashFilterWrapper<false>>>(tmd, weights, terms, attr, posting_store, dict_snapshot);
+            } else {
+                return create_hash_filter_helper<MultiValueHashFilterWrapper<StringHashFilterWrapper<true>>>(tmd, weights, terms, attr, posting_store, dict_snapshot);
+            }
+        } else {
+            assert(attr.isIntegerType());
+            if (is_filter_search) {
+                return create_hash_filter_helper<MultiValueHashFilterWrapper<IntegerHashFilterWrapper<false>>>(tmd, weights, terms, attr, posting_store, dict_snapshot);
+            } else {
+                return create_hash_filter_helper<MultiValueHashFilterWrapper<IntegerHashFilterWrapper<true>>>(tmd, weights, terms, attr, posting_store, dict_snapshot);
+            }
+        }
+    }
     if (attr.isStringType()) {
         if (is_filter_search) {
             return create_hash_filter_helper<StringHashFilterWrapper<false>>(tmd, weights, terms, attr, posting_store, dict_snapshot);
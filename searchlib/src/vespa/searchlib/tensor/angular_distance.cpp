@@ -21,6 +21,17 @@ private:
     mutable VectorStoreType _tmpSpace;
     const std::span<const FloatType> _lhs;
     double _lhs_norm_sq;
+    double calc_converted(const FloatType* b) const noexcept {
+        size_t sz = _lhs.size();
+        auto a = _lhs.data();
+        double b_norm_sq = _computer.dotProduct(cast(b), cast(b), sz);
+        double squared_norms = _lhs_norm_sq * b_norm_sq;
+        double dot_product = _computer.dotProduct(cast(a), cast(b), sz);
+        double div = (squared_norms > 0) ? sqrt(squared_norms) : 1.0;
+        double cosine_similarity = dot_product / div;
+        double distance = 1.0 - cosine_similarity; // in range [0,2]
+        return distance;
+    }
 public:
     explicit BoundAngularDistance(TypedCells lhs)
         : _computer(vespalib::hwaccelerated::IAccelerated::getAccelerator()),
@@ -31,17 +42,12 @@ public:
         _lhs_norm_sq = _computer.dotProduct(cast(a), cast(a), lhs.size);
     }
     double calc(TypedCells rhs) const noexcept override {
-        size_t sz = _lhs.size();
-        std::span<const FloatType> rhs_vector = _tmpSpace.convertRhs(rhs);
-        auto a = _lhs.data();
-        auto b = rhs_vector.data();
-        double b_norm_sq = _computer.dotProduct(cast(b), cast(b), sz);
-        double squared_norms = _lhs_norm_sq * b_norm_sq;
-        double dot_product = _computer.dotProduct(cast(a), cast(b), sz);
-        double div = (squared_norms > 0) ? sqrt(squared_norms) : 1.0;
-        double cosine_similarity = dot_product / div;
-        double distance = 1.0 - cosine_similarity; // in range [0,2]
-        return distance;
+        return calc_converted(_tmpSpace.convertRhs(rhs).data());
+    }
+    void calc_batch(std::span<const TypedCells> rhs, std::span<double> distances) const noexcept override {
+        for (size_t i = 0; i < rhs.size(); ++i) {
+            distances[i] = calc_converted(_tmpSpace.convertRhs(rhs[i]).data());
+        }
     }
     double convert_threshold(double threshold) const noexcept override {
         if (threshold < 0.0) {
@@ -69,9 +75,11 @@ public:
 
 template class BoundAngularDistance<TemporaryVectorStore<float>>;
 template class BoundAngularDistance<TemporaryVectorStore<double>>;
+template class BoundAngularDistance<TemporaryVectorStore<vespalib::BFloat16>>;
 template class BoundAngularDistance<TemporaryVectorStore<Int8Float>>;
 template class BoundAngularDistance<ReferenceVectorStore<float>>;
 template class BoundAngularDistance<ReferenceVectorStore<double>>;
+template class BoundAngularDistance<ReferenceVectorStore<vespalib::BFloat16>>;
 template class BoundAngularDistance<ReferenceVectorStore<Int8Float>>;
 
 template <typename FloatType>
@@ -95,6 +103,7 @@ AngularDistanceFunctionFactory<FloatType>::for_insertion_vector(TypedCells lhs)
 
 template class AngularDistanceFunctionFactory<float>;
 template class AngularDistanceFunctionFactory<double>;
+template class AngularDistanceFunctionFactory<vespalib::BFloat16>;
 template class AngularDistanceFunctionFactory<Int8Float>;
 
 }
@@ -5,7 +5,8 @@
 namespace search::tensor {
 
 BitVectorVisitedTracker::BitVectorVisitedTracker(uint32_t nodeid_limit, uint32_t)
-    : _visited(nodeid_limit)
+    : _visited(nodeid_limit),
+      _count(0)
 {
 }
 
@@ -13,18 +13,21 @@ namespace search::tensor {
 class BitVectorVisitedTracker
 {
     search::AllocatedBitVector _visited;
+    uint32_t                   _count;
 public:
     BitVectorVisitedTracker(uint32_t nodeid_limit, uint32_t);
     ~BitVectorVisitedTracker();
-    void mark(uint32_t nodeid) { _visited.setBit(nodeid); }
+    void mark(uint32_t nodeid) { (void) try_mark(nodeid); }
     bool try_mark(uint32_t nodeid) {
         if (_visited.testBit(nodeid)) {
             return false;
         } else {
             _visited.setBit(nodeid);
+            ++_count;
             return true;
         }
     }
+    uint32_t count() const noexcept { return _count; }
 };
 
 }
@@ -1,3 +1,15 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "bound_distance_function.h"
+
+namespace search::tensor {
+
+void
+BoundDistanceFunction::calc_batch(std::span<const TypedCells> rhs, std::span<double> distances) const noexcept
+{
+    for (size_t i = 0; i < rhs.size(); ++i) {
+        distances[i] = calc(rhs[i]);
+    }
+}
+
+}
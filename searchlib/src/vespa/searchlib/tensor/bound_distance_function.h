@@ -5,6 +5,7 @@
 #include "distance_function.h"
 #include <vespa/eval/eval/typed_cells.h>
 #include <memory>
+#include <span>
 
 namespace search::tensor {
 
@@ -30,10 +31,16 @@ public:
 
     // calculate internal distance, early return allowed if > limit
     virtual double calc_with_limit(TypedCells rhs, double limit) const noexcept = 0;
+
+    // calculate internal distance (comparable) to each of the rhs vectors,
+    // storing the result in the corresponding slot of distances (at least rhs.size() slots).
+    // The default implementation calls calc() for each vector.
+    virtual void calc_batch(std::span<const TypedCells> rhs, std::span<double> distances) const noexcept;
 protected:
     static const double *cast(const double * p) { return p; }
     static const float *cast(const float * p) { return p; }
     static const int8_t *cast(const Int8Float * p) { return reinterpret_cast<const int8_t *>(p); }
+    static const vespalib::BFloat16 *cast(const vespalib::BFloat16 * p) { return p; }
 };
 
 }
@@ -2,6 +2,7 @@
 
 #include "default_nearest_neighbor_index_factory.h"
 #include "hnsw_index.h"
+#include "ivf_pq_index.h"
 #include "random_level_generator.h"
 #include "inv_log_level_generator.h"
 #include "distance_function_factory.h"
@@ -33,12 +34,21 @@ DefaultNearestNeighborIndexFactory::make(const DocVectorAccess& vectors,
                                          const search::attribute::HnswIndexParams& params) const
 {
     (void) vector_size;
+    if (params.ivf_pq().has_value() && !multi_vector_index && IvfPqIndex::supports(params.distance_metric())) {
+        return std::make_unique<IvfPqIndex>(vectors,
+                                            make_distance_function_factory(params.distance_metric(), cell_type),
+                                            params.distance_metric(),
+                                            params.ivf_pq().value());
+    }
     uint32_t m = params.max_links_per_node();
+    // Quantized traversal only preserves the ordering of distance metrics based on the angle between vectors.
+    auto quantization = HnswQuantizedVectors::supports(params.distance_metric()) ? params.quantization() : HnswQuantization::NONE;
     HnswIndexConfig cfg(m * 2,
                         m,
                         params.neighbors_to_explore_at_insert(),
                         10000,
-                        true);
+                        true,
+                        quantization);
     if (multi_vector_index) {
         return std::make_unique<HnswIndex<HnswIndexType::MULTI>>(vectors,
                                                                   make_distance_function_factory(params.distance_metric(), cell_type),
@@ -2,13 +2,30 @@
 
 #include "dense_tensor_attribute.h"
 #include <vespa/searchcommon/attribute/config.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 namespace search::tensor {
 
+namespace {
+
+void
+advise_will_need(const void* data, size_t size) noexcept
+{
+    static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+    uintptr_t start = reinterpret_cast<uintptr_t>(data) & ~(page_size - 1);
+    uintptr_t end = reinterpret_cast<uintptr_t>(data) + size;
+    // Only a hint, failure is ignored.
+    (void) madvise(reinterpret_cast<void*>(start), end - start, MADV_WILLNEED);
+}
+
+}
+
 DenseTensorAttribute::DenseTensorAttribute(std::string_view baseFileName, const Config& cfg,
                                            const NearestNeighborIndexFactory& index_factory)
     : TensorAttribute(baseFileName, cfg, _denseTensorStore, index_factory),
-      _denseTensorStore(cfg.tensorType(), get_memory_allocator())
+      _denseTensorStore(cfg.tensorType(), get_memory_allocator()),
+      _paged_vectors(static_cast<bool>(get_memory_allocator()))
 {
 }
 
@@ -43,4 +60,15 @@ DenseTensorAttribute::get_vectors(uint32_t docid) const noexcept
     return _denseTensorStore.get_vectors(ref);
 }
 
+void
+DenseTensorAttribute::prefetch_vector(uint32_t docid, uint32_t subspace) const noexcept
+{
+    if (_paged_vectors) {
+        auto cells = get_vector(docid, subspace);
+        if (!cells.non_existing_attribute_value()) {
+            advise_will_need(cells.data, vespalib::eval::CellTypeUtils::mem_size(cells.type, cells.size));
+        }
+    }
+}
+
 }
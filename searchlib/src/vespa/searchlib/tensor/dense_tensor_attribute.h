@@ -12,10 +12,14 @@ namespace search::tensor {
 /**
  * Attribute vector class used to store dense tensors for all
  * documents in memory.
+ *
+ * With a paged attribute the tensors are stored in memory mapped files,
+ * and the nearest neighbor index is hinted before reading many of them.
  */
 class DenseTensorAttribute : public TensorAttribute {
 private:
     DenseTensorStore _denseTensorStore;
+    bool             _paged_vectors;
 
 public:
     DenseTensorAttribute(std::string_view baseFileName, const Config& cfg,
@@ -28,6 +32,7 @@ public:
     // Implements DocVectorAccess
     vespalib::eval::TypedCells get_vector(uint32_t docid, uint32_t subspace) const noexcept override;
     VectorBundle get_vectors(uint32_t docid) const noexcept override;
+    void prefetch_vector(uint32_t docid, uint32_t subspace) const noexcept override;
 };
 
 }
@@ -130,6 +130,12 @@ DenseTensorStore::holdTensor(EntryRef ref)
 
 TensorStore::EntryRef
 DenseTensorStore::move_on_compact(EntryRef ref)
+{
+    return copy_tensor(ref);
+}
+
+TensorStore::EntryRef
+DenseTensorStore::copy_tensor(EntryRef ref)
 {
     if (!ref.valid()) {
         return RefType();
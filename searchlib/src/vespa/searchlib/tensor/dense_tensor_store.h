@@ -75,6 +75,7 @@ public:
     EntryRef store_encoded_tensor(vespalib::nbostream &encoded) override;
     std::unique_ptr<vespalib::eval::Value> get_tensor(EntryRef ref) const override;
     bool encode_stored_tensor(EntryRef ref, vespalib::nbostream &target) const override;
+    EntryRef copy_tensor(EntryRef ref) override;
     const DenseTensorStore* as_dense() const override;
     DenseTensorStore* as_dense() override;
 
@@ -22,7 +22,9 @@ DistanceCalculator::DistanceCalculator(const tensor::ITensorAttribute& attr_tens
                                        const vespalib::eval::Value& query_tensor_in)
     : _attr_tensor(attr_tensor),
       _query_tensor(&query_tensor_in),
-      _dist_fun()
+      _dist_fun(),
+      _subspace_cells(),
+      _subspace_distances()
 {
     auto * nns_index = _attr_tensor.nearest_neighbor_index();
     auto & dff = nns_index ? nns_index->distance_function_factory() : attr_tensor.distance_function_factory();
@@ -7,6 +7,8 @@
 #include "vector_bundle.h"
 #include <vespa/eval/eval/value_type.h>
 #include <optional>
+#include <span>
+#include <vector>
 
 namespace vespalib::eval { struct Value; }
 
@@ -25,6 +27,19 @@ private:
     const tensor::ITensorAttribute& _attr_tensor;
     const vespalib::eval::Value* _query_tensor;
     std::unique_ptr<BoundDistanceFunction> _dist_fun;
+    // Scratch space used to calculate the distances to all subspaces of a document in one batch.
+    mutable std::vector<vespalib::eval::TypedCells> _subspace_cells;
+    mutable std::vector<double> _subspace_distances;
+
+    std::span<const double> calc_subspace_distances(VectorBundle vectors) const noexcept {
+        _subspace_cells.clear();
+        for (uint32_t i = 0; i < vectors.subspaces(); ++i) {
+            _subspace_cells.push_back(vectors.cells(i));
+        }
+        _subspace_distances.resize(_subspace_cells.size());
+        _dist_fun->calc_batch(_subspace_cells, _subspace_distances);
+        return {_subspace_distances.data(), _subspace_cells.size()};
+    }
 
 public:
     DistanceCalculator(const tensor::ITensorAttribute& attr_tensor,
@@ -50,10 +65,8 @@ public:
             }
             return std::max(min_rawscore, _dist_fun->to_rawscore(_dist_fun->calc(cells)));
         } else {
-            auto vectors = _attr_tensor.get_vectors(docid);
             double result = _dist_fun->min_rawscore();
-            for (uint32_t i = 0; i < vectors.subspaces(); ++i) {
-                double distance = _dist_fun->calc(vectors.cells(i));
+            for (double distance : calc_subspace_distances(_attr_tensor.get_vectors(docid))) {
                 double score = _dist_fun->to_rawscore(distance);
                 result = std::max(result, score);
             }
@@ -71,10 +84,9 @@ public:
             }
             return _dist_fun->calc_with_limit(cells, limit);
         } else {
-            auto vectors = _attr_tensor.get_vectors(docid);
+            // All distance functions ignore the limit for now, so the batch calculation is used instead.
             double result = std::numeric_limits<double>::max();
-            for (uint32_t i = 0; i < vectors.subspaces(); ++i) {
-                double distance = _dist_fun->calc_with_limit(vectors.cells(i), limit);
+            for (double distance : calc_subspace_distances(_attr_tensor.get_vectors(docid))) {
                 result = std::min(result, distance);
             }
             return result;
@@ -82,8 +94,9 @@ public:
     }
 
     void calc_closest_subspace(VectorBundle vectors, std::optional<uint32_t>& closest_subspace, double& best_distance) noexcept {
-        for (uint32_t i = 0; i < vectors.subspaces(); ++i) {
-            double distance = _dist_fun->calc(vectors.cells(i));
+        auto distances = calc_subspace_distances(vectors);
+        for (uint32_t i = 0; i < distances.size(); ++i) {
+            double distance = distances[i];
             if (!closest_subspace.has_value() || distance < best_distance) {
                 best_distance = distance;
                 closest_subspace = i;
@@ -19,6 +19,15 @@ public:
     virtual ~DocVectorAccess() = default;
     virtual vespalib::eval::TypedCells get_vector(uint32_t docid, uint32_t subspace) const noexcept = 0;
     virtual VectorBundle get_vectors(uint32_t docid) const noexcept = 0;
+
+    /**
+     * Hints that the given vector will soon be read. Only needed when the vectors
+     * are not kept in memory, where it lets reading many vectors from disk overlap.
+     */
+    virtual void prefetch_vector(uint32_t docid, uint32_t subspace) const noexcept {
+        (void) docid;
+        (void) subspace;
+    }
 };
 
 }
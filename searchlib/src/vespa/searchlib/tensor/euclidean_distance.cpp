@@ -20,6 +20,9 @@ private:
     const vespalib::hwaccelerated::IAccelerated & _computer;
     mutable VectorStoreType _tmpSpace;
     const std::span<const FloatType> _lhs_vector;
+    double calc_converted(const FloatType* b) const noexcept {
+        return _computer.squaredEuclideanDistance(cast(_lhs_vector.data()), cast(b), _lhs_vector.size());
+    }
 public:
     explicit BoundEuclideanDistance(TypedCells lhs)
         : _computer(vespalib::hwaccelerated::IAccelerated::getAccelerator()),
@@ -27,10 +30,12 @@ public:
           _lhs_vector(_tmpSpace.storeLhs(lhs))
     {}
     double calc(TypedCells rhs) const noexcept override {
-        std::span<const FloatType> rhs_vector = _tmpSpace.convertRhs(rhs);
-        auto a = _lhs_vector.data();
-        auto b = rhs_vector.data();
-        return _computer.squaredEuclideanDistance(cast(a), cast(b), _lhs_vector.size());
+        return calc_converted(_tmpSpace.convertRhs(rhs).data());
+    }
+    void calc_batch(std::span<const TypedCells> rhs, std::span<double> distances) const noexcept override {
+        for (size_t i = 0; i < rhs.size(); ++i) {
+            distances[i] = calc_converted(_tmpSpace.convertRhs(rhs[i]).data());
+        }
     }
     double convert_threshold(double threshold) const noexcept override {
         return threshold*threshold;
@@ -48,9 +53,11 @@ public:
 template class BoundEuclideanDistance<TemporaryVectorStore<Int8Float>>;
 template class BoundEuclideanDistance<TemporaryVectorStore<float>>;
 template class BoundEuclideanDistance<TemporaryVectorStore<double>>;
+template class BoundEuclideanDistance<TemporaryVectorStore<vespalib::BFloat16>>;
 template class BoundEuclideanDistance<ReferenceVectorStore<Int8Float>>;
 template class BoundEuclideanDistance<ReferenceVectorStore<float>>;
 template class BoundEuclideanDistance<ReferenceVectorStore<double>>;
+template class BoundEuclideanDistance<ReferenceVectorStore<vespalib::BFloat16>>;
 
 template <typename FloatType>
 BoundDistanceFunction::UP
@@ -74,5 +81,6 @@ EuclideanDistanceFunctionFactory<FloatType>::for_insertion_vector(TypedCells lhs
 template class EuclideanDistanceFunctionFactory<Int8Float>;
 template class EuclideanDistanceFunctionFactory<float>;
 template class EuclideanDistanceFunctionFactory<double>;
+template class EuclideanDistanceFunctionFactory<vespalib::BFloat16>;
 
 }
@@ -27,6 +27,20 @@ FastValueView::FastValueView(const ValueType& type, std::span<const string_id> l
     assert(_index.map.size() == num_subspaces);
 }
 
+void
+FastValueView::assign(std::span<const string_id> labels, TypedCells cells, size_t num_subspaces)
+{
+    size_t num_mapped_dimensions = _index.map.addr_size();
+    _labels.assign(labels.begin(), labels.end());
+    _index.map.clear();
+    _cells = cells;
+    for (size_t i = 0; i < num_subspaces; ++i) {
+        std::span<const string_id> addr(_labels.data() + (i * num_mapped_dimensions), num_mapped_dimensions);
+        _index.map.add_mapping(FastAddrMap::hash_labels(addr));
+    }
+    assert(_index.map.size() == num_subspaces);
+}
+
 MemoryUsage
 FastValueView::get_memory_usage() const
 {
@@ -18,24 +18,31 @@ private:
     using FloatType = VectorStoreType::FloatType;
     mutable VectorStoreType _tmpSpace;
     const std::span<const FloatType> _lhs_vector;
-public:
-    explicit BoundHammingDistance(TypedCells lhs)
-        : _tmpSpace(lhs.size),
-          _lhs_vector(_tmpSpace.storeLhs(lhs))
-    {}
-    double calc(TypedCells rhs) const noexcept override {
+    double calc_converted(const FloatType* b) const noexcept {
         size_t sz = _lhs_vector.size();
-        std::span<const FloatType> rhs_vector = _tmpSpace.convertRhs(rhs);
         if constexpr (std::is_same<Int8Float, FloatType>::value) {
-            return (double) vespalib::binary_hamming_distance(_lhs_vector.data(), rhs_vector.data(), sz);
+            return (double) vespalib::binary_hamming_distance(_lhs_vector.data(), b, sz);
         } else {
             size_t sum = 0;
             for (size_t i = 0; i < sz; ++i) {
-                sum += (_lhs_vector[i] == rhs_vector[i]) ? 0 : 1;
+                sum += (_lhs_vector[i] == b[i]) ? 0 : 1;
             }
             return (double)sum;
         }
     }
+public:
+    explicit BoundHammingDistance(TypedCells lhs)
+        : _tmpSpace(lhs.size),
+          _lhs_vector(_tmpSpace.storeLhs(lhs))
+    {}
+    double calc(TypedCells rhs) const noexcept override {
+        return calc_converted(_tmpSpace.convertRhs(rhs).data());
+    }
+    void calc_batch(std::span<const TypedCells> rhs, std::span<double> distances) const noexcept override {
+        for (size_t i = 0; i < rhs.size(); ++i) {
+            distances[i] = calc_converted(_tmpSpace.convertRhs(rhs[i]).data());
+        }
+    }
     double convert_threshold(double threshold) const noexcept override {
         return threshold;
     }
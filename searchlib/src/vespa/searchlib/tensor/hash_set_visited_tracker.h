@@ -20,6 +20,7 @@ public:
     bool try_mark(uint32_t nodeid) {
         return _visited.insert(nodeid).second;
     }
+    uint32_t count() const noexcept { return _visited.size(); }
 };
 
 }
@@ -13,16 +13,41 @@
 #include <vespa/searchlib/attribute/address_space_usage.h>
 #include <vespa/searchlib/util/fileutil.h>
 #include <vespa/vespalib/datastore/array_store.hpp>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/doom.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/memory_allocator.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/time.h>
+#include <array>
+#include <functional>
+#include <limits>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".searchlib.tensor.hnsw_index");
 
 namespace search::tensor {
 
+namespace internal {
+
+/**
+ * Locks used while multiple threads add documents to the graph, see HnswIndex::add_documents_in_parallel().
+ *
+ * The link arrays of a node are read and replaced while holding its (striped) node mutex.
+ * The graph data stores, the quantized vectors and the entry node are guarded by the store mutex.
+ * A thread never holds more than one node mutex, and the store mutex is always taken last.
+ */
+struct BulkBuildLocks {
+    static constexpr uint32_t num_node_mutexes = 1024;
+    std::array<std::mutex, num_node_mutexes> node_mutexes;
+    std::mutex store_mutex;
+    std::mutex level_generator_mutex;
+
+    std::mutex& node_mutex(uint32_t nodeid) noexcept { return node_mutexes[nodeid % num_node_mutexes]; }
+};
+
+}
+
 using search::AddressSpaceComponents;
 using search::queryeval::GlobalFilter;
 using vespalib::datastore::ArrayStoreConfig;
@@ -81,6 +106,27 @@ bool operator< (const PairDist &a, const PairDist &b) {
     return (a.distance < b.distance);
 }
 
+/*
+ * Wraps the loader of the graph, populating the quantized vectors when the graph is loaded.
+ */
+class QuantizingIndexLoader : public NearestNeighborIndexLoader {
+    std::unique_ptr<NearestNeighborIndexLoader> _loader;
+    std::function<void()> _on_complete;
+public:
+    QuantizingIndexLoader(std::unique_ptr<NearestNeighborIndexLoader> loader, std::function<void()> on_complete)
+        : _loader(std::move(loader)),
+          _on_complete(std::move(on_complete))
+    {
+    }
+    bool load_next() override {
+        bool more = _loader->load_next();
+        if (!more) {
+            _on_complete();
+        }
+        return more;
+    }
+};
+
 }
 
 namespace internal {
@@ -219,13 +265,39 @@ HnswIndex<type>::select_neighbors(const HnswCandidateVectorT& neighbors, uint32_
     }
 }
 
+template <HnswIndexType type>
+std::unique_lock<std::mutex>
+HnswIndex<type>::lock_node(uint32_t nodeid) const
+{
+    return _bulk_build_locks ? std::unique_lock(_bulk_build_locks->node_mutex(nodeid)) : std::unique_lock<std::mutex>();
+}
+
+template <HnswIndexType type>
+std::unique_lock<std::mutex>
+HnswIndex<type>::lock_graph_stores() const
+{
+    return _bulk_build_locks ? std::unique_lock(_bulk_build_locks->store_mutex) : std::unique_lock<std::mutex>();
+}
+
+template <HnswIndexType type>
+std::unique_lock<std::mutex>
+HnswIndex<type>::lock_level_generator() const
+{
+    return _bulk_build_locks ? std::unique_lock(_bulk_build_locks->level_generator_mutex) : std::unique_lock<std::mutex>();
+}
+
 template <HnswIndexType type>
 void
 HnswIndex<type>::shrink_if_needed(uint32_t nodeid, uint32_t level)
 {
-    auto old_links = _graph.get_link_array(nodeid, level);
-    uint32_t max_links = max_links_for_level(level);
-    if (old_links.size() > max_links) {
+    LinkArray unused_links;
+    {
+        auto guard = lock_node(nodeid);
+        auto old_links = _graph.get_link_array(nodeid, level);
+        uint32_t max_links = max_links_for_level(level);
+        if (old_links.size() <= max_links) {
+            return;
+        }
         HnswTraversalCandidateVector neighbors;
         neighbors.reserve(old_links.size());
         auto df = _distance_ff->for_insertion_vector(get_vector(nodeid));
@@ -239,10 +311,12 @@ HnswIndex<type>::shrink_if_needed(uint32_t nodeid, uint32_t level)
         for (const auto & neighbor : split.used) {
             new_links.push_back(neighbor.nodeid);
         }
-        _graph.set_link_array(nodeid, level, new_links);
-        for (uint32_t removed_nodeid : split.unused) {
-            remove_link_to(removed_nodeid, nodeid, level);
-        }
+        set_link_array(nodeid, level, new_links);
+        unused_links = std::move(split.unused);
+    }
+    // The node mutex is released before the back links are removed, so at most one is held at a time.
+    for (uint32_t removed_nodeid : unused_links) {
+        remove_link_to(removed_nodeid, nodeid, level);
     }
 }
 
@@ -250,10 +324,20 @@ template <HnswIndexType type>
 void
 HnswIndex<type>::connect_new_node(uint32_t nodeid, const LinkArrayRef &neighbors, uint32_t level)
 {
-    _graph.set_link_array(nodeid, level, neighbors);
+    {
+        auto guard = lock_node(nodeid);
+        set_link_array(nodeid, level, neighbors);
+    }
     for (uint32_t neighbor_nodeid : neighbors) {
-        auto old_links = _graph.get_link_array(neighbor_nodeid, level);
-        add_link_to(neighbor_nodeid, level, old_links, nodeid);
+        {
+            auto guard = lock_node(neighbor_nodeid);
+            auto old_links = _graph.get_link_array(neighbor_nodeid, level);
+            add_link_to(neighbor_nodeid, level, old_links, nodeid);
+        }
+        if (_bulk_build_locks && !is_linked_to(nodeid, neighbor_nodeid, level)) {
+            // Another thread has already shrunk the new node and removed the link to this neighbor.
+            remove_link_to(neighbor_nodeid, nodeid, level);
+        }
     }
     for (uint32_t neighbor_nodeid : neighbors) {
         shrink_if_needed(neighbor_nodeid, level);
@@ -264,13 +348,22 @@ template <HnswIndexType type>
 void
 HnswIndex<type>::remove_link_to(uint32_t remove_from, uint32_t remove_id, uint32_t level)
 {
+    auto guard = lock_node(remove_from);
     LinkArray new_links;
     auto old_links = _graph.get_link_array(remove_from, level);
     new_links.reserve(old_links.size());
     for (uint32_t id : old_links) {
         if (id != remove_id) new_links.push_back(id);
     }
-    _graph.set_link_array(remove_from, level, new_links);
+    set_link_array(remove_from, level, new_links);
+}
+
+template <HnswIndexType type>
+bool
+HnswIndex<type>::is_linked_to(uint32_t nodeid, uint32_t link, uint32_t level) const
+{
+    auto guard = lock_node(nodeid);
+    return has_link_to(_graph.get_link_array(nodeid, level), link);
 }
 
 namespace {
@@ -288,6 +381,77 @@ calc_distance_helper(const BoundDistanceFunction &df, vespalib::eval::TypedCells
     return df.calc(rhs);
 }
 
+/*
+ * Neighbors found when traversing a layer, with the vectors used to
+ * calculate their distances to the query vector in one batch.
+ */
+class TraversalNeighbors {
+public:
+    struct Neighbor {
+        uint32_t nodeid;
+        uint32_t docid;
+        EntryRef levels_ref;
+        Neighbor(uint32_t nodeid_in, uint32_t docid_in, EntryRef levels_ref_in) noexcept
+            : nodeid(nodeid_in), docid(docid_in), levels_ref(levels_ref_in)
+        {}
+    };
+private:
+    std::vector<Neighbor>                   _neighbors;
+    std::vector<vespalib::eval::TypedCells> _vectors;
+    std::vector<double>                     _distances;
+public:
+    TraversalNeighbors() noexcept;
+    ~TraversalNeighbors();
+    void reserve(size_t size) {
+        _neighbors.reserve(size);
+        _vectors.reserve(size);
+        _distances.reserve(size);
+    }
+    void clear() noexcept {
+        _neighbors.clear();
+        _vectors.clear();
+    }
+    void add(uint32_t nodeid, uint32_t docid, EntryRef levels_ref, vespalib::eval::TypedCells vector) {
+        _neighbors.emplace_back(nodeid, docid, levels_ref);
+        _vectors.push_back(vector);
+    }
+    size_t size() const noexcept { return _neighbors.size(); }
+    const Neighbor& operator[](size_t i) const noexcept { return _neighbors[i]; }
+    double distance(size_t i) const noexcept { return _distances[i]; }
+    void calc_distances(const BoundDistanceFunction& df) {
+        _distances.resize(_vectors.size());
+        df.calc_batch(_vectors, _distances);
+    }
+};
+
+TraversalNeighbors::TraversalNeighbors() noexcept = default;
+TraversalNeighbors::~TraversalNeighbors() = default;
+
+size_t
+vector_mem_size(vespalib::eval::TypedCells vector) noexcept
+{
+    return vespalib::eval::CellTypeUtils::mem_size(vector.type, vector.size);
+}
+
+size_t
+link_array_mem_size(std::span<const uint32_t> links) noexcept
+{
+    return links.size() * sizeof(uint32_t);
+}
+
+void
+prefetch_cache_lines(vespalib::eval::TypedCells vector) noexcept
+{
+    // The hardware prefetcher is expected to pick up the rest of a long vector.
+    constexpr size_t cache_line_size = 64;
+    constexpr size_t max_prefetch_bytes = 4 * cache_line_size;
+    auto data = static_cast<const char*>(vector.data);
+    size_t bytes = std::min(vector_mem_size(vector), max_prefetch_bytes);
+    for (size_t offset = 0; offset < bytes; offset += cache_line_size) {
+        __builtin_prefetch(data + offset);
+    }
+}
+
 }
 
 template <HnswIndexType type>
@@ -332,18 +496,29 @@ HnswIndex<type>::estimate_visited_nodes(uint32_t level, uint32_t nodeid_limit, u
 
 template <HnswIndexType type>
 HnswCandidate
-HnswIndex<type>::find_nearest_in_layer(const BoundDistanceFunction &df, const HnswCandidate& entry_point, uint32_t level) const
+HnswIndex<type>::find_nearest_in_layer(const BoundDistanceFunction &df, const HnswCandidate& entry_point, uint32_t level, bool quantized,
+                                       SearchStats* stats) const
 {
     HnswCandidate nearest = entry_point;
     bool keep_searching = true;
     while (keep_searching) {
         keep_searching = false;
-        for (uint32_t neighbor_nodeid : _graph.get_link_array(nearest.levels_ref, level)) {
+        auto links = _graph.get_link_array(nearest.levels_ref, level);
+        if (stats != nullptr) {
+            stats->visited_nodes += links.size();
+            stats->distance_computations += links.size();
+            stats->visited_bytes += link_array_mem_size(links);
+        }
+        for (uint32_t neighbor_nodeid : links) {
             auto& neighbor_node = _graph.acquire_node(neighbor_nodeid);
             auto neighbor_ref = neighbor_node.levels_ref().load_acquire();
             uint32_t neighbor_docid = acquire_docid(neighbor_node, neighbor_nodeid);
             uint32_t neighbor_subspace = neighbor_node.acquire_subspace();
-            double dist = calc_distance(df, neighbor_docid, neighbor_subspace);
+            auto vector = get_traversal_vector(quantized, neighbor_nodeid, neighbor_docid, neighbor_subspace);
+            if (stats != nullptr) {
+                stats->visited_bytes += vector_mem_size(vector);
+            }
+            double dist = calc_distance_helper(df, vector);
             if (_graph.still_valid(neighbor_nodeid, neighbor_ref)
                 && dist < nearest.distance)
             {
@@ -361,7 +536,7 @@ void
 HnswIndex<type>::search_layer_helper(const BoundDistanceFunction &df, uint32_t neighbors_to_find, double exploration_slack,
                                      BestNeighbors& best_neighbors, uint32_t level, const GlobalFilter *filter,
                                      uint32_t nodeid_limit, const vespalib::Doom* const doom,
-                                     uint32_t estimated_visited_nodes) const
+                                     uint32_t estimated_visited_nodes, bool quantized, SearchStats* stats) const
 {
     NearestPriQ candidates;
     internal::GlobalFilterWrapper<type> filter_wrapper(filter);
@@ -385,6 +560,10 @@ HnswIndex<type>::search_layer_helper(const BoundDistanceFunction &df, uint32_t n
         }
     }
     double limit_dist = std::numeric_limits<double>::max();
+    uint32_t distance_computations = 0;
+    uint64_t visited_bytes = 0;
+    TraversalNeighbors neighbors;
+    neighbors.reserve(max_links_for_level(level));
 
     while (!candidates.empty()) {
         auto cand = candidates.top();
@@ -392,7 +571,12 @@ HnswIndex<type>::search_layer_helper(const BoundDistanceFunction &df, uint32_t n
             break;
         }
         candidates.pop();
-        for (uint32_t neighbor_nodeid : _graph.get_link_array(cand.levels_ref, level)) {
+        // All vectors of the unvisited neighbors are prefetched before any distance is calculated,
+        // so their cache misses overlap instead of being taken one neighbor at a time.
+        neighbors.clear();
+        auto links = _graph.get_link_array(cand.levels_ref, level);
+        visited_bytes += link_array_mem_size(links);
+        for (uint32_t neighbor_nodeid : links) {
             if (neighbor_nodeid >= nodeid_limit) {
                 continue;
             }
@@ -405,12 +589,25 @@ HnswIndex<type>::search_layer_helper(const BoundDistanceFunction &df, uint32_t n
             }
             uint32_t neighbor_docid = acquire_docid(neighbor_node, neighbor_nodeid);
             uint32_t neighbor_subspace = neighbor_node.acquire_subspace();
-            double dist_to_input = calc_distance(df, neighbor_docid, neighbor_subspace);
+            auto vector = get_traversal_vector(quantized, neighbor_nodeid, neighbor_docid, neighbor_subspace);
+            if (vector.non_existing_attribute_value()) [[unlikely]] {
+                // The write thread has removed the tensor, cf. calc_distance_helper().
+                continue;
+            }
+            prefetch_cache_lines(vector);
+            visited_bytes += vector_mem_size(vector);
+            neighbors.add(neighbor_nodeid, neighbor_docid, neighbor_ref, vector);
+        }
+        distance_computations += neighbors.size();
+        neighbors.calc_distances(df);
+        for (size_t i = 0; i < neighbors.size(); ++i) {
+            const auto& neighbor = neighbors[i];
+            double dist_to_input = neighbors.distance(i);
             if (dist_to_input < (1.0 + exploration_slack) * limit_dist) {
-                candidates.emplace(neighbor_nodeid, neighbor_ref, dist_to_input);
+                candidates.emplace(neighbor.nodeid, neighbor.levels_ref, dist_to_input);
 
-                if (dist_to_input < limit_dist && filter_wrapper.check(neighbor_docid)) {
-                    best_neighbors.emplace(neighbor_nodeid, neighbor_docid, neighbor_ref, dist_to_input);
+                if (dist_to_input < limit_dist && filter_wrapper.check(neighbor.docid)) {
+                    best_neighbors.emplace(neighbor.nodeid, neighbor.docid, neighbor.levels_ref, dist_to_input);
                     while (best_neighbors.size() > neighbors_to_find) {
                         best_neighbors.pop();
                         limit_dist = best_neighbors.top().distance;
@@ -422,6 +619,11 @@ HnswIndex<type>::search_layer_helper(const BoundDistanceFunction &df, uint32_t n
             break;
         }
     }
+    if (stats != nullptr) {
+        stats->visited_nodes += visited.count();
+        stats->distance_computations += distance_computations;
+        stats->visited_bytes += visited_bytes;
+    }
 }
 
 
@@ -431,7 +633,7 @@ void
 HnswIndex<type>::search_layer_filter_first_helper(const BoundDistanceFunction &df, uint32_t neighbors_to_find, double exploration_slack,
                                                   BestNeighbors& best_neighbors, double exploration, uint32_t level, const GlobalFilter *filter,
                                                   uint32_t nodeid_limit, const vespalib::Doom* const doom,
-                                                  uint32_t estimated_visited_nodes) const
+                                                  uint32_t estimated_visited_nodes, bool quantized, SearchStats* stats) const
 {
     assert(filter);
     NearestPriQ candidates;
@@ -457,7 +659,10 @@ HnswIndex<type>::search_layer_filter_first_helper(const BoundDistanceFunction &d
     }
     double limit_dist = std::numeric_limits<double>::max();
 
+    uint32_t distance_computations = 0;
+    uint64_t visited_bytes = 0;
     std::deque<uint32_t> neighborhood;
+    TraversalNeighbors neighbors;
     while (!candidates.empty()) {
         auto cand = candidates.top();
         if (cand.distance > (1.0 + exploration_slack) * limit_dist) {
@@ -467,8 +672,10 @@ HnswIndex<type>::search_layer_filter_first_helper(const BoundDistanceFunction &d
 
         // Instead of taking immediate neighbors, we additionally explore 2-hop neighbors (and possibly 3-hop neighbors)
         neighborhood.clear();
-        exploreNeighborhood(cand, neighborhood, visited, exploration, level, filter_wrapper, nodeid_limit);
+        exploreNeighborhood(cand, neighborhood, visited, exploration, level, filter_wrapper, nodeid_limit, visited_bytes);
 
+        // Prefetch all vectors in the neighborhood before calculating any distance, as in search_layer_helper().
+        neighbors.clear();
         for (uint32_t neighbor_nodeid : neighborhood) {
             auto& neighbor_node = _graph.acquire_node(neighbor_nodeid);
             auto neighbor_ref = neighbor_node.levels_ref().load_acquire();
@@ -477,13 +684,26 @@ HnswIndex<type>::search_layer_filter_first_helper(const BoundDistanceFunction &d
             }
             uint32_t neighbor_docid = acquire_docid(neighbor_node, neighbor_nodeid);
             uint32_t neighbor_subspace = neighbor_node.acquire_subspace();
-            double dist_to_input = calc_distance(df, neighbor_docid, neighbor_subspace);
+            auto vector = get_traversal_vector(quantized, neighbor_nodeid, neighbor_docid, neighbor_subspace);
+            if (vector.non_existing_attribute_value()) [[unlikely]] {
+                // The write thread has removed the tensor, cf. calc_distance_helper().
+                continue;
+            }
+            prefetch_cache_lines(vector);
+            visited_bytes += vector_mem_size(vector);
+            neighbors.add(neighbor_nodeid, neighbor_docid, neighbor_ref, vector);
+        }
+        distance_computations += neighbors.size();
+        neighbors.calc_distances(df);
+        for (size_t i = 0; i < neighbors.size(); ++i) {
+            const auto& neighbor = neighbors[i];
+            double dist_to_input = neighbors.distance(i);
             if (dist_to_input < (1.0 + exploration_slack) * limit_dist) {
-                candidates.emplace(neighbor_nodeid, neighbor_ref, dist_to_input);
+                candidates.emplace(neighbor.nodeid, neighbor.levels_ref, dist_to_input);
 
-                if (dist_to_input < limit_dist && filter_wrapper.check(neighbor_docid)) {
+                if (dist_to_input < limit_dist && filter_wrapper.check(neighbor.docid)) {
                     // exploreNeighborhood only returns nodes that pass the filter, no need to check that here
-                    best_neighbors.emplace(neighbor_nodeid, neighbor_docid, neighbor_ref, dist_to_input);
+                    best_neighbors.emplace(neighbor.nodeid, neighbor.docid, neighbor.levels_ref, dist_to_input);
                     while (best_neighbors.size() > neighbors_to_find) {
                         best_neighbors.pop();
                         limit_dist = best_neighbors.top().distance;
@@ -495,13 +715,19 @@ HnswIndex<type>::search_layer_filter_first_helper(const BoundDistanceFunction &d
             break;
         }
     }
+    if (stats != nullptr) {
+        stats->visited_nodes += visited.count();
+        stats->distance_computations += distance_computations;
+        stats->visited_bytes += visited_bytes;
+    }
 }
 
 template <HnswIndexType type>
 template <class VisitedTracker>
 void
 HnswIndex<type>::exploreNeighborhood(HnswTraversalCandidate &cand, std::deque<uint32_t> &found, VisitedTracker &visited, double exploration,
-                                     uint32_t level, const internal::GlobalFilterWrapper<type>& filter_wrapper, uint32_t nodeid_limit) const {
+                                     uint32_t level, const internal::GlobalFilterWrapper<type>& filter_wrapper, uint32_t nodeid_limit,
+                                     uint64_t& visited_bytes) const {
     assert(found.empty());
 
     std::deque<uint32_t> todo;
@@ -510,14 +736,14 @@ HnswIndex<type>::exploreNeighborhood(HnswTraversalCandidate &cand, std::deque<ui
     uint32_t max_neighbors_to_find = max_links_for_level(level);
 
     // Explore (1-hop) neighbors
-    exploreNeighborhoodByOneHop(todo, found, visited, level, filter_wrapper, nodeid_limit, max_neighbors_to_find);
+    exploreNeighborhoodByOneHop(todo, found, visited, level, filter_wrapper, nodeid_limit, max_neighbors_to_find, visited_bytes);
 
     // Explore 2-hop neighbors
-    exploreNeighborhoodByOneHop(todo, found, visited, level, filter_wrapper, nodeid_limit, max_neighbors_to_find);
+    exploreNeighborhoodByOneHop(todo, found, visited, level, filter_wrapper, nodeid_limit, max_neighbors_to_find, visited_bytes);
 
     // Explore 3-hop neighbors, but only if we have not found enough nodes yet (one quarter of the desired amount)
     if (static_cast<double>(todo.size()) < exploration * (max_neighbors_to_find * max_neighbors_to_find * max_neighbors_to_find)) {
-        exploreNeighborhoodByOneHop(todo, found, visited, level, filter_wrapper, nodeid_limit, max_neighbors_to_find);
+        exploreNeighborhoodByOneHop(todo, found, visited, level, filter_wrapper, nodeid_limit, max_neighbors_to_find, visited_bytes);
     }
 }
 
@@ -526,7 +752,7 @@ template <class VisitedTracker>
 void
 HnswIndex<type>::exploreNeighborhoodByOneHop(std::deque<uint32_t> &todo, std::deque<uint32_t> &found, VisitedTracker &visited, uint32_t level,
                                              const internal::GlobalFilterWrapper<type>& filter_wrapper, uint32_t nodeid_limit,
-                                             uint32_t max_neighbors_to_find) const {
+                                             uint32_t max_neighbors_to_find, uint64_t& visited_bytes) const {
     // We do not explore the candidates that we newly add to the deque
     uint32_t nodesToExplore = todo.size();
     for (uint32_t nodesExplored = 0; nodesExplored < nodesToExplore && found.size() < max_neighbors_to_find; ++nodesExplored) {
@@ -534,8 +760,10 @@ HnswIndex<type>::exploreNeighborhoodByOneHop(std::deque<uint32_t> &todo, std::de
         todo.pop_front();
         auto& node = _graph.acquire_node(nodeid);
         auto ref = node.levels_ref().load_acquire();
+        auto links = _graph.get_link_array(ref, level);
+        visited_bytes += link_array_mem_size(links);
 
-        for (uint32_t neighbor_nodeid : _graph.get_link_array(ref, level)) {
+        for (uint32_t neighbor_nodeid : links) {
             if (neighbor_nodeid >= nodeid_limit) {
                 continue;
             }
@@ -567,14 +795,15 @@ template <HnswIndexType type>
 template <class BestNeighbors>
 void
 HnswIndex<type>::search_layer(const BoundDistanceFunction &df, uint32_t neighbors_to_find, double exploration_slack, BestNeighbors& best_neighbors,
-                              uint32_t level, const vespalib::Doom* const doom, const GlobalFilter *filter) const
+                              uint32_t level, const vespalib::Doom* const doom, const GlobalFilter *filter, bool quantized,
+                              SearchStats* stats) const
 {
     uint32_t nodeid_limit = _graph.nodes_size.load(std::memory_order_acquire);
     uint32_t estimated_visited_nodes = estimate_visited_nodes(level, nodeid_limit, neighbors_to_find, filter);
     if (estimated_visited_nodes >= nodeid_limit / 128) {
-        search_layer_helper<BitVectorVisitedTracker>(df, neighbors_to_find, exploration_slack, best_neighbors, level, filter, nodeid_limit, doom, estimated_visited_nodes);
+        search_layer_helper<BitVectorVisitedTracker>(df, neighbors_to_find, exploration_slack, best_neighbors, level, filter, nodeid_limit, doom, estimated_visited_nodes, quantized, stats);
     } else {
-        search_layer_helper<HashSetVisitedTracker>(df, neighbors_to_find, exploration_slack, best_neighbors, level, filter, nodeid_limit, doom, estimated_visited_nodes);
+        search_layer_helper<HashSetVisitedTracker>(df, neighbors_to_find, exploration_slack, best_neighbors, level, filter, nodeid_limit, doom, estimated_visited_nodes, quantized, stats);
     }
 }
 
@@ -582,14 +811,15 @@ template <HnswIndexType type>
 template <class BestNeighbors>
 void
 HnswIndex<type>::search_layer_filter_first(const BoundDistanceFunction &df, uint32_t neighbors_to_find, double exploration_slack, BestNeighbors& best_neighbors, double exploration,
-                                           uint32_t level, const vespalib::Doom* const doom, const GlobalFilter *filter) const
+                                           uint32_t level, const vespalib::Doom* const doom, const GlobalFilter *filter, bool quantized,
+                                           SearchStats* stats) const
 {
     uint32_t nodeid_limit = _graph.nodes_size.load(std::memory_order_acquire);
     uint32_t estimated_visited_nodes = estimate_visited_nodes(level, nodeid_limit, neighbors_to_find, filter);
     if (estimated_visited_nodes >= nodeid_limit / 128) {
-        search_layer_filter_first_helper<BitVectorVisitedTracker>(df, neighbors_to_find, exploration_slack, best_neighbors, exploration, level, filter, nodeid_limit, doom, estimated_visited_nodes);
+        search_layer_filter_first_helper<BitVectorVisitedTracker>(df, neighbors_to_find, exploration_slack, best_neighbors, exploration, level, filter, nodeid_limit, doom, estimated_visited_nodes, quantized, stats);
     } else {
-        search_layer_filter_first_helper<HashSetVisitedTracker>(df, neighbors_to_find, exploration_slack, best_neighbors, exploration, level, filter, nodeid_limit, doom, estimated_visited_nodes);
+        search_layer_filter_first_helper<HashSetVisitedTracker>(df, neighbors_to_find, exploration_slack, best_neighbors, exploration, level, filter, nodeid_limit, doom, estimated_visited_nodes, quantized, stats);
     }
 }
 
@@ -601,9 +831,23 @@ HnswIndex<type>::HnswIndex(const DocVectorAccess& vectors, DistanceFunctionFacto
       _distance_ff(std::move(distance_ff)),
       _level_generator(std::move(level_generator)),
       _id_mapping(),
-      _cfg(cfg)
+      _cfg(cfg),
+      _quantized_vectors(cfg.quantization()),
+      _bulk_build_locks(),
+      _bulk_build_threads(0),
+      _bulk_build_added_docs(0),
+      _compacting_levels(),
+      _compacting_levels_filter(),
+      _compacting_links(),
+      _compaction_order(),
+      _compaction_step_nodes(default_compaction_step_nodes),
+      _compaction_pos(0),
+      _compaction_nodes(0)
 {
     assert(_distance_ff);
+    if (_quantized_vectors.enabled()) {
+        _distance_ff = std::make_unique<QuantizedDistanceFunctionFactory>(std::move(_distance_ff), _quantized_vectors);
+    }
 }
 
 template <HnswIndexType type>
@@ -616,13 +860,20 @@ using internal::PreparedFirstAddDoc;
 template <HnswIndexType type>
 void
 HnswIndex<type>::add_document(uint32_t docid)
+{
+    auto input_vectors = get_vectors(docid);
+    auto nodeids = _id_mapping.allocate_ids(docid, input_vectors.subspaces());
+    internal_add(docid, input_vectors, nodeids);
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::internal_add(uint32_t docid, VectorBundle input_vectors, std::span<const uint32_t> nodeids)
 {
     vespalib::GenerationHandler::Guard no_guard_needed;
     PreparedAddDoc op(docid, std::move(no_guard_needed));
-    auto input_vectors = get_vectors(docid);
     auto subspaces = input_vectors.subspaces();
     op.nodes.reserve(subspaces);
-    auto nodeids = _id_mapping.allocate_ids(docid, subspaces);
     assert(nodeids.size() == subspaces);
     for (uint32_t subspace = 0; subspace < subspaces; ++subspace) {
         auto entry = _graph.get_entry_node();
@@ -631,6 +882,64 @@ HnswIndex<type>::add_document(uint32_t docid)
     }
 }
 
+template <HnswIndexType type>
+void
+HnswIndex<type>::add_documents_in_parallel(std::span<const uint32_t> docids, vespalib::Executor& executor, uint32_t num_threads)
+{
+    // The first documents are added serially to ensure they are linked together, as for two-phase adds.
+    size_t serial_docs = 0;
+    uint32_t min_size = std::max(_cfg.min_size_before_two_phase(), 1u);
+    while ((serial_docs < docids.size()) && ((num_threads <= 1) || (_graph.get_active_nodes() < min_size))) {
+        add_document(docids[serial_docs++]);
+        _bulk_build_added_docs.fetch_add(1, std::memory_order_relaxed);
+    }
+    auto parallel_docids = docids.subspan(serial_docs);
+    if (parallel_docids.empty()) {
+        return;
+    }
+    // All nodeids are allocated and the node vector is sized up front, as neither
+    // the nodeid mapping nor the node vector can be changed while other threads use them.
+    std::vector<uint32_t> nodeids;
+    std::vector<uint32_t> nodeids_offsets;
+    nodeids_offsets.reserve(parallel_docids.size() + 1);
+    nodeids_offsets.push_back(0);
+    uint32_t nodeid_limit = _graph.nodes.get_size();
+    for (uint32_t docid : parallel_docids) {
+        auto allocated = _id_mapping.allocate_ids(docid, get_vectors(docid).subspaces());
+        for (uint32_t nodeid : allocated) {
+            nodeids.push_back(nodeid);
+            nodeid_limit = std::max(nodeid_limit, nodeid + 1);
+        }
+        nodeids_offsets.push_back(nodeids.size());
+    }
+    _graph.nodes.ensure_size(nodeid_limit, NodeType());
+    _bulk_build_locks = std::make_unique<internal::BulkBuildLocks>();
+    std::atomic<size_t> next_doc(0);
+    auto add_docs = [&]() {
+        _bulk_build_threads.fetch_add(1, std::memory_order_relaxed);
+        for (size_t i = next_doc.fetch_add(1, std::memory_order_relaxed); i < parallel_docids.size();
+             i = next_doc.fetch_add(1, std::memory_order_relaxed))
+        {
+            uint32_t docid = parallel_docids[i];
+            std::span<const uint32_t> doc_nodeids(nodeids.data() + nodeids_offsets[i], nodeids.data() + nodeids_offsets[i + 1]);
+            internal_add(docid, get_vectors(docid), doc_nodeids);
+            _bulk_build_added_docs.fetch_add(1, std::memory_order_relaxed);
+        }
+        _bulk_build_threads.fetch_sub(1, std::memory_order_relaxed);
+    };
+    uint32_t num_tasks = std::min(size_t(num_threads), parallel_docids.size()) - 1;
+    vespalib::CountDownLatch latch(num_tasks);
+    for (uint32_t i = 0; i < num_tasks; ++i) {
+        auto rejected = executor.execute(vespalib::makeLambdaTask([&]() { add_docs(); latch.countDown(); }));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    add_docs();
+    latch.await();
+    _bulk_build_locks.reset();
+}
+
 template <HnswIndexType type>
 PreparedAddDoc
 HnswIndex<type>::internal_prepare_add(uint32_t docid, VectorBundle input_vectors, vespalib::GenerationHandler::Guard read_guard) const
@@ -649,7 +958,11 @@ template <HnswIndexType type>
 void
 HnswIndex<type>::internal_prepare_add_node(PreparedAddDoc& op, TypedCells input_vector, const typename GraphType::EntryNode& entry) const
 {
-    int node_max_level = std::min(_level_generator->max_level(), max_max_level);
+    int node_max_level;
+    {
+        auto guard = lock_level_generator();
+        node_max_level = std::min(_level_generator->max_level(), max_max_level);
+    }
     std::vector<PreparedAddNode::Links> connections(node_max_level + 1);
     if (entry.nodeid == 0) {
         // graph has no entry point
@@ -728,11 +1041,19 @@ void
 HnswIndex<type>::internal_complete_add_node(uint32_t nodeid, uint32_t docid, uint32_t subspace, PreparedAddNode &prepared_node)
 {
     int32_t num_levels = prepared_node.connections.size();
-    auto levels_ref = _graph.make_node(nodeid, docid, subspace, num_levels);
+    vespalib::datastore::EntryRef levels_ref;
+    {
+        auto guard = lock_graph_stores();
+        if (_quantized_vectors.enabled()) {
+            _quantized_vectors.set(nodeid, get_vector(docid, subspace));
+        }
+        levels_ref = _graph.make_node(nodeid, docid, subspace, num_levels);
+    }
     for (int level = 0; level < num_levels; ++level) {
         auto neighbors = filter_valid_nodeids(level, prepared_node.connections[level], nodeid);
         connect_new_node(nodeid, neighbors, level);
     }
+    auto guard = lock_graph_stores();
     if (num_levels - 1 > get_entry_level()) {
         _graph.set_entry_node({nodeid, levels_ref, num_levels - 1});
     }
@@ -850,6 +1171,7 @@ HnswIndex<type>::assign_generation(generation_t current_gen)
     _graph.levels_store.assign_generation(current_gen);
     _graph.links_store.assign_generation(current_gen);
     _id_mapping.assign_generation(current_gen);
+    _quantized_vectors.assign_generation(current_gen);
 }
 
 template <HnswIndexType type>
@@ -860,39 +1182,136 @@ HnswIndex<type>::reclaim_memory(generation_t oldest_used_gen)
     _graph.levels_store.reclaim_memory(oldest_used_gen);
     _graph.links_store.reclaim_memory(oldest_used_gen);
     _id_mapping.reclaim_memory(oldest_used_gen);
+    _quantized_vectors.reclaim_memory(oldest_used_gen);
 }
 
 template <HnswIndexType type>
-void
-HnswIndex<type>::compact_level_arrays(const CompactionStrategy& compaction_strategy)
+std::vector<uint32_t>
+HnswIndex<type>::make_traversal_order() const
 {
-    auto compacting_buffers = _graph.levels_store.start_compact_worst_buffers(compaction_strategy);
-    uint32_t nodeid_limit = _graph.nodes.size();
-    auto filter = compacting_buffers->make_entry_ref_filter();
-    std::span<NodeType> nodes(&_graph.nodes[0], nodeid_limit);
-    for (auto& node : nodes) {
-        auto levels_ref = node.levels_ref().load_relaxed();
-        if (levels_ref.valid() && filter.has(levels_ref)) {
-            EntryRef new_levels_ref = _graph.levels_store.move_on_compact(levels_ref);
-            node.levels_ref().store_release(new_levels_ref);
+    uint32_t nodeid_limit = _graph.size();
+    std::vector<uint32_t> result;
+    result.reserve(nodeid_limit);
+    std::vector<bool> visited(nodeid_limit, false);
+    auto visit_from = [&](uint32_t start_nodeid) {
+        // result is used as the queue of the breadth first search
+        size_t next = result.size();
+        visited[start_nodeid] = true;
+        result.push_back(start_nodeid);
+        while (next < result.size()) {
+            for (uint32_t neighbor_nodeid : _graph.get_link_array(result[next++], 0)) {
+                if (neighbor_nodeid < nodeid_limit && !visited[neighbor_nodeid] && _graph.get_levels_ref(neighbor_nodeid).valid()) {
+                    visited[neighbor_nodeid] = true;
+                    result.push_back(neighbor_nodeid);
+                }
+            }
+        }
+    };
+    auto entry = _graph.get_entry_node();
+    if (entry.levels_ref.valid() && entry.nodeid < nodeid_limit) {
+        visit_from(entry.nodeid);
+    }
+    for (uint32_t nodeid = 1; nodeid < nodeid_limit; ++nodeid) {
+        if (!visited[nodeid] && _graph.get_levels_ref(nodeid).valid()) {
+            visit_from(nodeid);
         }
     }
-    compacting_buffers->finish();
+    return result;
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::compact_level_arrays(const CompactionStrategy& compaction_strategy)
+{
+    start_compact_level_arrays(compaction_strategy);
+    compact_step(std::numeric_limits<uint32_t>::max());
 }
 
 template <HnswIndexType type>
 void
 HnswIndex<type>::compact_link_arrays(const CompactionStrategy& compaction_strategy)
 {
-    auto context = _graph.links_store.compact_worst(compaction_strategy);
-    uint32_t nodeid_limit = _graph.nodes.size();
-    for (uint32_t nodeid = 1; nodeid < nodeid_limit; ++nodeid) {
-        EntryRef levels_ref = _graph.get_levels_ref(nodeid);
-        if (levels_ref.valid()) {
+    start_compact_link_arrays(compaction_strategy);
+    compact_step(std::numeric_limits<uint32_t>::max());
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::start_compact_level_arrays(const CompactionStrategy& compaction_strategy)
+{
+    assert(!is_compacting());
+    _compacting_levels = _graph.levels_store.start_compact_worst_buffers(compaction_strategy);
+    _compacting_levels_filter = std::make_unique<vespalib::datastore::EntryRefFilter>(_compacting_levels->make_entry_ref_filter());
+    _compaction_order = make_traversal_order();
+    _compaction_pos.store(0, std::memory_order_relaxed);
+    _compaction_nodes.store(_compaction_order.size(), std::memory_order_relaxed);
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::start_compact_link_arrays(const CompactionStrategy& compaction_strategy)
+{
+    assert(!is_compacting());
+    _compacting_links = _graph.links_store.compact_worst(compaction_strategy);
+    _compaction_order = make_traversal_order();
+    _compaction_pos.store(0, std::memory_order_relaxed);
+    _compaction_nodes.store(_compaction_order.size(), std::memory_order_relaxed);
+}
+
+template <HnswIndexType type>
+bool
+HnswIndex<type>::compact_step(uint32_t max_nodes)
+{
+    if (!is_compacting()) {
+        return false;
+    }
+    // Nodes removed since compaction started have invalid levels refs, and nodes added
+    // since then have their arrays allocated outside the buffers being compacted.
+    uint32_t pos = _compaction_pos.load(std::memory_order_relaxed);
+    uint32_t end = pos + std::min(max_nodes, static_cast<uint32_t>(_compaction_order.size()) - pos);
+    uint32_t nodeid_limit = _graph.size();
+    for (; pos < end; ++pos) {
+        uint32_t nodeid = _compaction_order[pos];
+        if (nodeid >= nodeid_limit) {
+            continue;
+        }
+        auto& node = _graph.nodes[nodeid];
+        auto levels_ref = node.levels_ref().load_relaxed();
+        if (!levels_ref.valid()) {
+            continue;
+        }
+        if (_compacting_levels) {
+            if (_compacting_levels_filter->has(levels_ref)) {
+                EntryRef new_levels_ref = _graph.levels_store.move_on_compact(levels_ref);
+                node.levels_ref().store_release(new_levels_ref);
+            }
+        } else {
             std::span<AtomicEntryRef> refs(_graph.levels_store.get_writable(levels_ref));
-            context->compact(refs);
+            _compacting_links->compact(refs);
         }
     }
+    _compaction_pos.store(pos, std::memory_order_relaxed);
+    if (pos < _compaction_order.size()) {
+        return true;
+    }
+    if (_compacting_levels) {
+        _compacting_levels->finish();
+        _compacting_levels.reset();
+        _compacting_levels_filter.reset();
+    }
+    _compacting_links.reset();
+    std::vector<uint32_t>().swap(_compaction_order);
+    _compaction_pos.store(0, std::memory_order_relaxed);
+    _compaction_nodes.store(0, std::memory_order_relaxed);
+    return false;
+}
+
+template <HnswIndexType type>
+NearestNeighborIndex::CompactionProgress
+HnswIndex<type>::get_compaction_progress() const noexcept
+{
+    uint32_t total_nodes = _compaction_nodes.load(std::memory_order_relaxed);
+    return { total_nodes != 0, _compaction_pos.load(std::memory_order_relaxed), total_nodes };
 }
 
 template <HnswIndexType type>
@@ -900,12 +1319,16 @@ bool
 HnswIndex<type>::consider_compact(const CompactionStrategy& compaction_strategy)
 {
     bool result = false;
-    if (_graph.levels_store.consider_compact()) {
-        compact_level_arrays(compaction_strategy);
+    if (is_compacting()) {
+        compact_step(_compaction_step_nodes);
         result = true;
-    }
-    if (_graph.links_store.consider_compact()) {
-        compact_link_arrays(compaction_strategy);
+    } else if (_graph.levels_store.consider_compact()) {
+        start_compact_level_arrays(compaction_strategy);
+        compact_step(_compaction_step_nodes);
+        result = true;
+    } else if (_graph.links_store.consider_compact()) {
+        start_compact_link_arrays(compaction_strategy);
+        compact_step(_compaction_step_nodes);
         result = true;
     }
     if (_id_mapping.consider_compact()) {
@@ -924,6 +1347,7 @@ HnswIndex<type>::update_stat(const CompactionStrategy& compaction_strategy)
     result.merge(_graph.levels_store.update_stat(compaction_strategy));
     result.merge(_graph.links_store.update_stat(compaction_strategy));
     result.merge(_id_mapping.update_stat(compaction_strategy));
+    result.merge(_quantized_vectors.memory_usage());
     return result;
 }
 
@@ -936,6 +1360,7 @@ HnswIndex<type>::memory_usage() const
     result.merge(_graph.levels_store.getMemoryUsage());
     result.merge(_graph.links_store.getMemoryUsage());
     result.merge(_id_mapping.memory_usage());
+    result.merge(_quantized_vectors.memory_usage());
     return result;
 }
 
@@ -969,6 +1394,7 @@ HnswIndex<type>::shrink_lid_space(uint32_t doc_id_limit)
             return;
         }
         _graph.nodes.shrink(doc_id_limit);
+        _quantized_vectors.shrink(doc_id_limit);
     }
 }
 
@@ -988,7 +1414,11 @@ HnswIndex<type>::make_loader(FastOS_FileInterface& file, const vespalib::Generic
     load_mips_max_distance(header, distance_function_factory());
     using ReaderType = FileReader<uint32_t>;
     using LoaderType = HnswIndexLoader<ReaderType, type>;
-    return std::make_unique<LoaderType>(_graph, _id_mapping, std::make_unique<ReaderType>(&file));
+    auto loader = std::make_unique<LoaderType>(_graph, _id_mapping, std::make_unique<ReaderType>(&file));
+    if (_quantized_vectors.enabled()) {
+        return std::make_unique<QuantizingIndexLoader>(std::move(loader), [this]() { quantize_all_nodes(); });
+    }
+    return loader;
 }
 
 struct NeighborsByDocId {
@@ -1002,9 +1432,14 @@ struct NeighborsByDocId {
 template <HnswIndexType type>
 std::vector<NearestNeighborIndex::Neighbor>
 HnswIndex<type>::top_k_by_docid(uint32_t k, const BoundDistanceFunction &df, const GlobalFilter *filter, bool low_hit_ratio, double exploration,
-                                uint32_t explore_k, double exploration_slack, const vespalib::Doom& doom, double distance_threshold) const
+                                uint32_t explore_k, double exploration_slack, const vespalib::Doom& doom, double distance_threshold,
+                                SearchStats* stats) const
 {
-    SearchBestNeighbors candidates = top_k_candidates(df, std::max(k, explore_k), exploration_slack, filter, low_hit_ratio, exploration, doom);
+    auto quantized_df = _quantized_vectors.enabled() ? dynamic_cast<const QuantizedBoundDistanceFunction*>(&df) : nullptr;
+    SearchBestNeighbors candidates = (quantized_df != nullptr)
+        ? rerank_candidates(df, top_k_candidates(quantized_df->traversal(), std::max(k, explore_k), exploration_slack, filter,
+                                                 low_hit_ratio, exploration, doom, true, stats), stats)
+        : top_k_candidates(df, std::max(k, explore_k), exploration_slack, filter, low_hit_ratio, exploration, doom, false, stats);
     auto result = candidates.get_neighbors(k, distance_threshold);
     std::sort(result.begin(), result.end(), NeighborsByDocId());
     return result;
@@ -1013,23 +1448,35 @@ HnswIndex<type>::top_k_by_docid(uint32_t k, const BoundDistanceFunction &df, con
 template <HnswIndexType type>
 std::vector<NearestNeighborIndex::Neighbor>
 HnswIndex<type>::find_top_k(uint32_t k, const BoundDistanceFunction &df, uint32_t explore_k, double exploration_slack,
-                            const vespalib::Doom& doom, double distance_threshold) const
+                            const vespalib::Doom& doom, double distance_threshold, SearchStats* stats) const
 {
-    return top_k_by_docid(k, df, nullptr, false, 0.0, explore_k, exploration_slack, doom, distance_threshold);
+    return top_k_by_docid(k, df, nullptr, false, 0.0, explore_k, exploration_slack, doom, distance_threshold, stats);
 }
 
 template <HnswIndexType type>
 std::vector<NearestNeighborIndex::Neighbor>
 HnswIndex<type>::find_top_k_with_filter(uint32_t k, const BoundDistanceFunction &df, const GlobalFilter &filter, bool low_hit_ratio, double exploration,
-                                        uint32_t explore_k, double exploration_slack, const vespalib::Doom& doom, double distance_threshold) const
+                                        uint32_t explore_k, double exploration_slack, const vespalib::Doom& doom, double distance_threshold,
+                                        SearchStats* stats) const
 {
-    return top_k_by_docid(k, df, &filter, low_hit_ratio, exploration, explore_k, exploration_slack, doom, distance_threshold);
+    return top_k_by_docid(k, df, &filter, low_hit_ratio, exploration, explore_k, exploration_slack, doom, distance_threshold, stats);
 }
 
 template <HnswIndexType type>
 typename HnswIndex<type>::SearchBestNeighbors
-HnswIndex<type>::top_k_candidates(const BoundDistanceFunction &df, uint32_t k, double exploration_slack, const GlobalFilter *filter, bool low_hit_ratio, double exploration, const vespalib::Doom& doom) const
+HnswIndex<type>::top_k_candidates(const BoundDistanceFunction &df, uint32_t k, double exploration_slack, const GlobalFilter *filter, bool low_hit_ratio, double exploration,
+                                  const vespalib::Doom& doom, bool quantized, SearchStats* stats) const
 {
+    if constexpr (NodeType::identity_mapping) {
+        // A sparse filter lists its documents. Calculating the distance to all of them is cheaper
+        // than a traversal that is expected to visit more nodes, most of them filtered away.
+        if (filter && filter->is_active() && (filter->representation() == GlobalFilter::Representation::SPARSE)) {
+            uint32_t nodeid_limit = _graph.nodes_size.load(std::memory_order_acquire);
+            if (filter->count() <= estimate_visited_nodes(0, nodeid_limit, k, filter)) {
+                return exact_candidates(df, k, filter->sparse_docids(), doom, quantized, stats);
+            }
+        }
+    }
     SearchBestNeighbors best_neighbors;
     auto entry = _graph.get_entry_node();
     if (entry.nodeid == 0) {
@@ -1037,23 +1484,112 @@ HnswIndex<type>::top_k_candidates(const BoundDistanceFunction &df, uint32_t k, d
         return best_neighbors;
     }
     int search_level = entry.level;
-    double entry_dist = calc_distance(df, entry.nodeid);
+    double entry_dist = quantized ? df.calc(_quantized_vectors.get(entry.nodeid)) : calc_distance(df, entry.nodeid);
+    if (stats != nullptr) {
+        // the entry node is counted as visited when searching the layers
+        ++stats->distance_computations;
+    }
     uint32_t entry_docid = get_docid(entry.nodeid);
     // TODO: check if entry docid/levels_ref is still valid here
     HnswCandidate entry_point(entry.nodeid, entry_docid, entry.levels_ref, entry_dist);
     while (search_level > 0) {
-        entry_point = find_nearest_in_layer(df, entry_point, search_level);
+        entry_point = find_nearest_in_layer(df, entry_point, search_level, quantized, stats);
         --search_level;
     }
     best_neighbors.push(entry_point);
-    if (filter && filter->is_active() && low_hit_ratio) {
-        search_layer_filter_first(df, k, exploration_slack, best_neighbors, exploration, 0, &doom, filter);
+    // Exploring beyond filtered away neighbors does not pay off when almost all documents pass the filter
+    if (filter && filter->is_active() && low_hit_ratio
+        && (filter->representation() != GlobalFilter::Representation::INVERTED)) {
+        search_layer_filter_first(df, k, exploration_slack, best_neighbors, exploration, 0, &doom, filter, quantized, stats);
     } else {
-        search_layer(df, k, exploration_slack, best_neighbors, 0, &doom, filter);
+        search_layer(df, k, exploration_slack, best_neighbors, 0, &doom, filter, quantized, stats);
     }
     return best_neighbors;
 }
 
+template <HnswIndexType type>
+typename HnswIndex<type>::SearchBestNeighbors
+HnswIndex<type>::exact_candidates(const BoundDistanceFunction &df, uint32_t k, std::span<const uint32_t> docids,
+                                  const vespalib::Doom& doom, bool quantized, SearchStats* stats) const
+{
+    SearchBestNeighbors best_neighbors;
+    uint32_t nodeid_limit = _graph.nodes_size.load(std::memory_order_acquire);
+    uint32_t distance_computations = 0;
+    for (uint32_t docid : docids) {
+        if (docid >= nodeid_limit) {
+            break;
+        }
+        auto levels_ref = _graph.acquire_node(docid).levels_ref().load_acquire();
+        if (!levels_ref.valid()) {
+            continue;
+        }
+        auto vector = get_traversal_vector(quantized, docid, docid, 0);
+        if (vector.non_existing_attribute_value()) [[unlikely]] {
+            continue;
+        }
+        ++distance_computations;
+        double dist = calc_distance_helper(df, vector);
+        if ((best_neighbors.size() < k) || (!best_neighbors.empty() && dist < best_neighbors.top().distance)) {
+            best_neighbors.emplace(docid, docid, levels_ref, dist);
+            if (best_neighbors.size() > k) {
+                best_neighbors.pop();
+            }
+        }
+        if (((distance_computations % 1024) == 0) && doom.soft_doom()) {
+            break;
+        }
+    }
+    if (stats != nullptr) {
+        stats->visited_nodes += distance_computations;
+        stats->distance_computations += distance_computations;
+    }
+    return best_neighbors;
+}
+
+template <HnswIndexType type>
+typename HnswIndex<type>::SearchBestNeighbors
+HnswIndex<type>::rerank_candidates(const BoundDistanceFunction &df, const SearchBestNeighbors& candidates, SearchStats* stats) const
+{
+    if (stats != nullptr) {
+        stats->distance_computations += candidates.size();
+    }
+    // With quantized traversal the full precision vectors are only read here, and
+    // they might not be kept in memory. All reads are started before the first distance is calculated.
+    for (const auto& candidate : candidates.peek()) {
+        prefetch_vector(candidate.nodeid);
+    }
+    TraversalNeighbors neighbors;
+    neighbors.reserve(candidates.size());
+    for (const auto& candidate : candidates.peek()) {
+        auto vector = get_vector(candidate.nodeid);
+        if (!vector.non_existing_attribute_value()) [[likely]] {
+            if (stats != nullptr) {
+                stats->visited_bytes += vector_mem_size(vector);
+            }
+            neighbors.add(candidate.nodeid, candidate.docid, candidate.levels_ref, vector);
+        }
+    }
+    neighbors.calc_distances(df);
+    SearchBestNeighbors result;
+    for (size_t i = 0; i < neighbors.size(); ++i) {
+        const auto& neighbor = neighbors[i];
+        result.emplace(neighbor.nodeid, neighbor.docid, neighbor.levels_ref, neighbors.distance(i));
+    }
+    return result;
+}
+
+template <HnswIndexType type>
+void
+HnswIndex<type>::quantize_all_nodes()
+{
+    uint32_t nodeid_limit = _graph.size();
+    for (uint32_t nodeid = 1; nodeid < nodeid_limit; ++nodeid) {
+        if (_graph.get_levels_ref(nodeid).valid()) {
+            _quantized_vectors.set(nodeid, get_vector(nodeid));
+        }
+    }
+}
+
 template <HnswIndexType type>
 HnswTestNode
 HnswIndex<type>::get_node(uint32_t nodeid) const
@@ -1079,6 +1615,9 @@ HnswIndex<type>::set_node(uint32_t nodeid, const HnswTestNode &node)
 {
     size_t num_levels = node.size();
     assert(num_levels > 0);
+    if (_quantized_vectors.enabled()) {
+        _quantized_vectors.set(nodeid, get_vector(nodeid, 0));
+    }
     auto levels_ref = _graph.make_node(nodeid, nodeid, 0, num_levels);
     for (size_t level = 0; level < num_levels; ++level) {
         connect_new_node(nodeid, node.level(level), level);
@@ -9,6 +9,7 @@
 #include "hnsw_index_utils.h"
 #include "hnsw_multi_best_neighbors.h"
 #include "hnsw_nodeid_mapping.h"
+#include "hnsw_quantized_vectors.h"
 #include "hnsw_single_best_neighbors.h"
 #include "hnsw_test_node.h"
 #include "nearest_neighbor_index.h"
@@ -20,9 +21,14 @@
 #include <vespa/searchlib/queryeval/global_filter.h>
 #include <vespa/vespalib/datastore/array_store.h>
 #include <vespa/vespalib/datastore/atomic_entry_ref.h>
+#include <vespa/vespalib/datastore/compacting_buffers.h>
 #include <vespa/vespalib/datastore/compaction_spec.h>
+#include <vespa/vespalib/datastore/entry_ref_filter.h>
+#include <vespa/vespalib/datastore/i_compaction_context.h>
 #include <vespa/vespalib/datastore/entryref.h>
 #include <vespa/vespalib/stllike/allocator.h>
+#include <atomic>
+#include <mutex>
 
 namespace search::tensor {
 
@@ -38,9 +44,15 @@ namespace search::tensor {
  * but some adjustments are made to support proper removes.
  *
  * TODO: Add details on how to handle removes.
+ *
+ * When building the graph for many documents at once, e.g. when the index is rebuilt on load,
+ * add_documents_in_parallel() lets multiple writer threads add documents concurrently.
+ * The link arrays are then guarded by striped node mutexes, see internal::BulkBuildLocks.
  */
 
 namespace internal {
+struct BulkBuildLocks;
+
 struct PreparedAddNode {
     using Links = std::vector<std::pair<uint32_t, vespalib::datastore::EntryRef>>;
     std::vector<Links> connections;
@@ -151,18 +163,42 @@ protected:
     // Chosen value is based on class comment for InvLogLevelGenerator.
     static constexpr uint32_t max_max_level = 29;
 
+    // Max number of nodes visited per call to consider_compact() when compacting level or link arrays.
+    static constexpr uint32_t default_compaction_step_nodes = 100000;
+
     GraphType _graph;
     const DocVectorAccess& _vectors;
     std::unique_ptr<DistanceFunctionFactory> _distance_ff;
     RandomLevelGenerator::UP _level_generator;
     IdMapping _id_mapping; // mapping from docid to nodeid vector
     HnswIndexConfig _cfg;
+    HnswQuantizedVectors _quantized_vectors; // only used for graph traversal at query time
+    std::unique_ptr<internal::BulkBuildLocks> _bulk_build_locks; // only set by add_documents_in_parallel()
+    std::atomic<uint32_t> _bulk_build_threads;
+    std::atomic<uint64_t> _bulk_build_added_docs;
+    // State for incremental compaction of level or link arrays, only one of them is compacted at a time.
+    std::unique_ptr<vespalib::datastore::CompactingBuffers> _compacting_levels;
+    std::unique_ptr<vespalib::datastore::EntryRefFilter> _compacting_levels_filter;
+    vespalib::datastore::ICompactionContext::UP _compacting_links;
+    std::vector<uint32_t> _compaction_order;
+    uint32_t _compaction_step_nodes;
+    std::atomic<uint32_t> _compaction_pos;
+    std::atomic<uint32_t> _compaction_nodes;
+
+    // The locks are only taken while documents are added in parallel.
+    std::unique_lock<std::mutex> lock_node(uint32_t nodeid) const;
+    std::unique_lock<std::mutex> lock_graph_stores() const;
+    std::unique_lock<std::mutex> lock_level_generator() const;
+    void set_link_array(uint32_t nodeid, uint32_t level, const LinkArrayRef& new_links) {
+        auto guard = lock_graph_stores();
+        _graph.set_link_array(nodeid, level, new_links);
+    }
 
     uint32_t max_links_for_level(uint32_t level) const;
     void add_link_to(uint32_t nodeid, uint32_t level, const LinkArrayRef& old_links, uint32_t new_link) {
         LinkArray new_links(old_links.begin(), old_links.end());
         new_links.push_back(new_link);
-        _graph.set_link_array(nodeid, level, new_links);
+        set_link_array(nodeid, level, new_links);
     }
 
     /**
@@ -183,6 +219,7 @@ protected:
     void connect_new_node(uint32_t nodeid, const LinkArrayRef &neighbors, uint32_t level);
     void mutual_reconnect(const LinkArrayRef &cluster, uint32_t level);
     void remove_link_to(uint32_t remove_from, uint32_t remove_id, uint32_t level);
+    bool is_linked_to(uint32_t nodeid, uint32_t link, uint32_t level) const;
 
     TypedCells get_vector(uint32_t nodeid) const {
         if constexpr (NodeType::identity_mapping) {
@@ -200,38 +237,63 @@ protected:
     VectorBundle get_vectors(uint32_t docid) const {
         return _vectors.get_vectors(docid);
     }
+    void prefetch_vector(uint32_t nodeid) const {
+        if constexpr (NodeType::identity_mapping) {
+            _vectors.prefetch_vector(nodeid, 0);
+        } else {
+            auto& ref = _graph.nodes.acquire_elem_ref(nodeid);
+            _vectors.prefetch_vector(ref.acquire_docid(), ref.acquire_subspace());
+        }
+    }
 
     double calc_distance(const BoundDistanceFunction &df, uint32_t rhs_nodeid) const;
     double calc_distance(const BoundDistanceFunction &df, uint32_t rhs_docid, uint32_t rhs_subspace) const;
+    TypedCells get_traversal_vector(bool quantized, uint32_t nodeid, uint32_t docid, uint32_t subspace) const {
+        return quantized ? _quantized_vectors.get(nodeid) : get_vector(docid, subspace);
+    }
     uint32_t estimate_visited_nodes(uint32_t level, uint32_t nodeid_limit, uint32_t neighbors_to_find, const GlobalFilter* filter) const;
 
     /**
      * Performs a greedy search in the given layer to find the candidate that is nearest the input vector.
      */
-    HnswCandidate find_nearest_in_layer(const BoundDistanceFunction &df, const HnswCandidate& entry_point, uint32_t level) const __attribute__((noinline));
+    HnswCandidate find_nearest_in_layer(const BoundDistanceFunction &df, const HnswCandidate& entry_point, uint32_t level,
+                                        bool quantized = false, SearchStats* stats = nullptr) const __attribute__((noinline));
     template <class VisitedTracker, class BestNeighbors>
     void search_layer_helper(const BoundDistanceFunction &df, uint32_t neighbors_to_find, double exploration_slack, BestNeighbors& best_neighbors,
                              uint32_t level, const GlobalFilter *filter, uint32_t nodeid_limit,
-                             const vespalib::Doom* const doom, uint32_t estimated_visited_nodes) const __attribute__((noinline));
+                             const vespalib::Doom* const doom, uint32_t estimated_visited_nodes, bool quantized,
+                             SearchStats* stats) const __attribute__((noinline));
     template <class VisitedTracker, class BestNeighbors>
     void search_layer_filter_first_helper(const BoundDistanceFunction &df, uint32_t neighbors_to_find, double exploration_slack, BestNeighbors& best_neighbors,
                                           double exploration, uint32_t level, const GlobalFilter *filter, uint32_t nodeid_limit,
-                                          const vespalib::Doom* const doom, uint32_t estimated_visited_nodes) const __attribute__((noinline));
+                                          const vespalib::Doom* const doom, uint32_t estimated_visited_nodes, bool quantized,
+                                          SearchStats* stats) const __attribute__((noinline));
     template <class VisitedTracker>
     void exploreNeighborhood(HnswTraversalCandidate &cand, std::deque<uint32_t> &found, VisitedTracker &visited, double exploration, uint32_t level,
-                             const internal::GlobalFilterWrapper<type>& filter_wrapper, uint32_t nodeid_limit) const;
+                             const internal::GlobalFilterWrapper<type>& filter_wrapper, uint32_t nodeid_limit,
+                             uint64_t& visited_bytes) const;
     template <class VisitedTracker>
     void exploreNeighborhoodByOneHop(std::deque<uint32_t> &todo, std::deque<uint32_t> &found, VisitedTracker &visited, uint32_t level,
                                      const internal::GlobalFilterWrapper<type>& filter_wrapper, uint32_t nodeid_limit,
-                                     uint32_t max_neighbors_to_find) const;
+                                     uint32_t max_neighbors_to_find, uint64_t& visited_bytes) const;
     template <class BestNeighbors>
     void search_layer(const BoundDistanceFunction &df, uint32_t neighbors_to_find, double exploration_slack, BestNeighbors& best_neighbors,
-                      uint32_t level, const vespalib::Doom* const doom, const GlobalFilter *filter = nullptr) const;
+                      uint32_t level, const vespalib::Doom* const doom, const GlobalFilter *filter = nullptr, bool quantized = false,
+                      SearchStats* stats = nullptr) const;
     template <class BestNeighbors>
     void search_layer_filter_first(const BoundDistanceFunction &df, uint32_t neighbors_to_find, double exploration_slack, BestNeighbors& best_neighbors, double exploration,
-                                   uint32_t level, const vespalib::Doom* const doom, const GlobalFilter *filter = nullptr) const;
+                                   uint32_t level, const vespalib::Doom* const doom, const GlobalFilter *filter = nullptr, bool quantized = false,
+                                   SearchStats* stats = nullptr) const;
+    SearchBestNeighbors rerank_candidates(const BoundDistanceFunction &df, const SearchBestNeighbors& candidates, SearchStats* stats) const;
+    /**
+     * Calculates the distance to each of the given documents, keeping the k best.
+     * Only used with a single node per document, where nodeid == docid.
+     */
+    SearchBestNeighbors exact_candidates(const BoundDistanceFunction &df, uint32_t k, std::span<const uint32_t> docids,
+                                         const vespalib::Doom& doom, bool quantized, SearchStats* stats) const;
     std::vector<Neighbor> top_k_by_docid(uint32_t k, const BoundDistanceFunction &df, const GlobalFilter *filter, bool low_hit_ratio, double exploration,
-                                         uint32_t explore_k, double exploration_slack, const vespalib::Doom& doom, double distance_threshold) const;
+                                         uint32_t explore_k, double exploration_slack, const vespalib::Doom& doom, double distance_threshold,
+                                         SearchStats* stats) const;
 
     internal::PreparedAddDoc internal_prepare_add(uint32_t docid, VectorBundle input_vectors,
                                                   vespalib::GenerationHandler::Guard read_guard) const;
@@ -239,9 +301,11 @@ protected:
     LinkArray filter_valid_nodeids(uint32_t level, const internal::PreparedAddNode::Links &neighbors, uint32_t self_nodeid);
     void internal_complete_add(uint32_t docid, internal::PreparedAddDoc &op);
     void internal_complete_add_node(uint32_t nodeid, uint32_t docid, uint32_t subspace, internal::PreparedAddNode &prepared_node);
+    void internal_add(uint32_t docid, VectorBundle input_vectors, std::span<const uint32_t> nodeids);
 
     // Called from writer only.
     uint32_t get_subspaces(uint32_t docid) const noexcept;
+    void quantize_all_nodes();
 public:
     HnswIndex(const DocVectorAccess& vectors, DistanceFunctionFactory::UP distance_ff,
               RandomLevelGenerator::UP level_generator, const HnswIndexConfig& cfg);
@@ -254,12 +318,34 @@ public:
     std::unique_ptr<PrepareResult> prepare_add_document(uint32_t docid, VectorBundle vectors,
                                                         vespalib::GenerationHandler::Guard read_guard) const override;
     void complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result) override;
+    bool can_add_documents_in_parallel() const noexcept override { return true; }
+    void add_documents_in_parallel(std::span<const uint32_t> docids, vespalib::Executor& executor, uint32_t num_threads) override;
     void remove_node(uint32_t nodeid);
     void remove_document(uint32_t docid) override;
     void assign_generation(generation_t current_gen) override;
     void reclaim_memory(generation_t oldest_used_gen) override;
+    /**
+     * Returns the nodeids of all nodes in the graph in breadth first order on level 0,
+     * starting at the entry node. Nodes not reachable from the entry node are added last.
+     *
+     * Compaction moves level and link arrays in this order, placing the arrays of
+     * nodes close to each other in the graph close to each other in memory.
+     */
+    std::vector<uint32_t> make_traversal_order() const;
     void compact_level_arrays(const CompactionStrategy& compaction_strategy);
     void compact_link_arrays(const CompactionStrategy& compaction_strategy);
+    /**
+     * Incremental compaction. The arrays of the worst buffers are moved in traversal order,
+     * at most max_nodes nodes per call to compact_step(). The compacted buffers are put on hold
+     * when all nodes have been visited. Used by consider_compact() to bound the time spent
+     * compacting the graph per commit. Returns true if more steps are needed.
+     */
+    void start_compact_level_arrays(const CompactionStrategy& compaction_strategy);
+    void start_compact_link_arrays(const CompactionStrategy& compaction_strategy);
+    bool compact_step(uint32_t max_nodes);
+    bool is_compacting() const noexcept { return _compacting_levels || _compacting_links; }
+    void set_compaction_step_nodes(uint32_t value) noexcept { _compaction_step_nodes = value; }
+    CompactionProgress get_compaction_progress() const noexcept override;
     bool consider_compact(const CompactionStrategy& compaction_strategy) override;
     vespalib::MemoryUsage update_stat(const CompactionStrategy& compaction_strategy) override;
     vespalib::MemoryUsage memory_usage() const override;
@@ -271,20 +357,30 @@ public:
     std::unique_ptr<NearestNeighborIndexLoader> make_loader(FastOS_FileInterface& file, const vespalib::GenericHeader& header) override;
 
     std::vector<Neighbor> find_top_k(uint32_t k, const BoundDistanceFunction &df, uint32_t explore_k, double exploration_slack,
-                                     const vespalib::Doom& doom, double distance_threshold) const override;
+                                     const vespalib::Doom& doom, double distance_threshold, SearchStats* stats = nullptr) const override;
 
     std::vector<Neighbor> find_top_k_with_filter(uint32_t k, const BoundDistanceFunction &df, const GlobalFilter &filter, bool low_hit_ratio, double exploration,
-                                                 uint32_t explore_k, double exploration_slack, const vespalib::Doom& doom, double distance_threshold) const override;
+                                                 uint32_t explore_k, double exploration_slack, const vespalib::Doom& doom, double distance_threshold,
+                                                 SearchStats* stats = nullptr) const override;
 
     DistanceFunctionFactory &distance_function_factory() const override { return *_distance_ff; }
 
+    /**
+     * Searches the graph for the k best candidates. With quantized set, the
+     * distance function must be bound to a quantized query vector, and the
+     * quantized vectors are used instead of the full precision ones.
+     * Visited nodes and distance computations are counted in stats, if given.
+     */
     SearchBestNeighbors top_k_candidates(const BoundDistanceFunction &df, uint32_t k, double exploration_slack, const GlobalFilter *filter, bool low_hit_ratio, double exploration,
-                                         const vespalib::Doom& doom) const;
+                                         const vespalib::Doom& doom, bool quantized = false, SearchStats* stats = nullptr) const;
+    const HnswQuantizedVectors& get_quantized_vectors() const noexcept { return _quantized_vectors; }
 
     uint32_t get_entry_nodeid() const { return _graph.get_entry_node().nodeid; }
     int32_t get_entry_level() const { return _graph.get_entry_node().level; }
 
     uint32_t get_active_nodes() const noexcept { return _graph.get_active_nodes(); }
+    uint32_t get_bulk_build_threads() const noexcept { return _bulk_build_threads.load(std::memory_order_relaxed); }
+    uint64_t get_bulk_build_added_docs() const noexcept { return _bulk_build_added_docs.load(std::memory_order_relaxed); }
 
     // Called from writer only.
     uint32_t check_consistency(uint32_t docid_limit) const noexcept override;
@@ -63,6 +63,14 @@ HnswIndexExplorer<type>::get_state(const vespalib::slime::Inserter& inserter, bo
     auto entry_node = graph.get_entry_node();
     object.setLong("entry_nodeid", entry_node.nodeid);
     object.setLong("entry_level", entry_node.level);
+    auto& bulk_build_obj = object.setObject("bulk_build");
+    bulk_build_obj.setLong("active_threads", _index.get_bulk_build_threads());
+    bulk_build_obj.setLong("added_documents", _index.get_bulk_build_added_docs());
+    auto& compaction_obj = object.setObject("compaction");
+    auto progress = _index.get_compaction_progress();
+    compaction_obj.setBool("active", progress.active);
+    compaction_obj.setLong("compacted_nodes", progress.compacted_nodes);
+    compaction_obj.setLong("total_nodes", progress.total_nodes);
     auto& cfgObj = object.setObject("cfg");
     auto& cfg = _index.config();
     cfgObj.setLong("max_links_at_level_0", cfg.max_links_at_level_0());
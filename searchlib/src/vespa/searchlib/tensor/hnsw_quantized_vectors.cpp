@@ -0,0 +1,156 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hnsw_quantized_vectors.h"
+#include "temporary_vector_store.h"
+#include <vespa/vespalib/util/rcuvector.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using search::attribute::DistanceMetric;
+using vespalib::eval::CellType;
+
+namespace search::tensor {
+
+namespace {
+
+DistanceFunctionFactory::UP
+make_code_distance_function_factory(HnswQuantization quantization)
+{
+    switch (quantization) {
+    case HnswQuantization::INT8:
+        return make_distance_function_factory(DistanceMetric::Angular, CellType::INT8);
+    case HnswQuantization::BINARY:
+        return make_distance_function_factory(DistanceMetric::Hamming, CellType::INT8);
+    case HnswQuantization::NONE:
+        break;
+    }
+    return {};
+}
+
+}
+
+HnswQuantizedVectors::HnswQuantizedVectors(HnswQuantization quantization)
+    : _quantization(quantization),
+      _code_size(0),
+      _codes(),
+      _code_distance_ff(make_code_distance_function_factory(quantization))
+{
+}
+
+HnswQuantizedVectors::~HnswQuantizedVectors() = default;
+
+uint32_t
+HnswQuantizedVectors::code_size_for(uint32_t vector_size) const noexcept
+{
+    return (_quantization == HnswQuantization::BINARY) ? ((vector_size + 7) / 8) : vector_size;
+}
+
+void
+HnswQuantizedVectors::quantize(TypedCells vector, int8_t* dst) const
+{
+    TemporaryVectorStore<float> tmp(vector.size);
+    auto cells = tmp.storeLhs(vector);
+    if (_quantization == HnswQuantization::BINARY) {
+        std::fill(dst, dst + code_size_for(cells.size()), 0);
+        for (size_t i = 0; i < cells.size(); ++i) {
+            if (cells[i] > 0.0f) {
+                dst[i / 8] |= int8_t(0x80u >> (i % 8));
+            }
+        }
+    } else {
+        float max_abs = 0.0f;
+        for (float cell : cells) {
+            max_abs = std::max(max_abs, std::fabs(cell));
+        }
+        float scale = (max_abs > 0.0f) ? (127.0f / max_abs) : 0.0f;
+        for (size_t i = 0; i < cells.size(); ++i) {
+            dst[i] = int8_t(std::lround(cells[i] * scale));
+        }
+    }
+}
+
+void
+HnswQuantizedVectors::set(uint32_t nodeid, TypedCells vector)
+{
+    uint32_t code_size = _code_size.load(std::memory_order_relaxed);
+    if (code_size == 0) {
+        code_size = code_size_for(vector.size);
+        _code_size.store(code_size, std::memory_order_release);
+    }
+    assert(code_size == code_size_for(vector.size));
+    size_t offset = size_t(nodeid) * code_size;
+    _codes.ensure_size(offset + code_size);
+    quantize(vector, &_codes[offset]);
+}
+
+void
+HnswQuantizedVectors::shrink(uint32_t nodeid_limit)
+{
+    size_t wanted_size = size_t(nodeid_limit) * _code_size.load(std::memory_order_relaxed);
+    if (wanted_size < _codes.size()) {
+        _codes.shrink(wanted_size);
+    }
+}
+
+vespalib::eval::TypedCells
+HnswQuantizedVectors::get(uint32_t nodeid) const noexcept
+{
+    uint32_t code_size = _code_size.load(std::memory_order_acquire);
+    return {&_codes.acquire_elem_ref(size_t(nodeid) * code_size), CellType::INT8, code_size};
+}
+
+BoundDistanceFunction::UP
+HnswQuantizedVectors::for_query_vector(TypedCells query) const
+{
+    std::vector<int8_t> code(code_size_for(query.size));
+    quantize(query, code.data());
+    // The bound distance function keeps its own copy of the quantized query vector.
+    return _code_distance_ff->for_query_vector(TypedCells(code.data(), CellType::INT8, code.size()));
+}
+
+bool
+HnswQuantizedVectors::supports(DistanceMetric metric) noexcept
+{
+    switch (metric) {
+    case DistanceMetric::Angular:
+    case DistanceMetric::PrenormalizedAngular:
+    case DistanceMetric::InnerProduct:
+        return true;
+    default:
+        return false;
+    }
+}
+
+QuantizedBoundDistanceFunction::QuantizedBoundDistanceFunction(BoundDistanceFunction::UP full, BoundDistanceFunction::UP traversal) noexcept
+    : _full(std::move(full)),
+      _traversal(std::move(traversal))
+{
+}
+
+QuantizedBoundDistanceFunction::~QuantizedBoundDistanceFunction() = default;
+
+QuantizedDistanceFunctionFactory::QuantizedDistanceFunctionFactory(DistanceFunctionFactory::UP full,
+                                                                   const HnswQuantizedVectors& quantized_vectors) noexcept
+    : _full(std::move(full)),
+      _quantized_vectors(quantized_vectors)
+{
+}
+
+QuantizedDistanceFunctionFactory::~QuantizedDistanceFunctionFactory() = default;
+
+BoundDistanceFunction::UP
+QuantizedDistanceFunctionFactory::for_query_vector(TypedCells lhs) const
+{
+    return std::make_unique<QuantizedBoundDistanceFunction>(_full->for_query_vector(lhs),
+                                                            _quantized_vectors.for_query_vector(lhs));
+}
+
+BoundDistanceFunction::UP
+QuantizedDistanceFunctionFactory::for_insertion_vector(TypedCells lhs) const
+{
+    return _full->for_insertion_vector(lhs);
+}
+
+}
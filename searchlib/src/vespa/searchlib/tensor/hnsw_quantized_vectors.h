@@ -0,0 +1,104 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "bound_distance_function.h"
+#include "distance_function_factory.h"
+#include "hnsw_index_config.h"
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vespa/vespalib/util/memoryusage.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <atomic>
+
+namespace search::tensor {
+
+/**
+ * Compact quantized copy of the vectors in a hnsw index, stored per nodeid.
+ *
+ * The quantized vectors are used instead of the full precision vectors when
+ * traversing the graph at query time, reducing the memory bandwidth needed
+ * per visited node. The candidates found are then reranked using the full
+ * precision vectors.
+ *
+ * With INT8 quantization each vector is scaled so its largest cell maps to 127,
+ * and angular distance is used between the quantized vectors (4x smaller than float).
+ * With BINARY quantization only the sign of each cell is kept, and hamming distance
+ * is used between the packed bit vectors (32x smaller than float).
+ * Both are only meaningful for distance metrics based on the angle between vectors.
+ *
+ * Supports 1 write thread and multiple search threads, in the same way as HnswGraph:
+ * the quantized vector for a node is set before the node is linked into the graph.
+ */
+class HnswQuantizedVectors {
+public:
+    using TypedCells = vespalib::eval::TypedCells;
+    using generation_t = vespalib::GenerationHandler::generation_t;
+private:
+    HnswQuantization            _quantization;
+    std::atomic<uint32_t>       _code_size;
+    vespalib::RcuVector<int8_t> _codes;
+    DistanceFunctionFactory::UP _code_distance_ff;
+
+    uint32_t code_size_for(uint32_t vector_size) const noexcept;
+    void quantize(TypedCells vector, int8_t* dst) const;
+public:
+    explicit HnswQuantizedVectors(HnswQuantization quantization);
+    ~HnswQuantizedVectors();
+
+    bool enabled() const noexcept { return _quantization != HnswQuantization::NONE; }
+    HnswQuantization quantization() const noexcept { return _quantization; }
+
+    // Called from writer only.
+    void set(uint32_t nodeid, TypedCells vector);
+    void shrink(uint32_t nodeid_limit);
+
+    TypedCells get(uint32_t nodeid) const noexcept;
+    BoundDistanceFunction::UP for_query_vector(TypedCells query) const;
+
+    void assign_generation(generation_t current_gen) { _codes.setGeneration(current_gen + 1); }
+    void reclaim_memory(generation_t oldest_used_gen) { _codes.reclaim_memory(oldest_used_gen); }
+    vespalib::MemoryUsage memory_usage() const { return _codes.getMemoryUsage(); }
+
+    static bool supports(search::attribute::DistanceMetric metric) noexcept;
+};
+
+/**
+ * Distance function bound to a query vector, combining the full precision
+ * distance function with one bound to the quantized query vector.
+ * All calculations are delegated to the full precision distance function;
+ * the quantized one is used by the hnsw index for graph traversal.
+ */
+class QuantizedBoundDistanceFunction final : public BoundDistanceFunction {
+    BoundDistanceFunction::UP _full;
+    BoundDistanceFunction::UP _traversal;
+public:
+    QuantizedBoundDistanceFunction(BoundDistanceFunction::UP full, BoundDistanceFunction::UP traversal) noexcept;
+    ~QuantizedBoundDistanceFunction() override;
+    const BoundDistanceFunction& traversal() const noexcept { return *_traversal; }
+    double calc(TypedCells rhs) const noexcept override { return _full->calc(rhs); }
+    double calc_with_limit(TypedCells rhs, double limit) const noexcept override { return _full->calc_with_limit(rhs, limit); }
+    void calc_batch(std::span<const TypedCells> rhs, std::span<double> distances) const noexcept override {
+        _full->calc_batch(rhs, distances);
+    }
+    double convert_threshold(double threshold) const noexcept override { return _full->convert_threshold(threshold); }
+    double to_rawscore(double distance) const noexcept override { return _full->to_rawscore(distance); }
+    double to_distance(double rawscore) const noexcept override { return _full->to_distance(rawscore); }
+    double min_rawscore() const noexcept override { return _full->min_rawscore(); }
+};
+
+/**
+ * Distance function factory used by a hnsw index with quantized vectors.
+ * Query vectors are bound both in full precision and quantized, while
+ * insertion vectors (used when building the graph) are bound in full precision only.
+ */
+class QuantizedDistanceFunctionFactory final : public DistanceFunctionFactory {
+    DistanceFunctionFactory::UP _full;
+    const HnswQuantizedVectors& _quantized_vectors;
+public:
+    QuantizedDistanceFunctionFactory(DistanceFunctionFactory::UP full, const HnswQuantizedVectors& quantized_vectors) noexcept;
+    ~QuantizedDistanceFunctionFactory() override;
+    BoundDistanceFunction::UP for_query_vector(TypedCells lhs) const override;
+    BoundDistanceFunction::UP for_insertion_vector(TypedCells lhs) const override;
+};
+
+}
@@ -0,0 +1,826 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "ivf_pq_index.h"
+#include "doc_vector_access.h"
+#include "ivf_pq_index_explorer.h"
+#include "nearest_neighbor_index_loader.h"
+#include "nearest_neighbor_index_saver.h"
+#include "prepare_result.h"
+#include "temporary_vector_store.h"
+#include "vector_bundle.h"
+#include <vespa/searchlib/attribute/address_space_components.h>
+#include <vespa/searchlib/attribute/address_space_usage.h>
+#include <vespa/searchlib/queryeval/global_filter.h>
+#include <vespa/vespalib/datastore/array_store.hpp>
+#include <vespa/vespalib/hwaccelerated/iaccelerated.h>
+#include <vespa/vespalib/util/doom.h>
+#include <vespa/vespalib/util/memory_allocator.h>
+#include <vespa/vespalib/util/rcuvector.hpp>
+#include <vespa/vespalib/util/size_literals.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+using search::attribute::DistanceMetric;
+using vespalib::datastore::CompactionStrategy;
+using vespalib::datastore::EntryRef;
+using vespalib::hwaccelerated::IAccelerated;
+
+namespace search::tensor {
+
+namespace {
+
+constexpr uint32_t kmeans_iterations = 10;
+constexpr size_t min_num_arrays_for_new_buffer = 512_Ki;
+constexpr float alloc_grow_factor = 0.3;
+
+uint32_t
+closest_centroid(const IAccelerated& computer, const float* vector, const float* centroids, uint32_t num_centroids, uint32_t size)
+{
+    uint32_t best = 0;
+    double best_distance = std::numeric_limits<double>::max();
+    for (uint32_t c = 0; c < num_centroids; ++c) {
+        double distance = computer.squaredEuclideanDistance(vector, centroids + size_t(c) * size, size);
+        if (distance < best_distance) {
+            best_distance = distance;
+            best = c;
+        }
+    }
+    return best;
+}
+
+/*
+ * Lloyd's algorithm with a fixed number of iterations, starting with
+ * evenly spaced training vectors as centroids.
+ */
+std::vector<float>
+train_kmeans(const IAccelerated& computer, const std::vector<float>& data, uint32_t size, uint32_t num_centroids)
+{
+    size_t num_vectors = data.size() / size;
+    assert(num_centroids > 0 && num_centroids <= num_vectors);
+    std::vector<float> centroids(size_t(num_centroids) * size);
+    for (uint32_t c = 0; c < num_centroids; ++c) {
+        size_t i = (c * num_vectors) / num_centroids;
+        std::copy_n(data.data() + i * size, size, centroids.data() + size_t(c) * size);
+    }
+    std::vector<double> sums(centroids.size());
+    std::vector<uint32_t> counts(num_centroids);
+    for (uint32_t iteration = 0; iteration < kmeans_iterations; ++iteration) {
+        std::fill(sums.begin(), sums.end(), 0.0);
+        std::fill(counts.begin(), counts.end(), 0);
+        for (size_t i = 0; i < num_vectors; ++i) {
+            const float* vector = data.data() + i * size;
+            uint32_t c = closest_centroid(computer, vector, centroids.data(), num_centroids, size);
+            ++counts[c];
+            for (uint32_t j = 0; j < size; ++j) {
+                sums[size_t(c) * size + j] += vector[j];
+            }
+        }
+        for (uint32_t c = 0; c < num_centroids; ++c) {
+            // An empty cluster keeps its previous centroid
+            if (counts[c] > 0) {
+                for (uint32_t j = 0; j < size; ++j) {
+                    centroids[size_t(c) * size + j] = sums[size_t(c) * size + j] / counts[c];
+                }
+            }
+        }
+    }
+    return centroids;
+}
+
+uint32_t
+select_num_subquantizers(uint32_t vector_size, uint32_t wanted)
+{
+    if (wanted == 0) {
+        wanted = std::max(1u, vector_size / 8);
+    }
+    wanted = std::min({wanted, vector_size, IvfPqIndex::max_subquantizers});
+    // Each subquantizer covers the same number of cells
+    while (vector_size % wanted != 0) {
+        --wanted;
+    }
+    return wanted;
+}
+
+struct NoFilter {
+    bool operator()(uint32_t) const noexcept { return true; }
+};
+
+struct GlobalFilterCheck {
+    const queryeval::GlobalFilter& filter;
+    uint32_t docid_limit;
+    explicit GlobalFilterCheck(const queryeval::GlobalFilter& filter_in) noexcept
+        : filter(filter_in),
+          docid_limit(filter_in.size())
+    {}
+    bool operator()(uint32_t docid) const noexcept { return docid < docid_limit && filter.check(docid); }
+};
+
+class PreparedAddDoc : public PrepareResult {
+public:
+    const IvfPqIndex::Clusters*          clusters;
+    uint32_t                             list;
+    std::vector<uint8_t>                 codes;
+    vespalib::GenerationHandler::Guard   read_guard;
+    explicit PreparedAddDoc(vespalib::GenerationHandler::Guard read_guard_in) noexcept
+        : clusters(nullptr),
+          list(0),
+          codes(),
+          read_guard(std::move(read_guard_in))
+    {}
+    ~PreparedAddDoc() override = default;
+};
+
+}
+
+/*
+ * Inverted list of documents, with the reference to the codes of each document.
+ * Written by the write thread only, and entries are removed by moving the last
+ * entry into their place.
+ */
+class IvfPqIndex::PostingList {
+public:
+    struct Entry {
+        vespalib::datastore::AtomicValueWrapper<uint32_t> docid;
+        AtomicEntryRef                                    codes_ref;
+        Entry() noexcept : docid(), codes_ref() {}
+    };
+private:
+    vespalib::RcuVector<Entry> _entries;
+    std::atomic<uint32_t>      _size;
+public:
+    PostingList();
+    ~PostingList();
+    uint32_t size() const noexcept { return _size.load(std::memory_order_relaxed); }
+    uint32_t acquire_size() const noexcept { return _size.load(std::memory_order_acquire); }
+    const Entry& get_entry(uint32_t pos) const noexcept { return _entries.get_elem_ref(pos); }
+    const Entry& acquire_entry(uint32_t pos) const noexcept { return _entries.acquire_elem_ref(pos); }
+    Entry& get_writable_entry(uint32_t pos) noexcept { return _entries[pos]; }
+    uint32_t add(uint32_t docid, EntryRef codes_ref) {
+        uint32_t pos = size();
+        _entries.ensure_size(pos + 1);
+        auto& entry = _entries[pos];
+        entry.codes_ref.store_release(codes_ref);
+        entry.docid.store_release(docid);
+        _size.store(pos + 1, std::memory_order_release);
+        return pos;
+    }
+    // Returns the docid of the entry moved into the given position, or 0 if no entry was moved.
+    uint32_t remove(uint32_t pos) {
+        uint32_t last = size() - 1;
+        uint32_t moved_docid = 0;
+        if (pos != last) {
+            const auto& src = _entries[last];
+            auto& dst = _entries[pos];
+            moved_docid = src.docid.load_relaxed();
+            dst.codes_ref.store_release(src.codes_ref.load_relaxed());
+            dst.docid.store_release(moved_docid);
+        }
+        _size.store(last, std::memory_order_release);
+        return moved_docid;
+    }
+    void clear() noexcept { _size.store(0, std::memory_order_release); }
+    void assign_generation(generation_t current_gen) { _entries.setGeneration(current_gen + 1); }
+    void reclaim_memory(generation_t oldest_used_gen) { _entries.reclaim_memory(oldest_used_gen); }
+    vespalib::MemoryUsage memory_usage() const { return _entries.getMemoryUsage(); }
+};
+
+IvfPqIndex::PostingList::PostingList()
+    : _entries(),
+      _size(0)
+{
+}
+
+IvfPqIndex::PostingList::~PostingList() = default;
+
+class IvfPqIndex::Clusters {
+public:
+    uint32_t           vector_size;
+    uint32_t           num_lists;
+    uint32_t           num_subquantizers;
+    uint32_t           subquantizer_size;
+    uint32_t           codebook_entries;
+    std::vector<float> centroids; // num_lists * vector_size
+    std::vector<float> codebooks; // num_subquantizers * codebook_size * subquantizer_size
+    std::vector<std::unique_ptr<PostingList>> lists;
+
+    Clusters(uint32_t vector_size_in, uint32_t num_subquantizers_in);
+    ~Clusters();
+    const float* codebook(uint32_t m) const noexcept {
+        return codebooks.data() + size_t(m) * codebook_size * subquantizer_size;
+    }
+    // Returns the list of the given vector, and fills in its codes.
+    uint32_t encode(const IAccelerated& computer, const float* vector, uint8_t* codes) const {
+        for (uint32_t m = 0; m < num_subquantizers; ++m) {
+            codes[m] = closest_centroid(computer, vector + size_t(m) * subquantizer_size, codebook(m), codebook_entries, subquantizer_size);
+        }
+        return closest_centroid(computer, vector, centroids.data(), num_lists, vector_size);
+    }
+    vespalib::MemoryUsage memory_usage() const;
+};
+
+IvfPqIndex::Clusters::Clusters(uint32_t vector_size_in, uint32_t num_subquantizers_in)
+    : vector_size(vector_size_in),
+      num_lists(0),
+      num_subquantizers(num_subquantizers_in),
+      subquantizer_size(vector_size_in / num_subquantizers_in),
+      codebook_entries(0),
+      centroids(),
+      codebooks(size_t(num_subquantizers_in) * codebook_size * (vector_size_in / num_subquantizers_in), 0.0f),
+      lists()
+{
+}
+
+IvfPqIndex::Clusters::~Clusters() = default;
+
+vespalib::MemoryUsage
+IvfPqIndex::Clusters::memory_usage() const
+{
+    vespalib::MemoryUsage result;
+    size_t bytes = (centroids.capacity() + codebooks.capacity()) * sizeof(float) +
+                   lists.capacity() * sizeof(std::unique_ptr<PostingList>);
+    result.incAllocatedBytes(bytes);
+    result.incUsedBytes(bytes);
+    for (const auto& list : lists) {
+        result.merge(list->memory_usage());
+    }
+    return result;
+}
+
+IvfPqIndex::QueryTables::QueryTables() noexcept
+    : clusters(nullptr),
+      list_distances(),
+      code_distances()
+{
+}
+
+IvfPqIndex::QueryTables::~QueryTables() = default;
+
+IvfPqIndex::IvfPqIndex(const DocVectorAccess& vectors, DistanceFunctionFactory::UP distance_ff,
+                       DistanceMetric distance_metric, const IvfPqIndexParams& params)
+    : _vectors(vectors),
+      _distance_ff(),
+      _params(params),
+      _inner_product(distance_metric == DistanceMetric::Dotproduct),
+      _normalize(distance_metric == DistanceMetric::Angular ||
+                 distance_metric == DistanceMetric::PrenormalizedAngular ||
+                 distance_metric == DistanceMetric::InnerProduct),
+      _vector_size(0),
+      _untrained(std::make_unique<PostingList>()),
+      _clusters(),
+      _published_clusters(nullptr),
+      _codes(CodeStore::optimizedConfigForHugePage(max_subquantizers,
+                                                   vespalib::alloc::MemoryAllocator::HUGEPAGE_SIZE,
+                                                   vespalib::alloc::MemoryAllocator::PAGE_SIZE,
+                                                   vespalib::datastore::ArrayStoreConfig::default_max_buffer_size,
+                                                   min_num_arrays_for_new_buffer,
+                                                   alloc_grow_factor).enable_free_lists(true), {}),
+      _doc_list(),
+      _doc_pos(),
+      _num_docs(0)
+{
+    assert(supports(distance_metric));
+    _distance_ff = std::make_unique<IvfPqDistanceFunctionFactory>(std::move(distance_ff), *this);
+}
+
+IvfPqIndex::~IvfPqIndex() = default;
+
+bool
+IvfPqIndex::supports(DistanceMetric metric) noexcept
+{
+    switch (metric) {
+    case DistanceMetric::Euclidean:
+    case DistanceMetric::Angular:
+    case DistanceMetric::PrenormalizedAngular:
+    case DistanceMetric::InnerProduct:
+    case DistanceMetric::Dotproduct:
+        return true;
+    default:
+        return false;
+    }
+}
+
+uint32_t
+IvfPqIndex::num_lists() const noexcept
+{
+    auto clusters = get_clusters();
+    return (clusters != nullptr) ? clusters->num_lists : 0;
+}
+
+uint32_t
+IvfPqIndex::num_subquantizers() const noexcept
+{
+    auto clusters = get_clusters();
+    return (clusters != nullptr) ? clusters->num_subquantizers : 0;
+}
+
+uint32_t
+IvfPqIndex::num_untrained_docs() const noexcept
+{
+    return _untrained->acquire_size();
+}
+
+std::vector<float>
+IvfPqIndex::to_float(TypedCells vector) const
+{
+    TemporaryVectorStore<float> tmp(vector.size);
+    auto cells = tmp.storeLhs(vector);
+    std::vector<float> result(cells.begin(), cells.end());
+    if (_normalize) {
+        double norm_sq = IAccelerated::getAccelerator().dotProduct(result.data(), result.data(), result.size());
+        if (norm_sq > 0.0) {
+            float scale = 1.0 / std::sqrt(norm_sq);
+            for (float& cell : result) {
+                cell *= scale;
+            }
+        }
+    }
+    return result;
+}
+
+IvfPqIndex::PostingList&
+IvfPqIndex::get_list(uint32_t list_ref) noexcept
+{
+    assert(list_ref != 0);
+    return (list_ref == 1) ? *_untrained : *_clusters->lists[list_ref - 2];
+}
+
+void
+IvfPqIndex::add_to_list(uint32_t docid, uint32_t list_ref, EntryRef codes_ref)
+{
+    if (docid >= _doc_list.size()) {
+        _doc_list.resize(docid + 1, 0);
+        _doc_pos.resize(docid + 1, 0);
+    }
+    assert(_doc_list[docid] == 0);
+    _doc_pos[docid] = get_list(list_ref).add(docid, codes_ref);
+    _doc_list[docid] = list_ref;
+}
+
+void
+IvfPqIndex::remove_from_list(uint32_t docid)
+{
+    uint32_t list_ref = (docid < _doc_list.size()) ? _doc_list[docid] : 0;
+    if (list_ref == 0) {
+        return;
+    }
+    auto& list = get_list(list_ref);
+    uint32_t pos = _doc_pos[docid];
+    EntryRef codes_ref = list.get_entry(pos).codes_ref.load_relaxed();
+    if (codes_ref.valid()) {
+        _codes.remove(codes_ref);
+    }
+    uint32_t moved_docid = list.remove(pos);
+    if (moved_docid != 0) {
+        _doc_pos[moved_docid] = pos;
+    }
+    _doc_list[docid] = 0;
+}
+
+void
+IvfPqIndex::train()
+{
+    const auto& computer = IAccelerated::getAccelerator();
+    uint32_t num_vectors = _untrained->size();
+    std::vector<uint32_t> docids;
+    std::vector<float> data;
+    docids.reserve(num_vectors);
+    data.reserve(size_t(num_vectors) * _vector_size);
+    for (uint32_t pos = 0; pos < num_vectors; ++pos) {
+        uint32_t docid = _untrained->get_entry(pos).docid.load_relaxed();
+        auto vector = to_float(_vectors.get_vector(docid, 0));
+        docids.push_back(docid);
+        data.insert(data.end(), vector.begin(), vector.end());
+    }
+    auto clusters = std::make_unique<Clusters>(_vector_size, select_num_subquantizers(_vector_size, _params.num_subquantizers()));
+    uint32_t num_lists = _params.num_lists();
+    if (num_lists == 0) {
+        num_lists = std::lround(std::sqrt(double(num_vectors)));
+    }
+    clusters->num_lists = std::clamp(num_lists, 1u, num_vectors);
+    clusters->centroids = train_kmeans(computer, data, _vector_size, clusters->num_lists);
+    clusters->codebook_entries = std::min(codebook_size, num_vectors);
+    uint32_t sub_size = clusters->subquantizer_size;
+    std::vector<float> slices(size_t(num_vectors) * sub_size);
+    for (uint32_t m = 0; m < clusters->num_subquantizers; ++m) {
+        for (size_t i = 0; i < num_vectors; ++i) {
+            std::copy_n(data.data() + i * _vector_size + size_t(m) * sub_size, sub_size, slices.data() + i * sub_size);
+        }
+        auto codebook = train_kmeans(computer, slices, sub_size, clusters->codebook_entries);
+        std::copy(codebook.begin(), codebook.end(), clusters->codebooks.begin() + size_t(m) * codebook_size * sub_size);
+    }
+    for (uint32_t list = 0; list < clusters->num_lists; ++list) {
+        clusters->lists.emplace_back(std::make_unique<PostingList>());
+    }
+    _clusters = std::move(clusters);
+    _published_clusters.store(_clusters.get(), std::memory_order_release);
+    // Search threads might see a document both in the untrained list and in its new list for a while.
+    std::vector<uint8_t> codes(_clusters->num_subquantizers);
+    for (uint32_t i = 0; i < docids.size(); ++i) {
+        uint32_t list = _clusters->encode(computer, data.data() + size_t(i) * _vector_size, codes.data());
+        _doc_list[docids[i]] = 0;
+        add_to_list(docids[i], list + 2, _codes.add(codes));
+    }
+    _untrained->clear();
+}
+
+void
+IvfPqIndex::add_vector(uint32_t docid, TypedCells vector)
+{
+    if (_vector_size == 0) {
+        _vector_size = vector.size;
+    }
+    assert(vector.size == _vector_size);
+    remove_document(docid);
+    if (_clusters) {
+        std::vector<uint8_t> codes(_clusters->num_subquantizers);
+        uint32_t list = _clusters->encode(IAccelerated::getAccelerator(), to_float(vector).data(), codes.data());
+        add_to_list(docid, list + 2, _codes.add(codes));
+    } else {
+        add_to_list(docid, 1, EntryRef());
+    }
+    ++_num_docs;
+    if (!_clusters && _untrained->size() >= std::max(1u, _params.min_training_size())) {
+        train();
+    }
+}
+
+void
+IvfPqIndex::calc_query_tables(TypedCells query, QueryTables& tables) const
+{
+    const auto& computer = IAccelerated::getAccelerator();
+    tables.clusters = get_clusters();
+    if (tables.clusters == nullptr || query.size != tables.clusters->vector_size) {
+        tables.clusters = nullptr;
+        return;
+    }
+    const auto& clusters = *tables.clusters;
+    auto q = to_float(query);
+    auto distance = [&](const float* a, const float* b, uint32_t size) -> float {
+        return _inner_product ? -computer.dotProduct(a, b, size) : computer.squaredEuclideanDistance(a, b, size);
+    };
+    tables.list_distances.resize(clusters.num_lists);
+    for (uint32_t list = 0; list < clusters.num_lists; ++list) {
+        tables.list_distances[list] = distance(q.data(), clusters.centroids.data() + size_t(list) * clusters.vector_size, clusters.vector_size);
+    }
+    uint32_t sub_size = clusters.subquantizer_size;
+    tables.code_distances.assign(size_t(clusters.num_subquantizers) * codebook_size, std::numeric_limits<float>::max());
+    for (uint32_t m = 0; m < clusters.num_subquantizers; ++m) {
+        const float* codebook = clusters.codebook(m);
+        float* table = tables.code_distances.data() + size_t(m) * codebook_size;
+        for (uint32_t code = 0; code < clusters.codebook_entries; ++code) {
+            table[code] = distance(q.data() + size_t(m) * sub_size, codebook + size_t(code) * sub_size, sub_size);
+        }
+    }
+}
+
+void
+IvfPqIndex::add_document(uint32_t docid)
+{
+    auto vectors = _vectors.get_vectors(docid);
+    if (vectors.subspaces() == 0) {
+        remove_document(docid);
+        return;
+    }
+    assert(vectors.subspaces() == 1);
+    add_vector(docid, vectors.cells(0));
+}
+
+std::unique_ptr<PrepareResult>
+IvfPqIndex::prepare_add_document(uint32_t docid, VectorBundle vectors, vespalib::GenerationHandler::Guard read_guard) const
+{
+    (void) docid;
+    auto result = std::make_unique<PreparedAddDoc>(std::move(read_guard));
+    auto clusters = get_clusters();
+    if (clusters != nullptr && vectors.subspaces() == 1 && vectors.cells(0).size == clusters->vector_size) {
+        result->clusters = clusters;
+        result->codes.resize(clusters->num_subquantizers);
+        result->list = clusters->encode(IAccelerated::getAccelerator(), to_float(vectors.cells(0)).data(), result->codes.data());
+    }
+    return result;
+}
+
+void
+IvfPqIndex::complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result)
+{
+    auto prepared = dynamic_cast<PreparedAddDoc*>(prepare_result.get());
+    if (prepared != nullptr && prepared->clusters != nullptr && prepared->clusters == _clusters.get() &&
+        _vectors.get_vectors(docid).subspaces() == 1)
+    {
+        remove_document(docid);
+        add_to_list(docid, prepared->list + 2, _codes.add(prepared->codes));
+        ++_num_docs;
+    } else {
+        add_document(docid);
+    }
+}
+
+void
+IvfPqIndex::remove_document(uint32_t docid)
+{
+    if (docid < _doc_list.size() && _doc_list[docid] != 0) {
+        remove_from_list(docid);
+        --_num_docs;
+    }
+}
+
+void
+IvfPqIndex::assign_generation(generation_t current_gen)
+{
+    _codes.assign_generation(current_gen);
+    _untrained->assign_generation(current_gen);
+    if (_clusters) {
+        for (auto& list : _clusters->lists) {
+            list->assign_generation(current_gen);
+        }
+    }
+}
+
+void
+IvfPqIndex::reclaim_memory(generation_t oldest_used_gen)
+{
+    _codes.reclaim_memory(oldest_used_gen);
+    _untrained->reclaim_memory(oldest_used_gen);
+    if (_clusters) {
+        for (auto& list : _clusters->lists) {
+            list->reclaim_memory(oldest_used_gen);
+        }
+    }
+}
+
+bool
+IvfPqIndex::consider_compact(const CompactionStrategy& compaction_strategy)
+{
+    if (!_clusters || !_codes.consider_compact()) {
+        return false;
+    }
+    auto context = _codes.compact_worst(compaction_strategy);
+    for (auto& list : _clusters->lists) {
+        uint32_t size = list->size();
+        for (uint32_t pos = 0; pos < size; ++pos) {
+            context->compact(std::span<AtomicEntryRef>(&list->get_writable_entry(pos).codes_ref, 1));
+        }
+    }
+    return true;
+}
+
+vespalib::MemoryUsage
+IvfPqIndex::update_stat(const CompactionStrategy& compaction_strategy)
+{
+    vespalib::MemoryUsage result;
+    result.merge(_codes.update_stat(compaction_strategy));
+    result.merge(_untrained->memory_usage());
+    if (_clusters) {
+        result.merge(_clusters->memory_usage());
+    }
+    size_t doc_bytes = (_doc_list.capacity() + _doc_pos.capacity()) * sizeof(uint32_t);
+    result.incAllocatedBytes(doc_bytes);
+    result.incUsedBytes(doc_bytes);
+    return result;
+}
+
+vespalib::MemoryUsage
+IvfPqIndex::memory_usage() const
+{
+    vespalib::MemoryUsage result;
+    result.merge(_codes.getMemoryUsage());
+    result.merge(_untrained->memory_usage());
+    if (_clusters) {
+        result.merge(_clusters->memory_usage());
+    }
+    size_t doc_bytes = (_doc_list.capacity() + _doc_pos.capacity()) * sizeof(uint32_t);
+    result.incAllocatedBytes(doc_bytes);
+    result.incUsedBytes(doc_bytes);
+    return result;
+}
+
+void
+IvfPqIndex::populate_address_space_usage(search::AddressSpaceUsage& usage) const
+{
+    usage.set(AddressSpaceComponents::ivf_pq_codes_store, _codes.addressSpaceUsage());
+}
+
+std::unique_ptr<vespalib::StateExplorer>
+IvfPqIndex::make_state_explorer() const
+{
+    return std::make_unique<IvfPqIndexExplorer>(*this);
+}
+
+void
+IvfPqIndex::shrink_lid_space(uint32_t doc_id_limit)
+{
+    if (doc_id_limit < _doc_list.size()) {
+        assert(std::all_of(_doc_list.begin() + doc_id_limit, _doc_list.end(), [](uint32_t list_ref) { return list_ref == 0; }));
+        _doc_list.resize(doc_id_limit);
+        _doc_pos.resize(doc_id_limit);
+        _doc_list.shrink_to_fit();
+        _doc_pos.shrink_to_fit();
+    }
+}
+
+std::unique_ptr<NearestNeighborIndexSaver>
+IvfPqIndex::make_saver(vespalib::GenericHeader&) const
+{
+    // The index is rebuilt from the tensor store when loaded
+    return {};
+}
+
+std::unique_ptr<NearestNeighborIndexLoader>
+IvfPqIndex::make_loader(FastOS_FileInterface&, const vespalib::GenericHeader&)
+{
+    throw std::runtime_error("An ivf-pq index is never saved, and cannot be loaded from file");
+}
+
+template <typename FilterCheck>
+std::vector<NearestNeighborIndex::Neighbor>
+IvfPqIndex::top_k(uint32_t k, const BoundDistanceFunction& df, FilterCheck filter_check, uint32_t explore_k,
+                  const vespalib::Doom& doom, double distance_threshold, SearchStats* stats) const
+{
+    explore_k = std::max(k, explore_k);
+    uint32_t visited_nodes = 0;
+    uint64_t visited_bytes = 0;
+    std::vector<uint32_t> docids;
+    uint32_t untrained_size = _untrained->acquire_size();
+    for (uint32_t pos = 0; pos < untrained_size; ++pos) {
+        uint32_t docid = _untrained->acquire_entry(pos).docid.load_acquire();
+        if (filter_check(docid)) {
+            docids.push_back(docid);
+        }
+    }
+    visited_nodes += untrained_size;
+    auto clusters = get_clusters();
+    auto ivf_pq_df = dynamic_cast<const IvfPqBoundDistanceFunction*>(&df);
+    if (clusters != nullptr && ivf_pq_df != nullptr && ivf_pq_df->tables().clusters == clusters) {
+        const auto& tables = ivf_pq_df->tables();
+        std::vector<uint32_t> lists(clusters->num_lists);
+        std::iota(lists.begin(), lists.end(), 0);
+        std::sort(lists.begin(), lists.end(), [&tables](uint32_t lhs, uint32_t rhs) {
+            return tables.list_distances[lhs] < tables.list_distances[rhs];
+        });
+        // Max heap on approximate distance of the best candidates found
+        std::vector<std::pair<float, uint32_t>> best;
+        best.reserve(explore_k + 1);
+        const float* code_distances = tables.code_distances.data();
+        uint32_t num_subquantizers = clusters->num_subquantizers;
+        uint32_t probed = 0;
+        for (uint32_t list_idx : lists) {
+            // Probe more lists than configured if too few candidates pass the filter
+            if ((probed >= std::max(1u, _params.num_probes()) && best.size() >= explore_k) || doom.soft_doom()) {
+                break;
+            }
+            ++probed;
+            const auto& list = *clusters->lists[list_idx];
+            uint32_t list_size = list.acquire_size();
+            visited_nodes += list_size;
+            for (uint32_t pos = 0; pos < list_size; ++pos) {
+                const auto& entry = list.acquire_entry(pos);
+                uint32_t docid = entry.docid.load_acquire();
+                EntryRef codes_ref = entry.codes_ref.load_acquire();
+                if (!codes_ref.valid() || !filter_check(docid)) {
+                    continue;
+                }
+                auto codes = _codes.get(codes_ref);
+                visited_bytes += codes.size();
+                float distance = 0.0f;
+                for (uint32_t m = 0; m < num_subquantizers; ++m) {
+                    distance += code_distances[size_t(m) * codebook_size + codes[m]];
+                }
+                if (best.size() < explore_k || distance < best.front().first) {
+                    best.emplace_back(distance, docid);
+                    std::push_heap(best.begin(), best.end());
+                    if (best.size() > explore_k) {
+                        std::pop_heap(best.begin(), best.end());
+                        best.pop_back();
+                    }
+                }
+            }
+        }
+        for (const auto& candidate : best) {
+            docids.push_back(candidate.second);
+        }
+    } else if (clusters != nullptr) {
+        // No lookup tables for the query vector (bound by another distance function factory), search all lists exactly
+        for (const auto& list : clusters->lists) {
+            uint32_t list_size = list->acquire_size();
+            visited_nodes += list_size;
+            for (uint32_t pos = 0; pos < list_size; ++pos) {
+                uint32_t docid = list->acquire_entry(pos).docid.load_acquire();
+                if (filter_check(docid)) {
+                    docids.push_back(docid);
+                }
+            }
+        }
+    }
+    // A document is in two lists for a while when the index is trained
+    std::sort(docids.begin(), docids.end());
+    docids.erase(std::unique(docids.begin(), docids.end()), docids.end());
+    std::vector<TypedCells> vectors;
+    std::vector<uint32_t> vector_docids;
+    vectors.reserve(docids.size());
+    vector_docids.reserve(docids.size());
+    for (uint32_t docid : docids) {
+        _vectors.prefetch_vector(docid, 0);
+    }
+    for (uint32_t docid : docids) {
+        auto vector = _vectors.get_vector(docid, 0);
+        if (!vector.non_existing_attribute_value()) [[likely]] {
+            visited_bytes += vespalib::eval::CellTypeUtils::mem_size(vector.type, vector.size);
+            vectors.push_back(vector);
+            vector_docids.push_back(docid);
+        }
+    }
+    std::vector<double> distances(vectors.size());
+    df.calc_batch(vectors, distances);
+    std::vector<Neighbor> result;
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        if (distances[i] <= distance_threshold) {
+            result.emplace_back(vector_docids[i], distances[i]);
+        }
+    }
+    auto by_distance = [](const Neighbor& lhs, const Neighbor& rhs) { return lhs.distance < rhs.distance; };
+    if (result.size() > k) {
+        std::nth_element(result.begin(), result.begin() + k, result.end(), by_distance);
+        result.resize(k);
+    }
+    std::sort(result.begin(), result.end(), [](const Neighbor& lhs, const Neighbor& rhs) { return lhs.docid < rhs.docid; });
+    if (stats != nullptr) {
+        stats->visited_nodes += visited_nodes;
+        stats->distance_computations += vectors.size();
+        stats->visited_bytes += visited_bytes;
+    }
+    return result;
+}
+
+std::vector<NearestNeighborIndex::Neighbor>
+IvfPqIndex::find_top_k(uint32_t k, const BoundDistanceFunction &df, uint32_t explore_k, double exploration_slack,
+                       const vespalib::Doom& doom, double distance_threshold, SearchStats* stats) const
+{
+    (void) exploration_slack;
+    return top_k(k, df, NoFilter(), explore_k, doom, distance_threshold, stats);
+}
+
+std::vector<NearestNeighborIndex::Neighbor>
+IvfPqIndex::find_top_k_with_filter(uint32_t k, const BoundDistanceFunction &df, const GlobalFilter &filter, bool low_hit_ratio,
+                                   double exploration, uint32_t explore_k, double exploration_slack, const vespalib::Doom& doom,
+                                   double distance_threshold, SearchStats* stats) const
+{
+    // Lists are scanned until enough candidates pass the filter, independent of its hit ratio
+    (void) low_hit_ratio;
+    (void) exploration;
+    (void) exploration_slack;
+    return top_k(k, df, GlobalFilterCheck(filter), explore_k, doom, distance_threshold, stats);
+}
+
+DistanceFunctionFactory&
+IvfPqIndex::distance_function_factory() const
+{
+    return *_distance_ff;
+}
+
+uint32_t
+IvfPqIndex::check_consistency(uint32_t docid_limit) const noexcept
+{
+    uint32_t inconsistencies = 0;
+    for (uint32_t docid = 1; docid < docid_limit; ++docid) {
+        bool in_index = (docid < _doc_list.size()) && (_doc_list[docid] != 0);
+        bool in_store = (_vectors.get_vectors(docid).subspaces() != 0);
+        if (in_index != in_store) {
+            ++inconsistencies;
+        }
+    }
+    return inconsistencies;
+}
+
+IvfPqBoundDistanceFunction::IvfPqBoundDistanceFunction(BoundDistanceFunction::UP full, const IvfPqIndex& index, TypedCells query)
+    : _full(std::move(full)),
+      _tables()
+{
+    index.calc_query_tables(query, _tables);
+}
+
+IvfPqBoundDistanceFunction::~IvfPqBoundDistanceFunction() = default;
+
+IvfPqDistanceFunctionFactory::IvfPqDistanceFunctionFactory(DistanceFunctionFactory::UP full, const IvfPqIndex& index) noexcept
+    : _full(std::move(full)),
+      _index(index)
+{
+}
+
+IvfPqDistanceFunctionFactory::~IvfPqDistanceFunctionFactory() = default;
+
+BoundDistanceFunction::UP
+IvfPqDistanceFunctionFactory::for_query_vector(TypedCells lhs) const
+{
+    return std::make_unique<IvfPqBoundDistanceFunction>(_full->for_query_vector(lhs), _index, lhs);
+}
+
+BoundDistanceFunction::UP
+IvfPqDistanceFunctionFactory::for_insertion_vector(TypedCells lhs) const
+{
+    return _full->for_insertion_vector(lhs);
+}
+
+}
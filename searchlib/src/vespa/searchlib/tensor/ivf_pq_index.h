@@ -0,0 +1,192 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "bound_distance_function.h"
+#include "distance_function_factory.h"
+#include "nearest_neighbor_index.h"
+#include <vespa/searchcommon/attribute/distance_metric.h>
+#include <vespa/searchcommon/attribute/ivf_pq_index_params.h>
+#include <vespa/vespalib/datastore/array_store.h>
+#include <vespa/vespalib/datastore/atomic_entry_ref.h>
+#include <vespa/vespalib/datastore/atomic_value_wrapper.h>
+#include <vespa/vespalib/util/rcuvector.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace search::tensor {
+
+class DocVectorAccess;
+
+/**
+ * Index used for approximate nearest neighbor search, using an inverted file of
+ * coarse clusters (IVF) with vectors encoded by product quantization (PQ).
+ *
+ * When the index contains min_training_size vectors, k-means is used to train the
+ * coarse centroids, and one codebook of 256 centroids for each subquantizer (a slice
+ * of the vector cells). Until then, all vectors are kept in a single untrained list
+ * that is searched exactly. After training, each vector is added to the list of its
+ * closest coarse centroid, and encoded as one byte per subquantizer in an ArrayStore.
+ *
+ * A query scans the lists of the num_probes closest coarse centroids, and more lists
+ * if the global filter leaves too few candidates. Asymmetric distance computation is
+ * used: the distances from each query slice to all centroids of its codebook are
+ * calculated once per query, and the distance to an encoded vector is a sum of table
+ * lookups. The best explore_k candidates are reranked using the full precision vectors.
+ *
+ * Only dense tensors (one vector per document) are supported. The angular distance
+ * metrics use normalized vectors for training and encoding, while dotproduct uses inner
+ * products instead of euclidean distances in the tables.
+ *
+ * Supports 1 write thread and multiple search threads. The index is not saved,
+ * it is rebuilt from the tensor store when the attribute is loaded.
+ */
+class IvfPqIndex : public NearestNeighborIndex {
+public:
+    using TypedCells = vespalib::eval::TypedCells;
+    using IvfPqIndexParams = search::attribute::IvfPqIndexParams;
+    static constexpr uint32_t codebook_size = 256;
+    static constexpr uint32_t max_subquantizers = 256;
+
+    /**
+     * Trained coarse centroids and subquantizer codebooks, with the inverted lists using them.
+     * Created once by the write thread, and never changed afterwards except for the list contents.
+     */
+    class Clusters;
+
+    /**
+     * Lookup tables for a query vector, calculated when a distance function is bound to it.
+     */
+    struct QueryTables {
+        const Clusters*    clusters;
+        std::vector<float> list_distances; // num_lists
+        std::vector<float> code_distances; // num_subquantizers * codebook_size
+        QueryTables() noexcept;
+        ~QueryTables();
+    };
+
+private:
+    using AtomicEntryRef = vespalib::datastore::AtomicEntryRef;
+    using EntryRef = vespalib::datastore::EntryRef;
+    using CodeStore = vespalib::datastore::ArrayStore<uint8_t>;
+
+    class PostingList;
+
+    const DocVectorAccess&          _vectors;
+    DistanceFunctionFactory::UP     _distance_ff;
+    IvfPqIndexParams                _params;
+    bool                            _inner_product;
+    bool                            _normalize;
+    uint32_t                        _vector_size;
+    std::unique_ptr<PostingList>    _untrained;
+    std::unique_ptr<Clusters>       _clusters;
+    std::atomic<const Clusters*>    _published_clusters;
+    CodeStore                       _codes;
+    // Writer only: list (0 = not in index, 1 = untrained, 2 + i = list i) and position in list per docid.
+    std::vector<uint32_t>           _doc_list;
+    std::vector<uint32_t>           _doc_pos;
+    uint32_t                        _num_docs;
+
+    std::vector<float> to_float(TypedCells vector) const;
+    PostingList& get_list(uint32_t list_ref) noexcept;
+    void add_to_list(uint32_t docid, uint32_t list_ref, EntryRef codes_ref);
+    void remove_from_list(uint32_t docid);
+    void train();
+    void add_vector(uint32_t docid, TypedCells vector);
+    template <typename FilterCheck>
+    std::vector<Neighbor> top_k(uint32_t k, const BoundDistanceFunction& df, FilterCheck filter_check, uint32_t explore_k,
+                                const vespalib::Doom& doom, double distance_threshold, SearchStats* stats) const;
+
+public:
+    IvfPqIndex(const DocVectorAccess& vectors, DistanceFunctionFactory::UP distance_ff,
+               search::attribute::DistanceMetric distance_metric, const IvfPqIndexParams& params);
+    ~IvfPqIndex() override;
+
+    static bool supports(search::attribute::DistanceMetric metric) noexcept;
+
+    // Called from search threads, returns nullptr if not trained.
+    const Clusters* get_clusters() const noexcept { return _published_clusters.load(std::memory_order_acquire); }
+    bool is_trained() const noexcept { return get_clusters() != nullptr; }
+    const IvfPqIndexParams& params() const noexcept { return _params; }
+    uint32_t num_lists() const noexcept;
+    uint32_t num_subquantizers() const noexcept;
+    uint32_t num_docs() const noexcept { return _num_docs; }
+    uint32_t num_untrained_docs() const noexcept;
+    void calc_query_tables(TypedCells query, QueryTables& tables) const;
+
+    // Implements NearestNeighborIndex
+    void add_document(uint32_t docid) override;
+    std::unique_ptr<PrepareResult> prepare_add_document(uint32_t docid, VectorBundle vectors,
+                                                        vespalib::GenerationHandler::Guard read_guard) const override;
+    void complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result) override;
+    void remove_document(uint32_t docid) override;
+    void assign_generation(generation_t current_gen) override;
+    void reclaim_memory(generation_t oldest_used_gen) override;
+    bool consider_compact(const CompactionStrategy& compaction_strategy) override;
+    vespalib::MemoryUsage update_stat(const CompactionStrategy& compaction_strategy) override;
+    vespalib::MemoryUsage memory_usage() const override;
+    void populate_address_space_usage(search::AddressSpaceUsage& usage) const override;
+    std::unique_ptr<vespalib::StateExplorer> make_state_explorer() const override;
+    void shrink_lid_space(uint32_t doc_id_limit) override;
+    std::unique_ptr<NearestNeighborIndexSaver> make_saver(vespalib::GenericHeader& header) const override;
+    std::unique_ptr<NearestNeighborIndexLoader> make_loader(FastOS_FileInterface& file, const vespalib::GenericHeader& header) override;
+    std::vector<Neighbor> find_top_k(uint32_t k,
+                                     const BoundDistanceFunction &df,
+                                     uint32_t explore_k,
+                                     double exploration_slack,
+                                     const vespalib::Doom& doom,
+                                     double distance_threshold,
+                                     SearchStats* stats = nullptr) const override;
+    std::vector<Neighbor> find_top_k_with_filter(uint32_t k,
+                                                 const BoundDistanceFunction &df,
+                                                 const GlobalFilter &filter,
+                                                 bool low_hit_ratio,
+                                                 double exploration,
+                                                 uint32_t explore_k,
+                                                 double exploration_slack,
+                                                 const vespalib::Doom& doom,
+                                                 double distance_threshold,
+                                                 SearchStats* stats = nullptr) const override;
+    DistanceFunctionFactory &distance_function_factory() const override;
+    uint32_t check_consistency(uint32_t docid_limit) const noexcept override;
+};
+
+/**
+ * Distance function bound to a query vector, combining the full precision
+ * distance function with the lookup tables used to scan an ivf-pq index.
+ * All calculations are delegated to the full precision distance function.
+ */
+class IvfPqBoundDistanceFunction final : public BoundDistanceFunction {
+    BoundDistanceFunction::UP _full;
+    IvfPqIndex::QueryTables   _tables;
+public:
+    IvfPqBoundDistanceFunction(BoundDistanceFunction::UP full, const IvfPqIndex& index, TypedCells query);
+    ~IvfPqBoundDistanceFunction() override;
+    const IvfPqIndex::QueryTables& tables() const noexcept { return _tables; }
+    double calc(TypedCells rhs) const noexcept override { return _full->calc(rhs); }
+    double calc_with_limit(TypedCells rhs, double limit) const noexcept override { return _full->calc_with_limit(rhs, limit); }
+    void calc_batch(std::span<const TypedCells> rhs, std::span<double> distances) const noexcept override {
+        _full->calc_batch(rhs, distances);
+    }
+    double convert_threshold(double threshold) const noexcept override { return _full->convert_threshold(threshold); }
+    double to_rawscore(double distance) const noexcept override { return _full->to_rawscore(distance); }
+    double to_distance(double rawscore) const noexcept override { return _full->to_distance(rawscore); }
+    double min_rawscore() const noexcept override { return _full->min_rawscore(); }
+};
+
+/**
+ * Distance function factory used by an ivf-pq index, binding query vectors
+ * both in full precision and to the lookup tables of the index.
+ */
+class IvfPqDistanceFunctionFactory final : public DistanceFunctionFactory {
+    DistanceFunctionFactory::UP _full;
+    const IvfPqIndex&           _index;
+public:
+    IvfPqDistanceFunctionFactory(DistanceFunctionFactory::UP full, const IvfPqIndex& index) noexcept;
+    ~IvfPqDistanceFunctionFactory() override;
+    BoundDistanceFunction::UP for_query_vector(TypedCells lhs) const override;
+    BoundDistanceFunction::UP for_insertion_vector(TypedCells lhs) const override;
+};
+
+}
@@ -0,0 +1,38 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "ivf_pq_index_explorer.h"
+#include "ivf_pq_index.h"
+#include <vespa/searchlib/util/state_explorer_utils.h>
+#include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/data/slime/inserter.h>
+
+namespace search::tensor {
+
+IvfPqIndexExplorer::IvfPqIndexExplorer(const IvfPqIndex& index)
+    : _index(index)
+{
+}
+
+IvfPqIndexExplorer::~IvfPqIndexExplorer() = default;
+
+void
+IvfPqIndexExplorer::get_state(const vespalib::slime::Inserter& inserter, bool full) const
+{
+    (void) full;
+    auto& object = inserter.insertObject();
+    auto& memUsageObj = object.setObject("memory_usage");
+    StateExplorerUtils::memory_usage_to_slime(_index.memory_usage(), memUsageObj.setObject("all"));
+    object.setBool("trained", _index.is_trained());
+    object.setLong("docs", _index.num_docs());
+    object.setLong("untrained_docs", _index.num_untrained_docs());
+    object.setLong("lists", _index.num_lists());
+    object.setLong("subquantizers", _index.num_subquantizers());
+    auto& cfgObj = object.setObject("cfg");
+    auto& params = _index.params();
+    cfgObj.setLong("num_lists", params.num_lists());
+    cfgObj.setLong("num_subquantizers", params.num_subquantizers());
+    cfgObj.setLong("num_probes", params.num_probes());
+    cfgObj.setLong("min_training_size", params.min_training_size());
+}
+
+}
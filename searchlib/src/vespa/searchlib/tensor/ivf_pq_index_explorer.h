@@ -0,0 +1,25 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/net/http/state_explorer.h>
+
+namespace search::tensor {
+
+class IvfPqIndex;
+
+/**
+ * Class used to explore the state of an ivf-pq index.
+ */
+class IvfPqIndexExplorer : public vespalib::StateExplorer
+{
+    const IvfPqIndex& _index;
+public:
+    IvfPqIndexExplorer(const IvfPqIndex& index);
+    ~IvfPqIndexExplorer() override;
+
+    // Implements vespalib::StateExplorer
+    void get_state(const vespalib::slime::Inserter& inserter, bool full) const override;
+};
+
+}
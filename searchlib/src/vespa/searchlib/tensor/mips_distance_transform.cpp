@@ -21,6 +21,20 @@ private:
     using ExtraDimT = std::conditional_t<extra_dim,double,std::monostate>;
     [[no_unique_address]] ExtraDimT _lhs_extra_dim;
 
+    double calc_converted(const FloatType* b) const noexcept {
+        size_t sz = _lhs_vector.size();
+        const FloatType * a = _lhs_vector.data();
+        double dp = _computer.dotProduct(cast(a), cast(b), sz);
+        if constexpr (extra_dim) {
+            double rhs_sq_norm = _computer.dotProduct(cast(b), cast(b), sz);
+            // avoid sqrt(negative) for robustness:
+            double diff = std::max(0.0, _max_sq_norm - rhs_sq_norm);
+            double rhs_extra_dim = std::sqrt(diff);
+            dp += _lhs_extra_dim * rhs_extra_dim;
+        }
+        return -dp;
+    }
+
 public:
     BoundMipsDistanceFunction(TypedCells lhs, MaximumSquaredNormStore& sq_norm_store)
         : BoundDistanceFunction(),
@@ -43,18 +57,12 @@ public:
     }
 
     double calc(TypedCells rhs) const noexcept override {
-        std::span<const FloatType> rhs_vector = _tmpSpace.convertRhs(rhs);
-        const FloatType * a = _lhs_vector.data();
-        const FloatType * b = rhs_vector.data();
-        double dp = _computer.dotProduct(cast(a), cast(b), rhs.size);
-        if constexpr (extra_dim) {
-            double rhs_sq_norm = _computer.dotProduct(cast(b), cast(b), rhs.size);
-            // avoid sqrt(negative) for robustness:
-            double diff = std::max(0.0, _max_sq_norm - rhs_sq_norm);
-            double rhs_extra_dim = std::sqrt(diff);
-            dp += _lhs_extra_dim * rhs_extra_dim;
+        return calc_converted(_tmpSpace.convertRhs(rhs).data());
+    }
+    void calc_batch(std::span<const TypedCells> rhs, std::span<double> distances) const noexcept override {
+        for (size_t i = 0; i < rhs.size(); ++i) {
+            distances[i] = calc_converted(_tmpSpace.convertRhs(rhs[i]).data());
         }
-        return -dp;
     }
     double convert_threshold(double threshold) const noexcept override {
         return threshold;
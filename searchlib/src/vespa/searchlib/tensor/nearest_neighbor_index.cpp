@@ -1,3 +1,17 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "nearest_neighbor_index.h"
+
+namespace search::tensor {
+
+void
+NearestNeighborIndex::add_documents_in_parallel(std::span<const uint32_t> docids, vespalib::Executor& executor, uint32_t num_threads)
+{
+    (void) executor;
+    (void) num_threads;
+    for (uint32_t docid : docids) {
+        add_document(docid);
+    }
+}
+
+}
@@ -10,12 +10,14 @@
 #include <vespa/vespalib/util/memoryusage.h>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
 
 class FastOS_FileInterface;
 
 namespace vespalib { class Doom; }
 namespace vespalib {
+class Executor;
 class GenericHeader;
 struct StateExplorer;
 }
@@ -55,6 +57,27 @@ public:
             return docid == rhs.docid && distance == rhs.distance;
         }
     };
+    /**
+     * Counters from searching the index, reported in the query trace.
+     */
+    struct SearchStats {
+        uint32_t visited_nodes;
+        uint32_t distance_computations;
+        // Bytes of link arrays and vectors read when searching the index.
+        uint64_t visited_bytes;
+        SearchStats() noexcept : visited_nodes(0), distance_computations(0), visited_bytes(0) {}
+    };
+    /**
+     * Progress of an incremental compaction of the index, reported by the state explorer.
+     */
+    struct CompactionProgress {
+        bool active;
+        uint32_t compacted_nodes;
+        uint32_t total_nodes;
+        CompactionProgress() noexcept : active(false), compacted_nodes(0), total_nodes(0) {}
+        CompactionProgress(bool active_in, uint32_t compacted_nodes_in, uint32_t total_nodes_in) noexcept
+            : active(active_in), compacted_nodes(compacted_nodes_in), total_nodes(total_nodes_in) {}
+    };
     virtual ~NearestNeighborIndex() = default;
     virtual void add_document(uint32_t docid) = 0;
 
@@ -77,10 +100,26 @@ public:
      */
     virtual void complete_add_document(uint32_t docid, std::unique_ptr<PrepareResult> prepare_result) = 0;
 
+    /**
+     * Returns true if add_documents_in_parallel() spreads the work over multiple threads.
+     */
+    virtual bool can_add_documents_in_parallel() const noexcept { return false; }
+
+    /**
+     * Adds the given documents to the index, using up to num_threads threads from the given executor.
+     *
+     * This function is only called by the attribute writer thread, and returns when all documents are added.
+     * The caller must commit between calls to have memory freed while adding the documents reclaimed.
+     * The default implementation adds the documents one by one in the calling thread.
+     */
+    virtual void add_documents_in_parallel(std::span<const uint32_t> docids, vespalib::Executor& executor, uint32_t num_threads);
+
     virtual void remove_document(uint32_t docid) = 0;
     virtual void assign_generation(generation_t current_gen) = 0;
     virtual void reclaim_memory(generation_t first_used_gen) = 0;
     virtual bool consider_compact(const CompactionStrategy& compaction_strategy) = 0;
+    // Called from explorer threads while an incremental compaction is performed by the writer.
+    virtual CompactionProgress get_compaction_progress() const noexcept { return {}; }
     virtual vespalib::MemoryUsage update_stat(const CompactionStrategy& compaction_strategy) = 0;
     virtual vespalib::MemoryUsage memory_usage() const = 0;
     virtual void populate_address_space_usage(search::AddressSpaceUsage& usage) const = 0;
@@ -107,7 +146,8 @@ public:
                                              uint32_t explore_k,
                                              double exploration_slack,
                                              const vespalib::Doom& doom,
-                                             double distance_threshold) const = 0;
+                                             double distance_threshold,
+                                             SearchStats* stats = nullptr) const = 0;
 
     // only return neighbors where the corresponding filter bit is set
     virtual std::vector<Neighbor> find_top_k_with_filter(uint32_t k,
@@ -118,7 +158,8 @@ public:
                                                          uint32_t explore_k,
                                                          double exploration_slack,
                                                          const vespalib::Doom& doom,
-                                                         double distance_threshold) const = 0;
+                                                         double distance_threshold,
+                                                         SearchStats* stats = nullptr) const = 0;
 
     virtual DistanceFunctionFactory &distance_function_factory() const = 0;
 
@@ -18,6 +18,11 @@ private:
     mutable VectorStoreType _tmpSpace;
     const std::span<const FloatType> _lhs;
     double _lhs_norm_sq;
+    double calc_converted(const FloatType* b) const noexcept {
+        double dot_product = _computer.dotProduct(cast(_lhs.data()), cast(b), _lhs.size());
+        double distance = _lhs_norm_sq - dot_product;
+        return distance;
+    }
 public:
     explicit BoundPrenormalizedAngularDistance(TypedCells lhs)
         : _computer(vespalib::hwaccelerated::IAccelerated::getAccelerator()),
@@ -31,12 +36,12 @@ public:
         }
     }
     double calc(TypedCells rhs) const noexcept override {
-        std::span<const FloatType> rhs_vector = _tmpSpace.convertRhs(rhs);
-        auto a = _lhs.data();
-        auto b = rhs_vector.data();
-        double dot_product = _computer.dotProduct(cast(a), cast(b), _lhs.size());
-        double distance = _lhs_norm_sq - dot_product;
-        return distance;
+        return calc_converted(_tmpSpace.convertRhs(rhs).data());
+    }
+    void calc_batch(std::span<const TypedCells> rhs, std::span<double> distances) const noexcept override {
+        for (size_t i = 0; i < rhs.size(); ++i) {
+            distances[i] = calc_converted(_tmpSpace.convertRhs(rhs[i]).data());
+        }
     }
     double convert_threshold(double threshold) const noexcept override {
         double cosine_similarity = 1.0 - threshold;
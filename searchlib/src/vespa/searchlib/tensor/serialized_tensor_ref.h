@@ -20,6 +20,8 @@ public:
     SerializedTensorRef(VectorBundle vectors, uint32_t num_mapped_dimensions, std::span<const vespalib::string_id> labels);
     ~SerializedTensorRef();
     const VectorBundle& get_vectors() const noexcept { return _vectors; }
+    uint32_t get_num_mapped_dimensions() const noexcept { return _num_mapped_dimensions; }
+    std::span<const vespalib::string_id> get_labels() const noexcept { return _labels; }
     std::span<const vespalib::string_id> get_labels(uint32_t subspace) const;
 };
 
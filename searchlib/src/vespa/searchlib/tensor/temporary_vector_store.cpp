@@ -59,5 +59,6 @@ TemporaryVectorStore<FloatType>::internal_convert(TypedCells cells, size_t offse
 template class TemporaryVectorStore<vespalib::eval::Int8Float>;
 template class TemporaryVectorStore<float>;
 template class TemporaryVectorStore<double>;
+template class TemporaryVectorStore<vespalib::BFloat16>;
 
 }
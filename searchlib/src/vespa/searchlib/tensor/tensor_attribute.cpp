@@ -366,6 +366,9 @@ TensorAttribute::update_tensor(DocId docId,
     const vespalib::eval::Value * old_v = nullptr;
     auto old_tensor = getTensor(docId);
     if (old_tensor) {
+        if (!_index && update.can_apply_in_place(*old_tensor) && update_tensor_in_place(docId, update)) {
+            return;
+        }
         old_v = old_tensor.get();
     } else if (create_empty_if_non_existing) {
         old_v = _emptyTensor.get();
@@ -378,6 +381,19 @@ TensorAttribute::update_tensor(DocId docId,
     }
 }
 
+bool
+TensorAttribute::update_tensor_in_place(DocId docid, const document::TensorUpdate& update)
+{
+    // Copy the stored tensor as is and modify the cells of the copy before it is visible to readers
+    EntryRef ref = _tensorStore.copy_tensor(_refVector[docid].load_relaxed());
+    if (!ref.valid()) {
+        return false;
+    }
+    update.apply_in_place(*_tensorStore.get_tensor(ref));
+    setTensorRef(docid, ref);
+    return true;
+}
+
 std::unique_ptr<PrepareResult>
 TensorAttribute::prepare_set_tensor(DocId docid, const vespalib::eval::Value& tensor) const
 {
@@ -40,6 +40,7 @@ protected:
     void setTensorRef(DocId docId, EntryRef ref);
     void internal_set_tensor(DocId docid, const vespalib::eval::Value& tensor);
     void consider_remove_from_index(DocId docid);
+    bool update_tensor_in_place(DocId docid, const document::TensorUpdate& update);
     virtual vespalib::MemoryUsage update_stat();
     void populate_address_space_usage(AddressSpaceUsage& usage) const override;
     EntryRef acquire_entry_ref(DocId doc_id) const noexcept { return _refVector.acquire_elem_ref(doc_id).load_acquire(); }
@@ -41,6 +41,14 @@ TensorAttributeExplorer::get_state(const vespalib::slime::Inserter& inserter, bo
     object.setLong("compact_generation", _compact_generation);
     StateExplorerUtils::memory_usage_to_slime(_ref_vector.getMemoryUsage(),
                                               object.setObject("ref_vector").setObject("memory_usage"));
+    if (_index != nullptr) {
+        auto& index_obj = object.setObject("index_compaction");
+        index_obj.setLong("dead_bytes", _index->memory_usage().deadBytes());
+        auto progress = _index->get_compaction_progress();
+        index_obj.setBool("active", progress.active);
+        index_obj.setLong("compacted_nodes", progress.compacted_nodes);
+        index_obj.setLong("total_nodes", progress.total_nodes);
+    }
 }
 
 std::vector<std::string>
@@ -18,10 +18,12 @@
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/jsonwriter.h>
 #include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadexecutor.h>
 #include <vespa/vespalib/util/time.h>
 #include <condition_variable>
 #include <filesystem>
 #include <mutex>
+#include <thread>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.tensor.tensor_attribute_loader");
@@ -72,6 +74,11 @@ bool can_use_index_save_file(const std::string& attrName,
     }
     const auto &config_params = config.hnsw_index_params().value();
     const auto &header_params = header.get_hnsw_index_params().value();
+    if (config_params.ivf_pq().has_value()) {
+        LOG(warning, "Attribute %s cannot use saved HNSW index for ANN, an ivf-pq index is rebuilt instead",
+            attrName.c_str());
+        return false;
+    }
     if ((config_params.max_links_per_node() != header_params.max_links_per_node()) ||
         (config_params.distance_metric() != header_params.distance_metric()))
     {
@@ -203,6 +210,52 @@ ThreadedIndexBuilder::add(uint32_t lid) {
     _shared_executor.execute(CpuUsage::wrap(std::move(task), CpuUsage::Category::SETUP));
 }
 
+/**
+ * Will build nearest neighbor index in batches, where the documents in each batch are
+ * added to the index by all threads in the shared executor at the same time.
+ * Memory freed while adding a batch is reclaimed when committing after it.
+ */
+class BulkIndexBuilder : public IndexBuilder {
+public:
+    BulkIndexBuilder(AttributeVector& attr, NearestNeighborIndex& index, vespalib::Executor& shared_executor)
+        : _attr(attr),
+          _index(index),
+          _shared_executor(shared_executor),
+          _num_threads(num_threads_in(shared_executor)),
+          _batch()
+    {
+        _batch.reserve(BATCH_SIZE);
+    }
+    void add(uint32_t lid) override {
+        _batch.push_back(lid);
+        if (_batch.size() >= BATCH_SIZE) {
+            flush();
+        }
+    }
+    void wait_complete() override {
+        flush();
+    }
+private:
+    static uint32_t num_threads_in(vespalib::Executor& executor) {
+        auto* thread_executor = dynamic_cast<vespalib::ThreadExecutor*>(&executor);
+        size_t num_threads = (thread_executor != nullptr) ? thread_executor->getNumThreads() : std::thread::hardware_concurrency();
+        return std::max(num_threads, size_t(1));
+    }
+    void flush() {
+        if (!_batch.empty()) {
+            _index.add_documents_in_parallel(_batch, _shared_executor, _num_threads);
+            _batch.clear();
+            _attr.commit();
+        }
+    }
+    static constexpr uint32_t BATCH_SIZE = 4096;
+    AttributeVector&      _attr;
+    NearestNeighborIndex& _index;
+    vespalib::Executor&   _shared_executor;
+    uint32_t              _num_threads;
+    std::vector<uint32_t> _batch;
+};
+
 class ForegroundIndexBuilder : public IndexBuilder {
 public:
     ForegroundIndexBuilder(AttributeVector& attr, NearestNeighborIndex& index)
@@ -286,7 +339,10 @@ void
 TensorAttributeLoader::build_index(vespalib::Executor* executor, uint32_t docid_limit)
 {
     std::unique_ptr<IndexBuilder> builder;
-    if (executor != nullptr) {
+    if (executor != nullptr && _index->can_add_documents_in_parallel()) {
+        builder = std::make_unique<BulkIndexBuilder>(_attr, *_index, *executor);
+        Event(_attr).addKV("execution", "multi-threaded-bulk").log("hnsw.index.rebuild.start");
+    } else if (executor != nullptr) {
         builder = std::make_unique<ThreadedIndexBuilder>(_attr, _generation_handler, _store, *_index, *executor);
         Event(_attr).addKV("execution", "multi-threaded").log("hnsw.index.rebuild.start");
     } else {
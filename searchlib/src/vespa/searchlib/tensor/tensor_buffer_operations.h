@@ -98,6 +98,8 @@ public:
 
     // Mark that reclaim_labels should be skipped for old buffer after copying tensor buffer
     void copied_labels(std::span<char> buf) const;
+    // Increase reference counts for labels after copying tensor buffer, when the old buffer is kept as is
+    void add_label_refs(std::span<char> buf) const;
     // Decrease reference counts for labels and set skip flag unless skip flag is set.
     void reclaim_labels(std::span<char> buf) const;
     // Serialize stored tensor to target (used when saving attribute)
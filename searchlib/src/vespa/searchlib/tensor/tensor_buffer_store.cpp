@@ -116,6 +116,17 @@ TensorBufferStore::get_tensor(EntryRef ref) const
     return _ops.make_fast_view(buf, _tensor_type);
 }
 
+EntryRef
+TensorBufferStore::copy_tensor(EntryRef ref)
+{
+    if (!ref.valid()) {
+        return EntryRef();
+    }
+    auto new_ref = _array_store.add(_array_store.get(ref));
+    _ops.add_label_refs(_array_store.get_writable(new_ref));
+    return new_ref;
+}
+
 bool
 TensorBufferStore::encode_stored_tensor(EntryRef ref, vespalib::nbostream &target) const
 {
@@ -51,6 +51,13 @@ public:
     virtual EntryRef store_encoded_tensor(vespalib::nbostream& encoded) = 0;
     virtual std::unique_ptr<vespalib::eval::Value> get_tensor(EntryRef ref) const = 0;
     virtual bool encode_stored_tensor(EntryRef ref, vespalib::nbostream& target) const = 0;
+    /*
+     * Stores a copy of the tensor referenced by ref, returning an invalid
+     * ref if not supported by the store. The cells of the tensor returned
+     * by get_tensor() for the new ref can be modified until the new ref is
+     * made visible to readers.
+     */
+    virtual EntryRef copy_tensor(EntryRef ref);
     virtual const DenseTensorStore* as_dense() const;
     virtual DenseTensorStore* as_dense();
 
@@ -38,6 +38,10 @@ public:
     }
     ~VectorBundle() = default;
     uint32_t subspaces() const noexcept { return _subspaces; }
+    // cells for all subspaces
+    vespalib::eval::TypedCells cells() const noexcept {
+        return {_data, _cell_type, _subspace_size * _subspaces};
+    }
     vespalib::eval::TypedCells cells(uint32_t subspace) const noexcept {
         return {static_cast<const char*>(_data) + _subspace_mem_size * subspace, _cell_type, _subspace_size};
     }
@@ -139,6 +139,7 @@ FakeZcFilterOcc::setupT(const FakeWord &fw)
     params.set("minChunkDocs", _posting_params._min_chunk_docs); // Control chunking
     params.set("minSkipDocs", _posting_params._min_skip_docs);   // Control skip info
     params.set("interleaved_features", _posting_params._encode_interleaved_features);
+    params.set("block_doc_ids", _posting_params._encode_block_doc_ids);
     writer.set_posting_list_params(params);
     auto &writeContext = writer.get_write_context();
     search::ComprBuffer &cb = writeContext;
@@ -792,6 +793,26 @@ public:
 
 FakeZc4SkipPosOccCfNoCheapUnpack::~FakeZc4SkipPosOccCfNoCheapUnpack() = default;
 
+static Zc4PostingParams
+make_block_doc_ids_params(const FakeWord &fw)
+{
+    Zc4PostingParams params(force_skip, disable_chunking, fw._docIdLimit, false, true, true);
+    params._encode_block_doc_ids = true;
+    return params;
+}
+
+class FakeZc4SkipPosOccCfBlockDocIds : public FakeZc4SkipPosOcc<true>
+{
+public:
+    FakeZc4SkipPosOccCfBlockDocIds(const FakeWord &fw)
+        : FakeZc4SkipPosOcc<true>(fw, make_block_doc_ids_params(fw), ".zc4skipposoccbe.cf.bd")
+    {
+    }
+    ~FakeZc4SkipPosOccCfBlockDocIds() override;
+};
+
+FakeZc4SkipPosOccCfBlockDocIds::~FakeZc4SkipPosOccCfBlockDocIds() = default;
+
 template <bool bigEndian>
 class FakeZc4NoSkipPosOccCf : public FakeZc4SkipPosOcc<bigEndian>
 {
@@ -908,6 +929,11 @@ initSkipPos0becfncu(std::make_pair("Zc4SkipPosOccBE.cf.ncu",
                                 makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfNoCheapUnpack > >));
 
 
+static FPFactoryInit
+initSkipPos0becfbd(std::make_pair("Zc4SkipPosOccBE.cf.bd",
+                                  makeFPFactory<FPFactoryT<FakeZc4SkipPosOccCfBlockDocIds > >));
+
+
 static FPFactoryInit
 initNoSkipPos0becf(std::make_pair("Zc4NoSkipPosOccBE.cf",
                                   makeFPFactory<FPFactoryT<FakeZc4NoSkipPosOccCf<true> > >));
@@ -42,6 +42,12 @@ ImpureValueBlueprint::createExecutor(const IQueryEnvironment &, vespalib::Stash
 
 struct DocidExecutor : FeatureExecutor {
     void execute(uint32_t docid) override { outputs().set_number(0, docid); }
+    bool supports_batch() const override { return true; }
+    void execute_batch(std::span<const uint32_t> docids, std::span<const feature_t * const>,
+                       std::span<feature_t * const> out) override
+    {
+        std::copy(docids.begin(), docids.end(), out[0]);
+    }
 };
 
 bool
@@ -39,6 +39,12 @@ createCommitChunk(const DomainConfig &cfg) {
     return std::make_unique<CommitChunk>(cfg.getChunkSizeLimit(), cfg.getChunkSizeLimit()/256);
 }
 
+/*
+ * When syncing on commit, a written chunk waits for the commits queued
+ * behind it so they share a single sync, but no more than this.
+ */
+constexpr size_t MAX_COMMITS_PER_SYNC = 16;
+
 VESPA_THREAD_STACK_TAG(tls_domain_commit);
 }
 
@@ -48,6 +54,10 @@ Domain::Domain(const string &domainName, const string & baseDir, vespalib::Execu
       _currentChunk(createCommitChunk(cfg)),
       _lastSerial(0),
       _singleCommitter(std::make_unique<vespalib::ThreadStackExecutor>(1, CpuUsage::wrap(tls_domain_commit, CpuCategory::WRITE))),
+      _pendingCommits(0),
+      _awaitingSync(),
+      _commitLatencyMutex(),
+      _commitLatency(),
       _executor(executor),
       _sessionId(1),
       _name(domainName),
@@ -86,6 +96,7 @@ Domain::Domain(const string &domainName, const string & baseDir, vespalib::Execu
         _parts[lastPart] = std::make_shared<DomainPart>(_name, dir(), lastPart, _fileHeaderContext, false);
         vespalib::File::sync(dir());
     }
+    _parts.crbegin()->second->setPreallocateSize(_config.getPreallocateSize());
     _lastSerial = end();
 }
 
@@ -93,6 +104,7 @@ Domain &
 Domain::setConfig(const DomainConfig & cfg) {
     _config = cfg;
     assert(_config.getEncoding().getCompression() != Encoding::Compression::none);
+    getActivePart()->setPreallocateSize(_config.getPreallocateSize());
     return *this;
 }
 
@@ -130,6 +142,10 @@ Domain::getDomainInfo() const
 {
     std::unique_lock guard(_partsMutex);
     DomainInfo info(SerialNumRange(begin(guard), end(guard)), size(guard), byteSize(guard), _maxSessionRunTime);
+    {
+        std::lock_guard stats_guard(_commitLatencyMutex);
+        info.commitLatency = _commitLatency;
+    }
     for (const auto &entry: _parts) {
         const DomainPart &part = *entry.second;
         info.parts.emplace_back(PartInfo(part.range(), part.size(), part.byteSize(), part.fileName()));
@@ -223,6 +239,7 @@ Domain::triggerSyncNow(std::unique_ptr<vespalib::IDestructorCallback> after_sync
     _singleCommitter->execute(makeLambdaTask([this, after_sync=std::move(after_sync)]() {
         (void) after_sync;
         getActivePart()->sync();
+        completeCommits(true);
     }));
 }
 
@@ -305,8 +322,11 @@ Domain::optionallyRotateFile(SerialNum serialNum) {
     DomainPart::SP dp = getActivePart();
     if (dp->byteSize() > _config.getPartSizeLimit()) {
         dp->sync();
+        // All commits waiting for sync were written to the old part
+        completeCommits(true);
         dp->close();
         dp = std::make_shared<DomainPart>(_name, dir(), serialNum, _fileHeaderContext, false);
+        dp->setPreallocateSize(_config.getPreallocateSize());
         {
             std::lock_guard guard(_partsMutex);
             _parts[serialNum] = dp;
@@ -372,29 +392,54 @@ Domain::commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunk
     chunk->shrinkPayloadToFit();
     std::promise<SerializedChunk> promise;
     std::future<SerializedChunk> future = promise.get_future();
+    _pendingCommits.fetch_add(1, std::memory_order_relaxed);
     _executor.execute(makeLambdaTask([promise=std::move(promise), chunk = std::move(chunk),
                                       encoding=_config.getEncoding(), compressionLevel=_config.getCompressionlevel()]() mutable {
         promise.set_value(SerializedChunk(std::move(chunk), encoding, compressionLevel));
     }));
-    _singleCommitter->execute( makeLambdaTask([this, future = std::move(future)]() mutable {
-        doCommit(future.get());
+    _singleCommitter->execute( makeLambdaTask([this, future = std::move(future), start=vespalib::steady_clock::now()]() mutable {
+        doCommit(future.get(), start);
     }));
 }
 
-
-
 void
-Domain::doCommit(const SerializedChunk & serialized) {
+Domain::doCommit(SerializedChunk serialized, vespalib::steady_time start) {
 
     SerialNumRange range = serialized.range();
     DomainPart::SP dp = optionallyRotateFile(range.from());
     dp->commit(serialized);
-    if (_config.getFSyncOnCommit()) {
+    _awaitingSync.push_back({std::move(serialized), start});
+    bool morePending = _pendingCommits.fetch_sub(1, std::memory_order_relaxed) > 1;
+    if ( ! _config.getFSyncOnCommit()) {
+        completeCommits(false);
+    } else if ( ! morePending || (_awaitingSync.size() >= MAX_COMMITS_PER_SYNC)) {
         dp->sync();
+        completeCommits(true);
     }
     cleanSessions();
-    LOG(debug, "Releasing %zu acks and %zu entries and %zu bytes.",
-        serialized.getNumCallBacks(), serialized.getNumEntries(), serialized.getData().size());
+}
+
+void
+Domain::completeCommits(bool synced) {
+    if (_awaitingSync.empty()) {
+        return;
+    }
+    auto now = vespalib::steady_clock::now();
+    {
+        std::lock_guard guard(_commitLatencyMutex);
+        for (const auto & commit : _awaitingSync) {
+            _commitLatency.add(vespalib::to_s(now - commit.start));
+        }
+        if (synced) {
+            ++_commitLatency.syncs;
+        }
+    }
+    for (const auto & commit : _awaitingSync) {
+        const SerializedChunk & serialized = commit.chunk;
+        LOG(debug, "Releasing %zu acks and %zu entries and %zu bytes.",
+            serialized.getNumCallBacks(), serialized.getNumEntries(), serialized.getData().size());
+    }
+    _awaitingSync.clear();
 }
 
 bool
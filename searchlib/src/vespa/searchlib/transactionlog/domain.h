@@ -6,6 +6,7 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <vector>
 
 namespace search::common { class FileHeaderContext; }
 namespace search::transactionlog {
@@ -56,6 +57,14 @@ public:
     Domain & setConfig(const DomainConfig & cfg);
 private:
     using UniqueLock = std::unique_lock<std::mutex>;
+    /*
+     * A written chunk waiting for the sync covering it. Releasing the
+     * chunk acks the operations in it.
+     */
+    struct PendingCommit {
+        SerializedChunk        chunk;
+        vespalib::steady_time  start;
+    };
     DomainPartSP getActivePart();
     void verifyLock(const UniqueLock & guard) const;
     void commitIfFull(const UniqueLock & guard);
@@ -63,7 +72,8 @@ private:
 
     std::unique_ptr<CommitChunk> grabCurrentChunk(const UniqueLock & guard);
     void commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunkOrderGuard);
-    void doCommit(const SerializedChunk & serialized);
+    void doCommit(SerializedChunk serialized, vespalib::steady_time start);
+    void completeCommits(bool synced);
     SerialNum begin(const UniqueLock & guard) const;
     SerialNum end(const UniqueLock & guard) const;
     size_t byteSize(const UniqueLock & guard) const;
@@ -86,6 +96,12 @@ private:
     std::unique_ptr<CommitChunk> _currentChunk;
     SerialNum                    _lastSerial;
     std::unique_ptr<Executor>    _singleCommitter;
+    // Chunks handed to _singleCommitter and not yet written
+    std::atomic<size_t>          _pendingCommits;
+    // Only accessed by _singleCommitter
+    std::vector<PendingCommit>   _awaitingSync;
+    mutable std::mutex           _commitLatencyMutex;
+    CommitLatencyStats           _commitLatency;
     Executor                    &_executor;
     std::atomic<int>             _sessionId;
     std::string             _name;
@@ -2,6 +2,7 @@
 
 #include "domainconfig.h"
 #include <vespa/vespalib/util/exceptions.h>
+#include <algorithm>
 
 namespace search::transactionlog {
 
@@ -10,7 +11,8 @@ DomainConfig::DomainConfig()
       _compressionLevel(9),
       _fSyncOnCommit(false),
       _partSizeLimit(0x10000000), // 256M
-      _chunkSizeLimit(0x40000)   // 256k
+      _chunkSizeLimit(0x40000),  // 256k
+      _preallocateSize(0)
 { }
 
 DomainConfig &
@@ -22,4 +24,20 @@ DomainConfig::setEncoding(Encoding v) {
     return *this;
 }
 
+size_t
+CommitLatencyStats::bucket(double latency) noexcept
+{
+    auto it = std::lower_bound(bucket_limits.begin(), bucket_limits.end(), latency);
+    return it - bucket_limits.begin();
+}
+
+void
+CommitLatencyStats::add(double latency) noexcept
+{
+    ++commits;
+    total_latency += latency;
+    max_latency = std::max(max_latency, latency);
+    ++buckets[bucket(latency)];
+}
+
 }
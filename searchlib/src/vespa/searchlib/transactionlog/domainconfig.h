@@ -3,6 +3,7 @@
 
 #include "ichunk.h"
 #include <vespa/vespalib/util/time.h>
+#include <array>
 #include <map>
 
 namespace search::transactionlog {
@@ -16,17 +17,39 @@ public:
     DomainConfig & setChunkSizeLimit(size_t v)      { _chunkSizeLimit = v; return *this; }
     DomainConfig & setCompressionLevel(uint8_t v)   { _compressionLevel = v; return *this; }
     DomainConfig & setFSyncOnCommit(bool v)         { _fSyncOnCommit = v; return *this; }
+    DomainConfig & setPreallocateSize(size_t v)     { _preallocateSize = v; return *this; }
     Encoding          getEncoding() const { return _encoding; }
     size_t       getPartSizeLimit() const { return _partSizeLimit; }
     size_t      getChunkSizeLimit() const { return _chunkSizeLimit; }
     uint8_t   getCompressionlevel() const { return _compressionLevel; }
     bool         getFSyncOnCommit() const { return _fSyncOnCommit; }
+    size_t     getPreallocateSize() const { return _preallocateSize; }
 private:
     Encoding     _encoding;
     uint8_t      _compressionLevel;
     bool         _fSyncOnCommit;
     size_t       _partSizeLimit;
     size_t       _chunkSizeLimit;
+    size_t       _preallocateSize;
+};
+
+/*
+ * Latency of commits, from a chunk is handed over for writing until it
+ * is written and synced (if enabled). Counters are monotonic.
+ */
+struct CommitLatencyStats {
+    // Upper bounds (in seconds) of all but the last bucket, which is open ended.
+    static constexpr std::array<double, 9> bucket_limits = {0.0005, 0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.5};
+    static constexpr size_t NUM_BUCKETS = bucket_limits.size() + 1;
+    uint64_t commits;
+    uint64_t syncs;
+    double   total_latency;
+    double   max_latency;
+    std::array<uint64_t, NUM_BUCKETS> buckets;
+
+    CommitLatencyStats() noexcept : commits(0), syncs(0), total_latency(0.0), max_latency(0.0), buckets() {}
+    static size_t bucket(double latency) noexcept;
+    void add(double latency) noexcept;
 };
 
 struct PartInfo {
@@ -48,11 +71,13 @@ struct DomainInfo {
     size_t numEntries;
     size_t byteSize;
     DurationSeconds maxSessionRunTime;
+    CommitLatencyStats commitLatency;
     std::vector<PartInfo> parts;
     DomainInfo(SerialNumRange range_in, size_t numEntries_in, size_t byteSize_in, DurationSeconds maxSessionRunTime_in)
-            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts() {}
+            : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in),
+              commitLatency(), parts() {}
     DomainInfo()
-            : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts() {}
+            : range(), numEntries(0), byteSize(0), maxSessionRunTime(), commitLatency(), parts() {}
 };
 
 using DomainStats = std::map<std::string, DomainInfo>;
@@ -6,7 +6,9 @@
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/fastlib/io/bufferedfile.h>
 #include <cassert>
+#include <cerrno>
 #include <filesystem>
+#include <fcntl.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".transactionlog.domainpart");
@@ -263,7 +265,9 @@ DomainPart::DomainPart(const string & name, const string & baseDir, SerialNum s,
       _headerLen(0),
       _writeLock(),
       _writtenSerial(0),
-      _syncedSerial(0)
+      _syncedSerial(0),
+      _preallocateSize(0),
+      _preallocatedTo(0)
 {
     if (_transLog->OpenReadOnly()) {
         int64_t currPos = buildPacketMapping(allowTruncate);
@@ -332,6 +336,7 @@ DomainPart::close()
          * hole.  XXX: Feed latency spike due to lack of delayed open
          * for new domainpart.
          */
+        releasePreallocated(*_transLog);
         handleSync(*_transLog);
         _transLog->dropFromCache();
         retval = _transLog->Close();
@@ -400,6 +405,56 @@ DomainPart::commit(const SerializedChunk & serialized)
     _skipList.emplace_back(range.from(), firstPos);
 }
 
+void
+DomainPart::setPreallocateSize(size_t sz)
+{
+    std::lock_guard guard(_writeLock);
+    _preallocateSize = sz;
+}
+
+void
+DomainPart::preallocate(FastOS_FileInterface &file, size_t bufLen)
+{
+    uint64_t writeEnd = byteSize() + bufLen;
+    if ((_preallocateSize == 0) || (writeEnd <= _preallocatedTo)) {
+        return;
+    }
+    uint64_t from = std::max(_preallocatedTo, uint64_t(byteSize()));
+    uint64_t len = std::max(uint64_t(_preallocateSize), writeEnd - from);
+#ifdef __linux__
+    if (fallocate(file.get_fd(), FALLOC_FL_KEEP_SIZE, from, len) != 0) {
+        LOG(debug, "Failed preallocating %" PRIu64 " bytes at %" PRIu64 " in '%s': %s",
+            len, from, file.GetFileName(), getLastErrorString().c_str());
+        if ((errno == EOPNOTSUPP) || (errno == ENOSYS)) {
+            _preallocateSize = 0;
+        }
+        return;
+    }
+#else
+    (void) file;
+#endif
+    _preallocatedTo = from + len;
+}
+
+void
+DomainPart::releasePreallocated(FastOS_FileInterface &file)
+{
+    std::lock_guard guard(_writeLock);
+    uint64_t from = byteSize();
+    if (file.IsOpened() && (_preallocatedTo > from)) {
+        // Truncating to the current size releases the blocks beyond it on most file systems
+        if ( ! file.SetSize(from)) {
+            LOG(warning, "Failed releasing preallocated space beyond %" PRIu64 " in '%s': %s",
+                from, file.GetFileName(), getLastErrorString().c_str());
+        }
+#ifdef __linux__
+        // Others, like tmpfs, need the hole punched
+        (void) fallocate(file.get_fd(), FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, from, _preallocatedTo - from);
+#endif
+    }
+    _preallocatedTo = 0;
+}
+
 void
 DomainPart::sync()
 {
@@ -435,6 +490,7 @@ void
 DomainPart::write(FastOS_FileInterface &file, SerialNumRange range, vespalib::ConstBufferRef buf)
 {
     std::lock_guard guard(_writeLock);
+    preallocate(file, buf.size());
     size_t written = file.Write2(buf.data(), buf.size());
     if ( written != buf.size() ) {
         throw runtime_error(handleWriteError("Failed writing the entry.", file, byteSize(), range, buf.size()));
@@ -30,6 +30,12 @@ public:
     bool visit(FastOS_FileInterface &file, SerialNumRange &r, Packet &packet);
     bool close();
     void sync();
+    /*
+     * Allocate disk space for the file in steps of the given size ahead
+     * of writing, without changing the file size. Unused space is released
+     * on close. 0 disables preallocation.
+     */
+    void setPreallocateSize(size_t sz);
     SerialNumRange range() const { return SerialNumRange(get_range_from(), get_range_to()); }
 
     SerialNum getSynced() const {
@@ -50,6 +56,8 @@ private:
     static bool read(FastOS_FileInterface &file, IChunk::UP & chunk, Alloc &buf, bool allowTruncate);
 
     void write(FastOS_FileInterface &file, SerialNumRange range, vespalib::ConstBufferRef buf);
+    void preallocate(FastOS_FileInterface &file, size_t bufLen);
+    void releasePreallocated(FastOS_FileInterface &file);
     void writeHeader(const common::FileHeaderContext &fileHeaderContext);
     void set_size(size_t sz) noexcept { _sz.store(sz, std::memory_order_relaxed); }
     SerialNum get_range_from() const noexcept { return _range_from.load(std::memory_order_relaxed); }
@@ -88,6 +96,8 @@ private:
     // Protected by _writeLock
     SerialNum             _writtenSerial;
     SerialNum             _syncedSerial;
+    size_t                _preallocateSize;
+    uint64_t              _preallocatedTo;
 };
 
 }
@@ -4,6 +4,7 @@
 #include <vespa/config/subscription/configuri.h>
 #include <vespa/config/helper/configfetcher.hpp>
 #include <vespa/vespalib/util/time.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".translogserverapp");
@@ -66,17 +67,18 @@ getDomainConfig(const searchlib::TranslogserverConfig & cfg) {
         .setCompressionLevel(cfg.compression.level)
         .setPartSizeLimit(cfg.filesizemax)
         .setChunkSizeLimit(cfg.chunk.sizelimit)
-        .setFSyncOnCommit(cfg.usefsync);
+        .setFSyncOnCommit(cfg.usefsync)
+        .setPreallocateSize(std::max(int64_t(0), cfg.preallocate));
     return dcfg;
 }
 
 void
 logReconfig(const searchlib::TranslogserverConfig & cfg, const DomainConfig & dcfg) {
     LOG(config, "configure Transaction Log Server %s at port %d\n"
-                "DomainConfig {encoding={%d, %d}, compression_level=%d, part_limit=%ld, chunk_limit=%ld}",
+                "DomainConfig {encoding={%d, %d}, compression_level=%d, part_limit=%ld, chunk_limit=%ld, preallocate=%ld}",
         cfg.servername.c_str(), cfg.listenport,
         dcfg.getEncoding().getCrc(), dcfg.getEncoding().getCompression(), dcfg.getCompressionlevel(),
-        dcfg.getPartSizeLimit(), dcfg.getChunkSizeLimit());
+        dcfg.getPartSizeLimit(), dcfg.getChunkSizeLimit(), dcfg.getPreallocateSize());
 }
 
 size_t
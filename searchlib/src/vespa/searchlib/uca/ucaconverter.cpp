@@ -28,7 +28,9 @@ UcaConverterFactory::create(string_view local, string_view strength) const {
 UcaConverter::UcaConverter(std::string_view locale, std::string_view strength)
     : _buffer(),
       _u16Buffer(128),
-      _collator()
+      _collator(),
+      _locale(locale),
+      _strength(strength)
 {
     UErrorCode status = U_ZERO_ERROR;
     Collator *coll = nullptr;
@@ -61,6 +63,18 @@ UcaConverter::UcaConverter(std::string_view locale, std::string_view strength)
 
 UcaConverter::~UcaConverter() {}
 
+std::string
+UcaConverter::id() const
+{
+    return "uca(" + _locale + "," + _strength + ")";
+}
+
+BlobConverter::UP
+UcaConverter::clone() const
+{
+    return std::make_unique<UcaConverter>(_locale, _strength);
+}
+
 int UcaConverter::utf8ToUtf16(const ConstBufferRef & src) const
 {
     UErrorCode status = U_ZERO_ERROR;
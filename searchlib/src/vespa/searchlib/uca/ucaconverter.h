@@ -28,6 +28,8 @@ public:
     UcaConverter(std::string_view locale, std::string_view strength);
     ~UcaConverter() override;
     const Collator & getCollator() const { return *_collator; }
+    std::string id() const override;
+    BlobConverter::UP clone() const override;
 private:
     struct Buffer {
         std::string _data;
@@ -59,6 +61,8 @@ private:
     mutable Buffer               _buffer;
     mutable std::vector<UChar>   _u16Buffer;
     std::unique_ptr<Collator>      _collator;
+    std::string                  _locale;
+    std::string                  _strength;
 };
 
 }
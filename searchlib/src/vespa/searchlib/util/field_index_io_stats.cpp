@@ -6,7 +6,8 @@
 namespace search {
 
 std::ostream& operator<<(std::ostream& os, const FieldIndexIoStats& stats) {
-    os << "{read: " << stats.read() << ", cached_read: " << stats.cached_read() << "}";
+    os << "{read: " << stats.read() << ", cached_read: " << stats.cached_read() <<
+        ", direct_io_read: " << stats.direct_io_read() << "}";
     return os;
 }
 
@@ -9,28 +9,34 @@ namespace search {
  * Class tracking disk io for a single field.
  */
 class FieldIndexIoStats {
-    DiskIoStats _read;        // cache miss
-    DiskIoStats _cached_read; // cache hit
+    DiskIoStats _read;           // cache miss
+    DiskIoStats _cached_read;    // cache hit
+    DiskIoStats _direct_io_read; // cache miss bypassing the OS page cache, also part of _read
 
 public:
     FieldIndexIoStats() noexcept
         : _read(),
-          _cached_read()
+          _cached_read(),
+          _direct_io_read()
     {
     }
 
     FieldIndexIoStats& read(const DiskIoStats& value) { _read = value; return *this; }
     FieldIndexIoStats& cached_read(DiskIoStats& value) { _cached_read = value; return *this; }
+    FieldIndexIoStats& direct_io_read(const DiskIoStats& value) { _direct_io_read = value; return *this; }
     const DiskIoStats& read() const noexcept { return _read; }
     const DiskIoStats& cached_read() const noexcept { return _cached_read; }
+    const DiskIoStats& direct_io_read() const noexcept { return _direct_io_read; }
     void merge(const FieldIndexIoStats& rhs) noexcept {
         _read.merge(rhs.read());
         _cached_read.merge(rhs.cached_read());
+        _direct_io_read.merge(rhs.direct_io_read());
     }
 
     bool operator==(const FieldIndexIoStats &rhs) const noexcept {
         return _read == rhs.read() &&
-               _cached_read == rhs.cached_read();
+               _cached_read == rhs.cached_read() &&
+               _direct_io_read == rhs.direct_io_read();
     }
     FieldIndexIoStats read_and_maybe_clear(bool clear_disk_io_stats) noexcept {
         auto result = *this;
@@ -42,8 +48,13 @@ public:
     void clear() noexcept {
         _read.clear();
         _cached_read.clear();
+        _direct_io_read.clear();
     }
     void add_uncached_read_operation(uint64_t bytes) noexcept { _read.add_read_operation(bytes); }
+    void add_uncached_direct_io_read_operation(uint64_t bytes) noexcept {
+        _read.add_read_operation(bytes);
+        _direct_io_read.add_read_operation(bytes);
+    }
     void add_cached_read_operation(uint64_t bytes) noexcept { _cached_read.add_read_operation(bytes); }
 };
 
@@ -16,12 +16,17 @@ private:
     vespalib::MemoryUsage _memory_usage;
     size_t _size_on_disk; // in bytes
     FieldIndexIoStats _io_stats;
+    // Size of features in memory index, uncompressed and as stored
+    uint64_t _raw_feature_bytes;
+    uint64_t _stored_feature_bytes;
 
 public:
     FieldIndexStats() noexcept
         : _memory_usage(),
           _size_on_disk(0),
-          _io_stats()
+          _io_stats(),
+          _raw_feature_bytes(0),
+          _stored_feature_bytes(0)
     {}
     FieldIndexStats &memory_usage(const vespalib::MemoryUsage &usage) noexcept {
         _memory_usage = usage;
@@ -37,16 +42,31 @@ public:
     FieldIndexStats& io_stats(const FieldIndexIoStats& stats) { _io_stats = stats; return *this; }
     const FieldIndexIoStats& io_stats() const noexcept { return _io_stats; }
 
+    FieldIndexStats& feature_bytes(uint64_t raw, uint64_t stored) noexcept {
+        _raw_feature_bytes = raw;
+        _stored_feature_bytes = stored;
+        return *this;
+    }
+    uint64_t raw_feature_bytes() const noexcept { return _raw_feature_bytes; }
+    uint64_t stored_feature_bytes() const noexcept { return _stored_feature_bytes; }
+    double feature_compression_ratio() const noexcept {
+        return (_stored_feature_bytes != 0) ? (double(_raw_feature_bytes) / _stored_feature_bytes) : 0.0;
+    }
+
     void merge(const FieldIndexStats &rhs) noexcept {
         _memory_usage.merge(rhs._memory_usage);
         _size_on_disk += rhs._size_on_disk;
         _io_stats.merge(rhs._io_stats);
+        _raw_feature_bytes += rhs._raw_feature_bytes;
+        _stored_feature_bytes += rhs._stored_feature_bytes;
     }
 
     bool operator==(const FieldIndexStats& rhs) const noexcept {
         return _memory_usage == rhs._memory_usage &&
                _size_on_disk == rhs._size_on_disk &&
-               _io_stats == rhs._io_stats;
+               _io_stats == rhs._io_stats &&
+               _raw_feature_bytes == rhs._raw_feature_bytes &&
+               _stored_feature_bytes == rhs._stored_feature_bytes;
     }
 };
 
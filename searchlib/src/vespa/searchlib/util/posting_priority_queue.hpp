@@ -3,6 +3,8 @@
 #pragma once
 
 #include "posting_priority_queue.h"
+#include <algorithm>
+#include <cassert>
 
 namespace search {
 
@@ -9,11 +9,30 @@ namespace search {
 /*
  * Provide priority queue semantics for a set of posting readers with
  * merging to a posting writer.
+ *
+ * With many readers (at least tournament limit), a tournament tree of
+ * losers is used instead of the sorted vector, replacing the shifting of
+ * vector elements for each written entry with log2(readers) comparisons
+ * selected without branches.
  */
 template <class Reader, class Writer>
 class PostingPriorityQueueMerger : public PostingPriorityQueue<Reader>
 {
     uint32_t _merge_chunk;
+    uint32_t _tournament_limit;
+    std::vector<uint32_t> _losers; // Tournament tree, index 0 is the winner
+    uint32_t _leaves;
+
+    // Exhausted readers and padding leaves lose against everything
+    bool wins(uint32_t lhs, uint32_t rhs) const noexcept {
+        const Reader *l = (lhs < _vec.size()) ? _vec[lhs].get() : nullptr;
+        const Reader *r = (rhs < _vec.size()) ? _vec[rhs].get() : nullptr;
+        bool l_valid = (l != nullptr) && l->isValid();
+        bool r_valid = (r != nullptr) && r->isValid();
+        return l_valid && (!r_valid || (*l < *r));
+    }
+    void setup_tournament();
+    void replay_tournament(uint32_t leaf) noexcept;
 public:
     using Parent = PostingPriorityQueue<Reader>;
     using Vector = typename Parent::Vector;
@@ -26,12 +45,19 @@ public:
 
     PostingPriorityQueueMerger()
         : Parent(),
-          _merge_chunk(0u)
+          _merge_chunk(0u),
+          _tournament_limit(0u),
+          _losers(),
+          _leaves(0u)
     {
     }
 
     void set_merge_chunk(uint32_t merge_chunk) { _merge_chunk = merge_chunk; }
+    // Use tournament tree when merging at least tournament_limit readers, 0 disables it
+    void set_tournament_limit(uint32_t tournament_limit) { _tournament_limit = tournament_limit; }
+    bool uses_tournament() const noexcept { return _tournament_limit > 0u && _vec.size() >= _tournament_limit; }
     void mergeHeap(Writer& writer, const IFlushToken& flush_token, uint32_t remaining_merge_chunk) __attribute__((noinline));
+    void mergeTournament(Writer& writer, const IFlushToken& flush_token, uint32_t remaining_merge_chunk) __attribute__((noinline));
     static void mergeOne(Writer& writer, Reader& reader, const IFlushToken &flush_token, uint32_t remaining_merge_chunk) __attribute__((noinline));
     static void mergeTwo(Writer& writer, Reader& reader1, Reader& reader2, const IFlushToken& flush_token, uint32_t& remaining_merge_chunk) __attribute__((noinline));
     static void mergeSmall(Writer& writer, typename Vector::iterator ib, typename Vector::iterator ie, const IFlushToken &flush_token, uint32_t& remaining_merge_chunk) __attribute__((noinline));
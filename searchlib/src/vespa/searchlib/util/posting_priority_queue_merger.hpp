@@ -20,6 +20,67 @@ PostingPriorityQueueMerger<Reader, Writer>::mergeHeap(Writer& writer, const IFlu
     }
 }
 
+template <class Reader, class Writer>
+void
+PostingPriorityQueueMerger<Reader, Writer>::setup_tournament()
+{
+    _leaves = 1u;
+    while (_leaves < _vec.size()) {
+        _leaves *= 2;
+    }
+    // Play all matches bottom up, remembering the loser of each match
+    std::vector<uint32_t> winners(2 * _leaves);
+    for (uint32_t leaf = 0; leaf < _leaves; ++leaf) {
+        winners[_leaves + leaf] = leaf;
+    }
+    _losers.assign(_leaves, 0u);
+    for (uint32_t node = _leaves - 1; node > 0; --node) {
+        uint32_t lhs = winners[2 * node];
+        uint32_t rhs = winners[2 * node + 1];
+        bool rhs_wins = wins(rhs, lhs);
+        winners[node] = rhs_wins ? rhs : lhs;
+        _losers[node] = rhs_wins ? lhs : rhs;
+    }
+    _losers[0] = winners[1];
+}
+
+template <class Reader, class Writer>
+void
+PostingPriorityQueueMerger<Reader, Writer>::replay_tournament(uint32_t leaf) noexcept
+{
+    uint32_t winner = leaf;
+    for (uint32_t node = (_leaves + leaf) / 2; node > 0; node /= 2) {
+        uint32_t challenger = _losers[node];
+        bool challenger_wins = wins(challenger, winner);
+        _losers[node] = challenger_wins ? winner : challenger;
+        winner = challenger_wins ? challenger : winner;
+    }
+    _losers[0] = winner;
+}
+
+template <class Reader, class Writer>
+void
+PostingPriorityQueueMerger<Reader, Writer>::mergeTournament(Writer& writer, const IFlushToken& flush_token, uint32_t remaining_merge_chunk)
+{
+    if (_losers.empty()) {
+        setup_tournament();
+    }
+    while (remaining_merge_chunk > 0u && !flush_token.stop_requested()) {
+        uint32_t winner = _losers[0];
+        Reader *low = _vec[winner].get();
+        low->write(writer);
+        low->read();
+        replay_tournament(winner);
+        --remaining_merge_chunk;
+        if (!wins(_losers[0], _leaves)) {
+            // All readers are exhausted
+            _vec.clear();
+            _losers.clear();
+            return;
+        }
+    }
+}
+
 template <class Reader, class Writer>
 void
 PostingPriorityQueueMerger<Reader, Writer>::mergeOne(Writer& writer, Reader& reader, const IFlushToken& flush_token, uint32_t remaining_merge_chunk)
@@ -73,6 +134,10 @@ PostingPriorityQueueMerger<Reader, Writer>::merge(Writer& writer, const IFlushTo
         return;
     assert(_heap_limit > 0u);
     uint32_t remaining_merge_chunk = _merge_chunk;
+    if (uses_tournament()) {
+        mergeTournament(writer, flush_token, remaining_merge_chunk);
+        return;
+    }
     if (_vec.size() >= _heap_limit) {
         void (PostingPriorityQueueMerger::*mergeHeapFunc)(Writer& writer, const IFlushToken& flush_token, uint32_t remaining_merge_chunk) =
             &PostingPriorityQueueMerger::mergeHeap;
@@ -9,6 +9,7 @@
 #include <vespa/document/repo/configbuilder.h>
 #include <vespa/document/repo/fixedtyperepo.h>
 #include <vespa/juniper/juniper_separators.h>
+#include <vespa/juniper/token_list.h>
 #include <vespa/searchlib/util/linguisticsannotation.h>
 #include <vespa/searchsummary/docsummary/annotation_converter.h>
 #include <vespa/searchsummary/docsummary/i_juniper_converter.h>
@@ -45,13 +46,35 @@ get_document_types_config()
 
 class MockJuniperConverter : public IJuniperConverter
 {
-    std::string _result;
+    std::string              _result;
+    bool                     _use_indexed_tokens;
+    std::vector<std::string> _tokens;
 public:
+    MockJuniperConverter(bool use_indexed_tokens = false)
+        : _result(), _use_indexed_tokens(use_indexed_tokens), _tokens()
+    {
+    }
     ~MockJuniperConverter() override;
     void convert(std::string_view input, vespalib::slime::Inserter&) override {
         _result = input;
     }
+    bool use_indexed_tokens() const noexcept override { return _use_indexed_tokens; }
+    void convert(std::string_view input, const juniper::TokenList& tokens, vespalib::slime::Inserter&) override {
+        _result = input;
+        for (const auto& entry : tokens.entries()) {
+            // Text covered by the token followed by its normalized form
+            std::string token(input.substr(entry.bytepos, entry.bytelen));
+            token += "=";
+            token += std::string(entry.len, ' ');
+            for (uint32_t i = 0; i < entry.len; ++i) {
+                auto c = tokens.token(entry)[i];
+                token[entry.bytelen + 1 + i] = (c < 0x80) ? static_cast<char>(c) : '#';
+            }
+            _tokens.emplace_back(std::move(token));
+        }
+    }
     const std::string& get_result() const noexcept { return _result; }
+    const std::vector<std::string>& get_tokens() const noexcept { return _tokens; }
 };
 
 MockJuniperConverter::~MockJuniperConverter() = default;
@@ -74,6 +97,8 @@ protected:
     std::string make_exp_il_annotated_string();
     std::string make_exp_il_annotated_chinese_string();
     void expect_annotated(const std::string& exp, const StringFieldValue& fv);
+    void expect_tokens(const std::vector<std::string>& exp, const std::string& exp_annotated,
+                       const StringFieldValue& fv);
 };
 
 AnnotationConverterTest::AnnotationConverterTest()
@@ -155,6 +180,19 @@ AnnotationConverterTest::expect_annotated(const std::string& exp, const StringFi
     EXPECT_EQ(exp, juniper_converter.get_result());
 }
 
+void
+AnnotationConverterTest::expect_tokens(const std::vector<std::string>& exp, const std::string& exp_annotated,
+                                       const StringFieldValue& fv)
+{
+    MockJuniperConverter juniper_converter(true);
+    AnnotationConverter annotation_converter(juniper_converter);
+    Slime slime;
+    SlimeInserter inserter(slime);
+    annotation_converter.convert(fv, inserter);
+    EXPECT_EQ(exp_annotated, juniper_converter.get_result());
+    EXPECT_EQ(exp, juniper_converter.get_tokens());
+}
+
 
 TEST_F(AnnotationConverterTest, convert_plain_string)
 {
@@ -216,4 +254,22 @@ TEST_F(AnnotationConverterTest, convert_annotated_overlaps)
     expect_annotated(exp, annotated_overlaps);
 }
 
+TEST_F(AnnotationConverterTest, indexed_tokens_are_passed_to_juniper_converter)
+{
+    using namespace juniper::separators;
+    std::string il_bar = interlinear_annotation_anchor_string + "bar" + interlinear_annotation_separator_string +
+                         "baz" + interlinear_annotation_terminator_string;
+    expect_tokens({"foo=foo", il_bar + "=#bar#baz#"}, make_exp_il_annotated_string(), make_annotated_string());
+    std::string il_abcde = interlinear_annotation_anchor_string + "abcde" + interlinear_annotation_separator_string +
+                           "ab abcde bcd de" + interlinear_annotation_terminator_string;
+    expect_tokens({il_abcde + "=#abcde#ab abcde bcd de#", "fg=fg"}, make_exp_overlaps(), make_annotated_overlaps());
+}
+
+TEST_F(AnnotationConverterTest, no_indexed_tokens_are_passed_for_plain_string)
+{
+    using namespace juniper::separators;
+    StringFieldValue plain_string("Foo Bar Baz");
+    expect_tokens({}, "Foo Bar Baz" + unit_separator_string, plain_string);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,138 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchsummary/docsummary/rendered_docsum_cache.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using search::docsummary::RenderedDocsumCache;
+using vespalib::Slime;
+using vespalib::slime::SlimeInserter;
+
+namespace {
+
+Slime
+make_docsum(const std::string& title)
+{
+    Slime docsum;
+    docsum.setObject().setString("title", title);
+    return docsum;
+}
+
+}
+
+class RenderedDocsumCacheTest : public ::testing::Test {
+protected:
+    RenderedDocsumCache _cache;
+    uint32_t            _config_id;
+
+    RenderedDocsumCacheTest();
+    ~RenderedDocsumCacheTest() override;
+
+    void insert(uint32_t lid, const std::string& class_name, const std::string& title) {
+        _cache.insert(lid, _config_id, class_name, _cache.get_generation(lid), make_docsum(title));
+    }
+    std::string lookup(uint32_t lid, const std::string& class_name) const {
+        return lookup(lid, _config_id, class_name);
+    }
+    std::string lookup(uint32_t lid, uint32_t config_id, const std::string& class_name) const {
+        Slime result;
+        if (!_cache.lookup(lid, config_id, class_name, SlimeInserter(result))) {
+            return "<miss>";
+        }
+        return std::string(result.get()["title"].asString().make_stringview());
+    }
+};
+
+RenderedDocsumCacheTest::RenderedDocsumCacheTest()
+    : ::testing::Test(),
+      _cache(100000),
+      _config_id(_cache.make_config_id())
+{
+}
+
+RenderedDocsumCacheTest::~RenderedDocsumCacheTest() = default;
+
+TEST_F(RenderedDocsumCacheTest, inserted_docsums_are_returned_per_lid_and_class)
+{
+    EXPECT_TRUE(_cache.enabled());
+    EXPECT_EQ("<miss>", lookup(1, "default"));
+    insert(1, "default", "one");
+    insert(1, "short", "short one");
+    insert(2, "default", "two");
+    EXPECT_EQ("one", lookup(1, "default"));
+    EXPECT_EQ("short one", lookup(1, "short"));
+    EXPECT_EQ("two", lookup(2, "default"));
+    EXPECT_EQ("<miss>", lookup(2, "short"));
+    EXPECT_EQ("<miss>", lookup(3, "default"));
+}
+
+TEST_F(RenderedDocsumCacheTest, invalidate_removes_all_classes_of_lid)
+{
+    insert(1, "default", "one");
+    insert(1, "short", "short one");
+    insert(2, "default", "two");
+    _cache.invalidate(1);
+    EXPECT_EQ("<miss>", lookup(1, "default"));
+    EXPECT_EQ("<miss>", lookup(1, "short"));
+    EXPECT_EQ("two", lookup(2, "default"));
+    insert(1, "default", "new one");
+    EXPECT_EQ("new one", lookup(1, "default"));
+}
+
+TEST_F(RenderedDocsumCacheTest, docsum_rendered_before_invalidation_is_not_inserted)
+{
+    uint64_t generation = _cache.get_generation(1);
+    _cache.invalidate(1);
+    _cache.insert(1, _config_id, "default", generation, make_docsum("stale"));
+    EXPECT_EQ("<miss>", lookup(1, "default"));
+    _cache.insert(1, _config_id, "default", _cache.get_generation(1), make_docsum("fresh"));
+    EXPECT_EQ("fresh", lookup(1, "default"));
+}
+
+TEST_F(RenderedDocsumCacheTest, docsums_from_other_summary_config_are_not_returned)
+{
+    uint32_t new_config_id = _cache.make_config_id();
+    EXPECT_NE(_config_id, new_config_id);
+    insert(1, "default", "one");
+    EXPECT_EQ("<miss>", lookup(1, new_config_id, "default"));
+    _cache.insert(1, new_config_id, "default", _cache.get_generation(1), make_docsum("new config"));
+    EXPECT_EQ("one", lookup(1, "default"));
+    EXPECT_EQ("new config", lookup(1, new_config_id, "default"));
+}
+
+TEST_F(RenderedDocsumCacheTest, clear_drops_all_docsums)
+{
+    insert(1, "default", "one");
+    uint64_t generation = _cache.get_generation(2);
+    _cache.clear();
+    _cache.insert(2, _config_id, "default", generation, make_docsum("stale"));
+    EXPECT_EQ("<miss>", lookup(1, "default"));
+    EXPECT_EQ("<miss>", lookup(2, "default"));
+    insert(1, "default", "one again");
+    EXPECT_EQ("one again", lookup(1, "default"));
+}
+
+TEST_F(RenderedDocsumCacheTest, disabling_cache_drops_all_docsums)
+{
+    insert(1, "default", "one");
+    _cache.set_max_bytes(0);
+    EXPECT_FALSE(_cache.enabled());
+    _cache.set_max_bytes(100000);
+    EXPECT_TRUE(_cache.enabled());
+    EXPECT_EQ("<miss>", lookup(1, "default"));
+}
+
+TEST_F(RenderedDocsumCacheTest, cache_size_is_bounded)
+{
+    _cache.set_max_bytes(2000);
+    for (uint32_t lid = 1; lid <= 100; ++lid) {
+        insert(lid, "default", std::string(100, 'x'));
+    }
+    auto stats = _cache.get_stats();
+    EXPECT_LE(stats.memory_used, 2000u);
+    EXPECT_LT(stats.elements, 100u);
+    EXPECT_EQ("<miss>", lookup(1, "default"));
+    EXPECT_EQ(std::string(100, 'x'), lookup(100, "default"));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -11,9 +11,11 @@ using namespace search::docsummary;
 class MockWriter : public DocsumFieldWriter {
 private:
     bool _generated;
+    bool _query_dependent;
 public:
-    MockWriter(bool generated) : _generated(generated) {}
+    MockWriter(bool generated, bool query_dependent = false) : _generated(generated), _query_dependent(query_dependent) {}
     bool isGenerated() const override { return _generated; }
+    bool isQueryDependent() const override { return _query_dependent; }
     void insert_field(uint32_t, const IDocsumStoreDocument*, GetDocsumsState&,
                       ElementIds,
                       vespalib::slime::Inserter &) const override {}
@@ -43,4 +45,23 @@ TEST(ResultClassTest, all_fields_in_class_are_generated)
     EXPECT_TRUE(rc.all_fields_generated({"generated_1"}));
 }
 
+TEST(ResultClassTest, class_is_query_dependent_if_any_field_depends_on_query)
+{
+    ResultClass rc("test");
+    rc.addConfigEntry("from_disk");
+    rc.addConfigEntry("generated", SummaryElementsSelector::select_all(), std::make_unique<MockWriter>(true));
+    EXPECT_FALSE(rc.is_query_dependent());
+    rc.addConfigEntry("teaser", SummaryElementsSelector::select_all(), std::make_unique<MockWriter>(false, true));
+    EXPECT_TRUE(rc.is_query_dependent());
+}
+
+TEST(ResultClassTest, class_is_query_dependent_if_elements_are_selected_by_match)
+{
+    ResultClass rc("test");
+    rc.addConfigEntry("array", SummaryElementsSelector::select_all(), std::make_unique<MockWriter>(false));
+    EXPECT_FALSE(rc.is_query_dependent());
+    rc.addConfigEntry("matched_array", SummaryElementsSelector::select_by_match("array", {}), std::make_unique<MockWriter>(false));
+    EXPECT_TRUE(rc.is_query_dependent());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
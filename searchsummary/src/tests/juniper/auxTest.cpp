@@ -7,6 +7,7 @@
 #include <cctype>
 #include <vespa/fastos/file.h>
 #include <vespa/juniper/juniper_separators.h>
+#include <vespa/juniper/token_list.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".auxtest");
@@ -603,6 +604,22 @@ Ctx::Ctx(const std::string& text_, QB& qb_)
 }
 Ctx::~Ctx() = default;
 
+TEST(AuxTest, testPrecomputedTokens) {
+    std::string              text = "Foo, bar";
+    Fast_NormalizeWordFolder wf;
+    TokenProcessor           tp(text);
+    juniper::TokenList       tokens;
+    tokens.add(0, 3, "foo");
+    tokens.add(5, 3, "bar");
+    // Tokens outside the text are ignored
+    tokens.add(9, 3, "baz");
+    JuniperTokenizer jt(&wf, text.c_str(), text.size(), &tp);
+    jt.setTokens(&tokens);
+    jt.scan();
+    std::vector<std::string> exp({"Foo", "bar", ""});
+    EXPECT_EQ(exp, tp.getTokens());
+}
+
 TEST(AuxTest, testSpecialTokenRegistry) {
     {
         using CharStream = SpecialTokenRegistry::CharStream;
@@ -35,6 +35,7 @@ Config::Config(const char* config_name, const Juniper& juniper)
     const char*          preserve_white_space = GetProp("dynsum.preserve_white_space", "off");
     size_t               match_winsize = strtol(GetProp("matcher.winsize", "200"), nullptr, 0);
     size_t               max_match_candidates = atoi(GetProp("matcher.max_match_candidates", "1000"));
+    const char*          use_indexed_tokens = GetProp("matcher.use_indexed_tokens", "off");
     const char*          seps = GetProp("dynsum.separators", separators.c_str());
     const unsigned char* cons =
         reinterpret_cast<const unsigned char*>(GetProp("dynsum.connectors", separators.c_str()));
@@ -55,7 +56,8 @@ Config::Config(const char* config_name, const Juniper& juniper)
         .SetMatchWindowSize(match_winsize)
         .SetMaxMatchCandidates(max_match_candidates)
         .SetWordFolder(&_juniper.getWordFolder())
-        .SetProximityFactor(proximity_factor);
+        .SetProximityFactor(proximity_factor)
+        .SetUseIndexedTokens(StringToConfigFlag(use_indexed_tokens) == CF_ON);
 }
 
 Config::~Config() {
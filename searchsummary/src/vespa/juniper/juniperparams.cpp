@@ -76,7 +76,8 @@ MatcherParams::MatcherParams()
     _stem_min(0),
     _stem_extend(0),
     _wordfolder(nullptr),
-    _proximity_factor(1.0) {}
+    _proximity_factor(1.0),
+    _use_indexed_tokens(false) {}
 
 MatcherParams& MatcherParams::SetMatchWindowSize(size_t winsize) {
     _match_winsize = winsize;
@@ -124,6 +125,16 @@ MatcherParams& MatcherParams::SetProximityFactor(double factor) {
     return *this;
 }
 
+MatcherParams& MatcherParams::SetUseIndexedTokens(bool use_indexed_tokens) {
+    _use_indexed_tokens = use_indexed_tokens;
+    return *this;
+}
+
 bool operator==(MatcherParams& mp1, MatcherParams& mp2) {
-    return memcmp(&mp1, &mp2, sizeof(MatcherParams)) == 0;
+    // Compare members explicitly as padding bytes are not initialized
+    return mp1.MatchWindowSize() == mp2.MatchWindowSize() &&
+           mp1.MatchWindowSizeFallbackMultiplier() == mp2.MatchWindowSizeFallbackMultiplier() &&
+           mp1.MaxMatchCandidates() == mp2.MaxMatchCandidates() && mp1.StemMinLength() == mp2.StemMinLength() &&
+           mp1.StemMaxExtend() == mp2.StemMaxExtend() && mp1.WordFolder() == mp2.WordFolder() &&
+           mp1.ProximityFactor() == mp2.ProximityFactor() && mp1.UseIndexedTokens() == mp2.UseIndexedTokens();
 }
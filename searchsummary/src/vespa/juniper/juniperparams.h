@@ -67,6 +67,10 @@ public:
     MatcherParams& SetProximityFactor(double factor);
     double         ProximityFactor() const noexcept { return _proximity_factor; };
 
+    // Use the tokens computed at indexing time instead of tokenizing the text again
+    MatcherParams& SetUseIndexedTokens(bool use_indexed_tokens);
+    bool           UseIndexedTokens() const noexcept { return _use_indexed_tokens; }
+
 private:
     size_t                 _match_winsize;
     double                 _match_winsize_fallback_multiplier;
@@ -75,6 +79,7 @@ private:
     size_t                 _stem_extend;
     const Fast_WordFolder* _wordfolder; // The wordfolder object needed as 1st parameter to folderfun
     double                 _proximity_factor;
+    bool                   _use_indexed_tokens;
 };
 
 bool operator==(MatcherParams& mp1, MatcherParams& mp2);
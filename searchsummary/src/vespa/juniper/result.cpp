@@ -26,7 +26,8 @@ public:
     std::string _text;
 };
 
-Result::Result(const Config& config, QueryHandle& qhandle, const char* docsum, size_t docsum_len)
+Result::Result(const Config& config, QueryHandle& qhandle, const char* docsum, size_t docsum_len,
+               const TokenList* tokens)
   : _qhandle(&qhandle),
     _mo(qhandle.MatchObj()),
     _docsum(docsum),
@@ -87,6 +88,7 @@ Result::Result(const Config& config, QueryHandle& qhandle, const char* docsum, s
 
     _tokenizer->SetSuccessor(_matcher.get());
     if (!_registry->getSpecialTokens().empty()) { _tokenizer->setRegistry(_registry.get()); }
+    _tokenizer->setTokens(tokens);
 }
 
 Result::~Result() = default;
@@ -12,7 +12,8 @@ namespace juniper {
 
 class Result {
 public:
-    Result(const Config& config, QueryHandle& qhandle, const char* docsum, size_t docsum_len);
+    Result(const Config& config, QueryHandle& qhandle, const char* docsum, size_t docsum_len,
+           const TokenList* tokens = nullptr);
     ~Result();
 
     inline void Scan() {
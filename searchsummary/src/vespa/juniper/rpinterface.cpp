@@ -63,9 +63,9 @@ std::unique_ptr<QueryHandle> Juniper::CreateQueryHandle(const IQuery& fquery, co
 }
 
 std::unique_ptr<Result> Analyse(const Config& config, QueryHandle& qhandle, const char* docsum, size_t docsum_len,
-                                uint32_t docid) {
+                                uint32_t docid, const TokenList* tokens) {
     LOG(debug, "juniper::Analyse(): docId(%u), docsumLen(%zu), docsum(%s)", docid, docsum_len, docsum);
-    return std::make_unique<Result>(config, qhandle, docsum, docsum_len);
+    return std::make_unique<Result>(config, qhandle, docsum, docsum_len, tokens);
 }
 
 long GetRelevancy(Result& result_handle) {
@@ -56,6 +56,10 @@ class QueryHandle;
  */
 class Result;
 
+/** Tokens of a document summary computed ahead of analysis, see token_list.h
+ */
+class TokenList;
+
 class Summary {
 public:
     virtual ~Summary() = default;
@@ -144,10 +148,13 @@ bool AnalyseCompatible(Config* conf1, Config* conf2);
  * @param docsum_len The length in bytes of the document summary, including
  any meta information.
  * @param docid A 32 bit number uniquely identifying the document to be analysed
+ * @param tokens Optional tokens for the document summary, computed at indexing time.
+ *    If given, the document summary is not tokenized again. Must refer to byte
+ *    positions in the document summary.
  * @return A unique pointer to a Result
  */
 std::unique_ptr<Result> Analyse(const Config& config, QueryHandle& query, const char* docsum, size_t docsum_len,
-                                uint32_t docid);
+                                uint32_t docid, const TokenList* tokens = nullptr);
 
 /** Get the computed relevancy of the processed content from the result.
  *  @param result_handle The result to retrieve from
@@ -0,0 +1,37 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "token_list.h"
+
+namespace juniper {
+
+TokenList::TokenList() noexcept
+    : _entries(),
+      _buffer()
+{
+}
+
+TokenList::~TokenList() = default;
+
+void
+TokenList::add(uint32_t bytepos, uint32_t bytelen, std::string_view normalized)
+{
+    if (normalized.empty()) {
+        return;
+    }
+    uint32_t offset = _buffer.size();
+    const char* src = normalized.data();
+    const char* src_end = src + normalized.size();
+    while (src < src_end) {
+        _buffer.push_back(Fast_UnicodeUtil::GetUTF8Char(src));
+    }
+    _entries.push_back(Entry{bytepos, bytelen, offset, static_cast<uint32_t>(_buffer.size() - offset)});
+}
+
+void
+TokenList::clear() noexcept
+{
+    _entries.clear();
+    _buffer.clear();
+}
+
+}
@@ -0,0 +1,45 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/fastlib/text/unicodeutil.h>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace juniper {
+
+/*
+ * Compact list of tokens computed ahead of analysis for a text passed to
+ * juniper, holding the byte boundaries of each token in the text and its
+ * normalized form. When passed to Analyse(), the tokens are used by the
+ * matcher instead of tokenizing and folding the text again.
+ */
+class TokenList {
+public:
+    struct Entry {
+        uint32_t bytepos; // Position in bytes from start of the text
+        uint32_t bytelen; // Size in bytes of the token in the text
+        uint32_t offset;  // Offset of the normalized form in the token buffer
+        uint32_t len;     // Size in ucs4_t of the normalized form
+    };
+private:
+    std::vector<Entry>  _entries;
+    std::vector<ucs4_t> _buffer;
+public:
+    TokenList() noexcept;
+    TokenList(const TokenList&) = delete;
+    TokenList& operator=(const TokenList&) = delete;
+    ~TokenList();
+    /*
+     * Add a token, the normalized form is utf8 encoded and is used as is.
+     * Tokens must be added in text order.
+     */
+    void add(uint32_t bytepos, uint32_t bytelen, std::string_view normalized);
+    void clear() noexcept;
+    bool empty() const noexcept { return _entries.empty(); }
+    size_t size() const noexcept { return _entries.size(); }
+    const std::vector<Entry>& entries() const noexcept { return _entries; }
+    const ucs4_t* token(const Entry& entry) const noexcept { return _buffer.data() + entry.offset; }
+};
+
+}
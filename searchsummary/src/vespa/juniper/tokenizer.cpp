@@ -2,6 +2,7 @@
 //
 #include "tokenizer.h"
 #include "juniperdebug.h"
+#include "token_list.h"
 #include <cinttypes>
 #include <vespa/fastlib/text/wordfolder.h>
 
@@ -15,6 +16,7 @@ JuniperTokenizer::JuniperTokenizer(const Fast_WordFolder* wordfolder, const char
     _len(len),
     _successor(successor),
     _registry(registry),
+    _tokens(nullptr),
     _charpos(0),
     _wordpos(0),
     _buffer() {}
@@ -28,6 +30,10 @@ void JuniperTokenizer::SetText(const char* text, size_t len) {
 
 // Scan the input and dispatch to the successor
 void JuniperTokenizer::scan() {
+    if (_tokens != nullptr) {
+        scan_tokens();
+        return;
+    }
     ITokenProcessor::Token token;
 
     const char* src = _text;
@@ -65,3 +71,21 @@ void JuniperTokenizer::scan() {
     token.token = nullptr;
     _successor->handle_end(token);
 }
+
+// Dispatch the precomputed tokens to the successor
+void JuniperTokenizer::scan_tokens() {
+    ITokenProcessor::Token token;
+    for (const auto& entry : _tokens->entries()) {
+        if (entry.bytepos + entry.bytelen > _len) break;
+        token.curlen = entry.len;
+        token.token = _tokens->token(entry);
+        token.wordpos = _wordpos++;
+        token.bytepos = entry.bytepos;
+        token.bytelen = entry.bytelen;
+        _successor->handle_token(token);
+    }
+    token.bytepos = _len;
+    token.bytelen = 0;
+    token.token = nullptr;
+    _successor->handle_end(token);
+}
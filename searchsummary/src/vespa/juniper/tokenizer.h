@@ -5,6 +5,7 @@
 #include "specialtokenregistry.h"
 
 class Fast_WordFolder;
+namespace juniper { class TokenList; }
 
 #define TOKEN_DSTLEN 1024
 
@@ -14,6 +15,8 @@ public:
                      const juniper::SpecialTokenRegistry* registry = nullptr);
     inline void SetSuccessor(ITokenProcessor* successor) { _successor = successor; }
     void        setRegistry(const juniper::SpecialTokenRegistry* registry) { _registry = registry; }
+    // Use the given tokens for the text instead of tokenizing it
+    void        setTokens(const juniper::TokenList* tokens) { _tokens = tokens; }
 
     void SetText(const char* text, size_t len);
 
@@ -26,9 +29,11 @@ private:
     size_t                               _len;  // Length of the text input
     ITokenProcessor*                     _successor;
     const juniper::SpecialTokenRegistry* _registry;
+    const juniper::TokenList*            _tokens;
     off_t                                _charpos; // Last utf8 character position
     off_t  _wordpos;              // Offset in numbering of words compared to input (as result of splits)
     ucs4_t _buffer[TOKEN_DSTLEN]; // Temp. buffer to store folding result
+    void scan_tokens();
 private:
     JuniperTokenizer(const JuniperTokenizer&);
     JuniperTokenizer& operator=(const JuniperTokenizer&);
@@ -38,7 +38,9 @@ AnnotationConverter::AnnotationConverter(IJuniperConverter& juniper_converter)
     : IStringFieldConverter(),
       _juniper_converter(juniper_converter),
       _text(),
-      _out()
+      _out(),
+      _tokens(),
+      _use_tokens(false)
 {
 }
 
@@ -51,6 +53,9 @@ AnnotationConverter::handleAnnotations(const document::Span& span, ForwardIt it,
     if (annCnt > 1 || (annCnt == 1 && it->altered)) {
         annotateSpans(span, it, last);
     } else {
+        if (_use_tokens && annCnt == 1) {
+            _tokens.add(_out.size(), span.length(), it->word);
+        }
         _out << getSpanString(_text, span) << juniper::separators::unit_separator_string;
     }
 }
@@ -58,6 +63,7 @@ AnnotationConverter::handleAnnotations(const document::Span& span, ForwardIt it,
 template <typename ForwardIt>
 void
 AnnotationConverter::annotateSpans(const document::Span& span, ForwardIt it, ForwardIt last) {
+    size_t start = _out.size();
     _out << juniper::separators::interlinear_annotation_anchor_string  // ANCHOR
          << (getSpanString(_text, span))
          << juniper::separators::interlinear_annotation_separator_string; // SEPARATOR
@@ -67,8 +73,12 @@ AnnotationConverter::annotateSpans(const document::Span& span, ForwardIt it, For
             _out << " ";
         }
     }
-    _out << juniper::separators::interlinear_annotation_terminator_string  // TERMINATOR
-         << juniper::separators::unit_separator_string;
+    _out << juniper::separators::interlinear_annotation_terminator_string;  // TERMINATOR
+    if (_use_tokens) {
+        // The whole interlinear annotation is a single token, as when juniper tokenizes it
+        _tokens.add(start, _out.size() - start, _out.view().substr(start));
+    }
+    _out << juniper::separators::unit_separator_string;
 }
 
 void
@@ -114,9 +124,15 @@ void
 AnnotationConverter::convert(const StringFieldValue &input, vespalib::slime::Inserter& inserter)
 {
     _out.clear();
+    _tokens.clear();
+    _use_tokens = _juniper_converter.use_indexed_tokens();
     _text = input.getValueRef();
     handleIndexingTerms(input);
-    _juniper_converter.convert(_out.view(), inserter);
+    if (_use_tokens && !_tokens.empty()) {
+        _juniper_converter.convert(_out.view(), _tokens, inserter);
+    } else {
+        _juniper_converter.convert(_out.view(), inserter);
+    }
 }
 
 bool
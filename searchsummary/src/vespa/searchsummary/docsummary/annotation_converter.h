@@ -3,6 +3,7 @@
 #pragma once
 
 #include "i_string_field_converter.h"
+#include <vespa/juniper/token_list.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 
 namespace document { class Span; }
@@ -17,12 +18,18 @@ class IJuniperConverter;
  * Class converting a string field value with annotations into a string
  * with interlinear annotations used by juniper before passing it to
  * the juniper converter.
+ *
+ * If requested by the juniper converter, the tokens from the indexing
+ * annotations are passed along with their positions in the converted
+ * string, so that juniper does not need to tokenize it again.
  */
 class AnnotationConverter : public IStringFieldConverter
 {
     IJuniperConverter&     _juniper_converter;
     std::string_view    _text;
     vespalib::asciistream  _out;
+    juniper::TokenList     _tokens;
+    bool                   _use_tokens;
 
     template <typename ForwardIt>
     void handleAnnotations(const document::Span& span, ForwardIt it, ForwardIt last);
@@ -18,6 +18,12 @@ DocsumFieldWriter::isDefaultValue(uint32_t, const GetDocsumsState&) const
     return false;
 }
 
+bool
+DocsumFieldWriter::isQueryDependent() const
+{
+    return false;
+}
+
 bool
 DocsumFieldWriter::setFieldWriterStateIndex(uint32_t)
 {
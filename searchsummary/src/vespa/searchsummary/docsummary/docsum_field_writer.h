@@ -28,6 +28,8 @@ public:
     virtual void insert_field(uint32_t docid, const IDocsumStoreDocument* doc, GetDocsumsState& state, ElementIds selected_elements, vespalib::slime::Inserter &target) const = 0;
     virtual const std::string & getAttributeName() const;
     virtual bool isDefaultValue(uint32_t docid, const GetDocsumsState& state) const;
+    // Whether the written value depends on the query, e.g. teasers and features
+    virtual bool isQueryDependent() const;
     void setIndex(size_t v) { _index = v; }
     size_t getIndex() const { return _index; }
     virtual bool setFieldWriterStateIndex(uint32_t fieldWriterStateIndex);
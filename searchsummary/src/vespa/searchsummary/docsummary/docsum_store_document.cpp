@@ -7,6 +7,8 @@
 #include <vespa/document/datatype/datatype.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <algorithm>
+#include <functional>
 
 namespace search::docsummary {
 
@@ -36,22 +38,56 @@ DocsumStoreDocument::get_field_value(const std::string& field_name) const
     return DocsumStoreFieldValue();
 }
 
+/*
+ * Returns a value with only the selected elements of an array or map field, setting
+ * only_selected to true. Other fields are returned as is.
+ */
+DocsumStoreFieldValue
+DocsumStoreDocument::get_selected_elements(const std::string& field_name, ElementIds selected_elements, bool& only_selected) const
+{
+    only_selected = false;
+    if (!_document || selected_elements.all_elements() ||
+        std::adjacent_find(selected_elements.begin(), selected_elements.end(), std::greater_equal<>()) != selected_elements.end())
+    {
+        return get_field_value(field_name);
+    }
+    try {
+        const document::Field& field = _document->getField(field_name);
+        auto value(field.getDataType().createFieldValue());
+        if (!value || !(value->isA(document::FieldValue::Type::ARRAY) || value->isA(document::FieldValue::Type::MAP))) {
+            return get_field_value(field_name);
+        }
+        std::span<const uint32_t> element_ids(selected_elements.begin(), selected_elements.end());
+        if (_document->getFields().getSelectedElements(field, element_ids, *value)) {
+            only_selected = true;
+            return DocsumStoreFieldValue(std::move(value));
+        }
+    } catch (document::FieldNotFoundException&) {
+        // Field was not found in document type. Return empty value.
+    }
+    return DocsumStoreFieldValue();
+}
+
 void
 DocsumStoreDocument::insert_summary_field(const std::string& field_name, ElementIds selected_elements, vespalib::slime::Inserter& inserter, IStringFieldConverter* converter) const
 {
-    auto field_value = get_field_value(field_name);
+    bool only_selected = false;
+    auto field_value = get_selected_elements(field_name, selected_elements, only_selected);
     if (field_value) {
-        SlimeFiller::insert_summary_field(*field_value, selected_elements, inserter, converter);
+        SlimeFiller::insert_summary_field(*field_value, only_selected ? ElementIds::select_all() : selected_elements,
+                                          inserter, converter);
     }
 }
 
 void
 DocsumStoreDocument::insert_juniper_field(const std::string& field_name, ElementIds selected_elements, vespalib::slime::Inserter& inserter, IJuniperConverter& converter) const
 {
-    auto field_value = get_field_value(field_name);
+    bool only_selected = false;
+    auto field_value = get_selected_elements(field_name, selected_elements, only_selected);
     if (field_value) {
         AnnotationConverter stacked_converter(converter);
-        SlimeFiller::insert_juniper_field(*field_value, selected_elements, inserter, stacked_converter);
+        SlimeFiller::insert_juniper_field(*field_value, only_selected ? ElementIds::select_all() : selected_elements,
+                                          inserter, stacked_converter);
     }
 }
 
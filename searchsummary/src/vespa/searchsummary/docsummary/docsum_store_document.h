@@ -10,10 +10,15 @@ namespace search::docsummary {
 
 /**
  * Class providing access to a document retrieved from an IDocsumStore.
+ *
+ * Fields are deserialized on demand from the stored document. When only some
+ * elements of an array or map field are selected, only those elements are
+ * deserialized.
  **/
 class DocsumStoreDocument : public IDocsumStoreDocument
 {
     std::unique_ptr<document::Document> _document;
+    DocsumStoreFieldValue get_selected_elements(const std::string& field_name, ElementIds selected_elements, bool& only_selected) const;
 public:
     explicit DocsumStoreDocument(std::unique_ptr<document::Document> document);
     ~DocsumStoreDocument() override;
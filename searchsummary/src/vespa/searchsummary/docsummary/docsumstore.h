@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace search::docsummary {
 
@@ -20,8 +22,15 @@ public:
 
     /**
      * Get a docsum specific abstract of the document for the given local document id.
+     * Might be called by multiple threads when docsums are generated in parallel.
      **/
     virtual std::unique_ptr<const IDocsumStoreDocument> get_document(uint32_t docid) = 0;
+
+    /**
+     * Hint that the documents for the given local document ids will be fetched by
+     * get_document(), allowing the store to read them in one batch.
+     **/
+    virtual void prefetch(const std::vector<uint32_t>& docids) { (void) docids; }
 };
 
 }
@@ -5,10 +5,13 @@
 #include "docsum_field_writer_state.h"
 #include "summary_elements_selector.h"
 #include "i_docsum_store_document.h"
+#include "rendered_docsum_cache.h"
 #include <vespa/document/fieldvalue/fieldvalue.h>
 #include <vespa/searchlib/attribute/iattributemanager.h>
 #include <vespa/vespalib/util/issue.h>
+#include <vespa/vespalib/data/slime/inject.h>
 #include <vespa/vespalib/data/slime/inserter.h>
+#include <vespa/vespalib/data/slime/slime.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.docsummary.docsumwriter");
@@ -16,6 +19,7 @@ LOG_SETUP(".searchlib.docsummary.docsumwriter");
 using vespalib::Issue;
 using vespalib::Memory;
 using vespalib::slime::ObjectInserter;
+using vespalib::slime::SlimeInserter;
 
 namespace search::docsummary {
 
@@ -57,46 +61,94 @@ DynamicDocsumWriter::insertDocsum(const ResolveClassInfo & rci, uint32_t docid,
                                      inserter);
             }
         }
+    } else if (use_rendered_docsum_cache(rci, state)) {
+        insert_cached_docsum(rci, docid, state, docinfos, topInserter);
     } else {
-        // look up docsum entry
-        auto doc = docinfos.get_document(docid);
-        if (!doc) {
-            return; // Use empty docsum when document is gone
+        insert_stored_docsum(rci, docid, state, docinfos, topInserter);
+    }
+}
+
+bool
+DynamicDocsumWriter::use_rendered_docsum_cache(const ResolveClassInfo & rci, const GetDocsumsState& state) const
+{
+    // A field selection in the request gives a different docsum for the same class
+    return _renderedDocsumCache && _renderedDocsumCache->enabled() &&
+           !rci.res_class->is_query_dependent() && state._args.get_fields().empty();
+}
+
+void
+DynamicDocsumWriter::insert_stored_docsum(const ResolveClassInfo & rci, uint32_t docid, GetDocsumsState& state,
+                                          IDocsumStore &docinfos, Inserter& topInserter)
+{
+    // look up docsum entry
+    auto doc = docinfos.get_document(docid);
+    if (!doc) {
+        return; // Use empty docsum when document is gone
+    }
+    // insert docsum blob
+    vespalib::slime::Cursor & docsum = topInserter.insertObject();
+    for (uint32_t i = 0; i < rci.res_class->getNumEntries(); ++i) {
+        const ResConfigEntry *outCfg = rci.res_class->getEntry(i);
+        if (!state._args.need_field(outCfg->name())) {
+            continue;
         }
-        // insert docsum blob
-        vespalib::slime::Cursor & docsum = topInserter.insertObject();
-        for (uint32_t i = 0; i < rci.res_class->getNumEntries(); ++i) {
-            const ResConfigEntry *outCfg = rci.res_class->getEntry(i);
-            if (!state._args.need_field(outCfg->name())) {
-                continue;
+        auto& elements_selector = outCfg->elements_selector();
+        const DocsumFieldWriter *writer = outCfg->writer();
+        const Memory field_name(outCfg->name().data(), outCfg->name().size());
+        ObjectInserter inserter(docsum, field_name);
+        if (writer != nullptr) {
+            if (! writer->isDefaultValue(docid, state)) {
+                writer->insert_field(docid, doc.get(), state, elements_selector.get_selected_elements(docid, state),
+                                     inserter);
             }
-            auto& elements_selector = outCfg->elements_selector();
-            const DocsumFieldWriter *writer = outCfg->writer();
-            const Memory field_name(outCfg->name().data(), outCfg->name().size());
-            ObjectInserter inserter(docsum, field_name);
-            if (writer != nullptr) {
-                if (! writer->isDefaultValue(docid, state)) {
-                    writer->insert_field(docid, doc.get(), state, elements_selector.get_selected_elements(docid, state),
-                                         inserter);
-                }
-            } else {
-                if (doc) {
-                    doc->insert_summary_field(outCfg->name(), elements_selector.get_selected_elements(docid, state),
-                                              inserter);
-                }
+        } else {
+            if (doc) {
+                doc->insert_summary_field(outCfg->name(), elements_selector.get_selected_elements(docid, state),
+                                          inserter);
             }
         }
     }
 }
 
+void
+DynamicDocsumWriter::insert_cached_docsum(const ResolveClassInfo & rci, uint32_t docid, GetDocsumsState& state,
+                                          IDocsumStore &docinfos, Inserter& topInserter)
+{
+    const std::string & class_name = rci.res_class->name();
+    // Sample the generation before reading the document, to detect changes while rendering
+    uint64_t generation = _renderedDocsumCache->get_generation(docid);
+    if (_renderedDocsumCache->lookup(docid, _renderedDocsumConfigId, class_name, topInserter)) {
+        return;
+    }
+    vespalib::Slime rendered;
+    SlimeInserter inserter(rendered);
+    insert_stored_docsum(rci, docid, state, docinfos, inserter);
+    if (rendered.get().valid()) {
+        _renderedDocsumCache->insert(docid, _renderedDocsumConfigId, class_name, generation, rendered);
+        vespalib::slime::inject(rendered.get(), topInserter);
+    }
+}
+
 DynamicDocsumWriter::DynamicDocsumWriter(std::unique_ptr<ResultConfig> config)
-    : _resultConfig(std::move(config))
+    : _resultConfig(std::move(config)),
+      _renderedDocsumCache(),
+      _renderedDocsumConfigId(0)
 {
 }
 
 
 DynamicDocsumWriter::~DynamicDocsumWriter() = default;
 
+void
+DynamicDocsumWriter::set_rendered_docsum_cache(std::shared_ptr<RenderedDocsumCache> cache)
+{
+    _renderedDocsumCache = std::move(cache);
+    if (_renderedDocsumCache) {
+        // Docsums rendered with an earlier result config must not be returned by this writer
+        _renderedDocsumConfigId = _renderedDocsumCache->make_config_id();
+    }
+}
+
 void
 DynamicDocsumWriter::initState(const IAttributeManager & attrMan, GetDocsumsState& state, const ResolveClassInfo& rci)
 {
@@ -15,6 +15,8 @@ namespace vespalib { class Slime; }
 
 namespace search::docsummary {
 
+class RenderedDocsumCache;
+
 static constexpr uint32_t SLIME_MAGIC_ID = 0x55555555;
 
 /**
@@ -47,6 +49,14 @@ class DynamicDocsumWriter : public IDocsumWriter
 {
 private:
     std::unique_ptr<ResultConfig>                         _resultConfig;
+    std::shared_ptr<RenderedDocsumCache>                  _renderedDocsumCache;
+    uint32_t                                              _renderedDocsumConfigId;
+
+    bool use_rendered_docsum_cache(const ResolveClassInfo & rci, const GetDocsumsState& state) const;
+    void insert_stored_docsum(const ResolveClassInfo & rci, uint32_t docid, GetDocsumsState& state,
+                              IDocsumStore &docinfos, Inserter & inserter);
+    void insert_cached_docsum(const ResolveClassInfo & rci, uint32_t docid, GetDocsumsState& state,
+                              IDocsumStore &docinfos, Inserter & inserter);
 
 public:
     DynamicDocsumWriter(std::unique_ptr<ResultConfig> config);
@@ -55,6 +65,11 @@ public:
     ~DynamicDocsumWriter() override;
 
     const ResultConfig *GetResultConfig() { return _resultConfig.get(); }
+    /**
+     * Sets a cache of rendered docsums used for result classes that are not query dependent.
+     * The owner of the cache must invalidate it when documents change.
+     */
+    void set_rendered_docsum_cache(std::shared_ptr<RenderedDocsumCache> cache);
 
     void initState(const search::IAttributeManager & attrMan, GetDocsumsState& state, const ResolveClassInfo& rci) override;
     void insertDocsum(const ResolveClassInfo & outputClassInfo, uint32_t docid, GetDocsumsState& state,
@@ -32,8 +32,15 @@ DynamicTeaserDFW::DynamicTeaserDFW(const juniper::Juniper * juniper, const char
     }
 }
 
+bool
+DynamicTeaserDFW::use_indexed_tokens() const noexcept
+{
+    return _juniperConfig->_matcherparams.UseIndexedTokens();
+}
+
 void
-DynamicTeaserDFW::insert_juniper_field(uint32_t docid, std::string_view input, GetDocsumsState& state, vespalib::slime::Inserter& inserter) const
+DynamicTeaserDFW::insert_juniper_field(uint32_t docid, std::string_view input, const juniper::TokenList* tokens,
+                                       GetDocsumsState& state, vespalib::slime::Inserter& inserter) const
 {
     auto& query = state._dynteaser.get_query(_input_field_name);
     if (!query) {
@@ -55,7 +62,7 @@ DynamicTeaserDFW::insert_juniper_field(uint32_t docid, std::string_view input, G
         }
 
         result = juniper::Analyse(*_juniperConfig, *query,
-                                  input.data(), input.length(), docid);
+                                  input.data(), input.length(), docid, tokens);
     }
 
     juniper::Summary *teaser = result
@@ -91,6 +98,8 @@ public:
     JuniperConverter(const DynamicTeaserDFW& writer, uint32_t doc_id, GetDocsumsState& state);
     ~JuniperConverter() override;
     void convert(std::string_view input, vespalib::slime::Inserter& inserter) override;
+    bool use_indexed_tokens() const noexcept override;
+    void convert(std::string_view input, const juniper::TokenList& tokens, vespalib::slime::Inserter& inserter) override;
 };
 
 JuniperConverter::JuniperConverter(const DynamicTeaserDFW& writer, uint32_t doc_id, GetDocsumsState& state)
@@ -106,7 +115,19 @@ JuniperConverter::~JuniperConverter() = default;
 void
 JuniperConverter::convert(std::string_view input, vespalib::slime::Inserter& inserter)
 {
-    _writer.insert_juniper_field(_doc_id, input, _state, inserter);
+    _writer.insert_juniper_field(_doc_id, input, nullptr, _state, inserter);
+}
+
+bool
+JuniperConverter::use_indexed_tokens() const noexcept
+{
+    return _writer.use_indexed_tokens();
+}
+
+void
+JuniperConverter::convert(std::string_view input, const juniper::TokenList& tokens, vespalib::slime::Inserter& inserter)
+{
+    _writer.insert_juniper_field(_doc_id, input, &tokens, _state, inserter);
 }
 
 }
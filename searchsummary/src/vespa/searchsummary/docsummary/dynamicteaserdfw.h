@@ -8,6 +8,7 @@
 namespace juniper {
     class Config;
     class Juniper;
+    class TokenList;
 }
 namespace vespalib::slime { struct Inserter; }
 
@@ -26,11 +27,13 @@ public:
     ~DynamicTeaserDFW() override;
 
     bool isGenerated() const override { return false; }
+    bool isQueryDependent() const override { return true; }
     void insert_field(uint32_t docid, const IDocsumStoreDocument* doc, GetDocsumsState& state,
                       ElementIds selected_elements,
                       vespalib::slime::Inserter &target) const override;
-    void insert_juniper_field(uint32_t docid, std::string_view input, GetDocsumsState& state,
-                              vespalib::slime::Inserter& inserter) const;
+    void insert_juniper_field(uint32_t docid, std::string_view input, const juniper::TokenList* tokens,
+                              GetDocsumsState& state, vespalib::slime::Inserter& inserter) const;
+    bool use_indexed_tokens() const noexcept;
 private:
     const juniper::Juniper                 *_juniper;
     std::string                        _input_field_name;
@@ -5,6 +5,7 @@
 #include <string>
 
 namespace document { class StringFieldValue; }
+namespace juniper { class TokenList; }
 namespace vespalib::slime { struct Inserter; }
 
 namespace search::docsummary {
@@ -18,6 +19,12 @@ class IJuniperConverter
 public:
     virtual ~IJuniperConverter() = default;
     virtual void convert(std::string_view input, vespalib::slime::Inserter& inserter) = 0;
+    // Returns true if tokens computed at indexing time should be passed to convert() below
+    virtual bool use_indexed_tokens() const noexcept { return false; }
+    virtual void convert(std::string_view input, const juniper::TokenList& tokens, vespalib::slime::Inserter& inserter) {
+        (void) tokens;
+        convert(input, inserter);
+    }
 };
 
 }
@@ -32,6 +32,7 @@ public:
         }
     };
     AllLocations getAllLocations(GetDocsumsState& state) const;
+    bool isQueryDependent() const override { return true; }
 };
 
 class AbsDistanceDFW : public LocationAttrDFW
@@ -0,0 +1,181 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "rendered_docsum_cache.h"
+#include <vespa/vespalib/data/simple_buffer.h>
+#include <vespa/vespalib/data/slime/binary_format.h>
+#include <vespa/vespalib/data/slime/inject.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/stllike/cache.hpp>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <string>
+#include <vector>
+
+using vespalib::Memory;
+using vespalib::SimpleBuffer;
+using vespalib::Slime;
+using vespalib::slime::BinaryFormat;
+
+namespace search::docsummary {
+
+namespace {
+
+/**
+ * The summaries rendered for a lid, one per summary class. Entries are
+ * immutable once shared with the cache.
+ **/
+struct Entry {
+    struct Variant {
+        uint32_t    config_id;
+        std::string class_name;
+        std::string blob;
+    };
+    uint32_t             epoch;
+    std::vector<Variant> variants;
+
+    explicit Entry(uint32_t epoch_in) noexcept : epoch(epoch_in), variants() { }
+    const Variant * find(uint32_t config_id, std::string_view class_name) const noexcept {
+        for (const auto & variant : variants) {
+            if ((variant.config_id == config_id) && (variant.class_name == class_name)) {
+                return &variant;
+            }
+        }
+        return nullptr;
+    }
+    size_t bytes_allocated() const noexcept {
+        size_t sum = sizeof(Entry) + variants.capacity() * sizeof(Variant);
+        for (const auto & variant : variants) {
+            sum += variant.class_name.capacity() + variant.blob.capacity();
+        }
+        return sum;
+    }
+};
+
+using EntrySP = std::shared_ptr<const Entry>;
+using Store = vespalib::NullStore<uint32_t, EntrySP>;
+
+struct ByteSize {
+    size_t operator() (const EntrySP & arg) const noexcept { return arg ? arg->bytes_allocated() : 0; }
+};
+
+}
+
+using CacheParams = vespalib::CacheParam<
+        vespalib::LruParam<uint32_t, EntrySP>,
+        Store,
+        vespalib::zero<uint32_t>,
+        ByteSize
+>;
+
+class RenderedDocsumCache::Cache : public vespalib::cache<CacheParams> {
+public:
+    explicit Cache(size_t max_bytes) : vespalib::cache<CacheParams>(null_store(), max_bytes) { }
+private:
+    static Store & null_store() {
+        static Store store;
+        return store;
+    }
+};
+
+RenderedDocsumCache::RenderedDocsumCache(size_t max_bytes)
+    : _cache(std::make_unique<Cache>(max_bytes)),
+      _lock(),
+      _epoch(0),
+      _nextConfigId(0),
+      _generations()
+{
+}
+
+RenderedDocsumCache::~RenderedDocsumCache() = default;
+
+bool
+RenderedDocsumCache::enabled() const noexcept
+{
+    return _cache->capacityBytes() != 0;
+}
+
+uint64_t
+RenderedDocsumCache::get_generation(uint32_t lid) const noexcept
+{
+    uint64_t epoch = _epoch.load(std::memory_order_acquire);
+    return (epoch << 32) | stripe(lid).load(std::memory_order_acquire);
+}
+
+bool
+RenderedDocsumCache::lookup(uint32_t lid, uint32_t config_id, std::string_view class_name,
+                            const vespalib::slime::Inserter& target) const
+{
+    EntrySP entry = _cache->read(lid);
+    if ( ! entry || (entry->epoch != _epoch.load(std::memory_order_relaxed))) {
+        return false;
+    }
+    const auto * variant = entry->find(config_id, class_name);
+    if (variant == nullptr) {
+        return false;
+    }
+    Slime docsum;
+    if (BinaryFormat::decode(Memory(variant->blob.data(), variant->blob.size()), docsum) == 0) {
+        return false;
+    }
+    vespalib::slime::inject(docsum.get(), target);
+    return true;
+}
+
+void
+RenderedDocsumCache::insert(uint32_t lid, uint32_t config_id, std::string_view class_name, uint64_t generation,
+                            const Slime& docsum)
+{
+    SimpleBuffer buf;
+    BinaryFormat::encode(docsum, buf);
+    Memory encoded = buf.get();
+    std::lock_guard guard(_lock);
+    if (get_generation(lid) != generation) {
+        return; // Document changed while rendering
+    }
+    auto entry = std::make_shared<Entry>(uint32_t(generation >> 32));
+    EntrySP old_entry = _cache->hasKey(lid) ? _cache->read(lid) : EntrySP();
+    if (old_entry && (old_entry->epoch == entry->epoch)) {
+        if (old_entry->find(config_id, class_name) != nullptr) {
+            return;
+        }
+        entry->variants.reserve(old_entry->variants.size() + 1);
+        entry->variants.insert(entry->variants.end(), old_entry->variants.begin(), old_entry->variants.end());
+    }
+    entry->variants.push_back({config_id, std::string(class_name), std::string(encoded.data, encoded.size)});
+    _cache->write(lid, std::move(entry));
+}
+
+void
+RenderedDocsumCache::invalidate(uint32_t lid)
+{
+    if ( ! enabled()) {
+        return; // Nothing is inserted, and all entries were dropped when disabled
+    }
+    std::lock_guard guard(_lock);
+    stripe(lid).fetch_add(1, std::memory_order_release);
+    _cache->invalidate(lid);
+}
+
+void
+RenderedDocsumCache::clear()
+{
+    std::lock_guard guard(_lock);
+    // Entries from earlier epochs are ignored by lookup and evicted over time
+    _epoch.fetch_add(1, std::memory_order_release);
+}
+
+void
+RenderedDocsumCache::set_max_bytes(size_t max_bytes)
+{
+    if (max_bytes == 0) {
+        clear();
+    }
+    _cache->setCapacityBytes(max_bytes);
+}
+
+vespalib::CacheStats
+RenderedDocsumCache::get_stats() const
+{
+    return _cache->get_stats();
+}
+
+}
@@ -0,0 +1,67 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/cache_stats.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+namespace vespalib { class Slime; }
+namespace vespalib::slime { struct Inserter; }
+
+namespace search::docsummary {
+
+/**
+ * Cache of rendered document summaries, keyed on local document id and
+ * summary class. Each entry is stored as binary slime. The summary classes
+ * of each summary config are identified by a config id, so entries from
+ * an older summary config are never returned.
+ *
+ * Only summaries that do not depend on the query are cached, and the
+ * feed must invalidate the lid after each put, update and remove has
+ * become visible. The generation of a lid is sampled before rendering
+ * and checked on insert. A summary rendered from a document that was
+ * changed while rendering is then dropped instead of cached.
+ **/
+class RenderedDocsumCache {
+public:
+    explicit RenderedDocsumCache(size_t max_bytes);
+    RenderedDocsumCache(const RenderedDocsumCache &) = delete;
+    RenderedDocsumCache & operator=(const RenderedDocsumCache &) = delete;
+    ~RenderedDocsumCache();
+
+    bool enabled() const noexcept;
+    uint32_t make_config_id() noexcept { return _nextConfigId.fetch_add(1, std::memory_order_relaxed); }
+    uint64_t get_generation(uint32_t lid) const noexcept;
+    /**
+     * Inserts the cached summary for the given lid and class into target.
+     * @return false if there is no such summary in the cache.
+     **/
+    bool lookup(uint32_t lid, uint32_t config_id, std::string_view class_name,
+                const vespalib::slime::Inserter& target) const;
+    void insert(uint32_t lid, uint32_t config_id, std::string_view class_name, uint64_t generation,
+                const vespalib::Slime& docsum);
+    void invalidate(uint32_t lid);
+    // Drops all cached summaries
+    void clear();
+    // Setting max bytes to 0 disables the cache, invalidation is then a no-op
+    void set_max_bytes(size_t max_bytes);
+    vespalib::CacheStats get_stats() const;
+private:
+    class Cache;
+    static constexpr size_t NUM_GENERATIONS = 1024;
+
+    const std::atomic<uint32_t> & stripe(uint32_t lid) const noexcept { return _generations[lid % NUM_GENERATIONS]; }
+    std::atomic<uint32_t> & stripe(uint32_t lid) noexcept { return _generations[lid % NUM_GENERATIONS]; }
+
+    std::unique_ptr<Cache>                            _cache;
+    mutable std::mutex                                _lock;
+    std::atomic<uint32_t>                             _epoch;
+    std::atomic<uint32_t>                             _nextConfigId;
+    std::array<std::atomic<uint32_t>, NUM_GENERATIONS> _generations;
+};
+
+}
@@ -15,6 +15,7 @@ ResultClass::ResultClass(const std::string& name)
       _dynInfo(),
       _omit_summary_features(false),
       _num_field_writer_states(0),
+      _query_dependent(false),
       _matching_elements_fields()
 {
     _matching_elements_fields = std::make_shared<MatchingElementsFields>();
@@ -48,6 +49,12 @@ ResultClass::addConfigEntry(const std::string& name,
         if (docsum_field_writer->setFieldWriterStateIndex(_num_field_writer_states)) {
             ++_num_field_writer_states;
         }
+        if (docsum_field_writer->isQueryDependent()) {
+            _query_dependent = true;
+        }
+    }
+    if (!elements_selector.all_elements()) {
+        _query_dependent = true;
     }
     e.set_elements_selector(elements_selector);
     e.set_writer(std::move(docsum_field_writer));
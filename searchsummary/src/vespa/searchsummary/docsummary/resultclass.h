@@ -49,6 +49,8 @@ private:
     // As default, summary features are always included.
     bool                       _omit_summary_features;
     size_t                     _num_field_writer_states;
+    // Whether or not any field in this class depends on the query (teasers, features, matched elements).
+    bool                       _query_dependent;
     std::shared_ptr<MatchingElementsFields> _matching_elements_fields;
 
 public:
@@ -77,6 +79,8 @@ public:
      **/
     uint32_t getNumEntries() const { return _entries.size(); }
 
+    const std::string & name() const noexcept { return _name; }
+
 
     /**
      * Add a config entry to this result class. Each config entry
@@ -133,6 +137,12 @@ public:
         return _omit_summary_features;
     }
 
+    /**
+     * Returns whether the docsums of this result class might differ between queries.
+     * Only docsums of classes that are not query dependent can be cached.
+     */
+    bool is_query_dependent() const noexcept { return _query_dependent; }
+
     size_t get_num_field_writer_states() const noexcept { return _num_field_writer_states; }
     const std::shared_ptr<MatchingElementsFields>& get_matching_elements_fields() const noexcept { return _matching_elements_fields; }
 };
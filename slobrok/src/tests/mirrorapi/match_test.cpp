@@ -17,6 +17,7 @@ class MatchTester : public slobrok::api::IMirrorAPI
         SCOPED_TRACE(n);
         SCOPED_TRACE(p);
         EXPECT_EQ(expected, match(n, p));
+        EXPECT_EQ(expected, slobrok::api::ServicePattern(p).match(n));
     }
 
 public:
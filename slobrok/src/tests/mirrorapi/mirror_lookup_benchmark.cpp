@@ -0,0 +1,102 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/slobrok/mirror_snapshot.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/util/time.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+using namespace slobrok::api;
+
+namespace {
+
+constexpr size_t num_services = 2000;
+constexpr size_t lookups_per_thread = 500000;
+
+std::string service_name(size_t i) {
+    return "storage/cluster.music/storage/" + std::to_string(i) + "/default";
+}
+
+MirrorSnapshot::SpecMap make_specs() {
+    MirrorSnapshot::SpecMap specs;
+    for (size_t i = 0; i < num_services; ++i) {
+        specs[service_name(i)] = "tcp/host" + std::to_string(i) + ".example.com:19123";
+    }
+    return specs;
+}
+
+// The way lookups were done before snapshots were introduced
+struct LockedSpecs {
+    mutable std::mutex      lock;
+    MirrorSnapshot::SpecMap specs;
+    IMirrorAPI::SpecList lookup(std::string_view name) const {
+        IMirrorAPI::SpecList ret;
+        ret.reserve(1);
+        std::lock_guard guard(lock);
+        auto found = specs.find(name);
+        if (found != specs.end()) {
+            ret.emplace_back(found->first, found->second);
+        }
+        return ret;
+    }
+    void update(MirrorSnapshot::SpecMap new_specs) {
+        std::lock_guard guard(lock);
+        specs = std::move(new_specs);
+    }
+};
+
+template <typename Lookup, typename Update>
+double ns_per_lookup(size_t num_threads, Lookup lookup, Update update) {
+    std::vector<std::string> names;
+    for (size_t i = 0; i < num_services; ++i) {
+        names.push_back(service_name(i));
+    }
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+                           while (!done.load(std::memory_order_relaxed)) {
+                               update();
+                               std::this_thread::sleep_for(10ms);
+                           }
+                       });
+    auto start = vespalib::steady_clock::now();
+    std::vector<std::thread> readers;
+    for (size_t t = 0; t < num_threads; ++t) {
+        readers.emplace_back([&, t]() {
+                                 size_t found = 0;
+                                 for (size_t i = 0; i < lookups_per_thread; ++i) {
+                                     found += lookup(names[(i * 7 + t) % num_services]);
+                                 }
+                                 EXPECT_EQ(lookups_per_thread, found);
+                             });
+    }
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    auto elapsed = vespalib::steady_clock::now() - start;
+    done = true;
+    writer.join();
+    return double(vespalib::count_ns(elapsed)) / lookups_per_thread;
+}
+
+}
+
+TEST(MirrorLookupBenchmark, concurrent_exact_lookups) {
+    auto specs = make_specs();
+    LockedSpecs locked;
+    locked.update(specs);
+    MirrorSnapshotPublisher publisher;
+    publisher.publish(std::make_unique<MirrorSnapshot>(specs));
+    for (size_t threads : {1, 4, 16}) {
+        double locked_ns = ns_per_lookup(threads,
+                                         [&](const std::string &name) { return locked.lookup(name).size(); },
+                                         [&]() { locked.update(specs); });
+        double snapshot_ns = ns_per_lookup(threads,
+                                           [&](const std::string &name) { return (publisher.read()->find(name) != nullptr) ? 1u : 0u; },
+                                           [&]() { publisher.publish(std::make_unique<MirrorSnapshot>(specs)); });
+        fprintf(stderr, "%2zu threads: locked copy: %8.1f ns/lookup, snapshot: %8.1f ns/lookup\n",
+                threads, locked_ns, snapshot_ns);
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,75 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/slobrok/mirror_snapshot.h>
+
+using namespace slobrok::api;
+
+namespace {
+
+MirrorSnapshot::SpecMap make_specs() {
+    MirrorSnapshot::SpecMap specs;
+    specs["A/x/w"] = "tcp/a:1";
+    specs["B/x"] = "tcp/b:2";
+    specs["B/y"] = "tcp/b:3";
+    specs["C/x/z"] = "tcp/c:4";
+    specs["Ba/x"] = "tcp/ba:5";
+    return specs;
+}
+
+std::vector<std::string> names(const MirrorSnapshot &snapshot, const char *pattern) {
+    std::vector<std::string> result;
+    snapshot.for_each_match(ServicePattern(pattern), [&](const MirrorSnapshot::Spec &spec) { result.push_back(spec.first); });
+    return result;
+}
+
+using Names = std::vector<std::string>;
+
+}
+
+TEST(MirrorSnapshotTest, pattern_is_compiled_into_prefix_and_wildcards) {
+    EXPECT_TRUE(ServicePattern("foo/bar").is_exact());
+    EXPECT_TRUE(ServicePattern("").is_exact());
+    EXPECT_FALSE(ServicePattern("foo/*").is_exact());
+    EXPECT_FALSE(ServicePattern("*").is_exact());
+    EXPECT_EQ("foo/", ServicePattern("foo/*/bar").prefix());
+    EXPECT_EQ("", ServicePattern("*/bar").prefix());
+    EXPECT_EQ("foo/bar", ServicePattern("foo/bar").prefix());
+}
+
+TEST(MirrorSnapshotTest, services_can_be_found_by_name) {
+    MirrorSnapshot snapshot(make_specs());
+    EXPECT_EQ(5u, snapshot.size());
+    const auto *spec = snapshot.find("B/x");
+    ASSERT_TRUE(spec != nullptr);
+    EXPECT_EQ("tcp/b:2", spec->second);
+    EXPECT_TRUE(snapshot.find("B") == nullptr);
+    EXPECT_EQ(Names({"B/x"}), names(snapshot, "B/x"));
+    EXPECT_EQ(Names(), names(snapshot, "B/z"));
+}
+
+TEST(MirrorSnapshotTest, services_are_matched_by_pattern_in_name_order) {
+    MirrorSnapshot snapshot(make_specs());
+    EXPECT_EQ(Names({"B/x", "B/y"}), names(snapshot, "B/*"));
+    EXPECT_EQ(Names({"B/x", "B/y", "Ba/x"}), names(snapshot, "B*/*"));
+    EXPECT_EQ(Names({"B/x", "Ba/x"}), names(snapshot, "*/x"));
+    EXPECT_EQ(Names({"A/x/w", "C/x/z"}), names(snapshot, "*/*/*"));
+    EXPECT_EQ(Names({"A/x/w", "B/x", "B/y", "Ba/x", "C/x/z"}), names(snapshot, "**"));
+    EXPECT_EQ(Names(), names(snapshot, "*"));
+    MirrorSnapshot::SpecList list;
+    snapshot.lookup(ServicePattern("C**"), list);
+    EXPECT_EQ(MirrorSnapshot::SpecList({{"C/x/z", "tcp/c:4"}}), list);
+}
+
+TEST(MirrorSnapshotTest, published_snapshot_is_visible_to_readers) {
+    MirrorSnapshotPublisher publisher;
+    auto empty = publisher.read();
+    EXPECT_EQ(0u, empty->size());
+    publisher.publish(std::make_unique<MirrorSnapshot>(make_specs()));
+    EXPECT_EQ(0u, empty->size()); // still valid while guarded
+    EXPECT_EQ(5u, publisher.read()->size());
+    EXPECT_EQ(5u, publisher.current().size());
+    publisher.reclaim_memory();
+    EXPECT_EQ(0u, empty->size());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
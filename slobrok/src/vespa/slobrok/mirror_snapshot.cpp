@@ -0,0 +1,128 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "mirror_snapshot.h"
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+
+namespace slobrok::api {
+
+ServicePattern::ServicePattern(std::string_view pattern)
+    : _pattern(pattern),
+      _parts()
+{
+    uint32_t literal_start = 0;
+    for (uint32_t i = 0; i < _pattern.size(); ++i) {
+        if (_pattern[i] == '*') {
+            if (i > literal_start) {
+                _parts.push_back({literal_start, i - literal_start});
+            }
+            _parts.push_back({i, 0});
+            literal_start = i + 1;
+        }
+    }
+    if (_pattern.size() > literal_start) {
+        _parts.push_back({literal_start, uint32_t(_pattern.size() - literal_start)});
+    }
+}
+
+ServicePattern::ServicePattern(ServicePattern &&) noexcept = default;
+ServicePattern &ServicePattern::operator=(ServicePattern &&) noexcept = default;
+ServicePattern::~ServicePattern() = default;
+
+/*
+ * Mirrors IMirrorAPI::match exactly, including that a '*' in the
+ * pattern is matched literally when the name has a '*' at the same
+ * position, and that there is no backtracking.
+ */
+bool
+ServicePattern::match(std::string_view name) const noexcept
+{
+    size_t pos = 0;
+    for (size_t i = 0; i < _parts.size(); ++i) {
+        const Part &part = _parts[i];
+        if (part.len > 0) {
+            if (name.substr(pos, part.len) != literal(part)) {
+                return false;
+            }
+            pos += part.len;
+        } else if (pos < name.size() && name[pos] == '*') {
+            ++pos;
+        } else {
+            while (pos < name.size() && name[pos] != '/') {
+                ++pos;
+            }
+            if ((i + 1) < _parts.size() && _parts[i + 1].len == 0) {
+                pos = name.size();
+            }
+        }
+    }
+    return (pos == name.size());
+}
+
+namespace {
+
+size_t
+byte_size_of(const MirrorSnapshot::SpecMap &specs)
+{
+    size_t sum = specs.getMemoryConsumption();
+    for (const auto &spec : specs) {
+        sum += spec.first.size() + spec.second.size() + sizeof(void *);
+    }
+    return sum;
+}
+
+}
+
+MirrorSnapshot::MirrorSnapshot(SpecMap specs)
+    : vespalib::GenerationHeldBase(byte_size_of(specs)),
+      _specs(std::move(specs)),
+      _sorted()
+{
+    _sorted.reserve(_specs.size());
+    for (const auto &spec : _specs) {
+        _sorted.push_back(&spec);
+    }
+    std::sort(_sorted.begin(), _sorted.end(), [](const Spec *a, const Spec *b) noexcept { return a->first < b->first; });
+}
+
+MirrorSnapshot::~MirrorSnapshot() = default;
+
+void
+MirrorSnapshot::lookup(const ServicePattern &pattern, SpecList &result) const
+{
+    for_each_match(pattern, [&result](const Spec &spec) { result.push_back(spec); });
+}
+
+MirrorSnapshotPublisher::MirrorSnapshotPublisher()
+    : _generation_handler(),
+      _generation_holder(),
+      _current(nullptr),
+      _owned(std::make_unique<MirrorSnapshot>(MirrorSnapshot::SpecMap()))
+{
+    _current.store(_owned.get(), std::memory_order_release);
+}
+
+MirrorSnapshotPublisher::~MirrorSnapshotPublisher()
+{
+    _generation_holder.reclaim_all();
+}
+
+void
+MirrorSnapshotPublisher::publish(std::unique_ptr<MirrorSnapshot> snapshot)
+{
+    _current.store(snapshot.get(), std::memory_order_release);
+    _generation_holder.insert(std::move(_owned));
+    _owned = std::move(snapshot);
+    _generation_holder.assign_generation(_generation_handler.getCurrentGeneration());
+    _generation_handler.incGeneration();
+    reclaim_memory();
+}
+
+void
+MirrorSnapshotPublisher::reclaim_memory()
+{
+    _generation_handler.update_oldest_used_generation();
+    _generation_holder.reclaim(_generation_handler.get_oldest_used_generation());
+}
+
+}
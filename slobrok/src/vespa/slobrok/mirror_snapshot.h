@@ -0,0 +1,136 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "imirrorapi.h"
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/util/generationholder.h>
+#include <atomic>
+#include <string_view>
+
+namespace slobrok::api {
+
+/**
+ * A lookup pattern compiled into runs of literal characters and
+ * wildcards. Matching is equivalent to IMirrorAPI::match, but does
+ * not need to rescan the pattern for each name, and the literal
+ * prefix of the pattern is used to limit the names considered.
+ **/
+class ServicePattern {
+private:
+    struct Part {
+        uint32_t offset;
+        uint32_t len; // 0 means '*'
+    };
+    std::string       _pattern;
+    std::vector<Part> _parts;
+
+    std::string_view literal(const Part &part) const noexcept {
+        return std::string_view(_pattern).substr(part.offset, part.len);
+    }
+public:
+    explicit ServicePattern(std::string_view pattern);
+    ServicePattern(ServicePattern &&) noexcept;
+    ServicePattern &operator=(ServicePattern &&) noexcept;
+    ~ServicePattern();
+    const std::string &str() const noexcept { return _pattern; }
+    bool is_exact() const noexcept { return (_parts.size() < 2) && (_parts.empty() || _parts[0].len > 0); }
+    std::string_view prefix() const noexcept {
+        return (!_parts.empty() && _parts[0].len > 0) ? literal(_parts[0]) : std::string_view();
+    }
+    bool match(std::string_view name) const noexcept;
+};
+
+/**
+ * An immutable view of all services known by a mirror. A new
+ * snapshot is built for each update from the slobrok, and published
+ * with a MirrorSnapshotPublisher so that lookups need no locking.
+ **/
+class MirrorSnapshot : public vespalib::GenerationHeldBase {
+public:
+    using Spec = IMirrorAPI::Spec;
+    using SpecList = IMirrorAPI::SpecList;
+    using SpecMap = vespalib::hash_map<std::string, std::string>;
+private:
+    SpecMap                  _specs;
+    std::vector<const Spec*> _sorted; // ordered by name, for pattern lookups
+public:
+    explicit MirrorSnapshot(SpecMap specs);
+    ~MirrorSnapshot() override;
+    const SpecMap &specs() const noexcept { return _specs; }
+    size_t size() const noexcept { return _specs.size(); }
+
+    // the service with exactly the given name, or nullptr if not found
+    const Spec *find(std::string_view name) const noexcept {
+        auto found = _specs.find(name);
+        return (found != _specs.end()) ? &*found : nullptr;
+    }
+
+    // call 'fun' with each service matching the pattern, in name order
+    template <typename F>
+    void for_each_match(const ServicePattern &pattern, F &&fun) const;
+
+    void lookup(const ServicePattern &pattern, SpecList &result) const;
+};
+
+/**
+ * Publishes mirror snapshots from a single writer to any number of
+ * readers. Readers take a generation guard before loading the
+ * current snapshot; replaced snapshots are held until no reader can
+ * observe them anymore (RCU style).
+ **/
+class MirrorSnapshotPublisher {
+private:
+    vespalib::GenerationHandler           _generation_handler;
+    vespalib::GenerationHolder            _generation_holder;
+    std::atomic<const MirrorSnapshot *>   _current;
+    std::unique_ptr<MirrorSnapshot>       _owned;
+public:
+    class Guard {
+    private:
+        vespalib::GenerationHandler::Guard _guard;
+        const MirrorSnapshot              *_snapshot;
+    public:
+        Guard(vespalib::GenerationHandler::Guard guard, const MirrorSnapshot *snapshot) noexcept
+            : _guard(std::move(guard)), _snapshot(snapshot) {}
+        const MirrorSnapshot &operator*() const noexcept { return *_snapshot; }
+        const MirrorSnapshot *operator->() const noexcept { return _snapshot; }
+    };
+
+    MirrorSnapshotPublisher();
+    MirrorSnapshotPublisher(const MirrorSnapshotPublisher &) = delete;
+    MirrorSnapshotPublisher &operator=(const MirrorSnapshotPublisher &) = delete;
+    ~MirrorSnapshotPublisher();
+
+    // may be called by any thread
+    Guard read() const {
+        auto guard = _generation_handler.takeGuard();
+        return Guard(std::move(guard), _current.load(std::memory_order_acquire));
+    }
+
+    // the following must only be called by the writer
+    const MirrorSnapshot &current() const noexcept { return *_owned; }
+    void publish(std::unique_ptr<MirrorSnapshot> snapshot);
+    void reclaim_memory();
+};
+
+template <typename F>
+void
+MirrorSnapshot::for_each_match(const ServicePattern &pattern, F &&fun) const
+{
+    if (pattern.is_exact()) {
+        if (const Spec *spec = find(pattern.str())) {
+            fun(*spec);
+        }
+        return;
+    }
+    std::string_view prefix = pattern.prefix();
+    auto pos = std::lower_bound(_sorted.begin(), _sorted.end(), prefix,
+                                [](const Spec *spec, std::string_view key) noexcept { return spec->first < key; });
+    for (; pos != _sorted.end() && std::string_view((*pos)->first).starts_with(prefix); ++pos) {
+        if (pattern.match((*pos)->first)) {
+            fun(**pos);
+        }
+    }
+}
+
+}
@@ -14,12 +14,11 @@ namespace slobrok::api {
 MirrorAPI::MirrorAPI(FRT_Supervisor &orb, const ConfiguratorFactory & config)
     : FNET_Task(orb.GetScheduler()),
       _orb(orb),
-      _lock(),
+      _snapshots(),
       _reqPending(false),
       _scheduled(false),
       _reqDone(false),
       _logOnSuccess(true),
-      _specs(),
       _specsGen(),
       _updates(),
       _slobrokSpecs(),
@@ -56,21 +55,23 @@ MirrorAPI::SpecList
 MirrorAPI::lookup(std::string_view pattern) const
 {
     SpecList ret;
-    ret.reserve(1);
-    bool exact = pattern.find('*') == std::string::npos;
-    std::lock_guard guard(_lock);
-    if (exact) {
-        auto found = _specs.find(pattern);
-        if (found != _specs.end()) {
-            ret.emplace_back(found->first, found->second);
-        }
-    } else {
-        for (const auto & spec : _specs) {
-            if (match(spec.first.c_str(), pattern.data())) {
-                ret.emplace_back(spec.first, spec.second);
-            }
+    if (pattern.find('*') == std::string::npos) {
+        auto snapshot = _snapshots.read();
+        if (const Spec *spec = snapshot->find(pattern)) {
+            ret.reserve(1);
+            ret.push_back(*spec);
         }
+        return ret;
     }
+    return lookup(ServicePattern(pattern));
+}
+
+MirrorAPI::SpecList
+MirrorAPI::lookup(const ServicePattern &pattern) const
+{
+    SpecList ret;
+    auto snapshot = _snapshots.read();
+    snapshot->lookup(pattern, ret);
     return ret;
 }
 
@@ -110,11 +111,8 @@ IMirrorAPI::match(const char *name, const char *pattern)
 void
 MirrorAPI::updateTo(SpecMap newSpecs, uint32_t newGen)
 {
-    {
-        std::lock_guard guard(_lock);
-         _specs = std::move(newSpecs);
-        _updates.add();
-    }
+    _snapshots.publish(std::make_unique<MirrorSnapshot>(std::move(newSpecs)));
+    _updates.add();
     _specsGen.setFromInt(newGen);
     if (_rpc_ms < 15000) {
         _rpc_ms = 15000;
@@ -124,7 +122,6 @@ MirrorAPI::updateTo(SpecMap newSpecs, uint32_t newGen)
 bool
 MirrorAPI::ready() const
 {
-    std::lock_guard guard(_lock);
     return _updates.getAsInt() != 0;
 }
 
@@ -181,7 +178,7 @@ MirrorAPI::handleIncrementalFetch()
     } else if (_specsGen == diff_from) {
         // incremental update
         SpecMap specs;
-        for (const auto & spec : _specs) {
+        for (const auto & spec : _snapshots.current().specs()) {
             bool keep = true;
             for (uint32_t idx = 0; idx < numRemove; idx++) {
                 if (spec.first == r[idx]._str) keep = false;
@@ -232,7 +229,7 @@ MirrorAPI::handleReqDone()
             // req done OK
             if (_logOnSuccess) {
                 LOG(info, "successfully connected to location broker %s (mirror initialized with %zu service names)",
-                    _currSlobrok.c_str(), _specs.size());
+                    _currSlobrok.c_str(), _snapshots.current().size());
                 _logOnSuccess = false;
             }
             return true;
@@ -306,6 +303,7 @@ void
 MirrorAPI::PerformTask()
 {
     _scheduled = false;
+    _snapshots.reclaim_memory();
     handleReconfig();
     if (handleReqDone()) {
         reSched(0.1); // be nice, do not make request again immediately
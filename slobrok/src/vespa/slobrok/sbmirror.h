@@ -3,9 +3,9 @@
 
 #include "imirrorapi.h"
 #include "backoff.h"
+#include "mirror_snapshot.h"
 #include "sblist.h"
 #include <vespa/vespalib/util/gencnt.h>
-#include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/fnet/frt/invoker.h>
 #include <atomic>
 
@@ -19,7 +19,8 @@ namespace slobrok::api {
  *
  * Updates to the service repository are
  * fetched in the background. Lookups against this object is done
- * using an internal mirror of the service repository.
+ * using an internal mirror of the service repository, which is
+ * published as immutable snapshots so that lookups never block.
  **/
 class MirrorAPI : public FNET_Task,
                   public FRT_IRequestWait,
@@ -53,6 +54,13 @@ public:
     // Inherit doc from IMirrorAPI.
     SpecList lookup(std::string_view pattern) const override;
 
+    /**
+     * @brief Obtain all the services matching a pre-compiled pattern.
+     *
+     * Prefer this when the same wildcard pattern is looked up repeatedly.
+     **/
+    SpecList lookup(const ServicePattern &pattern) const;
+
     // Inherit doc from IMirrorAPI.
     uint32_t updates() const override { return _updates.getAsInt(); }
 
@@ -71,7 +79,7 @@ public:
     bool ready() const override;
 
 private:
-    using SpecMap = vespalib::hash_map<std::string, std::string>;
+    using SpecMap = MirrorSnapshot::SpecMap;
     /** from FNET_Task, polls slobrok **/
     void PerformTask() override;
 
@@ -90,12 +98,11 @@ private:
     void reSched(double seconds);
 
     FRT_Supervisor          &_orb;
-    mutable std::mutex       _lock;
+    MirrorSnapshotPublisher  _snapshots;
     bool                     _reqPending;
     bool                     _scheduled;
     std::atomic<bool>        _reqDone;
     bool                     _logOnSuccess;
-    SpecMap                  _specs;
     vespalib::GenCnt         _specsGen;
     vespalib::GenCnt         _updates;
     SlobrokList              _slobrokSpecs;
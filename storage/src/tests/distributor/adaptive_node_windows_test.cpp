@@ -0,0 +1,131 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/storage/distributor/adaptive_node_windows.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+namespace storage::distributor {
+
+using namespace ::testing;
+using NodeStats = ContentNodeMessageStatsTracker::NodeStats;
+
+struct AdaptiveNodeWindowsTest : Test {
+    AdaptiveNodeWindows            _windows;
+    ContentNodeMessageStatsTracker _tracker;
+
+    AdaptiveNodeWindowsTest();
+    ~AdaptiveNodeWindowsTest() override;
+
+    void observe_latencies(uint16_t node, vespalib::duration latency, uint32_t samples) {
+        auto& stats = _tracker.stats_for(node);
+        for (uint32_t i = 0; i < samples; ++i) {
+            stats.observe_outgoing_request();
+            stats.observe_incoming_response_result(api::MessageType::PUT_REPLY_ID, api::ReturnCode::OK);
+            stats.observe_response_latency(latency);
+        }
+    }
+    void update() {
+        _windows.update(_tracker.node_stats());
+    }
+};
+
+AdaptiveNodeWindowsTest::AdaptiveNodeWindowsTest()
+    : _windows(),
+      _tracker()
+{
+    AdaptiveNodeWindows::Config cfg;
+    cfg.min_window = 2;
+    cfg.max_window = 20;
+    cfg.window_increment = 2;
+    cfg.window_decrease_factor = 0.5;
+    cfg.slow_node_latency_factor = 2.0;
+    cfg.min_latency_samples = 5;
+    _windows.set_config(cfg);
+}
+
+AdaptiveNodeWindowsTest::~AdaptiveNodeWindowsTest() = default;
+
+TEST_F(AdaptiveNodeWindowsTest, unknown_nodes_have_max_window) {
+    EXPECT_EQ(_windows.window_for(0), 20);
+    update();
+    EXPECT_EQ(_windows.window_for(0), 20);
+}
+
+TEST_F(AdaptiveNodeWindowsTest, only_slow_node_has_its_window_decreased) {
+    observe_latencies(0, 10ms, 10);
+    observe_latencies(1, 12ms, 10);
+    observe_latencies(2, 50ms, 10);
+    update();
+    EXPECT_EQ(_windows.window_for(0), 20);
+    EXPECT_EQ(_windows.window_for(1), 20);
+    EXPECT_EQ(_windows.window_for(2), 10);
+
+    observe_latencies(0, 10ms, 10);
+    observe_latencies(1, 12ms, 10);
+    observe_latencies(2, 50ms, 10);
+    update();
+    EXPECT_EQ(_windows.window_for(2), 5);
+    for (int i = 0; i < 5; ++i) {
+        observe_latencies(0, 10ms, 10);
+        observe_latencies(2, 50ms, 10);
+        update();
+    }
+    EXPECT_EQ(_windows.window_for(0), 20);
+    EXPECT_EQ(_windows.window_for(2), 2); // Bounded by min window
+}
+
+TEST_F(AdaptiveNodeWindowsTest, window_is_increased_again_when_node_catches_up) {
+    observe_latencies(0, 10ms, 10);
+    observe_latencies(1, 100ms, 10);
+    update();
+    ASSERT_EQ(_windows.window_for(1), 10);
+    observe_latencies(0, 10ms, 10);
+    observe_latencies(1, 11ms, 10);
+    update();
+    EXPECT_EQ(_windows.window_for(1), 12);
+    observe_latencies(0, 10ms, 10);
+    observe_latencies(1, 11ms, 10);
+    update();
+    EXPECT_EQ(_windows.window_for(1), 14);
+}
+
+TEST_F(AdaptiveNodeWindowsTest, only_latencies_since_last_update_are_considered) {
+    observe_latencies(0, 10ms, 10);
+    observe_latencies(1, 100ms, 1000); // Historic slowness
+    update();
+    ASSERT_EQ(_windows.window_for(1), 10);
+    observe_latencies(0, 10ms, 10);
+    observe_latencies(1, 10ms, 10);
+    update();
+    EXPECT_EQ(_windows.window_for(1), 12);
+}
+
+TEST_F(AdaptiveNodeWindowsTest, nodes_with_too_few_samples_are_not_adjusted) {
+    observe_latencies(0, 10ms, 10);
+    observe_latencies(1, 100ms, 4);
+    update();
+    EXPECT_EQ(_windows.window_for(1), 20);
+}
+
+TEST_F(AdaptiveNodeWindowsTest, single_sampled_node_is_never_considered_slow) {
+    observe_latencies(0, 1s, 10);
+    update();
+    EXPECT_EQ(_windows.window_for(0), 20);
+}
+
+TEST_F(AdaptiveNodeWindowsTest, reconfiguring_clamps_existing_windows) {
+    observe_latencies(0, 10ms, 10);
+    observe_latencies(1, 100ms, 10);
+    update();
+    ASSERT_EQ(_windows.window_for(1), 10);
+    auto cfg = _windows.config();
+    cfg.min_window = 15;
+    _windows.set_config(cfg);
+    EXPECT_EQ(_windows.window_for(1), 15);
+    cfg.max_window = cfg.min_window = 5;
+    _windows.set_config(cfg);
+    EXPECT_EQ(_windows.window_for(0), 5);
+    EXPECT_EQ(_windows.window_for(1), 5);
+    EXPECT_EQ(_windows.window_for(2), 5);
+}
+
+}
@@ -79,6 +79,77 @@ BucketInfo make_bucket_info(uint32_t dummy_info) {
 
 }
 
+namespace {
+
+BucketInfo make_bucket_info_with_all_fields_set() {
+    BucketInfo bi;
+    bi.addNode(BucketCopy(1234, 3, api::BucketInfo(0xcafe, 10, 2000, 12, 2500, true, true, 5678)).setTrusted(true), {3, 5});
+    bi.addNode(BucketCopy(4321, 5, api::BucketInfo(0xbeef, 11, 3000, 13, 3500, false, false, 8765)), {3, 5});
+    bi.setLastGarbageCollectionTime(777);
+    return bi;
+}
+
+struct ConstRefCollector : BucketDatabase::EntryProcessor {
+    std::vector<BucketInfo> infos;
+    bool process(const BucketDatabase::ConstEntryRef& e) override {
+        const auto& replicas = e->getRawNodes();
+        infos.emplace_back(e->getLastGarbageCollectionTime(), std::vector<BucketCopy>(replicas.begin(), replicas.end()));
+        return true;
+    }
+};
+
+}
+
+TEST_F(BTreeReadGuardTest, replica_state_is_preserved_by_packed_representation) {
+    BucketId bucket(16, 16);
+    const auto expected = make_bucket_info_with_all_fields_set();
+    _db.update(BucketDatabase::Entry(bucket, BucketInfo(expected)));
+
+    auto entry = _db.get(bucket);
+    ASSERT_TRUE(entry.valid());
+    EXPECT_EQ(entry.getBucketInfo(), expected);
+    ASSERT_EQ(entry->getNodeCount(), 2);
+    for (uint16_t i = 0; i < 2; ++i) {
+        const auto& actual_copy = entry->getNodeRef(i);
+        const auto& expected_copy = expected.getNodeRef(i);
+        EXPECT_EQ(actual_copy.getTimestamp(), expected_copy.getTimestamp());
+        EXPECT_EQ(actual_copy.getNode(), expected_copy.getNode());
+        EXPECT_EQ(actual_copy.trusted(), expected_copy.trusted());
+        EXPECT_EQ(actual_copy.getBucketInfo().getLastModified(), expected_copy.getBucketInfo().getLastModified());
+    }
+
+    ConstRefCollector collector;
+    _db.for_each_upper_bound(collector, BucketId());
+    ASSERT_EQ(collector.infos.size(), 1u);
+    EXPECT_EQ(collector.infos[0], expected);
+
+    auto guard = _db.acquire_read_guard();
+    auto iter = guard->create_iterator();
+    ASSERT_TRUE(iter->valid());
+    EXPECT_EQ(iter->value()->getNodeCount(), 2);
+    EXPECT_EQ(iter->value()->getNodeRef(0), expected.getNodeRef(0));
+    EXPECT_EQ(iter->value()->getNodeRef(1), expected.getNodeRef(1));
+}
+
+TEST_F(BTreeReadGuardTest, buckets_with_many_replicas_are_stored_and_decoded) {
+    BucketId bucket(16, 16);
+    BucketInfo expected;
+    std::vector<uint16_t> ideal_nodes;
+    for (uint16_t node = 0; node < 20; ++node) {
+        ideal_nodes.push_back(node);
+    }
+    for (uint16_t node = 0; node < 20; ++node) {
+        expected.addNode(BC(node, node + 1), ideal_nodes);
+    }
+    _db.update(BucketDatabase::Entry(bucket, BucketInfo(expected)));
+    EXPECT_EQ(_db.get(bucket).getBucketInfo(), expected);
+
+    ConstRefCollector collector;
+    _db.for_each_upper_bound(collector, BucketId());
+    ASSERT_EQ(collector.infos.size(), 1u);
+    EXPECT_EQ(collector.infos[0], expected);
+}
+
 // Simple pseudo-stress test with a single writer and a single reader thread.
 // The writer thread continuously updates a set of buckets with an array of bucket
 // info instances and last GC timestamp that all have the same value, but the value
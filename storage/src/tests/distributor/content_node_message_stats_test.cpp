@@ -37,6 +37,21 @@ TEST(ContentNodeMessageStatsTest, merging_adds_across_stats) {
     EXPECT_EQ(s1, Stats(11, 22, 33, 44, 55, 66));
 }
 
+TEST(ContentNodeMessageStatsTest, latencies_are_summed_merged_and_subtracted) {
+    Stats s1;
+    EXPECT_EQ(s1.avg_latency(), vespalib::duration::zero());
+    s1.observe_response_latency(10ms);
+    s1.observe_response_latency(30ms);
+    EXPECT_EQ(s1.latency_samples, 2);
+    EXPECT_EQ(s1.avg_latency(), 20ms);
+    Stats s2(s1);
+    s2.observe_response_latency(80ms);
+    EXPECT_EQ(s2.subtracted(s1).avg_latency(), 80ms);
+    s1.merge(s2);
+    EXPECT_EQ(s1.latency_samples, 5);
+    EXPECT_EQ(s1.avg_latency(), 32ms);
+}
+
 TEST(ContentNodeMessageStatsTest, errors_are_categorized_based_on_result_code) {
     constexpr auto id = api::MessageType::PUT_REPLY_ID;
     Stats s;
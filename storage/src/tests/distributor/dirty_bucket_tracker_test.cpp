@@ -0,0 +1,98 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/document/bucket/fixed_bucket_spaces.h>
+#include <vespa/storage/distributor/distributor_bucket_space.h>
+#include <vespa/storage/distributor/distributor_bucket_space_repo.h>
+#include <vespa/storage/distributor/maintenance/dirty_bucket_tracker.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+namespace storage::distributor {
+
+using document::Bucket;
+using document::BucketId;
+using document::FixedBucketSpaces;
+using namespace ::testing;
+
+struct DirtyBucketTrackerTest : Test {
+    DistributorBucketSpaceRepo _repo;
+    DirtyBucketTracker         _tracker;
+
+    DirtyBucketTrackerTest();
+    ~DirtyBucketTrackerTest() override;
+
+    static Bucket default_bucket(uint32_t n) {
+        return Bucket(FixedBucketSpaces::default_space(), BucketId(16, n));
+    }
+    static Bucket global_bucket(uint32_t n) {
+        return Bucket(FixedBucketSpaces::global_space(), BucketId(16, n));
+    }
+    BucketDatabase& db(document::BucketSpace space) {
+        return _repo.get(space).getBucketDatabase();
+    }
+    void update_in_db(const Bucket& bucket) {
+        db(bucket.getBucketSpace()).update(BucketDatabase::Entry(bucket.getBucketId(), BucketInfo()));
+    }
+};
+
+DirtyBucketTrackerTest::DirtyBucketTrackerTest()
+    : _repo(0),
+      _tracker()
+{
+}
+
+DirtyBucketTrackerTest::~DirtyBucketTrackerTest() = default;
+
+TEST_F(DirtyBucketTrackerTest, buckets_are_not_tracked_when_disabled) {
+    EXPECT_FALSE(_tracker.enabled());
+    _tracker.mark_dirty(default_bucket(1));
+    EXPECT_TRUE(_tracker.empty());
+}
+
+TEST_F(DirtyBucketTrackerTest, buckets_are_returned_in_first_dirtied_order_without_duplicates) {
+    _tracker.set_enabled(true);
+    _tracker.mark_dirty(default_bucket(3));
+    _tracker.mark_dirty(default_bucket(1));
+    _tracker.mark_dirty(default_bucket(3));
+    _tracker.mark_dirty(global_bucket(3));
+    EXPECT_EQ(3u, _tracker.size());
+    EXPECT_EQ(std::vector<Bucket>({default_bucket(3), default_bucket(1), global_bucket(3)}), _tracker.take(10));
+    EXPECT_TRUE(_tracker.empty());
+}
+
+TEST_F(DirtyBucketTrackerTest, take_returns_at_most_the_requested_number_of_buckets) {
+    _tracker.set_enabled(true);
+    for (uint32_t i = 1; i <= 5; ++i) {
+        _tracker.mark_dirty(default_bucket(i));
+    }
+    EXPECT_EQ(std::vector<Bucket>({default_bucket(1), default_bucket(2)}), _tracker.take(2));
+    EXPECT_EQ(3u, _tracker.size());
+    // A bucket that has been taken may be dirtied anew
+    _tracker.mark_dirty(default_bucket(1));
+    EXPECT_EQ(std::vector<Bucket>({default_bucket(3), default_bucket(4), default_bucket(5), default_bucket(1)}),
+              _tracker.take(10));
+}
+
+TEST_F(DirtyBucketTrackerTest, disabling_tracking_drops_tracked_buckets) {
+    _tracker.set_enabled(true);
+    _tracker.mark_dirty(default_bucket(1));
+    _tracker.set_enabled(false);
+    EXPECT_TRUE(_tracker.empty());
+}
+
+TEST_F(DirtyBucketTrackerTest, bucket_database_mutations_are_tracked_when_attached) {
+    _tracker.set_enabled(true);
+    update_in_db(default_bucket(1)); // Not yet attached
+    EXPECT_TRUE(_tracker.empty());
+
+    _tracker.attach_to(_repo);
+    update_in_db(default_bucket(2));
+    update_in_db(global_bucket(3));
+    db(FixedBucketSpaces::default_space()).remove(BucketId(16, 1));
+    EXPECT_EQ(std::vector<Bucket>({default_bucket(2), global_bucket(3), default_bucket(1)}), _tracker.take(10));
+
+    _tracker.detach();
+    update_in_db(default_bucket(4));
+    EXPECT_TRUE(_tracker.empty());
+}
+
+}
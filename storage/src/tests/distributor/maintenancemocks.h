@@ -35,12 +35,14 @@ class MockOperation : public MaintenanceOperation
     bool _shouldBlock;
     bool _was_blocked;
     bool _was_throttled;
+    std::vector<uint16_t> _target_nodes;
 public:
     explicit MockOperation(const document::Bucket &bucket)
         : _bucket(bucket),
           _shouldBlock(false),
           _was_blocked(false),
-          _was_throttled(false)
+          _was_throttled(false),
+          _target_nodes()
     {}
 
     [[nodiscard]] std::string toString() const override {
@@ -62,6 +64,12 @@ public:
     void setShouldBlock(bool shouldBlock) {
         _shouldBlock = shouldBlock;
     }
+    [[nodiscard]] std::span<const uint16_t> target_nodes() const noexcept override {
+        return _target_nodes;
+    }
+    void set_target_nodes(std::vector<uint16_t> nodes) {
+        _target_nodes = std::move(nodes);
+    }
     [[nodiscard]] bool get_was_blocked() const noexcept { return _was_blocked; }
     [[nodiscard]] bool get_was_throttled() const noexcept { return _was_throttled; }
 };
@@ -154,4 +154,41 @@ TEST_F(MultiThreadedStripeAccessGuardTest, merge_entries_into_db_handles_empty_e
     EXPECT_EQ(RawIdVector(), _stripe0.entries_as_raw_ids());
 }
 
+TEST_F(MultiThreadedStripeAccessGuardTest, parallel_db_processing_is_not_enabled_for_single_stripe) {
+    start_pool_with_one_stripe();
+    EXPECT_FALSE(_accessor.parallel_db_processing_enabled());
+    _accessor.set_parallel_db_processing_enabled(true);
+    EXPECT_FALSE(_accessor.parallel_db_processing_enabled());
+}
+
+TEST_F(MultiThreadedStripeAccessGuardTest, parallel_remove_superfluous_buckets_aggregates_reports_across_stripes) {
+    _stripe0.report = PotentialDataLossReport(20, 100);
+    _stripe1.report = PotentialDataLossReport(5,  200);
+    _stripe2.report = PotentialDataLossReport(7,  350);
+    _stripe3.report = PotentialDataLossReport(3,  30);
+    start_pool_with_stripes();
+    _accessor.set_parallel_db_processing_enabled(true);
+    ASSERT_TRUE(_accessor.parallel_db_processing_enabled());
+
+    auto guard = _accessor.rendezvous_and_hold_all();
+    auto report = guard->remove_superfluous_buckets(document::FixedBucketSpaces::default_space(),
+                                                    lib::ClusterState(), false);
+    EXPECT_EQ(report.buckets, 35);
+    EXPECT_EQ(report.documents, 680);
+}
+
+TEST_F(MultiThreadedStripeAccessGuardTest, parallel_merge_entries_into_db_operates_across_all_stripes) {
+    start_pool_with_stripes();
+    _accessor.set_parallel_db_processing_enabled(true);
+    ASSERT_TRUE(_accessor.parallel_db_processing_enabled());
+    merge_entries_into_db({0x10,0x20,0x30,0x40,0x11,0x21,0x31,0x12,0x22,0x13});
+    EXPECT_EQ(RawIdVector({0x10,0x20,0x30,0x40}), _stripe0.entries_as_raw_ids());
+    EXPECT_EQ(RawIdVector({0x12,0x22}), _stripe1.entries_as_raw_ids());
+    EXPECT_EQ(RawIdVector({0x11,0x21,0x31}), _stripe2.entries_as_raw_ids());
+    EXPECT_EQ(RawIdVector({0x13}), _stripe3.entries_as_raw_ids());
+
+    _accessor.set_parallel_db_processing_enabled(false);
+    EXPECT_FALSE(_accessor.parallel_db_processing_enabled());
+}
+
 }
@@ -700,6 +700,19 @@ TEST_F(PendingMessageTrackerTest, message_stats_are_updated_on_send_and_receive)
     ASSERT_TRUE(stats.per_node.contains(0));
     EXPECT_EQ(stats.per_node[0].recv_ok, 1);
     EXPECT_EQ(stats.per_node[0].sum_received(), 1);
+    EXPECT_EQ(stats.per_node[0].latency_samples, 0); // Not tracked by default
+}
+
+TEST_F(PendingMessageTrackerTest, response_latencies_are_tracked_when_enabled) {
+    Fixture f;
+    f.tracker().set_track_response_latencies(true);
+    auto cmd = f.sendPut(RequestBuilder().toNode(0));
+    f.clock().addSecondsToTime(2);
+    f.sendPutReply(*cmd, RequestBuilder(), api::ReturnCode(api::ReturnCode::OK));
+    auto stats = f.tracker().content_node_stats();
+    ASSERT_TRUE(stats.per_node.contains(0));
+    EXPECT_EQ(stats.per_node[0].latency_samples, 1);
+    EXPECT_EQ(stats.per_node[0].avg_latency(), 2s);
 }
 
 }
@@ -300,6 +300,21 @@ TEST_F(SimpleMaintenanceScannerTest, merge_pending_maintenance_stats) {
     EXPECT_EQ(exp.perNodeStats, result.perNodeStats);
 }
 
+TEST_F(SimpleMaintenanceScannerTest, reprioritized_bucket_is_not_counted_in_pending_stats) {
+    addBucketToDb(1);
+    _scanner->reprioritize_bucket(document::Bucket(makeBucketSpace(), BucketId(16, 1)));
+    EXPECT_EQ("PrioritizedBucket(Bucket(BucketSpace(0x0000000000000001), BucketId(0x4000000000000001)), pri VERY_HIGH)\n",
+              _priorityDb->toString());
+    const auto& stats = _scanner->getPendingMaintenanceStats();
+    EXPECT_EQ("delete bucket: 0, merge bucket: 0, "
+              "split bucket: 0, join bucket: 0, "
+              "set bucket state: 0, garbage collection: 0",
+              stringifyGlobalPendingStats(stats));
+    // Reprioritizing a bucket does not advance the scan cursor
+    ASSERT_FALSE(_scanner->scanNext().isDone());
+    ASSERT_TRUE(_scanner->scanNext().isDone());
+}
+
 TEST_F(SimpleMaintenanceScannerTest, empty_bucket_db_is_immediately_done_by_default) {
     auto res = _scanner->scanNext();
     EXPECT_TRUE(res.isDone());
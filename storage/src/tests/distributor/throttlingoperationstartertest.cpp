@@ -24,6 +24,20 @@ struct ThrottlingOperationStarterTest : Test {
         return std::make_shared<MockOperation>(makeDocumentBucket(BucketId(16, 1)));
     }
 
+    std::shared_ptr<Operation> create_mock_operation_to_nodes(std::vector<uint16_t> nodes) {
+        auto op = std::make_shared<MockOperation>(makeDocumentBucket(BucketId(16, 1)));
+        op->set_target_nodes(std::move(nodes));
+        return op;
+    }
+
+    void set_fixed_node_windows(uint32_t window) {
+        AdaptiveNodeWindows::Config cfg;
+        cfg.min_window = window;
+        cfg.max_window = window;
+        _operationStarter->node_windows().set_config(cfg);
+        _operationStarter->set_per_node_throttling_enabled(true);
+    }
+
     std::unique_ptr<MockOperationStarter> _starterImpl;
     std::unique_ptr<ThrottlingOperationStarter> _operationStarter;
 
@@ -118,4 +132,39 @@ TEST_F(ThrottlingOperationStarterTest, finishing_operations_allows_more_to_start
     EXPECT_FALSE(_starterImpl->getOperations().empty());
 }
 
+TEST_F(ThrottlingOperationStarterTest, per_node_windows_are_ignored_when_disabled) {
+    AdaptiveNodeWindows::Config cfg;
+    cfg.min_window = 1;
+    cfg.max_window = 1;
+    _operationStarter->node_windows().set_config(cfg);
+    EXPECT_TRUE(_operationStarter->start(create_mock_operation_to_nodes({0}), OperationStarter::Priority(0)));
+    EXPECT_TRUE(_operationStarter->start(create_mock_operation_to_nodes({0}), OperationStarter::Priority(0)));
+    EXPECT_EQ(_operationStarter->pending_count_for_node(0), 2);
+}
+
+TEST_F(ThrottlingOperationStarterTest, operation_throttled_when_any_target_node_window_is_full) {
+    set_fixed_node_windows(1);
+    EXPECT_TRUE(_operationStarter->start(create_mock_operation_to_nodes({0, 1}), OperationStarter::Priority(0)));
+    EXPECT_EQ(_operationStarter->pending_count_for_node(0), 1);
+    EXPECT_EQ(_operationStarter->pending_count_for_node(1), 1);
+
+    auto throttled = create_mock_operation_to_nodes({1, 2});
+    EXPECT_FALSE(_operationStarter->start(throttled, OperationStarter::Priority(0)));
+    EXPECT_TRUE(as_mock_operation(*throttled).get_was_throttled());
+    // Other nodes are not affected by the full windows of nodes 0 and 1
+    EXPECT_TRUE(_operationStarter->start(create_mock_operation_to_nodes({2}), OperationStarter::Priority(0)));
+    EXPECT_EQ(_operationStarter->pending_count_for_node(2), 1);
+}
+
+TEST_F(ThrottlingOperationStarterTest, finishing_operations_frees_up_per_node_windows) {
+    set_fixed_node_windows(1);
+    EXPECT_TRUE(_operationStarter->start(create_mock_operation_to_nodes({0, 1}), OperationStarter::Priority(0)));
+    EXPECT_FALSE(_operationStarter->start(create_mock_operation_to_nodes({1}), OperationStarter::Priority(0)));
+
+    _starterImpl->getOperations().pop_back();
+    EXPECT_EQ(_operationStarter->pending_count_for_node(0), 0);
+    EXPECT_EQ(_operationStarter->pending_count_for_node(1), 0);
+    EXPECT_TRUE(_operationStarter->start(create_mock_operation_to_nodes({1}), OperationStarter::Priority(0)));
+}
+
 }
@@ -241,6 +241,24 @@ struct FileStorHandlerComponents {
         filestorHandler = std::make_unique<FileStorHandlerImpl>(messageSender, metrics, test._node->getComponentRegister());
         filestorHandler->setGetNextMessageTimeout(50ms);
     }
+    FileStorHandlerComponents(FileStorTestBase& test, uint32_t threadsPerDisk, uint32_t numStripes)
+        : top(),
+          dummyManager(new DummyStorageLink),
+          messageSender(*dummyManager),
+          metrics(),
+          filestorHandler()
+    {
+        top.push_back(std::unique_ptr<StorageLink>(dummyManager));
+        top.open();
+
+        metrics.initDiskMetrics(numStripes, threadsPerDisk);
+
+        filestorHandler = std::make_unique<FileStorHandlerImpl>(threadsPerDisk, numStripes, messageSender, metrics,
+                                                                test._node->getComponentRegister(),
+                                                                vespalib::SharedOperationThrottler::DynamicThrottleParams(),
+                                                                vespalib::SharedOperationThrottler::DynamicThrottleParams());
+        filestorHandler->setGetNextMessageTimeout(50ms);
+    }
     ~FileStorHandlerComponents();
 };
 
@@ -2092,4 +2110,42 @@ TEST_F(FileStorHandlerTest, inhibited_operations_are_skipped)
     EXPECT_EQ(30, get_next_message().msg->getPriority());
 }
 
+TEST_F(FileStorManagerTest, idle_stripe_steals_non_conflicting_operations_from_other_stripe)
+{
+    FileStorHandlerComponents c(*this, 2, 2);
+    auto& handler = *c.filestorHandler;
+    std::string docid = "id:foo:testdoctype1::a";
+    // Find the stripe owning the bucket of the document
+    handler.schedule(make_put_command(20, docid));
+    uint32_t owner = 0;
+    {
+        auto msg = handler.getNextMessage(0);
+        if (!msg.msg) {
+            owner = 1;
+            msg = handler.getNextMessage(1);
+        }
+        ASSERT_TRUE(msg.msg);
+    }
+    uint32_t thief = 1 - owner;
+    handler.set_work_stealing(true);
+    handler.schedule(make_put_command(30, docid));
+    {
+        auto stolen = handler.getNextMessage(thief);
+        ASSERT_TRUE(stolen.msg);
+        EXPECT_EQ(30, stolen.msg->getPriority());
+        EXPECT_EQ(1, c.metrics.stripes[owner]->stolen_operations.getValue());
+
+        // Bucket is locked by the stolen operation, so the next operation is inhibited for all stripes
+        handler.schedule(make_put_command(40, docid));
+        EXPECT_FALSE(handler.getNextMessage(thief).msg);
+        EXPECT_FALSE(handler.getNextMessage(owner).msg);
+    }
+    // Lock released by the thief is released in the owning stripe
+    auto msg = handler.getNextMessage(owner);
+    ASSERT_TRUE(msg.msg);
+    EXPECT_EQ(40, msg.msg->getPriority());
+    EXPECT_EQ(1, c.metrics.stripes[owner]->stolen_operations.getValue());
+    EXPECT_EQ(0, c.metrics.stripes[thief]->stolen_operations.getValue());
+}
+
 } // storage
@@ -1461,4 +1461,44 @@ TEST_F(MergeHandlerTest, multiple_versions_in_apply_diff_only_writes_newest_vers
               "getBucketInfo(Bucket(0x40000000000004d2))\n");
 }
 
+TEST_F(MergeHandlerTest, mid_chain_apply_bucket_diff_is_sent_on_before_local_writes_without_copying_payload) {
+    setUpChain(MIDDLE);
+
+    document::TestDocMan doc_mgr;
+    document::Document::SP doc(doc_mgr.createRandomDocumentAtLocation(_location, 1));
+
+    PersistenceProviderWrapper provider_wrapper(getPersistenceProvider());
+    MergeHandler handler = createHandler(provider_wrapper);
+    std::vector<api::ApplyBucketDiffCommand::Entry> apply_diff;
+    {
+        api::ApplyBucketDiffCommand::Entry e;
+        e._entry._timestamp = 20'000;
+        e._entry._hasMask = 0x1; // Only present on first node in chain
+        e._entry._flags = MergeHandler::IN_USE;
+        fill_entry(e, *doc, doc_mgr.getTypeRepo());
+        apply_diff.push_back(e);
+    }
+    auto apply_bucket_diff_cmd = std::make_shared<api::ApplyBucketDiffCommand>(_bucket, _nodes);
+    apply_bucket_diff_cmd->getDiff() = std::move(apply_diff);
+
+    provider_wrapper.clearOperationLog();
+    auto tracker = handler.handleApplyBucketDiff(*apply_bucket_diff_cmd, createTracker(apply_bucket_diff_cmd, _bucket));
+    ASSERT_FALSE(tracker);
+
+    ASSERT_EQ(1, messageKeeper()._msgs.size());
+    ASSERT_EQ(api::MessageType::APPLYBUCKETDIFF, messageKeeper()._msgs[0]->getType());
+    auto& cmd2 = dynamic_cast<api::ApplyBucketDiffCommand&>(*messageKeeper()._msgs[0]);
+    ASSERT_EQ(1, cmd2.getDiff().size());
+    EXPECT_TRUE(cmd2.getDiff()[0].filled());
+    EXPECT_EQ(0x3, cmd2.getDiff()[0]._entry._hasMask);
+    // Payload has been moved on to the next node, not copied into the pending reply
+    auto s = getEnv()._fileStorHandler.editMergeStatus(_bucket);
+    ASSERT_TRUE(s->pendingApplyDiff);
+    EXPECT_TRUE(s->pendingApplyDiff->getDiff().empty());
+
+    handler.drain_async_writes();
+    EXPECT_NE(std::string::npos,
+              provider_wrapper.toString().find("put(Bucket(0x40000000000004d2), 20000, id:mail:testdoctype1:n=1234:9380.html)\n"));
+}
+
 } // storage
@@ -0,0 +1,81 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/storage/storageserver/adaptive_merge_limiter.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace storage {
+
+using Decision = AdaptiveMergeLimiter::Decision;
+
+namespace {
+
+AdaptiveMergeLimiter::Params
+make_params(uint32_t min_limit, uint32_t max_limit)
+{
+    AdaptiveMergeLimiter::Params params;
+    params.min_limit = min_limit;
+    params.max_limit = max_limit;
+    params.target_queue_latency_ms = 100.0;
+    params.max_disk_usage = 0.8;
+    params.decrease_factor = 0.5;
+    params.increment = 2.0;
+    return params;
+}
+
+const NodeLoadSample idle(10.0, 0.1);
+const NodeLoadSample high_latency(150.0, 0.1);
+const NodeLoadSample high_disk_usage(10.0, 0.9);
+
+}
+
+TEST(AdaptiveMergeLimiterTest, limit_starts_at_max_limit) {
+    AdaptiveMergeLimiter limiter(make_params(2, 16));
+    EXPECT_EQ(16u, limiter.limit());
+}
+
+TEST(AdaptiveMergeLimiterTest, limit_is_decreased_multiplicatively_down_to_min_limit) {
+    AdaptiveMergeLimiter limiter(make_params(3, 16));
+    EXPECT_EQ(Decision::DECREASE, limiter.update(high_latency, 16));
+    EXPECT_EQ(8u, limiter.limit());
+    EXPECT_EQ(Decision::DECREASE, limiter.update(high_disk_usage, 8));
+    EXPECT_EQ(4u, limiter.limit());
+    EXPECT_EQ(Decision::DECREASE, limiter.update(high_latency, 4));
+    EXPECT_EQ(3u, limiter.limit());
+    EXPECT_EQ(Decision::HOLD, limiter.update(high_latency, 3));
+    EXPECT_EQ(3u, limiter.limit());
+}
+
+TEST(AdaptiveMergeLimiterTest, limit_is_only_increased_when_saturated) {
+    AdaptiveMergeLimiter limiter(make_params(1, 8));
+    limiter.update(high_latency, 8);
+    limiter.update(high_latency, 4);
+    ASSERT_EQ(2u, limiter.limit());
+    EXPECT_EQ(Decision::HOLD, limiter.update(idle, 1));
+    EXPECT_EQ(2u, limiter.limit());
+    EXPECT_EQ(Decision::INCREASE, limiter.update(idle, 2));
+    EXPECT_EQ(4u, limiter.limit());
+    EXPECT_EQ(Decision::INCREASE, limiter.update(idle, 4));
+    EXPECT_EQ(Decision::INCREASE, limiter.update(idle, 6));
+    EXPECT_EQ(8u, limiter.limit());
+    EXPECT_EQ(Decision::HOLD, limiter.update(idle, 8));
+    EXPECT_EQ(8u, limiter.limit());
+}
+
+TEST(AdaptiveMergeLimiterTest, new_params_clamp_current_limit) {
+    AdaptiveMergeLimiter limiter(make_params(1, 16));
+    limiter.set_params(make_params(1, 4));
+    EXPECT_EQ(4u, limiter.limit());
+    limiter.set_params(make_params(6, 10));
+    EXPECT_EQ(6u, limiter.limit());
+}
+
+TEST(AdaptiveMergeLimiterTest, invalid_params_are_sanitized) {
+    AdaptiveMergeLimiter limiter(make_params(10, 0));
+    EXPECT_EQ(1u, limiter.params().max_limit);
+    EXPECT_EQ(1u, limiter.params().min_limit);
+    EXPECT_EQ(1u, limiter.limit());
+}
+
+}
@@ -1699,6 +1699,66 @@ TEST_F(MergeThrottlerTest, memory_limit_can_be_set_to_unlimited) {
     EXPECT_EQ(throttler(0).getMetrics().merge_memory_limit.getLast(), 0);
 }
 
+namespace {
+
+struct FakeNodeLoadSampler : NodeLoadSampler {
+    NodeLoadSample sample;
+    NodeLoadSample sample_node_load() override { return sample; }
+};
+
+}
+
+TEST_F(MergeThrottlerTest, adaptive_merge_limit_is_lowered_under_load_and_raised_when_saturated) {
+    StorServerConfigBuilder cfg(*default_server_config());
+    auto& adaptive_cfg = cfg.mergeThrottlingAdaptiveLimit;
+    adaptive_cfg.enabled = true;
+    adaptive_cfg.minLimit = 1;
+    adaptive_cfg.targetQueueLatencyMs = 100.0;
+    adaptive_cfg.decreaseFactor = 0.5;
+    adaptive_cfg.increment = 1.0;
+    adaptive_cfg.adjustIntervalSecs = 3600.0; // Only explicit adjustments in this test
+    auto& mt = throttler(0);
+    mt.on_configure(cfg);
+    FakeNodeLoadSampler sampler;
+    mt.set_node_load_sampler_locking(&sampler);
+    EXPECT_EQ(throttler_max_merges_pending(0), mt.adaptive_merge_limit_locking());
+
+    sampler.sample = NodeLoadSample(500.0, 0.1);
+    for (uint32_t i = 0; (i < 10) && (mt.adaptive_merge_limit_locking() > 1); ++i) {
+        mt.adjust_adaptive_merge_limit_locking();
+    }
+    EXPECT_EQ(1u, mt.adaptive_merge_limit_locking());
+    EXPECT_EQ(1, mt.getMetrics().adaptive_merge_limit.getLast());
+    EXPECT_GT(mt.getMetrics().adaptive_merge_limit_decreases.getValue(), 0);
+    EXPECT_DOUBLE_EQ(500.0, mt.getMetrics().sampled_persistence_queue_latency.getLast());
+
+    // Only one merge can be active, so the next one is queued
+    ASSERT_NO_FATAL_FAILURE(send_and_expect_forwarding(
+            MergeBuilder(document::BucketId(16, 0)).nodes(0, 1, 2).create()));
+    _topLinks[0]->sendDown(MergeBuilder(document::BucketId(16, 1)).nodes(0, 1, 2).create());
+    waitUntilMergeQueueIs(mt, 1, _messageWaitTime);
+
+    // Still overloaded due to disk usage
+    sampler.sample = NodeLoadSample(10.0, 0.95);
+    mt.adjust_adaptive_merge_limit_locking();
+    EXPECT_EQ(1u, mt.adaptive_merge_limit_locking());
+
+    // Node has spare capacity and the limit is saturated; the limit is raised and the queued merge is started
+    sampler.sample = NodeLoadSample(10.0, 0.1);
+    mt.adjust_adaptive_merge_limit_locking();
+    EXPECT_EQ(2u, mt.adaptive_merge_limit_locking());
+    EXPECT_EQ(1, mt.getMetrics().adaptive_merge_limit_increases.getValue());
+    waitUntilMergeQueueIs(mt, 0, _messageWaitTime);
+    _topLinks[0]->waitForMessage(MessageType::MERGEBUCKET, _messageWaitTime);
+
+    mt.set_node_load_sampler_locking(nullptr);
+}
+
+TEST_F(MergeThrottlerTest, adaptive_merge_limit_is_disabled_by_default) {
+    EXPECT_EQ(0u, throttler(0).adaptive_merge_limit_locking());
+    EXPECT_EQ(0, throttler(0).getMetrics().adaptive_merge_limit.getLast());
+}
+
 // TODO test message queue aborting (use rendezvous functionality--make guard)
 
 } // namespace storage
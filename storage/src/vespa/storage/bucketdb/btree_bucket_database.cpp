@@ -2,10 +2,12 @@
 
 #include "btree_bucket_database.h"
 #include "generic_btree_bucket_database.hpp"
+#include "packed_bucket_copy.h"
 #include <vespa/vespalib/datastore/array_store.hpp>
 #include <vespa/vespalib/datastore/buffer_type.hpp>
 #include <vespa/vespalib/util/memory_allocator.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <array>
 #include <iostream>
 
 /*
@@ -45,16 +47,32 @@ vespalib::datastore::ArrayStoreConfig make_default_array_store_config() {
 
 namespace {
 
-Entry entry_from_replica_array_ref(const BucketId& id, uint32_t gc_timestamp, std::span<const BucketCopy> replicas) {
-    return Entry(id, BucketInfo(gc_timestamp, std::vector<BucketCopy>(replicas.begin(), replicas.end())));
+using bucketdb::PackedBucketCopy;
+
+template <typename ReplicaSeq>
+ReplicaSeq unpack_replicas(std::span<const PackedBucketCopy> packed) {
+    ReplicaSeq replicas;
+    replicas.reserve(packed.size());
+    for (const auto& replica : packed) {
+        replicas.push_back(replica.unpack());
+    }
+    return replicas;
+}
+
+Entry entry_from_replica_array_ref(const BucketId& id, uint32_t gc_timestamp, std::span<const PackedBucketCopy> replicas) {
+    return Entry(id, BucketInfo(gc_timestamp, unpack_replicas<std::vector<BucketCopy>>(replicas)));
 }
 
 ConstEntryRef const_entry_ref_from_replica_array_ref(const BucketId& id, uint32_t gc_timestamp,
-                                                     std::span<const BucketCopy> replicas)
+                                                     std::span<const PackedBucketCopy> replicas)
 {
-    return ConstEntryRef(id, ConstBucketInfoRef(gc_timestamp, replicas));
+    return ConstEntryRef(id, ConstBucketInfoRef(gc_timestamp, unpack_replicas<vespalib::SmallVector<BucketCopy, 4>>(replicas)));
 }
 
+// Replica arrays are tiny (bounded by the redundancy), so packing them into a
+// fixed-size stack buffer avoids a transient heap allocation for every DB write.
+constexpr size_t max_stack_packed_replicas = 16;
+
 EntryRef entry_ref_from_value(uint64_t value) {
     return EntryRef(value & 0xffffffffULL);
 }
@@ -72,7 +90,7 @@ uint64_t value_from(uint32_t gc_timestamp, EntryRef ref) {
 struct BTreeBucketDatabase::ReplicaValueTraits {
     using ValueType     = Entry;
     using ConstValueRef = ConstEntryRef;
-    using DataStoreType = vespalib::datastore::ArrayStore<BucketCopy>;
+    using DataStoreType = vespalib::datastore::ArrayStore<PackedBucketCopy>;
 
     static void init_data_store(DataStoreType&) {
         // No-op; initialized via config provided to ArrayStore constructor.
@@ -81,7 +99,18 @@ struct BTreeBucketDatabase::ReplicaValueTraits {
         return Entry::createInvalid();
     }
     static uint64_t wrap_and_store_value(DataStoreType& store, const Entry& entry) noexcept {
-        auto replicas_ref = store.add(entry.getBucketInfo().getRawNodes());
+        const auto& replicas = entry.getBucketInfo().getRawNodes();
+        EntryRef replicas_ref;
+        if (replicas.size() <= max_stack_packed_replicas) {
+            std::array<PackedBucketCopy, max_stack_packed_replicas> packed;
+            for (size_t i = 0; i < replicas.size(); ++i) {
+                packed[i] = PackedBucketCopy(replicas[i]);
+            }
+            replicas_ref = store.add(std::span<const PackedBucketCopy>(packed.data(), replicas.size()));
+        } else {
+            std::vector<PackedBucketCopy> packed(replicas.begin(), replicas.end());
+            replicas_ref = store.add(packed);
+        }
         return value_from(entry.getBucketInfo().getLastGarbageCollectionTime(), replicas_ref);
     }
     static void remove_by_wrapped_value(DataStoreType& store, uint64_t value) noexcept {
@@ -114,6 +143,7 @@ Entry BTreeBucketDatabase::get(const BucketId& bucket) const {
 
 void BTreeBucketDatabase::remove(const BucketId& bucket) {
     _impl->remove(bucket);
+    notify_bucket_mutated(bucket);
 }
 
 using bucketdb::ByValue;
@@ -142,12 +172,14 @@ void BTreeBucketDatabase::getAll(const BucketId& bucket,
 void BTreeBucketDatabase::update(const Entry& newEntry) {
     assert(newEntry.valid());
     _impl->update(newEntry.getBucketId(), newEntry);
+    notify_bucket_mutated(newEntry.getBucketId());
 }
 
 void
 BTreeBucketDatabase::process_update(const document::BucketId& bucket, EntryUpdateProcessor &processor, bool create_if_nonexisting)
 {
     _impl->process_update(bucket, processor, create_if_nonexisting);
+    notify_bucket_mutated(bucket);
 }
 
 // TODO need snapshot read with guarding
@@ -74,8 +74,26 @@ public:
         virtual bool process_entry(Entry &entry) const = 0;
     };
 
+    /**
+     * Observer of single-bucket mutations, i.e. update(), remove() and process_update().
+     * Bulk mutations done via merge() or clear() are not reported, as these only happen
+     * as part of cluster state/distribution transitions which already imply that the
+     * entire database must be re-evaluated.
+     */
+    struct MutationListener {
+        virtual ~MutationListener() = default;
+        virtual void on_bucket_mutated(const document::BucketId& bucket) = 0;
+    };
+
+    BucketDatabase() noexcept : _mutation_listener(nullptr) {}
     ~BucketDatabase() override = default;
 
+    // At most one listener may be registered at a time. Listener lifetime must
+    // exceed that of its registration. Pass nullptr to unregister.
+    void set_mutation_listener(MutationListener* listener) noexcept {
+        _mutation_listener = listener;
+    }
+
     virtual Entry get(const document::BucketId& bucket) const = 0;
     virtual void remove(const document::BucketId& bucket) = 0;
 
@@ -173,6 +191,14 @@ public:
     }
 
     [[nodiscard]] virtual vespalib::MemoryUsage memory_usage() const noexcept = 0;
+protected:
+    void notify_bucket_mutated(const document::BucketId& bucket) const {
+        if (_mutation_listener) {
+            _mutation_listener->on_bucket_mutated(bucket);
+        }
+    }
+private:
+    MutationListener* _mutation_listener;
 };
 
 template <typename BucketInfoType>
@@ -7,7 +7,7 @@
 namespace storage {
 
 template class BucketInfoBase<std::vector<BucketCopy>>;
-template class BucketInfoBase<std::span<const BucketCopy>>;
+template class BucketInfoBase<vespalib::SmallVector<BucketCopy, 4>>;
 
 BucketInfo::BucketInfo() noexcept : BucketInfoBase() {}
 
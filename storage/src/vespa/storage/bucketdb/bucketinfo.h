@@ -2,6 +2,7 @@
 #pragma once
 
 #include "bucketcopy.h"
+#include <vespa/vespalib/util/small_vector.h>
 #include <vespa/vespalib/util/time.h>
 #include <span>
 #include <vector>
@@ -146,7 +147,14 @@ std::ostream& operator<<(std::ostream& out, const BucketInfoBase<NodeSeq>& info)
     return out;
 }
 
-class ConstBucketInfoRef : public BucketInfoBase<std::span<const BucketCopy>> {
+/**
+ * Read-only replica information as observed when iterating over a bucket database.
+ *
+ * Replicas are stored in a packed form in the database and are decoded into this
+ * object upon access. For the common case of a bucket having no more than 4 replicas
+ * the decoded replicas are kept inline, i.e. no heap allocation is required.
+ */
+class ConstBucketInfoRef : public BucketInfoBase<vespalib::SmallVector<BucketCopy, 4>> {
 public:
     using BucketInfoBase::BucketInfoBase;
 };
@@ -228,7 +236,7 @@ private:
 };
 
 extern template class BucketInfoBase<std::vector<BucketCopy>>;
-extern template class BucketInfoBase<std::span<const BucketCopy>>;
+extern template class BucketInfoBase<vespalib::SmallVector<BucketCopy, 4>>;
 
 }
 
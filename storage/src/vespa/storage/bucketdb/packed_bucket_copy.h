@@ -0,0 +1,74 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "bucketcopy.h"
+
+namespace storage::bucketdb {
+
+/**
+ * Compact, lossless representation of a BucketCopy used as the element type of the
+ * replica arrays stored in the distributor B-tree bucket database.
+ *
+ * A BucketCopy embeds an api::BucketInfo whose trailing bool flags are padded out
+ * to a full 8 byte boundary, and adds its own 16-bit flag field on top of this.
+ * Here all boolean state (trusted, ready, active) is folded into a single flag byte,
+ * shrinking each replica from 48 to 40 bytes.
+ *
+ * Both pack() and unpack() are inline and branch-free, as they are invoked for every
+ * replica of every bucket visited during bucket database scans.
+ */
+class PackedBucketCopy {
+    uint64_t _timestamp;
+    uint64_t _last_modified;
+    uint32_t _checksum;
+    uint32_t _doc_count;
+    uint32_t _total_doc_size;
+    uint32_t _meta_count;
+    uint32_t _used_file_size;
+    uint16_t _node;
+    uint8_t  _flags;
+
+    static constexpr uint8_t TRUSTED = 1;
+    static constexpr uint8_t READY   = 2;
+    static constexpr uint8_t ACTIVE  = 4;
+public:
+    PackedBucketCopy() noexcept
+        : _timestamp(0),
+          _last_modified(0),
+          _checksum(0),
+          _doc_count(0),
+          _total_doc_size(0),
+          _meta_count(0),
+          _used_file_size(0),
+          _node(0xffff),
+          _flags(0)
+    {}
+
+    explicit PackedBucketCopy(const BucketCopy& copy) noexcept
+        : _timestamp(copy.getTimestamp()),
+          _last_modified(copy.getBucketInfo().getLastModified()),
+          _checksum(copy.getChecksum()),
+          _doc_count(copy.getDocumentCount()),
+          _total_doc_size(copy.getTotalDocumentSize()),
+          _meta_count(copy.getMetaCount()),
+          _used_file_size(copy.getUsedFileSize()),
+          _node(copy.getNode()),
+          _flags((copy.trusted() ? TRUSTED : 0) | (copy.ready() ? READY : 0) | (copy.active() ? ACTIVE : 0))
+    {}
+
+    [[nodiscard]] uint16_t node() const noexcept { return _node; }
+    [[nodiscard]] bool trusted() const noexcept { return (_flags & TRUSTED) != 0; }
+
+    [[nodiscard]] BucketCopy unpack() const noexcept {
+        BucketCopy copy(_timestamp, _node,
+                        api::BucketInfo(_checksum, _doc_count, _total_doc_size, _meta_count, _used_file_size,
+                                        (_flags & READY) != 0, (_flags & ACTIVE) != 0, _last_modified));
+        copy.setTrusted(trusted());
+        return copy;
+    }
+};
+
+static_assert(sizeof(PackedBucketCopy) == 40);
+static_assert(sizeof(PackedBucketCopy) < sizeof(BucketCopy));
+
+}
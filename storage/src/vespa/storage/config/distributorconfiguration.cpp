@@ -25,6 +25,12 @@ DistributorConfiguration::DistributorConfiguration(StorageComponent& component)
       _minimalBucketSplit(16),
       _maxNodesPerMerge(16),
       _max_consecutively_inhibited_maintenance_ticks(20),
+      _background_maintenance_scan_tick_interval(1),
+      _max_dirty_buckets_checked_per_tick(64),
+      _per_node_maintenance_window_min(2),
+      _per_node_maintenance_window_max(100),
+      _slow_node_latency_factor(2.0),
+      _per_node_maintenance_window_update_interval(1s),
       _max_activation_inhibited_out_of_sync_groups(0),
       _max_document_operation_message_size_bytes(INT32_MAX),
       _lastGarbageCollectionChange(vespalib::duration::zero()),
@@ -48,6 +54,8 @@ DistributorConfiguration::DistributorConfiguration(StorageComponent& component)
       _enable_metadata_only_fetch_phase_for_inconsistent_updates(true),
       _enable_operation_cancellation(false),
       _symmetric_put_and_activate_replica_selection(false),
+      _parallel_cluster_state_db_processing(false),
+      _per_node_maintenance_throttling_enabled(false),
       _minimumReplicaCountingMode(ReplicaCountingMode::TRUSTED)
 {
 }
@@ -124,6 +132,13 @@ DistributorConfiguration::configure(const DistributorManagerConfig & config)
     _minimalBucketSplit = std::max(config.minsplitcount, static_cast<int>(spi::BucketLimits::MinUsedBits));
     _maxNodesPerMerge = config.maximumNodesPerMerge;
     _max_consecutively_inhibited_maintenance_ticks = config.maxConsecutivelyInhibitedMaintenanceTicks;
+    _background_maintenance_scan_tick_interval = std::max(1, config.backgroundMaintenanceScanTickInterval);
+    _max_dirty_buckets_checked_per_tick = std::max(1, config.maxDirtyBucketsCheckedPerTick);
+    _per_node_maintenance_throttling_enabled = config.enablePerNodeMaintenanceThrottling;
+    _per_node_maintenance_window_min = std::max(1, config.perNodeMaintenanceWindowMin);
+    _per_node_maintenance_window_max = std::max(static_cast<int>(_per_node_maintenance_window_min), config.perNodeMaintenanceWindowMax);
+    _slow_node_latency_factor = std::max(1.0, config.slowNodeLatencyFactor);
+    _per_node_maintenance_window_update_interval = vespalib::from_s(config.perNodeMaintenanceWindowUpdateInterval);
 
     _garbageCollectionInterval = std::chrono::seconds(config.garbagecollection.interval);
 
@@ -153,6 +168,7 @@ DistributorConfiguration::configure(const DistributorManagerConfig & config)
     _enable_operation_cancellation = config.enableOperationCancellation;
     _minimumReplicaCountingMode = deriveReplicaCountingMode(config.minimumReplicaCountingMode);
     _symmetric_put_and_activate_replica_selection = config.symmetricPutAndActivateReplicaSelection;
+    _parallel_cluster_state_db_processing = config.parallelClusterStateDbProcessing;
     if (config.maxDocumentOperationMessageSizeBytes > 0) {
         _max_document_operation_message_size_bytes = config.maxDocumentOperationMessageSizeBytes;
     } else {
@@ -224,6 +224,51 @@ public:
         return _max_consecutively_inhibited_maintenance_ticks;
     }
 
+    void set_background_maintenance_scan_tick_interval(uint32_t interval) noexcept {
+        _background_maintenance_scan_tick_interval = interval;
+    }
+    [[nodiscard]] uint32_t background_maintenance_scan_tick_interval() const noexcept {
+        return _background_maintenance_scan_tick_interval;
+    }
+    [[nodiscard]] bool incremental_maintenance_scanning_enabled() const noexcept {
+        return (_background_maintenance_scan_tick_interval > 1);
+    }
+    void set_max_dirty_buckets_checked_per_tick(uint32_t max_buckets) noexcept {
+        _max_dirty_buckets_checked_per_tick = max_buckets;
+    }
+    [[nodiscard]] uint32_t max_dirty_buckets_checked_per_tick() const noexcept {
+        return _max_dirty_buckets_checked_per_tick;
+    }
+
+    void set_per_node_maintenance_throttling_enabled(bool enabled) noexcept {
+        _per_node_maintenance_throttling_enabled = enabled;
+    }
+    [[nodiscard]] bool per_node_maintenance_throttling_enabled() const noexcept {
+        return _per_node_maintenance_throttling_enabled;
+    }
+    void set_per_node_maintenance_window_range(uint32_t min_window, uint32_t max_window) noexcept {
+        _per_node_maintenance_window_min = min_window;
+        _per_node_maintenance_window_max = max_window;
+    }
+    [[nodiscard]] uint32_t per_node_maintenance_window_min() const noexcept {
+        return _per_node_maintenance_window_min;
+    }
+    [[nodiscard]] uint32_t per_node_maintenance_window_max() const noexcept {
+        return _per_node_maintenance_window_max;
+    }
+    void set_slow_node_latency_factor(double factor) noexcept {
+        _slow_node_latency_factor = factor;
+    }
+    [[nodiscard]] double slow_node_latency_factor() const noexcept {
+        return _slow_node_latency_factor;
+    }
+    void set_per_node_maintenance_window_update_interval(vespalib::duration interval) noexcept {
+        _per_node_maintenance_window_update_interval = interval;
+    }
+    [[nodiscard]] vespalib::duration per_node_maintenance_window_update_interval() const noexcept {
+        return _per_node_maintenance_window_update_interval;
+    }
+
     void set_max_activation_inhibited_out_of_sync_groups(uint32_t max_groups) noexcept {
         _max_activation_inhibited_out_of_sync_groups = max_groups;
     }
@@ -245,6 +290,12 @@ public:
     [[nodiscard]] bool symmetric_put_and_activate_replica_selection() const noexcept {
         return _symmetric_put_and_activate_replica_selection;
     }
+    void set_parallel_cluster_state_db_processing(bool parallel) noexcept {
+        _parallel_cluster_state_db_processing = parallel;
+    }
+    [[nodiscard]] bool parallel_cluster_state_db_processing() const noexcept {
+        return _parallel_cluster_state_db_processing;
+    }
 
     [[nodiscard]] bool containsTimeStatement(const std::string& documentSelection) const;
 
@@ -258,6 +309,12 @@ private:
     uint32_t _minimalBucketSplit;
     uint32_t _maxNodesPerMerge;
     uint32_t _max_consecutively_inhibited_maintenance_ticks;
+    uint32_t _background_maintenance_scan_tick_interval;
+    uint32_t _max_dirty_buckets_checked_per_tick;
+    uint32_t _per_node_maintenance_window_min;
+    uint32_t _per_node_maintenance_window_max;
+    double   _slow_node_latency_factor;
+    vespalib::duration _per_node_maintenance_window_update_interval;
     uint32_t _max_activation_inhibited_out_of_sync_groups;
     uint32_t _max_document_operation_message_size_bytes;
 
@@ -289,6 +346,8 @@ private:
     bool _enable_metadata_only_fetch_phase_for_inconsistent_updates; //TODO Rewrite tests and GC
     bool _enable_operation_cancellation;
     bool _symmetric_put_and_activate_replica_selection;
+    bool _parallel_cluster_state_db_processing;
+    bool _per_node_maintenance_throttling_enabled;
 
     ReplicaCountingMode _minimumReplicaCountingMode;
 };
@@ -0,0 +1,93 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "adaptive_node_windows.h"
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace storage::distributor {
+
+AdaptiveNodeWindows::Config::Config() noexcept
+    : min_window(2),
+      max_window(UINT32_MAX),
+      window_increment(2),
+      window_decrease_factor(0.5),
+      slow_node_latency_factor(2.0),
+      min_latency_samples(10)
+{
+}
+
+AdaptiveNodeWindows::AdaptiveNodeWindows()
+    : _config(),
+      _prev_stats(),
+      _windows()
+{
+}
+
+AdaptiveNodeWindows::~AdaptiveNodeWindows() = default;
+
+void
+AdaptiveNodeWindows::set_config(const Config& config)
+{
+    _config = config;
+    _config.min_window = std::max(_config.min_window, 1u);
+    _config.max_window = std::max(_config.max_window, _config.min_window);
+    for (auto& w : _windows) {
+        w.second = std::clamp(w.second, double(_config.min_window), double(_config.max_window));
+    }
+}
+
+double&
+AdaptiveNodeWindows::window_ref(uint16_t node)
+{
+    auto iter = _windows.find(node);
+    if (iter == _windows.end()) {
+        iter = _windows.insert(std::make_pair(node, double(_config.max_window))).first;
+    }
+    return iter->second;
+}
+
+void
+AdaptiveNodeWindows::update(const ContentNodeMessageStatsTracker::NodeStats& current_stats)
+{
+    const auto delta = current_stats.sparse_subtracted(_prev_stats);
+    _prev_stats = current_stats;
+
+    std::vector<std::pair<uint16_t, vespalib::duration>> sampled;
+    for (const auto& s : delta.per_node) {
+        if ((s.second.latency_samples > 0) && (s.second.latency_samples >= _config.min_latency_samples)) {
+            sampled.emplace_back(s.first, s.second.avg_latency());
+        }
+    }
+    if (sampled.empty()) {
+        return;
+    }
+    std::vector<vespalib::duration> latencies;
+    latencies.reserve(sampled.size());
+    for (const auto& s : sampled) {
+        latencies.emplace_back(s.second);
+    }
+    // Use the lower median, so that with two nodes the faster one acts as the baseline.
+    auto median_iter = latencies.begin() + (latencies.size() - 1) / 2;
+    std::nth_element(latencies.begin(), median_iter, latencies.end());
+    const double slow_threshold_us = vespalib::count_us(*median_iter) * _config.slow_node_latency_factor;
+
+    for (const auto& s : sampled) {
+        double& window = window_ref(s.first);
+        const bool is_slow = ((sampled.size() > 1) && (vespalib::count_us(s.second) > slow_threshold_us));
+        if (is_slow) {
+            window = std::max(window * _config.window_decrease_factor, double(_config.min_window));
+        } else {
+            window = std::min(window + _config.window_increment, double(_config.max_window));
+        }
+    }
+}
+
+uint32_t
+AdaptiveNodeWindows::window_for(uint16_t node) const noexcept
+{
+    auto iter = _windows.find(node);
+    return (iter != _windows.end()) ? static_cast<uint32_t>(iter->second) : _config.max_window;
+}
+
+}
@@ -0,0 +1,56 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "content_node_message_stats_tracker.h"
+#include <vespa/vespalib/stllike/hash_map.h>
+
+namespace storage::distributor {
+
+/**
+ * Adaptive per content node windows of pending maintenance operations.
+ *
+ * Windows are adjusted from the delta of the (monotonic) per-node message statistics
+ * between two consecutive calls to update(), using additive increase/multiplicative
+ * decrease. A sampled node whose average response latency is more than a configurable
+ * factor above the median latency across all sampled nodes has its window decreased,
+ * while the windows of all other sampled nodes are increased. Since slowness is judged
+ * relative to the other nodes, a node lagging behind its peers is backed off without
+ * limiting how many operations are sent to the healthy nodes.
+ *
+ * Nodes that have not been observed yet implicitly have the maximum window size.
+ *
+ * Not thread safe.
+ */
+class AdaptiveNodeWindows {
+public:
+    struct Config {
+        uint32_t min_window;
+        uint32_t max_window;
+        uint32_t window_increment;
+        double   window_decrease_factor;
+        double   slow_node_latency_factor;
+        uint32_t min_latency_samples;
+
+        Config() noexcept;
+        bool operator==(const Config&) const noexcept = default;
+    };
+
+    AdaptiveNodeWindows();
+    ~AdaptiveNodeWindows();
+
+    void set_config(const Config& config);
+    [[nodiscard]] const Config& config() const noexcept { return _config; }
+
+    // Adjusts windows based on the statistics observed since the previous invocation.
+    void update(const ContentNodeMessageStatsTracker::NodeStats& current_stats);
+
+    [[nodiscard]] uint32_t window_for(uint16_t node) const noexcept;
+private:
+    double& window_ref(uint16_t node);
+
+    Config                                    _config;
+    ContentNodeMessageStatsTracker::NodeStats _prev_stats;
+    vespalib::hash_map<uint16_t, double>      _windows;
+};
+
+}
@@ -13,6 +13,8 @@ std::ostream& operator<<(std::ostream& os, const ContentNodeMessageStats& s) {
        << ", recv_time_sync_error=" << s.recv_clock_skew_error
        << ", recv_other_error="     << s.recv_other_error
        << ", cancelled="            << s.cancelled
+       << ", latency_samples="      << s.latency_samples
+       << ", latency_sum_us="       << s.latency_sum_us
        << ")";
     return os;
 }
@@ -24,6 +26,8 @@ void ContentNodeMessageStats::merge(const ContentNodeMessageStats& other) noexce
     recv_clock_skew_error += other.recv_clock_skew_error;
     recv_other_error      += other.recv_other_error;
     cancelled             += other.cancelled;
+    latency_samples       += other.latency_samples;
+    latency_sum_us        += other.latency_sum_us;
 }
 
 ContentNodeMessageStats
@@ -35,6 +39,8 @@ ContentNodeMessageStats::subtracted(const ContentNodeMessageStats& rhs) const no
     s.recv_clock_skew_error = recv_clock_skew_error - rhs.recv_clock_skew_error;
     s.recv_other_error      = recv_other_error - rhs.recv_other_error;
     s.cancelled             = cancelled - rhs.cancelled;
+    s.latency_samples       = latency_samples - rhs.latency_samples;
+    s.latency_sum_us        = latency_sum_us - rhs.latency_sum_us;
     return s;
 }
 
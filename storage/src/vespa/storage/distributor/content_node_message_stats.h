@@ -4,6 +4,8 @@
 
 #include <vespa/storageapi/messageapi/storagemessage.h>
 #include <vespa/storageapi/messageapi/returncode.h>
+#include <vespa/vespalib/util/time.h>
+#include <algorithm>
 #include <cstdint>
 #include <iosfwd>
 
@@ -24,10 +26,14 @@ struct ContentNodeMessageStats {
     uint64_t recv_other_error;
     uint64_t cancelled;
     // TODO also count timeouts explicitly?
+    // Request/response round-trip latencies. Only sampled when latency tracking has been
+    // explicitly enabled by the owner of the stats, so latency_samples <= sum_received().
+    uint64_t latency_samples;
+    uint64_t latency_sum_us;
 
     constexpr ContentNodeMessageStats() noexcept
         : sent(0), recv_ok(0), recv_network_error(0), recv_clock_skew_error(0),
-          recv_other_error(0), cancelled(0)
+          recv_other_error(0), cancelled(0), latency_samples(0), latency_sum_us(0)
     {}
 
     constexpr ContentNodeMessageStats(uint64_t sent_, uint64_t recv_ok_, uint64_t recv_network_error_,
@@ -35,7 +41,7 @@ struct ContentNodeMessageStats {
                                       uint64_t cancelled_) noexcept
         : sent(sent_), recv_ok(recv_ok_), recv_network_error(recv_network_error_),
           recv_clock_skew_error(recv_clock_skew_error_), recv_other_error(recv_other_error_),
-          cancelled(cancelled_)
+          cancelled(cancelled_), latency_samples(0), latency_sum_us(0)
     {}
 
     void merge(const ContentNodeMessageStats& other) noexcept;
@@ -54,6 +60,12 @@ struct ContentNodeMessageStats {
         return sum_errors() + recv_ok;
     }
 
+    // Average observed latency across all latency samples, or zero if there are none.
+    [[nodiscard]] vespalib::duration avg_latency() const noexcept {
+        return (latency_samples > 0) ? std::chrono::microseconds(latency_sum_us / latency_samples)
+                                     : vespalib::duration::zero();
+    }
+
     bool operator==(const ContentNodeMessageStats&) const noexcept = default;
 
     void observe_outgoing_request() noexcept {
@@ -62,6 +74,10 @@ struct ContentNodeMessageStats {
     void observe_cancelled() noexcept {
         ++cancelled;
     }
+    void observe_response_latency(vespalib::duration latency) noexcept {
+        ++latency_samples;
+        latency_sum_us += std::max(vespalib::count_us(latency), int64_t(0));
+    }
 
     // Message type is included since certain messages may have transitive errors set,
     // which cannot be directly attributed to a particular node.
@@ -61,6 +61,7 @@ DistributorStripe::DistributorStripe(DistributorComponentRegister& compReg,
       _done_initializing_ref(done_initializing_ref),
       _bucketPriorityDb(std::make_unique<SimpleBucketPriorityDatabase>()),
       _scanner(std::make_unique<SimpleMaintenanceScanner>(*_bucketPriorityDb, _idealStateManager, *_bucketSpaceRepo)),
+      _dirty_bucket_tracker(),
       _throttlingStarter(std::make_unique<ThrottlingOperationStarter>(_maintenanceOperationOwner)),
       _blockingStarter(std::make_unique<BlockingOperationStarter>(_component, *_operation_sequencer,
                                                                   *_throttlingStarter)),
@@ -78,13 +79,16 @@ DistributorStripe::DistributorStripe(DistributorComponentRegister& compReg,
       _ownershipSafeTimeCalc(std::make_unique<OwnershipTransferSafeTimePointCalculator>(0s)), // Set by config later
       _db_memory_sample_interval(30s),
       _last_db_memory_sample_time_point(),
+      _last_node_window_update_time_point(),
       _inhibited_maintenance_tick_count(0),
+      _ticks_since_background_scan(0),
       _stripe_index(stripe_index),
       _non_activation_maintenance_is_inhibited(false),
       _must_send_updated_host_info(false)
 {
     propagateDefaultDistribution(_component.getDistribution());
     propagateClusterStates();
+    _dirty_bucket_tracker.attach_to(*_bucketSpaceRepo);
 }
 
 DistributorStripe::~DistributorStripe() = default;
@@ -418,6 +422,8 @@ DistributorStripe::enterRecoveryMode()
     LOG(debug, "Entering recovery mode");
     _schedulingMode = MaintenanceScheduler::RECOVERY_SCHEDULING_MODE;
     (void)_scanner->fetch_and_reset(); // Just drop accumulated stats on the floor.
+    _dirty_bucket_tracker.clear(); // Implicitly covered by the full scan.
+    _ticks_since_background_scan = 0;
     // We enter recovery mode due to cluster state or distribution config changes.
     // Until we have completed a new DB scan round, we don't know the state of our
     // newly owned buckets and must not report stats for these out to the cluster
@@ -808,6 +814,38 @@ DistributorStripe::scanNextBucket()
     return scanResult;
 }
 
+/*
+ * With incremental maintenance scanning enabled, buckets that have changed since they
+ * were last checked are eagerly re-evaluated on every tick, while the full round-robin
+ * scan (which is what eventually catches everything else, such as buckets due for
+ * time-based GC) only advances every N ticks. Recovery mode always scans at full
+ * speed, as we cannot make any assumptions about buckets after a state transition.
+ */
+void
+DistributorStripe::maintenance_scan_tick()
+{
+    if (isInRecoveryMode() || !getConfig().incremental_maintenance_scanning_enabled()) {
+        scanNextBucket();
+        return;
+    }
+    check_dirty_buckets();
+    if (++_ticks_since_background_scan >= getConfig().background_maintenance_scan_tick_interval()) {
+        _ticks_since_background_scan = 0;
+        scanNextBucket();
+    }
+}
+
+void
+DistributorStripe::check_dirty_buckets()
+{
+    if (_dirty_bucket_tracker.empty()) {
+        return;
+    }
+    for (const auto& bucket : _dirty_bucket_tracker.take(getConfig().max_dirty_buckets_checked_per_tick())) {
+        _scanner->reprioritize_bucket(bucket);
+    }
+}
+
 void DistributorStripe::send_updated_host_info_if_required() {
     if (_must_send_updated_host_info) {
         _stripe_host_info_notifier.notify_stripe_wants_to_send_host_info(_stripe_index);
@@ -820,6 +858,7 @@ DistributorStripe::startNextMaintenanceOperation()
 {
     _throttlingStarter->setMaxPendingRange(getConfig().getMinPendingMaintenanceOps(),
                                            getConfig().getMaxPendingMaintenanceOps());
+    maybe_update_node_maintenance_windows();
     auto effective_scheduling_mode = ((_schedulingMode == MaintenanceScheduler::RECOVERY_SCHEDULING_MODE) ||
                                       non_activation_maintenance_is_inhibited())
                                               ? MaintenanceScheduler::RECOVERY_SCHEDULING_MODE
@@ -827,6 +866,19 @@ DistributorStripe::startNextMaintenanceOperation()
     _scheduler->tick(effective_scheduling_mode);
 }
 
+void
+DistributorStripe::maybe_update_node_maintenance_windows()
+{
+    if (!_throttlingStarter->per_node_throttling_enabled()) {
+        return;
+    }
+    auto now = _component.getClock().getMonotonicTime();
+    if ((now - _last_node_window_update_time_point) >= getConfig().per_node_maintenance_window_update_interval()) {
+        _throttlingStarter->node_windows().update(_pendingMessageTracker.content_node_stats());
+        _last_node_window_update_time_point = now;
+    }
+}
+
 framework::ThreadWaitInfo
 DistributorStripe::doNonCriticalTick(framework::ThreadIndex)
 {
@@ -843,7 +895,7 @@ DistributorStripe::doNonCriticalTick(framework::ThreadIndex)
     // Ordering note: since maintenance inhibiting checks whether startExternalOperations()
     // did any useful work with incoming data, this check must be performed _after_ the call.
     if (!should_inhibit_current_maintenance_scan_tick()) {
-        scanNextBucket();
+        maintenance_scan_tick();
         if (!_bucketDBUpdater.hasPendingClusterState()) {
             startNextMaintenanceOperation();
         }
@@ -902,8 +954,16 @@ void
 DistributorStripe::propagate_config_snapshot_to_internal_components()
 {
     _bucketDBMetricUpdater.setMinimumReplicaCountingMode(getConfig().getMinimumReplicaCountingMode());
+    _dirty_bucket_tracker.set_enabled(getConfig().incremental_maintenance_scanning_enabled());
     _ownershipSafeTimeCalc->setMaxClusterClockSkew(getConfig().getMaxClusterClockSkew());
     _pendingMessageTracker.setNodeBusyDuration(getConfig().getInhibitMergesOnBusyNodeDuration());
+    _pendingMessageTracker.set_track_response_latencies(getConfig().per_node_maintenance_throttling_enabled());
+    AdaptiveNodeWindows::Config node_windows_config;
+    node_windows_config.min_window = getConfig().per_node_maintenance_window_min();
+    node_windows_config.max_window = getConfig().per_node_maintenance_window_max();
+    node_windows_config.slow_node_latency_factor = getConfig().slow_node_latency_factor();
+    _throttlingStarter->node_windows().set_config(node_windows_config);
+    _throttlingStarter->set_per_node_throttling_enabled(getConfig().per_node_maintenance_throttling_enabled());
     _bucketDBUpdater.set_stale_reads_enabled(getConfig().allowStaleReadsDuringClusterStateTransitions());
     _externalOperationHandler.set_concurrent_gets_enabled(
             getConfig().allowStaleReadsDuringClusterStateTransitions());
@@ -18,6 +18,7 @@
 #include <vespa/storage/common/messagesender.h>
 #include <vespa/storage/distributor/bucketdb/bucketdbmetricupdater.h>
 #include <vespa/storage/distributor/distributor_stripe_component.h>
+#include <vespa/storage/distributor/maintenance/dirty_bucket_tracker.h>
 #include <vespa/storage/distributor/maintenance/maintenancescheduler.h>
 #include <vespa/storageapi/message/state.h>
 #include <vespa/storageframework/generic/metric/metricupdatehook.h>
@@ -247,11 +248,14 @@ private:
     void maybe_update_bucket_db_memory_usage_stats();
     void scanAllBuckets();
     MaintenanceScanner::ScanResult scanNextBucket();
+    void maintenance_scan_tick();
+    void check_dirty_buckets();
     bool should_inhibit_current_maintenance_scan_tick() const noexcept;
     void mark_current_maintenance_tick_as_inhibited() noexcept;
     void mark_maintenance_tick_as_no_longer_inhibited() noexcept;
     void fetchExternalMessages();
     void startNextMaintenanceOperation();
+    void maybe_update_node_maintenance_windows();
     void signalWorkWasDone();
     bool workWasDone() const noexcept;
 
@@ -356,6 +360,7 @@ private:
 
     std::unique_ptr<BucketPriorityDatabase> _bucketPriorityDb;
     std::unique_ptr<SimpleMaintenanceScanner> _scanner;
+    DirtyBucketTracker _dirty_bucket_tracker;
     std::unique_ptr<ThrottlingOperationStarter> _throttlingStarter;
     std::unique_ptr<BlockingOperationStarter> _blockingStarter;
     std::unique_ptr<MaintenanceScheduler> _scheduler;
@@ -378,7 +383,9 @@ private:
     std::unique_ptr<OwnershipTransferSafeTimePointCalculator> _ownershipSafeTimeCalc;
     std::chrono::steady_clock::duration _db_memory_sample_interval;
     std::chrono::steady_clock::time_point _last_db_memory_sample_time_point;
+    std::chrono::steady_clock::time_point _last_node_window_update_time_point;
     size_t _inhibited_maintenance_tick_count;
+    uint32_t _ticks_since_background_scan;
     uint32_t _stripe_index;
     std::atomic<bool> _non_activation_maintenance_is_inhibited;
     bool _must_send_updated_host_info;
@@ -39,6 +39,14 @@ DistributorMetricSet::DistributorMetricSet()
       activate_cluster_state_processing_time("activate_cluster_state_processing_time", {},
               "Elapsed time in which the distributor thread is blocked on merging pending "
               "bucket info into its bucket database upon activating a cluster state", this),
+      db_pruning_processing_time("db_pruning_processing_time", {},
+              "Elapsed time spent pruning buckets no longer owned by this distributor "
+              "(or without available replicas) from the bucket database as part of "
+              "processing a new cluster state. Included in set_cluster_state_processing_time", this),
+      db_merging_processing_time("db_merging_processing_time", {},
+              "Elapsed time spent merging bucket info gathered from content nodes into "
+              "the bucket database as part of activating a cluster state. Included in "
+              "activate_cluster_state_processing_time", this),
       recoveryModeTime("recoverymodeschedulingtime", {},
               "Time spent scheduling operations in recovery mode "
               "after receiving new cluster state", this),
@@ -35,6 +35,8 @@ public:
     metrics::DoubleAverageMetric  stateTransitionTime;
     metrics::DoubleAverageMetric  set_cluster_state_processing_time;
     metrics::DoubleAverageMetric  activate_cluster_state_processing_time;
+    metrics::DoubleAverageMetric  db_pruning_processing_time;
+    metrics::DoubleAverageMetric  db_merging_processing_time;
     metrics::DoubleAverageMetric  recoveryModeTime;
     metrics::LongValueMetric      docsStored;
     metrics::LongValueMetric      bytesStored;
@@ -0,0 +1,102 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "dirty_bucket_tracker.h"
+#include <vespa/storage/distributor/distributor_bucket_space.h>
+#include <vespa/storage/distributor/distributor_bucket_space_repo.h>
+#include <vespa/vespalib/stllike/hash_set.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace storage::distributor {
+
+class DirtyBucketTracker::SpaceListener : public BucketDatabase::MutationListener {
+    DirtyBucketTracker&   _tracker;
+    document::BucketSpace _bucket_space;
+public:
+    SpaceListener(DirtyBucketTracker& tracker, document::BucketSpace bucket_space) noexcept
+        : _tracker(tracker),
+          _bucket_space(bucket_space)
+    {}
+    void on_bucket_mutated(const document::BucketId& bucket) override {
+        _tracker.mark_dirty(document::Bucket(_bucket_space, bucket));
+    }
+};
+
+DirtyBucketTracker::DirtyBucketTracker()
+    : _listeners(),
+      _attached_repo(nullptr),
+      _dirty_set(),
+      _dirty_order(),
+      _enabled(false)
+{
+}
+
+DirtyBucketTracker::~DirtyBucketTracker() {
+    detach();
+}
+
+void
+DirtyBucketTracker::attach_to(DistributorBucketSpaceRepo& repo)
+{
+    assert(_attached_repo == nullptr);
+    for (auto& space : repo) {
+        _listeners.emplace_back(std::make_unique<SpaceListener>(*this, space.first));
+        space.second->getBucketDatabase().set_mutation_listener(_listeners.back().get());
+    }
+    _attached_repo = &repo;
+}
+
+void
+DirtyBucketTracker::detach()
+{
+    if (_attached_repo == nullptr) {
+        return;
+    }
+    for (auto& space : *_attached_repo) {
+        space.second->getBucketDatabase().set_mutation_listener(nullptr);
+    }
+    _listeners.clear();
+    _attached_repo = nullptr;
+}
+
+void
+DirtyBucketTracker::set_enabled(bool enabled)
+{
+    if (!enabled) {
+        clear();
+    }
+    _enabled = enabled;
+}
+
+void
+DirtyBucketTracker::mark_dirty(const document::Bucket& bucket)
+{
+    if (!_enabled) {
+        return;
+    }
+    if (_dirty_set.insert(bucket).second) {
+        _dirty_order.push_back(bucket);
+    }
+}
+
+std::vector<document::Bucket>
+DirtyBucketTracker::take(size_t max_buckets)
+{
+    const size_t n = std::min(max_buckets, _dirty_order.size());
+    std::vector<document::Bucket> result(_dirty_order.begin(), _dirty_order.begin() + n);
+    _dirty_order.erase(_dirty_order.begin(), _dirty_order.begin() + n);
+    for (const auto& bucket : result) {
+        _dirty_set.erase(bucket);
+    }
+    return result;
+}
+
+void
+DirtyBucketTracker::clear()
+{
+    _dirty_set.clear();
+    _dirty_order.clear();
+}
+
+}
+
+VESPALIB_HASH_SET_INSTANTIATE_H(document::Bucket, document::Bucket::hash);
@@ -0,0 +1,55 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/document/bucket/bucket.h>
+#include <vespa/storage/bucketdb/bucketdatabase.h>
+#include <vespa/vespalib/stllike/hash_set.h>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace storage::distributor {
+
+class DistributorBucketSpaceRepo;
+
+/**
+ * Keeps track of buckets whose bucket database entries have been changed since they
+ * were last evaluated for maintenance, in the order in which they were first changed.
+ *
+ * The tracker registers itself as the mutation listener of the bucket databases of
+ * all bucket spaces in the repo it is attached to. Tracking is disabled by default,
+ * in which case mutations are ignored altogether.
+ *
+ * Not thread safe; must only be accessed by the stripe thread owning the databases.
+ */
+class DirtyBucketTracker {
+    class SpaceListener;
+
+    std::vector<std::unique_ptr<SpaceListener>>                   _listeners;
+    DistributorBucketSpaceRepo*                                   _attached_repo;
+    vespalib::hash_set<document::Bucket, document::Bucket::hash>  _dirty_set;
+    std::deque<document::Bucket>                                  _dirty_order;
+    bool                                                          _enabled;
+public:
+    DirtyBucketTracker();
+    DirtyBucketTracker(const DirtyBucketTracker&) = delete;
+    DirtyBucketTracker& operator=(const DirtyBucketTracker&) = delete;
+    ~DirtyBucketTracker();
+
+    void attach_to(DistributorBucketSpaceRepo& repo);
+    void detach();
+
+    // Disabling tracking also drops all currently tracked buckets.
+    void set_enabled(bool enabled);
+    [[nodiscard]] bool enabled() const noexcept { return _enabled; }
+
+    void mark_dirty(const document::Bucket& bucket);
+    // Returns up to max_buckets of the least recently dirtied buckets and stops tracking them.
+    [[nodiscard]] std::vector<document::Bucket> take(size_t max_buckets);
+    void clear();
+
+    [[nodiscard]] size_t size() const noexcept { return _dirty_order.size(); }
+    [[nodiscard]] bool empty() const noexcept { return _dirty_order.empty(); }
+};
+
+}
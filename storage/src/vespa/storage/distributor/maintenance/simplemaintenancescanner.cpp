@@ -107,6 +107,16 @@ SimpleMaintenanceScanner::prioritizeBucket(const document::Bucket &bucket)
     }
 }
 
+void
+SimpleMaintenanceScanner::reprioritize_bucket(const document::Bucket& bucket)
+{
+    NodeMaintenanceStatsTracker uncounted_stats;
+    MaintenancePriorityAndType pri(_priorityGenerator.prioritize(bucket, uncounted_stats));
+    if (pri.requiresMaintenance()) {
+        _bucketPriorityDb.setPriority(PrioritizedBucket(bucket, pri.getPriority().getPriority()));
+    }
+}
+
 std::ostream&
 operator<<(std::ostream& os, const SimpleMaintenanceScanner::GlobalMaintenanceStats& stats)
 {
@@ -57,6 +57,11 @@ public:
 
     // TODO: move out into own interface!
     void prioritizeBucket(const document::Bucket &id);
+    // Re-evaluates the maintenance priority of a single bucket outside the regular scan
+    // order. Unlike prioritizeBucket(), this does not count towards the pending
+    // maintenance stats of the current scan round, as the bucket will (also) be counted
+    // once the round-robin scan reaches it.
+    void reprioritize_bucket(const document::Bucket& bucket);
 
     // TODO Only for testing
     const PendingMaintenanceStats& getPendingMaintenanceStats() const noexcept {
@@ -3,9 +3,28 @@
 #include "distributor_stripe.h"
 #include "distributor_stripe_pool.h"
 #include "distributor_stripe_thread.h"
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 
 namespace storage::distributor {
 
+namespace {
+
+template <typename Func>
+struct StripeTask : vespalib::Runnable {
+    Func&           _func;
+    size_t          _stripe_idx;
+    TickableStripe& _stripe;
+
+    StripeTask(Func& func, size_t stripe_idx, TickableStripe& stripe) noexcept
+        : _func(func),
+          _stripe_idx(stripe_idx),
+          _stripe(stripe)
+    {}
+    void run() override { _func(_stripe_idx, _stripe); }
+};
+
+}
+
 MultiThreadedStripeAccessGuard::MultiThreadedStripeAccessGuard(
         MultiThreadedStripeAccessor& accessor,
         DistributorStripePool& stripe_pool)
@@ -70,10 +89,14 @@ MultiThreadedStripeAccessGuard::remove_superfluous_buckets(document::BucketSpace
                                                            const lib::ClusterState& new_state,
                                                            bool is_distribution_change)
 {
-    PotentialDataLossReport report;
-    for_each_stripe([&](TickableStripe& stripe) {
-        report.merge(stripe.remove_superfluous_buckets(bucket_space, new_state, is_distribution_change));
+    std::vector<PotentialDataLossReport> stripe_reports(_stripe_pool.stripe_count());
+    for_each_stripe_in_parallel([&](size_t stripe_idx, TickableStripe& stripe) {
+        stripe_reports[stripe_idx] = stripe.remove_superfluous_buckets(bucket_space, new_state, is_distribution_change);
     });
+    PotentialDataLossReport report;
+    for (const auto& stripe_report : stripe_reports) {
+        report.merge(stripe_report);
+    }
     return report;
 }
 
@@ -89,23 +112,42 @@ MultiThreadedStripeAccessGuard::merge_entries_into_db(document::BucketSpace buck
     if (entries.empty()) {
         return;
     }
-    std::vector<dbtransition::Entry> stripe_entries;
-    stripe_entries.reserve(entries.size() / _stripe_pool.stripe_count());
-    auto* curr_stripe = &_stripe_pool.stripe_of_key(entries[0].bucket_key);
-    stripe_entries.push_back(entries[0]);
-    for (size_t i = 1; i < entries.size(); ++i) {
-        const auto& entry = entries[i];
-        auto* next_stripe = &_stripe_pool.stripe_of_key(entry.bucket_key);
-        if (curr_stripe != next_stripe) {
-            curr_stripe->merge_entries_into_db(bucket_space, gathered_at_timestamp, distribution,
-                                               new_state, storage_up_states, outdated_nodes, stripe_entries);
-            stripe_entries.clear();
+    if (!_accessor.parallel_db_processing_enabled()) {
+        std::vector<dbtransition::Entry> stripe_entries;
+        stripe_entries.reserve(entries.size() / _stripe_pool.stripe_count());
+        auto* curr_stripe = &_stripe_pool.stripe_of_key(entries[0].bucket_key);
+        stripe_entries.push_back(entries[0]);
+        for (size_t i = 1; i < entries.size(); ++i) {
+            const auto& entry = entries[i];
+            auto* next_stripe = &_stripe_pool.stripe_of_key(entry.bucket_key);
+            if (curr_stripe != next_stripe) {
+                curr_stripe->merge_entries_into_db(bucket_space, gathered_at_timestamp, distribution,
+                                                   new_state, storage_up_states, outdated_nodes, stripe_entries);
+                stripe_entries.clear();
+            }
+            curr_stripe = next_stripe;
+            stripe_entries.push_back(entry);
         }
-        curr_stripe = next_stripe;
-        stripe_entries.push_back(entry);
+        curr_stripe->merge_entries_into_db(bucket_space, gathered_at_timestamp, distribution,
+                                           new_state, storage_up_states, outdated_nodes, stripe_entries);
+        return;
     }
-    curr_stripe->merge_entries_into_db(bucket_space, gathered_at_timestamp, distribution,
-                                       new_state, storage_up_states, outdated_nodes, stripe_entries);
+    // Partition entries up front so that each stripe can merge its own (still sorted)
+    // subset in a single DB pass concurrently with the other stripes.
+    std::vector<std::vector<dbtransition::Entry>> entries_per_stripe(_stripe_pool.stripe_count());
+    for (auto& stripe_entries : entries_per_stripe) {
+        stripe_entries.reserve(entries.size() / _stripe_pool.stripe_count());
+    }
+    for (const auto& entry : entries) {
+        entries_per_stripe[_stripe_pool.stripe_index_of_key(entry.bucket_key)].push_back(entry);
+    }
+    for_each_stripe_in_parallel([&](size_t stripe_idx, TickableStripe& stripe) {
+        const auto& stripe_entries = entries_per_stripe[stripe_idx];
+        if (!stripe_entries.empty()) {
+            stripe.merge_entries_into_db(bucket_space, gathered_at_timestamp, distribution,
+                                         new_state, storage_up_states, outdated_nodes, stripe_entries);
+        }
+    });
 }
 
 void MultiThreadedStripeAccessGuard::update_read_snapshot_before_db_pruning() {
@@ -181,6 +223,43 @@ void MultiThreadedStripeAccessGuard::for_each_stripe(Func&& f) const {
     }
 }
 
+template <typename Func>
+void MultiThreadedStripeAccessGuard::for_each_stripe_in_parallel(Func&& f) {
+    const size_t n_stripes = _stripe_pool.stripe_count();
+    auto* bundle = _accessor._db_processing_bundle.get();
+    if (!bundle || n_stripes == 1) {
+        for (size_t i = 0; i < n_stripes; ++i) {
+            f(i, _stripe_pool.stripe_thread(i).stripe());
+        }
+        return;
+    }
+    assert(bundle->size() >= n_stripes);
+    std::vector<StripeTask<Func>> tasks;
+    tasks.reserve(n_stripes);
+    for (size_t i = 0; i < n_stripes; ++i) {
+        tasks.emplace_back(f, i, _stripe_pool.stripe_thread(i).stripe());
+    }
+    bundle->run(tasks);
+}
+
+MultiThreadedStripeAccessor::MultiThreadedStripeAccessor(DistributorStripePool& stripe_pool)
+    : _stripe_pool(stripe_pool),
+      _db_processing_bundle(),
+      _guard_held(false)
+{}
+
+MultiThreadedStripeAccessor::~MultiThreadedStripeAccessor() = default;
+
+void MultiThreadedStripeAccessor::set_parallel_db_processing_enabled(bool enabled) {
+    assert(!_guard_held);
+    const bool want_bundle = enabled && (_stripe_pool.stripe_count() > 1);
+    if (want_bundle && !_db_processing_bundle) {
+        _db_processing_bundle = std::make_unique<vespalib::SimpleThreadBundle>(_stripe_pool.stripe_count());
+    } else if (!want_bundle) {
+        _db_processing_bundle.reset();
+    }
+}
+
 std::unique_ptr<StripeAccessGuard> MultiThreadedStripeAccessor::rendezvous_and_hold_all() {
     // For sanity checking of invariant of only one guard being allowed at any given time.
     assert(!_guard_held);
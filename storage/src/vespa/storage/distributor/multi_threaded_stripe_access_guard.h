@@ -3,6 +3,8 @@
 
 #include "stripe_access_guard.h"
 
+namespace vespalib { struct ThreadBundle; }
+
 namespace storage::distributor {
 
 class MultiThreadedStripeAccessor;
@@ -18,6 +20,11 @@ class TickableStripe;
  * Threads are automatically un-parked upon guard destruction.
  *
  * At most one guard instance may exist at any given time.
+ *
+ * If the accessor has parallel DB processing enabled, bucket DB pruning and merging
+ * during cluster state transitions are performed for all stripes in parallel. This is
+ * safe since each stripe exclusively owns its bucket databases and the stripe threads
+ * are parked while the guard is held.
  */
 class MultiThreadedStripeAccessGuard : public StripeAccessGuard {
     MultiThreadedStripeAccessor& _accessor;
@@ -67,6 +74,11 @@ private:
 
     template <typename Func>
     void for_each_stripe(Func&& f) const;
+
+    // Invokes f(stripe_idx, stripe) for all stripes, using the accessor's DB processing
+    // thread bundle if present. Returns once f has completed for all stripes.
+    template <typename Func>
+    void for_each_stripe_in_parallel(Func&& f);
 };
 
 /**
@@ -74,18 +86,24 @@ private:
  * in the provided stripe pool.
  */
 class MultiThreadedStripeAccessor : public StripeAccessor {
-    DistributorStripePool& _stripe_pool;
-    bool                   _guard_held;
+    DistributorStripePool&                   _stripe_pool;
+    std::unique_ptr<vespalib::ThreadBundle>  _db_processing_bundle;
+    bool                                     _guard_held;
 
     friend class MultiThreadedStripeAccessGuard;
 public:
-    explicit MultiThreadedStripeAccessor(DistributorStripePool& stripe_pool)
-        : _stripe_pool(stripe_pool),
-          _guard_held(false)
-    {}
-    ~MultiThreadedStripeAccessor() override = default;
+    explicit MultiThreadedStripeAccessor(DistributorStripePool& stripe_pool);
+    ~MultiThreadedStripeAccessor() override;
 
     std::unique_ptr<StripeAccessGuard> rendezvous_and_hold_all() override;
+
+    // If enabled (and there is more than one stripe), bucket DB processing for cluster
+    // state transitions is spread across a dedicated thread bundle with one thread per
+    // stripe. Must not be called while a guard is held.
+    void set_parallel_db_processing_enabled(bool enabled);
+    [[nodiscard]] bool parallel_db_processing_enabled() const noexcept {
+        return static_cast<bool>(_db_processing_bundle);
+    }
 private:
     void mark_guard_released();
 };
@@ -164,6 +164,10 @@ public:
 
     void on_throttled() override;
 
+    [[nodiscard]] std::span<const uint16_t> target_nodes() const noexcept override {
+        return getNodes();
+    }
+
     /**
        Called by IdealStateManager to allow the operation to call back its
        OperationFinished() method when done.
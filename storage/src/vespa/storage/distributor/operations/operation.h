@@ -5,6 +5,7 @@
 #include <vespa/vdslib/state/nodetype.h>
 #include <vespa/storage/distributor/distributormessagesender.h>
 #include <vespa/vespalib/util/time.h>
+#include <span>
 
 namespace storage {
 
@@ -97,6 +98,14 @@ public:
      */
     virtual void on_throttled();
 
+    /**
+     * Returns the content nodes this operation will send requests to, if these are
+     * known before the operation is started. Used for per-node throttling.
+     */
+    [[nodiscard]] virtual std::span<const uint16_t> target_nodes() const noexcept {
+        return {};
+    }
+
     /**
         Transfers message settings such as priority, timeout, etc. from one message to another.
     */
@@ -20,6 +20,7 @@ PendingMessageTracker::PendingMessageTracker(framework::ComponentRegister& cr, u
       _deferred_read_tasks(),
       _node_message_stats_tracker(),
       _trackTime(false),
+      _track_response_latencies(false),
       _lock()
 {
     _component.registerStatusPage(*this);
@@ -137,9 +138,11 @@ PendingMessageTracker::insert(const std::shared_ptr<api::StorageMessage>& msg)
         // TODO STRIPE reevaluate if getBucket() on RequestBucketInfo msgs should transparently return superbucket..!
         document::Bucket bucket = getBucket(*msg);
         {
-            // We will not start tracking time until we have been asked for html at least once.
-            // Time tracking is only used for presenting pending messages for debugging.
-            TimePoint now = (_trackTime.load(std::memory_order_relaxed)) ? currentTime() : TimePoint();
+            // We will not start tracking time until we have been asked for html at least once,
+            // unless response latencies are explicitly tracked. Time tracking is otherwise only
+            // used for presenting pending messages for debugging.
+            const bool track_time = (_track_response_latencies || _trackTime.load(std::memory_order_relaxed));
+            TimePoint now = track_time ? currentTime() : TimePoint();
             const uint16_t node_index = msg->getAddress()->getIndex();
             std::lock_guard guard(_lock);
             _messages.emplace(now, msg->getType().getId(), msg->getPriority(), msg->getMsgId(), bucket, node_index);
@@ -168,7 +171,11 @@ PendingMessageTracker::reply(const api::StorageReply& r)
         const uint16_t node_index = r.getAddress()->getIndex();
         _nodeInfo.decPending(node_index);
         api::ReturnCode::Result code = r.getResult().getResult();
-        _node_message_stats_tracker.stats_for(node_index).observe_incoming_response_result(r.getType().getId(), code);
+        auto& node_stats = _node_message_stats_tracker.stats_for(node_index);
+        node_stats.observe_incoming_response_result(r.getType().getId(), code);
+        if (_track_response_latencies && (iter->timeStamp != TimePoint())) {
+            node_stats.observe_response_latency(currentTime() - iter->timeStamp);
+        }
         if (code == api::ReturnCode::BUSY || code == api::ReturnCode::TIMEOUT) {
             _nodeInfo.setBusy(node_index, _nodeBusyDuration);
         }
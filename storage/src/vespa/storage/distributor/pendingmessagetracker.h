@@ -122,6 +122,14 @@ public:
         _nodeBusyDuration = duration;
     }
 
+    /**
+     * If enabled, the round-trip latency of every tracked request is sampled into
+     * the per-node content node message statistics.
+     */
+    void set_track_response_latencies(bool track) noexcept {
+        _track_response_latencies = track;
+    }
+
     void run_once_no_pending_for_bucket(const document::Bucket& bucket, std::unique_ptr<DeferredTask> task);
     void abort_deferred_tasks();
 
@@ -203,6 +211,7 @@ private:
     DeferredBucketTaskMap          _deferred_read_tasks;
     ContentNodeMessageStatsTracker _node_message_stats_tracker;
     mutable std::atomic<bool>      _trackTime;
+    bool                           _track_response_latencies;
 
     // Protects sampling of content node statistics and status page rendering, as this can happen
     // from arbitrary other threads than the owning stripe's worker thread.
@@ -24,12 +24,20 @@ ThrottlingOperationStarter::canStart(uint32_t currentOperationCount, Priority pr
 bool
 ThrottlingOperationStarter::start(const std::shared_ptr<Operation>& operation, Priority priority)
 {
-    if (!may_allow_operation_with_priority(priority)) {
+    if (!may_allow_operation_with_priority(priority)
+        || (_per_node_throttling_enabled && !node_windows_allow(operation->target_nodes())))
+    {
         operation->on_throttled();
         return false;
     }
     auto wrappedOp = std::make_shared<ThrottlingOperation>(operation, *this);
     ++_pendingCount;
+    for (uint16_t node : wrappedOp->counted_nodes()) {
+        if (node >= _per_node_pending.size()) {
+            _per_node_pending.resize(node + 1);
+        }
+        ++_per_node_pending[node];
+    }
     return _starterImpl.start(wrappedOp, priority);
 }
 
@@ -39,12 +47,26 @@ ThrottlingOperationStarter::may_allow_operation_with_priority(Priority priority)
     return canStart(_pendingCount, priority);
 }
 
+bool
+ThrottlingOperationStarter::node_windows_allow(std::span<const uint16_t> nodes) const noexcept
+{
+    for (uint16_t node : nodes) {
+        if (pending_count_for_node(node) >= _node_windows.window_for(node)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void
-ThrottlingOperationStarter::signalOperationFinished(const Operation& op)
+ThrottlingOperationStarter::signalOperationFinished(const ThrottlingOperation& op)
 {
-    (void) op;
     assert(_pendingCount > 0);
     --_pendingCount;
+    for (uint16_t node : op.counted_nodes()) {
+        assert(pending_count_for_node(node) > 0);
+        --_per_node_pending[node];
+    }
 }
 
 }
@@ -1,10 +1,12 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "adaptive_node_windows.h"
 #include "operationstarter.h"
 #include <vespa/storage/distributor/maintenance/pending_window_checker.h>
 #include <vespa/vespalib/util/hdr_abort.h>
 #include <vespa/storage/distributor/operations/operation.h>
+#include <vector>
 
 namespace storage::distributor {
 
@@ -16,13 +18,18 @@ class ThrottlingOperationStarter : public OperationStarter, public PendingWindow
         ThrottlingOperation(Operation::SP operation,
                             ThrottlingOperationStarter& operationStarter)
             : _operation(std::move(operation)),
-              _operationStarter(operationStarter)
+              _operationStarter(operationStarter),
+              _nodes(_operation->target_nodes().begin(), _operation->target_nodes().end())
         {}
 
         ~ThrottlingOperation() override;
+
+        // Nodes as observed when the operation was started, used for per-node pending counts.
+        [[nodiscard]] const std::vector<uint16_t>& counted_nodes() const noexcept { return _nodes; }
     private:
         Operation::SP _operation;
         ThrottlingOperationStarter& _operationStarter;
+        std::vector<uint16_t> _nodes;
 
         ThrottlingOperation(const ThrottlingOperation&);
         ThrottlingOperation& operator=(const ThrottlingOperation&);
@@ -39,6 +46,9 @@ class ThrottlingOperationStarter : public OperationStarter, public PendingWindow
         [[nodiscard]] std::string toString() const override {
             return _operation->toString();
         }
+        [[nodiscard]] std::span<const uint16_t> target_nodes() const noexcept override {
+            return _operation->target_nodes();
+        }
         void start(DistributorStripeMessageSender& sender, vespalib::system_time startTime) override {
             _operation->start(sender, startTime);
         }
@@ -62,7 +72,10 @@ public:
         : _starterImpl(starterImpl),
           _minPending(0),
           _maxPending(UINT32_MAX),
-          _pendingCount(0)
+          _pendingCount(0),
+          _per_node_throttling_enabled(false),
+          _node_windows(),
+          _per_node_pending()
     {}
     ~ThrottlingOperationStarter() override;
 
@@ -77,16 +90,37 @@ public:
         _maxPending = maxPending;
     }
 
+    /**
+     * If enabled, operations are additionally throttled by the adaptive window of each of
+     * their target nodes, i.e. an operation is only started if every node it targets has
+     * fewer pending operations (started via this starter) than its current window size.
+     */
+    void set_per_node_throttling_enabled(bool enabled) noexcept {
+        _per_node_throttling_enabled = enabled;
+    }
+    [[nodiscard]] bool per_node_throttling_enabled() const noexcept { return _per_node_throttling_enabled; }
+
+    [[nodiscard]] AdaptiveNodeWindows& node_windows() noexcept { return _node_windows; }
+    [[nodiscard]] const AdaptiveNodeWindows& node_windows() const noexcept { return _node_windows; }
+
+    [[nodiscard]] bool node_windows_allow(std::span<const uint16_t> nodes) const noexcept;
+    [[nodiscard]] uint32_t pending_count_for_node(uint16_t node) const noexcept {
+        return (node < _per_node_pending.size()) ? _per_node_pending[node] : 0;
+    }
+
 private:
     ThrottlingOperationStarter(const ThrottlingOperationStarter&);
     ThrottlingOperationStarter& operator=(const ThrottlingOperationStarter&);
 
     friend class ThrottlingOperation;
-    void signalOperationFinished(const Operation& op);
+    void signalOperationFinished(const ThrottlingOperation& op);
 
     uint32_t _minPending;
     uint32_t _maxPending;
     uint32_t _pendingCount;
+    bool _per_node_throttling_enabled;
+    AdaptiveNodeWindows _node_windows;
+    std::vector<uint32_t> _per_node_pending;
 };
 
 }
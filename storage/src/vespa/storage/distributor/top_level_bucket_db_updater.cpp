@@ -120,6 +120,7 @@ TopLevelBucketDBUpdater::remove_superfluous_buckets(
         const lib::ClusterStateBundle& new_state,
         bool is_distribution_config_change)
 {
+    framework::MilliSecTimer pruning_timer(_node_ctx.clock());
     const char* up_states = storage_node_up_states();
     for (auto& elem : _op_ctx.bucket_space_states()) {
         const auto& old_cluster_state(elem.second->get_cluster_state());
@@ -145,6 +146,8 @@ TopLevelBucketDBUpdater::remove_superfluous_buckets(
         }
         maybe_inject_simulated_db_pruning_delay();
     }
+    _distributor_interface.metrics().db_pruning_processing_time.addValue(
+            pruning_timer.getElapsedTimeAsDouble());
 }
 
 namespace {
@@ -410,8 +413,11 @@ TopLevelBucketDBUpdater::activate_pending_cluster_state(StripeAccessGuard& guard
 {
     framework::MilliSecTimer process_timer(_node_ctx.clock());
 
+    framework::MilliSecTimer merging_timer(_node_ctx.clock());
     _pending_cluster_state->merge_into_bucket_databases(guard);
     maybe_inject_simulated_db_merging_delay();
+    _distributor_interface.metrics().db_merging_processing_time.addValue(
+            merging_timer.getElapsedTimeAsDouble());
 
     if (_pending_cluster_state->isVersionedTransition()) {
         LOG(debug, "Activating pending cluster state version %u", _pending_cluster_state->clusterStateVersion());
@@ -508,6 +508,7 @@ TopLevelDistributor::enable_next_config_if_changed()
             auto guard = _stripe_accessor->rendezvous_and_hold_all();
             guard->update_total_distributor_config(_component.total_distributor_config_sp());
         }
+        _stripe_accessor->set_parallel_db_processing_enabled(_total_config->parallel_cluster_state_db_processing());
         _maintenance_safe_time_delay = _total_config->getMaxClusterClockSkew();
         _current_internal_config_generation = _component.internal_config_generation();
     }
@@ -48,7 +48,7 @@ class DistributorStatus;
 class DistributorStripe;
 class DistributorStripePool;
 class DistributorTotalMetrics;
-class StripeAccessor;
+class MultiThreadedStripeAccessor;
 class OperationSequencer;
 class OwnershipTransferSafeTimePointCalculator;
 class SimpleMaintenanceScanner;
@@ -202,7 +202,7 @@ private:
     uint8_t                               _n_stripe_bits;
     DistributorStripePool&                _stripe_pool;
     std::vector<std::unique_ptr<DistributorStripe>> _stripes;
-    std::unique_ptr<StripeAccessor>      _stripe_accessor;
+    std::unique_ptr<MultiThreadedStripeAccessor> _stripe_accessor;
     storage::lib::RandomGen              _random_stripe_gen;
     std::mutex                           _random_stripe_gen_mutex;
     MessageQueue                         _message_queue; // Queue for top-level ops
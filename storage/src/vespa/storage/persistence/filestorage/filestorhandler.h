@@ -293,6 +293,14 @@ public:
     virtual void set_throttle_apply_bucket_diff_ops(bool throttle_apply_bucket_diff) noexcept = 0;
 
     virtual void set_max_feed_op_batch_size(uint32_t max_batch) noexcept = 0;
+
+    /**
+     * If enabled, a persistence thread whose own stripe has an empty queue may take
+     * operations from the queues of other stripes. Bucket locks are still owned by the
+     * stripe the bucket belongs to, so an operation is only taken if it does not conflict
+     * with any held lock.
+     */
+    virtual void set_work_stealing(bool enabled) noexcept = 0;
 private:
     vespalib::duration _getNextMessageTimout;
 };
@@ -37,6 +37,9 @@ uint32_t per_stripe_maintenance_limit(uint32_t num_threads, uint32_t num_stripes
     return std::max(1u, (num_threads / num_stripes) / 2);
 }
 
+// Max time a persistence thread with an empty stripe queue waits before looking for work in other stripes.
+constexpr vespalib::duration steal_poll_interval = 10ms;
+
 }
 
 FileStorHandlerImpl::FileStorHandlerImpl(MessageSender& sender, FileStorMetrics& metrics,
@@ -66,7 +69,8 @@ FileStorHandlerImpl::FileStorHandlerImpl(uint32_t numThreads, uint32_t numStripe
       _paused(false),
       _throttle_apply_bucket_diff_ops(false),
       _last_active_operations_stats(),
-      _max_feed_op_batch_size(1)
+      _max_feed_op_batch_size(1),
+      _work_stealing(false)
 {
     assert(numStripes > 0);
     _stripes.reserve(numStripes);
@@ -380,6 +384,9 @@ FileStorHandlerImpl::updateMetrics(const MetricLockGuard &)
         const auto & m = stripe->averageQueueWaitingTime;
         _metrics->averageQueueWaitingTime.addTotalValueWithCount(m.getTotal(), m.getCount());
     }
+    for (size_t i = 0; i < _stripes.size() && i < _metrics->stripes.size(); ++i) {
+        _metrics->stripes[i]->queue_size.addValue(_stripes[i].get_cached_queue_size());
+    }
     update_active_operations_metrics();
 }
 
@@ -421,7 +428,13 @@ FileStorHandlerImpl::getNextMessage(uint32_t stripeId, vespalib::steady_time dea
     if (!tryHandlePause()) {
         return {}; // Still paused, return to allow tick.
     }
-    return _stripes[stripeId].getNextMessage(deadline);
+    if (should_steal(stripeId)) {
+        auto stolen = steal_message(stripeId);
+        if (stolen.lock) {
+            return stolen;
+        }
+    }
+    return _stripes[stripeId].getNextMessage(steal_aware_deadline(stripeId, deadline));
 }
 
 FileStorHandler::LockedMessageBatch
@@ -430,7 +443,37 @@ FileStorHandlerImpl::next_message_batch(uint32_t stripe_id, vespalib::steady_tim
     if (!tryHandlePause()) {
         return {};
     }
-    return _stripes[stripe_id].next_message_batch(now, deadline);
+    if (should_steal(stripe_id)) {
+        auto stolen = steal_message(stripe_id);
+        if (stolen.lock) {
+            return LockedMessageBatch(std::move(stolen));
+        }
+    }
+    return _stripes[stripe_id].next_message_batch(now, steal_aware_deadline(stripe_id, deadline));
+}
+
+FileStorHandler::LockedMessage
+FileStorHandlerImpl::steal_message(uint32_t thief_stripe_id)
+{
+    const size_t num_stripes = _stripes.size();
+    for (size_t i = 1; i < num_stripes; ++i) {
+        auto stolen = _stripes[(thief_stripe_id + i) % num_stripes].try_steal_message();
+        if (stolen.lock) {
+            return stolen;
+        }
+    }
+    return {};
+}
+
+vespalib::steady_time
+FileStorHandlerImpl::steal_aware_deadline(uint32_t stripe_id, vespalib::steady_time deadline) const noexcept
+{
+    // A thread waiting on its own (empty) stripe is not woken up by operations scheduled to other
+    // stripes, so bound the wait to make it poll for stealable work with a reasonable frequency.
+    if (!should_steal(stripe_id)) {
+        return deadline;
+    }
+    return std::min(deadline, _component.getClock().getMonotonicTime() + steal_poll_interval);
 }
 
 FileStorHandler::LockedMessage
@@ -1054,6 +1097,38 @@ document::GlobalId gid_from_feed_op(const api::StorageMessage& msg) {
 
 } // anon ns
 
+FileStorHandler::LockedMessage
+FileStorHandlerImpl::Stripe::try_steal_message()
+{
+    if (get_cached_queue_size() == 0) {
+        return {};
+    }
+    std::unique_lock guard(*_lock, std::try_to_lock);
+    if (!guard.owns_lock() || _owner.isPaused()) {
+        return {};
+    }
+    PriorityIdx& idx(bmi::get<1>(*_queue));
+    PriorityIdx::iterator iter(idx.begin()), end(idx.end());
+    while ((iter != end) && operationIsInhibited(guard, iter->_bucket, *iter->_command)) {
+        ++iter;
+    }
+    if (iter == end) {
+        return {};
+    }
+    ThrottleToken throttle_token;
+    if (operation_type_should_be_throttled(iter->_command->getType().getId())) {
+        throttle_token = _owner.operation_throttler().try_acquire_one();
+        if (!throttle_token.valid()) {
+            return {};
+        }
+    }
+    auto stolen = getMessage(guard, idx, iter, std::move(throttle_token));
+    if (stolen.lock) {
+        _metrics->stolen_operations.inc();
+    }
+    return stolen;
+}
+
 FileStorHandler::LockedMessageBatch
 FileStorHandlerImpl::Stripe::next_message_batch(vespalib::steady_time now, vespalib::steady_time deadline)
 {
@@ -157,6 +157,10 @@ public:
 
         [[nodiscard]] FileStorHandler::LockedMessage getNextMessage(vespalib::steady_time deadline);
         [[nodiscard]] FileStorHandler::LockedMessageBatch next_message_batch(vespalib::steady_time now, vespalib::steady_time deadline);
+        // Non-blocking attempt at taking the highest priority operation that is not inhibited,
+        // on behalf of a persistence thread belonging to another stripe. Returns an empty
+        // message if the stripe lock is contended or no operation can be dispatched right now.
+        [[nodiscard]] FileStorHandler::LockedMessage try_steal_message();
         void dumpQueue(std::ostream & os) const;
         void dumpActiveHtml(std::ostream & os) const;
         void dumpQueueHtml(std::ostream & os) const;
@@ -315,6 +319,13 @@ public:
         return _max_feed_op_batch_size.load(std::memory_order_relaxed);
     }
 
+    void set_work_stealing(bool enabled) noexcept override {
+        _work_stealing.store(enabled, std::memory_order_relaxed);
+    }
+    [[nodiscard]] bool work_stealing() const noexcept {
+        return _work_stealing.load(std::memory_order_relaxed);
+    }
+
     // Implements ResumeGuard::Callback
     void resume() override;
 
@@ -343,6 +354,7 @@ private:
     std::atomic<bool>               _throttle_apply_bucket_diff_ops;
     std::optional<ActiveOperationsStats> _last_active_operations_stats;
     std::atomic<uint32_t>           _max_feed_op_batch_size;
+    std::atomic<bool>               _work_stealing;
 
     // Returns the index in the targets array we are sending to, or -1 if none of them match.
     int calculateTargetBasedOnDocId(const api::StorageMessage& msg, std::vector<RemapInfo*>& targets);
@@ -409,6 +421,15 @@ private:
         _state.store(s, std::memory_order_relaxed);
     }
     bool isClosed() const noexcept { return getState() == DiskState::CLOSED; }
+    /**
+     * Returns true if the thread serving the given stripe should look for work in other stripes,
+     * i.e. work stealing is enabled and its own queue is empty.
+     */
+    bool should_steal(uint32_t stripe_id) const noexcept {
+        return work_stealing() && (_stripes.size() > 1) && (_stripes[stripe_id].get_cached_queue_size() == 0);
+    }
+    LockedMessage steal_message(uint32_t thief_stripe_id);
+    vespalib::steady_time steal_aware_deadline(uint32_t stripe_id, vespalib::steady_time deadline) const noexcept;
     void dumpActiveHtml(std::ostream & os) const;
     void dumpQueueHtml(std::ostream & os) const;
     void flush();
@@ -239,6 +239,7 @@ FileStorManager::on_configure(const StorFilestorConfig& config)
         _filestorHandler->reconfigure_dynamic_maintenance_throttler(updated_maintenance_dyn_throttle_params);
     }
     _filestorHandler->set_max_feed_op_batch_size(std::max(1, config.maxFeedOpBatchSize));
+    _filestorHandler->set_work_stealing(config.enableWorkStealing);
     // TODO remove once desired throttling behavior is set in stone
     {
         _filestorHandler->use_dynamic_operation_throttling(use_dynamic_operation_throttling);
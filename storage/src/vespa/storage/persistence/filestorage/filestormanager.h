@@ -95,6 +95,7 @@ public:
         return *_provider;
     }
     ProviderErrorWrapper& error_wrapper() noexcept;
+    ServiceLayerHostInfoReporter& host_info_reporter() noexcept { return _host_info_reporter; }
 
     void handleNewState() noexcept override;
 
@@ -188,7 +188,11 @@ FileStorStripeMetrics::FileStorStripeMetrics(const std::string& name, const std:
                                          "queued async operation because it was disallowed by the throttle policy", this),
       timeouts_waiting_for_throttle_token("timeouts_waiting_for_throttle_token", {},
                                           "Number of times a persistence thread timed out waiting for an available "
-                                          "throttle policy token", this)
+                                          "throttle policy token", this),
+      queue_size("queuesize", {}, "Size of input message queue of this stripe.", this),
+      stolen_operations("stolen_operations", {},
+                        "Number of operations queued in this stripe that were dispatched by a "
+                        "persistence thread belonging to another stripe (work stealing)", this)
 {
 }
 
@@ -121,6 +121,8 @@ public:
     metrics::LongCountMetric throttled_rpc_direct_dispatches;
     metrics::LongCountMetric throttled_persistence_thread_polls;
     metrics::LongCountMetric timeouts_waiting_for_throttle_token;
+    metrics::LongAverageMetric queue_size;
+    metrics::LongCountMetric stolen_operations;
     FileStorStripeMetrics(const std::string& name, const std::string& description);
     ~FileStorStripeMetrics() override;
 };
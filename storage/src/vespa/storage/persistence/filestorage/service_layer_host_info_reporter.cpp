@@ -104,6 +104,13 @@ ServiceLayerHostInfoReporter::update_resource_usage(const spi::ResourceUsage& re
     }
 }
 
+spi::ResourceUsage
+ServiceLayerHostInfoReporter::get_resource_usage_snapshot()
+{
+    std::lock_guard guard(_lock);
+    return get_usage();
+}
+
 void
 ServiceLayerHostInfoReporter::report(vespalib::JsonStream& output)
 {
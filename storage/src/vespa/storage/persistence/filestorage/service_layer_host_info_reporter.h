@@ -33,6 +33,8 @@ public:
     void set_noise_level(double level);
     void report(vespalib::JsonStream& output) override;
     const spi::ResourceUsage &get_old_resource_usage() noexcept { return _old_resource_usage; }
+    // Thread safe copy of the latest resource usage
+    spi::ResourceUsage get_resource_usage_snapshot();
 };
 
 }
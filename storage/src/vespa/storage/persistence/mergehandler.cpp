@@ -25,6 +25,23 @@ using vespalib::RetainGuard;
 
 namespace storage {
 
+/**
+ * A diff entry decoded from an ApplyBucketDiff command, ready to be written through the SPI.
+ * A null document means remove.
+ */
+struct MergeHandler::PreparedDiffWrite {
+    spi::Timestamp                      timestamp;
+    std::shared_ptr<document::Document> doc;
+    document::DocumentId                doc_id;
+
+    PreparedDiffWrite(spi::Timestamp timestamp_in, std::shared_ptr<document::Document> doc_in,
+                      document::DocumentId doc_id_in) noexcept
+        : timestamp(timestamp_in),
+          doc(std::move(doc_in)),
+          doc_id(std::move(doc_id_in))
+    {}
+};
+
 MergeHandler::MergeHandler(PersistenceUtil& env, spi::PersistenceProvider& spi,
                            const ClusterContext& cluster_context, const framework::Clock & clock,
                            vespalib::ISequencedTaskExecutor& executor,
@@ -508,7 +525,8 @@ MergeHandler::applyDiffEntry(std::shared_ptr<ApplyBucketDiffState> async_results
                              const spi::Bucket& bucket,
                              const api::ApplyBucketDiffCommand::Entry& e,
                              const document::DocumentTypeRepo& repo,
-                             const NewestDocumentVersionMapping& newest_per_doc) const
+                             const NewestDocumentVersionMapping& newest_per_doc,
+                             PreparedDiffWrites* deferred_writes) const
 {
     if (!e._docName.empty()) {
         auto version_iter = newest_per_doc.find(e._docName);
@@ -519,22 +537,35 @@ MergeHandler::applyDiffEntry(std::shared_ptr<ApplyBucketDiffState> async_results
             return;
         }
     }
+    spi::Timestamp timestamp(e._entry._timestamp);
+    PreparedDiffWrite write = (!(e._entry._flags & (DELETED | DELETED_IN_PLACE)))
+            ? PreparedDiffWrite(timestamp, std::shared_ptr<document::Document>(deserializeDiffDocument(e, repo)), document::DocumentId())
+            : PreparedDiffWrite(timestamp, std::shared_ptr<document::Document>(), document::DocumentId(e._docName));
+    if (deferred_writes != nullptr) {
+        deferred_writes->push_back(std::move(write));
+    } else {
+        dispatch_diff_write(std::move(async_results), bucket, std::move(write));
+    }
+}
+
+void
+MergeHandler::dispatch_diff_write(std::shared_ptr<ApplyBucketDiffState> async_results, const spi::Bucket& bucket,
+                                  PreparedDiffWrite write) const
+{
     // Important: token acquisitions MUST be in same order across all multi-throttled callsites.
     auto op_throttle_token = _env._fileStorHandler.operation_throttler().blocking_acquire_one();
     auto maintenance_throttle_token = _env._fileStorHandler.maintenance_throttler().blocking_acquire_one();
-    spi::Timestamp timestamp(e._entry._timestamp);
-    if (!(e._entry._flags & (DELETED | DELETED_IN_PLACE))) {
+    if (write.doc) {
         // Regular put entry
-        std::shared_ptr<document::Document> doc(deserializeDiffDocument(e, repo));
-        document::DocumentId docId = doc->getId();
+        document::DocumentId docId = write.doc->getId();
         auto complete = std::make_unique<ApplyBucketDiffEntryComplete>(std::move(async_results), std::move(docId),
                                                                        std::move(op_throttle_token), std::move(maintenance_throttle_token),
                                                                        "put",
                                                                        _clock, _env._metrics.merge_handler_metrics.merge_put_latency);
-        _spi.putAsync(bucket, timestamp, std::move(doc), std::move(complete));
+        _spi.putAsync(bucket, write.timestamp, std::move(write.doc), std::move(complete));
     } else {
         std::vector<spi::IdAndTimestamp> ids;
-        ids.emplace_back(document::DocumentId(e._docName), timestamp);
+        ids.emplace_back(std::move(write.doc_id), write.timestamp);
         auto complete = std::make_unique<ApplyBucketDiffEntryComplete>(std::move(async_results), ids[0].id,
                                                                        std::move(op_throttle_token), std::move(maintenance_throttle_token),
                                                                        "remove",
@@ -543,13 +574,24 @@ MergeHandler::applyDiffEntry(std::shared_ptr<ApplyBucketDiffState> async_results
     }
 }
 
+void
+MergeHandler::dispatch_diff_writes(const std::shared_ptr<ApplyBucketDiffState>& async_results, const spi::Bucket& bucket,
+                                   PreparedDiffWrites& writes) const
+{
+    for (auto& write : writes) {
+        dispatch_diff_write(async_results, bucket, std::move(write));
+    }
+    writes.clear();
+}
+
 /**
  * Apply the diffs needed locally.
  */
 void
 MergeHandler::applyDiffLocally(const spi::Bucket& bucket, std::vector<api::ApplyBucketDiffCommand::Entry>& diff,
                                uint8_t nodeIndex, spi::Context& context,
-                               const std::shared_ptr<ApplyBucketDiffState> & async_results) const
+                               const std::shared_ptr<ApplyBucketDiffState> & async_results,
+                               PreparedDiffWrites* deferred_writes) const
 {
     // Sort the data to apply by which file they should be added to
     LOG(spam, "Merge(%s): Applying data locally. Diff has %zu entries",
@@ -596,7 +638,7 @@ MergeHandler::applyDiffLocally(const spi::Bucket& bucket, std::vector<api::Apply
             ++i;
             LOG(spam, "ApplyBucketDiff(%s): Adding slot %s",
                 bucket.toString().c_str(), e.toString().c_str());
-            applyDiffEntry(async_results, bucket, e, repo, newest_versions);
+            applyDiffEntry(async_results, bucket, e, repo, newest_versions, deferred_writes);
         } else {
             assert(spi::Timestamp(e._entry._timestamp) == existing.getTimestamp());
             // Diffing for existing timestamp; should either both be put
@@ -607,7 +649,7 @@ MergeHandler::applyDiffLocally(const spi::Bucket& bucket, std::vector<api::Apply
             if ((e._entry._flags & DELETED) && !existing.isRemove()) {
                 LOG(debug, "Slot in diff is remove for existing timestamp in %s. Diff slot: %s. Existing slot: %s",
                     bucket.toString().c_str(), e.toString().c_str(), existing.toString().c_str());
-                applyDiffEntry(async_results, bucket, e, repo, newest_versions);
+                applyDiffEntry(async_results, bucket, e, repo, newest_versions, deferred_writes);
             } else {
                 // Duplicate put, just ignore it.
                 LOG(debug, "During diff apply, attempting to add slot whose timestamp already exists in %s, "
@@ -635,7 +677,7 @@ MergeHandler::applyDiffLocally(const spi::Bucket& bucket, std::vector<api::Apply
         LOG(spam, "ApplyBucketDiff(%s): Adding slot %s",
             bucket.toString().c_str(), e.toString().c_str());
 
-        applyDiffEntry(async_results, bucket, e, repo, newest_versions);
+        applyDiffEntry(async_results, bucket, e, repo, newest_versions, deferred_writes);
         byteCount += e._headerBlob.size() + e._bodyBlob.size();
     }
     if (byteCount + notNeededByteCount != 0) {
@@ -1279,9 +1321,13 @@ MergeHandler::handleApplyBucketDiff(api::ApplyBucketDiffCommand& cmd, MessageTra
             bucket.toString().c_str(), cmd.getDiff().size(),
             _env._nodeIndex, index);
     }
+    // When not last in chain, the local writes are issued after the diff has been sent on to the
+    // next node, such that the next node can apply the diff while we are writing it.
+    PreparedDiffWrites deferred_writes;
     if (applyDiffHasLocallyNeededData(cmd.getDiff(), index)) {
        async_results = ApplyBucketDiffState::create(*this, _env._metrics.merge_handler_metrics, _clock, bucket, RetainGuard(*_monitored_ref_count));
-       applyDiffLocally(bucket, cmd.getDiff(), index, tracker->context(), async_results);
+       applyDiffLocally(bucket, cmd.getDiff(), index, tracker->context(), async_results,
+                        lastInChain ? nullptr : &deferred_writes);
     } else {
         LOG(spam, "Merge(%s): Didn't need fetched data on node %u (%u).",
             bucket.toString().c_str(), _env._nodeIndex, index);
@@ -1305,9 +1351,12 @@ MergeHandler::handleApplyBucketDiff(api::ApplyBucketDiffCommand& cmd, MessageTra
             }
         }
 
+        // Move the diff out of the command before creating the reply to avoid copying the payload
+        std::vector<api::ApplyBucketDiffCommand::Entry> diff;
+        diff.swap(cmd.getDiff());
         auto reply = std::make_shared<api::ApplyBucketDiffReply>(cmd);
         tracker->setReply(reply);
-        static_cast<api::ApplyBucketDiffReply&>(tracker->getReply()).getDiff().swap(cmd.getDiff());
+        static_cast<api::ApplyBucketDiffReply&>(tracker->getReply()).getDiff().swap(diff);
         LOG(spam, "Replying to ApplyBucketDiff for %s to node %d.",
             bucket.toString().c_str(), cmd.getNodes()[index - 1].index);
         if (async_results) {
@@ -1319,13 +1368,15 @@ MergeHandler::handleApplyBucketDiff(api::ApplyBucketDiffCommand& cmd, MessageTra
         MergeStateDeleter stateGuard(_env._fileStorHandler, bucket.getBucket());
         auto s = std::make_shared<MergeStatus>(_clock, cmd.getPriority(), cmd.getTrace().getLevel());
         _env._fileStorHandler.addMergeStatus(bucket.getBucket(), s);
-        s->pendingApplyDiff = std::make_shared<api::ApplyBucketDiffReply>(cmd);
 
         LOG(spam, "Sending ApplyBucketDiff for %s on to node %d",
             bucket.toString().c_str(), cmd.getNodes()[index + 1].index);
         auto cmd2 = std::make_shared<api::ApplyBucketDiffCommand>(bucket.getBucket(), cmd.getNodes());
         cmd2->setAddress(createAddress(_cluster_context.cluster_name_ptr(), cmd.getNodes()[index + 1].index));
         cmd2->getDiff().swap(cmd.getDiff());
+        // The diff of the pending reply is replaced by the diff of the reply from the next node,
+        // so it is created after the diff (with payload) has been moved to the forwarded command.
+        s->pendingApplyDiff = std::make_shared<api::ApplyBucketDiffReply>(cmd);
         cmd2->setPriority(cmd.getPriority());
         cmd2->setTimeout(cmd.getTimeout());
         s->pendingId = cmd2->getMsgId();
@@ -1337,6 +1388,9 @@ MergeHandler::handleApplyBucketDiff(api::ApplyBucketDiffCommand& cmd, MessageTra
         // Everything went fine. Don't delete state but wait for reply
         stateGuard.deactivate();
         tracker->dontReply();
+        if (async_results) {
+            dispatch_diff_writes(async_results, bucket, deferred_writes);
+        }
     }
 
     tracker_handover_guard.handover();
@@ -44,6 +44,8 @@ private:
     using Timestamp = framework::MicroSecTime;
 public:
     using NewestDocumentVersionMapping = vespalib::hash_map<std::string_view, api::Timestamp>;
+    struct PreparedDiffWrite;
+    using PreparedDiffWrites = std::vector<PreparedDiffWrite>;
 
     enum StateFlag {
         IN_USE                     = 0x01,
@@ -62,9 +64,18 @@ public:
                              std::vector<api::GetBucketDiffCommand::Entry>& output, spi::Context& context) const;
     void fetchLocalData(const spi::Bucket& bucket, std::vector<api::ApplyBucketDiffCommand::Entry>& diff,
                         uint8_t nodeIndex, spi::Context& context) const;
+    /**
+     * Apply the entries of the diff that are needed locally. If `deferred_writes` is given,
+     * the entries are only decoded and added to it; the writes must then be issued by
+     * dispatch_diff_writes(). This lets a node in the middle of a merge chain pass the diff
+     * on to the next node before it starts writing locally.
+     */
     void applyDiffLocally(const spi::Bucket& bucket, std::vector<api::ApplyBucketDiffCommand::Entry>& diff,
                           uint8_t nodeIndex, spi::Context& context,
-                          const std::shared_ptr<ApplyBucketDiffState> & async_results) const;
+                          const std::shared_ptr<ApplyBucketDiffState> & async_results,
+                          PreparedDiffWrites* deferred_writes = nullptr) const;
+    void dispatch_diff_writes(const std::shared_ptr<ApplyBucketDiffState>& async_results, const spi::Bucket& bucket,
+                              PreparedDiffWrites& writes) const;
     void sync_bucket_info(const spi::Bucket& bucket) const override;
     void schedule_delayed_delete(std::unique_ptr<ApplyBucketDiffState>) const override;
 
@@ -110,7 +121,10 @@ private:
      */
     void applyDiffEntry(std::shared_ptr<ApplyBucketDiffState> async_results, const spi::Bucket&,
                         const api::ApplyBucketDiffCommand::Entry&, const document::DocumentTypeRepo& repo,
-                        const NewestDocumentVersionMapping& newest_per_doc) const;
+                        const NewestDocumentVersionMapping& newest_per_doc,
+                        PreparedDiffWrites* deferred_writes) const;
+    void dispatch_diff_write(std::shared_ptr<ApplyBucketDiffState> async_results, const spi::Bucket& bucket,
+                             PreparedDiffWrite write) const;
 
     /**
      * Fill entries-vector with metadata for bucket up to maxTimestamp,
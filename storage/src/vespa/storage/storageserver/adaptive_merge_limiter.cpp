@@ -0,0 +1,71 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "adaptive_merge_limiter.h"
+#include <algorithm>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".storage.adaptive_merge_limiter");
+
+namespace storage {
+
+AdaptiveMergeLimiter::Params::Params() noexcept
+    : min_limit(1),
+      max_limit(16),
+      target_queue_latency_ms(200.0),
+      max_disk_usage(0.8),
+      decrease_factor(0.75),
+      increment(1.0)
+{
+}
+
+namespace {
+
+AdaptiveMergeLimiter::Params
+sanitized(AdaptiveMergeLimiter::Params params) noexcept
+{
+    params.max_limit = std::max(params.max_limit, 1u);
+    params.min_limit = std::clamp(params.min_limit, 1u, params.max_limit);
+    params.decrease_factor = std::clamp(params.decrease_factor, 0.0, 1.0);
+    params.increment = std::max(params.increment, 0.0);
+    return params;
+}
+
+}
+
+AdaptiveMergeLimiter::AdaptiveMergeLimiter(const Params& params)
+    : _params(sanitized(params)),
+      _limit(_params.max_limit)
+{
+}
+
+AdaptiveMergeLimiter::~AdaptiveMergeLimiter() = default;
+
+void
+AdaptiveMergeLimiter::set_params(const Params& params)
+{
+    _params = sanitized(params);
+    _limit = std::clamp(_limit, double(_params.min_limit), double(_params.max_limit));
+}
+
+AdaptiveMergeLimiter::Decision
+AdaptiveMergeLimiter::update(const NodeLoadSample& load, uint32_t active_merges)
+{
+    const double old_limit = _limit;
+    Decision decision = Decision::HOLD;
+    if ((load.persistence_queue_latency_ms > _params.target_queue_latency_ms) ||
+        (load.disk_usage > _params.max_disk_usage))
+    {
+        _limit = std::max(_limit * _params.decrease_factor, double(_params.min_limit));
+        decision = (_limit < old_limit) ? Decision::DECREASE : Decision::HOLD;
+    } else if (active_merges >= limit()) {
+        _limit = std::min(_limit + _params.increment, double(_params.max_limit));
+        decision = (_limit > old_limit) ? Decision::INCREASE : Decision::HOLD;
+    }
+    if (decision != Decision::HOLD) {
+        LOG(debug, "Merge limit %.2f -> %.2f (queue latency %.1f ms, disk usage %.3f, active merges %u)",
+            old_limit, _limit, load.persistence_queue_latency_ms, load.disk_usage, active_merges);
+    }
+    return decision;
+}
+
+}
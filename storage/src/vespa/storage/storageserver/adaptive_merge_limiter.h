@@ -0,0 +1,72 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstdint>
+
+namespace storage {
+
+/*
+ * Load observed on a content node since the previous sample.
+ */
+struct NodeLoadSample {
+    double persistence_queue_latency_ms; // Average time spent in the persistence queue
+    double disk_usage;                   // Relative disk usage, in [0, 1]
+
+    NodeLoadSample() noexcept : persistence_queue_latency_ms(0.0), disk_usage(0.0) {}
+    NodeLoadSample(double persistence_queue_latency_ms_, double disk_usage_) noexcept
+        : persistence_queue_latency_ms(persistence_queue_latency_ms_),
+          disk_usage(disk_usage_)
+    {}
+};
+
+class NodeLoadSampler {
+public:
+    virtual ~NodeLoadSampler() = default;
+    virtual NodeLoadSample sample_node_load() = 0;
+};
+
+/*
+ * Adjusts the limit of concurrently active merges on a node from observed node
+ * load, using additive increase and multiplicative decrease in the same manner
+ * as mbus::DynamicThrottlePolicy does for its window size:
+ *
+ *  - if the persistence queue latency is above its target or the disk usage is
+ *    above its limit, the merge limit is multiplied by the decrease factor.
+ *  - otherwise, if the limit is saturated by active merges, the limit is
+ *    increased by the increment.
+ *  - otherwise, the limit is kept as is.
+ *
+ * The limit is always kept within [min_limit, max_limit]. Not thread safe.
+ */
+class AdaptiveMergeLimiter {
+public:
+    struct Params {
+        uint32_t min_limit;
+        uint32_t max_limit;
+        double   target_queue_latency_ms;
+        double   max_disk_usage;
+        double   decrease_factor;
+        double   increment;
+
+        Params() noexcept;
+    };
+    enum class Decision {
+        HOLD,
+        INCREASE,
+        DECREASE
+    };
+private:
+    Params _params;
+    double _limit;
+public:
+    explicit AdaptiveMergeLimiter(const Params& params);
+    ~AdaptiveMergeLimiter();
+
+    // Keeps the current limit, clamped to the new bounds
+    void set_params(const Params& params);
+    [[nodiscard]] const Params& params() const noexcept { return _params; }
+    Decision update(const NodeLoadSample& load, uint32_t active_merges);
+    [[nodiscard]] uint32_t limit() const noexcept { return static_cast<uint32_t>(_limit); }
+};
+
+}
@@ -214,6 +214,17 @@ convert_to_rpc_compression_config(const vespa::config::content::core::StorCommun
     return CompressionConfig(compression_type, mgr_config.rpc.compress.level, 90, mgr_config.rpc.compress.limit);
 }
 
+template <typename DenseConfig>
+vespalib::compression::AdaptiveCompression::Config
+convert_to_adaptive_compression_config(const DenseConfig& dense) {
+    using vespalib::compression::CompressionConfig;
+    vespalib::compression::AdaptiveCompression::Config cfg;
+    cfg.dense = CompressionConfig(CompressionConfig::ZSTD, dense.level, 90);
+    cfg.dense_min_size = std::max(0, dense.limit);
+    cfg.slow_link_bytes_per_second = dense.slowLinkThroughput;
+    return cfg;
+}
+
 }
 
 CommunicationManager::CommunicationManager(StorageComponentRegister& compReg,
@@ -231,7 +242,10 @@ CommunicationManager::CommunicationManager(StorageComponentRegister& compReg,
       _configUri(configUri),
       _closed(false),
       _docApiConverter(std::make_shared<PlaceHolderBucketResolver>()),
-      _thread()
+      _thread(),
+      _compression_metrics_ready(false),
+      _last_rpc_compression_stats(),
+      _last_mbus_compression_stats()
 {
     _component.registerMetricUpdateHook(*this, 5s);
     _component.registerMetric(_metrics);
@@ -398,6 +412,7 @@ CommunicationManager::on_configure(const CommunicationManagerConfig& config)
                 CommunicationManagerConfig::Mbus::Compress::getTypeName(config.mbus.compress.type).c_str());
         params.setCompressionConfig(CompressionConfig(compressionType, config.mbus.compress.level,
                                                       90, config.mbus.compress.limit));
+        params.setAdaptiveCompressionConfig(convert_to_adaptive_compression_config(config.mbus.compress.dense));
 
         // Configure messagebus here as we for legacy reasons have
         // config here.
@@ -412,10 +427,13 @@ CommunicationManager::on_configure(const CommunicationManagerConfig& config)
 
     _message_codec_provider = std::make_unique<rpc::MessageCodecProvider>(_component.getTypeRepo()->documentTypeRepo);
     _shared_rpc_resources = std::make_unique<rpc::SharedRpcResources>(_configUri, config.rpcport,
-                                                                      config.rpc.numNetworkThreads, config.rpc.eventsBeforeWakeup);
+                                                                      config.rpc.numNetworkThreads, config.rpc.eventsBeforeWakeup,
+                                                                      std::max(0, config.rpc.zeroCopyThreshold),
+                                                                      std::max(0, config.rpc.priorityStreakLimit));
     _cc_rpc_service = std::make_unique<rpc::ClusterControllerApiRpcService>(*this, *_shared_rpc_resources);
     rpc::StorageApiRpcService::Params rpc_params;
     rpc_params.compression_config = convert_to_rpc_compression_config(config);
+    rpc_params.adaptive_compression = convert_to_adaptive_compression_config(config.rpc.compress.dense);
     rpc_params.num_rpc_targets_per_node = config.rpc.numTargetsPerNode;
     _storage_api_rpc_service = std::make_unique<rpc::StorageApiRpcService>(
             *this, *_shared_rpc_resources, *_message_codec_provider, rpc_params);
@@ -441,6 +459,7 @@ CommunicationManager::on_configure(const CommunicationManagerConfig& config)
         // _after_ we've initialized our internal member variables.
         _messageBusSession->register_session_deferred();
     }
+    _compression_metrics_ready.store(true, std::memory_order_release);
 }
 
 void
@@ -742,6 +761,16 @@ void
 CommunicationManager::updateMetrics(const MetricLockGuard &)
 {
     _metrics.queueSize.addValue(_eventQueue.size());
+    if (_compression_metrics_ready.load(std::memory_order_acquire) && !_closed.load(std::memory_order_relaxed)) {
+        auto rpc_stats = _storage_api_rpc_service->compression_stats();
+        _metrics.rpc_compression.update(rpc_stats.subtract(_last_rpc_compression_stats));
+        _last_rpc_compression_stats = rpc_stats;
+        if (_mbus) {
+            auto mbus_stats = _mbus->getRPCNetwork().getCompression().stats();
+            _metrics.mbus_compression.update(mbus_stats.subtract(_last_mbus_compression_stats));
+            _last_mbus_compression_stats = mbus_stats;
+        }
+    }
 }
 
 void
@@ -109,6 +109,9 @@ private:
     std::atomic<bool>     _closed;
     DocumentApiConverter  _docApiConverter;
     std::unique_ptr<framework::Thread> _thread;
+    std::atomic<bool>     _compression_metrics_ready; // set once RPC and mbus endpoints exist
+    vespalib::compression::AdaptiveCompression::Stats _last_rpc_compression_stats;
+    vespalib::compression::AdaptiveCompression::Stats _last_mbus_compression_stats;
 
     void updateMetrics(const MetricLockGuard &) override;
 
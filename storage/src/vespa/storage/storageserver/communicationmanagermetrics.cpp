@@ -5,6 +5,45 @@
 using namespace metrics;
 namespace storage {
 
+PayloadCompressionMetrics::PayloadCompressionMetrics(const std::string& name, const std::string& description, MetricSet* owner)
+    : MetricSet(name, {}, description, owner),
+      payloads("payloads", {}, "Number of payloads compressed", this),
+      input_bytes("input_bytes", {}, "Uncompressed size of compressed payloads", this),
+      output_bytes("output_bytes", {}, "Compressed size of compressed payloads", this),
+      ratio("ratio", {}, "Compression ratio (uncompressed size / compressed size)", this)
+{
+}
+
+PayloadCompressionMetrics::~PayloadCompressionMetrics() = default;
+
+void
+PayloadCompressionMetrics::update(const vespalib::compression::AdaptiveCompression::TypeStats& delta)
+{
+    if (delta.payloads == 0) {
+        return;
+    }
+    payloads.inc(delta.payloads);
+    input_bytes.inc(delta.input_bytes);
+    output_bytes.inc(delta.output_bytes);
+    ratio.addValue(delta.ratio());
+}
+
+TransportCompressionMetrics::TransportCompressionMetrics(const std::string& name, const std::string& description, MetricSet* owner)
+    : MetricSet(name, {}, description, owner),
+      lz4("lz4", "Payloads compressed with lz4", this),
+      zstd("zstd", "Payloads compressed with zstd", this)
+{
+}
+
+TransportCompressionMetrics::~TransportCompressionMetrics() = default;
+
+void
+TransportCompressionMetrics::update(const vespalib::compression::AdaptiveCompression::Stats& delta)
+{
+    lz4.update(delta.lz4);
+    zstd.update(delta.zstd);
+}
+
 CommunicationManagerMetrics::CommunicationManagerMetrics(MetricSet* owner)
     : MetricSet("communication", {}, "Metrics for the communication manager", owner),
       queueSize("messagequeue", {}, "Size of input message queue.", this),
@@ -18,7 +57,9 @@ CommunicationManagerMetrics::CommunicationManagerMetrics(MetricSet* owner)
       bucketSpaceMappingFailures("bucket_space_mapping_failures", {},
                                  "Number of messages that could not be resolved to a known bucket space", this),
       sendCommandLatency("sendcommandlatency", {}, "Average ms used to send commands to MBUS", this),
-      sendReplyLatency("sendreplylatency", {}, "Average ms used to send replies to MBUS", this)
+      sendReplyLatency("sendreplylatency", {}, "Average ms used to send replies to MBUS", this),
+      rpc_compression("rpc_compression", "Compression of outgoing storage API RPC payloads", this),
+      mbus_compression("mbus_compression", "Compression of outgoing MessageBus payloads", this)
 {
 }
 
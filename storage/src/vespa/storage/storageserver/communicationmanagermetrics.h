@@ -11,9 +11,30 @@
 #include <vespa/metrics/metricset.h>
 #include <vespa/metrics/valuemetric.h>
 #include <vespa/metrics/countmetric.h>
+#include <vespa/vespalib/util/adaptive_compression.h>
 
 namespace storage {
 
+struct PayloadCompressionMetrics : public metrics::MetricSet {
+    metrics::LongCountMetric payloads;
+    metrics::LongCountMetric input_bytes;
+    metrics::LongCountMetric output_bytes;
+    metrics::DoubleAverageMetric ratio;
+
+    PayloadCompressionMetrics(const std::string& name, const std::string& description, metrics::MetricSet* owner);
+    ~PayloadCompressionMetrics() override;
+    void update(const vespalib::compression::AdaptiveCompression::TypeStats& delta);
+};
+
+struct TransportCompressionMetrics : public metrics::MetricSet {
+    PayloadCompressionMetrics lz4;
+    PayloadCompressionMetrics zstd;
+
+    TransportCompressionMetrics(const std::string& name, const std::string& description, metrics::MetricSet* owner);
+    ~TransportCompressionMetrics() override;
+    void update(const vespalib::compression::AdaptiveCompression::Stats& delta);
+};
+
 struct CommunicationManagerMetrics : public metrics::MetricSet {
     metrics::LongAverageMetric queueSize;
     metrics::DoubleAverageMetric messageProcessTime;
@@ -23,6 +44,8 @@ struct CommunicationManagerMetrics : public metrics::MetricSet {
     metrics::LongCountMetric bucketSpaceMappingFailures;
     metrics::DoubleAverageMetric sendCommandLatency;
     metrics::DoubleAverageMetric sendReplyLatency;
+    TransportCompressionMetrics rpc_compression;
+    TransportCompressionMetrics mbus_compression;
 
     CommunicationManagerMetrics(metrics::MetricSet* owner = nullptr);
     ~CommunicationManagerMetrics();
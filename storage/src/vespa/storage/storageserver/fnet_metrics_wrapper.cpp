@@ -4,9 +4,53 @@
 
 namespace storage {
 
+namespace {
+
+double to_ms(vespalib::duration d) {
+    return vespalib::count_us(d) / 1000.0;
+}
+
+}
+
+FnetMetricsWrapper::LatencyMetrics::LatencyMetrics(const std::string& name, const std::string& description,
+                                                   metrics::MetricSet* owner)
+    : metrics::MetricSet(name, {}, description, owner),
+      count("count", {}, "number of latencies observed since last update", this),
+      average("average", {}, "average latency (ms)", this),
+      p50("p50", {}, "50th percentile latency (ms)", this),
+      p99("p99", {}, "99th percentile latency (ms)", this),
+      p999("p999", {}, "99.9th percentile latency (ms)", this),
+      max("max", {}, "maximum latency (ms)", this)
+{
+}
+
+FnetMetricsWrapper::LatencyMetrics::~LatencyMetrics() = default;
+
+void
+FnetMetricsWrapper::LatencyMetrics::update(const fnet::LatencyHistogram::Snapshot& delta)
+{
+    count.set(delta.count());
+    if (delta.count() > 0) {
+        average.set(to_ms(delta.average()));
+        p50.set(to_ms(delta.percentile(0.5)));
+        p99.set(to_ms(delta.percentile(0.99)));
+        p999.set(to_ms(delta.percentile(0.999)));
+        max.set(to_ms(delta.max()));
+    }
+}
+
 FnetMetricsWrapper::FnetMetricsWrapper(metrics::MetricSet* owner)
     : metrics::MetricSet("fnet", {}, "transport layer metrics", owner),
-      _num_connections("num-connections", {}, "total number of connection objects", this)
+      _num_connections("num-connections", {}, "total number of connection objects", this),
+      _zero_copy_bytes_sent("zero-copy-bytes-sent", {}, "total number of bytes written using zero-copy writes", this),
+      _read_to_decode("read-to-decode-latency", "time from socket seen readable until packet decoded", this),
+      _event_queue("event-queue-latency", "time from event posted until handled by transport thread", this),
+      _read_to_invoke("read-to-invoke-latency", "time from socket seen readable until RPC method invoked", this),
+      _output_drain("output-drain-latency", "time from packet queued on idle connection until written", this),
+      _invoke_queue_high("invoke-queue-high-latency", "time high priority RPC requests wait to be invoked", this),
+      _invoke_queue_normal("invoke-queue-normal-latency", "time normal priority RPC requests wait to be invoked", this),
+      _invoke_queue_low("invoke-queue-low-latency", "time low priority RPC requests wait to be invoked", this),
+      _prev_latency(fnet::LatencyStats::collect())
 {
 }
 
@@ -16,6 +60,17 @@ void
 FnetMetricsWrapper::update_metrics()
 {
     _num_connections.set(FNET_Connection::get_num_connections());
+    _zero_copy_bytes_sent.set(FNET_Connection::get_zero_copy_bytes_sent());
+    auto latency = fnet::LatencyStats::collect();
+    auto delta = latency.subtract(_prev_latency);
+    _prev_latency = latency;
+    _read_to_decode.update(delta.read_to_decode);
+    _event_queue.update(delta.event_queue);
+    _read_to_invoke.update(delta.read_to_invoke);
+    _output_drain.update(delta.output_drain);
+    _invoke_queue_high.update(delta.invoke_queue[uint32_t(fnet::Priority::HIGH)]);
+    _invoke_queue_normal.update(delta.invoke_queue[uint32_t(fnet::Priority::NORMAL)]);
+    _invoke_queue_low.update(delta.invoke_queue[uint32_t(fnet::Priority::LOW)]);
 }
 
 }
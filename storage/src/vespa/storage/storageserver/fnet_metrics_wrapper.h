@@ -6,6 +6,8 @@
 #include <vespa/metrics/valuemetric.h>
 
 #include <vespa/fnet/connection.h>
+#include <vespa/fnet/latency_histogram.h>
+#include <string>
 
 namespace storage {
 
@@ -13,7 +15,30 @@ namespace storage {
 class FnetMetricsWrapper : public metrics::MetricSet
 {
 private:
+    // Latency distribution observed since the previous metric update
+    struct LatencyMetrics : metrics::MetricSet {
+        metrics::LongValueMetric   count;
+        metrics::DoubleValueMetric average;
+        metrics::DoubleValueMetric p50;
+        metrics::DoubleValueMetric p99;
+        metrics::DoubleValueMetric p999;
+        metrics::DoubleValueMetric max;
+
+        LatencyMetrics(const std::string& name, const std::string& description, metrics::MetricSet* owner);
+        ~LatencyMetrics() override;
+        void update(const fnet::LatencyHistogram::Snapshot& delta);
+    };
+
     metrics::LongValueMetric _num_connections;
+    metrics::LongValueMetric _zero_copy_bytes_sent;
+    LatencyMetrics           _read_to_decode;
+    LatencyMetrics           _event_queue;
+    LatencyMetrics           _read_to_invoke;
+    LatencyMetrics           _output_drain;
+    LatencyMetrics           _invoke_queue_high;
+    LatencyMetrics           _invoke_queue_normal;
+    LatencyMetrics           _invoke_queue_low;
+    fnet::LatencyStats::Snapshot _prev_latency;
 
 public:
     explicit FnetMetricsWrapper(metrics::MetricSet* owner);
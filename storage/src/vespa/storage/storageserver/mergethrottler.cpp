@@ -70,6 +70,12 @@ MergeThrottler::Metrics::Metrics(metrics::MetricSet* owner)
                                    "memory usage (in bytes) of the merges currently in the active window", this),
       merge_memory_limit("merge_memory_limit", {}, "The active soft limit (in bytes) for memory used by merge operations on this node", this),
       bounced_due_to_back_pressure("bounced_due_to_back_pressure", {}, "Number of merges bounced due to resource exhaustion back-pressure", this),
+      adaptive_merge_limit("adaptive_merge_limit", {}, "The current adaptive limit of active merges, 0 if not enabled", this),
+      adaptive_merge_limit_increases("adaptive_merge_limit_increases", {}, "Number of times the adaptive merge limit has been raised", this),
+      adaptive_merge_limit_decreases("adaptive_merge_limit_decreases", {}, "Number of times the adaptive merge limit has been lowered", this),
+      sampled_persistence_queue_latency("sampled_persistence_queue_latency", {}, "Persistence queue latency (in ms) "
+                                        "observed by the adaptive merge limit", this),
+      sampled_disk_usage("sampled_disk_usage", {}, "Relative disk usage observed by the adaptive merge limit", this),
       chaining("mergechains", this),
       local("locallyexecutedmerges", this)
 { }
@@ -204,6 +210,10 @@ MergeThrottler::MergeThrottler(
       _backpressure_duration(std::chrono::seconds(30)),
       _active_merge_memory_used_bytes(0),
       _max_merge_memory_usage_bytes(0), // 0 ==> unlimited
+      _adaptive_limiter(),
+      _node_load_sampler(nullptr),
+      _adaptive_adjust_interval(std::chrono::seconds(1)),
+      _next_adaptive_adjustment(),
       _use_dynamic_throttling(false),
       _closing(false)
 {
@@ -229,6 +239,9 @@ MergeThrottler::on_configure(const StorServerConfig& new_config)
     if (new_config.resourceExhaustionMergeBackPressureDurationSecs < 0.0) {
         throw config::InvalidConfigException("Merge back-pressure duration cannot be less than 0");
     }
+    if (new_config.mergeThrottlingAdaptiveLimit.adjustIntervalSecs < 0.0) {
+        throw config::InvalidConfigException("Adaptive merge limit adjust interval cannot be less than 0");
+    }
     if (_use_dynamic_throttling) {
         auto min_win_sz = std::max(new_config.mergeThrottlingPolicy.minWindowSize, 1);
         auto max_win_sz = std::max(new_config.mergeThrottlingPolicy.maxWindowSize, 1);
@@ -241,10 +254,12 @@ MergeThrottler::on_configure(const StorServerConfig& new_config)
         _throttlePolicy->setWindowSizeIncrement(win_sz_increment);
         LOG(debug, "Using dynamic throttling window min/max [%d, %d], win size increment %.2g",
             min_win_sz, max_win_sz, win_sz_increment);
+        configure_adaptive_merge_limit(new_config, max_win_sz);
     } else {
         // Use legacy config values when static throttling is enabled.
         _throttlePolicy->setMinWindowSize(new_config.maxMergesPerNode);
         _throttlePolicy->setMaxWindowSize(new_config.maxMergesPerNode);
+        configure_adaptive_merge_limit(new_config, new_config.maxMergesPerNode);
     }
     LOG(debug, "Setting new max queue size to %d", new_config.maxMergeQueueSize);
     _maxQueueSize = new_config.maxMergeQueueSize;
@@ -260,6 +275,34 @@ MergeThrottler::on_configure(const StorServerConfig& new_config)
     _metrics->merge_memory_limit.set(static_cast<int64_t>(_max_merge_memory_usage_bytes));
 }
 
+void
+MergeThrottler::configure_adaptive_merge_limit(const StorServerConfig& cfg, uint32_t max_limit)
+{
+    const auto& adaptive_cfg = cfg.mergeThrottlingAdaptiveLimit;
+    if (!adaptive_cfg.enabled) {
+        _adaptive_limiter.reset();
+        _metrics->adaptive_merge_limit.set(0);
+        return;
+    }
+    AdaptiveMergeLimiter::Params params;
+    params.min_limit = static_cast<uint32_t>(std::max(adaptive_cfg.minLimit, 1));
+    params.max_limit = max_limit;
+    params.target_queue_latency_ms = adaptive_cfg.targetQueueLatencyMs;
+    params.max_disk_usage = adaptive_cfg.maxDiskUsage;
+    params.decrease_factor = adaptive_cfg.decreaseFactor;
+    params.increment = adaptive_cfg.increment;
+    if (_adaptive_limiter) {
+        _adaptive_limiter->set_params(params);
+    } else {
+        _adaptive_limiter = std::make_unique<AdaptiveMergeLimiter>(params);
+    }
+    _adaptive_adjust_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(adaptive_cfg.adjustIntervalSecs));
+    _metrics->adaptive_merge_limit.set(_adaptive_limiter->limit());
+    LOG(debug, "Using adaptive merge limit in [%u, %u], currently %u",
+        _adaptive_limiter->params().min_limit, _adaptive_limiter->params().max_limit, _adaptive_limiter->limit());
+}
+
 MergeThrottler::~MergeThrottler()
 {
     LOG(debug, "Deleting link %s", toString().c_str());
@@ -442,10 +485,47 @@ MergeThrottler::enqueue_merge_for_later_processing(
 bool
 MergeThrottler::canProcessNewMerge() const
 {
+    if (_adaptive_limiter && (_merges.size() >= _adaptive_limiter->limit())) {
+        return false;
+    }
     DummyMbusRequest dummyMsg;
     return _throttlePolicy->canSend(dummyMsg, _merges.size());
 }
 
+void
+MergeThrottler::maybe_adjust_adaptive_merge_limit(MessageGuard& msgGuard)
+{
+    if (!_adaptive_limiter || !_node_load_sampler) {
+        return;
+    }
+    const auto now = _component.getClock().getMonotonicTime();
+    if (now < _next_adaptive_adjustment) {
+        return;
+    }
+    _next_adaptive_adjustment = now + _adaptive_adjust_interval;
+    adjust_adaptive_merge_limit(msgGuard);
+}
+
+void
+MergeThrottler::adjust_adaptive_merge_limit(MessageGuard& msgGuard)
+{
+    if (!_adaptive_limiter || !_node_load_sampler) {
+        return;
+    }
+    const NodeLoadSample load = _node_load_sampler->sample_node_load();
+    _metrics->sampled_persistence_queue_latency.set(load.persistence_queue_latency_ms);
+    _metrics->sampled_disk_usage.set(load.disk_usage);
+    const auto decision = _adaptive_limiter->update(load, _merges.size());
+    _metrics->adaptive_merge_limit.set(_adaptive_limiter->limit());
+    if (decision == AdaptiveMergeLimiter::Decision::DECREASE) {
+        _metrics->adaptive_merge_limit_decreases.inc();
+    } else if (decision == AdaptiveMergeLimiter::Decision::INCREASE) {
+        _metrics->adaptive_merge_limit_increases.inc();
+        // A raised limit may allow queued merges to be started right away
+        processQueuedMerges(msgGuard);
+    }
+}
+
 bool
 MergeThrottler::isMergeAlreadyKnown(const api::StorageMessage::SP& msg) const
 {
@@ -660,6 +740,7 @@ MergeThrottler::run(framework::ThreadHandle& thread)
         for (std::size_t i = 0; i < up.size(); ++i) {
             handleMessageUp(up[i], msgGuard);
         }
+        maybe_adjust_adaptive_merge_limit(msgGuard);
     }
     LOG(debug, "Returning from MergeThrottler working thread");
 }
@@ -1344,6 +1425,25 @@ MergeThrottler::set_hw_info_locking(const vespalib::HwInfo& hw_info) {
     _hw_info = hw_info;
 }
 
+void
+MergeThrottler::set_node_load_sampler_locking(NodeLoadSampler* sampler) noexcept {
+    std::lock_guard lock(_stateLock);
+    _node_load_sampler = sampler;
+    _next_adaptive_adjustment = _component.getClock().getMonotonicTime() + _adaptive_adjust_interval;
+}
+
+uint32_t
+MergeThrottler::adaptive_merge_limit_locking() const noexcept {
+    std::lock_guard lock(_stateLock);
+    return _adaptive_limiter ? _adaptive_limiter->limit() : 0;
+}
+
+void
+MergeThrottler::adjust_adaptive_merge_limit_locking() {
+    MessageGuard msgGuard(_stateLock, *this);
+    adjust_adaptive_merge_limit(msgGuard);
+}
+
 size_t
 MergeThrottler::deduced_memory_limit(const StorServerConfig& cfg) const noexcept {
     const auto min_limit = static_cast<size_t>(std::max(cfg.mergeThrottlingMemoryLimit.autoLowerBoundBytes, INT64_C(1)));
@@ -1392,6 +1492,9 @@ MergeThrottler::reportHtmlStatus(std::ostream& out,
             << _throttlePolicy->getMaxPendingCount()
             << "</p>\n";
     }
+    if (_adaptive_limiter) {
+        out << "<p>Adaptive merge limit: " << _adaptive_limiter->limit() << "</p>\n";
+    }
     out << "<p>Please see node metrics for performance numbers</p>\n";
     out << "<h3>Active merges ("
         << _merges.size()
@@ -4,6 +4,7 @@
  */
 #pragma once
 
+#include "adaptive_merge_limiter.h"
 #include <vespa/config/helper/ifetchercallback.h>
 #include <vespa/document/bucket/bucket.h>
 #include <vespa/metrics/countmetric.h>
@@ -72,6 +73,11 @@ public:
         metrics::LongValueMetric estimated_merge_memory_usage;
         metrics::LongValueMetric merge_memory_limit;
         metrics::LongCountMetric bounced_due_to_back_pressure;
+        metrics::LongValueMetric adaptive_merge_limit;
+        metrics::LongCountMetric adaptive_merge_limit_increases;
+        metrics::LongCountMetric adaptive_merge_limit_decreases;
+        metrics::DoubleValueMetric sampled_persistence_queue_latency;
+        metrics::DoubleValueMetric sampled_disk_usage;
         MergeOperationMetrics chaining;
         MergeOperationMetrics local;
 
@@ -184,6 +190,10 @@ private:
     std::chrono::steady_clock::duration           _backpressure_duration;
     size_t                                        _active_merge_memory_used_bytes;
     size_t                                        _max_merge_memory_usage_bytes;
+    std::unique_ptr<AdaptiveMergeLimiter>         _adaptive_limiter; // nullptr if disabled
+    NodeLoadSampler*                              _node_load_sampler;
+    std::chrono::steady_clock::duration           _adaptive_adjust_interval;
+    std::chrono::steady_clock::time_point         _next_adaptive_adjustment;
     bool                                          _use_dynamic_throttling;
     bool                                          _closing;
 public:
@@ -229,6 +239,15 @@ public:
     void set_max_merge_memory_usage_bytes_locking(uint32_t max_memory_bytes) noexcept;
     [[nodiscard]] uint32_t max_merge_memory_usage_bytes_locking() const noexcept;
     void set_hw_info_locking(const vespalib::HwInfo& hw_info);
+    /*
+     * Sets the source of node load samples used by the adaptive merge limit.
+     * The sampler must outlive the throttler or be reset before being destroyed.
+     */
+    void set_node_load_sampler_locking(NodeLoadSampler* sampler) noexcept;
+    // 0 if the adaptive merge limit is disabled
+    [[nodiscard]] uint32_t adaptive_merge_limit_locking() const noexcept;
+    // For unit testing only
+    void adjust_adaptive_merge_limit_locking();
     // For unit testing only
     std::mutex& getStateLock() { return _stateLock; }
 
@@ -361,6 +380,9 @@ private:
      * merge can be processed.
      */
     bool canProcessNewMerge() const;
+    void maybe_adjust_adaptive_merge_limit(MessageGuard& msgGuard);
+    void adjust_adaptive_merge_limit(MessageGuard& msgGuard);
+    void configure_adaptive_merge_limit(const StorServerConfig& cfg, uint32_t max_limit);
 
     [[nodiscard]] bool merge_is_backpressure_throttled(const api::MergeBucketCommand& cmd) const;
     void bounce_backpressure_throttled_merge(const api::MergeBucketCommand& cmd, MessageGuard& guard);
@@ -46,6 +46,7 @@ void ClusterControllerApiRpcService::register_server_methods(SharedRpcResources&
 
     rb.DefineMethod("getnodestate3", "sii", "ss", FRT_METHOD(ClusterControllerApiRpcService::RPC_getNodeState2), this);
     rb.RequestAccessFilter(make_cc_api_capability_filter());
+    rb.MethodPriority(fnet::Priority::HIGH);
     rb.MethodDesc("Get state of this node");
     rb.ParamDesc("nodestate", "Expected state of given node. If correct, the "
                               "request will be queued on target until it changes. To not give "
@@ -56,6 +57,7 @@ void ClusterControllerApiRpcService::register_server_methods(SharedRpcResources&
     //-------------------------------------------------------------------------
     rb.DefineMethod("getnodestate2", "si", "s", FRT_METHOD(ClusterControllerApiRpcService::RPC_getNodeState2), this);
     rb.RequestAccessFilter(make_cc_api_capability_filter());
+    rb.MethodPriority(fnet::Priority::HIGH);
     rb.MethodDesc("Get state of this node");
     rb.ParamDesc("nodestate", "Expected state of given node. If correct, the "
                               "request will be queued on target until it changes. To not give "
@@ -65,11 +67,13 @@ void ClusterControllerApiRpcService::register_server_methods(SharedRpcResources&
     //-------------------------------------------------------------------------
     rb.DefineMethod("setsystemstate2", "s", "", FRT_METHOD(ClusterControllerApiRpcService::RPC_setSystemState2), this);
     rb.RequestAccessFilter(make_cc_api_capability_filter());
+    rb.MethodPriority(fnet::Priority::HIGH);
     rb.MethodDesc("Set systemstate on this node");
     rb.ParamDesc("systemstate", "New systemstate to set");
     //-------------------------------------------------------------------------
     rb.DefineMethod("setdistributionstates", "bix", "", FRT_METHOD(ClusterControllerApiRpcService::RPC_setDistributionStates), this);
     rb.RequestAccessFilter(make_cc_api_capability_filter());
+    rb.MethodPriority(fnet::Priority::HIGH);
     rb.MethodDesc("Set distribution states for cluster and bucket spaces");
     rb.ParamDesc("compressionType", "Compression type for payload");
     rb.ParamDesc("uncompressedSize", "Uncompressed size for payload");
@@ -77,6 +81,7 @@ void ClusterControllerApiRpcService::register_server_methods(SharedRpcResources&
     //-------------------------------------------------------------------------
     rb.DefineMethod("activate_cluster_state_version", "i", "i", FRT_METHOD(ClusterControllerApiRpcService::RPC_activateClusterStateVersion), this);
     rb.RequestAccessFilter(make_cc_api_capability_filter());
+    rb.MethodPriority(fnet::Priority::HIGH);
     rb.MethodDesc("Explicitly activates an already prepared cluster state version");
     rb.ParamDesc("activate_version", "Expected cluster state version to activate");
     rb.ReturnDesc("actual_version", "Cluster state version that was prepared on the node prior to receiving RPC");
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <vespa/vespalib/util/adaptive_compression.h>
 #include <string>
 
 class FRT_Target;
@@ -11,11 +12,14 @@ namespace storage::rpc {
  * Simple wrapper API to access a FRT_Target.
  */
 class RpcTarget {
+    vespalib::compression::AdaptiveCompression::LinkEstimate _link;
 public:
     virtual ~RpcTarget() = default;
     virtual FRT_Target* get() noexcept = 0;
     virtual bool is_valid() const noexcept = 0;
     virtual const std::string& spec() const noexcept = 0;
+    // Estimated throughput of the link to this target, used to select payload compression
+    vespalib::compression::AdaptiveCompression::LinkEstimate& link_estimate() noexcept { return _link; }
 };
 
 }
@@ -64,9 +64,13 @@ public:
 SharedRpcResources::SharedRpcResources(const config::ConfigUri& config_uri,
                                        int rpc_server_port,
                                        size_t rpc_thread_pool_size,
-                                       size_t rpc_events_before_wakeup)
+                                       size_t rpc_events_before_wakeup,
+                                       uint32_t rpc_zero_copy_threshold,
+                                       uint32_t rpc_priority_streak_limit)
     : _transport(std::make_unique<FNET_Transport>(fnet::TransportConfig(rpc_thread_pool_size).
-              events_before_wakeup(rpc_events_before_wakeup))),
+              events_before_wakeup(rpc_events_before_wakeup).
+              zero_copy_threshold(rpc_zero_copy_threshold).
+              priority_streak_limit(rpc_priority_streak_limit))),
       _orb(std::make_unique<FRT_Supervisor>(_transport.get())),
       _slobrok_register(std::make_unique<slobrok::api::RegisterAPI>(*_orb, slobrok::ConfiguratorFactory(config_uri))),
       _slobrok_mirror(std::make_unique<slobrok::api::MirrorAPI>(*_orb, slobrok::ConfiguratorFactory(config_uri))),
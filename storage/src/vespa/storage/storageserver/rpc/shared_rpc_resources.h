@@ -29,7 +29,8 @@ class SharedRpcResources {
     bool                                       _shutdown;
 public:
     SharedRpcResources(const config::ConfigUri& config_uri, int rpc_server_port,
-                       size_t rpc_thread_pool_size, size_t rpc_events_before_wakeup);
+                       size_t rpc_thread_pool_size, size_t rpc_events_before_wakeup,
+                       uint32_t rpc_zero_copy_threshold = 0, uint32_t rpc_priority_streak_limit = 0);
     ~SharedRpcResources();
 
     FRT_Supervisor& supervisor() noexcept { return *_orb; }
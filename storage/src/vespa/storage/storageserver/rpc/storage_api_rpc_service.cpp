@@ -24,6 +24,7 @@
 #include <vespa/log/log.h>
 LOG_SETUP(".storage.storage_api_rpc_service");
 
+using vespalib::compression::AdaptiveCompression;
 using vespalib::compression::CompressionConfig;
 using vespalib::TraceLevel;
 
@@ -38,7 +39,8 @@ StorageApiRpcService::StorageApiRpcService(MessageDispatcher& message_dispatcher
       _message_codec_provider(message_codec_provider),
       _params(params),
       _target_resolver(std::make_unique<CachingRpcTargetResolver>(_rpc_resources.slobrok_mirror(), _rpc_resources.target_factory(),
-                                                                  params.num_rpc_targets_per_node))
+                                                                  params.num_rpc_targets_per_node)),
+      _compression(params.compression_config, params.adaptive_compression)
 {
     register_server_methods(rpc_resources);
 }
@@ -47,6 +49,7 @@ StorageApiRpcService::~StorageApiRpcService() = default;
 
 StorageApiRpcService::Params::Params()
     : compression_config(),
+      adaptive_compression(),
       num_rpc_targets_per_node(1)
 {}
 
@@ -117,11 +120,12 @@ void encode_header_into_rpc_params(HeaderType& hdr, FRT_Values& params) {
 
 void compress_and_add_payload_to_rpc_params(mbus::BlobRef payload,
                                             FRT_Values& params,
-                                            const CompressionConfig& compression_cfg) {
+                                            AdaptiveCompression& compression,
+                                            const AdaptiveCompression::LinkEstimate* link) {
     assert(payload.size() <= UINT32_MAX);
     vespalib::ConstBufferRef to_compress(payload.data(), payload.size());
     vespalib::DataBuffer buf(vespalib::roundUp2inN(payload.size()));
-    auto comp_type = compress(compression_cfg, to_compress, buf, false);
+    auto comp_type = compression.compress(to_compress, buf, link);
     assert(buf.getDataLen() <= UINT32_MAX);
 
     params.AddInt8(comp_type);
@@ -132,11 +136,12 @@ void compress_and_add_payload_to_rpc_params(mbus::BlobRef payload,
 } // anon ns
 
 template <typename MessageType>
-void StorageApiRpcService::encode_and_compress_rpc_payload(const MessageType& msg, FRT_Values& params) {
+void StorageApiRpcService::encode_and_compress_rpc_payload(const MessageType& msg, FRT_Values& params,
+                                                           const AdaptiveCompression::LinkEstimate* link) {
     auto wrapped_codec = _message_codec_provider.wrapped_codec();
     auto payload = wrapped_codec->codec().encode(msg);
 
-    compress_and_add_payload_to_rpc_params(payload, params, _params.compression_config);
+    compress_and_add_payload_to_rpc_params(payload, params, _compression, link);
 }
 
 template <typename PayloadCodecCallback>
@@ -214,7 +219,8 @@ void StorageApiRpcService::encode_rpc_v1_response(FRT_RPCRequest& request, api::
     }
     // TODO consistent naming...
     encode_header_into_rpc_params(hdr, *ret);
-    encode_and_compress_rpc_payload<api::StorageReply>(reply, *ret);
+    // The link to the client is not known here; large replies use dense compression whenever it is enabled
+    encode_and_compress_rpc_payload<api::StorageReply>(reply, *ret, nullptr);
 }
 
 void StorageApiRpcService::send_rpc_v1_request(std::shared_ptr<api::StorageCommand> cmd) {
@@ -251,14 +257,15 @@ void StorageApiRpcService::send_rpc_v1_request(std::shared_ptr<api::StorageComma
 
     auto* params = req->GetParams();
     encode_header_into_rpc_params(req_hdr, *params);
-    encode_and_compress_rpc_payload<api::StorageCommand>(*cmd, *params);
+    encode_and_compress_rpc_payload<api::StorageCommand>(*cmd, *params, &target->link_estimate());
 
     const auto timeout = cmd->getTimeout();
+    auto* frt_target = target->get();
     // TODO verify it's fine that we alloc this on the request stash and use it this way
-    auto& req_ctx = req->getStash().create<RpcRequestContext>(std::move(cmd));
+    auto& req_ctx = req->getStash().create<RpcRequestContext>(std::move(cmd), std::move(target));
     req->SetContext(FNET_Context(&req_ctx));
 
-    target->get()->InvokeAsync(req.release(), vespalib::to_s(timeout), this);
+    frt_target->InvokeAsync(req.release(), vespalib::to_s(timeout), this);
 }
 
 void StorageApiRpcService::RequestDone(FRT_RPCRequest* raw_req) {
@@ -270,6 +277,8 @@ void StorageApiRpcService::RequestDone(FRT_RPCRequest* raw_req) {
         return;
     }
     LOG(spam, "Client: received rpc.v1 OK response");
+    req_ctx->_target->link_estimate().observe_transfer(req->GetParams()->GetLength() + req->GetReturn()->GetLength(),
+                                                       vespalib::steady_clock::now() - req_ctx->_send_time);
     const auto& ret = *req->GetReturn();
     protobuf::ResponseHeader hdr;
     if (!decode_header_from_rpc_params(ret, hdr)) {
@@ -5,7 +5,9 @@
 #include <vespa/fnet/frt/invokable.h>
 #include <vespa/fnet/frt/invoker.h>
 #include <vespa/storageapi/messageapi/returncode.h>
+#include <vespa/vespalib/util/adaptive_compression.h>
 #include <vespa/vespalib/util/compressionconfig.h>
+#include <vespa/vespalib/util/time.h>
 #include <atomic>
 #include <memory>
 #include <string>
@@ -36,6 +38,7 @@ class StorageApiRpcService : public FRT_Invokable, public FRT_IRequestWait {
 public:
     struct Params {
         vespalib::compression::CompressionConfig compression_config;
+        vespalib::compression::AdaptiveCompression::Config adaptive_compression;
         size_t num_rpc_targets_per_node;
 
         Params();
@@ -47,6 +50,7 @@ private:
     MessageCodecProvider& _message_codec_provider;
     const Params          _params;
     std::unique_ptr<CachingRpcTargetResolver> _target_resolver;
+    vespalib::compression::AdaptiveCompression _compression;
 public:
     StorageApiRpcService(MessageDispatcher& message_dispatcher,
                          SharedRpcResources& rpc_resources,
@@ -61,6 +65,10 @@ public:
     void encode_rpc_v1_response(FRT_RPCRequest& request, api::StorageReply& reply);
     void send_rpc_v1_request(std::shared_ptr<api::StorageCommand> cmd);
 
+    [[nodiscard]] vespalib::compression::AdaptiveCompression::Stats compression_stats() const noexcept {
+        return _compression.stats();
+    }
+
     static constexpr const char* rpc_v1_method_name() noexcept {
         return "storageapi.v1.send";
     }
@@ -69,9 +77,13 @@ private:
 
     struct RpcRequestContext {
         std::shared_ptr<api::StorageCommand> _originator_cmd;
+        std::shared_ptr<RpcTarget>           _target;
+        vespalib::steady_time                _send_time;
 
-        explicit RpcRequestContext(std::shared_ptr<api::StorageCommand> cmd)
-            : _originator_cmd(std::move(cmd))
+        RpcRequestContext(std::shared_ptr<api::StorageCommand> cmd, std::shared_ptr<RpcTarget> target)
+            : _originator_cmd(std::move(cmd)),
+              _target(std::move(target)),
+              _send_time(vespalib::steady_clock::now())
         {}
     };
 
@@ -79,7 +91,8 @@ private:
     template <typename PayloadCodecCallback>
     [[nodiscard]] bool uncompress_rpc_payload(const FRT_Values& params, PayloadCodecCallback payload_callback);
     template <typename MessageType>
-    void encode_and_compress_rpc_payload(const MessageType& msg, FRT_Values& params);
+    void encode_and_compress_rpc_payload(const MessageType& msg, FRT_Values& params,
+                                         const vespalib::compression::AdaptiveCompression::LinkEstimate* link);
     void RequestDone(FRT_RPCRequest* request) override;
 
     void handle_request_done_rpc_error(FRT_RPCRequest& req, const RpcRequestContext& req_ctx);
@@ -0,0 +1,42 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "service_layer_node_load_sampler.h"
+#include <vespa/persistence/spi/resource_usage.h>
+#include <vespa/storage/persistence/filestorage/filestormetrics.h>
+#include <vespa/storage/persistence/filestorage/service_layer_host_info_reporter.h>
+
+namespace storage {
+
+ServiceLayerNodeLoadSampler::ServiceLayerNodeLoadSampler(const FileStorMetrics& filestor_metrics,
+                                                         ServiceLayerHostInfoReporter& host_info_reporter) noexcept
+    : _filestor_metrics(filestor_metrics),
+      _host_info_reporter(host_info_reporter),
+      _last_queue_wait_total(0.0),
+      _last_queue_wait_count(0)
+{
+}
+
+ServiceLayerNodeLoadSampler::~ServiceLayerNodeLoadSampler() = default;
+
+NodeLoadSample
+ServiceLayerNodeLoadSampler::sample_node_load()
+{
+    double total = 0.0;
+    uint64_t count = 0;
+    for (const auto& stripe : _filestor_metrics.stripes) {
+        total += stripe->averageQueueWaitingTime.getTotal();
+        count += stripe->averageQueueWaitingTime.getCount();
+    }
+    double latency_ms = 0.0;
+    if ((count < _last_queue_wait_count) || (total < _last_queue_wait_total)) {
+        // Metrics have been reset by a snapshot since the previous sample
+        latency_ms = (count > 0) ? (total / count) : 0.0;
+    } else if (count > _last_queue_wait_count) {
+        latency_ms = (total - _last_queue_wait_total) / (count - _last_queue_wait_count);
+    }
+    _last_queue_wait_total = total;
+    _last_queue_wait_count = count;
+    return {latency_ms, _host_info_reporter.get_resource_usage_snapshot().get_disk_usage()};
+}
+
+}
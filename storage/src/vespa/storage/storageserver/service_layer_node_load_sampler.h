@@ -0,0 +1,34 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "adaptive_merge_limiter.h"
+#include <cstdint>
+
+namespace storage {
+
+struct FileStorMetrics;
+class ServiceLayerHostInfoReporter;
+
+/*
+ * Samples the load of a content node for the adaptive merge limit of the
+ * MergeThrottler:
+ *
+ * - persistence queue latency is the average queue waiting time of the
+ *   operations dequeued by the filestor stripes since the previous sample.
+ * - disk usage is the latest usage reported by the persistence provider to
+ *   the service layer host info reporter.
+ */
+class ServiceLayerNodeLoadSampler : public NodeLoadSampler {
+    const FileStorMetrics&        _filestor_metrics;
+    ServiceLayerHostInfoReporter& _host_info_reporter;
+    double                        _last_queue_wait_total;
+    uint64_t                      _last_queue_wait_count;
+public:
+    ServiceLayerNodeLoadSampler(const FileStorMetrics& filestor_metrics,
+                                ServiceLayerHostInfoReporter& host_info_reporter) noexcept;
+    ~ServiceLayerNodeLoadSampler() override;
+
+    NodeLoadSample sample_node_load() override;
+};
+
+}
@@ -8,6 +8,7 @@
 #include "statemanager.h"
 #include "priorityconverter.h"
 #include "service_layer_error_listener.h"
+#include "service_layer_node_load_sampler.h"
 #include <vespa/storage/common/i_storage_chain_builder.h>
 #include <vespa/storage/visiting/messagebusvisitormessagesession.h>
 #include <vespa/storage/visiting/visitormanager.h>
@@ -56,6 +57,7 @@ ServiceLayerNode::ServiceLayerNode(const config::ConfigUri& configUri,
       _merge_throttler(nullptr),
       _visitor_manager(nullptr),
       _modified_bucket_checker(nullptr),
+      _node_load_sampler(),
       _init_has_been_called(false)
 {
 }
@@ -210,6 +212,9 @@ ServiceLayerNode::createChain(IStorageChainBuilder &builder)
     // the storage link chain is closed prior to destruction.
     auto error_listener = std::make_shared<ServiceLayerErrorListener>(*_component, *_merge_throttler);
     _fileStorManager->error_wrapper().register_error_listener(std::move(error_listener));
+    _node_load_sampler = std::make_unique<ServiceLayerNodeLoadSampler>(_fileStorManager->get_metrics(),
+                                                                      _fileStorManager->host_info_reporter());
+    _merge_throttler->set_node_load_sampler_locking(_node_load_sampler.get());
 
     // Purge config no longer needed
     _persistence_bootstrap_config.reset();
@@ -29,6 +29,7 @@ class ChangedBucketOwnershipHandler;
 class FileStorManager;
 class MergeThrottler;
 class ModifiedBucketChecker;
+class ServiceLayerNodeLoadSampler;
 class VisitorManager;
 
 class ServiceLayerNode
@@ -56,6 +57,7 @@ private:
     MergeThrottler*                     _merge_throttler;
     VisitorManager*                     _visitor_manager;
     ModifiedBucketChecker*              _modified_bucket_checker;
+    std::unique_ptr<ServiceLayerNodeLoadSampler> _node_load_sampler;
     bool                                _init_has_been_called;
 
 public:
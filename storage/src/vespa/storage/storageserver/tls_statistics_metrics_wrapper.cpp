@@ -9,7 +9,11 @@ TlsStatisticsMetricsWrapper::EndpointMetrics::EndpointMetrics(std::string_view t
       tls_connections_established("tls-connections-established", {},
               "Number of secure mTLS connections established", this),
       insecure_connections_established("insecure-connections-established", {},
-              "Number of insecure (plaintext) connections established", this)
+              "Number of insecure (plaintext) connections established", this),
+      kernel_tls_tx_connections("kernel-tls-tx-connections", {},
+              "Number of TLS connections with encryption offloaded to the kernel", this),
+      kernel_tls_rx_connections("kernel-tls-rx-connections", {},
+              "Number of TLS connections with decryption offloaded to the kernel", this)
 {}
 
 TlsStatisticsMetricsWrapper::EndpointMetrics::~EndpointMetrics() = default;
@@ -49,6 +53,10 @@ void TlsStatisticsMetricsWrapper::update_metrics_with_snapshot_delta() {
     client.tls_connections_established.set(client_delta.tls_connections);
     server.insecure_connections_established.set(server_delta.insecure_connections);
     server.tls_connections_established.set(server_delta.tls_connections);
+    client.kernel_tls_tx_connections.set(client_delta.kernel_tls_tx_connections);
+    client.kernel_tls_rx_connections.set(client_delta.kernel_tls_rx_connections);
+    server.kernel_tls_tx_connections.set(server_delta.kernel_tls_tx_connections);
+    server.kernel_tls_rx_connections.set(server_delta.kernel_tls_rx_connections);
 
     // We have underlying stats for both server and client here, but for the
     // moment we just aggregate them up into combined metrics. Can be trivially
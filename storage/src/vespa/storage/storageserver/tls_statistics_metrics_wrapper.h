@@ -19,6 +19,8 @@ class TlsStatisticsMetricsWrapper : public metrics::MetricSet {
 
         metrics::LongCountMetric tls_connections_established;
         metrics::LongCountMetric insecure_connections_established;
+        metrics::LongCountMetric kernel_tls_tx_connections;
+        metrics::LongCountMetric kernel_tls_rx_connections;
     };
 
     EndpointMetrics client;
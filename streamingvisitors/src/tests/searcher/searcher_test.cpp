@@ -536,6 +536,12 @@ testStrChrFieldSearcher(StrChrFieldSearcher & fs)
         EXPECT_EQ(HitsList({{{0, 1}}}), search_string(fs, "bar", "foo____________________bar"));
         EXPECT_EQ(HitsList({{{0, 2}}}), search_string(fs, "bar", "foo____________________thisisaveryveryverylongword____________________bar"));
     }
+    { // words that do not start with the first character of the term are skipped, but still counted
+        std::string many = "xbar abar bar xx Bar barbar ba a b bar";
+        EXPECT_EQ(HitsList({{{0, 2}, {0, 4}, {0, 9}}}), search_string(fs, "bar", many));
+        EXPECT_EQ(HitsList({{{0, 5}}}), search_string(fs, "barbar", "q bbar baarbar r bar barbar"));
+        EXPECT_EQ(HitsList({{}}), search_string(fs, "zip", many));
+    }
 }
 
 void check_fuzzy_param_parsing(std::string_view term, std::string_view exp_term,
@@ -256,6 +256,17 @@ TEST_F(SearchVisitorTest, basic_query_execution_in_search_visitor)
     expect_match_features({}, {}, *res);
 }
 
+TEST_F(SearchVisitorTest, large_document_batch_is_prepared_in_parallel_and_matched_in_order)
+{
+    DocumentVector docs;
+    for (int id = 0; id < 200; ++id) {
+        docs.emplace_back(id);
+    }
+    auto res = execute_query(RequestBuilder().number_term("[150;153]", "id").build(), docs);
+    expect_hits({{153,163.0}, {152,162.0}, {151,161.0}, {150,160.0}}, *res);
+    expect_summary({{150}, {151}, {152}, {153}}, *res);
+}
+
 TEST_F(SearchVisitorTest, match_features_returned_in_search_result)
 {
     auto res = execute_query(RequestBuilder().
@@ -27,6 +27,12 @@ using vsm::VSMAdapter;
 
 namespace streaming {
 
+namespace {
+
+constexpr size_t document_preparation_threads = 4;
+
+}
+
 __thread SearchEnvironment::EnvMap * SearchEnvironment::_localEnvMap = nullptr;
 
 SearchEnvironment::Env::Env(const config::ConfigUri& configUri, const Fast_NormalizeWordFolder& wf, FNET_Transport* transport, const std::string& file_distributor_connection_spec)
@@ -112,7 +118,8 @@ SearchEnvironment::SearchEnvironment(const config::ConfigUri & configUri, FNET_T
       _wordFolder(std::make_unique<Fast_NormalizeWordFolder>()),
       _configUri(configUri),
       _transport(transport),
-      _file_distributor_connection_spec(file_distributor_connection_spec)
+      _file_distributor_connection_spec(file_distributor_connection_spec),
+      _document_preparation_pool(document_preparation_threads)
 {
 }
 
@@ -10,6 +10,7 @@
 #include <vespa/config/retriever/simpleconfigurer.h>
 #include <vespa/config/subscription/configuri.h>
 #include <vespa/vsm/vsm/vsm-adapter.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
 #include <mutex>
 
 class FNET_Transport;
@@ -74,6 +75,7 @@ private:
     config::ConfigUri        _configUri;
     FNET_Transport* const    _transport;
     std::string         _file_distributor_connection_spec;
+    vespalib::SimpleThreadBundle::Pool _document_preparation_pool;
 
     Env & getEnv(const std::string & config_id);
 
@@ -82,6 +84,8 @@ public:
     ~SearchEnvironment();
     std::shared_ptr<const SearchEnvironmentSnapshot> get_snapshot(const std::string& config_id);
     std::optional<int64_t> get_oldest_config_generation();
+    // Shared by all search visitors to prepare batches of documents in parallel
+    vespalib::SimpleThreadBundle::Pool & get_document_preparation_pool() noexcept { return _document_preparation_pool; }
     // Should only be used by unit tests to simulate that the calling thread is finished.
     void clear_thread_local_env_map();
 };
@@ -31,6 +31,8 @@
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/issue.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <algorithm>
+#include <functional>
 #include <optional>
 #include <string>
 
@@ -319,6 +321,7 @@ SearchVisitor::SearchVisitor(StorageComponent& component,
                              const Parameters& params)
     : Visitor(component),
       _env(get_search_environment_snapshot(vEnv, params)),
+      _document_preparation_pool(dynamic_cast<SearchEnvironment&>(vEnv).get_document_preparation_pool()),
       _params(params),
       _init_called(false),
       _collectGroupingHits(false),
@@ -328,6 +331,7 @@ SearchVisitor::SearchVisitor(StorageComponent& component,
       _query(),
       _queryResult(std::make_unique<documentapi::QueryResultMessage>()),
       _fieldSearcherMap(),
+      _searched_fields(),
       _docTypeMapping(),
       _fieldSearchSpecMap(),
       _snippetModifierManager(),
@@ -887,6 +891,12 @@ SearchVisitor::setupFieldSearchers()
     StringFieldIdTMap fieldsInQuery = _fieldSearchSpecMap.buildFieldsInQuery(_query);
     // Connect field names in the query to field searchers
     _fieldSearchSpecMap.buildSearcherMap(fieldsInQuery.map(), _fieldSearcherMap);
+    _searched_fields.clear();
+    for (const vsm::FieldSearcherContainer & fSearch : _fieldSearcherMap) {
+        _searched_fields.push_back(fSearch->field());
+    }
+    std::sort(_searched_fields.begin(), _searched_fields.end());
+    _searched_fields.erase(std::unique(_searched_fields.begin(), _searched_fields.end()), _searched_fields.end());
     return fieldsInQuery;
 }
 
@@ -1114,28 +1124,91 @@ SearchVisitor::handleDocuments(const document::BucketId&, DocEntryList & entries
         //Prevent continuing with bad config.
         return;
     }
-    document::DocumentId emptyId;
     LOG(debug, "SearchVisitor '%s' handling block of %zu documents", _id.c_str(), entries.size());
-    size_t highestFieldNo(_fieldSearchSpecMap.nameIdMap().highestFieldNo());
-
     const document::DocumentType* defaultDocType = _docTypeMapping.getDefaultDocumentType();
     assert(defaultDocType);
-    for (const auto & entry : entries) {
-        auto document = std::make_shared<StorageDocument>(entry->releaseDocument(), _fieldPathMap, highestFieldNo);
-
+    std::vector<PreparedDocument> prepared(entries.size());
+    prepare_documents(entries, prepared);
+    // matching, ranking and grouping is done in visiting order by this thread
+    for (auto & entry : prepared) {
+        if ( ! entry.error.empty()) {
+            Issue::report("Caught exception handling document '%s'. Exception='%s'",
+                          entry.document ? entry.document->docDoc().getId().getScheme().toString().c_str() : "",
+                          entry.error.c_str());
+            continue;
+        }
         try {
-            if (defaultDocType != nullptr
-                && !compatibleDocumentTypes(*defaultDocType, document->docDoc().getType()))
-            {
+            if ( ! entry.compatible) {
                 LOG(debug, "Skipping document of type '%s' when handling only documents of type '%s'",
-                    document->docDoc().getType().getName().c_str(), defaultDocType->getName().c_str());
+                    entry.document->docDoc().getType().getName().c_str(), defaultDocType->getName().c_str());
             } else {
-                handleDocument(document);
+                handleDocument(entry.document);
             }
         } catch (const std::exception & e) {
             Issue::report("Caught exception handling document '%s'. Exception='%s'",
-                          document->docDoc().getId().getScheme().toString().c_str(), e.what());
+                          entry.document ? entry.document->docDoc().getId().getScheme().toString().c_str() : "",
+                          e.what());
+        }
+    }
+}
+
+namespace {
+
+// fewer documents than this for each thread is not worth the synchronization
+constexpr size_t min_documents_per_preparation_thread = 16;
+
+class PrepareDocumentsTask : public vespalib::Runnable {
+    const std::function<void(size_t)> & _prepare;
+    size_t _first;
+    size_t _stride;
+    size_t _count;
+public:
+    PrepareDocumentsTask(const std::function<void(size_t)> & prepare, size_t first, size_t stride, size_t count) noexcept
+        : _prepare(prepare), _first(first), _stride(stride), _count(count)
+    {}
+    void run() override {
+        for (size_t i = _first; i < _count; i += _stride) {
+            _prepare(i);
+        }
+    }
+};
+
+}
+
+void
+SearchVisitor::prepare_documents(DocEntryList & entries, std::vector<PreparedDocument> & prepared)
+{
+    std::function<void(size_t)> prepare = [&](size_t i) { prepare_document(*entries[i], prepared[i]); };
+    size_t wanted_threads = entries.size() / min_documents_per_preparation_thread;
+    if (wanted_threads < 2) {
+        PrepareDocumentsTask(prepare, 0, 1, entries.size()).run();
+        return;
+    }
+    auto guard = _document_preparation_pool.getBundle();
+    size_t num_threads = std::min(wanted_threads, guard.bundle().size());
+    std::vector<PrepareDocumentsTask> tasks;
+    tasks.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        tasks.emplace_back(prepare, i, num_threads, entries.size());
+    }
+    guard.bundle().run(tasks);
+}
+
+void
+SearchVisitor::prepare_document(storage::spi::DocEntry & entry, PreparedDocument & prepared) const
+{
+    try {
+        size_t highestFieldNo(_fieldSearchSpecMap.nameIdMap().highestFieldNo());
+        prepared.document = std::make_shared<StorageDocument>(entry.releaseDocument(), _fieldPathMap, highestFieldNo);
+        const document::DocumentType* defaultDocType = _docTypeMapping.getDefaultDocumentType();
+        prepared.compatible = compatibleDocumentTypes(*defaultDocType, prepared.document->docDoc().getType());
+        if (prepared.compatible) {
+            for (vsm::FieldIdT field : _searched_fields) {
+                prepared.document->getComplexField(field);
+            }
         }
+    } catch (const std::exception & e) {
+        prepared.error = e.what();
     }
 }
 
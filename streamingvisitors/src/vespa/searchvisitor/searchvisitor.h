@@ -305,6 +305,25 @@ private:
     static bool compatibleDocumentTypes(const document::DocumentType& typeA,
                                         const document::DocumentType& typeB);
 
+    /**
+     * A visited document made ready for matching, see prepare_documents.
+     */
+    struct PreparedDocument {
+        vsm::StorageDocument::SP document;
+        bool                     compatible;
+        std::string              error;
+        PreparedDocument() noexcept : document(), compatible(false), error() {}
+    };
+
+    /**
+     * Wrap the visited documents and fetch the fields used by the
+     * field searchers, which deserializes them. Documents are
+     * independent of each other, so large batches are split across
+     * the threads of the document preparation pool.
+     */
+    void prepare_documents(DocEntryList & entries, std::vector<PreparedDocument> & prepared);
+    void prepare_document(storage::spi::DocEntry & entry, PreparedDocument & prepared) const;
+
     /**
      * Process one document
      * @param document Document to process.
@@ -452,6 +471,7 @@ private:
 
     void init(const vdslib::Parameters & params);
     std::shared_ptr<const SearchEnvironmentSnapshot> _env;
+    vespalib::SimpleThreadBundle::Pool    & _document_preparation_pool;
     vdslib::Parameters                      _params;
     bool                                    _init_called;
     bool                                    _collectGroupingHits;
@@ -461,6 +481,7 @@ private:
     search::streaming::Query                _query;
     std::unique_ptr<documentapi::QueryResultMessage>    _queryResult;
     vsm::FieldIdTSearcherMap                _fieldSearcherMap;
+    std::vector<vsm::FieldIdT>              _searched_fields;
     vsm::SharedFieldPathMap                 _fieldPathMap;
     vsm::DocumentTypeMapping                _docTypeMapping;
     vsm::FieldSearchSpecMap                 _fieldSearchSpecMap;
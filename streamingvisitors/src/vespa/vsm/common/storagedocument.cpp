@@ -34,10 +34,10 @@ StorageDocument::getComplexField(FieldIdT fId) const
     if (_cachedFields[fId].getFieldValue() == nullptr) {
         const FieldPath & fp = (*_fieldMap)[fId];
         if ( ! fp.empty() ) {
-            const document::StructuredFieldValue * sfv = _doc.get();
             NestedIterator nested = fp.getFullRange();
             const document::FieldPathEntry& fvInfo = nested.cur();
-            document::FieldValue::UP fv = sfv->getValue(fvInfo.getFieldRef());
+            // The value references the serialized document, which outlives _backedFields.
+            document::FieldValue::UP fv = _doc->getFields().getFieldValueReferencingBuffer(fvInfo.getFieldRef());
             if (fv) {
                 SubDocument tmp(fv.get(), nested.next());
                 _cachedFields[fId].swap(tmp);
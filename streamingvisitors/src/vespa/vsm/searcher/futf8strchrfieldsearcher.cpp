@@ -4,6 +4,7 @@
 #ifdef __x86_64__
 #include "fold.h"
 #endif
+#include <vespa/vespalib/hwaccelerated/iaccelerated.h>
 #include <vespa/vespalib/util/size_literals.h>
 
 using search::byte;
@@ -73,23 +74,9 @@ bool
 FUTF8StrChrFieldSearcher::lfoldua(const char * toFold, size_t sz, char * folded, size_t & alignedStart)
 {
   alignedStart =  0xF - (size_t(folded + 0xF) % 0x10);
-#ifdef __x86_64__
-  bool retval(true);
-
-  size_t alignsz16 = sz & 0xFFFFFFF0;
-  size_t rest = sz - alignsz16;
-
-  if (alignsz16) {
-    const byte * end = sse2_foldua(reinterpret_cast<const byte *>(toFold), alignsz16, reinterpret_cast<byte *>(folded+alignedStart));
-    retval = (end == reinterpret_cast<const byte *>(toFold+alignsz16));
-  }
-  if(rest && retval) {
-    retval = ansiFold(toFold + alignsz16, rest, folded+alignedStart+alignsz16);
-  }
-  return retval;
-#else
-  return ansiFold(toFold, sz, folded + alignedStart);
-#endif
+  // uses the widest vector unit available (avx2/avx-512/neon), falling back when hitting non-ascii utf8
+  const auto & accelerator = vespalib::hwaccelerated::IAccelerated::getAccelerator();
+  return (accelerator.fold_ascii_word_chars(toFold, sz, folded + alignedStart) == sz);
 }
 
 namespace {
@@ -140,6 +127,26 @@ inline const char* advance(const char* n)
 }
 #endif
 
+// number of words starting in [n, end), where n is the start of a word
+inline size_t count_word_starts(const char * n, const char * end)
+{
+    size_t count = 1;
+    for (const char * p = n + 1; p < end; ++p) {
+        count += ((p[-1] == '\0') & (p[0] != '\0'));
+    }
+    return count;
+}
+
+// find the first word after the one starting at n that starts with c, or nullptr
+inline const char * find_word_starting_with(const char * n, const char * end, char c)
+{
+    const char * p = n;
+    do {
+        p = static_cast<const char *>(memchr(p + 1, c, end - p - 1));
+    } while ((p != nullptr) && (p[-1] != '\0'));
+    return p;
+}
+
 }
 
 size_t FUTF8StrChrFieldSearcher::match(const char *folded, size_t sz, QueryTerm & qt)
@@ -155,6 +162,13 @@ size_t FUTF8StrChrFieldSearcher::match(const char *folded, size_t sz, QueryTerm
   while (true) {
     if (n>=e) break;
 
+    if ((tsz > 0) && (*n != *term)) {
+      // memchr based prefilter; skip all words not starting with the first character of the term
+      const char * next = find_word_starting_with(n, e, *term);
+      words += count_word_starts(n, (next != nullptr) ? next : e);
+      if (next == nullptr) break;
+      n = next;
+    }
     const char *tt = term;
     while ((tt < et) && (*tt == *n)) { tt++; n++; }
     if ((tt == et) && (prefix() || qt.isPrefix() || !*n)) {
@@ -71,7 +71,8 @@ NearestNeighborFieldSearcher::NearestNeighborFieldSearcher(FieldIdT fid,
     : FieldSearcher(fid),
       _metric(metric),
       _attr(),
-      _calcs()
+      _calcs(),
+      _has_single_subspace(false)
 {
 }
 
@@ -96,6 +97,7 @@ NearestNeighborFieldSearcher::prepare(search::streaming::QueryTermList& qtl,
                                 field(), field_paths[field()].back().getDataType().toString().c_str());
     }
     _attr = make_attribute(tensor_type->getTensorType(), _metric);
+    _has_single_subspace = tensor_type->getTensorType().is_dense();
     _calcs.clear();
     for (auto term : qtl) {
         auto* nn_term = term->as_nearest_neighbor_query_node();
@@ -122,6 +124,20 @@ NearestNeighborFieldSearcher::prepare(search::streaming::QueryTermList& qtl,
     }
 }
 
+template <bool has_single_subspace>
+void
+NearestNeighborFieldSearcher::calc_distances()
+{
+    for (auto& elem : _calcs) {
+        // the limit is tightened by the heap as hits are ranked, letting distance functions exit early
+        double distance_limit = elem->heap.distanceLimit();
+        double distance = elem->calc->calc_with_limit<has_single_subspace>(scratch_docid, distance_limit);
+        if (distance <= distance_limit) {
+            elem->node->set_distance(distance);
+        }
+    }
+}
+
 void
 NearestNeighborFieldSearcher::onValue(const document::FieldValue& fv)
 {
@@ -129,12 +145,10 @@ NearestNeighborFieldSearcher::onValue(const document::FieldValue& fv)
         const auto* tfv = dynamic_cast<const document::TensorFieldValue*>(&fv);
         if (tfv && tfv->getAsTensorPtr()) {
             _attr->add(*tfv->getAsTensorPtr(), 1);
-            for (auto& elem : _calcs) {
-                double distance_limit = elem->heap.distanceLimit();
-                double distance = elem->calc->calc_with_limit<false>(scratch_docid, distance_limit);
-                if (distance <= distance_limit) {
-                    elem->node->set_distance(distance);
-                }
+            if (_has_single_subspace) {
+                calc_distances<true>();
+            } else {
+                calc_distances<false>();
             }
         }
     }
@@ -36,6 +36,10 @@ private:
     search::attribute::DistanceMetric _metric;
     std::unique_ptr<search::tensor::TensorExtAttribute> _attr;
     std::vector<std::unique_ptr<NodeAndCalc>> _calcs;
+    bool _has_single_subspace;
+
+    template <bool has_single_subspace>
+    void calc_distances();
 
 public:
     NearestNeighborFieldSearcher(FieldIdT fid,
@@ -0,0 +1,58 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+TEST(LatencyHistogramTest, empty_histogram_reports_zero) {
+    LatencyHistogram hist;
+    EXPECT_EQ(0u, hist.count());
+    EXPECT_EQ(0.0, hist.min());
+    EXPECT_EQ(0.0, hist.mean());
+    EXPECT_EQ(0.0, hist.max());
+    EXPECT_EQ(0.0, hist.percentile(99.0));
+}
+
+TEST(LatencyHistogramTest, min_max_and_mean_are_exact_at_microsecond_resolution) {
+    LatencyHistogram hist;
+    hist.record(0.002);
+    hist.record(0.004);
+    hist.record(1.5);
+    EXPECT_EQ(3u, hist.count());
+    EXPECT_NEAR(0.002, hist.min(), 10e-9);
+    EXPECT_NEAR(1.5, hist.max(), 10e-9);
+    EXPECT_NEAR(0.502, hist.mean(), 10e-9);
+}
+
+TEST(LatencyHistogramTest, percentiles_have_bounded_relative_error) {
+    LatencyHistogram hist;
+    for (size_t i = 1; i <= 100000; ++i) {
+        hist.record(0.00001 * i);
+    }
+    EXPECT_NEAR(0.5, hist.percentile(50.0), 0.5 * 0.01);
+    EXPECT_NEAR(0.9, hist.percentile(90.0), 0.9 * 0.01);
+    EXPECT_NEAR(0.99, hist.percentile(99.0), 0.99 * 0.01);
+    EXPECT_NEAR(0.999, hist.percentile(99.9), 0.999 * 0.01);
+    EXPECT_NEAR(1.0, hist.percentile(100.0), 10e-9);
+}
+
+TEST(LatencyHistogramTest, merged_histogram_matches_combined_recording) {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    LatencyHistogram both;
+    for (size_t i = 0; i < 1000; ++i) {
+        a.record(0.001 * i);
+        b.record(2.0 + 0.001 * i);
+        both.record(0.001 * i);
+        both.record(2.0 + 0.001 * i);
+    }
+    a.merge(b);
+    EXPECT_EQ(both.count(), a.count());
+    EXPECT_EQ(both.min(), a.min());
+    EXPECT_EQ(both.max(), a.max());
+    EXPECT_NEAR(both.mean(), a.mean(), 10e-9);
+    EXPECT_EQ(both.percentile(50.0), a.percentile(50.0));
+    EXPECT_EQ(both.percentile(99.0), a.percentile(99.0));
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
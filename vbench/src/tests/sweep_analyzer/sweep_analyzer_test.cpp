@@ -0,0 +1,111 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vbench/test/all.h>
+#include <vespa/vespalib/data/slime/slime.h>
+
+using namespace vbench;
+
+void post(Handler<Request> &handler, double scheduledTime, double startTime, double endTime,
+          Request::Status status = Request::STATUS_OK)
+{
+    Request::UP req(new Request());
+    req->scheduledTime(scheduledTime).startTime(startTime).endTime(endTime).status(status);
+    handler.handle(std::move(req));
+}
+
+// feed one step of the sweep, where every request takes 'latency'
+// seconds to complete once started and starts are delayed by 'delay'
+void feed_step(Handler<Request> &handler, const LoadSweep &sweep, size_t step, double latency, double delay = 0.0) {
+    size_t n = (size_t)(sweep.qps(step) * sweep.stepDuration());
+    for (size_t i = 0; i < n; ++i) {
+        double scheduled = sweep.stepStart(step) + (i / sweep.qps(step));
+        post(handler, scheduled, scheduled + delay, scheduled + delay + latency);
+    }
+}
+
+TEST(SweepAnalyzerTest, latency_includes_time_spent_waiting_to_be_sent) {
+    RequestSink f1;
+    LoadSweep sweep(10.0, 10.0, 1, 1.0);
+    SweepAnalyzer f2(sweep, 0.5, 3.0, "", f1);
+    post(f2, 0.1, 0.5, 0.6);
+    auto curve = f2.getCurve();
+    ASSERT_EQ(1u, curve.points.size());
+    EXPECT_EQ(1u, curve.points[0].ok);
+    EXPECT_NEAR(0.5, curve.points[0].max, 10e-6);
+}
+
+TEST(SweepAnalyzerTest, failed_and_dropped_requests_are_counted_per_step) {
+    RequestSink f1;
+    LoadSweep sweep(10.0, 10.0, 2, 1.0);
+    SweepAnalyzer f2(sweep, 0.5, 3.0, "", f1);
+    post(f2, 0.1, 0.1, 0.2, Request::STATUS_FAILED);
+    post(f2, 1.1, 1.1, 1.2, Request::STATUS_DROPPED);
+    post(f2, 1.2, 1.2, 1.3, Request::STATUS_DROPPED);
+    auto curve = f2.getCurve();
+    ASSERT_EQ(2u, curve.points.size());
+    EXPECT_EQ(1u, curve.points[0].failed);
+    EXPECT_EQ(0u, curve.points[0].dropped);
+    EXPECT_EQ(0u, curve.points[1].failed);
+    EXPECT_EQ(2u, curve.points[1].dropped);
+}
+
+TEST(SweepAnalyzerTest, unsaturated_sweep_sustains_all_steps) {
+    RequestSink f1;
+    LoadSweep sweep(100.0, 100.0, 3, 2.0);
+    SweepAnalyzer f2(sweep, 0.9, 3.0, "", f1);
+    for (size_t step = 0; step < sweep.steps(); ++step) {
+        feed_step(f2, sweep, step, 0.001);
+    }
+    auto curve = f2.getCurve();
+    ASSERT_EQ(3u, curve.points.size());
+    EXPECT_FALSE(curve.saturated);
+    EXPECT_NEAR(300.0, curve.maxSustainedQps, 10e-6);
+    EXPECT_NEAR(200.0, curve.points[1].achievedQps, 1.0);
+}
+
+TEST(SweepAnalyzerTest, knee_is_detected_from_latency_increase) {
+    RequestSink f1;
+    LoadSweep sweep(100.0, 100.0, 3, 2.0);
+    SweepAnalyzer f2(sweep, 0.9, 3.0, "", f1);
+    feed_step(f2, sweep, 0, 0.001);
+    feed_step(f2, sweep, 1, 0.001, 0.01);
+    feed_step(f2, sweep, 2, 0.001);
+    auto curve = f2.getCurve();
+    EXPECT_TRUE(curve.saturated);
+    EXPECT_EQ(1u, curve.kneeStep);
+    EXPECT_NEAR(100.0, curve.maxSustainedQps, 10e-6);
+}
+
+TEST(SweepAnalyzerTest, knee_is_detected_from_throughput_drop) {
+    RequestSink f1;
+    LoadSweep sweep(100.0, 100.0, 3, 2.0);
+    SweepAnalyzer f2(sweep, 0.9, 1000.0, "", f1);
+    feed_step(f2, sweep, 0, 0.001);
+    feed_step(f2, sweep, 1, 0.001);
+    for (size_t i = 0; i < 300; ++i) {
+        double scheduled = sweep.stepStart(2) + (i / sweep.qps(2));
+        post(f2, scheduled, scheduled, scheduled + 0.001);
+    }
+    auto curve = f2.getCurve();
+    EXPECT_TRUE(curve.saturated);
+    EXPECT_EQ(2u, curve.kneeStep);
+    EXPECT_NEAR(200.0, curve.maxSustainedQps, 10e-6);
+}
+
+TEST(SweepAnalyzerTest, curve_is_written_as_json) {
+    RequestSink f1;
+    LoadSweep sweep(100.0, 100.0, 2, 1.0);
+    SweepAnalyzer f2(sweep, 0.9, 3.0, "", f1);
+    feed_step(f2, sweep, 0, 0.001);
+    feed_step(f2, sweep, 1, 0.001);
+    vespalib::Slime slime;
+    string json = f2.getCurve().toJson();
+    ASSERT_TRUE(vespalib::slime::JsonFormat::decode(vespalib::Memory(json), slime) > 0);
+    EXPECT_FALSE(slime.get()["saturated"].asBool());
+    EXPECT_EQ(2u, slime.get()["steps"].entries());
+    EXPECT_NEAR(200.0, slime.get()["steps"][1]["offered_qps"].asDouble(), 10e-6);
+    EXPECT_EQ(200, slime.get()["steps"][1]["ok"].asLong());
+    EXPECT_TRUE(slime.get()["steps"][1]["latency"]["p99"].valid());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,40 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vbench/test/all.h>
+#include <vespa/vespalib/util/exceptions.h>
+
+using namespace vbench;
+
+TEST(SweepTaggerTest, requests_are_scheduled_at_the_offered_rate_of_each_step) {
+    RequestReceptor f1;
+    SweepTagger f2(LoadSweep(2.0, 2.0, 2, 1.0), f1);
+    std::vector<double> expect = {0.0, 0.5, 1.0, 1.25, 1.5, 1.75};
+    for (double time: expect) {
+        f2.handle(Request::UP(new Request()));
+        ASSERT_TRUE(f1.request.get() != 0);
+        EXPECT_NEAR(time, f1.request->scheduledTime(), 10e-6);
+        f1.request.reset();
+    }
+    f2.handle(Request::UP(new Request()));
+    EXPECT_TRUE(f1.request.get() == 0);
+}
+
+TEST(SweepTaggerTest, invalid_sweep_is_rejected) {
+    EXPECT_THROW(LoadSweep(0.0, 1.0, 1, 1.0), vespalib::IllegalArgumentException);
+    EXPECT_THROW(LoadSweep(1.0, -1.0, 1, 1.0), vespalib::IllegalArgumentException);
+    EXPECT_THROW(LoadSweep(1.0, 1.0, 0, 1.0), vespalib::IllegalArgumentException);
+    EXPECT_THROW(LoadSweep(1.0, 1.0, 1, 0.0), vespalib::IllegalArgumentException);
+}
+
+TEST(SweepTaggerTest, time_is_mapped_to_sweep_step) {
+    LoadSweep sweep(10.0, 10.0, 3, 5.0);
+    EXPECT_EQ(0u, sweep.step(0.0));
+    EXPECT_EQ(0u, sweep.step(4.99));
+    EXPECT_EQ(1u, sweep.step(5.0));
+    EXPECT_EQ(2u, sweep.step(14.99));
+    EXPECT_EQ(3u, sweep.step(15.0));
+    EXPECT_EQ(3u, sweep.step(-1.0));
+    EXPECT_NEAR(30.0, sweep.qps(2), 10e-6);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
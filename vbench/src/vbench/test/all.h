@@ -16,6 +16,10 @@
 #include <vbench/vbench/server_tagger.h>
 #include <vbench/vbench/request.h>
 #include <vbench/vbench/latency_analyzer.h>
+#include <vbench/vbench/latency_histogram.h>
+#include <vbench/vbench/load_sweep.h>
+#include <vbench/vbench/sweep_analyzer.h>
+#include <vbench/vbench/sweep_tagger.h>
 #include <vbench/core/input_file_reader.h>
 #include <vbench/core/line_reader.h>
 #include <vbench/core/string.h>
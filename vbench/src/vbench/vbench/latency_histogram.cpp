@@ -0,0 +1,121 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "latency_histogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace vbench {
+
+size_t
+LatencyHistogram::index_of(uint64_t value)
+{
+    if (value < SUB_BUCKETS) {
+        return value;
+    }
+    uint32_t shift = (std::bit_width(value) - SUB_BUCKET_BITS);
+    return ((shift + 1) * HALF_SUB_BUCKETS) + (value >> shift) - HALF_SUB_BUCKETS;
+}
+
+uint64_t
+LatencyHistogram::lowest_value(size_t idx)
+{
+    if (idx < SUB_BUCKETS) {
+        return idx;
+    }
+    uint32_t shift = (idx / HALF_SUB_BUCKETS) - 1;
+    return ((idx % HALF_SUB_BUCKETS) + HALF_SUB_BUCKETS) << shift;
+}
+
+uint64_t
+LatencyHistogram::highest_value(size_t idx)
+{
+    return lowest_value(idx + 1) - 1;
+}
+
+LatencyHistogram::LatencyHistogram()
+    : _counts(),
+      _total(0),
+      _min(0),
+      _max(0),
+      _sum(0.0)
+{
+}
+
+LatencyHistogram::~LatencyHistogram() = default;
+
+void
+LatencyHistogram::record(double latency)
+{
+    uint64_t value = (latency > 0.0) ? (uint64_t)std::llround(latency * 1000000.0) : 0;
+    value = std::min(value, MAX_VALUE);
+    size_t idx = index_of(value);
+    if (idx >= _counts.size()) {
+        _counts.resize(idx + 1, 0);
+    }
+    ++_counts[idx];
+    if (_total == 0 || value < _min) {
+        _min = value;
+    }
+    if (_total == 0 || value > _max) {
+        _max = value;
+    }
+    ++_total;
+    _sum += value;
+}
+
+void
+LatencyHistogram::merge(const LatencyHistogram &rhs)
+{
+    if (rhs._total == 0) {
+        return;
+    }
+    if (rhs._counts.size() > _counts.size()) {
+        _counts.resize(rhs._counts.size(), 0);
+    }
+    for (size_t i = 0; i < rhs._counts.size(); ++i) {
+        _counts[i] += rhs._counts[i];
+    }
+    _min = (_total == 0) ? rhs._min : std::min(_min, rhs._min);
+    _max = (_total == 0) ? rhs._max : std::max(_max, rhs._max);
+    _total += rhs._total;
+    _sum += rhs._sum;
+}
+
+double
+LatencyHistogram::min() const
+{
+    return (_min / 1000000.0);
+}
+
+double
+LatencyHistogram::max() const
+{
+    return (_max / 1000000.0);
+}
+
+double
+LatencyHistogram::mean() const
+{
+    return (_total == 0) ? 0.0 : ((_sum / _total) / 1000000.0);
+}
+
+double
+LatencyHistogram::percentile(double per) const
+{
+    if (_total == 0) {
+        return 0.0;
+    }
+    uint64_t target = std::max(uint64_t(1), (uint64_t)std::ceil((per / 100.0) * _total));
+    uint64_t acc = 0;
+    for (size_t i = 0; i < _counts.size(); ++i) {
+        acc += _counts[i];
+        if (acc >= target) {
+            uint64_t value = std::clamp(highest_value(i), _min, _max);
+            return (value / 1000000.0);
+        }
+    }
+    return max();
+}
+
+} // namespace vbench
@@ -0,0 +1,48 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace vbench {
+
+/**
+ * High dynamic range histogram of latencies. Latencies are given in
+ * seconds and recorded with microsecond resolution in log-linear
+ * buckets: each power of two is split into 64 linear sub-buckets,
+ * keeping the relative error of reported values below 1% regardless
+ * of magnitude while using a bounded amount of memory.
+ **/
+class LatencyHistogram
+{
+private:
+    static constexpr uint32_t SUB_BUCKET_BITS = 7;
+    static constexpr uint64_t SUB_BUCKETS = (uint64_t(1) << SUB_BUCKET_BITS);
+    static constexpr uint64_t HALF_SUB_BUCKETS = (SUB_BUCKETS / 2);
+    static constexpr uint64_t MAX_VALUE = (uint64_t(1) << 40);
+
+    std::vector<uint64_t> _counts;
+    uint64_t              _total;
+    uint64_t              _min;
+    uint64_t              _max;
+    double                _sum;
+
+    static size_t index_of(uint64_t value);
+    static uint64_t lowest_value(size_t idx);
+    static uint64_t highest_value(size_t idx);
+
+public:
+    LatencyHistogram();
+    ~LatencyHistogram();
+    void record(double latency);
+    void merge(const LatencyHistogram &rhs);
+    uint64_t count() const { return _total; }
+    double min() const;
+    double max() const;
+    double mean() const;
+    double percentile(double per) const;
+};
+
+} // namespace vbench
@@ -0,0 +1,31 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "load_sweep.h"
+#include <vbench/core/string.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <algorithm>
+
+namespace vbench {
+
+LoadSweep::LoadSweep(double startQps, double stepQps, size_t steps, double stepDuration)
+    : _startQps(startQps),
+      _stepQps(stepQps),
+      _steps(steps),
+      _stepDuration(stepDuration)
+{
+    if (!(startQps > 0.0) || (stepQps < 0.0) || (steps == 0) || !(stepDuration > 0.0)) {
+        throw vespalib::IllegalArgumentException(strfmt("invalid load sweep: start_qps=%g, step_qps=%g, steps=%zu, step_duration=%g",
+                                                        startQps, stepQps, steps, stepDuration));
+    }
+}
+
+size_t
+LoadSweep::step(double time) const
+{
+    if (!(time >= 0.0) || (time >= endTime())) {
+        return _steps;
+    }
+    return std::min((size_t)(time / _stepDuration), _steps - 1);
+}
+
+} // namespace vbench
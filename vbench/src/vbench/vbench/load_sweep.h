@@ -0,0 +1,37 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+
+namespace vbench {
+
+/**
+ * Schedule for an open-loop load sweep. The offered load starts at
+ * startQps and is increased by stepQps for each step. Each step lasts
+ * for stepDuration seconds, and the sweep ends after the last step.
+ **/
+class LoadSweep
+{
+private:
+    double _startQps;
+    double _stepQps;
+    size_t _steps;
+    double _stepDuration;
+
+public:
+    LoadSweep(double startQps, double stepQps, size_t steps, double stepDuration);
+    size_t steps() const { return _steps; }
+    double stepDuration() const { return _stepDuration; }
+    double qps(size_t step) const { return _startQps + (step * _stepQps); }
+    double stepStart(size_t step) const { return step * _stepDuration; }
+    double endTime() const { return stepStart(_steps); }
+
+    /**
+     * Returns the step covering the given time, or steps() if the time
+     * is outside the sweep.
+     **/
+    size_t step(double time) const;
+};
+
+} // namespace vbench
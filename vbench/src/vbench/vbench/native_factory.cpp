@@ -9,9 +9,24 @@
 #include "qps_analyzer.h"
 #include "request_dumper.h"
 #include "ignore_before.h"
+#include "sweep_analyzer.h"
+#include "sweep_tagger.h"
 
 namespace vbench {
 
+namespace {
+
+LoadSweep createLoadSweep(const vespalib::slime::Inspector &spec) {
+    return LoadSweep(spec["start_qps"].asDouble(), spec["step_qps"].asDouble(),
+                     spec["steps"].asLong(), spec["step_duration"].asDouble());
+}
+
+double getDouble(const vespalib::slime::Inspector &field, double defaultValue) {
+    return field.valid() ? field.asDouble() : defaultValue;
+}
+
+} // namespace vbench::<unnamed>
+
 Generator::UP
 NativeFactory::createGenerator(const vespalib::slime::Inspector &spec,
                                Handler<Request> &next)
@@ -35,6 +50,9 @@ NativeFactory::createTagger(const vespalib::slime::Inspector &spec,
     if (type == "QpsTagger") {
         return Tagger::UP(new QpsTagger(spec["qps"].asLong(), next));
     }
+    if (type == "SweepTagger") {
+        return Tagger::UP(new SweepTagger(createLoadSweep(spec), next));
+    }
     return Tagger::UP();
 }
 
@@ -55,6 +73,12 @@ NativeFactory::createAnalyzer(const vespalib::slime::Inspector &spec,
     if (type == "IgnoreBefore") {
         return Analyzer::UP(new IgnoreBefore(spec["time"].asDouble(), next));
     }
+    if (type == "SweepAnalyzer") {
+        return Analyzer::UP(new SweepAnalyzer(createLoadSweep(spec),
+                                              getDouble(spec["min_throughput_ratio"], 0.9),
+                                              getDouble(spec["max_latency_factor"], 3.0),
+                                              spec["file"].asString().make_string(), next));
+    }
     return Analyzer::UP();
 }
 
@@ -0,0 +1,168 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sweep_analyzer.h"
+#include <vespa/vespalib/data/slime/slime.h>
+
+namespace vbench {
+
+SweepAnalyzer::Point::Point()
+    : offeredQps(0), achievedQps(0), ok(0), failed(0), dropped(0),
+      min(0), avg(0), per50(0), per90(0), per99(0), per999(0), max(0)
+{
+}
+
+SweepAnalyzer::Curve::Curve()
+    : points(),
+      saturated(false),
+      kneeStep(0),
+      maxSustainedQps(0)
+{
+}
+
+SweepAnalyzer::Curve::~Curve() = default;
+
+string
+SweepAnalyzer::Curve::toJson() const
+{
+    vespalib::Slime slime;
+    vespalib::slime::Cursor &root = slime.setObject();
+    root.setBool("saturated", saturated);
+    if (saturated) {
+        root.setLong("knee_step", kneeStep);
+    }
+    root.setDouble("max_sustained_qps", maxSustainedQps);
+    vespalib::slime::Cursor &steps = root.setArray("steps");
+    for (const Point &point: points) {
+        vespalib::slime::Cursor &obj = steps.addObject();
+        obj.setDouble("offered_qps", point.offeredQps);
+        obj.setDouble("achieved_qps", point.achievedQps);
+        obj.setLong("ok", point.ok);
+        obj.setLong("failed", point.failed);
+        obj.setLong("dropped", point.dropped);
+        vespalib::slime::Cursor &latency = obj.setObject("latency");
+        latency.setDouble("min", point.min);
+        latency.setDouble("avg", point.avg);
+        latency.setDouble("p50", point.per50);
+        latency.setDouble("p90", point.per90);
+        latency.setDouble("p99", point.per99);
+        latency.setDouble("p999", point.per999);
+        latency.setDouble("max", point.max);
+    }
+    return slime.toString();
+}
+
+SweepAnalyzer::Step::Step()
+    : latency(),
+      ok(0),
+      failed(0),
+      dropped(0),
+      completed(0)
+{
+}
+
+SweepAnalyzer::SweepAnalyzer(const LoadSweep &sweep, double minThroughputRatio, double maxLatencyFactor,
+                             const string &fileName, Handler<Request> &next)
+    : _next(next),
+      _sweep(sweep),
+      _minThroughputRatio(minThroughputRatio),
+      _maxLatencyFactor(maxLatencyFactor),
+      _fileName(fileName),
+      _steps(sweep.steps())
+{
+}
+
+SweepAnalyzer::~SweepAnalyzer() = default;
+
+void
+SweepAnalyzer::handle(Request::UP request)
+{
+    size_t scheduledStep = _sweep.step(request->scheduledTime());
+    if (scheduledStep < _steps.size()) {
+        Step &step = _steps[scheduledStep];
+        switch (request->status()) {
+        case Request::STATUS_OK:
+            ++step.ok;
+            step.latency.record(request->endTime() - request->scheduledTime());
+            break;
+        case Request::STATUS_DROPPED:
+            ++step.dropped;
+            break;
+        case Request::STATUS_FAILED:
+            ++step.failed;
+            break;
+        }
+    }
+    if (request->status() == Request::STATUS_OK) {
+        size_t endStep = _sweep.step(request->endTime());
+        if (endStep < _steps.size()) {
+            ++_steps[endStep].completed;
+        }
+    }
+    _next.handle(std::move(request));
+}
+
+void
+SweepAnalyzer::report()
+{
+    Curve curve = getCurve();
+    for (size_t i = 0; i < curve.points.size(); ++i) {
+        const Point &point = curve.points[i];
+        fprintf(stdout, "sweep step %zu: offered qps: %g, achieved qps: %g, p50: %g, p99: %g, max: %g\n",
+                i, point.offeredQps, point.achievedQps, point.per50, point.per99, point.max);
+    }
+    if (curve.saturated) {
+        fprintf(stdout, "sweep knee at step %zu, max sustained qps: %g\n", curve.kneeStep, curve.maxSustainedQps);
+    } else {
+        fprintf(stdout, "sweep not saturated, max sustained qps: %g\n", curve.maxSustainedQps);
+    }
+    if (!_fileName.empty()) {
+        FILE *file = fopen(_fileName.c_str(), "w");
+        if (file == nullptr) {
+            fprintf(stderr, "could not write sweep curve to file: %s\n", _fileName.c_str());
+            return;
+        }
+        string json = curve.toJson();
+        fwrite(json.data(), 1, json.size(), file);
+        fclose(file);
+    }
+}
+
+SweepAnalyzer::Curve
+SweepAnalyzer::getCurve() const
+{
+    Curve curve;
+    double baseline = 0.0;
+    for (size_t i = 0; i < _steps.size(); ++i) {
+        const Step &step = _steps[i];
+        Point point;
+        point.offeredQps = _sweep.qps(i);
+        point.achievedQps = (step.completed / _sweep.stepDuration());
+        point.ok = step.ok;
+        point.failed = step.failed;
+        point.dropped = step.dropped;
+        point.min = step.latency.min();
+        point.avg = step.latency.mean();
+        point.per50 = step.latency.percentile(50.0);
+        point.per90 = step.latency.percentile(90.0);
+        point.per99 = step.latency.percentile(99.0);
+        point.per999 = step.latency.percentile(99.9);
+        point.max = step.latency.max();
+        if (i == 0) {
+            baseline = point.per99;
+        }
+        if (!curve.saturated) {
+            bool lowThroughput = (point.achievedQps < (_minThroughputRatio * point.offeredQps));
+            bool highLatency = (baseline > 0.0) && (point.per99 > (_maxLatencyFactor * baseline));
+            if (lowThroughput || highLatency) {
+                curve.saturated = true;
+                curve.kneeStep = i;
+            } else {
+                curve.maxSustainedQps = point.offeredQps;
+            }
+        }
+        curve.points.push_back(point);
+    }
+    return curve;
+}
+
+} // namespace vbench
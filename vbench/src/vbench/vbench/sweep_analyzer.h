@@ -0,0 +1,80 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "analyzer.h"
+#include "latency_histogram.h"
+#include "load_sweep.h"
+
+namespace vbench {
+
+/**
+ * Component building a latency versus throughput curve for a load
+ * sweep scheduled by a SweepTagger with the same sweep. Latency is
+ * measured from the scheduled time of each request rather than the
+ * time it was actually sent, so time spent waiting for an available
+ * connection while the target is saturated is included (avoiding
+ * coordinated omission). Latencies are attributed to the step a
+ * request was scheduled in, while achieved throughput is the rate of
+ * successful requests completing within each step.
+ *
+ * The knee of the curve is the first step where either the achieved
+ * throughput falls below minThroughputRatio of the offered load, or
+ * the 99 percentile latency exceeds maxLatencyFactor times that of the
+ * first step. The curve is written as JSON to the given file (if any)
+ * when reporting. All latencies are in seconds.
+ **/
+class SweepAnalyzer : public Analyzer
+{
+public:
+    struct Point {
+        double offeredQps;
+        double achievedQps;
+        size_t ok;
+        size_t failed;
+        size_t dropped;
+        double min;
+        double avg;
+        double per50;
+        double per90;
+        double per99;
+        double per999;
+        double max;
+        Point();
+    };
+    struct Curve {
+        std::vector<Point> points;
+        bool               saturated;
+        size_t             kneeStep;
+        double             maxSustainedQps;
+        Curve();
+        ~Curve();
+        string toJson() const;
+    };
+
+private:
+    struct Step {
+        LatencyHistogram latency;
+        size_t           ok;
+        size_t           failed;
+        size_t           dropped;
+        size_t           completed;
+        Step();
+    };
+    Handler<Request>  &_next;
+    LoadSweep          _sweep;
+    double             _minThroughputRatio;
+    double             _maxLatencyFactor;
+    string             _fileName;
+    std::vector<Step>  _steps;
+
+public:
+    SweepAnalyzer(const LoadSweep &sweep, double minThroughputRatio, double maxLatencyFactor,
+                  const string &fileName, Handler<Request> &next);
+    ~SweepAnalyzer() override;
+    void handle(Request::UP request) override;
+    void report() override;
+    Curve getCurve() const;
+};
+
+} // namespace vbench
@@ -0,0 +1,30 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sweep_tagger.h"
+
+namespace vbench {
+
+SweepTagger::SweepTagger(const LoadSweep &sweep, Handler<Request> &next)
+    : _sweep(sweep),
+      _step(0),
+      _time(0.0),
+      _next(next)
+{
+}
+
+void
+SweepTagger::handle(Request::UP request)
+{
+    if (_step >= _sweep.steps()) {
+        return;
+    }
+    request->scheduledTime(_time);
+    _time += (1.0 / _sweep.qps(_step));
+    if (_time >= _sweep.stepStart(_step + 1)) {
+        ++_step;
+        _time = _sweep.stepStart(_step);
+    }
+    _next.handle(std::move(request));
+}
+
+} // namespace vbench
@@ -0,0 +1,31 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "tagger.h"
+#include "request.h"
+#include "load_sweep.h"
+
+namespace vbench {
+
+/**
+ * Sets the start time of requests based on a stepped load sweep. Each
+ * step starts on its step boundary with evenly spaced requests at the
+ * offered qps of that step. Requests arriving after the last step
+ * are discarded, so the input must contain enough requests to cover
+ * the whole sweep.
+ **/
+class SweepTagger : public Tagger
+{
+private:
+    LoadSweep         _sweep;
+    size_t            _step;
+    double            _time;
+    Handler<Request> &_next;
+
+public:
+    SweepTagger(const LoadSweep &sweep, Handler<Request> &next);
+    void handle(Request::UP request) override;
+};
+
+} // namespace vbench
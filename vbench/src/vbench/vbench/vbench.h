@@ -12,6 +12,8 @@
 #include "request_scheduler.h"
 #include "request_sink.h"
 #include "server_tagger.h"
+#include "sweep_analyzer.h"
+#include "sweep_tagger.h"
 #include "tagger.h"
 #include <vbench/core/taintable.h>
 #include <vespa/vespalib/data/slime/slime.h>
@@ -9,6 +9,8 @@
 #include <vespa/vespalib/datastore/compaction_strategy.h>
 #include <vespa/vespalib/datastore/entry_ref_filter.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <map>
+#include <random>
 
 using vespalib::GenerationHandler;
 using vespalib::datastore::CompactionSpec;
@@ -195,6 +197,53 @@ TEST_F(BTreeStoreTest, require_that_btree_roots_are_compacted)
     test_compact_sequence(10);
 }
 
+TEST_F(BTreeStoreTest, require_that_batched_changes_are_merged_into_tree)
+{
+    std::mt19937 rnd(42);
+    std::map<int, int> exp;
+    EntryRef root = add_sequence(0, 2000);
+    for (int i = 0; i < 2000; ++i) {
+        exp[i] = 0;
+    }
+    inc_generation();
+    for (int pass = 1; pass <= 200; ++pass) {
+        std::map<int, int> adds;
+        std::vector<TreeStore::KeyType> removals;
+        // Changes are clustered to get several changes per leaf node
+        int base = rnd() % 2000;
+        for (int i = 0; i < 40; ++i) {
+            int key = base + (rnd() % 60);
+            if ((rnd() % 2) == 0) {
+                adds[key] = pass;
+            } else {
+                removals.emplace_back(key);
+            }
+        }
+        std::sort(removals.begin(), removals.end());
+        removals.erase(std::unique(removals.begin(), removals.end()), removals.end());
+        std::vector<TreeStore::KeyDataType> additions;
+        for (auto& add : adds) {
+            additions.emplace_back(add.first, add.second);
+        }
+        for (auto key : removals) {
+            exp.erase(key);
+        }
+        for (auto& add : adds) {
+            exp[add.first] = add.second;
+        }
+        _store.apply(root,
+                     additions.data(), additions.data() + additions.size(),
+                     removals.data(), removals.data() + removals.size());
+        inc_generation();
+        ASSERT_EQ(exp.size(), _store.frozenSize(root));
+        std::vector<std::pair<int, int>> exp_pairs(exp.begin(), exp.end());
+        std::vector<std::pair<int, int>> act;
+        _store.foreach_frozen(root, [&act](int key, int data) { act.emplace_back(key, data); });
+        ASSERT_EQ(exp_pairs, act);
+    }
+    _store.clear(root);
+}
+
 }
 
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -1,7 +1,11 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/adaptive_compression.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/vespalib/data/databuffer.h>
 #include <atomic>
 #include <string>
@@ -68,9 +72,101 @@ TEST(CompressionTest, requiret_that_zstd_compression_decompression_works) {
     EXPECT_EQ(_G_compressableText, std::string(decompress.data(), decompress.size()));
 }
 
+ZStdDictionary::SP
+trainDictionary() {
+    std::vector<char> samples;
+    std::vector<size_t> sampleSizes;
+    for (uint32_t i(0); i < 2000; i++) {
+        std::string sample = make_string("{\"id\":%u,\"name\":\"name %u\",\"text\":\"%s\"}",
+                                         i, i * 13, _G_compressableText.c_str() + (i % 100));
+        samples.insert(samples.end(), sample.begin(), sample.end());
+        sampleSizes.push_back(sample.size());
+    }
+    return ZStdDictionary::train(samples, sampleSizes, 4096);
+}
+
+TEST(CompressionTest, require_that_zstd_dictionary_compression_decompression_works) {
+    auto dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    EXPECT_NE(0u, dictionary->id());
+    EXPECT_GE(4096u, dictionary->data().size());
+    std::string text = make_string("{\"id\":%u,\"name\":\"name %u\",\"text\":\"%s\"}", 5000u, 65000u, _G_compressableText.c_str());
+    ConstBufferRef ref(text.c_str(), text.size());
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD);
+    DataBuffer plain;
+    EXPECT_EQ(CompressionConfig::Type::ZSTD, compress(cfg, ref, plain, false));
+    ZStdDictionaryCompressor compressor(*dictionary);
+    DataBuffer compressed;
+    EXPECT_EQ(CompressionConfig::Type::ZSTD, compress(compressor, cfg, ref, compressed));
+    EXPECT_LT(compressed.getDataLen(), plain.getDataLen());
+
+    DataBuffer decompressed;
+    decompress(compressor, text.size(), ConstBufferRef(compressed.getData(), compressed.getDataLen()), decompressed, false);
+    EXPECT_EQ(text, std::string(decompressed.getData(), decompressed.getDataLen()));
+}
+
+TEST(CompressionTest, require_that_invalid_zstd_dictionary_is_rejected) {
+    EXPECT_THROW(ZStdDictionary(std::vector<char>(100, 'a')), IllegalArgumentException);
+}
+
 TEST(CompressionTest, require_that_CompressionConfig_is_Atomic) {
     EXPECT_EQ(8u, sizeof(CompressionConfig));
     EXPECT_TRUE(std::atomic<CompressionConfig>::is_always_lock_free);
 }
 
+TEST(AdaptiveCompressionTest, dense_compression_is_used_for_large_payloads_on_slow_or_unknown_links) {
+    AdaptiveCompression::Config cfg;
+    cfg.dense_min_size = 1000;
+    cfg.slow_link_bytes_per_second = 10e6;
+    AdaptiveCompression compression(CompressionConfig(CompressionConfig::LZ4), cfg);
+    AdaptiveCompression::LinkEstimate link;
+    EXPECT_EQ(CompressionConfig::LZ4, compression.select(999, nullptr).type);
+    EXPECT_EQ(CompressionConfig::ZSTD, compression.select(1000, nullptr).type);
+    EXPECT_EQ(CompressionConfig::ZSTD, compression.select(1000, &link).type);
+    link.observe_transfer(1_Mi, 10ms); // 100 MB/s
+    EXPECT_EQ(CompressionConfig::LZ4, compression.select(1000, &link).type);
+    link.observe_transfer(1_Mi, 10s); // slowly dragged below the threshold
+    EXPECT_EQ(CompressionConfig::LZ4, compression.select(1000, &link).type);
+    for (int i = 0; i < 50; ++i) {
+        link.observe_transfer(1_Mi, 10s);
+    }
+    EXPECT_EQ(CompressionConfig::ZSTD, compression.select(1000, &link).type);
+}
+
+TEST(AdaptiveCompressionTest, dense_compression_is_disabled_by_default) {
+    AdaptiveCompression compression(CompressionConfig(CompressionConfig::LZ4));
+    EXPECT_EQ(CompressionConfig::LZ4, compression.select(100_Mi, nullptr).type);
+}
+
+TEST(AdaptiveCompressionTest, small_transfers_are_not_sampled) {
+    AdaptiveCompression::LinkEstimate link;
+    link.observe_transfer(AdaptiveCompression::LinkEstimate::min_sample_bytes - 1, 1ms);
+    EXPECT_EQ(0.0, link.bytes_per_second());
+    link.observe_transfer(AdaptiveCompression::LinkEstimate::min_sample_bytes, 1s);
+    EXPECT_DOUBLE_EQ(double(AdaptiveCompression::LinkEstimate::min_sample_bytes), link.bytes_per_second());
+}
+
+TEST(AdaptiveCompressionTest, compression_ratio_is_tracked_per_type) {
+    AdaptiveCompression::Config cfg;
+    cfg.dense_min_size = 1000;
+    AdaptiveCompression compression(CompressionConfig(CompressionConfig::LZ4), cfg);
+    ConstBufferRef ref(_G_compressableText.c_str(), _G_compressableText.size());
+    ConstBufferRef small(_G_compressableText.c_str(), 10);
+    DataBuffer a, b, c;
+    EXPECT_EQ(CompressionConfig::ZSTD, compression.compress(ref, a, nullptr));
+    EXPECT_EQ(CompressionConfig::NONE, compression.compress(small, b, nullptr));
+    auto before = compression.stats();
+    EXPECT_EQ(1u, before.zstd.payloads);
+    EXPECT_EQ(ref.size(), before.zstd.input_bytes);
+    EXPECT_EQ(a.getDataLen(), before.zstd.output_bytes);
+    EXPECT_GT(before.zstd.ratio(), 10.0);
+    EXPECT_EQ(1u, before.none.payloads);
+    EXPECT_EQ(1.0, before.none.ratio());
+    EXPECT_EQ(0u, before.lz4.payloads);
+    EXPECT_EQ(CompressionConfig::ZSTD, compression.compress(ref, c, nullptr));
+    auto delta = compression.stats().subtract(before);
+    EXPECT_EQ(1u, delta.zstd.payloads);
+    EXPECT_EQ(0u, delta.none.payloads);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
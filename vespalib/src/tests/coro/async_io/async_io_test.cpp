@@ -16,6 +16,8 @@
 #include <vespa/vespalib/net/tls/tls_crypto_engine.h>
 #include <vespa/vespalib/net/tls/maybe_tls_crypto_engine.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <cstdlib>
+#include <unistd.h>
 
 using namespace vespalib;
 using namespace vespalib::coro;
@@ -184,4 +186,37 @@ TEST(AsyncIoTest, tls_socket_io_with_io_uring_maybe) {
     verify_socket_io(engine, AsyncIo::ImplTag::URING);
 }
 
+Lazy<std::string> pread_msg(AsyncIo &async, int fd, size_t len, uint64_t offset) {
+    std::string result(len, '\0');
+    ssize_t res = co_await async.pread(fd, result.data(), len, offset);
+    result.resize(std::max(res, ssize_t(0)));
+    co_return result;
+}
+
+void verify_file_io(AsyncIo::ImplTag prefer_impl) {
+    char name[] = "async_io_test_XXXXXX";
+    int fd = mkstemp(name);
+    REQUIRE(fd >= 0);
+    unlink(name);
+    std::string content = "positional reads from a regular file";
+    REQUIRE(::write(fd, content.data(), content.size()) == ssize_t(content.size()));
+    auto async = AsyncIo::create(prefer_impl);
+    fprintf(stderr, "verify_file_io: async impl: %s\n", impl_spec(async).c_str());
+    auto f1 = make_future(pread_msg(async, fd, 10, 0));
+    auto f2 = make_future(pread_msg(async, fd, 5, 11));
+    auto f3 = make_future(pread_msg(async, fd, 100, 32));
+    EXPECT_EQ("positional", f1.get());
+    EXPECT_EQ("reads", f2.get());
+    EXPECT_EQ("file", f3.get());
+    close(fd);
+}
+
+TEST(AsyncIoTest, file_io) {
+    verify_file_io(AsyncIo::ImplTag::EPOLL);
+}
+
+TEST(AsyncIoTest, file_io_with_io_uring_maybe) {
+    verify_file_io(AsyncIo::ImplTag::URING);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -12,6 +12,7 @@
 #include <vespa/vespalib/test/memory_allocator_observer.h>
 #include <vespa/vespalib/util/memory_allocator.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vector>
 
 using namespace vespalib::datastore;
@@ -329,6 +330,22 @@ TYPED_TEST(NumberStoreTest, add_and_get_large_arrays_of_simple_type)
     this->assertAdd({2,3,4,5,6,7});
 }
 
+TYPED_TEST(NumberStoreTest, small_and_large_arrays_can_be_prefetched)
+{
+    std::vector<typename TestFixture::ElemVector> inputs{{}, {1}, {2,3}, {3,4,5}, {1,2,3,4,5}, {2,3,4,5,6,7}};
+    std::vector<EntryRef> refs;
+    for (const auto& input : inputs) {
+        refs.emplace_back(this->add(input));
+    }
+    this->store.prefetch(EntryRef());
+    for (auto ref : refs) {
+        this->store.prefetch(ref);
+    }
+    for (size_t i = 0; i < refs.size(); ++i) {
+        this->assertGet(refs[i], inputs[i]);
+    }
+}
+
 TEST_F(StringStoreTest, add_and_get_large_arrays_of_non_trivial_type)
 {
     assertAdd({"aa", "bb", "cc", "dd", "ee"});
@@ -504,6 +521,27 @@ void testCompaction(Fixture &f, bool compactMemory, bool compactAddressSpace)
 
 }
 
+TEST_F(NumberStoreBasicTest, compaction_copies_entries_using_helper_executor)
+{
+    vespalib::ThreadStackExecutor executor(4);
+    CompactionContext::set_helper_executor(&executor);
+    constexpr uint32_t num_arrays = 3 * CompactionContext::parallel_copy_chunk_size;
+    std::vector<EntryRef> refs;
+    for (uint32_t i = 0; i < num_arrays; ++i) {
+        refs.emplace_back(add({i, i + 1}));
+    }
+    for (uint32_t i = 0; i < num_arrays; i += 3) {
+        ASSERT_NO_FATAL_FAILURE(remove(refs[i]));
+    }
+    reclaim_memory();
+    ASSERT_NO_FATAL_FAILURE(compactWorst(true, false));
+    CompactionContext::set_helper_executor(nullptr);
+    EXPECT_EQ(num_arrays - num_arrays / 3, refStore.size());
+    assertStoreContent();
+    assertGet(refs[1], {1, 2}); // Old ref should still point to data.
+    reclaim_memory();
+}
+
 TYPED_TEST(NumberStoreTest, compactWorst_selects_on_only_memory) {
     testCompaction<typename TestFixture::Parent>(*this, true, false);
 }
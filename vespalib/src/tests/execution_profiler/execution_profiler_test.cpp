@@ -1,11 +1,13 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/vespalib/util/execution_profiler.h>
+#include <vespa/vespalib/util/execution_profile_aggregator.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <thread>
 
 using Profiler = vespalib::ExecutionProfiler;
+using Aggregator = vespalib::ExecutionProfileAggregator;
 using vespalib::Slime;
 using vespalib::slime::Cursor;
 using vespalib::slime::Inspector;
@@ -232,4 +234,106 @@ TEST(ExecutionProfilerTest, flat_profiling_does_not_report_tasks_with_count_0) {
     EXPECT_EQ(slime["roots"][0]["count"].asLong(), 1);
 }
 
+TEST(ExecutionProfilerTest, hw_counters_are_reported_when_available) {
+    for (int32_t depth: {64, -4}) {
+        Profiler profiler(depth, true);
+        for (int i = 0; i < 3; ++i) {
+            foo(profiler);
+        }
+        Slime slime;
+        profiler.report(slime.setObject());
+        fprintf(stderr, "%s\n", slime.toString().c_str());
+        ASSERT_TRUE(slime["hw_counters"].valid());
+        if (depth > 0) {
+            EXPECT_TRUE(find_path(slime, {{"foo", 3}, {"bar", 3}, {"baz", 6}, {"fox", 18}}));
+        }
+        const Inspector &root = slime["roots"][0];
+        const Inspector &counters = (depth > 0) ? root["total_hw_counters"] : root["self_hw_counters"];
+        if (slime["hw_counters"].asBool()) {
+            EXPECT_TRUE(counters.valid());
+            if (counters["instructions"].valid()) {
+                EXPECT_GT(counters["instructions"].asLong(), 0);
+            }
+        } else {
+            fprintf(stderr, "hardware counters not available\n");
+            EXPECT_FALSE(counters.valid());
+        }
+    }
+}
+
+TEST(ExecutionProfilerTest, hw_counters_are_not_reported_by_default) {
+    Profiler profiler(64);
+    fox(profiler);
+    Slime slime;
+    profiler.report(slime.setObject());
+    EXPECT_FALSE(slime["hw_counters"].valid());
+    EXPECT_FALSE(slime["roots"][0]["total_hw_counters"].valid());
+}
+
+TEST(ExecutionProfileAggregatorTest, tree_profiles_are_merged_by_task_path) {
+    Aggregator aggregator;
+    for (int i = 0; i < 3; ++i) {
+        Profiler profiler(64);
+        foo(profiler);
+        bar(profiler);
+        Slime report;
+        profiler.report(report.setObject());
+        aggregator.merge(report.get());
+    }
+    EXPECT_EQ(aggregator.num_profiles(), 3);
+    Slime slime;
+    aggregator.report(slime.setObject());
+    fprintf(stderr, "%s\n", slime.toString().c_str());
+    EXPECT_EQ(slime["profiler"].asString().make_string(), "tree");
+    EXPECT_EQ(slime["profiles"].asLong(), 3);
+    EXPECT_EQ(slime["roots"].entries(), 2);
+    EXPECT_GT(slime["total_time_ms"].asDouble(), 0.0);
+    EXPECT_TRUE(find_path(slime, {{"foo", 3}, {"bar", 3}, {"baz", 6}, {"fox", 18}}));
+    EXPECT_TRUE(find_path(slime, {{"foo", 3}, {"baz", 3}, {"fox", 9}}));
+    EXPECT_TRUE(find_path(slime, {{"foo", 3}, {"fox", 3}}));
+    EXPECT_TRUE(find_path(slime, {{"bar", 3}, {"baz", 6}, {"fox", 18}}));
+    EXPECT_TRUE(find_path(slime, {{"bar", 3}, {"fox", 6}}));
+    EXPECT_LT(slime["roots"][0]["self_time_ms"].asDouble(), slime["roots"][0]["total_time_ms"].asDouble());
+}
+
+TEST(ExecutionProfileAggregatorTest, flat_profiles_are_ignored) {
+    Aggregator aggregator;
+    Profiler profiler(-64);
+    foo(profiler);
+    Slime report;
+    profiler.report(report.setObject());
+    aggregator.merge(report.get());
+    EXPECT_EQ(aggregator.num_profiles(), 0);
+}
+
+TEST(ExecutionProfileAggregatorTest, number_of_tasks_is_limited) {
+    Aggregator aggregator(3);
+    Profiler profiler(64);
+    foo(profiler);
+    Slime report;
+    profiler.report(report.setObject());
+    aggregator.merge(report.get());
+    Slime slime;
+    aggregator.report(slime.setObject());
+    fprintf(stderr, "%s\n", slime.toString().c_str());
+    EXPECT_TRUE(find_path(slime, {{"foo", 1}, {"bar", 1}, {"baz", 2}}));
+    EXPECT_EQ(slime["dropped_tasks"].asLong(), 4);
+}
+
+TEST(ExecutionProfileAggregatorTest, reset_clears_aggregated_profiles) {
+    Aggregator aggregator;
+    Profiler profiler(64);
+    fox(profiler);
+    Slime report;
+    profiler.report(report.setObject());
+    aggregator.merge(report.get());
+    EXPECT_EQ(aggregator.num_profiles(), 1);
+    aggregator.reset();
+    EXPECT_EQ(aggregator.num_profiles(), 0);
+    Slime slime;
+    aggregator.report(slime.setObject());
+    EXPECT_EQ(slime["profiles"].asLong(), 0);
+    EXPECT_EQ(slime["roots"].entries(), 0);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,106 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/fuzzy/bit_parallel_levenshtein.h>
+#include <vespa/vespalib/fuzzy/levenshtein_distance.h>
+#include <vespa/vespalib/fuzzy/unicode_utils.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <random>
+
+using namespace vespalib::fuzzy;
+using vespalib::LevenshteinDistance;
+
+namespace {
+
+BitParallelLevenshtein make_matcher(std::string_view target, uint8_t max_edits, bool cased, bool prefix) {
+    auto target_u32 = cased ? utf8_string_to_utf32(target) : utf8_string_to_utf32_lowercased(target);
+    return {target_u32, max_edits, cased, prefix};
+}
+
+std::optional<uint32_t> edits(std::string_view target, std::string_view source, uint8_t max_edits, bool prefix = false) {
+    auto result = make_matcher(target, max_edits, true, prefix).match(source);
+    return result.matches() ? std::optional<uint32_t>(result.edits()) : std::nullopt;
+}
+
+std::string random_string(std::mt19937& rnd, size_t max_len) {
+    std::uniform_int_distribution<size_t> len_dist(0, max_len);
+    std::uniform_int_distribution<int> char_dist(0, 3);
+    std::string result;
+    for (size_t i = len_dist(rnd); i > 0; --i) {
+        result.push_back("abcx"[char_dist(rnd)]);
+    }
+    return result;
+}
+
+}
+
+TEST(BitParallelLevenshteinTest, full_string_matching_edge_cases) {
+    EXPECT_EQ(edits("abc", "abc", 2), std::optional{0});
+    EXPECT_EQ(edits("abc", "ab1", 2), std::optional{1});
+    EXPECT_EQ(edits("abc", "1bc", 2), std::optional{1});
+    EXPECT_EQ(edits("abc", "ab", 2), std::optional{1});
+    EXPECT_EQ(edits("abc", "abcd", 2), std::optional{1});
+    EXPECT_EQ(edits("bc", "abcd", 2), std::optional{2});
+    EXPECT_EQ(edits("abc", "123", 2), std::nullopt);
+    EXPECT_EQ(edits("", "ab", 2), std::optional{2});
+    EXPECT_EQ(edits("", "abc", 2), std::nullopt);
+    EXPECT_EQ(edits("abc", "", 2), std::nullopt);
+    EXPECT_EQ(edits("abcde", "xad", 2), std::nullopt);
+    EXPECT_EQ(edits("abcde", "abcdefgh", 2), std::nullopt);
+}
+
+TEST(BitParallelLevenshteinTest, prefix_matching_edge_cases) {
+    EXPECT_EQ(edits("", "literally anything", 1, true), std::optional{0});
+    EXPECT_EQ(edits("x", "", 1, true), std::optional{1});
+    EXPECT_EQ(edits("abc", "abcdef", 1, true), std::optional{0});
+    EXPECT_EQ(edits("abc", "ab", 1, true), std::optional{1});
+    EXPECT_EQ(edits("ac", "abcdef", 1, true), std::optional{1});
+    EXPECT_EQ(edits("ban", "2bananas", 1, true), std::optional{1});
+    EXPECT_EQ(edits("ban", "boonanas", 1, true), std::nullopt);
+}
+
+TEST(BitParallelLevenshteinTest, uncased_matching_lowercases_source) {
+    auto matcher = make_matcher("Hello", 1, false, false);
+    EXPECT_EQ(0, matcher.match("HELLO").edits());
+    EXPECT_EQ(1, matcher.match("jELLO").edits());
+    auto cased = make_matcher("Hello", 1, true, false);
+    EXPECT_FALSE(cased.match("HELLO").matches());
+    EXPECT_EQ(1, cased.match("hello").edits());
+}
+
+TEST(BitParallelLevenshteinTest, non_ascii_chars_are_matched_as_code_points) {
+    EXPECT_EQ(edits("blåbær", "blåbær", 1), std::optional{0});
+    EXPECT_EQ(edits("blåbær", "blabær", 1), std::optional{1});
+    EXPECT_EQ(edits("blåbær", "blabar", 1), std::nullopt);
+    EXPECT_EQ(edits("日本語", "日本", 1), std::optional{1});
+}
+
+TEST(BitParallelLevenshteinTest, max_length_target_is_supported) {
+    std::string target(64, 'a');
+    EXPECT_TRUE(BitParallelLevenshtein::supports_target_length(64));
+    EXPECT_FALSE(BitParallelLevenshtein::supports_target_length(65));
+    EXPECT_EQ(edits(target, target, 2), std::optional{0});
+    EXPECT_EQ(edits(target, target + "bb", 2), std::optional{2});
+    EXPECT_EQ(edits(target, "b" + target.substr(1), 2), std::optional{1});
+}
+
+TEST(BitParallelLevenshteinTest, results_are_equal_to_dynamic_programming_results) {
+    std::mt19937 rnd(42);
+    for (size_t i = 0; i < 20000; ++i) {
+        auto target = random_string(rnd, 12);
+        auto source = random_string(rnd, 14);
+        auto target_u32 = utf8_string_to_utf32(target);
+        auto source_u32 = utf8_string_to_utf32(source);
+        for (uint8_t max_edits : {1, 2}) {
+            for (bool prefix : {false, true}) {
+                auto expect = LevenshteinDistance::calculate(target_u32, source_u32, max_edits, prefix);
+                EXPECT_EQ(expect, edits(target, source, max_edits, prefix))
+                    << "target='" << target << "', source='" << source << "', max_edits="
+                    << int(max_edits) << ", prefix=" << prefix;
+                auto u32_result = BitParallelLevenshtein(target_u32, max_edits, true, prefix).match_u32(source_u32);
+                EXPECT_EQ(expect.has_value(), u32_result.matches());
+            }
+        }
+    }
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -37,6 +37,7 @@ verifyEuclideanDistance(const hwaccelerated::IAccelerated & accelerator, size_t
     verifyEuclideanDistance<int8_t, double>(accelerator, testLength, 0.0);
     verifyEuclideanDistance<float, double>(accelerator, testLength, 0.0001); // Small deviation requiring EXPECT_APPROX
     verifyEuclideanDistance<double, double>(accelerator, testLength, 0.0);
+    verifyEuclideanDistance<BFloat16, double>(accelerator, testLength, 0.0001);
 }
 
 TEST(HWAcceleratedTest, test_euclidean_distance) {
@@ -45,4 +46,111 @@ TEST(HWAcceleratedTest, test_euclidean_distance) {
     GTEST_DO(verifyEuclideanDistance(hwaccelerated::IAccelerated::getAccelerator(), TEST_LENGTH));
 }
 
+void
+verifyBFloat16DotProduct(const hwaccelerated::IAccelerated & accel, size_t testLength) {
+    srand(1);
+    std::vector<BFloat16> a = createAndFill<BFloat16>(testLength);
+    std::vector<BFloat16> b = createAndFill<BFloat16>(testLength);
+    for (size_t j(0); j < 0x20; j++) {
+        double sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            sum += double(a[i]) * double(b[i]);
+        }
+        double hwComputedSum(accel.dotProduct(&a[j], &b[j], testLength - j));
+        EXPECT_NEAR(sum, hwComputedSum, sum*0.0001);
+    }
+}
+
+TEST(HWAcceleratedTest, test_bfloat16_dot_product) {
+    constexpr size_t TEST_LENGTH = 140000;
+    GTEST_DO(verifyBFloat16DotProduct(*hwaccelerated::IAccelerated::create_platform_baseline_accelerator(), TEST_LENGTH));
+    GTEST_DO(verifyBFloat16DotProduct(hwaccelerated::IAccelerated::getAccelerator(), TEST_LENGTH));
+}
+
+void
+verifyAndOr128(const hwaccelerated::IAccelerated & accel, size_t numSources, bool emptyAnd) {
+    constexpr size_t NUM_WORDS = 64; // 4 blocks of 128 bytes
+    srand(1);
+    std::vector<std::vector<uint64_t>> vectors(numSources, std::vector<uint64_t>(NUM_WORDS));
+    std::vector<std::pair<const void *, bool>> src;
+    for (size_t i(0); i < numSources; i++) {
+        for (auto & word : vectors[i]) {
+            word = (uint64_t(rand()) << 32) | uint64_t(rand()) | 0x8000000000000001ul;
+        }
+        src.emplace_back(vectors[i].data(), (i == 2));
+    }
+    if (emptyAnd) {
+        // first block becomes empty after the first source pair
+        for (size_t w(0); w < 16; w++) {
+            vectors[1][w] = ~vectors[0][w];
+        }
+    }
+    for (size_t offset(0); offset < NUM_WORDS * sizeof(uint64_t); offset += 128) {
+        size_t base = offset / sizeof(uint64_t);
+        alignas(64) uint64_t andResult[16];
+        alignas(64) uint64_t orResult[16];
+        accel.and128(offset, src, andResult);
+        accel.or128(offset, src, orResult);
+        for (size_t w(0); w < 16; w++) {
+            uint64_t expAnd = ~uint64_t(0);
+            uint64_t expOr = 0;
+            for (size_t i(0); i < numSources; i++) {
+                uint64_t word = src[i].second ? ~vectors[i][base + w] : vectors[i][base + w];
+                expAnd &= word;
+                expOr |= word;
+            }
+            EXPECT_EQ(expAnd, andResult[w]);
+            EXPECT_EQ(expOr, orResult[w]);
+        }
+    }
+}
+
+TEST(HWAcceleratedTest, test_and128_and_or128_with_many_sources) {
+    for (size_t numSources : {1, 2, 3, 12}) {
+        for (bool emptyAnd : {false, true}) {
+            if (emptyAnd && numSources < 2) continue;
+            GTEST_DO(verifyAndOr128(*hwaccelerated::IAccelerated::create_platform_baseline_accelerator(), numSources, emptyAnd));
+            GTEST_DO(verifyAndOr128(hwaccelerated::IAccelerated::getAccelerator(), numSources, emptyAnd));
+        }
+    }
+}
+
+char
+fold_ascii_word_char(char c) {
+    if (c >= 'A' && c <= 'Z') {
+        return c + ('a' - 'A');
+    }
+    return ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) ? c : '\0';
+}
+
+void
+verifyFoldAsciiWordChars(const hwaccelerated::IAccelerated & accel, size_t testLength) {
+    std::vector<char> input(testLength);
+    for (size_t i(0); i < testLength; i++) {
+        input[i] = char(i % 128);
+    }
+    for (size_t j(0); j < 0x40; j++) {
+        std::vector<char> folded(testLength - j, 'x');
+        EXPECT_EQ(testLength - j, accel.fold_ascii_word_chars(&input[j], testLength - j, folded.data()));
+        for (size_t i(j); i < testLength; i++) {
+            EXPECT_EQ(fold_ascii_word_char(input[i]), folded[i - j]);
+        }
+    }
+    size_t non_ascii = testLength / 2 + 3;
+    input[non_ascii] = char(0xc3);
+    for (size_t j(0); j < 0x40; j++) {
+        std::vector<char> folded(testLength - j, 'x');
+        EXPECT_EQ(non_ascii - j, accel.fold_ascii_word_chars(&input[j], testLength - j, folded.data()));
+        for (size_t i(j); i < non_ascii; i++) {
+            EXPECT_EQ(fold_ascii_word_char(input[i]), folded[i - j]);
+        }
+    }
+}
+
+TEST(HWAcceleratedTest, test_fold_ascii_word_chars) {
+    constexpr size_t TEST_LENGTH = 1000;
+    GTEST_DO(verifyFoldAsciiWordChars(*hwaccelerated::IAccelerated::create_platform_baseline_accelerator(), TEST_LENGTH));
+    GTEST_DO(verifyFoldAsciiWordChars(hwaccelerated::IAccelerated::getAccelerator(), TEST_LENGTH));
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -9,7 +9,9 @@
 #include <vespa/vespalib/metrics/prometheus_formatter.h>
 #include "mock_tick.h"
 #include <stdio.h>
+#include <thread>
 #include <unistd.h>
+#include <vector>
 
 using namespace vespalib;
 using namespace vespalib::metrics;
@@ -239,4 +241,51 @@ TEST(SimpleMetricsTest, use_simple_metrics_collector)
     EXPECT_NE(0u, snap4.gauges()[2].observedCount());
 }
 
+TEST(SimpleMetricsTest, sharded_cells_are_aggregated_when_samples_are_collected)
+{
+    SimpleManagerConfig cf;
+    cf.sliding_window_seconds = 5;
+    std::shared_ptr<MockTick> ticker = std::make_shared<MockTick>(TimeStamp(1.0));
+    auto manager = SimpleMetricsManager::createForTest(cf, std::make_unique<TickProxy>(ticker));
+
+    Counter myCounter = manager->counter("foo", "no description");
+    Gauge myGauge = manager->gauge("bar", "dummy description");
+    Point one = manager->pointBuilder().bind("thread", "1").build();
+    myCounter.add(5);
+    myGauge.sample(50.0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            auto counter_cell = myCounter.cell();
+            auto labeled_cell = myCounter.cell(one);
+            auto gauge_cell = myGauge.cell();
+            for (int i = 0; i < 1000; ++i) {
+                counter_cell.add();
+                labeled_cell.add(2);
+                gauge_cell.sample(t * 1000 + i);
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    EXPECT_EQ(1.0, ticker->give(TimeStamp(2.0)).count());
+    Snapshot snap1 = manager->snapshot();
+    ASSERT_EQ(2u, snap1.counters().size());
+    EXPECT_EQ(4005u, snap1.counters()[0].count());
+    EXPECT_EQ(8000u, snap1.counters()[1].count());
+    ASSERT_EQ(1u, snap1.gauges().size());
+    EXPECT_EQ(4001u, snap1.gauges()[0].observedCount());
+    EXPECT_EQ(0.0, snap1.gauges()[0].minValue());
+    EXPECT_EQ(3999.0, snap1.gauges()[0].maxValue());
+    EXPECT_EQ(50.0 + 4 * 499500.0 + 6000000.0, snap1.gauges()[0].sumValue());
+
+    // cells are reset when collected
+    myCounter.cell().add(3);
+    EXPECT_EQ(2.0, ticker->give(TimeStamp(3.0)).count());
+    Snapshot snap2 = manager->snapshot();
+    EXPECT_EQ(4008u, snap2.counters()[0].count());
+    EXPECT_EQ(4001u, snap2.gauges()[0].observedCount());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -43,7 +43,9 @@ struct Fixture {
     Selector<Context> selector;
     std::vector<SocketPair> sockets;
     std::vector<Context> contexts;
-    Fixture(size_t size, bool read_enabled, bool write_enabled) : wakeup(false), selector(), sockets(), contexts() {
+    Fixture(size_t size, bool read_enabled, bool write_enabled, SelectorBackend backend = SelectorBackend::EPOLL)
+        : wakeup(false), selector(backend), sockets(), contexts()
+    {
         for (size_t i = 0; i < size; ++i) {
             sockets.push_back(SocketPair::create());
             contexts.push_back(Context(sockets.back().a.get()));
@@ -182,6 +184,37 @@ TEST(SelectorTest, require_that_filling_the_output_buffer_disables_write_events)
     GTEST_DO(f1.reset().poll().verify(false, {in}));
 }
 
+TEST(SelectorTest, require_that_io_uring_backend_falls_back_to_epoll_when_not_supported) {
+    Fixture f1(1, true, true, SelectorBackend::IO_URING);
+    EXPECT_EQ(f1.selector.backend(), IoUringEpoll::is_supported() ? SelectorBackend::IO_URING : SelectorBackend::EPOLL);
+    GTEST_DO(f1.reset().poll().verify(false, {out}));
+}
+
+TEST(SelectorTest, require_that_io_uring_backend_produces_level_triggered_events) {
+    if (!IoUringEpoll::is_supported()) {
+        GTEST_SKIP() << "io_uring not supported";
+    }
+    Fixture f1(3, true, false, SelectorBackend::IO_URING);
+    ASSERT_EQ(f1.selector.backend(), SelectorBackend::IO_URING);
+    GTEST_DO(f1.reset().poll(10).verify(false, {none, none, none}));
+    EXPECT_TRUE(f1.write(1, "test"));
+    GTEST_DO(f1.reset().poll().verify(false, {none, in, none}));
+    GTEST_DO(f1.reset().poll().verify(false, {none, in, none}));
+    f1.update(1, true, true);
+    GTEST_DO(f1.reset().poll().verify(false, {none, both, none}));
+    f1.update(2, false, true);
+    GTEST_DO(f1.reset().poll().verify(false, {none, both, out}));
+    EXPECT_TRUE(f1.read(1, strlen("test")));
+    f1.update(1, true, false);
+    f1.update(2, true, false);
+    GTEST_DO(f1.reset().poll(10).verify(false, {none, none, none}));
+    f1.selector.remove(f1.contexts[0].fd);
+    EXPECT_TRUE(f1.write(0, "test"));
+    GTEST_DO(f1.reset().poll(10).verify(false, {none, none, none}));
+    f1.selector.wakeup();
+    GTEST_DO(f1.reset().poll().verify(true, {none, none, none}));
+}
+
 TEST(SelectorTest, require_that_selector_can_be_woken_while_waiting_for_events) {
     size_t num_threads = 2;
     Fixture f1(0, true, false);
@@ -525,6 +525,31 @@ TEST_F(SocketTest, require_that_tcp_lingering_can_be_adjusted)
     }
 }
 
+TEST_F(SocketTest, require_that_zero_copy_writes_are_reported_as_completed)
+{
+    ServerSocket f1("tcp/0");
+    TimeBomb f2(60);
+    SocketHandle client = SocketSpec::from_port(f1.address().port()).client_address().connect();
+    SocketHandle server = f1.accept();
+    ASSERT_TRUE(client.valid());
+    ASSERT_TRUE(server.valid());
+    if (!server.set_zero_copy(true)) {
+        GTEST_SKIP() << "zero-copy writes not supported";
+    }
+    EXPECT_EQ(server.reap_zero_copy_completions(), 0u);
+    std::string message(16384, 'x');
+    ssize_t written = server.write_zero_copy(message.data(), message.size());
+    ASSERT_GT(written, 0);
+    EXPECT_EQ(read_bytes(client, written), message.substr(0, written));
+    size_t completed = server.reap_zero_copy_completions();
+    while (completed == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        completed = server.reap_zero_copy_completions();
+    }
+    EXPECT_EQ(completed, 1u);
+    EXPECT_EQ(server.reap_zero_copy_completions(), 0u);
+}
+
 SocketHandle connect_async(const SocketAddress &addr) {
     struct ConnectContext {
         SocketHandle handle;
@@ -927,6 +927,68 @@ TEST(OpensslImplTest, success_statistics_are_incremented_on_OK_authorization) {
     EXPECT_EQ(1u, client_stats.tls_connections);
 }
 
+TransportSecurityOptions create_options_with_kernel_tls_offload() {
+    auto source_opts = vespalib::test::make_tls_options_for_testing();
+    auto ts_builder = TransportSecurityOptions::Params().
+            ca_certs_pem(source_opts.ca_certs_pem()).
+            cert_chain_pem(source_opts.cert_chain_pem()).
+            private_key_pem(source_opts.private_key_pem()).
+            authorized_peers(AuthorizedPeers::allow_all_authenticated()).
+            enable_kernel_tls_offload(true);
+    return TransportSecurityOptions(std::move(ts_builder));
+}
+
+TEST(OpensslImplTest, kernel_tls_keys_are_not_exported_unless_offload_is_enabled) {
+    Fixture f;
+    ASSERT_TRUE(f.handshake());
+    KernelTlsKeys keys;
+    EXPECT_FALSE(f.client->export_kernel_tls_keys(true, keys));
+    EXPECT_FALSE(f.server->export_kernel_tls_keys(false, keys));
+}
+
+TEST(OpensslImplTest, exported_kernel_tls_keys_match_between_peers) {
+    Fixture f;
+    auto opts = create_options_with_kernel_tls_offload();
+    f.client = Fixture::create_openssl_codec(opts, CryptoCodec::Mode::Client);
+    f.server = Fixture::create_openssl_codec(opts, CryptoCodec::Mode::Server);
+    ASSERT_TRUE(f.handshake());
+    KernelTlsKeys client_tx, client_rx, server_tx, server_rx;
+    ASSERT_TRUE(f.client->export_kernel_tls_keys(true, client_tx));
+    ASSERT_TRUE(f.client->export_kernel_tls_keys(false, client_rx));
+    ASSERT_TRUE(f.server->export_kernel_tls_keys(true, server_tx));
+    ASSERT_TRUE(f.server->export_kernel_tls_keys(false, server_rx));
+    EXPECT_EQ(client_tx.cipher, server_rx.cipher);
+    EXPECT_EQ(client_tx.key, server_rx.key);
+    EXPECT_EQ(client_tx.iv, server_rx.iv);
+    EXPECT_EQ(server_tx.key, client_rx.key);
+    EXPECT_EQ(server_tx.iv, client_rx.iv);
+    EXPECT_NE(client_tx.key, client_rx.key);
+    EXPECT_EQ(12u, client_tx.iv.size());
+}
+
+TEST(OpensslImplTest, failed_kernel_tls_offload_falls_back_to_user_space_encryption) {
+    Fixture f;
+    auto opts = create_options_with_kernel_tls_offload();
+    f.client = Fixture::create_openssl_codec(opts, CryptoCodec::Mode::Client);
+    f.server = Fixture::create_openssl_codec(opts, CryptoCodec::Mode::Server);
+    ASSERT_TRUE(f.handshake());
+    auto client_before = ConnectionStatistics::get(false).snapshot();
+    // Not a socket, so the kernel will refuse to take over the session
+    auto res = f.client->offload_to_kernel(-1, true, true);
+    EXPECT_FALSE(res.tx);
+    EXPECT_FALSE(res.rx);
+    auto client_stats = ConnectionStatistics::get(false).snapshot().subtract(client_before);
+    EXPECT_EQ(0u, client_stats.kernel_tls_tx_connections);
+    EXPECT_EQ(0u, client_stats.kernel_tls_rx_connections);
+
+    std::string client_plaintext = "Hello world";
+    ASSERT_FALSE(f.client_encode(client_plaintext).failed);
+    std::string server_plaintext;
+    auto server_res = f.server_decode(server_plaintext, 256);
+    ASSERT_TRUE(server_res.frame_decoded_ok());
+    EXPECT_EQ(client_plaintext, server_plaintext);
+}
+
 // TODO we can't test embedded nulls since the OpenSSL v3 extension APIs
 // take in null terminated strings as arguments... :I
 
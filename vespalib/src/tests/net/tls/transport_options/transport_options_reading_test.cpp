@@ -25,6 +25,7 @@ class ConfigWriter {
     std::optional<std::string> _accepted_ciphers;
     std::optional<std::string> _authorized_peers;
     std::optional<std::string> _disable_hostname_validation;
+    std::optional<std::string> _enable_kernel_tls_offload;
     std::optional<std::string> _flipper_the_dolphin;
 public:
     ConfigWriter();
@@ -36,6 +37,7 @@ public:
     ConfigWriter accepted_ciphers(std::optional<std::string> value) && { _accepted_ciphers = value; return std::move(*this); }
     ConfigWriter authorized_peers(std::optional<std::string> value) && { _authorized_peers = value; return std::move(*this); }
     ConfigWriter disable_hostname_validation(std::optional<std::string> value) && { _disable_hostname_validation = value; return std::move(*this); }
+    ConfigWriter enable_kernel_tls_offload(std::optional<std::string> value) && { _enable_kernel_tls_offload = value; return std::move(*this); }
     ConfigWriter flipper_the_dolphin(std::optional<std::string> value) && { _flipper_the_dolphin = value; return std::move(*this); }
     void write(std::ostream& os);
     std::string write();
@@ -48,6 +50,7 @@ ConfigWriter::ConfigWriter()
       _accepted_ciphers(),
       _authorized_peers(),
       _disable_hostname_validation(),
+      _enable_kernel_tls_offload(),
       _flipper_the_dolphin()
 {
 }
@@ -90,6 +93,9 @@ ConfigWriter::write(std::ostream& os)
     if (_disable_hostname_validation.has_value()) {
         os << ",\n" << R"(  "disable-hostname-validation": )" << _disable_hostname_validation.value();
     }
+    if (_enable_kernel_tls_offload.has_value()) {
+        os << ",\n" << R"(  "enable-kernel-tls-offload": )" << _enable_kernel_tls_offload.value();
+    }
     if (_flipper_the_dolphin.has_value()) {
         os << ",\n" << R"(  "flipper-the-dolphin": )" << _flipper_the_dolphin.value();
     }
@@ -317,6 +323,19 @@ TEST_F(TransportSecurityOptionsTest, hostname_validation_can_be_explicitly_enabl
     EXPECT_FALSE(read_options_from_json_string(json)->disable_hostname_validation());
 }
 
+TEST_F(TransportSecurityOptionsTest, kernel_tls_offload_is_disabled_by_default)
+{
+    auto json = ConfigWriter().write();
+    EXPECT_FALSE(read_options_from_json_string(json)->enable_kernel_tls_offload());
+}
+
+TEST_F(TransportSecurityOptionsTest, kernel_tls_offload_can_be_explicitly_enabled)
+{
+    auto json = ConfigWriter().enable_kernel_tls_offload("true").write();
+    EXPECT_TRUE(read_options_from_json_string(json)->enable_kernel_tls_offload());
+    EXPECT_TRUE(read_options_from_json_string(json)->copy_without_private_key().enable_kernel_tls_offload());
+}
+
 TEST_F(TransportSecurityOptionsTest, unknown_fields_are_ignored_at_parse_time)
 {
     auto json = ConfigWriter().flipper_the_dolphin(R"("*weird dolphin noises*")").write();
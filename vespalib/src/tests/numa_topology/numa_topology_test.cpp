@@ -0,0 +1,108 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/util/numa_thread_bundle_pool.h>
+#include <vespa/vespalib/util/numa_topology.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using vespalib::NumaThreadBundlePool;
+using vespalib::NumaTopology;
+using vespalib::Runnable;
+
+using CpuList = std::vector<uint32_t>;
+using Nodes = std::vector<CpuList>;
+
+struct NodeDir {
+    std::filesystem::path path;
+    NodeDir() : path("numa_topology_test_nodes") {
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+    }
+    ~NodeDir() { std::filesystem::remove_all(path); }
+    void add(const std::string &name, const std::string &cpulist) {
+        std::filesystem::create_directories(path / name);
+        std::ofstream(path / name / "cpulist") << cpulist << "\n";
+    }
+};
+
+TEST(NumaTopologyTest, cpu_lists_can_be_parsed) {
+    EXPECT_EQ(CpuList({0,1,2,3,8,10,11}), NumaTopology::parse_cpu_list("0-3,8,10-11\n"));
+    EXPECT_EQ(CpuList({5}), NumaTopology::parse_cpu_list("5"));
+    EXPECT_EQ(CpuList(), NumaTopology::parse_cpu_list(""));
+    EXPECT_EQ(CpuList(), NumaTopology::parse_cpu_list("3-1"));
+    EXPECT_EQ(CpuList(), NumaTopology::parse_cpu_list("0-x"));
+    EXPECT_EQ(CpuList(), NumaTopology::parse_cpu_list("1,,2"));
+}
+
+TEST(NumaTopologyTest, nodes_are_discovered_in_order_skipping_nodes_without_cpus) {
+    NodeDir dir;
+    dir.add("node1", "4-7");
+    dir.add("node0", "0-3");
+    dir.add("node2", "");
+    dir.add("nodeinfo", "8-9");
+    auto numa = NumaTopology::discover(dir.path.string());
+    ASSERT_EQ(2u, numa.num_nodes());
+    EXPECT_TRUE(numa.is_multi_node());
+    EXPECT_EQ(CpuList({0,1,2,3}), numa.cpus(0));
+    EXPECT_EQ(CpuList({4,5,6,7}), numa.cpus(1));
+}
+
+TEST(NumaTopologyTest, missing_topology_gives_single_node) {
+    auto numa = NumaTopology::discover("no_such_directory");
+    EXPECT_EQ(1u, numa.num_nodes());
+    EXPECT_FALSE(numa.is_multi_node());
+    EXPECT_FALSE(numa.pin_current_thread(0));
+}
+
+TEST(NumaTopologyTest, single_node_leaves_threads_alone) {
+    NumaTopology numa(Nodes{{0}});
+    size_t calls = 0;
+    Runnable::init_fun_t init = [&calls](Runnable &) { ++calls; return 1; };
+    auto pinned = numa.spread_over_nodes(init);
+    struct Nop : Runnable { void run() override {} } nop;
+    std::thread([&]{
+        pinned(nop);
+        EXPECT_EQ(NumaTopology::no_node, NumaTopology::current_node());
+    }).join();
+    EXPECT_EQ(1u, calls);
+}
+
+TEST(NumaTopologyTest, threads_are_spread_over_nodes) {
+    uint32_t cpu = 0; // any cpu we are allowed to run on will do for all nodes
+    NumaTopology numa(Nodes{{cpu}, {cpu}});
+    std::vector<uint32_t> nodes;
+    Runnable::init_fun_t init = [&nodes](Runnable &) { nodes.push_back(NumaTopology::current_node()); return 1; };
+    auto spread = numa.spread_over_nodes(init);
+    struct Nop : Runnable { void run() override {} } nop;
+    for (int i = 0; i < 3; ++i) {
+        std::thread([&]{ spread(nop); }).join();
+    }
+    if (nodes[0] == NumaTopology::no_node) {
+        GTEST_SKIP() << "not allowed to set cpu affinity";
+    }
+    EXPECT_EQ(std::vector<uint32_t>({0, 1, 0}), nodes);
+}
+
+TEST(NumaTopologyTest, bundles_are_taken_from_pool_of_calling_thread_node) {
+    NumaTopology numa(Nodes{{0}, {0}});
+    NumaThreadBundlePool pools(2, Runnable::default_init_function, numa);
+    EXPECT_EQ(2u, pools.num_pools());
+    auto *first = &pools.pool();
+    auto *second = &pools.pool();
+    EXPECT_NE(first, second); // not pinned, round robin
+    vespalib::SimpleThreadBundle::Pool *node1 = nullptr;
+    std::thread([&]{
+        if (numa.pin_current_thread(1)) {
+            node1 = &pools.pool();
+            EXPECT_EQ(node1, &pools.pool());
+        }
+    }).join();
+    if (node1 == nullptr) {
+        GTEST_SKIP() << "not allowed to set cpu affinity";
+    }
+    EXPECT_EQ(2u, node1->getBundle().bundle().size());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
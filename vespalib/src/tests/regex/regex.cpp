@@ -18,13 +18,17 @@ TEST(RegExTest, require_that_prefix_detection_works) {
     EXPECT_EQ("fo", RegexpUtil::get_prefix("^foo*"));
     EXPECT_EQ("fo", RegexpUtil::get_prefix("^foo?"));
     EXPECT_EQ("foo", RegexpUtil::get_prefix("^foo+"));
+    EXPECT_EQ("foo", RegexpUtil::get_prefix("^foo(bar|baz)"));
+    EXPECT_EQ("foo.", RegexpUtil::get_prefix("^foo\\."));
+    EXPECT_EQ("foo", RegexpUtil::get_prefix("^foo\\.?"));
+    EXPECT_EQ("foo", RegexpUtil::get_prefix("^foo[|]"));
+    EXPECT_EQ("bl", RegexpUtil::get_prefix("^blå?"));
 }
 
 TEST(RegExTest, require_that_prefix_detection_sometimes_underestimates_the_prefix_size) {
     EXPECT_EQ("", RegexpUtil::get_prefix("^^foo"));
-    EXPECT_EQ("", RegexpUtil::get_prefix("^foo(bar|baz)"));
     EXPECT_EQ("fo", RegexpUtil::get_prefix("^foo{1,2}"));
-    EXPECT_EQ("foo", RegexpUtil::get_prefix("^foo\\."));
+    EXPECT_EQ("foo", RegexpUtil::get_prefix("^foo\\d"));
     EXPECT_EQ("foo", RegexpUtil::get_prefix("^foo(bar)"));
     EXPECT_EQ("", RegexpUtil::get_prefix("(^foo)"));
     EXPECT_EQ("", RegexpUtil::get_prefix("^(foo)"));
@@ -32,6 +36,71 @@ TEST(RegExTest, require_that_prefix_detection_sometimes_underestimates_the_prefi
     EXPECT_EQ("", RegexpUtil::get_prefix("^foo|^foobar"));
 }
 
+TEST(RegExTest, require_that_required_literal_detection_works) {
+    EXPECT_EQ("", RegexpUtil::get_required_literal(""));
+    EXPECT_EQ("foo", RegexpUtil::get_required_literal("foo"));
+    EXPECT_EQ("foo", RegexpUtil::get_required_literal("^foo$"));
+    EXPECT_EQ("hello", RegexpUtil::get_required_literal("a.hello.*b"));
+    EXPECT_EQ(" world", RegexpUtil::get_required_literal("^hel(lo|p)? world"));
+    EXPECT_EQ("hell", RegexpUtil::get_required_literal("hello?"));
+    EXPECT_EQ("hello", RegexpUtil::get_required_literal("hello+"));
+    EXPECT_EQ("ab", RegexpUtil::get_required_literal("abc{0,3}de"));
+    EXPECT_EQ("foo.bar", RegexpUtil::get_required_literal("\\d+foo\\.bar\\s"));
+    EXPECT_EQ("foo", RegexpUtil::get_required_literal("[a-z]+foo[^]x]"));
+    EXPECT_EQ("blåbær", RegexpUtil::get_required_literal("blåbær"));
+    EXPECT_EQ("bl", RegexpUtil::get_required_literal("blå*"));
+}
+
+TEST(RegExTest, require_that_required_literal_is_not_detected_when_unsafe) {
+    EXPECT_EQ("", RegexpUtil::get_required_literal("foo|bar"));
+    EXPECT_EQ("", RegexpUtil::get_required_literal("(?i)foo"));
+    EXPECT_EQ("", RegexpUtil::get_required_literal("\\x{41}foo"));
+    EXPECT_EQ("", RegexpUtil::get_required_literal("\\pLfoo"));
+    EXPECT_EQ("", RegexpUtil::get_required_literal("(foo)"));
+    EXPECT_EQ("", RegexpUtil::get_required_literal("(foo)*"));
+    EXPECT_EQ("", RegexpUtil::get_required_literal("f*"));
+}
+
+TEST(RegExTest, required_literal_is_used_as_prefilter) {
+    auto re = Regex::from_pattern("^a.*needle[0-9]");
+    EXPECT_EQ("needle", re.required_literal());
+    EXPECT_FALSE(re.may_match("a haystack"));
+    EXPECT_TRUE(re.may_match("a needle"));
+    EXPECT_FALSE(re.partial_match("a needle"));
+    EXPECT_TRUE(re.partial_match("a needle7"));
+    auto uncased = Regex::from_pattern("NeeDle", Regex::Options::IgnoreCase);
+    EXPECT_EQ("needle", uncased.required_literal());
+    EXPECT_TRUE(uncased.partial_match("a long haystack with a NEEDLE in it"));
+    EXPECT_FALSE(uncased.may_match("a long haystack with a NEED LE in it"));
+    auto non_ascii = Regex::from_pattern("blåbær", Regex::Options::IgnoreCase);
+    EXPECT_EQ("", non_ascii.required_literal());
+    EXPECT_TRUE(non_ascii.partial_match("BLÅBÆR"));
+}
+
+TEST(RegExTest, uncased_prefilter_does_not_reject_non_ascii_case_folding) {
+    auto re = Regex::from_pattern("kelvin", Regex::Options::IgnoreCase);
+    EXPECT_TRUE(re.partial_match("\u212Aelvin")); // KELVIN SIGN folds to 'k'
+    EXPECT_FALSE(re.partial_match("felvin"));
+}
+
+TEST(RegExTest, prefilter_does_not_change_match_results) {
+    std::vector<std::string> patterns = {"abc", "a.c", "ab+c", "ab?c", "x(ab|cd)y", "[a-c]bca", "^ab", "bc$",
+                                         "a\\.b", "a{2}b", "(ab)+c", "abc|cba", "\\bab"};
+    std::vector<std::string> inputs = {"", "a", "abc", "xaby", "xcdy", "aabbcc", "a.b", "aab", "bca", "abab",
+                                       "ababc", "cba", "ABC", "xABy", "0123456789abcdef0123", "ab ab abc abcabc"};
+    for (const auto& pattern : patterns) {
+        for (uint32_t opts : {uint32_t(Regex::Options::None), uint32_t(Regex::Options::IgnoreCase)}) {
+            auto re = Regex::from_pattern(pattern, opts);
+            ASSERT_TRUE(re.parsed_ok());
+            auto reference = (opts == Regex::Options::None) ? pattern : "(?i)" + pattern;
+            for (const auto& input : inputs) {
+                EXPECT_EQ(Regex::partial_match(input, reference), re.partial_match(input)) << pattern << " ~ " << input;
+                EXPECT_EQ(Regex::full_match(input, reference), re.full_match(input)) << pattern << " ~ " << input;
+            }
+        }
+    }
+}
+
 const std::string special("^|()[]{}.*?+\\$");
 
 struct ExprFixture {
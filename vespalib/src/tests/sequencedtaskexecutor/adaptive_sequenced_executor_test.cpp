@@ -2,6 +2,7 @@
 
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/adaptive_sequenced_executor.h>
+#include <vespa/vespalib/util/gate.h>
 
 #include <condition_variable>
 #include <unistd.h>
@@ -251,6 +252,41 @@ TEST(AdaptiveSequencedExecutorTest, require_that_you_distribute_well) {
     }
 }
 
+TEST(AdaptiveSequencedExecutorTest, require_that_ids_per_strand_multiplies_number_of_executors) {
+    AdaptiveSequencedExecutor executor(7, 1, 0, 10, true, 3);
+    EXPECT_EQ(21u, executor.getNumExecutors());
+    EXPECT_EQ(20u, executor.getExecutorId(20).getId());
+    EXPECT_EQ(0u, executor.getExecutorId(21).getId());
+}
+
+TEST(AdaptiveSequencedExecutorTest, require_that_id_is_moved_away_from_strand_busy_with_other_id) {
+    // ids 0 and 2 start out sharing strand 0; a single thread makes the interleaving deterministic
+    AdaptiveSequencedExecutor executor(2, 1, 0, 1000, true, 2);
+    ISequencedTaskExecutor::ExecutorId hot(0);
+    ISequencedTaskExecutor::ExecutorId cold(2);
+    Gate hot_started;
+    Gate hot_blocked;
+    std::vector<int> res;
+    executor.executeLambda(hot, [&]() { hot_started.countDown(); hot_blocked.await(); res.push_back(1); });
+    hot_started.await();
+    executor.executeLambda(hot, [&]() { res.push_back(2); });
+    executor.executeLambda(hot, [&]() { res.push_back(3); });
+    executor.executeLambda(cold, [&]() { res.push_back(11); });
+    executor.executeLambda(cold, [&]() { res.push_back(12); });
+    hot_blocked.countDown();
+    executor.sync_all();
+    // the cold id does not queue behind the hot id, and each id keeps its own order
+    EXPECT_EQ(std::vector<int>({1, 11, 2, 12, 3}), res);
+    EXPECT_EQ(1u, executor.get_moved_ids());
+    auto stats = executor.get_strand_stats();
+    ASSERT_EQ(2u, stats.size());
+    EXPECT_EQ(3u, stats[0].accepted_tasks);
+    EXPECT_EQ(2u, stats[1].accepted_tasks);
+    EXPECT_EQ(2u, stats[0].max_queue_size);
+    EXPECT_EQ(0u, stats[0].queue_size);
+    EXPECT_EQ(0u, executor.get_strand_stats()[1].accepted_tasks);
+}
+
 }
 
 GTEST_MAIN_RUN_ALL_TESTS()
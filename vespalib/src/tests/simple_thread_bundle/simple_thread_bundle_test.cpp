@@ -80,6 +80,35 @@ TEST(SimpleThreadBundleTest, require_that_signals_can_be_counted_and_cancelled)
     Nexus::run(num_threads, task);
 }
 
+TEST(SimpleThreadBundleTest, require_that_spinning_signals_can_be_counted_and_cancelled) {
+    size_t num_threads = 2;
+    Signal f1;
+    size_t f2 = 16000;
+    auto task = [&](Nexus &ctx){
+                    if (ctx.thread_id() == 0) {
+                        for (size_t i = 0; i < f2; ++i) {
+                            f1.send();
+                            if (i % 128 == 0) { std::this_thread::sleep_for(1ms); }
+                        }
+                        ctx.barrier();
+                        f1.cancel();
+                    } else {
+                        size_t localGen = 0;
+                        size_t diffSum = 0;
+                        while (localGen < f2) {
+                            size_t diff = f1.wait(localGen, 100us);
+                            EXPECT_GT(diff, 0u);
+                            diffSum += diff;
+                        }
+                        EXPECT_EQ(f2, diffSum);
+                        ctx.barrier();
+                        EXPECT_EQ(0u, f1.wait(localGen, 100us));
+                        EXPECT_EQ(f2 + 1, localGen);
+                    }
+                };
+    Nexus::run(num_threads, task);
+}
+
 TEST(SimpleThreadBundleTest, require_that_bundles_of_size_0_cannot_be_created) {
     VESPA_EXPECT_EXCEPTION(SimpleThreadBundle(0), IllegalArgumentException, "");
 }
@@ -184,6 +213,22 @@ TEST(SimpleThreadBundleTest, require_that_all_strategies_work_with_variable_numb
     }
 }
 
+TEST(SimpleThreadBundleTest, require_that_all_strategies_work_with_spinning_threads) {
+    std::vector<SimpleThreadBundle::Strategy> strategies
+        = make_box(SimpleThreadBundle::USE_SIGNAL_LIST,
+                   SimpleThreadBundle::USE_SIGNAL_TREE,
+                   SimpleThreadBundle::USE_BROADCAST);
+    for (auto strategy : strategies) {
+        State state(4);
+        SimpleThreadBundle threadBundle(4, Runnable::default_init_function, strategy, 1ms);
+        for (size_t i = 0; i < 100; ++i) {
+            threadBundle.run(state.getTargets(4));
+            if (i % 10 == 0) { std::this_thread::sleep_for(2ms); } // let the workers park
+        }
+        ASSERT_NO_FATAL_FAILURE(state.check({100, 100, 100, 100})) << "strategy: " << strategy;
+    }
+}
+
 TEST(SimpleThreadBundleTest, require_that_bundle_pool_gives_out_bundles) {
     SimpleThreadBundle::Pool f1(5);
     auto b1 = f1.getBundle();
@@ -2,6 +2,7 @@
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/stash.h>
+#include <vespa/vespalib/util/stash_chunk_pool.h>
 #include <vespa/vespalib/util/traits.h>
 
 using namespace vespalib;
@@ -471,4 +472,44 @@ TEST(StashTest, require_that_uninitialized_arrays_can_be_created) {
     EXPECT_EQ(sum({chunk_header_size(), sizeof(float) * 64}), stash.count_used());
 }
 
+TEST(StashTest, require_that_chunk_pool_recycles_a_bounded_number_of_chunks) {
+    StashChunkPool pool(4_Ki, 2);
+    EXPECT_EQ(4_Ki, pool.chunk_size());
+    void *a = pool.alloc();
+    void *b = pool.alloc();
+    void *c = pool.alloc();
+    EXPECT_EQ(0u, pool.cached_chunks());
+    pool.release(a);
+    pool.release(b);
+    pool.release(c); // pool is full; freed
+    EXPECT_EQ(2u, pool.cached_chunks());
+    void *d = pool.alloc();
+    EXPECT_TRUE(d == a || d == b);
+    EXPECT_EQ(1u, pool.cached_chunks());
+    pool.release(d);
+}
+
+TEST(StashTest, require_that_pooled_stash_takes_chunks_from_and_gives_them_back_to_the_pool) {
+    StashChunkPool pool(4_Ki, 8);
+    size_t destructed = 0;
+    {
+        Stash stash(pool);
+        EXPECT_EQ(4_Ki, stash.get_chunk_size());
+        for (size_t i = 0; i < 12; ++i) {
+            stash.alloc(1000); // 4 allocations per chunk
+        }
+        EXPECT_EQ(0u, pool.cached_chunks());
+        EXPECT_EQ(3u * 4_Ki, stash.get_memory_usage().allocatedBytes());
+        stash.clear();
+        EXPECT_EQ(2u, pool.cached_chunks()); // one chunk is kept
+        Stash other(std::move(stash));
+        other.create<SmallObject>(destructed);
+    }
+    EXPECT_EQ(1u, destructed);
+    EXPECT_EQ(3u, pool.cached_chunks());
+    Stash reused(pool);
+    reused.alloc(8);
+    EXPECT_EQ(2u, pool.cached_chunks());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -257,6 +257,19 @@ TEST(StateServerTest, require_that_the_state_server_exposes_the_state_api_handle
     EXPECT_EQ(page3, page1);
 }
 
+TEST(StateServerTest, require_that_the_state_server_serves_cpu_profiles)
+{
+    SimpleHealthProducer f1;
+    SimpleMetricsProducer f2;
+    SimpleComponentConfigProducer f3;
+    StateServer f4(0, f1, f2, f3);
+    int port = f4.getListenPort();
+    EXPECT_TRUE(getPage(port, root_path).find("/state/v1/profile\"}") != std::string::npos);
+    std::string profile = getFull(port, "/state/v1/profile?seconds=0.1&frequency=997&tag=category");
+    EXPECT_TRUE(profile.find("HTTP/1.1 200 OK") == 0);
+    EXPECT_TRUE(profile.find("Content-Type: text/plain") != std::string::npos);
+}
+
 //-----------------------------------------------------------------------------
 
 TEST(StateServerTest, require_that_json_handlers_can_be_removed_from_repo)
@@ -6,6 +6,9 @@
 #include <vespa/vespalib/stllike/identity.h>
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/stllike/hash_map_equal.hpp>
+#include <vespa/vespalib/stllike/hash_set.hpp>
+#include <vespa/vespalib/stllike/swiss_hashtable.hpp>
 
 using vespalib::hashtable;
 using std::vector;
@@ -222,6 +225,94 @@ TEST(HashtableTest, benchmark_hash_table_reconstruction_with_non_POD_objects) {
     EXPECT_EQ(NUM_ITER, NonPOD::destruction_count);
 }
 
+template<typename K> using up_swiss_hashtable =
+    swiss_hashtable<K, std::unique_ptr<K>,
+                    vespalib::hash<K>, std::equal_to<K>, Dereference<K>>;
+
+TEST(HashtableTest, require_that_swiss_hashtable_can_store_unique_ptrs) {
+    up_swiss_hashtable<int> table(100);
+    EXPECT_TRUE(table.insert(std::make_unique<int>(42)).second);
+    EXPECT_FALSE(table.insert(std::make_unique<int>(42)).second);
+    auto it = table.find(42);
+    ASSERT_TRUE(it != table.end());
+    EXPECT_EQ(42, **it);
+    EXPECT_TRUE(table.find(43) == table.end());
+    up_swiss_hashtable<int> moved(std::move(table));
+    EXPECT_EQ(42, **moved.find(42));
+}
+
+TEST(HashtableTest, require_that_swiss_hashtable_grows_and_reuses_erased_slots) {
+    using Table = swiss_hashtable<uint32_t, uint32_t, vespalib::hash<uint32_t>, std::equal_to<>, Identity>;
+    Table table(0);
+    EXPECT_EQ(16u, table.capacity());
+    for (uint32_t i = 0; i < 10000; ++i) {
+        EXPECT_TRUE(table.insert(i).second);
+    }
+    EXPECT_EQ(10000u, table.size());
+    EXPECT_EQ(16384u, table.capacity());
+    for (uint32_t i = 0; i < 10000; i += 2) {
+        table.erase(i);
+    }
+    EXPECT_EQ(5000u, table.size());
+    for (uint32_t i = 0; i < 10000; ++i) {
+        EXPECT_EQ((i % 2) == 1, table.find(i) != table.end());
+    }
+    // churn does not grow the table beyond what the live elements need
+    for (uint32_t i = 0; i < 100000; ++i) {
+        table.insert(20000 + i);
+        table.erase(20000 + i);
+    }
+    EXPECT_EQ(5000u, table.size());
+    EXPECT_EQ(16384u, table.capacity());
+    size_t sum = 0;
+    table.for_each([&sum](uint32_t v) { sum += v; });
+    EXPECT_EQ(25000000u, sum);
+    Table copy(table);
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    EXPECT_TRUE(table.begin() == table.end());
+    EXPECT_EQ(5000u, copy.size());
+    EXPECT_EQ(5000u, std::distance(copy.begin(), copy.end()));
+    EXPECT_TRUE(copy.find(9999) != copy.end());
+}
+
+TEST(HashtableTest, require_that_swiss_hashtable_supports_duplicates_with_force_insert) {
+    using Pair = std::pair<int, std::string>;
+    using Map = swiss_hashtable<int, Pair, vespalib::hash<int>, std::equal_to<>, Select1st<Pair>>;
+    Map m(1);
+    m.force_insert(Pair(1, "1"));
+    m.force_insert(Pair(1, "1.2"));
+    EXPECT_EQ(2u, m.size());
+    EXPECT_FALSE(m.insert(Pair(1, "1.3")).second);
+    m.erase(1);
+    EXPECT_EQ(1u, m.size());
+    ASSERT_TRUE(m.find(1) != m.end());
+    m.erase(1);
+    EXPECT_TRUE(m.find(1) == m.end());
+}
+
+TEST(HashtableTest, require_that_hash_map_and_hash_set_can_use_open_addressing) {
+    using Map = vespalib::hash_map<std::string, int, vespalib::hash<std::string>, std::equal_to<>, hashtable_base::open_addressing>;
+    using Set = vespalib::hash_set<int, vespalib::hash<int>, std::equal_to<>, hashtable_base::open_addressing>;
+    static_assert(std::is_same_v<Map::HashTable, swiss_hashtable<std::string, std::pair<std::string, int>, vespalib::hash<std::string>, std::equal_to<>, Select1st<std::pair<std::string, int>>>>);
+    Map map;
+    map["foo"] = 1;
+    map["bar"] = 2;
+    map["foo"] += 10;
+    EXPECT_EQ(2u, map.size());
+    EXPECT_EQ(11, map["foo"]);
+    EXPECT_TRUE(map.contains("bar"));
+    EXPECT_FALSE(map.contains("baz"));
+    Map other(map);
+    EXPECT_TRUE(map == other);
+    map.erase("bar");
+    EXPECT_FALSE(map == other);
+    Set set({1, 2, 3, 2});
+    EXPECT_EQ(3u, set.size());
+    EXPECT_TRUE(set.contains(3));
+    EXPECT_FALSE(set.contains(4));
+}
+
 }  // namespace
 
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -94,6 +94,18 @@ size_t benchHashMapVespaLib2(size_t sz, size_t numLookups)
     return benchM(set, sz, numLookups);
 }
 
+size_t benchHashVespaLibOpen(size_t sz, size_t numLookups)
+{
+    vespalib::hash_set<uint32_t, vespalib::hash<uint32_t>, std::equal_to<uint32_t>, vespalib::hashtable_base::open_addressing > set(sz);
+    return bench(set, sz, numLookups);
+}
+
+size_t benchHashMapVespaLibOpen(size_t sz, size_t numLookups)
+{
+    vespalib::hash_map<uint32_t, uint32_t, vespalib::hash<uint32_t>, std::equal_to<uint32_t>, vespalib::hashtable_base::open_addressing > set(sz);
+    return benchM(set, sz, numLookups);
+}
+
 std::unique_ptr<char []> createData(size_t sz) {
     auto data = std::make_unique<char []>(sz);
     for (size_t i(0); i < sz; i++) {
@@ -150,6 +162,8 @@ int main(int argc, char *argv[])
     description['G'] = "vespalib::hash_set with simple and modulator.";
     description['k'] = "vespalib::hash_map";
     description['K'] = "vespalib::hash_map with simple and modulator.";
+    description['s'] = "vespalib::hash_set with open addressing.";
+    description['S'] = "vespalib::hash_map with open addressing.";
     description['x'] = "xxhash32";
     description['X'] = "xxhash64";
     description['l'] = "legacy";
@@ -161,11 +175,13 @@ int main(int argc, char *argv[])
         case 'G': found = benchHashVespaLib2(count, rep); break;
         case 'k': found = benchHashMapVespaLib(count, rep); break;
         case 'K': found = benchHashMapVespaLib2(count, rep); break;
+        case 's': found = benchHashVespaLibOpen(count, rep); break;
+        case 'S': found = benchHashMapVespaLibOpen(count, rep); break;
         case 'x': found = benchXXHash32(count, rep); break;
         case 'X': found = benchXXHash64(count, rep); break;
         case 'l': found = benchLegacyHash(count, rep); break;
         default:
-            for (char c : "mhgGkKxXl") {
+            for (char c : "mhgGkKsSxXl") {
                 printf("'%c' = %s\n", c, description[c]);
             }
             return 1;
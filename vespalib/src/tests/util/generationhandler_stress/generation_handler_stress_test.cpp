@@ -5,6 +5,7 @@
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/util/time.h>
 #include <thread>
 #include <cinttypes>
 
@@ -65,7 +66,7 @@ IndirectContext::IndirectContext() noexcept
 
 class Fixture : public ::testing::Test {
 protected:
-    GenerationHandler _generationHandler;
+    std::unique_ptr<GenerationHandler> _generationHandler;
     uint32_t _readThreads;
     ThreadStackExecutor _writer; // 1 write thread
     std::unique_ptr<ThreadStackExecutor> _readers; // multiple reader threads
@@ -79,10 +80,12 @@ protected:
     ~Fixture();
 
     void set_read_threads(uint32_t read_threads);
+    void set_shards(uint32_t shards) { _generationHandler = std::make_unique<GenerationHandler>(shards); }
 
     uint32_t getReadThreads() const { return _readThreads; }
     void stressTest(uint32_t writeCnt);
     void stress_test_indirect(uint64_t write_cnt);
+    void benchmark_guards(uint64_t guard_cnt);
 public:
     void readWork(const WorkContext &context);
     void writeWork(uint32_t cnt, WorkContext &context);
@@ -98,7 +101,7 @@ private:
 
 Fixture::Fixture()
     : ::testing::Test(),
-      _generationHandler(),
+      _generationHandler(std::make_unique<GenerationHandler>()),
       _readThreads(1),
       _writer(1),
       _readers(),
@@ -144,7 +147,7 @@ Fixture::readWork(const WorkContext &context)
     uint32_t cnt = std::numeric_limits<uint32_t>::max();
 
     for (i = 0; i < cnt && !_stopRead.load(); ++i) {
-        auto guard = _generationHandler.takeGuard();
+        auto guard = _generationHandler->takeGuard();
         auto generation = context._generation.load(std::memory_order_relaxed);
         EXPECT_GE(generation, guard.getGeneration());
     }
@@ -158,8 +161,8 @@ Fixture::writeWork(uint32_t cnt, WorkContext &context)
 {
     ReadStopper read_stopper(_stopRead);
     for (uint32_t i = 0; i < cnt; ++i) {
-        context._generation.store(_generationHandler.getNextGeneration(), std::memory_order_relaxed);
-        _generationHandler.incGeneration();
+        context._generation.store(_generationHandler->getNextGeneration(), std::memory_order_relaxed);
+        _generationHandler->incGeneration();
     }
     _doneWriteWork += cnt;
     LOG(info, "done %u write work", cnt);
@@ -224,7 +227,7 @@ Fixture::read_indirect_work(const IndirectContext& context)
     uint64_t cnt = std::numeric_limits<uint32_t>::max();
     uint64_t old_value = 0;
     for (i = 0; i < cnt && !_stopRead.load(); ++i) {
-        auto guard = _generationHandler.takeGuard();
+        auto guard = _generationHandler->takeGuard();
         // Data referenced by pointer is protected by guard
         auto v_ptr = context._value_ptr.load(std::memory_order_acquire);
         EXPECT_GE(*v_ptr, old_value);
@@ -240,18 +243,18 @@ Fixture::write_indirect_work(uint64_t cnt, IndirectContext& context)
 {
     ReadStopper read_stopper(_stopRead);
     uint32_t sleep_cnt = 0;
-    ASSERT_EQ(0, _generationHandler.getCurrentGeneration());
-    auto oldest_gen = _generationHandler.get_oldest_used_generation();
+    ASSERT_EQ(0, _generationHandler->getCurrentGeneration());
+    auto oldest_gen = _generationHandler->get_oldest_used_generation();
     for (uint64_t i = 0; i < cnt; ++i) {
-        auto gen = _generationHandler.getCurrentGeneration();
+        auto gen = _generationHandler->getCurrentGeneration();
         // Hold data for gen, write new data for next_gen
         auto next_gen = gen + 1;
         auto *v_ptr = context.calc_value_ptr(next_gen);
         ASSERT_EQ(0u, *v_ptr);
         *v_ptr = next_gen;
         context._value_ptr.store(v_ptr, std::memory_order_release);
-        _generationHandler.incGeneration();
-        auto first_used_gen = _generationHandler.get_oldest_used_generation();
+        _generationHandler->incGeneration();
+        auto first_used_gen = _generationHandler->get_oldest_used_generation();
         while (oldest_gen < first_used_gen) {
             // Clear data that readers should no longer have access to.
             *context.calc_value_ptr(oldest_gen) = 0;
@@ -261,8 +264,8 @@ Fixture::write_indirect_work(uint64_t cnt, IndirectContext& context)
             // Sleep if writer gets too much ahead of readers.
             std::this_thread::sleep_for(1ms);
             ++sleep_cnt;
-            _generationHandler.update_oldest_used_generation();
-            first_used_gen = _generationHandler.get_oldest_used_generation();
+            _generationHandler->update_oldest_used_generation();
+            first_used_gen = _generationHandler->get_oldest_used_generation();
         }
     }
     _doneWriteWork += cnt;
@@ -284,6 +287,25 @@ Fixture::stress_test_indirect(uint64_t write_cnt)
     _readers->sync();
 }
 
+void
+Fixture::benchmark_guards(uint64_t guard_cnt)
+{
+    uint32_t read_threads = getReadThreads();
+    vespalib::Timer timer;
+    for (uint32_t i = 0; i < read_threads; ++i) {
+        _readers->execute(makeLambdaTask([this, guard_cnt]() {
+            for (uint64_t j = 0; j < guard_cnt; ++j) {
+                auto guard = _generationHandler->takeGuard();
+            }
+        }));
+    }
+    _readers->sync();
+    double elapsed_s = vespalib::to_s(timer.elapsed());
+    LOG(info, "%u read threads took %" PRIu64 " guards each in %6.3f s, %6.1f ns per guard per thread",
+        read_threads, guard_cnt, elapsed_s, elapsed_s * 1e9 / guard_cnt);
+    EXPECT_EQ(0u, _generationHandler->getGenerationRefCount());
+}
+
 using GenerationHandlerStressTest = Fixture;
 
 TEST_F(GenerationHandlerStressTest, stress_test_2_readers)
@@ -310,6 +332,33 @@ TEST_F(GenerationHandlerStressTest, stress_test_indirect_4_readers)
     stress_test_indirect(smoke_test ? 10000 : 1000000);
 }
 
+TEST_F(GenerationHandlerStressTest, stress_test_sharded_4_readers)
+{
+    set_shards(4);
+    set_read_threads(4);
+    stressTest(smoke_test ? 10000 : 1000000);
+}
+
+TEST_F(GenerationHandlerStressTest, stress_test_indirect_sharded_4_readers)
+{
+    set_shards(4);
+    set_read_threads(4);
+    stress_test_indirect(smoke_test ? 10000 : 1000000);
+}
+
+TEST_F(GenerationHandlerStressTest, benchmark_guards_shared_refcount)
+{
+    set_read_threads(std::max(4u, std::thread::hardware_concurrency()));
+    benchmark_guards(smoke_test ? 10000 : 10000000);
+}
+
+TEST_F(GenerationHandlerStressTest, benchmark_guards_sharded_refcount)
+{
+    set_shards(GenerationHandler::sharded());
+    set_read_threads(std::max(4u, std::thread::hardware_concurrency()));
+    benchmark_guards(smoke_test ? 10000 : 10000000);
+}
+
 int main(int argc, char **argv) {
     if (argc > 1 && argv[1] == smoke_test_option) {
         smoke_test = true;
@@ -3,6 +3,8 @@
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/generationhandler.h>
 #include <deque>
+#include <thread>
+#include <vector>
 
 namespace vespalib {
 
@@ -132,4 +134,28 @@ TEST_F(GenerationHandlerTest, require_that_generation_can_grow_large)
     }
 }
 
+TEST(ShardedGenerationHandlerTest, require_that_guards_from_many_threads_are_counted)
+{
+    GenerationHandler gh(4);
+    std::vector<GenGuard> guards(8);
+    std::vector<std::thread> threads;
+    for (auto &guard : guards) {
+        threads.emplace_back([&gh, &guard]() { guard = gh.takeGuard(); });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(8u, gh.getGenerationRefCount(0));
+    gh.incGeneration();
+    GenGuard copy(guards[3]);
+    EXPECT_EQ(9u, gh.getGenerationRefCount(0));
+    guards.clear();
+    gh.update_oldest_used_generation();
+    EXPECT_EQ(0u, gh.get_oldest_used_generation());
+    copy = GenGuard();
+    gh.update_oldest_used_generation();
+    EXPECT_EQ(0u, gh.getGenerationRefCount());
+    EXPECT_EQ(1u, gh.get_oldest_used_generation());
+}
+
 }
@@ -67,6 +67,14 @@ TEST(MiMallocErrorHandlerDeathTest, mimalloc_unknown_errno_aborts_with_unknown_e
                 R"(mimalloc has reported an invariant violation: \(unknown error\) \(errno .+\))");
 }
 
+TEST(MiMallocAllocationSamplingTest, sample_interval_can_only_be_set_when_mimalloc_is_present) {
+    bool present = is_mi_malloc_present();
+    EXPECT_EQ(set_mi_malloc_allocation_sample_interval(10), present);
+    EXPECT_EQ(mi_malloc_allocation_sample_interval(), present ? 10u : 0u);
+    EXPECT_EQ(set_mi_malloc_allocation_sample_interval(0), present);
+    EXPECT_EQ(mi_malloc_allocation_sample_interval(), 0u);
+}
+
 } // ns vespalib
 
 int main(int argc, char* argv[]) {
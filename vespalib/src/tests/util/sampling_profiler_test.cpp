@@ -0,0 +1,89 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/util/cpu_usage.h>
+#include <vespa/vespalib/util/sampling_profiler.h>
+#include <vespa/vespalib/util/time.h>
+#include <sstream>
+
+using vespalib::CpuUsage;
+using vespalib::SamplingProfiler;
+
+namespace {
+
+double __attribute__((noinline)) burn_cpu(vespalib::duration how_long) {
+    double x = 1.0;
+    auto start = vespalib::cpu_usage::total_cpu_usage();
+    while ((vespalib::cpu_usage::total_cpu_usage() - start) < how_long) {
+        for (int i = 0; i < 10000; ++i) {
+            x = x * 1.000001 + 0.000001;
+        }
+    }
+    return x;
+}
+
+struct Folded {
+    size_t total = 0;
+    std::vector<std::string> stacks;
+};
+
+Folded parse(const std::string &folded) {
+    Folded result;
+    std::istringstream input(folded);
+    std::string line;
+    while (std::getline(input, line)) {
+        auto pos = line.rfind(' ');
+        EXPECT_NE(pos, std::string::npos);
+        result.stacks.push_back(line.substr(0, pos));
+        result.total += std::stoul(line.substr(pos + 1));
+    }
+    return result;
+}
+
+}
+
+TEST(SamplingProfilerTest, samples_are_aggregated_into_folded_stacks) {
+    SamplingProfiler profiler(997, false);
+    ASSERT_TRUE(profiler.active());
+    EXPECT_GT(burn_cpu(200ms), 0.0);
+    auto result = profiler.stop();
+    EXPECT_FALSE(profiler.active());
+    EXPECT_GT(result.samples, 10u);
+    EXPECT_EQ(result.dropped, 0u);
+    auto folded = parse(result.folded);
+    EXPECT_EQ(folded.total, result.samples);
+    for (const auto &stack: folded.stacks) {
+        EXPECT_FALSE(stack.starts_with("other;"));
+    }
+}
+
+TEST(SamplingProfilerTest, samples_can_be_tagged_with_cpu_category) {
+    SamplingProfiler profiler(997, true);
+    ASSERT_TRUE(profiler.active());
+    {
+        auto usage = CpuUsage::use(CpuUsage::Category::READ);
+        EXPECT_GT(burn_cpu(200ms), 0.0);
+    }
+    auto folded = parse(profiler.stop().folded);
+    ASSERT_FALSE(folded.stacks.empty());
+    size_t read_stacks = 0;
+    for (const auto &stack: folded.stacks) {
+        if (stack.starts_with("read;")) {
+            ++read_stacks;
+        }
+    }
+    EXPECT_GT(read_stacks, 0u);
+}
+
+TEST(SamplingProfilerTest, only_one_profiler_can_be_active_at_a_time) {
+    SamplingProfiler first(99, false);
+    EXPECT_TRUE(first.active());
+    {
+        SamplingProfiler second(99, false);
+        EXPECT_FALSE(second.active());
+        EXPECT_EQ(second.stop().samples, 0u);
+    }
+    first.stop();
+    SamplingProfiler third(99, false);
+    EXPECT_TRUE(third.active());
+}
@@ -0,0 +1,114 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/util/tiered_memory_allocator.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <cstring>
+
+using vespalib::alloc::PtrAndSize;
+using vespalib::alloc::TieredMemoryAllocator;
+
+namespace {
+
+std::string basedir("tiered-memory-allocator-dir");
+
+void fill(PtrAndSize buf, char seed) {
+    auto* p = static_cast<char*>(buf.get());
+    for (size_t i = 0; i < buf.size(); ++i) {
+        p[i] = static_cast<char>(seed + i * 7);
+    }
+}
+
+bool check(PtrAndSize buf, char seed) {
+    auto* p = static_cast<const char*>(buf.get());
+    for (size_t i = 0; i < buf.size(); ++i) {
+        if (p[i] != static_cast<char>(seed + i * 7)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+class TieredMemoryAllocatorTest : public ::testing::Test
+{
+protected:
+    TieredMemoryAllocator _allocator;
+
+    TieredMemoryAllocatorTest()
+        : _allocator(basedir, TieredMemoryAllocator::Policy(3, 64_Ki))
+    {
+    }
+    ~TieredMemoryAllocatorTest() override;
+};
+
+TieredMemoryAllocatorTest::~TieredMemoryAllocatorTest() = default;
+
+TEST_F(TieredMemoryAllocatorTest, empty_allocation)
+{
+    auto buf = _allocator.alloc(0);
+    EXPECT_EQ(nullptr, buf.get());
+    EXPECT_EQ(0u, buf.size());
+    _allocator.free(buf);
+}
+
+TEST_F(TieredMemoryAllocatorTest, unchanged_allocation_is_migrated_to_file_and_back)
+{
+    auto buf = _allocator.alloc(200_Ki);
+    EXPECT_LE(200_Ki, buf.size());
+    fill(buf, 3);
+    _allocator.sample(buf, 42);
+    for (uint32_t i = 0; i < 3; ++i) {
+        EXPECT_FALSE(_allocator.is_cold(buf));
+        _allocator.sample(buf, 42);
+    }
+    EXPECT_TRUE(_allocator.is_cold(buf));
+    EXPECT_TRUE(check(buf, 3));
+    auto stats = _allocator.get_stats();
+    EXPECT_EQ(0u, stats.hot_allocations);
+    EXPECT_EQ(1u, stats.cold_allocations);
+    EXPECT_EQ(buf.size(), stats.cold_bytes);
+    EXPECT_EQ(1u, stats.demotions);
+    fill(buf, 5);
+    EXPECT_TRUE(check(buf, 5));
+    _allocator.sample(buf, 43);
+    EXPECT_FALSE(_allocator.is_cold(buf));
+    EXPECT_TRUE(check(buf, 5));
+    stats = _allocator.get_stats();
+    EXPECT_EQ(1u, stats.hot_allocations);
+    EXPECT_EQ(buf.size(), stats.hot_bytes);
+    EXPECT_EQ(0u, stats.cold_allocations);
+    EXPECT_EQ(1u, stats.promotions);
+    _allocator.free(buf);
+    stats = _allocator.get_stats();
+    EXPECT_EQ(0u, stats.hot_allocations);
+    EXPECT_EQ(0u, stats.hot_bytes);
+}
+
+TEST_F(TieredMemoryAllocatorTest, changed_or_small_allocations_stay_hot)
+{
+    auto buf = _allocator.alloc(200_Ki);
+    auto small_buf = _allocator.alloc(4_Ki);
+    for (uint32_t i = 0; i < 10; ++i) {
+        _allocator.sample(buf, i);
+        _allocator.sample(small_buf, 42);
+    }
+    EXPECT_FALSE(_allocator.is_cold(buf));
+    EXPECT_FALSE(_allocator.is_cold(small_buf));
+    EXPECT_EQ(2u, _allocator.get_stats().hot_allocations);
+    _allocator.free(buf);
+    _allocator.free(small_buf);
+}
+
+TEST_F(TieredMemoryAllocatorTest, cold_allocation_can_be_freed)
+{
+    auto buf = _allocator.alloc(200_Ki);
+    for (uint32_t i = 0; i < 4; ++i) {
+        _allocator.sample(buf, 0);
+    }
+    EXPECT_TRUE(_allocator.is_cold(buf));
+    _allocator.free(buf);
+    auto stats = _allocator.get_stats();
+    EXPECT_EQ(0u, stats.cold_allocations);
+    EXPECT_EQ(0u, stats.cold_bytes);
+}
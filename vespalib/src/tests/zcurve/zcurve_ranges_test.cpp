@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/geo/zcurve.h>
+#include <algorithm>
 #include <vector>
 #include <cinttypes>
 #include <format>
@@ -56,4 +57,43 @@ TEST(ZCurveRangesTest, require_that_silly_bounding_box_does_not_explode) {
     EXPECT_EQ(42u, ranges.size());
 }
 
+int64_t total_estimate(const Z::RangeVector &ranges) {
+    int64_t sum = 0;
+    for (auto range: ranges) {
+        sum += range.max() - range.min() + 1;
+    }
+    return sum;
+}
+
+TEST(ZCurveRangesTest, require_that_ranges_for_circle_contain_circle_but_less_of_bounding_box) {
+    for (int r: {1, 5, 13, 100}) {
+        for (int cx: {-r / 2, 0, 7}) {
+            int cy = 3;
+            auto in_circle = [=](int64_t x, int64_t y) {
+                return (x - cx) * (x - cx) + (y - cy) * (y - cy) <= int64_t(r) * r;
+            };
+            auto may_overlap = [=](int32_t min_x, int32_t min_y, int32_t max_x, int32_t max_y) {
+                return in_circle(std::clamp(cx, min_x, max_x), std::clamp(cy, min_y, max_y));
+            };
+            Z::RangeVector ranges = Z::find_ranges(cx - r, cy - r, cx + r, cy + r, may_overlap);
+            for (int x = cx - r; x <= cx + r; ++x) {
+                for (int y = cy - r; y <= cy + r; ++y) {
+                    if (in_circle(x, y)) {
+                        ASSERT_TRUE(inside(x, y, ranges)) << std::format("CIRCLE: ({}, {}) r {}", cx, cy, r);
+                    }
+                }
+            }
+            EXPECT_LE(ranges.size(), 42u);
+            if (r > 1) {
+                EXPECT_LT(total_estimate(ranges), total_estimate(Z::find_ranges(cx - r, cy - r, cx + r, cy + r)));
+            }
+        }
+    }
+}
+
+TEST(ZCurveRangesTest, require_that_shape_outside_bounding_box_gives_no_ranges) {
+    auto never = [](int32_t, int32_t, int32_t, int32_t) { return false; };
+    EXPECT_TRUE(Z::find_ranges(-10, -10, 10, 10, never).empty());
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -206,6 +206,12 @@ FastOS_FileInterface::IsMemoryMapped() const
     return false;
 }
 
+int
+FastOS_FileInterface::get_fd() const
+{
+    return -1;
+}
+
 const char *
 FastOS_FileInterface::GetFileName() const
 {
@@ -435,6 +435,13 @@ public:
      */
     virtual bool IsMemoryMapped() const;
 
+    /**
+     * Inquiry about the underlying file descriptor, used for async io.
+     * @return file descriptor, or -1 if the file is not open or has no
+     *         file descriptor.
+     */
+    virtual int get_fd() const;
+
     /**
      * Will drop whatever is in the FS cache when called. Does not have effect in the future.
      **/
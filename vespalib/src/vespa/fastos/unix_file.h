@@ -70,6 +70,7 @@ public:
     }
 
     bool IsMemoryMapped() const override { return _mmapbase != nullptr; }
+    int get_fd() const override { return _filedes; }
     bool SetPosition(int64_t desiredPosition) override;
     int64_t getPosition() const override;
     int64_t getSize() const override;
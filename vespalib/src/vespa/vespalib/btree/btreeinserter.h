@@ -36,6 +36,7 @@ public:
     using InternalNodeTypeRefPair = typename InternalNodeType::RefPair;
     using LeafNodeTypeRefPair = typename LeafNodeType::RefPair;
     using Inserter = BTreeInserter<KeyT, DataT, AggrT, CompareT, TraitsT, AggrCalcT>;
+    using KeyDataType = BTreeKeyData<KeyT, DataT>;
 
 private:
     static void rebalanceLeafEntries(LeafNodeType *leafNode, Iterator &itr, AggrCalcT aggrCalc);
@@ -43,6 +44,18 @@ private:
 public:
     static void
     insert(BTreeNode::Ref &root, Iterator &itr, const KeyType &key, const DataType &data, const AggrCalcT &aggrCalc);
+
+    /**
+     * Merge the sorted additions and removals belonging to the leaf node
+     * at the iterator in one pass, thawing the leaf node and its path once.
+     * Returns false without changing the tree if the leaf node would
+     * overflow, underflow or get a new last key, or if there are
+     * aggregated values. Otherwise a and r are advanced past the merged
+     * changes.
+     */
+    static bool
+    merge_leaf(BTreeNode::Ref &root, Iterator &itr, const KeyDataType *&a, const KeyDataType *ae,
+               const KeyType *&r, const KeyType *re, CompareT comp);
 };
 
 extern template class BTreeInserter<uint32_t, uint32_t, NoAggregated>;
@@ -181,4 +181,100 @@ insert(BTreeNode::Ref &root,
     }
 }
 
+
+template <typename KeyT, typename DataT, typename AggrT, typename CompareT,
+          typename TraitsT, class AggrCalcT>
+bool
+BTreeInserter<KeyT, DataT, AggrT, CompareT, TraitsT, AggrCalcT>::
+merge_leaf(BTreeNode::Ref &root,
+           Iterator &itr,
+           const KeyDataType *&a,
+           const KeyDataType *ae,
+           const KeyType *&r,
+           const KeyType *re,
+           CompareT comp)
+{
+    if constexpr (AggrCalcT::hasAggregated()) {
+        return false;
+    } else {
+        constexpr uint32_t maxSlots = LeafNodeType::maxSlots();
+        if (!itr.valid()) {
+            return false;
+        }
+        const LeafNodeType *lnode = itr.getLeafNode();
+        uint32_t oldSize = lnode->validSlots();
+        KeyType lastKey = lnode->getLastKey();
+        KeyDataType merged[maxSlots];
+        uint32_t newSize = 0;
+        uint32_t changes = 0;
+        uint32_t i = 0;
+        const KeyDataType *ta = a;
+        const KeyType *tr = r;
+        auto in_leaf = [&lastKey, comp](const KeyType &key) { return !comp(lastKey, key); };
+        while ((ta != ae && in_leaf(ta->_key)) || (tr != re && in_leaf(*tr))) {
+            if (++changes > 2 * maxSlots) {
+                return false;
+            }
+            bool add = (ta != ae && in_leaf(ta->_key)) && (tr == re || !in_leaf(*tr) || !comp(*tr, ta->_key));
+            const KeyType &key = add ? ta->_key : *tr;
+            while (i < oldSize && comp(lnode->getKey(i), key)) {
+                if (newSize >= maxSlots) {
+                    return false;
+                }
+                merged[newSize++] = KeyDataType(lnode->getKey(i), lnode->getData(i));
+                ++i;
+            }
+            if (i < oldSize && !comp(key, lnode->getKey(i))) {
+                ++i; // replaced or removed
+            }
+            if (add) {
+                if (newSize >= maxSlots) {
+                    return false;
+                }
+                merged[newSize++] = *ta;
+                if (tr != re && !comp(ta->_key, *tr)) {
+                    ++tr;
+                }
+                ++ta;
+            } else {
+                ++tr;
+            }
+        }
+        if (changes < 2 || newSize + (oldSize - i) > maxSlots) {
+            return false;
+        }
+        while (i < oldSize) {
+            merged[newSize++] = KeyDataType(lnode->getKey(i), lnode->getData(i));
+            ++i;
+        }
+        if (newSize == 0 || (itr.getPathSize() > 0 && newSize < LeafNodeType::minSlots()) ||
+            comp(merged[newSize - 1]._key, lastKey))
+        {
+            return false;
+        }
+        root = itr.thaw(root);
+        LeafNodeType *wnode = itr.getLeafNode();
+        for (i = 0; i < newSize; ++i) {
+            wnode->update(i, merged[i]._key, merged[i].getData());
+        }
+        if (newSize < oldSize) {
+            wnode->cleanRange(newSize, oldSize);
+        }
+        wnode->setValidSlots(newSize);
+        for (uint32_t level = 0; level < itr.getPathSize(); ++level) {
+            InternalNodeType *node = itr.getPath(level).getWNode();
+            if (newSize > oldSize) {
+                node->incValidLeaves(newSize - oldSize);
+            } else {
+                node->decValidLeaves(oldSize - newSize);
+            }
+        }
+        // Remaining changes are beyond the last key in the leaf node
+        itr.setLeafNodeIdx(newSize - 1);
+        a = ta;
+        r = tr;
+        return true;
+    }
+}
+
 }
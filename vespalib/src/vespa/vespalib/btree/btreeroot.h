@@ -156,6 +156,7 @@ public:
     using NodeAllocatorType = typename ParentType::NodeAllocatorType;
     using KeyType = typename ParentType::KeyType;
     using DataType = typename ParentType::DataType;
+    using KeyDataType = typename ParentType::KeyDataType;
     using LeafNodeType = typename ParentType::LeafNodeType;
     using InternalNodeType = typename ParentType::InternalNodeType;
     using LeafNodeTypeRefPair = typename ParentType::LeafNodeTypeRefPair;
@@ -197,6 +198,11 @@ public:
            const KeyType &key, const DataType &data,
            const AggrCalcT &aggrCalc = AggrCalcT());
 
+    // Merge changes belonging to the leaf node at iterator, see BTreeInserter::merge_leaf()
+    bool
+    merge_leaf(Iterator &itr, const KeyDataType *&a, const KeyDataType *ae,
+               const KeyType *&r, const KeyType *re, CompareT comp = CompareT());
+
     bool
     remove(const KeyType & key,
            NodeAllocatorType &allocator, CompareT comp = CompareT(),
@@ -402,6 +402,24 @@ insert(Iterator &itr,
 }
 
 
+template <typename KeyT, typename DataT, typename AggrT, typename CompareT,
+          typename TraitsT, class AggrCalcT>
+bool
+BTreeRoot<KeyT, DataT, AggrT, CompareT, TraitsT, AggrCalcT>::
+merge_leaf(Iterator &itr,
+           const KeyDataType *&a, const KeyDataType *ae,
+           const KeyType *&r, const KeyType *re,
+           CompareT comp)
+{
+    using Inserter = BTreeInserter<KeyT, DataT, AggrT, CompareT, TraitsT, AggrCalcT>;
+    bool oldFrozen = isFrozen();
+    bool merged = Inserter::merge_leaf(_root, itr, a, ae, r, re, comp);
+    if (oldFrozen && !isFrozen())
+        itr.getAllocator().needFreeze(this);
+    return merged;
+}
+
+
 template <typename KeyT, typename DataT, typename AggrT, typename CompareT,
           typename TraitsT, class AggrCalcT>
 bool
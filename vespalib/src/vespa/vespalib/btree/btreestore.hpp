@@ -305,20 +305,21 @@ applyModifyTree(BTreeType *tree,
                     ((a != ae) ? a->_key : *r),
                     comp);
     while (a != ae || r != re) {
+        const KeyType &key = (r != re && (a == ae || comp(*r, a->_key))) ? *r : a->_key;
+        if (itr.valid() && comp(itr.getKey(), key)) {
+            itr.binarySeek(key, comp);
+        }
+        if (tree->merge_leaf(itr, a, ae, r, re, comp)) {
+            continue;
+        }
         if (r != re && (a == ae || comp(*r, a->_key))) {
             // remove
-            if (itr.valid() && comp(itr.getKey(), *r)) {
-                itr.binarySeek(*r, comp);
-            }
             if (itr.valid() && !comp(*r, itr.getKey())) {
                 tree->remove(itr, _aggrCalc);
             }
             ++r;
         } else {
             // update or add
-            if (itr.valid() && comp(itr.getKey(), a->_key)) {
-                itr.binarySeek(a->_key, comp);
-            }
             if (itr.valid() && !comp(a->_key, itr.getKey())) {
                 tree->thaw(itr);
                 itr.updateData(a->getData(), _aggrCalc);
@@ -12,6 +12,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <unistd.h>
 
 #ifdef VESPA_HAS_IO_URING
 #include "io_uring_thread.hpp"
@@ -241,6 +242,12 @@ struct SelectorThread : AsyncIo {
         }
         co_return -ECANCELED;
     }
+    Lazy<ssize_t> pread(int fd, char *buf, size_t len, uint64_t offset) override {
+        // regular files are always readable according to epoll; read
+        // them directly in the calling thread
+        ssize_t res = ::pread(fd, buf, len, offset);
+        co_return (res < 0) ? -errno : res;
+    }
     Lazy<bool> schedule() override {
         co_return co_await async_run();
     }
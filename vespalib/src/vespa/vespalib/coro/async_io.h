@@ -61,6 +61,9 @@ struct AsyncIo : std::enable_shared_from_this<AsyncIo> {
     virtual Lazy<SocketHandle> connect(const SocketAddress &addr) = 0;
     virtual Lazy<ssize_t> read(SocketHandle &handle, char *buf, size_t len) = 0;
     virtual Lazy<ssize_t> write(SocketHandle &handle, const char *buf, size_t len) = 0;
+    // positional read from a regular file; may complete synchronously
+    // with implementations that are not able to wait for file io
+    virtual Lazy<ssize_t> pread(int fd, char *buf, size_t len, uint64_t offset) = 0;
     virtual Lazy<bool> schedule() = 0;
 
 protected:
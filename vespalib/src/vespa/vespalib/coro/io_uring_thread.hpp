@@ -220,6 +220,16 @@ struct IoUringThread : AsyncIo {
         }
         co_return res;
     }
+    Lazy<ssize_t> pread(int fd, char *buf, size_t len, uint64_t offset) override {
+        ssize_t res = -ECANCELED;
+        bool inside = in_thread() ? true : co_await async_run();
+        if (inside) {
+            auto *sqe = _uring.get_sqe();
+            io_uring_prep_read(sqe, fd, buf, len, offset);
+            res = co_await wait_for_sqe(sqe);
+        }
+        co_return res;
+    }
     Lazy<bool> schedule() override {
         co_return co_await async_run();
     }
@@ -135,6 +135,32 @@ public:
         }
     }
 
+    /**
+     * Prefetch the start of the array referenced by ref into the cache,
+     * allowing a later get() to be served without a cache miss.
+     */
+    void prefetch(EntryRef ref) const noexcept {
+        if (!ref.valid()) [[unlikely]] {
+            return;
+        }
+        RefT internalRef(ref);
+        const BufferAndMeta & bufferAndMeta = _store.getBufferMeta(internalRef.bufferId());
+        if (bufferAndMeta.getTypeId() != _largeArrayTypeId) [[likely]] {
+            if constexpr (has_dynamic_buffer_type) {
+                if (_mapper.is_dynamic_buffer(bufferAndMeta.getTypeId())) {
+                    auto entry = TypeMapper::DynamicBufferType::get_entry(bufferAndMeta.get_buffer_acquire(), internalRef.offset(), bufferAndMeta.get_entry_size());
+                    // Array size is stored just before the array elements
+                    __builtin_prefetch(reinterpret_cast<const char *>(entry) - sizeof(uint32_t));
+                    __builtin_prefetch(entry);
+                    return;
+                }
+            }
+            __builtin_prefetch(_store.template getEntryArray<ElemT>(internalRef, bufferAndMeta.get_array_size()));
+        } else {
+            __builtin_prefetch(_store.template getEntry<LargeArray>(internalRef));
+        }
+    }
+
     /**
      * Allocate an array of the given size without any instantiation of ElemT elements.
      *
@@ -158,6 +184,8 @@ public:
 
     void remove(EntryRef ref);
     EntryRef move_on_compact(EntryRef ref) override;
+    EntryRef allocate_on_compact(EntryRef ref) override;
+    void copy_on_compact(EntryRef old_ref, EntryRef new_ref) const override;
     ICompactionContext::UP compact_worst(const CompactionStrategy& compaction_strategy);
     // Use this if references to array store is not an array of AtomicEntryRef
     std::unique_ptr<CompactingBuffers> start_compact_worst_buffers(const CompactionStrategy &compaction_strategy);
@@ -208,6 +208,28 @@ ArrayStore<ElemT, RefT, TypeMapperT>::move_on_compact(EntryRef ref)
     return add(get(ref));
 }
 
+template <typename ElemT, typename RefT, typename TypeMapperT>
+EntryRef
+ArrayStore<ElemT, RefT, TypeMapperT>::allocate_on_compact(EntryRef ref)
+{
+    if constexpr (std::is_trivially_copyable_v<ElemT>) {
+        return allocate(get(ref).size());
+    } else {
+        return move_on_compact(ref);
+    }
+}
+
+template <typename ElemT, typename RefT, typename TypeMapperT>
+void
+ArrayStore<ElemT, RefT, TypeMapperT>::copy_on_compact(EntryRef old_ref, EntryRef new_ref) const
+{
+    if constexpr (std::is_trivially_copyable_v<ElemT>) {
+        auto old_array = get(old_ref);
+        auto new_array = vespalib::unconstify(get(new_ref));
+        std::copy(old_array.begin(), old_array.end(), new_array.begin());
+    }
+}
+
 template <typename ElemT, typename RefT, typename TypeMapperT>
 ICompactionContext::UP
 ArrayStore<ElemT, RefT, TypeMapperT>::compact_worst(const CompactionStrategy &compaction_strategy)
@@ -234,6 +256,7 @@ template <typename ElemT, typename RefT, typename TypeMapperT>
 vespalib::MemoryUsage
 ArrayStore<ElemT, RefT, TypeMapperT>::update_stat(const CompactionStrategy& compaction_strategy)
 {
+    _store.sample_tiered_memory();
     auto address_space_usage = _store.getAddressSpaceUsage();
     auto memory_usage = getMemoryUsage();
     _compaction_spec = compaction_strategy.should_compact(memory_usage, address_space_usage);
@@ -101,6 +101,7 @@ public:
 
     BufferStats& stats() noexcept { return _stats; }
     const BufferStats& stats() const noexcept { return _stats; }
+    const Alloc& get_alloc() const noexcept { return _buffer; }
 
     void enable_free_list(FreeList& type_free_list) noexcept { _free_list.enable(type_free_list); }
     void disable_free_list() noexcept { _free_list.disable(); }
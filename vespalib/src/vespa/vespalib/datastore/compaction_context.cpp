@@ -3,9 +3,78 @@
 #include "compaction_context.h"
 #include "compacting_buffers.h"
 #include "i_compactable.h"
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadexecutor.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace vespalib::datastore {
 
+namespace {
+
+std::atomic<vespalib::Executor*> helper_executor(nullptr);
+
+struct MovedEntry {
+    uint32_t idx; // index in refs
+    EntryRef new_ref;
+    MovedEntry(uint32_t idx_in, EntryRef new_ref_in) noexcept : idx(idx_in), new_ref(new_ref_in) { }
+};
+
+/*
+ * Shared state for copying moved entries in chunks. Helper tasks starting after
+ * all chunks have been claimed return without touching anything but this state,
+ * thus the writer thread only waits for chunks being copied, not for queued tasks.
+ */
+class ParallelCopy {
+    const ICompactable&       _store;
+    std::span<AtomicEntryRef> _refs;
+    std::vector<MovedEntry>   _moved;
+    size_t                    _num_chunks;
+    std::atomic<size_t>       _next_chunk;
+    std::atomic<size_t>       _done_chunks;
+    std::mutex                _lock;
+    std::condition_variable   _cond;
+public:
+    ParallelCopy(const ICompactable& store, std::span<AtomicEntryRef> refs, std::vector<MovedEntry> moved)
+        : _store(store),
+          _refs(refs),
+          _moved(std::move(moved)),
+          _num_chunks((_moved.size() + CompactionContext::parallel_copy_chunk_size - 1) / CompactionContext::parallel_copy_chunk_size),
+          _next_chunk(0),
+          _done_chunks(0),
+          _lock(),
+          _cond()
+    {
+    }
+    size_t num_chunks() const noexcept { return _num_chunks; }
+    const std::vector<MovedEntry>& moved() const noexcept { return _moved; }
+    void run() {
+        constexpr size_t chunk_size = CompactionContext::parallel_copy_chunk_size;
+        for (size_t chunk = _next_chunk.fetch_add(1, std::memory_order_relaxed); chunk < _num_chunks;
+             chunk = _next_chunk.fetch_add(1, std::memory_order_relaxed))
+        {
+            size_t end = std::min((chunk + 1) * chunk_size, _moved.size());
+            for (size_t i = chunk * chunk_size; i < end; ++i) {
+                _store.copy_on_compact(_refs[_moved[i].idx].load_relaxed(), _moved[i].new_ref);
+            }
+            if (_done_chunks.fetch_add(1, std::memory_order_acq_rel) + 1 == _num_chunks) {
+                std::lock_guard guard(_lock);
+                _cond.notify_all();
+            }
+        }
+    }
+    void await() {
+        std::unique_lock guard(_lock);
+        _cond.wait(guard, [this]() { return _done_chunks.load(std::memory_order_acquire) == _num_chunks; });
+    }
+};
+
+}
+
 CompactionContext::CompactionContext(ICompactable& store,
                                      std::unique_ptr<CompactingBuffers> compacting_buffers)
     : _store(store),
@@ -22,6 +91,11 @@ CompactionContext::~CompactionContext()
 void
 CompactionContext::compact(std::span<AtomicEntryRef> refs)
 {
+    auto* executor = get_helper_executor();
+    if (executor != nullptr && refs.size() > parallel_copy_chunk_size) {
+        compact_parallel(refs, *executor);
+        return;
+    }
     for (auto &atomic_entry_ref : refs) {
         auto ref = atomic_entry_ref.load_relaxed();
         if (ref.valid() && _filter.has(ref)) {
@@ -31,4 +105,44 @@ CompactionContext::compact(std::span<AtomicEntryRef> refs)
     }
 }
 
+void
+CompactionContext::compact_parallel(std::span<AtomicEntryRef> refs, vespalib::Executor& executor)
+{
+    std::vector<MovedEntry> moved;
+    for (uint32_t idx = 0; idx < refs.size(); ++idx) {
+        auto ref = refs[idx].load_relaxed();
+        if (ref.valid() && _filter.has(ref)) {
+            moved.emplace_back(idx, _store.allocate_on_compact(ref));
+        }
+    }
+    auto copy = std::make_shared<ParallelCopy>(_store, refs, std::move(moved));
+    auto* thread_executor = dynamic_cast<vespalib::ThreadExecutor*>(&executor);
+    size_t num_threads = (thread_executor != nullptr) ? thread_executor->getNumThreads() : 1;
+    size_t num_tasks = (copy->num_chunks() > 1) ? std::min(num_threads, copy->num_chunks() - 1) : 0;
+    for (size_t i = 0; i < num_tasks; ++i) {
+        auto rejected = executor.execute(vespalib::makeLambdaTask([copy]() { copy->run(); }));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    copy->run();
+    copy->await();
+    // Only the reference remap is left for the writer thread
+    for (auto& entry : copy->moved()) {
+        refs[entry.idx].store_release(entry.new_ref);
+    }
+}
+
+void
+CompactionContext::set_helper_executor(vespalib::Executor* executor) noexcept
+{
+    helper_executor.store(executor, std::memory_order_release);
+}
+
+vespalib::Executor*
+CompactionContext::get_helper_executor() noexcept
+{
+    return helper_executor.load(std::memory_order_acquire);
+}
+
 }
@@ -5,6 +5,8 @@
 #include "i_compaction_context.h"
 #include "entry_ref_filter.h"
 
+namespace vespalib { class Executor; }
+
 namespace vespalib::datastore {
 
 class CompactingBuffers;
@@ -12,6 +14,10 @@ struct ICompactable;
 
 /**
  * A compaction context is used when performing a compaction of data buffers in a data store.
+ *
+ * When a helper executor is set, and many entries are moved, the new entries are
+ * allocated by the writer thread while the contents are copied by the helper threads.
+ * The writer thread then updates the entry refs when all copying is done.
  */
 class CompactionContext : public ICompactionContext {
 private:
@@ -19,10 +25,20 @@ private:
     std::unique_ptr<vespalib::datastore::CompactingBuffers> _compacting_buffers;
     EntryRefFilter _filter;
 
+    void compact_parallel(std::span<AtomicEntryRef> refs, vespalib::Executor& executor);
 public:
+    static constexpr size_t parallel_copy_chunk_size = 4096;
+
     CompactionContext(ICompactable& store, std::unique_ptr<CompactingBuffers> compacting_buffers);
     ~CompactionContext() override;
     void compact(std::span<AtomicEntryRef> refs) override;
+
+    /*
+     * Set executor with helper threads used for copying entries during compaction.
+     * Must be reset before the executor is destroyed.
+     */
+    static void set_helper_executor(vespalib::Executor* executor) noexcept;
+    static vespalib::Executor* get_helper_executor() noexcept;
 };
 
 }
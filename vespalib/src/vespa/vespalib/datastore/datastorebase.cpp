@@ -7,6 +7,7 @@
 #include "compaction_strategy.h"
 #include <vespa/vespalib/util/generation_hold_list.hpp>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/tiered_memory_allocator.h>
 #include <algorithm>
 #include <limits>
 #include <cassert>
@@ -367,6 +368,27 @@ DataStoreBase::getMemStats() const noexcept
     return stats;
 }
 
+void
+DataStoreBase::sample_tiered_memory()
+{
+    uint32_t buffer_id_limit = get_bufferid_limit_relaxed();
+    for (uint32_t bufferId = 0; bufferId < buffer_id_limit; ++bufferId) {
+        BufferState * state = _buffers[bufferId].get_state_relaxed();
+        if (state == nullptr || !state->isActive()) {
+            continue;
+        }
+        auto allocator = dynamic_cast<const alloc::TieredMemoryAllocator *>(state->getTypeHandler()->get_memory_allocator());
+        if (allocator == nullptr) {
+            continue;
+        }
+        // Any change to buffer contents changes the number of used, dead or held entries
+        const auto& stats = state->stats();
+        uint64_t signature = stats.size() ^ (uint64_t(stats.dead_entries()) << 24) ^ (uint64_t(stats.hold_entries()) << 44);
+        const auto& buffer = state->get_alloc();
+        allocator->sample(alloc::PtrAndSize(const_cast<void *>(buffer.get()), buffer.size()), signature);
+    }
+}
+
 vespalib::AddressSpace
 DataStoreBase::getAddressSpaceUsage() const noexcept
 {
@@ -153,6 +153,12 @@ public:
      */
     MemoryStats getMemStats() const noexcept;
 
+    /**
+     * Samples changes to buffers allocated by a tiered memory allocator, allowing
+     * buffers that have not been changed for a while to be migrated to file backed memory.
+     */
+    void sample_tiered_memory();
+
     /**
      * Assume that no readers are present while data structure is being initialized.
      */
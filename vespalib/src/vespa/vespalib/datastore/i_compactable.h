@@ -15,6 +15,16 @@ namespace vespalib::datastore {
 struct ICompactable {
     virtual ~ICompactable() = default;
     virtual EntryRef move_on_compact(EntryRef ref) = 0;
+    /*
+     * Moving an entry can also be split in two steps, allowing the contents
+     * to be copied by helper threads. allocate_on_compact() is called by the
+     * writer thread and returns a reference to a new uninitialized entry.
+     * copy_on_compact() is then called by any thread to copy the old entry to
+     * the new entry, before the new reference is made visible to readers.
+     * The default is to copy the entry when allocating.
+     */
+    virtual EntryRef allocate_on_compact(EntryRef ref) { return move_on_compact(ref); }
+    virtual void copy_on_compact(EntryRef, EntryRef) const { }
 };
 
 }
@@ -0,0 +1,186 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bit_parallel_levenshtein.h"
+#include <vespa/vespalib/text/lowercase.h>
+#include <vespa/vespalib/text/utf8.h>
+#include <algorithm>
+#include <cassert>
+
+namespace vespalib::fuzzy {
+
+BitParallelLevenshtein::BitParallelLevenshtein(std::span<const uint32_t> target_u32, uint8_t max_edits,
+                                               bool is_cased, bool is_prefix)
+    : _ascii_eq(),
+      _other_eq(),
+      _target_chars(target_u32.size()),
+      _max_edits(max_edits),
+      _is_cased(is_cased),
+      _is_prefix(is_prefix)
+{
+    assert(supports_target_length(target_u32.size()));
+    for (size_t i = 0; i < target_u32.size(); ++i) {
+        uint32_t ch = target_u32[i];
+        uint64_t bit = uint64_t(1) << i;
+        if (ch < _ascii_eq.size()) {
+            _ascii_eq[ch] |= bit;
+        } else {
+            auto iter = std::find_if(_other_eq.begin(), _other_eq.end(), [ch](const auto& entry) { return entry.first == ch; });
+            if (iter != _other_eq.end()) {
+                iter->second |= bit;
+            } else {
+                _other_eq.emplace_back(ch, bit);
+            }
+        }
+    }
+}
+
+BitParallelLevenshtein::BitParallelLevenshtein(BitParallelLevenshtein&&) noexcept = default;
+BitParallelLevenshtein& BitParallelLevenshtein::operator=(BitParallelLevenshtein&&) noexcept = default;
+BitParallelLevenshtein::~BitParallelLevenshtein() = default;
+
+namespace {
+
+/**
+ * The state of matching a source string against the target, one source char
+ * (i.e. one column of the dynamic programming matrix) at a time.
+ *
+ * pv/mv hold the vertical deltas (+1/-1) of the current column, score is the
+ * bottom cell of the column, i.e. the distance between the target and the
+ * source chars seen so far. In addition the last row of the column with a
+ * distance within max edits is tracked (Ukkonen's cutoff), which lets us give
+ * up as soon as no cell in the column is within max edits.
+ */
+class Column {
+    uint64_t _pv;
+    uint64_t _mv;
+    uint64_t _last;
+    uint32_t _rows;
+    uint32_t _max_edits;
+    uint32_t _score;
+    uint32_t _best;
+    uint32_t _active;       // last row within max edits
+    uint32_t _active_score; // the distance in that row
+
+    static int32_t delta(uint64_t plus, uint64_t minus, uint32_t row) noexcept {
+        return int32_t((plus >> (row - 1)) & 1) - int32_t((minus >> (row - 1)) & 1);
+    }
+    int32_t vertical_delta(uint32_t row) const noexcept { return delta(_pv, _mv, row); }
+public:
+    Column(uint32_t rows, uint32_t max_edits) noexcept
+        : _pv(~uint64_t(0)),
+          _mv(0),
+          _last(uint64_t(1) << (rows - 1)),
+          _rows(rows),
+          _max_edits(max_edits),
+          _score(rows),
+          _best(rows),
+          _active(std::min(rows, max_edits)),
+          _active_score(_active)
+    {}
+    uint32_t score() const noexcept { return _score; }
+    uint32_t best() const noexcept { return _best; }
+
+    // returns false if no cell in the new column is within max edits
+    bool step(uint64_t eq) noexcept {
+        uint64_t xv = eq | _mv;
+        uint64_t xh = (((eq & _pv) + _pv) ^ _pv) | eq;
+        uint64_t ph = _mv | ~(xh | _pv);
+        uint64_t mh = _pv & xh;
+        if (ph & _last) {
+            ++_score;
+        } else if (mh & _last) {
+            --_score;
+        }
+        // horizontal delta of the last active row; the top row always increases by one
+        _active_score += (_active == 0) ? 1 : delta(ph, mh, _active);
+        // the top row of the matrix increases by one for each source char
+        ph = (ph << 1) | 1;
+        mh = (mh << 1);
+        _pv = mh | ~(xv | ph);
+        _mv = ph & xv;
+        _best = std::min(_best, _score);
+        // the last active row moves down at most one row per column
+        if (_active < _rows) {
+            ++_active;
+            _active_score += vertical_delta(_active);
+        }
+        while (_active_score > _max_edits) {
+            if (_active == 0) {
+                return false;
+            }
+            _active_score -= vertical_delta(_active);
+            --_active;
+        }
+        return true;
+    }
+};
+
+}
+
+BitParallelLevenshtein::MatchResult
+BitParallelLevenshtein::match(std::string_view source) const noexcept
+{
+    const uint32_t m = _target_chars;
+    const uint32_t k = _max_edits;
+    if (m == 0) {
+        if (_is_prefix) {
+            return MatchResult::make_match(k, 0);
+        }
+        Utf8Reader reader(source.data(), source.size());
+        uint32_t n = 0;
+        for (; n <= k && reader.hasMore(); ++n) {
+            (void) reader.getChar();
+        }
+        return make_result(n);
+    }
+    Column col(m, k);
+    size_t pos = 0;
+    // fast path for the (common) ASCII prefix of the source
+    for (; pos < source.size() && uint8_t(source[pos]) < 0x80; ++pos) {
+        uint32_t ch = uint8_t(source[pos]);
+        if (!_is_cased && (ch - 'A') < 26u) {
+            ch += ('a' - 'A');
+        }
+        if (!col.step(eq_mask(ch))) {
+            return _is_prefix ? make_result(col.best()) : MatchResult::make_mismatch(k);
+        }
+    }
+    if (pos < source.size()) {
+        Utf8Reader reader(source.data() + pos, source.size() - pos);
+        while (reader.hasMore()) {
+            uint32_t ch = reader.getChar();
+            if (!col.step(eq_mask(_is_cased ? ch : LowerCase::convert(ch)))) {
+                return _is_prefix ? make_result(col.best()) : MatchResult::make_mismatch(k);
+            }
+        }
+    }
+    return make_result(_is_prefix ? col.best() : col.score());
+}
+
+BitParallelLevenshtein::MatchResult
+BitParallelLevenshtein::match_u32(std::span<const uint32_t> source) const noexcept
+{
+    const uint32_t m = _target_chars;
+    const uint32_t k = _max_edits;
+    if (m == 0) {
+        return make_result(_is_prefix ? 0 : source.size());
+    }
+    if (!_is_prefix && (source.size() > m + k || m > source.size() + k)) {
+        return MatchResult::make_mismatch(k);
+    }
+    Column col(m, k);
+    for (uint32_t ch : source) {
+        if (!col.step(eq_mask(ch))) {
+            return _is_prefix ? make_result(col.best()) : MatchResult::make_mismatch(k);
+        }
+    }
+    return make_result(_is_prefix ? col.best() : col.score());
+}
+
+size_t
+BitParallelLevenshtein::memory_usage() const noexcept
+{
+    return sizeof(*this) + _other_eq.capacity() * sizeof(std::pair<uint32_t, uint64_t>);
+}
+
+}
@@ -0,0 +1,88 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "levenshtein_dfa.h"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace vespalib::fuzzy {
+
+/**
+ * Bit-parallel Levenshtein matcher for short target strings, based on
+ * the algorithm by Myers ("A fast bit-vector algorithm for approximate
+ * string matching based on dynamic programming", 1999) in the global
+ * edit distance formulation by Hyyrö.
+ *
+ * A whole column of the dynamic programming matrix is kept as vertical
+ * deltas in two 64-bit words, so each source character is processed
+ * with a handful of word operations regardless of the target length.
+ * The target can therefore be at most 64 code points long. Matching
+ * stops as soon as no cell in the current column is within max edits
+ * (Ukkonen's cutoff), so most mismatches only look at a few chars.
+ *
+ * Has the same matching semantics as a LevenshteinDfa built with the
+ * same arguments, but does not generate successor strings, so it is
+ * intended for matching candidates one by one rather than for seeking
+ * in a dictionary. Like the implicit DFA it is cheap to build, but it
+ * is considerably faster to match with.
+ */
+class BitParallelLevenshtein {
+public:
+    using MatchResult = LevenshteinDfa::MatchResult;
+    static constexpr size_t max_target_chars = 64;
+
+    /**
+     * The target must already be lowercased if matching is uncased,
+     * and must not be longer than max_target_chars code points.
+     */
+    BitParallelLevenshtein(std::span<const uint32_t> target_u32, uint8_t max_edits, bool is_cased, bool is_prefix);
+    BitParallelLevenshtein(BitParallelLevenshtein&&) noexcept;
+    BitParallelLevenshtein& operator=(BitParallelLevenshtein&&) noexcept;
+    ~BitParallelLevenshtein();
+
+    [[nodiscard]] static constexpr bool supports_target_length(size_t target_chars) noexcept {
+        return target_chars <= max_target_chars;
+    }
+
+    /**
+     * Matches the UTF-8 string `source` against the target, returning
+     * a MatchResult with the same semantics as LevenshteinDfa::match(source).
+     */
+    [[nodiscard]] MatchResult match(std::string_view source) const noexcept;
+
+    /**
+     * Same as match(), but for a source string that is already decoded
+     * (and lowercased if matching is uncased).
+     */
+    [[nodiscard]] MatchResult match_u32(std::span<const uint32_t> source) const noexcept;
+
+    [[nodiscard]] size_t memory_usage() const noexcept;
+private:
+    std::array<uint64_t, 128>                  _ascii_eq;
+    std::vector<std::pair<uint32_t, uint64_t>> _other_eq;
+    uint32_t                                   _target_chars;
+    uint8_t                                    _max_edits;
+    bool                                       _is_cased;
+    bool                                       _is_prefix;
+
+    MatchResult make_result(uint32_t edits) const noexcept {
+        return (edits <= _max_edits) ? MatchResult::make_match(_max_edits, edits) : MatchResult::make_mismatch(_max_edits);
+    }
+    uint64_t eq_mask(uint32_t ch) const noexcept {
+        if (ch < _ascii_eq.size()) [[likely]] {
+            return _ascii_eq[ch];
+        }
+        for (const auto& entry : _other_eq) {
+            if (entry.first == ch) {
+                return entry.second;
+            }
+        }
+        return 0;
+    }
+};
+
+}
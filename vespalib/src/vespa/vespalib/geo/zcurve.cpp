@@ -86,30 +86,42 @@ class ZAreaSplitter
 private:
     using RangeVector = ZCurve::RangeVector;
 
-    ZAreaQueue _queue;
+    ZAreaQueue                _queue;
+    const ZCurve::AreaFilter *_may_overlap;
+
+    void put(Area area) {
+        if ((_may_overlap == nullptr) ||
+            (*_may_overlap)(area.min.x, area.min.y, area.max.x, area.max.y))
+        {
+            _queue.put(std::move(area));
+        }
+    }
 
 public:
-    ZAreaSplitter(int min_x, int min_y, int max_x, int max_y) : _queue() {
+    ZAreaSplitter(int min_x, int min_y, int max_x, int max_y, const ZCurve::AreaFilter *may_overlap)
+        : _queue(),
+          _may_overlap(may_overlap)
+    {
         assert(min_x <= max_x);
         assert(min_y <= max_y);
         bool cross_x = (min_x < 0) != (max_x < 0);
         bool cross_y = (min_y < 0) != (max_y < 0);
         if (cross_x) {
             if (cross_y) {
-                _queue.put(Area(min_x, min_y,    -1,    -1));
-                _queue.put(Area(    0, min_y, max_x,    -1));
-                _queue.put(Area(min_x,     0,    -1, max_y));
-                _queue.put(Area(    0,     0, max_x, max_y));
+                put(Area(min_x, min_y,    -1,    -1));
+                put(Area(    0, min_y, max_x,    -1));
+                put(Area(min_x,     0,    -1, max_y));
+                put(Area(    0,     0, max_x, max_y));
             } else {
-                _queue.put(Area(min_x, min_y,    -1, max_y));
-                _queue.put(Area(    0, min_y, max_x, max_y));
+                put(Area(min_x, min_y,    -1, max_y));
+                put(Area(    0, min_y, max_x, max_y));
             }
         } else {
             if (cross_y) {
-                _queue.put(Area(min_x, min_y, max_x,    -1));
-                _queue.put(Area(min_x,     0, max_x, max_y));
+                put(Area(min_x, min_y, max_x,    -1));
+                put(Area(min_x,     0, max_x, max_y));
             } else {
-                _queue.put(Area(min_x, min_y, max_x, max_y));
+                put(Area(min_x, min_y, max_x, max_y));
             }
         }
     }
@@ -125,12 +137,12 @@ public:
         uint32_t x_bits = bits::split_range(area.min.x, area.max.x, x_first_max, x_last_min);
         uint32_t y_bits = bits::split_range(area.min.y, area.max.y, y_first_max, y_last_min);
         if (x_bits > y_bits) {
-            _queue.put(Area(area.min.x, area.min.y, x_first_max, area.max.y));
-            _queue.put(Area(x_last_min, area.min.y,  area.max.x, area.max.y));
+            put(Area(area.min.x, area.min.y, x_first_max, area.max.y));
+            put(Area(x_last_min, area.min.y,  area.max.x, area.max.y));
         } else {
             assert(y_bits > 0);
-            _queue.put(Area(area.min.x, area.min.y, area.max.x, y_first_max));
-            _queue.put(Area(area.min.x, y_last_min, area.max.x,  area.max.y));
+            put(Area(area.min.x, area.min.y, area.max.x, y_first_max));
+            put(Area(area.min.x, y_last_min, area.max.x,  area.max.y));
         }
     }
 
@@ -150,9 +162,11 @@ ZCurve::BoundingBox::BoundingBox(int32_t minx,
 {
 }
 
+namespace {
+
 ZCurve::RangeVector
-ZCurve::find_ranges(int min_x, int min_y,
-                    int max_x, int max_y)
+find_ranges_impl(int min_x, int min_y, int max_x, int max_y,
+                 uint32_t estimate_factor, const ZCurve::AreaFilter *may_overlap)
 {
     uint64_t x_size = (static_cast<int64_t>(max_x) - min_x + 1);
     uint64_t y_size = (static_cast<int64_t>(max_y) - min_y + 1);
@@ -160,18 +174,39 @@ ZCurve::find_ranges(int min_x, int min_y,
                            y_size > std::numeric_limits<uint32_t>::max()) ?
                           std::numeric_limits<uint64_t>::max() :
                           (x_size * y_size);
-    int64_t estimate_target = (total_size > std::numeric_limits<int64_t>::max() / 4) ?
+    int64_t estimate_target = (total_size > std::numeric_limits<int64_t>::max() / estimate_factor) ?
                               std::numeric_limits<int64_t>::max() :
-                              (total_size * 4);
-    ZAreaSplitter splitter(min_x, min_y, max_x, max_y);
+                              (total_size * estimate_factor);
+    ZAreaSplitter splitter(min_x, min_y, max_x, max_y, may_overlap);
     while (splitter.total_estimate() > estimate_target && splitter.num_ranges() < 42) {
         splitter.split_worst();
     }
-    RangeVector ranges = splitter.extract_ranges();
+    ZCurve::RangeVector ranges = splitter.extract_ranges();
     std::sort(ranges.begin(), ranges.end());
     return ranges;
 }
 
+}
+
+ZCurve::RangeVector
+ZCurve::find_ranges(int min_x, int min_y,
+                    int max_x, int max_y)
+{
+    return find_ranges_impl(min_x, min_y, max_x, max_y, 4, nullptr);
+}
+
+ZCurve::RangeVector
+ZCurve::find_ranges(int min_x, int min_y,
+                    int max_x, int max_y,
+                    const AreaFilter &may_overlap)
+{
+    // Dropping the parts outside the shape makes an estimate below the
+    // bounding box size reachable. When all remaining areas are exact,
+    // the estimate is at most the bounding box size, so the area with
+    // the worst error can always be split further.
+    return find_ranges_impl(min_x, min_y, max_x, max_y, 1, &may_overlap);
+}
+
 int64_t
 ZCurve::encodeSlow(int32_t x, int32_t y)
 {
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <vector>
 
 namespace vespalib::geo {
@@ -187,6 +188,24 @@ public:
     static RangeVector find_ranges(int min_x, int min_y,
                                    int max_x, int max_y);
 
+    /**
+     * Tells whether any point inside the given inclusive box may be
+     * part of a shape. Must never return false for a box that
+     * contains points of the shape.
+     **/
+    using AreaFilter = std::function<bool(int32_t min_x, int32_t min_y, int32_t max_x, int32_t max_y)>;
+
+    /**
+     * Like find_ranges above, but for a shape (like a circle) inside
+     * the bounding box. Parts of the bounding box rejected by the
+     * filter are dropped while the ranges are refined, so the
+     * returned ranges contain all points of the shape, but far fewer
+     * points outside it than the ranges for the whole bounding box.
+     **/
+    static RangeVector find_ranges(int min_x, int min_y,
+                                   int max_x, int max_y,
+                                   const AreaFilter &may_overlap);
+
     static int64_t encodeSlow(int32_t x, int32_t y);
 
     static void decodeSlow(int64_t enc, int32_t *xp, int32_t *yp);
@@ -46,4 +46,19 @@ Avx2Accelerator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const
     return helper::multiplyAdd(a, b, sz);
 }
 
+double
+Avx2Accelerator::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept {
+    return helper::squaredEuclideanDistanceBFloat16<32>(a, b, sz);
+}
+
+float
+Avx2Accelerator::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept {
+    return helper::dotProductBFloat16<32>(a, b, sz);
+}
+
+size_t
+Avx2Accelerator::fold_ascii_word_chars(const char * src, size_t sz, char * dest) const noexcept {
+    return helper::fold_ascii_word_chars<32>(src, sz, dest);
+}
+
 }
@@ -16,10 +16,13 @@ public:
     double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const noexcept override;
     double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const noexcept override;
     double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const noexcept override;
+    double squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept override;
+    float dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept override;
     void convert_bfloat16_to_float(const uint16_t * src, float * dest, size_t sz) const noexcept override;
     int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const noexcept override;
     void and128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept override;
     void or128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept override;
+    size_t fold_ascii_word_chars(const char * src, size_t sz, char * dest) const noexcept override;
     const char* target_name() const noexcept override { return "AVX2"; }
 };
 
@@ -74,4 +74,19 @@ Avx3DlAccelerator::dotProduct(const int8_t* a, const int8_t* b, size_t sz) const
     return helper::multiplyAdd(a, b, sz);
 }
 
+double
+Avx3DlAccelerator::squaredEuclideanDistance(const BFloat16* a, const BFloat16* b, size_t sz) const noexcept {
+    return helper::squaredEuclideanDistanceBFloat16<64>(a, b, sz);
+}
+
+float
+Avx3DlAccelerator::dotProduct(const BFloat16* a, const BFloat16* b, size_t sz) const noexcept {
+    return helper::dotProductBFloat16<64>(a, b, sz);
+}
+
+size_t
+Avx3DlAccelerator::fold_ascii_word_chars(const char* src, size_t sz, char* dest) const noexcept {
+    return helper::fold_ascii_word_chars<64>(src, sz, dest);
+}
+
 }
@@ -22,6 +22,7 @@ public:
     int64_t dotProduct(const int16_t * a, const int16_t * b, size_t sz) const noexcept override;
     int64_t dotProduct(const int32_t * a, const int32_t * b, size_t sz) const noexcept override;
     long long dotProduct(const int64_t * a, const int64_t * b, size_t sz) const noexcept override;
+    float dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept override;
     void orBit(void * a, const void * b, size_t bytes) const noexcept override;
     void andBit(void * a, const void * b, size_t bytes) const noexcept override;
     void andNotBit(void * a, const void * b, size_t bytes) const noexcept override;
@@ -31,8 +32,10 @@ public:
     double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const noexcept override;
     double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const noexcept override;
     double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const noexcept override;
+    double squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept override;
     void and128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept override;
     void or128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept override;
+    size_t fold_ascii_word_chars(const char * src, size_t sz, char * dest) const noexcept override;
 #ifdef VESPA_HWACCEL_TARGET_NAME
     const char* target_name() const noexcept override { return VESPA_HWACCEL_TARGET_NAME; }
 #endif
@@ -127,6 +127,12 @@ VESPA_HWACCEL_TARGET_TYPE::dotProduct(const int64_t * a, const int64_t * b, size
     return multiplyAdd<long long, int64_t, 8>(a, b, sz);
 }
 
+float
+VESPA_HWACCEL_TARGET_TYPE::dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept
+{
+    return helper::dotProductBFloat16<16>(a, b, sz);
+}
+
 void
 VESPA_HWACCEL_TARGET_TYPE::orBit(void * aOrg, const void * bOrg, size_t bytes) const noexcept
 {
@@ -183,6 +189,11 @@ VESPA_HWACCEL_TARGET_TYPE::squaredEuclideanDistance(const double * a, const doub
     return squaredEuclideanDistanceT<double, 16>(a, b, sz);
 }
 
+double
+VESPA_HWACCEL_TARGET_TYPE::squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept {
+    return helper::squaredEuclideanDistanceBFloat16<16>(a, b, sz);
+}
+
 void
 VESPA_HWACCEL_TARGET_TYPE::and128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept {
     helper::andChunks<16, 8>(offset, src, dest);
@@ -193,4 +204,9 @@ VESPA_HWACCEL_TARGET_TYPE::or128(size_t offset, const std::vector<std::pair<cons
     helper::orChunks<16, 8>(offset, src, dest);
 }
 
+size_t
+VESPA_HWACCEL_TARGET_TYPE::fold_ascii_word_chars(const char * src, size_t sz, char * dest) const noexcept {
+    return helper::fold_ascii_word_chars<16>(src, sz, dest);
+}
+
 } // vespalib::hwaccelerated
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/bfloat16.h>
 #include <memory>
 #include <cstdint>
 #include <vector>
@@ -23,6 +24,8 @@ public:
     virtual int64_t dotProduct(const int16_t * a, const int16_t * b, size_t sz) const noexcept = 0;
     virtual int64_t dotProduct(const int32_t * a, const int32_t * b, size_t sz) const noexcept = 0;
     virtual long long dotProduct(const int64_t * a, const int64_t * b, size_t sz) const noexcept = 0;
+    // Calculated directly on the bfloat16 cells, without converting the vectors to float first
+    virtual float dotProduct(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept = 0;
     virtual void orBit(void * a, const void * b, size_t bytes) const noexcept = 0;
     virtual void andBit(void * a, const void * b, size_t bytes) const noexcept = 0;
     virtual void andNotBit(void * a, const void * b, size_t bytes) const noexcept = 0;
@@ -32,10 +35,14 @@ public:
     virtual double squaredEuclideanDistance(const int8_t * a, const int8_t * b, size_t sz) const noexcept = 0;
     virtual double squaredEuclideanDistance(const float * a, const float * b, size_t sz) const noexcept = 0;
     virtual double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const noexcept = 0;
+    virtual double squaredEuclideanDistance(const BFloat16 * a, const BFloat16 * b, size_t sz) const noexcept = 0;
     // AND 128 bytes from multiple, optionally inverted sources
     virtual void and128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept = 0;
     // OR 128 bytes from multiple, optionally inverted sources
     virtual void or128(size_t offset, const std::vector<std::pair<const void *, bool>> &src, void *dest) const noexcept = 0;
+    // Lowercase ascii letters and keep digits, while all other ascii characters become '\0'.
+    // Stops at the first non-ascii byte and returns the number of bytes folded.
+    virtual size_t fold_ascii_word_chars(const char * src, size_t sz, char * dest) const noexcept = 0;
 
     // Returns a static string representing the name of the underlying accelerator implementation
     [[nodiscard]] virtual const char* target_name() const noexcept { return "Unknown"; }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/config.h>
+#include <vespa/vespalib/util/bfloat16.h>
 #include <bit>
 #include <cstring>
 
@@ -47,6 +48,30 @@ const T * cast(const void * ptr, size_t offsetBytes) {
     return static_cast<const T *>(static_cast<const void *>(static_cast<const char *>(ptr) + offsetBytes));
 }
 
+// Prefetch the next 128 bytes of a source while combining the current ones.
+// Hardware prefetchers track a limited number of streams, which is easily
+// exceeded when combining many bitvectors.
+inline void
+prefetchNextChunks(const void * base, size_t offset) {
+    const char * next = static_cast<const char *>(base) + offset + 128;
+    __builtin_prefetch(next);
+    __builtin_prefetch(next + 64);
+}
+
+template <typename Chunk, unsigned Chunks>
+bool
+allZero(const Chunk * chunk) {
+    Chunk acc = chunk[0];
+    for (size_t n = 1; n < Chunks; n++) {
+        acc |= chunk[n];
+    }
+    uint64_t bits = 0;
+    for (size_t i = 0; i < (sizeof(Chunk) / sizeof(uint64_t)); i++) {
+        bits |= acc[i];
+    }
+    return (bits == 0);
+}
+
 template<unsigned ChunkSize, unsigned Chunks>
 void
 andChunks(size_t offset, const std::vector<std::pair<const void *, bool>> & src, void * dest) {
@@ -55,11 +80,17 @@ andChunks(size_t offset, const std::vector<std::pair<const void *, bool>> & src,
     static_assert(ChunkSize * Chunks == 128, "ChunkSize*Chunks == 128");
     Chunk * chunk = static_cast<Chunk *>(dest);
     const Chunk * tmp = cast<Chunk, ChunkSize>(src[0].first, offset);
+    prefetchNextChunks(src[0].first, offset);
     for (size_t n=0; n < Chunks; n++) {
         chunk[n] = get<Chunk, ChunkSize>(tmp+n, src[0].second);
     }
     for (size_t i(1); i < src.size(); i++) {
+        // the remaining sources cannot change an empty result
+        if (__builtin_expect(allZero<Chunk, Chunks>(chunk), false)) {
+            return;
+        }
         tmp = cast<Chunk, ChunkSize>(src[i].first, offset);
+        prefetchNextChunks(src[i].first, offset);
         for (size_t n=0; n < Chunks; n++) {
             chunk[n] &= get<Chunk, ChunkSize>(tmp+n, src[i].second);
         }
@@ -74,11 +105,13 @@ orChunks(size_t offset, const std::vector<std::pair<const void *, bool>> &src, v
     static_assert(ChunkSize * Chunks == 128, "ChunkSize*Chunks == 128");
     Chunk * chunk = static_cast<Chunk *>(dest);
     const Chunk * tmp = cast<Chunk, ChunkSize>(src[0].first, offset);
+    prefetchNextChunks(src[0].first, offset);
     for (size_t n = 0; n < Chunks; n++) {
         chunk[n] = get<Chunk, ChunkSize>(tmp + n, src[0].second);
     }
     for (size_t i(1); i < src.size(); i++) {
         tmp = cast<Chunk, ChunkSize>(src[i].first, offset);
+        prefetchNextChunks(src[i].first, offset);
         for (size_t n = 0; n < Chunks; n++) {
             chunk[n] |= get<Chunk, ChunkSize>(tmp + n, src[i].second);
         }
@@ -121,6 +154,100 @@ convert_bfloat16_to_float(const uint16_t *src, float *dest, size_t sz) noexcept
     }
 }
 
+// lowercase ascii letters, keep digits and turn everything else into '\0'
+inline char
+fold_ascii_word_char(uint8_t c) noexcept {
+    uint8_t low = c | 0x20;
+    bool is_letter = (uint8_t(low - 'a') < 26);
+    bool is_digit = (uint8_t(c - '0') < 10);
+    return is_letter ? low : (is_digit ? c : 0);
+}
+
+template <unsigned BLOCK>
+size_t
+fold_ascii_word_chars(const char *src, size_t sz, char *dest) noexcept {
+    const auto *s = reinterpret_cast<const uint8_t *>(src);
+    size_t i(0);
+    for (; i + BLOCK <= sz; i += BLOCK) {
+        uint8_t high(0);
+        for (unsigned j(0); j < BLOCK; j++) {
+            high |= s[i + j];
+        }
+        if (high & 0x80) [[unlikely]] {
+            break;
+        }
+        for (unsigned j(0); j < BLOCK; j++) {
+            dest[i + j] = fold_ascii_word_char(s[i + j]);
+        }
+    }
+    for (; i < sz; i++) {
+        if (s[i] & 0x80) {
+            return i;
+        }
+        dest[i] = fold_ascii_word_char(s[i]);
+    }
+    return sz;
+}
+
+inline float
+bfloat16_to_float(const BFloat16 &value) noexcept {
+    return std::bit_cast<float>(uint32_t(value.get_bits()) << 16);
+}
+
+/*
+ * The bfloat16 kernels widen each cell to float on the fly, and keep UNROLL
+ * independent float partial sums. This lets the compiler use the widest
+ * vector registers of the target for both the widening and the fused
+ * multiply-add, instead of converting the vectors through a temporary buffer.
+ */
+template <size_t UNROLL>
+float
+dotProductBFloat16(const BFloat16 *a, const BFloat16 *b, size_t sz) noexcept {
+    float partial[UNROLL];
+    for (size_t j(0); j < UNROLL; j++) {
+        partial[j] = 0.0f;
+    }
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            partial[j] += bfloat16_to_float(a[i + j]) * bfloat16_to_float(b[i + j]);
+        }
+    }
+    for (; i < sz; i++) {
+        partial[i % UNROLL] += bfloat16_to_float(a[i]) * bfloat16_to_float(b[i]);
+    }
+    float sum(0.0f);
+    for (size_t j(0); j < UNROLL; j++) {
+        sum += partial[j];
+    }
+    return sum;
+}
+
+template <size_t UNROLL>
+double
+squaredEuclideanDistanceBFloat16(const BFloat16 *a, const BFloat16 *b, size_t sz) noexcept {
+    float partial[UNROLL];
+    for (size_t j(0); j < UNROLL; j++) {
+        partial[j] = 0.0f;
+    }
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            float d = bfloat16_to_float(a[i + j]) - bfloat16_to_float(b[i + j]);
+            partial[j] += d * d;
+        }
+    }
+    for (; i < sz; i++) {
+        float d = bfloat16_to_float(a[i]) - bfloat16_to_float(b[i]);
+        partial[i % UNROLL] += d * d;
+    }
+    double sum(0.0);
+    for (size_t j(0); j < UNROLL; j++) {
+        sum += partial[j];
+    }
+    return sum;
+}
+
 template<typename ACCUM = uint32_t>
 ACCUM
 multiplyAddT(const int8_t *a, const int8_t *b, size_t sz) noexcept __attribute__((noinline));
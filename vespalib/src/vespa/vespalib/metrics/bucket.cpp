@@ -84,7 +84,7 @@ findMissing(const std::vector<T> &already,
 void Bucket::merge(const CurrentSamples &samples)
 {
     counters = mergeFromSamples<Counter>(samples.counterIncrements);
-    gauges = mergeFromSamples<Gauge>(samples.gaugeMeasurements);
+    gauges = mergeVectors(mergeFromSamples<Gauge>(samples.gaugeMeasurements), samples.gaugeCellTotals);
 }
 
 void Bucket::merge(const Bucket &other)
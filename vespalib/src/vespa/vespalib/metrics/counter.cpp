@@ -14,5 +14,14 @@ Counter::add(size_t count, Point point) const
     }
 }
 
+Counter::Cell
+Counter::cell(Point point) const
+{
+    if (_manager) {
+        return Cell(_manager->counterCell(std::make_pair(_id, point)));
+    }
+    return Cell();
+}
+
 } // namespace vespalib::metrics
 } // namespace vespalib
@@ -4,6 +4,7 @@
 #include <memory>
 #include "metric_id.h"
 #include "point.h"
+#include "sharded_cells.h"
 
 namespace vespalib {
 namespace metrics {
@@ -40,6 +41,29 @@ public:
      **/
     void add(size_t count, Point p) const;
 
+    /**
+     * Handle to a single point of a counter, for use on hot paths.
+     * Increments are recorded in per-thread shards without locking
+     * and are only aggregated when samples are collected.
+     **/
+    class Cell {
+        std::shared_ptr<CounterCell> _cell;
+    public:
+        Cell() noexcept : _cell() {}
+        explicit Cell(std::shared_ptr<CounterCell> cell) noexcept : _cell(std::move(cell)) {}
+        void add(size_t count = 1) const noexcept {
+            if (_cell) {
+                _cell->add(count);
+            }
+        }
+    };
+
+    /**
+     * Get or create a cell for the given point of this counter.
+     * @param p the point representing labels for increments of the cell (default empty)
+     **/
+    Cell cell(Point p = Point::empty) const;
+
     // internal
     struct Increment {
         using Key = std::pair<MetricId, Point>;
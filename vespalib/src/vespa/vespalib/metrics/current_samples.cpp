@@ -6,6 +6,9 @@ namespace metrics {
 
 using Guard = std::lock_guard<std::mutex>;
 
+CurrentSamples::CurrentSamples() = default;
+CurrentSamples::~CurrentSamples() = default;
+
 void
 CurrentSamples::add(Counter::Increment inc)
 {
@@ -20,12 +23,52 @@ CurrentSamples::sample(Gauge::Measurement value)
     gaugeMeasurements.add(value);
 }
 
+std::shared_ptr<CounterCell>
+CurrentSamples::counterCell(CounterCell::Key key)
+{
+    Guard guard(lock);
+    auto &cell = counterCells[key];
+    if (!cell) {
+        cell = std::make_shared<CounterCell>(key);
+    }
+    return cell;
+}
+
+std::shared_ptr<GaugeCell>
+CurrentSamples::gaugeCell(GaugeCell::Key key)
+{
+    Guard guard(lock);
+    auto &cell = gaugeCells[key];
+    if (!cell) {
+        cell = std::make_shared<GaugeCell>(key);
+    }
+    return cell;
+}
+
 void
 CurrentSamples::extract(CurrentSamples &into)
 {
     Guard guard(lock);
     swap(into.counterIncrements, counterIncrements);
     swap(into.gaugeMeasurements, gaugeMeasurements);
+    for (const auto & [key, cell] : counterCells) {
+        size_t count = cell->drain();
+        if (count != 0) {
+            into.counterIncrements.add(Counter::Increment(key, count));
+        }
+    }
+    into.gaugeCellTotals.clear();
+    for (const auto & [key, cell] : gaugeCells) {
+        auto totals = cell->drain();
+        if (totals.count != 0) {
+            GaugeAggregator aggr(Gauge::Measurement(key, totals.last));
+            aggr.observedCount = totals.count;
+            aggr.sumValue = totals.sum;
+            aggr.minValue = totals.min;
+            aggr.maxValue = totals.max;
+            into.gaugeCellTotals.push_back(aggr);
+        }
+    }
 }
 
 } // namespace vespalib::metrics
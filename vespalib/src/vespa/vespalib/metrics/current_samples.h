@@ -1,10 +1,14 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <map>
+#include <memory>
 #include <mutex>
+#include <vector>
 #include "stable_store.h"
 #include "counter.h"
 #include "gauge.h"
+#include "gauge_aggregator.h"
 
 namespace vespalib {
 namespace metrics {
@@ -14,11 +18,19 @@ struct CurrentSamples {
     std::mutex lock;
     StableStore<Counter::Increment> counterIncrements;
     StableStore<Gauge::Measurement> gaugeMeasurements;
+    // sharded cells, drained into the samples above by extract
+    std::map<CounterCell::Key, std::shared_ptr<CounterCell>> counterCells;
+    std::map<GaugeCell::Key, std::shared_ptr<GaugeCell>> gaugeCells;
+    // gauge cell totals taken by extract, sorted by key
+    std::vector<GaugeAggregator> gaugeCellTotals;
 
-    ~CurrentSamples() {}
+    CurrentSamples();
+    ~CurrentSamples();
 
     void add(Counter::Increment inc);
     void sample(Gauge::Measurement value);
+    std::shared_ptr<CounterCell> counterCell(CounterCell::Key key);
+    std::shared_ptr<GaugeCell> gaugeCell(GaugeCell::Key key);
     void extract(CurrentSamples &into);
 };
 
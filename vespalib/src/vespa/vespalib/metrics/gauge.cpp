@@ -13,5 +13,14 @@ Gauge::sample(double value, Point point) const
     }
 }
 
+Gauge::Cell
+Gauge::cell(Point point) const
+{
+    if (_manager) {
+        return Cell(_manager->gaugeCell(std::make_pair(_id, point)));
+    }
+    return Cell();
+}
+
 } // namespace vespalib::metrics
 } // namespace vespalib
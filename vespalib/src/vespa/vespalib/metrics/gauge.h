@@ -4,6 +4,7 @@
 #include <memory>
 #include "metric_id.h"
 #include "point.h"
+#include "sharded_cells.h"
 
 namespace vespalib {
 namespace metrics {
@@ -30,6 +31,29 @@ public:
      **/
     void sample(double value, Point p = Point::empty) const;
 
+    /**
+     * Handle to a single point of a gauge, for use on hot paths.
+     * Measurements are aggregated in per-thread shards without
+     * locking and are only merged when samples are collected.
+     **/
+    class Cell {
+        std::shared_ptr<GaugeCell> _cell;
+    public:
+        Cell() noexcept : _cell() {}
+        explicit Cell(std::shared_ptr<GaugeCell> cell) noexcept : _cell(std::move(cell)) {}
+        void sample(double value) const noexcept {
+            if (_cell) {
+                _cell->sample(value);
+            }
+        }
+    };
+
+    /**
+     * Get or create a cell for the given point of this gauge.
+     * @param p the point representing labels for samples of the cell (default empty)
+     **/
+    Cell cell(Point p = Point::empty) const;
+
     // internal
     struct Measurement {
         using Key = std::pair<MetricId, Point>;
@@ -83,6 +83,12 @@ public:
 
     // for use from Gauge only
     virtual void sample(Gauge::Measurement value) = 0;
+
+    // for use from Counter only; may return nullptr to discard increments
+    virtual std::shared_ptr<CounterCell> counterCell(CounterCell::Key) { return {}; }
+
+    // for use from Gauge only; may return nullptr to discard samples
+    virtual std::shared_ptr<GaugeCell> gaugeCell(GaugeCell::Key) { return {}; }
 };
 
 
@@ -0,0 +1,54 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "sharded_cells.h"
+#include <algorithm>
+
+namespace vespalib::metrics {
+
+namespace sharded {
+
+namespace {
+
+std::atomic<size_t> next_shard(0);
+
+}
+
+size_t
+my_shard() noexcept
+{
+    thread_local size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % num_shards;
+    return shard;
+}
+
+}
+
+size_t
+CounterCell::drain() noexcept
+{
+    size_t sum = 0;
+    for (auto &shard: shards) {
+        if (shard.count.load(std::memory_order_relaxed) != 0) {
+            sum += shard.count.exchange(0, std::memory_order_relaxed);
+        }
+    }
+    return sum;
+}
+
+GaugeCell::Totals
+GaugeCell::drain() noexcept
+{
+    Totals result;
+    for (auto &shard: shards) {
+        size_t count = shard.count.exchange(0, std::memory_order_acquire);
+        if (count == 0) {
+            continue;
+        }
+        result.count += count;
+        result.sum += shard.sum.exchange(0.0, std::memory_order_relaxed);
+        result.min = std::min(result.min, shard.min.exchange(std::numeric_limits<double>::infinity(), std::memory_order_relaxed));
+        result.max = std::max(result.max, shard.max.exchange(-std::numeric_limits<double>::infinity(), std::memory_order_relaxed));
+        result.last = shard.last.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+}
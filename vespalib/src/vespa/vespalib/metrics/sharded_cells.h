@@ -0,0 +1,84 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "metric_id.h"
+#include "point.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace vespalib::metrics {
+
+// internal
+namespace sharded {
+
+constexpr size_t num_shards = 16;
+
+// shard used by the calling thread; threads are assigned shards in turn
+size_t my_shard() noexcept;
+
+}
+
+/**
+ * Counter value for a single (metric, point) pair, split into shards
+ * on separate cache lines so that threads updating it do not contend.
+ * The shards are summed (and reset) only when the metrics manager
+ * collects samples.
+ **/
+struct CounterCell {
+    using Key = std::pair<MetricId, Point>;
+    struct alignas(64) Shard {
+        std::atomic<size_t> count{0};
+    };
+    const Key idx;
+    std::array<Shard, sharded::num_shards> shards;
+
+    explicit CounterCell(Key key) noexcept : idx(key), shards() {}
+    void add(size_t count) noexcept {
+        shards[sharded::my_shard()].count.fetch_add(count, std::memory_order_relaxed);
+    }
+    size_t drain() noexcept;
+};
+
+/**
+ * Gauge measurements for a single (metric, point) pair, aggregated
+ * per shard in the same way as GaugeAggregator. Measurements
+ * recorded while the cell is drained may be split between two
+ * collection intervals.
+ **/
+struct GaugeCell {
+    using Key = std::pair<MetricId, Point>;
+    struct alignas(64) Shard {
+        std::atomic<size_t> count{0};
+        std::atomic<double> sum{0.0};
+        std::atomic<double> min{std::numeric_limits<double>::infinity()};
+        std::atomic<double> max{-std::numeric_limits<double>::infinity()};
+        std::atomic<double> last{0.0};
+    };
+    struct Totals {
+        size_t count = 0;
+        double sum = 0.0;
+        double min = std::numeric_limits<double>::infinity();
+        double max = -std::numeric_limits<double>::infinity();
+        double last = 0.0;
+    };
+    const Key idx;
+    std::array<Shard, sharded::num_shards> shards;
+
+    explicit GaugeCell(Key key) noexcept : idx(key), shards() {}
+    void sample(double value) noexcept {
+        Shard &shard = shards[sharded::my_shard()];
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+        double seen = shard.min.load(std::memory_order_relaxed);
+        while (value < seen && !shard.min.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+        seen = shard.max.load(std::memory_order_relaxed);
+        while (value > seen && !shard.max.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+        shard.last.store(value, std::memory_order_relaxed);
+        shard.count.fetch_add(1, std::memory_order_release);
+    }
+    Totals drain() noexcept;
+};
+
+}
@@ -82,6 +82,12 @@ public:
     void sample(Gauge::Measurement value) override {
         _currentSamples.sample(value);
     }
+    std::shared_ptr<CounterCell> counterCell(CounterCell::Key key) override {
+        return _currentSamples.counterCell(key);
+    }
+    std::shared_ptr<GaugeCell> gaugeCell(GaugeCell::Key key) override {
+        return _currentSamples.gaugeCell(key);
+    }
 };
 
 } // namespace vespalib::metrics
@@ -33,6 +33,9 @@ public:
     ssize_t flush() override { return 0; }
     ssize_t half_close() override { return _socket.half_close(); }
     void drop_empty_buffers() override {}
+    bool enable_zero_copy() override { return _socket.set_zero_copy(true); }
+    ssize_t write_zero_copy(const char *buf, size_t len) override { return _socket.write_zero_copy(buf, len); }
+    size_t reap_zero_copy_completions() override { return _socket.reap_zero_copy_completions(); }
 };
 
     NullCryptoSocket::~NullCryptoSocket() = default;
@@ -7,6 +7,24 @@ namespace vespalib {
 
 CryptoSocket::~CryptoSocket() = default;
 
+bool
+CryptoSocket::enable_zero_copy()
+{
+    return false;
+}
+
+ssize_t
+CryptoSocket::write_zero_copy(const char *buf, size_t len)
+{
+    return write(buf, len);
+}
+
+size_t
+CryptoSocket::reap_zero_copy_completions()
+{
+    return 0;
+}
+
 std::unique_ptr<net::ConnectionAuthContext>
 CryptoSocket::make_auth_context()
 {
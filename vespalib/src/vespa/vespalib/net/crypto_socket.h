@@ -145,6 +145,34 @@ struct CryptoSocket {
      **/
     virtual void drop_empty_buffers() = 0;
 
+    /**
+     * Try to enable zero-copy writes (see write_zero_copy). Returns
+     * false if not supported, which is always the case when data is
+     * transformed (encrypted) before being written to the underlying
+     * socket. The default implementation returns false.
+     **/
+    virtual bool enable_zero_copy();
+
+    /**
+     * Like write, but the kernel may transmit data directly from the
+     * application buffer instead of copying it. Each successful call
+     * counts as a single zero-copy write, and the written part of the
+     * buffer MUST be left untouched until the write has been reported
+     * as completed by reap_zero_copy_completions. Zero-copy writes
+     * are completed in the order they were made. Must only be called
+     * after enable_zero_copy returned true.
+     **/
+    virtual ssize_t write_zero_copy(const char *buf, size_t len);
+
+    /**
+     * Returns the number of zero-copy writes completed since the
+     * previous call. Pending completions make the underlying socket
+     * report an error event; the application should reap completions
+     * whenever it gets an event for a socket with zero-copy writes in
+     * flight.
+     **/
+    virtual size_t reap_zero_copy_completions();
+
     /**
      * If the underlying transport channel supports authn/authz,
      * returns a new ConnectionAuthContext object containing the verified
@@ -29,6 +29,10 @@ public:
     ~HttpServer();
     const std::string &host() const { return _server->my_host(); }
     JsonHandlerRepo &repo() { return _handler_repo; }
+    // bind a handler that responds on its own, bypassing the json handler repo
+    Portal::Token::UP bind(const std::string &path_prefix, Portal::GetHandler &handler) {
+        return _server->bind(path_prefix, handler);
+    }
     int port() const { return _server->listen_port(); }
 };
 
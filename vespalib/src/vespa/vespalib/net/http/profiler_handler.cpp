@@ -0,0 +1,83 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "profiler_handler.h"
+#include <vespa/vespalib/util/sampling_profiler.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+namespace vespalib {
+
+namespace {
+
+double get_number_param(const Portal::GetRequest &req, const std::string &name, double default_value) {
+    if (!req.has_param(name)) {
+        return default_value;
+    }
+    return strtod(req.get_param(name).c_str(), nullptr);
+}
+
+}
+
+void
+ProfilerHandler::run(Portal::GetRequest req, double seconds, uint32_t frequency, bool tag_with_category)
+{
+    SamplingProfiler profiler(frequency, tag_with_category);
+    if (!profiler.active()) {
+        req.respond_with_error(503, "Another profiler is already running");
+    } else {
+        {
+            std::unique_lock guard(_lock);
+            _cond.wait_for(guard, std::chrono::duration<double>(seconds), [this]{ return _closed; });
+        }
+        auto result = profiler.stop();
+        if (result.dropped > 0) {
+            result.folded.append(make_string("[dropped] %zu\n", result.dropped));
+        }
+        req.respond_with_content("text/plain", result.folded);
+    }
+    std::lock_guard guard(_lock);
+    _busy = false;
+}
+
+ProfilerHandler::ProfilerHandler()
+    : _lock(),
+      _cond(),
+      _busy(false),
+      _closed(false),
+      _thread()
+{
+}
+
+ProfilerHandler::~ProfilerHandler()
+{
+    {
+        std::lock_guard guard(_lock);
+        _closed = true;
+    }
+    _cond.notify_all();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void
+ProfilerHandler::get(Portal::GetRequest req)
+{
+    double seconds = std::clamp(get_number_param(req, "seconds", 10.0), 0.0, 60.0);
+    uint32_t frequency = std::clamp(get_number_param(req, "frequency", 99.0), 1.0, 1000.0);
+    bool tag_with_category = req.has_param("tag") && (req.get_param("tag") == "category");
+    std::lock_guard guard(_lock);
+    if (_busy || _closed) {
+        req.respond_with_error(503, "A profile is already being taken");
+        return;
+    }
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    _busy = true;
+    _thread = std::thread(&ProfilerHandler::run, this, std::move(req), seconds, frequency, tag_with_category);
+}
+
+} // namespace vespalib
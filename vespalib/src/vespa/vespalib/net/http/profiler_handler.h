@@ -0,0 +1,39 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/portal/portal.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace vespalib {
+
+/**
+ * Serves CPU profiles of the current process taken with the
+ * SamplingProfiler, as folded stacks in text/plain. Since a profile
+ * takes a while, it is taken in a separate thread, and only one
+ * profile can be taken at a time. Parameters:
+ *
+ *   seconds:   how long to profile (default 10, max 60)
+ *   frequency: samples per second of CPU time (default 99, max 1000)
+ *   tag:       use 'category' to tag samples with the CpuUsage
+ *              category of the sampled thread
+ **/
+class ProfilerHandler : public Portal::GetHandler
+{
+private:
+    std::mutex              _lock;
+    std::condition_variable _cond;
+    bool                    _busy;
+    bool                    _closed;
+    std::thread             _thread;
+
+    void run(Portal::GetRequest req, double seconds, uint32_t frequency, bool tag_with_category);
+public:
+    ProfilerHandler();
+    ~ProfilerHandler() override;
+    void get(Portal::GetRequest req) override;
+};
+
+} // namespace vespalib
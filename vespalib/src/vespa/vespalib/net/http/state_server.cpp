@@ -10,10 +10,13 @@ StateServer::StateServer(int port,
                          ComponentConfigProducer &ccp)
     : _api(hp, mp, ccp),
       _server(port),
-      _tokens()
+      _tokens(),
+      _profiler(),
+      _profiler_token(_server.bind("/state/v1/profile", _profiler))
 {
     _tokens.push_back(_server.repo().bind("/state/v1", _api));
     _tokens.push_back(_server.repo().bind("/metrics/total", _api));
+    _tokens.push_back(_api.repo().add_root_resource("/state/v1/profile"));
 }
 
 StateServer::~StateServer() = default;
@@ -9,6 +9,7 @@
 #include "metrics_producer.h"
 #include "component_config_producer.h"
 #include "json_handler_repo.h"
+#include "profiler_handler.h"
 
 namespace vespalib {
 
@@ -22,6 +23,8 @@ private:
     StateApi _api;
     HttpServer _server;
     std::vector<JsonHandlerRepo::Token::UP> _tokens;
+    ProfilerHandler _profiler;
+    Portal::Token::UP _profiler_token;
 
 public:
     using UP = std::unique_ptr<StateServer>;
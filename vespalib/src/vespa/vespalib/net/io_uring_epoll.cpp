@@ -0,0 +1,206 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "io_uring_epoll.h"
+#include <vespa/config.h>
+#include <vespa/log/log.h>
+
+#ifdef VESPA_HAS_IO_URING
+
+#include <liburing.h>
+#include <cassert>
+#include <unordered_map>
+
+namespace vespalib {
+
+namespace {
+
+constexpr unsigned ring_entries = 4096;
+constexpr uint64_t ignored_token = 0;
+
+uint32_t maybe(uint32_t value, bool yes) { return yes ? value : 0; }
+
+}
+
+struct IoUringEpoll::Impl {
+    struct Entry {
+        void     *ctx;
+        uint32_t  mask;
+        uint64_t  token; // identifies the current poll request for the fd
+        bool      armed;
+    };
+
+    io_uring                          ring;
+    std::unordered_map<int, Entry>    entries; // by fd
+    std::unordered_map<uint64_t, int> tokens;  // current token -> fd
+    uint64_t                          last_token;
+
+    Impl() : ring(), entries(), tokens(), last_token(ignored_token) {
+        int res = io_uring_queue_init(ring_entries, &ring, 0);
+        assert(res == 0);
+        (void) res;
+    }
+    ~Impl() {
+        io_uring_queue_exit(&ring);
+    }
+    io_uring_sqe *get_sqe() {
+        io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+        while (sqe == nullptr) {
+            // submission queue is full; hand queued requests to the kernel
+            io_uring_submit(&ring);
+            sqe = io_uring_get_sqe(&ring);
+        }
+        return sqe;
+    }
+    void arm(int fd, Entry &entry) {
+        auto *sqe = get_sqe();
+        io_uring_prep_poll_add(sqe, fd, entry.mask);
+        io_uring_sqe_set_data64(sqe, entry.token);
+        entry.armed = true;
+    }
+    void disarm(Entry &entry) {
+        tokens.erase(entry.token);
+        if (entry.armed) {
+            auto *sqe = get_sqe();
+            io_uring_prep_poll_remove(sqe, entry.token);
+            io_uring_sqe_set_data64(sqe, ignored_token);
+            entry.armed = false;
+        }
+    }
+    void assign(int fd, Entry &entry, void *ctx, uint32_t mask) {
+        entry.ctx = ctx;
+        entry.mask = mask;
+        entry.token = ++last_token;
+        tokens[entry.token] = fd;
+        if (mask != 0) {
+            arm(fd, entry);
+        }
+    }
+    void submit_and_wait(int timeout_ms) {
+        if ((timeout_ms == 0) || (io_uring_cq_ready(&ring) > 0)) {
+            io_uring_submit(&ring);
+        } else if (timeout_ms < 0) {
+            io_uring_submit_and_wait(&ring, 1);
+        } else {
+            __kernel_timespec ts;
+            ts.tv_sec = timeout_ms / 1000;
+            ts.tv_nsec = (timeout_ms % 1000) * 1000000L;
+            io_uring_cqe *cqe = nullptr;
+            io_uring_submit_and_wait_timeout(&ring, &cqe, 1, &ts, nullptr);
+        }
+    }
+    size_t extract(epoll_event *events, size_t max_events) {
+        size_t num_events = 0;
+        unsigned num_seen = 0;
+        unsigned head;
+        io_uring_cqe *cqe;
+        io_uring_for_each_cqe(&ring, head, cqe) {
+            if (num_events == max_events) {
+                break;
+            }
+            ++num_seen;
+            auto token = tokens.find(io_uring_cqe_get_data64(cqe));
+            if (token == tokens.end()) {
+                continue; // stale poll completion or poll removal result
+            }
+            int fd = token->second;
+            Entry &entry = entries.find(fd)->second;
+            entry.armed = false;
+            events[num_events].events = (cqe->res < 0) ? uint32_t(EPOLLERR) : uint32_t(cqe->res);
+            events[num_events].data.ptr = entry.ctx;
+            ++num_events;
+            // re-armed requests complete right away (on the next
+            // submit) if the fd is still ready, like with level
+            // triggered epoll
+            arm(fd, entry);
+        }
+        io_uring_cq_advance(&ring, num_seen);
+        return num_events;
+    }
+};
+
+IoUringEpoll::IoUringEpoll()
+    : _impl(std::make_unique<Impl>())
+{
+}
+
+IoUringEpoll::~IoUringEpoll() = default;
+
+bool
+IoUringEpoll::is_supported()
+{
+    io_uring_probe *probe = io_uring_get_probe();
+    bool supported = (probe != nullptr)
+                     && io_uring_opcode_supported(probe, IORING_OP_POLL_ADD)
+                     && io_uring_opcode_supported(probe, IORING_OP_POLL_REMOVE);
+    if (probe != nullptr) {
+        io_uring_free_probe(probe);
+    }
+    return supported;
+}
+
+void
+IoUringEpoll::add(int fd, void *ctx, bool read, bool write)
+{
+    auto [pos, inserted] = _impl->entries.try_emplace(fd, Impl::Entry{nullptr, 0, ignored_token, false});
+    assert(inserted);
+    (void) inserted;
+    _impl->assign(fd, pos->second, ctx, maybe(EPOLLIN, read) | maybe(EPOLLOUT, write));
+}
+
+void
+IoUringEpoll::update(int fd, void *ctx, bool read, bool write)
+{
+    auto pos = _impl->entries.find(fd);
+    assert(pos != _impl->entries.end());
+    Impl::Entry &entry = pos->second;
+    uint32_t mask = maybe(EPOLLIN, read) | maybe(EPOLLOUT, write);
+    if (mask == entry.mask) {
+        entry.ctx = ctx;
+        return;
+    }
+    _impl->disarm(entry);
+    _impl->assign(fd, entry, ctx, mask);
+}
+
+void
+IoUringEpoll::remove(int fd)
+{
+    auto pos = _impl->entries.find(fd);
+    if (pos != _impl->entries.end()) {
+        _impl->disarm(pos->second);
+        _impl->entries.erase(pos);
+    }
+}
+
+size_t
+IoUringEpoll::wait(epoll_event *events, size_t max_events, int timeout_ms)
+{
+    _impl->submit_and_wait(timeout_ms);
+    return _impl->extract(events, max_events);
+}
+
+}
+
+#else // VESPA_HAS_IO_URING
+
+namespace vespalib {
+
+struct IoUringEpoll::Impl {};
+
+IoUringEpoll::IoUringEpoll()
+    : _impl()
+{
+    LOG_ABORT("should not be reached: io_uring is not supported by this build");
+}
+
+IoUringEpoll::~IoUringEpoll() = default;
+
+bool IoUringEpoll::is_supported() { return false; }
+void IoUringEpoll::add(int, void *, bool, bool) {}
+void IoUringEpoll::update(int, void *, bool, bool) {}
+void IoUringEpoll::remove(int) {}
+size_t IoUringEpoll::wait(epoll_event *, size_t, int) { return 0; }
+
+}
+
+#endif // VESPA_HAS_IO_URING
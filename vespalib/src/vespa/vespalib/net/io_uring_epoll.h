@@ -0,0 +1,46 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#ifdef __APPLE__
+#include "emulated_epoll.h"
+#else
+#include "native_epoll.h"
+#endif
+#include <memory>
+
+namespace vespalib {
+
+/**
+ * Drop-in replacement for the Epoll class using io_uring poll
+ * requests to obtain readiness events. Registrations are not
+ * performed immediately; they are queued as submission entries and
+ * handed to the kernel together with the wait for completions,
+ * resulting in a single system call per call to wait, regardless of
+ * how many file descriptors were added, updated or removed.
+ *
+ * Poll requests are one-shot and re-armed when their completion is
+ * extracted, which gives the same level-triggered semantics as the
+ * Epoll class. Stale completions (for file descriptors that have
+ * since been updated or removed) are discarded.
+ *
+ * Only available when compiled with io_uring support; check with
+ * is_supported() before creating an instance. Not thread safe;
+ * add/update/remove/wait must all be called by the same thread.
+ **/
+class IoUringEpoll
+{
+private:
+    struct Impl;
+    std::unique_ptr<Impl> _impl;
+public:
+    IoUringEpoll();
+    ~IoUringEpoll();
+    static bool is_supported();
+    void add(int fd, void *ctx, bool read, bool write);
+    void update(int fd, void *ctx, bool read, bool write);
+    void remove(int fd);
+    size_t wait(epoll_event *events, size_t max_events, int timeout_ms);
+};
+
+}
@@ -8,6 +8,8 @@
 #else
 #include "native_epoll.h"
 #endif
+#include "io_uring_epoll.h"
+#include <memory>
 #include <vector>
 
 namespace vespalib {
@@ -22,7 +24,8 @@ private:
     size_t                   _num_events;
 public:
     EpollEvents(size_t max_events) : _epoll_events(max_events), _num_events(0) {}
-    void extract(Epoll &epoll, int timeout_ms) {
+    template <typename Poller>
+    void extract(Poller &epoll, int timeout_ms) {
         _num_events = epoll.wait(&_epoll_events[0], _epoll_events.size(), timeout_ms);
     }
     const epoll_event *begin() const { return &_epoll_events[0]; }
@@ -33,27 +36,69 @@ public:
 //-----------------------------------------------------------------------------
 enum class SelectorDispatchResult {WAKEUP_CALLED, NO_WAKEUP};
 
+/**
+ * Which mechanism a Selector uses to wait for events. IO_URING falls
+ * back to EPOLL when io_uring is not supported. Note that with
+ * IO_URING, add/update/remove take effect on the next call to poll
+ * and must be called by the thread doing the polling.
+ **/
+enum class SelectorBackend {EPOLL, IO_URING};
+
 template <typename Context>
 class Selector
 {
 private:
-    Epoll       _epoll;
-    WakeupPipe  _wakeup_pipe;
-    EpollEvents _events;
+    Epoll                         _epoll;
+    std::unique_ptr<IoUringEpoll> _uring;
+    WakeupPipe                    _wakeup_pipe;
+    EpollEvents                   _events;
+
+    static std::unique_ptr<IoUringEpoll> make_uring(SelectorBackend backend) {
+        if ((backend == SelectorBackend::IO_URING) && IoUringEpoll::is_supported()) {
+            return std::make_unique<IoUringEpoll>();
+        }
+        return {};
+    }
+    void add_ptr(int fd, void *ctx, bool read, bool write) {
+        if (_uring) {
+            _uring->add(fd, ctx, read, write);
+        } else {
+            _epoll.add(fd, ctx, read, write);
+        }
+    }
 public:
-    Selector()
-        : _epoll(), _wakeup_pipe(), _events(4096)
+    Selector(SelectorBackend backend = SelectorBackend::EPOLL)
+        : _epoll(), _uring(make_uring(backend)), _wakeup_pipe(), _events(4096)
     {
-        _epoll.add(_wakeup_pipe.get_read_fd(), nullptr, true, false);
+        add_ptr(_wakeup_pipe.get_read_fd(), nullptr, true, false);
     }
     ~Selector() {
-        _epoll.remove(_wakeup_pipe.get_read_fd());
+        remove(_wakeup_pipe.get_read_fd());
+    }
+    SelectorBackend backend() const { return _uring ? SelectorBackend::IO_URING : SelectorBackend::EPOLL; }
+    void add(int fd, Context &ctx, bool read, bool write) { add_ptr(fd, &ctx, read, write); }
+    void update(int fd, Context &ctx, bool read, bool write) {
+        if (_uring) {
+            _uring->update(fd, &ctx, read, write);
+        } else {
+            _epoll.update(fd, &ctx, read, write);
+        }
+    }
+    void remove(int fd) {
+        if (_uring) {
+            _uring->remove(fd);
+        } else {
+            _epoll.remove(fd);
+        }
     }
-    void add(int fd, Context &ctx, bool read, bool write) { _epoll.add(fd, &ctx, read, write); }
-    void update(int fd, Context &ctx, bool read, bool write) { _epoll.update(fd, &ctx, read, write); }
-    void remove(int fd) { _epoll.remove(fd); }
     void wakeup() { _wakeup_pipe.write_token(); }
-    void poll(int timeout_ms) { _events.extract(_epoll, timeout_ms); }
+    void poll(int timeout_ms) {
+        if (_uring) {
+            _events.extract(*_uring, timeout_ms);
+        } else {
+            _events.extract(_epoll, timeout_ms);
+        }
+    }
     size_t num_events() const { return _events.size(); }
     template <typename Handler>
     SelectorDispatchResult dispatch(Handler &handler) {
@@ -4,6 +4,11 @@
 #include <sys/socket.h>
 #include <errno.h>
 #include <cassert>
+#include <cstring>
+#ifdef __linux__
+#include <netinet/in.h>
+#include <linux/errqueue.h>
+#endif
 
 namespace vespalib {
 
@@ -40,6 +45,55 @@ SocketHandle::write(const char *buf, size_t len)
     }
 }
 
+ssize_t
+SocketHandle::write_zero_copy(const char *buf, size_t len)
+{
+#if defined(__linux__) && defined(MSG_ZEROCOPY)
+    for (;;) {
+        ssize_t result = ::send(_fd, buf, len, MSG_ZEROCOPY);
+        if ((result >= 0) || (errno != EINTR)) {
+            return result;
+        }
+    }
+#else
+    return write(buf, len);
+#endif
+}
+
+size_t
+SocketHandle::reap_zero_copy_completions()
+{
+    size_t completed = 0;
+#if defined(__linux__) && defined(MSG_ZEROCOPY)
+    for (;;) {
+        char control[128];
+        msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        if (::recvmsg(_fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return completed; // typically EAGAIN; error queue is empty
+        }
+        for (cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm != nullptr; cm = CMSG_NXTHDR(&msg, cm)) {
+            if (((cm->cmsg_level == SOL_IP) && (cm->cmsg_type == IP_RECVERR)) ||
+                ((cm->cmsg_level == SOL_IPV6) && (cm->cmsg_type == IPV6_RECVERR)))
+            {
+                sock_extended_err err;
+                memcpy(&err, CMSG_DATA(cm), sizeof(err));
+                if ((err.ee_errno == 0) && (err.ee_origin == SO_EE_ORIGIN_ZEROCOPY)) {
+                    // inclusive range of completed write sequence numbers
+                    completed += (uint32_t(err.ee_data - err.ee_info) + 1);
+                }
+            }
+        }
+    }
+#endif
+    return completed;
+}
+
 SocketHandle
 SocketHandle::accept()
 {
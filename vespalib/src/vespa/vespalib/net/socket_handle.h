@@ -50,9 +50,14 @@ public:
     bool set_ipv6_only(bool value) { return SocketOptions::set_ipv6_only(_fd, value); }
     bool set_keepalive(bool value) { return SocketOptions::set_keepalive(_fd, value); }
     bool set_linger(bool enable, int value) { return SocketOptions::set_linger(_fd, enable, value); }
+    bool set_zero_copy(bool value) { return SocketOptions::set_zero_copy(_fd, value); }
 
     ssize_t read(char *buf, size_t len);
     ssize_t write(const char *buf, size_t len);
+    // MSG_ZEROCOPY write; requires set_zero_copy(true) to have succeeded
+    ssize_t write_zero_copy(const char *buf, size_t len);
+    // number of zero-copy writes completed since last call
+    size_t reap_zero_copy_completions();
     SocketHandle accept();
     void shutdown();
     int half_close();
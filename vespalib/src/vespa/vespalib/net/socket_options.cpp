@@ -70,4 +70,16 @@ SocketOptions::set_linger(int fd, bool enable, int value)
     return (setsockopt(fd, SOL_SOCKET, SO_LINGER, &data, sizeof(data)) == 0);
 }
 
+bool
+SocketOptions::set_zero_copy(int fd, bool value)
+{
+#ifdef SO_ZEROCOPY
+    return set_bool_opt(fd, SOL_SOCKET, SO_ZEROCOPY, value);
+#else
+    (void) fd;
+    (void) value;
+    return false;
+#endif
+}
+
 } // namespace vespalib
@@ -15,6 +15,7 @@ struct SocketOptions {
     static bool set_ipv6_only(int fd, bool value);
     static bool set_keepalive(int fd, bool value);
     static bool set_linger(int fd, bool enable, int value);
+    static bool set_zero_copy(int fd, bool value);
 };
 
 } // namespace vespalib
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "capability_set.h"
+#include "kernel_tls.h"
 #include <vespa/vespalib/net/socket_address.h>
 #include <memory>
 
@@ -189,6 +190,25 @@ public:
      */
     [[nodiscard]] virtual CapabilitySet granted_capabilities() const noexcept = 0;
 
+    /**
+     * Attempts to hand record protection of the established session over to the
+     * kernel for the (connected TCP) socket `fd`, for the transmit and/or receive
+     * direction as requested. Only succeeds if offloading was enabled in the
+     * transport security options, the negotiated protocol and cipher can be
+     * offloaded and the kernel supports it. The caller must guarantee that no
+     * application data has been passed through the codec in a requested direction.
+     *
+     * Once a direction has been offloaded, the codec must not be used for it
+     * any more; data must be read and written directly on the socket instead.
+     *
+     * Precondition: handshake must be completed
+     */
+    [[nodiscard]] virtual KernelTls::Result offload_to_kernel([[maybe_unused]] int fd,
+                                                              [[maybe_unused]] bool tx,
+                                                              [[maybe_unused]] bool rx) noexcept {
+        return {};
+    }
+
     /*
      * Creates an implementation defined CryptoCodec that provides at least TLSv1.2
      * compliant handshaking and full duplex data transfer.
@@ -57,6 +57,21 @@ CryptoCodecAdapter::flush_all()
     return res;
 }
 
+void
+CryptoCodecAdapter::try_offload_to_kernel()
+{
+    if (_kernel_tls_tried) {
+        return;
+    }
+    _kernel_tls_tried = true;
+    // All handshake output has been flushed and no application data has
+    // been encoded yet. Ciphertext already read into user space must be
+    // decoded by the codec, so receive offload is only possible when no
+    // data was left over after the handshake.
+    bool rx = (_input.obtain().size == 0);
+    _kernel_tls = _codec->offload_to_kernel(_socket.get(), true, rx);
+}
+
 void
 CryptoCodecAdapter::inject_read_data(const char *buf, size_t len)
 {
@@ -78,7 +93,13 @@ CryptoCodecAdapter::handshake()
         _output.commit(hs_res.bytes_produced);
         switch (hs_res.state) {
         case ::vespalib::net::tls::HandshakeResult::State::Failed: return HandshakeResult::FAIL;
-        case ::vespalib::net::tls::HandshakeResult::State::Done: return hs_try_flush();
+        case ::vespalib::net::tls::HandshakeResult::State::Done: {
+            auto flush_res = hs_try_flush();
+            if (flush_res == HandshakeResult::DONE) {
+                try_offload_to_kernel();
+            }
+            return flush_res;
+        }
         case ::vespalib::net::tls::HandshakeResult::State::NeedsWork: return HandshakeResult::NEED_WORK;
         case ::vespalib::net::tls::HandshakeResult::State::NeedsMorePeerData:
             auto flush_res = hs_try_flush();
@@ -103,6 +124,17 @@ CryptoCodecAdapter::do_handshake_work()
 ssize_t
 CryptoCodecAdapter::read(char *buf, size_t len)
 {
+    if (_kernel_tls.rx) {
+        if (_got_tls_close) {
+            return 0;
+        }
+        ssize_t res = KernelTls::read(_socket.get(), buf, len, _got_tls_close);
+        if ((res == 0) && !_got_tls_close) {
+            res = -1; // eof without close_notify
+            errno = EIO;
+        }
+        return res;
+    }
     auto drain_res = drain(buf, len);
     if ((drain_res != 0) || _got_tls_close) {
         return drain_res;
@@ -126,6 +158,9 @@ CryptoCodecAdapter::read(char *buf, size_t len)
 ssize_t
 CryptoCodecAdapter::drain(char *buf, size_t len)
 {
+    if (_kernel_tls.rx) {
+        return 0; // nothing is buffered in user space
+    }
     auto src = _input.obtain();
     auto res = _codec->decode(src.data, src.size, buf, len);
     if (res.failed()) {
@@ -142,6 +177,9 @@ CryptoCodecAdapter::drain(char *buf, size_t len)
 ssize_t
 CryptoCodecAdapter::write(const char *buf, size_t len)
 {
+    if (_kernel_tls.tx) {
+        return _socket.write(buf, len);
+    }
     if (_output.obtain().size >= _codec->min_encode_buffer_size()) {
         if (flush() < 0) {
             return -1;
@@ -185,6 +223,12 @@ CryptoCodecAdapter::half_close()
     if (flush_res < 0) {
         return flush_res;
     }
+    if (!_encoded_tls_close && _kernel_tls.tx) {
+        if (KernelTls::send_close_notify(_socket.get()) < 0) {
+            return -1;
+        }
+        _encoded_tls_close = true;
+    }
     if (!_encoded_tls_close) {
         auto dst = _output.reserve(_codec->min_encode_buffer_size());
         auto res = _codec->half_close(dst.data, dst.size);
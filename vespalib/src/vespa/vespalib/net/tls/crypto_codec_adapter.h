@@ -23,6 +23,8 @@ private:
     std::unique_ptr<CryptoCodec> _codec;
     bool                         _got_tls_close;
     bool                         _encoded_tls_close;
+    bool                         _kernel_tls_tried;
+    KernelTls::Result            _kernel_tls;
 
     bool is_blocked(ssize_t res, int error) const {
         return ((res < 0) && ((error == EWOULDBLOCK) || (error == EAGAIN)));
@@ -31,10 +33,11 @@ private:
     HandshakeResult hs_try_fill();
     ssize_t fill_input(); // -1/0/1 -> error/eof/ok
     ssize_t flush_all();  // -1/0 -> error/ok
+    void try_offload_to_kernel();
 public:
     CryptoCodecAdapter(SocketHandle socket, std::unique_ptr<CryptoCodec> codec)
         : _input(0), _output(0), _socket(std::move(socket)), _codec(std::move(codec)),
-          _got_tls_close(false), _encoded_tls_close(false) {}
+          _got_tls_close(false), _encoded_tls_close(false), _kernel_tls_tried(false), _kernel_tls() {}
     void inject_read_data(const char *buf, size_t len) override;
     int get_fd() const override { return _socket.get(); }
     HandshakeResult handshake() override;
@@ -47,6 +50,9 @@ public:
     ssize_t half_close() override;
     void drop_empty_buffers() override;
     std::unique_ptr<net::ConnectionAuthContext> make_auth_context() override;
+    // Whether encryption/decryption of records has been offloaded to the kernel
+    bool kernel_tls_tx() const noexcept { return _kernel_tls.tx; }
+    bool kernel_tls_rx() const noexcept { return _kernel_tls.rx; }
 };
 
 } // namespace vespalib::net::tls
@@ -15,6 +15,8 @@
 #include <openssl/ssl.h>
 #include <openssl/crypto.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
 #include <openssl/pem.h>
 
 #include <vespa/log/bufferedlogger.h>
@@ -161,6 +163,43 @@ std::string ssl_error_from_stack() {
     return std::string(buf);
 }
 
+#if (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+
+struct EvpPkeyCtxDeleter {
+    void operator()(::EVP_PKEY_CTX* ctx) const noexcept {
+        ::EVP_PKEY_CTX_free(ctx);
+    }
+};
+using EvpPkeyCtxPtr = std::unique_ptr<::EVP_PKEY_CTX, EvpPkeyCtxDeleter>;
+
+// HKDF-Expand-Label(secret, label, "", out_len) as specified in RFC 8446 section 7.1,
+// used to derive the traffic key and IV from a TLSv1.3 application traffic secret.
+bool hkdf_expand_label(const ::EVP_MD* md, const std::vector<unsigned char>& secret,
+                       std::string_view label, size_t out_len, std::vector<unsigned char>& out) noexcept
+{
+    constexpr std::string_view label_prefix = "tls13 ";
+    std::vector<unsigned char> hkdf_label;
+    hkdf_label.push_back(static_cast<unsigned char>(out_len >> 8));
+    hkdf_label.push_back(static_cast<unsigned char>(out_len & 0xff));
+    hkdf_label.push_back(static_cast<unsigned char>(label_prefix.size() + label.size()));
+    hkdf_label.insert(hkdf_label.end(), label_prefix.begin(), label_prefix.end());
+    hkdf_label.insert(hkdf_label.end(), label.begin(), label.end());
+    hkdf_label.push_back(0); // empty context
+    EvpPkeyCtxPtr ctx(::EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, nullptr));
+    out.resize(out_len);
+    size_t produced = out_len;
+    return (ctx
+            && (::EVP_PKEY_derive_init(ctx.get()) == 1)
+            && (::EVP_PKEY_CTX_set_hkdf_mode(ctx.get(), EVP_PKEY_HKDEF_MODE_EXPAND_ONLY) == 1)
+            && (::EVP_PKEY_CTX_set_hkdf_md(ctx.get(), md) == 1)
+            && (::EVP_PKEY_CTX_set1_hkdf_key(ctx.get(), secret.data(), static_cast<int>(secret.size())) == 1)
+            && (::EVP_PKEY_CTX_add1_hkdf_info(ctx.get(), hkdf_label.data(), static_cast<int>(hkdf_label.size())) == 1)
+            && (::EVP_PKEY_derive(ctx.get(), out.data(), &produced) == 1)
+            && (produced == out_len));
+}
+
+#endif
+
 void log_ssl_error(const char* source, const SocketAddress& peer_address, int ssl_error) {
     // Buffer the emitted log messages on the peer's IP address. This prevents a single misbehaving
     // client from flooding our logs, while at the same time ensuring that logs for other clients
@@ -234,7 +273,9 @@ OpenSslCryptoCodecImpl::OpenSslCryptoCodecImpl(std::shared_ptr<OpenSslTlsContext
     }
 }
 
-OpenSslCryptoCodecImpl::~OpenSslCryptoCodecImpl() = default;
+OpenSslCryptoCodecImpl::~OpenSslCryptoCodecImpl() {
+    clear_traffic_secrets();
+}
 
 std::unique_ptr<OpenSslCryptoCodecImpl>
 OpenSslCryptoCodecImpl::make_client_codec(std::shared_ptr<OpenSslTlsContextImpl> ctx,
@@ -483,6 +524,93 @@ EncodeResult OpenSslCryptoCodecImpl::half_close(char* ciphertext, size_t ciphert
     return encoded_bytes(0, static_cast<size_t>(pending_after - pending_before));
 }
 
+void OpenSslCryptoCodecImpl::observe_traffic_secret(std::string_view label, std::vector<unsigned char> secret) noexcept {
+    // Only the secrets of the first application traffic epoch are of interest;
+    // key updates are not supported once records are protected by the kernel.
+    const bool is_client = (_mode == Mode::Client);
+    if (label == "CLIENT_TRAFFIC_SECRET_0") {
+        (is_client ? _tx_traffic_secret : _rx_traffic_secret) = std::move(secret);
+    } else if (label == "SERVER_TRAFFIC_SECRET_0") {
+        (is_client ? _rx_traffic_secret : _tx_traffic_secret) = std::move(secret);
+    } else {
+        secure_memzero(secret.data(), secret.size());
+    }
+}
+
+void OpenSslCryptoCodecImpl::clear_traffic_secrets() noexcept {
+    secure_memzero(_tx_traffic_secret.data(), _tx_traffic_secret.size());
+    secure_memzero(_rx_traffic_secret.data(), _rx_traffic_secret.size());
+    _tx_traffic_secret.clear();
+    _rx_traffic_secret.clear();
+}
+
+bool OpenSslCryptoCodecImpl::export_kernel_tls_keys([[maybe_unused]] bool tx,
+                                                    [[maybe_unused]] KernelTlsKeys& keys_out) const noexcept {
+#if (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+    const auto& secret = (tx ? _tx_traffic_secret : _rx_traffic_secret);
+    if (secret.empty() || !SSL_is_init_finished(_ssl.get()) || (::SSL_version(_ssl.get()) != TLS1_3_VERSION)) {
+        return false;
+    }
+    if (!tx && ::SSL_has_pending(_ssl.get())) {
+        return false; // Records already buffered by OpenSSL must be decoded by OpenSSL
+    }
+    const ::SSL_CIPHER* cipher = ::SSL_get_current_cipher(_ssl.get());
+    if (cipher == nullptr) {
+        return false;
+    }
+    const ::EVP_MD* md = nullptr;
+    size_t key_size = 0;
+    switch (::SSL_CIPHER_get_id(cipher)) {
+    case TLS1_3_CK_AES_128_GCM_SHA256:
+        keys_out.cipher = KernelTlsKeys::Cipher::AES_GCM_128;
+        md = ::EVP_sha256();
+        key_size = 16;
+        break;
+    case TLS1_3_CK_AES_256_GCM_SHA384:
+        keys_out.cipher = KernelTlsKeys::Cipher::AES_GCM_256;
+        md = ::EVP_sha384();
+        key_size = 32;
+        break;
+    case TLS1_3_CK_CHACHA20_POLY1305_SHA256:
+        keys_out.cipher = KernelTlsKeys::Cipher::CHACHA20_POLY1305;
+        md = ::EVP_sha256();
+        key_size = 32;
+        break;
+    default:
+        return false;
+    }
+    constexpr size_t iv_size = 12;
+    return (hkdf_expand_label(md, secret, "key", key_size, keys_out.key) &&
+            hkdf_expand_label(md, secret, "iv", iv_size, keys_out.iv));
+#else
+    return false;
+#endif
+}
+
+KernelTls::Result OpenSslCryptoCodecImpl::offload_to_kernel(int fd, bool tx, bool rx) noexcept {
+    KernelTls::Result result;
+    if (!_ctx->transport_security_options().enable_kernel_tls_offload()) {
+        return result;
+    }
+    KernelTlsKeys tx_keys;
+    KernelTlsKeys rx_keys;
+    const bool has_tx_keys = (tx && export_kernel_tls_keys(true, tx_keys));
+    const bool has_rx_keys = (rx && export_kernel_tls_keys(false, rx_keys));
+    // Secrets are never needed again, regardless of the outcome
+    clear_traffic_secrets();
+    result = KernelTls::enable(fd, (has_tx_keys ? &tx_keys : nullptr), (has_rx_keys ? &rx_keys : nullptr));
+    auto& stats = ConnectionStatistics::get(_mode == Mode::Server);
+    if (result.tx) {
+        stats.inc_kernel_tls_tx_connections();
+    }
+    if (result.rx) {
+        stats.inc_kernel_tls_rx_connections();
+    }
+    LOG(debug, "Kernel TLS offload with %s: tx=%s, rx=%s", _peer_address.spec().c_str(),
+        (result.tx ? "yes" : "no"), (result.rx ? "yes" : "no"));
+    return result;
+}
+
 }
 
 // External references:
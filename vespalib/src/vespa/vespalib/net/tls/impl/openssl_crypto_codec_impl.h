@@ -10,6 +10,8 @@
 #include <vespa/vespalib/net/tls/transport_security_options.h>
 #include <memory>
 #include <optional>
+#include <string_view>
+#include <vector>
 
 namespace vespalib::net::tls { struct TlsContext; }
 
@@ -59,6 +61,9 @@ class OpenSslCryptoCodecImpl : public CryptoCodec {
     std::optional<HandshakeResult>         _deferred_handshake_result;
     PeerCredentials _peer_credentials;
     CapabilitySet   _granted_capabilities;
+    // TLSv1.3 application traffic secrets, only captured if kernel TLS offload is enabled
+    std::vector<unsigned char> _tx_traffic_secret;
+    std::vector<unsigned char> _rx_traffic_secret;
 public:
     ~OpenSslCryptoCodecImpl() override;
 
@@ -99,6 +104,15 @@ public:
                         char* plaintext, size_t plaintext_size) noexcept override;
     EncodeResult half_close(char* ciphertext, size_t ciphertext_size) noexcept override;
 
+    KernelTls::Result offload_to_kernel(int fd, bool tx, bool rx) noexcept override;
+    /*
+     * Derives the kernel TLS traffic keys for the given direction from the captured
+     * application traffic secret. Only possible for TLSv1.3 sessions using an AEAD
+     * cipher supported by the kernel, and only for receive if OpenSSL holds no
+     * unprocessed peer data. Exposed for testing; offload_to_kernel() uses this.
+     */
+    [[nodiscard]] bool export_kernel_tls_keys(bool tx, KernelTlsKeys& keys_out) const noexcept;
+
     [[nodiscard]] const PeerCredentials& peer_credentials() const noexcept override {
         return _peer_credentials;
     }
@@ -123,6 +137,8 @@ public:
     void set_granted_capabilities(CapabilitySet granted_capabilities) {
         _granted_capabilities = granted_capabilities;
     }
+    // Only used by code bridging OpenSSL key log callbacks and kernel TLS offload.
+    void observe_traffic_secret(std::string_view label, std::vector<unsigned char> secret) noexcept;
 private:
     OpenSslCryptoCodecImpl(std::shared_ptr<OpenSslTlsContextImpl> ctx,
                            const SocketSpec& peer_spec,
@@ -135,6 +151,7 @@ private:
     DecodeResult drain_and_produce_plaintext_from_ssl(char* plaintext, size_t plaintext_size) noexcept;
     // Precondition: read_result < 0
     DecodeResult remap_ssl_read_failure_to_decode_result(int read_result) noexcept;
+    void clear_traffic_secrets() noexcept;
 };
 
 }
@@ -214,6 +214,9 @@ OpenSslTlsContextImpl::OpenSslTlsContextImpl(
     disable_compression();
     disable_renegotiation();
     disable_session_resumption();
+    if (ts_opts.enable_kernel_tls_offload()) {
+        enable_kernel_tls_key_export();
+    }
     enforce_peer_certificate_verification();
     set_ssl_ctx_self_reference();
     if (!ts_opts.accepted_ciphers().empty()) {
@@ -331,6 +334,15 @@ void OpenSslTlsContextImpl::disable_session_resumption() {
     SSL_CTX_set_options(_ctx.get(), SSL_OP_NO_TICKET);
 }
 
+void OpenSslTlsContextImpl::enable_kernel_tls_key_export() {
+#if (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+    // TLSv1.3 session tickets are sent as post-handshake records, which would both
+    // race with the handover to the kernel and consume record sequence numbers.
+    ::SSL_CTX_set_num_tickets(_ctx.get(), 0);
+    ::SSL_CTX_set_keylog_callback(_ctx.get(), key_log_cb_wrapper);
+#endif
+}
+
 namespace {
 
 // There's no good reason for entries to contain embedded nulls, aside from
@@ -459,6 +471,60 @@ int OpenSslTlsContextImpl::verify_cb_wrapper(int preverified_ok, ::X509_STORE_CT
     return 0;
 }
 
+namespace {
+
+int hex_digit_value(char c) noexcept {
+    if ((c >= '0') && (c <= '9')) {
+        return (c - '0');
+    } else if ((c >= 'a') && (c <= 'f')) {
+        return (c - 'a' + 10);
+    } else if ((c >= 'A') && (c <= 'F')) {
+        return (c - 'A' + 10);
+    }
+    return -1;
+}
+
+bool decode_hex(std::string_view hex, std::vector<unsigned char>& out) {
+    if ((hex.size() % 2) != 0) {
+        return false;
+    }
+    out.resize(hex.size() / 2);
+    for (size_t i = 0; i < out.size(); ++i) {
+        const int hi = hex_digit_value(hex[i * 2]);
+        const int lo = hex_digit_value(hex[i * 2 + 1]);
+        if ((hi < 0) || (lo < 0)) {
+            return false;
+        }
+        out[i] = static_cast<unsigned char>((hi << 4) | lo);
+    }
+    return true;
+}
+
+}
+
+// Key log lines are on the NSS key log format, i.e. "<label> <client random> <secret>",
+// with the latter two fields hex encoded.
+void OpenSslTlsContextImpl::key_log_cb_wrapper(const ::SSL* ssl, const char* line) {
+    void* data = SSL_get_app_data(ssl);
+    if (data == nullptr) {
+        return;
+    }
+    auto* codec_impl = static_cast<OpenSslCryptoCodecImpl*>(data);
+    std::string_view entry(line);
+    const auto label_end = entry.find(' ');
+    const auto random_end = (label_end != std::string_view::npos) ? entry.find(' ', label_end + 1)
+                                                                  : std::string_view::npos;
+    if (random_end == std::string_view::npos) {
+        return;
+    }
+    std::vector<unsigned char> secret;
+    if (decode_hex(entry.substr(random_end + 1), secret)) {
+        codec_impl->observe_traffic_secret(entry.substr(0, label_end), std::move(secret));
+    } else {
+        secure_memzero(secret.data(), secret.size());
+    }
+}
+
 bool OpenSslTlsContextImpl::verify_trusted_certificate(::X509_STORE_CTX* store_ctx, OpenSslCryptoCodecImpl& codec_impl) {
     const auto authz_mode = authorization_mode();
     // TODO consider if we want to fill in peer credentials even if authorization is disabled
@@ -44,6 +44,9 @@ private:
     // explicitly to the peer that it's not a supported action.
     void disable_renegotiation();
     void disable_session_resumption();
+    // Captures TLSv1.3 application traffic secrets in the codecs, allowing record
+    // protection to be handed over to the kernel after the handshake.
+    void enable_kernel_tls_key_export();
     void enforce_peer_certificate_verification();
     void set_ssl_ctx_self_reference();
     void set_accepted_cipher_suites(const std::vector<std::string>& ciphers);
@@ -51,6 +54,7 @@ private:
     bool verify_trusted_certificate(::X509_STORE_CTX* store_ctx, OpenSslCryptoCodecImpl& codec_impl);
 
     static int verify_cb_wrapper(int preverified_ok, ::X509_STORE_CTX* store_ctx);
+    static void key_log_cb_wrapper(const ::SSL* ssl, const char* line);
 };
 
 }
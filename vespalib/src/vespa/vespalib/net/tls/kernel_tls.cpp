@@ -0,0 +1,186 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "kernel_tls.h"
+#include "transport_security_options.h"
+#include <cerrno>
+
+#if defined(__linux__) && __has_include(<linux/tls.h>)
+#define VESPALIB_HAS_KERNEL_TLS 1
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <cstring>
+#endif
+
+#include <vespa/log/log.h>
+LOG_SETUP(".vespalib.net.tls.kernel_tls");
+
+namespace vespalib::net::tls {
+
+KernelTlsKeys::KernelTlsKeys() noexcept
+    : cipher(Cipher::AES_GCM_128),
+      key(),
+      iv()
+{
+}
+
+KernelTlsKeys::~KernelTlsKeys() {
+    secure_memzero(key.data(), key.size());
+    secure_memzero(iv.data(), iv.size());
+}
+
+#ifdef VESPALIB_HAS_KERNEL_TLS
+
+namespace {
+
+constexpr unsigned char record_type_alert            = 21;
+constexpr unsigned char record_type_handshake        = 22;
+constexpr unsigned char record_type_application_data = 23;
+constexpr unsigned char alert_level_warning          = 1;
+constexpr unsigned char alert_close_notify           = 0;
+constexpr unsigned char handshake_new_session_ticket = 4;
+
+// Fills in a kernel crypto info struct from a TLSv1.3 static IV. For the
+// AES-GCM ciphers the kernel wants the IV split into a 4 byte salt and
+// an 8 byte nonce part; ChaCha20-Poly1305 takes the full 12 byte IV.
+template <typename CryptoInfo>
+bool fill_crypto_info(CryptoInfo& info, uint16_t cipher_type, const KernelTlsKeys& keys) noexcept {
+    if ((keys.key.size() != sizeof(info.key)) || (keys.iv.size() != sizeof(info.salt) + sizeof(info.iv))) {
+        return false;
+    }
+    memset(&info, 0, sizeof(info));
+    info.info.version = TLS_1_3_VERSION;
+    info.info.cipher_type = cipher_type;
+    memcpy(info.salt, keys.iv.data(), sizeof(info.salt));
+    memcpy(info.iv, keys.iv.data() + sizeof(info.salt), sizeof(info.iv));
+    memcpy(info.key, keys.key.data(), sizeof(info.key));
+    // rec_seq left at zero
+    return true;
+}
+
+template <typename CryptoInfo>
+bool set_crypto_info(int fd, int direction, uint16_t cipher_type, const KernelTlsKeys& keys) noexcept {
+    CryptoInfo info;
+    bool ok = fill_crypto_info(info, cipher_type, keys)
+              && (setsockopt(fd, SOL_TLS, direction, &info, sizeof(info)) == 0);
+    secure_memzero(&info, sizeof(info));
+    return ok;
+}
+
+bool install_keys(int fd, int direction, const KernelTlsKeys& keys) noexcept {
+    switch (keys.cipher) {
+    case KernelTlsKeys::Cipher::AES_GCM_128:
+        return set_crypto_info<tls12_crypto_info_aes_gcm_128>(fd, direction, TLS_CIPHER_AES_GCM_128, keys);
+    case KernelTlsKeys::Cipher::AES_GCM_256:
+        return set_crypto_info<tls12_crypto_info_aes_gcm_256>(fd, direction, TLS_CIPHER_AES_GCM_256, keys);
+    case KernelTlsKeys::Cipher::CHACHA20_POLY1305:
+        return set_crypto_info<tls12_crypto_info_chacha20_poly1305>(fd, direction, TLS_CIPHER_CHACHA20_POLY1305, keys);
+    }
+    return false;
+}
+
+}
+
+KernelTls::Result
+KernelTls::enable(int fd, const KernelTlsKeys* tx_keys, const KernelTlsKeys* rx_keys) noexcept
+{
+    Result result;
+    if ((tx_keys == nullptr) && (rx_keys == nullptr)) {
+        return result;
+    }
+    if (setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) != 0) {
+        LOG(debug, "unable to attach kernel TLS to socket %d: %s", fd, strerror(errno));
+        return result;
+    }
+    result.tx = (tx_keys != nullptr) && install_keys(fd, TLS_TX, *tx_keys);
+    result.rx = (rx_keys != nullptr) && install_keys(fd, TLS_RX, *rx_keys);
+    return result;
+}
+
+ssize_t
+KernelTls::read(int fd, char* buf, size_t len, bool& got_close) noexcept
+{
+    for (;;) {
+        char cmsg_buf[CMSG_SPACE(sizeof(unsigned char))];
+        iovec iov;
+        iov.iov_base = buf;
+        iov.iov_len = len;
+        msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = cmsg_buf;
+        msg.msg_controllen = sizeof(cmsg_buf);
+        ssize_t res = recvmsg(fd, &msg, 0);
+        if (res <= 0) {
+            return res;
+        }
+        const cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        if ((cmsg == nullptr) || (cmsg->cmsg_level != SOL_TLS) || (cmsg->cmsg_type != TLS_GET_RECORD_TYPE)) {
+            return res; // plain application data
+        }
+        unsigned char record_type = *CMSG_DATA(cmsg);
+        if (record_type == record_type_application_data) {
+            return res;
+        }
+        if ((record_type == record_type_alert) && (res == 2) && (buf[1] == alert_close_notify)) {
+            got_close = true;
+            return 0;
+        }
+        if ((record_type == record_type_handshake) && (buf[0] == handshake_new_session_ticket)) {
+            continue; // session resumption is not used, so tickets sent by the peer are ignored
+        }
+        // Anything else (including key updates) can not be handled once the kernel owns the session
+        errno = EIO;
+        return -1;
+    }
+}
+
+ssize_t
+KernelTls::send_close_notify(int fd) noexcept
+{
+    char cmsg_buf[CMSG_SPACE(sizeof(unsigned char))];
+    unsigned char alert[2] = {alert_level_warning, alert_close_notify};
+    iovec iov;
+    iov.iov_base = alert;
+    iov.iov_len = sizeof(alert);
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = cmsg_buf;
+    msg.msg_controllen = sizeof(cmsg_buf);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_TLS;
+    cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(unsigned char));
+    *CMSG_DATA(cmsg) = record_type_alert;
+    return sendmsg(fd, &msg, MSG_NOSIGNAL);
+}
+
+#else // VESPALIB_HAS_KERNEL_TLS
+
+KernelTls::Result
+KernelTls::enable(int, const KernelTlsKeys*, const KernelTlsKeys*) noexcept
+{
+    return {};
+}
+
+ssize_t
+KernelTls::read(int, char*, size_t, bool&) noexcept
+{
+    errno = ENOTSUP;
+    return -1;
+}
+
+ssize_t
+KernelTls::send_close_notify(int) noexcept
+{
+    errno = ENOTSUP;
+    return -1;
+}
+
+#endif // VESPALIB_HAS_KERNEL_TLS
+
+}
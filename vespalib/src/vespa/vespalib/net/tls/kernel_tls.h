@@ -0,0 +1,58 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <sys/types.h>
+
+namespace vespalib::net::tls {
+
+/**
+ * Traffic keys for a single direction of an established TLSv1.3
+ * session, in the form needed to hand record protection over to the
+ * kernel (Linux kTLS). The record sequence number is implicitly 0,
+ * i.e. keys must be exported before any application data has been
+ * sent or received in the given direction.
+ *
+ * Key material is securely cleared on destruction.
+ **/
+struct KernelTlsKeys {
+    enum class Cipher {
+        AES_GCM_128,
+        AES_GCM_256,
+        CHACHA20_POLY1305
+    };
+    Cipher                     cipher;
+    std::vector<unsigned char> key;
+    std::vector<unsigned char> iv; // full 12 byte (salt + nonce) static IV
+
+    KernelTlsKeys() noexcept;
+    ~KernelTlsKeys();
+};
+
+/**
+ * Thin wrappers around the Linux kTLS socket API. All functions fail
+ * gracefully (returning false or -1 with EIO/ENOTSUP in errno) when
+ * kTLS is not available, either because the build platform lacks it
+ * or because the running kernel does not have the 'tls' module.
+ **/
+struct KernelTls {
+    // Attaches the TLS upper layer protocol to the (connected) TCP socket
+    // and installs the given keys for transmit and/or receive. Either key
+    // set may be nullptr. Returns which directions were offloaded.
+    struct Result {
+        bool tx = false;
+        bool rx = false;
+    };
+    [[nodiscard]] static Result enable(int fd, const KernelTlsKeys* tx_keys, const KernelTlsKeys* rx_keys) noexcept;
+
+    // Reads decrypted application data from a socket with kTLS receive
+    // offload. A close_notify alert from the peer is reported as EOF (0)
+    // and flags got_close, any other non-data record fails with EIO.
+    [[nodiscard]] static ssize_t read(int fd, char* buf, size_t len, bool& got_close) noexcept;
+
+    // Sends a close_notify alert on a socket with kTLS transmit offload.
+    [[nodiscard]] static ssize_t send_close_notify(int fd) noexcept;
+};
+
+}
@@ -33,6 +33,9 @@ public:
     ssize_t flush() override { return _socket->flush(); }
     ssize_t half_close() override { return _socket->half_close(); }
     void drop_empty_buffers() override { _socket->drop_empty_buffers(); }
+    bool enable_zero_copy() override { return _socket->enable_zero_copy(); }
+    ssize_t write_zero_copy(const char *buf, size_t len) override { return _socket->write_zero_copy(buf, len); }
+    size_t reap_zero_copy_completions() override { return _socket->reap_zero_copy_completions(); }
     std::unique_ptr<net::ConnectionAuthContext> make_auth_context() override;
 };
 
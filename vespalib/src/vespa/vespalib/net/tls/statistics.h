@@ -31,6 +31,11 @@ struct ConnectionStatistics {
     std::atomic<uint64_t> invalid_peer_credentials = 0;
     // Number of connections broken due to errors during TLS encoding or decoding
     std::atomic<uint64_t> broken_tls_connections   = 0;
+    // Number of TLS connections where encryption of outgoing (tx) or decryption
+    // of incoming (rx) records has been offloaded to the kernel (kTLS) after the
+    // handshake. Remaining TLS connections use user space encryption.
+    std::atomic<uint64_t> kernel_tls_tx_connections = 0;
+    std::atomic<uint64_t> kernel_tls_rx_connections = 0;
 
     void inc_insecure_connections() noexcept {
         insecure_connections.fetch_add(1, std::memory_order_relaxed);
@@ -47,6 +52,12 @@ struct ConnectionStatistics {
     void inc_broken_tls_connections() noexcept {
         broken_tls_connections.fetch_add(1, std::memory_order_relaxed);
     }
+    void inc_kernel_tls_tx_connections() noexcept {
+        kernel_tls_tx_connections.fetch_add(1, std::memory_order_relaxed);
+    }
+    void inc_kernel_tls_rx_connections() noexcept {
+        kernel_tls_rx_connections.fetch_add(1, std::memory_order_relaxed);
+    }
 
     struct Snapshot {
         uint64_t insecure_connections     = 0;
@@ -54,6 +65,8 @@ struct ConnectionStatistics {
         uint64_t failed_tls_handshakes    = 0;
         uint64_t invalid_peer_credentials = 0;
         uint64_t broken_tls_connections   = 0;
+        uint64_t kernel_tls_tx_connections = 0;
+        uint64_t kernel_tls_rx_connections = 0;
 
         [[nodiscard]] Snapshot subtract(const Snapshot& rhs) const noexcept;
     };
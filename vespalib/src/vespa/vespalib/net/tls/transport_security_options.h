@@ -15,6 +15,7 @@ class TransportSecurityOptions {
     AuthorizedPeers  _authorized_peers;
     std::vector<std::string> _accepted_ciphers;
     bool _disable_hostname_validation;
+    bool _enable_kernel_tls_offload;
 public:
     struct Params {
         std::string _ca_certs_pem;
@@ -23,6 +24,7 @@ public:
         AuthorizedPeers  _authorized_peers;
         std::vector<std::string> _accepted_ciphers;
         bool _disable_hostname_validation;
+        bool _enable_kernel_tls_offload;
 
         Params();
         ~Params();
@@ -43,6 +45,10 @@ public:
             _disable_hostname_validation = disable;
             return *this;
         }
+        Params& enable_kernel_tls_offload(bool enable) {
+            _enable_kernel_tls_offload = enable;
+            return *this;
+        }
     };
 
     explicit TransportSecurityOptions(Params params);
@@ -61,13 +67,17 @@ public:
     TransportSecurityOptions copy_without_private_key() const;
     const std::vector<std::string>& accepted_ciphers() const noexcept { return _accepted_ciphers; }
     bool disable_hostname_validation() const noexcept { return _disable_hostname_validation; }
+    // If set, record protection of established TLSv1.3 connections is handed over
+    // to the kernel (Linux kTLS) when supported, falling back to user space otherwise.
+    bool enable_kernel_tls_offload() const noexcept { return _enable_kernel_tls_offload; }
 
 private:
     TransportSecurityOptions(std::string ca_certs_pem,
                              std::string cert_chain_pem,
                              std::string private_key_pem,
                              AuthorizedPeers authorized_peers,
-                             bool disable_hostname_validation);
+                             bool disable_hostname_validation,
+                             bool enable_kernel_tls_offload);
 };
 
 // Zeroes out `size` bytes in `buf` in a way that shall never be optimized
@@ -158,6 +158,7 @@ std::unique_ptr<TransportSecurityOptions> load_from_input(Input& input) {
     if (root["disable-hostname-validation"].valid()) {
         disable_hostname_validation = root["disable-hostname-validation"].asBool();
     }
+    bool enable_kernel_tls_offload = root["enable-kernel-tls-offload"].asBool();
 
     auto options = std::make_unique<TransportSecurityOptions>(
             TransportSecurityOptions::Params()
@@ -166,7 +167,8 @@ std::unique_ptr<TransportSecurityOptions> load_from_input(Input& input) {
                 .private_key_pem(priv_key)
                 .authorized_peers(std::move(authorized_peers))
                 .accepted_ciphers(std::move(accepted_ciphers))
-                .disable_hostname_validation(disable_hostname_validation));
+                .disable_hostname_validation(disable_hostname_validation)
+                .enable_kernel_tls_offload(enable_kernel_tls_offload));
     secure_memzero(&priv_key[0], priv_key.size());
     return options;
 }
@@ -1,28 +1,120 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "regex.h"
+#include <vespa/vespalib/util/regexp.h>
 #include <re2/re2.h>
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace vespalib {
 
 using re2::StringPiece;
 
+namespace {
+
+constexpr char to_lower(char c) noexcept {
+    return ((c >= 'A') && (c <= 'Z')) ? char(c + ('a' - 'A')) : c;
+}
+
+bool equal_ignore_case(const char *a, const char *lower, size_t len) noexcept {
+    for (size_t i = 0; i < len; ++i) {
+        if (to_lower(a[i]) != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Search for an ASCII literal (given in lowercase) ignoring ASCII case. Since
+ * the regex engine also folds some non-ASCII chars into ASCII letters (like
+ * the Kelvin sign into 'k'), input with non-ASCII bytes is reported as a
+ * possible match when the literal is not found.
+ **/
+bool contains_ignore_case(std::string_view input, std::string_view lower) noexcept {
+    if (input.size() < lower.size()) {
+        return false;
+    }
+    const char first_lower = lower[0];
+    const char first_upper = ((first_lower >= 'a') && (first_lower <= 'z')) ? char(first_lower - ('a' - 'A')) : first_lower;
+    const size_t last = input.size() - lower.size();
+    bool non_ascii = false;
+    size_t pos = 0;
+#ifdef __SSE2__
+    const __m128i lo = _mm_set1_epi8(first_lower);
+    const __m128i hi = _mm_set1_epi8(first_upper);
+    for (; pos + 16 <= input.size(); pos += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input.data() + pos));
+        non_ascii |= (_mm_movemask_epi8(bytes) != 0);
+        uint32_t hits = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes, lo), _mm_cmpeq_epi8(bytes, hi)));
+        for (; hits != 0; hits &= (hits - 1)) {
+            size_t candidate = pos + __builtin_ctz(hits);
+            if ((candidate <= last) && equal_ignore_case(input.data() + candidate + 1, lower.data() + 1, lower.size() - 1)) {
+                return true;
+            }
+        }
+    }
+#endif
+    for (; pos < input.size(); ++pos) {
+        char c = input[pos];
+        non_ascii |= ((c & 0x80) != 0);
+        if ((pos <= last) && ((c == first_lower) || (c == first_upper)) &&
+            equal_ignore_case(input.data() + pos + 1, lower.data() + 1, lower.size() - 1))
+        {
+            return true;
+        }
+    }
+    return non_ascii;
+}
+
+std::string make_required_literal(std::string_view pattern, const RE2::Options& opts) {
+    std::string literal = RegexpUtil::get_required_literal(pattern);
+    if (!opts.case_sensitive()) {
+        if (std::any_of(literal.begin(), literal.end(), [](char c) { return (c & 0x80) != 0; })) {
+            return {}; // only ASCII case folding is supported
+        }
+        std::transform(literal.begin(), literal.end(), literal.begin(), to_lower);
+    }
+    return literal;
+}
+
+}
+
 class Regex::Impl {
-    RE2 _regex;
+    RE2         _regex;
+    std::string _literal;
+    bool        _ignore_case;
 public:
-    Impl(std::string_view pattern, const re2::RE2::Options& opts)
-        : _regex(StringPiece(pattern.data(), pattern.size()), opts)
+    Impl(std::string_view pattern, const re2::RE2::Options& opts, bool use_literal)
+        : _regex(StringPiece(pattern.data(), pattern.size()), opts),
+          _literal(use_literal ? make_required_literal(pattern, opts) : std::string()),
+          _ignore_case(!opts.case_sensitive())
     {}
 
+    std::string_view required_literal() const noexcept { return _literal; }
+
+    bool may_match(std::string_view input) const noexcept {
+        if (_literal.empty()) {
+            return true;
+        }
+        if (_ignore_case) {
+            return contains_ignore_case(input, _literal);
+        }
+        return (memmem(input.data(), input.size(), _literal.data(), _literal.size()) != nullptr);
+    }
+
     bool parsed_ok() const noexcept {
         return _regex.ok();
     }
 
     bool partial_match(std::string_view input) const noexcept {
         assert(input.size() <= INT32_MAX);
-        if (!_regex.ok()) {
+        if (!_regex.ok() || !may_match(input)) {
             return false;
         }
         return RE2::PartialMatch(StringPiece(input.data(), input.size()), _regex);
@@ -30,7 +122,7 @@ public:
 
     bool full_match(std::string_view input) const noexcept {
         assert(input.size() <= INT32_MAX);
-        if (!_regex.ok()) {
+        if (!_regex.ok() || !may_match(input)) {
             return false;
         }
         return RE2::FullMatch(StringPiece(input.data(), input.size()), _regex);
@@ -71,7 +163,7 @@ Regex Regex::from_pattern(std::string_view pattern, uint32_t opt_mask) {
     if ((opt_mask & Options::DotMatchesNewline) != 0) {
         opts.set_dot_nl(true);
     }
-    return Regex(std::make_unique<const Impl>(pattern, opts));
+    return Regex(std::make_unique<const Impl>(pattern, opts, true));
 }
 
 bool Regex::parsed_ok() const noexcept {
@@ -86,19 +178,27 @@ bool Regex::full_match(std::string_view input) const noexcept {
     return _impl->full_match(input);
 }
 
+std::string_view Regex::required_literal() const noexcept {
+    return _impl->required_literal();
+}
+
+bool Regex::may_match(std::string_view input) const noexcept {
+    return _impl->may_match(input);
+}
+
 std::pair<std::string, std::string> Regex::possible_anchored_match_prefix_range() const {
     return _impl->possible_anchored_match_prefix_range();
 }
 
 bool Regex::partial_match(std::string_view input, std::string_view pattern) noexcept {
     assert(pattern.size() <= INT32_MAX);
-    Impl impl(pattern, RE2::Quiet);
+    Impl impl(pattern, RE2::Quiet, false);
     return impl.partial_match(input);
 }
 
 bool Regex::full_match(std::string_view input, std::string_view pattern) noexcept {
     assert(pattern.size() <= INT32_MAX);
-    Impl impl(pattern, RE2::Quiet);
+    Impl impl(pattern, RE2::Quiet, false);
     return impl.full_match(input);
 }
 
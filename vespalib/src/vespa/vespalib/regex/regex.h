@@ -63,6 +63,15 @@ public:
     [[nodiscard]] bool partial_match(std::string_view input) const noexcept;
     [[nodiscard]] bool full_match(std::string_view input) const noexcept;
 
+    // Returns the literal that must be present in any input matching this regex (see
+    // RegexpUtil::get_required_literal), or an empty string if there is none. The literal
+    // is lowercased if the regex ignores case.
+    [[nodiscard]] std::string_view required_literal() const noexcept;
+
+    // Cheap check for the required literal, done by partial_match() and full_match()
+    // before running the regex itself. Returns false only if the input cannot match.
+    [[nodiscard]] bool may_match(std::string_view input) const noexcept;
+
     // Returns a pair of <lower bound, upper bound> prefix strings that constrain the possible
     // match-able range of inputs for this regex. If there is no shared prefix, or if extracting
     // the range fails, the strings will be empty.
@@ -347,7 +347,7 @@ public:
         return sizeof(value_type);
     }
 
-    // For testing. Not const since backing lrucache_map does not have const_iterator
+    // Used for testing and for snapshotting cache keys. Not const since backing lrucache_map does not have const_iterator
     [[nodiscard]] std::vector<K> dump_segment_keys_in_lru_order(CacheSegment segment);
 
 protected:
@@ -1,7 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
-#include "hashtable.h"
+#include "swiss_hashtable.h"
 #include "hash_fun.h"
 #include "select.h"
 
@@ -14,7 +14,7 @@ public:
     using value_type = std::pair<K, V>;
     using key_type = K;
     using mapped_type = V;
-    using HashTable = hashtable< K, value_type, H, EQ, Select1st<value_type>, M >;
+    using HashTable = typename select_hashtable< K, value_type, H, EQ, Select1st<value_type>, M >::type;
 private:
     HashTable _ht;
 public:
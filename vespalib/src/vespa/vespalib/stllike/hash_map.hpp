@@ -3,6 +3,7 @@
 
 #include "hash_map_insert.hpp"
 #include "hashtable.hpp"
+#include "swiss_hashtable.hpp"
 #include "select.h"
 
 namespace vespalib {
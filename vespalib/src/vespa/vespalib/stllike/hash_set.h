@@ -1,7 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
-#include "hashtable.h"
+#include "swiss_hashtable.h"
 #include "hash_fun.h"
 #include "identity.h"
 #include <initializer_list>
@@ -12,7 +12,7 @@ template< typename K, typename H = vespalib::hash<K>, typename EQ = std::equal_t
 class hash_set
 {
 private:
-    using HashTable = hashtable< K, K, H, EQ, Identity, M>;
+    using HashTable = typename select_hashtable< K, K, H, EQ, Identity, M>::type;
     HashTable _ht;
 public:
     using iterator = typename HashTable::iterator;
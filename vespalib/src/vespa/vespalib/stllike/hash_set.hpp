@@ -3,6 +3,7 @@
 
 #include "hash_set_insert.hpp"
 #include "hashtable.hpp"
+#include "swiss_hashtable.hpp"
 #include "identity.h"
 
 namespace vespalib {
@@ -83,6 +83,12 @@ public:
     private:
         next_t _mask;
     };
+    /**
+     * Not a modulator; used in its place to select the open
+     * addressing swiss_hashtable as the implementation of hash_map
+     * and hash_set.
+     **/
+    struct open_addressing {};
     static size_t getModuloStl(size_t size) noexcept;
     static size_t getModuloSimple(size_t size) noexcept {
         return std::max(size_t(8), roundUp2inN(size));
@@ -308,6 +314,11 @@ public:
         return end();
     }
     const_iterator find(const Key & key) const noexcept;
+    // Prefetch the bucket a later find for the given key will start in.
+    template< typename AltKey>
+    void prefetch(const AltKey & key) const noexcept {
+        __builtin_prefetch(&_nodes[hash(key)]);
+    }
     template <typename V>
     insert_result insert(V && node) {
         return insert_internal(std::forward<V>(node));
@@ -0,0 +1,286 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "hashtable.h"
+#include <cstdint>
+#include <memory>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace vespalib {
+
+/**
+   An open addressing hashtable in the style of SwissTable, with the
+   same interface as vespalib::hashtable.
+
+   The table is split into groups of 16 slots. Each slot has a control
+   byte that is either empty, deleted or holds 7 bits of the hash of
+   the element in the slot. A lookup compares the control bytes of a
+   whole group at once (using SSE2 when available) and only looks at
+   the elements whose hash bits match, so most lookups touch a single
+   cache line of control bytes and a single element. Groups are probed
+   in a triangular sequence, ending at the first group with an empty
+   slot.
+
+   Compared to vespalib::hashtable there is no chain of next indexes
+   to follow, and erased slots are reused. Like vespalib::hashtable,
+   insert may invalidate iterators. The table is grown when 7/8 of the
+   slots are in use.
+
+   Use hashtable_base::open_addressing in place of the modulator of a
+   hash_map or hash_set to select this implementation.
+**/
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+class swiss_hashtable : public hashtable_base
+{
+private:
+    using ctrl_t = int8_t;
+    static constexpr ctrl_t ctrl_empty = -128;
+    static constexpr ctrl_t ctrl_deleted = -2;
+    static constexpr size_t group_size = 16;
+
+    struct Slot {
+        alignas(Value) char mem[sizeof(Value)];
+        Value & get() noexcept { return *reinterpret_cast<Value *>(mem); }
+        const Value & get() const noexcept { return *reinterpret_cast<const Value *>(mem); }
+    };
+
+    // bit masks of the slots in a group whose control byte matches a criteria
+    class Group {
+    private:
+#ifdef __SSE2__
+        __m128i _ctrl;
+        static uint32_t mask(__m128i bytes) noexcept { return _mm_movemask_epi8(bytes); }
+    public:
+        explicit Group(const ctrl_t *ctrl) noexcept
+            : _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {}
+        uint32_t match(ctrl_t h2) const noexcept { return mask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl)); }
+        // both empty and deleted have the high bit set
+        uint32_t match_free() const noexcept { return mask(_ctrl); }
+#else
+        const ctrl_t *_ctrl;
+    public:
+        explicit Group(const ctrl_t *ctrl) noexcept : _ctrl(ctrl) {}
+        uint32_t match(ctrl_t h2) const noexcept {
+            uint32_t bits = 0;
+            for (size_t i = 0; i < group_size; ++i) {
+                bits |= uint32_t(_ctrl[i] == h2) << i;
+            }
+            return bits;
+        }
+        uint32_t match_free() const noexcept {
+            uint32_t bits = 0;
+            for (size_t i = 0; i < group_size; ++i) {
+                bits |= uint32_t(_ctrl[i] < 0) << i;
+            }
+            return bits;
+        }
+#endif
+        uint32_t match_empty() const noexcept { return match(ctrl_empty); }
+    };
+
+    // the bits of a (mixed) hash used to select the first group and the control byte
+    struct HashBits {
+        size_t h1;
+        ctrl_t h2;
+        constexpr explicit HashBits(uint64_t hash) noexcept
+            : h1(0), h2(0)
+        {
+            // many of our hash functions are the identity, so mix before splitting
+            uint64_t mixed = (hash ^ (hash >> 32)) * 0x9e3779b97f4a7c15ul;
+            h1 = (mixed >> 32);
+            h2 = ctrl_t((mixed >> 25) & 0x7f);
+        }
+    };
+
+public:
+    class const_iterator;
+    class iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = Value;
+        using reference = Value&;
+        using pointer = Value*;
+        using iterator_category = std::forward_iterator_tag;
+
+        constexpr explicit iterator(swiss_hashtable * hash) noexcept : _current(0), _hashTable(hash) {
+            if ((_current < _hashTable->capacity()) && !_hashTable->is_full(_current)) {
+                advanceToNextValidHash();
+            }
+        }
+        constexpr iterator(swiss_hashtable * hash, size_t pos) noexcept : _current(pos), _hashTable(hash) { }
+        constexpr static iterator end(swiss_hashtable *hash) noexcept { return iterator(hash, hash->capacity()); }
+
+        constexpr Value & operator * ()  const noexcept { return _hashTable->get(_current); }
+        constexpr Value * operator -> () const noexcept { return & _hashTable->get(_current); }
+        iterator & operator ++ () noexcept {
+            advanceToNextValidHash();
+            return *this;
+        }
+        iterator operator ++ (int) noexcept {
+            iterator prev = *this;
+            ++(*this);
+            return prev;
+        }
+        constexpr bool operator==(const iterator& rhs) const noexcept { return (_current == rhs._current); }
+        constexpr bool operator!=(const iterator& rhs) const noexcept { return (_current != rhs._current); }
+    private:
+        void advanceToNextValidHash() noexcept {
+            ++_current;
+            while ((_current < _hashTable->capacity()) && ! _hashTable->is_full(_current)) {
+                ++_current;
+            }
+        }
+        size_t            _current;
+        swiss_hashtable * _hashTable;
+
+        friend class swiss_hashtable::const_iterator;
+    };
+    class const_iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = const Value;
+        using reference = const Value&;
+        using pointer = const Value*;
+        using iterator_category = std::forward_iterator_tag;
+
+        constexpr explicit const_iterator(const swiss_hashtable * hash) noexcept : _current(0), _hashTable(hash) {
+            if ((_current < _hashTable->capacity()) && !_hashTable->is_full(_current)) {
+                advanceToNextValidHash();
+            }
+        }
+        constexpr const_iterator(const swiss_hashtable * hash, size_t pos) noexcept : _current(pos), _hashTable(hash) { }
+        constexpr const_iterator(const iterator &i) noexcept :  _current(i._current), _hashTable(i._hashTable) {}
+        static constexpr const_iterator end(const swiss_hashtable *hash) noexcept { return const_iterator(hash, hash->capacity()); }
+
+        constexpr const Value & operator * ()  const noexcept { return _hashTable->get(_current); }
+        constexpr const Value * operator -> () const noexcept { return & _hashTable->get(_current); }
+        const_iterator & operator ++ () noexcept {
+            advanceToNextValidHash();
+            return *this;
+        }
+        const_iterator operator ++ (int) noexcept {
+            const_iterator prev = *this;
+            ++(*this);
+            return prev;
+        }
+        constexpr bool operator==(const const_iterator& rhs) const noexcept { return (_current == rhs._current); }
+        constexpr bool operator!=(const const_iterator& rhs) const noexcept { return (_current != rhs._current); }
+    private:
+        void advanceToNextValidHash() noexcept {
+            ++_current;
+            while ((_current < _hashTable->capacity()) && ! _hashTable->is_full(_current)) {
+                ++_current;
+            }
+        }
+        size_t                  _current;
+        const swiss_hashtable * _hashTable;
+    };
+    using insert_result = std::pair<iterator, bool>;
+
+public:
+    swiss_hashtable(swiss_hashtable &&rhs) noexcept;
+    swiss_hashtable & operator = (swiss_hashtable &&rhs) noexcept;
+    swiss_hashtable(const swiss_hashtable &);
+    swiss_hashtable & operator = (const swiss_hashtable &);
+    explicit swiss_hashtable(size_t reservedSpace);
+    swiss_hashtable(size_t reservedSpace, const Hash & hasher, const Equal & equal);
+    ~swiss_hashtable();
+    constexpr iterator begin()             noexcept { return iterator(this); }
+    constexpr iterator end()               noexcept { return iterator::end(this); }
+    constexpr const_iterator begin() const noexcept { return const_iterator(this); }
+    constexpr const_iterator end()   const noexcept { return const_iterator::end(this); }
+    constexpr size_t capacity()      const noexcept { return _num_groups * group_size; }
+    constexpr size_t size()          const noexcept { return _count; }
+    constexpr bool empty()           const noexcept { return _count == 0; }
+
+    template< typename AltKey>
+    iterator find(const AltKey & key) noexcept { return iterator(this, find_index(key)); }
+    iterator find(const Key & key) noexcept { return iterator(this, find_index(key)); }
+    template< typename AltKey>
+    const_iterator find(const AltKey & key) const noexcept { return const_iterator(this, find_index(key)); }
+    const_iterator find(const Key & key) const noexcept { return const_iterator(this, find_index(key)); }
+
+    // Prefetch the group a later find for the given key will start in.
+    template< typename AltKey>
+    void prefetch(const AltKey & key) const noexcept {
+        size_t group = HashBits(_hasher(key)).h1 & group_mask();
+        __builtin_prefetch(&_ctrl[group * group_size]);
+        __builtin_prefetch(&_slots[group * group_size]);
+    }
+    template <typename V>
+    insert_result insert(V && node);
+    // This will insert unconditionally, without checking presence, and might cause duplicates.
+    // Use at you own risk.
+    void force_insert(Value && value);
+
+    /// This gives faster iteration than can be achieved by the iterators.
+    template <typename Func>
+    void for_each(Func func) const;
+
+    void erase(const Key & key);
+    void reserve(size_t sz) {
+        if (sz > max_count(_num_groups)) {
+            resize(sz);
+        }
+    }
+    void clear();
+    void resize(size_t newSize) __attribute__((noinline));
+    void swap(swiss_hashtable & rhs) noexcept;
+
+    /**
+     * Get an approximate number of the memory allocated (in bytes) by this hash table.
+     * Not including any data K would store outside of sizeof(K) of course.
+     */
+    size_t getMemoryConsumption() const;
+
+    /**
+     * Get an approximate number of memory used (in bytes) by this hash table.
+     * Note that getMemoryConsumption() >= getMemoryUsed().
+     */
+    size_t getMemoryUsed() const;
+
+private:
+    size_t                    _num_groups;
+    size_t                    _count;
+    size_t                    _growth_left;
+    std::unique_ptr<ctrl_t[]> _ctrl;
+    std::unique_ptr<Slot[]>   _slots;
+    Hash                      _hasher;
+    Equal                     _equal;
+    KeyExtract                _keyExtractor;
+
+    static constexpr size_t max_count(size_t num_groups) noexcept { return (num_groups * group_size * 7) / 8; }
+    static size_t groups_needed(size_t count) noexcept;
+    constexpr size_t group_mask() const noexcept { return _num_groups - 1; }
+    constexpr bool is_full(size_t idx) const noexcept { return _ctrl[idx] >= 0; }
+    Value & get(size_t index)                       noexcept { return _slots[index].get(); }
+    constexpr const Value & get(size_t index) const noexcept { return _slots[index].get(); }
+
+    template <typename K>
+    size_t find_index(const K & key) const noexcept;
+    size_t find_free(const HashBits & bits) const noexcept;
+    void init_storage(size_t num_groups);
+    void rehash(size_t num_groups);
+    void destroy_all() noexcept;
+    template <typename V>
+    void emplace_at(size_t idx, ctrl_t h2, V && node);
+    void grow() __attribute__((noinline));
+};
+
+/**
+ * Selects the hashtable implementation used by hash_map and hash_set
+ * based on their modulator template parameter.
+ **/
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract, typename Modulator>
+struct select_hashtable {
+    using type = hashtable<Key, Value, Hash, Equal, KeyExtract, Modulator>;
+};
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+struct select_hashtable<Key, Value, Hash, Equal, KeyExtract, hashtable_base::open_addressing> {
+    using type = swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>;
+};
+
+}
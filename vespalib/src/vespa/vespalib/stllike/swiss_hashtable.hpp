@@ -0,0 +1,342 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "swiss_hashtable.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace vespalib {
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+size_t
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::groups_needed(size_t count) noexcept
+{
+    size_t slots = (count * 8 + 6) / 7;
+    size_t groups = (slots + group_size - 1) / group_size;
+    return (groups > 1) ? roundUp2inN(groups) : 1;
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::init_storage(size_t num_groups)
+{
+    size_t num_slots = num_groups * group_size;
+    _ctrl.reset(new ctrl_t[num_slots]);
+    _slots.reset(new Slot[num_slots]);
+    memset(_ctrl.get(), ctrl_empty, num_slots);
+    _num_groups = num_groups;
+    _count = 0;
+    _growth_left = max_count(num_groups);
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::destroy_all() noexcept
+{
+    if constexpr (!can_skip_destruction<Value>) {
+        for (size_t i = 0; i < capacity(); ++i) {
+            if (is_full(i)) {
+                get(i).~Value();
+            }
+        }
+    }
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::swiss_hashtable(size_t reservedSpace)
+    : _num_groups(0),
+      _count(0),
+      _growth_left(0),
+      _ctrl(),
+      _slots(),
+      _hasher(),
+      _equal(),
+      _keyExtractor()
+{
+    init_storage(groups_needed(reservedSpace));
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::swiss_hashtable(size_t reservedSpace, const Hash & hasher, const Equal & equal)
+    : _num_groups(0),
+      _count(0),
+      _growth_left(0),
+      _ctrl(),
+      _slots(),
+      _hasher(hasher),
+      _equal(equal),
+      _keyExtractor()
+{
+    init_storage(groups_needed(reservedSpace));
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::swiss_hashtable(const swiss_hashtable & rhs)
+    : _num_groups(0),
+      _count(0),
+      _growth_left(0),
+      _ctrl(),
+      _slots(),
+      _hasher(rhs._hasher),
+      _equal(rhs._equal),
+      _keyExtractor(rhs._keyExtractor)
+{
+    init_storage(rhs._num_groups);
+    for (size_t i = 0; i < capacity(); ++i) {
+        if (rhs.is_full(i)) {
+            new (_slots[i].mem) Value(rhs.get(i));
+        }
+    }
+    memcpy(_ctrl.get(), rhs._ctrl.get(), capacity());
+    _count = rhs._count;
+    _growth_left = rhs._growth_left;
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract> &
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::operator = (const swiss_hashtable & rhs)
+{
+    if (this != &rhs) {
+        swiss_hashtable tmp(rhs);
+        swap(tmp);
+    }
+    return *this;
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::swiss_hashtable(swiss_hashtable && rhs) noexcept
+    : _num_groups(std::exchange(rhs._num_groups, 0)),
+      _count(std::exchange(rhs._count, 0)),
+      _growth_left(std::exchange(rhs._growth_left, 0)),
+      _ctrl(std::move(rhs._ctrl)),
+      _slots(std::move(rhs._slots)),
+      _hasher(std::move(rhs._hasher)),
+      _equal(std::move(rhs._equal)),
+      _keyExtractor(std::move(rhs._keyExtractor))
+{
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract> &
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::operator = (swiss_hashtable && rhs) noexcept
+{
+    if (this != &rhs) {
+        destroy_all();
+        _num_groups = std::exchange(rhs._num_groups, 0);
+        _count = std::exchange(rhs._count, 0);
+        _growth_left = std::exchange(rhs._growth_left, 0);
+        _ctrl = std::move(rhs._ctrl);
+        _slots = std::move(rhs._slots);
+        _hasher = std::move(rhs._hasher);
+        _equal = std::move(rhs._equal);
+        _keyExtractor = std::move(rhs._keyExtractor);
+    }
+    return *this;
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::~swiss_hashtable()
+{
+    destroy_all();
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::swap(swiss_hashtable & rhs) noexcept
+{
+    std::swap(_num_groups, rhs._num_groups);
+    std::swap(_count, rhs._count);
+    std::swap(_growth_left, rhs._growth_left);
+    _ctrl.swap(rhs._ctrl);
+    _slots.swap(rhs._slots);
+    std::swap(_hasher, rhs._hasher);
+    std::swap(_equal, rhs._equal);
+    std::swap(_keyExtractor, rhs._keyExtractor);
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+template< typename K>
+size_t
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::find_index(const K & key) const noexcept
+{
+    HashBits bits(_hasher(key));
+    size_t group = bits.h1 & group_mask();
+    for (size_t probe = 1; ; ++probe) {
+        size_t base = group * group_size;
+        Group ctrl(&_ctrl[base]);
+        for (uint32_t match = ctrl.match(bits.h2); match != 0; match &= (match - 1)) {
+            size_t idx = base + __builtin_ctz(match);
+            if (__builtin_expect(_equal(_keyExtractor(get(idx)), key), true)) {
+                return idx;
+            }
+        }
+        if (__builtin_expect(ctrl.match_empty() != 0, true)) {
+            return capacity();
+        }
+        group = (group + probe) & group_mask();
+    }
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+size_t
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::find_free(const HashBits & bits) const noexcept
+{
+    size_t group = bits.h1 & group_mask();
+    for (size_t probe = 1; ; ++probe) {
+        size_t base = group * group_size;
+        uint32_t match = Group(&_ctrl[base]).match_free();
+        if (__builtin_expect(match != 0, true)) {
+            return base + __builtin_ctz(match);
+        }
+        group = (group + probe) & group_mask();
+    }
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+template< typename V>
+void
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::emplace_at(size_t idx, ctrl_t h2, V && node)
+{
+    new (_slots[idx].mem) Value(std::forward<V>(node));
+    if (_ctrl[idx] == ctrl_empty) {
+        --_growth_left;
+    }
+    _ctrl[idx] = h2;
+    ++_count;
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+template< typename V>
+typename swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::insert_result
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::insert(V && node)
+{
+    size_t idx = find_index(_keyExtractor(node));
+    if (idx != capacity()) {
+        return insert_result(iterator(this, idx), false);
+    }
+    HashBits bits(_hasher(_keyExtractor(node)));
+    idx = find_free(bits);
+    if (_growth_left == 0 && _ctrl[idx] == ctrl_empty) [[unlikely]] {
+        grow();
+        idx = find_free(bits);
+    }
+    emplace_at(idx, bits.h2, std::forward<V>(node));
+    return insert_result(iterator(this, idx), true);
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::force_insert(Value && value)
+{
+    HashBits bits(_hasher(_keyExtractor(value)));
+    size_t idx = find_free(bits);
+    if (_growth_left == 0 && _ctrl[idx] == ctrl_empty) [[unlikely]] {
+        grow();
+        idx = find_free(bits);
+    }
+    emplace_at(idx, bits.h2, std::move(value));
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+template <typename Func>
+void
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::for_each(Func func) const
+{
+    for (size_t i = 0; i < capacity(); ++i) {
+        if (is_full(i)) {
+            func(get(i));
+        }
+    }
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::erase(const Key & key)
+{
+    size_t idx = find_index(key);
+    if (idx == capacity()) {
+        return;
+    }
+    if constexpr (!can_skip_destruction<Value>) {
+        get(idx).~Value();
+    }
+    // lookups stop at a group with an empty slot, so a slot may be
+    // made empty (rather than deleted) if its group already has one.
+    size_t base = idx & ~(group_size - 1);
+    if (Group(&_ctrl[base]).match_empty() != 0) {
+        _ctrl[idx] = ctrl_empty;
+        ++_growth_left;
+    } else {
+        _ctrl[idx] = ctrl_deleted;
+    }
+    --_count;
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::clear()
+{
+    if (_count == 0 && _growth_left == max_count(_num_groups)) {
+        return; // Already empty and without deleted slots
+    }
+    destroy_all();
+    memset(_ctrl.get(), ctrl_empty, capacity());
+    _count = 0;
+    _growth_left = max_count(_num_groups);
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::resize(size_t newSize)
+{
+    rehash(std::max(groups_needed(newSize), groups_needed(_count)));
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::rehash(size_t num_groups)
+{
+    size_t old_capacity = capacity();
+    std::unique_ptr<ctrl_t[]> old_ctrl = std::move(_ctrl);
+    std::unique_ptr<Slot[]> old_slots = std::move(_slots);
+    init_storage(num_groups);
+    for (size_t i = 0; i < old_capacity; ++i) {
+        if (old_ctrl[i] >= 0) {
+            Value &value = old_slots[i].get();
+            HashBits bits(_hasher(_keyExtractor(value)));
+            emplace_at(find_free(bits), bits.h2, std::move(value));
+            if constexpr (!can_skip_destruction<Value>) {
+                value.~Value();
+            }
+        }
+    }
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::grow()
+{
+    // keep the size if most of the used up slots are deleted ones
+    if (_count * 2 <= max_count(_num_groups)) {
+        rehash(_num_groups);
+    } else {
+        rehash(_num_groups * 2);
+    }
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+size_t
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::getMemoryConsumption() const
+{
+    return sizeof(swiss_hashtable) + capacity() * (sizeof(Slot) + sizeof(ctrl_t));
+}
+
+template< typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+size_t
+swiss_hashtable<Key, Value, Hash, Equal, KeyExtract>::getMemoryUsed() const
+{
+    return sizeof(swiss_hashtable) + _count * sizeof(Slot) + capacity() * sizeof(ctrl_t);
+}
+
+}
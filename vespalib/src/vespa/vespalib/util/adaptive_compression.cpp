@@ -0,0 +1,138 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "adaptive_compression.h"
+#include "compressor.h"
+#include <vespa/vespalib/data/databuffer.h>
+
+namespace vespalib::compression {
+
+namespace {
+
+// weight of a new throughput sample in the moving average
+constexpr double sample_weight = 0.1;
+
+}
+
+AdaptiveCompression::Config::Config() noexcept
+    : dense(CompressionConfig::ZSTD, 3, 90),
+      dense_min_size(0),
+      slow_link_bytes_per_second(100e6)
+{
+}
+
+void
+AdaptiveCompression::LinkEstimate::observe_transfer(size_t bytes, duration elapsed) noexcept
+{
+    if ((bytes < min_sample_bytes) || (elapsed <= duration::zero())) {
+        return;
+    }
+    double sample = double(bytes) / to_s(elapsed);
+    double old_value = _bytes_per_second.load(std::memory_order_relaxed);
+    double new_value;
+    do {
+        new_value = (old_value == 0.0) ? sample : (old_value * (1.0 - sample_weight) + sample * sample_weight);
+    } while (!_bytes_per_second.compare_exchange_weak(old_value, new_value, std::memory_order_relaxed));
+}
+
+AdaptiveCompression::TypeStats
+AdaptiveCompression::TypeStats::subtract(const TypeStats &rhs) const noexcept
+{
+    TypeStats result;
+    result.payloads = payloads - rhs.payloads;
+    result.input_bytes = input_bytes - rhs.input_bytes;
+    result.output_bytes = output_bytes - rhs.output_bytes;
+    return result;
+}
+
+AdaptiveCompression::Stats
+AdaptiveCompression::Stats::subtract(const Stats &rhs) const noexcept
+{
+    Stats result;
+    result.none = none.subtract(rhs.none);
+    result.lz4 = lz4.subtract(rhs.lz4);
+    result.zstd = zstd.subtract(rhs.zstd);
+    return result;
+}
+
+void
+AdaptiveCompression::AtomicTypeStats::add(size_t input, size_t output) noexcept
+{
+    payloads.fetch_add(1, std::memory_order_relaxed);
+    input_bytes.fetch_add(input, std::memory_order_relaxed);
+    output_bytes.fetch_add(output, std::memory_order_relaxed);
+}
+
+AdaptiveCompression::TypeStats
+AdaptiveCompression::AtomicTypeStats::load() const noexcept
+{
+    TypeStats result;
+    result.payloads = payloads.load(std::memory_order_relaxed);
+    result.input_bytes = input_bytes.load(std::memory_order_relaxed);
+    result.output_bytes = output_bytes.load(std::memory_order_relaxed);
+    return result;
+}
+
+AdaptiveCompression::AdaptiveCompression(CompressionConfig base) noexcept
+    : AdaptiveCompression(base, Config())
+{
+}
+
+AdaptiveCompression::AdaptiveCompression(CompressionConfig base, Config config) noexcept
+    : _base(base),
+      _config(config),
+      _none(),
+      _lz4(),
+      _zstd()
+{
+}
+
+AdaptiveCompression::~AdaptiveCompression() = default;
+
+CompressionConfig
+AdaptiveCompression::select(size_t size, const LinkEstimate *link) const noexcept
+{
+    if ((_config.dense_min_size == 0) || (size < _config.dense_min_size)) {
+        return _base;
+    }
+    double throughput = (link != nullptr) ? link->bytes_per_second() : 0.0;
+    if ((throughput > 0.0) && (throughput >= _config.slow_link_bytes_per_second)) {
+        return _base;
+    }
+    return _config.dense;
+}
+
+CompressionConfig::Type
+AdaptiveCompression::compress(const ConstBufferRef &org, DataBuffer &dest, const LinkEstimate *link)
+{
+    size_t before = dest.getDataLen();
+    auto type = vespalib::compression::compress(select(org.size(), link), org, dest, false);
+    observe(type, org.size(), dest.getDataLen() - before);
+    return type;
+}
+
+void
+AdaptiveCompression::observe(CompressionConfig::Type type, size_t input_bytes, size_t output_bytes) noexcept
+{
+    switch (type) {
+    case CompressionConfig::LZ4:
+        _lz4.add(input_bytes, output_bytes);
+        break;
+    case CompressionConfig::ZSTD:
+        _zstd.add(input_bytes, output_bytes);
+        break;
+    default:
+        _none.add(input_bytes, output_bytes);
+    }
+}
+
+AdaptiveCompression::Stats
+AdaptiveCompression::stats() const noexcept
+{
+    Stats result;
+    result.none = _none.load();
+    result.lz4 = _lz4.load();
+    result.zstd = _zstd.load();
+    return result;
+}
+
+}
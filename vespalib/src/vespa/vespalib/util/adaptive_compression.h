@@ -0,0 +1,111 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "compressionconfig.h"
+#include "time.h"
+#include <atomic>
+
+namespace vespalib { class ConstBufferRef; class DataBuffer; }
+
+namespace vespalib::compression {
+
+/**
+ * Selects the compression to use for a single network payload. Small
+ * payloads, and payloads sent over fast links, use the base
+ * compression (typically fast, e.g. lz4). Payloads of at least
+ * 'dense_min_size' bytes sent over links measured to be slower than
+ * 'slow_link_bytes_per_second' use the dense compression (typically
+ * zstd) instead, trading cpu for bandwidth where bandwidth is scarce.
+ * Links without a throughput estimate are treated as slow.
+ *
+ * The compression type is carried with each payload, so receivers do
+ * not need to know which compression the sender selected.
+ *
+ * Compression ratios per type are tracked for metrics. All methods
+ * are thread safe.
+ **/
+class AdaptiveCompression {
+public:
+    struct Config {
+        CompressionConfig dense;
+        size_t            dense_min_size; // 0 disables dense compression
+        double            slow_link_bytes_per_second;
+        Config() noexcept;
+    };
+
+    /**
+     * Estimate of the throughput of a single link (connection), based
+     * on the time it takes to transfer request/response pairs. Only
+     * transfers of at least 'min_sample_bytes' are sampled, since the
+     * round trip latency dominates smaller transfers.
+     **/
+    class LinkEstimate {
+        std::atomic<double> _bytes_per_second; // 0 means unknown
+    public:
+        static constexpr size_t min_sample_bytes = 64 * 1024;
+        LinkEstimate() noexcept : _bytes_per_second(0.0) {}
+        void observe_transfer(size_t bytes, duration elapsed) noexcept;
+        double bytes_per_second() const noexcept { return _bytes_per_second.load(std::memory_order_relaxed); }
+    };
+
+    struct TypeStats {
+        uint64_t payloads;
+        uint64_t input_bytes;
+        uint64_t output_bytes;
+        TypeStats() noexcept : payloads(0), input_bytes(0), output_bytes(0) {}
+        double ratio() const noexcept {
+            return (output_bytes > 0) ? double(input_bytes) / double(output_bytes) : 1.0;
+        }
+        TypeStats subtract(const TypeStats &rhs) const noexcept;
+    };
+    struct Stats {
+        TypeStats none; // not compressed, including uncompressable payloads
+        TypeStats lz4;
+        TypeStats zstd;
+        Stats subtract(const Stats &rhs) const noexcept;
+    };
+
+private:
+    struct AtomicTypeStats {
+        std::atomic<uint64_t> payloads;
+        std::atomic<uint64_t> input_bytes;
+        std::atomic<uint64_t> output_bytes;
+        AtomicTypeStats() noexcept : payloads(0), input_bytes(0), output_bytes(0) {}
+        void add(size_t input, size_t output) noexcept;
+        TypeStats load() const noexcept;
+    };
+
+    CompressionConfig _base;
+    Config            _config;
+    AtomicTypeStats   _none;
+    AtomicTypeStats   _lz4;
+    AtomicTypeStats   _zstd;
+
+public:
+    explicit AdaptiveCompression(CompressionConfig base) noexcept;
+    AdaptiveCompression(CompressionConfig base, Config config) noexcept;
+    AdaptiveCompression(const AdaptiveCompression &) = delete;
+    AdaptiveCompression &operator=(const AdaptiveCompression &) = delete;
+    ~AdaptiveCompression();
+
+    const CompressionConfig &base() const noexcept { return _base; }
+    const Config &config() const noexcept { return _config; }
+
+    /**
+     * Select the compression for a payload of the given size sent over
+     * the given link. The link may be nullptr if it is not known.
+     **/
+    CompressionConfig select(size_t size, const LinkEstimate *link) const noexcept;
+
+    /**
+     * Compress the payload as selected for the given link, appending
+     * the result to dest (see vespalib::compression::compress) and
+     * tracking the resulting compression ratio.
+     **/
+    CompressionConfig::Type compress(const ConstBufferRef &org, DataBuffer &dest, const LinkEstimate *link);
+
+    void observe(CompressionConfig::Type type, size_t input_bytes, size_t output_bytes) noexcept;
+    Stats stats() const noexcept;
+};
+
+}
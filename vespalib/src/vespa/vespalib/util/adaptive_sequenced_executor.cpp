@@ -8,7 +8,8 @@ namespace vespalib {
 
 AdaptiveSequencedExecutor::Strand::Strand() noexcept
     : state(State::IDLE),
-      queue()
+      queue(),
+      stats()
 {
 }
 
@@ -172,13 +173,34 @@ AdaptiveSequencedExecutor::exchange_strand(Worker &worker, std::unique_lock<std:
     return true;
 }
 
+void
+AdaptiveSequencedExecutor::maybe_move_id(IdMapping &mapping, const std::unique_lock<std::mutex> &)
+{
+    if ((mapping.in_flight > 0) || (_strands[mapping.strand].state == Strand::State::IDLE)) {
+        return;
+    }
+    // the strand is busy with other ids; look for an idle strand close by
+    constexpr size_t max_probes = 8;
+    for (size_t i = 0; i < std::min(max_probes, _strands.size()); ++i) {
+        size_t candidate = _next_probe;
+        _next_probe = (_next_probe + 1) % _strands.size();
+        if (_strands[candidate].state == Strand::State::IDLE) {
+            mapping.strand = candidate;
+            ++_moved_ids;
+            return;
+        }
+    }
+}
+
 AdaptiveSequencedExecutor::TaggedTask
-AdaptiveSequencedExecutor::next_task(Worker &worker, std::optional<uint32_t> prev_token)
+AdaptiveSequencedExecutor::next_task(Worker &worker, std::optional<uint32_t> prev_token, uint32_t prev_id)
 {
     TaggedTask task;
     auto guard = std::unique_lock(_mutex);
     if (prev_token.has_value()) {
         _barrier.completeEvent(prev_token.value());
+        assert(_ids[prev_id].in_flight > 0);
+        --_ids[prev_id].in_flight;
     }
     if (exchange_strand(worker, guard)) {
         assert(worker.state == Worker::State::RUNNING);
@@ -201,20 +223,25 @@ AdaptiveSequencedExecutor::worker_main()
 {
     Worker worker;
     std::optional<uint32_t> prev_token = std::nullopt;
-    while (TaggedTask my_task = next_task(worker, prev_token)) {
+    uint32_t prev_id = 0;
+    while (TaggedTask my_task = next_task(worker, prev_token, prev_id)) {
         my_task.task->run();
         prev_token = my_task.token;
+        prev_id = my_task.id;
     }
     _thread_tools->allow_worker_exit.await();
 }
 
 AdaptiveSequencedExecutor::AdaptiveSequencedExecutor(size_t num_strands, size_t num_threads,
                                                      size_t max_waiting, size_t max_pending,
-                                                     bool is_max_pending_hard)
-    : ISequencedTaskExecutor(num_strands),
+                                                     bool is_max_pending_hard, size_t ids_per_strand)
+    : ISequencedTaskExecutor(num_strands * std::max(ids_per_strand, size_t(1))),
       _thread_tools(std::make_unique<ThreadTools>(*this)),
       _mutex(),
       _strands(num_strands),
+      _ids(),
+      _next_probe(0),
+      _moved_ids(0),
       _wait_queue(num_strands),
       _worker_stack(num_threads),
       _self(),
@@ -222,6 +249,10 @@ AdaptiveSequencedExecutor::AdaptiveSequencedExecutor(size_t num_strands, size_t
       _idleTracker(steady_clock::now()),
       _cfg(num_threads, max_waiting, max_pending, is_max_pending_hard)
 {
+    _ids.reserve(getNumExecutors());
+    for (size_t i = 0; i < getNumExecutors(); ++i) {
+        _ids.emplace_back(i % num_strands);
+    }
     _stats.queueSize.add(_self.pending_tasks);
     _thread_tools->start(num_threads);
 }
@@ -250,18 +281,23 @@ AdaptiveSequencedExecutor::~AdaptiveSequencedExecutor()
 
 ISequencedTaskExecutor::ExecutorId
 AdaptiveSequencedExecutor::getExecutorId(uint64_t component) const {
-    return ExecutorId(component % _strands.size());
+    return ExecutorId(component % _ids.size());
 }
 
 void
 AdaptiveSequencedExecutor::executeTask(ExecutorId id, Task::UP task)
 {
-    assert(id.getId() < _strands.size());
-    Strand &strand = _strands[id.getId()];
+    assert(id.getId() < _ids.size());
     auto guard = std::unique_lock(_mutex);
     assert(_self.state != Self::State::CLOSED);
     maybe_block_self(guard);
-    strand.queue.push(TaggedTask(std::move(task), _barrier.startEvent()));
+    IdMapping &mapping = _ids[id.getId()];
+    maybe_move_id(mapping, guard);
+    ++mapping.in_flight;
+    Strand &strand = _strands[mapping.strand];
+    strand.queue.push(TaggedTask(std::move(task), _barrier.startEvent(), id.getId()));
+    ++strand.stats.accepted_tasks;
+    strand.stats.max_queue_size = std::max(strand.stats.max_queue_size, size_t(strand.queue.size()));
     _stats.queueSize.add(++_self.pending_tasks);
     ++_stats.acceptedTasks;
     if (strand.state == Strand::State::WAITING) {
@@ -328,4 +364,26 @@ AdaptiveSequencedExecutor::get_config() const
     return _cfg;
 }
 
+std::vector<AdaptiveSequencedExecutor::StrandStats>
+AdaptiveSequencedExecutor::get_strand_stats()
+{
+    auto guard = std::lock_guard(_mutex);
+    std::vector<StrandStats> result;
+    result.reserve(_strands.size());
+    for (auto &strand: _strands) {
+        result.push_back(strand.stats);
+        result.back().queue_size = strand.queue.size();
+        strand.stats = StrandStats();
+        strand.stats.max_queue_size = strand.queue.size();
+    }
+    return result;
+}
+
+uint64_t
+AdaptiveSequencedExecutor::get_moved_ids() const
+{
+    auto guard = std::lock_guard(_mutex);
+    return _moved_ids;
+}
+
 }
@@ -19,18 +19,40 @@ namespace vespalib {
  * Sequenced executor that balances the number of active threads in
  * order to optimize for throughput over latency by minimizing the
  * number of critical-path wakeups.
+ *
+ * Tasks are queued in strands that any idle worker thread can pick
+ * up, keeping the order of the tasks within a strand. Each executor
+ * id is mapped to a strand (there are ids_per_strand ids for each
+ * strand, initially spread round-robin); when an id with no tasks in flight gets
+ * a new task while its strand is busy with tasks for other ids, the
+ * id is moved to an idle strand. This keeps ids that share a strand
+ * with a hot id from queueing behind it, without breaking the order
+ * of tasks with the same id.
  **/
 class AdaptiveSequencedExecutor : public ISequencedTaskExecutor
 {
+public:
+    /**
+     * Queue statistics for a single strand since the last call to
+     * get_strand_stats().
+     **/
+    struct StrandStats {
+        size_t   queue_size;
+        size_t   max_queue_size;
+        uint64_t accepted_tasks;
+        StrandStats() noexcept : queue_size(0), max_queue_size(0), accepted_tasks(0) {}
+    };
+
 private:
     using Task = Executor::Task;
 
     struct TaggedTask {
         Task::UP task;
         uint32_t token;
-        TaggedTask() : task(nullptr), token(0) {}
-        TaggedTask(Task::UP task_in, uint32_t token_in)
-            : task(std::move(task_in)), token(token_in) {}
+        uint32_t id;
+        TaggedTask() : task(nullptr), token(0), id(0) {}
+        TaggedTask(Task::UP task_in, uint32_t token_in, uint32_t id_in)
+            : task(std::move(task_in)), token(token_in), id(id_in) {}
         TaggedTask(TaggedTask &&rhs) = default;
         TaggedTask(const TaggedTask &rhs) = delete;
         TaggedTask &operator=(const TaggedTask &rhs) = delete;
@@ -38,11 +60,21 @@ private:
             assert(task.get() == nullptr); // no overwrites
             task = std::move(rhs.task);
             token = rhs.token;
+            id = rhs.id;
             return *this;
         }
         operator bool() const { return bool(task); }
     };
 
+    /**
+     * The strand currently handling the tasks of an executor id.
+     **/
+    struct IdMapping {
+        uint32_t strand;
+        uint32_t in_flight;
+        explicit IdMapping(uint32_t strand_in) noexcept : strand(strand_in), in_flight(0) {}
+    };
+
     /**
      * Values used to configure the executor.
      **/
@@ -80,6 +112,7 @@ private:
         enum class State { IDLE, WAITING, ACTIVE };
         State state;
         ArrayQueue<TaggedTask> queue;
+        StrandStats stats;
         Strand() noexcept;
         ~Strand();
     };
@@ -131,6 +164,9 @@ private:
     std::unique_ptr<ThreadTools>       _thread_tools;
     mutable std::mutex                 _mutex;
     std::vector<Strand>                _strands;
+    std::vector<IdMapping>             _ids;
+    size_t                             _next_probe;
+    uint64_t                           _moved_ids;
     ArrayQueue<Strand*>                _wait_queue;
     ArrayQueue<Worker*>                _worker_stack;
     EventBarrier<BarrierCompletion>    _barrier;
@@ -145,12 +181,13 @@ private:
     void maybe_wake_worker(const std::unique_lock<std::mutex> &lock);
     bool obtain_strand(Worker &worker, std::unique_lock<std::mutex> &lock);
     bool exchange_strand(Worker &worker, std::unique_lock<std::mutex> &lock);
-    TaggedTask next_task(Worker &worker, std::optional<uint32_t> prev_token);
+    void maybe_move_id(IdMapping &mapping, const std::unique_lock<std::mutex> &lock);
+    TaggedTask next_task(Worker &worker, std::optional<uint32_t> prev_token, uint32_t prev_id);
     void worker_main();
 public:
     AdaptiveSequencedExecutor(size_t num_strands, size_t num_threads,
                               size_t max_waiting, size_t max_pending,
-                              bool is_max_pending_hard);
+                              bool is_max_pending_hard, size_t ids_per_strand = 1);
     ~AdaptiveSequencedExecutor() override;
     ExecutorId getExecutorId(uint64_t component) const override;
     void executeTask(ExecutorId id, Task::UP task) override;
@@ -158,6 +195,15 @@ public:
     void setTaskLimit(uint32_t task_limit) override;
     ExecutorStats getStats() override;
     Config get_config() const;
+    size_t num_strands() const noexcept { return _strands.size(); }
+
+    /**
+     * Returns the queue statistics of each strand, resetting the
+     * accepted task count and max queue size of each strand.
+     **/
+    std::vector<StrandStats> get_strand_stats();
+    // number of times an executor id has been moved to another strand
+    uint64_t get_moved_ids() const;
 };
 
 }
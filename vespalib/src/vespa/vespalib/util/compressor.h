@@ -43,6 +43,17 @@ CompressionConfig::Type compress(CompressionConfig compression, const vespalib::
  */
 void decompress(CompressionConfig::Type compression, size_t uncompressedLen, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap);
 
+/**
+ * Compress using the given compressor, e.g. one with a dictionary. Returns NONE and leaves dest
+ * untouched if the compression criteria in the config can not be met.
+ */
+CompressionConfig::Type compress(ICompressor & compressor, CompressionConfig compression, const ConstBufferRef & org, DataBuffer & dest);
+
+/**
+ * Decompress using the given compressor, e.g. one with a dictionary. Throws if decompression fails.
+ */
+void decompress(ICompressor & decompressor, size_t uncompressedLen, const ConstBufferRef & org, DataBuffer & dest, bool allowSwap);
+
 size_t computeMaxCompressedsize(CompressionConfig::Type type, size_t uncompressedSize);
 
 //-----------------------------------------------------------------------------
@@ -107,6 +107,12 @@ CpuUsage::ThreadTrackerImpl::sample() noexcept
     return sample;
 }
 
+namespace {
+
+thread_local CpuUsage::Category my_category = CpuUsage::Category::OTHER;
+
+}
+
 std::string &
 CpuUsage::name_of(Category cat)
 {
@@ -128,9 +134,16 @@ CpuUsage::MyUsage::set_cpu_category_for_this_thread(Category cat) noexcept
         }
     };
     thread_local Wrapper wrapper;
+    my_category = cat;
     return wrapper.self->set_category(cat);
 }
 
+CpuUsage::Category
+CpuUsage::category_of_this_thread() noexcept
+{
+    return my_category;
+}
+
 CpuUsage::CpuUsage()
   : _lock(),
     _usage(),
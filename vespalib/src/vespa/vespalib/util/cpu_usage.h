@@ -182,6 +182,10 @@ private:
 
 public:
     static MyUsage use(Category cat) { return MyUsage(cat); }
+    // The category currently declared by the calling thread. Only
+    // reads a thread local variable, so it is safe to use from a
+    // signal handler.
+    static Category category_of_this_thread() noexcept;
     static TimedSample sample();
     static Runnable::init_fun_t wrap(Runnable::init_fun_t init, Category cat);
     static Executor::Task::UP wrap(Executor::Task::UP task, Category cat);
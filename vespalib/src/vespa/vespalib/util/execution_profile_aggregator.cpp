@@ -0,0 +1,135 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "execution_profile_aggregator.h"
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <algorithm>
+
+namespace vespalib {
+
+ExecutionProfileAggregator::Node::Node(const std::string &name_in)
+  : name(name_in),
+    count(0),
+    total_time_ms(0.0),
+    children()
+{
+}
+
+ExecutionProfileAggregator::Node::Node(Node &&) noexcept = default;
+ExecutionProfileAggregator::Node::~Node() = default;
+
+void
+ExecutionProfileAggregator::merge_children(NodeId parent, const slime::Inspector &children)
+{
+    for (size_t i = 0; i < children.entries(); ++i) {
+        const auto &child = children[i];
+        std::string name = child["name"].asString().make_string();
+        NodeId node;
+        auto pos = edges_of(parent).find(name);
+        if (pos != edges_of(parent).end()) {
+            node = pos->second;
+        } else if (_nodes.size() < _max_nodes) {
+            node = _nodes.size();
+            edges_of(parent).insert(std::make_pair(name, node));
+            _nodes.emplace_back(name); // may invalidate references to edges
+        } else {
+            ++_dropped;
+            continue;
+        }
+        _nodes[node].count += child["count"].asLong();
+        _nodes[node].total_time_ms += child["total_time_ms"].asDouble();
+        merge_children(node, child["children"]);
+    }
+}
+
+double
+ExecutionProfileAggregator::children_time(const Edges &edges) const
+{
+    double result = 0.0;
+    for (const auto &entry: edges) {
+        result += _nodes[entry.second].total_time_ms;
+    }
+    return result;
+}
+
+void
+ExecutionProfileAggregator::render_children(slime::Cursor &arr, const Edges &edges) const
+{
+    std::vector<NodeId> children;
+    children.reserve(edges.size());
+    for (const auto &entry: edges) {
+        children.push_back(entry.second);
+    }
+    std::sort(children.begin(), children.end(),
+              [&](const auto &a, const auto &b) {
+                  return (_nodes[a].total_time_ms > _nodes[b].total_time_ms);
+              });
+    for (NodeId child: children) {
+        const Node &node = _nodes[child];
+        auto &obj = arr.addObject();
+        obj.setString("name", node.name);
+        obj.setLong("count", node.count);
+        obj.setDouble("total_time_ms", node.total_time_ms);
+        if (!node.children.empty()) {
+            obj.setDouble("self_time_ms", node.total_time_ms - children_time(node.children));
+            render_children(obj.setArray("children"), node.children);
+        }
+    }
+}
+
+ExecutionProfileAggregator::ExecutionProfileAggregator(size_t max_nodes)
+  : _lock(),
+    _max_nodes(max_nodes),
+    _profiles(0),
+    _dropped(0),
+    _nodes(),
+    _roots()
+{
+}
+
+ExecutionProfileAggregator::~ExecutionProfileAggregator() = default;
+
+void
+ExecutionProfileAggregator::merge(const slime::Inspector &report)
+{
+    if (report["profiler"].asString().make_stringview() != "tree") {
+        return;
+    }
+    std::lock_guard guard(_lock);
+    ++_profiles;
+    merge_children(no_parent, report["roots"]);
+}
+
+void
+ExecutionProfileAggregator::report(slime::Cursor &obj) const
+{
+    std::lock_guard guard(_lock);
+    obj.setString("profiler", "tree");
+    obj.setLong("profiles", _profiles);
+    obj.setDouble("total_time_ms", children_time(_roots));
+    if (_dropped > 0) {
+        obj.setLong("dropped_tasks", _dropped);
+    }
+    if (!_roots.empty()) {
+        render_children(obj.setArray("roots"), _roots);
+    }
+}
+
+size_t
+ExecutionProfileAggregator::num_profiles() const
+{
+    std::lock_guard guard(_lock);
+    return _profiles;
+}
+
+void
+ExecutionProfileAggregator::reset()
+{
+    std::lock_guard guard(_lock);
+    _profiles = 0;
+    _dropped = 0;
+    _nodes.clear();
+    _roots.clear();
+}
+
+}
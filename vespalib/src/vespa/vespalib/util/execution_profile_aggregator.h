@@ -0,0 +1,71 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace vespalib {
+
+namespace slime {
+struct Cursor;
+struct Inspector;
+}
+
+/**
+ * Merges the reports of many tree ExecutionProfiler runs into a
+ * single tree, where tasks are identified by their (mapped) names
+ * and the path leading to them. This is used to aggregate profiles
+ * of the same kind of work (like the matching done for a rank
+ * profile) across many executions. Counts and times are summed;
+ * hardware counters are not aggregated.
+ *
+ * To bound memory usage, at most max_nodes distinct tasks are
+ * tracked; time spent in tasks not given a node is only included in
+ * the time of their parent. All functions are thread-safe.
+ **/
+class ExecutionProfileAggregator {
+public:
+    static constexpr size_t default_max_nodes = 4096;
+
+private:
+    using NodeId = uint32_t;
+    using Edges = vespalib::hash_map<std::string, NodeId>;
+    struct Node {
+        std::string name;
+        size_t count;
+        double total_time_ms;
+        Edges children;
+        Node(const std::string &name_in);
+        Node(Node &&) noexcept;
+        ~Node();
+    };
+
+    mutable std::mutex _lock;
+    size_t             _max_nodes;
+    size_t             _profiles;
+    size_t             _dropped;
+    std::vector<Node>  _nodes;
+    Edges              _roots;
+
+    static constexpr NodeId no_parent = -1;
+    Edges &edges_of(NodeId parent) { return (parent == no_parent) ? _roots : _nodes[parent].children; }
+    void merge_children(NodeId parent, const slime::Inspector &children);
+    double children_time(const Edges &edges) const;
+    void render_children(slime::Cursor &arr, const Edges &edges) const;
+
+public:
+    explicit ExecutionProfileAggregator(size_t max_nodes = default_max_nodes);
+    ~ExecutionProfileAggregator();
+
+    // merge the output of ExecutionProfiler::report for a tree profiler
+    void merge(const slime::Inspector &report);
+    // same format as a single tree profiler report, with "profiles" added
+    void report(slime::Cursor &obj) const;
+    size_t num_profiles() const;
+    void reset();
+};
+
+}
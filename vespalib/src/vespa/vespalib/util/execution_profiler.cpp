@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "execution_profiler.h"
+#include "hw_counters.h"
 #include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/data/slime/slime.h>
@@ -31,6 +32,44 @@ double as_ms(duration d) {
     return (count_ns(d) / 1000000.0);
 }
 
+using Counters = HwCounters::Sample;
+
+// Hardware counters for the profiled thread; opened on first use
+class CounterSource {
+private:
+    bool _enabled;
+    std::unique_ptr<HwCounters> _counters;
+public:
+    explicit CounterSource(bool enabled) noexcept : _enabled(enabled), _counters() {}
+    bool enabled() const noexcept { return _enabled; }
+    Counters sample() {
+        if (!_enabled) {
+            return {};
+        }
+        if (!_counters) {
+            _counters = std::make_unique<HwCounters>();
+        }
+        return _counters->sample();
+    }
+    void render(slime::Cursor &obj, const std::string &name, const Counters &counters) const {
+        if (!_counters || !_counters->valid()) {
+            return;
+        }
+        auto &dst = obj.setObject(name);
+        for (uint32_t i = 0; i < HwCounters::NUM_COUNTERS; ++i) {
+            auto counter = HwCounters::Counter(i);
+            if (_counters->is_available(counter)) {
+                dst.setLong(HwCounters::name_of(counter), counters[counter]);
+            }
+        }
+    }
+    void report(slime::Cursor &obj) const {
+        if (_enabled) {
+            obj.setBool("hw_counters", _counters && _counters->valid());
+        }
+    }
+};
+
 class TreeProfiler : public ExecutionProfiler::Impl
 {
 private:
@@ -42,23 +81,27 @@ private:
         TaskId task;
         size_t count;
         duration total_time;
+        Counters total_counters;
         Edges children;
         Node(TaskId task_in) noexcept
           : task(task_in),
             count(0),
             total_time(),
+            total_counters(),
             children() {}
     };
     struct Frame {
         NodeId node;
+        Counters start_counters;
         steady_time start;
-        Frame(NodeId node_in) noexcept
-          : node(node_in), start(steady_clock::now()) {}
+        Frame(NodeId node_in, const Counters &counters_in) noexcept
+          : node(node_in), start_counters(counters_in), start(steady_clock::now()) {}
     };
 
     std::vector<Node> _nodes;
     Edges _roots;
     std::vector<Frame> _state;
+    CounterSource _counters;
 
     duration get_children_time(const Edges &edges) const {
         duration result = duration::zero();
@@ -67,6 +110,13 @@ private:
         }
         return result;
     }
+    Counters get_children_counters(const Edges &edges) const {
+        Counters result;
+        for (const auto &entry: edges) {
+            result += _nodes[entry.second].total_counters;
+        }
+        return result;
+    }
     std::vector<NodeId> get_sorted_children(const Edges &edges) const {
         std::vector<uint32_t> children;
         for (const auto &entry: edges) {
@@ -82,9 +132,14 @@ private:
         obj.setString("name", ctx.resolve_name(_nodes[node].task));
         obj.setLong("count", _nodes[node].count);
         obj.setDouble("total_time_ms", as_ms(_nodes[node].total_time));
+        _counters.render(obj, "total_hw_counters", _nodes[node].total_counters);
         if (!_nodes[node].children.empty()) {
             auto children_time = get_children_time(_nodes[node].children);
             obj.setDouble("self_time_ms", as_ms(_nodes[node].total_time - children_time));
+            if (_counters.enabled()) {
+                auto children_counters = get_children_counters(_nodes[node].children);
+                _counters.render(obj, "self_hw_counters", _nodes[node].total_counters - children_counters);
+            }
             render_children(obj.setArray("children"), _nodes[node].children, ctx);
         }
     }
@@ -95,7 +150,7 @@ private:
         }
     }
 public:
-    TreeProfiler() : _nodes(), _roots(), _state() {}
+    explicit TreeProfiler(bool hw_counters) : _nodes(), _roots(), _state(), _counters(hw_counters) {}
     void track_start(TaskId task) override {
         auto &edges = _state.empty() ? _roots : _nodes[_state.back().node].children;
         auto [pos, was_new] = edges.insert(std::make_pair(task, _nodes.size()));
@@ -105,12 +160,15 @@ public:
             _nodes.emplace_back(task);
         }
         assert(node < _nodes.size());
-        _state.emplace_back(node);
+        _state.emplace_back(node, _counters.sample());
     }
     void track_complete() override {
         assert(!_state.empty());
         auto &node = _nodes[_state.back().node];
         auto elapsed = steady_clock::now() - _state.back().start;
+        if (_counters.enabled()) {
+            node.total_counters += (_counters.sample() - _state.back().start_counters);
+        }
         ++node.count;
         node.total_time += elapsed;
         _state.pop_back();
@@ -118,6 +176,7 @@ public:
     void report(slime::Cursor &obj, ReportContext &ctx) const override {
         obj.setString("profiler", "tree");
         obj.setLong("depth", ctx.get_max_depth());
+        _counters.report(obj);
         obj.setDouble("total_time_ms", as_ms(get_children_time(_roots)));
         if (!_roots.empty()) {
             render_children(obj.setArray("roots"), _roots, ctx);
@@ -133,21 +192,27 @@ private:
     struct Node {
         size_t count;
         duration self_time;
+        Counters self_counters;
         Node() noexcept
           : count(0),
-            self_time() {}
+            self_time(),
+            self_counters() {}
     };
     struct Frame {
         TaskId task;
+        Counters start_counters;
+        Counters overlap_counters;
         steady_time start;
         duration overlap;
-        Frame(TaskId task_in) noexcept
-          : task(task_in), start(steady_clock::now()), overlap() {}
+        Frame(TaskId task_in, const Counters &counters_in) noexcept
+          : task(task_in), start_counters(counters_in), overlap_counters(),
+            start(steady_clock::now()), overlap() {}
     };
 
     size_t _topn;
     std::vector<Node> _nodes;
     std::vector<Frame> _state;
+    CounterSource _counters;
 
     duration get_total_time() const {
         duration result = duration::zero();
@@ -174,9 +239,10 @@ private:
         obj.setString("name", ctx.resolve_name(node));
         obj.setLong("count", _nodes[node].count);
         obj.setDouble("self_time_ms", as_ms(_nodes[node].self_time));
+        _counters.render(obj, "self_hw_counters", _nodes[node].self_counters);
     }
 public:
-    FlatProfiler(size_t topn) : _topn(topn), _nodes(), _state() {
+    FlatProfiler(size_t topn, bool hw_counters) : _topn(topn), _nodes(), _state(), _counters(hw_counters) {
         _nodes.reserve(256);
         _state.reserve(64);
     }
@@ -184,23 +250,30 @@ public:
         if (task >= _nodes.size()) {
             _nodes.resize(task + 1);
         }
-        _state.emplace_back(task);
+        _state.emplace_back(task, _counters.sample());
     }
     void track_complete() override {
         assert(!_state.empty());
         auto &state = _state.back();
         auto &node = _nodes[state.task];
         auto elapsed = steady_clock::now() - state.start;
+        Counters used;
+        if (_counters.enabled()) {
+            used = _counters.sample() - state.start_counters;
+            node.self_counters += (used - state.overlap_counters);
+        }
         ++node.count;
         node.self_time += (elapsed - state.overlap);
         _state.pop_back();
         if (!_state.empty()) {
             _state.back().overlap += elapsed;
+            _state.back().overlap_counters += used;
         }
     }
     void report(slime::Cursor &obj, ReportContext &ctx) const override {
         obj.setString("profiler", "flat");
         obj.setLong("topn", _topn);
+        _counters.report(obj);
         obj.setDouble("total_time_ms", as_ms(get_total_time()));
         auto list = get_sorted_nodes();
         if (auto limit = std::min(list.size(), _topn); limit > 0) {
@@ -214,7 +287,7 @@ public:
 
 }
 
-ExecutionProfiler::ExecutionProfiler(int32_t profile_depth)
+ExecutionProfiler::ExecutionProfiler(int32_t profile_depth, bool hw_counters)
   : _level(0),
     _max_depth(),
     _names(),
@@ -224,10 +297,10 @@ ExecutionProfiler::ExecutionProfiler(int32_t profile_depth)
     if (profile_depth < 0) {
         _max_depth = -1;
         size_t topn = -profile_depth;
-        _impl = std::make_unique<FlatProfiler>(topn);
+        _impl = std::make_unique<FlatProfiler>(topn, hw_counters);
     } else {
         _max_depth = profile_depth;
-        _impl = std::make_unique<TreeProfiler>();
+        _impl = std::make_unique<TreeProfiler>(hw_counters);
     }
 }
 
@@ -21,6 +21,12 @@ namespace slime { struct Cursor; }
  * and when it completes. Any sub-task must complete before any parent
  * task. Any task may be executed any number of times and may depend
  * on any other task.
+ *
+ * When hardware counters are enabled, cpu cycles, instructions,
+ * cache misses and branch mispredicts are tracked per task in
+ * addition to time (see HwCounters). Counters are opened lazily by
+ * the first started task, which means that the profiler must be used
+ * by a single thread; the one doing the work being measured.
  **/
 class ExecutionProfiler {
 public:
@@ -42,7 +48,7 @@ private:
     std::unique_ptr<Impl> _impl;
 
 public:
-    ExecutionProfiler(int32_t profile_depth);
+    ExecutionProfiler(int32_t profile_depth, bool hw_counters = false);
     ~ExecutionProfiler();
     TaskId resolve(const std::string &name);
     const std::string &name_of(TaskId task) const { return _names[task]; }
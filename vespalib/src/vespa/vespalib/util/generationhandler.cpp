@@ -1,12 +1,30 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "generationhandler.h"
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <thread>
 
 namespace vespalib {
 
-GenerationHandler::GenerationHold::GenerationHold() noexcept
-    : _refCount(1),
+namespace {
+
+std::atomic<uint32_t> next_thread_shard(0);
+
+// Spread reader threads round robin over the shards
+uint32_t
+thread_shard(uint32_t numShards) noexcept
+{
+    thread_local uint32_t shard = next_thread_shard.fetch_add(1, std::memory_order_relaxed);
+    return (numShards == 1) ? 0 : (shard % numShards);
+}
+
+}
+
+GenerationHandler::GenerationHold::GenerationHold(uint32_t numShards) noexcept
+    : _refCounts(std::make_unique<RefCount[]>(numShards)),
+      _numShards(numShards),
       _generation(0),
       _next(0)
 { }
@@ -17,52 +35,91 @@ GenerationHandler::GenerationHold::~GenerationHold() {
 
 void
 GenerationHandler::GenerationHold::setValid() noexcept {
-    auto old = _refCount.fetch_sub(1, std::memory_order_release);
-    assert(!valid(old));
+    for (uint32_t i = 0; i < _numShards; ++i) {
+        auto old = _refCounts[i]._value.fetch_sub(1, std::memory_order_release);
+        (void) old;
+        assert(!valid(old));
+    }
 }
 
 bool
 GenerationHandler::GenerationHold::setInvalid() noexcept {
-    uint32_t refs = 0;
-    if (_refCount.compare_exchange_strong(refs, 1,
-                                          std::memory_order_acq_rel,
-                                          std::memory_order_relaxed))
-    {
-        return true;
-    } else {
-        assert(valid(refs));
-        return false;
+    /*
+     * A shard held by a reader is never marked invalid. Readers that
+     * see an invalid shard back off, also when we have to undo since a
+     * later shard was held.
+     */
+    for (uint32_t i = 0; i < _numShards; ++i) {
+        uint32_t refs = 0;
+        if (!_refCounts[i]._value.compare_exchange_strong(refs, 1,
+                                                          std::memory_order_acq_rel,
+                                                          std::memory_order_relaxed))
+        {
+            assert(valid(refs));
+            while (i > 0) {
+                --i;
+                _refCounts[i]._value.fetch_sub(1, std::memory_order_release);
+            }
+            return false;
+        }
     }
+    return true;
 }
 
 GenerationHandler::GenerationHold *
-GenerationHandler::GenerationHold::acquire() noexcept {
-    if (valid(_refCount.fetch_add(2, std::memory_order_acq_rel))) {
+GenerationHandler::GenerationHold::acquire(uint32_t shard) noexcept {
+    if (valid(_refCounts[shard]._value.fetch_add(2, std::memory_order_acq_rel))) {
         return this;
     } else {
-        release();
+        release(shard);
         return nullptr;
     }
 }
 
 GenerationHandler::GenerationHold *
-GenerationHandler::GenerationHold::copy(GenerationHold *self) noexcept {
+GenerationHandler::GenerationHold::copy(GenerationHold *self, uint32_t shard) noexcept {
     if (self == nullptr) {
         return nullptr;
     } else {
-        uint32_t oldRefCount = self->_refCount.fetch_add(2, std::memory_order_relaxed);
+        uint32_t oldRefCount = self->_refCounts[shard]._value.fetch_add(2, std::memory_order_relaxed);
         (void) oldRefCount;
         assert(valid(oldRefCount));
         return self;
     }
 }
 
+uint32_t
+GenerationHandler::GenerationHold::getRefCount() const noexcept {
+    uint32_t refs = 0;
+    for (uint32_t i = 0; i < _numShards; ++i) {
+        refs += _refCounts[i]._value.load(std::memory_order_relaxed) / 2;
+    }
+    return refs;
+}
+
+uint32_t
+GenerationHandler::GenerationHold::getRefCountAcqRel() noexcept {
+    uint32_t refs = 0;
+    for (uint32_t i = 0; i < _numShards; ++i) {
+        refs += _refCounts[i]._value.fetch_add(0, std::memory_order_acq_rel) / 2;
+    }
+    return refs;
+}
+
+GenerationHandler::Guard::Guard(GenerationHold *hold) noexcept
+    : _hold(nullptr),
+      _shard(thread_shard(hold->num_shards()))
+{
+    _hold = hold->acquire(_shard);
+}
+
 GenerationHandler::Guard &
 GenerationHandler::Guard::operator=(const Guard & rhs) noexcept
 {
     if (&rhs != this) {
         cleanup();
-        _hold = GenerationHold::copy(rhs._hold);
+        _hold = GenerationHold::copy(rhs._hold, rhs._shard);
+        _shard = rhs._shard;
     }
     return *this;
 }
@@ -73,6 +130,7 @@ GenerationHandler::Guard::operator=(Guard &&rhs) noexcept
     if (&rhs != this) {
         cleanup();
         _hold = rhs._hold;
+        _shard = rhs._shard;
         rhs._hold = nullptr;
     }
     return *this;
@@ -96,20 +154,28 @@ GenerationHandler::update_oldest_used_generation()
     _oldest_used_generation.store(_first->_generation, std::memory_order_relaxed);
 }
 
-GenerationHandler::GenerationHandler()
+GenerationHandler::GenerationHandler(uint32_t numShards)
     : _generation(0),
       _oldest_used_generation(0),
       _last(nullptr),
       _first(nullptr),
       _free(nullptr),
-      _numHolds(0u)
+      _numHolds(0u),
+      _numShards(std::max(numShards, 1u))
 {
-    _last = _first = new GenerationHold;
+    _last = _first = new GenerationHold(_numShards);
     ++_numHolds;
     _first->_generation.store(getCurrentGeneration(), std::memory_order_relaxed);
     _first->setValid();
 }
 
+uint32_t
+GenerationHandler::sharded() noexcept
+{
+    static const uint32_t shards = std::clamp(std::bit_ceil(std::thread::hardware_concurrency()), 1u, 16u);
+    return shards;
+}
+
 GenerationHandler::~GenerationHandler()
 {
     update_oldest_used_generation();
@@ -158,7 +224,7 @@ GenerationHandler::incGeneration()
     }
     GenerationHold *nhold = nullptr;
     if (_free == nullptr) {
-        nhold = new GenerationHold;
+        nhold = new GenerationHold(_numShards);
         ++_numHolds;
     } else {
         nhold = _free;
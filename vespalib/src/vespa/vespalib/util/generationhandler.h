@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <atomic>
+#include <memory>
 
 namespace vespalib {
 
@@ -12,6 +13,12 @@ namespace vespalib {
  * (changed by a single writer), and previous generations still
  * occupied by multiple readers.  Readers will take a generation guard
  * by calling takeGuard().
+ *
+ * The reference count for each generation can be split into multiple
+ * shards, each on its own cache line. A reader thread always counts
+ * in the same shard, so readers on different cores do not contend on
+ * a single cache line when taking guards. The writer pays for this by
+ * checking all shards when reclaiming a generation.
  **/
 class GenerationHandler {
 public:
@@ -26,29 +33,32 @@ public:
     class GenerationHold
     {
         // least significant bit is invalid flag
-        std::atomic<uint32_t> _refCount;
+        struct alignas(64) RefCount {
+            std::atomic<uint32_t> _value;
+            RefCount() noexcept : _value(1) { }
+        };
+        std::unique_ptr<RefCount[]> _refCounts;
+        uint32_t                    _numShards;
 
         static bool valid(uint32_t refCount) noexcept { return (refCount & 1) == 0u; }
     public:
         std::atomic<generation_t> _generation;
         GenerationHold *_next;	// next free element or next newer element.
 
-        GenerationHold() noexcept;
+        explicit GenerationHold(uint32_t numShards) noexcept;
+        GenerationHold() noexcept : GenerationHold(1) { }
         ~GenerationHold();
 
         void setValid() noexcept;
         bool setInvalid() noexcept;
-        void release() noexcept {
-            _refCount.fetch_sub(2, std::memory_order_release);
-        }
-        GenerationHold *acquire() noexcept;
-        static GenerationHold *copy(GenerationHold *self) noexcept;
-        uint32_t getRefCount() const noexcept {
-            return _refCount.load(std::memory_order_relaxed) / 2;
-        }
-        uint32_t getRefCountAcqRel() noexcept {
-            return _refCount.fetch_add(0, std::memory_order_acq_rel) / 2;
+        void release(uint32_t shard) noexcept {
+            _refCounts[shard]._value.fetch_sub(2, std::memory_order_release);
         }
+        GenerationHold *acquire(uint32_t shard) noexcept;
+        static GenerationHold *copy(GenerationHold *self, uint32_t shard) noexcept;
+        uint32_t getRefCount() const noexcept;
+        uint32_t getRefCountAcqRel() noexcept;
+        uint32_t num_shards() const noexcept { return _numShards; }
     };
 
     /**
@@ -57,19 +67,21 @@ public:
     class Guard {
     private:
         GenerationHold *_hold;
+        uint32_t        _shard; // copies count in the same shard, which can not be invalidated while held
         void cleanup() noexcept {
             if (_hold != nullptr) {
-                _hold->release();
+                _hold->release(_shard);
                 _hold = nullptr;
             }
         }
     public:
-        Guard() noexcept : _hold(nullptr) { }
-        Guard(GenerationHold *hold) noexcept : _hold(hold->acquire()) { } // hold is never nullptr
+        Guard() noexcept : _hold(nullptr), _shard(0) { }
+        Guard(GenerationHold *hold) noexcept; // hold is never nullptr
         ~Guard() { cleanup(); }
-        Guard(const Guard & rhs) noexcept : _hold(GenerationHold::copy(rhs._hold)) { }
+        Guard(const Guard & rhs) noexcept : _hold(GenerationHold::copy(rhs._hold, rhs._shard)), _shard(rhs._shard) { }
         Guard(Guard &&rhs) noexcept
-            : _hold(rhs._hold)
+            : _hold(rhs._hold),
+              _shard(rhs._shard)
         {
             rhs._hold = nullptr;
         }
@@ -89,14 +101,23 @@ private:
     GenerationHold               *_first;     // Points to "firstUsedGeneration" entry
     GenerationHold               *_free;      // List of free entries
     uint32_t                      _numHolds;  // Number of allocated generation hold entries
+    const uint32_t                _numShards; // Number of reference count shards per entry
 
     void set_generation(generation_t generation) noexcept { _generation.store(generation, std::memory_order_relaxed); }
 
 public:
     /**
-     * Creates a new generation handler.
+     * Creates a new generation handler, with reference counts split
+     * into the given number of shards.
+     **/
+    explicit GenerationHandler(uint32_t numShards);
+    GenerationHandler() : GenerationHandler(1) { }
+
+    /**
+     * Number of shards that lets readers on all cores of this machine
+     * take guards without sharing cache lines much.
      **/
-    GenerationHandler();
+    static uint32_t sharded() noexcept;
     ~GenerationHandler();
 
     /**
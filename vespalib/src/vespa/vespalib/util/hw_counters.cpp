@@ -0,0 +1,119 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hw_counters.h"
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <cstring>
+#endif
+
+namespace vespalib {
+
+namespace {
+
+#ifdef __linux__
+
+struct EventSpec {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr EventSpec event_specs[HwCounters::NUM_COUNTERS] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                          (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+};
+
+int open_counter(const EventSpec &spec, int group_fd) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.disabled = (group_fd < 0) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+#endif
+
+}
+
+HwCounters::HwCounters()
+    : _group_fd(-1),
+      _fd(),
+      _slot(),
+      _num_open(0)
+{
+    _fd.fill(-1);
+#ifdef __linux__
+    for (uint32_t i = 0; i < NUM_COUNTERS; ++i) {
+        int fd = open_counter(event_specs[i], _group_fd);
+        if (fd >= 0) {
+            if (_group_fd < 0) {
+                _group_fd = fd;
+            }
+            _fd[i] = fd;
+            _slot[i] = _num_open++;
+        }
+    }
+    if (_group_fd >= 0) {
+        ioctl(_group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(_group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+}
+
+HwCounters::~HwCounters()
+{
+    for (int fd: _fd) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+HwCounters::Sample
+HwCounters::sample() const noexcept
+{
+    Sample result;
+#ifdef __linux__
+    if (_group_fd >= 0) {
+        // PERF_FORMAT_GROUP layout: number of events followed by one value per event
+        uint64_t buf[1 + NUM_COUNTERS];
+        ssize_t expect = sizeof(uint64_t) * (1 + _num_open);
+        if (read(_group_fd, buf, sizeof(buf)) == expect) {
+            for (uint32_t i = 0; i < NUM_COUNTERS; ++i) {
+                if (_fd[i] >= 0) {
+                    result.value[i] = buf[1 + _slot[i]];
+                }
+            }
+        }
+    }
+#endif
+    return result;
+}
+
+const char *
+HwCounters::name_of(Counter counter) noexcept
+{
+    switch (counter) {
+    case CYCLES:        return "cycles";
+    case INSTRUCTIONS:  return "instructions";
+    case L1D_MISSES:    return "l1d_misses";
+    case LLC_MISSES:    return "llc_misses";
+    case BRANCH_MISSES: return "branch_misses";
+    case NUM_COUNTERS: break;
+    }
+    return "unknown";
+}
+
+}
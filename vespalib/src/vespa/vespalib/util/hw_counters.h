@@ -0,0 +1,73 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace vespalib {
+
+/**
+ * Hardware performance counters for the thread that created this
+ * object, backed by perf_event_open(2). Only user space events are
+ * counted. Counters that cannot be opened (missing permissions,
+ * virtualized hardware, non-linux platforms) are reported as not
+ * available and always sample as 0.
+ *
+ * Sampling is a single read syscall for all counters, which is cheap
+ * compared to the counted work only when that work is non-trivial.
+ **/
+class HwCounters {
+public:
+    enum Counter : uint32_t {
+        CYCLES,
+        INSTRUCTIONS,
+        L1D_MISSES,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        NUM_COUNTERS
+    };
+
+    struct Sample {
+        std::array<uint64_t, NUM_COUNTERS> value;
+        Sample() noexcept : value() {}
+        uint64_t operator[](Counter counter) const noexcept { return value[counter]; }
+        Sample &operator+=(const Sample &rhs) noexcept {
+            for (size_t i = 0; i < NUM_COUNTERS; ++i) {
+                value[i] += rhs.value[i];
+            }
+            return *this;
+        }
+        Sample &operator-=(const Sample &rhs) noexcept {
+            for (size_t i = 0; i < NUM_COUNTERS; ++i) {
+                value[i] -= rhs.value[i];
+            }
+            return *this;
+        }
+        Sample operator-(const Sample &rhs) const noexcept {
+            Sample result(*this);
+            result -= rhs;
+            return result;
+        }
+    };
+
+private:
+    int                                 _group_fd;
+    std::array<int, NUM_COUNTERS>       _fd;
+    std::array<uint32_t, NUM_COUNTERS>  _slot; // position of counter in group read
+    uint32_t                            _num_open;
+
+public:
+    HwCounters();
+    HwCounters(const HwCounters &) = delete;
+    HwCounters &operator=(const HwCounters &) = delete;
+    ~HwCounters();
+
+    bool valid() const noexcept { return (_num_open > 0); }
+    bool is_available(Counter counter) const noexcept { return (_fd[counter] >= 0); }
+    Sample sample() const noexcept;
+    static const char *name_of(Counter counter) noexcept;
+};
+
+}
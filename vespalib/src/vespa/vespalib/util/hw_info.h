@@ -41,10 +41,16 @@ public:
     class Cpu {
     private:
         uint32_t _cores;
+        uint32_t _numa_nodes;
     public:
-        Cpu(uint32_t cores_) noexcept : _cores(std::max(1u, cores_)) { }
+        Cpu(uint32_t cores_) noexcept : Cpu(cores_, 1) { }
+        Cpu(uint32_t cores_, uint32_t numa_nodes_) noexcept
+            : _cores(std::max(1u, cores_)), _numa_nodes(std::max(1u, numa_nodes_)) { }
         uint32_t cores() const noexcept { return _cores; }
-        bool operator == (const Cpu & rhs) const noexcept { return _cores == rhs._cores; }
+        uint32_t numa_nodes() const noexcept { return _numa_nodes; }
+        bool operator == (const Cpu & rhs) const noexcept {
+            return (_cores == rhs._cores) && (_numa_nodes == rhs._numa_nodes);
+        }
     };
 
 private:
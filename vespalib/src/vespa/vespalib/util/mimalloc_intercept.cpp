@@ -3,6 +3,7 @@
 #include "mimalloc_intercept.h"
 #include <absl/debugging/stacktrace.h>
 #include <absl/debugging/symbolize.h>
+#include <algorithm>
 #include <atomic>
 #include <cerrno>
 #include <chrono>
@@ -24,6 +25,8 @@ extern "C" {
 // From https://microsoft.github.io/mimalloc/group__extended.html
 typedef void mi_error_fun(int err, void* arg);
 void mi_register_error(mi_error_fun* err_fn, void* arg) __attribute__((weak));
+typedef void mi_deferred_free_fun(bool force, unsigned long long heartbeat, void* arg);
+void mi_register_deferred_free(mi_deferred_free_fun* deferred_free, void* arg) __attribute__((weak));
 
 }
 
@@ -117,6 +120,122 @@ void terminate_on_mi_malloc_failure(int err, void* fwd_arg) {
 
 namespace {
 
+// Fixed size table of sampled call stacks. It is filled from within mimalloc's
+// allocation slow path, so it must never allocate and is constant initialized
+// to be usable before any dynamic initialization has happened.
+class SampledStacks {
+public:
+    static constexpr int max_depth = 24;
+    static constexpr size_t num_entries = 2048;
+private:
+    struct Entry {
+        uint64_t hash = 0;
+        int      depth = 0;
+        uint64_t samples = 0;
+        void*    frames[max_depth] = {};
+    };
+    std::atomic_flag _lock;
+    uint64_t         _samples = 0;
+    uint64_t         _dropped = 0;
+    size_t           _used = 0;
+    Entry            _entries[num_entries];
+
+    void lock() noexcept {
+        while (_lock.test_and_set(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+    void unlock() noexcept { _lock.clear(std::memory_order_release); }
+public:
+    constexpr SampledStacks() noexcept = default;
+    void record(void* const* frames, int depth) noexcept {
+        uint64_t hash = 0xcbf29ce484222325ul;
+        for (int i = 0; i < depth; ++i) {
+            hash = (hash ^ reinterpret_cast<uintptr_t>(frames[i])) * 0x100000001b3ul;
+        }
+        lock();
+        ++_samples;
+        Entry* found = nullptr;
+        for (size_t probe = 0, idx = hash % num_entries; probe < num_entries; ++probe, idx = (idx + 1) % num_entries) {
+            Entry& e = _entries[idx];
+            if (e.depth == 0) {
+                if (_used * 4 < num_entries * 3) { // keep probe sequences short
+                    e.hash = hash;
+                    e.depth = depth;
+                    std::copy(frames, frames + depth, e.frames);
+                    ++_used;
+                    found = &e;
+                }
+                break;
+            }
+            if (e.hash == hash && e.depth == depth && std::equal(frames, frames + depth, e.frames)) {
+                found = &e;
+                break;
+            }
+        }
+        if (found != nullptr) {
+            ++found->samples;
+        } else {
+            ++_dropped;
+        }
+        unlock();
+    }
+    void dump(FILE* out, size_t max_stacks, uint32_t interval) {
+        constexpr size_t max_stacks_to_show = 64;
+        uint16_t used[num_entries];
+        Entry top[max_stacks_to_show];
+        size_t num_used = 0;
+        lock();
+        for (size_t i = 0; i < num_entries; ++i) {
+            if (_entries[i].depth != 0) {
+                used[num_used++] = i;
+            }
+        }
+        size_t num_top = std::min({max_stacks, num_used, max_stacks_to_show});
+        std::partial_sort(used, used + num_top, used + num_used,
+                          [this](uint16_t a, uint16_t b) noexcept { return _entries[a].samples > _entries[b].samples; });
+        for (size_t i = 0; i < num_top; ++i) {
+            top[i] = _entries[used[i]];
+        }
+        uint64_t samples = _samples;
+        uint64_t dropped = _dropped;
+        unlock();
+        fprintf(out, "Allocation samples: every %u. mimalloc slow path, %lu samples, %zu stacks, %lu dropped\n",
+                interval, samples, num_used, dropped);
+        for (size_t i = 0; i < num_top; ++i) {
+            const Entry& e = top[i];
+            fprintf(out, "%5.1f%% %lu samples\n", (samples > 0) ? (100.0 * e.samples) / samples : 0.0, e.samples);
+            for (int j = 0; j < e.depth; ++j) {
+                const char* sym = "(unknown)";
+                char tmp[1024];
+                if (absl::Symbolize(e.frames[j], tmp, sizeof(tmp))) {
+                    sym = tmp;
+                }
+                fprintf(out, "    %p  %s\n", e.frames[j], sym);
+            }
+        }
+        fflush(out);
+    }
+};
+
+constinit SampledStacks sampled_stacks;
+std::atomic<uint32_t> sample_interval{0};
+
+// Called by mimalloc with a per-thread heartbeat that is incremented each time an
+// allocation takes the slow (generic) path, and with force set on explicit collects.
+void sample_allocation_slow_path(bool force, unsigned long long heartbeat, [[maybe_unused]] void* arg) {
+    uint32_t interval = sample_interval.load(std::memory_order_relaxed);
+    if (force || interval == 0 || (heartbeat % interval) != 0) {
+        return;
+    }
+    void* frames[SampledStacks::max_depth];
+    // Skip this frame; the mimalloc frames are kept as their number depends on the mimalloc build
+    int depth = absl::GetStackTrace(frames, SampledStacks::max_depth, 1);
+    if (depth > 0) {
+        sampled_stacks.record(frames, depth);
+    }
+}
+
 class MiMallocAutoRegisterErrorHandler {
 public:
     MiMallocAutoRegisterErrorHandler() {
@@ -125,6 +244,10 @@ public:
         if (mi_register_error) {
             mi_register_error(terminate_on_mi_malloc_failure, nullptr);
         }
+        const char* interval = getenv("VESPA_MIMALLOC_SAMPLE_INTERVAL");
+        if (interval != nullptr) {
+            set_mi_malloc_allocation_sample_interval(strtoul(interval, nullptr, 10));
+        }
     }
 };
 
@@ -132,4 +255,25 @@ public:
 
 } // anon ns
 
+bool is_mi_malloc_present() noexcept {
+    return (mi_register_error != nullptr);
+}
+
+bool set_mi_malloc_allocation_sample_interval(uint32_t interval) noexcept {
+    if (mi_register_deferred_free == nullptr) {
+        return false;
+    }
+    sample_interval.store(interval, std::memory_order_relaxed);
+    mi_register_deferred_free((interval != 0) ? sample_allocation_slow_path : nullptr, nullptr);
+    return true;
+}
+
+uint32_t mi_malloc_allocation_sample_interval() noexcept {
+    return sample_interval.load(std::memory_order_relaxed);
+}
+
+void dump_mi_malloc_allocation_samples(FILE* out, size_t max_stacks) {
+    sampled_stacks.dump(out, max_stacks, mi_malloc_allocation_sample_interval());
+}
+
 }
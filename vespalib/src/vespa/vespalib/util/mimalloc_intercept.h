@@ -2,6 +2,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
 namespace vespalib {
 
 // Implementation of the `mimalloc_register_error` function callback which
@@ -10,4 +14,20 @@ namespace vespalib {
 __attribute__((noreturn))
 void terminate_on_mi_malloc_failure(int err, void* fwd_arg);
 
+// Whether mimalloc is the active allocator (i.e. preloaded).
+bool is_mi_malloc_present() noexcept;
+
+// Samples the call stack of every n'th allocation taking the mimalloc slow path,
+// which is roughly every time an allocating thread has used up a page of blocks
+// of its size class. The samples are thus roughly proportional to the bytes
+// allocated per call stack. mimalloc does not pass the allocation size, so only
+// sample counts are recorded. An interval of 0 turns sampling off. Returns false
+// if mimalloc is not present. Sampling is also enabled at startup if the
+// VESPA_MIMALLOC_SAMPLE_INTERVAL environment variable is set.
+bool set_mi_malloc_allocation_sample_interval(uint32_t interval) noexcept;
+uint32_t mi_malloc_allocation_sample_interval() noexcept;
+
+// Writes the sampled call stacks, most sampled first.
+void dump_mi_malloc_allocation_samples(FILE* out, size_t max_stacks);
+
 }
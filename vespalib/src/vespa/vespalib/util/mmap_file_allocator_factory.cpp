@@ -2,6 +2,7 @@
 
 #include "mmap_file_allocator_factory.h"
 #include "mmap_file_allocator.h"
+#include "tiered_memory_allocator.h"
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <filesystem>
 
@@ -36,6 +37,17 @@ MmapFileAllocatorFactory::make_memory_allocator(const std::string& name)
     return std::make_unique<MmapFileAllocator>(os.str());
 };
 
+std::unique_ptr<MemoryAllocator>
+MmapFileAllocatorFactory::make_tiered_memory_allocator(const std::string& name)
+{
+    if (_dir_name.empty()) {
+        return {};
+    }
+    vespalib::asciistream os;
+    os << _dir_name << "/" << _generation.fetch_add(1) << "." << name;
+    return std::make_unique<TieredMemoryAllocator>(os.str());
+}
+
 MmapFileAllocatorFactory&
 MmapFileAllocatorFactory::instance()
 {
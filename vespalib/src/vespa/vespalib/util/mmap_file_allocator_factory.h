@@ -11,7 +11,7 @@ namespace vespalib::alloc {
 class MemoryAllocator;
 
 /*
- * Class for creating an mmap file allocator on demand.
+ * Class for creating an mmap file allocator or a tiered memory allocator on demand.
  */
 class MmapFileAllocatorFactory {
     std::string _dir_name;
@@ -24,6 +24,7 @@ class MmapFileAllocatorFactory {
 public:
     void setup(const std::string &dir_name);
     std::unique_ptr<MemoryAllocator> make_memory_allocator(const std::string& name);
+    std::unique_ptr<MemoryAllocator> make_tiered_memory_allocator(const std::string& name);
 
     static MmapFileAllocatorFactory& instance();
 };
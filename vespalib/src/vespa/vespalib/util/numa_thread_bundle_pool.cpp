@@ -0,0 +1,32 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "numa_thread_bundle_pool.h"
+
+namespace vespalib {
+
+NumaThreadBundlePool::NumaThreadBundlePool(size_t bundleSize, Runnable::init_fun_t init_fun, const NumaTopology &numa,
+                                           duration spin)
+    : _pools(),
+      _next(0)
+{
+    for (uint32_t node = 0; node < numa.num_nodes(); ++node) {
+        _pools.push_back(std::make_unique<SimpleThreadBundle::Pool>(bundleSize, numa.pin_to_node(node, init_fun), spin));
+    }
+}
+
+NumaThreadBundlePool::~NumaThreadBundlePool() = default;
+
+SimpleThreadBundle::Pool &
+NumaThreadBundlePool::pool()
+{
+    if (_pools.size() == 1) {
+        return *_pools[0];
+    }
+    uint32_t node = NumaTopology::current_node();
+    if (node >= _pools.size()) {
+        node = _next.fetch_add(1, std::memory_order_relaxed) % _pools.size();
+    }
+    return *_pools[node];
+}
+
+}
@@ -0,0 +1,41 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "numa_topology.h"
+#include "simple_thread_bundle.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * A pool of thread bundles for each NUMA node, with the threads of
+ * each pool pinned to its node. A bundle is taken from the pool of the
+ * node the calling thread is pinned to, so that all threads working on
+ * the same request run on the same socket and share local memory.
+ * Callers that are not pinned take bundles from all pools in turn.
+ *
+ * With a single node this is the same as a plain
+ * SimpleThreadBundle::Pool.
+ **/
+class NumaThreadBundlePool
+{
+private:
+    std::vector<std::unique_ptr<SimpleThreadBundle::Pool>> _pools;
+    std::atomic<uint32_t>                                  _next;
+
+public:
+    using Guard = SimpleThreadBundle::Pool::Guard;
+    NumaThreadBundlePool(size_t bundleSize, Runnable::init_fun_t init_fun, const NumaTopology &numa, duration spin);
+    NumaThreadBundlePool(size_t bundleSize, Runnable::init_fun_t init_fun, const NumaTopology &numa)
+        : NumaThreadBundlePool(bundleSize, std::move(init_fun), numa, duration::zero()) {}
+    NumaThreadBundlePool(size_t bundleSize, Runnable::init_fun_t init_fun)
+        : NumaThreadBundlePool(bundleSize, std::move(init_fun), NumaTopology()) {}
+    ~NumaThreadBundlePool();
+    size_t num_pools() const noexcept { return _pools.size(); }
+    SimpleThreadBundle::Pool &pool();
+    Guard getBundle() { return pool().getBundle(); }
+};
+
+}
@@ -0,0 +1,161 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "numa_topology.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace vespalib {
+
+namespace {
+
+thread_local uint32_t pinned_node = NumaTopology::no_node;
+
+bool parse_number(std::string_view str, uint32_t &value) {
+    auto res = std::from_chars(str.data(), str.data() + str.size(), value);
+    return (res.ec == std::errc()) && (res.ptr == str.data() + str.size());
+}
+
+std::string read_line(const std::filesystem::path &path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+}
+
+NumaTopology::NumaTopology()
+    : _nodes(1)
+{
+}
+
+NumaTopology::NumaTopology(std::vector<std::vector<uint32_t>> nodes)
+    : _nodes(std::move(nodes))
+{
+    if (_nodes.empty()) {
+        _nodes.resize(1);
+    }
+}
+
+NumaTopology::NumaTopology(const NumaTopology &) = default;
+NumaTopology::NumaTopology(NumaTopology &&) noexcept = default;
+NumaTopology::~NumaTopology() = default;
+
+std::vector<uint32_t>
+NumaTopology::parse_cpu_list(std::string_view list)
+{
+    std::vector<uint32_t> result;
+    while (!list.empty() && (list.back() == '\n' || list.back() == ' ')) {
+        list.remove_suffix(1);
+    }
+    while (!list.empty()) {
+        auto comma = list.find(',');
+        auto range = list.substr(0, comma);
+        list = (comma == std::string_view::npos) ? std::string_view() : list.substr(comma + 1);
+        auto dash = range.find('-');
+        uint32_t first = 0;
+        uint32_t last = 0;
+        if (dash == std::string_view::npos) {
+            if (!parse_number(range, first)) {
+                return {};
+            }
+            last = first;
+        } else if (!parse_number(range.substr(0, dash), first) ||
+                   !parse_number(range.substr(dash + 1), last) || (last < first))
+        {
+            return {};
+        }
+        for (uint32_t cpu = first; cpu <= last; ++cpu) {
+            result.push_back(cpu);
+        }
+    }
+    return result;
+}
+
+NumaTopology
+NumaTopology::discover(const std::string &node_dir)
+{
+    std::vector<std::pair<uint32_t, std::vector<uint32_t>>> found;
+    std::error_code ec;
+    for (const auto &entry: std::filesystem::directory_iterator(node_dir, ec)) {
+        std::string name = entry.path().filename().string();
+        uint32_t id = 0;
+        if (!name.starts_with("node") || !parse_number(std::string_view(name).substr(4), id)) {
+            continue;
+        }
+        auto cpus = parse_cpu_list(read_line(entry.path() / "cpulist"));
+        if (!cpus.empty()) {
+            found.emplace_back(id, std::move(cpus));
+        }
+    }
+    std::sort(found.begin(), found.end());
+    std::vector<std::vector<uint32_t>> nodes;
+    for (auto &node: found) {
+        nodes.push_back(std::move(node.second));
+    }
+    return NumaTopology(std::move(nodes));
+}
+
+bool
+NumaTopology::pin_current_thread(uint32_t node) const
+{
+    if (!is_multi_node() || (node >= num_nodes()) || _nodes[node].empty()) {
+        return false;
+    }
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (uint32_t cpu: _nodes[node]) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        return false;
+    }
+    pinned_node = node;
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint32_t
+NumaTopology::current_node() noexcept
+{
+    return pinned_node;
+}
+
+Runnable::init_fun_t
+NumaTopology::pin_to_node(uint32_t node, Runnable::init_fun_t init) const
+{
+    if (!is_multi_node()) {
+        return init;
+    }
+    return [topology = *this, node, init](Runnable &target) {
+        topology.pin_current_thread(node);
+        return init(target);
+    };
+}
+
+Runnable::init_fun_t
+NumaTopology::spread_over_nodes(Runnable::init_fun_t init) const
+{
+    if (!is_multi_node()) {
+        return init;
+    }
+    auto next = std::make_shared<std::atomic<uint32_t>>(0);
+    return [topology = *this, next, init](Runnable &target) {
+        topology.pin_current_thread(next->fetch_add(1, std::memory_order_relaxed) % topology.num_nodes());
+        return init(target);
+    };
+}
+
+}
@@ -0,0 +1,69 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "runnable.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * The NUMA nodes (sockets) of the machine and the cpus belonging to
+ * each of them, used to keep threads working on the same data close
+ * to the same memory.
+ *
+ * Threads are pinned to a node by wrapping the init function used to
+ * start them, in the same way as with be_nice and CpuUsage::wrap.
+ * Since memory is placed on the node of the thread first touching it,
+ * pinning the threads of a pool also keeps their memory local. A
+ * machine with a single node (or where the topology cannot be read)
+ * has nothing to gain from pinning, and threads are left alone.
+ **/
+class NumaTopology
+{
+private:
+    std::vector<std::vector<uint32_t>> _nodes; // cpus of each node
+
+public:
+    static constexpr uint32_t no_node = uint32_t(-1);
+
+    // a single node with no known cpus
+    NumaTopology();
+    explicit NumaTopology(std::vector<std::vector<uint32_t>> nodes);
+    NumaTopology(const NumaTopology &);
+    NumaTopology(NumaTopology &&) noexcept;
+    ~NumaTopology();
+
+    /**
+     * Read the topology from sysfs (node<N>/cpulist below the given
+     * directory). Nodes without cpus are skipped.
+     **/
+    static NumaTopology discover(const std::string &node_dir = "/sys/devices/system/node");
+
+    // parse a kernel cpu list like "0-3,8,10-11"; returns empty on error
+    static std::vector<uint32_t> parse_cpu_list(std::string_view list);
+
+    uint32_t num_nodes() const noexcept { return _nodes.size(); }
+    const std::vector<uint32_t> &cpus(uint32_t node) const { return _nodes[node]; }
+    bool is_multi_node() const noexcept { return (_nodes.size() > 1); }
+
+    /**
+     * Restrict the calling thread to the cpus of the given node and
+     * remember the node for current_node(). Returns false if nothing
+     * was done.
+     **/
+    bool pin_current_thread(uint32_t node) const;
+
+    // the node the calling thread was pinned to, or no_node
+    static uint32_t current_node() noexcept;
+
+    // init function pinning each thread started with it to the given node
+    Runnable::init_fun_t pin_to_node(uint32_t node, Runnable::init_fun_t init) const;
+
+    // init function pinning the threads started with it to all nodes in turn
+    Runnable::init_fun_t spread_over_nodes(Runnable::init_fun_t init) const;
+};
+
+}
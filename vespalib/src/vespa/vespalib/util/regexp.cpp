@@ -14,8 +14,46 @@ namespace vespalib {
 
 namespace {
 
+// skip past a bracket expression starting at pos, returns the position after it
+size_t skip_bracket(std::string_view re, size_t pos) {
+    ++pos; // '['
+    if ((pos < re.size()) && (re[pos] == '^')) {
+        ++pos;
+    }
+    if ((pos < re.size()) && (re[pos] == ']')) {
+        ++pos; // literal ']' first in set
+    }
+    for (; pos < re.size() && re[pos] != ']'; ++pos) {
+        if (re[pos] == '\\') {
+            ++pos;
+        } else if ((re[pos] == '[') && (pos + 1 < re.size()) && (re[pos + 1] == ':')) {
+            size_t end = re.find(":]", pos + 2);
+            if (end != re.npos) {
+                pos = end + 1;
+            }
+        }
+    }
+    return std::min(pos + 1, re.size());
+}
+
+// does the expression have alternatives outside of any group?
 bool has_option(std::string_view re) {
-    return (re.find('|') != re.npos);
+    int depth = 0;
+    for (size_t pos = 0; pos < re.size(); ++pos) {
+        char c = re[pos];
+        if (c == '\\') {
+            ++pos;
+        } else if (c == '[') {
+            pos = skip_bracket(re, pos) - 1;
+        } else if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            --depth;
+        } else if ((c == '|') && (depth <= 0)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 bool maybe_none(char c) {
@@ -27,6 +65,26 @@ bool maybe_none(char c) {
 const std::string special("^|()[]{}.*?+\\$");
 bool is_special(char c) { return special.find(c) != special.npos; }
 
+// escaped punctuation is a literal char
+bool is_escaped_literal(char c) {
+    return ((c >= '!' && c <= '/') || (c >= ':' && c <= '@') || (c >= '[' && c <= '`') || (c >= '{' && c <= '~'));
+}
+
+// escapes matching a single (non-literal) char or an empty string
+bool is_simple_escape(char c) {
+    return (std::string_view("dDwWsSbBAznrtfv").find(c) != std::string_view::npos);
+}
+
+// remove the last (possibly multi-byte) UTF-8 char
+void pop_char(std::string &str) {
+    while (!str.empty() && ((str.back() & 0xc0) == 0x80)) {
+        str.pop_back();
+    }
+    if (!str.empty()) {
+        str.pop_back();
+    }
+}
+
 std::string escape(std::string_view str) {
     std::string result;
     for (char c: str) {
@@ -47,16 +105,89 @@ RegexpUtil::get_prefix(std::string_view re)
     if ((re.size() > 0) && (re.data()[0] == '^') && !has_option(re)) {
         const char *end = re.data() + re.size();
         const char *pos = re.data() + 1;
-        for (; (pos < end) && !is_special(*pos); ++pos) {
-            prefix.push_back(*pos);
+        for (; pos < end; ++pos) {
+            if ((*pos == '\\') && (pos + 1 < end) && is_escaped_literal(pos[1])) {
+                prefix.push_back(*++pos);
+            } else if (!is_special(*pos)) {
+                prefix.push_back(*pos);
+            } else {
+                break;
+            }
         }
-        if ((pos < end) && maybe_none(*pos) && !prefix.empty()) {
-            prefix.resize(prefix.size() - 1); // pop_back
+        if ((pos < end) && maybe_none(*pos)) {
+            pop_char(prefix);
         }
     }
     return prefix;
 }
 
+std::string
+RegexpUtil::get_required_literal(std::string_view re)
+{
+    std::string best;
+    std::string current;
+    auto end_run = [&]() {
+        if (current.size() > best.size()) {
+            best = current;
+        }
+        current.clear();
+    };
+    if (has_option(re)) {
+        return best;
+    }
+    int depth = 0;
+    for (size_t pos = 0; pos < re.size(); ++pos) {
+        char c = re[pos];
+        if (c == '\\') {
+            if (pos + 1 >= re.size()) {
+                return {};
+            }
+            char next = re[++pos];
+            if (is_escaped_literal(next)) {
+                if (depth == 0) {
+                    current.push_back(next);
+                }
+            } else if (is_simple_escape(next)) {
+                end_run();
+            } else {
+                return {}; // e.g. \x{..}, \p{..}, \Q..\E or octal codes
+            }
+        } else if (c == '[') {
+            pos = skip_bracket(re, pos) - 1;
+            end_run();
+        } else if (c == '(') {
+            if ((pos + 1 < re.size()) && (re[pos + 1] == '?')) {
+                return {}; // flags might change the meaning of the rest of the expression
+            }
+            ++depth;
+            end_run();
+        } else if (c == ')') {
+            --depth;
+            end_run();
+        } else if (depth > 0) {
+            // group contents might be optional or repeated
+        } else if (maybe_none(c)) {
+            pop_char(current);
+            end_run();
+            if (c == '{') {
+                size_t close = re.find('}', pos);
+                if (close == re.npos) {
+                    return {};
+                }
+                pos = close;
+            }
+        } else if (c == '+') {
+            end_run();
+        } else if (is_special(c)) {
+            end_run();
+        } else {
+            current.push_back(c);
+        }
+    }
+    end_run();
+    return best;
+}
+
 std::string
 RegexpUtil::make_from_suffix(std::string_view suffix)
 {
@@ -23,6 +23,20 @@ public:
      **/
     static std::string get_prefix(std::string_view re);
 
+    /**
+     * Look at the given regular expression and identify the longest
+     * literal string that must be present (anywhere) in a string for
+     * it to match the expression. An empty string is returned if no
+     * such literal is found, e.g. for expressions with top-level
+     * alternatives or with constructs this function does not
+     * understand. Like get_prefix, this might underestimate the
+     * actual literal.
+     *
+     * @param re Regular expression.
+     * @return literal that must be present in matching strings
+     **/
+    static std::string get_required_literal(std::string_view re);
+
     /**
      * Make a regexp matching strings with the given suffix.
      *
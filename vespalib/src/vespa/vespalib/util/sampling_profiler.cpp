@@ -0,0 +1,188 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sampling_profiler.h"
+#include "classname.h"
+#include "cpu_usage.h"
+#include "stringfmt.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <sys/time.h>
+
+namespace vespalib {
+
+struct SamplingProfiler::State {
+    struct Sample {
+        int                depth;
+        CpuUsage::Category category;
+        void              *frames[max_frames];
+    };
+    // not value-initialized; pages are only touched when samples are taken
+    std::unique_ptr<Sample[]> samples;
+    std::atomic<size_t>       next;
+    State() : samples(new Sample[max_samples]), next(0) {}
+};
+
+namespace {
+
+// the frames of the signal handler itself and the signal trampoline
+constexpr int skip_frames = 2;
+
+std::atomic<bool> profiler_claimed(false);
+std::atomic<SamplingProfiler::State *> active_state(nullptr);
+std::atomic<uint32_t> handlers_running(0);
+
+void handle_sigprof(int, siginfo_t *, void *) {
+    int saved_errno = errno;
+    handlers_running.fetch_add(1);
+    if (auto *state = active_state.load()) {
+        size_t idx = state->next.fetch_add(1, std::memory_order_relaxed);
+        if (idx < SamplingProfiler::max_samples) {
+            auto &sample = state->samples[idx];
+            sample.depth = backtrace(sample.frames, SamplingProfiler::max_frames);
+            sample.category = CpuUsage::category_of_this_thread();
+        }
+    }
+    handlers_running.fetch_sub(1);
+    errno = saved_errno;
+}
+
+// The handler is installed on first use and then left in place, as a
+// SIGPROF still pending when a profiler is stopped would otherwise hit
+// the default action and terminate the process.
+void install_handler_once() {
+    static std::once_flag once;
+    std::call_once(once, []{
+        // backtrace may allocate on first use, so make sure that is not in the signal handler
+        void *warmup[1];
+        (void) backtrace(warmup, 1);
+        struct sigaction action = {};
+        action.sa_sigaction = handle_sigprof;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigaction(SIGPROF, &action, nullptr);
+    });
+}
+
+bool timer_is_armed() {
+    struct itimerval timer = {};
+    getitimer(ITIMER_PROF, &timer);
+    return (timer.it_value.tv_sec != 0) || (timer.it_value.tv_usec != 0);
+}
+
+void set_timer(uint32_t frequency_hz) {
+    struct itimerval timer = {};
+    if (frequency_hz > 0) {
+        long interval_us = std::max(1'000'000l / frequency_hz, 1l);
+        timer.it_interval.tv_sec = interval_us / 1'000'000;
+        timer.it_interval.tv_usec = interval_us % 1'000'000;
+        timer.it_value = timer.it_interval;
+    }
+    setitimer(ITIMER_PROF, &timer, nullptr);
+}
+
+class SymbolCache {
+private:
+    std::map<void *, std::string> _names;
+
+    static std::string resolve(void *addr) {
+        // return addresses point past the call instruction
+        void *lookup = static_cast<char *>(addr) - 1;
+        Dl_info info;
+        if (dladdr(lookup, &info) != 0) {
+            if (info.dli_sname != nullptr) {
+                std::string name = demangle(info.dli_sname);
+                return name.empty() ? std::string(info.dli_sname) : name;
+            }
+            if (info.dli_fname != nullptr) {
+                std::string_view module(info.dli_fname);
+                module = module.substr(module.rfind('/') + 1);
+                return make_string("%.*s+0x%zx", int(module.size()), module.data(),
+                                   size_t(static_cast<char *>(lookup) - static_cast<char *>(info.dli_fbase)));
+            }
+        }
+        return make_string("%p", addr);
+    }
+public:
+    const std::string &lookup(void *addr) {
+        auto pos = _names.find(addr);
+        if (pos == _names.end()) {
+            pos = _names.emplace(addr, resolve(addr)).first;
+        }
+        return pos->second;
+    }
+};
+
+}
+
+SamplingProfiler::SamplingProfiler(uint32_t frequency_hz, bool tag_with_category)
+    : _state(),
+      _tag_with_category(tag_with_category)
+{
+    bool expected = false;
+    if (!profiler_claimed.compare_exchange_strong(expected, true)) {
+        return;
+    }
+    if (timer_is_armed()) {
+        profiler_claimed.store(false);
+        return;
+    }
+    install_handler_once();
+    _state = std::make_unique<State>();
+    active_state.store(_state.get());
+    set_timer(std::clamp(frequency_hz, 1u, 1'000'000u));
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    stop();
+}
+
+SamplingProfiler::Result
+SamplingProfiler::stop()
+{
+    Result result;
+    if (!_state) {
+        return result;
+    }
+    set_timer(0);
+    active_state.store(nullptr);
+    while (handlers_running.load() != 0) {
+        std::this_thread::yield();
+    }
+    size_t taken = _state->next.load();
+    result.samples = std::min(taken, max_samples);
+    result.dropped = taken - result.samples;
+    SymbolCache symbols;
+    std::map<std::string, size_t> stacks;
+    std::string line;
+    for (size_t i = 0; i < result.samples; ++i) {
+        const auto &sample = _state->samples[i];
+        line.clear();
+        if (_tag_with_category) {
+            line.append(CpuUsage::name_of(sample.category));
+        }
+        for (int frame = sample.depth - 1; frame >= skip_frames; --frame) {
+            if (!line.empty()) {
+                line.push_back(';');
+            }
+            line.append(symbols.lookup(sample.frames[frame]));
+        }
+        ++stacks[line];
+    }
+    for (const auto &[stack, count]: stacks) {
+        result.folded.append(stack);
+        result.folded.append(make_string(" %zu\n", count));
+    }
+    _state.reset();
+    profiler_claimed.store(false);
+    return result;
+}
+
+}
@@ -0,0 +1,60 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace vespalib {
+
+/**
+ * Low-overhead sampling CPU profiler for the current process.
+ *
+ * While a profiler is active, the process gets a SIGPROF signal for
+ * each 1/frequency second of CPU time consumed (ITIMER_PROF). The
+ * thread interrupted by the signal stores its stack frame addresses
+ * into a pre-allocated sample buffer, optionally tagged with the
+ * CpuUsage category the thread has declared. Symbols are only
+ * resolved when the profiler is stopped, where the samples are
+ * aggregated into the folded stack format used by flame graph tools:
+ *
+ *   [category;]outermost_frame;...;innermost_frame <count>
+ *
+ * Only one profiler can be active in a process at any time, and a
+ * profiler will not start if someone else has armed ITIMER_PROF.
+ * Frames are resolved using the dynamic symbol table; frames that
+ * cannot be resolved are reported as module+offset.
+ **/
+class SamplingProfiler
+{
+public:
+    static constexpr size_t max_frames = 48;
+    static constexpr size_t max_samples = 32 * 1024;
+
+    struct Result {
+        size_t samples;
+        size_t dropped;
+        std::string folded;
+        Result() noexcept : samples(0), dropped(0), folded() {}
+    };
+
+    struct State;
+
+    SamplingProfiler(uint32_t frequency_hz, bool tag_with_category);
+    SamplingProfiler(const SamplingProfiler &) = delete;
+    SamplingProfiler &operator=(const SamplingProfiler &) = delete;
+    ~SamplingProfiler();
+
+    // false if another profiler was already running
+    bool active() const noexcept { return bool(_state); }
+
+    // stop sampling and aggregate the samples taken so far
+    Result stop();
+
+private:
+    std::unique_ptr<State> _state;
+    bool                   _tag_with_category;
+};
+
+}
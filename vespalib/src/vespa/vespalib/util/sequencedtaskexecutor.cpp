@@ -66,7 +66,9 @@ SequencedTaskExecutor::create(Runnable::init_fun_t func, uint32_t threads, uint3
 {
     if (optimize == OptimizeFor::ADAPTIVE) {
         size_t num_strands = std::min(taskLimit, threads*32);
-        return std::make_unique<AdaptiveSequencedExecutor>(num_strands, threads, kindOfWatermark, taskLimit, is_task_limit_hard);
+        // more ids than strands lets ids sharing a strand with a hot id be moved away from it
+        constexpr size_t ids_per_strand = 4;
+        return std::make_unique<AdaptiveSequencedExecutor>(num_strands, threads, kindOfWatermark, taskLimit, is_task_limit_hard, ids_per_strand);
     } else {
         auto executors = std::vector<std::unique_ptr<SyncableThreadExecutor>>();
         executors.reserve(threads);
@@ -7,7 +7,7 @@
 #include "spin_lock.h"
 #include <vespa/vespalib/stllike/identity.h>
 #include <vespa/vespalib/stllike/allocator.h>
-#include <vespa/vespalib/stllike/hashtable.hpp>
+#include <vespa/vespalib/stllike/swiss_hashtable.hpp>
 #include <mutex>
 #include <vector>
 #include <array>
@@ -107,7 +107,7 @@ private:
             bool operator()(const Key &a, const Key &b) const { return (a.idx == b.idx); }
             bool operator()(const Key &a, const AltKey &b) const { return ((a.hash == b.hash) && (entries[a.idx].view() == b.str)); }
         };
-        using HashType = hashtable<Key,Key,Hash,Equal,Identity,hashtable_base::and_modulator>;
+        using HashType = swiss_hashtable<Key,Key,Hash,Equal,Identity>;
 
     private:
         mutable SpinLock   _lock;
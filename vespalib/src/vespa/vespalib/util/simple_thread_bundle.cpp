@@ -55,15 +55,49 @@ Runnable::UP chain(Runnable::UP first, Runnable::UP second) {
 Signal::Signal() noexcept
     : valid(true),
       generation(0),
+      sleepers(0),
       monitor(std::make_unique<std::mutex>()),
       cond(std::make_unique<std::condition_variable>())
 {}
+
+Signal::Signal(Signal &&rhs) noexcept
+    : valid(rhs.valid),
+      generation(rhs.generation.load(std::memory_order_relaxed)),
+      sleepers(rhs.sleepers),
+      monitor(std::move(rhs.monitor)),
+      cond(std::move(rhs.cond))
+{}
+
 Signal::~Signal() = default;
 
-SimpleThreadBundle::Pool::Pool(size_t bundleSize, init_fun_t init_fun)
+size_t
+Signal::wait(size_t &localGen, duration spin) const
+{
+    size_t gen = generation.load(std::memory_order_acquire);
+    if ((gen == localGen) && (spin > duration::zero())) {
+        auto spin_end = steady_clock::now() + spin;
+        // only look at the clock now and then, it is more expensive than the load
+        for (size_t i = 1; (gen == localGen) && (((i % 64) != 0) || (steady_clock::now() < spin_end)); ++i) {
+            gen = generation.load(std::memory_order_acquire);
+        }
+    }
+    std::unique_lock guard(*monitor);
+    while (localGen == generation.load(std::memory_order_relaxed)) {
+        ++sleepers;
+        cond->wait(guard);
+        --sleepers;
+    }
+    gen = generation.load(std::memory_order_relaxed);
+    size_t diff = (gen - localGen);
+    localGen = gen;
+    return (valid ? diff : 0);
+}
+
+SimpleThreadBundle::Pool::Pool(size_t bundleSize, init_fun_t init_fun, duration spin)
     : _lock(),
       _bundleSize(bundleSize),
       _init_fun(init_fun),
+      _spin(spin),
       _bundles()
 {
 }
@@ -87,7 +121,7 @@ SimpleThreadBundle::Pool::obtain()
             return ret;
         }
     }
-    return std::make_unique<SimpleThreadBundle>(_bundleSize, _init_fun, USE_SIGNAL_LIST);
+    return std::make_unique<SimpleThreadBundle>(_bundleSize, _init_fun, USE_SIGNAL_LIST, _spin);
 }
 
 void
@@ -100,7 +134,7 @@ SimpleThreadBundle::Pool::release(SimpleThreadBundle::UP bundle)
 
 //-----------------------------------------------------------------------------
 
-SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Runnable::init_fun_t init_fun, Strategy strategy)
+SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Runnable::init_fun_t init_fun, Strategy strategy, duration spin)
     : _work(),
       _signals(),
       _workers(),
@@ -135,7 +169,7 @@ SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Runnable::init_fun_t init
             _hook = std::move(hook);
         } else {
             size_t signal_idx = (strategy == USE_BROADCAST) ? 0 : (i - 1);
-            _workers.push_back(std::make_unique<Worker>(_signals[signal_idx], init_fun, std::move(hook)));
+            _workers.push_back(std::make_unique<Worker>(_signals[signal_idx], spin, init_fun, std::move(hook)));
         }
     }
 }
@@ -177,9 +211,10 @@ SimpleThreadBundle::run(Runnable* const* targets, size_t cnt)
     latch.await();
 }
 
-SimpleThreadBundle::Worker::Worker(Signal &s, Runnable::init_fun_t init_fun, Runnable::UP h)
+SimpleThreadBundle::Worker::Worker(Signal &s, duration spin_in, Runnable::init_fun_t init_fun, Runnable::UP h)
   : thread(),
     signal(s),
+    spin(spin_in),
     hook(std::move(h))
 {
     thread = thread::start(*this, std::move(init_fun));
@@ -187,7 +222,7 @@ SimpleThreadBundle::Worker::Worker(Signal &s, Runnable::init_fun_t init_fun, Run
 
 void
 SimpleThreadBundle::Worker::run() {
-    for (size_t gen = 0; signal.wait(gen) > 0; ) {
+    for (size_t gen = 0; signal.wait(gen, spin) > 0; ) {
         hook->run();
     }
 }
@@ -6,6 +6,8 @@
 #include "thread.h"
 #include "runnable.h"
 #include "thread_bundle.h"
+#include "time.h"
+#include <atomic>
 
 namespace vespalib {
 
@@ -41,39 +43,39 @@ struct Part {
 };
 
 /**
- * countable signal path between threads.
+ * countable signal path between threads. The waiting thread may spin
+ * for a while on the generation before parking on the condition, in
+ * which case sending to it does not need to wake a parked thread. Each
+ * signal has its own cache line since the waiting thread polls it.
  **/
-struct Signal {
+struct alignas(64) Signal {
     bool valid;
-    size_t generation;
+    std::atomic<size_t> generation;
+    mutable size_t sleepers; // parked in wait, protected by monitor
     std::unique_ptr<std::mutex> monitor;
     std::unique_ptr<std::condition_variable> cond;
     Signal() noexcept;
-    Signal(Signal &&) noexcept = default;
+    Signal(Signal &&rhs) noexcept;
     ~Signal();
-    size_t wait(size_t &localGen) const {
-        std::unique_lock guard(*monitor);
-        while (localGen == generation) {
-            cond->wait(guard);
-        }
-        size_t diff = (generation - localGen);
-        localGen = generation;
-        return (valid ? diff : 0);
-    }
+    size_t wait(size_t &localGen, duration spin = duration::zero()) const;
     void send() {
         std::lock_guard guard(*monitor);
-        ++generation;
-        cond->notify_one();
+        generation.store(generation.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        if (sleepers > 0) {
+            cond->notify_one();
+        }
     }
     void broadcast() {
         std::lock_guard guard(*monitor);
-        ++generation;
-        cond->notify_all();
+        generation.store(generation.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        if (sleepers > 0) {
+            cond->notify_all();
+        }
     }
     void cancel() {
         std::lock_guard guard(*monitor);
-        ++generation;
         valid = false;
+        generation.store(generation.load(std::memory_order_relaxed) + 1, std::memory_order_release);
         cond->notify_all();
     }
 };
@@ -100,6 +102,7 @@ public:
         std::mutex _lock;
         size_t     _bundleSize;
         init_fun_t _init_fun;
+        duration   _spin;
         std::vector<SimpleThreadBundle*> _bundles;
 
     public:
@@ -114,7 +117,8 @@ public:
             SimpleThreadBundle::UP  _bundle;
             Pool                   &_pool;
         };
-        Pool(size_t bundleSize, init_fun_t init_fun);
+        Pool(size_t bundleSize, init_fun_t init_fun, duration spin);
+        Pool(size_t bundleSize, init_fun_t init_fun) : Pool(bundleSize, std::move(init_fun), duration::zero()) {}
         explicit Pool(size_t bundleSize) : Pool(bundleSize, Runnable::default_init_function) {}
         ~Pool();
         Guard getBundle() { return Guard(*this); }
@@ -128,8 +132,9 @@ private:
         using UP = std::unique_ptr<Worker>;
         std::thread thread;
         Signal &signal;
+        duration spin;
         Runnable::UP hook;
-        Worker(Signal &s, init_fun_t init_fun, Runnable::UP h);
+        Worker(Signal &s, duration spin_in, init_fun_t init_fun, Runnable::UP h);
         void run() override;
     };
 
@@ -139,7 +144,14 @@ private:
     Runnable::UP            _hook;
 
 public:
-    SimpleThreadBundle(size_t size, init_fun_t init_fun, Strategy strategy);
+    /**
+     * Worker threads spin for up to 'spin' waiting for the next call to
+     * run before parking. Spinning trades cpu for lower wakeup latency
+     * when run is called often.
+     **/
+    SimpleThreadBundle(size_t size, init_fun_t init_fun, Strategy strategy, duration spin);
+    SimpleThreadBundle(size_t size, init_fun_t init_fun, Strategy strategy)
+      : SimpleThreadBundle(size, std::move(init_fun), strategy, duration::zero()) {}
     SimpleThreadBundle(size_t size, Strategy strategy)
       : SimpleThreadBundle(size, Runnable::default_init_function, strategy) {}
     explicit SimpleThreadBundle(size_t size)
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "stash.h"
+#include "stash_chunk_pool.h"
 #include <algorithm>
 
 namespace vespalib {
@@ -8,23 +9,31 @@ namespace stash {
 
 namespace {
 
-Chunk *free_chunks(Chunk *chunk, Chunk *until = nullptr) {
+void free_chunk(void *mem, StashChunkPool *pool) noexcept {
+    if (pool != nullptr) {
+        pool->release(mem);
+    } else {
+        free(mem);
+    }
+}
+
+Chunk *free_chunks(StashChunkPool *pool, Chunk *chunk, Chunk *until = nullptr) {
     while (chunk != until) {
         void *mem = chunk;
         chunk = chunk->next;
-        free(mem);
+        free_chunk(mem, pool);
     }
     return until;
 }
 
-Chunk *keep_one(Chunk *chunk) {
+Chunk *keep_one(StashChunkPool *pool, Chunk *chunk) {
     if (chunk != nullptr) {
         Chunk *next = chunk->next;
         while (next != nullptr) {
             void *mem = chunk;
             chunk = next;
             next = chunk->next;
-            free(mem);
+            free_chunk(mem, pool);
         }
         chunk->clear();
         return chunk;
@@ -49,7 +58,7 @@ char *
 Stash::do_alloc(size_t size)
 {
     if (is_small(size)) {
-        void *chunk_mem = malloc(_chunk_size);
+        void *chunk_mem = (_pool != nullptr) ? _pool->alloc() : malloc(_chunk_size);
         _chunks = new (chunk_mem) stash::Chunk(_chunks);
         return _chunks->alloc(size, _chunk_size);
     } else {
@@ -63,14 +72,24 @@ Stash::do_alloc(size_t size)
 Stash::Stash(size_t chunk_size) noexcept
     : _chunks(nullptr),
       _cleanup(nullptr),
-      _chunk_size(std::max(size_t(128), chunk_size))
+      _chunk_size(std::max(size_t(128), chunk_size)),
+      _pool(nullptr)
+{
+}
+
+Stash::Stash(StashChunkPool &pool) noexcept
+    : _chunks(nullptr),
+      _cleanup(nullptr),
+      _chunk_size(pool.chunk_size()),
+      _pool(&pool)
 {
 }
 
 Stash::Stash(Stash &&rhs) noexcept
     : _chunks(rhs._chunks),
       _cleanup(rhs._cleanup),
-      _chunk_size(rhs._chunk_size)
+      _chunk_size(rhs._chunk_size),
+      _pool(rhs._pool)
 {
     rhs._chunks = nullptr;
     rhs._cleanup = nullptr;
@@ -80,10 +99,11 @@ Stash &
 Stash::operator=(Stash &&rhs) noexcept
 {
     stash::run_cleanup(_cleanup);
-    stash::free_chunks(_chunks);
+    stash::free_chunks(_pool, _chunks);
     _chunks = rhs._chunks;
     _cleanup = rhs._cleanup;
     _chunk_size = rhs._chunk_size;
+    _pool = rhs._pool;
     rhs._chunks = nullptr;
     rhs._cleanup = nullptr;
     return *this;
@@ -92,21 +112,21 @@ Stash::operator=(Stash &&rhs) noexcept
 Stash::~Stash()
 {
     stash::run_cleanup(_cleanup);
-    stash::free_chunks(_chunks);
+    stash::free_chunks(_pool, _chunks);
 }
 
 void
 Stash::clear()
 {
     _cleanup = stash::run_cleanup(_cleanup);
-    _chunks = stash::keep_one(_chunks);
+    _chunks = stash::keep_one(_pool, _chunks);
 }
 
 void
 Stash::revert(const Mark &mark)
 {
     _cleanup = stash::run_cleanup(_cleanup, mark._cleanup);
-    _chunks = stash::free_chunks(_chunks, mark._chunk);
+    _chunks = stash::free_chunks(_pool, _chunks, mark._chunk);
     if (_chunks != nullptr) {
         _chunks->used = mark._used;
     }
@@ -9,6 +9,9 @@
 #include <span>
 
 namespace vespalib {
+
+class StashChunkPool;
+
 namespace stash {
 
 struct Cleanup {
@@ -80,6 +83,10 @@ struct Chunk {
  *
  * The minimal chunk size of a stash is 4k. Any object larger than 1/4
  * of the chunk size will be allocated separately.
+ *
+ * A stash may take its chunks from a StashChunkPool, in which case
+ * the chunk size is given by the pool and chunks are given back to
+ * the pool instead of being freed.
  **/
 class Stash
 {
@@ -87,6 +94,7 @@ private:
     stash::Chunk   *_chunks;
     stash::Cleanup *_cleanup;
     size_t          _chunk_size;
+    StashChunkPool *_pool;
 
     char *do_alloc(size_t size);
     bool is_small(size_t size) const noexcept { return (size < (_chunk_size / 4)); }
@@ -132,6 +140,7 @@ public:
 
     using UP = std::unique_ptr<Stash>;
     explicit Stash(size_t chunk_size) noexcept ;
+    explicit Stash(StashChunkPool &pool) noexcept;
     Stash() noexcept : Stash(4096) {}
     Stash(Stash &&rhs) noexcept;
     Stash(const Stash &) = delete;
@@ -0,0 +1,79 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "stash_chunk_pool.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace vespalib {
+
+namespace {
+
+std::atomic<size_t> next_thread_idx(0);
+
+}
+
+size_t
+StashChunkPool::first_slot() const noexcept
+{
+    // spread threads over the slots to avoid contending for the same ones
+    thread_local size_t thread_idx = next_thread_idx.fetch_add(1, std::memory_order_relaxed);
+    return (thread_idx * 7) % _num_slots;
+}
+
+StashChunkPool::StashChunkPool(size_t chunk_size, size_t max_chunks)
+    : _chunk_size(std::max(size_t(128), chunk_size)),
+      _num_slots(std::max(size_t(1), max_chunks)),
+      _slots(std::make_unique<Slot[]>(_num_slots)),
+      _cached(0)
+{
+    for (size_t i = 0; i < _num_slots; ++i) {
+        _slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+StashChunkPool::~StashChunkPool()
+{
+    for (size_t i = 0; i < _num_slots; ++i) {
+        free(_slots[i].load(std::memory_order_relaxed));
+    }
+}
+
+void *
+StashChunkPool::alloc()
+{
+    if (_cached.load(std::memory_order_relaxed) > 0) {
+        size_t first = first_slot();
+        for (size_t i = 0; i < _num_slots; ++i) {
+            Slot &slot = _slots[(first + i) % _num_slots];
+            if (slot.load(std::memory_order_relaxed) != nullptr) {
+                void *chunk = slot.exchange(nullptr, std::memory_order_acquire);
+                if (chunk != nullptr) {
+                    _cached.fetch_sub(1, std::memory_order_relaxed);
+                    return chunk;
+                }
+            }
+        }
+    }
+    return malloc(_chunk_size);
+}
+
+void
+StashChunkPool::release(void *chunk) noexcept
+{
+    if (_cached.load(std::memory_order_relaxed) < _num_slots) {
+        size_t first = first_slot();
+        for (size_t i = 0; i < _num_slots; ++i) {
+            Slot &slot = _slots[(first + i) % _num_slots];
+            void *expect = nullptr;
+            if (slot.load(std::memory_order_relaxed) == nullptr &&
+                slot.compare_exchange_strong(expect, chunk, std::memory_order_release, std::memory_order_relaxed))
+            {
+                _cached.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+    free(chunk);
+}
+
+}
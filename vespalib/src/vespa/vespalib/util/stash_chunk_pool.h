@@ -0,0 +1,52 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace vespalib {
+
+/**
+ * A bounded pool of equally sized memory chunks that may be shared
+ * by stashes owned by different threads. Chunks released by a stash
+ * are kept in the pool (up to a maximum number of chunks) and handed
+ * out again to the next stash needing memory, letting short-lived
+ * stashes (like the ones used for a single query) avoid most trips
+ * to the allocator.
+ *
+ * The pool is lock-free; each cached chunk lives in its own slot
+ * which is claimed with an atomic exchange. The pool must outlive all
+ * stashes using it.
+ **/
+class StashChunkPool
+{
+private:
+    using Slot = std::atomic<void*>;
+
+    size_t                  _chunk_size;
+    size_t                  _num_slots;
+    std::unique_ptr<Slot[]> _slots;
+    std::atomic<size_t>     _cached;
+
+    size_t first_slot() const noexcept;
+
+public:
+    StashChunkPool(size_t chunk_size, size_t max_chunks);
+    StashChunkPool(const StashChunkPool &) = delete;
+    StashChunkPool &operator=(const StashChunkPool &) = delete;
+    ~StashChunkPool();
+
+    size_t chunk_size() const noexcept { return _chunk_size; }
+    size_t max_chunks() const noexcept { return _num_slots; }
+    size_t cached_chunks() const noexcept { return _cached.load(std::memory_order_relaxed); }
+
+    // get a chunk of chunk_size() bytes, from the pool if possible
+    void *alloc();
+
+    // give back a chunk obtained from alloc; freed if the pool is full
+    void release(void *chunk) noexcept;
+};
+
+}
@@ -0,0 +1,220 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "tiered_memory_allocator.h"
+#include "round_up_to_page_size.h"
+#include "exceptions.h"
+#include "stringfmt.h"
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+
+using vespalib::make_string_short::fmt;
+namespace fs = std::filesystem;
+
+namespace vespalib::alloc {
+
+TieredMemoryAllocator::TieredMemoryAllocator(std::string dir_name)
+    : TieredMemoryAllocator(std::move(dir_name), Policy())
+{
+}
+
+TieredMemoryAllocator::TieredMemoryAllocator(std::string dir_name, Policy policy)
+    : _dir_name(std::move(dir_name)),
+      _policy(policy),
+      _file(_dir_name + "/swapfile"),
+      _end_offset(0),
+      _allocations(),
+      _freelist(),
+      _hot_allocations(0),
+      _hot_bytes(0),
+      _cold_allocations(0),
+      _cold_bytes(0),
+      _demotions(0),
+      _promotions(0)
+{
+    fs::create_directories(fs::path(_dir_name));
+    _file.open(O_RDWR | O_CREAT | O_TRUNC, false);
+}
+
+TieredMemoryAllocator::~TieredMemoryAllocator()
+{
+    assert(_allocations.empty());
+    _file.close();
+    _file.unlink();
+    fs::remove_all(fs::path(_dir_name));
+}
+
+uint64_t
+TieredMemoryAllocator::alloc_area(size_t sz) const
+{
+    uint64_t offset = _freelist.alloc(sz);
+    if (offset != FileAreaFreeList::bad_offset) {
+        return offset;
+    }
+    offset = _end_offset;
+    _end_offset += sz;
+    _file.resize(_end_offset);
+    return offset;
+}
+
+void
+TieredMemoryAllocator::update_stats(const Allocation& allocation, bool cold, bool added) const noexcept
+{
+    auto& allocations = cold ? _cold_allocations : _hot_allocations;
+    auto& bytes = cold ? _cold_bytes : _hot_bytes;
+    if (added) {
+        add(allocations, 1);
+        add(bytes, allocation.size);
+    } else {
+        sub(allocations, 1);
+        sub(bytes, allocation.size);
+    }
+}
+
+PtrAndSize
+TieredMemoryAllocator::alloc(size_t sz) const
+{
+    if (sz == 0) {
+        return {}; // empty allocation
+    }
+    sz = round_up_to_page_size(sz);
+    void *buf = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buf == MAP_FAILED) {
+        throw IoException(fmt("Failed mmap(nullptr, %zu, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0). Reason given by OS = '%s'",
+                              sz, getLastErrorString().c_str()),
+                          IoException::getErrorType(errno), VESPA_STRLOC);
+    }
+    assert(buf != nullptr);
+    auto ins_res = _allocations.insert(std::make_pair(buf, Allocation(sz)));
+    assert(ins_res.second);
+    update_stats(ins_res.first->second, false, true);
+    return {buf, sz};
+}
+
+void
+TieredMemoryAllocator::free(PtrAndSize alloc) const noexcept
+{
+    if (alloc.size() == 0) {
+        assert(alloc.get() == nullptr);
+        return; // empty allocation
+    }
+    auto itr = _allocations.find(alloc.get());
+    assert(itr != _allocations.end());
+    assert(itr->second.size == alloc.size());
+    auto allocation = itr->second;
+    _allocations.erase(itr);
+    update_stats(allocation, allocation.cold(), false);
+    int retval = munmap(alloc.get(), alloc.size());
+    assert(retval == 0);
+    if (allocation.cold()) {
+        _freelist.free(allocation.offset, allocation.size);
+    }
+}
+
+size_t
+TieredMemoryAllocator::resize_inplace(PtrAndSize, size_t) const
+{
+    return 0;
+}
+
+void
+TieredMemoryAllocator::demote(void *ptr, Allocation& allocation) const
+{
+    uint64_t offset = alloc_area(allocation.size);
+    _file.write(ptr, allocation.size, offset);
+    // Replace anonymous memory with file backed memory containing the same data
+    void *buf = mmap(ptr, allocation.size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, _file.getFileDescriptor(), offset);
+    if (buf == MAP_FAILED) {
+        throw IoException(fmt("Failed mmap(%p, %zu, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, %s(fd=%d), %" PRIu64 "). Reason given by OS = '%s'",
+                              ptr, allocation.size, _file.getFilename().c_str(), _file.getFileDescriptor(), offset, getLastErrorString().c_str()),
+                          IoException::getErrorType(errno), VESPA_STRLOC);
+    }
+    assert(buf == ptr);
+    int retval = madvise(buf, allocation.size, MADV_RANDOM);
+    assert(retval == 0);
+#ifdef __linux__
+    retval = madvise(buf, allocation.size, MADV_DONTDUMP);
+    assert(retval == 0);
+#endif
+    update_stats(allocation, false, false);
+    allocation.offset = offset;
+    update_stats(allocation, true, true);
+    _demotions.store(_demotions.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void
+TieredMemoryAllocator::promote(void *ptr, Allocation& allocation) const
+{
+#ifdef __linux__
+    void *buf = mmap(nullptr, allocation.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buf == MAP_FAILED) {
+        return; // Keep allocation cold
+    }
+    memcpy(buf, ptr, allocation.size);
+    // Move anonymous memory on top of file backed memory containing the same data
+    void *moved = mremap(buf, allocation.size, allocation.size, MREMAP_MAYMOVE | MREMAP_FIXED, ptr);
+    if (moved == MAP_FAILED) {
+        int retval = munmap(buf, allocation.size);
+        assert(retval == 0);
+        return; // Keep allocation cold
+    }
+    assert(moved == ptr);
+    _freelist.free(allocation.offset, allocation.size);
+    update_stats(allocation, true, false);
+    allocation.offset = hot_offset;
+    update_stats(allocation, false, true);
+    _promotions.store(_promotions.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+#else
+    (void) ptr;
+    (void) allocation;
+#endif
+}
+
+void
+TieredMemoryAllocator::sample(PtrAndSize alloc, uint64_t signature) const
+{
+    auto itr = _allocations.find(alloc.get());
+    if (itr == _allocations.end()) {
+        return;
+    }
+    auto& allocation = itr->second;
+    if (allocation.signature != signature) {
+        allocation.signature = signature;
+        allocation.stable_samples = 0;
+        if (allocation.cold()) {
+            promote(itr->first, allocation);
+        }
+        return;
+    }
+    if (allocation.cold() || allocation.size < _policy.min_cold_size) {
+        return;
+    }
+    if (++allocation.stable_samples >= _policy.cold_samples) {
+        demote(itr->first, allocation);
+    }
+}
+
+bool
+TieredMemoryAllocator::is_cold(PtrAndSize alloc) const noexcept
+{
+    auto itr = _allocations.find(alloc.get());
+    return (itr != _allocations.end()) && itr->second.cold();
+}
+
+TieredMemoryStats
+TieredMemoryAllocator::get_stats() const noexcept
+{
+    TieredMemoryStats stats;
+    stats.hot_allocations = _hot_allocations.load(std::memory_order_relaxed);
+    stats.hot_bytes = _hot_bytes.load(std::memory_order_relaxed);
+    stats.cold_allocations = _cold_allocations.load(std::memory_order_relaxed);
+    stats.cold_bytes = _cold_bytes.load(std::memory_order_relaxed);
+    stats.demotions = _demotions.load(std::memory_order_relaxed);
+    stats.promotions = _promotions.load(std::memory_order_relaxed);
+    return stats;
+}
+
+}
@@ -0,0 +1,124 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "memory_allocator.h"
+#include "file_area_freelist.h"
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <atomic>
+#include <string>
+
+namespace vespalib::alloc {
+
+/*
+ * Statistics for a tiered memory allocator.
+ */
+struct TieredMemoryStats {
+    size_t   hot_allocations;
+    size_t   hot_bytes;
+    size_t   cold_allocations;
+    size_t   cold_bytes;
+    uint64_t demotions;
+    uint64_t promotions;
+    TieredMemoryStats() noexcept
+        : hot_allocations(0),
+          hot_bytes(0),
+          cold_allocations(0),
+          cold_bytes(0),
+          demotions(0),
+          promotions(0)
+    { }
+};
+
+/*
+ * Class handling memory allocations that start out as anonymous memory (hot)
+ * and are migrated to memory backed by a file (cold) when sampling shows that
+ * they have not been changed for a while. A cold allocation is migrated back to
+ * anonymous memory when it is changed again.
+ *
+ * Migration keeps both the address and the contents of the allocation. When
+ * demoting, the contents are written to an area of the file which is then
+ * mapped on top of the anonymous memory. Pages of cold allocations can then be
+ * dropped by the kernel under memory pressure, while pages that are still read
+ * stay in the page cache.
+ *
+ * Not reentrant or thread safe, only the writer thread should allocate, free
+ * and sample. Should not be destructed before all allocations have been freed.
+ */
+class TieredMemoryAllocator : public MemoryAllocator {
+public:
+    struct Policy {
+        // Number of samples without changes before allocation is demoted
+        uint32_t cold_samples;
+        // Allocations smaller than this are never demoted
+        size_t   min_cold_size;
+        Policy() noexcept : Policy(default_cold_samples, default_min_cold_size) { }
+        Policy(uint32_t cold_samples_in, size_t min_cold_size_in) noexcept
+            : cold_samples(cold_samples_in),
+              min_cold_size(min_cold_size_in)
+        { }
+    };
+    static constexpr uint32_t default_cold_samples = 8;
+    static constexpr size_t default_min_cold_size = 1_Mi;
+private:
+    static constexpr uint64_t hot_offset = FileAreaFreeList::bad_offset;
+    struct Allocation {
+        size_t   size;
+        uint64_t offset; // offset in file for cold allocation
+        uint64_t signature;
+        uint32_t stable_samples;
+        Allocation() noexcept : Allocation(0u) { }
+        explicit Allocation(size_t size_in) noexcept
+            : size(size_in),
+              offset(hot_offset),
+              signature(0),
+              stable_samples(0)
+        { }
+        bool cold() const noexcept { return offset != hot_offset; }
+    };
+    using Allocations = hash_map<void *, Allocation>;
+    const std::string _dir_name;
+    const Policy      _policy;
+    mutable File      _file;
+    mutable uint64_t  _end_offset;
+    mutable Allocations _allocations;
+    mutable FileAreaFreeList _freelist;
+    // Statistics can be read by other threads
+    mutable std::atomic<size_t>   _hot_allocations;
+    mutable std::atomic<size_t>   _hot_bytes;
+    mutable std::atomic<size_t>   _cold_allocations;
+    mutable std::atomic<size_t>   _cold_bytes;
+    mutable std::atomic<uint64_t> _demotions;
+    mutable std::atomic<uint64_t> _promotions;
+    static void add(std::atomic<size_t>& stat, size_t delta) noexcept {
+        stat.store(stat.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+    static void sub(std::atomic<size_t>& stat, size_t delta) noexcept {
+        stat.store(stat.load(std::memory_order_relaxed) - delta, std::memory_order_relaxed);
+    }
+    void update_stats(const Allocation& allocation, bool cold, bool added) const noexcept;
+    uint64_t alloc_area(size_t sz) const;
+    void demote(void *ptr, Allocation& allocation) const;
+    void promote(void *ptr, Allocation& allocation) const;
+public:
+    explicit TieredMemoryAllocator(std::string dir_name);
+    TieredMemoryAllocator(std::string dir_name, Policy policy);
+    ~TieredMemoryAllocator() override;
+    PtrAndSize alloc(size_t sz) const override;
+    void free(PtrAndSize alloc) const noexcept override;
+    size_t resize_inplace(PtrAndSize, size_t) const override;
+
+    /*
+     * Sample an allocation. The signature should change when the contents of
+     * the allocation are changed, e.g. by including the number of used and
+     * dead entries in a datastore buffer.
+     */
+    void sample(PtrAndSize alloc, uint64_t signature) const;
+    bool is_cold(PtrAndSize alloc) const noexcept;
+    const Policy& policy() const noexcept { return _policy; }
+    // Can be called by any thread
+    TieredMemoryStats get_stats() const noexcept;
+};
+
+}
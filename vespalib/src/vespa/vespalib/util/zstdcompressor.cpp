@@ -2,7 +2,10 @@
 
 #include "zstdcompressor.h"
 #include <vespa/vespalib/util/alloc.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <zstd.h>
+#include <zdict.h>
 #include <cassert>
 
 using vespalib::alloc::Alloc;
@@ -31,6 +34,22 @@ private:
 thread_local std::unique_ptr<CompressContext>  _tlCompressState;
 thread_local std::unique_ptr<DecompressContext> _tlDecompressState;
 
+ZSTD_CCtx *
+compressContext() {
+    if ( ! _tlCompressState) {
+        _tlCompressState = std::make_unique<CompressContext>();
+    }
+    return _tlCompressState->get();
+}
+
+ZSTD_DCtx *
+decompressContext() {
+    if ( ! _tlDecompressState) {
+        _tlDecompressState = std::make_unique<DecompressContext>();
+    }
+    return _tlDecompressState->get();
+}
+
 }
 
 size_t ZStdCompressor::adjustProcessLen(uint16_t, size_t len)   const { return ZSTD_compressBound(len); }
@@ -39,10 +58,7 @@ bool
 ZStdCompressor::process(CompressionConfig config, const void * inputV, size_t inputLen, void * outputV, size_t & outputLenV)
 {
     size_t maxOutputLen = ZSTD_compressBound(inputLen);
-    if ( ! _tlCompressState) {
-        _tlCompressState = std::make_unique<CompressContext>();
-    }
-    size_t sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    size_t sz = ZSTD_compressCCtx(compressContext(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
@@ -51,13 +67,89 @@ ZStdCompressor::process(CompressionConfig config, const void * inputV, size_t in
 bool
 ZStdCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV, size_t & outputLenV)
 {
-    if ( ! _tlDecompressState) {
-        _tlDecompressState = std::make_unique<DecompressContext>();
-    }
-    size_t sz = ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
+    size_t sz = ZSTD_decompressDCtx(decompressContext(), outputV, outputLenV, inputV, inputLen);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
 }
 
+ZStdDictionary::ZStdDictionary(std::vector<char> data)
+    : _data(std::move(data)),
+      _id(ZDICT_getDictID(_data.data(), _data.size())),
+      _lock(),
+      _cdicts(),
+      _ddictOnce(),
+      _ddict(nullptr)
+{
+    if (_id == 0) {
+        throw IllegalArgumentException(make_string("Not a valid zstd dictionary (%zu bytes)", _data.size()), VESPA_STRLOC);
+    }
+}
+
+ZStdDictionary::~ZStdDictionary()
+{
+    for (auto & entry : _cdicts) {
+        ZSTD_freeCDict(entry.second);
+    }
+    ZSTD_freeDDict(_ddict);
+}
+
+const ZSTD_CDict *
+ZStdDictionary::getCDict(int compressionLevel) const
+{
+    // Digested dictionaries are kept for the lifetime of the dictionary as they might be in use by other threads
+    std::lock_guard guard(_lock);
+    for (const auto & entry : _cdicts) {
+        if (entry.first == compressionLevel) {
+            return entry.second;
+        }
+    }
+    _cdicts.emplace_back(compressionLevel, ZSTD_createCDict(_data.data(), _data.size(), compressionLevel));
+    return _cdicts.back().second;
+}
+
+const ZSTD_DDict *
+ZStdDictionary::getDDict() const
+{
+    std::call_once(_ddictOnce, [this]() { _ddict = ZSTD_createDDict(_data.data(), _data.size()); });
+    return _ddict;
+}
+
+ZStdDictionary::SP
+ZStdDictionary::train(const std::vector<char> & samples, const std::vector<size_t> & sampleSizes, size_t maxSize)
+{
+    std::vector<char> data(maxSize);
+    size_t sz = ZDICT_trainFromBuffer(data.data(), data.size(), samples.data(), sampleSizes.data(), sampleSizes.size());
+    if (ZDICT_isError(sz)) {
+        return {};
+    }
+    data.resize(sz);
+    return std::make_shared<const ZStdDictionary>(std::move(data));
+}
+
+size_t ZStdDictionaryCompressor::adjustProcessLen(uint16_t, size_t len) const { return ZSTD_compressBound(len); }
+
+bool
+ZStdDictionaryCompressor::process(CompressionConfig config, const void * inputV, size_t inputLen, void * outputV, size_t & outputLenV)
+{
+    size_t maxOutputLen = ZSTD_compressBound(inputLen);
+    size_t sz = ZSTD_compress_usingCDict(compressContext(), outputV, maxOutputLen, inputV, inputLen,
+                                         _dictionary.getCDict(config.compressionLevel));
+    outputLenV = sz;
+    return ! ZSTD_isError(sz);
+}
+
+bool
+ZStdDictionaryCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV, size_t & outputLenV)
+{
+    size_t sz = ZSTD_decompress_usingDDict(decompressContext(), outputV, outputLenV, inputV, inputLen, _dictionary.getDDict());
+    if (ZSTD_isError(sz)) {
+        // Wrong or missing dictionary, a zero length makes decompress() fail instead of passing the input through
+        outputLenV = 0;
+        return false;
+    }
+    outputLenV = sz;
+    return true;
+}
+
 }
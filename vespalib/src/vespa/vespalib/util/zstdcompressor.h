@@ -2,6 +2,12 @@
 #pragma once
 
 #include "compressor.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 namespace vespalib::compression {
 
@@ -13,5 +19,54 @@ public:
     size_t adjustProcessLen(uint16_t options, size_t len)   const override;
 };
 
+/**
+ * A trained zstd dictionary. The digested dictionaries used for compression
+ * and decompression are created on first use and shared by all threads.
+ */
+class ZStdDictionary
+{
+public:
+    using SP = std::shared_ptr<const ZStdDictionary>;
+    /**
+     * @param data is a dictionary as produced by train(). Throws IllegalArgumentException
+     *             if it is not a valid zstd dictionary.
+     */
+    explicit ZStdDictionary(std::vector<char> data);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator=(const ZStdDictionary &) = delete;
+    ~ZStdDictionary();
+    uint32_t id() const noexcept { return _id; }
+    const std::vector<char> & data() const noexcept { return _data; }
+    const ZSTD_CDict_s * getCDict(int compressionLevel) const;
+    const ZSTD_DDict_s * getDDict() const;
+    /**
+     * Train a dictionary from a set of samples stored back to back in samples.
+     * Returns nullptr if training fails, e.g. due to too few samples.
+     */
+    static SP train(const std::vector<char> & samples, const std::vector<size_t> & sampleSizes, size_t maxSize);
+private:
+    std::vector<char>        _data;
+    uint32_t                 _id;
+    mutable std::mutex       _lock;
+    mutable std::vector<std::pair<int, ZSTD_CDict_s *>> _cdicts;
+    mutable std::once_flag   _ddictOnce;
+    mutable ZSTD_DDict_s   * _ddict;
+};
+
+/**
+ * Zstd compressor using a trained dictionary. Data compressed with a dictionary
+ * can only be decompressed with the same dictionary.
+ */
+class ZStdDictionaryCompressor : public ICompressor
+{
+public:
+    explicit ZStdDictionaryCompressor(const ZStdDictionary & dictionary) noexcept : _dictionary(dictionary) { }
+    bool process(CompressionConfig config, const void * input, size_t inputLen, void * output, size_t & outputLen) override;
+    bool unprocess(const void * input, size_t inputLen, void * output, size_t & outputLen) override;
+    size_t adjustProcessLen(uint16_t options, size_t len)   const override;
+private:
+    const ZStdDictionary & _dictionary;
+};
+
 }
 
@@ -6,6 +6,8 @@
 #include <malloc.h>
 #include <dlfcn.h>
 #include <functional>
+#include <string>
+#include <vector>
 #include <cassert>
 
 LOG_SETUP("new_test");
@@ -235,6 +237,65 @@ TEST(NewTest, verify_mmap_limit) {
     EXPECT_LT(size_t(labs(small.get() - large_2.get())), 1_Ti);
 }
 
+void
+allocate_and_free_blocks(size_t count, size_t sz) {
+    std::vector<std::unique_ptr<char[]>> blocks;
+    for (size_t i(0); i < count; i++) {
+        blocks.push_back(std::make_unique<char[]>(sz));
+        memset(blocks.back().get(), 0x5b, sz);
+    }
+}
+
+TEST(NewTest, verify_malloc_trim_releases_cached_free_memory) {
+    if (_env == MallocLibrary::UNKNOWN) return;
+    using ReleaseFunc = size_t (*)(int);
+    auto release = reinterpret_cast<ReleaseFunc>(dlsym(RTLD_DEFAULT, "vespamalloc_release_free_memory"));
+    ASSERT_TRUE(release != nullptr);
+    allocate_and_free_blocks(16, 256_Ki);
+    if (_env == MallocLibrary::VESPA_MALLOC_D) {
+        // Free blocks in debug variants carry state used for verification
+        EXPECT_EQ(0, malloc_trim(0));
+        EXPECT_EQ(0u, release(-1));
+        return;
+    }
+    EXPECT_EQ(1, malloc_trim(0));
+    allocate_and_free_blocks(16, 256_Ki);
+    EXPECT_GE(release(0), 256_Ki);
+    EXPECT_EQ(0u, release(1000));
+    auto buf = std::make_unique<char[]>(256_Ki);
+    memset(buf.get(), 0x3c, 256_Ki);
+    EXPECT_EQ(0u, count_mismatches(buf.get(), 0x3c, 256_Ki));
+}
+
+TEST(NewTest, verify_allocation_sampling_records_call_stacks) {
+    if (_env == MallocLibrary::UNKNOWN) return;
+    using SetIntervalFunc = void (*)(size_t);
+    using ResetFunc = void (*)();
+    using DumpFunc = void (*)(FILE *, size_t);
+    auto set_interval = reinterpret_cast<SetIntervalFunc>(dlsym(RTLD_DEFAULT, "vespamalloc_set_alloc_sample_interval"));
+    auto reset = reinterpret_cast<ResetFunc>(dlsym(RTLD_DEFAULT, "vespamalloc_reset_alloc_samples"));
+    auto dump = reinterpret_cast<DumpFunc>(dlsym(RTLD_DEFAULT, "vespamalloc_dump_alloc_samples"));
+    ASSERT_TRUE(set_interval != nullptr);
+    ASSERT_TRUE(reset != nullptr);
+    ASSERT_TRUE(dump != nullptr);
+    reset();
+    set_interval(4_Ki);
+    allocate_and_free_blocks(256, 1_Ki);
+    set_interval(0);
+    char * buf = nullptr;
+    size_t buf_size = 0;
+    FILE * f = open_memstream(&buf, &buf_size);
+    ASSERT_TRUE(f != nullptr);
+    dump(f, 8);
+    fclose(f);
+    std::string info(buf, buf_size);
+    free(buf);
+    EXPECT_EQ(0u, info.find("Allocation samples: interval 0 bytes"));
+    EXPECT_EQ(std::string::npos, info.find(" 0 samples"));
+    EXPECT_NE(std::string::npos, info.find("bytes estimated"));
+    reset();
+}
+
 void
 verifyReallocLarge(char * initial, bool expect_vespamalloc_optimization) {
     const size_t INITIAL_SIZE = 0x400001;
@@ -109,6 +109,12 @@ public:
     [[nodiscard]] bool empty() const noexcept { return (_count == 0); }
     [[nodiscard]] bool full() const noexcept { return (_count == NumBlocks); }
     size_t fill(void * mem, SizeClassT sc, size_t blocksPerChunk = NumBlocks) noexcept;
+    template <typename Func>
+    void forEach(Func func) noexcept {
+        for (CountT i(0); i < _count; i++) {
+            func(_memBlockList[i]);
+        }
+    }
     AFList * getNext() noexcept { return static_cast<AFList *>(AFListBase::getNext()); }
     static AFList * linkOut(AtomicHeadPtr & head) noexcept {
         return static_cast<AFList *>(AFListBase::linkOut(head));
@@ -2,6 +2,10 @@
 #include "common.h"
 #include <vespamalloc/util/callstack.h>
 #include <pthread.h>
+#include <algorithm>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/syscall.h>
 
 namespace vespamalloc {
 
@@ -63,6 +67,28 @@ logStackTrace() {
     fprintf(_G_logFile, "\n");
 }
 
+uint32_t
+numaNodesFromEnv()
+{
+    const char * s = getenv("VESPA_MALLOC_NUMA_NODES");
+    long numNodes = (s != nullptr) ? strtol(s, nullptr, 0) : 1;
+    return std::clamp(numNodes, 1l, long(MAX_NUMA_NODES));
+}
+
+uint32_t
+currentNumaNode(uint32_t numNodes)
+{
+    if (numNodes <= 1) {
+        return 0;
+    }
+    unsigned cpu(0);
+    unsigned node(0);
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return 0;
+    }
+    return node % numNodes;
+}
+
 void
 logBigBlock(const void *ptr, size_t exact, size_t adjusted, size_t gross)
 {
@@ -19,6 +19,7 @@ namespace vespamalloc {
 #define NUM_SIZE_CLASSES 32   // Max 64G
 
 static constexpr uint32_t NUM_THREADS = 16384;
+static constexpr uint32_t MAX_NUMA_NODES = 8;
 
 #define UNUSED(a)
 #ifdef ENABLE_DEBUG
@@ -124,6 +125,16 @@ void info();
 void logBigBlock(const void *ptr, size_t exact, size_t adjusted, size_t gross) __attribute__((noinline));
 void logStackTrace() __attribute__((noinline));
 
+/**
+ * Number of NUMA nodes the global pool keeps separate free lists for, as given
+ * by VESPA_MALLOC_NUMA_NODES. Defaults to 1, which gives a single shared pool.
+ */
+uint32_t numaNodesFromEnv();
+/**
+ * The NUMA node the calling thread is currently running on, folded into [0, numNodes).
+ */
+uint32_t currentNumaNode(uint32_t numNodes);
+
 #define ASSERT_STACKTRACE(a) { \
     if ( __builtin_expect(!(a), false) ) {  \
         vespamalloc::logStackTrace();       \
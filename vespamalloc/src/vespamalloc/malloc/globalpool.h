@@ -22,12 +22,21 @@ public:
     ~AllocPoolT();
 
     ChunkSList *getFree(SizeClassT sc, size_t minBlocks);
-    ChunkSList *exchangeFree(SizeClassT sc, ChunkSList * csl);
-    ChunkSList *exchangeAlloc(SizeClassT sc, ChunkSList * csl);
+    ChunkSList *exchangeFree(SizeClassT sc, ChunkSList * csl, uint32_t node);
+    ChunkSList *exchangeAlloc(SizeClassT sc, ChunkSList * csl, uint32_t node);
     ChunkSList *exactAlloc(size_t exactSize, SizeClassT sc, ChunkSList * csl) __attribute__((noinline));
     ChunkSList *returnMemory(SizeClassT sc, ChunkSList * csl) __attribute__((noinline));
 
+    /**
+     * Hands the pages inside the free blocks of at least MIN_RELEASE_SIZE cached
+     * for the given NUMA node back to the OS. The blocks stay in the pool and
+     * are faulted in again when reused. Returns the number of bytes released.
+     */
+    size_t releaseFreeMemory(uint32_t node) __attribute__((noinline));
+
     DataSegment & dataSegment()      { return _dataSegment; }
+    uint32_t numNodes()        const { return _numNodes; }
+    uint32_t currentNode()     const { return currentNumaNode(_numNodes); }
     void enableThreadSupport() __attribute__((noinline));
 
     static void setParams(size_t threadCacheLimit);
@@ -38,17 +47,22 @@ public:
     void info(FILE * os, size_t level=0) __attribute__((noinline));
 private:
     ChunkSList * getFree(SizeClassT sc) __attribute__((noinline));
-    ChunkSList * getAlloc(SizeClassT sc) __attribute__((noinline));
+    ChunkSList * getAlloc(SizeClassT sc, uint32_t node) __attribute__((noinline));
+    ChunkSList * stealAlloc(SizeClassT sc, uint32_t node) __attribute__((noinline));
     ChunkSList * malloc(const Guard & guard, SizeClassT sc) __attribute__((noinline));
     ChunkSList * getChunks(const Guard & guard, size_t numChunks) __attribute__((noinline));
     ChunkSList * allocChunkList(const Guard & guard) __attribute__((noinline));
     void validate(const void * ptr) const noexcept;
 
+    static constexpr size_t MIN_RELEASE_SIZE = 0x10000;
+
+    // Full chunk lists are kept per NUMA node, so that freed memory is reused on the node
+    // that touched it first. Empty chunk lists only carry bookkeeping and are shared.
     class AllocFree
     {
     public:
         AllocFree() : _full(), _empty() { }
-        typename ChunkSList::AtomicHeadPtr _full;
+        typename ChunkSList::AtomicHeadPtr _full[MAX_NUMA_NODES];
         typename ChunkSList::AtomicHeadPtr _empty;
     };
     class Stat
@@ -59,7 +73,8 @@ private:
                  _exchangeAlloc(0),
                  _exchangeFree(0),
                  _exactAlloc(0),
-                 _return(0),_malloc(0) { }
+                 _return(0),_malloc(0),
+                 _steal(0) { }
         std::atomic<size_t> _getAlloc;
         std::atomic<size_t> _getFree;
         std::atomic<size_t> _exchangeAlloc;
@@ -67,9 +82,10 @@ private:
         std::atomic<size_t> _exactAlloc;
         std::atomic<size_t> _return;
         std::atomic<size_t> _malloc;
+        std::atomic<size_t> _steal;
         bool isUsed()       const {
             // Do not count _getFree.
-            return (_getAlloc || _exchangeAlloc || _exchangeFree || _exactAlloc || _return || _malloc);
+            return (_getAlloc || _exchangeAlloc || _exchangeFree || _exactAlloc || _return || _malloc || _steal);
         }
     };
 
@@ -77,6 +93,7 @@ private:
     ChunkSList            * _chunkPool;
     AllocFree               _scList[NUM_SIZE_CLASSES];
     DataSegment           & _dataSegment;
+    const uint32_t          _numNodes;
     std::atomic<size_t>     _getChunks;
     std::atomic<size_t>     _getChunksSum;
     std::atomic<size_t>     _allocChunkList;
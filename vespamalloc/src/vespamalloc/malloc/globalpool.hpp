@@ -2,6 +2,8 @@
 #pragma once
 
 #include "globalpool.h"
+#include <sys/mman.h>
+#include <unistd.h>
 
 #define USE_STAT2(a) a
 
@@ -15,6 +17,7 @@ AllocPoolT<MemBlockPtrT>::AllocPoolT(DataSegment & ds)
     : _chunkPool(nullptr),
       _scList(),
       _dataSegment(ds),
+      _numNodes(numaNodesFromEnv()),
       _getChunks(0),
       _getChunksSum(0),
       _allocChunkList(0),
@@ -62,14 +65,17 @@ AllocPoolT<MemBlockPtrT>::getFree(SizeClassT sc)
 
 template <typename MemBlockPtrT>
 typename AllocPoolT<MemBlockPtrT>::ChunkSList *
-AllocPoolT<MemBlockPtrT>::getAlloc(SizeClassT sc)
+AllocPoolT<MemBlockPtrT>::getAlloc(SizeClassT sc, uint32_t node)
 {
     ChunkSList * csl(nullptr);
-    typename ChunkSList::AtomicHeadPtr & full = _scList[sc]._full;
+    typename ChunkSList::AtomicHeadPtr & full = _scList[sc]._full[node];
     while ((csl = ChunkSList::linkOut(full)) == nullptr) {
         Guard sync(_mutex);
         if (full.load(std::memory_order_relaxed)._ptr == nullptr) {
-            ChunkSList * ncsl(malloc(sync, sc));
+            ChunkSList * ncsl(stealAlloc(sc, node));
+            if (ncsl == nullptr) {
+                ncsl = malloc(sync, sc);
+            }
             if (ncsl) {
                 ChunkSList::linkInList(full, ncsl);
             } else {
@@ -82,6 +88,25 @@ AllocPoolT<MemBlockPtrT>::getAlloc(SizeClassT sc)
     return csl;
 }
 
+/**
+ * Memory freed on one node and allocated on another, as in a producer/consumer setup,
+ * would make the data segment grow without bounds if each node only used its own lists.
+ * So before extending the data segment, take what other nodes have cached.
+ */
+template <typename MemBlockPtrT>
+typename AllocPoolT<MemBlockPtrT>::ChunkSList *
+AllocPoolT<MemBlockPtrT>::stealAlloc(SizeClassT sc, uint32_t node)
+{
+    ChunkSList * csl(nullptr);
+    for (uint32_t i(1); (csl == nullptr) && (i < _numNodes); i++) {
+        csl = ChunkSList::linkOut(_scList[sc]._full[(node + i) % _numNodes]);
+    }
+    if (csl != nullptr) {
+        USE_STAT2(_stat[sc]._steal.fetch_add(1, std::memory_order_relaxed));
+    }
+    return csl;
+}
+
 template <typename MemBlockPtrT>
 typename AllocPoolT<MemBlockPtrT>::ChunkSList *
 AllocPoolT<MemBlockPtrT>::getFree(SizeClassT sc, size_t UNUSED(minBlocks))
@@ -94,12 +119,12 @@ AllocPoolT<MemBlockPtrT>::getFree(SizeClassT sc, size_t UNUSED(minBlocks))
 
 template <typename MemBlockPtrT>
 typename AllocPoolT<MemBlockPtrT>::ChunkSList *
-AllocPoolT<MemBlockPtrT>::exchangeFree(SizeClassT sc, typename AllocPoolT<MemBlockPtrT>::ChunkSList * csl)
+AllocPoolT<MemBlockPtrT>::exchangeFree(SizeClassT sc, typename AllocPoolT<MemBlockPtrT>::ChunkSList * csl, uint32_t node)
 {
     PARANOID_CHECK1( if (csl->empty() || (csl->count() > ChunkSList::NumBlocks)) { *(int*)0 = 0; } );
     AllocFree & af = _scList[sc];
-    validate(af._full.load(std::memory_order_relaxed)._ptr);
-    ChunkSList::linkIn(af._full, csl, csl);
+    validate(af._full[node].load(std::memory_order_relaxed)._ptr);
+    ChunkSList::linkIn(af._full[node], csl, csl);
     ChunkSList *ncsl = getFree(sc);
     validate(ncsl);
     USE_STAT2(_stat[sc]._exchangeFree.fetch_add(1, std::memory_order_relaxed));
@@ -108,13 +133,13 @@ AllocPoolT<MemBlockPtrT>::exchangeFree(SizeClassT sc, typename AllocPoolT<MemBlo
 
 template <typename MemBlockPtrT>
 typename AllocPoolT<MemBlockPtrT>::ChunkSList *
-AllocPoolT<MemBlockPtrT>::exchangeAlloc(SizeClassT sc, typename AllocPoolT<MemBlockPtrT>::ChunkSList * csl)
+AllocPoolT<MemBlockPtrT>::exchangeAlloc(SizeClassT sc, typename AllocPoolT<MemBlockPtrT>::ChunkSList * csl, uint32_t node)
 {
     PARANOID_CHECK1( if ( ! csl->empty()) { *(int*)0 = 0; } );
     AllocFree & af = _scList[sc];
     validate(af._empty.load(std::memory_order_relaxed)._ptr);
     ChunkSList::linkIn(af._empty, csl, csl);
-    ChunkSList * ncsl = getAlloc(sc);
+    ChunkSList * ncsl = getAlloc(sc, node);
     validate(ncsl);
     USE_STAT2(_stat[sc]._exchangeAlloc.fetch_add(1, std::memory_order_relaxed));
     PARANOID_CHECK1( if (ncsl->empty() || (ncsl->count() > ChunkSList::NumBlocks)) { *(int*)0 = 0; } );
@@ -163,6 +188,41 @@ AllocPoolT<MemBlockPtrT>::returnMemory(SizeClassT sc, typename AllocPoolT<MemBlo
     return completelyEmpty;
 }
 
+template <typename MemBlockPtrT>
+size_t
+AllocPoolT<MemBlockPtrT>::releaseFreeMemory(uint32_t node)
+{
+    if ( ! MemBlockPtrT::freeContentIsDisposable() || (node >= _numNodes)) {
+        return 0;
+    }
+    const size_t pageSize(getpagesize());
+    size_t released(0);
+    for (SizeClassT sc(0); sc < NUM_SIZE_CLASSES; sc++) {
+        const size_t cs(MemBlockPtrT::classSize(sc));
+        if (cs < MIN_RELEASE_SIZE) {
+            continue;
+        }
+        // Take all lists out while releasing, so no one hands the blocks out meanwhile.
+        typename ChunkSList::AtomicHeadPtr & full = _scList[sc]._full[node];
+        ChunkSList * head(nullptr);
+        for (ChunkSList * csl(ChunkSList::linkOut(full)); csl != nullptr; csl = ChunkSList::linkOut(full)) {
+            csl->forEach([&](MemBlockPtrT & mem) {
+                size_t start = (size_t(mem.rawPtr()) + pageSize - 1) & ~(pageSize - 1);
+                size_t end = (size_t(mem.rawPtr()) + cs) & ~(pageSize - 1);
+                if ((start < end) && (madvise(reinterpret_cast<void *>(start), end - start, MADV_DONTNEED) == 0)) {
+                    released += end - start;
+                }
+            });
+            csl->setNext(head);
+            head = csl;
+        }
+        if (head != nullptr) {
+            ChunkSList::linkInList(full, head);
+        }
+    }
+    return released;
+}
+
 template <typename MemBlockPtrT>
 typename AllocPoolT<MemBlockPtrT>::ChunkSList *
 AllocPoolT<MemBlockPtrT>::malloc(const Guard & guard, SizeClassT sc)
@@ -263,17 +323,17 @@ template <typename MemBlockPtrT>
 void AllocPoolT<MemBlockPtrT>::info(FILE * os, size_t level)
 {
     if (level > 0) {
-        fprintf(os, "GlobalPool getChunks(%ld, %ld) allocChunksList(%ld):\n",
-                _getChunks.load(), _getChunksSum.load(), _allocChunkList.load());
+        fprintf(os, "GlobalPool getChunks(%ld, %ld) allocChunksList(%ld) numaNodes(%u):\n",
+                _getChunks.load(), _getChunksSum.load(), _allocChunkList.load(), _numNodes);
         for (size_t i = 0; i < NELEMS(_stat); i++) {
             const Stat & s = _stat[i];
             if (s.isUsed()) {
                 fprintf(os, "SC %2ld(%10ld) GetAlloc(%6ld) GetFree(%6ld) "
                             "ExChangeAlloc(%6ld) ExChangeFree(%6ld) ExactAlloc(%6ld) "
-                            "Returned(%6ld) Malloc(%6ld)\n",
+                            "Returned(%6ld) Malloc(%6ld) Steal(%6ld)\n",
                             i, MemBlockPtrT::classSize(i), s._getAlloc.load(), s._getFree.load(),
                             s._exchangeAlloc.load(), s._exchangeFree.load(), s._exactAlloc.load(),
-                            s._return.load(), s._malloc.load());
+                            s._return.load(), s._malloc.load(), s._steal.load());
             }
         }
     }
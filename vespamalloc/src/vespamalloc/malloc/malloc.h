@@ -8,6 +8,7 @@
 #include "threadpool.h"
 #include "threadlist.h"
 #include "threadproxy.h"
+#include <vespamalloc/util/allocsampler.h>
 
 namespace vespamalloc {
 
@@ -96,6 +97,21 @@ public:
         _threadList.setParams(threadCacheLimit);
         _allocPool.setParams(threadCacheLimit);
     }
+    /**
+     * Releases the pages of free blocks cached in the global pool for the given
+     * NUMA node, or for all nodes if node is negative. Returns bytes released.
+     */
+    size_t releaseFreeMemory(int node) {
+        size_t released(0);
+        for (uint32_t i(0); i < _allocPool.numNodes(); i++) {
+            if ((node < 0) || (uint32_t(node) == i)) {
+                released += _allocPool.releaseFreeMemory(i);
+            }
+        }
+        return released;
+    }
+    void setAllocSampleInterval(size_t bytes) { _allocSampler.setInterval(bytes); }
+    AllocSampler & allocSampler() { return _allocSampler; }
     const DataSegment & dataSegment() const { return _segment; }
     const MMapPool & mmapPool() const { return _mmapPool; }
 private:
@@ -108,6 +124,7 @@ private:
     AllocPool    _allocPool;
     MMapPool     _mmapPool;
     ThreadListT  _threadList;
+    AllocSampler _allocSampler;
 };
 
 template <typename MemBlockPtrT, typename ThreadListT>
@@ -117,7 +134,8 @@ MemoryManager<MemBlockPtrT, ThreadListT>::MemoryManager(size_t logLimitAtStart)
     _segment(*this),
     _allocPool(_segment),
     _mmapPool(),
-    _threadList(_allocPool, _mmapPool)
+    _threadList(_allocPool, _mmapPool),
+    _allocSampler()
 {
     setAllocatorForThreads(this);
     initThisThread();
@@ -183,6 +201,7 @@ int MemoryManager<MemBlockPtrT, ThreadListT>::mallopt(int param, int value) {
 template <typename MemBlockPtrT, typename ThreadListT>
 void * MemoryManager<MemBlockPtrT, ThreadListT>::malloc(size_t sz)
 {
+    _allocSampler.sample(sz);
     MemBlockPtrT mem;
     ThreadPool & tp = _threadList.getCurrent();
     tp.malloc(mem.adjustSize(sz), mem);
@@ -198,6 +217,7 @@ void * MemoryManager<MemBlockPtrT, ThreadListT>::malloc(size_t sz)
 template <typename MemBlockPtrT, typename ThreadListT>
 void * MemoryManager<MemBlockPtrT, ThreadListT>::malloc(size_t sz, std::align_val_t alignment)
 {
+    _allocSampler.sample(sz);
     MemBlockPtrT mem;
     ThreadPool & tp = _threadList.getCurrent();
     tp.malloc(mem.adjustSize(sz, alignment), mem);
@@ -51,6 +51,8 @@ public:
     static void dumpInfo(size_t level);
     static void setFill(uint8_t ) { }
     static bool verifySizeClass(int sc) { (void) sc; return true; }
+    // Free blocks carry no state, so their pages may be handed back to the OS.
+    static constexpr bool freeContentIsDisposable() { return true; }
     static size_t getMinSizeForAlignment(size_t align, size_t sz) {
         return (sz < Parent::MAX_ALIGN)
                    ? std::max(sz, align)
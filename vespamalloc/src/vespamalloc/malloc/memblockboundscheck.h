@@ -36,6 +36,8 @@ public:
     static void dumpFile(FILE * fp)       { _logFile = fp; }
     static void setFill(uint8_t pattern)  { _fillValue = pattern; }
     static bool verifySizeClass(int sc)   { return sc >= 0; }
+    // Free blocks keep their header and fill pattern for verification.
+    static constexpr bool freeContentIsDisposable() { return false; }
 
     template<typename T>
     void readjustAlignment(const T & segment) {
@@ -67,6 +67,7 @@ private:
             bigblocklimit,
             fillvalue,
             dumpsignal,
+            alloc_sample_interval,
             numberofentries  // Must be the last one
         };
         Params() __attribute__ ((noinline));
@@ -126,6 +127,7 @@ MemoryWatcher<T, S>::Params::Params()
     _params[          bigblocklimit] = NameValuePair("bigblocklimit", "0x80000000"); // 8M
     _params[              fillvalue] = NameValuePair("fillvalue", "0xa8"); // Means NO fill.
     _params[             dumpsignal] = NameValuePair("dumpsignal", "27"); // SIGPROF
+    _params[  alloc_sample_interval] = NameValuePair("alloc_sample_interval", "0"); // Bytes between sampled stacks, 0 is off
 }
 
 template <typename T, typename S>
@@ -204,7 +206,7 @@ void MemoryWatcher<T, S>::activateOptions()
     this->setParams(_params[Params::threadcachelimit].valueAsLong());
     _G_bigBlockLimit = _params[Params::bigblocklimit].valueAsLong();
     T::setFill(_params[Params::fillvalue].valueAsLong());
-
+    this->setAllocSampleInterval(_params[Params::alloc_sample_interval].valueAsLong());
 }
 
 namespace {
@@ -148,6 +148,35 @@ struct mallinfo mallinfo() __THROW {
 }
 #endif
 
+// Exported symbol for returning cached free memory to the OS, for a single NUMA node or all (numa_node < 0).
+size_t vespamalloc_release_free_memory(int numa_node) __attribute__((visibility("default")));
+size_t vespamalloc_release_free_memory(int numa_node) {
+    return vespamalloc::createAllocator()->releaseFreeMemory(numa_node);
+}
+
+// Exported symbols for sampling the call stacks of allocations, see vespamalloc::AllocSampler.
+// An interval of 0 turns sampling off; samples taken so far are kept until reset.
+void vespamalloc_set_alloc_sample_interval(size_t bytes) __attribute__((visibility("default")));
+void vespamalloc_set_alloc_sample_interval(size_t bytes) {
+    vespamalloc::createAllocator()->setAllocSampleInterval(bytes);
+}
+
+void vespamalloc_reset_alloc_samples() __attribute__((visibility("default")));
+void vespamalloc_reset_alloc_samples() {
+    vespamalloc::createAllocator()->allocSampler().reset();
+}
+
+void vespamalloc_dump_alloc_samples(FILE* out_file, size_t max_stacks) __attribute__((visibility("default")));
+void vespamalloc_dump_alloc_samples(FILE* out_file, size_t max_stacks) {
+    vespamalloc::createAllocator()->allocSampler().info(out_file, max_stacks);
+}
+
+int malloc_trim(size_t pad) __THROW __attribute__((visibility("default")));
+int malloc_trim(size_t pad) __THROW {
+    (void) pad;
+    return (vespamalloc::createAllocator()->releaseFreeMemory(-1) > 0) ? 1 : 0;
+}
+
 int mallopt(int param, int value) throw() __attribute((visibility("default")));
 int mallopt(int param, int value) throw() {
     return vespamalloc::createAllocator()->mallopt(param, value);
@@ -71,7 +71,7 @@ mallocHelper(size_t exactSize,
         PARANOID_CHECK2( if (!mem.ptr()) { *(int *)0 = 0; } );
     } else {
         if ( ! alwaysReuse(sc) ) {
-            af._allocFrom = _allocPool->exchangeAlloc(sc, af._allocFrom);
+            af._allocFrom = _allocPool->exchangeAlloc(sc, af._allocFrom, _numaNode);
             _stat[sc].incExchangeAlloc();
             if (af._allocFrom) {
                 af._allocFrom->sub(mem);
@@ -105,6 +105,7 @@ ThreadPoolT<MemBlockPtrT, ThreadStatT>::ThreadPoolT() :
     _mmapPool(nullptr),
     _mmapLimit(MMAP_LIMIT_MAX),
     _threadId(0),
+    _numaNode(0),
     _osThreadId(0)
 {
 }
@@ -151,19 +152,19 @@ void ThreadPoolT<MemBlockPtrT, ThreadStatT>::free(MemBlockPtrT mem, SizeClassT s
         } else {
             af._freeTo->add(mem);
             if (af._freeTo->full()) {
-                af._freeTo = _allocPool->exchangeFree(sc, af._freeTo);
+                af._freeTo = _allocPool->exchangeFree(sc, af._freeTo, _numaNode);
                 _stat[sc].incExchangeFree();
             }
         }
     } else if (cs < _threadCacheLimit) {
         af._freeTo->add(mem);
         if (af._freeTo->count()*cs > _threadCacheLimit) {
-            af._freeTo = _allocPool->exchangeFree(sc, af._freeTo);
+            af._freeTo = _allocPool->exchangeFree(sc, af._freeTo, _numaNode);
             _stat[sc].incExchangeFree();
         }
     } else if ( !alwaysReuse(sc) ) {
         af._freeTo->add(mem);
-        af._freeTo = _allocPool->exchangeFree(sc, af._freeTo);
+        af._freeTo = _allocPool->exchangeFree(sc, af._freeTo, _numaNode);
         _stat[sc].incExchangeFree();
     } else {
         af._freeTo->add(mem);
@@ -207,6 +208,8 @@ void ThreadPoolT<MemBlockPtrT, ThreadStatT>::init(int thrId)
     setThreadId(thrId);
     ASSERT_STACKTRACE(_osThreadId.load(std::memory_order_relaxed) == -1);
     _osThreadId = pthread_self();
+    // Sampled once, threads migrating to another node will keep using the lists of the first one.
+    _numaNode = _allocPool->currentNode();
     for (size_t i=0; (i < NELEMS(_memList)); i++) {
         _memList[i].init(*_allocPool, i);
     }
@@ -0,0 +1,187 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespamalloc/util/allocsampler.h>
+#include <vespamalloc/util/callstack.h>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace vespamalloc {
+
+namespace {
+
+#ifdef __PIC__
+    #define SAMPLER_TLS_LINKAGE __attribute__((visibility("hidden"), tls_model("initial-exec")))
+#else
+    #define SAMPLER_TLS_LINKAGE __attribute__((visibility("hidden"), tls_model("local-exec")))
+#endif
+
+struct SamplerThreadState {
+    int64_t  bytesUntilSample;
+    uint64_t rnd;
+    bool     inSampler;
+};
+
+thread_local SamplerThreadState _threadState SAMPLER_TLS_LINKAGE = { 0, 0, false };
+
+// Uniform jitter around the interval avoids sampling in lockstep with periodic allocation patterns
+int64_t
+nextCountDown(SamplerThreadState & state, size_t interval) noexcept {
+    // xorshift64
+    state.rnd ^= state.rnd << 13;
+    state.rnd ^= state.rnd >> 7;
+    state.rnd ^= state.rnd << 17;
+    return int64_t(interval / 2 + state.rnd % interval);
+}
+
+uint64_t
+hashStack(const void * const * frames, uint32_t depth) noexcept {
+    uint64_t hash = 0xcbf29ce484222325ul;
+    for (uint32_t i(0); i < depth; i++) {
+        hash = (hash ^ uint64_t(frames[i])) * 0x100000001b3ul;
+    }
+    return hash;
+}
+
+constexpr size_t MAX_STACKS_TO_SHOW = 64;
+
+}
+
+AllocSampler::AllocSampler() noexcept
+    : _interval(0),
+      _lock(),
+      _samples(0),
+      _dropped(0),
+      _numEntries(0),
+      _entries()
+{
+}
+
+void
+AllocSampler::setInterval(size_t bytes) noexcept
+{
+    _interval.store(bytes, std::memory_order_relaxed);
+}
+
+void
+AllocSampler::lock() const noexcept
+{
+    while (_lock.test_and_set(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+void
+AllocSampler::countDown(size_t sz) noexcept
+{
+    SamplerThreadState & state = _threadState;
+    size_t interval = _interval.load(std::memory_order_relaxed);
+    if (__builtin_expect(state.rnd == 0, false)) {
+        // First allocation in this thread, do not always sample it
+        state.rnd = uint64_t(&state) | 1;
+        state.bytesUntilSample = nextCountDown(state, std::max(interval, size_t(1)));
+    }
+    state.bytesUntilSample -= int64_t(sz);
+    if ((state.bytesUntilSample > 0) || state.inSampler) {
+        return;
+    }
+    // backtrace() may allocate the first time it is called in a process
+    state.inSampler = true;
+    if (interval != 0) {
+        const void * frames[MAX_STACK_DEPTH + 1];
+        int depth = backtrace(const_cast<void **>(frames), MAX_STACK_DEPTH + 1);
+        if (depth > 1) {
+            // Skip this frame
+            record(frames + 1, depth - 1, sz, std::max(sz, interval));
+        }
+        state.bytesUntilSample = nextCountDown(state, interval);
+    }
+    state.inSampler = false;
+}
+
+void
+AllocSampler::record(const void * const * frames, uint32_t depth, size_t sz, size_t weight) noexcept
+{
+    uint64_t hash = hashStack(frames, depth);
+    lock();
+    _samples++;
+    Entry * found = nullptr;
+    size_t idx = hash & (NUM_ENTRIES - 1);
+    for (size_t probe(0); (found == nullptr) && (probe < NUM_ENTRIES); probe++, idx = (idx + 1) & (NUM_ENTRIES - 1)) {
+        Entry & e = _entries[idx];
+        if (e.depth == 0) {
+            if (_numEntries * 4 >= NUM_ENTRIES * 3) {
+                break; // Keep probe sequences short
+            }
+            e.hash = hash;
+            e.depth = depth;
+            memcpy(e.frames, frames, depth * sizeof(frames[0]));
+            _numEntries++;
+            found = &e;
+        } else if ((e.hash == hash) && (e.depth == depth) && (memcmp(e.frames, frames, depth * sizeof(frames[0])) == 0)) {
+            found = &e;
+        }
+    }
+    if (found != nullptr) {
+        found->samples++;
+        found->bytes += weight;
+        found->lastSize = sz;
+    } else {
+        _dropped++;
+    }
+    unlock();
+}
+
+void
+AllocSampler::reset() noexcept
+{
+    lock();
+    memset(_entries, 0, sizeof(_entries));
+    _samples = 0;
+    _dropped = 0;
+    _numEntries = 0;
+    unlock();
+}
+
+void
+AllocSampler::info(FILE * os, size_t maxStacks) const
+{
+    // Copy out under the lock, print without it as printing may allocate
+    uint16_t used[NUM_ENTRIES];
+    Entry top[MAX_STACKS_TO_SHOW];
+    size_t numUsed(0);
+    uint64_t totalBytes(0);
+    lock();
+    for (size_t i(0); i < NUM_ENTRIES; i++) {
+        if (_entries[i].depth != 0) {
+            used[numUsed++] = i;
+            totalBytes += _entries[i].bytes;
+        }
+    }
+    size_t numTop = std::min({maxStacks, numUsed, MAX_STACKS_TO_SHOW});
+    std::partial_sort(used, used + numTop, used + numUsed,
+                      [this](uint16_t a, uint16_t b) { return _entries[a].bytes > _entries[b].bytes; });
+    for (size_t i(0); i < numTop; i++) {
+        top[i] = _entries[used[i]];
+    }
+    uint64_t samples = _samples;
+    uint64_t dropped = _dropped;
+    unlock();
+    fprintf(os, "Allocation samples: interval %zu bytes, %lu samples, %zu stacks, %lu dropped\n",
+            interval(), samples, numUsed, dropped);
+    for (size_t i(0); i < numTop; i++) {
+        const Entry & e = top[i];
+        fprintf(os, "%5.1f%% %lu bytes estimated, %lu samples, last size %lu\n",
+                (totalBytes > 0) ? (100.0 * e.bytes) / totalBytes : 0.0, e.bytes, e.samples, e.lastSize);
+        fprintf(os, "    ");
+        for (uint32_t j(0); j < e.depth; j++) {
+            if (j > 0) {
+                fprintf(os, " from ");
+            }
+            StackEntry(e.frames[j]).info(os);
+        }
+        fprintf(os, "\n");
+    }
+    fflush(os);
+}
+
+}
@@ -0,0 +1,63 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace vespamalloc {
+
+/**
+ * Samples the call stacks of allocations, aggregated per distinct stack.
+ *
+ * Sampling is driven by the number of bytes allocated by each thread: a
+ * stack is recorded roughly every 'interval' bytes, so the chance of a
+ * call site being sampled is proportional to the bytes it allocates. Each
+ * sample is weighted with the bytes it represents when estimating the
+ * bytes allocated per stack. When disabled (interval 0) the only cost is
+ * a relaxed load per allocation.
+ *
+ * Stacks are kept in a fixed size table that never allocates. Samples of
+ * new stacks are counted as dropped when the table is full.
+ */
+class AllocSampler {
+public:
+    static constexpr size_t MAX_STACK_DEPTH = 24;
+    static constexpr size_t NUM_ENTRIES = 4096;
+
+    AllocSampler() noexcept;
+    void setInterval(size_t bytes) noexcept;
+    size_t interval() const noexcept { return _interval.load(std::memory_order_relaxed); }
+    void sample(size_t sz) noexcept {
+        if (__builtin_expect(_interval.load(std::memory_order_relaxed) != 0, false)) {
+            countDown(sz);
+        }
+    }
+    /** Forgets all samples taken so far. */
+    void reset() noexcept;
+    /** Writes the stacks with the most estimated bytes allocated, most first. */
+    void info(FILE * os, size_t maxStacks) const;
+private:
+    struct Entry {
+        uint64_t     hash;
+        uint32_t     depth;
+        uint64_t     samples;
+        uint64_t     bytes;
+        uint64_t     lastSize;
+        const void * frames[MAX_STACK_DEPTH];
+    };
+    void countDown(size_t sz) noexcept __attribute__((noinline));
+    void record(const void * const * frames, uint32_t depth, size_t sz, size_t weight) noexcept;
+    void lock() const noexcept;
+    void unlock() const noexcept { _lock.clear(std::memory_order_release); }
+
+    std::atomic<size_t>      _interval;
+    mutable std::atomic_flag _lock;
+    uint64_t                 _samples;
+    uint64_t                 _dropped;
+    uint32_t                 _numEntries;
+    Entry                    _entries[NUM_ENTRIES];
+};
+
+}